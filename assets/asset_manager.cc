@@ -9,7 +9,16 @@
 
 namespace flutter {
 
-AssetManager::AssetManager() = default;
+namespace {
+
+// Prefetching reads one byte of every page of a mapping, so that the pages of
+// file backed mappings are resident before the mapping is used.
+constexpr size_t kPrefetchPageSize = 4096u;
+
+}  // namespace
+
+AssetManager::AssetManager()
+    : resolvers_mutex_(fml::SharedMutex::Create()) {}
 
 AssetManager::~AssetManager() = default;
 
@@ -18,7 +27,9 @@ bool AssetManager::PushFront(std::unique_ptr<AssetResolver> resolver) {
     return false;
   }
 
+  fml::UniqueLock lock(*resolvers_mutex_);
   resolvers_.push_front(std::move(resolver));
+  ResetIndex();
   return true;
 }
 
@@ -27,7 +38,9 @@ bool AssetManager::PushBack(std::unique_ptr<AssetResolver> resolver) {
     return false;
   }
 
+  fml::UniqueLock lock(*resolvers_mutex_);
   resolvers_.push_back(std::move(resolver));
+  ResetIndex();
   return true;
 }
 
@@ -37,6 +50,7 @@ void AssetManager::UpdateResolverByType(
   if (updated_asset_resolver == nullptr) {
     return;
   }
+  fml::UniqueLock lock(*resolvers_mutex_);
   bool updated = false;
   std::deque<std::unique_ptr<AssetResolver>> new_resolvers;
   for (auto& old_resolver : resolvers_) {
@@ -53,12 +67,98 @@ void AssetManager::UpdateResolverByType(
     new_resolvers.push_back(std::move(updated_asset_resolver));
   }
   resolvers_.swap(new_resolvers);
+  ResetIndex();
 }
 
 std::deque<std::unique_ptr<AssetResolver>> AssetManager::TakeResolvers() {
+  fml::UniqueLock lock(*resolvers_mutex_);
+  ResetIndex();
   return std::move(resolvers_);
 }
 
+void AssetManager::ResetIndex() {
+  std::scoped_lock lock(index_mutex_);
+  resolver_index_.clear();
+  prefetched_mappings_.clear();
+}
+
+void AssetManager::Prefetch(
+    const std::vector<std::string>& asset_names,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner) {
+  std::weak_ptr<AssetManager> weak_manager = weak_from_this();
+  if (!task_runner || weak_manager.expired()) {
+    return;
+  }
+  for (const auto& asset_name : asset_names) {
+    if (asset_name.empty()) {
+      continue;
+    }
+    task_runner->PostTask([weak_manager, asset_name]() {
+      if (auto manager = weak_manager.lock()) {
+        manager->PrefetchAsset(asset_name);
+      }
+    });
+  }
+}
+
+void AssetManager::PrefetchAsset(const std::string& asset_name) {
+  TRACE_EVENT1("flutter", "AssetManager::PrefetchAsset", "name",
+               asset_name.c_str());
+  // The shared lock is held until the mapping is stored, so that a change of
+  // the resolvers can't leave behind a mapping from a removed resolver.
+  fml::SharedLock lock(*resolvers_mutex_);
+  {
+    std::scoped_lock index_lock(index_mutex_);
+    if (prefetched_mappings_.count(asset_name) > 0) {
+      return;
+    }
+  }
+  auto mapping = ResolveAsMapping(asset_name);
+  if (mapping == nullptr) {
+    return;
+  }
+  if (const uint8_t* data = mapping->GetMapping()) {
+    uint8_t checksum = 0u;
+    for (size_t offset = 0; offset < mapping->GetSize();
+         offset += kPrefetchPageSize) {
+      checksum ^= static_cast<const volatile uint8_t*>(data)[offset];
+    }
+    (void)checksum;
+  }
+  std::scoped_lock index_lock(index_mutex_);
+  prefetched_mappings_.emplace(asset_name, std::move(mapping));
+}
+
+std::unique_ptr<fml::Mapping> AssetManager::ResolveAsMapping(
+    const std::string& asset_name) const {
+  const AssetResolver* indexed_resolver = nullptr;
+  {
+    std::scoped_lock lock(index_mutex_);
+    auto found = resolver_index_.find(asset_name);
+    if (found != resolver_index_.end()) {
+      indexed_resolver = found->second;
+    }
+  }
+  if (indexed_resolver != nullptr) {
+    auto mapping = indexed_resolver->GetAsMapping(asset_name);
+    if (mapping != nullptr) {
+      return mapping;
+    }
+  }
+  for (const auto& resolver : resolvers_) {
+    if (resolver.get() == indexed_resolver) {
+      continue;
+    }
+    auto mapping = resolver->GetAsMapping(asset_name);
+    if (mapping != nullptr) {
+      std::scoped_lock lock(index_mutex_);
+      resolver_index_[asset_name] = resolver.get();
+      return mapping;
+    }
+  }
+  return nullptr;
+}
+
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
     const std::string& asset_name) const {
@@ -67,12 +167,20 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMapping", "name",
                asset_name.c_str());
-  for (const auto& resolver : resolvers_) {
-    auto mapping = resolver->GetAsMapping(asset_name);
-    if (mapping != nullptr) {
+  {
+    std::scoped_lock lock(index_mutex_);
+    auto found = prefetched_mappings_.find(asset_name);
+    if (found != prefetched_mappings_.end()) {
+      auto mapping = std::move(found->second);
+      prefetched_mappings_.erase(found);
       return mapping;
     }
   }
+  fml::SharedLock lock(*resolvers_mutex_);
+  auto mapping = ResolveAsMapping(asset_name);
+  if (mapping != nullptr) {
+    return mapping;
+  }
   FML_DLOG(WARNING) << "Could not find asset: " << asset_name;
   return nullptr;
 }
@@ -87,6 +195,7 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
   }
   TRACE_EVENT1("flutter", "AssetManager::GetAsMappings", "pattern",
                asset_pattern.c_str());
+  fml::SharedLock lock(*resolvers_mutex_);
   for (const auto& resolver : resolvers_) {
     auto resolver_mappings = resolver->GetAsMappings(asset_pattern, subdir);
     mappings.insert(mappings.end(),
@@ -96,8 +205,67 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
   return mappings;
 }
 
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>>
+AssetManager::GetAsMappingsConcurrently(
+    const std::vector<std::string>& asset_names,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner) const {
+  TRACE_EVENT0("flutter", "AssetManager::GetAsMappingsConcurrently");
+  std::vector<std::unique_ptr<fml::Mapping>> mappings(asset_names.size());
+  // The indices of the assets that haven't been found yet.
+  std::vector<size_t> pending;
+  {
+    std::scoped_lock lock(index_mutex_);
+    for (size_t i = 0; i < asset_names.size(); i++) {
+      if (asset_names[i].empty()) {
+        continue;
+      }
+      auto found = prefetched_mappings_.find(asset_names[i]);
+      if (found != prefetched_mappings_.end()) {
+        mappings[i] = std::move(found->second);
+        prefetched_mappings_.erase(found);
+      } else {
+        pending.push_back(i);
+      }
+    }
+  }
+
+  // Each resolver is asked for all the assets that the resolvers in front of
+  // it didn't have, so that every resolver reads its assets as one batch.
+  fml::SharedLock lock(*resolvers_mutex_);
+  for (const auto& resolver : resolvers_) {
+    if (pending.empty()) {
+      break;
+    }
+    std::vector<std::string> pending_names;
+    pending_names.reserve(pending.size());
+    for (size_t index : pending) {
+      pending_names.push_back(asset_names[index]);
+    }
+    auto resolver_mappings =
+        resolver->GetAsMappingsConcurrently(pending_names, task_runner);
+    FML_DCHECK(resolver_mappings.size() == pending.size());
+    std::vector<size_t> still_pending;
+    std::scoped_lock index_lock(index_mutex_);
+    for (size_t i = 0; i < pending.size(); i++) {
+      if (i < resolver_mappings.size() && resolver_mappings[i] != nullptr) {
+        mappings[pending[i]] = std::move(resolver_mappings[i]);
+        resolver_index_[pending_names[i]] = resolver.get();
+      } else {
+        still_pending.push_back(pending[i]);
+      }
+    }
+    pending.swap(still_pending);
+  }
+  for (size_t index : pending) {
+    FML_DLOG(WARNING) << "Could not find asset: " << asset_names[index];
+  }
+  return mappings;
+}
+
 // |AssetResolver|
 bool AssetManager::IsValid() const {
+  fml::SharedLock lock(*resolvers_mutex_);
   return !resolvers_.empty();
 }
 
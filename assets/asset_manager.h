@@ -7,16 +7,31 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <optional>
 #include "flutter/assets/asset_resolver.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
+#include "flutter/fml/synchronization/shared_mutex.h"
+#include "flutter/fml/task_runner.h"
 
 namespace flutter {
 
-class AssetManager final : public AssetResolver {
+//------------------------------------------------------------------------------
+/// @brief      Resolves assets from a queue of `AssetResolver`s.
+///
+///             The resolver that an asset was found in is remembered, so later
+///             lookups of the same asset go straight to that resolver instead
+///             of trying every resolver in front of it first. The index is
+///             discarded whenever the resolvers change.
+///
+///             The asset manager may be used from multiple threads.
+///
+class AssetManager final : public AssetResolver,
+                           public std::enable_shared_from_this<AssetManager> {
  public:
   AssetManager();
 
@@ -70,6 +85,30 @@ class AssetManager final : public AssetResolver {
 
   std::deque<std::unique_ptr<AssetResolver>> TakeResolvers();
 
+  //--------------------------------------------------------------------------
+  /// @brief      Resolves and reads the named assets in parallel on the given
+  ///             task runner, ahead of their use. The next `GetAsMapping` call
+  ///             for a prefetched asset hands out its prefetched mapping
+  ///             instead of resolving the asset again.
+  ///
+  ///             This is meant for assets that are known to be needed before
+  ///             the first frame, so that they can be read while the isolate
+  ///             is still starting up. Prefetched mappings that are never
+  ///             asked for are held until the resolvers change or the asset
+  ///             manager is collected.
+  ///
+  ///             Prefetching does nothing unless the asset manager is owned
+  ///             by a `std::shared_ptr`.
+  ///
+  /// @param[in]  asset_names  The names of the assets to prefetch. Assets
+  ///                          that can't be found are ignored.
+  ///
+  /// @param[in]  task_runner  The task runner to read the assets on, usually
+  ///                          the concurrent worker task runner of the VM.
+  ///
+  void Prefetch(const std::vector<std::string>& asset_names,
+                const std::shared_ptr<fml::BasicTaskRunner>& task_runner);
+
   // |AssetResolver|
   bool IsValid() const override;
 
@@ -88,8 +127,32 @@ class AssetManager final : public AssetResolver {
       const std::string& asset_pattern,
       const std::optional<std::string>& subdir) const override;
 
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappingsConcurrently(
+      const std::vector<std::string>& asset_names,
+      const std::shared_ptr<fml::BasicTaskRunner>& task_runner) const override;
+
  private:
+  // Guards |resolvers_|. Lookups share it, changes to the resolvers hold it
+  // exclusively.
+  std::unique_ptr<fml::SharedMutex> resolvers_mutex_;
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
+  // Guards |resolver_index_| and |prefetched_mappings_|. Only ever acquired
+  // after |resolvers_mutex_|, never before it.
+  mutable std::mutex index_mutex_;
+  mutable std::unordered_map<std::string, const AssetResolver*>
+      resolver_index_;
+  mutable std::unordered_map<std::string, std::unique_ptr<fml::Mapping>>
+      prefetched_mappings_;
+
+  // Must be called with |resolvers_mutex_| held.
+  std::unique_ptr<fml::Mapping> ResolveAsMapping(
+      const std::string& asset_name) const;
+
+  // Must be called with |resolvers_mutex_| held exclusively.
+  void ResetIndex();
+
+  void PrefetchAsset(const std::string& asset_name);
 
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManager);
 };
@@ -11,6 +11,7 @@
 #include <optional>
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
 
 namespace flutter {
 
@@ -81,6 +82,33 @@ class AssetResolver {
     return {};
   };
 
+  //--------------------------------------------------------------------------
+  /// @brief      Same as GetAsMapping() but for a batch of assets, which the
+  ///             resolver may read concurrently on the given task runner
+  ///             instead of one after the other.
+  ///
+  /// @param[in]  asset_names  The names of the assets to read.
+  ///
+  /// @param[in]  task_runner  The task runner to read the assets on, usually
+  ///             the concurrent worker task runner of the VM. The assets are
+  ///             read on the calling thread if this is null.
+  ///
+  /// @return     Returns the mappings of the assets in the order of
+  ///             `asset_names`, with nullptr for the assets that could not be
+  ///             found.
+  ///
+  [[nodiscard]] virtual std::vector<std::unique_ptr<fml::Mapping>>
+  GetAsMappingsConcurrently(
+      const std::vector<std::string>& asset_names,
+      const std::shared_ptr<fml::BasicTaskRunner>& task_runner) const {
+    std::vector<std::unique_ptr<fml::Mapping>> mappings;
+    mappings.reserve(asset_names.size());
+    for (const auto& asset_name : asset_names) {
+      mappings.push_back(GetAsMapping(asset_name));
+    }
+    return mappings;
+  }
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(AssetResolver);
 };
@@ -7,6 +7,7 @@
 #include <regex>
 #include <utility>
 
+#include "flutter/fml/async_file_reader.h"
 #include "flutter/fml/eintr_wrapper.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/mapping.h"
@@ -110,4 +111,16 @@ std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
   return mappings;
 }
 
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>>
+DirectoryAssetBundle::GetAsMappingsConcurrently(
+    const std::vector<std::string>& asset_names,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner) const {
+  if (!is_valid_) {
+    FML_DLOG(WARNING) << "Asset bundle was not valid.";
+    return std::vector<std::unique_ptr<fml::Mapping>>(asset_names.size());
+  }
+  return fml::AsyncFileReader(task_runner).ReadFiles(descriptor_, asset_names);
+}
+
 }  // namespace flutter
@@ -43,6 +43,11 @@ class DirectoryAssetBundle : public AssetResolver {
       const std::string& asset_pattern,
       const std::optional<std::string>& subdir) const override;
 
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappingsConcurrently(
+      const std::vector<std::string>& asset_names,
+      const std::shared_ptr<fml::BasicTaskRunner>& task_runner) const override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(DirectoryAssetBundle);
 };
 
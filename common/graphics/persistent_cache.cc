@@ -4,8 +4,12 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <algorithm>
 #include <future>
+#include <map>
 #include <memory>
+#include <set>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -50,6 +54,7 @@ bool PersistentCache::gIsReadOnly = false;
 
 std::atomic<bool> PersistentCache::cache_sksl_ = false;
 std::atomic<bool> PersistentCache::strategy_set_ = false;
+std::atomic<size_t> PersistentCache::eager_sksl_warmup_count_ = 0;
 
 void PersistentCache::SetCacheSkSL(bool value) {
   if (strategy_set_ && value != cache_sksl_) {
@@ -60,6 +65,48 @@ void PersistentCache::SetCacheSkSL(bool value) {
   cache_sksl_ = value;
 }
 
+void PersistentCache::SetEagerSkSLWarmupCount(size_t count) {
+  eager_sksl_warmup_count_ = count;
+}
+
+struct PersistentCache::SkSLUsageRecord {
+  std::mutex mutex;
+  // Keyed by the cache file name of the shader.
+  std::map<std::string, SkSLUsage> usage;
+  std::set<std::string> used_this_run;
+  bool write_pending = false;
+
+  // The usage file holds one "<file name> <first use> <run count>" line per
+  // shader.
+  void Read(const fml::UniqueFD& directory) {
+    auto file = fml::OpenFileReadOnly(directory, kSkSLUsageFileName);
+    if (!file.is_valid()) {
+      return;
+    }
+    fml::FileMapping mapping(file);
+    if (mapping.GetMapping() == nullptr) {
+      return;
+    }
+    std::istringstream stream(
+        std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                    mapping.GetSize()));
+    std::string file_name;
+    SkSLUsage entry;
+    while (stream >> file_name >> entry.first_use >> entry.run_count) {
+      usage[file_name] = entry;
+    }
+  }
+
+  std::string Serialize() const {
+    std::ostringstream stream;
+    for (const auto& [file_name, entry] : usage) {
+      stream << file_name << " " << entry.first_use << " " << entry.run_count
+             << "\n";
+    }
+    return stream.str();
+  }
+};
+
 PersistentCache* PersistentCache::GetCacheForProcess() {
   std::scoped_lock lock(instance_mutex_);
   if (gPersistentCache == nullptr) {
@@ -191,7 +238,7 @@ sk_sp<SkData> ParseBase64(const std::string& input) {
   return data;
 }
 
-size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
+size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) {
   // clang-tidy has trouble reasoning about some of the complicated array and
   // pointer-arithmetic code in rapidjson.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.PlacementNew)
@@ -200,24 +247,83 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
   FML_TRACE_EVENT("flutter", "PersistentCache::PrecompileKnownSkSLs", "count",
                   known_sksls.size());
 
+  std::scoped_lock lock(pending_sksls_mutex_);
+  pending_sksls_.clear();
+  next_pending_sksl_ = 0;
+  pending_sksls_context_ = context;
+
   if (context == nullptr) {
     return 0;
   }
 
+  size_t eager_count = eager_sksl_warmup_count_;
+  if (eager_count == 0 || eager_count > known_sksls.size()) {
+    eager_count = known_sksls.size();
+  }
+
   size_t precompiled_count = 0;
-  for (const auto& sksl : known_sksls) {
+  for (size_t i = 0; i < eager_count; i++) {
     TRACE_EVENT0("flutter", "PrecompilingSkSL");
-    if (context->precompileShader(*sksl.key, *sksl.value)) {
+    if (context->precompileShader(*known_sksls[i].key,
+                                  *known_sksls[i].value)) {
       precompiled_count++;
     }
   }
+  pending_sksls_.assign(known_sksls.begin() + eager_count, known_sksls.end());
 
   FML_TRACE_COUNTER("flutter", "PersistentCache::PrecompiledSkSLs",
                     reinterpret_cast<int64_t>(this),  // Trace Counter ID
-                    "Successful", precompiled_count);
+                    "Successful", precompiled_count,  //
+                    "Pending", pending_sksls_.size());
   return precompiled_count;
 }
 
+bool PersistentCache::HasPendingSkSLs() const {
+  std::scoped_lock lock(pending_sksls_mutex_);
+  return next_pending_sksl_ < pending_sksls_.size();
+}
+
+size_t PersistentCache::PrecompilePendingSkSLs(GrDirectContext* context,
+                                               fml::TimePoint deadline) {
+  std::scoped_lock lock(pending_sksls_mutex_);
+  if (context == nullptr || context != pending_sksls_context_ ||
+      next_pending_sksl_ >= pending_sksls_.size()) {
+    return 0;
+  }
+
+  TRACE_EVENT0("flutter", "PersistentCache::PrecompilePendingSkSLs");
+  size_t precompiled_count = 0;
+  while (next_pending_sksl_ < pending_sksls_.size() &&
+         fml::TimePoint::Now() < deadline) {
+    TRACE_EVENT0("flutter", "PrecompilingSkSL");
+    const SkSLCache& sksl = pending_sksls_[next_pending_sksl_++];
+    if (context->precompileShader(*sksl.key, *sksl.value)) {
+      precompiled_count++;
+    }
+  }
+
+  size_t pending_count = pending_sksls_.size() - next_pending_sksl_;
+  if (pending_count == 0) {
+    pending_sksls_.clear();
+    next_pending_sksl_ = 0;
+  }
+  FML_TRACE_COUNTER("flutter", "PersistentCache::PendingSkSLs",
+                    reinterpret_cast<int64_t>(this),  // Trace Counter ID
+                    "Pending", pending_count);
+  return precompiled_count;
+}
+
+std::optional<PersistentCache::SkSLUsage> PersistentCache::GetSkSLUsage(
+    const SkData& key) const {
+  std::string file_name = SkKeyToFilePath(key);
+  std::scoped_lock lock(sksl_usage_->mutex);
+  auto found = sksl_usage_->usage.find(file_name);
+  if (found == sksl_usage_->usage.end()) {
+    return std::nullopt;
+  }
+  return found->second;
+}
+
 std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
   std::vector<PersistentCache::SkSLCache> result;
@@ -272,18 +378,55 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
     }
   }
 
-  return result;
+  // Order the shaders by their recorded usage. The sort is stable so that
+  // shaders without usage keep the order they were found in.
+  std::vector<std::optional<SkSLUsage>> usage;
+  usage.reserve(result.size());
+  {
+    std::scoped_lock lock(sksl_usage_->mutex);
+    for (const auto& sksl : result) {
+      auto found = sksl_usage_->usage.find(SkKeyToFilePath(*sksl.key));
+      if (found == sksl_usage_->usage.end()) {
+        usage.emplace_back(std::nullopt);
+      } else {
+        usage.emplace_back(found->second);
+      }
+    }
+  }
+  std::vector<size_t> order(result.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&usage](size_t a, size_t b) {
+    if (!usage[a].has_value() || !usage[b].has_value()) {
+      return usage[a].has_value() && !usage[b].has_value();
+    }
+    if (usage[a]->first_use != usage[b]->first_use) {
+      return usage[a]->first_use < usage[b]->first_use;
+    }
+    return usage[a]->run_count > usage[b]->run_count;
+  });
+  std::vector<PersistentCache::SkSLCache> sorted;
+  sorted.reserve(result.size());
+  for (size_t i : order) {
+    sorted.push_back(std::move(result[i]));
+  }
+
+  return sorted;
 }
 
 PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      sksl_usage_(std::make_shared<SkSLUsageRecord>()) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
+    return;
   }
+  sksl_usage_->Read(*cache_directory_);
 }
 
 PersistentCache::~PersistentCache() = default;
@@ -336,6 +479,7 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (file_name.empty()) {
     return nullptr;
   }
+  RecordSkSLUsage(file_name);
   auto result =
       PersistentCache::LoadFile(*cache_directory_, file_name, false).value;
   if (result != nullptr) {
@@ -413,6 +557,8 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
+  RecordSkSLUsage(file_name);
+
   std::unique_ptr<fml::MallocMapping> mapping = BuildCacheObject(key, data);
   if (!mapping) {
     return;
@@ -423,6 +569,42 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
                        std::move(file_name), std::move(mapping));
 }
 
+void PersistentCache::RecordSkSLUsage(const std::string& file_name) {
+  std::scoped_lock lock(sksl_usage_->mutex);
+  if (!sksl_usage_->used_this_run.insert(file_name).second) {
+    return;
+  }
+  SkSLUsage& usage = sksl_usage_->usage[file_name];
+  usage.first_use = sksl_usage_->used_this_run.size() - 1;
+  usage.run_count++;
+
+  if (is_read_only_ || sksl_usage_->write_pending) {
+    return;
+  }
+  // Unlike the shaders themselves, the usage is not worth writing on the
+  // frame workload. Without a worker, it is written after a later first use.
+  auto worker = GetWorkerTaskRunner();
+  if (!worker) {
+    return;
+  }
+  sksl_usage_->write_pending = true;
+  worker->PostTask([record = sksl_usage_,
+                    cache_directory = cache_directory_]() {
+    TRACE_EVENT0("flutter", "PersistentCache::WriteSkSLUsage");
+    std::string contents;
+    {
+      std::scoped_lock lock(record->mutex);
+      record->write_pending = false;
+      contents = record->Serialize();
+    }
+    fml::DataMapping mapping(
+        std::vector<uint8_t>(contents.begin(), contents.end()));
+    if (!fml::WriteAtomically(*cache_directory, kSkSLUsageFileName, mapping)) {
+      FML_LOG(WARNING) << "Could not write the SkSL usage to persistent store.";
+    }
+  });
+}
+
 void PersistentCache::DumpSkp(const SkData& data) {
   if (is_read_only_ || !IsValid()) {
     FML_LOG(ERROR) << "Could not dump SKP from read-only or invalid persistent "
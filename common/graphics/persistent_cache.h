@@ -7,11 +7,13 @@
 
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/unique_fd.h"
 #include "third_party/skia/include/gpu/GrContextOptions.h"
 
@@ -95,13 +97,32 @@ class PersistentCache : public GrContextOptions::PersistentCache {
     sk_sp<SkData> value;
   };
 
-  /// Load all the SkSL shader caches in the right directory.
+  // How the shader with a given key was used by this and earlier runs.
+  struct SkSLUsage {
+    // The position of the shader in the order in which the shaders were first
+    // used by the latest run that used it.
+    uint32_t first_use = 0;
+    // The number of runs that used the shader.
+    uint32_t run_count = 0;
+  };
+
+  /// Load all the SkSL shader caches in the right directory. The shaders that
+  /// earlier runs used first, and then the ones used by the most runs, come
+  /// first. The shaders without recorded usage come last.
   std::vector<SkSLCache> LoadSkSLs() const;
 
+  /// The recorded usage of the shader with the given key, or std::nullopt if
+  /// neither this run nor an earlier one used it.
+  std::optional<SkSLUsage> GetSkSLUsage(const SkData& key) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Precompile SkSLs packaged with the application and gathered
   ///             during previous runs in the given context.
   ///
+  ///             If an eager SkSL warmup count is set, only that many SkSLs,
+  ///             in the order of |LoadSkSLs|, are precompiled. The others are
+  ///             left to |PrecompilePendingSkSLs|.
+  ///
   /// @warning    The context must be the rendering context. This context may be
   ///             destroyed during application suspension and subsequently
   ///             recreated. The SkSLs must be precompiled again in the new
@@ -111,7 +132,24 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   ///
   /// @return     The number of SkSLs precompiled.
   ///
-  size_t PrecompileKnownSkSLs(GrDirectContext* context) const;
+  size_t PrecompileKnownSkSLs(GrDirectContext* context);
+
+  /// Whether |PrecompileKnownSkSLs| left SkSLs to precompile later.
+  bool HasPendingSkSLs() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Precompile the SkSLs left by the last |PrecompileKnownSkSLs|,
+  ///             one at a time, until the deadline passes.
+  ///
+  /// @param      context   The rendering context to precompile shaders in. If
+  ///                       it is not the context given to the last
+  ///                       |PrecompileKnownSkSLs|, nothing is precompiled.
+  /// @param      deadline  The time after which no SkSL is started.
+  ///
+  /// @return     The number of SkSLs precompiled.
+  ///
+  size_t PrecompilePendingSkSLs(GrDirectContext* context,
+                                fml::TimePoint deadline);
 
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
@@ -129,8 +167,15 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static void MarkStrategySet() { strategy_set_ = true; }
 
+  // The number of SkSLs |PrecompileKnownSkSLs| precompiles, or 0 to
+  // precompile all of them.
+  static size_t eager_sksl_warmup_count() { return eager_sksl_warmup_count_; }
+
+  static void SetEagerSkSLWarmupCount(size_t count);
+
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  static constexpr char kSkSLUsageFileName[] = "io.flutter.sksl_usage";
 
  private:
   static std::string cache_base_path_;
@@ -150,12 +195,25 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // strategy_set_ becomes true.
   static std::atomic<bool> strategy_set_;
 
+  static std::atomic<size_t> eager_sksl_warmup_count_;
+
+  // The usage of the shaders, shared with the tasks that write it to disk.
+  struct SkSLUsageRecord;
+
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
 
+  const std::shared_ptr<SkSLUsageRecord> sksl_usage_;
+
+  // The SkSLs left by |PrecompileKnownSkSLs| for |PrecompilePendingSkSLs|.
+  mutable std::mutex pending_sksls_mutex_;
+  std::vector<SkSLCache> pending_sksls_;
+  size_t next_pending_sksl_ = 0;
+  GrDirectContext* pending_sksls_context_ = nullptr;
+
   bool stored_new_shaders_ = false;
   bool is_dumping_skp_ = false;
 
@@ -165,6 +223,10 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   bool IsValid() const;
 
+  // Record that Skia used the shader stored under |file_name|, and schedule a
+  // write of the usage if this is its first use in this run.
+  void RecordSkSLUsage(const std::string& file_name);
+
   explicit PersistentCache(bool read_only = false);
 
   // |GrContextOptions::PersistentCache|
@@ -21,6 +21,7 @@ void TextureRegistry::RegisterTexture(const std::shared_ptr<Texture>& texture) {
     return;
   }
   mapping_[texture->Id()] = texture;
+  dirty_textures_.insert(texture->Id());
 }
 
 void TextureRegistry::RegisterContextListener(
@@ -42,6 +43,7 @@ void TextureRegistry::UnregisterTexture(int64_t id) {
   }
   found->second->OnTextureUnregistered();
   mapping_.erase(found);
+  dirty_textures_.insert(id);
 }
 
 void TextureRegistry::UnregisterContextListener(uintptr_t id) {
@@ -52,6 +54,7 @@ void TextureRegistry::UnregisterContextListener(uintptr_t id) {
 void TextureRegistry::OnGrContextCreated() {
   for (auto& it : mapping_) {
     it.second->OnGrContextCreated();
+    dirty_textures_.insert(it.first);
   }
 
   // Calling OnGrContextCreated may result in a subsequent call to
@@ -95,4 +98,21 @@ std::shared_ptr<Texture> TextureRegistry::GetTexture(int64_t id) {
   return it != mapping_.end() ? it->second : nullptr;
 }
 
+void TextureRegistry::MarkNewFrameAvailable(int64_t id) {
+  auto texture = GetTexture(id);
+  if (!texture) {
+    return;
+  }
+  texture->MarkNewFrameAvailable();
+  dirty_textures_.insert(id);
+}
+
+bool TextureRegistry::IsTextureDirty(int64_t id) const {
+  return dirty_textures_.find(id) != dirty_textures_.end();
+}
+
+void TextureRegistry::ClearDirtyTextures() {
+  dirty_textures_.clear();
+}
+
 }  // namespace flutter
@@ -6,6 +6,7 @@
 #define FLUTTER_COMMON_GRAPHICS_TEXTURE_H_
 
 #include <map>
+#include <set>
 
 #include "flutter/display_list/dl_canvas.h"
 #include "flutter/fml/macros.h"
@@ -87,6 +88,19 @@ class TextureRegistry {
   // Called from raster thread.
   std::shared_ptr<Texture> GetTexture(int64_t id);
 
+  // Called from raster thread.
+  void MarkNewFrameAvailable(int64_t id);
+
+  // Whether the texture may paint differently than it did in the last
+  // rasterized frame, because it was registered, unregistered, received a
+  // new frame or was re-created with a new context since then.
+  //
+  // Called from raster thread.
+  bool IsTextureDirty(int64_t id) const;
+
+  // Called from raster thread once a frame has been rasterized.
+  void ClearDirtyTextures();
+
   // Called from raster thread.
   void OnGrContextCreated();
 
@@ -95,6 +109,7 @@ class TextureRegistry {
 
  private:
   std::map<int64_t, std::shared_ptr<Texture>> mapping_;
+  std::set<int64_t> dirty_textures_;
   size_t image_counter_;
   // This map keeps track of registered context listeners by their own
   // externally provided id. It indexes into ordered_images_.
@@ -148,6 +148,12 @@ struct Settings {
   bool trace_systrace = false;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
+  // The number of frames to write to disk as serialized DisplayLists, from
+  // the first frame on. The capture is disabled when 0.
+  uint32_t display_list_capture_frame_count = 0;
+  // The directory the captured frames are written to. A temporary directory
+  // is created when empty.
+  std::string display_list_capture_directory;
   bool cache_sksl = false;
   bool purge_persistent_cache = false;
   bool endless_trace_buffer = false;
@@ -221,6 +227,11 @@ struct Settings {
   // must be available to the application.
   bool enable_vulkan_validation = false;
 
+  // Measure the GPU time of the render passes of each frame rendered with
+  // Impeller, and add it to the timeline. Ignored on backends that can't
+  // measure GPU time.
+  bool enable_impeller_gpu_tracing = false;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -309,6 +320,12 @@ struct Settings {
   // Due to this, the buffer must be as small as possible.
   std::shared_ptr<const fml::Mapping> persistent_isolate_data;
 
+  // The number of root isolates the first engine of an engine group keeps
+  // created ahead of time in its isolate group so that spawned engines don't
+  // have to create one on demand, or 0 to disable the pool. Only used when
+  // running precompiled code.
+  size_t spawn_isolate_pool_size = 0;
+
   /// Max size of old gen heap size in MB, or 0 for unlimited, -1 for default
   /// value.
   ///
@@ -319,6 +336,82 @@ struct Settings {
   // Max bytes threshold of resource cache, or 0 for unlimited.
   size_t resource_cache_max_bytes_threshold = 0;
 
+  /// The number of frames the UI thread may produce before the raster thread
+  /// consumes them, or 0 for the platform default. Depths above 1 let the UI
+  /// thread start on the next frame while a slow frame is being rasterized.
+  uint32_t frame_pipeline_depth = 0;
+
+  /// How much later than its vsync target time, in milliseconds, a frame that
+  /// is produced ahead of the raster thread may be expected to be displayed,
+  /// or 0 for no limit. The UI thread waits for the raster thread instead of
+  /// producing frames past this budget.
+  int64_t frame_pipeline_latency_budget_ms = 0;
+
+  /// Start building each frame as late after its vsync as the timings of the
+  /// recent frames predict it can while still being rasterized before its
+  /// target time, instead of right at its vsync. This lets frames include
+  /// input that arrives after their vsync.
+  bool enable_deadline_frame_scheduling = false;
+
+  /// Hint the platform to produce vsyncs at 60Hz for the frames that aren't
+  /// driven by pointer input, and as fast as the display refreshes for the
+  /// others. Only has an effect on variable refresh rate displays.
+  bool enable_adaptive_frame_rate = false;
+
+  /// Dispatch the pointer events to the framework once per frame, with the
+  /// consecutive moves of each device coalesced and their positions resampled
+  /// to the vsync time, instead of the way the platform view dispatches them.
+  bool enable_pointer_resampling = false;
+
+  /// Decode the JPEG and HEIF images with the decoders of the platform, which
+  /// use its hardware decoders and decode straight at the size the image is
+  /// displayed at, in preference to the builtin software decoders.
+  bool prefer_platform_image_decoders = false;
+
+  /// Compress the large opaque images decoded by Impeller to a block
+  /// compressed texture format when they are uploaded, on devices that
+  /// support one, to cut the memory their textures take up.
+  bool enable_image_texture_compression = false;
+
+  /// Keep rasterizing the frames on the raster thread while Android platform
+  /// views are displayed, and hand only the updates of the views off to the
+  /// platform thread, instead of merging the raster thread into the platform
+  /// thread for as long as they are displayed.
+  bool enable_unmerged_platform_views = false;
+
+  /// The number of known SkSLs to precompile when the rendering context is
+  /// created, or 0 to precompile all of them. The SkSLs earlier runs used
+  /// first are precompiled first. The others are precompiled in the time that
+  /// is left before the target time of the frames that follow.
+  uint32_t eager_sksl_warmup_count = 0;
+
+  /// The number of bytes the caches of the engine may take up together. The
+  /// memory governor splits it among the caches, and trims them to their
+  /// share when the platform reports memory pressure. With a budget of 0, the
+  /// caches are only trimmed relative to what they take up.
+  size_t memory_budget_bytes = 0;
+
+  /// The number of times per second the native stacks of the UI and raster
+  /// threads are sampled, or 0 to not sample them. The samples are aggregated
+  /// into a flame graph served by the `_flutter.getNativeStackSamples` service
+  /// protocol extension. Only supported on POSIX platforms.
+  uint32_t native_stack_samples_per_second = 0;
+
+  /// The number of frame budgets by which the target time of a frame may
+  /// have passed when it is about to be rasterized, before the rasterizer
+  /// drops it to rasterize a newer frame that is waiting in the pipeline, or
+  /// 0 to rasterize every frame.
+  uint32_t stale_frame_threshold_frames = 0;
+
+  /// The number of frames between the frames whose layers are timed as they
+  /// paint, or 0 to not time them. The costs of the layers are served by the
+  /// `_flutter.getLayerCosts` service protocol extension.
+  uint32_t layer_cost_sample_interval = 0;
+
+  /// Whether the layers of the last frame whose layers were timed are drawn
+  /// over each frame, tinted by how long they took to paint.
+  bool show_layer_cost_heatmap = false;
+
   /// The minimum number of samples to require in multipsampled anti-aliasing.
   ///
   /// Setting this value to 0 or 1 disables MSAA.
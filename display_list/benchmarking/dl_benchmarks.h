@@ -97,6 +97,7 @@ void BM_SaveLayer(benchmark::State& state,
                   BackendType backend_type,
                   unsigned attributes,
                   size_t save_depth);
+void BM_DispatchDisplayList(benchmark::State& state, bool compacted);
 // clang-format off
 
 // DrawLine
@@ -149,6 +149,65 @@ static void BM_DisplayListBuilderWithSaveLayerAndImageFilter(
   }
 }
 
+enum class DisplayListBuilderStorageType {
+  kRealloc,
+  kArena,
+};
+
+// Records |state.range(0)| draw ops per iteration, as a long scrolling list
+// would, and reports how many bytes of already recorded ops had to be
+// moved as the storage grew along with how much of the storage came from
+// memory recycled from the previous iteration's DisplayList.
+static void BM_DisplayListBuilderStorage(benchmark::State& state,
+                                         DisplayListBuilderStorageType type) {
+  const int op_count = state.range(0);
+  auto arena = type == DisplayListBuilderStorageType::kArena
+                   ? std::make_shared<DlStorageArena>()
+                   : nullptr;
+  DisplayListBuilder builder(DisplayListBuilder::kMaxCullRect,
+                             /*prepare_rtree=*/true, arena);
+  DlPaint paint;
+  size_t bytes_recorded = 0;
+  sk_sp<DisplayList> previous;
+  while (state.KeepRunning()) {
+    for (int i = 0; i < op_count; i++) {
+      SkScalar y = i * 20.0f;
+      paint.setColor(i & 1 ? DlColor::kBlue() : DlColor::kRed());
+      builder.DrawRect(SkRect::MakeXYWH(0, y, 100, 18), paint);
+    }
+    // The previous frame's list stays alive until the new one is built,
+    // as it would while the raster thread is still drawing it.
+    previous = builder.Build();
+    bytes_recorded += previous->bytes(false);
+  }
+  state.counters["BytesRecorded"] = benchmark::Counter(
+      bytes_recorded, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["BytesCopied"] =
+      benchmark::Counter(builder.bytes_relocated(),
+                         benchmark::Counter::kAvgIterations);
+  if (arena) {
+    state.counters["ChunksAllocated"] =
+        benchmark::Counter(arena->allocated_chunk_count(),
+                           benchmark::Counter::kAvgIterations);
+    state.counters["ChunksRecycled"] =
+        benchmark::Counter(arena->recycled_chunk_count(),
+                           benchmark::Counter::kAvgIterations);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_DisplayListBuilderStorage,
+                  kRealloc,
+                  DisplayListBuilderStorageType::kRealloc)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 16)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderStorage,
+                  kArena,
+                  DisplayListBuilderStorageType::kArena)
+    ->RangeMultiplier(4)
+    ->Range(1 << 8, 1 << 16)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
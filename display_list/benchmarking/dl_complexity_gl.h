@@ -15,9 +15,23 @@ class DisplayListGLComplexityCalculator
   static DisplayListGLComplexityCalculator* GetInstance();
 
   unsigned int Compute(const DisplayList* display_list) override {
+    // Scores computed with a lowered ceiling may be truncated.
+    bool cacheable = ceiling_ == std::numeric_limits<unsigned int>::max();
+    if (cacheable) {
+      auto cached = display_list->GetCachedComplexityScore(
+          DisplayList::ComplexityScorer::kGL);
+      if (cached.has_value()) {
+        return cached.value();
+      }
+    }
     GLHelper helper(ceiling_);
     display_list->Dispatch(helper);
-    return helper.ComplexityScore();
+    unsigned int score = helper.ComplexityScore();
+    if (cacheable) {
+      display_list->SetCachedComplexityScore(
+          DisplayList::ComplexityScorer::kGL, score);
+    }
+    return score;
   }
 
   bool ShouldBeCached(unsigned int complexity_score) override {
@@ -15,9 +15,23 @@ class DisplayListMetalComplexityCalculator
   static DisplayListMetalComplexityCalculator* GetInstance();
 
   unsigned int Compute(const DisplayList* display_list) override {
+    // Scores computed with a lowered ceiling may be truncated.
+    bool cacheable = ceiling_ == std::numeric_limits<unsigned int>::max();
+    if (cacheable) {
+      auto cached = display_list->GetCachedComplexityScore(
+          DisplayList::ComplexityScorer::kMetal);
+      if (cached.has_value()) {
+        return cached.value();
+      }
+    }
     MetalHelper helper(ceiling_);
     display_list->Dispatch(helper);
-    return helper.ComplexityScore();
+    unsigned int score = helper.ComplexityScore();
+    if (cacheable) {
+      display_list->SetCachedComplexityScore(
+          DisplayList::ComplexityScorer::kMetal, score);
+    }
+    return score;
   }
 
   bool ShouldBeCached(unsigned int complexity_score) override {
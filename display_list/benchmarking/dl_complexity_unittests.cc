@@ -64,6 +64,34 @@ TEST(DisplayListComplexity, DisplayListCeiling) {
   }
 }
 
+TEST(DisplayListComplexity, ScoresAreCachedByTheDisplayList) {
+  auto display_list = GetSampleDisplayList();
+  ASSERT_FALSE(display_list
+                   ->GetCachedComplexityScore(
+                       DisplayList::ComplexityScorer::kGL)
+                   .has_value());
+
+  auto calculator = DisplayListGLComplexityCalculator::GetInstance();
+  calculator->SetComplexityCeiling(10u);
+  ASSERT_EQ(calculator->Compute(display_list.get()), 10u);
+  // Scores limited by a ceiling are not cached.
+  ASSERT_FALSE(display_list
+                   ->GetCachedComplexityScore(
+                       DisplayList::ComplexityScorer::kGL)
+                   .has_value());
+  calculator->SetComplexityCeiling(std::numeric_limits<unsigned int>::max());
+
+  unsigned int score = calculator->Compute(display_list.get());
+  ASSERT_EQ(display_list->GetCachedComplexityScore(
+                DisplayList::ComplexityScorer::kGL),
+            score);
+  ASSERT_EQ(calculator->Compute(display_list.get()), score);
+  ASSERT_FALSE(display_list
+                   ->GetCachedComplexityScore(
+                       DisplayList::ComplexityScorer::kMetal)
+                   .has_value());
+}
+
 TEST(DisplayListComplexity, NestedDisplayList) {
   auto display_list = GetSampleNestedDisplayList();
 
@@ -0,0 +1,241 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays the frames captured with `--capture-display-lists` and reports how
+// long each of them takes to render.
+//
+// Usage:
+//   dl_replay --captures=<directory> [--backend=<backend>] [--iterations=<n>]
+//
+// The backends are `software`, `opengl` and `metal`, which render the frames
+// with Skia, and `impeller`, which times the translation of the frames into
+// Impeller pictures.
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/dl_serialization.h"
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/display_list/testing/dl_test_surface_provider.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_point.h"
+
+#ifdef DL_REPLAY_ENABLE_IMPELLER
+#include "flutter/impeller/display_list/display_list_dispatcher.h"  // nogncheck
+#endif  // DL_REPLAY_ENABLE_IMPELLER
+
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+namespace {
+
+using BackendType = DlSurfaceProvider::BackendType;
+
+struct FrameTimes {
+  std::string file_name;
+  DlCapturedFrame frame;
+  std::vector<fml::TimeDelta> times;
+
+  fml::TimeDelta Median() const { return times[times.size() / 2]; }
+};
+
+class Renderer {
+ public:
+  virtual ~Renderer() = default;
+
+  virtual bool Prepare(const SkISize& frame_size) = 0;
+
+  virtual void Render(const sk_sp<DisplayList>& display_list) = 0;
+};
+
+class SkiaRenderer final : public Renderer {
+ public:
+  explicit SkiaRenderer(std::unique_ptr<DlSurfaceProvider> provider)
+      : provider_(std::move(provider)) {}
+
+  bool Prepare(const SkISize& frame_size) override {
+    if (surface_ && frame_size == frame_size_) {
+      return true;
+    }
+    if (!provider_->InitializeSurface(frame_size.width(),
+                                      frame_size.height())) {
+      return false;
+    }
+    frame_size_ = frame_size;
+    auto instance = provider_->GetPrimarySurface();
+    surface_ = instance ? instance->sk_surface() : nullptr;
+    return surface_ != nullptr;
+  }
+
+  void Render(const sk_sp<DisplayList>& display_list) override {
+    DlSkCanvasAdapter canvas(surface_->getCanvas());
+    canvas.Clear(DlColor::kTransparent());
+    canvas.DrawDisplayList(display_list);
+    // Waits for the GPU so that the time includes the rendering itself.
+    surface_->flushAndSubmit(true);
+  }
+
+ private:
+  std::unique_ptr<DlSurfaceProvider> provider_;
+  SkISize frame_size_ = SkISize::MakeEmpty();
+  sk_sp<SkSurface> surface_;
+};
+
+#ifdef DL_REPLAY_ENABLE_IMPELLER
+class ImpellerRecordingRenderer final : public Renderer {
+ public:
+  bool Prepare(const SkISize& frame_size) override { return true; }
+
+  void Render(const sk_sp<DisplayList>& display_list) override {
+    impeller::DisplayListDispatcher dispatcher;
+    display_list->Dispatch(dispatcher);
+    dispatcher.EndRecordingAsPicture();
+  }
+};
+#endif  // DL_REPLAY_ENABLE_IMPELLER
+
+std::unique_ptr<Renderer> CreateRenderer(const std::string& backend) {
+  if (backend == "impeller") {
+#ifdef DL_REPLAY_ENABLE_IMPELLER
+    return std::make_unique<ImpellerRecordingRenderer>();
+#else
+    return nullptr;
+#endif  // DL_REPLAY_ENABLE_IMPELLER
+  }
+  BackendType backend_type;
+  if (backend == "software") {
+    backend_type = BackendType::kSoftware_Backend;
+  } else if (backend == "opengl") {
+    backend_type = BackendType::kOpenGL_Backend;
+  } else if (backend == "metal") {
+    backend_type = BackendType::kMetal_Backend;
+  } else {
+    return nullptr;
+  }
+  auto provider = DlSurfaceProvider::Create(backend_type);
+  if (!provider) {
+    return nullptr;
+  }
+  return std::make_unique<SkiaRenderer>(std::move(provider));
+}
+
+std::vector<FrameTimes> LoadFrames(const std::string& path) {
+  std::vector<FrameTimes> frames;
+  auto directory =
+      fml::OpenDirectory(path.c_str(), false, fml::FilePermission::kRead);
+  if (!directory.is_valid()) {
+    std::cerr << "Could not open " << path << "." << std::endl;
+    return frames;
+  }
+  std::vector<std::string> file_names;
+  fml::VisitFiles(directory, [&file_names](const fml::UniqueFD& directory,
+                                           const std::string& file_name) {
+    if (file_name.size() > 8 &&
+        file_name.compare(file_name.size() - 8, 8, ".dlframe") == 0) {
+      file_names.push_back(file_name);
+    }
+    return true;
+  });
+  std::sort(file_names.begin(), file_names.end());
+
+  for (const auto& file_name : file_names) {
+    auto mapping = fml::FileMapping::CreateReadOnly(directory, file_name);
+    if (!mapping) {
+      std::cerr << "Could not read " << file_name << "." << std::endl;
+      continue;
+    }
+    auto frame =
+        DlDeserializeCapturedFrame(mapping->GetMapping(), mapping->GetSize());
+    if (!frame.has_value() || frame->frame_size.isEmpty()) {
+      std::cerr << "Skipping the invalid frame " << file_name << "."
+                << std::endl;
+      continue;
+    }
+    frames.push_back({file_name, std::move(frame.value()), {}});
+  }
+  return frames;
+}
+
+int Main(int argc, char** argv) {
+  auto command_line = fml::CommandLineFromArgcArgv(argc, argv);
+  std::string captures;
+  if (!command_line.GetOptionValue("captures", &captures)) {
+    std::cerr << "Usage: dl_replay --captures=<directory> "
+                 "[--backend=software|opengl|metal|impeller] "
+                 "[--iterations=<n>]"
+              << std::endl;
+    return 1;
+  }
+  const std::string backend =
+      command_line.GetOptionValueWithDefault("backend", "software");
+  const int iterations = std::max(
+      1, std::stoi(command_line.GetOptionValueWithDefault("iterations", "10")));
+
+  auto renderer = CreateRenderer(backend);
+  if (!renderer) {
+    std::cerr << "The " << backend << " backend is not available."
+              << std::endl;
+    return 1;
+  }
+
+  auto frames = LoadFrames(captures);
+  if (frames.empty()) {
+    std::cerr << "No frames to replay in " << captures << "." << std::endl;
+    return 1;
+  }
+
+  for (auto& frame : frames) {
+    if (!renderer->Prepare(frame.frame.frame_size)) {
+      std::cerr << "Could not create a surface for " << frame.file_name << "."
+                << std::endl;
+      return 1;
+    }
+    // The first run warms up the caches and is not reported.
+    renderer->Render(frame.frame.display_list);
+    for (int i = 0; i < iterations; i++) {
+      const auto start = fml::TimePoint::Now();
+      renderer->Render(frame.frame.display_list);
+      frame.times.push_back(fml::TimePoint::Now() - start);
+    }
+    std::sort(frame.times.begin(), frame.times.end());
+  }
+
+  std::cout << std::fixed << std::setprecision(3);
+  fml::TimeDelta total;
+  const FrameTimes* slowest = &frames.front();
+  for (const auto& frame : frames) {
+    std::cout << frame.file_name << " frame=" << frame.frame.frame_number
+              << " size=" << frame.frame.frame_size.width() << "x"
+              << frame.frame.frame_size.height()
+              << " ops=" << frame.frame.display_list->op_count(true)
+              << " min=" << frame.times.front().ToMillisecondsF() << "ms"
+              << " median=" << frame.Median().ToMillisecondsF() << "ms"
+              << " max=" << frame.times.back().ToMillisecondsF() << "ms"
+              << std::endl;
+    total = total + frame.Median();
+    if (frame.Median() > slowest->Median()) {
+      slowest = &frame;
+    }
+  }
+  std::cout << "backend=" << backend << " frames=" << frames.size()
+            << " average_median="
+            << total.ToMillisecondsF() / frames.size() << "ms"
+            << " slowest=" << slowest->file_name << " ("
+            << slowest->Median().ToMillisecondsF() << "ms)" << std::endl;
+  return 0;
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace flutter
+
+int main(int argc, char** argv) {
+  return flutter::testing::Main(argc, argv);
+}
@@ -2,10 +2,18 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <thread>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_compact_ops.h"
 #include "flutter/display_list/dl_op_records.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -14,12 +22,18 @@ const SaveLayerOptions SaveLayerOptions::kNoAttributes = SaveLayerOptions();
 const SaveLayerOptions SaveLayerOptions::kWithAttributes =
     kNoAttributes.with_renders_with_attributes();
 
+static fml::MemoryCounter& GetDisplayListMemoryCounter() {
+  static auto& counter = fml::MemoryCounter::Get("display_list");
+  return counter;
+}
+
 DisplayList::DisplayList()
     : byte_count_(0),
       op_count_(0),
       nested_byte_count_(0),
       nested_op_count_(0),
       unique_id_(0),
+      content_hash_(0),
       bounds_({0, 0, 0, 0}),
       can_apply_group_opacity_(true) {}
 
@@ -37,13 +51,45 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
       nested_byte_count_(nested_byte_count),
       nested_op_count_(nested_op_count),
       unique_id_(next_unique_id()),
+      content_hash_(ComputeContentHash()),
       bounds_(bounds),
       can_apply_group_opacity_(can_apply_group_opacity),
-      rtree_(std::move(rtree)) {}
+      rtree_(std::move(rtree)),
+      memory_count_(GetDisplayListMemoryCounter(), byte_count) {}
+
+DisplayList::DisplayList(const DisplayList& display_list,
+                         std::unique_ptr<const DlCompactOps> compact_ops)
+    : byte_count_(compact_ops->bytes()),
+      op_count_(display_list.op_count_),
+      nested_byte_count_(display_list.nested_byte_count_),
+      nested_op_count_(display_list.nested_op_count_),
+      unique_id_(display_list.unique_id_),
+      content_hash_(display_list.content_hash_),
+      bounds_(display_list.bounds_),
+      can_apply_group_opacity_(display_list.can_apply_group_opacity_),
+      rtree_(display_list.rtree_),
+      compact_ops_(std::move(compact_ops)),
+      memory_count_(GetDisplayListMemoryCounter(), byte_count_) {}
 
 DisplayList::~DisplayList() {
-  uint8_t* ptr = storage_.get();
-  DisposeOps(ptr, ptr + byte_count_);
+  if (compact_ops_) {
+    return;
+  }
+  storage_.ForEachSegment(byte_count_, [](uint8_t* ptr, uint8_t* end) {
+    DisposeOps(ptr, end);
+    return true;
+  });
+}
+
+sk_sp<const DisplayList> DisplayList::Compacted() const {
+  if (compact_ops_) {
+    return sk_ref_sp(this);
+  }
+  TRACE_EVENT0("flutter", "DisplayList::Compacted");
+  auto compact_ops =
+      std::make_unique<const DlCompactOps>(storage_, byte_count_);
+  return sk_sp<const DisplayList>(
+      new DisplayList(*this, std::move(compact_ops)));
 }
 
 uint32_t DisplayList::next_unique_id() {
@@ -55,6 +101,40 @@ uint32_t DisplayList::next_unique_id() {
   return id;
 }
 
+static inline uint64_t MixContentHash(uint64_t hash, uint64_t value) {
+  hash = (hash ^ value) * 0x9e3779b97f4a7c15u;
+  return hash ^ (hash >> 29);
+}
+
+uint64_t DisplayList::ComputeContentHash() const {
+  uint64_t hash = MixContentHash(0, op_count_);
+  // The builder zero fills the records, so their padding is always 0 and
+  // the records can be hashed word by word.
+  storage_.ForEachSegment(byte_count_, [&hash](uint8_t* ptr, uint8_t* end) {
+    while (ptr < end) {
+      auto op = reinterpret_cast<const DLOp*>(ptr);
+      const uint32_t* words = reinterpret_cast<const uint32_t*>(ptr);
+      if (op->type == DisplayListOpType::kDrawDisplayList) {
+        // Nested lists are hashed by content so that outer lists that nest
+        // equal (but not interned) lists also hash the same.
+        auto draw = static_cast<const DrawDisplayListOp*>(op);
+        uint32_t opacity_bits;
+        memcpy(&opacity_bits, &draw->opacity, sizeof(opacity_bits));
+        hash = MixContentHash(hash, words[0]);
+        hash = MixContentHash(hash, opacity_bits);
+        hash = MixContentHash(hash, draw->display_list->content_hash());
+      } else {
+        for (size_t i = 0; i < op->size / sizeof(uint32_t); i++) {
+          hash = MixContentHash(hash, words[i]);
+        }
+      }
+      ptr += op->size;
+    }
+    return true;
+  });
+  return hash;
+}
+
 class Culler {
  public:
   virtual ~Culler() = default;
@@ -133,8 +213,7 @@ class VectorCuller final : public Culler {
 };
 
 void DisplayList::Dispatch(DlOpReceiver& receiver) const {
-  uint8_t* ptr = storage_.get();
-  Dispatch(receiver, ptr, ptr + byte_count_, NopCuller::instance);
+  Dispatch(receiver, NopCuller::instance);
 }
 
 void DisplayList::Dispatch(DlOpReceiver& receiver,
@@ -153,17 +232,121 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
     Dispatch(receiver);
     return;
   }
-  uint8_t* ptr = storage_.get();
   std::vector<int> rect_indices;
   rtree->search(cull_rect, &rect_indices);
   VectorCuller culler(rtree, rect_indices);
-  Dispatch(receiver, ptr, ptr + byte_count_, culler);
+  Dispatch(receiver, culler);
 }
 
-void DisplayList::Dispatch(DlOpReceiver& receiver,
-                           uint8_t* ptr,
-                           uint8_t* end,
-                           Culler& culler) const {
+void DisplayList::DispatchTiled(
+    const SkIRect& cull_rect,
+    const SkISize& tile_size,
+    const std::shared_ptr<fml::BasicTaskRunner>& runner,
+    const TileReceiverFactory& factory) const {
+  TRACE_EVENT0("flutter", "DisplayList::DispatchTiled");
+  if (cull_rect.isEmpty()) {
+    return;
+  }
+  if (!has_rtree() || !runner || tile_size.isEmpty()) {
+    std::unique_ptr<DlOpReceiver> receiver = factory(cull_rect);
+    if (receiver) {
+      if (has_rtree()) {
+        Dispatch(*receiver, SkRect::Make(cull_rect));
+      } else {
+        Dispatch(*receiver);
+      }
+    }
+    return;
+  }
+
+  struct TiledDispatchState {
+    TiledDispatchState(sk_sp<const DisplayList> display_list,
+                       TileReceiverFactory factory,
+                       std::vector<SkIRect> tiles,
+                       std::vector<std::vector<int>> tile_rect_indices)
+        : display_list(std::move(display_list)),
+          factory(std::move(factory)),
+          tiles(std::move(tiles)),
+          tile_rect_indices(std::move(tile_rect_indices)),
+          latch(this->tiles.size()) {}
+
+    const sk_sp<const DisplayList> display_list;
+    const TileReceiverFactory factory;
+    const std::vector<SkIRect> tiles;
+    const std::vector<std::vector<int>> tile_rect_indices;
+    std::atomic_size_t next_tile = 0;
+    fml::CountDownLatch latch;
+  };
+
+  std::vector<SkIRect> tiles;
+  std::vector<SkRect> queries;
+  for (int32_t y = cull_rect.fTop; y < cull_rect.fBottom;
+       y += tile_size.height()) {
+    for (int32_t x = cull_rect.fLeft; x < cull_rect.fRight;
+         x += tile_size.width()) {
+      tiles.push_back(SkIRect::MakeLTRB(
+          x, y, std::min(x + tile_size.width(), cull_rect.fRight),
+          std::min(y + tile_size.height(), cull_rect.fBottom)));
+      queries.push_back(SkRect::Make(tiles.back()));
+    }
+  }
+
+  // The R-Tree is searched for all of the tiles in a single pass, and
+  // the tiles that contain no rendering ops are dropped before any work
+  // is handed out.
+  std::vector<std::vector<int>> all_rect_indices;
+  rtree()->searchAll(queries, &all_rect_indices);
+  std::vector<SkIRect> drawn_tiles;
+  std::vector<std::vector<int>> tile_rect_indices;
+  for (size_t i = 0; i < tiles.size(); i++) {
+    if (!all_rect_indices[i].empty()) {
+      drawn_tiles.push_back(tiles[i]);
+      tile_rect_indices.push_back(std::move(all_rect_indices[i]));
+    }
+  }
+  size_t tile_count = drawn_tiles.size();
+  if (tile_count == 0) {
+    return;
+  }
+  auto state = std::make_shared<TiledDispatchState>(
+      sk_ref_sp(this), factory, std::move(drawn_tiles),
+      std::move(tile_rect_indices));
+
+  // Each worker claims tiles until there are none left, so a worker that
+  // only gets to run after the calling thread has finished all of the
+  // tiles has nothing to do and the number of posted tasks only needs to
+  // be enough to occupy the worker pool.
+  auto run_tiles = [state]() {
+    size_t index;
+    while ((index = state->next_tile.fetch_add(1)) < state->tiles.size()) {
+      state->display_list->DispatchTile(state->tiles[index],
+                                        state->tile_rect_indices[index],
+                                        state->factory);
+      state->latch.CountDown();
+    }
+  };
+  size_t helper_count =
+      std::min<size_t>(tile_count - 1, std::thread::hardware_concurrency());
+  for (size_t i = 0; i < helper_count; i++) {
+    runner->PostTask(run_tiles);
+  }
+  run_tiles();
+  state->latch.Wait();
+}
+
+void DisplayList::DispatchTile(const SkIRect& tile,
+                               const std::vector<int>& rect_indices,
+                               const TileReceiverFactory& factory) const {
+  TRACE_EVENT0("flutter", "DisplayList::DispatchTile");
+  std::unique_ptr<DlOpReceiver> receiver = factory(tile);
+  if (!receiver) {
+    return;
+  }
+  VectorCuller culler(rtree().get(), rect_indices);
+  Dispatch(*receiver, culler);
+}
+
+void DisplayList::Dispatch(DlOpReceiver& receiver, Culler& culler) const {
   DispatchContext context = {
       .receiver = receiver,
       .cur_index = 0,
@@ -173,29 +356,58 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
   if (!culler.init(context)) {
     return;
   }
-  while (ptr < end) {
-    auto op = reinterpret_cast<const DLOp*>(ptr);
-    ptr += op->size;
-    FML_DCHECK(ptr <= end);
-    switch (op->type) {
+  if (compact_ops_) {
+    DlCompactOps::Reader reader(*compact_ops_);
+    while (const DLOp* op = reader.Next()) {
+      if (!DispatchOp(context, op)) {
+        return;
+      }
+      culler.update(context);
+    }
+    return;
+  }
+  // The context, and therefore the op indices, carry over from one
+  // segment to the next when the records are stored in chunks.
+  storage_.ForEachSegment(
+      byte_count_, [&context, &culler](uint8_t* ptr, uint8_t* end) {
+        return DispatchOps(context, ptr, end, culler);
+      });
+}
+
+bool DisplayList::DispatchOp(DispatchContext& context, const DLOp* op) {
+  switch (op->type) {
 #define DL_OP_DISPATCH(name)                             \
   case DisplayListOpType::k##name:                       \
     static_cast<const name##Op*>(op)->dispatch(context); \
-    break;
+    return true;
 
-      FOR_EACH_DISPLAY_LIST_OP(DL_OP_DISPATCH)
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_DISPATCH)
 #ifdef IMPELLER_ENABLE_3D
-      DL_OP_DISPATCH(SetSceneColorSource)
+    DL_OP_DISPATCH(SetSceneColorSource)
 #endif  // IMPELLER_ENABLE_3D
 
 #undef DL_OP_DISPATCH
 
-      default:
-        FML_DCHECK(false);
-        return;
+    default:
+      FML_DCHECK(false);
+      return false;
+  }
+}
+
+bool DisplayList::DispatchOps(DispatchContext& context,
+                              uint8_t* ptr,
+                              uint8_t* end,
+                              Culler& culler) {
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    ptr += op->size;
+    FML_DCHECK(ptr <= end);
+    if (!DispatchOp(context, op)) {
+      return false;
     }
     culler.update(context);
   }
+  return true;
 }
 
 void DisplayList::DisposeOps(uint8_t* ptr, uint8_t* end) {
@@ -225,6 +437,27 @@ void DisplayList::DisposeOps(uint8_t* ptr, uint8_t* end) {
   }
 }
 
+// Compares two op records of the same type and size.
+static DisplayListCompare CompareOpRecords(const DLOp* opA, const DLOp* opB) {
+  switch (opA->type) {
+#define DL_OP_EQUALS(name)                            \
+  case DisplayListOpType::k##name:                    \
+    return static_cast<const name##Op*>(opA)->equals( \
+        static_cast<const name##Op*>(opB));
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_EQUALS)
+#ifdef IMPELLER_ENABLE_3D
+    DL_OP_EQUALS(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+
+#undef DL_OP_EQUALS
+
+    default:
+      FML_DCHECK(false);
+      return DisplayListCompare::kNotEqual;
+  }
+}
+
 static bool CompareOps(uint8_t* ptrA,
                        uint8_t* endA,
                        uint8_t* ptrB,
@@ -244,26 +477,7 @@ static bool CompareOps(uint8_t* ptrA,
     ptrB += opB->size;
     FML_DCHECK(ptrA <= endA);
     FML_DCHECK(ptrB <= endB);
-    DisplayListCompare result;
-    switch (opA->type) {
-#define DL_OP_EQUALS(name)                              \
-  case DisplayListOpType::k##name:                      \
-    result = static_cast<const name##Op*>(opA)->equals( \
-        static_cast<const name##Op*>(opB));             \
-    break;
-
-      FOR_EACH_DISPLAY_LIST_OP(DL_OP_EQUALS)
-#ifdef IMPELLER_ENABLE_3D
-      DL_OP_EQUALS(SetSceneColorSource)
-#endif  // IMPELLER_ENABLE_3D
-
-#undef DL_OP_EQUALS
-
-      default:
-        FML_DCHECK(false);
-        return false;
-    }
-    switch (result) {
+    switch (CompareOpRecords(opA, opB)) {
       case DisplayListCompare::kNotEqual:
         return false;
       case DisplayListCompare::kUseBulkCompare:
@@ -294,11 +508,105 @@ static bool CompareOps(uint8_t* ptrA,
   return true;
 }
 
+// Walks the op records of a possibly chunked storage one at a time.
+class OpRecordIterator {
+ public:
+  OpRecordIterator(const DisplayListStorage& storage, size_t byte_count) {
+    storage.ForEachSegment(byte_count, [this](uint8_t* ptr, uint8_t* end) {
+      segments_.emplace_back(ptr, end);
+      return true;
+    });
+    segment_ = segments_.begin();
+    ptr_ = segment_ == segments_.end() ? nullptr : segment_->first;
+  }
+
+  // Returns the next op record or nullptr if there are no more records.
+  const DLOp* Next() {
+    while (segment_ != segments_.end()) {
+      if (ptr_ < segment_->second) {
+        auto op = reinterpret_cast<const DLOp*>(ptr_);
+        ptr_ += op->size;
+        FML_DCHECK(ptr_ <= segment_->second);
+        return op;
+      }
+      if (++segment_ != segments_.end()) {
+        ptr_ = segment_->first;
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  std::vector<std::pair<uint8_t*, uint8_t*>> segments_;
+  std::vector<std::pair<uint8_t*, uint8_t*>>::const_iterator segment_;
+  uint8_t* ptr_;
+};
+
+// Walks the op records of a DisplayList one at a time, decoding them if the
+// list is compacted.
+class DisplayList::RecordIterator {
+ public:
+  explicit RecordIterator(const DisplayList& display_list) {
+    if (display_list.compact_ops_) {
+      compact_reader_.emplace(*display_list.compact_ops_);
+    } else {
+      record_iterator_.emplace(display_list.storage_, display_list.byte_count_);
+    }
+  }
+
+  // Returns the next op record or nullptr if there are no more records.
+  const DLOp* Next() {
+    return compact_reader_ ? compact_reader_->Next() : record_iterator_->Next();
+  }
+
+ private:
+  std::optional<OpRecordIterator> record_iterator_;
+  std::optional<DlCompactOps::Reader> compact_reader_;
+};
+
+// Compares the records op by op, for use when either list stores its
+// records in chunks whose boundaries need not line up with the other list,
+// or is compacted.
+template <typename Iterator>
+static bool CompareOpsOneByOne(Iterator& iterA, Iterator& iterB) {
+  while (true) {
+    const DLOp* opA = iterA.Next();
+    const DLOp* opB = iterB.Next();
+    if (opA == nullptr || opB == nullptr) {
+      return opA == opB;
+    }
+    if (opA->type != opB->type || opA->size != opB->size) {
+      return false;
+    }
+    switch (CompareOpRecords(opA, opB)) {
+      case DisplayListCompare::kNotEqual:
+        return false;
+      case DisplayListCompare::kUseBulkCompare:
+        if (memcmp(opA, opB, opA->size) != 0) {
+          return false;
+        }
+        break;
+      case DisplayListCompare::kEqual:
+        break;
+    }
+  }
+}
+
 bool DisplayList::Equals(const DisplayList* other) const {
   if (this == other) {
     return true;
   }
-  if (byte_count_ != other->byte_count_ || op_count_ != other->op_count_) {
+  if (op_count_ != other->op_count_) {
+    return false;
+  }
+  // The encoded size of a compacted list depends on the values of its
+  // records, so only the records themselves can be compared.
+  if (compact_ops_ || other->compact_ops_) {
+    RecordIterator iterA(*this);
+    RecordIterator iterB(*other);
+    return CompareOpsOneByOne(iterA, iterB);
+  }
+  if (byte_count_ != other->byte_count_) {
     return false;
   }
   uint8_t* ptr = storage_.get();
@@ -306,6 +614,11 @@ bool DisplayList::Equals(const DisplayList* other) const {
   if (ptr == o_ptr) {
     return true;
   }
+  if (storage_.is_chunked() || other->storage_.is_chunked()) {
+    RecordIterator iterA(*this);
+    RecordIterator iterB(*other);
+    return CompareOpsOneByOne(iterA, iterB);
+  }
   return CompareOps(ptr, ptr + byte_count_, o_ptr, o_ptr + other->byte_count_);
 }
 
@@ -5,12 +5,17 @@
 #ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <optional>
 
 #include "flutter/display_list/dl_sampling_options.h"
+#include "flutter/display_list/dl_storage.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/memory/memory_counter.h"
+#include "flutter/fml/task_runner.h"
 
 // The Flutter DisplayList mechanism encapsulates a persistent sequence of
 // rendering operations.
@@ -202,27 +207,10 @@ class SaveLayerOptions {
   };
 };
 
-// Manages a buffer allocated with malloc.
-class DisplayListStorage {
- public:
-  DisplayListStorage() = default;
-  DisplayListStorage(DisplayListStorage&&) = default;
-
-  uint8_t* get() const { return ptr_.get(); }
-
-  void realloc(size_t count) {
-    ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
-    FML_CHECK(ptr_);
-  }
-
- private:
-  struct FreeDeleter {
-    void operator()(uint8_t* p) { std::free(p); }
-  };
-  std::unique_ptr<uint8_t, FreeDeleter> ptr_;
-};
-
 class Culler;
+class DlCompactOps;
+struct DispatchContext;
+struct DLOp;
 
 // The base class that contains a sequence of rendering operations
 // for dispatch to a DlOpReceiver. These objects must be instantiated
@@ -236,6 +224,31 @@ class DisplayList : public SkRefCnt {
   void Dispatch(DlOpReceiver& ctx) const;
   void Dispatch(DlOpReceiver& ctx, const SkRect& cull_rect) const;
 
+  // Supplies the receiver for one tile of a |DispatchTiled| operation.
+  // The factory is invoked concurrently on the threads performing the
+  // dispatch and only for tiles that the R-Tree shows contain rendering
+  // ops. The returned receiver is destroyed on the same thread once all
+  // of the ops for its tile have been dispatched to it. A null return
+  // value skips the tile.
+  using TileReceiverFactory =
+      std::function<std::unique_ptr<DlOpReceiver>(const SkIRect& tile)>;
+
+  // Splits |cull_rect| into tiles of at most |tile_size| and dispatches
+  // the ops that intersect each tile, as determined by the R-Tree, to a
+  // receiver obtained from |factory| for that tile. The tiles are
+  // processed concurrently on |runner| and on the calling thread, and the
+  // call returns when all tiles are complete. Since the calling thread
+  // participates, it is safe to call this from a thread of the pool that
+  // backs |runner|.
+  //
+  // If the DisplayList has no R-Tree, or no |runner| is supplied, the
+  // whole |cull_rect| is dispatched as a single tile on the calling
+  // thread.
+  void DispatchTiled(const SkIRect& cull_rect,
+                     const SkISize& tile_size,
+                     const std::shared_ptr<fml::BasicTaskRunner>& runner,
+                     const TileReceiverFactory& factory) const;
+
   // From historical behavior, SkPicture always included nested bytes,
   // but nested ops are only included if requested. The defaults used
   // here for these accessors follow that pattern.
@@ -250,6 +263,12 @@ class DisplayList : public SkRefCnt {
 
   uint32_t unique_id() const { return unique_id_; }
 
+  // A hash of the op records computed when the list is built. Lists that
+  // were recorded with the same calls have the same hash, as long as the
+  // objects they reference, other than nested DisplayLists, are the same
+  // objects. See |DlInterningTable|.
+  uint64_t content_hash() const { return content_hash_; }
+
   const SkRect& bounds() const { return bounds_; }
 
   bool has_rtree() const { return rtree_ != nullptr; }
@@ -263,6 +282,44 @@ class DisplayList : public SkRefCnt {
 
   bool can_apply_group_opacity() const { return can_apply_group_opacity_; }
 
+  // The complexity scorers whose scores are cached by each list, see
+  // |DisplayListComplexityCalculator|.
+  enum class ComplexityScorer {
+    kGL,
+    kMetal,
+  };
+  static constexpr size_t kComplexityScorerCount = 2;
+
+  // Returns the complexity score previously stored for |scorer| with
+  // |SetCachedComplexityScore|, if any. Since the list never changes, the
+  // score only needs to be computed once however many frames consider
+  // the list for raster caching.
+  std::optional<unsigned int> GetCachedComplexityScore(
+      ComplexityScorer scorer) const {
+    uint64_t score = complexity_scores_[static_cast<size_t>(scorer)].load(
+        std::memory_order_relaxed);
+    if (score == kNoComplexityScore) {
+      return std::nullopt;
+    }
+    return static_cast<unsigned int>(score);
+  }
+
+  void SetCachedComplexityScore(ComplexityScorer scorer,
+                                unsigned int score) const {
+    complexity_scores_[static_cast<size_t>(scorer)].store(
+        score, std::memory_order_relaxed);
+  }
+
+  // Returns a DisplayList with the same ops, unique id, bounds and R-Tree
+  // that stores its op records in a compact encoding, see |DlCompactOps|.
+  // The compact encoding uses much less memory for large lists at the
+  // cost of decoding the records on every dispatch, so it is meant for
+  // lists that are retained for a long time rather than rebuilt on every
+  // frame. Returns this list if it is already compacted.
+  sk_sp<const DisplayList> Compacted() const;
+
+  bool is_compacted() const { return compact_ops_ != nullptr; }
+
   static void DisposeOps(uint8_t* ptr, uint8_t* end);
 
  private:
@@ -275,8 +332,13 @@ class DisplayList : public SkRefCnt {
               bool can_apply_group_opacity,
               sk_sp<const DlRTree> rtree);
 
+  DisplayList(const DisplayList& display_list,
+              std::unique_ptr<const DlCompactOps> compact_ops);
+
   static uint32_t next_unique_id();
 
+  uint64_t ComputeContentHash() const;
+
   const DisplayListStorage storage_;
   const size_t byte_count_;
   const unsigned int op_count_;
@@ -285,15 +347,33 @@ class DisplayList : public SkRefCnt {
   const unsigned int nested_op_count_;
 
   const uint32_t unique_id_;
+  const uint64_t content_hash_;
   const SkRect bounds_;
 
   const bool can_apply_group_opacity_;
   const sk_sp<const DlRTree> rtree_;
 
-  void Dispatch(DlOpReceiver& ctx,
-                uint8_t* ptr,
-                uint8_t* end,
-                Culler& culler) const;
+  static constexpr uint64_t kNoComplexityScore = ~uint64_t{0};
+  mutable std::atomic<uint64_t> complexity_scores_[kComplexityScorerCount] = {
+      kNoComplexityScore, kNoComplexityScore};
+
+  // Holds the op records instead of |storage_| if this list is compacted.
+  const std::unique_ptr<const DlCompactOps> compact_ops_;
+
+  // Counts the op records on the "display_list" memory counter.
+  const fml::ScopedMemoryCount memory_count_;
+
+  class RecordIterator;
+
+  void Dispatch(DlOpReceiver& ctx, Culler& culler) const;
+  void DispatchTile(const SkIRect& tile,
+                    const std::vector<int>& rect_indices,
+                    const TileReceiverFactory& factory) const;
+  static bool DispatchOp(DispatchContext& context, const DLOp* op);
+  static bool DispatchOps(DispatchContext& context,
+                          uint8_t* ptr,
+                          uint8_t* end,
+                          Culler& culler);
 
   friend class DisplayListBuilder;
 };
@@ -2,7 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -11,16 +13,19 @@
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_interning_table.h"
 #include "flutter/display_list/dl_paint.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/display_list/skia/dl_sk_dispatcher.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
 #include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/math.h"
 #include "flutter/testing/display_list_testing.h"
 #include "flutter/testing/testing.h"
 
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -275,6 +280,349 @@ TEST_F(DisplayListTest, SingleOpDisplayListsAreEqualWithOrWithoutRtree) {
   }
 }
 
+TEST_F(DisplayListTest, SingleOpDisplayListsAreEqualWithOrWithoutArena) {
+  // A tiny chunk size forces most of the larger ops into their own chunks.
+  auto arena = std::make_shared<DlStorageArena>(64);
+  for (auto& group : allGroups) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      DisplayListBuilder builder1(DisplayListBuilder::kMaxCullRect,
+                                  /*prepare_rtree=*/false);
+      DisplayListBuilder builder2(DisplayListBuilder::kMaxCullRect,
+                                  /*prepare_rtree=*/false, arena);
+      group.variants[i].invoker(ToReceiver(builder1));
+      group.variants[i].invoker(ToReceiver(builder2));
+      sk_sp<DisplayList> dl1 = builder1.Build();
+      sk_sp<DisplayList> dl2 = builder2.Build();
+
+      auto desc = group.op_name + "(variant " + std::to_string(i + 1) + " )";
+      ASSERT_EQ(dl1->op_count(false), dl2->op_count(false)) << desc;
+      ASSERT_EQ(dl1->bytes(false), dl2->bytes(false)) << desc;
+      ASSERT_EQ(dl1->op_count(true), dl2->op_count(true)) << desc;
+      ASSERT_EQ(dl1->bytes(true), dl2->bytes(true)) << desc;
+      ASSERT_EQ(dl1->bounds(), dl2->bounds()) << desc;
+      ASSERT_TRUE(DisplayListsEQ_Verbose(dl1, dl2)) << desc;
+      ASSERT_TRUE(DisplayListsEQ_Verbose(dl2, dl1)) << desc;
+      ASSERT_EQ(builder2.bytes_relocated(), 0u) << desc;
+    }
+  }
+}
+
+TEST_F(DisplayListTest, ChunkedDisplayListDispatchesAllOpsAcrossChunks) {
+  auto arena = std::make_shared<DlStorageArena>(256);
+  DisplayListBuilder builder(DisplayListBuilder::kMaxCullRect,
+                             /*prepare_rtree=*/false, arena);
+  DlOpReceiver& receiver = ToReceiver(builder);
+  for (auto& group : allGroups) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      group.variants[i].invoker(receiver);
+    }
+  }
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListBuilder copy_builder;
+  dl->Dispatch(ToReceiver(copy_builder));
+  sk_sp<DisplayList> copy = copy_builder.Build();
+  ASSERT_EQ(copy->op_count(false), dl->op_count(false));
+  ASSERT_EQ(copy->bytes(false), dl->bytes(false));
+  ASSERT_TRUE(DisplayListsEQ_Verbose(dl, copy));
+  ASSERT_TRUE(DisplayListsEQ_Verbose(copy, dl));
+}
+
+TEST_F(DisplayListTest, ChunkedSaveLayerRestoreAcrossChunks) {
+  auto arena = std::make_shared<DlStorageArena>(128);
+  DisplayListBuilder builder1(DisplayListBuilder::kMaxCullRect,
+                              /*prepare_rtree=*/false);
+  DisplayListBuilder builder2(DisplayListBuilder::kMaxCullRect,
+                              /*prepare_rtree=*/false, arena);
+  for (DisplayListBuilder* builder : {&builder1, &builder2}) {
+    builder->SaveLayer(nullptr, nullptr);
+    // Enough ops to push the matching restore into a later chunk.
+    for (int i = 0; i < 20; i++) {
+      builder->Save();
+      builder->Translate(i, i);
+      builder->DrawRect(SkRect::MakeLTRB(0, 0, 10, 10), DlPaint());
+      builder->Restore();
+    }
+    builder->Restore();
+  }
+  sk_sp<DisplayList> dl1 = builder1.Build();
+  sk_sp<DisplayList> dl2 = builder2.Build();
+  ASSERT_EQ(dl1->can_apply_group_opacity(), dl2->can_apply_group_opacity());
+  ASSERT_TRUE(DisplayListsEQ_Verbose(dl1, dl2));
+}
+
+TEST_F(DisplayListTest, ArenaRecyclesChunksOfDestroyedDisplayLists) {
+  auto arena = std::make_shared<DlStorageArena>(256);
+  DisplayListBuilder builder(DisplayListBuilder::kMaxCullRect,
+                             /*prepare_rtree=*/false, arena);
+  for (int i = 0; i < 100; i++) {
+    builder.DrawRect(SkRect::MakeLTRB(i, i, i + 10, i + 10), DlPaint());
+  }
+  sk_sp<DisplayList> dl = builder.Build();
+  size_t allocated = arena->allocated_chunk_count();
+  ASSERT_GT(allocated, 1u);
+  ASSERT_EQ(arena->recycled_chunk_count(), 0u);
+  dl.reset();
+  ASSERT_EQ(arena->retained_bytes(), allocated * 256);
+
+  for (int i = 0; i < 100; i++) {
+    builder.DrawRect(SkRect::MakeLTRB(i, i, i + 10, i + 10), DlPaint());
+  }
+  dl = builder.Build();
+  ASSERT_EQ(arena->allocated_chunk_count(), allocated);
+  ASSERT_EQ(arena->recycled_chunk_count(), allocated);
+  ASSERT_EQ(arena->retained_bytes(), 0u);
+}
+
+TEST_F(DisplayListTest, SingleOpDisplayListsAreEqualWhenCompacted) {
+  for (auto& group : allGroups) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      sk_sp<DisplayList> dl = Build(group.variants[i]);
+      sk_sp<const DisplayList> compacted = dl->Compacted();
+
+      auto desc = group.op_name + "(variant " + std::to_string(i + 1) + " )";
+      ASSERT_TRUE(compacted->is_compacted()) << desc;
+      ASSERT_EQ(compacted->Compacted().get(), compacted.get()) << desc;
+      ASSERT_EQ(compacted->unique_id(), dl->unique_id()) << desc;
+      ASSERT_EQ(compacted->op_count(false), dl->op_count(false)) << desc;
+      ASSERT_EQ(compacted->op_count(true), dl->op_count(true)) << desc;
+      ASSERT_EQ(compacted->bounds(), dl->bounds()) << desc;
+      ASSERT_TRUE(compacted->Equals(*dl)) << desc;
+      ASSERT_TRUE(dl->Equals(*compacted)) << desc;
+
+      DisplayListBuilder copy_builder;
+      compacted->Dispatch(ToReceiver(copy_builder));
+      sk_sp<DisplayList> copy = copy_builder.Build();
+      ASSERT_TRUE(DisplayListsEQ_Verbose(dl, copy)) << desc;
+    }
+  }
+}
+
+TEST_F(DisplayListTest, CompactedDisplayListDispatchesAllOps) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  DlOpReceiver& receiver = ToReceiver(builder);
+  for (auto& group : allGroups) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      group.variants[i].invoker(receiver);
+    }
+  }
+  sk_sp<DisplayList> dl = builder.Build();
+  sk_sp<const DisplayList> compacted = dl->Compacted();
+  ASSERT_EQ(compacted->rtree().get(), dl->rtree().get());
+
+  for (const SkRect& cull_rect : {SkRect::MakeLTRB(0, 0, 1000, 1000),
+                                  SkRect::MakeLTRB(10, 10, 20, 20)}) {
+    DisplayListBuilder expected_builder;
+    dl->Dispatch(ToReceiver(expected_builder), cull_rect);
+    DisplayListBuilder copy_builder;
+    compacted->Dispatch(ToReceiver(copy_builder), cull_rect);
+    ASSERT_TRUE(
+        DisplayListsEQ_Verbose(expected_builder.Build(), copy_builder.Build()));
+  }
+}
+
+TEST_F(DisplayListTest, CompactedDisplayListUsesLessMemory) {
+  DisplayListBuilder builder;
+  DlPaint paint;
+  for (int i = 0; i < 1000; i++) {
+    paint.setColor(i % 2 ? DlColor::kRed() : DlColor::kBlue());
+    builder.Save();
+    builder.Translate((i % 50) * 20, (i / 50) * 0.5f);
+    builder.DrawRect(SkRect::MakeXYWH(i % 50, i / 50, 10.25f, 10), paint);
+    builder.Restore();
+  }
+  sk_sp<DisplayList> dl = builder.Build();
+  sk_sp<const DisplayList> compacted = dl->Compacted();
+  ASSERT_LT(compacted->bytes(false) * 3, dl->bytes(false));
+  ASSERT_TRUE(DisplayListsEQ_Verbose(dl, compacted));
+}
+
+TEST_F(DisplayListTest, CompactedDisplayListsShareIdenticalImageRecords) {
+  DisplayListBuilder builder;
+  for (int i = 0; i < 100; i++) {
+    builder.DrawImage(TestImage1, {10, 10}, DlImageSampling::kNearestNeighbor);
+  }
+  sk_sp<DisplayList> dl = builder.Build();
+  sk_sp<const DisplayList> compacted = dl->Compacted();
+  ASSERT_LT(compacted->bytes(false) * 5, dl->bytes(false));
+  ASSERT_TRUE(DisplayListsEQ_Verbose(dl, compacted));
+  dl.reset();
+
+  DisplayListBuilder copy_builder;
+  compacted->Dispatch(ToReceiver(copy_builder));
+  ASSERT_EQ(copy_builder.Build()->op_count(), 100u);
+}
+
+static sk_sp<DisplayList> BuildIcon(
+    const std::shared_ptr<DlStorageArena>& arena,
+    DlColor color) {
+  DisplayListBuilder builder(DisplayListBuilder::kMaxCullRect, false, arena);
+  builder.DrawRect({0, 0, 24, 24}, DlPaint(color));
+  builder.DrawCircle({12, 12}, 8, DlPaint(DlColor::kWhite()));
+  return builder.Build();
+}
+
+TEST_F(DisplayListTest, IdenticalDisplayListsHaveTheSameContentHash) {
+  auto arena = std::make_shared<DlStorageArena>(64);
+  sk_sp<DisplayList> icon = BuildIcon(nullptr, DlColor::kBlue());
+  sk_sp<DisplayList> chunked_icon = BuildIcon(arena, DlColor::kBlue());
+  sk_sp<DisplayList> red_icon = BuildIcon(nullptr, DlColor::kRed());
+  ASSERT_NE(icon->unique_id(), chunked_icon->unique_id());
+  ASSERT_EQ(icon->content_hash(), chunked_icon->content_hash());
+  ASSERT_EQ(icon->content_hash(), icon->Compacted()->content_hash());
+  ASSERT_NE(icon->content_hash(), red_icon->content_hash());
+
+  DisplayListBuilder builder1;
+  builder1.DrawDisplayList(icon);
+  DisplayListBuilder builder2;
+  builder2.DrawDisplayList(chunked_icon);
+  ASSERT_EQ(builder1.Build()->content_hash(), builder2.Build()->content_hash());
+}
+
+TEST_F(DisplayListTest, InterningTableSharesIdenticalDisplayLists) {
+  auto table = std::make_shared<DlInterningTable>();
+  sk_sp<DisplayList> icon = table->Intern(BuildIcon(nullptr, DlColor::kBlue()));
+  sk_sp<DisplayList> red_icon =
+      table->Intern(BuildIcon(nullptr, DlColor::kRed()));
+  ASSERT_NE(icon, red_icon);
+  ASSERT_EQ(table->Intern(BuildIcon(nullptr, DlColor::kBlue())), icon);
+  ASSERT_EQ(table->size(), 2u);
+  ASSERT_EQ(table->hit_count(), 1u);
+
+  red_icon.reset();
+  ASSERT_EQ(table->Purge(), 1u);
+  ASSERT_EQ(table->size(), 1u);
+}
+
+TEST_F(DisplayListTest, BuilderInternsNestedDisplayLists) {
+  auto table = std::make_shared<DlInterningTable>();
+  std::vector<sk_sp<DisplayList>> tiles;
+  for (int i = 0; i < 10; i++) {
+    DisplayListBuilder builder;
+    builder.SetInterningTable(table);
+    builder.DrawDisplayList(BuildIcon(nullptr, DlColor::kBlue()));
+    tiles.push_back(builder.Build());
+  }
+  // One entry for the icon and one for the tile that draws it.
+  ASSERT_EQ(table->size(), 2u);
+  for (const sk_sp<DisplayList>& tile : tiles) {
+    ASSERT_EQ(tile, tiles[0]);
+  }
+}
+
+TEST_F(DisplayListTest, OptimizedBuilderFoldsConsecutiveTransforms) {
+  DisplayListBuilder builder;
+  builder.SetOptimizeOps(true);
+  builder.Translate(10, 10);
+  builder.Translate(5, -5);
+  builder.Scale(2, 2);
+  builder.Scale(0.5, 3);
+  builder.Translate(1, 1);
+  builder.Translate(-1, -1);
+  builder.DrawRect({0, 0, 10, 10}, DlPaint());
+
+  DisplayListBuilder expected;
+  expected.Translate(15, 5);
+  expected.Scale(1, 6);
+  expected.DrawRect({0, 0, 10, 10}, DlPaint());
+  ASSERT_TRUE(DisplayListsEQ_Verbose(builder.Build(), expected.Build()));
+}
+
+TEST_F(DisplayListTest, OptimizedBuilderKeepsTransformsAcrossSaves) {
+  DisplayListBuilder builder;
+  builder.SetOptimizeOps(true);
+  builder.Translate(10, 10);
+  builder.Save();
+  builder.Translate(5, 5);
+  builder.DrawRect({0, 0, 10, 10}, DlPaint());
+  builder.Restore();
+  builder.DrawRect({0, 0, 10, 10}, DlPaint());
+  sk_sp<DisplayList> dl = builder.Build();
+  // translate, save, translate, draw, restore, draw
+  ASSERT_EQ(dl->op_count(), 6u);
+}
+
+TEST_F(DisplayListTest, OptimizedBuilderRemovesEmptySaveRestorePairs) {
+  auto arena = std::make_shared<DlStorageArena>(64);
+  for (auto& storage_arena : {std::shared_ptr<DlStorageArena>(), arena}) {
+    DisplayListBuilder builder(DisplayListBuilder::kMaxCullRect, true,
+                               storage_arena);
+    builder.SetOptimizeOps(true);
+    builder.DrawRect({0, 0, 10, 10}, DlPaint());
+    builder.Save();
+    builder.Translate(5, 5);
+    builder.ClipRect({0, 0, 5, 5}, ClipOp::kIntersect, false);
+    builder.Save();
+    builder.Rotate(45);
+    builder.Restore();
+    builder.Restore();
+    builder.DrawRect({20, 20, 30, 30}, DlPaint());
+
+    DisplayListBuilder expected;
+    expected.DrawRect({0, 0, 10, 10}, DlPaint());
+    expected.DrawRect({20, 20, 30, 30}, DlPaint());
+    sk_sp<DisplayList> dl = builder.Build();
+    ASSERT_TRUE(DisplayListsEQ_Verbose(dl, expected.Build()));
+    std::vector<int> indices;
+    dl->rtree()->search({25, 25, 26, 26}, &indices);
+    ASSERT_EQ(indices, std::vector<int>({1}));
+  }
+}
+
+TEST_F(DisplayListTest, OptimizedBuilderKeepsSavesThatChangeAttributes) {
+  DisplayListBuilder builder;
+  builder.SetOptimizeOps(true);
+  DlOpReceiver& receiver = ToReceiver(builder);
+  receiver.save();
+  receiver.translate(5, 5);
+  // Attributes are not restored by restore().
+  receiver.setColor(DlColor::kRed());
+  receiver.restore();
+  sk_sp<DisplayList> dl = builder.Build();
+  ASSERT_EQ(dl->op_count(), 4u);
+}
+
+TEST_F(DisplayListTest, OptimizedBuilderRemovesClippedAndTransparentDraws) {
+  DisplayListBuilder builder;
+  builder.SetOptimizeOps(true);
+  builder.ClipRect({0, 0, 100, 100}, ClipOp::kIntersect, false);
+  builder.DrawRect({200, 200, 300, 300}, DlPaint(DlColor::kBlue()));
+  builder.DrawRect({10, 10, 20, 20}, DlPaint(DlColor::kTransparent()));
+  SkPoint points[] = {{200, 200}, {300, 300}};
+  builder.DrawPoints(PointMode::kLines, 2, points, DlPaint());
+  builder.Translate(500, 500);
+  builder.DrawDisplayList(BuildIcon(nullptr, DlColor::kRed()));
+  builder.DrawRect({-450, -450, -440, -440}, DlPaint(DlColor::kBlue()));
+  sk_sp<DisplayList> dl = builder.Build();
+
+  // Only the attributes of the removed draws remain:
+  // clip, setColor(blue), setColor(transparent), setColor(black),
+  // translate, setColor(blue), drawRect
+  ASSERT_EQ(dl->op_count(), 7u);
+  ASSERT_EQ(dl->bounds(), SkRect::MakeLTRB(50, 50, 60, 60));
+}
+
+TEST_F(DisplayListTest, OptimizedBuilderKeepsClippedDrawsInFilteredLayers) {
+  DisplayListBuilder builder;
+  builder.SetOptimizeOps(true);
+  builder.ClipRect({0, 0, 100, 100}, ClipOp::kIntersect, false);
+  DlPaint layer_paint;
+  layer_paint.setImageFilter(
+      DlMatrixImageFilter::Make(SkMatrix::Translate(-150, -150),
+                                DlImageSampling::kNearestNeighbor));
+  builder.SaveLayer(nullptr, &layer_paint);
+  builder.DrawRect({200, 200, 210, 210}, DlPaint(DlColor::kBlue()));
+  builder.Restore();
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListBuilder expected;
+  expected.ClipRect({0, 0, 100, 100}, ClipOp::kIntersect, false);
+  expected.SaveLayer(nullptr, &layer_paint);
+  expected.DrawRect({200, 200, 210, 210}, DlPaint(DlColor::kBlue()));
+  expected.Restore();
+  ASSERT_TRUE(DisplayListsEQ_Verbose(dl, expected.Build()));
+}
+
 TEST_F(DisplayListTest, FullRotationsAreNop) {
   DisplayListBuilder builder;
   DlOpReceiver& receiver = ToReceiver(builder);
@@ -2622,5 +2970,149 @@ TEST_F(DisplayListTest, DrawSaveDrawCannotInheritOpacity) {
   ASSERT_FALSE(display_list->can_apply_group_opacity());
 }
 
+class DrawRectCollector : public virtual DlOpReceiver,
+                          public IgnoreAttributeDispatchHelper,
+                          public IgnoreClipDispatchHelper,
+                          public IgnoreTransformDispatchHelper,
+                          public IgnoreDrawDispatchHelper {
+ public:
+  DrawRectCollector(std::mutex& mutex, std::vector<SkRect>& rects)
+      : mutex_(mutex), rects_(rects) {}
+
+  void drawRect(const SkRect& rect) override {
+    std::scoped_lock lock(mutex_);
+    rects_.push_back(rect);
+  }
+
+ private:
+  std::mutex& mutex_;
+  std::vector<SkRect>& rects_;
+};
+
+TEST_F(DisplayListTest, DispatchTiledOnlyVisitsTilesWithOps) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  builder.DrawRect(SkRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  builder.DrawRect(SkRect::MakeLTRB(310, 210, 320, 220), DlPaint());
+  auto display_list = builder.Build();
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  std::mutex mutex;
+  std::vector<SkIRect> tiles;
+  std::vector<SkRect> rects;
+  display_list->DispatchTiled(
+      SkIRect::MakeWH(400, 400), SkISize::Make(100, 100),
+      loop->GetTaskRunner(),
+      [&mutex, &tiles, &rects](const SkIRect& tile) {
+        std::scoped_lock lock(mutex);
+        tiles.push_back(tile);
+        return std::make_unique<DrawRectCollector>(mutex, rects);
+      });
+
+  ASSERT_EQ(tiles.size(), 2u);
+  std::sort(tiles.begin(), tiles.end(), [](const SkIRect& a, const SkIRect& b) {
+    return a.fTop < b.fTop;
+  });
+  EXPECT_EQ(tiles[0], SkIRect::MakeLTRB(0, 0, 100, 100));
+  EXPECT_EQ(tiles[1], SkIRect::MakeLTRB(300, 200, 400, 300));
+  ASSERT_EQ(rects.size(), 2u);
+}
+
+TEST_F(DisplayListTest, DispatchTiledWithoutRtreeDispatchesOnce) {
+  DisplayListBuilder builder(/*prepare_rtree=*/false);
+  builder.DrawRect(SkRect::MakeLTRB(10, 10, 20, 20), DlPaint());
+  builder.DrawRect(SkRect::MakeLTRB(310, 210, 320, 220), DlPaint());
+  auto display_list = builder.Build();
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  std::mutex mutex;
+  int tile_count = 0;
+  std::vector<SkRect> rects;
+  display_list->DispatchTiled(
+      SkIRect::MakeWH(400, 400), SkISize::Make(100, 100),
+      loop->GetTaskRunner(),
+      [&mutex, &tile_count, &rects](const SkIRect& tile) {
+        EXPECT_EQ(tile, SkIRect::MakeWH(400, 400));
+        tile_count++;
+        return std::make_unique<DrawRectCollector>(mutex, rects);
+      });
+
+  EXPECT_EQ(tile_count, 1);
+  EXPECT_EQ(rects.size(), 2u);
+}
+
+TEST_F(DisplayListTest, DrawToPixmapTiledMatchesSingleCanvasRendering) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  DlPaint paint;
+  for (int i = 0; i < 30; i++) {
+    paint.setColor(i & 1 ? DlColor::kBlue() : DlColor::kGreen());
+    builder.DrawCircle(SkPoint::Make(i * 9.5f, i * 7.25f), 12.0f, paint);
+    builder.DrawRect(SkRect::MakeXYWH(i * 11.0f, 200 - i * 5.0f, 15, 15),
+                     paint);
+  }
+  auto display_list = builder.Build();
+
+  SkImageInfo info = SkImageInfo::MakeN32Premul(300, 250);
+  SkBitmap expected;
+  expected.allocPixels(info);
+  expected.eraseColor(SK_ColorTRANSPARENT);
+  {
+    std::unique_ptr<SkCanvas> canvas = SkCanvas::MakeRasterDirect(
+        info, expected.getPixels(), expected.rowBytes());
+    DlSkCanvasDispatcher dispatcher(canvas.get());
+    display_list->Dispatch(dispatcher);
+  }
+
+  SkBitmap tiled;
+  tiled.allocPixels(info);
+  tiled.eraseColor(SK_ColorTRANSPARENT);
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  DlSkCanvasDispatcher::DrawToPixmapTiled(*display_list, tiled.pixmap(),
+                                          SkISize::Make(64, 64),
+                                          loop->GetTaskRunner());
+
+  for (int y = 0; y < info.height(); y++) {
+    ASSERT_EQ(memcmp(expected.getAddr32(0, y), tiled.getAddr32(0, y),
+                     info.minRowBytes()),
+              0)
+        << "row " << y;
+  }
+}
+
+class ImageFilterCollector : public virtual DlOpReceiver,
+                             public IgnoreAttributeDispatchHelper,
+                             public IgnoreClipDispatchHelper,
+                             public IgnoreTransformDispatchHelper,
+                             public IgnoreDrawDispatchHelper {
+ public:
+  void setImageFilter(const DlImageFilter* filter) override {
+    filters.push_back(filter);
+  }
+
+  std::vector<const DlImageFilter*> filters;
+};
+
+TEST_F(DisplayListTest, EqualSharedAttributesAreInterned) {
+  // Equal to, but a different object than, kTestComposeImageFilter1.
+  DlComposeImageFilter compose_filter(kTestBlurImageFilter1,
+                                      kTestMatrixImageFilter1);
+  ASSERT_EQ(compose_filter, kTestComposeImageFilter1);
+
+  DisplayListBuilder builder;
+  builder.DrawRect({0, 0, 10, 10},
+                   DlPaint().setImageFilter(&kTestComposeImageFilter1));
+  builder.DrawRect({0, 0, 10, 10},
+                   DlPaint().setImageFilter(&kTestComposeImageFilter2));
+  builder.DrawRect({0, 0, 10, 10}, DlPaint().setImageFilter(&compose_filter));
+  auto display_list = builder.Build();
+
+  ImageFilterCollector collector;
+  display_list->Dispatch(collector);
+  ASSERT_EQ(collector.filters.size(), 3u);
+  EXPECT_NE(collector.filters[0], &kTestComposeImageFilter1);
+  EXPECT_NE(collector.filters[0], collector.filters[1]);
+  EXPECT_EQ(collector.filters[0], collector.filters[2]);
+  EXPECT_EQ(*collector.filters[1], kTestComposeImageFilter2);
+}
+
 }  // namespace testing
 }  // namespace flutter
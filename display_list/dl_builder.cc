@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/dl_builder.h"
 
+#include <type_traits>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_op_records.h"
@@ -41,26 +43,63 @@ template <typename T, typename... Args>
 void* DisplayListBuilder::Push(size_t pod, int render_op_inc, Args&&... args) {
   size_t size = SkAlignPtr(sizeof(T) + pod);
   FML_DCHECK(size < (1 << 24));
-  if (used_ + size > allocated_) {
-    static_assert(is_power_of_two(DL_BUILDER_PAGE),
-                  "This math needs updating for non-pow2.");
-    // Next greater multiple of DL_BUILDER_PAGE.
-    allocated_ = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
-    storage_.realloc(allocated_);
-    FML_DCHECK(storage_.get());
-    memset(storage_.get() + used_, 0, allocated_ - used_);
-  }
-  FML_DCHECK(used_ + size <= allocated_);
-  auto op = reinterpret_cast<T*>(storage_.get() + used_);
+  T* op;
+  if (storage_.is_chunked()) {
+    // Chunked storage never moves the records already written.
+    op = reinterpret_cast<T*>(storage_.Append(size));
+  } else {
+    if (used_ + size > allocated_) {
+      static_assert(is_power_of_two(DL_BUILDER_PAGE),
+                    "This math needs updating for non-pow2.");
+      // Next greater multiple of DL_BUILDER_PAGE.
+      allocated_ = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
+      uint8_t* old_ptr = storage_.get();
+      storage_.realloc(allocated_);
+      FML_DCHECK(storage_.get());
+      if (old_ptr != nullptr && old_ptr != storage_.get()) {
+        bytes_relocated_ += used_;
+      }
+      memset(storage_.get() + used_, 0, allocated_ - used_);
+    }
+    FML_DCHECK(used_ + size <= allocated_);
+    op = reinterpret_cast<T*>(storage_.get() + used_);
+  }
+  last_op_offset_ = used_;
   used_ += size;
   new (op) T{std::forward<Args>(args)...};
   op->type = T::kType;
   op->size = size;
   render_op_count_ += render_op_inc;
   op_index_++;
+  if constexpr (!std::is_base_of_v<TransformClipOpBase, T> &&
+                !std::is_same_v<T, SaveOp> && !std::is_same_v<T, RestoreOp>) {
+    current_layer_->has_lasting_op_ = true;
+  }
   return op + 1;
 }
 
+template <typename T>
+const T* DisplayListBuilder::LastOpIf() const {
+  if (current_layer_->has_deferred_save_op_ || last_op_offset_ >= used_) {
+    return nullptr;
+  }
+  auto op = reinterpret_cast<const DLOp*>(storage_.at(last_op_offset_));
+  return op->type == T::kType ? static_cast<const T*>(op) : nullptr;
+}
+
+void DisplayListBuilder::DiscardOpsFrom(size_t offset,
+                                        int op_index,
+                                        int render_op_count) {
+  storage_.Truncate(offset, used_, [](uint8_t* ptr, uint8_t* end) {
+    DisplayList::DisposeOps(ptr, end);
+  });
+  used_ = offset;
+  // The op before |offset| is not known, so there is no last op.
+  last_op_offset_ = offset;
+  op_index_ = op_index;
+  render_op_count_ = render_op_count;
+}
+
 sk_sp<DisplayList> DisplayListBuilder::Build() {
   while (layer_stack_.size() > 1) {
     restore();
@@ -70,17 +109,25 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   size_t nested_bytes = nested_bytes_;
   int nested_count = nested_op_count_;
   used_ = allocated_ = render_op_count_ = op_index_ = 0;
+  last_op_offset_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
-  storage_.realloc(bytes);
+  if (!storage_.is_chunked()) {
+    storage_.realloc(bytes);
+  }
   bool compatible = layer_stack_.back().is_group_opacity_compatible();
-  return sk_sp<DisplayList>(new DisplayList(std::move(storage_), bytes, count,
-                                            nested_bytes, nested_count,
-                                            bounds(), compatible, rtree()));
+  sk_sp<DisplayList> display_list(
+      new DisplayList(std::move(storage_), bytes, count, nested_bytes,
+                      nested_count, bounds(), compatible, rtree()));
+  if (interning_table_) {
+    return interning_table_->Intern(display_list);
+  }
+  return display_list;
 }
 
 DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
-                                       bool prepare_rtree)
-    : tracker_(cull_rect, SkMatrix::I()) {
+                                       bool prepare_rtree,
+                                       std::shared_ptr<DlStorageArena> arena)
+    : storage_(std::move(arena)), tracker_(cull_rect, SkMatrix::I()) {
   if (prepare_rtree) {
     accumulator_ = std::make_unique<RTreeBoundsAccumulator>();
   } else {
@@ -92,10 +139,10 @@ DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
 }
 
 DisplayListBuilder::~DisplayListBuilder() {
-  uint8_t* ptr = storage_.get();
-  if (ptr) {
-    DisplayList::DisposeOps(ptr, ptr + used_);
-  }
+  storage_.ForEachSegment(used_, [](uint8_t* ptr, uint8_t* end) {
+    DisplayList::DisposeOps(ptr, end);
+    return true;
+  });
 }
 
 SkISize DisplayListBuilder::GetBaseLayerSize() const {
@@ -107,6 +154,22 @@ SkImageInfo DisplayListBuilder::GetImageInfo() const {
   return SkImageInfo::MakeUnknown(size.width(), size.height());
 }
 
+template <class T>
+std::shared_ptr<const T> DisplayListBuilder::Intern(
+    InternedAttributes<T>& interned,
+    const T* attribute) {
+  for (auto it = interned.rbegin(); it != interned.rend(); ++it) {
+    if (Equals(it->get(), attribute)) {
+      return *it;
+    }
+  }
+  if (interned.size() >= kMaxInternedAttributes) {
+    interned.erase(interned.begin());
+  }
+  interned.push_back(attribute->shared());
+  return interned.back();
+}
+
 void DisplayListBuilder::onSetAntiAlias(bool aa) {
   current_.setAntiAlias(aa);
   Push<SetAntiAliasOp>(0, 0, aa);
@@ -155,7 +218,7 @@ void DisplayListBuilder::onSetColorSource(const DlColorSource* source) {
     current_.setColorSource(nullptr);
     Push<ClearColorSourceOp>(0, 0);
   } else {
-    current_.setColorSource(source->shared());
+    current_.setColorSource(Intern(color_sources_, source));
     switch (source->type()) {
       case DlColorSourceType::kColor: {
         const DlColorColorSource* color_source = source->asColor();
@@ -220,7 +283,9 @@ void DisplayListBuilder::onSetImageFilter(const DlImageFilter* filter) {
     current_.setImageFilter(nullptr);
     Push<ClearImageFilterOp>(0, 0);
   } else {
-    current_.setImageFilter(filter->shared());
+    std::shared_ptr<const DlImageFilter> shared =
+        Intern(image_filters_, filter);
+    current_.setImageFilter(shared);
     switch (filter->type()) {
       case DlImageFilterType::kBlur: {
         const DlBlurImageFilter* blur_filter = filter->asBlur();
@@ -253,7 +318,7 @@ void DisplayListBuilder::onSetImageFilter(const DlImageFilter* filter) {
       case DlImageFilterType::kCompose:
       case DlImageFilterType::kLocalMatrix:
       case DlImageFilterType::kColorFilter: {
-        Push<SetSharedImageFilterOp>(0, 0, filter);
+        Push<SetSharedImageFilterOp>(0, 0, std::move(shared));
         break;
       }
     }
@@ -264,7 +329,7 @@ void DisplayListBuilder::onSetColorFilter(const DlColorFilter* filter) {
     current_.setColorFilter(nullptr);
     Push<ClearColorFilterOp>(0, 0);
   } else {
-    current_.setColorFilter(filter->shared());
+    current_.setColorFilter(Intern(color_filters_, filter));
     switch (filter->type()) {
       case DlColorFilterType::kBlend: {
         const DlBlendColorFilter* blend_filter = filter->asBlend();
@@ -299,7 +364,7 @@ void DisplayListBuilder::onSetPathEffect(const DlPathEffect* effect) {
     current_.setPathEffect(nullptr);
     Push<ClearPathEffectOp>(0, 0);
   } else {
-    current_.setPathEffect(effect->shared());
+    current_.setPathEffect(Intern(path_effects_, effect));
     switch (effect->type()) {
       case DlPathEffectType::kDash: {
         const DlDashPathEffect* dash_effect = effect->asDash();
@@ -315,7 +380,7 @@ void DisplayListBuilder::onSetMaskFilter(const DlMaskFilter* filter) {
     current_.setMaskFilter(nullptr);
     Push<ClearMaskFilterOp>(0, 0);
   } else {
-    current_.setMaskFilter(filter->shared());
+    current_.setMaskFilter(Intern(mask_filters_, filter));
     switch (filter->type()) {
       case DlMaskFilterType::kBlur: {
         const DlBlurMaskFilter* blur_filter = filter->asBlur();
@@ -353,26 +418,28 @@ void DisplayListBuilder::SetAttributesFromPaint(
     setStrokeJoin(paint.getStrokeJoin());
   }
   if (flags.applies_shader()) {
-    setColorSource(paint.getColorSource().get());
+    setColorSource(paint.getColorSourcePtr());
   }
   if (flags.applies_color_filter()) {
     setInvertColors(paint.isInvertColors());
-    setColorFilter(paint.getColorFilter().get());
+    setColorFilter(paint.getColorFilterPtr());
   }
   if (flags.applies_image_filter()) {
-    setImageFilter(paint.getImageFilter().get());
+    setImageFilter(paint.getImageFilterPtr());
   }
   if (flags.applies_path_effect()) {
-    setPathEffect(paint.getPathEffect().get());
+    setPathEffect(paint.getPathEffectPtr());
   }
   if (flags.applies_mask_filter()) {
-    setMaskFilter(paint.getMaskFilter().get());
+    setMaskFilter(paint.getMaskFilterPtr());
   }
 }
 
 void DisplayListBuilder::checkForDeferredSave() {
   if (current_layer_->has_deferred_save_op_) {
     size_t save_offset_ = used_;
+    current_layer_->save_op_index_ = op_index_;
+    current_layer_->save_render_op_count_ = render_op_count_;
     Push<SaveOp>(0, 1);
     current_layer_->save_offset_ = save_offset_;
     current_layer_->has_deferred_save_op_ = false;
@@ -390,10 +457,20 @@ void DisplayListBuilder::Save() {
 void DisplayListBuilder::Restore() {
   if (layer_stack_.size() > 1) {
     SaveOpBase* op = reinterpret_cast<SaveOpBase*>(
-        storage_.get() + current_layer_->save_offset());
+        storage_.at(current_layer_->save_offset()));
     if (!current_layer_->has_deferred_save_op_) {
-      op->restore_index = op_index_;
-      Push<RestoreOp>(0, 1);
+      if (optimize_ops_ && !current_layer_->has_layer() &&
+          !current_layer_->has_lasting_op_) {
+        // Everything since the save only affects the ops up to this
+        // restore, and there are none.
+        DiscardOpsFrom(current_layer_->save_offset(),
+                       current_layer_->save_op_index_,
+                       current_layer_->save_render_op_count_);
+        op = nullptr;
+      } else {
+        op->restore_index = op_index_;
+        Push<RestoreOp>(0, 1);
+      }
     }
     // Grab the current layer info before we push the restore
     // on the stack.
@@ -402,6 +479,9 @@ void DisplayListBuilder::Restore() {
     tracker_.restore();
     layer_stack_.pop_back();
     current_layer_ = &layer_stack_.back();
+    if (layer_info.has_lasting_op_) {
+      current_layer_->has_lasting_op_ = true;
+    }
     bool is_unbounded = layer_info.is_unbounded();
 
     // Before we pop_back we will get the current layer bounds from the
@@ -508,7 +588,7 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds,
     // opacity on top of it. But, if the layer is applying the ImageFilter
     // then it cannot pass the opacity on.
     if (!current_opacity_compatibility_ ||
-        current_.getImageFilter() != nullptr) {
+        current_.getImageFilterPtr() != nullptr) {
       UpdateLayerOpacityCompatibility(false);
     }
   }
@@ -540,7 +620,18 @@ void DisplayListBuilder::Translate(SkScalar tx, SkScalar ty) {
   if (SkScalarIsFinite(tx) && SkScalarIsFinite(ty) &&
       (tx != 0.0 || ty != 0.0)) {
     checkForDeferredSave();
-    Push<TranslateOp>(0, 1, tx, ty);
+    const TranslateOp* last =
+        optimize_ops_ ? LastOpIf<TranslateOp>() : nullptr;
+    if (last) {
+      SkScalar folded_tx = last->tx + tx;
+      SkScalar folded_ty = last->ty + ty;
+      DiscardLastOp();
+      if (folded_tx != 0.0 || folded_ty != 0.0) {
+        Push<TranslateOp>(0, 1, folded_tx, folded_ty);
+      }
+    } else {
+      Push<TranslateOp>(0, 1, tx, ty);
+    }
     tracker_.translate(tx, ty);
   }
 }
@@ -548,7 +639,17 @@ void DisplayListBuilder::Scale(SkScalar sx, SkScalar sy) {
   if (SkScalarIsFinite(sx) && SkScalarIsFinite(sy) &&
       (sx != 1.0 || sy != 1.0)) {
     checkForDeferredSave();
-    Push<ScaleOp>(0, 1, sx, sy);
+    const ScaleOp* last = optimize_ops_ ? LastOpIf<ScaleOp>() : nullptr;
+    if (last) {
+      SkScalar folded_sx = last->sx * sx;
+      SkScalar folded_sy = last->sy * sy;
+      DiscardLastOp();
+      if (folded_sx != 1.0 || folded_sy != 1.0) {
+        Push<ScaleOp>(0, 1, folded_sx, folded_sy);
+      }
+    } else {
+      Push<ScaleOp>(0, 1, sx, sy);
+    }
     tracker_.scale(sx, sy);
   }
 }
@@ -853,21 +954,23 @@ void DisplayListBuilder::drawPoints(PointMode mode,
   switch (mode) {
     case PointMode::kPoints:
       data_ptr = Push<DrawPointsOp>(bytes, 1, count);
+      CopyV(data_ptr, pts, count);
       AccumulateOpBounds(point_bounds, kDrawPointsAsPointsFlags);
       break;
     case PointMode::kLines:
       data_ptr = Push<DrawLinesOp>(bytes, 1, count);
+      CopyV(data_ptr, pts, count);
       AccumulateOpBounds(point_bounds, kDrawPointsAsLinesFlags);
       break;
     case PointMode::kPolygon:
       data_ptr = Push<DrawPolygonOp>(bytes, 1, count);
+      CopyV(data_ptr, pts, count);
       AccumulateOpBounds(point_bounds, kDrawPointsAsPolygonFlags);
       break;
     default:
       FML_DCHECK(false);
       return;
   }
-  CopyV(data_ptr, pts, count);
   // drawPoints treats every point or line (or segment of a polygon)
   // as a completely separate operation meaning we cannot ensure
   // distribution of group opacity without analyzing the mode and the
@@ -1073,6 +1176,17 @@ void DisplayListBuilder::DrawAtlas(const sk_sp<DlImage>& atlas,
 
 void DisplayListBuilder::DrawDisplayList(const sk_sp<DisplayList> display_list,
                                          SkScalar opacity) {
+  if (interning_table_) {
+    sk_sp<DisplayList> interned = interning_table_->Intern(display_list);
+    if (interned != display_list) {
+      DrawDisplayList(interned, opacity);
+      return;
+    }
+  }
+  if (optimize_ops_ && !in_filtered_layer() &&
+      QuickReject(display_list->bounds())) {
+    return;
+  }
   DlPaint current_paint = current_;
   Push<DrawDisplayListOp>(0, 1, display_list, opacity);
   // Not really necessary if the developer is interacting with us via
@@ -1081,22 +1195,24 @@ void DisplayListBuilder::DrawDisplayList(const sk_sp<DisplayList> display_list,
   SetAttributesFromPaint(current_paint,
                          DisplayListOpFlags::kSaveLayerWithPaintFlags);
 
-  const SkRect bounds = display_list->bounds();
+  // The bounds are accumulated directly so that the op is never removed
+  // after some of its rects were accumulated.
+  SkRect bounds = display_list->bounds();
   switch (accumulator()->type()) {
     case BoundsAccumulatorType::kRect:
-      AccumulateOpBounds(bounds, kDrawDisplayListFlags);
+      AccumulateBounds(bounds);
       break;
     case BoundsAccumulatorType::kRTree:
       auto rtree = display_list->rtree();
       if (rtree) {
         std::list<SkRect> rects = rtree->searchAndConsolidateRects(bounds);
-        for (const SkRect& rect : rects) {
+        for (SkRect& rect : rects) {
           // TODO (https://github.com/flutter/flutter/issues/114919): Attributes
           // are not necessarily `kDrawDisplayListFlags`.
-          AccumulateOpBounds(rect, kDrawDisplayListFlags);
+          AccumulateBounds(rect);
         }
       } else {
-        AccumulateOpBounds(bounds, kDrawDisplayListFlags);
+        AccumulateBounds(bounds);
       }
       break;
   }
@@ -1166,8 +1282,8 @@ bool DisplayListBuilder::AdjustBoundsForPaint(SkRect& bounds,
     // Path effect occurs before stroking...
     DisplayListSpecialGeometryFlags special_flags =
         flags.WithPathEffect(current_.getPathEffectPtr(), is_stroked);
-    if (current_.getPathEffect()) {
-      auto effect_bounds = current_.getPathEffect()->effect_bounds(bounds);
+    if (current_.getPathEffectPtr()) {
+      auto effect_bounds = current_.getPathEffectPtr()->effect_bounds(bounds);
       if (!effect_bounds.has_value()) {
         return false;
       }
@@ -1192,7 +1308,7 @@ bool DisplayListBuilder::AdjustBoundsForPaint(SkRect& bounds,
   }
 
   if (flags.applies_mask_filter()) {
-    auto filter = current_.getMaskFilter();
+    const DlMaskFilter* filter = current_.getMaskFilterPtr();
     if (filter) {
       switch (filter->type()) {
         case DlMaskFilterType::kBlur: {
@@ -1205,7 +1321,7 @@ bool DisplayListBuilder::AdjustBoundsForPaint(SkRect& bounds,
   }
 
   if (flags.applies_image_filter()) {
-    return ComputeFilteredBounds(bounds, current_.getImageFilter().get());
+    return ComputeFilteredBounds(bounds, current_.getImageFilterPtr());
   }
 
   return true;
@@ -1217,25 +1333,48 @@ void DisplayListBuilder::AccumulateUnbounded() {
 
 void DisplayListBuilder::AccumulateOpBounds(SkRect& bounds,
                                             DisplayListAttributeFlags flags) {
-  if (AdjustBoundsForPaint(bounds, flags)) {
-    AccumulateBounds(bounds);
+  if (optimize_ops_ && paint_nops_entirely(flags)) {
+    DiscardLastOp();
+  } else if (AdjustBoundsForPaint(bounds, flags)) {
+    if (!AccumulateBounds(bounds) && optimize_ops_ && !in_filtered_layer()) {
+      DiscardLastOp();
+    }
   } else {
     AccumulateUnbounded();
   }
 }
-void DisplayListBuilder::AccumulateBounds(SkRect& bounds) {
+bool DisplayListBuilder::AccumulateBounds(SkRect& bounds) {
   tracker_.mapRect(&bounds);
   if (bounds.intersect(tracker_.device_cull_rect())) {
     accumulator()->accumulate(bounds, op_index_ - 1);
+    return true;
+  }
+  return false;
+}
+
+bool DisplayListBuilder::paint_nops_entirely(DisplayListAttributeFlags flags) {
+  // The alpha of the paint multiplies the alpha of everything these ops
+  // draw, including the colors of shaders, images, vertices and atlases.
+  return !flags.ignores_paint() && flags.applies_alpha() &&
+         current_.getAlpha() == 0 && !current_.isInvertColors() &&
+         paint_nops_on_transparency();
+}
+
+bool DisplayListBuilder::in_filtered_layer() const {
+  for (const LayerInfo& layer : layer_stack_) {
+    if (layer.filter_) {
+      return true;
+    }
   }
+  return false;
 }
 
 bool DisplayListBuilder::paint_nops_on_transparency() {
   // SkImageFilter::canComputeFastBounds tests for transparency behavior
   // This test assumes that the blend mode checked down below will
   // NOP on transparent black.
-  if (current_.getImageFilter() &&
-      current_.getImageFilter()->modifies_transparent_black()) {
+  if (current_.getImageFilterPtr() &&
+      current_.getImageFilterPtr()->modifies_transparent_black()) {
     return false;
   }
 
@@ -1245,8 +1384,8 @@ bool DisplayListBuilder::paint_nops_on_transparency() {
   // save layer untouched out to the edge of the output surface.
   // This test assumes that the blend mode checked down below will
   // NOP on transparent black.
-  if (current_.getColorFilter() &&
-      current_.getColorFilter()->modifies_transparent_black()) {
+  if (current_.getColorFilterPtr() &&
+      current_.getColorFilterPtr()->modifies_transparent_black()) {
     return false;
   }
 
@@ -8,6 +8,7 @@
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_canvas.h"
+#include "flutter/display_list/dl_interning_table.h"
 #include "flutter/display_list/dl_op_flags.h"
 #include "flutter/display_list/dl_op_receiver.h"
 #include "flutter/display_list/dl_paint.h"
@@ -35,8 +36,14 @@ class DisplayListBuilder final : public virtual DlCanvas,
   explicit DisplayListBuilder(bool prepare_rtree)
       : DisplayListBuilder(kMaxCullRect, prepare_rtree) {}
 
+  // If an |arena| is supplied then the ops are recorded into chunks
+  // obtained from it rather than into a single buffer that is grown
+  // (and copied) with realloc. The resulting DisplayLists hand their
+  // chunks back to the arena when they are destroyed so that subsequent
+  // recordings can reuse the memory.
   explicit DisplayListBuilder(const SkRect& cull_rect = kMaxCullRect,
-                              bool prepare_rtree = false);
+                              bool prepare_rtree = false,
+                              std::shared_ptr<DlStorageArena> arena = nullptr);
 
   ~DisplayListBuilder();
 
@@ -229,6 +236,27 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   sk_sp<DisplayList> Build();
 
+  // The number of bytes of already recorded ops that had to be moved
+  // because the storage was grown, accumulated over the lifetime of the
+  // builder. This is always 0 for builders recording into an arena.
+  size_t bytes_relocated() const { return bytes_relocated_; }
+
+  // If an |interning_table| is set then both the lists drawn with
+  // |DrawDisplayList| and the list returned by |Build| are replaced by an
+  // identical list from the table when there is one, so that content that
+  // is recorded many times is only retained once.
+  void SetInterningTable(std::shared_ptr<DlInterningTable> interning_table) {
+    interning_table_ = std::move(interning_table);
+  }
+
+  // If |optimize_ops| is true then the builder also removes the ops that
+  // cannot affect the rendering as they are recorded: draws whose paint
+  // leaves the destination unchanged, draws that are entirely outside of
+  // the clip, and |Save|/|Restore| pairs that only enclose transform and
+  // clip ops. Consecutive translates and consecutive scales are folded
+  // into a single op.
+  void SetOptimizeOps(bool optimize_ops) { optimize_ops_ = optimize_ops; }
+
  private:
   // This method exposes the internal stateful DlOpReceiver implementation
   // of the DisplayListBuilder, primarily for testing purposes. Its use
@@ -306,31 +334,31 @@ class DisplayListBuilder final : public virtual DlCanvas,
   }
   // |DlOpReceiver|
   void setColorSource(const DlColorSource* source) override {
-    if (NotEquals(current_.getColorSource(), source)) {
+    if (NotEquals(current_.getColorSourcePtr(), source)) {
       onSetColorSource(source);
     }
   }
   // |DlOpReceiver|
   void setImageFilter(const DlImageFilter* filter) override {
-    if (NotEquals(current_.getImageFilter(), filter)) {
+    if (NotEquals(current_.getImageFilterPtr(), filter)) {
       onSetImageFilter(filter);
     }
   }
   // |DlOpReceiver|
   void setColorFilter(const DlColorFilter* filter) override {
-    if (NotEquals(current_.getColorFilter(), filter)) {
+    if (NotEquals(current_.getColorFilterPtr(), filter)) {
       onSetColorFilter(filter);
     }
   }
   // |DlOpReceiver|
   void setPathEffect(const DlPathEffect* effect) override {
-    if (NotEquals(current_.getPathEffect(), effect)) {
+    if (NotEquals(current_.getPathEffectPtr(), effect)) {
       onSetPathEffect(effect);
     }
   }
   // |DlOpReceiver|
   void setMaskFilter(const DlMaskFilter* filter) override {
-    if (NotEquals(current_.getMaskFilter(), filter)) {
+    if (NotEquals(current_.getMaskFilterPtr(), filter)) {
       onSetMaskFilter(filter);
     }
   }
@@ -473,6 +501,12 @@ class DisplayListBuilder final : public virtual DlCanvas,
   DisplayListStorage storage_;
   size_t used_ = 0;
   size_t allocated_ = 0;
+  size_t bytes_relocated_ = 0;
+  std::shared_ptr<DlInterningTable> interning_table_;
+  bool optimize_ops_ = false;
+  // The offset of the last recorded op, only valid if it is less than
+  // |used_|.
+  size_t last_op_offset_ = 0;
   int render_op_count_ = 0;
   int op_index_ = 0;
 
@@ -483,6 +517,21 @@ class DisplayListBuilder final : public virtual DlCanvas,
   template <typename T, typename... Args>
   void* Push(size_t extra, int op_inc, Args&&... args);
 
+  // Returns the last recorded op if it is of type |T| and belongs to the
+  // current save level, or nullptr.
+  template <typename T>
+  const T* LastOpIf() const;
+
+  // Removes the ops recorded from |offset| onwards and rewinds the op
+  // counts to |op_index| and |render_op_count|.
+  void DiscardOpsFrom(size_t offset, int op_index, int render_op_count);
+
+  // Removes the last recorded op, which must have been pushed with an
+  // |op_inc| of 1.
+  void DiscardLastOp() {
+    DiscardOpsFrom(last_op_offset_, op_index_ - 1, render_op_count_ - 1);
+  }
+
   void intersect(const SkRect& rect);
 
   // kInvalidSigma is used to indicate that no MaskBlur is currently set.
@@ -575,6 +624,12 @@ class DisplayListBuilder final : public virtual DlCanvas,
     std::shared_ptr<const DlImageFilter> filter_;
     bool is_unbounded_;
     bool has_deferred_save_op_ = false;
+    // The op counts before the save op of this layer was recorded.
+    int save_op_index_ = 0;
+    int save_render_op_count_ = 0;
+    // Whether the layer contains an op other than a transform or clip,
+    // i.e. an op whose effect outlasts the matching restore.
+    bool has_lasting_op_ = false;
 
     friend class DisplayListBuilder;
   };
@@ -600,9 +655,9 @@ class DisplayListBuilder final : public virtual DlCanvas,
   }
 
   void UpdateCurrentOpacityCompatibility() {
-    current_opacity_compatibility_ =             //
-        current_.getColorFilter() == nullptr &&  //
-        !current_.isInvertColors() &&            //
+    current_opacity_compatibility_ =                //
+        current_.getColorFilterPtr() == nullptr &&  //
+        !current_.isInvertColors() &&               //
         IsOpacityCompatible(current_.getBlendMode());
   }
 
@@ -713,11 +768,42 @@ class DisplayListBuilder final : public virtual DlCanvas,
   // Records the bounds for an op after modifying them according to the
   // supplied attribute flags and transforming by the current matrix
   // and clipping against the current clip.
+  //
+  // If |optimize_ops_| is set and the op that was just recorded cannot
+  // affect the rendering then it is removed instead.
   void AccumulateOpBounds(SkRect& bounds, DisplayListAttributeFlags flags);
 
   // Records the given bounds after transforming by the current matrix
-  // and clipping against the current clip.
-  void AccumulateBounds(SkRect& bounds);
+  // and clipping against the current clip. Returns false if the bounds
+  // are entirely outside of the clip.
+  bool AccumulateBounds(SkRect& bounds);
+
+  // Returns true if an op with the given |flags| leaves the destination
+  // unchanged with the current attributes.
+  bool paint_nops_entirely(DisplayListAttributeFlags flags);
+
+  // Returns true if an op outside of the clip could still be moved into
+  // view by the image filter of an enclosing layer.
+  bool in_filtered_layer() const;
+
+  // The most recently set attribute objects of each type. An attribute that
+  // is equal to one of them shares it with |current_| rather than being
+  // cloned again, which matters for lists that alternate between a few
+  // gradients or filters.
+  static constexpr size_t kMaxInternedAttributes = 8u;
+  template <class T>
+  using InternedAttributes = std::vector<std::shared_ptr<const T>>;
+  InternedAttributes<DlColorSource> color_sources_;
+  InternedAttributes<DlImageFilter> image_filters_;
+  InternedAttributes<DlColorFilter> color_filters_;
+  InternedAttributes<DlPathEffect> path_effects_;
+  InternedAttributes<DlMaskFilter> mask_filters_;
+
+  // Returns the interned attribute that is equal to |attribute|, adding a
+  // clone of it if there is none.
+  template <class T>
+  static std::shared_ptr<const T> Intern(InternedAttributes<T>& interned,
+                                         const T* attribute);
 
   DlPaint current_;
 };
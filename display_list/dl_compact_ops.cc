@@ -0,0 +1,359 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_compact_ops.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_op_records.h"
+
+namespace flutter {
+
+namespace {
+
+#define DL_OP_COUNT(name) +1
+constexpr size_t kOpTypeCount = 0 FOR_EACH_DISPLAY_LIST_OP(DL_OP_COUNT)
+#ifdef IMPELLER_ENABLE_3D
+    DL_OP_COUNT(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+    ;
+#undef DL_OP_COUNT
+
+static_assert(sizeof(DLOp) == sizeof(uint32_t));
+
+// The op type byte of a record in the table.
+constexpr uint8_t kTableRecordTag = 0xFF;
+// Set on the op type byte when the size of the record follows it.
+constexpr uint8_t kExplicitSizeFlag = 0x80;
+static_assert(kOpTypeCount < (kExplicitSizeFlag - 1));
+
+// The number of leading words of each op type whose last values are kept
+// as the reference for the next record of that type.
+constexpr size_t kHistoryWords = 16;
+
+// Quantized floats are multiples of 1/16.
+constexpr float kQuantizeScale = 16.0f;
+// Keeps quantized values within the range of exactly representable
+// integers.
+constexpr float kMaxQuantized = 1 << 24;
+
+enum WordTag : uint64_t {
+  kIntegerDelta = 0,
+  kQuantizedDelta = 1,
+  kRaw = 2,
+};
+constexpr int kWordTagBits = 2;
+
+struct OpTraits {
+  // Records that own no references are encoded into the stream, others
+  // are copied to the table.
+  bool encoded;
+  // The number of payload words of a record without any data following
+  // the op structure.
+  uint32_t words;
+};
+
+#define DL_OP_TRAITS(name)                                                   \
+  {                                                                          \
+      std::is_trivially_destructible_v<name##Op>,                            \
+      static_cast<uint32_t>(                                                 \
+          (SkAlignPtr(sizeof(name##Op)) - sizeof(DLOp)) / sizeof(uint32_t)), \
+  },
+constexpr OpTraits kOpTraits[] = {
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_TRAITS)
+#ifdef IMPELLER_ENABLE_3D
+        DL_OP_TRAITS(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+};
+#undef DL_OP_TRAITS
+static_assert(std::size(kOpTraits) == kOpTypeCount);
+
+uint64_t ZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+size_t VarintSize(uint64_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+
+void WriteVarint(std::vector<uint8_t>& stream, uint64_t value) {
+  while (value >= 0x80) {
+    stream.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  stream.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t ReadVarint(const uint8_t*& ptr) {
+  uint64_t value = 0;
+  int shift = 0;
+  uint8_t byte;
+  do {
+    byte = *ptr++;
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return value;
+}
+
+float BitsToFloat(uint32_t bits) {
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+uint32_t FloatToBits(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Returns whether the word is a float that is exactly a multiple of 1/16,
+// and that multiple in |quantized|.
+bool Quantize(uint32_t bits, int32_t* quantized) {
+  float scaled = BitsToFloat(bits) * kQuantizeScale;
+  if (!(std::abs(scaled) <= kMaxQuantized) || scaled != std::trunc(scaled)) {
+    return false;
+  }
+  *quantized = static_cast<int32_t>(scaled);
+  // Rejects values that don't round trip, such as -0.0.
+  return FloatToBits(*quantized / kQuantizeScale) == bits;
+}
+
+int32_t QuantizeOrZero(uint32_t bits) {
+  int32_t quantized;
+  return Quantize(bits, &quantized) ? quantized : 0;
+}
+
+// The reference value that a word of a record is encoded against.
+uint32_t PreviousWord(const uint32_t* history,
+                      const uint32_t* words,
+                      size_t index) {
+  if (index < kHistoryWords) {
+    return history[index];
+  }
+  return words[index - 2];
+}
+
+void EncodeWord(std::vector<uint8_t>& stream, uint32_t word, uint32_t prev) {
+  uint64_t integer =
+      ZigZag(static_cast<int32_t>(word - prev)) << kWordTagBits | kIntegerDelta;
+  size_t best_size = VarintSize(integer);
+  uint64_t best = integer;
+
+  int32_t quantized;
+  if (best_size > 1 && Quantize(word, &quantized)) {
+    uint64_t delta =
+        ZigZag(static_cast<int64_t>(quantized) - QuantizeOrZero(prev))
+            << kWordTagBits |
+        kQuantizedDelta;
+    if (VarintSize(delta) < best_size) {
+      best_size = VarintSize(delta);
+      best = delta;
+    }
+  }
+
+  if (best_size > 1 + sizeof(word)) {
+    WriteVarint(stream, kRaw);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&word);
+    stream.insert(stream.end(), bytes, bytes + sizeof(word));
+  } else {
+    WriteVarint(stream, best);
+  }
+}
+
+uint32_t DecodeWord(const uint8_t*& ptr, uint32_t prev) {
+  uint64_t value = ReadVarint(ptr);
+  switch (value & ((1 << kWordTagBits) - 1)) {
+    case kIntegerDelta:
+      return prev + static_cast<uint32_t>(UnZigZag(value >> kWordTagBits));
+    case kQuantizedDelta: {
+      int64_t quantized =
+          QuantizeOrZero(prev) + UnZigZag(value >> kWordTagBits);
+      return FloatToBits(quantized / kQuantizeScale);
+    }
+    default: {
+      uint32_t word;
+      memcpy(&word, ptr, sizeof(word));
+      ptr += sizeof(word);
+      return word;
+    }
+  }
+}
+
+// Copies a record that owns references into |dst|, along with the data
+// that follows its op structure.
+void CopyRecord(const DLOp* op, uint8_t* dst) {
+  size_t op_size = 0;
+  switch (op->type) {
+#define DL_OP_COPY(name)                                   \
+  case DisplayListOpType::k##name:                         \
+    new (dst) name##Op(*static_cast<const name##Op*>(op)); \
+    op_size = sizeof(name##Op);                            \
+    break;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_COPY)
+#ifdef IMPELLER_ENABLE_3D
+    DL_OP_COPY(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+
+#undef DL_OP_COPY
+  }
+  FML_DCHECK(op_size <= op->size);
+  memcpy(dst + op_size, reinterpret_cast<const uint8_t*>(op) + op_size,
+         op->size - op_size);
+}
+
+std::string_view RecordBytes(const DLOp* op) {
+  return std::string_view(reinterpret_cast<const char*>(op), op->size);
+}
+
+}  // namespace
+
+DlCompactOps::DlCompactOps(const DisplayListStorage& storage,
+                           size_t byte_count) {
+  std::vector<uint8_t> stream;
+  std::vector<uint32_t> history(kOpTypeCount * kHistoryWords);
+
+  // Identical records that own references share one copy in the table,
+  // found by the hash of their bytes.
+  struct TableRecord {
+    const DLOp* op;
+    size_t offset;
+  };
+  std::vector<TableRecord> table_records;
+  std::unordered_multimap<size_t, size_t> table_index;
+  std::hash<std::string_view> hasher;
+
+  storage.ForEachSegment(byte_count, [&](uint8_t* ptr, uint8_t* end) {
+    while (ptr < end) {
+      auto op = reinterpret_cast<const DLOp*>(ptr);
+      ptr += op->size;
+      FML_DCHECK(ptr <= end);
+      auto type = static_cast<size_t>(op->type);
+      FML_DCHECK(type < kOpTypeCount);
+
+      if (!kOpTraits[type].encoded) {
+        auto bytes = RecordBytes(op);
+        auto hash = hasher(bytes);
+        std::optional<size_t> offset;
+        auto range = table_index.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+          const TableRecord& record = table_records[it->second];
+          if (RecordBytes(record.op) == bytes) {
+            offset = record.offset;
+            break;
+          }
+        }
+        if (!offset.has_value()) {
+          offset = table_size_;
+          table_index.emplace(hash, table_records.size());
+          table_records.push_back({op, table_size_});
+          table_size_ += op->size;
+        }
+        // Record sizes, and therefore offsets, are multiples of 8 bytes.
+        stream.push_back(kTableRecordTag);
+        WriteVarint(stream, offset.value() / sizeof(uint64_t));
+        continue;
+      }
+
+      auto words = reinterpret_cast<const uint32_t*>(op + 1);
+      size_t word_count = (op->size - sizeof(DLOp)) / sizeof(uint32_t);
+      if (word_count == kOpTraits[type].words) {
+        stream.push_back(static_cast<uint8_t>(type));
+      } else {
+        stream.push_back(static_cast<uint8_t>(type) | kExplicitSizeFlag);
+        WriteVarint(stream, word_count);
+      }
+      uint32_t* type_history = &history[type * kHistoryWords];
+      for (size_t i = 0; i < word_count; i++) {
+        EncodeWord(stream, words[i], PreviousWord(type_history, words, i));
+      }
+      memcpy(type_history, words,
+             std::min(word_count, kHistoryWords) * sizeof(uint32_t));
+    }
+    return true;
+  });
+
+  if (table_size_ > 0) {
+    table_.realloc(table_size_);
+    memset(table_.get(), 0, table_size_);
+    for (const TableRecord& record : table_records) {
+      CopyRecord(record.op, table_.get() + record.offset);
+    }
+  }
+
+  stream_size_ = stream.size();
+  if (stream_size_ > 0) {
+    stream_.realloc(stream_size_);
+    memcpy(stream_.get(), stream.data(), stream_size_);
+  }
+}
+
+DlCompactOps::~DlCompactOps() {
+  if (table_size_ > 0) {
+    DisplayList::DisposeOps(table_.get(), table_.get() + table_size_);
+  }
+}
+
+DlCompactOps::Reader::Reader(const DlCompactOps& ops)
+    : ptr_(ops.stream_.get()),
+      end_(ops.stream_.get() + ops.stream_size_),
+      table_(ops.table_.get()),
+      history_(kOpTypeCount * kHistoryWords) {}
+
+const DLOp* DlCompactOps::Reader::Next() {
+  if (ptr_ >= end_) {
+    return nullptr;
+  }
+  uint8_t tag = *ptr_++;
+  if (tag == kTableRecordTag) {
+    return reinterpret_cast<const DLOp*>(table_ +
+                                         ReadVarint(ptr_) * sizeof(uint64_t));
+  }
+
+  size_t type = tag & ~kExplicitSizeFlag;
+  FML_DCHECK(type < kOpTypeCount);
+  size_t word_count =
+      (tag & kExplicitSizeFlag) ? ReadVarint(ptr_) : kOpTraits[type].words;
+  size_t size = sizeof(DLOp) + word_count * sizeof(uint32_t);
+  size_t scratch_words = (size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+  if (scratch_.size() < scratch_words) {
+    scratch_.resize(scratch_words);
+  }
+
+  auto op = new (scratch_.data()) DLOp();
+  op->type = static_cast<DisplayListOpType>(type);
+  op->size = size;
+  auto words = reinterpret_cast<uint32_t*>(op + 1);
+  uint32_t* type_history = &history_[type * kHistoryWords];
+  for (size_t i = 0; i < word_count; i++) {
+    words[i] = DecodeWord(ptr_, PreviousWord(type_history, words, i));
+  }
+  memcpy(type_history, words,
+         std::min(word_count, kHistoryWords) * sizeof(uint32_t));
+  FML_DCHECK(ptr_ <= end_);
+  return op;
+}
+
+}  // namespace flutter
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_COMPACT_OPS_H_
+#define FLUTTER_DISPLAY_LIST_DL_COMPACT_OPS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "flutter/display_list/dl_storage.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+struct DLOp;
+
+// A compact encoding of the op records of a DisplayList, for lists that
+// are retained for a long time.
+//
+// Records that consist only of plain data (numbers, enums, and "pod"
+// attribute objects) are encoded into a byte stream. Each record starts
+// with its op type byte, followed by the size of the record only if it
+// differs from the fixed size of that op type. Every 32-bit word of the
+// record is then encoded as a varint tagged with one of:
+//
+// - the difference from the previous value of that word as an integer,
+// - the difference from the previous value of that word as a float
+//   quantized to 1/16, when that represents the value exactly,
+// - the raw 4 bytes of the word.
+//
+// The previous value of a word is the same word of the last record of the
+// same type, so that runs of similar ops, such as rects that are laid out
+// next to each other, only encode what changed. Words past the first few
+// of a record are instead compared to the word 2 before them, which is the
+// matching coordinate of the previous point of point arrays.
+//
+// Records that hold references to other objects are copied to a table
+// that is shared by all of the records that are identical to them, and
+// the stream only holds their offset in the table.
+//
+// The encoding is lossless, the decoded records are bit for bit identical
+// to the records that were encoded.
+class DlCompactOps {
+ public:
+  // Encodes the |byte_count| bytes of op records held by |storage|.
+  DlCompactOps(const DisplayListStorage& storage, size_t byte_count);
+
+  ~DlCompactOps();
+
+  // The number of bytes used by the stream and the table.
+  size_t bytes() const { return stream_size_ + table_size_; }
+
+  // Decodes the records in order.
+  class Reader {
+   public:
+    explicit Reader(const DlCompactOps& ops);
+
+    // Returns the next record, or nullptr if there are no more records.
+    // Decoded records are only valid until the next call.
+    const DLOp* Next();
+
+   private:
+    const uint8_t* ptr_;
+    const uint8_t* const end_;
+    const uint8_t* const table_;
+    std::vector<uint32_t> history_;
+    std::vector<uint64_t> scratch_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Reader);
+  };
+
+ private:
+  DisplayListStorage stream_;
+  size_t stream_size_ = 0;
+  DisplayListStorage table_;
+  size_t table_size_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlCompactOps);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_COMPACT_OPS_H_
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_interning_table.h"
+
+namespace flutter {
+
+DlInterningTable::DlInterningTable() = default;
+
+DlInterningTable::~DlInterningTable() = default;
+
+// Lists with equal ops are drawn identically, but their bounds and R-Tree
+// also depend on the cull rect of the builder that recorded them.
+static bool CanReplace(const DisplayList& interned,
+                       const DisplayList& display_list) {
+  return interned.bounds() == display_list.bounds() &&
+         interned.has_rtree() == display_list.has_rtree() &&
+         interned.Equals(display_list);
+}
+
+sk_sp<DisplayList> DlInterningTable::Intern(
+    const sk_sp<DisplayList>& display_list) {
+  if (!display_list) {
+    return nullptr;
+  }
+  const uint64_t hash = display_list->content_hash();
+  std::scoped_lock lock(mutex_);
+  auto range = lists_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (CanReplace(*it->second, *display_list)) {
+      hit_count_++;
+      return it->second;
+    }
+  }
+  lists_.emplace(hash, display_list);
+  return display_list;
+}
+
+size_t DlInterningTable::Purge() {
+  std::scoped_lock lock(mutex_);
+  size_t removed = 0;
+  for (auto it = lists_.begin(); it != lists_.end();) {
+    if (it->second->unique()) {
+      it = lists_.erase(it);
+      removed++;
+    } else {
+      ++it;
+    }
+  }
+  return removed;
+}
+
+size_t DlInterningTable::size() const {
+  std::scoped_lock lock(mutex_);
+  return lists_.size();
+}
+
+size_t DlInterningTable::hit_count() const {
+  std::scoped_lock lock(mutex_);
+  return hit_count_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_INTERNING_TABLE_H_
+#define FLUTTER_DISPLAY_LIST_DL_INTERNING_TABLE_H_
+
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// A thread-safe table of DisplayLists keyed by their content hash, used to
+// share a single instance of identical content that was recorded more than
+// once, such as the same icon recorded by many list tiles.
+//
+// Since the shared instance keeps its |unique_id|, everything that is keyed
+// by the id of a DisplayList, like the entries of the raster cache, also
+// treats the interned copies as one.
+//
+// The table holds a reference to every list it has returned, so it should
+// be purged regularly (e.g. once per frame) to release the lists that are
+// no longer used anywhere else.
+class DlInterningTable {
+ public:
+  DlInterningTable();
+
+  ~DlInterningTable();
+
+  // Returns a list from the table that can be used in place of
+  // |display_list|, adding |display_list| to the table if there is none.
+  sk_sp<DisplayList> Intern(const sk_sp<DisplayList>& display_list);
+
+  // Removes the lists that are only referenced by the table and returns
+  // the number of lists removed.
+  size_t Purge();
+
+  // The number of lists held by the table.
+  size_t size() const;
+
+  // The number of calls to |Intern| that returned a list that was already
+  // in the table.
+  size_t hit_count() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_multimap<uint64_t, sk_sp<DisplayList>> lists_;
+  size_t hit_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlInterningTable);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_INTERNING_TABLE_H_
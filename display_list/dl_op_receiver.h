@@ -35,6 +35,8 @@ class DlOpReceiver {
   using SrcRectConstraint = DlCanvas::SrcRectConstraint;
 
  public:
+  virtual ~DlOpReceiver() = default;
+
   // MaxDrawPointsCount * sizeof(SkPoint) must be less than 1 << 32
   static constexpr int kMaxDrawPointsCount = ((1 << 29) - 1);
 
@@ -293,10 +293,11 @@ struct SetSceneColorSourceOp : DLOp {
 struct SetSharedImageFilterOp : DLOp {
   static const auto kType = DisplayListOpType::kSetSharedImageFilter;
 
-  SetSharedImageFilterOp(const DlImageFilter* filter)
-      : filter(filter->shared()) {}
+  // Shares the filter that the builder interned rather than cloning it.
+  explicit SetSharedImageFilterOp(std::shared_ptr<const DlImageFilter> filter)
+      : filter(std::move(filter)) {}
 
-  const std::shared_ptr<DlImageFilter> filter;
+  const std::shared_ptr<const DlImageFilter> filter;
 
   void dispatch(DispatchContext& ctx) const {
     ctx.receiver.setImageFilter(filter.get());
@@ -0,0 +1,1677 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_serialization.h"
+
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/display_list/dl_paint.h"
+#include "flutter/display_list/dl_vertices.h"
+#include "flutter/display_list/effects/dl_color_filter.h"
+#include "flutter/display_list/effects/dl_color_source.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/display_list/effects/dl_mask_filter.h"
+#include "flutter/display_list/effects/dl_path_effect.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkSerialProcs.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr uint32_t kDisplayListMagic = 0x54534c44;  // 'DLST'
+constexpr uint32_t kCapturedFrameMagic = 0x52464c44;  // 'DLFR'
+constexpr uint32_t kVersion = 1u;
+
+// Keeps corrupted data from recursing without bounds through nested lists
+// and image filters.
+constexpr int kMaxNestingDepth = 64;
+
+enum class SerializedOp : uint8_t {
+  kEnd,
+
+  kSetAntiAlias,
+  kSetDither,
+  kSetStyle,
+  kSetColor,
+  kSetStrokeWidth,
+  kSetStrokeMiter,
+  kSetStrokeCap,
+  kSetStrokeJoin,
+  kSetColorSource,
+  kSetColorFilter,
+  kSetInvertColors,
+  kSetBlendMode,
+  kSetPathEffect,
+  kSetMaskFilter,
+  kSetImageFilter,
+
+  kSave,
+  kSaveLayer,
+  kRestore,
+
+  kTranslate,
+  kScale,
+  kRotate,
+  kSkew,
+  kTransform2DAffine,
+  kTransformFullPerspective,
+  kTransformReset,
+
+  kClipRect,
+  kClipRRect,
+  kClipPath,
+
+  kDrawColor,
+  kDrawPaint,
+  kDrawLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+  kDrawRRect,
+  kDrawDRRect,
+  kDrawPath,
+  kDrawArc,
+  kDrawPoints,
+  kDrawVertices,
+  kDrawImage,
+  kDrawImageRect,
+  kDrawImageNine,
+  kDrawAtlas,
+  kDrawDisplayList,
+  kDrawTextBlob,
+  kDrawShadow,
+
+  kLast = kDrawShadow,
+};
+
+// Attribute objects are written as their type plus one, or one of these.
+constexpr uint8_t kNoAttribute = 0u;
+constexpr uint8_t kUnsupportedAttribute = 0xFF;
+
+template <typename T>
+uint8_t AttributeTag(T type) {
+  return static_cast<uint8_t>(type) + 1;
+}
+
+sk_sp<SkData> SerializeTypefaceWithData(SkTypeface* typeface, void* ctx) {
+  return typeface->serialize(SkTypeface::SerializeBehavior::kDoIncludeData);
+}
+
+sk_sp<DlImage> MakeRasterPlaceholder(const SkISize& size, bool is_opaque) {
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(SkImageInfo::MakeN32(
+          size.width(), size.height(),
+          is_opaque ? kOpaque_SkAlphaType : kPremul_SkAlphaType))) {
+    return nullptr;
+  }
+  bitmap.eraseColor(SK_ColorGRAY);
+  bitmap.setImmutable();
+  return DlImage::Make(bitmap.asImage());
+}
+
+class Writer {
+ public:
+  Writer() = default;
+
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    WriteBytes(&value, sizeof(T));
+  }
+
+  template <typename T>
+  void WriteArray(const T* values, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    WriteBytes(values, sizeof(T) * count);
+  }
+
+  template <typename E>
+  void WriteEnum(E value) {
+    Write(static_cast<uint8_t>(value));
+  }
+
+  void WriteBool(bool value) { Write<uint8_t>(value ? 1u : 0u); }
+
+  void WriteOp(SerializedOp op) { WriteEnum(op); }
+
+  void WriteMatrix(const SkMatrix& matrix) {
+    SkScalar values[9];
+    matrix.get9(values);
+    WriteArray(values, 9);
+  }
+
+  void WriteRRect(const SkRRect& rrect) {
+    uint8_t buffer[SkRRect::kSizeInMemory];
+    rrect.writeToMemory(buffer);
+    WriteArray(buffer, sizeof(buffer));
+  }
+
+  void WritePath(const SkPath& path) {
+    const size_t size = path.writeToMemory(nullptr);
+    Write(static_cast<uint32_t>(size));
+    const size_t offset = data_.size();
+    data_.resize(offset + size);
+    path.writeToMemory(data_.data() + offset);
+  }
+
+  void WriteColorSource(const DlColorSource* source);
+  void WriteColorFilter(const DlColorFilter* filter);
+  void WriteImageFilter(const DlImageFilter* filter);
+  void WriteMaskFilter(const DlMaskFilter* filter);
+  void WritePathEffect(const DlPathEffect* effect);
+
+  void WriteImage(const DlImage* image);
+  void WriteTextBlob(const SkTextBlob* blob);
+  void WriteDisplayList(const DisplayList& display_list);
+
+  sk_sp<SkData> Finish() {
+    return SkData::MakeWithCopy(data_.data(), data_.size());
+  }
+
+ private:
+  std::vector<uint8_t> data_;
+  // The objects that were already written, and their index in the order
+  // they were written in.
+  std::unordered_map<const DlImage*, uint32_t> images_;
+  std::unordered_map<uint32_t, uint32_t> text_blobs_;
+  std::unordered_map<uint32_t, uint32_t> display_lists_;
+
+  void WriteBytes(const void* bytes, size_t size) {
+    const auto* begin = static_cast<const uint8_t*>(bytes);
+    data_.insert(data_.end(), begin, begin + size);
+  }
+
+  // Writes the index of |key| in |table|, and returns whether it is new
+  // and its contents must follow.
+  template <typename K>
+  bool WriteTableIndex(std::unordered_map<K, uint32_t>& table, K key) {
+    auto [it, inserted] =
+        table.emplace(key, static_cast<uint32_t>(table.size()));
+    Write(it->second);
+    return inserted;
+  }
+
+  void WriteGradient(const DlGradientColorSourceBase* gradient) {
+    Write(static_cast<uint32_t>(gradient->stop_count()));
+    WriteArray(gradient->colors(), gradient->stop_count());
+    WriteArray(gradient->stops(), gradient->stop_count());
+    WriteEnum(gradient->tile_mode());
+    WriteMatrix(gradient->matrix());
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Writer);
+};
+
+class SerializingReceiver final : public DlOpReceiver {
+ public:
+  explicit SerializingReceiver(Writer& writer) : writer_(writer) {}
+
+  void setAntiAlias(bool aa) override {
+    writer_.WriteOp(SerializedOp::kSetAntiAlias);
+    writer_.WriteBool(aa);
+  }
+  void setDither(bool dither) override {
+    writer_.WriteOp(SerializedOp::kSetDither);
+    writer_.WriteBool(dither);
+  }
+  void setStyle(DlDrawStyle style) override {
+    writer_.WriteOp(SerializedOp::kSetStyle);
+    writer_.WriteEnum(style);
+  }
+  void setColor(DlColor color) override {
+    writer_.WriteOp(SerializedOp::kSetColor);
+    writer_.Write(color);
+  }
+  void setStrokeWidth(float width) override {
+    writer_.WriteOp(SerializedOp::kSetStrokeWidth);
+    writer_.Write(width);
+  }
+  void setStrokeMiter(float limit) override {
+    writer_.WriteOp(SerializedOp::kSetStrokeMiter);
+    writer_.Write(limit);
+  }
+  void setStrokeCap(DlStrokeCap cap) override {
+    writer_.WriteOp(SerializedOp::kSetStrokeCap);
+    writer_.WriteEnum(cap);
+  }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    writer_.WriteOp(SerializedOp::kSetStrokeJoin);
+    writer_.WriteEnum(join);
+  }
+  void setColorSource(const DlColorSource* source) override {
+    writer_.WriteOp(SerializedOp::kSetColorSource);
+    writer_.WriteColorSource(source);
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    writer_.WriteOp(SerializedOp::kSetColorFilter);
+    writer_.WriteColorFilter(filter);
+  }
+  void setInvertColors(bool invert) override {
+    writer_.WriteOp(SerializedOp::kSetInvertColors);
+    writer_.WriteBool(invert);
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    writer_.WriteOp(SerializedOp::kSetBlendMode);
+    writer_.WriteEnum(mode);
+  }
+  void setPathEffect(const DlPathEffect* effect) override {
+    writer_.WriteOp(SerializedOp::kSetPathEffect);
+    writer_.WritePathEffect(effect);
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    writer_.WriteOp(SerializedOp::kSetMaskFilter);
+    writer_.WriteMaskFilter(filter);
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    writer_.WriteOp(SerializedOp::kSetImageFilter);
+    writer_.WriteImageFilter(filter);
+  }
+
+  void save() override { writer_.WriteOp(SerializedOp::kSave); }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    writer_.WriteOp(SerializedOp::kSaveLayer);
+    writer_.WriteBool(bounds != nullptr);
+    if (bounds) {
+      writer_.Write(*bounds);
+    }
+    writer_.WriteBool(options.renders_with_attributes());
+    writer_.WriteImageFilter(backdrop);
+  }
+  void restore() override { writer_.WriteOp(SerializedOp::kRestore); }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    writer_.WriteOp(SerializedOp::kTranslate);
+    writer_.Write(tx);
+    writer_.Write(ty);
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    writer_.WriteOp(SerializedOp::kScale);
+    writer_.Write(sx);
+    writer_.Write(sy);
+  }
+  void rotate(SkScalar degrees) override {
+    writer_.WriteOp(SerializedOp::kRotate);
+    writer_.Write(degrees);
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    writer_.WriteOp(SerializedOp::kSkew);
+    writer_.Write(sx);
+    writer_.Write(sy);
+  }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    writer_.WriteOp(SerializedOp::kTransform2DAffine);
+    const SkScalar values[] = {mxx, mxy, mxt, myx, myy, myt};
+    writer_.WriteArray(values, 6);
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    writer_.WriteOp(SerializedOp::kTransformFullPerspective);
+    const SkScalar values[] = {mxx, mxy, mxz, mxt, myx, myy, myz, myt,
+                               mzx, mzy, mzz, mzt, mwx, mwy, mwz, mwt};
+    writer_.WriteArray(values, 16);
+  }
+  // clang-format on
+  void transformReset() override {
+    writer_.WriteOp(SerializedOp::kTransformReset);
+  }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    writer_.WriteOp(SerializedOp::kClipRect);
+    writer_.Write(rect);
+    writer_.WriteEnum(clip_op);
+    writer_.WriteBool(is_aa);
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    writer_.WriteOp(SerializedOp::kClipRRect);
+    writer_.WriteRRect(rrect);
+    writer_.WriteEnum(clip_op);
+    writer_.WriteBool(is_aa);
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    writer_.WriteOp(SerializedOp::kClipPath);
+    writer_.WritePath(path);
+    writer_.WriteEnum(clip_op);
+    writer_.WriteBool(is_aa);
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    writer_.WriteOp(SerializedOp::kDrawColor);
+    writer_.Write(color);
+    writer_.WriteEnum(mode);
+  }
+  void drawPaint() override { writer_.WriteOp(SerializedOp::kDrawPaint); }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    writer_.WriteOp(SerializedOp::kDrawLine);
+    writer_.Write(p0);
+    writer_.Write(p1);
+  }
+  void drawRect(const SkRect& rect) override {
+    writer_.WriteOp(SerializedOp::kDrawRect);
+    writer_.Write(rect);
+  }
+  void drawOval(const SkRect& bounds) override {
+    writer_.WriteOp(SerializedOp::kDrawOval);
+    writer_.Write(bounds);
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    writer_.WriteOp(SerializedOp::kDrawCircle);
+    writer_.Write(center);
+    writer_.Write(radius);
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    writer_.WriteOp(SerializedOp::kDrawRRect);
+    writer_.WriteRRect(rrect);
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    writer_.WriteOp(SerializedOp::kDrawDRRect);
+    writer_.WriteRRect(outer);
+    writer_.WriteRRect(inner);
+  }
+  void drawPath(const SkPath& path) override {
+    writer_.WriteOp(SerializedOp::kDrawPath);
+    writer_.WritePath(path);
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    writer_.WriteOp(SerializedOp::kDrawArc);
+    writer_.Write(oval_bounds);
+    writer_.Write(start_degrees);
+    writer_.Write(sweep_degrees);
+    writer_.WriteBool(use_center);
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    writer_.WriteOp(SerializedOp::kDrawPoints);
+    writer_.WriteEnum(mode);
+    writer_.Write(count);
+    writer_.WriteArray(points, count);
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    writer_.WriteOp(SerializedOp::kDrawVertices);
+    writer_.WriteEnum(vertices->mode());
+    writer_.Write(static_cast<uint32_t>(vertices->vertex_count()));
+    writer_.WriteArray(vertices->vertices(), vertices->vertex_count());
+    writer_.WriteBool(vertices->texture_coordinates() != nullptr);
+    if (vertices->texture_coordinates()) {
+      writer_.WriteArray(vertices->texture_coordinates(),
+                         vertices->vertex_count());
+    }
+    writer_.WriteBool(vertices->colors() != nullptr);
+    if (vertices->colors()) {
+      writer_.WriteArray(vertices->colors(), vertices->vertex_count());
+    }
+    const int index_count = vertices->indices() ? vertices->index_count() : 0;
+    writer_.Write(static_cast<uint32_t>(index_count));
+    writer_.WriteArray(vertices->indices(), index_count);
+    writer_.WriteEnum(mode);
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    writer_.WriteOp(SerializedOp::kDrawImage);
+    writer_.WriteImage(image.get());
+    writer_.Write(point);
+    writer_.WriteEnum(sampling);
+    writer_.WriteBool(render_with_attributes);
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    writer_.WriteOp(SerializedOp::kDrawImageRect);
+    writer_.WriteImage(image.get());
+    writer_.Write(src);
+    writer_.Write(dst);
+    writer_.WriteEnum(sampling);
+    writer_.WriteBool(render_with_attributes);
+    writer_.WriteEnum(constraint);
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    writer_.WriteOp(SerializedOp::kDrawImageNine);
+    writer_.WriteImage(image.get());
+    writer_.Write(center);
+    writer_.Write(dst);
+    writer_.WriteEnum(filter);
+    writer_.WriteBool(render_with_attributes);
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    writer_.WriteOp(SerializedOp::kDrawAtlas);
+    writer_.WriteImage(atlas.get());
+    writer_.Write(static_cast<uint32_t>(count));
+    writer_.WriteArray(xform, count);
+    writer_.WriteArray(tex, count);
+    writer_.WriteBool(colors != nullptr);
+    if (colors) {
+      writer_.WriteArray(colors, count);
+    }
+    writer_.WriteEnum(mode);
+    writer_.WriteEnum(sampling);
+    writer_.WriteBool(cull_rect != nullptr);
+    if (cull_rect) {
+      writer_.Write(*cull_rect);
+    }
+    writer_.WriteBool(render_with_attributes);
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    writer_.WriteOp(SerializedOp::kDrawDisplayList);
+    writer_.WriteDisplayList(*display_list);
+    writer_.Write(opacity);
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    writer_.WriteOp(SerializedOp::kDrawTextBlob);
+    writer_.WriteTextBlob(blob.get());
+    writer_.Write(x);
+    writer_.Write(y);
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    writer_.WriteOp(SerializedOp::kDrawShadow);
+    writer_.WritePath(path);
+    writer_.Write(color);
+    writer_.Write(elevation);
+    writer_.WriteBool(transparent_occluder);
+    writer_.Write(dpr);
+  }
+
+ private:
+  Writer& writer_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SerializingReceiver);
+};
+
+void Writer::WriteColorSource(const DlColorSource* source) {
+  if (!source) {
+    Write(kNoAttribute);
+    return;
+  }
+  if (auto color = source->asColor()) {
+    Write(AttributeTag(source->type()));
+    Write(color->color());
+  } else if (auto image = source->asImage()) {
+    Write(AttributeTag(source->type()));
+    WriteImage(image->image().get());
+    WriteEnum(image->horizontal_tile_mode());
+    WriteEnum(image->vertical_tile_mode());
+    WriteEnum(image->sampling());
+    WriteMatrix(image->matrix());
+  } else if (auto linear = source->asLinearGradient()) {
+    Write(AttributeTag(source->type()));
+    Write(linear->start_point());
+    Write(linear->end_point());
+    WriteGradient(linear);
+  } else if (auto radial = source->asRadialGradient()) {
+    Write(AttributeTag(source->type()));
+    Write(radial->center());
+    Write(radial->radius());
+    WriteGradient(radial);
+  } else if (auto conical = source->asConicalGradient()) {
+    Write(AttributeTag(source->type()));
+    Write(conical->start_center());
+    Write(conical->start_radius());
+    Write(conical->end_center());
+    Write(conical->end_radius());
+    WriteGradient(conical);
+  } else if (auto sweep = source->asSweepGradient()) {
+    Write(AttributeTag(source->type()));
+    Write(sweep->center());
+    Write(sweep->start());
+    Write(sweep->end());
+    WriteGradient(sweep);
+  } else {
+    // Runtime effects and scenes.
+    Write(kUnsupportedAttribute);
+  }
+}
+
+void Writer::WriteColorFilter(const DlColorFilter* filter) {
+  if (!filter) {
+    Write(kNoAttribute);
+    return;
+  }
+  Write(AttributeTag(filter->type()));
+  if (auto blend = filter->asBlend()) {
+    Write(blend->color());
+    WriteEnum(blend->mode());
+  } else if (auto matrix = filter->asMatrix()) {
+    float values[20];
+    matrix->get_matrix(values);
+    WriteArray(values, 20);
+  }
+}
+
+void Writer::WriteImageFilter(const DlImageFilter* filter) {
+  if (!filter) {
+    Write(kNoAttribute);
+    return;
+  }
+  Write(AttributeTag(filter->type()));
+  if (auto blur = filter->asBlur()) {
+    Write(blur->sigma_x());
+    Write(blur->sigma_y());
+    WriteEnum(blur->tile_mode());
+  } else if (auto dilate = filter->asDilate()) {
+    Write(dilate->radius_x());
+    Write(dilate->radius_y());
+  } else if (auto erode = filter->asErode()) {
+    Write(erode->radius_x());
+    Write(erode->radius_y());
+  } else if (auto matrix = filter->asMatrix()) {
+    WriteMatrix(matrix->matrix());
+    WriteEnum(matrix->sampling());
+  } else if (auto compose = filter->asCompose()) {
+    WriteImageFilter(compose->outer().get());
+    WriteImageFilter(compose->inner().get());
+  } else if (auto color_filter = filter->asColorFilter()) {
+    WriteColorFilter(color_filter->color_filter().get());
+  } else if (auto local_matrix = filter->asLocalMatrix()) {
+    WriteMatrix(local_matrix->matrix());
+    WriteImageFilter(local_matrix->image_filter().get());
+  }
+}
+
+void Writer::WriteMaskFilter(const DlMaskFilter* filter) {
+  if (!filter) {
+    Write(kNoAttribute);
+    return;
+  }
+  Write(AttributeTag(filter->type()));
+  if (auto blur = filter->asBlur()) {
+    WriteEnum(blur->style());
+    Write(blur->sigma());
+    WriteBool(blur->respectCTM());
+  }
+}
+
+void Writer::WritePathEffect(const DlPathEffect* effect) {
+  if (!effect) {
+    Write(kNoAttribute);
+    return;
+  }
+  Write(AttributeTag(effect->type()));
+  if (auto dash = effect->asDash()) {
+    Write(static_cast<uint32_t>(dash->count()));
+    WriteArray(dash->intervals(), dash->count());
+    Write(dash->phase());
+  }
+}
+
+void Writer::WriteImage(const DlImage* image) {
+  if (WriteTableIndex(images_, image)) {
+    Write(image->dimensions());
+    WriteBool(image->isOpaque());
+  }
+}
+
+void Writer::WriteTextBlob(const SkTextBlob* blob) {
+  if (WriteTableIndex(text_blobs_, blob->uniqueID())) {
+    SkSerialProcs procs = {};
+    procs.fTypefaceProc = SerializeTypefaceWithData;
+    auto data = blob->serialize(procs);
+    const uint32_t size = data ? data->size() : 0u;
+    Write(size);
+    if (size > 0u) {
+      WriteBytes(data->data(), size);
+    }
+  }
+}
+
+void Writer::WriteDisplayList(const DisplayList& display_list) {
+  if (WriteTableIndex(display_lists_, display_list.unique_id())) {
+    WriteBool(display_list.has_rtree());
+    SerializingReceiver receiver(*this);
+    display_list.Dispatch(receiver);
+    WriteOp(SerializedOp::kEnd);
+  }
+}
+
+class Reader {
+ public:
+  Reader(const void* data,
+         size_t size,
+         const DlImagePlaceholderFactory& image_factory)
+      : ptr_(static_cast<const uint8_t*>(data)),
+        end_(ptr_ + size),
+        image_factory_(image_factory) {}
+
+  bool ok() const { return ok_; }
+
+  bool at_end() const { return ptr_ == end_; }
+
+  template <typename T>
+  bool Read(T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (!ok_ || static_cast<size_t>(end_ - ptr_) < sizeof(T)) {
+      return Fail();
+    }
+    std::memcpy(&value, ptr_, sizeof(T));
+    ptr_ += sizeof(T);
+    return true;
+  }
+
+  template <typename T>
+  bool ReadArray(std::vector<T>& values, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (!ok_ || static_cast<size_t>(end_ - ptr_) / sizeof(T) < count) {
+      return Fail();
+    }
+    values.resize(count);
+    std::memcpy(values.data(), ptr_, sizeof(T) * count);
+    ptr_ += sizeof(T) * count;
+    return true;
+  }
+
+  template <typename E>
+  bool ReadEnum(E& value, E last) {
+    uint8_t raw;
+    if (!Read(raw) || raw > static_cast<uint8_t>(last)) {
+      return Fail();
+    }
+    value = static_cast<E>(raw);
+    return true;
+  }
+
+  bool ReadBool(bool& value) {
+    uint8_t raw;
+    if (!Read(raw) || raw > 1u) {
+      return Fail();
+    }
+    value = raw != 0u;
+    return true;
+  }
+
+  bool ReadMatrix(SkMatrix& matrix) {
+    std::vector<SkScalar> values;
+    if (!ReadArray(values, 9)) {
+      return false;
+    }
+    matrix.set9(values.data());
+    return true;
+  }
+
+  bool ReadRRect(SkRRect& rrect) {
+    if (!ok_ || static_cast<size_t>(end_ - ptr_) < SkRRect::kSizeInMemory ||
+        rrect.readFromMemory(ptr_, SkRRect::kSizeInMemory) == 0) {
+      return Fail();
+    }
+    ptr_ += SkRRect::kSizeInMemory;
+    return true;
+  }
+
+  bool ReadPath(SkPath& path) {
+    uint32_t size;
+    if (!Read(size) || static_cast<size_t>(end_ - ptr_) < size ||
+        path.readFromMemory(ptr_, size) != size) {
+      return Fail();
+    }
+    ptr_ += size;
+    return true;
+  }
+
+  bool ReadColorSource(std::shared_ptr<const DlColorSource>& source);
+  bool ReadColorFilter(std::shared_ptr<const DlColorFilter>& filter);
+  bool ReadImageFilter(std::shared_ptr<const DlImageFilter>& filter,
+                       int depth);
+  bool ReadMaskFilter(std::shared_ptr<const DlMaskFilter>& filter);
+  bool ReadPathEffect(std::shared_ptr<const DlPathEffect>& effect);
+
+  // The images and text blobs that could not be read back are set to
+  // nullptr, and the ops that draw them are skipped.
+  bool ReadImage(sk_sp<DlImage>& image);
+  bool ReadTextBlob(sk_sp<SkTextBlob>& blob);
+  bool ReadDisplayList(sk_sp<DisplayList>& display_list, int depth);
+
+ private:
+  const uint8_t* ptr_;
+  const uint8_t* const end_;
+  const DlImagePlaceholderFactory& image_factory_;
+  bool ok_ = true;
+  std::vector<sk_sp<DlImage>> images_;
+  std::vector<sk_sp<SkTextBlob>> text_blobs_;
+  std::vector<sk_sp<DisplayList>> display_lists_;
+
+  bool Fail() {
+    ok_ = false;
+    return false;
+  }
+
+  // Reads the index of an object and returns whether its contents follow.
+  template <typename T>
+  bool ReadTableIndex(const std::vector<T>& table,
+                      uint32_t& index,
+                      bool& is_new) {
+    if (!Read(index) || index > table.size()) {
+      return Fail();
+    }
+    is_new = index == table.size();
+    return true;
+  }
+
+  struct Gradient {
+    std::vector<DlColor> colors;
+    std::vector<float> stops;
+    DlTileMode tile_mode;
+    SkMatrix matrix;
+  };
+
+  bool ReadGradient(Gradient& gradient) {
+    uint32_t stop_count;
+    return Read(stop_count) && ReadArray(gradient.colors, stop_count) &&
+           ReadArray(gradient.stops, stop_count) &&
+           ReadEnum(gradient.tile_mode, DlTileMode::kDecal) &&
+           ReadMatrix(gradient.matrix);
+  }
+
+  bool ReadOps(DisplayListBuilder& builder, int depth);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Reader);
+};
+
+bool Reader::ReadColorSource(std::shared_ptr<const DlColorSource>& source) {
+  uint8_t tag;
+  if (!Read(tag)) {
+    return false;
+  }
+  source = nullptr;
+  if (tag == kNoAttribute || tag == kUnsupportedAttribute) {
+    return true;
+  }
+  switch (static_cast<DlColorSourceType>(tag - 1)) {
+    case DlColorSourceType::kColor: {
+      DlColor color;
+      if (!Read(color)) {
+        return false;
+      }
+      source = std::make_shared<DlColorColorSource>(color);
+      return true;
+    }
+    case DlColorSourceType::kImage: {
+      sk_sp<DlImage> image;
+      DlTileMode horizontal_tile_mode;
+      DlTileMode vertical_tile_mode;
+      DlImageSampling sampling;
+      SkMatrix matrix;
+      if (!ReadImage(image) ||
+          !ReadEnum(horizontal_tile_mode, DlTileMode::kDecal) ||
+          !ReadEnum(vertical_tile_mode, DlTileMode::kDecal) ||
+          !ReadEnum(sampling, DlImageSampling::kCubic) || !ReadMatrix(matrix)) {
+        return false;
+      }
+      if (image) {
+        source = std::make_shared<DlImageColorSource>(
+            image, horizontal_tile_mode, vertical_tile_mode, sampling,
+            &matrix);
+      }
+      return true;
+    }
+    case DlColorSourceType::kLinearGradient: {
+      SkPoint start_point;
+      SkPoint end_point;
+      Gradient gradient;
+      if (!Read(start_point) || !Read(end_point) || !ReadGradient(gradient)) {
+        return false;
+      }
+      source = DlColorSource::MakeLinear(
+          start_point, end_point, gradient.colors.size(),
+          gradient.colors.data(), gradient.stops.data(), gradient.tile_mode,
+          &gradient.matrix);
+      return true;
+    }
+    case DlColorSourceType::kRadialGradient: {
+      SkPoint center;
+      SkScalar radius;
+      Gradient gradient;
+      if (!Read(center) || !Read(radius) || !ReadGradient(gradient)) {
+        return false;
+      }
+      source = DlColorSource::MakeRadial(
+          center, radius, gradient.colors.size(), gradient.colors.data(),
+          gradient.stops.data(), gradient.tile_mode, &gradient.matrix);
+      return true;
+    }
+    case DlColorSourceType::kConicalGradient: {
+      SkPoint start_center;
+      SkScalar start_radius;
+      SkPoint end_center;
+      SkScalar end_radius;
+      Gradient gradient;
+      if (!Read(start_center) || !Read(start_radius) || !Read(end_center) ||
+          !Read(end_radius) || !ReadGradient(gradient)) {
+        return false;
+      }
+      source = DlColorSource::MakeConical(
+          start_center, start_radius, end_center, end_radius,
+          gradient.colors.size(), gradient.colors.data(),
+          gradient.stops.data(), gradient.tile_mode, &gradient.matrix);
+      return true;
+    }
+    case DlColorSourceType::kSweepGradient: {
+      SkPoint center;
+      SkScalar start;
+      SkScalar end;
+      Gradient gradient;
+      if (!Read(center) || !Read(start) || !Read(end) ||
+          !ReadGradient(gradient)) {
+        return false;
+      }
+      source = DlColorSource::MakeSweep(
+          center, start, end, gradient.colors.size(), gradient.colors.data(),
+          gradient.stops.data(), gradient.tile_mode, &gradient.matrix);
+      return true;
+    }
+    default:
+      return Fail();
+  }
+}
+
+bool Reader::ReadColorFilter(std::shared_ptr<const DlColorFilter>& filter) {
+  uint8_t tag;
+  if (!Read(tag)) {
+    return false;
+  }
+  filter = nullptr;
+  if (tag == kNoAttribute) {
+    return true;
+  }
+  switch (static_cast<DlColorFilterType>(tag - 1)) {
+    case DlColorFilterType::kBlend: {
+      DlColor color;
+      DlBlendMode mode;
+      if (!Read(color) || !ReadEnum(mode, DlBlendMode::kLastMode)) {
+        return false;
+      }
+      filter = std::make_shared<DlBlendColorFilter>(color, mode);
+      return true;
+    }
+    case DlColorFilterType::kMatrix: {
+      std::vector<float> values;
+      if (!ReadArray(values, 20)) {
+        return false;
+      }
+      filter = std::make_shared<DlMatrixColorFilter>(values.data());
+      return true;
+    }
+    case DlColorFilterType::kSrgbToLinearGamma:
+      filter = DlSrgbToLinearGammaColorFilter::instance;
+      return true;
+    case DlColorFilterType::kLinearToSrgbGamma:
+      filter = DlLinearToSrgbGammaColorFilter::instance;
+      return true;
+    default:
+      return Fail();
+  }
+}
+
+bool Reader::ReadImageFilter(std::shared_ptr<const DlImageFilter>& filter,
+                             int depth) {
+  uint8_t tag;
+  if (!Read(tag)) {
+    return false;
+  }
+  filter = nullptr;
+  if (tag == kNoAttribute) {
+    return true;
+  }
+  if (depth > kMaxNestingDepth) {
+    return Fail();
+  }
+  switch (static_cast<DlImageFilterType>(tag - 1)) {
+    case DlImageFilterType::kBlur: {
+      SkScalar sigma_x;
+      SkScalar sigma_y;
+      DlTileMode tile_mode;
+      if (!Read(sigma_x) || !Read(sigma_y) ||
+          !ReadEnum(tile_mode, DlTileMode::kDecal)) {
+        return false;
+      }
+      filter = std::make_shared<DlBlurImageFilter>(sigma_x, sigma_y, tile_mode);
+      return true;
+    }
+    case DlImageFilterType::kDilate: {
+      SkScalar radius_x;
+      SkScalar radius_y;
+      if (!Read(radius_x) || !Read(radius_y)) {
+        return false;
+      }
+      filter = std::make_shared<DlDilateImageFilter>(radius_x, radius_y);
+      return true;
+    }
+    case DlImageFilterType::kErode: {
+      SkScalar radius_x;
+      SkScalar radius_y;
+      if (!Read(radius_x) || !Read(radius_y)) {
+        return false;
+      }
+      filter = std::make_shared<DlErodeImageFilter>(radius_x, radius_y);
+      return true;
+    }
+    case DlImageFilterType::kMatrix: {
+      SkMatrix matrix;
+      DlImageSampling sampling;
+      if (!ReadMatrix(matrix) ||
+          !ReadEnum(sampling, DlImageSampling::kCubic)) {
+        return false;
+      }
+      filter = std::make_shared<DlMatrixImageFilter>(matrix, sampling);
+      return true;
+    }
+    case DlImageFilterType::kCompose: {
+      std::shared_ptr<const DlImageFilter> outer;
+      std::shared_ptr<const DlImageFilter> inner;
+      if (!ReadImageFilter(outer, depth + 1) ||
+          !ReadImageFilter(inner, depth + 1)) {
+        return false;
+      }
+      filter = DlComposeImageFilter::Make(outer, inner);
+      return true;
+    }
+    case DlImageFilterType::kColorFilter: {
+      std::shared_ptr<const DlColorFilter> color_filter;
+      if (!ReadColorFilter(color_filter)) {
+        return false;
+      }
+      filter = DlColorFilterImageFilter::Make(color_filter);
+      return true;
+    }
+    case DlImageFilterType::kLocalMatrix: {
+      SkMatrix matrix;
+      std::shared_ptr<const DlImageFilter> inner;
+      if (!ReadMatrix(matrix) || !ReadImageFilter(inner, depth + 1)) {
+        return false;
+      }
+      if (inner) {
+        filter = std::make_shared<DlLocalMatrixImageFilter>(matrix,
+                                                            inner->shared());
+      }
+      return true;
+    }
+    default:
+      return Fail();
+  }
+}
+
+bool Reader::ReadMaskFilter(std::shared_ptr<const DlMaskFilter>& filter) {
+  uint8_t tag;
+  if (!Read(tag)) {
+    return false;
+  }
+  filter = nullptr;
+  if (tag == kNoAttribute) {
+    return true;
+  }
+  switch (static_cast<DlMaskFilterType>(tag - 1)) {
+    case DlMaskFilterType::kBlur: {
+      DlBlurStyle style;
+      SkScalar sigma;
+      bool respect_ctm;
+      if (!ReadEnum(style, DlBlurStyle::kInner) || !Read(sigma) ||
+          !ReadBool(respect_ctm)) {
+        return false;
+      }
+      filter = std::make_shared<DlBlurMaskFilter>(style, sigma, respect_ctm);
+      return true;
+    }
+    default:
+      return Fail();
+  }
+}
+
+bool Reader::ReadPathEffect(std::shared_ptr<const DlPathEffect>& effect) {
+  uint8_t tag;
+  if (!Read(tag)) {
+    return false;
+  }
+  effect = nullptr;
+  if (tag == kNoAttribute) {
+    return true;
+  }
+  switch (static_cast<DlPathEffectType>(tag - 1)) {
+    case DlPathEffectType::kDash: {
+      uint32_t count;
+      std::vector<SkScalar> intervals;
+      SkScalar phase;
+      if (!Read(count) || !ReadArray(intervals, count) || !Read(phase)) {
+        return false;
+      }
+      effect = DlDashPathEffect::Make(intervals.data(), count, phase);
+      return true;
+    }
+    default:
+      return Fail();
+  }
+}
+
+bool Reader::ReadImage(sk_sp<DlImage>& image) {
+  uint32_t index;
+  bool is_new;
+  if (!ReadTableIndex(images_, index, is_new)) {
+    return false;
+  }
+  if (is_new) {
+    SkISize size;
+    bool is_opaque;
+    if (!Read(size) || !ReadBool(is_opaque)) {
+      return false;
+    }
+    sk_sp<DlImage> placeholder;
+    if (!size.isEmpty()) {
+      placeholder = image_factory_ ? image_factory_(size, is_opaque)
+                                   : MakeRasterPlaceholder(size, is_opaque);
+    }
+    images_.push_back(std::move(placeholder));
+  }
+  image = images_[index];
+  return true;
+}
+
+bool Reader::ReadTextBlob(sk_sp<SkTextBlob>& blob) {
+  uint32_t index;
+  bool is_new;
+  if (!ReadTableIndex(text_blobs_, index, is_new)) {
+    return false;
+  }
+  if (is_new) {
+    uint32_t size;
+    if (!Read(size) || static_cast<size_t>(end_ - ptr_) < size) {
+      return Fail();
+    }
+    text_blobs_.push_back(
+        size > 0u ? SkTextBlob::Deserialize(ptr_, size, SkDeserialProcs())
+                  : nullptr);
+    ptr_ += size;
+  }
+  blob = text_blobs_[index];
+  return true;
+}
+
+bool Reader::ReadDisplayList(sk_sp<DisplayList>& display_list, int depth) {
+  uint32_t index;
+  bool is_new;
+  if (!ReadTableIndex(display_lists_, index, is_new)) {
+    return false;
+  }
+  if (is_new) {
+    if (depth > kMaxNestingDepth) {
+      return Fail();
+    }
+    bool has_rtree;
+    if (!ReadBool(has_rtree)) {
+      return false;
+    }
+    // Nested lists are written after the index of the list that draws
+    // them, so the slot of this list is taken before reading them.
+    display_lists_.push_back(nullptr);
+    DisplayListBuilder builder(has_rtree);
+    if (!ReadOps(builder, depth)) {
+      return false;
+    }
+    display_lists_[index] = builder.Build();
+  }
+  display_list = display_lists_[index];
+  return true;
+}
+
+bool Reader::ReadOps(DisplayListBuilder& builder, int depth) {
+  using ClipOp = DlCanvas::ClipOp;
+  using PointMode = DlCanvas::PointMode;
+  using SrcRectConstraint = DlCanvas::SrcRectConstraint;
+
+  // The attributes set by the ops, which are passed along to the draw ops
+  // that render with attributes.
+  DlPaint paint;
+  while (ok_) {
+    SerializedOp op;
+    if (!ReadEnum(op, SerializedOp::kLast)) {
+      return false;
+    }
+    switch (op) {
+      case SerializedOp::kEnd:
+        return true;
+
+      case SerializedOp::kSetAntiAlias: {
+        bool aa;
+        if (ReadBool(aa)) {
+          paint.setAntiAlias(aa);
+        }
+        break;
+      }
+      case SerializedOp::kSetDither: {
+        bool dither;
+        if (ReadBool(dither)) {
+          paint.setDither(dither);
+        }
+        break;
+      }
+      case SerializedOp::kSetStyle: {
+        DlDrawStyle style;
+        if (ReadEnum(style, DlDrawStyle::kLastStyle)) {
+          paint.setDrawStyle(style);
+        }
+        break;
+      }
+      case SerializedOp::kSetColor: {
+        DlColor color;
+        if (Read(color)) {
+          paint.setColor(color);
+        }
+        break;
+      }
+      case SerializedOp::kSetStrokeWidth: {
+        float width;
+        if (Read(width)) {
+          paint.setStrokeWidth(width);
+        }
+        break;
+      }
+      case SerializedOp::kSetStrokeMiter: {
+        float limit;
+        if (Read(limit)) {
+          paint.setStrokeMiter(limit);
+        }
+        break;
+      }
+      case SerializedOp::kSetStrokeCap: {
+        DlStrokeCap cap;
+        if (ReadEnum(cap, DlStrokeCap::kLastCap)) {
+          paint.setStrokeCap(cap);
+        }
+        break;
+      }
+      case SerializedOp::kSetStrokeJoin: {
+        DlStrokeJoin join;
+        if (ReadEnum(join, DlStrokeJoin::kLastJoin)) {
+          paint.setStrokeJoin(join);
+        }
+        break;
+      }
+      case SerializedOp::kSetColorSource: {
+        std::shared_ptr<const DlColorSource> source;
+        if (ReadColorSource(source)) {
+          paint.setColorSource(source);
+        }
+        break;
+      }
+      case SerializedOp::kSetColorFilter: {
+        std::shared_ptr<const DlColorFilter> filter;
+        if (ReadColorFilter(filter)) {
+          paint.setColorFilter(filter);
+        }
+        break;
+      }
+      case SerializedOp::kSetInvertColors: {
+        bool invert;
+        if (ReadBool(invert)) {
+          paint.setInvertColors(invert);
+        }
+        break;
+      }
+      case SerializedOp::kSetBlendMode: {
+        DlBlendMode mode;
+        if (ReadEnum(mode, DlBlendMode::kLastMode)) {
+          paint.setBlendMode(mode);
+        }
+        break;
+      }
+      case SerializedOp::kSetPathEffect: {
+        std::shared_ptr<const DlPathEffect> effect;
+        if (ReadPathEffect(effect)) {
+          paint.setPathEffect(effect ? effect->shared() : nullptr);
+        }
+        break;
+      }
+      case SerializedOp::kSetMaskFilter: {
+        std::shared_ptr<const DlMaskFilter> filter;
+        if (ReadMaskFilter(filter)) {
+          paint.setMaskFilter(filter ? filter->shared() : nullptr);
+        }
+        break;
+      }
+      case SerializedOp::kSetImageFilter: {
+        std::shared_ptr<const DlImageFilter> filter;
+        if (ReadImageFilter(filter, 0)) {
+          paint.setImageFilter(filter);
+        }
+        break;
+      }
+
+      case SerializedOp::kSave:
+        builder.Save();
+        break;
+      case SerializedOp::kSaveLayer: {
+        bool has_bounds;
+        SkRect bounds;
+        bool renders_with_attributes;
+        std::shared_ptr<const DlImageFilter> backdrop;
+        if (ReadBool(has_bounds) && (!has_bounds || Read(bounds)) &&
+            ReadBool(renders_with_attributes) &&
+            ReadImageFilter(backdrop, 0)) {
+          builder.SaveLayer(has_bounds ? &bounds : nullptr,
+                            renders_with_attributes ? &paint : nullptr,
+                            backdrop.get());
+        }
+        break;
+      }
+      case SerializedOp::kRestore:
+        builder.Restore();
+        break;
+
+      case SerializedOp::kTranslate: {
+        SkScalar tx;
+        SkScalar ty;
+        if (Read(tx) && Read(ty)) {
+          builder.Translate(tx, ty);
+        }
+        break;
+      }
+      case SerializedOp::kScale: {
+        SkScalar sx;
+        SkScalar sy;
+        if (Read(sx) && Read(sy)) {
+          builder.Scale(sx, sy);
+        }
+        break;
+      }
+      case SerializedOp::kRotate: {
+        SkScalar degrees;
+        if (Read(degrees)) {
+          builder.Rotate(degrees);
+        }
+        break;
+      }
+      case SerializedOp::kSkew: {
+        SkScalar sx;
+        SkScalar sy;
+        if (Read(sx) && Read(sy)) {
+          builder.Skew(sx, sy);
+        }
+        break;
+      }
+      case SerializedOp::kTransform2DAffine: {
+        std::vector<SkScalar> m;
+        if (ReadArray(m, 6)) {
+          builder.Transform2DAffine(m[0], m[1], m[2], m[3], m[4], m[5]);
+        }
+        break;
+      }
+      case SerializedOp::kTransformFullPerspective: {
+        std::vector<SkScalar> m;
+        if (ReadArray(m, 16)) {
+          // clang-format off
+          builder.TransformFullPerspective(m[0],  m[1],  m[2],  m[3],
+                                           m[4],  m[5],  m[6],  m[7],
+                                           m[8],  m[9],  m[10], m[11],
+                                           m[12], m[13], m[14], m[15]);
+          // clang-format on
+        }
+        break;
+      }
+      case SerializedOp::kTransformReset:
+        builder.TransformReset();
+        break;
+
+      case SerializedOp::kClipRect: {
+        SkRect rect;
+        ClipOp clip_op;
+        bool is_aa;
+        if (Read(rect) && ReadEnum(clip_op, ClipOp::kIntersect) &&
+            ReadBool(is_aa)) {
+          builder.ClipRect(rect, clip_op, is_aa);
+        }
+        break;
+      }
+      case SerializedOp::kClipRRect: {
+        SkRRect rrect;
+        ClipOp clip_op;
+        bool is_aa;
+        if (ReadRRect(rrect) && ReadEnum(clip_op, ClipOp::kIntersect) &&
+            ReadBool(is_aa)) {
+          builder.ClipRRect(rrect, clip_op, is_aa);
+        }
+        break;
+      }
+      case SerializedOp::kClipPath: {
+        SkPath path;
+        ClipOp clip_op;
+        bool is_aa;
+        if (ReadPath(path) && ReadEnum(clip_op, ClipOp::kIntersect) &&
+            ReadBool(is_aa)) {
+          builder.ClipPath(path, clip_op, is_aa);
+        }
+        break;
+      }
+
+      case SerializedOp::kDrawColor: {
+        DlColor color;
+        DlBlendMode mode;
+        if (Read(color) && ReadEnum(mode, DlBlendMode::kLastMode)) {
+          builder.DrawColor(color, mode);
+        }
+        break;
+      }
+      case SerializedOp::kDrawPaint:
+        builder.DrawPaint(paint);
+        break;
+      case SerializedOp::kDrawLine: {
+        SkPoint p0;
+        SkPoint p1;
+        if (Read(p0) && Read(p1)) {
+          builder.DrawLine(p0, p1, paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawRect: {
+        SkRect rect;
+        if (Read(rect)) {
+          builder.DrawRect(rect, paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawOval: {
+        SkRect bounds;
+        if (Read(bounds)) {
+          builder.DrawOval(bounds, paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawCircle: {
+        SkPoint center;
+        SkScalar radius;
+        if (Read(center) && Read(radius)) {
+          builder.DrawCircle(center, radius, paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawRRect: {
+        SkRRect rrect;
+        if (ReadRRect(rrect)) {
+          builder.DrawRRect(rrect, paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawDRRect: {
+        SkRRect outer;
+        SkRRect inner;
+        if (ReadRRect(outer) && ReadRRect(inner)) {
+          builder.DrawDRRect(outer, inner, paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawPath: {
+        SkPath path;
+        if (ReadPath(path)) {
+          builder.DrawPath(path, paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawArc: {
+        SkRect bounds;
+        SkScalar start;
+        SkScalar sweep;
+        bool use_center;
+        if (Read(bounds) && Read(start) && Read(sweep) &&
+            ReadBool(use_center)) {
+          builder.DrawArc(bounds, start, sweep, use_center, paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawPoints: {
+        PointMode mode;
+        uint32_t count;
+        std::vector<SkPoint> points;
+        if (ReadEnum(mode, PointMode::kPolygon) && Read(count) &&
+            count <= DlOpReceiver::kMaxDrawPointsCount &&
+            ReadArray(points, count)) {
+          builder.DrawPoints(mode, count, points.data(), paint);
+        } else {
+          Fail();
+        }
+        break;
+      }
+      case SerializedOp::kDrawVertices: {
+        DlVertexMode vertex_mode;
+        uint32_t vertex_count;
+        std::vector<SkPoint> vertices;
+        bool has_texture_coordinates;
+        std::vector<SkPoint> texture_coordinates;
+        bool has_colors;
+        std::vector<DlColor> colors;
+        uint32_t index_count;
+        std::vector<uint16_t> indices;
+        DlBlendMode mode;
+        if (ReadEnum(vertex_mode, DlVertexMode::kTriangleFan) &&
+            Read(vertex_count) && ReadArray(vertices, vertex_count) &&
+            ReadBool(has_texture_coordinates) &&
+            (!has_texture_coordinates ||
+             ReadArray(texture_coordinates, vertex_count)) &&
+            ReadBool(has_colors) &&
+            (!has_colors || ReadArray(colors, vertex_count)) &&
+            Read(index_count) && ReadArray(indices, index_count) &&
+            ReadEnum(mode, DlBlendMode::kLastMode)) {
+          auto dl_vertices = DlVertices::Make(
+              vertex_mode, vertex_count, vertices.data(),
+              has_texture_coordinates ? texture_coordinates.data() : nullptr,
+              has_colors ? colors.data() : nullptr, index_count,
+              index_count > 0u ? indices.data() : nullptr);
+          builder.DrawVertices(dl_vertices, mode, paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawImage: {
+        sk_sp<DlImage> image;
+        SkPoint point;
+        DlImageSampling sampling;
+        bool render_with_attributes;
+        if (ReadImage(image) && Read(point) &&
+            ReadEnum(sampling, DlImageSampling::kCubic) &&
+            ReadBool(render_with_attributes) && image) {
+          builder.DrawImage(image, point, sampling,
+                            render_with_attributes ? &paint : nullptr);
+        }
+        break;
+      }
+      case SerializedOp::kDrawImageRect: {
+        sk_sp<DlImage> image;
+        SkRect src;
+        SkRect dst;
+        DlImageSampling sampling;
+        bool render_with_attributes;
+        SrcRectConstraint constraint;
+        if (ReadImage(image) && Read(src) && Read(dst) &&
+            ReadEnum(sampling, DlImageSampling::kCubic) &&
+            ReadBool(render_with_attributes) &&
+            ReadEnum(constraint, SrcRectConstraint::kFast) && image) {
+          builder.DrawImageRect(image, src, dst, sampling,
+                                render_with_attributes ? &paint : nullptr,
+                                constraint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawImageNine: {
+        sk_sp<DlImage> image;
+        SkIRect center;
+        SkRect dst;
+        DlFilterMode filter;
+        bool render_with_attributes;
+        if (ReadImage(image) && Read(center) && Read(dst) &&
+            ReadEnum(filter, DlFilterMode::kLast) &&
+            ReadBool(render_with_attributes) && image) {
+          builder.DrawImageNine(image, center, dst, filter,
+                                render_with_attributes ? &paint : nullptr);
+        }
+        break;
+      }
+      case SerializedOp::kDrawAtlas: {
+        sk_sp<DlImage> atlas;
+        uint32_t count;
+        std::vector<SkRSXform> xforms;
+        std::vector<SkRect> tex;
+        bool has_colors;
+        std::vector<DlColor> colors;
+        DlBlendMode mode;
+        DlImageSampling sampling;
+        bool has_cull_rect;
+        SkRect cull_rect;
+        bool render_with_attributes;
+        if (ReadImage(atlas) && Read(count) && ReadArray(xforms, count) &&
+            ReadArray(tex, count) && ReadBool(has_colors) &&
+            (!has_colors || ReadArray(colors, count)) &&
+            ReadEnum(mode, DlBlendMode::kLastMode) &&
+            ReadEnum(sampling, DlImageSampling::kCubic) &&
+            ReadBool(has_cull_rect) && (!has_cull_rect || Read(cull_rect)) &&
+            ReadBool(render_with_attributes) && atlas) {
+          builder.DrawAtlas(atlas, xforms.data(), tex.data(),
+                            has_colors ? colors.data() : nullptr, count, mode,
+                            sampling, has_cull_rect ? &cull_rect : nullptr,
+                            render_with_attributes ? &paint : nullptr);
+        }
+        break;
+      }
+      case SerializedOp::kDrawDisplayList: {
+        sk_sp<DisplayList> display_list;
+        SkScalar opacity;
+        if (ReadDisplayList(display_list, depth + 1) && Read(opacity) &&
+            display_list) {
+          builder.DrawDisplayList(display_list, opacity);
+        }
+        break;
+      }
+      case SerializedOp::kDrawTextBlob: {
+        sk_sp<SkTextBlob> blob;
+        SkScalar x;
+        SkScalar y;
+        if (ReadTextBlob(blob) && Read(x) && Read(y) && blob) {
+          builder.DrawTextBlob(blob, x, y, paint);
+        }
+        break;
+      }
+      case SerializedOp::kDrawShadow: {
+        SkPath path;
+        DlColor color;
+        SkScalar elevation;
+        bool transparent_occluder;
+        SkScalar dpr;
+        if (ReadPath(path) && Read(color) && Read(elevation) &&
+            ReadBool(transparent_occluder) && Read(dpr)) {
+          builder.DrawShadow(path, color, elevation, transparent_occluder,
+                             dpr);
+        }
+        break;
+      }
+    }
+  }
+  return false;
+}
+
+bool ReadHeader(Reader& reader, uint32_t magic) {
+  uint32_t read_magic;
+  uint32_t version;
+  if (!reader.Read(read_magic) || !reader.Read(version)) {
+    return false;
+  }
+  if (read_magic != magic) {
+    FML_LOG(ERROR) << "Not a serialized DisplayList.";
+    return false;
+  }
+  if (version != kVersion) {
+    FML_LOG(ERROR) << "Unsupported DisplayList serialization version "
+                   << version << ".";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+sk_sp<SkData> DlSerializeDisplayList(const DisplayList& display_list) {
+  Writer writer;
+  writer.Write(kDisplayListMagic);
+  writer.Write(kVersion);
+  writer.WriteDisplayList(display_list);
+  return writer.Finish();
+}
+
+sk_sp<DisplayList> DlDeserializeDisplayList(
+    const void* data,
+    size_t size,
+    const DlImagePlaceholderFactory& image_factory) {
+  Reader reader(data, size, image_factory);
+  sk_sp<DisplayList> display_list;
+  if (!ReadHeader(reader, kDisplayListMagic) ||
+      !reader.ReadDisplayList(display_list, 0) || !reader.at_end()) {
+    return nullptr;
+  }
+  return display_list;
+}
+
+sk_sp<SkData> DlSerializeCapturedFrame(const DlCapturedFrame& frame) {
+  FML_DCHECK(frame.display_list);
+  Writer writer;
+  writer.Write(kCapturedFrameMagic);
+  writer.Write(kVersion);
+  writer.Write(frame.frame_number);
+  writer.Write(frame.frame_size);
+  writer.Write(frame.device_pixel_ratio);
+  writer.WriteDisplayList(*frame.display_list);
+  return writer.Finish();
+}
+
+std::optional<DlCapturedFrame> DlDeserializeCapturedFrame(
+    const void* data,
+    size_t size,
+    const DlImagePlaceholderFactory& image_factory) {
+  Reader reader(data, size, image_factory);
+  DlCapturedFrame frame;
+  if (!ReadHeader(reader, kCapturedFrameMagic) ||
+      !reader.Read(frame.frame_number) || !reader.Read(frame.frame_size) ||
+      !reader.Read(frame.device_pixel_ratio) ||
+      !reader.ReadDisplayList(frame.display_list, 0) || !reader.at_end()) {
+    return std::nullopt;
+  }
+  return frame;
+}
+
+}  // namespace flutter
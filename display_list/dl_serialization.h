@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
+#define FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
+
+#include <functional>
+#include <optional>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/image/dl_image.h"
+
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+// A binary serialization of DisplayLists, used to capture the frames of an
+// app and replay them outside of it (see the dl_replay tool).
+//
+// The serialization is written from the ops of the list, as seen by a
+// DlOpReceiver, and read back by recording the same ops into a
+// DisplayListBuilder. Nested DisplayLists, images and text blobs that are
+// used more than once are only written the first time.
+//
+// The contents of images are not captured, only their size and opacity,
+// and they are replaced by placeholders when the list is read back.
+// Runtime effect color sources are not captured either and are dropped.
+// Everything else is read back as it was recorded.
+//
+// The format is only meant to be read by the engine that wrote it and
+// lists written by other versions of the format are rejected.
+
+// Creates the placeholder for an image of a deserialized list.
+using DlImagePlaceholderFactory =
+    std::function<sk_sp<DlImage>(const SkISize& size, bool is_opaque)>;
+
+// A frame of an app, with its layer tree flattened into a single list.
+struct DlCapturedFrame {
+  uint64_t frame_number = 0;
+  SkISize frame_size = SkISize::MakeEmpty();
+  float device_pixel_ratio = 1.0f;
+  sk_sp<DisplayList> display_list;
+};
+
+sk_sp<SkData> DlSerializeDisplayList(const DisplayList& display_list);
+
+// Returns nullptr if the data is not a valid serialization. Images are
+// replaced with the placeholders returned by |image_factory|, or with
+// raster images of the same size when it is not set.
+sk_sp<DisplayList> DlDeserializeDisplayList(
+    const void* data,
+    size_t size,
+    const DlImagePlaceholderFactory& image_factory = nullptr);
+
+sk_sp<SkData> DlSerializeCapturedFrame(const DlCapturedFrame& frame);
+
+std::optional<DlCapturedFrame> DlDeserializeCapturedFrame(
+    const void* data,
+    size_t size,
+    const DlImagePlaceholderFactory& image_factory = nullptr);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_SERIALIZATION_H_
@@ -0,0 +1,176 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_serialization.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_paint.h"
+#include "flutter/display_list/dl_vertices.h"
+#include "flutter/display_list/effects/dl_color_filter.h"
+#include "flutter/display_list/effects/dl_color_source.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/display_list/effects/dl_mask_filter.h"
+#include "flutter/display_list/effects/dl_path_effect.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static sk_sp<DisplayList> RoundTrip(
+    const sk_sp<DisplayList>& display_list,
+    const DlImagePlaceholderFactory& image_factory = nullptr) {
+  auto data = DlSerializeDisplayList(*display_list);
+  return DlDeserializeDisplayList(data->data(), data->size(), image_factory);
+}
+
+TEST(DisplayListSerialization, RoundTripsShapesAndAttributes) {
+  DisplayListBuilder builder;
+  DlPaint paint;
+  paint.setAntiAlias(true);
+  paint.setColor(DlColor::kRed());
+  builder.DrawRect(SkRect::MakeLTRB(10, 10, 50, 50), paint);
+
+  paint.setDrawStyle(DlDrawStyle::kStroke);
+  paint.setStrokeWidth(3.0f);
+  paint.setStrokeCap(DlStrokeCap::kRound);
+  paint.setStrokeJoin(DlStrokeJoin::kBevel);
+  const SkScalar intervals[] = {5.0f, 2.0f};
+  paint.setPathEffect(DlDashPathEffect::Make(intervals, 2, 1.0f));
+  builder.DrawPath(kTestPath1, paint);
+  builder.DrawRRect(SkRRect::MakeRectXY(SkRect::MakeWH(40, 30), 5, 5), paint);
+
+  paint = DlPaint();
+  const DlColor colors[] = {DlColor::kBlue(), DlColor::kGreen()};
+  const float stops[] = {0.0f, 1.0f};
+  paint.setColorSource(DlColorSource::MakeLinear(
+      SkPoint::Make(0, 0), SkPoint::Make(100, 100), 2, colors, stops,
+      DlTileMode::kMirror));
+  paint.setColorFilter(
+      DlBlendColorFilter::Make(DlColor::kYellow(), DlBlendMode::kModulate));
+  paint.setMaskFilter(DlBlurMaskFilter::Make(DlBlurStyle::kOuter, 2.0f));
+  builder.DrawCircle(SkPoint::Make(50, 50), 20, paint);
+
+  builder.Save();
+  builder.Translate(5, 10);
+  builder.Rotate(30);
+  builder.ClipRRect(SkRRect::MakeOval(SkRect::MakeWH(80, 80)),
+                    DlCanvas::ClipOp::kIntersect, true);
+  builder.ClipPath(kTestPath2, DlCanvas::ClipOp::kDifference, false);
+  builder.DrawPoints(DlCanvas::PointMode::kPolygon, TestPointCount, TestPoints,
+                     paint);
+  builder.Restore();
+
+  DlBlurImageFilter blur(3.0f, 4.0f, DlTileMode::kDecal);
+  DlDilateImageFilter dilate(1.0f, 2.0f);
+  DlComposeImageFilter compose(blur, dilate);
+  builder.SaveLayer(nullptr, nullptr, &compose);
+  builder.DrawShadow(kTestPath1, DlColor::kBlack(), 4.0f, false, 2.0f);
+  builder.Restore();
+
+  auto display_list = builder.Build();
+  auto deserialized = RoundTrip(display_list);
+  ASSERT_NE(deserialized, nullptr);
+  EXPECT_TRUE(deserialized->Equals(display_list));
+}
+
+TEST(DisplayListSerialization, RoundTripsVertices) {
+  const SkPoint coords[] = {{0, 0}, {10, 0}, {0, 10}};
+  const DlColor colors[] = {DlColor::kRed(), DlColor::kGreen(),
+                            DlColor::kBlue()};
+  const uint16_t indices[] = {0, 1, 2};
+  auto vertices = DlVertices::Make(DlVertexMode::kTriangles, 3, coords,
+                                   nullptr, colors, 3, indices);
+  DisplayListBuilder builder;
+  builder.DrawVertices(vertices, DlBlendMode::kSrcOver, DlPaint());
+  auto display_list = builder.Build();
+
+  auto deserialized = RoundTrip(display_list);
+  ASSERT_NE(deserialized, nullptr);
+  EXPECT_TRUE(deserialized->Equals(display_list));
+}
+
+TEST(DisplayListSerialization, WritesSharedNestedListsOnce) {
+  DisplayListBuilder nested_builder;
+  for (int i = 0; i < 100; i++) {
+    nested_builder.DrawRect(SkRect::MakeXYWH(i, i, 10, 10), DlPaint());
+  }
+  auto nested = nested_builder.Build();
+
+  DisplayListBuilder once_builder;
+  once_builder.DrawDisplayList(nested);
+  auto once_data = DlSerializeDisplayList(*once_builder.Build());
+
+  DisplayListBuilder twice_builder;
+  twice_builder.DrawDisplayList(nested);
+  twice_builder.Translate(100, 0);
+  twice_builder.DrawDisplayList(nested, 0.5f);
+  auto twice = twice_builder.Build();
+  auto twice_data = DlSerializeDisplayList(*twice);
+
+  EXPECT_LT(twice_data->size(), once_data->size() + 64u);
+
+  auto deserialized =
+      DlDeserializeDisplayList(twice_data->data(), twice_data->size());
+  ASSERT_NE(deserialized, nullptr);
+  EXPECT_TRUE(deserialized->Equals(twice));
+}
+
+TEST(DisplayListSerialization, ReplacesImagesWithPlaceholders) {
+  DisplayListBuilder builder;
+  builder.DrawImage(TestImage1, SkPoint::Make(0, 0), kLinearSampling);
+  builder.DrawImageRect(TestImage1, SkRect::MakeWH(40, 40),
+                        SkRect::MakeWH(80, 80), kNearestSampling);
+  builder.DrawImage(TestImage2, SkPoint::Make(50, 50), kLinearSampling);
+  auto display_list = builder.Build();
+
+  std::vector<SkISize> placeholder_sizes;
+  auto deserialized = RoundTrip(
+      display_list, [&placeholder_sizes](const SkISize& size, bool is_opaque) {
+        placeholder_sizes.push_back(size);
+        return MakeTestImage(size.width(), size.height(), 5);
+      });
+  ASSERT_NE(deserialized, nullptr);
+  EXPECT_EQ(deserialized->op_count(), display_list->op_count());
+  EXPECT_EQ(deserialized->bounds(), display_list->bounds());
+  ASSERT_EQ(placeholder_sizes.size(), 2u);
+  EXPECT_EQ(placeholder_sizes[0], TestImage1->dimensions());
+  EXPECT_EQ(placeholder_sizes[1], TestImage2->dimensions());
+}
+
+TEST(DisplayListSerialization, RejectsTruncatedData) {
+  DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeWH(10, 10), DlPaint(DlColor::kRed()));
+  builder.DrawPath(kTestPath1, DlPaint());
+  auto data = DlSerializeDisplayList(*builder.Build());
+
+  for (size_t size = 0; size < data->size(); size++) {
+    EXPECT_EQ(DlDeserializeDisplayList(data->data(), size), nullptr) << size;
+  }
+  EXPECT_NE(DlDeserializeDisplayList(data->data(), data->size()), nullptr);
+}
+
+TEST(DisplayListSerialization, RoundTripsCapturedFrames) {
+  DisplayListBuilder builder;
+  builder.DrawColor(DlColor::kWhite(), DlBlendMode::kSrc);
+  DlCapturedFrame frame;
+  frame.frame_number = 42;
+  frame.frame_size = SkISize::Make(1080, 1920);
+  frame.device_pixel_ratio = 2.75f;
+  frame.display_list = builder.Build();
+
+  auto data = DlSerializeCapturedFrame(frame);
+  auto deserialized = DlDeserializeCapturedFrame(data->data(), data->size());
+  ASSERT_TRUE(deserialized.has_value());
+  EXPECT_EQ(deserialized->frame_number, 42u);
+  EXPECT_EQ(deserialized->frame_size, SkISize::Make(1080, 1920));
+  EXPECT_EQ(deserialized->device_pixel_ratio, 2.75f);
+  EXPECT_TRUE(deserialized->display_list->Equals(frame.display_list));
+
+  // Frames and lists are not interchangeable.
+  EXPECT_EQ(DlDeserializeDisplayList(data->data(), data->size()), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
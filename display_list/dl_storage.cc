@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_storage.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace flutter {
+
+std::shared_ptr<DlStorageArena> DlStorageArena::ForCurrentThread() {
+  static thread_local std::shared_ptr<DlStorageArena> arena =
+      std::make_shared<DlStorageArena>();
+  return arena;
+}
+
+DlStorageArena::DlStorageArena(size_t chunk_size, size_t max_retained_bytes)
+    : chunk_size_(chunk_size), max_retained_bytes_(max_retained_bytes) {
+  FML_DCHECK(chunk_size_ > 0);
+}
+
+DlStorageArena::~DlStorageArena() {
+  for (uint8_t* chunk : free_chunks_) {
+    std::free(chunk);
+  }
+}
+
+uint8_t* DlStorageArena::AcquireChunk(size_t min_size, size_t* out_size) {
+  if (min_size <= chunk_size_) {
+    *out_size = chunk_size_;
+    {
+      std::scoped_lock lock(mutex_);
+      if (!free_chunks_.empty()) {
+        uint8_t* chunk = free_chunks_.back();
+        free_chunks_.pop_back();
+        recycled_chunk_count_++;
+        return chunk;
+      }
+      allocated_chunk_count_++;
+    }
+    uint8_t* chunk = static_cast<uint8_t*>(std::malloc(chunk_size_));
+    FML_CHECK(chunk);
+    return chunk;
+  }
+  *out_size = min_size;
+  {
+    std::scoped_lock lock(mutex_);
+    allocated_chunk_count_++;
+  }
+  uint8_t* chunk = static_cast<uint8_t*>(std::malloc(min_size));
+  FML_CHECK(chunk);
+  return chunk;
+}
+
+void DlStorageArena::ReleaseChunk(uint8_t* chunk, size_t size) {
+  if (size == chunk_size_) {
+    std::scoped_lock lock(mutex_);
+    if ((free_chunks_.size() + 1) * chunk_size_ <= max_retained_bytes_) {
+      free_chunks_.push_back(chunk);
+      return;
+    }
+  }
+  std::free(chunk);
+}
+
+size_t DlStorageArena::retained_bytes() const {
+  std::scoped_lock lock(mutex_);
+  return free_chunks_.size() * chunk_size_;
+}
+
+size_t DlStorageArena::recycled_chunk_count() const {
+  std::scoped_lock lock(mutex_);
+  return recycled_chunk_count_;
+}
+
+size_t DlStorageArena::allocated_chunk_count() const {
+  std::scoped_lock lock(mutex_);
+  return allocated_chunk_count_;
+}
+
+DisplayListStorage::DisplayListStorage(DisplayListStorage&& other)
+    : ptr_(std::move(other.ptr_)),
+      arena_(other.arena_),
+      chunks_(std::move(other.chunks_)) {
+  // The moved-from storage stays in the same mode so that a builder can
+  // keep recording into it after handing its records to a DisplayList.
+  other.chunks_.clear();
+}
+
+DisplayListStorage& DisplayListStorage::operator=(DisplayListStorage&& other) {
+  if (this != &other) {
+    ReleaseChunks();
+    ptr_ = std::move(other.ptr_);
+    arena_ = other.arena_;
+    chunks_ = std::move(other.chunks_);
+    other.chunks_.clear();
+  }
+  return *this;
+}
+
+DisplayListStorage::~DisplayListStorage() {
+  ReleaseChunks();
+}
+
+void DisplayListStorage::ReleaseChunks() {
+  for (const Chunk& chunk : chunks_) {
+    arena_->ReleaseChunk(chunk.ptr, chunk.capacity);
+  }
+  chunks_.clear();
+}
+
+uint8_t* DisplayListStorage::Append(size_t size) {
+  FML_DCHECK(is_chunked());
+  if (chunks_.empty() || chunks_.back().used + size > chunks_.back().capacity) {
+    size_t start =
+        chunks_.empty() ? 0 : chunks_.back().start + chunks_.back().used;
+    size_t capacity;
+    uint8_t* ptr = arena_->AcquireChunk(size, &capacity);
+    chunks_.push_back({
+        .ptr = ptr,
+        .capacity = capacity,
+        .start = start,
+        .used = 0,
+    });
+  }
+  Chunk& chunk = chunks_.back();
+  uint8_t* ptr = chunk.ptr + chunk.used;
+  // Recycled chunks contain the records of a previous DisplayList and
+  // fresh chunks are uninitialized, either way the padding bytes of the
+  // new record must be zeroed for the bulk compares done by |Equals|.
+  memset(ptr, 0, size);
+  chunk.used += size;
+  return ptr;
+}
+
+uint8_t* DisplayListStorage::ChunkedAt(size_t offset) const {
+  if (chunks_.empty()) {
+    FML_DCHECK(offset == 0);
+    return nullptr;
+  }
+  // Find the last chunk that starts at or before the offset.
+  auto it = std::upper_bound(
+      chunks_.begin(), chunks_.end(), offset,
+      [](size_t offset, const Chunk& chunk) { return offset < chunk.start; });
+  FML_DCHECK(it != chunks_.begin());
+  const Chunk& chunk = *(--it);
+  FML_DCHECK(offset - chunk.start <= chunk.used);
+  return chunk.ptr + (offset - chunk.start);
+}
+
+}  // namespace flutter
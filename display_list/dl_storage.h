@@ -0,0 +1,198 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_STORAGE_H_
+#define FLUTTER_DISPLAY_LIST_DL_STORAGE_H_
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// A thread-safe recycler of fixed size memory chunks used to hold the
+// op records of DisplayLists that are recorded in chunked mode.
+//
+// Chunks are acquired by a |DisplayListBuilder| while it records and are
+// handed back when the |DisplayList| that ended up owning them is
+// destroyed, which may happen on a different thread (typically the raster
+// thread or the IO thread unref queue). Retaining up to
+// |max_retained_bytes| of released chunks lets the next frame's recording
+// reuse the memory of the previous frame without going back to malloc.
+class DlStorageArena {
+ public:
+  static constexpr size_t kDefaultChunkSize = 16 * 1024;
+  static constexpr size_t kDefaultMaxRetainedBytes = 4 * 1024 * 1024;
+
+  // Returns the arena associated with the calling thread, creating it on
+  // first use. The UI thread uses this arena for all of its recordings.
+  static std::shared_ptr<DlStorageArena> ForCurrentThread();
+
+  explicit DlStorageArena(size_t chunk_size = kDefaultChunkSize,
+                          size_t max_retained_bytes = kDefaultMaxRetainedBytes);
+
+  ~DlStorageArena();
+
+  size_t chunk_size() const { return chunk_size_; }
+
+  // Returns a chunk of at least |min_size| bytes, reusing a previously
+  // released chunk when possible. The actual size of the chunk is stored
+  // into |out_size|. Requests larger than the chunk size are satisfied
+  // with a dedicated allocation that is not recycled.
+  uint8_t* AcquireChunk(size_t min_size, size_t* out_size);
+
+  // Returns a chunk previously obtained from |AcquireChunk|.
+  void ReleaseChunk(uint8_t* chunk, size_t size);
+
+  // The number of bytes held in released chunks awaiting reuse.
+  size_t retained_bytes() const;
+
+  // The number of chunks that were served from the recycled list rather
+  // than from a fresh allocation.
+  size_t recycled_chunk_count() const;
+
+  // The number of chunks that had to be freshly allocated.
+  size_t allocated_chunk_count() const;
+
+ private:
+  const size_t chunk_size_;
+  const size_t max_retained_bytes_;
+
+  mutable std::mutex mutex_;
+  std::vector<uint8_t*> free_chunks_;
+  size_t recycled_chunk_count_ = 0;
+  size_t allocated_chunk_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlStorageArena);
+};
+
+// Manages the memory that holds the op records of a DisplayList.
+//
+// In the default mode the records live in a single buffer allocated with
+// malloc that the |DisplayListBuilder| grows with |realloc| as it records.
+//
+// In chunked mode (when constructed with a |DlStorageArena|) the records
+// are appended into a sequence of chunks obtained from the arena. An op
+// record never straddles two chunks and already-written records are never
+// moved, so growing the storage never copies. Offsets into chunked
+// storage are logical offsets, counting only the bytes used in each chunk,
+// so that they line up with the byte counts the builder tracks.
+class DisplayListStorage {
+ public:
+  DisplayListStorage() = default;
+  explicit DisplayListStorage(std::shared_ptr<DlStorageArena> arena)
+      : arena_(std::move(arena)) {}
+  DisplayListStorage(DisplayListStorage&& other);
+  DisplayListStorage& operator=(DisplayListStorage&& other);
+
+  ~DisplayListStorage();
+
+  bool is_chunked() const { return arena_ != nullptr; }
+
+  // The base of the contiguous buffer, or of the first chunk if the
+  // storage is chunked.
+  uint8_t* get() const {
+    return is_chunked() ? (chunks_.empty() ? nullptr : chunks_.front().ptr)
+                        : ptr_.get();
+  }
+
+  // Resizes the contiguous buffer. Only valid in the default mode.
+  void realloc(size_t count) {
+    FML_DCHECK(!is_chunked());
+    ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
+    FML_CHECK(ptr_);
+  }
+
+  // Appends |size| zero-initialized bytes to the chunked storage and
+  // returns their address, starting a new chunk if the current one
+  // cannot hold them. Only valid in chunked mode.
+  uint8_t* Append(size_t size);
+
+  // Translates a logical offset into the address of the byte at that
+  // offset.
+  uint8_t* at(size_t offset) const {
+    return is_chunked() ? ChunkedAt(offset) : ptr_.get() + offset;
+  }
+
+  // Invokes |segment_fn(start, end)| for each contiguous run of op records
+  // in order, stopping early if the function returns false. |size| is the
+  // number of bytes in use, needed for the contiguous mode.
+  template <typename F>
+  bool ForEachSegment(size_t size, F&& segment_fn) const {
+    if (!is_chunked()) {
+      uint8_t* ptr = ptr_.get();
+      return size == 0 || segment_fn(ptr, ptr + size);
+    }
+    for (const Chunk& chunk : chunks_) {
+      if (chunk.used > 0 && !segment_fn(chunk.ptr, chunk.ptr + chunk.used)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Invokes |segment_fn(start, end)| for each contiguous run of the op
+  // records between |offset| and |size| and then discards them, so that
+  // the next records are written at |offset|. The discarded bytes are
+  // zeroed like the bytes of fresh storage.
+  template <typename F>
+  void Truncate(size_t offset, size_t size, F&& segment_fn) {
+    FML_DCHECK(offset <= size);
+    if (!is_chunked()) {
+      if (offset < size) {
+        segment_fn(ptr_.get() + offset, ptr_.get() + size);
+        memset(ptr_.get() + offset, 0, size - offset);
+      }
+      return;
+    }
+    // Chunks are always zeroed again by |Append|.
+    while (!chunks_.empty()) {
+      Chunk& chunk = chunks_.back();
+      size_t start = offset > chunk.start ? offset - chunk.start : 0;
+      if (start < chunk.used) {
+        segment_fn(chunk.ptr + start, chunk.ptr + chunk.used);
+      }
+      if (chunk.start < offset) {
+        chunk.used = start;
+        break;
+      }
+      arena_->ReleaseChunk(chunk.ptr, chunk.capacity);
+      chunks_.pop_back();
+    }
+  }
+
+  // The number of chunks currently held, 0 for contiguous storage.
+  size_t chunk_count() const { return chunks_.size(); }
+
+ private:
+  struct Chunk {
+    uint8_t* ptr;
+    size_t capacity;
+    // Logical offset of the first byte of this chunk.
+    size_t start;
+    size_t used;
+  };
+
+  uint8_t* ChunkedAt(size_t offset) const;
+  void ReleaseChunks();
+
+  struct FreeDeleter {
+    void operator()(uint8_t* p) { std::free(p); }
+  };
+  std::unique_ptr<uint8_t, FreeDeleter> ptr_;
+
+  std::shared_ptr<DlStorageArena> arena_;
+  std::vector<Chunk> chunks_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListStorage);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_STORAGE_H_
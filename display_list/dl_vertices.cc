@@ -138,7 +138,9 @@ DlVertices::DlVertices(const DlVertices* other)
                  other->colors(),
                  other->index_count_,
                  other->indices(),
-                 &other->bounds_) {}
+                 &other->bounds_) {
+  content_hash_ = other->content_hash_;
+}
 
 DlVertices::DlVertices(DlVertexMode mode,
                        int unchecked_vertex_count,
@@ -176,6 +178,33 @@ DlVertices::DlVertices(DlVertexMode mode,
   FML_DCHECK((index_count_ != 0) == (indices() != nullptr));
 }
 
+uint64_t DlVertices::compute_content_hash() const {
+  auto mix = [](uint64_t hash, uint64_t value) {
+    hash = (hash ^ value) * 0x9e3779b97f4a7c15u;
+    return hash ^ (hash >> 29);
+  };
+  uint64_t hash = mix(static_cast<uint64_t>(mode_), vertex_count_);
+  hash = mix(hash, index_count_);
+  hash = mix(hash, texture_coordinates_offset_);
+  hash = mix(hash, colors_offset_);
+  // The lists are laid out back to back after the object.
+  const char* data = reinterpret_cast<const char*>(this) + sizeof(DlVertices);
+  size_t length = size() - sizeof(DlVertices);
+  while (length >= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    hash = mix(hash, word);
+    data += sizeof(word);
+    length -= sizeof(word);
+  }
+  if (length > 0) {
+    uint64_t word = 0;
+    memcpy(&word, data, length);
+    hash = mix(hash, word);
+  }
+  return hash;
+}
+
 bool DlVertices::operator==(DlVertices const& other) const {
   auto lists_equal = [](auto* a, auto* b, int count) {
     if (a == nullptr || b == nullptr) {
@@ -189,6 +218,7 @@ bool DlVertices::operator==(DlVertices const& other) const {
     return true;
   };
   return                                                               //
+      content_hash_ == other.content_hash_ &&                          //
       mode_ == other.mode_ &&                                          //
       vertex_count_ == other.vertex_count_ &&                          //
       lists_equal(vertices(), other.vertices(), vertex_count_) &&      //
@@ -292,6 +322,7 @@ std::shared_ptr<DlVertices> DlVertices::Builder::build() {
 
   vertices_->bounds_ =
       compute_bounds(vertices_->vertices(), vertices_->vertex_count_);
+  vertices_->content_hash_ = vertices_->compute_content_hash();
 
   return std::move(vertices_);
 }
@@ -228,6 +228,11 @@ class DlVertices {
     return static_cast<const uint16_t*>(pod(indices_offset_));
   }
 
+  /// Returns a hash of the mode and of all of the lists of data. Vertices
+  /// with equal contents have equal hashes, so renderers can use it to
+  /// share the buffers they upload the data to across frames.
+  uint64_t content_hash() const { return content_hash_; }
+
   bool operator==(DlVertices const& other) const;
 
   bool operator!=(DlVertices const& other) const { return !(*this == other); }
@@ -271,6 +276,10 @@ class DlVertices {
 
   SkRect bounds_;
 
+  uint64_t content_hash_ = 0;
+
+  uint64_t compute_content_hash() const;
+
   const void* pod(int offset) const {
     if (offset <= 0) {
       return nullptr;
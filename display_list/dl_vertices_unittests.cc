@@ -6,6 +6,7 @@
 #include "flutter/display_list/dl_vertices.h"
 #include "flutter/display_list/testing/dl_test_equality.h"
 #include "flutter/display_list/utils/dl_comparable.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "gtest/gtest.h"
 
 namespace flutter {
@@ -977,5 +978,53 @@ TEST(DisplayListVertices, TestNotEquals) {
   }
 }
 
+TEST(DisplayListVertices, ContentHashFollowsContents) {
+  SkPoint coords[3] = {
+      SkPoint::Make(2, 3),
+      SkPoint::Make(5, 6),
+      SkPoint::Make(15, 20),
+  };
+  DlColor colors[3] = {
+      DlColor::kRed(),
+      DlColor::kCyan(),
+      DlColor::kGreen(),
+  };
+
+  auto vertices1 = DlVertices::Make(DlVertexMode::kTriangles, 3, coords,
+                                    nullptr, colors, 0, nullptr);
+  auto vertices2 = DlVertices::Make(DlVertexMode::kTriangles, 3, coords,
+                                    nullptr, colors, 0, nullptr);
+  EXPECT_EQ(vertices1->content_hash(), vertices2->content_hash());
+
+  auto fan = DlVertices::Make(DlVertexMode::kTriangleFan, 3, coords, nullptr,
+                              colors, 0, nullptr);
+  EXPECT_NE(vertices1->content_hash(), fan->content_hash());
+
+  auto no_colors = DlVertices::Make(DlVertexMode::kTriangles, 3, coords,
+                                    nullptr, nullptr, 0, nullptr);
+  EXPECT_NE(vertices1->content_hash(), no_colors->content_hash());
+
+  coords[2] = SkPoint::Make(15, 21);
+  auto moved = DlVertices::Make(DlVertexMode::kTriangles, 3, coords, nullptr,
+                                colors, 0, nullptr);
+  EXPECT_NE(vertices1->content_hash(), moved->content_hash());
+
+  // Copies recorded into display lists keep the hash.
+  DisplayListBuilder builder;
+  builder.DrawVertices(vertices1, DlBlendMode::kSrcOver, DlPaint());
+  class VerticesReceiver : public IgnoreAttributeDispatchHelper,
+                           public IgnoreClipDispatchHelper,
+                           public IgnoreTransformDispatchHelper,
+                           public IgnoreDrawDispatchHelper {
+   public:
+    void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+      hash = vertices->content_hash();
+    }
+    uint64_t hash = 0;
+  } receiver;
+  builder.Build()->Dispatch(receiver);
+  EXPECT_EQ(receiver.hash, vertices1->content_hash());
+}
+
 }  // namespace testing
 }  // namespace flutter
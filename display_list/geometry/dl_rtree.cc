@@ -4,10 +4,50 @@
 
 #include "flutter/display_list/geometry/dl_rtree.h"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 #include "flutter/fml/logging.h"
 
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DL_RTREE_NEON 1
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define DL_RTREE_SSE 1
+#endif
+
 namespace flutter {
 
+namespace {
+
+// Whether two non-empty rects intersect, as |SkRect::Intersects| would
+// find them to. All four edges are compared at once where SIMD
+// instructions are available, as
+// (a.left, a.top, b.left, b.top) < (b.right, b.bottom, a.right, a.bottom).
+inline bool Intersects(const SkRect& a, const SkRect& b) {
+#if DL_RTREE_NEON
+  const float32x4_t av = vld1q_f32(&a.fLeft);
+  const float32x4_t bv = vld1q_f32(&b.fLeft);
+  const uint32x4_t less =
+      vcltq_f32(vcombine_f32(vget_low_f32(av), vget_low_f32(bv)),
+                vcombine_f32(vget_high_f32(bv), vget_high_f32(av)));
+  const uint32x2_t both = vand_u32(vget_low_u32(less), vget_high_u32(less));
+  return (vget_lane_u32(both, 0) & vget_lane_u32(both, 1)) != 0;
+#elif DL_RTREE_SSE
+  const __m128 av = _mm_loadu_ps(&a.fLeft);
+  const __m128 bv = _mm_loadu_ps(&b.fLeft);
+  return _mm_movemask_ps(_mm_cmplt_ps(_mm_movelh_ps(av, bv),
+                                      _mm_movehl_ps(av, bv))) == 0xF;
+#else
+  return a.fLeft < b.fRight && a.fTop < b.fBottom &&  //
+         b.fLeft < a.fRight && b.fTop < a.fBottom;
+#endif
+}
+
+}  // namespace
+
 DlRTree::DlRTree(const SkRect rects[],
                  int N,
                  const int ids[],
@@ -61,21 +101,18 @@ DlRTree::DlRTree(const SkRect rects[],
   FML_DCHECK(leaf_index == leaf_count);
 
   // --- Implementation note ---
-  // Many R-Tree algorithms attempt to consolidate nearby rectangles
-  // into branches of the tree in order to maximize the benefit of
-  // bounds testing against whole sub-trees. The Skia code from which
-  // this was based, though, indicated that empirical tests against a
-  // browser client showed little gains in rendering performance while
-  // costing 17% performance in bulk loading the rects into the R-Tree:
-  // https://github.com/google/skia/blob/12b6bd042f7cdffb9012c90c3b4885601fc7be95/src/core/SkRTree.cpp#L96
+  // The rectangles are bulk loaded with the Sort-Tile-Recursive (STR)
+  // algorithm. Each generation of nodes is sorted into vertical slices
+  // by the horizontal center of the nodes, and each slice by their
+  // vertical center, so that each run of |kMaxChildren| nodes in that
+  // order are near each other and are given the same parent. This keeps
+  // the bounds of the parents small, so that searches can skip more of
+  // the tree, whatever the order in which the rectangles were recorded.
   //
-  // Given that this class will most often be used to track rendering
-  // operations that were drawn in an app that performs a type of
-  // "page layout" with rendering proceeding in a linear fashion from
-  // top to bottom (and left to right or right to left), the rectangles
-  // are likely nearly sorted when they are delivered to this constructor
-  // so leaving them in their original order should show similar results
-  // to what Skia found in their empirical browser tests.
+  // The leaves keep the order in which the rectangles were passed in,
+  // since their indices are the results of the searches, so the parents
+  // refer to their children through |children_| rather than owning a
+  // range of |nodes_|.
   // ---
 
   // Continually process the previous level (generation) of nodes,
@@ -85,57 +122,74 @@ DlRTree::DlRTree(const SkRect rects[],
   // Each generation will end up reduced by a factor of up to kMaxChildren
   // until there is just one node left, which is the root node of
   // the R-Tree.
-  uint32_t gen_start = 0;
-  gen_count = leaf_count;
-  while (gen_count > 1) {
-    uint32_t gen_end = gen_start + gen_count;
-
-    uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
-    FML_DCHECK(gen_end + family_count <= total_node_count);
-
-    // D here is similar to the variable in a Bresenham line algorithm where
-    // we want to slowly move |family_count| steps along the minor axis as
-    // we move |gen_count| steps along the major axis.
-    //
-    // Each inner loop increments D by family_count.
-    // The inner loop executes a total of gen_count times.
-    // Every time D exceeds 0 we subtract gen_count and move to a new parent.
-    // All told we will increment D by family_count a total of gen_count times.
-    // All told we will decrement D by gen_count a total of family_count times.
-    // This leaves D back at its starting value.
-    //
-    // We could bias/balance where the extra children are placed by varying
-    // the initial count of D from 0 to (1 - family_count), but we aren't
-    // looking at this process aesthetically so we just use 0 as an initial
-    // value. Using 0 provides a "greedy" allocation of the extra children.
-    // Bresenham also uses double the size of the steps we use here also to
-    // have better rounding of when the minor axis steps occur, but again we
-    // don't care about the distribution of the extra children.
-    int D = 0;
-
-    uint32_t sibling_index = gen_start;
-    uint32_t parent_index = gen_end;
-    Node* parent = nullptr;
-    while (sibling_index < gen_end) {
-      if ((D += family_count) > 0) {
-        D -= gen_count;
-        FML_DCHECK(parent_index < gen_end + family_count);
-        parent = &nodes_[parent_index++];
-        parent->bounds.setEmpty();
-        parent->child.index = sibling_index;
-        parent->child.count = 0;
+  children_.reserve(total_node_count - 1);
+  std::vector<uint32_t> generation(leaf_count);
+  std::iota(generation.begin(), generation.end(), 0u);
+  uint32_t parent_index = leaf_count;
+  while (generation.size() > 1) {
+    sortTileRecursive(generation);
+    std::vector<uint32_t> parents;
+    parents.reserve((generation.size() + kMaxChildren - 1u) / kMaxChildren);
+    for (size_t i = 0; i < generation.size(); i += kMaxChildren) {
+      FML_DCHECK(parent_index < total_node_count);
+      Node& parent = nodes_[parent_index];
+      parent.bounds.setEmpty();
+      parent.child.index = children_.size();
+      parent.child.count = 0;
+      size_t end = std::min<size_t>(i + kMaxChildren, generation.size());
+      for (size_t j = i; j < end; j++) {
+        parent.bounds.join(nodes_[generation[j]].bounds);
+        children_.push_back(generation[j]);
+        parent.child.count++;
       }
-      FML_DCHECK(parent != nullptr);
-      parent->bounds.join(nodes_[sibling_index++].bounds);
-      parent->child.count++;
+      parents.push_back(parent_index++);
     }
-    FML_DCHECK(D == 0);
-    FML_DCHECK(sibling_index == gen_end);
-    FML_DCHECK(parent_index == gen_end + family_count);
-    gen_start = gen_end;
-    gen_count = family_count;
+    generation = std::move(parents);
+  }
+  FML_DCHECK(parent_index == total_node_count);
+  FML_DCHECK(children_.size() == total_node_count - 1);
+}
+
+void DlRTree::sortTileRecursive(std::vector<uint32_t>& generation) const {
+  struct Entry {
+    float x;
+    float y;
+    uint32_t index;
+  };
+  // Rectangles that extend to infinity have no center. They are all
+  // sorted as if they were centered on the origin.
+  auto center = [](float a, float b) {
+    float c = a * 0.5f + b * 0.5f;
+    return std::isnan(c) ? 0.0f : c;
+  };
+  std::vector<Entry> entries;
+  entries.reserve(generation.size());
+  for (uint32_t index : generation) {
+    const SkRect& bounds = nodes_[index].bounds;
+    entries.push_back({center(bounds.fLeft, bounds.fRight),
+                       center(bounds.fTop, bounds.fBottom), index});
+  }
+
+  size_t parent_count = (entries.size() + kMaxChildren - 1u) / kMaxChildren;
+  auto slice_count = static_cast<size_t>(
+      std::ceil(std::sqrt(static_cast<double>(parent_count))));
+  // Slices hold a whole number of parents, so that no parent straddles
+  // two slices.
+  size_t slice_size = slice_count * kMaxChildren;
+
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+    return a.x < b.x || (a.x == b.x && a.index < b.index);
+  });
+  for (size_t i = 0; i < entries.size(); i += slice_size) {
+    auto slice_end = entries.begin() + std::min(i + slice_size, entries.size());
+    std::sort(entries.begin() + i, slice_end,
+              [](const Entry& a, const Entry& b) {
+                return a.y < b.y || (a.y == b.y && a.index < b.index);
+              });
+  }
+  for (size_t i = 0; i < entries.size(); i++) {
+    generation[i] = entries[i].index;
   }
-  FML_DCHECK(gen_start + gen_count == total_node_count);
 }
 
 void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
@@ -148,14 +202,52 @@ void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
     return;
   }
   const Node& root = nodes_.back();
-  if (root.bounds.intersects(query)) {
+  if (Intersects(root.bounds, query)) {
     if (nodes_.size() == 1) {
       FML_DCHECK(leaf_count_ == 1);
       // The root node is the only node and it is a leaf node
       results->push_back(0);
     } else {
+      size_t first_result = results->size();
       search(root, query, results);
+      // The tree is traversed in spatial order, the results are returned
+      // in the order of the rectangles.
+      std::sort(results->begin() + first_result, results->end());
+    }
+  }
+}
+
+void DlRTree::searchAll(const std::vector<SkRect>& queries,
+                        std::vector<std::vector<int>>* results) const {
+  FML_DCHECK(results != nullptr);
+  results->clear();
+  results->resize(queries.size());
+  if (nodes_.empty()) {
+    FML_DCHECK(leaf_count_ == 0);
+    return;
+  }
+  const Node& root = nodes_.back();
+  std::vector<int> query_indices;
+  for (size_t i = 0; i < queries.size(); i++) {
+    if (!queries[i].isEmpty() && Intersects(root.bounds, queries[i])) {
+      query_indices.push_back(i);
+    }
+  }
+  if (query_indices.empty()) {
+    return;
+  }
+  if (nodes_.size() == 1) {
+    FML_DCHECK(leaf_count_ == 1);
+    // The root node is the only node and it is a leaf node
+    for (int query_index : query_indices) {
+      (*results)[query_index].push_back(0);
     }
+    return;
+  }
+  searchAll(root, queries, query_indices, results);
+  for (int query_index : query_indices) {
+    auto& query_results = (*results)[query_index];
+    std::sort(query_results.begin(), query_results.end());
   }
 }
 
@@ -167,51 +259,55 @@ std::list<SkRect> DlRTree::searchAndConsolidateRects(
 
   std::list<SkRect> final_results;
   for (int index : intermediary_results) {
-    auto current_record_rect = bounds(index);
-    auto replaced_existing_rect = false;
-    // // If the current record rect intersects with any of the rects in the
-    // // result list, then join them, and update the rect in final_results.
-    std::list<SkRect>::iterator curr_rect_itr = final_results.begin();
-    std::list<SkRect>::iterator first_intersecting_rect_itr;
-    while (!replaced_existing_rect && curr_rect_itr != final_results.end()) {
-      if (SkRect::Intersects(*curr_rect_itr, current_record_rect)) {
-        replaced_existing_rect = true;
-        first_intersecting_rect_itr = curr_rect_itr;
-        curr_rect_itr->join(current_record_rect);
-      }
-      curr_rect_itr++;
-    }
-    // It's possible that the result contains duplicated rects at this point.
-    // For example, consider a result list that contains rects A, B. If a
-    // new rect C is a superset of A and B, then A and B are the same set after
-    // the merge. As a result, find such cases and remove them from the result
-    // list.
-    while (replaced_existing_rect && curr_rect_itr != final_results.end()) {
-      if (SkRect::Intersects(*curr_rect_itr, *first_intersecting_rect_itr)) {
-        first_intersecting_rect_itr->join(*curr_rect_itr);
-        curr_rect_itr = final_results.erase(curr_rect_itr);
-      } else {
-        curr_rect_itr++;
-      }
+    consolidateRect(&final_results, bounds(index));
+  }
+  return final_results;
+}
+
+void DlRTree::consolidateRect(std::list<SkRect>* rects, const SkRect& rect) {
+  FML_DCHECK(rects != nullptr);
+  auto replaced_existing_rect = false;
+  // If the rect intersects with any of the rects in the list, then join
+  // them, and update the rect in the list.
+  std::list<SkRect>::iterator curr_rect_itr = rects->begin();
+  std::list<SkRect>::iterator first_intersecting_rect_itr;
+  while (!replaced_existing_rect && curr_rect_itr != rects->end()) {
+    if (SkRect::Intersects(*curr_rect_itr, rect)) {
+      replaced_existing_rect = true;
+      first_intersecting_rect_itr = curr_rect_itr;
+      curr_rect_itr->join(rect);
     }
-    if (!replaced_existing_rect) {
-      final_results.push_back(current_record_rect);
+    curr_rect_itr++;
+  }
+  // It's possible that the list contains duplicated rects at this point.
+  // For example, consider a list that contains rects A, B. If a new rect
+  // C is a superset of A and B, then A and B are the same set after the
+  // merge. As a result, find such cases and remove them from the list.
+  while (replaced_existing_rect && curr_rect_itr != rects->end()) {
+    if (SkRect::Intersects(*curr_rect_itr, *first_intersecting_rect_itr)) {
+      first_intersecting_rect_itr->join(*curr_rect_itr);
+      curr_rect_itr = rects->erase(curr_rect_itr);
+    } else {
+      curr_rect_itr++;
     }
   }
-  return final_results;
+  if (!replaced_existing_rect) {
+    rects->push_back(rect);
+  }
 }
 
 void DlRTree::search(const Node& parent,
                      const SkRect& query,
                      std::vector<int>* results) const {
   // Caller protects against empty query
-  int start = parent.child.index;
-  int end = start + parent.child.count;
-  for (int i = start; i < end; i++) {
-    const Node& node = nodes_[i];
-    if (node.bounds.intersects(query)) {
-      if (i < leaf_count_) {
-        results->push_back(i);
+  uint32_t start = parent.child.index;
+  uint32_t end = start + parent.child.count;
+  for (uint32_t i = start; i < end; i++) {
+    int index = children_[i];
+    const Node& node = nodes_[index];
+    if (Intersects(node.bounds, query)) {
+      if (index < leaf_count_) {
+        results->push_back(index);
       } else {
         search(node, query, results);
       }
@@ -219,4 +315,35 @@ void DlRTree::search(const Node& parent,
   }
 }
 
+void DlRTree::searchAll(const Node& parent,
+                        const std::vector<SkRect>& queries,
+                        const std::vector<int>& query_indices,
+                        std::vector<std::vector<int>>* results) const {
+  // Caller protects against empty queries
+  std::vector<int> hits;
+  hits.reserve(query_indices.size());
+  uint32_t start = parent.child.index;
+  uint32_t end = start + parent.child.count;
+  for (uint32_t i = start; i < end; i++) {
+    int index = children_[i];
+    const Node& node = nodes_[index];
+    hits.clear();
+    for (int query_index : query_indices) {
+      if (Intersects(node.bounds, queries[query_index])) {
+        hits.push_back(query_index);
+      }
+    }
+    if (hits.empty()) {
+      continue;
+    }
+    if (index < leaf_count_) {
+      for (int query_index : hits) {
+        (*results)[query_index].push_back(index);
+      }
+    } else {
+      searchAll(node, queries, hits, results);
+    }
+  }
+}
+
 }  // namespace flutter
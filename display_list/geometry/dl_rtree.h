@@ -17,9 +17,14 @@ namespace flutter {
 /// An R-Tree that stores a list of bounding rectangles with optional
 /// associated IDs.
 ///
-/// The R-Tree can be searched in one of two ways:
+/// The R-Tree is bulk loaded with the Sort-Tile-Recursive algorithm,
+/// which groups nearby rectangles under the same internal nodes.
+///
+/// The R-Tree can be searched in one of three ways:
 /// - Query for a list of hits among the original rectangles
 ///   @see |search|
+/// - Query for the lists of hits of many rectangles at once
+///   @see |searchAll|
 /// - Query for a set of non-overlapping rectangles that are joined
 ///   from the original rectangles that intersect a query rect
 ///   @see |searchAndConsolidateRects|
@@ -28,7 +33,8 @@ class DlRTree : public SkRefCnt {
   static constexpr int kMaxChildren = 11;
 
   // Leaf nodes at start of vector have an ID,
-  // Internal nodes after that have child index and count.
+  // Internal nodes after that have the index and count of their
+  // children in |children_|.
   struct Node {
     SkRect bounds;
     union {
@@ -70,13 +76,22 @@ class DlRTree : public SkRefCnt {
   ///
   /// Note that the indices are internal indices of the stored data
   /// and not the index of the rectangles or ids in the constructor.
-  /// The returned indices may not themselves be in numerical order,
-  /// but they will represent the rectangles and IDs in the order in
-  /// which they were passed into the constructor. The actual rectangle
-  /// and ID associated with each index can be retreived using the
-  /// |DlRTree::id| and |DlRTree::bouds| methods.
+  /// The returned indices are in numerical order, which is the order
+  /// in which the rectangles and IDs were passed into the constructor.
+  /// The actual rectangle and ID associated with each index can be
+  /// retreived using the |DlRTree::id| and |DlRTree::bouds| methods.
   void search(const SkRect& query, std::vector<int>* results) const;
 
+  /// Search the rectangles for each of the queries, sharing the
+  /// traversal of the tree between them, and return the leaf node
+  /// indices that intersect each query in the corresponding vector
+  /// of |results|, in the same order as |search| returns them.
+  ///
+  /// This is cheaper than searching each query on its own when the
+  /// queries are near each other, such as the tiles of a frame.
+  void searchAll(const std::vector<SkRect>& queries,
+                 std::vector<std::vector<int>>* results) const;
+
   /// Return the ID for the indicated result of a query or
   /// invalid_id if the index is not a valid leaf node index.
   int id(int result_index) const {
@@ -95,7 +110,8 @@ class DlRTree : public SkRefCnt {
 
   /// Returns the bytes used by the object and all of its node data.
   size_t bytes_used() const {
-    return sizeof(DlRTree) + sizeof(Node) * nodes_.size();
+    return sizeof(DlRTree) + sizeof(Node) * nodes_.size() +
+           sizeof(uint32_t) * children_.size();
   }
 
   /// Returns the number of leaf nodes corresponding to non-empty
@@ -115,6 +131,10 @@ class DlRTree : public SkRefCnt {
   /// exclusive.
   std::list<SkRect> searchAndConsolidateRects(const SkRect& query) const;
 
+  /// Adds the rect to a list of mutually exclusive rects, joining it with
+  /// any rects of the list that it intersects, and them with each other.
+  static void consolidateRect(std::list<SkRect>* rects, const SkRect& rect);
+
  private:
   static constexpr SkRect empty_ = SkRect::MakeEmpty();
 
@@ -122,7 +142,18 @@ class DlRTree : public SkRefCnt {
               const SkRect& query,
               std::vector<int>* results) const;
 
+  void searchAll(const Node& parent,
+                 const std::vector<SkRect>& queries,
+                 const std::vector<int>& query_indices,
+                 std::vector<std::vector<int>>* results) const;
+
+  // Sorts the indices of a generation of nodes so that each run of
+  // |kMaxChildren| of them holds nodes that are near each other.
+  void sortTileRecursive(std::vector<uint32_t>& generation) const;
+
   std::vector<Node> nodes_;
+  // The node indices of the children of each internal node.
+  std::vector<uint32_t> children_;
   int leaf_count_;
   int invalid_id_;
 };
@@ -301,5 +301,85 @@ TEST(DisplayListRTree, OverlappingRects) {
   EXPECT_EQ(list.front(), SkRect::MakeLTRB(0, 0, 70, 70));
 }
 
+TEST(DisplayListRTree, ResultsInOrderOfRectsWhateverTheirPositions) {
+  // The rects are spread out in an order that is unrelated to their
+  // positions, so the tree groups them in a different order.
+  const int kCount = 500;
+  SkRect rects[kCount];
+  for (int i = 0; i < kCount; i++) {
+    int cell = (i * 37) % kCount;
+    int x = (cell % 25) * 10;
+    int y = (cell / 25) * 10;
+    rects[i] = SkRect::MakeXYWH(x, y, 15, 15);
+  }
+  DlRTree tree(rects, kCount);
+  ASSERT_EQ(tree.leaf_count(), kCount);
+
+  for (int x = 0; x < 250; x += 23) {
+    for (int y = 0; y < 200; y += 17) {
+      auto query = SkRect::MakeXYWH(x, y, 31, 29);
+      std::vector<int> results;
+      tree.search(query, &results);
+      std::vector<int> expected;
+      for (int i = 0; i < kCount; i++) {
+        if (SkRect::Intersects(rects[i], query)) {
+          expected.push_back(i);
+        }
+      }
+      ASSERT_EQ(results, expected) << x << ", " << y;
+    }
+  }
+}
+
+TEST(DisplayListRTree, SearchAllMatchesSearch) {
+  const int kCount = 400;
+  SkRect rects[kCount];
+  for (int i = 0; i < kCount; i++) {
+    int x = (i * 53) % 400;
+    int y = (i * 29) % 300;
+    rects[i] = SkRect::MakeXYWH(x, y, 5 + i % 40, 5 + i % 30);
+  }
+  DlRTree tree(rects, kCount);
+
+  // A grid of tiles, an empty query and a query outside of the rects.
+  std::vector<SkRect> queries;
+  for (int y = 0; y < 350; y += 64) {
+    for (int x = 0; x < 450; x += 64) {
+      queries.push_back(SkRect::MakeXYWH(x, y, 64, 64));
+    }
+  }
+  queries.push_back(SkRect::MakeEmpty());
+  queries.push_back(SkRect::MakeXYWH(1000, 1000, 10, 10));
+
+  std::vector<std::vector<int>> all_results;
+  tree.searchAll(queries, &all_results);
+  ASSERT_EQ(all_results.size(), queries.size());
+  for (size_t i = 0; i < queries.size(); i++) {
+    std::vector<int> results;
+    tree.search(queries[i], &results);
+    EXPECT_EQ(all_results[i], results) << i;
+  }
+  EXPECT_TRUE(all_results[queries.size() - 2].empty());
+  EXPECT_TRUE(all_results[queries.size() - 1].empty());
+}
+
+TEST(DisplayListRTree, SearchAllSingleRectAndEmptyTree) {
+  auto rect = SkRect::MakeLTRB(10, 10, 20, 20);
+  DlRTree tree(&rect, 1);
+  std::vector<SkRect> queries = {SkRect::MakeLTRB(0, 0, 15, 15),
+                                 SkRect::MakeLTRB(20, 20, 30, 30)};
+  std::vector<std::vector<int>> results;
+  tree.searchAll(queries, &results);
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_EQ(results[0], std::vector<int>{0});
+  EXPECT_TRUE(results[1].empty());
+
+  DlRTree empty_tree(nullptr, 0);
+  empty_tree.searchAll(queries, &results);
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_TRUE(results[0].empty());
+  EXPECT_TRUE(results[1].empty());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -264,6 +264,51 @@ void DlSkCanvasDispatcher::drawDisplayList(
   // Restore canvas state to what it was before dispatching.
   canvas_->restoreToCount(restore_count);
 }
+namespace {
+
+// Holds the canvas for a |DlSkTileDispatcher| so that it is constructed
+// before the DlSkCanvasDispatcher base class that renders into it.
+struct DlSkTileCanvasHolder {
+  explicit DlSkTileCanvasHolder(std::unique_ptr<SkCanvas> canvas)
+      : tile_canvas(std::move(canvas)) {}
+
+  std::unique_ptr<SkCanvas> tile_canvas;
+};
+
+// A DlSkCanvasDispatcher that owns the canvas rendering a single tile.
+class DlSkTileDispatcher final : private DlSkTileCanvasHolder,
+                                 public DlSkCanvasDispatcher {
+ public:
+  explicit DlSkTileDispatcher(std::unique_ptr<SkCanvas> canvas)
+      : DlSkTileCanvasHolder(std::move(canvas)),
+        DlSkCanvasDispatcher(tile_canvas.get()) {}
+};
+
+}  // namespace
+
+void DlSkCanvasDispatcher::DrawToPixmapTiled(
+    const DisplayList& display_list,
+    const SkPixmap& pixmap,
+    const SkISize& tile_size,
+    const std::shared_ptr<fml::BasicTaskRunner>& runner) {
+  display_list.DispatchTiled(
+      pixmap.bounds(), tile_size, runner,
+      [&pixmap](const SkIRect& tile) -> std::unique_ptr<DlOpReceiver> {
+        SkPixmap tile_pixmap;
+        if (!pixmap.extractSubset(&tile_pixmap, tile)) {
+          return nullptr;
+        }
+        std::unique_ptr<SkCanvas> canvas = SkCanvas::MakeRasterDirect(
+            tile_pixmap.info(), tile_pixmap.writable_addr(),
+            tile_pixmap.rowBytes());
+        if (!canvas) {
+          return nullptr;
+        }
+        canvas->translate(-tile.fLeft, -tile.fTop);
+        return std::make_unique<DlSkTileDispatcher>(std::move(canvas));
+      });
+}
+
 void DlSkCanvasDispatcher::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                         SkScalar x,
                                         SkScalar y) {
@@ -113,6 +113,22 @@ class DlSkCanvasDispatcher : public virtual DlOpReceiver,
                          bool transparentOccluder,
                          SkScalar dpr);
 
+  // Rasterizes |display_list| into the pixels of |pixmap|, whose origin
+  // corresponds to the origin of the DisplayList, by splitting the pixmap
+  // into tiles of |tile_size| that are rendered concurrently on |runner|
+  // through separate SkCanvas instances. See |DisplayList::DispatchTiled|.
+  //
+  // Each tile only touches the pixels inside its own bounds so the tiles
+  // never contend with each other, but unlike a single canvas the results
+  // are only identical to a non-tiled rendering of the DisplayList if its
+  // ops do not depend on pixels outside of the tile being rendered, such
+  // as backdrop filters reading across tile boundaries.
+  static void DrawToPixmapTiled(
+      const DisplayList& display_list,
+      const SkPixmap& pixmap,
+      const SkISize& tile_size,
+      const std::shared_ptr<fml::BasicTaskRunner>& runner);
+
  private:
   SkCanvas* canvas_;
   const SkM44 original_transform_;
@@ -27,42 +27,43 @@ bool Equals(const T* a, const T* b) {
 }
 
 template <class T>
-bool Equals(std::shared_ptr<const T> a, const T* b) {
+bool Equals(const std::shared_ptr<const T>& a, const T* b) {
   return Equals(a.get(), b);
 }
 
 template <class T>
-bool Equals(std::shared_ptr<T> a, const T* b) {
+bool Equals(const std::shared_ptr<T>& a, const T* b) {
   return Equals(a.get(), b);
 }
 
 template <class T>
-bool Equals(const T* a, std::shared_ptr<const T> b) {
+bool Equals(const T* a, const std::shared_ptr<const T>& b) {
   return Equals(a, b.get());
 }
 
 template <class T>
-bool Equals(const T* a, std::shared_ptr<T> b) {
+bool Equals(const T* a, const std::shared_ptr<T>& b) {
   return Equals(a, b.get());
 }
 
 template <class T>
-bool Equals(std::shared_ptr<const T> a, std::shared_ptr<const T> b) {
+bool Equals(const std::shared_ptr<const T>& a,
+            const std::shared_ptr<const T>& b) {
   return Equals(a.get(), b.get());
 }
 
 template <class T>
-bool Equals(std::shared_ptr<T> a, std::shared_ptr<const T> b) {
+bool Equals(const std::shared_ptr<T>& a, const std::shared_ptr<const T>& b) {
   return Equals(a.get(), b.get());
 }
 
 template <class T>
-bool Equals(std::shared_ptr<const T> a, std::shared_ptr<T> b) {
+bool Equals(const std::shared_ptr<const T>& a, const std::shared_ptr<T>& b) {
   return Equals(a.get(), b.get());
 }
 
 template <class T>
-bool Equals(std::shared_ptr<T> a, std::shared_ptr<T> b) {
+bool Equals(const std::shared_ptr<T>& a, const std::shared_ptr<T>& b) {
   return Equals(a.get(), b.get());
 }
 
@@ -72,42 +73,43 @@ bool NotEquals(const T* a, const T* b) {
 }
 
 template <class T>
-bool NotEquals(std::shared_ptr<const T> a, const T* b) {
+bool NotEquals(const std::shared_ptr<const T>& a, const T* b) {
   return !Equals(a.get(), b);
 }
 
 template <class T>
-bool NotEquals(std::shared_ptr<T> a, const T* b) {
+bool NotEquals(const std::shared_ptr<T>& a, const T* b) {
   return !Equals(a.get(), b);
 }
 
 template <class T>
-bool NotEquals(const T* a, std::shared_ptr<const T> b) {
+bool NotEquals(const T* a, const std::shared_ptr<const T>& b) {
   return !Equals(a, b.get());
 }
 
 template <class T>
-bool NotEquals(const T* a, std::shared_ptr<T> b) {
+bool NotEquals(const T* a, const std::shared_ptr<T>& b) {
   return !Equals(a, b.get());
 }
 
 template <class T>
-bool NotEquals(std::shared_ptr<const T> a, std::shared_ptr<const T> b) {
+bool NotEquals(const std::shared_ptr<const T>& a,
+               const std::shared_ptr<const T>& b) {
   return !Equals(a.get(), b.get());
 }
 
 template <class T>
-bool NotEquals(std::shared_ptr<T> a, std::shared_ptr<const T> b) {
+bool NotEquals(const std::shared_ptr<T>& a, const std::shared_ptr<const T>& b) {
   return !Equals(a.get(), b.get());
 }
 
 template <class T>
-bool NotEquals(std::shared_ptr<const T> a, std::shared_ptr<T> b) {
+bool NotEquals(const std::shared_ptr<const T>& a, const std::shared_ptr<T>& b) {
   return !Equals(a.get(), b.get());
 }
 
 template <class T>
-bool NotEquals(std::shared_ptr<T> a, std::shared_ptr<T> b) {
+bool NotEquals(const std::shared_ptr<T>& a, const std::shared_ptr<T>& b) {
   return !Equals(a.get(), b.get());
 }
 
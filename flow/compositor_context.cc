@@ -15,39 +15,60 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
     flutter::LayerTree& layer_tree,
     bool has_raster_cache) {
   if (layer_tree.root_layer()) {
-    PaintRegionMap empty_paint_region_map;
-    DiffContext context(layer_tree.frame_size(),
-                        layer_tree.device_pixel_ratio(),
-                        layer_tree.paint_region_map(),
-                        prev_layer_tree_ ? prev_layer_tree_->paint_region_map()
-                                         : empty_paint_region_map,
-                        has_raster_cache);
-    context.PushCullRect(SkRect::MakeIWH(layer_tree.frame_size().width(),
-                                         layer_tree.frame_size().height()));
-    {
-      DiffContext::AutoSubtreeRestore subtree(&context);
-      const Layer* prev_root_layer = nullptr;
-      if (!prev_layer_tree_ ||
-          prev_layer_tree_->frame_size() != layer_tree.frame_size()) {
-        // If there is no previous layer tree assume the entire frame must be
-        // repainted.
-        context.MarkSubtreeDirty(SkRect::MakeIWH(
-            layer_tree.frame_size().width(), layer_tree.frame_size().height()));
-      } else {
-        prev_root_layer = prev_layer_tree_->root_layer();
-      }
-      layer_tree.root_layer()->Diff(&context, prev_root_layer);
-    }
-
-    damage_ =
-        context.ComputeDamage(additional_damage_, horizontal_clip_alignment_,
-                              vertical_clip_alignment_);
+    Diff(layer_tree, has_raster_cache);
     return SkRect::Make(damage_->buffer_damage);
   } else {
     return std::nullopt;
   }
 }
 
+bool FrameDamage::IsUnchanged(flutter::LayerTree& layer_tree,
+                              bool has_raster_cache) {
+  if (!layer_tree.root_layer()) {
+    return false;
+  }
+  Diff(layer_tree, has_raster_cache);
+  // The root of the previous layer tree knows whether it embeds platform
+  // views if it was prerolled, and previous layer trees that weren't were
+  // unchanged themselves. Platform views that aren't in the previous layer
+  // tree are damaged by the diff like any other new layer.
+  return prev_layer_tree_ && prev_layer_tree_->root_layer() &&
+         !prev_layer_tree_->root_layer()->subtree_has_platform_view() &&
+         prev_layer_tree_->device_pixel_ratio() ==
+             layer_tree.device_pixel_ratio() &&
+         damage_->frame_damage.isEmpty();
+}
+
+void FrameDamage::Diff(flutter::LayerTree& layer_tree, bool has_raster_cache) {
+  PaintRegionMap empty_paint_region_map;
+  DiffContext context(layer_tree.frame_size(), layer_tree.device_pixel_ratio(),
+                      layer_tree.paint_region_map(),
+                      prev_layer_tree_ ? prev_layer_tree_->paint_region_map()
+                                       : empty_paint_region_map,
+                      has_raster_cache);
+  context.SetTextureRegistry(texture_registry_);
+  context.PushCullRect(SkRect::MakeIWH(layer_tree.frame_size().width(),
+                                       layer_tree.frame_size().height()));
+  {
+    DiffContext::AutoSubtreeRestore subtree(&context);
+    const Layer* prev_root_layer = nullptr;
+    if (!prev_layer_tree_ || !prev_layer_tree_->root_layer() ||
+        prev_layer_tree_->frame_size() != layer_tree.frame_size()) {
+      // If there is no previous layer tree assume the entire frame must be
+      // repainted.
+      context.MarkSubtreeDirty(SkRect::MakeIWH(
+          layer_tree.frame_size().width(), layer_tree.frame_size().height()));
+    } else {
+      prev_root_layer = prev_layer_tree_->root_layer();
+    }
+    layer_tree.root_layer()->Diff(&context, prev_root_layer);
+  }
+
+  damage_ =
+      context.ComputeDamage(additional_damage_, horizontal_clip_alignment_,
+                            vertical_clip_alignment_);
+}
+
 CompositorContext::CompositorContext()
     : texture_registry_(std::make_shared<TextureRegistry>()),
       raster_time_(fixed_refresh_rate_updater_),
@@ -172,11 +193,15 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
 void CompositorContext::OnGrContextCreated() {
   texture_registry_->OnGrContextCreated();
   raster_cache_.Clear();
+  raster_time_.ClearVisualizeCache();
+  ui_time_.ClearVisualizeCache();
 }
 
 void CompositorContext::OnGrContextDestroyed() {
   texture_registry_->OnGrContextDestroyed();
   raster_cache_.Clear();
+  raster_time_.ClearVisualizeCache();
+  ui_time_.ClearVisualizeCache();
 }
 
 }  // namespace flutter
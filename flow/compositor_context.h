@@ -12,6 +12,7 @@
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/instrumentation.h"
+#include "flutter/flow/layer_cost_store.h"
 #include "flutter/flow/layer_snapshot_store.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/macros.h"
@@ -48,8 +49,9 @@ enum class RasterStatus {
   kEnqueuePipeline,
   // Failed to rasterize the frame.
   kFailed,
-  // Layer tree was discarded due to LayerTreeDiscardCallback or inability to
-  // access the GPU.
+  // Layer tree was discarded due to LayerTreeDiscardCallback, inability to
+  // access the GPU, or because it was stale and a newer one was waiting to be
+  // rasterized.
   kDiscarded,
   // Drawing was yielded to allow the correct thread to draw as a result of the
   // RasterThreadMerger.
@@ -70,6 +72,13 @@ class FrameDamage {
     additional_damage_.join(damage);
   }
 
+  // Sets the registry that tells which textures have new frames, so that
+  // texture layers whose textures don't are not damaged. If not set, every
+  // texture layer is repainted.
+  void SetTextureRegistry(const TextureRegistry* texture_registry) {
+    texture_registry_ = texture_registry;
+  }
+
   // Specifies clip rect alignment.
   void SetClipAlignment(int horizontal, int vertical) {
     horizontal_clip_alignment_ = horizontal;
@@ -84,6 +93,15 @@ class FrameDamage {
   std::optional<SkRect> ComputeClipRect(flutter::LayerTree& layer_tree,
                                         bool has_raster_cache);
 
+  // Returns whether layer_tree renders identically to the previous layer tree,
+  // in which case the frame doesn't need to be rasterized or presented.
+  // The paint region of layer_tree is calculated either way, so that it can
+  // be used for diffing of subsequent frames.
+  //
+  // Frames showing platform views are never considered unchanged, as the
+  // contents of platform views can change without the layer tree changing.
+  bool IsUnchanged(flutter::LayerTree& layer_tree, bool has_raster_cache);
+
   // See Damage::frame_damage.
   std::optional<SkIRect> GetFrameDamage() const {
     return damage_ ? std::make_optional(damage_->frame_damage) : std::nullopt;
@@ -95,9 +113,12 @@ class FrameDamage {
   }
 
  private:
+  void Diff(flutter::LayerTree& layer_tree, bool has_raster_cache);
+
   SkIRect additional_damage_ = SkIRect::MakeEmpty();
   std::optional<Damage> damage_;
   const LayerTree* prev_layer_tree_ = nullptr;
+  const TextureRegistry* texture_registry_ = nullptr;
   int vertical_clip_alignment_ = 1;
   int horizontal_clip_alignment_ = 1;
 };
@@ -139,6 +160,15 @@ class CompositorContext {
 
     impeller::AiksContext* aiks_context() const { return aiks_context_; }
 
+    // The surface that the root canvas of the frame renders into, if its
+    // pixels can be read back during painting. See
+    // |PaintContext::readback_surface|.
+    void set_readback_surface(SkSurface* surface) {
+      readback_surface_ = surface;
+    }
+
+    SkSurface* readback_surface() const { return readback_surface_; }
+
     virtual RasterStatus Raster(LayerTree& layer_tree,
                                 bool ignore_raster_cache,
                                 FrameDamage* frame_damage);
@@ -154,6 +184,7 @@ class CompositorContext {
     const bool instrumentation_enabled_;
     const bool surface_supports_readback_;
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
+    SkSurface* readback_surface_ = nullptr;
 
     FML_DISALLOW_COPY_AND_ASSIGN(ScopedFrame);
   };
@@ -191,12 +222,15 @@ class CompositorContext {
 
   LayerSnapshotStore& snapshot_store() { return layer_snapshot_store_; }
 
+  LayerCostStore& layer_cost_store() { return layer_cost_store_; }
+
  private:
   RasterCache raster_cache_;
   std::shared_ptr<TextureRegistry> texture_registry_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
   LayerSnapshotStore layer_snapshot_store_;
+  LayerCostStore layer_cost_store_;
 
   /// Only used by default constructor of `CompositorContext`.
   FixedRefreshRateUpdater fixed_refresh_rate_updater_;
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/flow/diff_context.h"
+#include "flutter/common/graphics/texture.h"
 #include "flutter/flow/layers/layer.h"
 
 namespace flutter {
@@ -244,20 +245,57 @@ void DiffContext::AddDamage(const SkRect& rect) {
   damage_.join(rect);
 }
 
+void DiffContext::BeginChildren(const Layer* container,
+                                const Layer* old_container) {
+  std::shared_ptr<const PaintRegionMap> last_frame;
+  if (old_container) {
+    last_frame = GetOldLayerPaintRegion(old_container).children();
+  }
+  children_regions_stack_.push_back({
+      .container = container,
+      .this_frame = std::make_shared<PaintRegionMap>(),
+      .last_frame = std::move(last_frame),
+  });
+}
+
+void DiffContext::EndChildren() {
+  FML_DCHECK(!children_regions_stack_.empty());
+  finished_children_regions_ = std::move(children_regions_stack_.back());
+  children_regions_stack_.pop_back();
+}
+
 void DiffContext::SetLayerPaintRegion(const Layer* layer,
                                       const PaintRegion& region) {
-  this_frame_paint_region_map_[layer->unique_id()] = region;
+  PaintRegionMap& map = children_regions_stack_.empty()
+                            ? this_frame_paint_region_map_
+                            : *children_regions_stack_.back().this_frame;
+  PaintRegion& layer_region = map[layer->unique_id()];
+  layer_region = region;
+  if (finished_children_regions_.container == layer) {
+    layer_region.set_children(
+        std::move(finished_children_regions_.this_frame));
+    finished_children_regions_ = {};
+  }
 }
 
 PaintRegion DiffContext::GetOldLayerPaintRegion(const Layer* layer) const {
-  auto i = last_frame_paint_region_map_.find(layer->unique_id());
-  if (i != last_frame_paint_region_map_.end()) {
-    return i->second;
-  } else {
-    // This is valid when Layer::PreservePaintRegion is called for retained
-    // layer with zero sized parent clip (these layers are not diffed)
-    return PaintRegion();
+  const PaintRegionMap* map =
+      children_regions_stack_.empty()
+          ? &last_frame_paint_region_map_
+          : children_regions_stack_.back().last_frame.get();
+  if (map) {
+    auto i = map->find(layer->unique_id());
+    if (i != map->end()) {
+      return i->second;
+    }
   }
+  // This is valid when Layer::PreservePaintRegion is called for retained
+  // layer with zero sized parent clip (these layers are not diffed)
+  return PaintRegion();
+}
+
+bool DiffContext::IsTextureDirty(int64_t texture_id) const {
+  return !texture_registry_ || texture_registry_->IsTextureDirty(texture_id);
 }
 
 void DiffContext::Statistics::LogStatistics() {
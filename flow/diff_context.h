@@ -6,7 +6,7 @@
 #define FLUTTER_FLOW_DIFF_CONTEXT_H_
 
 #include <functional>
-#include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 #include "display_list/utils/dl_matrix_clip_tracker.h"
@@ -18,6 +18,7 @@
 namespace flutter {
 
 class Layer;
+class TextureRegistry;
 
 // Represents area that needs to be updated in front buffer (frame_damage) and
 // area that is going to be painted to in back buffer (buffer_damage).
@@ -36,9 +37,6 @@ struct Damage {
   SkIRect buffer_damage;
 };
 
-// Layer Unique Id to PaintRegion
-using PaintRegionMap = std::map<uint64_t, PaintRegion>;
-
 // Tracks state during tree diffing process and computes resulting damage
 class DiffContext {
  public:
@@ -69,6 +67,27 @@ class DiffContext {
     DiffContext* context_;
   };
 
+  // Records the paint regions of the children of the given container
+  // separately from those of its ancestors and siblings, and looks up the
+  // old paint regions of the children of the container it replaces, until
+  // the scope ends. The recorded regions are then kept with the paint region
+  // that is set next for the container, see PaintRegion::children.
+  class AutoChildrenRegions {
+    FML_DISALLOW_COPY_ASSIGN_AND_MOVE(AutoChildrenRegions);
+
+   public:
+    AutoChildrenRegions(DiffContext* context,
+                        const Layer* container,
+                        const Layer* old_container)
+        : context_(context) {
+      context->BeginChildren(container, old_container);
+    }
+    ~AutoChildrenRegions() { context_->EndChildren(); }
+
+   private:
+    DiffContext* context_;
+  };
+
   // Pushes additional transform for current subtree
   void PushTransform(const SkMatrix& transform);
 
@@ -124,6 +143,14 @@ class DiffContext {
   // Readback rect is in screen coordinates.
   void AddReadbackRegion(const SkIRect& rect);
 
+  // Returns whether the damage accumulated so far, which comes from the
+  // layers diffed before the current one, intersects the given rect.
+  //
+  // Rect is in screen coordinates.
+  bool IntersectsDamage(const SkRect& rect) const {
+    return damage_.intersects(rect);
+  }
+
   // Returns the paint region for current subtree; Each rect in paint region is
   // in screen coordinates; Once a layer accumulates the paint regions of its
   // children, this PaintRegion value can be associated with the current layer
@@ -148,6 +175,8 @@ class DiffContext {
   void AddDamage(const PaintRegion& damage);
 
   // Associates the paint region with specified layer and current layer tree.
+  // If the layer is a container whose children were just diffed, the paint
+  // regions of the children are kept with it.
   // The paint region can not be stored directly in layer itself, because same
   // retained layer instance can possibly paint in different locations depending
   // on ancestor layers.
@@ -162,6 +191,16 @@ class DiffContext {
   // cached.
   bool has_raster_cache() const { return has_raster_cache_; }
 
+  // Sets the registry that tells which textures may have new frames. If no
+  // registry is set, every texture is assumed to have a new frame.
+  void SetTextureRegistry(const TextureRegistry* texture_registry) {
+    texture_registry_ = texture_registry;
+  }
+
+  // Whether the texture may paint differently than it did in the previous
+  // frame.
+  bool IsTextureDirty(int64_t texture_id) const;
+
   class Statistics {
    public:
     // Picture replaced by different picture
@@ -230,6 +269,10 @@ class DiffContext {
 
   void MakeCurrentTransformIntegral();
 
+  void BeginChildren(const Layer* container, const Layer* old_container);
+
+  void EndChildren();
+
   DisplayListMatrixClipTracker clip_tracker_;
   std::shared_ptr<std::vector<SkRect>> rects_;
   State state_;
@@ -246,7 +289,28 @@ class DiffContext {
 
   PaintRegionMap& this_frame_paint_region_map_;
   const PaintRegionMap& last_frame_paint_region_map_;
+
+  struct ChildrenRegions {
+    const Layer* container;
+
+    // Paint regions of the children in this frame.
+    std::shared_ptr<PaintRegionMap> this_frame;
+
+    // Paint regions of the children of the replaced container in the last
+    // frame, if any.
+    std::shared_ptr<const PaintRegionMap> last_frame;
+  };
+
+  // Containers whose children are being diffed, innermost last. Paint
+  // regions of layers outside of any container are kept in the layer tree
+  // maps.
+  std::vector<ChildrenRegions> children_regions_stack_;
+
+  // The container whose children were diffed last, and their regions, until
+  // the paint region of the container is set.
+  ChildrenRegions finished_children_regions_ = {};
   bool has_raster_cache_;
+  const TextureRegistry* texture_registry_ = nullptr;
 
   void AddDamage(const SkRect& rect);
 
@@ -42,6 +42,10 @@ bool DisplayListEmbedderViewSlice::recording_ended() {
   return builder_ == nullptr;
 }
 
+sk_sp<DisplayList> DisplayListEmbedderViewSlice::display_list() const {
+  return display_list_;
+}
+
 void ExternalViewEmbedder::SubmitFrame(GrDirectContext* context,
                                        std::unique_ptr<SurfaceFrame> frame) {
   frame->Submit();
@@ -4,6 +4,8 @@
 
 #include "flutter/flow/frame_timings.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 
@@ -211,4 +213,133 @@ const char* FrameTimingsRecorder::GetFrameNumberTraceArg() const {
   return frame_number_trace_arg_val_.c_str();
 }
 
+FrameTimingHistograms::FrameTimingHistograms() = default;
+
+FrameTimingHistograms::~FrameTimingHistograms() = default;
+
+void FrameTimingHistograms::AddFrameTiming(const FrameTiming& timing) {
+  const auto micros = [&timing](FrameTiming::Phase start,
+                                FrameTiming::Phase end) {
+    return (timing.Get(end) - timing.Get(start)).ToMicroseconds();
+  };
+  std::scoped_lock lock(mutex_);
+  histograms_[static_cast<size_t>(Metric::kBuildTime)].Add(
+      micros(FrameTiming::kBuildStart, FrameTiming::kBuildFinish));
+  histograms_[static_cast<size_t>(Metric::kRasterTime)].Add(
+      micros(FrameTiming::kRasterStart, FrameTiming::kRasterFinish));
+  histograms_[static_cast<size_t>(Metric::kVsyncOverhead)].Add(
+      micros(FrameTiming::kVsyncStart, FrameTiming::kBuildStart));
+  histograms_[static_cast<size_t>(Metric::kLatency)].Add(
+      micros(FrameTiming::kVsyncStart, FrameTiming::kRasterFinish));
+}
+
+fml::TimeDelta FrameTimingHistograms::GetPercentile(Metric metric,
+                                                    double percentile) const {
+  FML_DCHECK(metric < Metric::kCount);
+  std::scoped_lock lock(mutex_);
+  return fml::TimeDelta::FromMicroseconds(
+      histograms_[static_cast<size_t>(metric)].GetValueAtPercentile(
+          percentile));
+}
+
+FrameTimingHistograms::Percentiles FrameTimingHistograms::GetPercentiles(
+    Metric metric) const {
+  FML_DCHECK(metric < Metric::kCount);
+  std::scoped_lock lock(mutex_);
+  const auto& histogram = histograms_[static_cast<size_t>(metric)];
+  return {
+      .frame_count = histogram.GetCount(),
+      .p50 = fml::TimeDelta::FromMicroseconds(
+          histogram.GetValueAtPercentile(50)),
+      .p90 = fml::TimeDelta::FromMicroseconds(
+          histogram.GetValueAtPercentile(90)),
+      .p99 = fml::TimeDelta::FromMicroseconds(
+          histogram.GetValueAtPercentile(99)),
+      .max = fml::TimeDelta::FromMicroseconds(histogram.GetMax()),
+  };
+}
+
+uint64_t FrameTimingHistograms::GetFrameCount() const {
+  std::scoped_lock lock(mutex_);
+  return histograms_[0].GetCount();
+}
+
+void FrameTimingHistograms::AddDroppedFrame() {
+  std::scoped_lock lock(mutex_);
+  dropped_frame_count_++;
+}
+
+uint64_t FrameTimingHistograms::GetDroppedFrameCount() const {
+  std::scoped_lock lock(mutex_);
+  return dropped_frame_count_;
+}
+
+void FrameTimingHistograms::Reset() {
+  std::scoped_lock lock(mutex_);
+  for (auto& histogram : histograms_) {
+    histogram.Reset();
+  }
+  dropped_frame_count_ = 0;
+}
+
+void FrameTimingHistograms::Histogram::Add(int64_t micros) {
+  const auto value =
+      std::clamp<int64_t>(micros, 0, (int64_t{1} << kMaxValueBits) - 1);
+  counts_[GetBucketIndex(value)]++;
+  count_++;
+  max_ = std::max(max_, value);
+}
+
+int64_t FrameTimingHistograms::Histogram::GetValueAtPercentile(
+    double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  const auto rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) /
+                                         100.0 * count_)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      return std::min(GetBucketUpperBound(i), max_);
+    }
+  }
+  return max_;
+}
+
+void FrameTimingHistograms::Histogram::Reset() {
+  counts_.fill(0);
+  count_ = 0;
+  max_ = 0;
+}
+
+// Values below twice the sub-bucket count each have their own bucket. Above
+// that, each power of two is split into as many buckets as there are
+// sub-buckets, so that the buckets grow with the values they hold.
+//
+// static
+size_t FrameTimingHistograms::Histogram::GetBucketIndex(int64_t value) {
+  if (value < 2 * kSubBucketCount) {
+    return static_cast<size_t>(value);
+  }
+  int shift = 0;
+  while ((value >> shift) >= 2 * kSubBucketCount) {
+    shift++;
+  }
+  return 2 * kSubBucketCount + (shift - 1) * kSubBucketCount +
+         static_cast<size_t>((value >> shift) - kSubBucketCount);
+}
+
+// static
+int64_t FrameTimingHistograms::Histogram::GetBucketUpperBound(size_t index) {
+  if (index < 2 * kSubBucketCount) {
+    return static_cast<int64_t>(index);
+  }
+  const auto shift = (index - 2 * kSubBucketCount) / kSubBucketCount + 1;
+  const auto sub_bucket =
+      (index - 2 * kSubBucketCount) % kSubBucketCount + kSubBucketCount;
+  return ((static_cast<int64_t>(sub_bucket) + 1) << shift) - 1;
+}
+
 }  // namespace flutter
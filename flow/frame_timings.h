@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_FRAME_TIMINGS_H_
 #define FLUTTER_FLOW_FRAME_TIMINGS_H_
 
+#include <array>
 #include <mutex>
 
 #include "flutter/common/settings.h"
@@ -141,6 +142,101 @@ class FrameTimingsRecorder {
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(FrameTimingsRecorder);
 };
 
+/// Aggregates the phase durations of rasterized frames into histograms, so
+/// that their percentiles can be read at any time without keeping the timings
+/// of every frame.
+///
+/// The buckets of the histograms grow wider with their values, which keeps
+/// the relative error of a percentile under about three percent for durations
+/// up to an hour. This class is thread safe and doesn't require additional
+/// synchronization.
+class FrameTimingHistograms {
+ public:
+  enum class Metric : uint32_t {
+    /// From the start to the end of the frame build.
+    kBuildTime,
+    /// From the start to the end of the frame rasterization.
+    kRasterTime,
+    /// From the vsync signal to the start of the frame build.
+    kVsyncOverhead,
+    /// From the vsync signal to the end of the frame rasterization.
+    kLatency,
+    kCount,
+  };
+
+  struct Percentiles {
+    uint64_t frame_count = 0;
+    fml::TimeDelta p50;
+    fml::TimeDelta p90;
+    fml::TimeDelta p99;
+    fml::TimeDelta max;
+  };
+
+  FrameTimingHistograms();
+
+  ~FrameTimingHistograms();
+
+  /// Adds the durations of the phases of a rasterized frame.
+  void AddFrameTiming(const FrameTiming& timing);
+
+  /// Returns the given percentile, between 0 and 100, of a metric over all
+  /// the frames added so far, or zero if none were.
+  fml::TimeDelta GetPercentile(Metric metric, double percentile) const;
+
+  /// Returns the usual percentiles of a metric over all the frames added so
+  /// far.
+  Percentiles GetPercentiles(Metric metric) const;
+
+  /// Returns the number of frames added so far.
+  uint64_t GetFrameCount() const;
+
+  /// Counts a frame that was built but dropped without being rasterized,
+  /// because a newer frame was waiting to be rasterized.
+  void AddDroppedFrame();
+
+  /// Returns the number of frames dropped so far.
+  uint64_t GetDroppedFrameCount() const;
+
+  /// Forgets all the frames added so far.
+  void Reset();
+
+ private:
+  class Histogram {
+   public:
+    void Add(int64_t micros);
+
+    int64_t GetValueAtPercentile(double percentile) const;
+
+    int64_t GetMax() const { return max_; }
+
+    uint64_t GetCount() const { return count_; }
+
+    void Reset();
+
+   private:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr int kSubBucketCount = 1 << kSubBucketBits;
+    static constexpr int kMaxValueBits = 32;
+    static constexpr size_t kBucketCount =
+        2 * kSubBucketCount +
+        (kMaxValueBits - kSubBucketBits - 1) * kSubBucketCount;
+
+    std::array<uint64_t, kBucketCount> counts_ = {};
+    uint64_t count_ = 0;
+    int64_t max_ = 0;
+
+    static size_t GetBucketIndex(int64_t value);
+
+    static int64_t GetBucketUpperBound(size_t index);
+  };
+
+  mutable std::mutex mutex_;
+  std::array<Histogram, static_cast<size_t>(Metric::kCount)> histograms_;
+  uint64_t dropped_frame_count_ = 0;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(FrameTimingHistograms);
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_FLOW_FRAME_TIMINGS_H_
@@ -297,5 +297,89 @@ TEST(FrameTimingsRecorderTest, FrameNumberTraceArgIsValid) {
   ASSERT_EQ(actual_arg, expected_arg);
 }
 
+TEST(FrameTimingHistogramsTest, PercentilesOfPhaseDurations) {
+  FrameTimingHistograms histograms;
+  ASSERT_EQ(histograms.GetFrameCount(), 0u);
+  ASSERT_EQ(histograms.GetPercentile(
+                FrameTimingHistograms::Metric::kBuildTime, 50),
+            fml::TimeDelta::Zero());
+
+  const auto vsync = fml::TimePoint::Now();
+  for (int i = 1; i <= 100; i++) {
+    FrameTiming timing;
+    timing.Set(FrameTiming::kVsyncStart, vsync);
+    timing.Set(FrameTiming::kBuildStart,
+               vsync + fml::TimeDelta::FromMicroseconds(10));
+    timing.Set(FrameTiming::kBuildFinish,
+               vsync + fml::TimeDelta::FromMicroseconds(10 + i * 100));
+    timing.Set(FrameTiming::kRasterStart,
+               vsync + fml::TimeDelta::FromMicroseconds(20000));
+    timing.Set(FrameTiming::kRasterFinish,
+               vsync + fml::TimeDelta::FromMicroseconds(25000));
+    histograms.AddFrameTiming(timing);
+  }
+  ASSERT_EQ(histograms.GetFrameCount(), 100u);
+
+  const auto build = histograms.GetPercentiles(
+      FrameTimingHistograms::Metric::kBuildTime);
+  EXPECT_EQ(build.frame_count, 100u);
+  EXPECT_NEAR(build.p50.ToMicroseconds(), 5000, 5000 * 0.04);
+  EXPECT_NEAR(build.p90.ToMicroseconds(), 9000, 9000 * 0.04);
+  EXPECT_NEAR(build.p99.ToMicroseconds(), 9900, 9900 * 0.04);
+  EXPECT_EQ(build.max.ToMicroseconds(), 10000);
+
+  const auto vsync_overhead = histograms.GetPercentiles(
+      FrameTimingHistograms::Metric::kVsyncOverhead);
+  EXPECT_EQ(vsync_overhead.p50.ToMicroseconds(), 10);
+  EXPECT_EQ(vsync_overhead.max.ToMicroseconds(), 10);
+
+  const auto raster = histograms.GetPercentiles(
+      FrameTimingHistograms::Metric::kRasterTime);
+  EXPECT_NEAR(raster.p99.ToMicroseconds(), 5000, 5000 * 0.04);
+
+  const auto latency =
+      histograms.GetPercentiles(FrameTimingHistograms::Metric::kLatency);
+  EXPECT_EQ(latency.max.ToMicroseconds(), 25000);
+
+  histograms.Reset();
+  ASSERT_EQ(histograms.GetFrameCount(), 0u);
+}
+
+TEST(FrameTimingHistogramsTest, CountsDroppedFrames) {
+  FrameTimingHistograms histograms;
+  histograms.AddDroppedFrame();
+  histograms.AddDroppedFrame();
+  // Dropped frames have no durations.
+  EXPECT_EQ(histograms.GetFrameCount(), 0u);
+  EXPECT_EQ(histograms.GetDroppedFrameCount(), 2u);
+
+  histograms.Reset();
+  EXPECT_EQ(histograms.GetDroppedFrameCount(), 0u);
+}
+
+TEST(FrameTimingHistogramsTest, ClampsOutOfRangeDurations) {
+  FrameTimingHistograms histograms;
+  const auto vsync = fml::TimePoint::Now();
+  FrameTiming timing;
+  timing.Set(FrameTiming::kVsyncStart, vsync);
+  // Out of order phases make for negative durations.
+  timing.Set(FrameTiming::kBuildStart, vsync);
+  timing.Set(FrameTiming::kBuildFinish,
+             vsync - fml::TimeDelta::FromMilliseconds(1));
+  timing.Set(FrameTiming::kRasterStart, vsync);
+  timing.Set(FrameTiming::kRasterFinish,
+             vsync + fml::TimeDelta::FromSeconds(24 * 60 * 60));
+  histograms.AddFrameTiming(timing);
+
+  EXPECT_EQ(histograms.GetPercentile(
+                FrameTimingHistograms::Metric::kBuildTime, 99),
+            fml::TimeDelta::Zero());
+  EXPECT_EQ(
+      histograms
+          .GetPercentiles(FrameTimingHistograms::Metric::kRasterTime)
+          .max,
+      fml::TimeDelta::FromMicroseconds((int64_t{1} << 32) - 1));
+}
+
 }  // namespace testing
 }  // namespace flutter
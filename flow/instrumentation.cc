@@ -9,6 +9,7 @@
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "third_party/skia/include/core/SkPath.h"
 #include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
 
@@ -22,6 +23,7 @@ Stopwatch::Stopwatch(const RefreshRateUpdater& updater)
   const fml::TimeDelta delta = fml::TimeDelta::Zero();
   laps_.resize(kMaxSamples, delta);
   cache_dirty_ = true;
+  visualize_cache_context_ = nullptr;
   prev_drawn_sample_index_ = 0;
 }
 
@@ -86,11 +88,13 @@ fml::TimeDelta Stopwatch::AverageDelta() const {
 
 // Initialize the SkSurface for drawing into. Draws the base background and any
 // timing data from before the initial Visualize() call.
-void Stopwatch::InitVisualizeSurface(SkISize size) const {
-  // Mark as dirty if the size has changed.
+void Stopwatch::InitVisualizeSurface(SkISize size,
+                                     GrDirectContext* gr_context) const {
+  // Mark as dirty if the size or the context has changed.
   if (visualize_cache_surface_) {
     if (size.width() != visualize_cache_surface_->width() ||
-        size.height() != visualize_cache_surface_->height()) {
+        size.height() != visualize_cache_surface_->height() ||
+        gr_context != visualize_cache_context_) {
       cache_dirty_ = true;
     };
   }
@@ -100,9 +104,18 @@ void Stopwatch::InitVisualizeSurface(SkISize size) const {
   }
   cache_dirty_ = false;
 
-  // TODO(garyq): Use a GPU surface instead of a CPU surface.
+  // A GPU surface only has the newest sample rendered into it each frame,
+  // where the snapshot of a CPU surface has to be uploaded again.
+  const SkImageInfo image_info =
+      SkImageInfo::MakeN32Premul(size.width(), size.height());
   visualize_cache_surface_ =
-      SkSurface::MakeRasterN32Premul(size.width(), size.height());
+      gr_context ? SkSurface::MakeRenderTarget(
+                       gr_context, skgpu::Budgeted::kYes, image_info)
+                 : nullptr;
+  if (!visualize_cache_surface_) {
+    visualize_cache_surface_ = SkSurface::MakeRaster(image_info);
+  }
+  visualize_cache_context_ = gr_context;
 
   SkCanvas* cache_canvas = visualize_cache_surface_->getCanvas();
 
@@ -153,9 +166,11 @@ void Stopwatch::InitVisualizeSurface(SkISize size) const {
   cache_canvas->drawPath(path, paint);
 }
 
-void Stopwatch::Visualize(DlCanvas* canvas, const SkRect& rect) const {
+void Stopwatch::Visualize(DlCanvas* canvas,
+                          const SkRect& rect,
+                          GrDirectContext* gr_context) const {
   // Initialize visualize cache if it has not yet been initialized.
-  InitVisualizeSurface(SkISize::Make(rect.width(), rect.height()));
+  InitVisualizeSurface(SkISize::Make(rect.width(), rect.height()), gr_context);
 
   SkCanvas* cache_canvas = visualize_cache_surface_->getCanvas();
   SkPaint paint;
@@ -247,6 +262,12 @@ void Stopwatch::Visualize(DlCanvas* canvas, const SkRect& rect) const {
                     DlImageSampling::kNearestNeighbor);
 }
 
+void Stopwatch::ClearVisualizeCache() {
+  visualize_cache_surface_ = nullptr;
+  visualize_cache_context_ = nullptr;
+  cache_dirty_ = true;
+}
+
 fml::Milliseconds Stopwatch::GetFrameBudget() const {
   return refresh_rate_updater_.GetFrameBudget();
 }
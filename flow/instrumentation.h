@@ -14,6 +14,8 @@
 
 #include "third_party/skia/include/core/SkSurface.h"
 
+class GrDirectContext;
+
 namespace flutter {
 
 class Stopwatch {
@@ -38,9 +40,19 @@ class Stopwatch {
 
   fml::TimeDelta AverageDelta() const;
 
-  void InitVisualizeSurface(SkISize size) const;
+  /// Prepares the cache of the graph for the given size. The cache is a
+  /// surface of |gr_context| if there is one, so that drawing the graph
+  /// only renders the newest sample and doesn't upload it every frame.
+  void InitVisualizeSurface(SkISize size,
+                            GrDirectContext* gr_context = nullptr) const;
+
+  void Visualize(DlCanvas* canvas,
+                 const SkRect& rect,
+                 GrDirectContext* gr_context = nullptr) const;
 
-  void Visualize(DlCanvas* canvas, const SkRect& rect) const;
+  /// Drops the cache of the graph, which must be done before the context it
+  /// was created with is destroyed.
+  void ClearVisualizeCache();
 
   void Start();
 
@@ -64,6 +76,7 @@ class Stopwatch {
   // expensive redrawing of old data.
   mutable bool cache_dirty_;
   mutable sk_sp<SkSurface> visualize_cache_surface_;
+  mutable GrDirectContext* visualize_cache_context_;
   mutable size_t prev_drawn_sample_index_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Stopwatch);
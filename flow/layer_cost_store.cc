@@ -0,0 +1,137 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layer_cost_store.h"
+
+#include <algorithm>
+
+#include "flutter/display_list/dl_paint.h"
+#include "flutter/flow/layers/layer.h"
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+LayerCostStore::LayerCostStore() = default;
+
+LayerCostStore::~LayerCostStore() = default;
+
+void LayerCostStore::SetSampleInterval(size_t frame_interval) {
+  sample_interval_ = frame_interval;
+  frame_count_ = 0;
+}
+
+bool LayerCostStore::BeginFrame() {
+  FML_DCHECK(!sampling_);
+  sampling_ = sample_interval_ > 0 && (frame_count_++ % sample_interval_) == 0;
+  return sampling_;
+}
+
+void LayerCostStore::EndFrame() {
+  if (!sampling_) {
+    return;
+  }
+  sampling_ = false;
+  FML_DCHECK(child_time_stack_.empty());
+  child_time_stack_.clear();
+  sampled_frame_count_++;
+  for (const auto& record : frame_records_) {
+    auto& cost = costs_[record.original_layer_id];
+    cost.original_layer_id = record.original_layer_id;
+    cost.layer_unique_id = record.layer_unique_id;
+    cost.sample_count++;
+    cost.total_self_time = cost.total_self_time + record.self_time;
+    cost.max_self_time = std::max(cost.max_self_time, record.self_time);
+    cost.total_time = cost.total_time + record.total_time;
+    cost.device_bounds = record.device_bounds;
+  }
+  last_frame_records_ = std::move(frame_records_);
+  frame_records_.clear();
+}
+
+std::vector<LayerCost> LayerCostStore::GetCosts() const {
+  std::vector<LayerCost> costs;
+  costs.reserve(costs_.size());
+  for (const auto& [id, cost] : costs_) {
+    costs.push_back(cost);
+  }
+  std::sort(costs.begin(), costs.end(),
+            [](const LayerCost& a, const LayerCost& b) {
+              return a.total_self_time > b.total_self_time;
+            });
+  return costs;
+}
+
+void LayerCostStore::Reset() {
+  costs_.clear();
+  last_frame_records_.clear();
+  sampled_frame_count_ = 0;
+}
+
+void LayerCostStore::DrawHeatmap(DlCanvas* canvas) const {
+  if (!canvas || last_frame_records_.empty()) {
+    return;
+  }
+  fml::TimeDelta max_self_time;
+  for (const auto& record : last_frame_records_) {
+    max_self_time = std::max(max_self_time, record.self_time);
+  }
+  if (max_self_time <= fml::TimeDelta::Zero()) {
+    return;
+  }
+
+  DlAutoCanvasRestore restore(canvas, true);
+  canvas->SetTransform(SkMatrix::I());
+  DlPaint paint;
+  for (const auto& record : last_frame_records_) {
+    auto heat = static_cast<float>(record.self_time.ToSecondsF() /
+                                   max_self_time.ToSecondsF());
+    paint.setColor(DlColor::kBlack()
+                       .withRed(static_cast<uint8_t>(255 * heat))
+                       .withBlue(static_cast<uint8_t>(255 * (1 - heat)))
+                       .withAlpha(static_cast<uint8_t>(32 + 96 * heat)));
+    canvas->DrawRect(record.device_bounds, paint);
+  }
+}
+
+void LayerCostStore::PushLayer() {
+  child_time_stack_.push_back(fml::TimeDelta::Zero());
+}
+
+void LayerCostStore::PopLayer(const Layer& layer,
+                              const SkRect& device_bounds,
+                              fml::TimeDelta total_time) {
+  FML_DCHECK(!child_time_stack_.empty());
+  auto child_time = child_time_stack_.back();
+  child_time_stack_.pop_back();
+  if (!child_time_stack_.empty()) {
+    child_time_stack_.back() = child_time_stack_.back() + total_time;
+  }
+  frame_records_.push_back({
+      .original_layer_id = layer.original_layer_id(),
+      .layer_unique_id = layer.unique_id(),
+      .self_time = std::max(total_time - child_time, fml::TimeDelta::Zero()),
+      .total_time = total_time,
+      .device_bounds = device_bounds,
+  });
+}
+
+LayerCostStore::ScopedLayerTimer::ScopedLayerTimer(
+    LayerCostStore* store,
+    const Layer& layer,
+    const LayerStateStack& state_stack)
+    : store_(store), layer_(layer) {
+  if (store_) {
+    device_bounds_ = state_stack.transform_3x3().mapRect(layer.paint_bounds());
+    store_->PushLayer();
+    start_ = fml::TimePoint::Now();
+  }
+}
+
+LayerCostStore::ScopedLayerTimer::~ScopedLayerTimer() {
+  if (store_) {
+    store_->PopLayer(layer_, device_bounds_, fml::TimePoint::Now() - start_);
+  }
+}
+
+}  // namespace flutter
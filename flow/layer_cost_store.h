@@ -0,0 +1,138 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYER_COST_STORE_H_
+#define FLUTTER_FLOW_LAYER_COST_STORE_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/display_list/dl_canvas.h"
+#include "flutter/flow/layers/layer_state_stack.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace flutter {
+
+class Layer;
+
+/// The cost of painting a layer, aggregated over the sampled frames that
+/// painted it. A layer is identified by its original layer id, which a layer
+/// that replaces it in a later frame, like the one an `EngineLayer` is
+/// updated with, keeps.
+struct LayerCost {
+  uint64_t original_layer_id = 0;
+  /// The unique id of the layer in the last sampled frame that painted it.
+  uint64_t layer_unique_id = 0;
+  size_t sample_count = 0;
+  /// The time spent painting the layer itself, not its children.
+  fml::TimeDelta total_self_time;
+  fml::TimeDelta max_self_time;
+  /// The time spent painting the layer and its children.
+  fml::TimeDelta total_time;
+  /// The device bounds of the layer in the last sampled frame that painted
+  /// it.
+  SkRect device_bounds = SkRect::MakeEmpty();
+};
+
+/// Times how long each layer takes to paint, every few frames, to find the
+/// layers that are expensive to raster without snapshotting each of them like
+/// the |LayerSnapshotStore| does. Only CPU time is measured, since layers
+/// record into the canvas of the frame and are rendered together.
+///
+/// Used on the raster thread.
+class LayerCostStore {
+ public:
+  LayerCostStore();
+
+  ~LayerCostStore();
+
+  /// Samples one frame every `frame_interval` frames, or none if 0.
+  void SetSampleInterval(size_t frame_interval);
+
+  size_t GetSampleInterval() const { return sample_interval_; }
+
+  /// Whether the last sampled frame is drawn over each frame as a heatmap of
+  /// the self time of its layers.
+  void SetHeatmapEnabled(bool enabled) { heatmap_enabled_ = enabled; }
+
+  bool IsHeatmapEnabled() const { return heatmap_enabled_; }
+
+  /// Starts a frame, and returns whether the layers it paints should be
+  /// timed.
+  bool BeginFrame();
+
+  /// Ends a frame started by |BeginFrame|.
+  void EndFrame();
+
+  size_t GetSampledFrameCount() const { return sampled_frame_count_; }
+
+  /// Returns the cost of every layer painted in a sampled frame, most
+  /// expensive first.
+  std::vector<LayerCost> GetCosts() const;
+
+  /// Forgets the costs of all layers.
+  void Reset();
+
+  /// Draws the layers of the last sampled frame, in device space, tinted
+  /// from blue to red by their share of the most expensive layer's self
+  /// time.
+  void DrawHeatmap(DlCanvas* canvas) const;
+
+  /// Times the painting of a layer for as long as it is in scope, if the
+  /// store is non-null. Timers nest, so that the time spent in the timers of
+  /// children is only counted as self time of the children.
+  class ScopedLayerTimer {
+   public:
+    /// The `state_stack` holds the transform that the layer is painted with.
+    ScopedLayerTimer(LayerCostStore* store,
+                     const Layer& layer,
+                     const LayerStateStack& state_stack);
+
+    ~ScopedLayerTimer();
+
+   private:
+    LayerCostStore* store_;
+    const Layer& layer_;
+    SkRect device_bounds_;
+    fml::TimePoint start_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedLayerTimer);
+  };
+
+ private:
+  struct FrameRecord {
+    uint64_t original_layer_id;
+    uint64_t layer_unique_id;
+    fml::TimeDelta self_time;
+    fml::TimeDelta total_time;
+    SkRect device_bounds;
+  };
+
+  size_t sample_interval_ = 0;
+  bool heatmap_enabled_ = false;
+  size_t frame_count_ = 0;
+  size_t sampled_frame_count_ = 0;
+  bool sampling_ = false;
+  // The time spent in the children of each layer that is being timed.
+  std::vector<fml::TimeDelta> child_time_stack_;
+  std::vector<FrameRecord> frame_records_;
+  std::vector<FrameRecord> last_frame_records_;
+  std::unordered_map<uint64_t, LayerCost> costs_;
+
+  void PushLayer();
+
+  void PopLayer(const Layer& layer,
+                const SkRect& device_bounds,
+                fml::TimeDelta total_time);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerCostStore);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYER_COST_STORE_H_
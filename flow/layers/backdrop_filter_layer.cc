@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include "third_party/skia/include/core/SkSurface.h"
+
 namespace flutter {
 
 BackdropFilterLayer::BackdropFilterLayer(
@@ -20,6 +22,10 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
       context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(old_layer));
     }
   }
+  bool layer_unchanged =
+      !context->IsSubtreeDirty() && blend_mode_ == prev->blend_mode_;
+  backdrop_snapshot_ = nullptr;
+  diffed_ = true;
 
   // Backdrop filter paints everywhere in cull rect
   auto paint_bounds = context->GetCullRect();
@@ -32,6 +38,16 @@ void BackdropFilterLayer::Diff(DiffContext* context, const Layer* old_layer) {
     filter_->get_input_device_bounds(
         filter_target_bounds, context->GetTransform3x3(), filter_input_bounds);
     context->AddReadbackRegion(filter_input_bounds);
+
+    // The filtered backdrop of the old layer is still valid if nothing
+    // painted so far, below this layer, changed within the filter input or
+    // under the layer itself.
+    auto backdrop_bounds = SkRect::Make(filter_input_bounds);
+    backdrop_bounds.join(paint_bounds);
+    if (layer_unchanged && !context->IntersectsDamage(backdrop_bounds)) {
+      backdrop_snapshot_ = prev->backdrop_snapshot_;
+      backdrop_snapshot_bounds_ = prev->backdrop_snapshot_bounds_;
+    }
   }
 
   DiffChildren(context, prev);
@@ -56,10 +72,57 @@ void BackdropFilterLayer::Preroll(PrerollContext* context) {
 void BackdropFilterLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
+  bool diffed = diffed_;
+  diffed_ = false;
+  if (diffed && CanSnapshotBackdrop(context)) {
+    SkIRect device_bounds =
+        context.canvas->GetTransform().mapRect(paint_bounds()).roundOut();
+    if (device_bounds.intersect(
+            context.canvas->GetDestinationClipBounds().roundOut())) {
+      if (backdrop_snapshot_ &&
+          backdrop_snapshot_bounds_.contains(device_bounds)) {
+        DlAutoCanvasRestore restore(context.canvas, true);
+        context.canvas->TransformReset();
+        context.canvas->ClipRect(SkRect::Make(device_bounds));
+        DlPaint paint;
+        paint.setBlendMode(DlBlendMode::kSrc);
+        context.canvas->DrawImage(
+            backdrop_snapshot_,
+            SkPoint::Make(backdrop_snapshot_bounds_.fLeft,
+                          backdrop_snapshot_bounds_.fTop),
+            DlImageSampling::kNearestNeighbor, &paint);
+      } else {
+        {
+          auto mutator = context.state_stack.save();
+          mutator.applyBackdropFilter(paint_bounds(), filter_, blend_mode_);
+        }
+        backdrop_snapshot_ = DlImage::Make(
+            context.readback_surface->makeImageSnapshot(device_bounds));
+        backdrop_snapshot_bounds_ = device_bounds;
+      }
+      // Painting the children over the composited backdrop instead of into
+      // the backdrop layer is equivalent because SrcOver is associative.
+      PaintChildren(context);
+      return;
+    }
+  }
+  backdrop_snapshot_ = nullptr;
+
   auto mutator = context.state_stack.save();
   mutator.applyBackdropFilter(paint_bounds(), filter_, blend_mode_);
 
   PaintChildren(context);
 }
 
+bool BackdropFilterLayer::CanSnapshotBackdrop(
+    const PaintContext& context) const {
+  const auto& state_stack = context.state_stack;
+  return filter_ && blend_mode_ == DlBlendMode::kSrcOver &&
+         context.readback_surface != nullptr &&
+         !state_stack.has_save_layer() &&
+         state_stack.outstanding_opacity() == SK_Scalar1 &&
+         !state_stack.outstanding_color_filter() &&
+         !state_stack.outstanding_image_filter();
+}
+
 }  // namespace flutter
@@ -22,9 +22,24 @@ class BackdropFilterLayer : public ContainerLayer {
   void Paint(PaintContext& context) const override;
 
  private:
+  // Whether the filtered backdrop can be composited directly into the
+  // readback surface of the frame and read back from it, which only gives
+  // the same result as compositing it together with the children if this
+  // layer is drawn with SrcOver and is not nested in another saveLayer.
+  bool CanSnapshotBackdrop(const PaintContext& context) const;
+
   std::shared_ptr<const DlImageFilter> filter_;
   DlBlendMode blend_mode_;
 
+  // The pixels of the filtered backdrop composited into the readback surface
+  // in a previous frame, and the device bounds they were read back from.
+  // |Diff| carries them over from the old layer if nothing under the filter
+  // changed since, and |Paint| draws them instead of filtering again.
+  mutable sk_sp<DlImage> backdrop_snapshot_;
+  mutable SkIRect backdrop_snapshot_bounds_ = SkIRect::MakeEmpty();
+  // Set by |Diff| for the frame it diffs, and reset by the following |Paint|.
+  mutable bool diffed_ = false;
+
   FML_DISALLOW_COPY_AND_ASSIGN(BackdropFilterLayer);
 };
 
@@ -2,6 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <tuple>
+#include <variant>
+
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 #include "flutter/flow/layers/clip_rect_layer.h"
 
@@ -13,6 +17,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
 #include "third_party/skia/include/core/SkImageFilter.h"
+#include "third_party/skia/include/core/SkSurface.h"
 #include "third_party/skia/include/effects/SkImageFilters.h"
 
 namespace flutter {
@@ -335,6 +340,87 @@ TEST_F(BackdropFilterLayerTest, OpacityInheritance) {
   EXPECT_TRUE(DisplayListsEQ_Verbose(display_list(), expected_builder.Build()));
 }
 
+TEST_F(BackdropFilterLayerTest, ReusesFilteredBackdropWhenUnchanged) {
+  const SkRect clip_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.0f, 21.0f);
+  const SkPath child_path = SkPath().addRect(clip_bounds);
+  const DlPaint child_paint = DlPaint(DlColor::kYellow());
+  auto layer_filter =
+      std::make_shared<DlBlurImageFilter>(2.5, 3.2, DlTileMode::kClamp);
+  auto mock_layer = std::make_shared<MockLayer>(child_path, child_paint);
+  auto surface = SkSurface::MakeRasterN32Premul(100, 100);
+  paint_context().readback_surface = surface.get();
+
+  auto make_tree = [&](const std::shared_ptr<Layer>& below) {
+    auto layer = std::make_shared<BackdropFilterLayer>(layer_filter,
+                                                       DlBlendMode::kSrcOver);
+    layer->Add(mock_layer);
+    auto clip = std::make_shared<ClipRectLayer>(clip_bounds, Clip::hardEdge);
+    if (below) {
+      clip->Add(below);
+    }
+    clip->Add(layer);
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(clip);
+    return std::make_tuple(root, clip, layer);
+  };
+  auto diff = [](ContainerLayer* root, const ContainerLayer* old_root,
+                 PaintRegionMap& region_map,
+                 const PaintRegionMap& old_region_map) {
+    DiffContext context(SkISize::Make(100, 100), 1, region_map,
+                        old_region_map, false);
+    context.PushCullRect(SkRect::MakeWH(100, 100));
+    root->Diff(&context, old_root);
+  };
+  auto paint = [&](ClipRectLayer* clip, BackdropFilterLayer* layer) {
+    preroll_context()->state_stack.set_preroll_delegate(SkMatrix());
+    clip->Preroll(preroll_context());
+    mock_canvas().reset_draw_calls();
+    layer->Paint(paint_context());
+    return mock_canvas().draw_calls();
+  };
+  auto filters_backdrop = [](const std::vector<MockCanvas::DrawCall>& calls) {
+    return std::any_of(calls.begin(), calls.end(), [](const auto& call) {
+      return std::holds_alternative<MockCanvas::SaveLayerData>(call.data);
+    });
+  };
+  auto draws_image = [](const std::vector<MockCanvas::DrawCall>& calls) {
+    return std::any_of(calls.begin(), calls.end(), [](const auto& call) {
+      return std::holds_alternative<MockCanvas::DrawImageData>(call.data);
+    });
+  };
+
+  // The first frame filters the backdrop and reads the result back.
+  PaintRegionMap region_map_0, region_map_1, region_map_2, region_map_3;
+  auto root_0 = std::make_shared<ContainerLayer>();
+  auto [root_1, clip_1, layer_1] = make_tree(nullptr);
+  diff(root_1.get(), root_0.get(), region_map_1, region_map_0);
+  auto calls = paint(clip_1.get(), layer_1.get());
+  EXPECT_TRUE(filters_backdrop(calls));
+  EXPECT_FALSE(draws_image(calls));
+
+  // Nothing changed below the layer, so the backdrop is reused.
+  auto [root_2, clip_2, layer_2] = make_tree(nullptr);
+  clip_2->AssignOldLayer(clip_1.get());
+  layer_2->AssignOldLayer(layer_1.get());
+  diff(root_2.get(), root_1.get(), region_map_2, region_map_1);
+  calls = paint(clip_2.get(), layer_2.get());
+  EXPECT_FALSE(filters_backdrop(calls));
+  EXPECT_TRUE(draws_image(calls));
+  EXPECT_EQ(calls.back(),
+            (MockCanvas::DrawCall{
+                0, MockCanvas::DrawPathData{child_path, child_paint}}));
+
+  // Content added below the layer invalidates the backdrop.
+  auto below = std::make_shared<MockLayer>(child_path, DlPaint());
+  auto [root_3, clip_3, layer_3] = make_tree(below);
+  clip_3->AssignOldLayer(clip_2.get());
+  layer_3->AssignOldLayer(layer_2.get());
+  diff(root_3.get(), root_2.get(), region_map_3, region_map_2);
+  calls = paint(clip_3.get(), layer_3.get());
+  EXPECT_TRUE(filters_backdrop(calls));
+  EXPECT_FALSE(draws_image(calls));
+}
+
 using BackdropLayerDiffTest = DiffContextTest;
 
 TEST_F(BackdropLayerDiffTest, BackdropLayer) {
@@ -51,12 +51,19 @@ void ColorFilterLayer::Preroll(PrerollContext* context) {
   // those attributes with our saveLayer normally.
   // However, some color filters can commute themselves with an opacity
   // modulation so in that case we can apply the opacity on behalf of our
-  // ancestors - otherwise we can apply no attributes.
+  // ancestors. Filters that leave transparent black alone can also be
+  // applied by the LayerStateStack as the image filter of that saveLayer,
+  // which comes before all of the other attributes, so we can then apply
+  // all of them - otherwise we can apply no attributes.
   if (filter_) {
-    context->renderable_state_flags =
-        filter_->can_commute_with_opacity()
-            ? LayerStateStack::kCallerCanApplyOpacity
-            : 0;
+    if (!filter_->modifies_transparent_black()) {
+      context->renderable_state_flags = kSaveLayerRenderFlags;
+    } else {
+      context->renderable_state_flags =
+          filter_->can_commute_with_opacity()
+              ? LayerStateStack::kCallerCanApplyOpacity
+              : 0;
+    }
   }
   // else - we can apply whatever our children can apply.
 }
@@ -412,9 +412,9 @@ TEST_F(ColorFilterLayerTest, OpacityInheritance) {
   context->state_stack.set_preroll_delegate(initial_transform);
   color_filter_layer->Preroll(preroll_context());
   // ColorFilterLayer can always inherit opacity whether or not their
-  // children are compatible.
-  EXPECT_EQ(context->renderable_state_flags,
-            LayerStateStack::kCallerCanApplyOpacity);
+  // children are compatible, and filters that leave transparent black
+  // alone can inherit the other attributes as well.
+  EXPECT_EQ(context->renderable_state_flags, Layer::kSaveLayerRenderFlags);
 
   int opacity_alpha = 0x7F;
   SkPoint offset = SkPoint::Make(10, 10);
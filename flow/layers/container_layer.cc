@@ -17,15 +17,9 @@ void ContainerLayer::Diff(DiffContext* context, const Layer* old_layer) {
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
-void ContainerLayer::PreservePaintRegion(DiffContext* context) {
-  Layer::PreservePaintRegion(context);
-  for (auto& layer : layers_) {
-    layer->PreservePaintRegion(context);
-  }
-}
-
 void ContainerLayer::DiffChildren(DiffContext* context,
                                   const ContainerLayer* old_layer) {
+  DiffContext::AutoChildrenRegions children_regions(context, this, old_layer);
   if (context->IsSubtreeDirty()) {
     for (auto& layer : layers_) {
       layer->Diff(context, nullptr);
@@ -89,7 +83,8 @@ void ContainerLayer::DiffChildren(DiffContext* context,
 
         // While we don't need to diff retained layers, we still need to
         // associate their paint region with current layer tree so that we can
-        // retrieve it in next frame diff
+        // retrieve it in next frame diff. The paint regions of the rest of
+        // the subtree are kept with it, so this doesn't visit the subtree.
         layer->PreservePaintRegion(context);
       } else {
         layer->Diff(context, prev_layer.get());
@@ -189,6 +184,8 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
   // and the trace event on this common function has a small overhead.
   for (auto& layer : layers_) {
     if (layer->needs_painting(context)) {
+      LayerCostStore::ScopedLayerTimer timer(context.layer_cost_store, *layer,
+                                             context.state_stack);
       layer->Paint(context);
     }
   }
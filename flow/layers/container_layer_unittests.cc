@@ -160,6 +160,47 @@ TEST_F(ContainerLayerTest, Multiple) {
                                                child_path2, child_paint2}}}));
 }
 
+TEST_F(ContainerLayerTest, PaintChildrenTimesLayersOfSampledFrames) {
+  SkPath child_path1;
+  child_path1.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  SkPath child_path2;
+  child_path2.addRect(8.0f, 2.0f, 16.5f, 14.5f);
+  auto mock_layer1 = std::make_shared<MockLayer>(child_path1);
+  auto mock_layer2 = std::make_shared<MockLayer>(child_path2);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(mock_layer1);
+  layer->Add(mock_layer2);
+  layer->Preroll(preroll_context());
+
+  LayerCostStore store;
+  store.SetSampleInterval(2);
+  for (int frame = 0; frame < 3; frame++) {
+    paint_context().layer_cost_store = store.BeginFrame() ? &store : nullptr;
+    layer->Paint(paint_context());
+    store.EndFrame();
+  }
+  paint_context().layer_cost_store = nullptr;
+
+  // The first and third frames are sampled.
+  EXPECT_EQ(store.GetSampledFrameCount(), 2u);
+  auto costs = store.GetCosts();
+  ASSERT_EQ(costs.size(), 2u);
+  for (const auto& cost : costs) {
+    EXPECT_EQ(cost.sample_count, 2u);
+    EXPECT_GE(cost.total_time, cost.total_self_time);
+    EXPECT_GE(cost.total_self_time, cost.max_self_time);
+    if (cost.original_layer_id == mock_layer1->original_layer_id()) {
+      EXPECT_EQ(cost.device_bounds, child_path1.getBounds());
+    } else {
+      EXPECT_EQ(cost.original_layer_id, mock_layer2->original_layer_id());
+      EXPECT_EQ(cost.device_bounds, child_path2.getBounds());
+    }
+  }
+
+  store.Reset();
+  EXPECT_TRUE(store.GetCosts().empty());
+}
+
 TEST_F(ContainerLayerTest, MultipleWithEmpty) {
   SkPath child_path1;
   child_path1.addRect(5.0f, 6.0f, 20.5f, 21.5f);
@@ -745,5 +786,50 @@ TEST_F(ContainerLayerDiffTest, ReplaceLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 250, 150));
 }
 
+// Retained subtrees carry over the paint regions of all of their layers, so
+// they can still be diffed once they are replaced in a later frame.
+TEST_F(ContainerLayerDiffTest, ReplaceRetainedLayerChildren) {
+  auto path1 = SkPath().addRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  auto path2 = SkPath().addRect(SkRect::MakeLTRB(100, 0, 150, 50));
+
+  auto inner = CreateContainerLayer(std::make_shared<MockLayer>(path1));
+  auto c1 = CreateContainerLayer({inner, std::make_shared<MockLayer>(path2)});
+
+  MockLayerTree t1;
+  t1.root()->Add(c1);
+
+  auto damage = DiffLayerTree(t1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 150, 50));
+
+  MockLayerTree t2;
+  t2.root()->Add(c1);
+
+  damage = DiffLayerTree(t2, t1);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+
+  // Only the removed layer is damaged.
+  MockLayerTree t3;
+  auto c2 = CreateContainerLayer(inner);
+  c2->AssignOldLayer(c1.get());
+  t3.root()->Add(c2);
+
+  damage = DiffLayerTree(t3, t2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(100, 0, 150, 50));
+
+  MockLayerTree t4;
+  t4.root()->Add(c2);
+
+  damage = DiffLayerTree(t4, t3);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+
+  MockLayerTree t5;
+  auto c3 = std::make_shared<ContainerLayer>();
+  c3->AssignOldLayer(c2.get());
+  t5.root()->Add(c3);
+
+  damage = DiffLayerTree(t5, t4);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 50, 50));
+}
+
 }  // namespace testing
 }  // namespace flutter
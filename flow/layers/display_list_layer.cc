@@ -159,6 +159,16 @@ void DisplayListLayer::Paint(PaintContext& context) const {
   }
 
   auto display_list = display_list_.skia_object();
+  if (context.raster_cache && display_list_raster_cache_item_) {
+    // Measure the draw, which lets the raster cache weigh what this display
+    // list costs to draw against the bytes it would take up when cached.
+    const auto start_time = fml::TimePoint::Now();
+    context.canvas->DrawDisplayList(display_list, opacity);
+    context.raster_cache->RecordDrawTime(
+        display_list_raster_cache_item_->GetId().value(),
+        context.canvas->GetTransform(), fml::TimePoint::Now() - start_time);
+    return;
+  }
   context.canvas->DrawDisplayList(display_list, opacity);
 }
 
@@ -22,6 +22,7 @@ static bool IsDisplayListWorthRasterizing(
     const DisplayList* display_list,
     bool will_change,
     bool is_complex,
+    std::optional<fml::TimeDelta> draw_time,
     DisplayListComplexityCalculator* complexity_calculator) {
   if (will_change) {
     // If the display list is going to change in the future, there is no point
@@ -42,6 +43,13 @@ static bool IsDisplayListWorthRasterizing(
     return true;
   }
 
+  if (draw_time.has_value() &&
+      draw_time.value() >= RasterCacheUtil::kMinimumDrawTimeToCache) {
+    // The display list was measured to be expensive to draw, whatever its
+    // complexity score says.
+    return true;
+  }
+
   unsigned int complexity_score = complexity_calculator->Compute(display_list);
   return complexity_calculator->ShouldBeCached(complexity_score);
 }
@@ -76,8 +84,13 @@ void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                 context->gr_context->backend())
                           : DisplayListComplexityCalculator::GetForSoftware();
 
+  std::optional<fml::TimeDelta> draw_time;
+  if (context->raster_cache) {
+    draw_time = context->raster_cache->GetDrawTime(key_id_, matrix);
+  }
+
   if (!IsDisplayListWorthRasterizing(display_list(), will_change_, is_complex_,
-                                     complexity_calculator)) {
+                                     draw_time, complexity_calculator)) {
     // We only deal with display lists that are worthy of rasterization.
     return;
   }
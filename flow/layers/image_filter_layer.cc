@@ -70,10 +70,10 @@ void ImageFilterLayer::Preroll(PrerollContext* context) {
 
   // Our saveLayer would apply any outstanding opacity or any outstanding
   // color filter after it applies our image filter. So we can apply either
-  // of those attributes with our saveLayer.
-  context->renderable_state_flags =
-      (LayerStateStack::kCallerCanApplyOpacity |
-       LayerStateStack::kCallerCanApplyColorFilter);
+  // of those attributes with our saveLayer. An outstanding image filter is
+  // composed with ours by the LayerStateStack unless our offset or the
+  // integral transform of the raster cache resolves it first.
+  context->renderable_state_flags = kSaveLayerRenderFlags;
 
   const SkIRect filter_in_bounds = child_bounds.roundOut();
   SkIRect filter_out_bounds;
@@ -571,9 +571,7 @@ TEST_F(ImageFilterLayerTest, OpacityInheritance) {
   image_filter_layer->Preroll(preroll_context());
   // ImageFilterLayers can always inherit opacity whether or not their
   // children are compatible.
-  EXPECT_EQ(context->renderable_state_flags,
-            LayerStateStack::kCallerCanApplyOpacity |
-                LayerStateStack::kCallerCanApplyColorFilter);
+  EXPECT_EQ(context->renderable_state_flags, Layer::kSaveLayerRenderFlags);
 
   int opacity_alpha = 0x7F;
   SkPoint offset = SkPoint::Make(10, 10);
@@ -15,6 +15,7 @@
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/instrumentation.h"
+#include "flutter/flow/layer_cost_store.h"
 #include "flutter/flow/layer_snapshot_store.h"
 #include "flutter/flow/layers/layer_state_stack.h"
 #include "flutter/flow/raster_cache.h"
@@ -120,7 +121,15 @@ struct PaintContext {
   // only when leaf layer tracing is enabled.
   LayerSnapshotStore* layer_snapshot_store = nullptr;
   bool enable_leaf_layer_tracing = false;
+  // Store to collect the paint time of each layer. The store is non-null
+  // only on the frames that it samples.
+  LayerCostStore* layer_cost_store = nullptr;
   impeller::AiksContext* aiks_context;
+
+  // The surface that |canvas| renders into directly, if its pixels can be
+  // read back while painting. Cleared when painting switches to a canvas
+  // that doesn't render into this surface.
+  SkSurface* readback_surface = nullptr;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
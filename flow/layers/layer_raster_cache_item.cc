@@ -119,6 +119,7 @@ bool Rasterize(RasterCacheItem::CacheState cache_state,
       .texture_registry              = paint_context.texture_registry,
       .raster_cache                  = paint_context.raster_cache,
       .frame_device_pixel_ratio      = paint_context.frame_device_pixel_ratio,
+      .aiks_context                  = paint_context.aiks_context,
       // clang-format on
   };
 
@@ -4,6 +4,9 @@
 
 #include "flutter/flow/layers/layer_state_stack.h"
 
+#include <algorithm>
+
+#include "flutter/display_list/effects/dl_image_filter.h"
 #include "flutter/display_list/utils/dl_matrix_clip_tracker.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
@@ -230,6 +233,7 @@ class SaveLayerEntry : public LayerStateStack::StateEntry {
     stack->delegate_->restore();
     stack->outstanding_ = old_attributes_;
   }
+  bool is_save_layer() const override { return true; }
 
  protected:
   const SkRect bounds_;
@@ -680,6 +684,19 @@ void LayerStateStack::push_opacity(const SkRect& bounds, SkScalar opacity) {
 void LayerStateStack::push_color_filter(
     const SkRect& bounds,
     const std::shared_ptr<const DlColorFilter>& filter) {
+  if (needs_save_layer(filter) && !filter->modifies_transparent_black()) {
+    // A saveLayer applies its image filter before any of the other
+    // outstanding attributes, which is the order in which our ancestors
+    // expect them to be applied after this filter. Running the filter as
+    // an image filter thus lets a single saveLayer apply all of them.
+    // Image filters are not limited to the bounds of the layer, though,
+    // so the filter must leave transparent black pixels alone.
+    TRACE_EVENT_INSTANT0("flutter",
+                         "LayerStateStack::ColorFilterAsImageFilter");
+    push_image_filter(bounds,
+                      std::make_shared<DlColorFilterImageFilter>(filter));
+    return;
+  }
   maybe_save_layer(filter);
   state_stack_.emplace_back(
       std::make_unique<ColorFilterEntry>(bounds, filter, outstanding_));
@@ -689,9 +706,18 @@ void LayerStateStack::push_color_filter(
 void LayerStateStack::push_image_filter(
     const SkRect& bounds,
     const std::shared_ptr<const DlImageFilter>& filter) {
-  maybe_save_layer(filter);
-  state_stack_.emplace_back(
-      std::make_unique<ImageFilterEntry>(bounds, filter, outstanding_));
+  std::shared_ptr<const DlImageFilter> applied_filter = filter;
+  if (outstanding_.image_filter) {
+    // A transform between the outstanding image filter and this one would
+    // have resolved the outstanding filter with a saveLayer, so both of
+    // them apply in the same coordinate space and can be composed into
+    // the filter of a single saveLayer.
+    TRACE_EVENT_INSTANT0("flutter", "LayerStateStack::ComposeImageFilters");
+    applied_filter = std::make_shared<DlComposeImageFilter>(
+        outstanding_.image_filter, filter);
+  }
+  state_stack_.emplace_back(std::make_unique<ImageFilterEntry>(
+      bounds, applied_filter, outstanding_));
   apply_last_entry();
 }
 
@@ -739,6 +765,13 @@ void LayerStateStack::push_clip_path(const SkPath& path, bool is_aa) {
   apply_last_entry();
 }
 
+bool LayerStateStack::has_save_layer() const {
+  return std::any_of(state_stack_.begin(), state_stack_.end(),
+                     [](const std::unique_ptr<StateEntry>& entry) {
+                       return entry->is_save_layer();
+                     });
+}
+
 bool LayerStateStack::needs_save_layer(int flags) const {
   if (outstanding_.opacity < SK_Scalar1 &&
       (flags & LayerStateStack::kCallerCanApplyOpacity) == 0) {
@@ -755,6 +788,13 @@ bool LayerStateStack::needs_save_layer(int flags) const {
   return false;
 }
 
+bool LayerStateStack::needs_save_layer(
+    const std::shared_ptr<const DlColorFilter>& filter) const {
+  return outstanding_.color_filter || outstanding_.image_filter ||
+         (outstanding_.opacity < SK_Scalar1 &&
+          !filter->can_commute_with_opacity());
+}
+
 void LayerStateStack::do_save() {
   state_stack_.emplace_back(std::make_unique<SaveEntry>());
   apply_last_entry();
@@ -800,18 +840,7 @@ void LayerStateStack::maybe_save_layer(SkScalar opacity) {
 
 void LayerStateStack::maybe_save_layer(
     const std::shared_ptr<const DlColorFilter>& filter) {
-  if (outstanding_.color_filter || outstanding_.image_filter ||
-      (outstanding_.opacity < SK_Scalar1 &&
-       !filter->can_commute_with_opacity())) {
-    // TBD: compose the 2 color filters together.
-    save_layer(outstanding_.save_layer_bounds);
-  }
-}
-
-void LayerStateStack::maybe_save_layer(
-    const std::shared_ptr<const DlImageFilter>& filter) {
-  if (outstanding_.image_filter) {
-    // TBD: compose the 2 image filters together.
+  if (needs_save_layer(filter)) {
     save_layer(outstanding_.save_layer_bounds);
   }
 }
@@ -324,6 +324,11 @@ class LayerStateStack {
   // its initial state.
   bool is_empty() const { return state_stack_.empty(); }
 
+  // Returns true if any saveLayer, including that of a backdrop filter,
+  // is applied by the state stack, in which case the content is not
+  // rendered directly into the destination of the delegate.
+  bool has_save_layer() const;
+
  private:
   size_t stack_count() const { return state_stack_.size(); }
   void restore_to_count(size_t restore_count);
@@ -361,6 +366,8 @@ class LayerStateStack {
   // or the apply flags, then a protective saveLayer will be executed.
   // ---------------------
   bool needs_save_layer(int flags) const;
+  bool needs_save_layer(
+      const std::shared_ptr<const DlColorFilter>& filter) const;
   void do_save();
   void save_layer(const SkRect& bounds);
   void maybe_save_layer_for_transform(bool needs_save);
@@ -368,7 +375,6 @@ class LayerStateStack {
   void maybe_save_layer(int apply_flags);
   void maybe_save_layer(SkScalar opacity);
   void maybe_save_layer(const std::shared_ptr<const DlColorFilter>& filter);
-  void maybe_save_layer(const std::shared_ptr<const DlImageFilter>& filter);
   // ---------------------
 
   struct RenderingAttributes {
@@ -406,6 +412,7 @@ class LayerStateStack {
     virtual void reapply(LayerStateStack* stack) const { apply(stack); }
     virtual void restore(LayerStateStack* stack) const {}
     virtual void update_mutators(MutatorsStack* mutators_stack) const {}
+    virtual bool is_save_layer() const { return false; }
 
    protected:
     StateEntry() = default;
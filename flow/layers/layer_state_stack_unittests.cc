@@ -291,7 +291,7 @@ TEST(LayerStateStack, ImageFilter) {
       std::make_shared<DlBlurImageFilter>(2.0f, 2.0f, DlTileMode::kClamp);
   std::shared_ptr<DlBlurImageFilter> inner_filter =
       std::make_shared<DlBlurImageFilter>(3.0f, 3.0f, DlTileMode::kClamp);
-  SkRect inner_src_rect = rect;
+  DlComposeImageFilter composed_filter(outer_filter, inner_filter);
   SkRect outer_src_rect;
   ASSERT_EQ(inner_filter->map_local_bounds(rect, outer_src_rect),
             &outer_src_rect);
@@ -304,14 +304,14 @@ TEST(LayerStateStack, ImageFilter) {
 
     ASSERT_EQ(state_stack.outstanding_image_filter(), outer_filter);
 
-    // Check nested color filters result in nested saveLayers
+    // Check nested image filters are composed together
     {
       auto mutator2 = state_stack.save();
       mutator.applyImageFilter(rect, inner_filter);
 
-      ASSERT_EQ(state_stack.outstanding_image_filter(), inner_filter);
+      ASSERT_EQ(*state_stack.outstanding_image_filter(), composed_filter);
 
-      // Verify output with applyState that does not accept color filters
+      // Verify output with applyState that does not accept image filters
       {
         DisplayListBuilder builder;
         state_stack.set_delegate(&builder);
@@ -326,17 +326,14 @@ TEST(LayerStateStack, ImageFilter) {
         state_stack.clear_delegate();
 
         DisplayListBuilder expected;
-        DlPaint outer_save_paint = DlPaint().setImageFilter(outer_filter);
-        DlPaint inner_save_paint = DlPaint().setImageFilter(inner_filter);
-        expected.SaveLayer(&outer_src_rect, &outer_save_paint);
-        expected.SaveLayer(&inner_src_rect, &inner_save_paint);
+        DlPaint save_paint = DlPaint().setImageFilter(&composed_filter);
+        expected.SaveLayer(&rect, &save_paint);
         expected.DrawRect(rect, DlPaint());
         expected.Restore();
-        expected.Restore();
         ASSERT_TRUE(DisplayListsEQ_Verbose(builder.Build(), expected.Build()));
       }
 
-      // Verify output with applyState that accepts color filters
+      // Verify output with applyState that accepts image filters
       {
         SkRect rect = {10, 10, 20, 20};
         DisplayListBuilder builder;
@@ -344,7 +341,7 @@ TEST(LayerStateStack, ImageFilter) {
         {
           auto restore = state_stack.applyState(
               rect, LayerStateStack::kCallerCanApplyImageFilter);
-          ASSERT_EQ(state_stack.outstanding_image_filter(), inner_filter);
+          ASSERT_EQ(*state_stack.outstanding_image_filter(), composed_filter);
 
           DlPaint paint;
           state_stack.fill(paint);
@@ -353,9 +350,7 @@ TEST(LayerStateStack, ImageFilter) {
         state_stack.clear_delegate();
 
         DisplayListBuilder expected;
-        DlPaint save_paint = DlPaint().setImageFilter(outer_filter);
-        DlPaint draw_paint = DlPaint().setImageFilter(inner_filter);
-        expected.SaveLayer(&outer_src_rect, &save_paint);
+        DlPaint draw_paint = DlPaint().setImageFilter(&composed_filter);
         expected.DrawRect(rect, draw_paint);
         ASSERT_TRUE(DisplayListsEQ_Verbose(builder.Build(), expected.Build()));
       }
@@ -548,5 +543,112 @@ TEST(LayerStateStack, ColorFilterAndImageFilterInteraction) {
   ASSERT_EQ(state_stack.outstanding_color_filter(), nullptr);
 }
 
+TEST(LayerStateStack, NestedColorFiltersShareASaveLayer) {
+  SkRect rect = {10, 10, 20, 20};
+  std::shared_ptr<const DlColorFilter> outer_filter =
+      DlSrgbToLinearGammaColorFilter::instance;
+  std::shared_ptr<const DlColorFilter> inner_filter =
+      DlLinearToSrgbGammaColorFilter::instance;
+  DlColorFilterImageFilter inner_image_filter(inner_filter);
+
+  DisplayListBuilder builder;
+  LayerStateStack state_stack;
+  state_stack.set_delegate(&builder);
+  ASSERT_EQ(builder.GetSaveCount(), 1);
+
+  {
+    auto mutator1 = state_stack.save();
+    mutator1.applyColorFilter(rect, outer_filter);
+    ASSERT_EQ(builder.GetSaveCount(), 1);
+
+    {
+      auto mutator2 = state_stack.save();
+      mutator2.applyColorFilter(rect, inner_filter);
+
+      // The inner filter is applied as an image filter rather than
+      // resolving the outer filter with a saveLayer
+      ASSERT_EQ(builder.GetSaveCount(), 1);
+      ASSERT_EQ(state_stack.outstanding_color_filter(), outer_filter);
+      ASSERT_EQ(*state_stack.outstanding_image_filter(), inner_image_filter);
+
+      {
+        auto restore = state_stack.applyState(rect, 0);
+        ASSERT_EQ(builder.GetSaveCount(), 2);
+        builder.DrawRect(rect, DlPaint());
+      }
+    }
+    ASSERT_EQ(builder.GetSaveCount(), 1);
+    ASSERT_EQ(state_stack.outstanding_color_filter(), outer_filter);
+    ASSERT_EQ(state_stack.outstanding_image_filter(), nullptr);
+  }
+  state_stack.clear_delegate();
+
+  DisplayListBuilder expected;
+  DlPaint save_paint = DlPaint()
+                           .setColorFilter(outer_filter)
+                           .setImageFilter(&inner_image_filter);
+  expected.SaveLayer(&rect, &save_paint);
+  expected.DrawRect(rect, DlPaint());
+  expected.Restore();
+  ASSERT_TRUE(DisplayListsEQ_Verbose(builder.Build(), expected.Build()));
+}
+
+TEST(LayerStateStack, OpacityAndNonCommutingColorFilterShareASaveLayer) {
+  SkRect rect = {10, 10, 20, 20};
+  // clang-format off
+  const float matrix[20] = {
+    0, 0, 0, 1, 0,
+    0, 1, 0, 0, 0,
+    0, 0, 1, 0, 0,
+    0, 0, 0, 1, 0,
+  };
+  // clang-format on
+  std::shared_ptr<const DlColorFilter> color_filter =
+      std::make_shared<DlMatrixColorFilter>(matrix);
+  ASSERT_FALSE(color_filter->can_commute_with_opacity());
+  ASSERT_FALSE(color_filter->modifies_transparent_black());
+  DlColorFilterImageFilter image_filter(color_filter);
+
+  DisplayListBuilder builder;
+  LayerStateStack state_stack;
+  state_stack.set_delegate(&builder);
+  ASSERT_EQ(builder.GetSaveCount(), 1);
+
+  {
+    auto mutator1 = state_stack.save();
+    mutator1.applyOpacity(rect, 0.5f);
+
+    {
+      auto mutator2 = state_stack.save();
+      mutator2.applyColorFilter(rect, color_filter);
+
+      // The opacity is still outstanding and will be applied after the
+      // color filter by the same saveLayer
+      ASSERT_EQ(builder.GetSaveCount(), 1);
+      ASSERT_EQ(state_stack.outstanding_opacity(), 0.5f);
+      ASSERT_EQ(state_stack.outstanding_color_filter(), nullptr);
+      ASSERT_EQ(*state_stack.outstanding_image_filter(), image_filter);
+
+      {
+        auto restore = state_stack.applyState(rect, 0);
+        ASSERT_EQ(builder.GetSaveCount(), 2);
+        builder.DrawRect(rect, DlPaint());
+      }
+    }
+    ASSERT_EQ(builder.GetSaveCount(), 1);
+    ASSERT_EQ(state_stack.outstanding_opacity(), 0.5f);
+    ASSERT_EQ(state_stack.outstanding_image_filter(), nullptr);
+  }
+  state_stack.clear_delegate();
+
+  DisplayListBuilder expected;
+  DlPaint save_paint =
+      DlPaint().setOpacity(0.5f).setImageFilter(&image_filter);
+  expected.SaveLayer(&rect, &save_paint);
+  expected.DrawRect(rect, DlPaint());
+  expected.Restore();
+  ASSERT_TRUE(DisplayListsEQ_Verbose(builder.Build(), expected.Build()));
+}
+
 }  // namespace testing
 }  // namespace flutter
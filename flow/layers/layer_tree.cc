@@ -127,6 +127,11 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
     snapshot_store = &frame.context().snapshot_store();
   }
 
+  // The store only times the layers of the frames that it samples.
+  LayerCostStore& cost_store = frame.context().layer_cost_store();
+  LayerCostStore* layer_cost_store =
+      cost_store.BeginFrame() ? &cost_store : nullptr;
+
   SkColorSpace* color_space = GetColorSpace(frame.canvas());
   RasterCache* cache =
       ignore_raster_cache ? nullptr : &frame.context().raster_cache();
@@ -144,7 +149,9 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       .frame_device_pixel_ratio      = device_pixel_ratio_,
       .layer_snapshot_store          = snapshot_store,
       .enable_leaf_layer_tracing     = enable_leaf_layer_tracing_,
+      .layer_cost_store              = layer_cost_store,
       .aiks_context                  = frame.aiks_context(),
+      .readback_surface              = frame.readback_surface(),
       // clang-format on
   };
 
@@ -154,8 +161,15 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
   }
 
   if (root_layer_->needs_painting(context)) {
+    LayerCostStore::ScopedLayerTimer timer(context.layer_cost_store,
+                                           *root_layer_, state_stack);
     root_layer_->Paint(context);
   }
+  cost_store.EndFrame();
+
+  if (cost_store.IsHeatmapEnabled()) {
+    cost_store.DrawHeatmap(canvas);
+  }
 }
 
 sk_sp<DisplayList> LayerTree::Flatten(
@@ -202,6 +216,7 @@ sk_sp<DisplayList> LayerTree::Flatten(
       .frame_device_pixel_ratio      = device_pixel_ratio_,
       .layer_snapshot_store          = nullptr,
       .enable_leaf_layer_tracing     = false,
+      .layer_cost_store              = nullptr,
       // clang-format on
   };
 
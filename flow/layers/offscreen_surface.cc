@@ -31,11 +31,9 @@ static sk_sp<SkSurface> CreateSnapshotSurface(GrDirectContext* surface_context,
   return SkSurface::MakeRaster(image_info);
 }
 
-/// Returns a buffer containing a snapshot of the surface.
-///
-/// If compressed is true the data is encoded as PNG.
-static sk_sp<SkData> GetRasterData(const sk_sp<SkSurface>& offscreen_surface,
-                                   bool compressed) {
+/// Returns a CPU copy of the contents of the surface.
+static sk_sp<SkImage> GetRasterImage(
+    const sk_sp<SkSurface>& offscreen_surface) {
   // Prepare an image from the surface, this image may potentially be on th GPU.
   auto potentially_gpu_snapshot = offscreen_surface->makeImageSnapshot();
   if (!potentially_gpu_snapshot) {
@@ -50,34 +48,47 @@ static sk_sp<SkData> GetRasterData(const sk_sp<SkSurface>& offscreen_surface,
     FML_LOG(ERROR) << "Screenshot: unable to make raster image";
     return nullptr;
   }
+  return cpu_snapshot;
+}
+
+OffscreenSurface::OffscreenSurface(GrDirectContext* surface_context,
+                                   const SkISize& size) {
+  offscreen_surface_ = CreateSnapshotSurface(surface_context, size);
+  if (offscreen_surface_) {
+    adapter_.set_canvas(offscreen_surface_->getCanvas());
+  }
+}
+
+sk_sp<SkData> OffscreenSurface::GetRasterData(bool compressed) const {
+  return EncodeRasterImage(GetRasterImage(), compressed);
+}
+
+sk_sp<SkImage> OffscreenSurface::GetRasterImage() const {
+  return flutter::GetRasterImage(offscreen_surface_);
+}
+
+sk_sp<SkData> OffscreenSurface::EncodeRasterImage(
+    const sk_sp<SkImage>& raster_image,
+    bool compressed) {
+  if (!raster_image) {
+    return nullptr;
+  }
 
   // If the caller want the pixels to be compressed, there is a Skia utility to
   // compress to PNG. Use that.
   if (compressed) {
-    return cpu_snapshot->encodeToData();
+    return raster_image->encodeToData();
   }
 
   // Copy it into a bitmap and return the same.
   SkPixmap pixmap;
-  if (!cpu_snapshot->peekPixels(&pixmap)) {
+  if (!raster_image->peekPixels(&pixmap)) {
     FML_LOG(ERROR) << "Screenshot: unable to obtain bitmap pixels";
     return nullptr;
   }
   return SkData::MakeWithCopy(pixmap.addr32(), pixmap.computeByteSize());
 }
 
-OffscreenSurface::OffscreenSurface(GrDirectContext* surface_context,
-                                   const SkISize& size) {
-  offscreen_surface_ = CreateSnapshotSurface(surface_context, size);
-  if (offscreen_surface_) {
-    adapter_.set_canvas(offscreen_surface_->getCanvas());
-  }
-}
-
-sk_sp<SkData> OffscreenSurface::GetRasterData(bool compressed) const {
-  return flutter::GetRasterData(offscreen_surface_, compressed);
-}
-
 DlCanvas* OffscreenSurface::GetCanvas() {
   return &adapter_;
 }
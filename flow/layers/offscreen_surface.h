@@ -11,6 +11,7 @@
 #include "flutter/display_list/dl_canvas.h"
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/include/core/SkSurface.h"
@@ -28,6 +29,16 @@ class OffscreenSurface {
 
   sk_sp<SkData> GetRasterData(bool compressed) const;
 
+  /// Returns a CPU copy of the contents of the surface, or nullptr if it
+  /// could not be read back.
+  sk_sp<SkImage> GetRasterImage() const;
+
+  /// Returns the pixels of an image returned by |GetRasterImage|, encoded as
+  /// PNG if |compressed| is true. Unlike the read back, this does not need the
+  /// GPU context of the surface and may be called on any thread.
+  static sk_sp<SkData> EncodeRasterImage(const sk_sp<SkImage>& raster_image,
+                                         bool compressed);
+
   DlCanvas* GetCanvas();
 
   bool IsValid() const;
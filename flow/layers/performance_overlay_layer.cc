@@ -4,8 +4,10 @@
 
 #include "flutter/flow/layers/performance_overlay_layer.h"
 
+#include <deque>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <string>
 
 #include "third_party/skia/include/core/SkFont.h"
@@ -14,7 +16,73 @@
 namespace flutter {
 namespace {
 
+// Keeps the typefaces and the label text blobs of the overlay across frames.
+// Overlay layers are created anew every frame, and the labels only change
+// when the statistics do, so this saves reading the font file and shaping
+// the text every frame.
+class StatisticsTextCache {
+ public:
+  static StatisticsTextCache& GetInstance() {
+    static StatisticsTextCache* cache = new StatisticsTextCache();
+    return *cache;
+  }
+
+  sk_sp<SkTextBlob> MakeText(const std::string& text,
+                             const std::string& font_path) {
+    std::scoped_lock lock(mutex_);
+    for (const auto& entry : texts_) {
+      if (entry.text == text && entry.font_path == font_path) {
+        return entry.blob;
+      }
+    }
+
+    SkFont font;
+    if (font_path != "") {
+      font = SkFont(GetTypeface(font_path));
+    }
+    font.setSize(15);
+    auto blob = SkTextBlob::MakeFromText(text.c_str(), text.size(), font,
+                                         SkTextEncoding::kUTF8);
+    // Enough for the labels of both stopwatches.
+    if (texts_.size() >= 4u) {
+      texts_.pop_front();
+    }
+    texts_.push_back({text, font_path, blob});
+    return blob;
+  }
+
+ private:
+  struct TextEntry {
+    std::string text;
+    std::string font_path;
+    sk_sp<SkTextBlob> blob;
+  };
+
+  std::mutex mutex_;
+  std::deque<std::pair<std::string, sk_sp<SkTypeface>>> typefaces_;
+  std::deque<TextEntry> texts_;
+
+  StatisticsTextCache() = default;
+
+  sk_sp<SkTypeface> GetTypeface(const std::string& font_path) {
+    for (const auto& [path, typeface] : typefaces_) {
+      if (path == font_path) {
+        return typeface;
+      }
+    }
+    if (typefaces_.size() >= 2u) {
+      typefaces_.pop_front();
+    }
+    auto typeface = SkTypeface::MakeFromFile(font_path.c_str());
+    typefaces_.emplace_back(font_path, typeface);
+    return typeface;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StatisticsTextCache);
+};
+
 void VisualizeStopWatch(DlCanvas* canvas,
+                        GrDirectContext* gr_context,
                         const Stopwatch& stopwatch,
                         SkScalar x,
                         SkScalar y,
@@ -29,7 +97,7 @@ void VisualizeStopWatch(DlCanvas* canvas,
 
   if (show_graph) {
     SkRect visualization_rect = SkRect::MakeXYWH(x, y, width, height);
-    stopwatch.Visualize(canvas, visualization_rect);
+    stopwatch.Visualize(canvas, visualization_rect, gr_context);
   }
 
   if (show_labels) {
@@ -47,12 +115,6 @@ sk_sp<SkTextBlob> PerformanceOverlayLayer::MakeStatisticsText(
     const Stopwatch& stopwatch,
     const std::string& label_prefix,
     const std::string& font_path) {
-  SkFont font;
-  if (font_path != "") {
-    font = SkFont(SkTypeface::MakeFromFile(font_path.c_str()));
-  }
-  font.setSize(15);
-
   double max_ms_per_frame = stopwatch.MaxDelta().ToMillisecondsF();
   double average_ms_per_frame = stopwatch.AverageDelta().ToMillisecondsF();
   std::stringstream stream;
@@ -61,9 +123,7 @@ sk_sp<SkTextBlob> PerformanceOverlayLayer::MakeStatisticsText(
   stream << label_prefix << "  "
          << "max " << max_ms_per_frame << " ms/frame, "
          << "avg " << average_ms_per_frame << " ms/frame";
-  auto text = stream.str();
-  return SkTextBlob::MakeFromText(text.c_str(), text.size(), font,
-                                  SkTextEncoding::kUTF8);
+  return StatisticsTextCache::GetInstance().MakeText(stream.str(), font_path);
 }
 
 PerformanceOverlayLayer::PerformanceOverlayLayer(uint64_t options,
@@ -100,12 +160,13 @@ void PerformanceOverlayLayer::Paint(PaintContext& context) const {
   auto mutator = context.state_stack.save();
 
   VisualizeStopWatch(
-      context.canvas, context.raster_time, x, y, width, height - padding,
-      options_ & kVisualizeRasterizerStatistics,
+      context.canvas, context.gr_context, context.raster_time, x, y, width,
+      height - padding, options_ & kVisualizeRasterizerStatistics,
       options_ & kDisplayRasterizerStatistics, "Raster", font_path_);
 
-  VisualizeStopWatch(context.canvas, context.ui_time, x, y + height, width,
-                     height - padding, options_ & kVisualizeEngineStatistics,
+  VisualizeStopWatch(context.canvas, context.gr_context, context.ui_time, x,
+                     y + height, width, height - padding,
+                     options_ & kVisualizeEngineStatistics,
                      options_ & kDisplayEngineStatistics, "UI", font_path_);
 }
 
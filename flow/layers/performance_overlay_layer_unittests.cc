@@ -193,6 +193,22 @@ TEST_F(PerformanceOverlayLayerTest, SimpleRasterizerStatistics) {
                                             text_position}}}));
 }
 
+TEST_F(PerformanceOverlayLayerTest, StatisticsTextIsReusedAcrossFrames) {
+  FixedRefreshRateStopwatch stopwatch;
+  stopwatch.SetLapTime(fml::TimeDelta::FromMilliseconds(4));
+
+  auto text = PerformanceOverlayLayer::MakeStatisticsText(stopwatch, "UI", "");
+  EXPECT_EQ(PerformanceOverlayLayer::MakeStatisticsText(stopwatch, "UI", ""),
+            text);
+  EXPECT_NE(
+      PerformanceOverlayLayer::MakeStatisticsText(stopwatch, "Raster", ""),
+      text);
+
+  stopwatch.SetLapTime(fml::TimeDelta::FromMilliseconds(20));
+  EXPECT_NE(PerformanceOverlayLayer::MakeStatisticsText(stopwatch, "UI", ""),
+            text);
+}
+
 TEST_F(PerformanceOverlayLayerTest, MarkAsDirtyWhenResized) {
   // Regression test for https://github.com/flutter/flutter/issues/54188
 
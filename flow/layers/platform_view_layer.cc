@@ -13,6 +13,19 @@ PlatformViewLayer::PlatformViewLayer(const SkPoint& offset,
                                      int64_t view_id)
     : offset_(offset), size_(size), view_id_(view_id) {}
 
+void PlatformViewLayer::Diff(DiffContext* context, const Layer* old_layer) {
+  DiffContext::AutoSubtreeRestore subtree(context);
+  if (!context->IsSubtreeDirty()) {
+    FML_DCHECK(old_layer);
+    // The platform composites the contents of the view, which can change
+    // without this layer changing.
+    context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(old_layer));
+  }
+  context->AddLayerBounds(SkRect::MakeXYWH(offset_.x(), offset_.y(),
+                                           size_.width(), size_.height()));
+  context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
+}
+
 void PlatformViewLayer::Preroll(PrerollContext* context) {
   set_paint_bounds(SkRect::MakeXYWH(offset_.x(), offset_.y(), size_.width(),
                                     size_.height()));
@@ -43,6 +56,7 @@ void PlatformViewLayer::Paint(PaintContext& context) const {
   }
   DlCanvas* canvas = context.view_embedder->CompositeEmbeddedView(view_id_);
   context.canvas = canvas;
+  context.readback_surface = nullptr;
   context.state_stack.set_delegate(canvas);
 }
 
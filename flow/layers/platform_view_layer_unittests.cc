@@ -6,6 +6,7 @@
 #include "flutter/flow/layers/platform_view_layer.h"
 #include "flutter/flow/layers/transform_layer.h"
 
+#include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_embedder.h"
 #include "flutter/flow/testing/mock_layer.h"
@@ -139,5 +140,26 @@ TEST_F(PlatformViewLayerTest, StateTransfer) {
   transform_layer1->Paint(paint_ctx);
 }
 
+using PlatformViewLayerDiffTest = DiffContextTest;
+
+TEST_F(PlatformViewLayerDiffTest, PlatformViewIsAlwaysDamaged) {
+  auto layer1 = std::make_shared<PlatformViewLayer>(
+      SkPoint::Make(10, 10), SkSize::Make(100, 100), /*view_id=*/0);
+  MockLayerTree tree1;
+  tree1.root()->Add(layer1);
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 110, 110));
+
+  // The contents of the platform view may have changed even though the layer
+  // didn't.
+  auto layer2 = std::make_shared<PlatformViewLayer>(
+      SkPoint::Make(10, 10), SkSize::Make(100, 100), /*view_id=*/0);
+  layer2->AssignOldLayer(layer1.get());
+  MockLayerTree tree2;
+  tree2.root()->Add(layer2);
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 110, 110));
+}
+
 }  // namespace testing
 }  // namespace flutter
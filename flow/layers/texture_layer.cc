@@ -24,9 +24,14 @@ void TextureLayer::Diff(DiffContext* context, const Layer* old_layer) {
   if (!context->IsSubtreeDirty()) {
     FML_DCHECK(old_layer);
     auto prev = old_layer->as_texture_layer();
-    // TODO(knopp) It would be nice to be able to determine that a texture is
-    // dirty
-    context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(prev));
+    // The layer paints what it painted in the previous frame unless the
+    // texture has changed since.
+    if (!prev || prev->offset_ != offset_ || prev->size_ != size_ ||
+        prev->texture_id_ != texture_id_ || prev->freeze_ != freeze_ ||
+        prev->sampling_ != sampling_ ||
+        context->IsTextureDirty(texture_id_)) {
+      context->MarkSubtreeDirty(context->GetOldLayerPaintRegion(prev));
+    }
   }
 
   // Make sure DiffContext knows there is a TextureLayer in this subtree.
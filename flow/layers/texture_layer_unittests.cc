@@ -115,6 +115,41 @@ TEST_F(TextureLayerDiffTest, TextureInRetainedLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 100, 100));
 }
 
+TEST_F(TextureLayerDiffTest, OnlyTexturesWithNewFramesAreDamaged) {
+  TextureRegistry registry;
+  registry.RegisterTexture(std::make_shared<MockTexture>(0));
+  registry.RegisterTexture(std::make_shared<MockTexture>(1));
+
+  MockLayerTree tree1;
+  auto container = std::make_shared<ContainerLayer>();
+  tree1.root()->Add(container);
+  container->Add(std::make_shared<TextureLayer>(
+      SkPoint::Make(0, 0), SkSize::Make(100, 100), 0, false,
+      DlImageSampling::kLinear));
+  container->Add(std::make_shared<TextureLayer>(
+      SkPoint::Make(200, 0), SkSize::Make(100, 100), 1, false,
+      DlImageSampling::kLinear));
+
+  auto damage = DiffLayerTree(tree1, MockLayerTree(), SkIRect::MakeEmpty(), 0,
+                              0, true, &registry);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 300, 100));
+  registry.ClearDirtyTextures();
+
+  // The same layers are drawn again without any new texture frames.
+  MockLayerTree tree2;
+  tree2.root()->Add(container);
+  damage = DiffLayerTree(tree2, tree1, SkIRect::MakeEmpty(), 0, 0, true,
+                         &registry);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+
+  registry.MarkNewFrameAvailable(1);
+  MockLayerTree tree3;
+  tree3.root()->Add(container);
+  damage = DiffLayerTree(tree3, tree2, SkIRect::MakeEmpty(), 0, 0, true,
+                         &registry);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 300, 100));
+}
+
 TEST_F(TextureLayerTest, OpacityInheritance) {
   const SkPoint layer_offset = SkPoint::Make(0.0f, 0.0f);
   const SkSize layer_size = SkSize::Make(8.0f, 8.0f);
@@ -2,12 +2,20 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <memory>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkRect.h"
 
 namespace flutter {
 
+class PaintRegion;
+
+// Layer Unique Id to PaintRegion
+using PaintRegionMap = std::unordered_map<uint64_t, PaintRegion>;
+
 // Corresponds to area on the screen where the layer subtree has painted to.
 //
 // The area is used when adding damage of removed or dirty layer to overall
@@ -56,12 +64,28 @@ class PaintRegion {
   // region.
   bool has_texture() const { return has_texture_; }
 
+  // Returns the paint regions of the children of the container layer this
+  // region belongs to. Null for other layers, and for containers whose
+  // children weren't diffed.
+  //
+  // Keeping the regions of the children with the region of their container
+  // allows a retained subtree to carry over all of its paint regions to the
+  // next frame by copying the region of its root.
+  const std::shared_ptr<const PaintRegionMap>& children() const {
+    return children_;
+  }
+
+  void set_children(std::shared_ptr<const PaintRegionMap> children) {
+    children_ = std::move(children);
+  }
+
  private:
   std::shared_ptr<std::vector<SkRect>> rects_;
   size_t from_ = 0;
   size_t to_ = 0;
   bool has_readback_ = false;
   bool has_texture_ = false;
+  std::shared_ptr<const PaintRegionMap> children_;
 };
 
 }  // namespace flutter
@@ -4,15 +4,18 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
 #include "flutter/common/constants.h"
+#include "flutter/display_list/dl_builder.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
@@ -23,10 +26,19 @@
 
 namespace flutter {
 
+static fml::MemoryCounter& GetRasterCacheMemoryCounter() {
+  static auto& counter = fml::MemoryCounter::Get("raster_cache");
+  return counter;
+}
+
 RasterCacheResult::RasterCacheResult(sk_sp<DlImage> image,
                                      const SkRect& logical_rect,
                                      const char* type)
-    : image_(std::move(image)), logical_rect_(logical_rect), flow_(type) {}
+    : image_(std::move(image)),
+      logical_rect_(logical_rect),
+      flow_(type),
+      memory_count_(GetRasterCacheMemoryCounter(),
+                    image_ ? image_->GetApproximateByteSize() : 0u) {}
 
 void RasterCacheResult::draw(DlCanvas& canvas, const DlPaint* paint) const {
   DlAutoCanvasRestore auto_restore(&canvas, true);
@@ -43,9 +55,11 @@ void RasterCacheResult::draw(DlCanvas& canvas, const DlPaint* paint) const {
 }
 
 RasterCache::RasterCache(size_t access_threshold,
-                         size_t display_list_cache_limit_per_frame)
+                         size_t display_list_cache_limit_per_frame,
+                         size_t byte_budget)
     : access_threshold_(access_threshold),
       display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame),
+      byte_budget_(byte_budget),
       checkerboard_images_(false) {}
 
 /// @note Procedure doesn't copy all closures.
@@ -58,6 +72,27 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
   SkRect dest_rect =
       RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
 
+  if (display_list_rasterizer_) {
+    DisplayListBuilder builder(
+        SkRect::MakeWH(dest_rect.width(), dest_rect.height()));
+    builder.Translate(-dest_rect.left(), -dest_rect.top());
+    builder.Transform(matrix);
+    draw_function(&builder);
+
+    if (checkerboard_images_) {
+      draw_checkerboard(&builder, context.logical_rect);
+    }
+
+    auto image = display_list_rasterizer_(
+        builder.Build(),
+        SkISize::Make(dest_rect.width(), dest_rect.height()));
+    if (!image) {
+      return nullptr;
+    }
+    return std::make_unique<RasterCacheResult>(image, context.logical_rect,
+                                               context.flow_type);
+  }
+
   const SkImageInfo image_info =
       SkImageInfo::MakeN32Premul(dest_rect.width(), dest_rect.height(),
                                  sk_ref_sp(context.dst_color_space));
@@ -94,9 +129,28 @@ bool RasterCache::UpdateCacheEntry(
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
   if (!entry.image) {
+    auto measurement = draw_times_.find(key);
+    if (measurement != draw_times_.end()) {
+      entry.draw_time = measurement->second.draw_time;
+    }
+    SkRect dest_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+        raster_cache_context.logical_rect,
+        RasterCacheUtil::GetIntegralTransCTM(raster_cache_context.matrix));
+    size_t bytes = static_cast<size_t>(dest_rect.width()) *
+                   static_cast<size_t>(dest_rect.height()) * 4;
+    if (!MakeRoomForEntry(entry, bytes)) {
+      return false;
+    }
     void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
+    const auto start_time = fml::TimePoint::Now();
     entry.image = Rasterize(raster_cache_context, render_function, func);
     if (entry.image != nullptr) {
+      entry.last_drawn_frame = frame_count_;
+      // Rasterizing draws the same content as drawing the entry without the
+      // cache would, so it stands in for that time until it is measured.
+      if (entry.draw_time == fml::TimeDelta::Zero()) {
+        entry.draw_time = fml::TimePoint::Now() - start_time;
+      }
       switch (id.type()) {
         case RasterCacheKeyType::kDisplayList: {
           display_list_cached_this_frame_++;
@@ -121,6 +175,9 @@ RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
   if (visible || entry.accesses_since_visible > 0) {
     entry.accesses_since_visible++;
   }
+  if (visible) {
+    entry.visible_frames++;
+  }
   return {entry.accesses_since_visible, entry.image != nullptr};
 }
 
@@ -134,6 +191,114 @@ int RasterCache::GetAccessCount(const RasterCacheKeyID& id,
   return -1;
 }
 
+void RasterCache::RecordDrawTime(const RasterCacheKeyID& id,
+                                 const SkMatrix& matrix,
+                                 fml::TimeDelta draw_time) const {
+  RasterCacheKey key = RasterCacheKey(id, matrix);
+  DrawTimeEntry& measurement = draw_times_[key];
+  measurement.used_this_frame = true;
+  if (measurement.draw_time == fml::TimeDelta::Zero()) {
+    measurement.draw_time = draw_time;
+  } else {
+    // Smooth out the noise of individual measurements.
+    measurement.draw_time = fml::TimeDelta::FromNanoseconds(
+        (measurement.draw_time.ToNanoseconds() * 3 +
+         draw_time.ToNanoseconds()) /
+        4);
+  }
+  auto entry = cache_.find(key);
+  if (entry != cache_.end()) {
+    entry->second.draw_time = measurement.draw_time;
+  }
+}
+
+std::optional<fml::TimeDelta> RasterCache::GetDrawTime(
+    const RasterCacheKeyID& id,
+    const SkMatrix& matrix) const {
+  auto measurement = draw_times_.find(RasterCacheKey(id, matrix));
+  if (measurement == draw_times_.end()) {
+    return std::nullopt;
+  }
+  measurement->second.used_this_frame = true;
+  return measurement->second.draw_time;
+}
+
+// static
+double RasterCache::GetValuePerByte(const Entry& entry, size_t bytes) {
+  if (entry.accesses_since_visible == 0 || bytes == 0) {
+    return 0;
+  }
+  double visible_rate = static_cast<double>(entry.visible_frames) /
+                        static_cast<double>(entry.accesses_since_visible);
+  return entry.draw_time.ToMicrosecondsF() * visible_rate /
+         static_cast<double>(bytes);
+}
+
+bool RasterCache::MakeRoomForEntry(const Entry& candidate,
+                                   size_t bytes) const {
+  if (bytes > byte_budget_) {
+    return false;
+  }
+  size_t cached_bytes = 0;
+  for (const auto& item : cache_) {
+    if (item.second.image) {
+      cached_bytes += item.second.image->image_bytes();
+    }
+  }
+  if (cached_bytes + bytes <= byte_budget_) {
+    return true;
+  }
+  bool measured = candidate.draw_time != fml::TimeDelta::Zero();
+  double candidate_value = measured ? GetValuePerByte(candidate, bytes) : 0;
+
+  struct EvictableEntry {
+    bool stale;
+    size_t last_drawn_frame;
+    double value;
+    RasterCacheKey::Map<Entry>::iterator it;
+  };
+  std::vector<EvictableEntry> evictable;
+  size_t evictable_bytes = 0;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    if (!it->second.image) {
+      continue;
+    }
+    size_t image_bytes = it->second.image->image_bytes();
+    bool stale = it->second.last_drawn_frame + 1 < frame_count_;
+    double value = GetValuePerByte(it->second, image_bytes);
+    if (stale || (measured && value < candidate_value)) {
+      evictable.push_back({stale, it->second.last_drawn_frame, value, it});
+      evictable_bytes += image_bytes;
+    }
+  }
+  if (cached_bytes - evictable_bytes + bytes > byte_budget_) {
+    return false;
+  }
+
+  std::sort(evictable.begin(), evictable.end(),
+            [](const EvictableEntry& a, const EvictableEntry& b) {
+              if (a.stale != b.stale) {
+                return a.stale;
+              }
+              if (a.stale) {
+                return a.last_drawn_frame < b.last_drawn_frame;
+              }
+              return a.value < b.value;
+            });
+  for (const auto& entry : evictable) {
+    if (cached_bytes + bytes <= byte_budget_) {
+      break;
+    }
+    size_t image_bytes = entry.it->second.image->image_bytes();
+    RasterCacheMetrics& metrics = GetMetricsForKind(entry.it->first.kind());
+    metrics.eviction_count++;
+    metrics.eviction_bytes += image_bytes;
+    cached_bytes -= image_bytes;
+    entry.it->second.image.reset();
+  }
+  return true;
+}
+
 bool RasterCache::HasEntry(const RasterCacheKeyID& id,
                            const SkMatrix& matrix) const {
   RasterCacheKey key = RasterCacheKey(id, matrix);
@@ -152,16 +317,22 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
   }
 
   Entry& entry = it->second;
+  RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
 
   if (entry.image) {
     entry.image->draw(canvas, paint);
+    entry.last_drawn_frame = frame_count_;
+    metrics.hit_count++;
+    metrics.time_saved = metrics.time_saved + entry.draw_time;
     return true;
   }
 
+  metrics.miss_count++;
   return false;
 }
 
 void RasterCache::BeginFrame() {
+  frame_count_++;
   display_list_cached_this_frame_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
@@ -198,6 +369,14 @@ void RasterCache::EvictUnusedCacheEntries() {
     }
     cache_.erase(it);
   }
+  for (auto it = draw_times_.begin(); it != draw_times_.end();) {
+    if (it->second.used_this_frame) {
+      it->second.used_this_frame = false;
+      ++it;
+    } else {
+      it = draw_times_.erase(it);
+    }
+  }
 }
 
 void RasterCache::EndFrame() {
@@ -207,6 +386,7 @@ void RasterCache::EndFrame() {
 
 void RasterCache::Clear() {
   cache_.clear();
+  draw_times_.clear();
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -247,6 +427,13 @@ void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
   Clear();
 }
 
+void RasterCache::SetDisplayListRasterizer(DisplayListRasterizer rasterizer) {
+  display_list_rasterizer_ = std::move(rasterizer);
+
+  // Images rasterized by the previous backend can't be drawn by this one.
+  Clear();
+}
+
 void RasterCache::TraceStatsToTimeline() const {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER(
@@ -282,7 +469,8 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
-RasterCacheMetrics& RasterCache::GetMetricsForKind(RasterCacheKeyKind kind) {
+RasterCacheMetrics& RasterCache::GetMetricsForKind(
+    RasterCacheKeyKind kind) const {
   switch (kind) {
     case RasterCacheKeyKind::kDisplayListMetrics:
       return picture_metrics_;
@@ -5,14 +5,19 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_H_
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
+#include <functional>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
+#include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_canvas.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/memory/memory_counter.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/trace_event.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkRect.h"
@@ -48,6 +53,8 @@ class RasterCacheResult {
   sk_sp<DlImage> image_;
   SkRect logical_rect_;
   fml::tracing::TraceFlow flow_;
+  // Counts the image on the "raster_cache" memory counter.
+  fml::ScopedMemoryCount memory_count_;
 };
 
 class Layer;
@@ -76,6 +83,24 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of times an entry was drawn from its cached image in this
+   * frame.
+   */
+  size_t hit_count = 0;
+
+  /**
+   * The number of times an entry that was meant to be drawn from the cache
+   * had no image and had to be drawn from scratch in this frame.
+   */
+  size_t miss_count = 0;
+
+  /**
+   * The measured render time that drawing from the cached images instead of
+   * from scratch saved in this frame.
+   */
+  fml::TimeDelta time_saved;
+
   /**
    * The total cache entries that had images during this frame.
    */
@@ -125,6 +150,12 @@ class RasterCache {
     const bool has_image;
   };
 
+  // Renders a display list into an image of the given size. Backends that
+  // don't rasterize through a |GrDirectContext|, such as Impeller, provide
+  // one so that their cache entries are backed by their own textures.
+  using DisplayListRasterizer =
+      std::function<sk_sp<DlImage>(sk_sp<DisplayList>, SkISize)>;
+
   std::unique_ptr<RasterCacheResult> Rasterize(
       const RasterCache::Context& context,
       const std::function<void(DlCanvas*)>& draw_function,
@@ -134,7 +165,8 @@ class RasterCache {
   explicit RasterCache(
       size_t access_threshold = 3,
       size_t picture_and_display_list_cache_limit_per_frame =
-          RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame);
+          RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+      size_t byte_budget = RasterCacheUtil::kDefaultCacheByteBudget);
 
   virtual ~RasterCache() = default;
 
@@ -159,6 +191,11 @@ class RasterCache {
 
   void SetCheckboardCacheImages(bool checkerboard);
 
+  // Makes |Rasterize| record the cached contents into a display list and
+  // render them with |rasterizer| instead of a Skia surface. Pass nullptr to
+  // go back to rasterizing with Skia.
+  void SetDisplayListRasterizer(DisplayListRasterizer rasterizer);
+
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
   const RasterCacheMetrics& layer_metrics() const { return layer_metrics_; }
 
@@ -208,6 +245,12 @@ class RasterCache {
    */
   size_t access_threshold() const { return access_threshold_; }
 
+  /**
+   * @brief Return the number of bytes that the cached images may take up
+   * together.
+   */
+  size_t byte_budget() const { return byte_budget_; }
+
   bool GenerateNewCacheInThisFrame() const {
     // Disabling caching when access_threshold is zero is historic behavior.
     return access_threshold_ != 0 && display_list_cached_this_frame_ <
@@ -234,6 +277,24 @@ class RasterCache {
    */
   int GetAccessCount(const RasterCacheKeyID& id, const SkMatrix& matrix) const;
 
+  /**
+   * @brief Records how long it took to draw the given entry without the
+   * cache. The measured render time of an entry decides how much it is worth
+   * caching, together with the bytes its image takes up and how often it is
+   * visible. Measurements are kept for as long as they are recorded or
+   * queried every frame, whether or not the entry exists.
+   */
+  void RecordDrawTime(const RasterCacheKeyID& id,
+                      const SkMatrix& matrix,
+                      fml::TimeDelta draw_time) const;
+
+  /**
+   * Returns the measured time it takes to draw the given entry without the
+   * cache, or std::nullopt if it has not been measured.
+   */
+  std::optional<fml::TimeDelta> GetDrawTime(const RasterCacheKeyID& id,
+                                            const SkMatrix& matrix) const;
+
   bool UpdateCacheEntry(
       const RasterCacheKeyID& id,
       const Context& raster_cache_context,
@@ -244,20 +305,46 @@ class RasterCache {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    size_t visible_frames = 0;
+    // The last frame the image was drawn in, see |frame_count_|.
+    size_t last_drawn_frame = 0;
+    // The measured time to draw the entry without the cache, or zero.
+    fml::TimeDelta draw_time;
     std::unique_ptr<RasterCacheResult> image;
   };
 
+  struct DrawTimeEntry {
+    bool used_this_frame = false;
+    fml::TimeDelta draw_time;
+  };
+
+  // The render time an entry saves per byte of its image in an average
+  // frame since it first became visible.
+  static double GetValuePerByte(const Entry& entry, size_t bytes);
+
+  // Evicts cached images until an image of the given size fits into the
+  // byte budget, and returns whether it does. Images that were not drawn in
+  // the last frame are evicted first, least recently drawn first, and the
+  // others only for a measured candidate that saves more render time per
+  // byte, least valuable first.
+  bool MakeRoomForEntry(const Entry& candidate, size_t bytes) const;
+
   void UpdateMetrics();
 
-  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
+  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind) const;
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
+  const size_t byte_budget_;
   mutable size_t display_list_cached_this_frame_ = 0;
-  RasterCacheMetrics layer_metrics_;
-  RasterCacheMetrics picture_metrics_;
+  // The number of frames begun so far.
+  size_t frame_count_ = 0;
+  mutable RasterCacheMetrics layer_metrics_;
+  mutable RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
+  mutable RasterCacheKey::Map<DrawTimeEntry> draw_times_;
   bool checkerboard_images_;
+  DisplayListRasterizer display_list_rasterizer_;
 
   void TraceStatsToTimeline() const;
 
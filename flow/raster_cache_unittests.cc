@@ -23,6 +23,7 @@
 #include "third_party/skia/include/core/SkPaint.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 namespace testing {
@@ -183,6 +184,61 @@ TEST(RasterCache, SetCheckboardCacheImages) {
   ASSERT_TRUE(did_draw_checkerboard);
 }
 
+TEST(RasterCache, DisplayListRasterizerReplacesSkiaSurfaces) {
+  flutter::RasterCache cache;
+
+  SkMatrix matrix = SkMatrix::Translate(10.5, 20);
+  auto display_list = GetSampleDisplayList();
+
+  sk_sp<DisplayList> rasterized_display_list;
+  SkISize rasterized_size = SkISize::MakeEmpty();
+  cache.SetDisplayListRasterizer(
+      [&](sk_sp<DisplayList> display_list, SkISize size) {
+        rasterized_display_list = std::move(display_list);
+        rasterized_size = size;
+        auto surface = SkSurface::MakeRasterN32Premul(size.width(),
+                                                      size.height());
+        return DlImage::Make(surface->makeImageSnapshot());
+      });
+
+  bool did_draw = false;
+  auto draw_function = [&](DlCanvas* canvas) {
+    did_draw = true;
+    canvas->DrawDisplayList(display_list);
+  };
+  auto draw_checkerboard = [](DlCanvas* canvas, const SkRect&) {};
+  RasterCache::Context r_context = {
+      // clang-format off
+      .gr_context         = nullptr,
+      .dst_color_space    = nullptr,
+      .matrix             = matrix,
+      .logical_rect       = display_list->bounds(),
+      .flow_type          = "RasterCacheFlow::DisplayList",
+      // clang-format on
+  };
+
+  auto result = cache.Rasterize(r_context, draw_function, draw_checkerboard);
+  ASSERT_NE(result, nullptr);
+  ASSERT_TRUE(did_draw);
+  ASSERT_NE(rasterized_display_list, nullptr);
+
+  SkRect device_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+      display_list->bounds(), RasterCacheUtil::GetIntegralTransCTM(matrix));
+  ASSERT_EQ(rasterized_size, SkISize::Make(device_rect.width(),
+                                           device_rect.height()));
+  ASSERT_EQ(result->image_dimensions(), rasterized_size);
+  // The contents are recorded relative to the origin of the image.
+  ASSERT_EQ(rasterized_display_list->bounds(),
+            SkRect::MakeWH(device_rect.width(), device_rect.height()));
+
+  // Without a rasterizer nothing was recorded into a display list.
+  rasterized_display_list = nullptr;
+  cache.SetDisplayListRasterizer(nullptr);
+  result = cache.Rasterize(r_context, draw_function, draw_checkerboard);
+  ASSERT_NE(result, nullptr);
+  ASSERT_EQ(rasterized_display_list, nullptr);
+}
+
 TEST(RasterCache, AccessThresholdOfZeroDisablesCachingForSkPicture) {
   size_t threshold = 0;
   flutter::RasterCache cache(threshold);
@@ -433,6 +489,218 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+TEST(RasterCache, ByteBudgetEvictsImagesThatSaveLessRenderTimePerByte) {
+  size_t threshold = 1;
+  // Room for the image of one sample display list, which takes 25624 bytes.
+  flutter::RasterCache cache(
+      threshold,
+      RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+      40000);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+
+  // Only the first image fits, and the second one was never measured, so it
+  // can't displace it.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_FALSE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  cache.RecordDrawTime(display_list_item_2.GetId().value(), matrix,
+                       fml::TimeDelta::FromSeconds(1));
+  cache.EndFrame();
+
+  // The second display list was measured to be far more expensive to draw
+  // than it took to rasterize the first one, so it takes its place.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_FALSE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_TRUE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_bytes, 25624u);
+  cache.EndFrame();
+
+  // The first display list can't take the place back.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  cache.EndFrame();
+}
+
+TEST(RasterCache, ByteBudgetEvictsImagesThatWereNotDrawnRecentlyFirst) {
+  size_t threshold = 1;
+  // Room for the image of one sample display list, which takes 25624 bytes.
+  flutter::RasterCache cache(
+      threshold,
+      RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame,
+      40000);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  auto begin_frame = [&]() {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+    RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+  };
+
+  begin_frame();
+  cache.EndFrame();
+
+  // The first image was just rasterized, so the second one can't displace
+  // it in this frame or the next.
+  for (int i = 0; i < 2; i++) {
+    begin_frame();
+    ASSERT_TRUE(
+        RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+    ASSERT_FALSE(
+        RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+    ASSERT_FALSE(
+        display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+    ASSERT_EQ(cache.picture_metrics().miss_count, 1u);
+    ASSERT_EQ(cache.picture_metrics().hit_count, 0u);
+    cache.EndFrame();
+  }
+
+  // The first image was not drawn in the last frame.
+  begin_frame();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_TRUE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_FALSE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_EQ(cache.picture_metrics().hit_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().miss_count, 1u);
+  cache.EndFrame();
+}
+
+TEST(RasterCache, MeasuredDrawTimeOverridesComplexityScore) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  // A single raster op is too cheap to cache going by its complexity.
+  auto display_list = GetSampleDisplayList(1);
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), false,
+                                               false);
+
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_EQ(display_list_item.cache_state(), RasterCacheItem::kNone);
+  cache.RecordDrawTime(display_list_item.GetId().value(), matrix,
+                       RasterCacheUtil::kMinimumDrawTimeToCache);
+  cache.EndFrame();
+
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_EQ(display_list_item.cache_state(), RasterCacheItem::kNone);
+  cache.RecordDrawTime(display_list_item.GetId().value(), matrix,
+                       RasterCacheUtil::kMinimumDrawTimeToCache);
+  cache.EndFrame();
+
+  cache.BeginFrame();
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
@@ -6,6 +6,7 @@
 #define FLUTTER_FLOW_RASTER_CACHE_UTIL_H_
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_delta.h"
 #include "include/core/SkM44.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkRect.h"
@@ -19,6 +20,17 @@ struct RasterCacheUtil {
   // the work across multiple frames.
   static constexpr int kDefaultPictureAndDisplayListCacheLimitPerFrame = 3;
 
+  // The default number of bytes the cached images may take up together. When
+  // a new image does not fit, the images that save the least render time per
+  // byte are evicted to make room for it, if it is expected to save more.
+  static constexpr size_t kDefaultCacheByteBudget = 128 * 1024 * 1024;
+
+  // Display lists that were measured to take at least this long to draw
+  // without the cache are cached even if their complexity score is low, as
+  // the score does not account for every kind of expensive operation.
+  static constexpr fml::TimeDelta kMinimumDrawTimeToCache =
+      fml::TimeDelta::FromMicroseconds(500);
+
   // The ImageFilterLayer might cache the filtered output of this layer
   // if the layer remains stable (if it is not animating for instance).
   // If the ImageFilterLayer is not the same between rendered frames,
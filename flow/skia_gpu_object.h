@@ -5,12 +5,15 @@
 #ifndef FLUTTER_FLOW_SKIA_GPU_OBJECT_H_
 #define FLUTTER_FLOW_SKIA_GPU_OBJECT_H_
 
+#include <algorithm>
 #include <mutex>
 #include <queue>
 
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
@@ -20,11 +23,21 @@ namespace flutter {
 
 // A queue that holds Skia objects that must be destructed on the given task
 // runner.
+//
+// The objects are released in batches of at most |max_drain_batch_size|
+// objects and textures, each taking at most |kMaxDrainBatchDuration|. When a
+// batch leaves objects behind, the next batch is posted behind the tasks that
+// were queued in the meantime, so that releasing a large number of objects
+// does not hold up the image uploads of the task runner.
 template <class T>
 class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
  public:
   using ResourceContext = T;
 
+  static constexpr size_t kDefaultMaxDrainBatchSize = 256;
+  static constexpr fml::TimeDelta kMaxDrainBatchDuration =
+      fml::TimeDelta::FromMilliseconds(2);
+
   void Unref(SkRefCnt* object) {
     if (drain_immediate_) {
       object->unref();
@@ -35,7 +48,7 @@ class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
     if (!drain_pending_) {
       drain_pending_ = true;
       task_runner_->PostDelayedTask(
-          [strong = fml::Ref(this)]() { strong->Drain(); }, drain_delay_);
+          [strong = fml::Ref(this)]() { strong->DrainBatch(); }, drain_delay_);
     }
   }
 
@@ -47,7 +60,7 @@ class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
     if (!drain_pending_) {
       drain_pending_ = true;
       task_runner_->PostDelayedTask(
-          [strong = fml::Ref(this)]() { strong->Drain(); }, drain_delay_);
+          [strong = fml::Ref(this)]() { strong->DrainBatch(); }, drain_delay_);
     }
   }
 
@@ -55,7 +68,8 @@ class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
   // shutdown (when the platform side reference to the OpenGL context is about
   // to go away), we may need to pre-emptively drain the unref queue. It is the
   // responsibility of the caller to ensure that no further unrefs are queued
-  // after this call.
+  // after this call. Unlike the automatic drain, this releases all of the
+  // queued objects at once.
   void Drain() {
     TRACE_EVENT0("flutter", "SkiaUnrefQueue::Drain");
     std::deque<SkRefCnt*> skia_objects;
@@ -64,7 +78,8 @@ class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
       std::scoped_lock lock(mutex_);
       objects_.swap(skia_objects);
       textures_.swap(textures);
-      drain_pending_ = false;
+      // A pending batch finds the queue empty and completes the drain.
+      TraceQueueDepthLocked();
     }
     DoDrain(skia_objects, textures, context_);
   }
@@ -74,6 +89,72 @@ class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
   }
 
  private:
+  // Releases one batch of the queued objects and textures, and posts the
+  // next batch if the queue is not empty yet. Skia is only signaled to clean
+  // up the released resources once the queue is empty.
+  void DrainBatch() {
+    TRACE_EVENT0("flutter", "SkiaUnrefQueue::DrainBatch");
+    std::deque<SkRefCnt*> skia_objects;
+    std::deque<GrBackendTexture> textures;
+    {
+      std::scoped_lock lock(mutex_);
+      size_t object_count = std::min(objects_.size(), max_drain_batch_size_);
+      skia_objects.assign(objects_.begin(), objects_.begin() + object_count);
+      objects_.erase(objects_.begin(), objects_.begin() + object_count);
+      size_t texture_count =
+          std::min(textures_.size(), max_drain_batch_size_ - object_count);
+      textures.assign(textures_.begin(), textures_.begin() + texture_count);
+      textures_.erase(textures_.begin(), textures_.begin() + texture_count);
+    }
+
+    const fml::TimePoint deadline =
+        fml::TimePoint::Now() + kMaxDrainBatchDuration;
+    while (!skia_objects.empty() && fml::TimePoint::Now() < deadline) {
+      skia_objects.front()->unref();
+      skia_objects.pop_front();
+      needs_deferred_cleanup_ = true;
+    }
+    if (context_) {
+      while (!textures.empty() && fml::TimePoint::Now() < deadline) {
+        context_->deleteBackendTexture(textures.front());
+        textures.pop_front();
+      }
+    } else {
+      textures.clear();
+    }
+
+    bool drain_complete;
+    {
+      std::scoped_lock lock(mutex_);
+      // Return what the deadline left over to the front of the queue.
+      objects_.insert(objects_.begin(), skia_objects.begin(),
+                      skia_objects.end());
+      textures_.insert(textures_.begin(), textures.begin(), textures.end());
+      drain_complete = objects_.empty() && textures_.empty();
+      drain_pending_ = !drain_complete;
+      TraceQueueDepthLocked();
+    }
+
+    if (!drain_complete) {
+      task_runner_->PostTask(
+          [strong = fml::Ref(this)]() { strong->DrainBatch(); });
+      return;
+    }
+    if (context_ && needs_deferred_cleanup_) {
+      context_->performDeferredCleanup(std::chrono::milliseconds(0));
+    }
+    needs_deferred_cleanup_ = false;
+  }
+
+  void TraceQueueDepthLocked() const {
+#if !FLUTTER_RELEASE
+    FML_TRACE_COUNTER("flutter",                                          //
+                      "SkiaUnrefQueue", reinterpret_cast<int64_t>(this),  //
+                      "PendingObjects", objects_.size(),                  //
+                      "PendingTextures", textures_.size());
+#endif  // !FLUTTER_RELEASE
+  }
+
   const fml::RefPtr<fml::TaskRunner> task_runner_;
   const fml::TimeDelta drain_delay_;
   std::mutex mutex_;
@@ -84,6 +165,10 @@ class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
   // Enabled when there is an impeller context, which removes the usage of
   // the queue altogether.
   bool drain_immediate_;
+  const size_t max_drain_batch_size_;
+  // Whether objects were released since Skia was last signaled to
+  // performDeferredCleanup. Only accessed on the task runner.
+  bool needs_deferred_cleanup_ = false;
 
   // The `GrDirectContext* context` is only used for signaling Skia to
   // performDeferredCleanup. It can be nullptr when such signaling is not needed
@@ -91,12 +176,14 @@ class UnrefQueue : public fml::RefCountedThreadSafe<UnrefQueue<T>> {
   UnrefQueue(fml::RefPtr<fml::TaskRunner> task_runner,
              fml::TimeDelta delay,
              sk_sp<ResourceContext> context = nullptr,
-             bool drain_immediate = false)
+             bool drain_immediate = false,
+             size_t max_drain_batch_size = kDefaultMaxDrainBatchSize)
       : task_runner_(std::move(task_runner)),
         drain_delay_(delay),
         drain_pending_(false),
         context_(context),
-        drain_immediate_(drain_immediate) {}
+        drain_immediate_(drain_immediate),
+        max_drain_batch_size_(std::max<size_t>(max_drain_batch_size, 1)) {}
 
   ~UnrefQueue() {
     // The ResourceContext must be deleted on the task runner thread.
@@ -4,10 +4,12 @@
 
 #include "flutter/flow/skia_gpu_object.h"
 
+#include <atomic>
 #include <future>
 #include <utility>
 
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/testing/thread_test.h"
@@ -35,6 +37,21 @@ class TestSkObject : public SkRefCnt {
   fml::TaskQueueId* dtor_task_queue_id_;
 };
 
+class CountingSkObject : public SkRefCnt {
+ public:
+  CountingSkObject(fml::CountDownLatch* latch, std::atomic<size_t>* count)
+      : latch_(latch), count_(count) {}
+
+  ~CountingSkObject() override {
+    (*count_)++;
+    latch_->CountDown();
+  }
+
+ private:
+  fml::CountDownLatch* latch_;
+  std::atomic<size_t>* count_;
+};
+
 class TestResourceContext : public TestSkObject {
  public:
   TestResourceContext(std::shared_ptr<fml::AutoResetWaitableEvent> latch,
@@ -161,5 +178,47 @@ TEST_F(SkiaGpuObjectTest, UnrefResourceContextInTaskRunnerThread) {
   ASSERT_EQ(dtor_task_queue_id, unref_task_runner()->GetTaskQueueId());
 }
 
+TEST_F(SkiaGpuObjectTest, QueueDrainsInBatches) {
+  fml::CountDownLatch latch(3);
+  std::atomic<size_t> count = 0;
+  size_t count_after_first_batch = 0;
+  fml::RefPtr<SkiaUnrefQueue> unref_queue;
+  unref_task_runner()->PostTask([&]() {
+    unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+        unref_task_runner(), fml::TimeDelta::FromSeconds(0), nullptr,
+        /*drain_immediate=*/false, /*max_drain_batch_size=*/1);
+    for (size_t i = 0; i < 3; i++) {
+      unref_queue->Unref(new CountingSkObject(&latch, &count));
+    }
+    // This task is queued after the first batch, but the next batches are
+    // queued after it.
+    unref_task_runner()->PostTask(
+        [&]() { count_after_first_batch = count.load(); });
+  });
+  latch.Wait();
+  ASSERT_EQ(count_after_first_batch, 1u);
+  ASSERT_EQ(count.load(), 3u);
+}
+
+TEST_F(SkiaGpuObjectTest, ExplicitDrainReleasesAllObjects) {
+  fml::CountDownLatch latch(3);
+  std::atomic<size_t> count = 0;
+  size_t count_after_drain = 0;
+  fml::AutoResetWaitableEvent drained;
+  unref_task_runner()->PostTask([&]() {
+    auto unref_queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+        unref_task_runner(), fml::TimeDelta::FromSeconds(3), nullptr,
+        /*drain_immediate=*/false, /*max_drain_batch_size=*/1);
+    for (size_t i = 0; i < 3; i++) {
+      unref_queue->Unref(new CountingSkObject(&latch, &count));
+    }
+    unref_queue->Drain();
+    count_after_drain = count.load();
+    drained.Signal();
+  });
+  drained.Wait();
+  ASSERT_EQ(count_after_drain, 3u);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -26,6 +26,10 @@ bool Surface::EnableRasterCache() const {
   return true;
 }
 
+bool Surface::AllowsSkippingUnchangedFrames() const {
+  return true;
+}
+
 std::shared_ptr<impeller::AiksContext> Surface::GetAiksContext() const {
   return nullptr;
 }
@@ -49,6 +49,10 @@ class Surface {
 
   virtual bool EnableRasterCache() const;
 
+  /// Whether frames that would render identically to the last frame presented
+  /// on this surface may be dropped instead of being presented again.
+  virtual bool AllowsSkippingUnchangedFrames() const;
+
   virtual std::shared_ptr<impeller::AiksContext> GetAiksContext() const;
 
   /// Capture the `SurfaceData` currently present in the surface.
@@ -57,6 +57,38 @@ TEST(TextureRegistryTest, UnregisterTextureCallbackTriggered) {
   ASSERT_TRUE(mock_texture2->unregistered());
 }
 
+TEST(TextureRegistryTest, TracksDirtyTextures) {
+  TextureRegistry registry;
+  auto mock_texture1 = std::make_shared<MockTexture>(0);
+  auto mock_texture2 = std::make_shared<MockTexture>(1);
+
+  registry.RegisterTexture(mock_texture1);
+  registry.RegisterTexture(mock_texture2);
+  EXPECT_TRUE(registry.IsTextureDirty(0));
+  EXPECT_TRUE(registry.IsTextureDirty(1));
+
+  registry.ClearDirtyTextures();
+  EXPECT_FALSE(registry.IsTextureDirty(0));
+  EXPECT_FALSE(registry.IsTextureDirty(1));
+
+  registry.MarkNewFrameAvailable(1);
+  EXPECT_FALSE(registry.IsTextureDirty(0));
+  EXPECT_TRUE(registry.IsTextureDirty(1));
+
+  // Textures that aren't registered have no frames.
+  registry.MarkNewFrameAvailable(2);
+  EXPECT_FALSE(registry.IsTextureDirty(2));
+
+  registry.ClearDirtyTextures();
+  registry.UnregisterTexture(0);
+  EXPECT_TRUE(registry.IsTextureDirty(0));
+  EXPECT_FALSE(registry.IsTextureDirty(1));
+
+  registry.ClearDirtyTextures();
+  registry.OnGrContextCreated();
+  EXPECT_TRUE(registry.IsTextureDirty(1));
+}
+
 TEST(TextureRegistryTest, GrContextCallbackTriggered) {
   TextureRegistry registry;
   auto mock_texture1 = std::make_shared<MockTexture>(0);
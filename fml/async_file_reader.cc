@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/async_file_reader.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+
+namespace {
+
+// The most reads a batch keeps in flight on the task runner at once, besides
+// the one on the calling thread.
+constexpr size_t kMaxConcurrentReads = 8u;
+
+std::unique_ptr<Mapping> ReadMapping(const UniqueFD& base_directory,
+                                     const std::string& path) {
+  TRACE_EVENT1("flutter", "AsyncFileReader::Read", "path", path.c_str());
+  UniqueFD fd =
+      OpenFile(base_directory, path.c_str(), false, FilePermission::kRead);
+  if (!fd.is_valid() || IsDirectory(fd)) {
+    return nullptr;
+  }
+  auto mapping = std::make_unique<FileMapping>(
+      fd, std::initializer_list<FileMapping::Protection>{
+              FileMapping::Protection::kRead},
+      FileMapping::AccessHint::kPopulate);
+  if (!mapping->IsValid()) {
+    return nullptr;
+  }
+  return mapping;
+}
+
+// The state of a batch of reads, shared by the threads that read it. Reads
+// are claimed one at a time, so a thread that starts late finds nothing left
+// to read instead of holding up the batch.
+struct ReadBatch {
+  ReadBatch(UniqueFD p_directory, std::vector<std::string> p_paths)
+      : directory(std::move(p_directory)),
+        paths(std::move(p_paths)),
+        mappings(paths.size()),
+        latch(paths.size()) {}
+
+  void ReadRemaining() {
+    for (size_t index = next_index++; index < paths.size();
+         index = next_index++) {
+      mappings[index] = ReadMapping(directory, paths[index]);
+      latch.CountDown();
+    }
+  }
+
+  const UniqueFD directory;
+  const std::vector<std::string> paths;
+  std::vector<std::unique_ptr<Mapping>> mappings;
+  std::atomic_size_t next_index = 0u;
+  CountDownLatch latch;
+};
+
+}  // namespace
+
+AsyncFileReader::AsyncFileReader(std::shared_ptr<BasicTaskRunner> task_runner)
+    : task_runner_(std::move(task_runner)) {}
+
+AsyncFileReader::~AsyncFileReader() = default;
+
+void AsyncFileReader::ReadFile(const UniqueFD& base_directory,
+                               const std::string& path,
+                               ReadCallback callback) const {
+  if (!task_runner_) {
+    callback(ReadMapping(base_directory, path));
+    return;
+  }
+  // The directory is duplicated so that the caller's descriptor may be
+  // closed before the read happens.
+  auto directory = std::make_shared<UniqueFD>(Duplicate(base_directory.get()));
+  task_runner_->PostTask([directory, path, callback = std::move(callback)]() {
+    callback(ReadMapping(*directory, path));
+  });
+}
+
+std::vector<std::unique_ptr<Mapping>> AsyncFileReader::ReadFiles(
+    const UniqueFD& base_directory,
+    const std::vector<std::string>& paths) const {
+  TRACE_EVENT0("flutter", "AsyncFileReader::ReadFiles");
+  std::vector<std::unique_ptr<Mapping>> mappings;
+  if (!task_runner_ || paths.size() < 2u) {
+    mappings.reserve(paths.size());
+    for (const auto& path : paths) {
+      mappings.push_back(ReadMapping(base_directory, path));
+    }
+    return mappings;
+  }
+
+  auto batch =
+      std::make_shared<ReadBatch>(Duplicate(base_directory.get()), paths);
+  const size_t task_count = std::min(paths.size() - 1u, kMaxConcurrentReads);
+  for (size_t i = 0; i < task_count; i++) {
+    task_runner_->PostTask([batch]() { batch->ReadRemaining(); });
+  }
+  batch->ReadRemaining();
+  batch->latch.Wait();
+  return std::move(batch->mappings);
+}
+
+}  // namespace fml
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_ASYNC_FILE_READER_H_
+#define FLUTTER_FML_ASYNC_FILE_READER_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      Reads files on the threads of a task runner, so that a batch of
+///             reads is issued to the storage concurrently instead of one
+///             after the other.
+///
+///             Files are read into file mappings whose pages are populated
+///             before the mapping is handed out, so that the reads happen on
+///             the threads of the task runner rather than on the first access
+///             to the mapping.
+///
+class AsyncFileReader {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Invoked with the mapping of a file that was read, or nullptr
+  ///             if the file could not be read.
+  ///
+  using ReadCallback = std::function<void(std::unique_ptr<Mapping> mapping)>;
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  task_runner  The task runner to read the files on, usually a
+  ///                          concurrent task runner. Files are read on the
+  ///                          calling thread if this is null.
+  ///
+  explicit AsyncFileReader(std::shared_ptr<BasicTaskRunner> task_runner);
+
+  ~AsyncFileReader();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the file at `path` relative to `base_directory` and
+  ///             invokes the callback with its mapping on the thread it was
+  ///             read on.
+  ///
+  void ReadFile(const UniqueFD& base_directory,
+                const std::string& path,
+                ReadCallback callback) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the files at `paths` relative to `base_directory`
+  ///             concurrently, and waits for all of them to be read.
+  ///
+  ///             The calling thread reads files too, so this doesn't deadlock
+  ///             when the threads of the task runner are all busy, for
+  ///             example when called from one of them.
+  ///
+  /// @return     The mappings of the files in the order of `paths`, with
+  ///             nullptr for the files that could not be read.
+  ///
+  std::vector<std::unique_ptr<Mapping>> ReadFiles(
+      const UniqueFD& base_directory,
+      const std::vector<std::string>& paths) const;
+
+ private:
+  const std::shared_ptr<BasicTaskRunner> task_runner_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AsyncFileReader);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_ASYNC_FILE_READER_H_
@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/async_file_reader.h"
+
+#include <string>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+static std::string ToString(const Mapping& mapping) {
+  return {reinterpret_cast<const char*>(mapping.GetMapping()),
+          mapping.GetSize()};
+}
+
+static std::vector<std::string> WriteFiles(const UniqueFD& directory,
+                                           size_t count) {
+  std::vector<std::string> paths;
+  for (size_t i = 0; i < count; i++) {
+    std::string path = "file_" + std::to_string(i);
+    std::string contents = "contents of " + path;
+    DataMapping mapping(std::vector<uint8_t>(contents.begin(), contents.end()));
+    EXPECT_TRUE(WriteAtomically(directory, path.c_str(), mapping));
+    paths.push_back(std::move(path));
+  }
+  return paths;
+}
+
+TEST(AsyncFileReaderTest, ReadsFilesInOrder) {
+  ScopedTemporaryDirectory dir;
+  auto paths = WriteFiles(dir.fd(), 20u);
+  paths.insert(paths.begin() + 5, "missing");
+
+  auto loop = ConcurrentMessageLoop::Create(4u);
+  AsyncFileReader reader(loop->GetTaskRunner());
+  auto mappings = reader.ReadFiles(dir.fd(), paths);
+
+  ASSERT_EQ(mappings.size(), paths.size());
+  for (size_t i = 0; i < paths.size(); i++) {
+    if (paths[i] == "missing") {
+      EXPECT_EQ(mappings[i], nullptr);
+    } else {
+      ASSERT_NE(mappings[i], nullptr);
+      EXPECT_EQ(ToString(*mappings[i]), "contents of " + paths[i]);
+    }
+  }
+}
+
+TEST(AsyncFileReaderTest, ReadsFilesWithoutTaskRunner) {
+  ScopedTemporaryDirectory dir;
+  auto paths = WriteFiles(dir.fd(), 3u);
+
+  AsyncFileReader reader(nullptr);
+  auto mappings = reader.ReadFiles(dir.fd(), paths);
+  ASSERT_EQ(mappings.size(), 3u);
+  for (size_t i = 0; i < paths.size(); i++) {
+    ASSERT_NE(mappings[i], nullptr);
+    EXPECT_EQ(ToString(*mappings[i]), "contents of " + paths[i]);
+  }
+}
+
+TEST(AsyncFileReaderTest, ReadsFilesFromWorkerThreads) {
+  ScopedTemporaryDirectory dir;
+  auto paths = WriteFiles(dir.fd(), 10u);
+
+  // Every worker of the loop waits on a batch of its own, so the batches can
+  // only complete if the threads waiting on them read the files themselves.
+  auto loop = ConcurrentMessageLoop::Create(2u);
+  AsyncFileReader reader(loop->GetTaskRunner());
+  AutoResetWaitableEvent latch1;
+  AutoResetWaitableEvent latch2;
+  for (auto* latch : {&latch1, &latch2}) {
+    loop->GetTaskRunner()->PostTask([&reader, &dir, &paths, latch]() {
+      auto mappings = reader.ReadFiles(dir.fd(), paths);
+      for (const auto& mapping : mappings) {
+        EXPECT_NE(mapping, nullptr);
+      }
+      latch->Signal();
+    });
+  }
+  latch1.Wait();
+  latch2.Wait();
+}
+
+TEST(AsyncFileReaderTest, ReadsFileAsynchronously) {
+  ScopedTemporaryDirectory dir;
+  auto paths = WriteFiles(dir.fd(), 1u);
+
+  auto loop = ConcurrentMessageLoop::Create(1u);
+  AsyncFileReader reader(loop->GetTaskRunner());
+  AutoResetWaitableEvent latch;
+  std::string contents;
+  reader.ReadFile(dir.fd(), paths[0],
+                  [&contents, &latch](std::unique_ptr<Mapping> mapping) {
+                    if (mapping) {
+                      contents = ToString(*mapping);
+                    }
+                    latch.Signal();
+                  });
+  latch.Wait();
+  EXPECT_EQ(contents, "contents of file_0");
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -4,6 +4,7 @@
 
 #include "flutter/fml/backtrace.h"
 
+#include <algorithm>
 #include <csignal>
 #include <sstream>
 
@@ -24,7 +25,7 @@ namespace fml {
 
 static std::string kKUnknownFrameName = "Unknown";
 
-static std::string GetSymbolName(void* symbol) {
+std::string GetSymbolName(void* symbol) {
   char name[1024];
   if (!absl::Symbolize(symbol, name, sizeof(name))) {
     return kKUnknownFrameName;
@@ -40,6 +41,19 @@ static int Backtrace(void** symbols, int size) {
 #endif  // FML_OS_WIN
 }
 
+size_t CaptureBacktrace(void** frames, size_t max_frames) {
+  constexpr size_t kMaxFrames = 256;
+  void* symbols[kMaxFrames];
+  const auto available_frames =
+      Backtrace(symbols, std::min(max_frames + 1, kMaxFrames));
+  if (available_frames <= 1) {
+    return 0;
+  }
+  // Exclude here.
+  std::copy(symbols + 1, symbols + available_frames, frames);
+  return available_frames - 1;
+}
+
 std::string BacktraceHere(size_t offset) {
   constexpr size_t kMaxFrames = 256;
   void* symbols[kMaxFrames];
@@ -16,6 +16,17 @@ namespace fml {
 // If the |offset| is 0, the backtrace is included caller function.
 std::string BacktraceHere(size_t offset = 0);
 
+// Capture the return addresses of the frames of the calling thread into
+// |frames|, starting with the caller of this function.
+//
+// Unlike |BacktraceHere|, this neither symbolizes nor allocates once it has
+// been called once, and so may be called from a signal handler. Returns the
+// number of frames captured, which is 0 if backtraces are not supported.
+size_t CaptureBacktrace(void** frames, size_t max_frames);
+
+// Retrieve the name of the function containing |address|, or "Unknown".
+std::string GetSymbolName(void* address);
+
 void InstallCrashHandler();
 
 bool IsCrashHandlingSupported();
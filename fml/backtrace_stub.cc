@@ -12,6 +12,14 @@ std::string BacktraceHere(size_t offset) {
   return "";
 }
 
+size_t CaptureBacktrace(void** frames, size_t max_frames) {
+  return 0;
+}
+
+std::string GetSymbolName(void* address) {
+  return kKUnknownFrameName;
+}
+
 void InstallCrashHandler() {
   // Not supported.
 }
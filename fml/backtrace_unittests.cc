@@ -34,5 +34,19 @@ TEST(BacktraceTest, CanGatherBacktrace) {
   }
 }
 
+TEST(BacktraceTest, CanCaptureBacktrace) {
+  if (!IsCrashHandlingSupported()) {
+    GTEST_SKIP();
+    return;
+  }
+  void* frames[8];
+  const auto frame_count = CaptureBacktrace(frames, 8u);
+  ASSERT_GT(frame_count, 0u);
+  ASSERT_LE(frame_count, 8u);
+  ASSERT_NE(frames[0], nullptr);
+
+  ASSERT_EQ(CaptureBacktrace(frames, 1u), 1u);
+}
+
 }  // namespace testing
 }  // namespace fml
@@ -19,11 +19,15 @@ std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
 
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    worker_states_.emplace_back(std::make_unique<Worker>());
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      WorkerMain(i);
     });
   }
 
@@ -43,68 +47,83 @@ size_t ConcurrentMessageLoop::GetWorkerCount() const {
   return worker_count_;
 }
 
-std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner() {
-  return std::make_shared<ConcurrentTaskRunner>(weak_from_this());
+std::shared_ptr<ConcurrentTaskRunner> ConcurrentMessageLoop::GetTaskRunner(
+    const char* task_type) {
+  return std::make_shared<ConcurrentTaskRunner>(weak_from_this(), task_type);
 }
 
-void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
+void ConcurrentMessageLoop::PostTask(const fml::closure& task,
+                                     const char* task_type) {
   if (!task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
   // Don't just drop tasks on the floor in case of shutdown.
   if (shutdown_) {
     FML_DLOG(WARNING)
         << "Tried to post a task to shutdown concurrent message "
            "loop. The task will be executed on the callers thread.";
-    lock.unlock();
     task();
     return;
   }
 
-  tasks_.push(task);
+  Task pending_task{
+      .closure = task,
+      .post_time = fml::TimePoint::Now(),
+      .task_type = task_type,
+  };
+  if (auto worker_index = GetCurrentWorkerIndex()) {
+    auto& worker = *worker_states_[worker_index.value()];
+    std::scoped_lock lock(worker.tasks_mutex);
+    worker.tasks.push_back(std::move(pending_task));
+  } else {
+    std::scoped_lock lock(injected_tasks_mutex_);
+    injected_tasks_.push(std::move(pending_task));
+  }
+  ++pending_task_count_;
 
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
+  WakeUpWorker();
+}
 
+void ConcurrentMessageLoop::WakeUpWorker() {
+  // Workers count themselves idle before they check for pending tasks, and
+  // the pending task count is incremented before the idle workers are
+  // checked, so at least one side sees the other.
+  if (idle_worker_count_ == 0) {
+    return;
+  }
+
+  // Acquiring the mutex makes sure the idle worker is waiting on the condition
+  // variable. Unlock the mutex before notifying the condition variable because
+  // that mutex has to be acquired on the other thread anyway.
+  { std::scoped_lock lock(tasks_mutex_); }
   tasks_condition_.notify_one();
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
   while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
-    });
-
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
     std::vector<fml::closure> thread_tasks;
-
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
-    }
-
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+    bool shutdown_now = false;
+    {
+      std::unique_lock lock(tasks_mutex_);
+      ++idle_worker_count_;
+      tasks_condition_.wait(lock, [&]() {
+        return pending_task_count_ > 0 || shutdown_ || HasThreadTasksLocked();
+      });
+      --idle_worker_count_;
+
+      // Shutdown cannot be read with the task mutex unlocked.
+      shutdown_now = shutdown_;
+
+      if (HasThreadTasksLocked()) {
+        thread_tasks = GetThreadTasksLocked();
+        FML_DCHECK(!HasThreadTasksLocked());
+      }
     }
 
     // Don't hold onto the mutex while tasks are being executed as they could
     // themselves try to post more tasks to the message loop.
-    lock.unlock();
-
     TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
-    if (task) {
-      task();
-    }
 
     // Execute any thread tasks.
     for (const auto& thread_task : thread_tasks) {
@@ -112,11 +131,114 @@ void ConcurrentMessageLoop::WorkerMain() {
     }
 
     if (shutdown_now) {
+      // Execute one last task, like the other workers woken up for shutdown.
+      if (auto task = TakeTask(worker_index)) {
+        RunTask(worker_index, task.value());
+      }
       break;
     }
+
+    // Keep running tasks without going back to sleep while there are any.
+    while (!shutdown_) {
+      auto task = TakeTask(worker_index);
+      if (!task.has_value()) {
+        break;
+      }
+      RunTask(worker_index, task.value());
+    }
   }
 }
 
+std::optional<ConcurrentMessageLoop::Task> ConcurrentMessageLoop::TakeTask(
+    size_t worker_index) {
+  // The most recently posted task of this worker is the most likely to still
+  // have its data in the caches.
+  auto& worker = *worker_states_[worker_index];
+  {
+    std::scoped_lock lock(worker.tasks_mutex);
+    if (!worker.tasks.empty()) {
+      Task task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+      --pending_task_count_;
+      return task;
+    }
+  }
+
+  // Take a share of the injected tasks, so that the others can be stolen from
+  // this worker instead of contending on the injection queue.
+  {
+    std::scoped_lock lock(injected_tasks_mutex_);
+    if (!injected_tasks_.empty()) {
+      Task task = std::move(injected_tasks_.front());
+      injected_tasks_.pop();
+      const size_t share = injected_tasks_.size() / worker_count_;
+      if (share > 0) {
+        std::scoped_lock worker_lock(worker.tasks_mutex);
+        for (size_t i = 0; i < share; i++) {
+          // Keep the oldest tasks in front of the queue, where they are
+          // stolen from first.
+          worker.tasks.push_front(std::move(injected_tasks_.front()));
+          injected_tasks_.pop();
+        }
+      }
+      --pending_task_count_;
+      return task;
+    }
+  }
+
+  // Steal the oldest task of another worker.
+  for (size_t i = 1; i < worker_count_; i++) {
+    auto& victim = *worker_states_[(worker_index + i) % worker_count_];
+    std::scoped_lock lock(victim.tasks_mutex);
+    if (!victim.tasks.empty()) {
+      Task task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      --pending_task_count_;
+      return task;
+    }
+  }
+
+  return std::nullopt;
+}
+
+void ConcurrentMessageLoop::RunTask(size_t worker_index, const Task& task) {
+  const auto start_time = fml::TimePoint::Now();
+  task.closure();
+  const auto end_time = fml::TimePoint::Now();
+  fml::tracing::TraceFlushThreadTimelineEvents();
+
+  const auto wait_time = start_time - task.post_time;
+  const auto run_time = end_time - start_time;
+  auto& worker = *worker_states_[worker_index];
+  std::scoped_lock lock(worker.statistics_mutex);
+  auto& statistics = worker.statistics[task.task_type];
+  statistics.task_count++;
+  statistics.total_wait_time = statistics.total_wait_time + wait_time;
+  statistics.max_wait_time = std::max(statistics.max_wait_time, wait_time);
+  statistics.total_run_time = statistics.total_run_time + run_time;
+  statistics.max_run_time = std::max(statistics.max_run_time, run_time);
+}
+
+std::map<std::string, ConcurrentMessageLoop::TaskStatistics>
+ConcurrentMessageLoop::GetTaskStatistics() const {
+  std::map<std::string, TaskStatistics> result;
+  for (const auto& worker : worker_states_) {
+    std::scoped_lock lock(worker->statistics_mutex);
+    for (const auto& [task_type, statistics] : worker->statistics) {
+      auto& merged = result[task_type];
+      merged.task_count += statistics.task_count;
+      merged.total_wait_time =
+          merged.total_wait_time + statistics.total_wait_time;
+      merged.max_wait_time =
+          std::max(merged.max_wait_time, statistics.max_wait_time);
+      merged.total_run_time = merged.total_run_time + statistics.total_run_time;
+      merged.max_run_time =
+          std::max(merged.max_run_time, statistics.max_run_time);
+    }
+  }
+  return result;
+}
+
 void ConcurrentMessageLoop::Terminate() {
   std::scoped_lock lock(tasks_mutex_);
   shutdown_ = true;
@@ -148,9 +270,22 @@ std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
   return pending_tasks;
 }
 
+std::optional<size_t> ConcurrentMessageLoop::GetCurrentWorkerIndex() const {
+  // The worker thread ids are set before any task can be posted, and never
+  // change after.
+  const auto thread_id = std::this_thread::get_id();
+  for (size_t i = 0; i < worker_thread_ids_.size(); i++) {
+    if (worker_thread_ids_[i] == thread_id) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
 ConcurrentTaskRunner::ConcurrentTaskRunner(
-    std::weak_ptr<ConcurrentMessageLoop> weak_loop)
-    : weak_loop_(std::move(weak_loop)) {}
+    std::weak_ptr<ConcurrentMessageLoop> weak_loop,
+    const char* task_type)
+    : weak_loop_(std::move(weak_loop)), task_type_(task_type) {}
 
 ConcurrentTaskRunner::~ConcurrentTaskRunner() = default;
 
@@ -160,7 +295,7 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
   }
 
   if (auto loop = weak_loop_.lock()) {
-    loop->PostTask(task);
+    loop->PostTask(task, task_type_);
     return;
   }
 
@@ -171,13 +306,7 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
 }
 
 bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    if (worker_thread_id == std::this_thread::get_id()) {
-      return true;
-    }
-  }
-  return false;
+  return GetCurrentWorkerIndex().has_value();
 }
 
 }  // namespace fml
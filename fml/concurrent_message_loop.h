@@ -5,22 +5,46 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <map>
+#include <optional>
 #include <queue>
+#include <string>
 #include <thread>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace fml {
 
 class ConcurrentTaskRunner;
 
+/// A pool of worker threads that run the tasks posted to its task runners.
+///
+/// Tasks posted from outside the pool go to a shared injection queue. Tasks
+/// posted from a worker go to the worker's own queue, which it runs most
+/// recent first. Workers take batches of tasks from the injection queue into
+/// their own queues, and steal the oldest tasks of the other workers when
+/// they run out, so that they rarely contend on the same lock.
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
+  static constexpr const char* kDefaultTaskType = "default";
+
+  /// The time spent by the tasks of one type waiting to run and running.
+  struct TaskStatistics {
+    size_t task_count = 0;
+    fml::TimeDelta total_wait_time;
+    fml::TimeDelta max_wait_time;
+    fml::TimeDelta total_run_time;
+    fml::TimeDelta max_run_time;
+  };
+
   static std::shared_ptr<ConcurrentMessageLoop> Create(
       size_t worker_count = std::thread::hardware_concurrency());
 
@@ -28,7 +52,11 @@ class ConcurrentMessageLoop
 
   size_t GetWorkerCount() const;
 
-  std::shared_ptr<ConcurrentTaskRunner> GetTaskRunner();
+  /// Returns a task runner for the worker pool. The statistics of the tasks
+  /// it posts are recorded under `task_type`, which must outlive the loop,
+  /// like a string literal.
+  std::shared_ptr<ConcurrentTaskRunner> GetTaskRunner(
+      const char* task_type = kDefaultTaskType);
 
   void Terminate();
 
@@ -36,23 +64,52 @@ class ConcurrentMessageLoop
 
   bool RunsTasksOnCurrentThread();
 
+  /// Returns the statistics of the tasks that have run so far, by task type.
+  std::map<std::string, TaskStatistics> GetTaskStatistics() const;
+
  private:
   friend ConcurrentTaskRunner;
 
+  struct Task {
+    fml::closure closure;
+    fml::TimePoint post_time;
+    const char* task_type;
+  };
+
+  struct Worker {
+    std::mutex tasks_mutex;
+    std::deque<Task> tasks;
+    mutable std::mutex statistics_mutex;
+    std::map<const char*, TaskStatistics> statistics;
+  };
+
   size_t worker_count_ = 0;
   std::vector<std::thread> workers_;
+  std::vector<std::unique_ptr<Worker>> worker_states_;
+  // Guards the sleeping workers and the thread tasks.
   std::mutex tasks_mutex_;
   std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
+  std::mutex injected_tasks_mutex_;
+  std::queue<Task> injected_tasks_;
+  std::atomic<size_t> pending_task_count_ = 0;
+  std::atomic<size_t> idle_worker_count_ = 0;
   std::vector<std::thread::id> worker_thread_ids_;
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  std::atomic_bool shutdown_ = false;
 
   explicit ConcurrentMessageLoop(size_t worker_count);
 
-  void WorkerMain();
+  void WorkerMain(size_t worker_index);
+
+  void PostTask(const fml::closure& task, const char* task_type);
+
+  void WakeUpWorker();
+
+  std::optional<size_t> GetCurrentWorkerIndex() const;
+
+  std::optional<Task> TakeTask(size_t worker_index);
 
-  void PostTask(const fml::closure& task);
+  void RunTask(size_t worker_index, const Task& task);
 
   bool HasThreadTasksLocked() const;
 
@@ -63,7 +120,9 @@ class ConcurrentMessageLoop
 
 class ConcurrentTaskRunner : public BasicTaskRunner {
  public:
-  explicit ConcurrentTaskRunner(std::weak_ptr<ConcurrentMessageLoop> weak_loop);
+  explicit ConcurrentTaskRunner(
+      std::weak_ptr<ConcurrentMessageLoop> weak_loop,
+      const char* task_type = ConcurrentMessageLoop::kDefaultTaskType);
 
   virtual ~ConcurrentTaskRunner();
 
@@ -73,6 +132,7 @@ class ConcurrentTaskRunner : public BasicTaskRunner {
   friend ConcurrentMessageLoop;
 
   std::weak_ptr<ConcurrentMessageLoop> weak_loop_;
+  const char* task_type_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentTaskRunner);
 };
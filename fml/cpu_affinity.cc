@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+
+#if defined(FML_OS_ANDROID)
+#include <sched.h>
+#endif
+
+namespace fml {
+
+CPUSpeedTracker::CPUSpeedTracker(std::vector<CpuIndexAndSpeed> data) {
+  if (data.empty()) {
+    return;
+  }
+  auto [min, max] = std::minmax_element(
+      data.begin(), data.end(),
+      [](const CpuIndexAndSpeed& a, const CpuIndexAndSpeed& b) {
+        return a.speed < b.speed;
+      });
+  const int64_t min_speed = min->speed;
+  const int64_t max_speed = max->speed;
+  if (min_speed == max_speed) {
+    return;
+  }
+  valid_ = true;
+
+  for (const auto& cpu : data) {
+    if (cpu.speed == max_speed) {
+      performance_.push_back(cpu.index);
+    } else {
+      not_performance_.push_back(cpu.index);
+    }
+    if (cpu.speed == min_speed) {
+      efficiency_.push_back(cpu.index);
+    }
+  }
+}
+
+const std::vector<size_t>& CPUSpeedTracker::GetIndices(
+    CpuAffinity affinity) const {
+  switch (affinity) {
+    case CpuAffinity::kPerformance:
+      return performance_;
+    case CpuAffinity::kEfficiency:
+      return efficiency_;
+    case CpuAffinity::kNotPerformance:
+      return not_performance_;
+  }
+  return not_performance_;
+}
+
+#if defined(FML_OS_ANDROID)
+
+// Reads the maximum frequency of each core from sysfs. Cores that are offline
+// or that don't report a frequency are left out.
+static std::vector<CpuIndexAndSpeed> ReadCpuSpeeds() {
+  std::vector<CpuIndexAndSpeed> data;
+  const unsigned int count = std::thread::hardware_concurrency();
+  for (size_t index = 0; index < count; index++) {
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(index) +
+                       "/cpufreq/cpuinfo_max_freq");
+    int64_t speed = 0;
+    if (file >> speed) {
+      data.push_back({.index = index, .speed = speed});
+    }
+  }
+  return data;
+}
+
+static const CPUSpeedTracker& GetCPUSpeedTracker() {
+  static const CPUSpeedTracker tracker(ReadCpuSpeeds());
+  return tracker;
+}
+
+bool RequestAffinity(CpuAffinity affinity) {
+  const CPUSpeedTracker& tracker = GetCPUSpeedTracker();
+  if (!tracker.IsValid()) {
+    return true;
+  }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (size_t index : tracker.GetIndices(affinity)) {
+    CPU_SET(index, &set);
+  }
+  if (::sched_setaffinity(0, sizeof(set), &set) != 0) {
+    FML_LOG(ERROR) << "Failed to set the CPU affinity of the thread";
+    return false;
+  }
+  return true;
+}
+
+std::optional<size_t> EfficiencyCoreCount() {
+  const CPUSpeedTracker& tracker = GetCPUSpeedTracker();
+  if (!tracker.IsValid()) {
+    return std::nullopt;
+  }
+  return tracker.GetIndices(CpuAffinity::kEfficiency).size();
+}
+
+#else
+
+bool RequestAffinity(CpuAffinity affinity) {
+  return true;
+}
+
+std::optional<size_t> EfficiencyCoreCount() {
+  return std::nullopt;
+}
+
+#endif  // defined(FML_OS_ANDROID)
+
+}  // namespace fml
@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_CPU_AFFINITY_H_
+#define FLUTTER_FML_CPU_AFFINITY_H_
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace fml {
+
+/// The cores that a thread may be scheduled on.
+enum class CpuAffinity {
+  /// The cores with the highest maximum frequency.
+  kPerformance,
+  /// The cores with the lowest maximum frequency.
+  kEfficiency,
+  /// Every core but the ones with the highest maximum frequency, so that the
+  /// thread does not compete with the threads pinned to them.
+  kNotPerformance,
+};
+
+struct CpuIndexAndSpeed {
+  /// The index of the core, as used in a CPU set.
+  size_t index;
+  /// The maximum frequency of the core.
+  int64_t speed;
+};
+
+//------------------------------------------------------------------------------
+/// Sorts the cores of the device into the sets each |CpuAffinity| maps to.
+///
+class CPUSpeedTracker {
+ public:
+  explicit CPUSpeedTracker(std::vector<CpuIndexAndSpeed> data);
+
+  /// Whether the cores run at different speeds. If they don't, there is
+  /// nothing to gain from pinning threads to some of them.
+  bool IsValid() const { return valid_; }
+
+  /// The indices of the cores in the given set.
+  const std::vector<size_t>& GetIndices(CpuAffinity affinity) const;
+
+ private:
+  bool valid_ = false;
+  std::vector<size_t> performance_;
+  std::vector<size_t> efficiency_;
+  std::vector<size_t> not_performance_;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Restricts the calling thread to the given set of cores.
+///
+/// @return     Whether the thread runs on the requested cores. This is true
+///             where all of the cores run at the same speed, or where pinning
+///             is not supported, since no core is faster than another then.
+///
+bool RequestAffinity(CpuAffinity affinity);
+
+//------------------------------------------------------------------------------
+/// @brief      The number of efficiency cores, or std::nullopt if the cores
+///             can't be told apart.
+///
+std::optional<size_t> EfficiencyCoreCount();
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_CPU_AFFINITY_H_
@@ -0,0 +1,42 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(CpuAffinity, SortsCoresBySpeed) {
+  CPUSpeedTracker tracker({
+      {.index = 0, .speed = 1},
+      {.index = 1, .speed = 1},
+      {.index = 2, .speed = 2},
+      {.index = 3, .speed = 3},
+  });
+
+  ASSERT_TRUE(tracker.IsValid());
+  EXPECT_EQ(tracker.GetIndices(CpuAffinity::kPerformance),
+            std::vector<size_t>{3u});
+  EXPECT_EQ(tracker.GetIndices(CpuAffinity::kEfficiency),
+            (std::vector<size_t>{0u, 1u}));
+  EXPECT_EQ(tracker.GetIndices(CpuAffinity::kNotPerformance),
+            (std::vector<size_t>{0u, 1u, 2u}));
+}
+
+TEST(CpuAffinity, IsInvalidWhenAllCoresRunAtTheSameSpeed) {
+  CPUSpeedTracker tracker({
+      {.index = 0, .speed = 1},
+      {.index = 1, .speed = 1},
+  });
+  EXPECT_FALSE(tracker.IsValid());
+  EXPECT_TRUE(tracker.GetIndices(CpuAffinity::kPerformance).empty());
+
+  CPUSpeedTracker empty_tracker({});
+  EXPECT_FALSE(empty_tracker.IsValid());
+}
+
+}  // namespace testing
+}  // namespace fml
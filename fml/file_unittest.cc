@@ -326,6 +326,34 @@ TEST(FileTest, MappingDontNeedSafeTest) {
   ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "my_contents"));
 }
 
+TEST(FileTest, MappingAccessHintTest) {
+  fml::ScopedTemporaryDirectory dir;
+  const std::string contents = "some content";
+
+  {
+    auto file = fml::OpenFile(dir.fd(), "my_contents", true,
+                              fml::FilePermission::kReadWrite);
+    WriteStringToFile(file, contents);
+  }
+
+  for (auto access_hint : {fml::FileMapping::AccessHint::kNormal,
+                           fml::FileMapping::AccessHint::kWillNeed,
+                           fml::FileMapping::AccessHint::kPopulate}) {
+    auto file = fml::OpenFile(dir.fd(), "my_contents", false,
+                              fml::FilePermission::kRead);
+    fml::FileMapping mapping(file, {fml::FileMapping::Protection::kRead},
+                             access_hint);
+    ASSERT_TRUE(mapping.IsValid());
+    ASSERT_EQ(mapping.GetSize(), contents.size());
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                          mapping.GetSize()),
+              contents);
+    ASSERT_TRUE(fml::PrefetchMapping(mapping));
+  }
+
+  ASSERT_TRUE(fml::UnlinkFile(dir.fd(), "my_contents"));
+}
+
 TEST(FileTest, FileTestsWork) {
   fml::ScopedTemporaryDirectory dir;
   ASSERT_TRUE(dir.fd().is_valid());
@@ -44,9 +44,21 @@ class FileMapping final : public Mapping {
     kExecute,
   };
 
+  // How the pages of the mapping are expected to be accessed.
+  enum class AccessHint {
+    // Pages are faulted in lazily on first access.
+    kNormal,
+    // Pages are read ahead asynchronously after the mapping is created.
+    kWillNeed,
+    // Pages are read before the constructor returns where supported, and read
+    // ahead asynchronously otherwise.
+    kPopulate,
+  };
+
   explicit FileMapping(const fml::UniqueFD& fd,
                        std::initializer_list<Protection> protection = {
-                           Protection::kRead});
+                           Protection::kRead},
+                       AccessHint access_hint = AccessHint::kNormal);
 
   ~FileMapping() override;
 
@@ -214,6 +226,19 @@ class SymbolMapping final : public Mapping {
   FML_DISALLOW_COPY_AND_ASSIGN(SymbolMapping);
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Hints the OS that the pages backing the mapping will be accessed
+///             soon so that they are read ahead instead of being faulted in one
+///             by one on first access. This does not wait for the pages to be
+///             read but may still issue I/O, so it is best called off the
+///             threads that will access the mapping.
+///
+/// @param[in]  mapping  The mapping to prefetch.
+///
+/// @return     Whether the OS accepted the hint.
+///
+bool PrefetchMapping(const Mapping& mapping);
+
 }  // namespace fml
 
 #endif  // FLUTTER_FML_MAPPING_H_
@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/memory_counter.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/logging.h"
+
+namespace fml {
+
+namespace {
+
+struct Registry {
+  std::mutex mutex;
+  std::map<std::string, MemoryCounter*, std::less<>> counters;
+};
+
+// Counters are referenced from function local statics, so neither they nor
+// the registry are ever destroyed.
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+}  // namespace
+
+MemoryCounter& MemoryCounter::Get(std::string_view name) {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  auto found = registry.counters.find(name);
+  if (found != registry.counters.end()) {
+    return *found->second;
+  }
+  auto* counter = new MemoryCounter(std::string{name});
+  registry.counters.emplace(counter->GetName(), counter);
+  return *counter;
+}
+
+std::vector<MemoryCounter::Usage> MemoryCounter::GetAllUsage() {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  std::vector<Usage> usage;
+  usage.reserve(registry.counters.size());
+  for (const auto& [name, counter] : registry.counters) {
+    usage.push_back({
+        .name = name,
+        .bytes = counter->GetBytes(),
+        .peak_bytes = counter->GetPeakBytes(),
+    });
+  }
+  return usage;
+}
+
+void MemoryCounter::ResetAllPeaks() {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  for (const auto& [name, counter] : registry.counters) {
+    counter->ResetPeak();
+  }
+}
+
+MemoryCounter::MemoryCounter(std::string name) : name_(std::move(name)) {}
+
+MemoryCounter::~MemoryCounter() = default;
+
+const std::string& MemoryCounter::GetName() const {
+  return name_;
+}
+
+void MemoryCounter::Increase(size_t bytes) {
+  UpdatePeak(bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+}
+
+void MemoryCounter::Decrease(size_t bytes) {
+  auto previous = bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+  FML_DCHECK(previous >= bytes) << "Memory counter " << name_ << " underflow.";
+}
+
+void MemoryCounter::Set(size_t bytes) {
+  bytes_.store(bytes, std::memory_order_relaxed);
+  UpdatePeak(bytes);
+}
+
+size_t MemoryCounter::GetBytes() const {
+  return bytes_.load(std::memory_order_relaxed);
+}
+
+size_t MemoryCounter::GetPeakBytes() const {
+  return peak_bytes_.load(std::memory_order_relaxed);
+}
+
+void MemoryCounter::ResetPeak() {
+  peak_bytes_.store(GetBytes(), std::memory_order_relaxed);
+}
+
+void MemoryCounter::UpdatePeak(size_t bytes) {
+  auto peak = peak_bytes_.load(std::memory_order_relaxed);
+  while (bytes > peak && !peak_bytes_.compare_exchange_weak(
+                             peak, bytes, std::memory_order_relaxed)) {
+  }
+}
+
+ScopedMemoryCount::ScopedMemoryCount() = default;
+
+ScopedMemoryCount::ScopedMemoryCount(MemoryCounter& counter, size_t bytes)
+    : counter_(&counter), bytes_(bytes) {
+  counter_->Increase(bytes_);
+}
+
+ScopedMemoryCount::ScopedMemoryCount(ScopedMemoryCount&& other)
+    : counter_(other.counter_), bytes_(other.bytes_) {
+  other.counter_ = nullptr;
+  other.bytes_ = 0u;
+}
+
+ScopedMemoryCount& ScopedMemoryCount::operator=(ScopedMemoryCount&& other) {
+  if (this != &other) {
+    Update(0u);
+    counter_ = other.counter_;
+    bytes_ = other.bytes_;
+    other.counter_ = nullptr;
+    other.bytes_ = 0u;
+  }
+  return *this;
+}
+
+ScopedMemoryCount::~ScopedMemoryCount() {
+  Update(0u);
+}
+
+void ScopedMemoryCount::Update(size_t bytes) {
+  if (!counter_) {
+    return;
+  }
+  if (bytes > bytes_) {
+    counter_->Increase(bytes - bytes_);
+  } else if (bytes < bytes_) {
+    counter_->Decrease(bytes_ - bytes);
+  }
+  bytes_ = bytes;
+}
+
+size_t ScopedMemoryCount::GetBytes() const {
+  return bytes_;
+}
+
+}  // namespace fml
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_MEMORY_MEMORY_COUNTER_H_
+#define FLUTTER_FML_MEMORY_MEMORY_COUNTER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      Counts the bytes of native memory that one subsystem of the
+///             engine holds, and the most it has held.
+///
+///             There is one counter per name, and it lives for as long as the
+///             process, so allocation sites can keep a reference to it in a
+///             function local static:
+///
+///             ```
+///             static auto& counter = fml::MemoryCounter::Get("host_buffer");
+///             counter.Increase(bytes);
+///             ```
+///
+///             Counters are updated with relaxed atomic operations and may be
+///             updated from any thread.
+///
+class MemoryCounter {
+ public:
+  struct Usage {
+    std::string name;
+    size_t bytes = 0;
+    size_t peak_bytes = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the counter with the given name, creating it the
+  ///             first time it is asked for.
+  ///
+  static MemoryCounter& Get(std::string_view name);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the usage of every counter, sorted by name.
+  ///
+  static std::vector<Usage> GetAllUsage();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Resets the peak of every counter to its current usage.
+  ///
+  static void ResetAllPeaks();
+
+  const std::string& GetName() const;
+
+  void Increase(size_t bytes);
+
+  void Decrease(size_t bytes);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the usage of subsystems whose size is polled rather
+  ///             than tracked at each allocation.
+  ///
+  void Set(size_t bytes);
+
+  size_t GetBytes() const;
+
+  size_t GetPeakBytes() const;
+
+  void ResetPeak();
+
+ private:
+  const std::string name_;
+  std::atomic<size_t> bytes_ = 0u;
+  std::atomic<size_t> peak_bytes_ = 0u;
+
+  explicit MemoryCounter(std::string name);
+
+  ~MemoryCounter();
+
+  void UpdatePeak(size_t bytes);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MemoryCounter);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Counts bytes on a |MemoryCounter| for as long as it lives, for
+///             allocations that are owned by a single object.
+///
+class ScopedMemoryCount {
+ public:
+  ScopedMemoryCount();
+
+  ScopedMemoryCount(MemoryCounter& counter, size_t bytes);
+
+  ScopedMemoryCount(ScopedMemoryCount&& other);
+
+  ScopedMemoryCount& operator=(ScopedMemoryCount&& other);
+
+  ~ScopedMemoryCount();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Changes the counted bytes, for allocations that grow or
+  ///             shrink. Does nothing if there is no counter.
+  ///
+  void Update(size_t bytes);
+
+  size_t GetBytes() const;
+
+ private:
+  MemoryCounter* counter_ = nullptr;
+  size_t bytes_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedMemoryCount);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_MEMORY_MEMORY_COUNTER_H_
@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/memory/memory_counter.h"
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(MemoryCounterTest, CountersAreSharedByName) {
+  auto& counter = MemoryCounter::Get("memory_counter_test.shared");
+  ASSERT_EQ(&counter, &MemoryCounter::Get("memory_counter_test.shared"));
+  ASSERT_EQ(counter.GetName(), "memory_counter_test.shared");
+  ASSERT_NE(&counter, &MemoryCounter::Get("memory_counter_test.other"));
+}
+
+TEST(MemoryCounterTest, TracksBytesAndPeak) {
+  auto& counter = MemoryCounter::Get("memory_counter_test.peak");
+  counter.Increase(100);
+  counter.Increase(50);
+  counter.Decrease(120);
+  EXPECT_EQ(counter.GetBytes(), 30u);
+  EXPECT_EQ(counter.GetPeakBytes(), 150u);
+
+  counter.ResetPeak();
+  EXPECT_EQ(counter.GetPeakBytes(), 30u);
+
+  counter.Set(10);
+  EXPECT_EQ(counter.GetBytes(), 10u);
+  EXPECT_EQ(counter.GetPeakBytes(), 30u);
+  counter.Decrease(10);
+}
+
+TEST(MemoryCounterTest, ScopedCountReleasesBytes) {
+  auto& counter = MemoryCounter::Get("memory_counter_test.scoped");
+  {
+    ScopedMemoryCount count(counter, 64);
+    EXPECT_EQ(counter.GetBytes(), 64u);
+    count.Update(96);
+    EXPECT_EQ(counter.GetBytes(), 96u);
+
+    ScopedMemoryCount moved = std::move(count);
+    EXPECT_EQ(moved.GetBytes(), 96u);
+    EXPECT_EQ(counter.GetBytes(), 96u);
+  }
+  EXPECT_EQ(counter.GetBytes(), 0u);
+  EXPECT_EQ(counter.GetPeakBytes(), 96u);
+}
+
+TEST(MemoryCounterTest, GetAllUsageIncludesEveryCounter) {
+  auto& counter = MemoryCounter::Get("memory_counter_test.all");
+  ScopedMemoryCount count(counter, 8);
+  auto usage = MemoryCounter::GetAllUsage();
+  ASSERT_TRUE(std::is_sorted(
+      usage.begin(), usage.end(),
+      [](const auto& a, const auto& b) { return a.name < b.name; }));
+  auto found = std::find_if(usage.begin(), usage.end(), [](const auto& u) {
+    return u.name == "memory_counter_test.all";
+  });
+  ASSERT_NE(found, usage.end());
+  EXPECT_EQ(found->bytes, 8u);
+  EXPECT_EQ(found->peak_bytes, 8u);
+}
+
+}  // namespace testing
+}  // namespace fml
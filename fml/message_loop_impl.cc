@@ -11,6 +11,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 
 #if FML_OS_MACOSX
 #include "flutter/fml/platform/darwin/message_loop_darwin.h"
@@ -54,14 +55,15 @@ MessageLoopImpl::~MessageLoopImpl() {
 }
 
 void MessageLoopImpl::PostTask(const fml::closure& task,
-                               fml::TimePoint target_time) {
+                               fml::TimePoint target_time,
+                               fml::TaskSourceGrade task_source_grade) {
   FML_DCHECK(task != nullptr);
   if (terminated_) {
     // If the message loop has already been terminated, PostTask should destruct
     // |task| synchronously within this function.
     return;
   }
-  task_queue_->RegisterTask(queue_id_, task, target_time);
+  task_queue_->RegisterTask(queue_id_, task, target_time, task_source_grade);
 }
 
 void MessageLoopImpl::AddTaskObserver(intptr_t key,
@@ -133,6 +135,7 @@ void MessageLoopImpl::FlushTasks(FlushType type) {
       break;
     }
   } while (invocation);
+  fml::tracing::TraceFlushThreadTimelineEvents();
 }
 
 void MessageLoopImpl::RunExpiredTasksNow() {
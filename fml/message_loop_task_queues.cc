@@ -48,7 +48,7 @@ MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queues_mutex_);
   TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
   ++task_queue_id_counter_;
   queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
@@ -56,7 +56,9 @@ TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
 }
 
 MessageLoopTaskQueues::MessageLoopTaskQueues()
-    : task_queue_id_counter_(0), order_(0) {
+    : queues_mutex_(fml::SharedMutex::Create()),
+      task_queue_id_counter_(0),
+      order_(0) {
   tls_task_source_grade.reset(
       new TaskSourceGradeHolder{TaskSourceGrade::kUnspecified});
 }
@@ -64,7 +66,7 @@ MessageLoopTaskQueues::MessageLoopTaskQueues()
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queues_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
@@ -76,7 +78,8 @@ void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queues_mutex_);
+  auto group_lock = LockQueueGroup(queue_id);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
@@ -95,7 +98,8 @@ void MessageLoopTaskQueues::RegisterTask(
     const fml::closure& task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queues_mutex_);
+  auto group_lock = LockQueueGroup(queue_id);
   size_t order = order_++;
   const auto& queue_entry = queue_entries_.at(queue_id);
   queue_entry->task_source->RegisterTask(
@@ -112,17 +116,19 @@ void MessageLoopTaskQueues::RegisterTask(
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queues_mutex_);
+  auto group_lock = LockQueueGroup(queue_id);
   return HasPendingTasksUnlocked(queue_id);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queues_mutex_);
+  auto group_lock = LockQueueGroup(queue_id);
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
   }
-  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id);
+  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id, from_time);
 
   if (!HasPendingTasksUnlocked(queue_id)) {
     WakeUpUnlocked(queue_id, fml::TimePoint::Max());
@@ -130,7 +136,11 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
     WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
   }
 
-  if (top.task.GetTargetTime() > from_time) {
+  const bool is_runnable_idle_task =
+      top.task.GetTaskSourceGrade() == TaskSourceGrade::kIdle &&
+      queue_entries_.at(top.task_queue_id)
+          ->task_source->HasRunnableIdleTask(from_time);
+  if (top.task.GetTargetTime() > from_time && !is_runnable_idle_task) {
     return nullptr;
   }
   fml::closure invocation = top.task.GetTask();
@@ -141,6 +151,23 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
   return invocation;
 }
 
+MessageLoopTaskQueues::QueueGroupLock MessageLoopTaskQueues::LockQueueGroup(
+    TaskQueueId queue_id) const {
+  const auto& entry = queue_entries_.at(queue_id);
+  const TaskQueueId owner =
+      entry->subsumed_by == _kUnmerged ? queue_id : entry->subsumed_by;
+  // Merged queues are always locked in the order of their ids, so threads
+  // locking the same group can't deadlock.
+  std::set<TaskQueueId> group = queue_entries_.at(owner)->owner_of;
+  group.insert(owner);
+  QueueGroupLock group_lock;
+  group_lock.reserve(group.size());
+  for (TaskQueueId id : group) {
+    group_lock.emplace_back(queue_entries_.at(id)->mutex);
+  }
+  return group_lock;
+}
+
 void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
                                            fml::TimePoint time) const {
   if (queue_entries_.at(queue_id)->wakeable) {
@@ -149,7 +176,8 @@ void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queues_mutex_);
+  auto group_lock = LockQueueGroup(queue_id);
   const auto& queue_entry = queue_entries_.at(queue_id);
   if (queue_entry->subsumed_by != _kUnmerged) {
     return 0;
@@ -169,20 +197,25 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queues_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
-  queue_entries_.at(queue_id)->task_observers[key] = callback;
+  queue_entry->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_observers.erase(key);
+  fml::SharedLock lock(*queues_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  queue_entry->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queues_mutex_);
+  auto group_lock = LockQueueGroup(queue_id);
   std::vector<fml::closure> observers;
 
   if (queue_entries_.at(queue_id)->subsumed_by != _kUnmerged) {
@@ -205,17 +238,18 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
-  FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
-      << "Wakeable can only be set once.";
-  queue_entries_.at(queue_id)->wakeable = wakeable;
+  fml::SharedLock lock(*queues_mutex_);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  FML_CHECK(!queue_entry->wakeable) << "Wakeable can only be set once.";
+  queue_entry->wakeable = wakeable;
 }
 
 bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queues_mutex_);
   auto& owner_entry = queue_entries_.at(owner);
   auto& subsumed_entry = queue_entries_.at(subsumed);
   auto& subsumed_set = owner_entry->owner_of;
@@ -263,7 +297,7 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queues_mutex_);
   const auto& owner_entry = queue_entries_.at(owner);
   if (owner_entry->owner_of.empty()) {
     FML_LOG(WARNING)
@@ -307,7 +341,7 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queues_mutex_);
   if (owner == _kUnmerged || subsumed == _kUnmerged) {
     return false;
   }
@@ -317,17 +351,35 @@ bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
 
 std::set<TaskQueueId> MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queues_mutex_);
   return queue_entries_.at(owner)->owner_of;
 }
 
+void MessageLoopTaskQueues::SetIdlePeriodEnd(TaskQueueId queue_id,
+                                             fml::TimePoint end) {
+  fml::SharedLock lock(*queues_mutex_);
+  auto group_lock = LockQueueGroup(queue_id);
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  queue_entry->task_source->SetIdlePeriodEnd(end);
+  TaskQueueId loop_to_wake = queue_id;
+  if (queue_entry->subsumed_by != _kUnmerged) {
+    loop_to_wake = queue_entry->subsumed_by;
+  }
+  // Idle tasks may be able to run earlier than the loop was woken up for.
+  if (HasPendingTasksUnlocked(loop_to_wake)) {
+    WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
+  }
+}
+
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queues_mutex_);
+  auto group_lock = LockQueueGroup(queue_id);
   queue_entries_.at(queue_id)->task_source->PauseSecondary();
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queues_mutex_);
+  auto group_lock = LockQueueGroup(queue_id);
   queue_entries_.at(queue_id)->task_source->ResumeSecondary();
   // Schedule a wake as needed.
   if (HasPendingTasksUnlocked(queue_id)) {
@@ -358,28 +410,51 @@ bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
 
 fml::TimePoint MessageLoopTaskQueues::GetNextWakeTimeUnlocked(
     TaskQueueId queue_id) const {
-  return PeekNextTaskUnlocked(queue_id).task.GetTargetTime();
+  // Idle tasks that can run now don't wait for their target time.
+  const auto now = fml::TimePoint::Now();
+  const auto next_task = PeekNextTaskUnlocked(queue_id, now);
+  if (next_task.task.GetTaskSourceGrade() == TaskSourceGrade::kIdle &&
+      queue_entries_.at(next_task.task_queue_id)
+          ->task_source->HasRunnableIdleTask(now)) {
+    return std::min(now, next_task.task.GetTargetTime());
+  }
+  return PeekNextTaskUnlocked(queue_id, fml::TimePoint::Min())
+      .task.GetTargetTime();
 }
 
 TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
-    TaskQueueId owner) const {
+    TaskQueueId owner,
+    fml::TimePoint now) const {
   FML_DCHECK(HasPendingTasksUnlocked(owner));
   const auto& entry = queue_entries_.at(owner);
   if (entry->owner_of.empty()) {
     FML_CHECK(!entry->task_source->IsEmpty());
-    return entry->task_source->Top();
+    return entry->task_source->Top(now);
+  }
+
+  // Due tasks critical to user interaction run first in any of the merged
+  // queues.
+  bool has_due_priority_task = entry->task_source->HasDuePriorityTask(now);
+  for (TaskQueueId subsumed : entry->owner_of) {
+    has_due_priority_task =
+        has_due_priority_task ||
+        queue_entries_.at(subsumed)->task_source->HasDuePriorityTask(now);
   }
 
   // Use optional for the memory of TopTask object.
   std::optional<TaskSource::TopTask> top_task;
 
   std::function<void(const TaskSource*)> top_task_updater =
-      [&top_task](const TaskSource* source) {
-        if (source && !source->IsEmpty()) {
-          TaskSource::TopTask other_task = source->Top();
-          if (!top_task.has_value() || top_task->task > other_task.task) {
-            top_task.emplace(other_task);
-          }
+      [&top_task, has_due_priority_task, now](const TaskSource* source) {
+        if (!source || source->IsEmpty()) {
+          return;
+        }
+        if (has_due_priority_task && !source->HasDuePriorityTask(now)) {
+          return;
+        }
+        TaskSource::TopTask other_task = source->Top(now);
+        if (!top_task.has_value() || top_task->task > other_task.task) {
+          top_task.emplace(other_task);
         }
       };
 
@@ -393,6 +468,27 @@ TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
   // At least one task at the top because PeekNextTaskUnlocked() is called after
   // HasPendingTasksUnlocked()
   FML_CHECK(top_task.has_value());
+
+  // When no task is due, an idle task can run if one of the merged queues is
+  // in an idle period.
+  if (top_task->task.GetTargetTime() > now) {
+    std::optional<TaskSource::TopTask> idle_task;
+    auto idle_task_updater = [&idle_task, now](const TaskSource* source) {
+      if (source->HasRunnableIdleTask(now)) {
+        TaskSource::TopTask other_task = source->Top(now);
+        if (!idle_task.has_value() || idle_task->task > other_task.task) {
+          idle_task.emplace(other_task);
+        }
+      }
+    };
+    idle_task_updater(owner_tasks);
+    for (TaskQueueId subsumed : entry->owner_of) {
+      idle_task_updater(queue_entries_.at(subsumed)->task_source.get());
+    }
+    if (idle_task.has_value()) {
+      return idle_task.value();
+    }
+  }
   return top_task.value();
 }
 
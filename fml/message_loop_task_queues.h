@@ -46,6 +46,10 @@ class TaskQueueEntry {
 
   TaskQueueId created_for;
 
+  /// Guards the tasks, observers and wakeable of this TaskQueue. The mutexes
+  /// of merged TaskQueues are locked together, in the order of their ids.
+  std::mutex mutex;
+
   explicit TaskQueueEntry(TaskQueueId created_for);
 
  private:
@@ -61,6 +65,12 @@ enum class FlushType {
 /// fml::MessageLoops.
 ///
 /// This also wakes up the loop at the required times.
+///
+/// The set of TaskQueues and how they are merged is guarded by a shared mutex
+/// that is only locked exclusively to create, dispose, merge and unmerge
+/// TaskQueues. Everything else locks it shared and then only the entries of
+/// the TaskQueues involved, so that the threads of unmerged TaskQueues don't
+/// contend with each other when posting and running tasks.
 /// \see fml::MessageLoop
 /// \see fml::Wakeable
 class MessageLoopTaskQueues {
@@ -133,6 +143,11 @@ class MessageLoopTaskQueues {
   // otherwise.
   std::set<TaskQueueId> GetSubsumedTaskQueueId(TaskQueueId owner) const;
 
+  /// Starts an idle period of the queue that lasts until `end`, during which
+  /// its idle tasks can run when no other task is due. An `end` in the past
+  /// ends the current idle period.
+  void SetIdlePeriodEnd(TaskQueueId queue_id, fml::TimePoint end);
+
   void PauseSecondarySource(TaskQueueId queue_id);
 
   void ResumeSecondarySource(TaskQueueId queue_id);
@@ -140,19 +155,31 @@ class MessageLoopTaskQueues {
  private:
   class MergedQueuesRunner;
 
+  using QueueGroupLock = std::vector<std::unique_lock<std::mutex>>;
+
   MessageLoopTaskQueues();
 
   ~MessageLoopTaskQueues();
 
+  /// Locks the entries of the given TaskQueue and of all the TaskQueues that
+  /// are merged with it. The caller must hold `queues_mutex_` at least shared.
+  QueueGroupLock LockQueueGroup(TaskQueueId queue_id) const;
+
+  // The methods below expect the caller to either hold `queues_mutex_`
+  // exclusively, or shared along with the group lock of `queue_id`.
+
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
 
-  TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
+  /// Returns the task that would run next at `now`: the earliest due task
+  /// critical to user interaction if there is one, or else the earliest task.
+  TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner,
+                                           fml::TimePoint now) const;
 
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
+  std::unique_ptr<fml::SharedMutex> queues_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_;
@@ -66,5 +66,64 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Several producer threads post to each of a few queues, like the platform,
+// IO and raster threads all posting to the UI thread, while each queue's own
+// thread drains it.
+static void BM_MultiProducerRegisterAndGetTasks(
+    benchmark::State& state) {  // NOLINT
+  const int num_task_queues = 4;
+  const int num_producers_per_queue = state.range(0);
+  const int num_tasks_per_producer = 100;
+  const int num_tasks_per_queue =
+      num_producers_per_queue * num_tasks_per_producer;
+
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  std::vector<TaskQueueId> queue_ids;
+  for (int i = 0; i < num_task_queues; i++) {
+    queue_ids.push_back(task_queue->CreateTaskQueue());
+  }
+
+  while (state.KeepRunning()) {
+    const fml::TimePoint past = fml::TimePoint::Now();
+    std::vector<std::thread> threads;
+    CountDownLatch start(1);
+
+    for (const auto& queue_id : queue_ids) {
+      for (int i = 0; i < num_producers_per_queue; i++) {
+        threads.emplace_back([queue_id, &task_queue, past, &start]() {
+          start.Wait();
+          for (int j = 0; j < num_tasks_per_producer; j++) {
+            task_queue->RegisterTask(
+                queue_id, [] {}, past);
+          }
+        });
+      }
+      threads.emplace_back([queue_id, &task_queue, &start,
+                            num_tasks_per_queue]() {
+        start.Wait();
+        int num_invocations = 0;
+        while (num_invocations < num_tasks_per_queue) {
+          fml::closure invocation =
+              task_queue->GetNextTaskToRun(queue_id, fml::TimePoint::Now());
+          if (invocation) {
+            num_invocations++;
+          }
+        }
+      });
+    }
+
+    start.CountDown();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (const auto& queue_id : queue_ids) {
+    task_queue->Dispose(queue_id);
+  }
+}
+
+BENCHMARK(BM_MultiProducerRegisterAndGetTasks)->Arg(1)->Arg(2)->Arg(4);
+
 }  // namespace benchmarking
 }  // namespace fml
@@ -451,5 +451,102 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   ASSERT_EQ(time1, wakes[2]);
 }
 
+TEST(MessageLoopTaskQueue, DueUserInteractionTasksRunFirstOnMergedQueues) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto platform_queue = task_queue->CreateTaskQueue();
+  auto raster_queue = task_queue->CreateTaskQueue();
+  ASSERT_TRUE(task_queue->Merge(platform_queue, raster_queue));
+
+  const auto time = ChronoTicksSinceEpoch();
+  std::vector<int> order;
+  task_queue->RegisterTask(
+      platform_queue, [&order]() { order.push_back(1); }, time);
+  task_queue->RegisterTask(
+      platform_queue, [&order]() { order.push_back(2); },
+      time + fml::TimeDelta::FromMilliseconds(1));
+  task_queue->RegisterTask(
+      raster_queue, [&order]() { order.push_back(3); },
+      time + fml::TimeDelta::FromMilliseconds(2),
+      fml::TaskSourceGrade::kUserInteraction);
+
+  const auto now = time + fml::TimeDelta::FromMilliseconds(3);
+  while (auto invocation = task_queue->GetNextTaskToRun(platform_queue, now)) {
+    invocation();
+  }
+  ASSERT_EQ(order, std::vector<int>({3, 1, 2}));
+}
+
+TEST(MessageLoopTaskQueue, IdleTasksRunInIdlePeriodsOrAtTheirDeadline) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  const auto time = ChronoTicksSinceEpoch();
+  const auto deadline = time + fml::TimeDelta::FromMilliseconds(10);
+  std::vector<int> order;
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(1); }, deadline,
+      fml::TaskSourceGrade::kIdle);
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(2); },
+      time + fml::TimeDelta::FromMilliseconds(1));
+
+  // Not idle, and the idle task is not due yet.
+  const auto now = time + fml::TimeDelta::FromMilliseconds(2);
+  while (auto invocation = task_queue->GetNextTaskToRun(queue_id, now)) {
+    invocation();
+  }
+  ASSERT_EQ(order, std::vector<int>({2}));
+
+  // The idle task runs early during an idle period, after the other due
+  // tasks.
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(3); }, now);
+  task_queue->SetIdlePeriodEnd(queue_id,
+                               time + fml::TimeDelta::FromMilliseconds(5));
+  while (auto invocation = task_queue->GetNextTaskToRun(queue_id, now)) {
+    invocation();
+  }
+  ASSERT_EQ(order, std::vector<int>({2, 3, 1}));
+
+  // Outside of idle periods, idle tasks run at their deadline.
+  task_queue->SetIdlePeriodEnd(queue_id, fml::TimePoint::Min());
+  task_queue->RegisterTask(
+      queue_id, [&order]() { order.push_back(4); }, deadline,
+      fml::TaskSourceGrade::kIdle);
+  ASSERT_FALSE(task_queue->GetNextTaskToRun(queue_id, now));
+  auto invocation = task_queue->GetNextTaskToRun(queue_id, deadline);
+  ASSERT_TRUE(invocation);
+  invocation();
+  ASSERT_EQ(order, std::vector<int>({2, 3, 1, 4}));
+}
+
+TEST(MessageLoopTaskQueue, ConcurrentRegisterOnUnmergedQueues) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  const int num_queues = 4;
+  const int num_tasks = 100;
+  std::vector<fml::TaskQueueId> queues;
+  for (int i = 0; i < num_queues; i++) {
+    queues.push_back(task_queue->CreateTaskQueue());
+  }
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_queues * 2; i++) {
+    threads.emplace_back([&task_queue, queue_id = queues[i % num_queues]]() {
+      for (int j = 0; j < num_tasks; j++) {
+        task_queue->RegisterTask(
+            queue_id, [] {}, ChronoTicksSinceEpoch());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& queue_id : queues) {
+    ASSERT_EQ(task_queue->GetNumPendingTasks(queue_id),
+              static_cast<size_t>(num_tasks * 2));
+  }
+}
+
 }  // namespace testing
 }  // namespace fml
@@ -339,3 +339,31 @@ TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   latch.Wait();
   ASSERT_GE(thread_ids.size(), 1u);
 }
+
+TEST(MessageLoop, ConcurrentMessageLoopRunsTasksPostedFromWorkers) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto task_runner = loop->GetTaskRunner("test");
+  const size_t kCount = 10;
+  const size_t kNestedCount = 10;
+  fml::CountDownLatch latch(kCount * kNestedCount);
+  for (size_t i = 0; i < kCount; ++i) {
+    task_runner->PostTask([&]() {
+      ASSERT_TRUE(loop->RunsTasksOnCurrentThread());
+      for (size_t j = 0; j < kNestedCount; ++j) {
+        task_runner->PostTask([&]() { latch.CountDown(); });
+      }
+    });
+  }
+  latch.Wait();
+
+  // The statistics of the last tasks are recorded after they count down the
+  // latch.
+  auto statistics = loop->GetTaskStatistics();
+  while (statistics["test"].task_count < kCount + kCount * kNestedCount) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    statistics = loop->GetTaskStatistics();
+  }
+  ASSERT_EQ(statistics.size(), 1u);
+  ASSERT_EQ(statistics["test"].task_count, kCount + kCount * kNestedCount);
+  ASSERT_GE(statistics["test"].max_wait_time, fml::TimeDelta::Zero());
+}
@@ -50,8 +50,21 @@ Mapping::Mapping() = default;
 
 Mapping::~Mapping() = default;
 
+static bool AdviseWillNeed(const uint8_t* address, size_t size) {
+  if (address == nullptr || size == 0) {
+    return false;
+  }
+  // madvise requires a page aligned address.
+  const uintptr_t page_size = ::sysconf(_SC_PAGESIZE);
+  const uintptr_t start = reinterpret_cast<uintptr_t>(address);
+  const uintptr_t aligned_start = start & ~(page_size - 1);
+  return ::madvise(reinterpret_cast<void*>(aligned_start),
+                   size + (start - aligned_start), MADV_WILLNEED) == 0;
+}
+
 FileMapping::FileMapping(const fml::UniqueFD& handle,
-                         std::initializer_list<Protection> protection) {
+                         std::initializer_list<Protection> protection,
+                         AccessHint access_hint) {
   if (!handle.is_valid()) {
     return;
   }
@@ -69,9 +82,19 @@ FileMapping::FileMapping(const fml::UniqueFD& handle,
 
   const auto is_writable = IsWritable(protection);
 
-  auto* mapping =
-      ::mmap(nullptr, stat_buffer.st_size, ToPosixProtectionFlags(protection),
-             is_writable ? MAP_SHARED : MAP_PRIVATE, handle.get(), 0);
+  int flags = is_writable ? MAP_SHARED : MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+  const bool populate = access_hint == AccessHint::kPopulate;
+  if (populate) {
+    flags |= MAP_POPULATE;
+  }
+#else   // defined(MAP_POPULATE)
+  const bool populate = false;
+#endif  // defined(MAP_POPULATE)
+
+  auto* mapping = ::mmap(nullptr, stat_buffer.st_size,
+                         ToPosixProtectionFlags(protection), flags,
+                         handle.get(), 0);
 
   if (mapping == MAP_FAILED) {
     return;
@@ -83,6 +106,10 @@ FileMapping::FileMapping(const fml::UniqueFD& handle,
   if (is_writable) {
     mutable_mapping_ = mapping_;
   }
+
+  if (access_hint != AccessHint::kNormal && !populate) {
+    AdviseWillNeed(mapping_, size_);
+  }
 }
 
 FileMapping::~FileMapping() {
@@ -107,4 +134,8 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool PrefetchMapping(const Mapping& mapping) {
+  return AdviseWillNeed(mapping.GetMapping(), mapping.GetSize());
+}
+
 }  // namespace fml
@@ -40,8 +40,34 @@ static bool IsExecutable(
   return false;
 }
 
+// PrefetchVirtualMemory is only available starting with Windows 8, so it is
+// resolved at runtime.
+static bool PrefetchVirtualMemoryRange(const uint8_t* address, size_t size) {
+  if (address == nullptr || size == 0) {
+    return false;
+  }
+  struct MemoryRangeEntry {
+    PVOID virtual_address;
+    SIZE_T number_of_bytes;
+  };
+  using PrefetchVirtualMemoryProc =
+      BOOL(WINAPI*)(HANDLE, ULONG_PTR, MemoryRangeEntry*, ULONG);
+  static const auto prefetch_virtual_memory =
+      reinterpret_cast<PrefetchVirtualMemoryProc>(::GetProcAddress(
+          ::GetModuleHandleW(L"kernel32.dll"), "PrefetchVirtualMemory"));
+  if (prefetch_virtual_memory == nullptr) {
+    return false;
+  }
+  MemoryRangeEntry range = {
+      const_cast<uint8_t*>(address),  // virtual_address
+      size,                           // number_of_bytes
+  };
+  return prefetch_virtual_memory(::GetCurrentProcess(), 1, &range, 0) != FALSE;
+}
+
 FileMapping::FileMapping(const fml::UniqueFD& fd,
-                         std::initializer_list<Protection> protections)
+                         std::initializer_list<Protection> protections,
+                         AccessHint access_hint)
     : size_(0), mapping_(nullptr) {
   if (!fd.is_valid()) {
     return;
@@ -99,6 +125,10 @@ FileMapping::FileMapping(const fml::UniqueFD& fd,
   if (IsWritable(protections)) {
     mutable_mapping_ = mapping_;
   }
+
+  if (access_hint != AccessHint::kNormal) {
+    PrefetchVirtualMemoryRange(mapping_, size_);
+  }
 }
 
 FileMapping::~FileMapping() {
@@ -123,4 +153,8 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool PrefetchMapping(const Mapping& mapping) {
+  return PrefetchVirtualMemoryRange(mapping.GetMapping(), mapping.GetSize());
+}
+
 }  // namespace fml
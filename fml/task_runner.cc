@@ -35,6 +35,11 @@ void TaskRunner::PostDelayedTask(const fml::closure& task,
   loop_->PostTask(task, fml::TimePoint::Now() + delay);
 }
 
+void TaskRunner::PostIdleTask(const fml::closure& task,
+                              fml::TimePoint deadline) {
+  loop_->PostTask(task, deadline, fml::TaskSourceGrade::kIdle);
+}
+
 TaskQueueId TaskRunner::GetTaskQueueId() {
   FML_DCHECK(loop_);
   return loop_->GetTaskQueueId();
@@ -49,6 +49,13 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
   /// tens of milliseconds.
   virtual void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay);
 
+  /// Schedules a deferrable \p task to be run on the MessageLoop when it is
+  /// idle, like between the end of a frame and the next vsync, and no other
+  /// task is due. If the loop is not idle before \p deadline, the task runs
+  /// once the deadline has passed, like a task posted for that time.
+  /// \see fml::TaskSourceGrade::kIdle
+  virtual void PostIdleTask(const fml::closure& task, fml::TimePoint deadline);
+
   /// Returns \p true when the current executing thread's TaskRunner matches
   /// this instance.
   virtual bool RunsTasksOnCurrentThread();
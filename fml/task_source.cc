@@ -17,13 +17,15 @@ TaskSource::~TaskSource() {
 
 void TaskSource::ShutDown() {
   primary_task_queue_ = {};
+  priority_task_queue_ = {};
   secondary_task_queue_ = {};
+  idle_task_queue_ = {};
 }
 
 void TaskSource::RegisterTask(const DelayedTask& task) {
   switch (task.GetTaskSourceGrade()) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.push(task);
+      priority_task_queue_.push(task);
       break;
     case TaskSourceGrade::kUnspecified:
       primary_task_queue_.push(task);
@@ -31,13 +33,16 @@ void TaskSource::RegisterTask(const DelayedTask& task) {
     case TaskSourceGrade::kDartMicroTasks:
       secondary_task_queue_.push(task);
       break;
+    case TaskSourceGrade::kIdle:
+      idle_task_queue_.push(task);
+      break;
   }
 }
 
 void TaskSource::PopTask(TaskSourceGrade grade) {
   switch (grade) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.pop();
+      priority_task_queue_.pop();
       break;
     case TaskSourceGrade::kUnspecified:
       primary_task_queue_.pop();
@@ -45,11 +50,15 @@ void TaskSource::PopTask(TaskSourceGrade grade) {
     case TaskSourceGrade::kDartMicroTasks:
       secondary_task_queue_.pop();
       break;
+    case TaskSourceGrade::kIdle:
+      idle_task_queue_.pop();
+      break;
   }
 }
 
 size_t TaskSource::GetNumPendingTasks() const {
-  size_t size = primary_task_queue_.size();
+  size_t size = primary_task_queue_.size() + priority_task_queue_.size() +
+                idle_task_queue_.size();
   if (secondary_pause_requests_ == 0) {
     size += secondary_task_queue_.size();
   }
@@ -62,33 +71,52 @@ bool TaskSource::IsEmpty() const {
 
 TaskSource::TopTask TaskSource::Top() const {
   FML_CHECK(!IsEmpty());
-  if (secondary_pause_requests_ > 0 || secondary_task_queue_.empty()) {
-    const auto& primary_top = primary_task_queue_.top();
+  const DelayedTask* top = nullptr;
+  auto update_top = [&top](const DelayedTaskQueue& queue) {
+    if (!queue.empty() && (top == nullptr || *top > queue.top())) {
+      top = &queue.top();
+    }
+  };
+  update_top(primary_task_queue_);
+  update_top(priority_task_queue_);
+  update_top(idle_task_queue_);
+  if (secondary_pause_requests_ == 0) {
+    update_top(secondary_task_queue_);
+  }
+  return {
+      .task_queue_id = task_queue_id_,
+      .task = *top,
+  };
+}
+
+TaskSource::TopTask TaskSource::Top(fml::TimePoint now) const {
+  if (HasDuePriorityTask(now)) {
     return {
         .task_queue_id = task_queue_id_,
-        .task = primary_top,
+        .task = priority_task_queue_.top(),
     };
-  } else if (primary_task_queue_.empty()) {
-    const auto& secondary_top = secondary_task_queue_.top();
+  }
+  TopTask top = Top();
+  if (top.task.GetTargetTime() > now && HasRunnableIdleTask(now)) {
     return {
         .task_queue_id = task_queue_id_,
-        .task = secondary_top,
+        .task = idle_task_queue_.top(),
     };
-  } else {
-    const auto& primary_top = primary_task_queue_.top();
-    const auto& secondary_top = secondary_task_queue_.top();
-    if (primary_top > secondary_top) {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = secondary_top,
-      };
-    } else {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = primary_top,
-      };
-    }
   }
+  return top;
+}
+
+bool TaskSource::HasDuePriorityTask(fml::TimePoint now) const {
+  return !priority_task_queue_.empty() &&
+         priority_task_queue_.top().GetTargetTime() <= now;
+}
+
+bool TaskSource::HasRunnableIdleTask(fml::TimePoint now) const {
+  return !idle_task_queue_.empty() && now < idle_period_end_;
+}
+
+void TaskSource::SetIdlePeriodEnd(fml::TimePoint end) {
+  idle_period_end_ = end;
 }
 
 void TaskSource::PauseSecondary() {
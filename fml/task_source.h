@@ -18,7 +18,10 @@ class MessageLoopTaskQueues;
  * wrapper around a primary and secondary task heap with the difference between
  * them being that the secondary task heap can be paused and resumed by the task
  * dispatcher. `TaskSourceGrade` determines what task heap the task is assigned
- * to.
+ * to. Tasks critical to user interaction are kept in a separate priority heap
+ * of the primary tasks, so that they can overtake the other tasks that are due.
+ * Idle tasks are kept in their own heap, and run ahead of their target time
+ * during the idle periods of the source when no other task is due.
  *
  * Registering Tasks
  * -----------------
@@ -65,6 +68,22 @@ class TaskSource {
   /// the secondary heap has been paused or not.
   TopTask Top() const;
 
+  /// Returns the top task to run at `now`. This is the earliest task critical
+  /// to user interaction that is due by then if there is one, or `Top()` if
+  /// it is due or no idle task can run, or else the earliest idle task.
+  TopTask Top(fml::TimePoint now) const;
+
+  /// Returns true if a task critical to user interaction is due at `now`.
+  bool HasDuePriorityTask(fml::TimePoint now) const;
+
+  /// Returns true if an idle task can run ahead of its target time at `now`,
+  /// because an idle period is in progress.
+  bool HasRunnableIdleTask(fml::TimePoint now) const;
+
+  /// Starts an idle period that lasts until `end`, replacing any previous
+  /// one. An `end` in the past ends the current idle period.
+  void SetIdlePeriodEnd(fml::TimePoint end);
+
   /// Pause providing tasks from secondary task heap.
   void PauseSecondary();
 
@@ -74,7 +93,10 @@ class TaskSource {
  private:
   const fml::TaskQueueId task_queue_id_;
   fml::DelayedTaskQueue primary_task_queue_;
+  fml::DelayedTaskQueue priority_task_queue_;
   fml::DelayedTaskQueue secondary_task_queue_;
+  fml::DelayedTaskQueue idle_task_queue_;
+  fml::TimePoint idle_period_end_ = fml::TimePoint::Min();
   int secondary_pause_requests_ = 0;
 
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskSource);
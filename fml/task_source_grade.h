@@ -14,11 +14,17 @@ namespace fml {
  */
 enum class TaskSourceGrade {
   /// This `TaskSourceGrade` indicates that a task is critical to user
-  /// interaction.
+  /// interaction, like producing a frame for a vsync. Once due, these tasks
+  /// run ahead of the other due tasks of their queue.
   kUserInteraction,
   /// This `TaskSourceGrade` indicates that a task corresponds to servicing a
   /// dart micro task. These aren't critical to user interaction.
   kDartMicroTasks,
+  /// This `TaskSourceGrade` indicates that a task is deferrable. It runs in
+  /// the idle periods of its queue, like the time between the end of a frame
+  /// and the next vsync, and only runs outside of them once its target time,
+  /// which is its deadline, has passed.
+  kIdle,
   /// The absence of a specialized `TaskSourceGrade`.
   kUnspecified,
 };
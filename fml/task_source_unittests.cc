@@ -97,5 +97,34 @@ TEST(TaskSourceTests, OrderingMultiTaskHeapsSecondaryPaused) {
   ASSERT_EQ(value, 1);
 }
 
+TEST(TaskSourceTests, DueUserInteractionTasksOvertakeOtherTasks) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  int value = 0;
+  task_source.RegisterTask(
+      {1, [&] { value = 1; }, time_stamp, TaskSourceGrade::kUnspecified});
+  task_source.RegisterTask({2, [&] { value = 7; },
+                            time_stamp + fml::TimeDelta::FromMilliseconds(1),
+                            TaskSourceGrade::kUserInteraction});
+
+  // The user interaction task isn't due yet.
+  ASSERT_FALSE(task_source.HasDuePriorityTask(time_stamp));
+  ASSERT_EQ(task_source.Top(time_stamp).task.GetTaskSourceGrade(),
+            TaskSourceGrade::kUnspecified);
+
+  const auto now = time_stamp + fml::TimeDelta::FromMilliseconds(2);
+  ASSERT_TRUE(task_source.HasDuePriorityTask(now));
+  auto top_task = task_source.Top(now);
+  top_task.task.GetTask()();
+  task_source.PopTask(top_task.task.GetTaskSourceGrade());
+  ASSERT_EQ(value, 7);
+
+  auto second_task = task_source.Top(now);
+  second_task.task.GetTask()();
+  task_source.PopTask(second_task.task.GetTaskSourceGrade());
+  ASSERT_EQ(value, 1);
+  ASSERT_TRUE(task_source.IsEmpty());
+}
+
 }  // namespace testing
 }  // namespace fml
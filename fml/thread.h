@@ -8,9 +8,11 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <thread>
 
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 
@@ -42,6 +44,9 @@ class Thread {
 
     std::string name;
     ThreadPriority priority;
+    /// The cores the thread should be kept on, if any. Applied by the
+    /// |ThreadConfigSetter| of platforms with heterogeneous cores.
+    std::optional<CpuAffinity> affinity;
   };
 
   using ThreadConfigSetter = std::function<void(const ThreadConfig&)>;
@@ -5,12 +5,16 @@
 #include "flutter/fml/trace_event.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <cstring>
+#include <mutex>
 #include <utility>
 
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/thread_local.h"
 
 namespace fml {
 namespace tracing {
@@ -26,6 +30,180 @@ int64_t DefaultMicrosSource() {
 AsciiTrie gAllowlist;
 std::atomic<TimelineEventHandler> gTimelineEventHandler;
 std::atomic<TimelineMicrosSource> gTimelineMicrosSource = DefaultMicrosSource;
+std::atomic<bool> gTimelineEventBuffering = true;
+
+// The enabled flags of the trace categories. The flags are never moved or
+// freed, as call sites keep pointers to them.
+class TraceCategoryRegistry {
+ public:
+  static TraceCategoryRegistry& GetInstance() {
+    static TraceCategoryRegistry* registry = new TraceCategoryRegistry();
+    return *registry;
+  }
+
+  const std::atomic<bool>* GetEnabledFlag(const char* category_group) {
+    std::scoped_lock lock(mutex_);
+    auto category = FindOrAdd(category_group);
+    return category ? &category->enabled : &overflow_enabled_;
+  }
+
+  void SetCategoryEnabled(const char* category_group, bool enabled) {
+    std::scoped_lock lock(mutex_);
+    auto category = FindOrAdd(category_group);
+    if (!category) {
+      FML_LOG(ERROR) << "Too many trace categories to disable "
+                     << category_group << ".";
+      return;
+    }
+    category->disabled = !enabled;
+    category->enabled = !category->disabled && HasHandler();
+  }
+
+  void OnTimelineEventHandlerChanged() {
+    std::scoped_lock lock(mutex_);
+    const auto has_handler = HasHandler();
+    for (size_t i = 0; i < category_count_; i++) {
+      categories_[i].enabled = !categories_[i].disabled && has_handler;
+    }
+    overflow_enabled_ = has_handler;
+  }
+
+ private:
+  static constexpr size_t kMaxCategories = 64;
+
+  struct Category {
+    std::string name;
+    bool disabled = false;
+    std::atomic<bool> enabled = false;
+  };
+
+  std::mutex mutex_;
+  std::array<Category, kMaxCategories> categories_;
+  size_t category_count_ = 0;
+  // Shared by the categories past the limit, which can't be disabled.
+  std::atomic<bool> overflow_enabled_ = false;
+
+  TraceCategoryRegistry() = default;
+
+  static bool HasHandler() {
+    return gTimelineEventHandler.load(std::memory_order_relaxed) != nullptr;
+  }
+
+  Category* FindOrAdd(const char* category_group) {
+    for (size_t i = 0; i < category_count_; i++) {
+      if (categories_[i].name == category_group) {
+        return &categories_[i];
+      }
+    }
+    if (category_count_ == kMaxCategories) {
+      return nullptr;
+    }
+    auto& category = categories_[category_count_++];
+    category.name = category_group;
+    category.enabled = HasHandler();
+    return &category;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TraceCategoryRegistry);
+};
+
+// The timeline events recorded by a thread that have not been handed to the
+// timeline event handler yet. Only its thread uses the buffer, so recording
+// an event takes no locks and never allocates.
+class TimelineEventBuffer {
+ public:
+  TimelineEventBuffer() = default;
+
+  ~TimelineEventBuffer() { Flush(); }
+
+  // Returns false if the event does not fit in a buffered event, in which
+  // case it must be handed to the handler directly after a flush.
+  bool Add(const char* label,
+           int64_t timestamp0,
+           int64_t timestamp1_or_async_id,
+           Dart_Timeline_Event_Type type,
+           intptr_t argument_count,
+           const char** argument_names,
+           const char** argument_values) {
+    if (argument_count > static_cast<intptr_t>(kMaxArguments)) {
+      return false;
+    }
+    for (intptr_t i = 0; i < argument_count; i++) {
+      if (::strlen(argument_values[i]) >= kMaxArgumentLength) {
+        return false;
+      }
+    }
+
+    auto& event = events_[event_count_++];
+    event.label = label;
+    event.timestamp0 = timestamp0;
+    event.timestamp1_or_async_id = timestamp1_or_async_id;
+    event.type = type;
+    event.argument_count = argument_count;
+    for (intptr_t i = 0; i < argument_count; i++) {
+      event.argument_names[i] = argument_names[i];
+      ::strncpy(event.argument_values[i], argument_values[i],
+                kMaxArgumentLength);
+      event.argument_value_pointers[i] = event.argument_values[i];
+    }
+
+    if (type == Dart_Timeline_Event_Begin) {
+      duration_depth_++;
+    } else if (type == Dart_Timeline_Event_End && duration_depth_ > 0) {
+      duration_depth_--;
+    }
+    if (duration_depth_ == 0 || event_count_ == kCapacity) {
+      Flush();
+    }
+    return true;
+  }
+
+  void Flush() {
+    // Events recorded while no handler is installed are dropped, just like
+    // the ones that are not buffered.
+    TimelineEventHandler handler =
+        gTimelineEventHandler.load(std::memory_order_relaxed);
+    for (size_t i = 0; handler && i < event_count_; i++) {
+      auto& event = events_[i];
+      handler(event.label, event.timestamp0, event.timestamp1_or_async_id,
+              event.type, event.argument_count, event.argument_names,
+              event.argument_value_pointers);
+    }
+    event_count_ = 0;
+  }
+
+ private:
+  static constexpr size_t kCapacity = 128;
+  static constexpr size_t kMaxArguments = 2;
+  static constexpr size_t kMaxArgumentLength = 32;
+
+  struct Event {
+    const char* label;
+    int64_t timestamp0;
+    int64_t timestamp1_or_async_id;
+    Dart_Timeline_Event_Type type;
+    intptr_t argument_count;
+    const char* argument_names[kMaxArguments];
+    const char* argument_value_pointers[kMaxArguments];
+    char argument_values[kMaxArguments][kMaxArgumentLength];
+  };
+
+  std::array<Event, kCapacity> events_;
+  size_t event_count_ = 0;
+  size_t duration_depth_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TimelineEventBuffer);
+};
+
+FML_THREAD_LOCAL ThreadLocalUniquePtr<TimelineEventBuffer>
+    tls_timeline_event_buffer;
+
+TimelineEventBuffer& GetThreadTimelineEventBuffer() {
+  if (!tls_timeline_event_buffer.get()) {
+    tls_timeline_event_buffer.reset(new TimelineEventBuffer());
+  }
+  return *tls_timeline_event_buffer.get();
+}
 
 inline void FlutterTimelineEvent(const char* label,
                                  int64_t timestamp0,
@@ -36,10 +214,22 @@ inline void FlutterTimelineEvent(const char* label,
                                  const char** argument_values) {
   TimelineEventHandler handler =
       gTimelineEventHandler.load(std::memory_order_relaxed);
-  if (handler && gAllowlist.Query(label)) {
-    handler(label, timestamp0, timestamp1_or_async_id, type, argument_count,
-            argument_names, argument_values);
+  if (!handler || !gAllowlist.Query(label)) {
+    return;
   }
+  // Events without a timestamp are timestamped by the handler, so they can't
+  // be handed to it later.
+  if (timestamp0 >= 0 &&
+      gTimelineEventBuffering.load(std::memory_order_relaxed)) {
+    auto& buffer = GetThreadTimelineEventBuffer();
+    if (buffer.Add(label, timestamp0, timestamp1_or_async_id, type,
+                   argument_count, argument_names, argument_values)) {
+      return;
+    }
+    buffer.Flush();
+  }
+  handler(label, timestamp0, timestamp1_or_async_id, type, argument_count,
+          argument_names, argument_values);
 }
 }  // namespace
 
@@ -47,8 +237,31 @@ void TraceSetAllowlist(const std::vector<std::string>& allowlist) {
   gAllowlist.Fill(allowlist);
 }
 
+const std::atomic<bool>* TraceGetCategoryEnabledFlag(TraceArg category_group) {
+  return TraceCategoryRegistry::GetInstance().GetEnabledFlag(category_group);
+}
+
+void TraceSetCategoryEnabled(TraceArg category_group, bool enabled) {
+  TraceCategoryRegistry::GetInstance().SetCategoryEnabled(category_group,
+                                                          enabled);
+}
+
+void TraceSetTimelineEventBuffering(bool enabled) {
+  gTimelineEventBuffering = enabled;
+  if (!enabled) {
+    TraceFlushThreadTimelineEvents();
+  }
+}
+
+void TraceFlushThreadTimelineEvents() {
+  if (auto buffer = tls_timeline_event_buffer.get()) {
+    buffer->Flush();
+  }
+}
+
 void TraceSetTimelineEventHandler(TimelineEventHandler handler) {
   gTimelineEventHandler = handler;
+  TraceCategoryRegistry::GetInstance().OnTimelineEventHandlerChanged();
 }
 
 bool TraceHasTimelineEventHandler() {
@@ -96,6 +309,36 @@ void TraceTimelineEvent(TraceArg category_group,
   );
 }
 
+void TraceTimelineEvent(TraceArg category_group,
+                        TraceArg name,
+                        int64_t timestamp_micros,
+                        TraceIDArg identifier,
+                        Dart_Timeline_Event_Type type,
+                        size_t argument_count,
+                        const char** names,
+                        const std::string* values) {
+  std::array<const char*, 8> c_values;
+  if (argument_count > c_values.size()) {
+    TraceTimelineEvent(
+        category_group, name, timestamp_micros, identifier, type,
+        std::vector<const char*>(names, names + argument_count),
+        std::vector<std::string>(values, values + argument_count));
+    return;
+  }
+  for (size_t i = 0; i < argument_count; i++) {
+    c_values[i] = values[i].c_str();
+  }
+
+  FlutterTimelineEvent(name,              // label
+                       timestamp_micros,  // timestamp0
+                       identifier,        // timestamp1_or_async_id
+                       type,              // event type
+                       argument_count,    // argument_count
+                       names,             // argument_names
+                       c_values.data()    // argument_values
+  );
+}
+
 void TraceTimelineEvent(TraceArg category_group,
                         TraceArg name,
                         TraceIDArg identifier,
@@ -314,6 +557,17 @@ void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id) {
 
 void TraceSetAllowlist(const std::vector<std::string>& allowlist) {}
 
+const std::atomic<bool>* TraceGetCategoryEnabledFlag(TraceArg category_group) {
+  static std::atomic<bool> disabled = false;
+  return &disabled;
+}
+
+void TraceSetCategoryEnabled(TraceArg category_group, bool enabled) {}
+
+void TraceSetTimelineEventBuffering(bool enabled) {}
+
+void TraceFlushThreadTimelineEvents() {}
+
 void TraceSetTimelineEventHandler(TimelineEventHandler handler) {}
 
 bool TraceHasTimelineEventHandler() {
@@ -338,6 +592,15 @@ void TraceTimelineEvent(TraceArg category_group,
                         const std::vector<const char*>& c_names,
                         const std::vector<std::string>& values) {}
 
+void TraceTimelineEvent(TraceArg category_group,
+                        TraceArg name,
+                        int64_t timestamp_micros,
+                        TraceIDArg identifier,
+                        Dart_Timeline_Event_Type type,
+                        size_t argument_count,
+                        const char** names,
+                        const std::string* values) {}
+
 void TraceTimelineEvent(TraceArg category_group,
                         TraceArg name,
                         TraceIDArg identifier,
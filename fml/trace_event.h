@@ -37,6 +37,8 @@
 
 #endif  //  defined(OS_FUCHSIA)
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -58,17 +60,45 @@
 
 #define __FML__TOKEN_CAT__(x, y) x##y
 #define __FML__TOKEN_CAT__2(x, y) __FML__TOKEN_CAT__(x, y)
-#define __FML__AUTO_TRACE_END(name)                                  \
+
+// Whether events in the category are recorded. The flag of the category is
+// looked up once per call site, so this is a single relaxed atomic load. The
+// category must be a string literal or another constant.
+#define __FML__TRACE_CATEGORY_ENABLED(category_group)                 \
+  ([]() {                                                             \
+    static const std::atomic<bool>* __trace_category_enabled =        \
+        ::fml::tracing::TraceGetCategoryEnabledFlag(category_group);  \
+    return __trace_category_enabled->load(std::memory_order_relaxed); \
+  }())
+
+// Only evaluates the statement, and so its arguments, if the category is
+// enabled.
+#define __FML__TRACE_IF_ENABLED(category_group, ...)   \
+  if (__FML__TRACE_CATEGORY_ENABLED(category_group)) { \
+    __VA_ARGS__;                                       \
+  }
+
+// Records the begin event of a duration if the category is enabled, and the
+// matching end event when the enclosing scope is left.
+#define __FML__TRACE_DURATION(category_group, name, ...)             \
+  const bool __FML__TOKEN_CAT__2(__trace_enabled_, __LINE__) =       \
+      __FML__TRACE_CATEGORY_ENABLED(category_group);                 \
+  if (__FML__TOKEN_CAT__2(__trace_enabled_, __LINE__)) {             \
+    __VA_ARGS__;                                                     \
+  }                                                                  \
   ::fml::tracing::ScopedInstantEnd __FML__TOKEN_CAT__2(__trace_end_, \
-                                                       __LINE__)(name);
+                                                       __LINE__)(    \
+      name, __FML__TOKEN_CAT__2(__trace_enabled_, __LINE__));
 
 // This macro has the FML_ prefix so that it does not collide with the macros
 // from lib/trace/event.h on Fuchsia.
 //
 // TODO(chinmaygarde): All macros here should have the FML prefix.
-#define FML_TRACE_COUNTER(category_group, name, counter_id, arg1, ...)         \
-  ::fml::tracing::TraceCounter((category_group), (name), (counter_id), (arg1), \
-                               __VA_ARGS__);
+#define FML_TRACE_COUNTER(category_group, name, counter_id, arg1, ...)     \
+  __FML__TRACE_IF_ENABLED(                                                 \
+      category_group,                                                      \
+      ::fml::tracing::TraceCounter((category_group), (name), (counter_id), \
+                                   (arg1), __VA_ARGS__))
 
 // Avoid using the same `name` and `argX_name` for nested traces, which can
 // lead to double free errors. E.g. the following code should be avoided:
@@ -83,58 +113,80 @@
 // ```
 //
 // Instead, either use different `name` or `arg1` parameter names.
-#define FML_TRACE_EVENT(category_group, name, ...)                   \
-  ::fml::tracing::TraceEvent((category_group), (name), __VA_ARGS__); \
-  __FML__AUTO_TRACE_END(name)
+#define FML_TRACE_EVENT(category_group, name, ...) \
+  __FML__TRACE_DURATION(                           \
+      category_group, name,                        \
+      ::fml::tracing::TraceEvent((category_group), (name), __VA_ARGS__))
 
-#define TRACE_EVENT0(category_group, name)           \
-  ::fml::tracing::TraceEvent0(category_group, name); \
-  __FML__AUTO_TRACE_END(name)
+#define TRACE_EVENT0(category_group, name)    \
+  __FML__TRACE_DURATION(category_group, name, \
+                        ::fml::tracing::TraceEvent0(category_group, name))
 
-#define TRACE_EVENT1(category_group, name, arg1_name, arg1_val)           \
-  ::fml::tracing::TraceEvent1(category_group, name, arg1_name, arg1_val); \
-  __FML__AUTO_TRACE_END(name)
+#define TRACE_EVENT1(category_group, name, arg1_name, arg1_val)    \
+  __FML__TRACE_DURATION(                                           \
+      category_group, name,                                        \
+      ::fml::tracing::TraceEvent1(category_group, name, arg1_name, \
+                                  arg1_val))
 
 #define TRACE_EVENT2(category_group, name, arg1_name, arg1_val, arg2_name, \
                      arg2_val)                                             \
-  ::fml::tracing::TraceEvent2(category_group, name, arg1_name, arg1_val,   \
-                              arg2_name, arg2_val);                        \
-  __FML__AUTO_TRACE_END(name)
+  __FML__TRACE_DURATION(                                                   \
+      category_group, name,                                                \
+      ::fml::tracing::TraceEvent2(category_group, name, arg1_name,         \
+                                  arg1_val, arg2_name, arg2_val))
 
 #define TRACE_EVENT_ASYNC_BEGIN0(category_group, name, id) \
-  ::fml::tracing::TraceEventAsyncBegin0(category_group, name, id);
+  __FML__TRACE_IF_ENABLED(                                 \
+      category_group,                                      \
+      ::fml::tracing::TraceEventAsyncBegin0(category_group, name, id))
 
 #define TRACE_EVENT_ASYNC_END0(category_group, name, id) \
-  ::fml::tracing::TraceEventAsyncEnd0(category_group, name, id);
+  __FML__TRACE_IF_ENABLED(                               \
+      category_group,                                    \
+      ::fml::tracing::TraceEventAsyncEnd0(category_group, name, id))
 
-#define TRACE_EVENT_ASYNC_BEGIN1(category_group, name, id, arg1_name,        \
-                                 arg1_val)                                   \
-  ::fml::tracing::TraceEventAsyncBegin1(category_group, name, id, arg1_name, \
-                                        arg1_val);
+#define TRACE_EVENT_ASYNC_BEGIN1(category_group, name, id, arg1_name, \
+                                 arg1_val)                            \
+  __FML__TRACE_IF_ENABLED(                                            \
+      category_group,                                                 \
+      ::fml::tracing::TraceEventAsyncBegin1(category_group, name, id, \
+                                            arg1_name, arg1_val))
 
 #define TRACE_EVENT_ASYNC_END1(category_group, name, id, arg1_name, arg1_val) \
-  ::fml::tracing::TraceEventAsyncEnd1(category_group, name, id, arg1_name,    \
-                                      arg1_val);
+  __FML__TRACE_IF_ENABLED(                                                    \
+      category_group,                                                         \
+      ::fml::tracing::TraceEventAsyncEnd1(category_group, name, id,           \
+                                          arg1_name, arg1_val))
 
 #define TRACE_EVENT_INSTANT0(category_group, name) \
-  ::fml::tracing::TraceEventInstant0(category_group, name);
-
-#define TRACE_EVENT_INSTANT1(category_group, name, arg1_name, arg1_val) \
-  ::fml::tracing::TraceEventInstant1(category_group, name, arg1_name, arg1_val);
-
-#define TRACE_EVENT_INSTANT2(category_group, name, arg1_name, arg1_val, \
-                             arg2_name, arg2_val)                       \
-  ::fml::tracing::TraceEventInstant2(category_group, name, arg1_name,   \
-                                     arg1_val, arg2_name, arg2_val);
+  __FML__TRACE_IF_ENABLED(                         \
+      category_group,                              \
+      ::fml::tracing::TraceEventInstant0(category_group, name))
+
+#define TRACE_EVENT_INSTANT1(category_group, name, arg1_name, arg1_val)   \
+  __FML__TRACE_IF_ENABLED(                                                \
+      category_group,                                                     \
+      ::fml::tracing::TraceEventInstant1(category_group, name, arg1_name, \
+                                         arg1_val))
+
+#define TRACE_EVENT_INSTANT2(category_group, name, arg1_name, arg1_val,   \
+                             arg2_name, arg2_val)                         \
+  __FML__TRACE_IF_ENABLED(                                                \
+      category_group,                                                     \
+      ::fml::tracing::TraceEventInstant2(category_group, name, arg1_name, \
+                                         arg1_val, arg2_name, arg2_val))
 
 #define TRACE_FLOW_BEGIN(category, name, id) \
-  ::fml::tracing::TraceEventFlowBegin0(category, name, id);
+  __FML__TRACE_IF_ENABLED(                   \
+      category, ::fml::tracing::TraceEventFlowBegin0(category, name, id))
 
 #define TRACE_FLOW_STEP(category, name, id) \
-  ::fml::tracing::TraceEventFlowStep0(category, name, id);
+  __FML__TRACE_IF_ENABLED(                  \
+      category, ::fml::tracing::TraceEventFlowStep0(category, name, id))
 
 #define TRACE_FLOW_END(category, name, id) \
-  ::fml::tracing::TraceEventFlowEnd0(category, name, id);
+  __FML__TRACE_IF_ENABLED(                 \
+      category, ::fml::tracing::TraceEventFlowEnd0(category, name, id))
 
 #endif  // TRACE_EVENT_HIDE_MACROS
 #endif  // !defined(OS_FUCHSIA)
@@ -154,6 +206,28 @@ using TraceIDArg = int64_t;
 
 void TraceSetAllowlist(const std::vector<std::string>& allowlist);
 
+/// Returns the flag that tells whether the events in the category are
+/// recorded, which is set while a timeline event handler is installed and the
+/// category has not been disabled. The flag lives as long as the process, so
+/// it can be looked up once and checked with a single atomic load.
+const std::atomic<bool>* TraceGetCategoryEnabledFlag(TraceArg category_group);
+
+/// Enables or disables the recording of the events in the category by the
+/// trace macros. All categories are enabled by default.
+void TraceSetCategoryEnabled(TraceArg category_group, bool enabled);
+
+/// Sets whether timeline events are collected in a buffer of the thread that
+/// records them, and are handed to the timeline event handler in batches.
+/// Buffered events are flushed when the outermost duration of the thread
+/// ends, when the buffer is full, after each task run by a message loop and
+/// when the thread exits. Events without a timestamp are never buffered, as
+/// the handler timestamps them itself. Enabled by default.
+void TraceSetTimelineEventBuffering(bool enabled);
+
+/// Hands the timeline events buffered by the calling thread to the timeline
+/// event handler.
+void TraceFlushThreadTimelineEvents();
+
 typedef void (*TimelineEventHandler)(const char*,
                                      int64_t,
                                      int64_t,
@@ -187,6 +261,15 @@ void TraceTimelineEvent(TraceArg category_group,
                         const std::vector<const char*>& names,
                         const std::vector<std::string>& values);
 
+void TraceTimelineEvent(TraceArg category_group,
+                        TraceArg name,
+                        int64_t timestamp_micros,
+                        TraceIDArg id,
+                        Dart_Timeline_Event_Type type,
+                        size_t argument_count,
+                        const char** names,
+                        const std::string* values);
+
 inline std::string TraceToString(const char* string) {
   return std::string{string};
 }
@@ -232,6 +315,38 @@ SplitArguments(Key key, Value value, Args... args) {
   return std::make_pair(std::move(keys), std::move(values));
 }
 
+inline void SplitArgumentsInto(const char** keys, std::string* values) {}
+
+template <typename Key, typename Value, typename... Args>
+void SplitArgumentsInto(const char** keys,
+                        std::string* values,
+                        Key key,
+                        Value value,
+                        Args... args) {
+  *keys = key;
+  *values = TraceToString(value);
+  SplitArgumentsInto(keys + 1, values + 1, args...);
+}
+
+/// Records an event with the given key-value pairs of arguments, which are
+/// collected on the stack instead of in vectors.
+template <typename... Args>
+void TraceTimelineEventWithArguments(TraceArg category_group,
+                                     TraceArg name,
+                                     int64_t timestamp_micros,
+                                     TraceIDArg id,
+                                     Dart_Timeline_Event_Type type,
+                                     Args... args) {
+  static_assert(sizeof...(Args) % 2 == 0,
+                "Arguments must be given as key-value pairs.");
+  constexpr size_t kArgumentCount = sizeof...(Args) / 2;
+  std::array<const char*, kArgumentCount> keys;
+  std::array<std::string, kArgumentCount> values;
+  SplitArgumentsInto(keys.data(), values.data(), args...);
+  TraceTimelineEvent(category_group, name, timestamp_micros, id, type,
+                     kArgumentCount, keys.data(), values.data());
+}
+
 size_t TraceNonce();
 
 template <typename... Args>
@@ -240,9 +355,12 @@ void TraceCounter(TraceArg category,
                   TraceIDArg identifier,
                   Args... args) {
 #if FLUTTER_TIMELINE_ENABLED
-  auto split = SplitArguments(args...);
-  TraceTimelineEvent(category, name, identifier, Dart_Timeline_Event_Counter,
-                     split.first, split.second);
+  if (!TraceHasTimelineEventHandler()) {
+    return;
+  }
+  TraceTimelineEventWithArguments(category, name, TraceGetTimelineMicros(),
+                                  identifier, Dart_Timeline_Event_Counter,
+                                  args...);
 #endif  // FLUTTER_TIMELINE_ENABLED
 }
 
@@ -257,9 +375,11 @@ void TraceCounterNopHACK(TraceArg category,
 template <typename... Args>
 void TraceEvent(TraceArg category, TraceArg name, Args... args) {
 #if FLUTTER_TIMELINE_ENABLED
-  auto split = SplitArguments(args...);
-  TraceTimelineEvent(category, name, 0, Dart_Timeline_Event_Begin, split.first,
-                     split.second);
+  if (!TraceHasTimelineEventHandler()) {
+    return;
+  }
+  TraceTimelineEventWithArguments(category, name, TraceGetTimelineMicros(), 0,
+                                  Dart_Timeline_Event_Begin, args...);
 #endif  // FLUTTER_TIMELINE_ENABLED
 }
 
@@ -286,8 +406,10 @@ void TraceEventAsyncComplete(TraceArg category_group,
                              TimePoint end,
                              Args... args) {
 #if FLUTTER_TIMELINE_ENABLED
+  if (!TraceHasTimelineEventHandler()) {
+    return;
+  }
   auto identifier = TraceNonce();
-  const auto split = SplitArguments(args...);
 
   if (begin > end) {
     std::swap(begin, end);
@@ -296,23 +418,11 @@ void TraceEventAsyncComplete(TraceArg category_group,
   const int64_t begin_micros = begin.ToEpochDelta().ToMicroseconds();
   const int64_t end_micros = end.ToEpochDelta().ToMicroseconds();
 
-  TraceTimelineEvent(category_group,                   // group
-                     name,                             // name
-                     begin_micros,                     // timestamp_micros
-                     identifier,                       // identifier
-                     Dart_Timeline_Event_Async_Begin,  // type
-                     split.first,                      // names
-                     split.second                      // values
-  );
-
-  TraceTimelineEvent(category_group,                 // group
-                     name,                           // name
-                     end_micros,                     // timestamp_micros
-                     identifier,                     // identifier
-                     Dart_Timeline_Event_Async_End,  // type
-                     split.first,                    // names
-                     split.second                    // values
-  );
+  TraceTimelineEventWithArguments(category_group, name, begin_micros,
+                                  identifier, Dart_Timeline_Event_Async_Begin,
+                                  args...);
+  TraceTimelineEventWithArguments(category_group, name, end_micros, identifier,
+                                  Dart_Timeline_Event_Async_End, args...);
 #endif  // FLUTTER_TIMELINE_ENABLED
 }
 
@@ -358,12 +468,18 @@ void TraceEventFlowEnd0(TraceArg category_group, TraceArg name, TraceIDArg id);
 
 class ScopedInstantEnd {
  public:
-  explicit ScopedInstantEnd(const char* str) : label_(str) {}
+  explicit ScopedInstantEnd(const char* str, bool enabled = true)
+      : label_(str), enabled_(enabled) {}
 
-  ~ScopedInstantEnd() { TraceEventEnd(label_); }
+  ~ScopedInstantEnd() {
+    if (enabled_) {
+      TraceEventEnd(label_);
+    }
+  }
 
  private:
   const char* label_;
+  const bool enabled_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ScopedInstantEnd);
 };
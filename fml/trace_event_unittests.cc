@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_event.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#if FLUTTER_TIMELINE_ENABLED && !defined(OS_FUCHSIA)
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+namespace {
+
+std::vector<std::string> gRecordedEvents;
+
+void RecordTimelineEvent(const char* label,
+                         int64_t timestamp0,
+                         int64_t timestamp1_or_async_id,
+                         Dart_Timeline_Event_Type type,
+                         intptr_t argument_count,
+                         const char** argument_names,
+                         const char** argument_values) {
+  std::string event = label;
+  for (intptr_t i = 0; i < argument_count; i++) {
+    event += std::string{" "} + argument_names[i] + "=" + argument_values[i];
+  }
+  gRecordedEvents.push_back(event);
+}
+
+int64_t FixedMicrosSource() {
+  return 1;
+}
+
+int64_t NoMicrosSource() {
+  return -1;
+}
+
+class TraceEventTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    gRecordedEvents.clear();
+    TraceSetTimelineMicrosSource(FixedMicrosSource);
+    TraceSetTimelineEventHandler(RecordTimelineEvent);
+  }
+
+  void TearDown() override {
+    TraceSetTimelineEventHandler(nullptr);
+    TraceSetTimelineMicrosSource(NoMicrosSource);
+    TraceSetCategoryEnabled("test", true);
+  }
+};
+
+}  // namespace
+
+TEST_F(TraceEventTest, CategoryFlagFollowsHandlerAndCategory) {
+  const auto* flag = TraceGetCategoryEnabledFlag("test");
+  ASSERT_EQ(flag, TraceGetCategoryEnabledFlag("test"));
+  EXPECT_TRUE(flag->load());
+
+  TraceSetCategoryEnabled("test", false);
+  EXPECT_FALSE(flag->load());
+  TRACE_EVENT_INSTANT0("test", "Disabled");
+
+  TraceSetCategoryEnabled("test", true);
+  EXPECT_TRUE(flag->load());
+  TRACE_EVENT_INSTANT0("test", "Enabled");
+
+  TraceSetTimelineEventHandler(nullptr);
+  EXPECT_FALSE(flag->load());
+
+  EXPECT_EQ(gRecordedEvents, std::vector<std::string>{"Enabled"});
+}
+
+TEST_F(TraceEventTest, DisabledCategoryDoesNotEvaluateArguments) {
+  TraceSetCategoryEnabled("test", false);
+  int evaluations = 0;
+  auto argument = [&evaluations]() {
+    evaluations++;
+    return 1;
+  };
+  FML_TRACE_COUNTER("test", "Counter", 0, "value", argument());
+  { FML_TRACE_EVENT("test", "Event", "value", argument()); }
+  EXPECT_EQ(evaluations, 0);
+  EXPECT_TRUE(gRecordedEvents.empty());
+}
+
+TEST_F(TraceEventTest, EventsAreBufferedUntilOutermostDurationEnds) {
+  {
+    TRACE_EVENT0("test", "Outer");
+    {
+      TRACE_EVENT1("test", "Inner", "key", "value");
+      FML_TRACE_COUNTER("test", "Counter", 0, "count", 3);
+    }
+    EXPECT_TRUE(gRecordedEvents.empty());
+  }
+  EXPECT_EQ(gRecordedEvents, (std::vector<std::string>{
+                                 "Outer",
+                                 "Inner key=value",
+                                 "Counter count=3",
+                                 "Inner",
+                                 "Outer",
+                             }));
+}
+
+TEST_F(TraceEventTest, BufferedEventsCanBeFlushed) {
+  TraceEvent0("test", "Outer");
+  TRACE_EVENT_INSTANT0("test", "Instant");
+  EXPECT_TRUE(gRecordedEvents.empty());
+
+  TraceFlushThreadTimelineEvents();
+  EXPECT_EQ(gRecordedEvents,
+            (std::vector<std::string>{"Outer", "Instant"}));
+
+  TraceEventEnd("Outer");
+  EXPECT_EQ(gRecordedEvents.size(), 3u);
+}
+
+TEST_F(TraceEventTest, EventsAreNotBufferedWhenDisabled) {
+  TraceSetTimelineEventBuffering(false);
+  {
+    TRACE_EVENT0("test", "Outer");
+    EXPECT_EQ(gRecordedEvents, std::vector<std::string>{"Outer"});
+  }
+  TraceSetTimelineEventBuffering(true);
+}
+
+TEST_F(TraceEventTest, EventsWithoutTimestampsAreNotBuffered) {
+  TraceSetTimelineMicrosSource(NoMicrosSource);
+  {
+    TRACE_EVENT0("test", "Outer");
+    EXPECT_EQ(gRecordedEvents, std::vector<std::string>{"Outer"});
+  }
+}
+
+TEST_F(TraceEventTest, LongArgumentsKeepEventOrder) {
+  const std::string long_value(100, 'a');
+  {
+    TRACE_EVENT0("test", "Outer");
+    TRACE_EVENT_INSTANT1("test", "Long", "key", long_value.c_str());
+    EXPECT_EQ(gRecordedEvents,
+              (std::vector<std::string>{"Outer", "Long key=" + long_value}));
+  }
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_TIMELINE_ENABLED && !defined(OS_FUCHSIA)
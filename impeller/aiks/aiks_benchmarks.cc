@@ -0,0 +1,358 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/testing/testing.h"
+#include "impeller/aiks/aiks_context.h"
+#include "impeller/aiks/canvas.h"
+#include "impeller/aiks/image.h"
+#include "impeller/entity/contents/linear_gradient_contents.h"
+#include "impeller/geometry/path_builder.h"
+#include "impeller/playground/playground.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/gpu_tracer.h"
+#include "impeller/renderer/render_target.h"
+#include "impeller/typographer/backends/skia/text_frame_skia.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace impeller {
+
+namespace {
+
+constexpr ISize kFrameSize = {1024, 768};
+
+// A playground that only sets up a context, scenes are rendered offscreen.
+class BenchmarkPlayground : public Playground {
+ public:
+  BenchmarkPlayground() : Playground(PlaygroundSwitches{}) {}
+
+  // |Playground|
+  std::unique_ptr<fml::Mapping> OpenAssetAsMapping(
+      std::string asset_name) const override {
+    return flutter::testing::OpenFixtureAsMapping(asset_name);
+  }
+
+  // |Playground|
+  std::string GetWindowTitle() const override {
+    return "Impeller Benchmarks";
+  }
+};
+
+// Records one frame of a scene. Scenes are recorded anew every frame, like
+// the layer tree of an app would be.
+using SceneCallback = std::function<void(Canvas&)>;
+
+// Loads the resources of a scene, or returns an empty callback if they can't
+// be loaded.
+using SceneFactory = SceneCallback (*)(const Playground& playground);
+
+SceneCallback CreateTextPageScene(const Playground& playground) {
+  auto data = flutter::testing::OpenFixtureAsSkData("Roboto-Regular.ttf");
+  if (!data) {
+    return nullptr;
+  }
+  SkFont font(SkTypeface::MakeFromData(data), 14);
+  std::vector<TextFrame> lines;
+  for (size_t i = 0; i < 48; i++) {
+    auto blob = SkTextBlob::MakeFromString(
+        "The quick brown fox jumps over the lazy dog, again and again and "
+        "again until the end of the line.",
+        font);
+    if (!blob) {
+      return nullptr;
+    }
+    lines.push_back(TextFrameFromTextBlob(blob));
+  }
+  return [lines = std::move(lines)](Canvas& canvas) {
+    canvas.DrawPaint({.color = Color::White()});
+    for (size_t i = 0; i < lines.size(); i++) {
+      canvas.DrawTextFrame(lines[i], {10, 16.0f * (i + 1)},
+                           {.color = i % 8 == 0 ? Color::Blue()
+                                                : Color::Black()});
+    }
+  };
+}
+
+SceneCallback CreateBlurScene(const Playground& playground) {
+  return [](Canvas& canvas) {
+    canvas.DrawPaint({.color = Color::White()});
+    Paint paint = {.color = Color::Red().WithAlpha(0.75)};
+    paint.mask_blur_descriptor = Paint::MaskBlurDescriptor{
+        .style = FilterContents::BlurStyle::kNormal,
+        .sigma = Sigma{8},
+    };
+    for (size_t i = 0; i < 24; i++) {
+      canvas.DrawCircle({60.0f + (i % 8) * 120, 120.0f + (i / 8) * 200}, 40,
+                        paint);
+    }
+
+    Paint layer_paint;
+    layer_paint.image_filter = [](const FilterInput::Ref& input,
+                                  const Matrix& effect_transform,
+                                  bool is_subpass) {
+      return FilterContents::MakeGaussianBlur(
+          input, Sigma{12}, Sigma{12}, FilterContents::BlurStyle::kNormal,
+          Entity::TileMode::kClamp, effect_transform);
+    };
+    canvas.SaveLayer(layer_paint);
+    canvas.DrawRRect(Rect::MakeLTRB(200, 200, 800, 600), 32,
+                     {.color = Color::Blue().WithAlpha(0.5)});
+    canvas.Restore();
+  };
+}
+
+SceneCallback CreateClipStackScene(const Playground& playground) {
+  return [](Canvas& canvas) {
+    canvas.DrawPaint({.color = Color::White()});
+    for (size_t i = 0; i < 16; i++) {
+      canvas.Save();
+      auto bounds = Rect::MakeXYWH(20.0f + (i % 4) * 250,
+                                   20.0f + (i / 4) * 185, 230, 165);
+      canvas.ClipRRect(bounds, 24);
+      auto center = bounds.origin + Point(bounds.size.width / 2,
+                                          bounds.size.height / 2);
+      canvas.ClipPath(PathBuilder{}.AddCircle(center, 90).TakePath());
+      for (size_t j = 0; j < 8; j++) {
+        canvas.DrawRect(
+            bounds.Shift({j * 20.0f, j * 12.0f}),
+            {.color = Color::Green().WithAlpha(0.1f * (j + 1))});
+      }
+      canvas.Restore();
+    }
+  };
+}
+
+SceneCallback CreateGradientScene(const Playground& playground) {
+  return [](Canvas& canvas) {
+    for (size_t i = 0; i < 64; i++) {
+      auto bounds = Rect::MakeXYWH((i % 8) * 128.0f, (i / 8) * 96.0f, 128, 96);
+      Paint paint;
+      paint.color_source_type = Paint::ColorSourceType::kLinearGradient;
+      paint.color_source = [bounds, i]() {
+        auto contents = std::make_shared<LinearGradientContents>();
+        contents->SetEndPoints(bounds.origin,
+                               bounds.origin + Point(bounds.size));
+        contents->SetColors({Color::Red(), Color::Blue().WithAlpha(i / 64.0f),
+                             Color::Yellow()});
+        contents->SetStops({0.0, 0.5, 1.0});
+        contents->SetTileMode(Entity::TileMode::kClamp);
+        return contents;
+      };
+      canvas.DrawRect(bounds, paint);
+    }
+  };
+}
+
+SceneCallback CreatePathChartScene(const Playground& playground) {
+  return [](Canvas& canvas) {
+    canvas.DrawPaint({.color = Color::White()});
+    for (size_t series = 0; series < 6; series++) {
+      PathBuilder line;
+      PathBuilder area;
+      Scalar base = 128.0f * (series + 1);
+      area.MoveTo({0, base});
+      for (size_t i = 0; i <= 512; i++) {
+        Point point = {i * 2.0f,
+                       base - 40 - 40 * std::sin(i * 0.05f + series)};
+        if (i == 0) {
+          line.MoveTo(point);
+        } else {
+          line.LineTo(point);
+        }
+        area.LineTo(point);
+      }
+      area.LineTo({1024, base});
+      area.Close();
+
+      auto color = Color(0.2f * series, 0.4f, 1.0f - 0.15f * series, 1.0f);
+      canvas.DrawPath(area.TakePath(), {.color = color.WithAlpha(0.25)});
+      canvas.DrawPath(line.TakePath(), {.color = color,
+                                        .stroke_width = 2,
+                                        .style = Paint::Style::kStroke});
+    }
+  };
+}
+
+SceneCallback CreateAtlasScene(const Playground& playground) {
+  auto texture = playground.CreateTextureForFixture("bay_bridge.jpg");
+  if (!texture) {
+    return nullptr;
+  }
+  auto atlas = std::make_shared<Image>(texture);
+  auto size = texture->GetSize();
+  std::vector<Matrix> transforms;
+  std::vector<Rect> texture_coordinates;
+  for (size_t i = 0; i < 1024; i++) {
+    transforms.push_back(
+        Matrix::MakeTranslation({(i % 32) * 32.0f, (i / 32) * 24.0f}) *
+        Matrix::MakeRotationZ(Radians{i * 0.1f}));
+    texture_coordinates.push_back(Rect::MakeXYWH(
+        (i % 16) * size.width / 16.0f, (i / 16 % 16) * size.height / 16.0f,
+        32, 32));
+  }
+  return [atlas, transforms = std::move(transforms),
+          texture_coordinates =
+              std::move(texture_coordinates)](Canvas& canvas) {
+    canvas.DrawAtlas(atlas, transforms, texture_coordinates, {},
+                     BlendMode::kSourceOver, {}, std::nullopt, {});
+  };
+}
+
+// Waits for the GPU to finish the commands submitted so far, so that frames
+// don't queue up faster than the GPU can render them.
+bool WaitForGPU(const Context& context) {
+  auto command_buffer = context.CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  fml::AutoResetWaitableEvent latch;
+  if (!command_buffer->SubmitCommands(
+          [&latch](CommandBuffer::Status) { latch.Signal(); })) {
+    return false;
+  }
+  latch.Wait();
+  return true;
+}
+
+void BM_RenderScene(benchmark::State& state,
+                    PlaygroundBackend backend,
+                    SceneFactory factory) {
+  if (!Playground::SupportsBackend(backend)) {
+    state.SkipWithError("Backend not supported.");
+    return;
+  }
+  BenchmarkPlayground playground;
+  playground.SetupContext(backend);
+  auto context = playground.GetContext();
+  if (!context) {
+    state.SkipWithError("Could not create the context.");
+    return;
+  }
+  auto scene = factory(playground);
+  if (!scene) {
+    state.SkipWithError("Could not load the scene.");
+    return;
+  }
+  AiksContext aiks_context(context);
+  if (!aiks_context.IsValid()) {
+    state.SkipWithError("Could not create the Aiks context.");
+    return;
+  }
+  auto render_target =
+      context->GetCapabilities()->SupportsOffscreenMSAA()
+          ? RenderTarget::CreateOffscreenMSAA(*context, kFrameSize)
+          : RenderTarget::CreateOffscreen(*context, kFrameSize);
+
+  const auto& content_context = aiks_context.GetContentContext();
+  auto allocator = context->GetResourceAllocator();
+  auto tracer = context->GetGPUTracer();
+  if (tracer) {
+    tracer->SetEnabled(true);
+  }
+
+  size_t draw_calls = 0u;
+  size_t pipeline_switches = 0u;
+  size_t gpu_frames = 0u;
+  fml::TimeDelta encode_time;
+  fml::TimeDelta gpu_time;
+  auto allocated_bytes = allocator->GetTotalAllocatedBytes();
+  for (auto _ : state) {
+    Canvas canvas;
+    scene(canvas);
+    auto picture = canvas.EndRecordingAsPicture();
+
+    auto start = fml::TimePoint::Now();
+    if (!aiks_context.Render(picture, render_target)) {
+      state.SkipWithError("Could not render the scene.");
+      break;
+    }
+    encode_time = encode_time + (fml::TimePoint::Now() - start);
+    draw_calls += content_context.GetDrawCallCount();
+    pipeline_switches += content_context.GetPipelineSwitchCount();
+    if (tracer) {
+      tracer->MarkFrameEnd();
+    }
+
+    if (!WaitForGPU(*context)) {
+      state.SkipWithError("Could not wait for the GPU.");
+      break;
+    }
+    state.SetIterationTime((fml::TimePoint::Now() - start).ToSecondsF());
+
+    if (auto last_frame_gpu_time = tracer ? tracer->GetLastFrameGPUTime()
+                                          : std::nullopt;
+        last_frame_gpu_time.has_value()) {
+      gpu_time = gpu_time + last_frame_gpu_time.value();
+      gpu_frames++;
+    }
+  }
+  allocated_bytes = allocator->GetTotalAllocatedBytes() - allocated_bytes;
+
+  const auto per_frame = benchmark::Counter::kAvgIterations;
+  state.counters["EncodeMs"] =
+      benchmark::Counter(encode_time.ToMillisecondsF(), per_frame);
+  state.counters["DrawCalls"] = benchmark::Counter(draw_calls, per_frame);
+  state.counters["PipelineSwitches"] =
+      benchmark::Counter(pipeline_switches, per_frame);
+  state.counters["AllocatedBytes"] =
+      benchmark::Counter(allocated_bytes, per_frame);
+  // Only backends with timestamp queries report GPU times.
+  if (gpu_frames > 0u) {
+    state.counters["GPUMs"] = gpu_time.ToMillisecondsF() / gpu_frames;
+  }
+}
+
+}  // namespace
+
+#define IMPELLER_SCENE_BENCHMARKS(backend, backend_name)                       \
+  BENCHMARK_CAPTURE(BM_RenderScene, TextPage/backend_name, backend,            \
+                    &CreateTextPageScene)                                      \
+      ->UseManualTime()                                                        \
+      ->Unit(benchmark::kMillisecond);                                         \
+  BENCHMARK_CAPTURE(BM_RenderScene, Blurs/backend_name, backend,               \
+                    &CreateBlurScene)                                          \
+      ->UseManualTime()                                                        \
+      ->Unit(benchmark::kMillisecond);                                         \
+  BENCHMARK_CAPTURE(BM_RenderScene, ClipStack/backend_name, backend,           \
+                    &CreateClipStackScene)                                     \
+      ->UseManualTime()                                                        \
+      ->Unit(benchmark::kMillisecond);                                         \
+  BENCHMARK_CAPTURE(BM_RenderScene, Gradients/backend_name, backend,           \
+                    &CreateGradientScene)                                      \
+      ->UseManualTime()                                                        \
+      ->Unit(benchmark::kMillisecond);                                         \
+  BENCHMARK_CAPTURE(BM_RenderScene, PathChart/backend_name, backend,           \
+                    &CreatePathChartScene)                                     \
+      ->UseManualTime()                                                        \
+      ->Unit(benchmark::kMillisecond);                                         \
+  BENCHMARK_CAPTURE(BM_RenderScene, Atlas/backend_name, backend,               \
+                    &CreateAtlasScene)                                         \
+      ->UseManualTime()                                                        \
+      ->Unit(benchmark::kMillisecond)
+
+#if IMPELLER_ENABLE_METAL
+IMPELLER_SCENE_BENCHMARKS(PlaygroundBackend::kMetal, Metal);
+#endif  // IMPELLER_ENABLE_METAL
+
+#if IMPELLER_ENABLE_OPENGLES
+IMPELLER_SCENE_BENCHMARKS(PlaygroundBackend::kOpenGLES, OpenGLES);
+#endif  // IMPELLER_ENABLE_OPENGLES
+
+#if IMPELLER_ENABLE_VULKAN
+IMPELLER_SCENE_BENCHMARKS(PlaygroundBackend::kVulkan, Vulkan);
+#endif  // IMPELLER_ENABLE_VULKAN
+
+}  // namespace impeller
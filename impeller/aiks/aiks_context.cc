@@ -4,7 +4,10 @@
 
 #include "impeller/aiks/aiks_context.h"
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/aiks/picture.h"
+#include "impeller/entity/entity_pass.h"
+#include "impeller/entity/render_target_cache.h"
 
 namespace impeller {
 
@@ -36,13 +39,34 @@ ContentContext& AiksContext::GetContentContext() const {
   return *content_context_;
 }
 
-bool AiksContext::Render(const Picture& picture, RenderTarget& render_target) {
+bool AiksContext::CanRenderDamage(const RenderTarget& render_target) const {
+  return IsValid() &&
+         EntityPass::CanRenderDamage(*content_context_, render_target);
+}
+
+bool AiksContext::Render(const Picture& picture,
+                         RenderTarget& render_target,
+                         std::optional<IRect> damage) {
   if (!IsValid()) {
     return false;
   }
 
   if (picture.pass) {
-    return picture.pass->Render(*content_context_, render_target);
+    // Subpass attachments released by the previous picture are recycled.
+    auto& render_target_cache = *content_context_->GetRenderTargetCache();
+    render_target_cache.Start();
+    content_context_->ResetDrawCallCounts();
+    auto result =
+        picture.pass->Render(*content_context_, render_target, damage);
+    render_target_cache.End();
+    FML_TRACE_COUNTER("impeller", "AiksContextDrawCalls",
+                      reinterpret_cast<int64_t>(this),  //
+                      "DrawCalls", content_context_->GetDrawCallCount(),
+                      "BatchedEntities",
+                      content_context_->GetBatchedEntityCount(),
+                      "PipelineSwitches",
+                      content_context_->GetPipelineSwitchCount());
+    return result;
   }
 
   return true;
@@ -5,9 +5,11 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_target.h"
 
@@ -28,7 +30,20 @@ class AiksContext {
 
   ContentContext& GetContentContext() const;
 
-  bool Render(const Picture& picture, RenderTarget& render_target);
+  //----------------------------------------------------------------------------
+  /// @brief      Renders the picture into the render target. If damage is
+  ///             set, only that area of the render target is rendered and
+  ///             the rest keeps its contents, see `CanRenderDamage()`.
+  ///
+  bool Render(const Picture& picture,
+              RenderTarget& render_target,
+              std::optional<IRect> damage = std::nullopt);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether pictures can be rendered into part of the render
+  ///             target, keeping the contents of the rest.
+  ///
+  bool CanRenderDamage(const RenderTarget& render_target) const;
 
  private:
   std::shared_ptr<Context> context_;
@@ -16,10 +16,12 @@
 #include "impeller/aiks/canvas.h"
 #include "impeller/aiks/image.h"
 #include "impeller/aiks/paint_pass_delegate.h"
+#include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/color_source_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/scene_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/contents/tiled_texture_contents.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/constants.h"
@@ -201,6 +203,33 @@ TEST_P(AiksTest, CanRenderImageRect) {
   ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
 }
 
+TEST_P(AiksTest, DownscaledMipmappedImagesUseTrilinearSampling) {
+  Canvas canvas;
+  auto image = std::make_shared<Image>(
+      CreateTextureForFixture("kalimba.jpg", /*enable_mipmapping=*/true));
+  auto source_rect = Rect::MakeSize(Size(image->GetSize()));
+  SamplerDescriptor linear;
+  linear.min_filter = linear.mag_filter = MinMagFilter::kLinear;
+
+  // A thumbnail of the image, and the image at its own size.
+  canvas.DrawImageRect(image, source_rect, Rect::MakeXYWH(0, 0, 64, 64), {},
+                       linear);
+  canvas.DrawImageRect(image, source_rect, Rect::MakeSize(source_rect.size),
+                       {}, linear);
+
+  std::vector<MipFilter> mip_filters;
+  auto picture = canvas.EndRecordingAsPicture();
+  picture.pass->IterateAllEntities([&mip_filters](Entity& entity) {
+    auto contents =
+        std::static_pointer_cast<TextureContents>(entity.GetContents());
+    mip_filters.push_back(contents->GetSamplerDescriptor().mip_filter);
+    return true;
+  });
+  ASSERT_EQ(mip_filters.size(), 2u);
+  ASSERT_EQ(mip_filters[0], MipFilter::kLinear);
+  ASSERT_EQ(mip_filters[1], MipFilter::kNearest);
+}
+
 TEST_P(AiksTest, CanRenderStrokes) {
   Canvas canvas;
   Paint paint;
@@ -1889,6 +1918,38 @@ TEST_P(AiksTest, DrawPaintAbsorbsClears) {
   ASSERT_EQ(picture.pass->GetClearColor(), Color::CornflowerBlue());
 }
 
+TEST_P(AiksTest, ConsecutiveDrawAtlasCallsAreMerged) {
+  auto atlas =
+      std::make_shared<Image>(CreateTextureForFixture("bay_bridge.jpg"));
+  auto draw_atlas = [&atlas](Canvas& canvas, Scalar x, BlendMode blend_mode) {
+    canvas.DrawAtlas(atlas, {Matrix::MakeTranslation({x, 0})},
+                     {Rect::MakeXYWH(0, 0, 100, 100)}, {}, BlendMode::kSource,
+                     {}, std::nullopt, {.blend_mode = blend_mode});
+  };
+
+  Canvas canvas;
+  draw_atlas(canvas, 0, BlendMode::kSourceOver);
+  draw_atlas(canvas, 100, BlendMode::kSourceOver);
+  draw_atlas(canvas, 200, BlendMode::kSourceOver);
+  // A different paint blend mode starts a new draw.
+  draw_atlas(canvas, 300, BlendMode::kPlus);
+  canvas.Translate({0, 100});
+  // So does a different transform.
+  draw_atlas(canvas, 0, BlendMode::kPlus);
+
+  Picture picture = canvas.EndRecordingAsPicture();
+  ASSERT_EQ(picture.pass->GetElementCount(), 3u);
+
+  std::vector<size_t> sprite_counts;
+  picture.pass->IterateAllEntities([&sprite_counts](Entity& entity) {
+    auto contents =
+        std::static_pointer_cast<AtlasContents>(entity.GetContents());
+    sprite_counts.push_back(contents->GetTransforms().size());
+    return true;
+  });
+  ASSERT_EQ(sprite_counts, (std::vector<size_t>{3u, 1u, 1u}));
+}
+
 TEST_P(AiksTest, ForegroundBlendSubpassCollapseOptimization) {
   Canvas canvas;
 
@@ -2163,5 +2224,31 @@ TEST_P(AiksTest, CanRenderOffscreenCheckerboard) {
   ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
 }
 
+TEST_P(AiksTest, CanRenderSiblingSaveLayersWithClips) {
+  // Each panel is rendered to its own offscreen texture, which can happen
+  // concurrently when the context has a worker task runner.
+  Canvas canvas;
+  canvas.Scale(GetContentScale());
+  canvas.DrawPaint({.color = Color::White()});
+  canvas.ClipRect(Rect::MakeLTRB(0, 0, 500, 500));
+
+  const std::vector<Color> colors = {Color::Red(), Color::Green(),
+                                     Color::Blue(), Color::Purple()};
+  for (size_t i = 0; i < colors.size(); i++) {
+    auto origin = Point((i % 2) * 250.0f, (i / 2) * 250.0f);
+    canvas.SaveLayer({.color = Color::Black().WithAlpha(0.75)});
+    {
+      canvas.ClipRRect(Rect::MakeXYWH(origin.x + 10, origin.y + 10, 230, 230),
+                       20);
+      canvas.DrawPaint({.color = colors[i]});
+      canvas.DrawCircle(origin + Point(125, 125), 150,
+                        {.color = Color::Yellow().WithAlpha(0.5)});
+    }
+    canvas.Restore();
+  }
+
+  ASSERT_TRUE(OpenPlaygroundHere(canvas.EndRecordingAsPicture()));
+}
+
 }  // namespace testing
 }  // namespace impeller
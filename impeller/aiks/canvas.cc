@@ -13,6 +13,7 @@
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/color_source_text_contents.h"
+#include "impeller/entity/contents/path_shadow_contents.h"
 #include "impeller/entity/contents/rrect_shadow_contents.h"
 #include "impeller/entity/contents/text_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
@@ -39,6 +40,29 @@ static bool UseColorSourceContents(
   return !vertices->HasTextureCoordinates();
 }
 
+// Below this scale, sampling only the nearest mip level visibly shimmers when
+// the image moves, so both levels around the sample are blended.
+static constexpr Scalar kTrilinearMinificationThreshold = 0.5f;
+
+static SamplerDescriptor GetMinificationSampler(const Texture& texture,
+                                                const Rect& source,
+                                                const Rect& dest,
+                                                const Matrix& transform,
+                                                SamplerDescriptor sampler) {
+  if (texture.GetTextureDescriptor().mip_count <= 1u ||
+      sampler.min_filter != MinMagFilter::kLinear ||
+      sampler.mip_filter == MipFilter::kLinear) {
+    return sampler;
+  }
+  auto scale = std::min(dest.size.width / source.size.width,
+                        dest.size.height / source.size.height) *
+               transform.GetMaxBasisLength();
+  if (scale < kTrilinearMinificationThreshold) {
+    sampler.mip_filter = MipFilter::kLinear;
+  }
+  return sampler;
+}
+
 Canvas::Canvas() {
   Initialize();
 }
@@ -59,6 +83,7 @@ void Canvas::Reset() {
   current_pass_ = nullptr;
   xformation_stack_ = {};
   lazy_glyph_atlas_ = nullptr;
+  last_atlas_ = {};
 }
 
 void Canvas::Save() {
@@ -159,6 +184,10 @@ void Canvas::RestoreToCount(size_t count) {
 }
 
 void Canvas::DrawPath(const Path& path, const Paint& paint) {
+  if (AttemptDrawBlurredPath(path, paint)) {
+    return;
+  }
+
   Entity entity;
   entity.SetTransformation(GetCurrentTransformation());
   entity.SetStencilDepth(GetStencilDepth());
@@ -225,6 +254,43 @@ bool Canvas::AttemptDrawBlurredRRect(const Rect& rect,
   return true;
 }
 
+bool Canvas::AttemptDrawBlurredPath(const Path& path, const Paint& paint) {
+  if (paint.color_source == nullptr ||
+      paint.color_source_type != Paint::ColorSourceType::kColor ||
+      paint.style != Paint::Style::kFill) {
+    return false;
+  }
+
+  if (!paint.mask_blur_descriptor.has_value() ||
+      paint.mask_blur_descriptor->style != FilterContents::BlurStyle::kNormal) {
+    return false;
+  }
+
+  // Only paths with an identity can have their blurred mask cached.
+  if (path.GetIdentity() == 0) {
+    return false;
+  }
+
+  Paint new_paint = paint;
+
+  auto contents = std::make_shared<PathShadowContents>();
+  contents->SetColor(new_paint.color);
+  contents->SetSigma(new_paint.mask_blur_descriptor->sigma);
+  contents->SetPath(path);
+
+  new_paint.mask_blur_descriptor = std::nullopt;
+
+  Entity entity;
+  entity.SetTransformation(GetCurrentTransformation());
+  entity.SetStencilDepth(GetStencilDepth());
+  entity.SetBlendMode(new_paint.blend_mode);
+  entity.SetContents(new_paint.WithFilters(std::move(contents)));
+
+  GetCurrentPass().AddEntity(entity);
+
+  return true;
+}
+
 void Canvas::DrawRect(Rect rect, const Paint& paint) {
   if (paint.style == Paint::Style::kStroke) {
     DrawPath(PathBuilder{}.AddRect(rect).TakePath(), paint);
@@ -320,15 +386,11 @@ void Canvas::DrawPicture(Picture picture) {
   if (!picture.pass) {
     return;
   }
-  // Clone the base pass and account for the CTM updates.
-  auto pass = picture.pass->Clone();
-  pass->IterateAllEntities([&](auto& entity) -> bool {
-    entity.IncrementStencilDepth(GetStencilDepth());
-    entity.SetTransformation(GetCurrentTransformation() *
-                             entity.GetTransformation());
-    return true;
-  });
-  return;
+  // Account for the CTM and the clips that are already applied, and draw the
+  // contents of the picture in place.
+  picture.pass->Reposition(GetCurrentTransformation(), GetStencilDepth());
+  GetCurrentPass().AppendElements(std::move(picture.pass));
+  last_atlas_ = {};
 }
 
 void Canvas::DrawImage(const std::shared_ptr<Image>& image,
@@ -364,7 +426,9 @@ void Canvas::DrawImageRect(const std::shared_ptr<Image>& image,
   auto contents = TextureContents::MakeRect(dest);
   contents->SetTexture(image->GetTexture());
   contents->SetSourceRect(source);
-  contents->SetSamplerDescriptor(std::move(sampler));
+  contents->SetSamplerDescriptor(
+      GetMinificationSampler(*image->GetTexture(), source, dest,
+                             GetCurrentTransformation(), std::move(sampler)));
   contents->SetOpacity(paint.color.alpha);
   contents->SetDeferApplyingOpacity(paint.HasColorFilter());
 
@@ -552,7 +616,31 @@ void Canvas::DrawAtlas(const std::shared_ptr<Image>& atlas,
   entity.SetBlendMode(paint.blend_mode);
   entity.SetContents(paint.WithFilters(contents, false));
 
-  GetCurrentPass().AddEntity(entity);
+  // Consecutive unfiltered atlas draws into the same pass with the same
+  // transform, clip and blend are drawn in order within a single draw, so
+  // their sprites are appended to the previous draw instead.
+  auto& pass = GetCurrentPass();
+  bool can_merge = entity.GetContents() == contents &&
+                   entity.GetBlendMode() <= Entity::kLastPipelineBlendMode;
+  if (can_merge && last_atlas_.contents && last_atlas_.pass == &pass &&
+      last_atlas_.element_count == pass.GetElementCount() &&
+      last_atlas_.transformation == entity.GetTransformation() &&
+      last_atlas_.stencil_depth == entity.GetStencilDepth() &&
+      last_atlas_.blend_mode == entity.GetBlendMode() &&
+      last_atlas_.contents->Merge(*contents)) {
+    return;
+  }
+
+  last_atlas_ = {};
+  if (can_merge) {
+    last_atlas_ = {.contents = contents,
+                   .pass = &pass,
+                   .element_count = pass.GetElementCount() + 1,
+                   .transformation = entity.GetTransformation(),
+                   .stencil_depth = entity.GetStencilDepth(),
+                   .blend_mode = entity.GetBlendMode()};
+  }
+  pass.AddEntity(std::move(entity));
 }
 
 }  // namespace impeller
@@ -26,6 +26,7 @@
 
 namespace impeller {
 
+class AtlasContents;
 class Entity;
 
 class Canvas {
@@ -136,6 +137,18 @@ class Canvas {
   std::deque<CanvasStackEntry> xformation_stack_;
   std::shared_ptr<LazyGlyphAtlas> lazy_glyph_atlas_;
 
+  /// The most recent atlas draw, which the next atlas draw may be merged into
+  /// as long as nothing else was added to its pass in between.
+  struct LastAtlasDraw {
+    std::shared_ptr<AtlasContents> contents;
+    const EntityPass* pass = nullptr;
+    size_t element_count = 0u;
+    Matrix transformation;
+    size_t stencil_depth = 0u;
+    BlendMode blend_mode = BlendMode::kSourceOver;
+  };
+  LastAtlasDraw last_atlas_;
+
   void Initialize();
 
   void Reset();
@@ -158,6 +171,8 @@ class Canvas {
                                Scalar corner_radius,
                                const Paint& paint);
 
+  bool AttemptDrawBlurredPath(const Path& path, const Paint& paint);
+
   FML_DISALLOW_COPY_AND_ASSIGN(Canvas);
 };
 
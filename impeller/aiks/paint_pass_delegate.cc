@@ -35,6 +35,11 @@ bool PaintPassDelegate::CanCollapseIntoParentPass(EntityPass* entity_pass) {
   return false;
 }
 
+// |EntityPassDelgate|
+bool PaintPassDelegate::CanClipSubpassTarget() {
+  return !paint_.image_filter.has_value();
+}
+
 // |EntityPassDelgate|
 std::shared_ptr<Contents> PaintPassDelegate::CreateContentsForSubpassTarget(
     std::shared_ptr<Texture> target,
@@ -125,6 +130,11 @@ bool OpacityPeepholePassDelegate::CanCollapseIntoParentPass(
   return true;
 }
 
+// |EntityPassDelgate|
+bool OpacityPeepholePassDelegate::CanClipSubpassTarget() {
+  return !paint_.image_filter.has_value();
+}
+
 // |EntityPassDelgate|
 std::shared_ptr<Contents>
 OpacityPeepholePassDelegate::CreateContentsForSubpassTarget(
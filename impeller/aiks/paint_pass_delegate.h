@@ -30,6 +30,9 @@ class PaintPassDelegate final : public EntityPassDelegate {
   // |EntityPassDelgate|
   bool CanCollapseIntoParentPass(EntityPass* entity_pass) override;
 
+  // |EntityPassDelgate|
+  bool CanClipSubpassTarget() override;
+
   // |EntityPassDelgate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
@@ -63,6 +66,9 @@ class OpacityPeepholePassDelegate final : public EntityPassDelegate {
   // |EntityPassDelgate|
   bool CanCollapseIntoParentPass(EntityPass* entity_pass) override;
 
+  // |EntityPassDelgate|
+  bool CanClipSubpassTarget() override;
+
   // |EntityPassDelgate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
@@ -44,7 +44,7 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
 
   auto statement = registration->CreateInsertStatement();
 
-  if (!statement.IsValid() || !statement.Reset()) {
+  if (!statement.IsValid() || !statement->Reset()) {
     /*
      *  Must be able to reset the statement for a new write
      */
@@ -59,15 +59,15 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
    *  for its members to be references. It does not manage the lifetimes of
    *  anything.
    */
-  ArchiveLocation item(*this, statement, *registration, primary_key);
+  ArchiveLocation item(*this, *statement, *registration, primary_key);
 
   /*
    *  If the item provides its own primary key, we need to bind it now.
    * Otherwise, one will be automatically assigned to it.
    */
   if (primary_key.has_value() &&
-      !statement.WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
-                            primary_key.value())) {
+      !statement->WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
+                             primary_key.value())) {
     return std::nullopt;
   }
 
@@ -75,7 +75,7 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
     return std::nullopt;
   }
 
-  if (statement.Execute() != ArchiveStatement::Result::kDone) {
+  if (statement->Execute() != ArchiveStatement::Result::kDone) {
     return std::nullopt;
   }
 
@@ -95,6 +95,30 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
   return lastInsert;
 }
 
+bool Archive::ArchiveInstances(
+    const ArchiveDef& definition,
+    const std::vector<const Archivable*>& archivables) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  /*
+   *  The transactions of the individual items are nested in this one, so all
+   *  of them are committed at once instead of syncing the database once per
+   *  item.
+   */
+  auto transaction = database_->CreateTransaction(transaction_count_);
+
+  for (const auto* archivable : archivables) {
+    if (!ArchiveInstance(definition, *archivable).has_value()) {
+      return false;
+    }
+  }
+
+  transaction.MarkWritesAsReadyForCommit();
+  return true;
+}
+
 bool Archive::UnarchiveInstance(const ArchiveDef& definition,
                                 PrimaryKey name,
                                 Archivable& archivable) {
@@ -124,7 +148,7 @@ size_t Archive::UnarchiveInstances(const ArchiveDef& definition,
 
   auto statement = registration->CreateQueryStatement(isQueryingSingle);
 
-  if (!statement.IsValid() || !statement.Reset()) {
+  if (!statement.IsValid() || !statement->Reset()) {
     return 0;
   }
 
@@ -133,13 +157,13 @@ size_t Archive::UnarchiveInstances(const ArchiveDef& definition,
      *  If a single statement is being queried for, bind the primary key as a
      * statement argument.
      */
-    if (!statement.WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
-                              primary_key.value())) {
+    if (!statement->WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
+                               primary_key.value())) {
       return 0;
     }
   }
 
-  if (statement.GetColumnCount() !=
+  if (statement->GetColumnCount() !=
       registration->GetMemberCount() + 1 /* primary key */) {
     return 0;
   }
@@ -152,13 +176,13 @@ size_t Archive::UnarchiveInstances(const ArchiveDef& definition,
 
   size_t itemsRead = 0;
 
-  while (statement.Execute() == ArchiveStatement::Result::kRow) {
+  while (statement->Execute() == ArchiveStatement::Result::kRow) {
     itemsRead++;
 
     /*
      *  Prepare a fresh archive item for the given statement
      */
-    ArchiveLocation item(*this, statement, *registration, primary_key);
+    ArchiveLocation item(*this, *statement, *registration, primary_key);
 
     if (!stepper(item)) {
       break;
@@ -172,4 +196,54 @@ size_t Archive::UnarchiveInstances(const ArchiveDef& definition,
   return itemsRead;
 }
 
+size_t Archive::UnarchiveInstances(const ArchiveDef& definition,
+                                   const std::vector<int64_t>& primary_keys,
+                                   const Archive::UnarchiveStep& stepper) {
+  if (!IsValid()) {
+    return 0;
+  }
+
+  const auto* registration =
+      database_->GetRegistrationForDefinition(definition);
+
+  if (registration == nullptr) {
+    return 0;
+  }
+
+  /*
+   *  The same single item query is rebound for every key instead of being
+   *  prepared once per item.
+   */
+  auto statement = registration->CreateQueryStatement(true /* single */);
+
+  if (!statement.IsValid() ||
+      statement->GetColumnCount() !=
+          registration->GetMemberCount() + 1 /* primary key */) {
+    return 0;
+  }
+
+  auto transaction = database_->CreateTransaction(transaction_count_);
+
+  size_t itemsRead = 0;
+
+  for (const auto primary_key : primary_keys) {
+    if (!statement->Reset() ||
+        !statement->WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
+                               primary_key) ||
+        statement->Execute() != ArchiveStatement::Result::kRow) {
+      break;
+    }
+
+    itemsRead++;
+
+    ArchiveLocation item(*this, *statement, *registration, primary_key);
+
+    if (!stepper(item)) {
+      break;
+    }
+  }
+
+  return itemsRead;
+}
+
 }  // namespace impeller
@@ -34,6 +34,22 @@ class Archive {
     return ArchiveInstance(def, archivable).has_value();
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Writes all the archivables in a single transaction. Either all
+  ///             of them are written or none are.
+  ///
+  template <class T,
+            class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
+  [[nodiscard]] bool Write(const std::vector<T>& archivables) {
+    const ArchiveDef& def = T::kArchiveDefinition;
+    std::vector<const Archivable*> items;
+    items.reserve(archivables.size());
+    for (const auto& archivable : archivables) {
+      items.push_back(&archivable);
+    }
+    return ArchiveInstances(def, items);
+  }
+
   template <class T,
             class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
   [[nodiscard]] bool Read(PrimaryKey name, T& archivable) {
@@ -60,6 +76,9 @@ class Archive {
       const ArchiveDef& definition,
       const Archivable& archivable);
 
+  bool ArchiveInstances(const ArchiveDef& definition,
+                        const std::vector<const Archivable*>& archivables);
+
   bool UnarchiveInstance(const ArchiveDef& definition,
                          PrimaryKey name,
                          Archivable& archivable);
@@ -68,6 +87,10 @@ class Archive {
                             const UnarchiveStep& stepper,
                             PrimaryKey primary_key = std::nullopt);
 
+  size_t UnarchiveInstances(const ArchiveDef& definition,
+                            const std::vector<int64_t>& primary_keys,
+                            const UnarchiveStep& stepper);
+
   FML_DISALLOW_COPY_AND_ASSIGN(Archive);
 };
 
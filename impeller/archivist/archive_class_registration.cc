@@ -21,6 +21,9 @@ ArchiveClassRegistration::ArchiveClassRegistration(ArchiveDatabase& database,
     // The first index entry is the primary key. So add one to the index.
     column_map_[definition_.members[i]] = i + 1;
   }
+  insert_statement_string_ = CreateInsertStatementString();
+  query_single_statement_string_ = CreateQueryStatementString(true);
+  query_all_statement_string_ = CreateQueryStatementString(false);
   is_valid_ = CreateTable();
 }
 
@@ -83,7 +86,7 @@ bool ArchiveClassRegistration::CreateTable() {
   return statement.Execute() == ArchiveStatement::Result::kDone;
 }
 
-ArchiveStatement ArchiveClassRegistration::CreateQueryStatement(
+std::string ArchiveClassRegistration::CreateQueryStatementString(
     bool single) const {
   std::stringstream stream;
   stream << "SELECT " << kArchivePrimaryKeyColumnName << ", ";
@@ -103,10 +106,10 @@ ArchiveStatement ArchiveClassRegistration::CreateQueryStatement(
 
   stream << ";";
 
-  return database_.CreateStatement(stream.str());
+  return stream.str();
 }
 
-ArchiveStatement ArchiveClassRegistration::CreateInsertStatement() const {
+std::string ArchiveClassRegistration::CreateInsertStatementString() const {
   std::stringstream stream;
   stream << "INSERT OR REPLACE INTO " << definition_.table_name
          << " VALUES ( ?, ";
@@ -118,7 +121,18 @@ ArchiveStatement ArchiveClassRegistration::CreateInsertStatement() const {
   }
   stream << ");";
 
-  return database_.CreateStatement(stream.str());
+  return stream.str();
+}
+
+ArchiveDatabase::CachedStatement
+ArchiveClassRegistration::CreateQueryStatement(bool single) const {
+  return database_.AcquireStatement(single ? query_single_statement_string_
+                                           : query_all_statement_string_);
+}
+
+ArchiveDatabase::CachedStatement
+ArchiveClassRegistration::CreateInsertStatement() const {
+  return database_.AcquireStatement(insert_statement_string_);
 }
 
 }  // namespace impeller
@@ -7,6 +7,7 @@
 
 #include "flutter/fml/macros.h"
 #include "impeller/archivist/archive.h"
+#include "impeller/archivist/archive_database.h"
 #include "impeller/archivist/archive_statement.h"
 
 namespace impeller {
@@ -23,9 +24,9 @@ class ArchiveClassRegistration {
 
   size_t GetMemberCount() const;
 
-  ArchiveStatement CreateInsertStatement() const;
+  ArchiveDatabase::CachedStatement CreateInsertStatement() const;
 
-  ArchiveStatement CreateQueryStatement(bool single) const;
+  ArchiveDatabase::CachedStatement CreateQueryStatement(bool single) const;
 
  private:
   using MemberColumnMap = std::map<std::string, size_t>;
@@ -36,9 +37,16 @@ class ArchiveClassRegistration {
 
   bool CreateTable();
 
+  std::string CreateInsertStatementString() const;
+
+  std::string CreateQueryStatementString(bool single) const;
+
   ArchiveDatabase& database_;
   const ArchiveDef definition_;
   MemberColumnMap column_map_;
+  std::string insert_statement_string_;
+  std::string query_single_statement_string_;
+  std::string query_all_statement_string_;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ArchiveClassRegistration);
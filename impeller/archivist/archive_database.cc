@@ -77,6 +77,20 @@ ArchiveDatabase::ArchiveDatabase(const std::string& filename)
   if (!rollback_transaction_stmt_->IsValid()) {
     return;
   }
+
+  /*
+   *  Write-ahead logging turns every commit into an append to the log instead
+   *  of a rewrite of the database file and a journal. Since the log survives
+   *  crashes of the process, syncing at checkpoints only is still safe.
+   */
+  auto journal_mode = CreateStatement("PRAGMA journal_mode = WAL;");
+  if (journal_mode.Execute() == ArchiveStatement::Result::kFailure) {
+    VALIDATION_LOG << "Could not enable write-ahead logging for the archive.";
+  }
+  auto synchronous = CreateStatement("PRAGMA synchronous = NORMAL;");
+  if (synchronous.Execute() == ArchiveStatement::Result::kFailure) {
+    VALIDATION_LOG << "Could not relax synchronization of the archive.";
+  }
 }
 
 ArchiveDatabase::~ArchiveDatabase() = default;
@@ -130,6 +144,58 @@ ArchiveStatement ArchiveDatabase::CreateStatement(
   return ArchiveStatement{handle_ ? handle_->Get() : nullptr, statementString};
 }
 
+ArchiveDatabase::CachedStatement ArchiveDatabase::AcquireStatement(
+    const std::string& statementString) {
+  auto found = statement_cache_.find(statementString);
+  if (found != statement_cache_.end() && !found->second.empty()) {
+    auto statement = std::move(found->second.back());
+    found->second.pop_back();
+    return CachedStatement{*this, statementString, std::move(statement)};
+  }
+  return CachedStatement{
+      *this, statementString,
+      std::unique_ptr<ArchiveStatement>(new ArchiveStatement(
+          handle_ ? handle_->Get() : nullptr, statementString))};
+}
+
+void ArchiveDatabase::RecycleStatement(
+    const std::string& statementString,
+    std::unique_ptr<ArchiveStatement> statement) {
+  /*
+   *  Resetting releases the locks held by a statement that has not run to
+   *  completion, such as a query that stopped at its first row.
+   */
+  if (!statement || !statement->Reset()) {
+    return;
+  }
+  statement_cache_[statementString].emplace_back(std::move(statement));
+}
+
+ArchiveDatabase::CachedStatement::CachedStatement(
+    ArchiveDatabase& database,
+    std::string statement_string,
+    std::unique_ptr<ArchiveStatement> statement)
+    : database_(&database),
+      statement_string_(std::move(statement_string)),
+      statement_(std::move(statement)) {}
+
+ArchiveDatabase::CachedStatement::CachedStatement(CachedStatement&& other)
+    : database_(other.database_),
+      statement_string_(std::move(other.statement_string_)),
+      statement_(std::move(other.statement_)) {
+  other.database_ = nullptr;
+}
+
+ArchiveDatabase::CachedStatement::~CachedStatement() {
+  if (database_ != nullptr) {
+    database_->RecycleStatement(statement_string_, std::move(statement_));
+  }
+}
+
+bool ArchiveDatabase::CachedStatement::IsValid() const {
+  return statement_ && statement_->IsValid();
+}
+
 ArchiveTransaction ArchiveDatabase::CreateTransaction(
     int64_t& transactionCount) {
   return ArchiveTransaction{transactionCount,          //
@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/archivist/archive_transaction.h"
@@ -22,6 +23,37 @@ struct ArchiveDef;
 ///
 class ArchiveDatabase {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      A prepared statement borrowed from the cache of the database.
+  ///             It is reset and returned to the cache when it goes out of
+  ///             scope.
+  ///
+  class CachedStatement {
+   public:
+    CachedStatement(CachedStatement&& other);
+
+    ~CachedStatement();
+
+    bool IsValid() const;
+
+    ArchiveStatement& operator*() const { return *statement_; }
+
+    ArchiveStatement* operator->() const { return statement_.get(); }
+
+   private:
+    friend class ArchiveDatabase;
+
+    ArchiveDatabase* database_ = nullptr;
+    std::string statement_string_;
+    std::unique_ptr<ArchiveStatement> statement_;
+
+    CachedStatement(ArchiveDatabase& database,
+                    std::string statement_string,
+                    std::unique_ptr<ArchiveStatement> statement);
+
+    FML_DISALLOW_COPY_AND_ASSIGN(CachedStatement);
+  };
+
   ArchiveDatabase(const std::string& filename);
 
   ~ArchiveDatabase();
@@ -43,11 +75,21 @@ class ArchiveDatabase {
   std::unique_ptr<ArchiveStatement> begin_transaction_stmt_;
   std::unique_ptr<ArchiveStatement> end_transaction_stmt_;
   std::unique_ptr<ArchiveStatement> rollback_transaction_stmt_;
+  /// Idle prepared statements by their SQL. A statement that is still in use
+  /// when the same SQL is needed again, as when archiving nested items of the
+  /// same class, is simply prepared once more.
+  std::map<std::string, std::vector<std::unique_ptr<ArchiveStatement>>>
+      statement_cache_;
 
   friend class ArchiveClassRegistration;
 
   ArchiveStatement CreateStatement(const std::string& statementString) const;
 
+  CachedStatement AcquireStatement(const std::string& statementString);
+
+  void RecycleStatement(const std::string& statementString,
+                        std::unique_ptr<ArchiveStatement> statement);
+
   FML_DISALLOW_COPY_AND_ASSIGN(ArchiveDatabase);
 };
 
@@ -125,16 +125,19 @@ class ArchiveLocation {
       return false;
     }
 
+    /*
+     *  Read all the items in one pass over the keys
+     */
     const ArchiveDef& otherDef = T::kArchiveDefinition;
-    for (const auto& key : keys) {
-      items.emplace_back();
-
-      if (!context_.UnarchiveInstance(otherDef, key, items.back())) {
-        return false;
-      }
-    }
-
-    return true;
+    bool itemsValid = true;
+    auto itemsRead = context_.UnarchiveInstances(
+        otherDef, keys, [&items, &itemsValid](ArchiveLocation& item) {
+          items.emplace_back();
+          itemsValid = items.back().Read(item);
+          return itemsValid;
+        });
+
+    return itemsValid && itemsRead == keys.size();
   }
 
  private:
@@ -32,8 +32,13 @@ void ArchivistFixture::TearDown() {
 
 void ArchivistFixture::DeleteArchiveFile() const {
   auto fixtures = flutter::testing::OpenFixturesDirectory();
-  if (fml::FileExists(fixtures, archive_file_name_.c_str())) {
-    fml::UnlinkFile(fixtures, archive_file_name_.c_str());
+  // Include the write-ahead log and its index left behind by archives that
+  // were not closed.
+  for (const auto& suffix : {"", "-wal", "-shm"}) {
+    auto file_name = archive_file_name_ + suffix;
+    if (fml::FileExists(fixtures, file_name.c_str())) {
+      fml::UnlinkFile(fixtures, file_name.c_str());
+    }
   }
 }
 
@@ -196,5 +196,48 @@ TEST_F(ArchiveTest, CanReadWriteVectorOfArchivables) {
   ASSERT_TRUE(read_success);
 }
 
+TEST_F(ArchiveTest, CanWriteManyInOneTransaction) {
+  Archive archive(GetArchiveFileName().c_str());
+  ASSERT_TRUE(archive.IsValid());
+
+  std::vector<Sample> samples;
+  for (size_t i = 0; i < 1000u; i++) {
+    samples.emplace_back(Sample{i});
+  }
+  ASSERT_TRUE(archive.Write(samples));
+
+  size_t current = 0;
+  bool read_success = true;
+  ASSERT_EQ(archive.Read<Sample>([&](ArchiveLocation& location) -> bool {
+    Sample sample;
+    read_success &= sample.Read(location);
+    read_success &= sample.GetSomeData() == current++;
+    return true;
+  }),
+            1000u);
+  ASSERT_TRUE(read_success);
+}
+
+TEST_F(ArchiveTest, CanReadWriteVectorOfArchivablesRepeatedly) {
+  Archive archive(GetArchiveFileName().c_str());
+  ASSERT_TRUE(archive.IsValid());
+
+  // Writes reuse the cached statements of the previous ones.
+  for (size_t i = 0; i < 3u; i++) {
+    SampleWithVector sample_with_vector;
+    ASSERT_TRUE(archive.Write(sample_with_vector));
+  }
+
+  size_t read_count = 0;
+  ASSERT_EQ(
+      archive.Read<SampleWithVector>([&](ArchiveLocation& location) -> bool {
+        SampleWithVector other_sample_with_vector;
+        read_count += other_sample_with_vector.Read(location);
+        return true;
+      }),
+      3u);
+  ASSERT_EQ(read_count, 3u);
+}
+
 }  // namespace testing
 }  // namespace impeller
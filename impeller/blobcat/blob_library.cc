@@ -4,7 +4,7 @@
 
 #include "impeller/blobcat/blob_library.h"
 
-#include <array>
+#include <algorithm>
 #include <string>
 #include <utility>
 
@@ -25,6 +25,27 @@ constexpr BlobShaderType ToShaderType(fb::Stage stage) {
   FML_UNREACHABLE();
 }
 
+using BlobKey = std::pair<BlobShaderType, std::string_view>;
+
+static BlobKey GetBlobKey(const fb::Blob& blob) {
+  return {ToShaderType(blob.stage()),
+          std::string_view(blob.name()->c_str(), blob.name()->size())};
+}
+
+static std::shared_ptr<fml::Mapping> CreateBlobMapping(
+    const fb::Blob& blob,
+    const std::shared_ptr<fml::Mapping>& payload) {
+  if (blob.mapping() == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<fml::NonOwnedMapping>(
+      blob.mapping()->Data(), blob.mapping()->size(),
+      [payload](auto, auto) {
+        // The pointers are into the base payload. Instead of copying the
+        // data, just hold onto the payload.
+      });
+}
+
 BlobLibrary::BlobLibrary(std::shared_ptr<fml::Mapping> payload)
     : payload_(std::move(payload)) {
   if (!payload_ || payload_->GetMapping() == nullptr) {
@@ -42,17 +63,19 @@ BlobLibrary::BlobLibrary(std::shared_ptr<fml::Mapping> payload)
     return;
   }
 
+  // Only the names are visited here. The blobs themselves are not touched
+  // until they are asked for.
+  is_sorted_ = true;
   if (auto items = blob_library->items()) {
-    for (auto i = items->begin(), end = items->end(); i != end; i++) {
-      BlobKey key;
-      key.name = i->name()->str();
-      key.type = ToShaderType(i->stage());
-      blobs_[key] = std::make_shared<fml::NonOwnedMapping>(
-          i->mapping()->Data(), i->mapping()->size(),
-          [payload = payload_](auto, auto) {
-            // The pointers are into the base payload. Instead of copying the
-            // data, just hold onto the payload.
-          });
+    for (flatbuffers::uoffset_t i = 0; i < items->size(); i++) {
+      if (items->Get(i)->name() == nullptr) {
+        VALIDATION_LOG << "Blob name was absent.";
+        return;
+      }
+      if (i > 0 &&
+          GetBlobKey(*items->Get(i)) < GetBlobKey(*items->Get(i - 1))) {
+        is_sorted_ = false;
+      }
     }
   }
 
@@ -68,16 +91,44 @@ bool BlobLibrary::IsValid() const {
 }
 
 size_t BlobLibrary::GetShaderCount() const {
-  return blobs_.size();
+  if (!IsValid()) {
+    return 0u;
+  }
+  auto items = fb::GetBlobLibrary(payload_->GetMapping())->items();
+  return items ? items->size() : 0u;
 }
 
-std::shared_ptr<fml::Mapping> BlobLibrary::GetMapping(BlobShaderType type,
-                                                      std::string name) const {
-  BlobKey key;
-  key.type = type;
-  key.name = std::move(name);
-  auto found = blobs_.find(key);
-  return found == blobs_.end() ? nullptr : found->second;
+std::shared_ptr<fml::Mapping> BlobLibrary::GetMapping(
+    BlobShaderType type,
+    std::string_view name) const {
+  if (!IsValid()) {
+    return nullptr;
+  }
+  auto items = fb::GetBlobLibrary(payload_->GetMapping())->items();
+  if (!items) {
+    return nullptr;
+  }
+  const BlobKey key = {type, name};
+  if (!is_sorted_) {
+    // Like the sorted case, the last of duplicate blobs wins.
+    for (auto i = items->size(); i > 0; i--) {
+      if (GetBlobKey(*items->Get(i - 1)) == key) {
+        return CreateBlobMapping(*items->Get(i - 1), payload_);
+      }
+    }
+    return nullptr;
+  }
+  auto found = std::upper_bound(
+      items->begin(), items->end(), key,
+      [](const BlobKey& key, const fb::Blob* blob) {
+        return key < GetBlobKey(*blob);
+      });
+  if (found == items->begin()) {
+    return nullptr;
+  }
+  const auto* blob = *(--found);
+  return GetBlobKey(*blob) == key ? CreateBlobMapping(*blob, payload_)
+                                  : nullptr;
 }
 
 size_t BlobLibrary::IterateAllBlobs(
@@ -88,10 +139,15 @@ size_t BlobLibrary::IterateAllBlobs(
   if (!IsValid() || !callback) {
     return 0u;
   }
+  auto items = fb::GetBlobLibrary(payload_->GetMapping())->items();
+  if (!items) {
+    return 0u;
+  }
   size_t count = 0u;
-  for (const auto& blob : blobs_) {
+  for (const auto* blob : *items) {
     count++;
-    if (!callback(blob.first.type, blob.first.name, blob.second)) {
+    if (!callback(ToShaderType(blob->stage()), blob->name()->str(),
+                  CreateBlobMapping(*blob, payload_))) {
       break;
     }
   }
@@ -4,17 +4,24 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
-#include <type_traits>
-#include <unordered_map>
+#include <string>
+#include <string_view>
 
-#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "impeller/blobcat/blob_types.h"
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      Reads the shader blobs of a container written by `BlobWriter`.
+///
+///             The container is indexed in place. Blobs are searched for in
+///             the flatbuffer, which the writer sorts by type and name, and the
+///             returned mappings point into the payload instead of copying it.
+///
 class BlobLibrary {
  public:
   explicit BlobLibrary(std::shared_ptr<fml::Mapping> payload);
@@ -28,7 +35,7 @@ class BlobLibrary {
   size_t GetShaderCount() const;
 
   std::shared_ptr<fml::Mapping> GetMapping(BlobShaderType type,
-                                           std::string name) const;
+                                           std::string_view name) const;
 
   size_t IterateAllBlobs(
       const std::function<bool(BlobShaderType type,
@@ -37,32 +44,9 @@ class BlobLibrary {
       const;
 
  private:
-  struct BlobKey {
-    BlobShaderType type = BlobShaderType::kFragment;
-    std::string name;
-
-    struct Hash {
-      size_t operator()(const BlobKey& key) const {
-        return fml::HashCombine(
-            static_cast<std::underlying_type_t<decltype(key.type)>>(key.type),
-            key.name);
-      }
-    };
-
-    struct Equal {
-      bool operator()(const BlobKey& lhs, const BlobKey& rhs) const {
-        return lhs.type == rhs.type && lhs.name == rhs.name;
-      }
-    };
-  };
-
-  using Blobs = std::unordered_map<BlobKey,
-                                   std::shared_ptr<fml::Mapping>,
-                                   BlobKey::Hash,
-                                   BlobKey::Equal>;
-
   std::shared_ptr<fml::Mapping> payload_;
-  Blobs blobs_;
+  // Containers written before blobs were sorted are searched linearly.
+  bool is_sorted_ = false;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(BlobLibrary);
@@ -4,9 +4,11 @@
 
 #include "impeller/blobcat/blob_writer.h"
 
+#include <algorithm>
 #include <array>
 #include <filesystem>
 #include <optional>
+#include <tuple>
 
 #include "impeller/blobcat/blob_flatbuffers.h"
 
@@ -96,8 +98,17 @@ constexpr fb::Stage ToStage(BlobShaderType type) {
 }
 
 std::shared_ptr<fml::Mapping> BlobWriter::CreateMapping() const {
+  // Sorted so that readers can binary search for blobs without building an
+  // index.
+  auto blob_descriptions = blob_descriptions_;
+  std::stable_sort(blob_descriptions.begin(), blob_descriptions.end(),
+                   [](const BlobDescription& lhs, const BlobDescription& rhs) {
+                     return std::tie(lhs.type, lhs.name) <
+                            std::tie(rhs.type, rhs.name);
+                   });
+
   fb::BlobLibraryT blobs;
-  for (const auto& blob_description : blob_descriptions_) {
+  for (const auto& blob_description : blob_descriptions) {
     auto mapping = blob_description.mapping;
     if (!mapping) {
       return nullptr;
@@ -53,5 +53,40 @@ TEST(BlobTest, CanReadAndWriteBlobs) {
   ASSERT_EQ(CreateStringFromMapping(*hello_vtx), "World");
 }
 
+TEST(BlobTest, CanFindBlobsRegardlessOfInsertionOrder) {
+  BlobWriter writer;
+  for (auto name : {"Zeta", "Alpha", "Mu", "Beta", "Omega"}) {
+    ASSERT_TRUE(writer.AddBlob(BlobShaderType::kFragment, name,
+                               CreateMappingFromString(name)));
+    ASSERT_TRUE(writer.AddBlob(BlobShaderType::kVertex, name,
+                               CreateMappingFromString(name)));
+  }
+
+  auto mapping = writer.CreateMapping();
+  ASSERT_NE(mapping, nullptr);
+
+  BlobLibrary library(mapping);
+  ASSERT_TRUE(library.IsValid());
+  ASSERT_EQ(library.GetShaderCount(), 10u);
+
+  for (auto name : {"Zeta", "Alpha", "Mu", "Beta", "Omega"}) {
+    for (auto type : {BlobShaderType::kVertex, BlobShaderType::kFragment}) {
+      auto blob = library.GetMapping(type, name);
+      ASSERT_NE(blob, nullptr);
+      ASSERT_EQ(CreateStringFromMapping(*blob), name);
+    }
+  }
+  ASSERT_EQ(library.GetMapping(BlobShaderType::kCompute, "Mu"), nullptr);
+  ASSERT_EQ(library.GetMapping(BlobShaderType::kVertex, "Gamma"), nullptr);
+  ASSERT_EQ(library.GetMapping(BlobShaderType::kVertex, "Zz"), nullptr);
+
+  size_t count = 0u;
+  library.IterateAllBlobs([&](auto type, const auto& name, const auto& blob) {
+    count++;
+    return blob != nullptr && CreateStringFromMapping(*blob) == name;
+  });
+  ASSERT_EQ(count, 10u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,192 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/compiler/compilation_cache.h"
+
+#include <cstdint>
+#include <sstream>
+#include <string_view>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/hex_codec.h"
+#include "flutter/shell/version/version.h"
+#include "openssl/sha.h"
+
+namespace impeller {
+namespace compiler {
+
+/// Bumped whenever the layout of the cache changes.
+static constexpr std::string_view kCacheFormatVersion = "1";
+
+static constexpr std::string_view kManifestIncludePrefix = "include ";
+static constexpr std::string_view kManifestOutputPrefix = "output ";
+
+namespace {
+
+class Hasher {
+ public:
+  Hasher() { SHA256_Init(&context_); }
+
+  void Update(const void* data, size_t size) {
+    // Prefix every field with its size so that adjacent fields can't be
+    // shifted into each other.
+    const uint64_t length = size;
+    SHA256_Update(&context_, &length, sizeof(length));
+    SHA256_Update(&context_, data, size);
+  }
+
+  void Update(std::string_view string) { Update(string.data(), string.size()); }
+
+  std::string Finish() {
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    SHA256_Final(digest, &context_);
+    return fml::HexEncode(std::string_view(
+        reinterpret_cast<const char*>(digest), SHA256_DIGEST_LENGTH));
+  }
+
+ private:
+  SHA256_CTX context_;
+};
+
+}  // namespace
+
+CompilationCache::CompilationCache(const std::string& directory) {
+  if (directory.empty()) {
+    return;
+  }
+  directory_ = std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      directory.c_str(), true, fml::FilePermission::kReadWrite));
+}
+
+CompilationCache::~CompilationCache() = default;
+
+bool CompilationCache::IsValid() const {
+  return directory_ && directory_->is_valid();
+}
+
+std::string CompilationCache::CreateSourceKey(const fml::Mapping& source,
+                                              const std::string& options) {
+  Hasher hasher;
+  hasher.Update(kCacheFormatVersion);
+  // Outputs of other versions of impellerc may differ.
+  hasher.Update(flutter::GetFlutterEngineVersion());
+  hasher.Update(options);
+  hasher.Update(source.GetMapping(), source.GetSize());
+  return hasher.Finish();
+}
+
+static std::string GetManifestName(const std::string& source_key) {
+  return source_key + ".manifest";
+}
+
+/// Creates the key of the entry from the contents of the included files, or
+/// `std::nullopt` if one of them can't be read.
+static std::optional<std::string> CreateEntryKey(
+    const std::string& source_key,
+    const std::vector<std::string>& included_file_names,
+    const fml::UniqueFD& working_directory) {
+  Hasher hasher;
+  hasher.Update(source_key);
+  for (const auto& name : included_file_names) {
+    auto mapping = fml::FileMapping::CreateReadOnly(working_directory, name);
+    if (!mapping || !mapping->IsValid()) {
+      return std::nullopt;
+    }
+    hasher.Update(name);
+    hasher.Update(mapping->GetMapping(), mapping->GetSize());
+  }
+  return hasher.Finish();
+}
+
+std::optional<CompilationCache::Outputs> CompilationCache::Find(
+    const std::string& source_key,
+    const fml::UniqueFD& working_directory) const {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+  auto manifest = fml::FileMapping::CreateReadOnly(*directory_,
+                                                   GetManifestName(source_key));
+  if (!manifest || !manifest->IsValid() || manifest->GetSize() == 0u) {
+    return std::nullopt;
+  }
+
+  std::vector<std::string> included_file_names;
+  std::vector<std::string> output_names;
+  std::istringstream stream(
+      std::string(reinterpret_cast<const char*>(manifest->GetMapping()),
+                  manifest->GetSize()));
+  for (std::string line; std::getline(stream, line);) {
+    if (line.rfind(kManifestIncludePrefix, 0) == 0) {
+      included_file_names.push_back(line.substr(kManifestIncludePrefix.size()));
+    } else if (line.rfind(kManifestOutputPrefix, 0) == 0) {
+      output_names.push_back(line.substr(kManifestOutputPrefix.size()));
+    }
+  }
+  if (output_names.empty()) {
+    return std::nullopt;
+  }
+
+  auto entry_key =
+      CreateEntryKey(source_key, included_file_names, working_directory);
+  if (!entry_key.has_value()) {
+    return std::nullopt;
+  }
+  auto entry_directory = fml::OpenDirectoryReadOnly(*directory_,
+                                                    entry_key.value().c_str());
+  if (!entry_directory.is_valid()) {
+    return std::nullopt;
+  }
+
+  Outputs outputs;
+  for (const auto& name : output_names) {
+    std::shared_ptr<const fml::Mapping> output =
+        fml::FileMapping::CreateReadOnly(entry_directory, name);
+    if (!output || output->GetMapping() == nullptr) {
+      return std::nullopt;
+    }
+    outputs[name] = std::move(output);
+  }
+  return outputs;
+}
+
+bool CompilationCache::Store(
+    const std::string& source_key,
+    const std::vector<std::string>& included_file_names,
+    const fml::UniqueFD& working_directory,
+    const Outputs& outputs) const {
+  if (!IsValid() || outputs.empty()) {
+    return false;
+  }
+  auto entry_key =
+      CreateEntryKey(source_key, included_file_names, working_directory);
+  if (!entry_key.has_value()) {
+    return false;
+  }
+  auto entry_directory = fml::CreateDirectory(
+      *directory_, {entry_key.value()}, fml::FilePermission::kReadWrite);
+  if (!entry_directory.is_valid()) {
+    return false;
+  }
+
+  std::stringstream manifest;
+  for (const auto& name : included_file_names) {
+    manifest << kManifestIncludePrefix << name << "\n";
+  }
+  for (const auto& [name, output] : outputs) {
+    if (!output || !fml::WriteAtomically(entry_directory, name.c_str(),
+                                         *output)) {
+      return false;
+    }
+    manifest << kManifestOutputPrefix << name << "\n";
+  }
+
+  // The manifest is written last so that it never refers to an incomplete
+  // entry.
+  return fml::WriteAtomically(*directory_,
+                              GetManifestName(source_key).c_str(),
+                              fml::DataMapping(manifest.str()));
+}
+
+}  // namespace compiler
+}  // namespace impeller
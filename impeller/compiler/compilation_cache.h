@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace impeller {
+namespace compiler {
+
+//------------------------------------------------------------------------------
+/// @brief      A content addressed on-disk cache of the files impellerc
+///             generates for a shader.
+///
+///             The files a shader includes are only known once it has been
+///             compiled, so entries are found in two steps. The source and
+///             the options address a manifest that lists the files the
+///             source included when it was last compiled. The contents of
+///             those files then address the entry holding the outputs. An
+///             edit to any of them misses the cache without having to
+///             compile first.
+///
+///             Cache directories may be shared by concurrent invocations.
+///
+class CompilationCache {
+ public:
+  /// The generated files of a compilation, by the name of their kind.
+  using Outputs = std::map<std::string, std::shared_ptr<const fml::Mapping>>;
+
+  explicit CompilationCache(const std::string& directory);
+
+  ~CompilationCache();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the key of a shader source compiled with the options.
+  ///             The options must capture everything that affects the
+  ///             outputs, other than the contents of included files.
+  ///
+  static std::string CreateSourceKey(const fml::Mapping& source,
+                                     const std::string& options);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Finds the outputs of the last compilation of the source if
+  ///             none of the files it included have changed since.
+  ///
+  /// @param[in]  source_key         The key created by `CreateSourceKey`.
+  /// @param[in]  working_directory  The directory the included file names
+  ///                                are relative to.
+  ///
+  std::optional<Outputs> Find(const std::string& source_key,
+                              const fml::UniqueFD& working_directory) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stores the outputs of a compilation of the source.
+  ///
+  /// @param[in]  source_key           The key created by `CreateSourceKey`.
+  /// @param[in]  included_file_names  The files the source included, relative
+  ///                                  to the working directory.
+  /// @param[in]  working_directory    The directory the compilation ran in.
+  /// @param[in]  outputs              The generated files.
+  ///
+  bool Store(const std::string& source_key,
+             const std::vector<std::string>& included_file_names,
+             const fml::UniqueFD& working_directory,
+             const Outputs& outputs) const;
+
+ private:
+  std::shared_ptr<fml::UniqueFD> directory_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CompilationCache);
+};
+
+}  // namespace compiler
+}  // namespace impeller
@@ -0,0 +1,74 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "impeller/compiler/compilation_cache.h"
+
+namespace impeller {
+namespace compiler {
+namespace testing {
+
+static std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+TEST(CompilationCacheTest, FindsStoredOutputs) {
+  fml::ScopedTemporaryDirectory cache_directory;
+  fml::ScopedTemporaryDirectory working_directory;
+  ASSERT_TRUE(fml::WriteAtomically(working_directory.fd(), "header.glsl",
+                                   fml::DataMapping("float a;")));
+
+  CompilationCache cache(cache_directory.path());
+  ASSERT_TRUE(cache.IsValid());
+
+  auto key = CompilationCache::CreateSourceKey(
+      fml::DataMapping("#include \"header.glsl\""), "--vulkan");
+  ASSERT_FALSE(cache.Find(key, working_directory.fd()).has_value());
+
+  CompilationCache::Outputs outputs;
+  outputs["spirv"] = std::make_shared<fml::DataMapping>("spirv");
+  outputs["sl"] = std::make_shared<fml::DataMapping>("sl");
+  ASSERT_TRUE(
+      cache.Store(key, {"header.glsl"}, working_directory.fd(), outputs));
+
+  auto found = cache.Find(key, working_directory.fd());
+  ASSERT_TRUE(found.has_value());
+  ASSERT_EQ(found->size(), 2u);
+  ASSERT_EQ(ToString(*found->at("spirv")), "spirv");
+  ASSERT_EQ(ToString(*found->at("sl")), "sl");
+}
+
+TEST(CompilationCacheTest, MissesWhenIncludedFileChanges) {
+  fml::ScopedTemporaryDirectory cache_directory;
+  fml::ScopedTemporaryDirectory working_directory;
+  ASSERT_TRUE(fml::WriteAtomically(working_directory.fd(), "header.glsl",
+                                   fml::DataMapping("float a;")));
+
+  CompilationCache cache(cache_directory.path());
+  auto key = CompilationCache::CreateSourceKey(
+      fml::DataMapping("#include \"header.glsl\""), "--vulkan");
+  CompilationCache::Outputs outputs;
+  outputs["sl"] = std::make_shared<fml::DataMapping>("sl");
+  ASSERT_TRUE(
+      cache.Store(key, {"header.glsl"}, working_directory.fd(), outputs));
+
+  ASSERT_TRUE(fml::WriteAtomically(working_directory.fd(), "header.glsl",
+                                   fml::DataMapping("float b;")));
+  ASSERT_FALSE(cache.Find(key, working_directory.fd()).has_value());
+}
+
+TEST(CompilationCacheTest, KeysDependOnOptions) {
+  fml::DataMapping source("void main() {}");
+  ASSERT_EQ(CompilationCache::CreateSourceKey(source, "--vulkan"),
+            CompilationCache::CreateSourceKey(source, "--vulkan"));
+  ASSERT_NE(CompilationCache::CreateSourceKey(source, "--vulkan"),
+            CompilationCache::CreateSourceKey(source, "--metal-ios"));
+}
+
+}  // namespace testing
+}  // namespace compiler
+}  // namespace impeller
@@ -137,6 +137,15 @@ static CompilerBackend CreateGLSLCompiler(const spirv_cross::ParsedIR& ir,
                              ? source_options.gles_language_version
                              : 100;
     sl_options.es = true;
+    // Subpass inputs read the current framebuffer value. On OpenGL ES these
+    // are mapped onto GL_EXT_shader_framebuffer_fetch for color attachment 0.
+    auto resources = gl_compiler->get_shader_resources();
+    for (const auto& subpass_input : resources.subpass_inputs) {
+      gl_compiler->remap_ext_framebuffer_fetch(
+          gl_compiler->get_decoration(subpass_input.id,
+                                      spv::DecorationInputAttachmentIndex),
+          0u, true);
+    }
   } else {
     sl_options.version = source_options.gles_language_version > 0
                              ? source_options.gles_language_version
@@ -206,6 +215,39 @@ static CompilerBackend CreateCompiler(const spirv_cross::ParsedIR& ir,
   return compiler;
 }
 
+/// Counts the instructions of a SPIR-V module, leaving out the debug
+/// instructions that are only present for reflection.
+static size_t CountSPIRVInstructions(const fml::Mapping& spirv) {
+  // The header of the module holds five words.
+  constexpr size_t kHeaderWordCount = 5u;
+  const auto* words = reinterpret_cast<const uint32_t*>(spirv.GetMapping());
+  const size_t word_count = spirv.GetSize() / sizeof(uint32_t);
+  size_t instruction_count = 0u;
+  for (size_t i = kHeaderWordCount; i < word_count;) {
+    const uint32_t instruction_word_count = words[i] >> 16u;
+    switch (static_cast<spv::Op>(words[i] & 0xffffu)) {
+      case spv::OpSourceContinued:
+      case spv::OpSource:
+      case spv::OpSourceExtension:
+      case spv::OpName:
+      case spv::OpMemberName:
+      case spv::OpString:
+      case spv::OpLine:
+      case spv::OpNoLine:
+      case spv::OpModuleProcessed:
+        break;
+      default:
+        instruction_count++;
+        break;
+    }
+    if (instruction_word_count == 0u) {
+      break;
+    }
+    i += instruction_word_count;
+  }
+  return instruction_count;
+}
+
 Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
                    const SourceOptions& source_options,
                    Reflector::Options reflector_options)
@@ -227,6 +269,9 @@ Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
   // will be processed later by backend specific compilers.
   spirv_options.generate_debug_info = true;
 
+  spirv_options.optimization_level =
+      ToShaderCOptimizationLevel(source_options.optimization_level);
+
   switch (options_.source_language) {
     case SourceLanguage::kGLSL:
       // Expects GLSL 4.60 (Core Profile).
@@ -334,6 +379,22 @@ Compiler::Compiler(const std::shared_ptr<const fml::Mapping>& source_mapping,
     included_file_names_ = std::move(included_file_names);
   }
 
+  reflector_options.instruction_count =
+      CountSPIRVInstructions(*spirv_assembly_);
+  reflector_options.unoptimized_instruction_count =
+      reflector_options.instruction_count;
+  if (spirv_options.optimization_level !=
+      shaderc_optimization_level::shaderc_optimization_level_zero) {
+    auto unoptimized_spirv_options = spirv_options;
+    unoptimized_spirv_options.optimization_level =
+        shaderc_optimization_level::shaderc_optimization_level_zero;
+    if (auto unoptimized_spirv = spv_compiler.CompileToSPV(
+            error_stream_, unoptimized_spirv_options.BuildShadercOptions())) {
+      reflector_options.unoptimized_instruction_count =
+          CountSPIRVInstructions(*unoptimized_spirv);
+    }
+  }
+
   // SL Generation.
   spirv_cross::Parser parser(
       reinterpret_cast<const uint32_t*>(spirv_assembly_->GetMapping()),
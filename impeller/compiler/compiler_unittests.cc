@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string>
+
 #include "flutter/testing/testing.h"
 #include "impeller/base/validation.h"
 #include "impeller/compiler/compiler.h"
@@ -123,6 +125,48 @@ TEST_P(CompilerTest, UniformsHaveBindingAndSet) {
   ASSERT_EQ(vert_uniform_binding.binding, 17u);
 }
 
+TEST_P(CompilerTest, SubpassInputsUseFramebufferFetchOnGLES) {
+  if (GetParam() == TargetPlatform::kOpenGLDesktop) {
+    GTEST_SKIP();
+  }
+  ASSERT_TRUE(CanCompileAndReflect("framebuffer_fetch.frag",
+                                   SourceType::kFragmentShader));
+  if (GetParam() != TargetPlatform::kOpenGLES) {
+    return;
+  }
+
+  auto shader = GetShaderFile("framebuffer_fetch.frag", GetParam());
+  ASSERT_TRUE(shader);
+  std::string source(reinterpret_cast<const char*>(shader->GetMapping()),
+                     shader->GetSize());
+  ASSERT_NE(source.find("GL_EXT_shader_framebuffer_fetch"), std::string::npos);
+}
+
+TEST_P(CompilerTest, ReflectsInstructionCounts) {
+  ASSERT_TRUE(CanCompileAndReflect("sample.frag", SourceType::kFragmentShader));
+
+  auto json_fd = GetReflectionJson("sample.frag");
+  nlohmann::json shader_json = nlohmann::json::parse(json_fd->GetMapping());
+  auto unoptimized =
+      shader_json["instruction_counts"]["unoptimized"].get<size_t>();
+  auto optimized = shader_json["instruction_counts"]["optimized"].get<size_t>();
+  ASSERT_GT(optimized, 0u);
+  ASSERT_LE(optimized, unoptimized);
+}
+
+TEST_P(CompilerTest, ReflectsUniformPadding) {
+  ASSERT_TRUE(CanCompileAndReflect("padded_uniforms.frag",
+                                   SourceType::kFragmentShader));
+
+  auto json_fd = GetReflectionJson("padded_uniforms.frag");
+  nlohmann::json shader_json = nlohmann::json::parse(json_fd->GetMapping());
+  auto packing = shader_json["buffers"][0]["packing"];
+  // Each float is padded to the alignment of the vec4 after it.
+  ASSERT_EQ(packing["byte_length"].get<size_t>(), 64u);
+  ASSERT_EQ(packing["padding_bytes"].get<size_t>(), 24u);
+  ASSERT_EQ(packing["packed_byte_length"].get<size_t>(), 40u);
+}
+
 #define INSTANTIATE_TARGET_PLATFORM_TEST_SUITE_P(suite_name)              \
   INSTANTIATE_TEST_SUITE_P(                                               \
       suite_name, CompilerTest,                                           \
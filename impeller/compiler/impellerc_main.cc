@@ -2,8 +2,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <sstream>
+#include <string_view>
 #include <system_error>
+#include <thread>
 
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
@@ -11,6 +16,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "impeller/base/strings.h"
+#include "impeller/compiler/compilation_cache.h"
 #include "impeller/compiler/compiler.h"
 #include "impeller/compiler/source_options.h"
 #include "impeller/compiler/switches.h"
@@ -21,42 +27,119 @@
 namespace impeller {
 namespace compiler {
 
+// The kinds of files generated for a shader, as stored in the cache.
+static constexpr const char* kSPIRVOutput = "spirv";
+static constexpr const char* kSLOutput = "sl";
+static constexpr const char* kReflectionJSONOutput = "reflection-json";
+static constexpr const char* kReflectionHeaderOutput = "reflection-header";
+static constexpr const char* kReflectionCCOutput = "reflection-cc";
+static constexpr const char* kDepfileOutput = "depfile";
+
 // Sets the file access mode of the file at path 'p' to 0644.
-static bool SetPermissiveAccess(const std::filesystem::path& p) {
+static bool SetPermissiveAccess(const std::filesystem::path& p,
+                                std::ostream& errors) {
   auto permissions =
       std::filesystem::perms::owner_read | std::filesystem::perms::owner_write |
       std::filesystem::perms::group_read | std::filesystem::perms::others_read;
   std::error_code error;
   std::filesystem::permissions(p, permissions, error);
   if (error) {
-    std::cerr << "Failed to set access on file '" << p
-              << "': " << error.message() << std::endl;
+    errors << "Failed to set access on file '" << p
+           << "': " << error.message() << std::endl;
     return false;
   }
   return true;
 }
 
-bool Main(const fml::CommandLine& command_line) {
-  fml::InstallCrashHandler();
-  if (command_line.HasOption("help")) {
-    Switches::PrintHelp(std::cout);
-    return true;
+// Everything besides the contents of the source and included files that
+// affects the generated files.
+static std::string CreateOptionsFingerprint(const Switches& switches) {
+  std::stringstream stream;
+  stream << TargetPlatformToString(switches.target_platform) << "\n"
+         << switches.source_file_name << "\n"
+         << SourceTypeToString(switches.input_type) << "\n"
+         << switches.sl_file_name << "\n"
+         << switches.iplr << "\n"
+         << switches.spirv_file_name << "\n"
+         << switches.reflection_json_name << "\n"
+         << switches.reflection_header_name << "\n"
+         << switches.reflection_cc_name << "\n"
+         << switches.depfile_path << "\n"
+         << switches.json_format << "\n"
+         << SourceLanguageToString(switches.source_language) << "\n"
+         << switches.gles_language_version << "\n"
+         << switches.metal_version << "\n"
+         << switches.entry_point << "\n"
+         << switches.use_half_textures << "\n"
+         << OptimizationLevelToString(switches.optimization_level) << "\n";
+  for (const auto& include_dir : switches.include_directories) {
+    stream << "include " << include_dir.name << "\n";
   }
+  for (const auto& define : switches.defines) {
+    stream << "define " << define << "\n";
+  }
+  return stream.str();
+}
 
-  Switches switches(command_line);
-  if (!switches.AreValid(std::cerr)) {
-    std::cerr << "Invalid flags specified." << std::endl;
-    Switches::PrintHelp(std::cerr);
-    return false;
+static bool WriteOutputs(const Switches& switches,
+                         const CompilationCache::Outputs& outputs,
+                         std::ostream& errors) {
+  struct OutputFile {
+    std::string_view kind;
+    const std::string& file_name;
+    const char* description;
+  };
+  const OutputFile files[] = {
+      {kSPIRVOutput, switches.spirv_file_name, "file"},
+      {kSLOutput, switches.sl_file_name, "file"},
+      {kReflectionJSONOutput, switches.reflection_json_name, "reflection json"},
+      {kReflectionHeaderOutput, switches.reflection_header_name,
+       "reflection header"},
+      {kReflectionCCOutput, switches.reflection_cc_name, "reflection CC"},
+      {kDepfileOutput, switches.depfile_path, "depfile"},
+  };
+  for (const auto& file : files) {
+    auto output = outputs.find(std::string(file.kind));
+    if (output == outputs.end()) {
+      continue;
+    }
+    auto file_name = std::filesystem::absolute(
+        std::filesystem::current_path() / file.file_name.c_str());
+    if (!fml::WriteAtomically(*switches.working_directory,
+                              Utf8FromPath(file_name).c_str(),
+                              *output->second)) {
+      errors << "Could not write " << file.description << " to "
+             << file.file_name << std::endl;
+      return false;
+    }
+    // Tools that consume the runtime stage data expect the access mode to
+    // be 0644.
+    if (switches.iplr && file.kind == kSLOutput &&
+        !SetPermissiveAccess(file_name, errors)) {
+      return false;
+    }
   }
+  return true;
+}
 
+static bool CompileShader(const Switches& switches, std::ostream& errors) {
   std::shared_ptr<fml::FileMapping> source_file_mapping =
       fml::FileMapping::CreateReadOnly(switches.source_file_name);
   if (!source_file_mapping) {
-    std::cerr << "Could not open input file." << std::endl;
+    errors << "Could not open input file." << std::endl;
     return false;
   }
 
+  CompilationCache cache(switches.cache_directory);
+  std::string source_key;
+  if (cache.IsValid()) {
+    source_key = CompilationCache::CreateSourceKey(
+        *source_file_mapping, CreateOptionsFingerprint(switches));
+    if (auto outputs = cache.Find(source_key, *switches.working_directory)) {
+      return WriteOutputs(switches, outputs.value(), errors);
+    }
+  }
+
   SourceOptions options;
   options.target_platform = switches.target_platform;
   options.source_language = switches.source_language;
@@ -76,6 +159,7 @@ bool Main(const fml::CommandLine& command_line) {
   options.gles_language_version = switches.gles_language_version;
   options.metal_version = switches.metal_version;
   options.use_half_textures = switches.use_half_textures;
+  options.optimization_level = switches.optimization_level;
 
   Reflector::Options reflector_options;
   reflector_options.target_platform = switches.target_platform;
@@ -97,8 +181,8 @@ bool Main(const fml::CommandLine& command_line) {
     Compiler sksl_compiler =
         Compiler(source_file_mapping, sksl_options, sksl_reflector_options);
     if (!sksl_compiler.IsValid()) {
-      std::cerr << "Compilation to SkSL failed." << std::endl;
-      std::cerr << sksl_compiler.GetErrorMessages() << std::endl;
+      errors << "Compilation to SkSL failed." << std::endl;
+      errors << sksl_compiler.GetErrorMessages() << std::endl;
       return false;
     }
     sksl_mapping = sksl_compiler.GetSLShaderSource();
@@ -106,106 +190,51 @@ bool Main(const fml::CommandLine& command_line) {
 
   Compiler compiler(source_file_mapping, options, reflector_options);
   if (!compiler.IsValid()) {
-    std::cerr << "Compilation failed." << std::endl;
-    std::cerr << compiler.GetErrorMessages() << std::endl;
+    errors << "Compilation failed." << std::endl;
+    errors << compiler.GetErrorMessages() << std::endl;
     return false;
   }
 
-  auto spriv_file_name = std::filesystem::absolute(
-      std::filesystem::current_path() / switches.spirv_file_name);
-  if (!fml::WriteAtomically(*switches.working_directory,
-                            Utf8FromPath(spriv_file_name).c_str(),
-                            *compiler.GetSPIRVAssembly())) {
-    std::cerr << "Could not write file to " << switches.spirv_file_name
-              << std::endl;
-    return false;
-  }
+  CompilationCache::Outputs outputs;
+  outputs[kSPIRVOutput] = compiler.GetSPIRVAssembly();
 
-  auto sl_file_name = std::filesystem::absolute(
-      std::filesystem::current_path() / switches.sl_file_name);
   if (switches.iplr) {
     auto reflector = compiler.GetReflector();
     if (reflector == nullptr) {
-      std::cerr << "Could not create reflector." << std::endl;
+      errors << "Could not create reflector." << std::endl;
       return false;
     }
     auto stage_data = reflector->GetRuntimeStageData();
     if (!stage_data) {
-      std::cerr << "Runtime stage information was nil." << std::endl;
+      errors << "Runtime stage information was nil." << std::endl;
       return false;
     }
     if (sksl_mapping) {
       stage_data->SetSkSLData(sksl_mapping);
     }
-    auto stage_data_mapping = options.json_format
-                                  ? stage_data->CreateJsonMapping()
-                                  : stage_data->CreateMapping();
+    std::shared_ptr<fml::Mapping> stage_data_mapping =
+        options.json_format ? stage_data->CreateJsonMapping()
+                            : stage_data->CreateMapping();
     if (!stage_data_mapping) {
-      std::cerr << "Runtime stage data could not be created." << std::endl;
-      return false;
-    }
-    if (!fml::WriteAtomically(*switches.working_directory,         //
-                              Utf8FromPath(sl_file_name).c_str(),  //
-                              *stage_data_mapping                  //
-                              )) {
-      std::cerr << "Could not write file to " << switches.sl_file_name
-                << std::endl;
-      return false;
-    }
-    // Tools that consume the runtime stage data expect the access mode to
-    // be 0644.
-    if (!SetPermissiveAccess(sl_file_name)) {
+      errors << "Runtime stage data could not be created." << std::endl;
       return false;
     }
+    outputs[kSLOutput] = std::move(stage_data_mapping);
   } else {
-    if (!fml::WriteAtomically(*switches.working_directory,
-                              Utf8FromPath(sl_file_name).c_str(),
-                              *compiler.GetSLShaderSource())) {
-      std::cerr << "Could not write file to " << switches.sl_file_name
-                << std::endl;
-      return false;
-    }
+    outputs[kSLOutput] = compiler.GetSLShaderSource();
   }
 
   if (TargetPlatformNeedsReflection(options.target_platform)) {
     if (!switches.reflection_json_name.empty()) {
-      auto reflection_json_name = std::filesystem::absolute(
-          std::filesystem::current_path() / switches.reflection_json_name);
-      if (!fml::WriteAtomically(
-              *switches.working_directory,
-              Utf8FromPath(reflection_json_name).c_str(),
-              *compiler.GetReflector()->GetReflectionJSON())) {
-        std::cerr << "Could not write reflection json to "
-                  << switches.reflection_json_name << std::endl;
-        return false;
-      }
+      outputs[kReflectionJSONOutput] =
+          compiler.GetReflector()->GetReflectionJSON();
     }
-
     if (!switches.reflection_header_name.empty()) {
-      auto reflection_header_name =
-          std::filesystem::absolute(std::filesystem::current_path() /
-                                    switches.reflection_header_name.c_str());
-      if (!fml::WriteAtomically(
-              *switches.working_directory,
-              Utf8FromPath(reflection_header_name).c_str(),
-              *compiler.GetReflector()->GetReflectionHeader())) {
-        std::cerr << "Could not write reflection header to "
-                  << switches.reflection_header_name << std::endl;
-        return false;
-      }
+      outputs[kReflectionHeaderOutput] =
+          compiler.GetReflector()->GetReflectionHeader();
     }
-
     if (!switches.reflection_cc_name.empty()) {
-      auto reflection_cc_name =
-          std::filesystem::absolute(std::filesystem::current_path() /
-                                    switches.reflection_cc_name.c_str());
-      if (!fml::WriteAtomically(*switches.working_directory,
-                                Utf8FromPath(reflection_cc_name).c_str(),
-                                *compiler.GetReflector()->GetReflectionCC())) {
-        std::cerr << "Could not write reflection CC to "
-                  << switches.reflection_cc_name << std::endl;
-        return false;
-      }
+      outputs[kReflectionCCOutput] = compiler.GetReflector()->GetReflectionCC();
     }
   }
 
@@ -227,18 +256,122 @@ bool Main(const fml::CommandLine& command_line) {
         result_file = switches.spirv_file_name;
         break;
     }
-    auto depfile_path = std::filesystem::absolute(
-        std::filesystem::current_path() / switches.depfile_path.c_str());
-    if (!fml::WriteAtomically(*switches.working_directory,
-                              Utf8FromPath(depfile_path).c_str(),
-                              *compiler.CreateDepfileContents({result_file}))) {
-      std::cerr << "Could not write depfile to " << switches.depfile_path
+    outputs[kDepfileOutput] = compiler.CreateDepfileContents({result_file});
+  }
+
+  if (!WriteOutputs(switches, outputs, errors)) {
+    return false;
+  }
+
+  // A failure to populate the cache only makes the next build slower.
+  if (cache.IsValid()) {
+    cache.Store(source_key, compiler.GetIncludedFileNames(),
+                *switches.working_directory, outputs);
+  }
+  return true;
+}
+
+// Compiles the shaders listed in the batch file in parallel. Every line of
+// the file holds the arguments of one shader, separated by whitespace.
+static bool CompileBatch(const fml::CommandLine& command_line) {
+  const auto batch_file_name =
+      command_line.GetOptionValueWithDefault("batch", "");
+  auto batch_file = fml::FileMapping::CreateReadOnly(batch_file_name);
+  if (!batch_file || !batch_file->IsValid()) {
+    std::cerr << "Could not open batch file." << std::endl;
+    return false;
+  }
+
+  // Options of the batch invocation apply to every shader that doesn't
+  // override them.
+  std::vector<std::string> shared_args;
+  if (command_line.HasOption("cache-dir")) {
+    shared_args.push_back(
+        "--cache-dir=" +
+        command_line.GetOptionValueWithDefault("cache-dir", ""));
+  }
+
+  std::vector<Switches> jobs;
+  std::istringstream lines(
+      std::string(reinterpret_cast<const char*>(batch_file->GetMapping()),
+                  batch_file->GetSize()));
+  for (std::string line; std::getline(lines, line);) {
+    std::vector<std::string> args = shared_args;
+    std::istringstream words(line);
+    for (std::string word; words >> word;) {
+      args.push_back(std::move(word));
+    }
+    if (args.size() == shared_args.size()) {
+      continue;
+    }
+    Switches switches(fml::CommandLineFromIteratorsWithArgv0(
+        "impellerc", args.begin(), args.end()));
+    if (!switches.AreValid(std::cerr)) {
+      std::cerr << "Invalid flags specified in batch file: " << line
                 << std::endl;
       return false;
     }
+    jobs.emplace_back(std::move(switches));
+  }
+  if (jobs.empty()) {
+    return true;
   }
 
-  return true;
+  size_t thread_count = std::thread::hardware_concurrency();
+  if (command_line.HasOption("jobs")) {
+    thread_count =
+        std::stoul(command_line.GetOptionValueWithDefault("jobs", "1"));
+  }
+  thread_count = std::clamp<size_t>(thread_count, 1u, jobs.size());
+
+  std::vector<std::stringstream> errors(jobs.size());
+  std::vector<char> succeeded(jobs.size(), false);
+  std::atomic_size_t next_job = 0u;
+  auto compile_jobs = [&]() {
+    for (size_t i = next_job++; i < jobs.size(); i = next_job++) {
+      succeeded[i] = CompileShader(jobs[i], errors[i]);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; i++) {
+    threads.emplace_back(compile_jobs);
+  }
+  compile_jobs();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  bool success = true;
+  for (size_t i = 0; i < jobs.size(); i++) {
+    if (!succeeded[i]) {
+      std::cerr << "Failed to compile " << jobs[i].source_file_name << ":"
+                << std::endl
+                << errors[i].str();
+      success = false;
+    }
+  }
+  return success;
+}
+
+bool Main(const fml::CommandLine& command_line) {
+  fml::InstallCrashHandler();
+  if (command_line.HasOption("help")) {
+    Switches::PrintHelp(std::cout);
+    return true;
+  }
+
+  if (command_line.HasOption("batch")) {
+    return CompileBatch(command_line);
+  }
+
+  Switches switches(command_line);
+  if (!switches.AreValid(std::cerr)) {
+    std::cerr << "Invalid flags specified." << std::endl;
+    Switches::PrintHelp(std::cerr);
+    return false;
+  }
+
+  return CompileShader(switches, std::cerr);
 }
 
 }  // namespace compiler
@@ -6,6 +6,7 @@
 
 #include "impeller/compiler/reflector.h"
 
+#include <algorithm>
 #include <atomic>
 #include <optional>
 #include <set>
@@ -197,6 +198,13 @@ std::optional<nlohmann::json> Reflector::GenerateTemplateArguments() const {
     root["header_file_name"] = options_.header_file_name;
   }
 
+  {
+    auto& instruction_counts = root["instruction_counts"] =
+        nlohmann::json::object_t{};
+    instruction_counts["unoptimized"] = options_.unoptimized_instruction_count;
+    instruction_counts["optimized"] = options_.instruction_count;
+  }
+
   const auto shader_resources = compiler_->get_shader_resources();
 
   // Uniform and storage buffers.
@@ -205,8 +213,11 @@ std::optional<nlohmann::json> Reflector::GenerateTemplateArguments() const {
     if (auto uniform_buffers_json =
             ReflectResources(shader_resources.uniform_buffers);
         uniform_buffers_json.has_value()) {
-      for (auto uniform_buffer : uniform_buffers_json.value()) {
+      for (size_t i = 0; i < uniform_buffers_json->size(); i++) {
+        auto uniform_buffer = uniform_buffers_json.value()[i];
         uniform_buffer["descriptor_type"] = "DescriptorType::kUniformBuffer";
+        uniform_buffer["packing"] = ReflectUniformPacking(
+            shader_resources.uniform_buffers[i].base_type_id);
         buffers.emplace_back(std::move(uniform_buffer));
       }
     } else {
@@ -429,6 +440,58 @@ std::optional<nlohmann::json::object_t> Reflector::ReflectResource(
   return result;
 }
 
+/// The std140 base alignment of a member of a uniform block.
+static size_t GetStd140Alignment(const spirv_cross::SPIRType& type) {
+  if (!type.array.empty() || type.columns > 1 ||
+      type.basetype == spirv_cross::SPIRType::BaseType::Struct) {
+    // Arrays, matrices and structs are aligned to four components.
+    return 16u;
+  }
+  const size_t component_size = type.width / 8;
+  return component_size * (type.vecsize == 3 ? 4 : type.vecsize);
+}
+
+nlohmann::json::object_t Reflector::ReflectUniformPacking(
+    const spirv_cross::TypeID& type_id) const {
+  nlohmann::json::object_t result;
+  const auto& type = compiler_->get_type(type_id);
+  if (type.basetype != spirv_cross::SPIRType::BaseType::Struct) {
+    return result;
+  }
+
+  struct Member {
+    size_t alignment = 0u;
+    size_t size = 0u;
+  };
+  std::vector<Member> members;
+  size_t members_size = 0u;
+  for (size_t i = 0; i < type.member_types.size(); i++) {
+    const auto& member_type = compiler_->get_type(type.member_types[i]);
+    const auto size = compiler_->get_declared_struct_member_size(type, i);
+    members.push_back({GetStd140Alignment(member_type), size});
+    members_size += size;
+  }
+  const auto byte_length = compiler_->get_declared_struct_size(type);
+
+  // Laying out the members in order of decreasing alignment leaves padding
+  // only where a member is smaller than its alignment.
+  std::stable_sort(members.begin(), members.end(),
+                   [](const Member& a, const Member& b) {
+                     return a.alignment > b.alignment;
+                   });
+  size_t packed_byte_length = 0u;
+  for (const auto& member : members) {
+    packed_byte_length = (packed_byte_length + member.alignment - 1) /
+                             member.alignment * member.alignment +
+                         member.size;
+  }
+
+  result["byte_length"] = byte_length;
+  result["padding_bytes"] = byte_length - std::min(byte_length, members_size);
+  result["packed_byte_length"] = std::min(byte_length, packed_byte_length);
+  return result;
+}
+
 std::optional<nlohmann::json::object_t> Reflector::ReflectType(
     const spirv_cross::TypeID& type_id) const {
   nlohmann::json::object_t result;
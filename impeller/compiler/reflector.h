@@ -53,6 +53,10 @@ class Reflector {
     std::string entry_point_name;
     std::string shader_name;
     std::string header_file_name;
+    /// The number of SPIR-V instructions of the shader before and after the
+    /// optimization passes.
+    size_t unoptimized_instruction_count = 0u;
+    size_t instruction_count = 0u;
   };
 
   Reflector(Options options,
@@ -121,6 +125,15 @@ class Reflector {
   std::optional<nlohmann::json::object_t> ReflectType(
       const spirv_cross::TypeID& type_id) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Reports the std140 padding of a uniform block and the size it
+  ///             would have with its members declared in order of decreasing
+  ///             alignment. Members are never reordered by the compiler since
+  ///             uniform data is written in declaration order.
+  ///
+  nlohmann::json::object_t ReflectUniformPacking(
+      const spirv_cross::TypeID& type_id) const;
+
   nlohmann::json::object_t EmitStructDefinition(
       std::optional<Reflector::StructDefinition> struc) const;
 
@@ -33,6 +33,10 @@ struct SourceOptions {
   /// opengl semantics. Only used on metal targets.
   bool use_half_textures = false;
 
+  /// @brief The SPIR-V optimization passes to run. SkSL is never optimized
+  /// since the optimized control flow can't be expressed in it.
+  OptimizationLevel optimization_level = OptimizationLevel::kPerformance;
+
   SourceOptions();
 
   ~SourceOptions();
@@ -28,6 +28,13 @@ static const std::map<std::string, TargetPlatform> kKnownPlatforms = {
     {"runtime-stage-vulkan", TargetPlatform::kRuntimeStageVulkan},
 };
 
+static const std::map<std::string, OptimizationLevel>
+    kKnownOptimizationLevels = {
+        {"none", OptimizationLevel::kNone},
+        {"performance", OptimizationLevel::kPerformance},
+        {"size", OptimizationLevel::kSize},
+};
+
 static const std::map<std::string, SourceType> kKnownSourceTypes = {
     {"vert", SourceType::kVertexShader},
     {"frag", SourceType::kFragmentShader},
@@ -75,6 +82,21 @@ void Switches::PrintHelp(std::ostream& stream) {
   stream << "[optional] --use-half-textures (force openGL semantics when "
             "targeting metal)"
          << std::endl;
+  stream << "[optional] --optimization-level={";
+  for (const auto& level : kKnownOptimizationLevels) {
+    stream << level.first << ", ";
+  }
+  stream << "} (default: performance)" << std::endl;
+  stream << "[optional] --cache-dir=<cache_directory> (reuses the outputs of "
+            "earlier compilations with the same sources and options)"
+         << std::endl;
+  stream << "[optional] --batch=<batch_file> (compiles the shaders given by "
+            "the arguments on each line of the file in parallel; replaces "
+            "all other flags but --cache-dir)"
+         << std::endl;
+  stream << "[optional] --jobs=<number> (default: the number of cores; only "
+            "used with --batch)"
+         << std::endl;
 }
 
 Switches::Switches() = default;
@@ -136,7 +158,8 @@ Switches::Switches(const fml::CommandLine& command_line)
           command_line.GetOptionValueWithDefault("metal-version", "1.2")),
       entry_point(
           command_line.GetOptionValueWithDefault("entry-point", "main")),
-      use_half_textures(command_line.HasOption("use-half-textures")) {
+      use_half_textures(command_line.HasOption("use-half-textures")),
+      cache_directory(command_line.GetOptionValueWithDefault("cache-dir", "")) {
   auto language =
       command_line.GetOptionValueWithDefault("source-language", "glsl");
   std::transform(language.begin(), language.end(), language.begin(),
@@ -147,6 +170,16 @@ Switches::Switches(const fml::CommandLine& command_line)
     source_language = SourceLanguage::kHLSL;
   }
 
+  auto optimization_level_option =
+      command_line.GetOptionValueWithDefault("optimization-level",
+                                             "performance");
+  if (auto level = kKnownOptimizationLevels.find(optimization_level_option);
+      level != kKnownOptimizationLevels.end()) {
+    optimization_level = level->second;
+  } else {
+    optimization_level_valid = false;
+  }
+
   if (!working_directory || !working_directory->is_valid()) {
     return;
   }
@@ -202,6 +235,11 @@ bool Switches::AreValid(std::ostream& explain) const {
     valid = false;
   }
 
+  if (!optimization_level_valid) {
+    explain << "Invalid optimization level." << std::endl;
+    valid = false;
+  }
+
   if (!working_directory || !working_directory->is_valid()) {
     explain << "Could not open the working directory: \""
             << Utf8FromPath(std::filesystem::current_path()).c_str() << "\""
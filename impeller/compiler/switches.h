@@ -37,6 +37,9 @@ struct Switches {
   std::string metal_version = "";
   std::string entry_point = "";
   bool use_half_textures = false;
+  OptimizationLevel optimization_level = OptimizationLevel::kPerformance;
+  std::string cache_directory = "";
+  bool optimization_level_valid = true;
 
   Switches();
 
@@ -87,6 +87,17 @@ std::string SourceLanguageToString(SourceLanguage source_language) {
   }
 }
 
+std::string OptimizationLevelToString(OptimizationLevel level) {
+  switch (level) {
+    case OptimizationLevel::kNone:
+      return "None";
+    case OptimizationLevel::kPerformance:
+      return "Performance";
+    case OptimizationLevel::kSize:
+      return "Size";
+  }
+}
+
 std::string EntryPointFunctionNameFromSourceName(
     const std::string& file_name,
     SourceType type,
@@ -184,6 +195,17 @@ shaderc_shader_kind ToShaderCShaderKind(SourceType type) {
   return shaderc_shader_kind::shaderc_glsl_infer_from_source;
 }
 
+shaderc_optimization_level ToShaderCOptimizationLevel(OptimizationLevel level) {
+  switch (level) {
+    case OptimizationLevel::kNone:
+      return shaderc_optimization_level::shaderc_optimization_level_zero;
+    case OptimizationLevel::kPerformance:
+      return shaderc_optimization_level::shaderc_optimization_level_performance;
+    case OptimizationLevel::kSize:
+      return shaderc_optimization_level::shaderc_optimization_level_size;
+  }
+}
+
 spv::ExecutionModel ToExecutionModel(SourceType type) {
   switch (type) {
     case SourceType::kVertexShader:
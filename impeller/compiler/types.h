@@ -44,6 +44,16 @@ enum class SourceLanguage {
   kHLSL,
 };
 
+/// The pipeline of SPIR-V optimization passes run before cross compilation.
+/// Both levels eliminate dead code, inline functions and fold constants. The
+/// size level also eliminates redundant code more aggressively, taking longer
+/// to compile.
+enum class OptimizationLevel {
+  kNone,
+  kPerformance,
+  kSize,
+};
+
 bool TargetPlatformIsMetal(TargetPlatform platform);
 
 bool TargetPlatformIsOpenGL(TargetPlatform platform);
@@ -58,6 +68,8 @@ std::string TargetPlatformToString(TargetPlatform platform);
 
 std::string SourceLanguageToString(SourceLanguage source_language);
 
+std::string OptimizationLevelToString(OptimizationLevel level);
+
 std::string TargetPlatformSLExtension(TargetPlatform platform);
 
 std::string EntryPointFunctionNameFromSourceName(
@@ -74,6 +86,8 @@ std::string ShaderCErrorToString(shaderc_compilation_status status);
 
 shaderc_shader_kind ToShaderCShaderKind(SourceType type);
 
+shaderc_optimization_level ToShaderCOptimizationLevel(OptimizationLevel level);
+
 spv::ExecutionModel ToExecutionModel(SourceType type);
 
 spirv_cross::CompilerMSL::Options::Platform TargetPlatformToMSLPlatform(
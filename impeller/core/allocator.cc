@@ -42,7 +42,11 @@ std::shared_ptr<DeviceBuffer> Allocator::CreateBufferWithCopy(
 
 std::shared_ptr<DeviceBuffer> Allocator::CreateBuffer(
     const DeviceBufferDescriptor& desc) {
-  return OnCreateBuffer(desc);
+  auto buffer = OnCreateBuffer(desc);
+  if (buffer) {
+    total_allocated_bytes_ += desc.size;
+  }
+  return buffer;
 }
 
 std::shared_ptr<Texture> Allocator::CreateTexture(
@@ -55,7 +59,19 @@ std::shared_ptr<Texture> Allocator::CreateTexture(
     return nullptr;
   }
 
-  return OnCreateTexture(desc);
+  auto texture = OnCreateTexture(desc);
+  if (texture) {
+    total_allocated_bytes_ += desc.GetByteSizeOfBaseMipLevel();
+  }
+  return texture;
+}
+
+std::optional<DeviceMemoryBudget> Allocator::GetDeviceMemoryBudget() const {
+  return std::nullopt;
+}
+
+size_t Allocator::GetTotalAllocatedBytes() const {
+  return total_allocated_bytes_;
 }
 
 uint16_t Allocator::MinimumBytesPerRow(PixelFormat format) const {
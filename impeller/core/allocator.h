@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <optional>
 #include <string>
 
 #include "flutter/fml/macros.h"
@@ -17,6 +19,16 @@ class Context;
 class DeviceBuffer;
 class Texture;
 
+//------------------------------------------------------------------------------
+/// @brief      How much device local memory is in use by the process, and how
+///             much it can use before allocations start failing or degrading
+///             the performance of the system.
+///
+struct DeviceMemoryBudget {
+  size_t usage = 0;
+  size_t budget = 0;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      An object that allocates device memory.
 ///
@@ -45,6 +57,21 @@ class Allocator {
 
   virtual ISize GetMaxTextureSizeSupported() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The device local memory budget reported by the driver, or
+  ///             std::nullopt if the backend doesn't track it. Caches may use
+  ///             this to release resources under memory pressure.
+  ///
+  virtual std::optional<DeviceMemoryBudget> GetDeviceMemoryBudget() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of bytes of all the buffers and textures created by
+  ///             this allocator so far, ignoring any that have since been
+  ///             collected. Textures count the size of their base mip level.
+  ///             Benchmarks use this to track the allocations of a workload.
+  ///
+  size_t GetTotalAllocatedBytes() const;
+
  protected:
   Allocator();
 
@@ -55,6 +82,8 @@ class Allocator {
       const TextureDescriptor& desc) = 0;
 
  private:
+  std::atomic<size_t> total_allocated_bytes_ = 0u;
+
   FML_DISALLOW_COPY_AND_ASSIGN(Allocator);
 };
 
@@ -105,6 +105,9 @@ enum class PixelFormat {
   kB10G10R10XR,
   kB10G10R10XRSRGB,
   kB10G10R10A10XR,
+  // Block compressed formats. Only sampled textures that are uploaded from
+  // the host may use them, on devices whose `Capabilities` support them.
+  kETC2R8G8B8UNormInt,
   // Depth and stencil formats.
   kS8UInt,
   kD32FloatS8UInt,
@@ -321,9 +324,38 @@ enum class ColorWriteMask : uint64_t {
   kAll = kRed | kGreen | kBlue | kAlpha,
 };
 
+/// The width and height in pixels of the blocks of pixels that block
+/// compressed formats store together.
+constexpr int64_t kCompressedPixelFormatBlockSize = 4;
+
+constexpr bool IsCompressedPixelFormat(PixelFormat format) {
+  return format == PixelFormat::kETC2R8G8B8UNormInt;
+}
+
+/// The number of blocks of a block compressed format that a row or a column
+/// of `pixels` pixels is stored in. Partial blocks are padded.
+constexpr size_t CompressedBlockCount(int64_t pixels) {
+  return static_cast<size_t>((pixels + kCompressedPixelFormatBlockSize - 1) /
+                             kCompressedPixelFormatBlockSize);
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The number of bytes a block of pixels takes up in a block
+///             compressed format, or 0 for the other formats.
+///
+constexpr size_t BytesPerBlockForPixelFormat(PixelFormat format) {
+  return format == PixelFormat::kETC2R8G8B8UNormInt ? 8u : 0u;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      The number of bytes a pixel takes up, or 0 for the block
+///             compressed formats, whose pixels don't have a size of their
+///             own.
+///
 constexpr size_t BytesPerPixelForPixelFormat(PixelFormat format) {
   switch (format) {
     case PixelFormat::kUnknown:
+    case PixelFormat::kETC2R8G8B8UNormInt:
       return 0u;
     case PixelFormat::kA8UNormInt:
     case PixelFormat::kR8UNormInt:
@@ -12,16 +12,36 @@
 #include "impeller/core/allocator.h"
 #include "impeller/core/buffer_view.h"
 #include "impeller/core/device_buffer.h"
+#include "impeller/core/host_buffer_ring.h"
 
 namespace impeller {
 
 std::shared_ptr<HostBuffer> HostBuffer::Create() {
-  return std::shared_ptr<HostBuffer>(new HostBuffer());
+  return Create(nullptr);
 }
 
-HostBuffer::HostBuffer() = default;
+std::shared_ptr<HostBuffer> HostBuffer::Create(
+    std::shared_ptr<HostBufferRing> ring) {
+  return std::shared_ptr<HostBuffer>(new HostBuffer(std::move(ring)));
+}
+
+static fml::MemoryCounter& GetHostBufferMemoryCounter() {
+  static auto& counter = fml::MemoryCounter::Get("host_buffer");
+  return counter;
+}
+
+HostBuffer::HostBuffer(std::shared_ptr<HostBufferRing> ring)
+    : ring_(std::move(ring)),
+      memory_count_(GetHostBufferMemoryCounter(), 0u) {}
 
-HostBuffer::~HostBuffer() = default;
+HostBuffer::~HostBuffer() {
+  if (!ring_) {
+    return;
+  }
+  for (auto& block : ring_blocks_) {
+    ring_->ReturnBlock(std::move(block));
+  }
+}
 
 void HostBuffer::SetLabel(std::string label) {
   label_ = std::move(label);
@@ -30,6 +50,9 @@ void HostBuffer::SetLabel(std::string label) {
 BufferView HostBuffer::Emplace(const void* buffer,
                                size_t length,
                                size_t align) {
+  if (ring_) {
+    return EmplaceInRing(buffer, length, align);
+  }
   if (align == 0 || (GetLength() % align) == 0) {
     return Emplace(buffer, length);
   }
@@ -49,6 +72,7 @@ BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
   if (!Truncate(old_length + length)) {
     return {};
   }
+  memory_count_.Update(GetReservedLength());
   generation_++;
   if (buffer) {
     ::memmove(GetBuffer() + old_length, buffer, length);
@@ -56,6 +80,36 @@ BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
   return BufferView{shared_from_this(), GetBuffer(), Range{old_length, length}};
 }
 
+BufferView HostBuffer::EmplaceInRing(const void* buffer,
+                                     size_t length,
+                                     size_t align) {
+  auto offset = ring_block_offset_;
+  if (align > 1 && (offset % align) != 0) {
+    offset += align - (offset % align);
+  }
+  if (ring_blocks_.empty() ||
+      offset + length >
+          ring_blocks_.back()->GetDeviceBufferDescriptor().size) {
+    // Start a new block. Unlike the heap backed mode, nothing that was
+    // already written is ever moved.
+    auto block = ring_->AcquireBlock(length);
+    if (!block) {
+      return {};
+    }
+    memory_count_.Update(memory_count_.GetBytes() +
+                         block->GetDeviceBufferDescriptor().size);
+    ring_blocks_.emplace_back(std::move(block));
+    offset = 0u;
+  }
+  const auto& block = ring_blocks_.back();
+  if (buffer && !block->CopyHostBuffer(static_cast<const uint8_t*>(buffer),
+                                       Range{0u, length}, offset)) {
+    return {};
+  }
+  ring_block_offset_ = offset + length;
+  return BufferView{block, block->OnGetContents(), Range{offset, length}};
+}
+
 std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
     Allocator& allocator) const {
   if (generation_ == device_buffer_generation_) {
@@ -8,8 +8,10 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/memory/memory_counter.h"
 #include "impeller/base/allocation.h"
 #include "impeller/core/buffer.h"
 #include "impeller/core/buffer_view.h"
@@ -17,12 +19,27 @@
 
 namespace impeller {
 
+class DeviceBuffer;
+class HostBufferRing;
+
 class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
                          public Allocation,
                          public Buffer {
  public:
   static std::shared_ptr<HostBuffer> Create();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a host buffer that writes its contents directly into
+  ///             persistently mapped blocks acquired from the given ring
+  ///             instead of growing a heap allocation that is copied into a
+  ///             new device buffer when encoded. The buffer views returned
+  ///             by such a host buffer refer to the blocks themselves.
+  ///
+  ///             If |ring| is nullptr, this is the same as |Create|.
+  ///
+  static std::shared_ptr<HostBuffer> Create(
+      std::shared_ptr<HostBufferRing> ring);
+
   // |Buffer|
   virtual ~HostBuffer();
 
@@ -96,10 +113,16 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
                                    size_t align);
 
  private:
+  const std::shared_ptr<HostBufferRing> ring_;
+  std::vector<std::shared_ptr<DeviceBuffer>> ring_blocks_;
+  size_t ring_block_offset_ = 0u;
   mutable std::shared_ptr<DeviceBuffer> device_buffer_;
   mutable size_t device_buffer_generation_ = 0u;
   size_t generation_ = 1u;
   std::string label_;
+  // Counts the heap allocation, or the ring blocks held, on the "host_buffer"
+  // memory counter.
+  fml::ScopedMemoryCount memory_count_;
 
   // |Buffer|
   std::shared_ptr<const DeviceBuffer> GetDeviceBuffer(
@@ -107,7 +130,11 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
 
   [[nodiscard]] BufferView Emplace(const void* buffer, size_t length);
 
-  HostBuffer();
+  [[nodiscard]] BufferView EmplaceInRing(const void* buffer,
+                                         size_t length,
+                                         size_t align);
+
+  explicit HostBuffer(std::shared_ptr<HostBufferRing> ring);
 
   FML_DISALLOW_COPY_AND_ASSIGN(HostBuffer);
 };
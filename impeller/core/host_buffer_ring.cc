@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/core/host_buffer_ring.h"
+
+#include <string>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
+
+namespace impeller {
+
+HostBufferRing::HostBufferRing(std::shared_ptr<Allocator> allocator,
+                               size_t block_length,
+                               size_t max_retained_blocks)
+    : allocator_(std::move(allocator)),
+      block_length_(block_length),
+      max_retained_blocks_(max_retained_blocks) {
+  FML_DCHECK(block_length_ > 0u);
+}
+
+HostBufferRing::~HostBufferRing() = default;
+
+size_t HostBufferRing::GetBlockLength() const {
+  return block_length_;
+}
+
+std::shared_ptr<DeviceBuffer> HostBufferRing::AcquireBlock(size_t min_length) {
+  if (min_length > block_length_) {
+    return CreateBlock(min_length);
+  }
+  {
+    Lock lock(mutex_);
+    // Blocks are handed back in the order they were used. If the oldest one
+    // is still referenced by a pending command buffer, the newer ones are
+    // too.
+    if (!blocks_.empty() && blocks_.front().use_count() == 1) {
+      auto block = std::move(blocks_.front());
+      blocks_.pop_front();
+      recycled_block_count_++;
+      return block;
+    }
+  }
+  return CreateBlock(block_length_);
+}
+
+void HostBufferRing::ReturnBlock(std::shared_ptr<DeviceBuffer> block) {
+  if (!block || block->GetDeviceBufferDescriptor().size != block_length_) {
+    return;
+  }
+  Lock lock(mutex_);
+  if (blocks_.size() >= max_retained_blocks_) {
+    return;
+  }
+  blocks_.emplace_back(std::move(block));
+}
+
+size_t HostBufferRing::GetRetainedBlockCount() const {
+  Lock lock(mutex_);
+  return blocks_.size();
+}
+
+size_t HostBufferRing::GetRecycledBlockCount() const {
+  Lock lock(mutex_);
+  return recycled_block_count_;
+}
+
+size_t HostBufferRing::GetAllocatedBlockCount() const {
+  Lock lock(mutex_);
+  return allocated_block_count_;
+}
+
+std::shared_ptr<DeviceBuffer> HostBufferRing::CreateBlock(size_t length) {
+  TRACE_EVENT1("impeller", "HostBufferRing::CreateBlock", "Length",
+               std::to_string(length).c_str());
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = length;
+  auto block = allocator_->CreateBuffer(desc);
+  if (!block || block->OnGetContents() == nullptr) {
+    return nullptr;
+  }
+  block->SetLabel("HostBufferRing Block");
+  if (length == block_length_) {
+    Lock lock(mutex_);
+    allocated_block_count_++;
+  }
+  return block;
+}
+
+}  // namespace impeller
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+class Allocator;
+class DeviceBuffer;
+
+//------------------------------------------------------------------------------
+/// @brief      A ring of persistently mapped, host visible device buffer
+///             blocks that |HostBuffer|s write their contents into directly.
+///
+///             A host buffer backed by a ring never needs to be copied into
+///             a fresh device buffer when it is encoded. Instead, it
+///             acquires blocks from the ring as it fills up and hands them
+///             back when it is destroyed. Handed back blocks are queued in
+///             the order in which they were used, one frame after the other.
+///
+///             A block is only reused once the ring holds the last
+///             reference to it. Backends that track the device buffers
+///             referenced by a command buffer until its fence is signaled
+///             (like Vulkan) therefore recycle a frame's blocks exactly when
+///             the GPU is done reading from them. Backends that don't
+///             guarantee this must not vend a ring.
+///
+///             The ring is thread-safe.
+///
+class HostBufferRing {
+ public:
+  static constexpr size_t kDefaultBlockLength = 256u * 1024u;
+  static constexpr size_t kDefaultMaxRetainedBlocks = 16u;
+
+  explicit HostBufferRing(
+      std::shared_ptr<Allocator> allocator,
+      size_t block_length = kDefaultBlockLength,
+      size_t max_retained_blocks = kDefaultMaxRetainedBlocks);
+
+  ~HostBufferRing();
+
+  size_t GetBlockLength() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a block that can hold at least |min_length| bytes.
+  ///             The oldest handed back block is reused if the GPU is done
+  ///             with it. Requests larger than the block length are given a
+  ///             dedicated buffer that will not be retained by the ring.
+  ///
+  /// @return     The block, or nullptr if the allocation failed.
+  ///
+  std::shared_ptr<DeviceBuffer> AcquireBlock(size_t min_length);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hands back a block obtained from |AcquireBlock| once the
+  ///             host buffer using it will not write to it anymore.
+  ///
+  void ReturnBlock(std::shared_ptr<DeviceBuffer> block);
+
+  size_t GetRetainedBlockCount() const;
+
+  size_t GetRecycledBlockCount() const;
+
+  size_t GetAllocatedBlockCount() const;
+
+ private:
+  const std::shared_ptr<Allocator> allocator_;
+  const size_t block_length_;
+  const size_t max_retained_blocks_;
+  mutable Mutex mutex_;
+  std::deque<std::shared_ptr<DeviceBuffer>> blocks_ IPLR_GUARDED_BY(mutex_);
+  size_t recycled_block_count_ IPLR_GUARDED_BY(mutex_) = 0u;
+  size_t allocated_block_count_ IPLR_GUARDED_BY(mutex_) = 0u;
+
+  std::shared_ptr<DeviceBuffer> CreateBlock(size_t length);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(HostBufferRing);
+};
+
+}  // namespace impeller
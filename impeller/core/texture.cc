@@ -69,6 +69,14 @@ TextureIntent Texture::GetIntent() const {
   return intent_;
 }
 
+void Texture::SetImmutable() {
+  immutable_ = true;
+}
+
+bool Texture::IsImmutable() const {
+  return immutable_;
+}
+
 Scalar Texture::GetYCoordScale() const {
   return 1.0;
 }
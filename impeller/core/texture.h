@@ -39,6 +39,13 @@ class Texture {
 
   TextureIntent GetIntent() const;
 
+  /// Marks the contents of the texture as final, for textures such as
+  /// decoded images. Immutable textures may be copied into caches, like the
+  /// image atlas, and drawn from the copy.
+  void SetImmutable();
+
+  bool IsImmutable() const;
+
   virtual Scalar GetYCoordScale() const;
 
   bool NeedsMipmapGeneration() const;
@@ -58,6 +65,7 @@ class Texture {
 
  private:
   TextureIntent intent_ = TextureIntent::kRenderToTexture;
+  bool immutable_ = false;
   const TextureDescriptor desc_;
 
   bool IsSliceValid(size_t slice) const;
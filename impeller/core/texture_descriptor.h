@@ -40,13 +40,22 @@ struct TextureDescriptor {
     if (!IsValid()) {
       return 0u;
     }
+    if (IsCompressedPixelFormat(format)) {
+      return CompressedBlockCount(size.height) * GetBytesPerRow();
+    }
     return size.Area() * BytesPerPixelForPixelFormat(format);
   }
 
+  /// The number of bytes in a row of pixels, or in a row of blocks of pixels
+  /// for the block compressed formats.
   constexpr size_t GetBytesPerRow() const {
     if (!IsValid()) {
       return 0u;
     }
+    if (IsCompressedPixelFormat(format)) {
+      return CompressedBlockCount(size.width) *
+             BytesPerBlockForPixelFormat(format);
+    }
     return size.width * BytesPerPixelForPixelFormat(format);
   }
 
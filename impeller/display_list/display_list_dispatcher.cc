@@ -43,6 +43,10 @@ namespace impeller {
 
 DisplayListDispatcher::DisplayListDispatcher() = default;
 
+DisplayListDispatcher::DisplayListDispatcher(
+    std::shared_ptr<DisplayListEntityCache> entity_cache)
+    : entity_cache_(std::move(entity_cache)) {}
+
 DisplayListDispatcher::~DisplayListDispatcher() = default;
 
 static BlendMode ToBlendMode(flutter::DlBlendMode mode) {
@@ -639,6 +643,111 @@ void DisplayListDispatcher::setMaskFilter(const flutter::DlMaskFilter* filter) {
   }
 }
 
+/// Returns the color filter applied by |filter| if it is a color filter image
+/// filter, or nullptr otherwise.
+static const flutter::DlColorFilter* GetColorFilterOfImageFilter(
+    const flutter::DlImageFilter* filter) {
+  if (filter == nullptr) {
+    return nullptr;
+  }
+  auto color_filter_image_filter = filter->asColorFilter();
+  if (color_filter_image_filter == nullptr) {
+    return nullptr;
+  }
+  return color_filter_image_filter->color_filter().get();
+}
+
+/// Whether |matrix| maps every unpremultiplied color in the unit cube back into
+/// the unit cube, in which case the clamp applied after it is a no-op.
+static bool ColorMatrixPreservesRange(
+    const FilterContents::ColorMatrix& matrix) {
+  for (size_t row = 0; row < 4; row++) {
+    const float* coefficients = &matrix.array[row * 5];
+    Scalar min = coefficients[4];
+    Scalar max = coefficients[4];
+    for (size_t column = 0; column < 4; column++) {
+      min += std::min(coefficients[column], 0.0f);
+      max += std::max(coefficients[column], 0.0f);
+    }
+    if (min < 0.0f || max > 1.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Returns the color matrix equivalent to applying |inner| and then |outer|.
+static FilterContents::ColorMatrix ConcatColorMatrices(
+    const FilterContents::ColorMatrix& outer,
+    const FilterContents::ColorMatrix& inner) {
+  FilterContents::ColorMatrix result;
+  for (size_t row = 0; row < 4; row++) {
+    for (size_t column = 0; column < 5; column++) {
+      Scalar value = column == 4 ? outer.array[row * 5 + 4] : 0.0f;
+      for (size_t k = 0; k < 4; k++) {
+        value += outer.array[row * 5 + k] * inner.array[k * 5 + column];
+      }
+      result.array[row * 5 + column] = value;
+    }
+  }
+  return result;
+}
+
+/// Attempts to replace the composition `outer(inner(input))` with a single
+/// filter that renders the same result in one pass instead of two.
+///
+/// Two color matrices are folded into one when doing so cannot change the
+/// result: the intermediate clamp must be a no-op, and the outer alpha may
+/// only scale the inner alpha so that colors lost to the intermediate
+/// premultiply cannot reappear. Two matrix filters with the same sampling are
+/// folded into a single sampling transform.
+static std::optional<Paint::ImageFilterProc> FoldComposedImageFilters(
+    const flutter::DlImageFilter* outer,
+    const flutter::DlImageFilter* inner) {
+  if (outer == nullptr || inner == nullptr) {
+    return std::nullopt;
+  }
+
+  auto outer_color_filter = GetColorFilterOfImageFilter(outer);
+  auto inner_color_filter = GetColorFilterOfImageFilter(inner);
+  if (outer_color_filter != nullptr && inner_color_filter != nullptr &&
+      outer_color_filter->asMatrix() != nullptr &&
+      inner_color_filter->asMatrix() != nullptr) {
+    FilterContents::ColorMatrix outer_matrix;
+    FilterContents::ColorMatrix inner_matrix;
+    outer_color_filter->asMatrix()->get_matrix(outer_matrix.array);
+    inner_color_filter->asMatrix()->get_matrix(inner_matrix.array);
+    bool outer_only_scales_alpha =
+        outer_matrix.array[15] == 0.0f && outer_matrix.array[16] == 0.0f &&
+        outer_matrix.array[17] == 0.0f && outer_matrix.array[19] == 0.0f;
+    if (!outer_only_scales_alpha || !ColorMatrixPreservesRange(inner_matrix)) {
+      return std::nullopt;
+    }
+    auto color_matrix = ConcatColorMatrices(outer_matrix, inner_matrix);
+    return [color_matrix](FilterInput::Ref input,
+                          const Matrix& effect_transform, bool is_subpass) {
+      return ColorFilterContents::MakeColorMatrix({std::move(input)},
+                                                  color_matrix);
+    };
+  }
+
+  auto outer_matrix_filter = outer->asMatrix();
+  auto inner_matrix_filter = inner->asMatrix();
+  if (outer_matrix_filter != nullptr && inner_matrix_filter != nullptr &&
+      outer_matrix_filter->sampling() == inner_matrix_filter->sampling()) {
+    auto matrix = ToMatrix(outer_matrix_filter->matrix()) *
+                  ToMatrix(inner_matrix_filter->matrix());
+    auto desc = ToSamplerDescriptor(outer_matrix_filter->sampling());
+    return [matrix, desc](FilterInput::Ref input,
+                          const Matrix& effect_transform, bool is_subpass) {
+      return FilterContents::MakeMatrixFilter(std::move(input), matrix, desc,
+                                              effect_transform, is_subpass);
+    };
+  }
+
+  return std::nullopt;
+}
+
 static std::optional<Paint::ImageFilterProc> ToImageFilterProc(
     const flutter::DlImageFilter* filter) {
   if (filter == nullptr) {
@@ -713,6 +822,10 @@ static std::optional<Paint::ImageFilterProc> ToImageFilterProc(
       FML_DCHECK(compose);
       auto outer = compose->outer();
       auto inner = compose->inner();
+      auto folded_proc = FoldComposedImageFilters(outer.get(), inner.get());
+      if (folded_proc.has_value()) {
+        return folded_proc;
+      }
       auto outer_proc = ToImageFilterProc(outer.get());
       auto inner_proc = ToImageFilterProc(inner.get());
       if (!outer_proc.has_value()) {
@@ -1139,7 +1252,11 @@ void DisplayListDispatcher::drawDisplayList(
     canvas_.SaveLayer(save_paint);
   }
 
-  display_list->Dispatch(*this);
+  if (entity_cache_ && canvas_.GetCurrentTransformation().IsAffine()) {
+    DrawCachedDisplayList(*display_list);
+  } else {
+    display_list->Dispatch(*this);
+  }
 
   // Restore all saved state back to what it was before we interpreted
   // the display_list
@@ -1148,6 +1265,37 @@ void DisplayListDispatcher::drawDisplayList(
   paint_ = saved_paint;
 }
 
+void DisplayListDispatcher::DrawCachedDisplayList(
+    const flutter::DisplayList& display_list) {
+  const Matrix transform = canvas_.GetCurrentTransformation();
+  const Matrix basis = transform.Basis();
+
+  const EntityPass* pass =
+      entity_cache_->Get(display_list.unique_id(), basis);
+  if (!pass) {
+    TRACE_EVENT0("impeller", "DisplayListDispatcher::TranslateDisplayList");
+    DisplayListDispatcher recorder(entity_cache_);
+    // Recording below the root save keeps a leading drawPaint from being
+    // absorbed into the clear color of the pass, and restoring it resets any
+    // clips the display list leaves behind.
+    recorder.canvas_.Save();
+    recorder.canvas_.Transform(basis);
+    recorder.initial_matrix_ = basis;
+    display_list.Dispatch(recorder);
+    recorder.canvas_.RestoreToCount(1);
+    pass = entity_cache_->Put(display_list.unique_id(), basis,
+                              recorder.EndRecordingAsPicture().pass);
+  }
+
+  // The cached entities already carry the basis, so only the translation is
+  // left to apply.
+  canvas_.Save();
+  canvas_.ResetTransform();
+  canvas_.Translate({transform.m[12], transform.m[13], 0});
+  canvas_.DrawPicture(Picture{.pass = pass->Clone()});
+  canvas_.Restore();
+}
+
 // |flutter::DlOpReceiver|
 void DisplayListDispatcher::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                          SkScalar x,
@@ -1213,12 +1361,16 @@ void DisplayListDispatcher::drawShadow(const SkPath& path,
   canvas_.PreConcat(
       Matrix::MakeTranslation(Vector2(0, -occluder_z * light_position.y)));
 
+  // Rects, circles and rrects with circular corners, which include stadiums,
+  // are blurred analytically. The blurred masks of other paths are cached
+  // across frames by the path's generation ID.
   SkRect rect;
   SkRRect rrect;
   SkRect oval;
   if (path.isRect(&rect)) {
     canvas_.DrawRect(skia_conversions::ToRect(rect), paint);
-  } else if (path.isRRect(&rrect) && rrect.isSimple()) {
+  } else if (path.isRRect(&rrect) && rrect.isSimple() &&
+             rrect.getSimpleRadii().fX == rrect.getSimpleRadii().fY) {
     canvas_.DrawRRect(skia_conversions::ToRect(rrect.rect()),
                       rrect.getSimpleRadii().fX, paint);
   } else if (path.isOval(&oval) && oval.width() == oval.height()) {
@@ -8,6 +8,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/aiks/canvas.h"
 #include "impeller/aiks/paint.h"
+#include "impeller/display_list/display_list_entity_cache.h"
 
 namespace impeller {
 
@@ -15,6 +16,12 @@ class DisplayListDispatcher final : public flutter::DlOpReceiver {
  public:
   DisplayListDispatcher();
 
+  /// Translates the nested display lists that are drawn with
+  /// |drawDisplayList| through |entity_cache|, which keeps them across
+  /// frames.
+  explicit DisplayListDispatcher(
+      std::shared_ptr<DisplayListEntityCache> entity_cache);
+
   ~DisplayListDispatcher();
 
   Picture EndRecordingAsPicture();
@@ -219,6 +226,11 @@ class DisplayListDispatcher final : public flutter::DlOpReceiver {
   Paint paint_;
   Canvas canvas_;
   Matrix initial_matrix_;
+  std::shared_ptr<DisplayListEntityCache> entity_cache_;
+
+  // Draws a display list from the entity pass it was translated into under
+  // the current transform basis, translating it first if it isn't cached.
+  void DrawCachedDisplayList(const flutter::DisplayList& display_list);
 
   FML_DISALLOW_COPY_AND_ASSIGN(DisplayListDispatcher);
 };
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/display_list_entity_cache.h"
+
+#include <algorithm>
+
+namespace impeller {
+
+DisplayListEntityCache::DisplayListEntityCache() = default;
+
+DisplayListEntityCache::~DisplayListEntityCache() = default;
+
+const EntityPass* DisplayListEntityCache::Get(uint32_t display_list_id,
+                                              const Matrix& basis) {
+  auto found = entries_.find(display_list_id);
+  if (found == entries_.end()) {
+    return nullptr;
+  }
+  for (auto& entry : found->second) {
+    if (entry.basis == basis) {
+      entry.used = true;
+      return entry.pass.get();
+    }
+  }
+  return nullptr;
+}
+
+const EntityPass* DisplayListEntityCache::Put(
+    uint32_t display_list_id,
+    const Matrix& basis,
+    std::unique_ptr<EntityPass> pass) {
+  auto& entries = entries_[display_list_id];
+  entries.push_back(Entry{.basis = basis, .pass = std::move(pass)});
+  return entries.back().pass.get();
+}
+
+void DisplayListEntityCache::EndFrame() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    auto& entries = it->second;
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const Entry& entry) { return !entry.used; }),
+                  entries.end());
+    for (auto& entry : entries) {
+      entry.used = false;
+    }
+    if (entries.empty()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+size_t DisplayListEntityCache::GetEntryCount() const {
+  size_t count = 0;
+  for (const auto& [id, entries] : entries_) {
+    count += entries.size();
+  }
+  return count;
+}
+
+}  // namespace impeller
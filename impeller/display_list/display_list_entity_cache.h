@@ -0,0 +1,65 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/entity/entity_pass.h"
+#include "impeller/geometry/matrix.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the entity passes that retained display lists were
+///             translated into, so that the display lists that are drawn
+///             again in the next frame don't have to be dispatched again.
+///
+///             A pass is recorded under the transform the display list is
+///             drawn with, less its translation. It can be reused for any
+///             transform that only differs from that one by a translation.
+///
+///             Entries that were not used during a frame are dropped at the
+///             end of it. The cache must only be used on one thread.
+///
+class DisplayListEntityCache {
+ public:
+  DisplayListEntityCache();
+
+  ~DisplayListEntityCache();
+
+  /// @brief  Gets the pass recorded for the display list with the given
+  ///         unique ID under the given transform basis, or nullptr.
+  const EntityPass* Get(uint32_t display_list_id, const Matrix& basis);
+
+  /// @brief  Stores the pass recorded for the display list with the given
+  ///         unique ID under the given transform basis.
+  ///
+  /// @return The stored pass.
+  const EntityPass* Put(uint32_t display_list_id,
+                        const Matrix& basis,
+                        std::unique_ptr<EntityPass> pass);
+
+  /// @brief  Drops the entries that were not used since the last call.
+  void EndFrame();
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct Entry {
+    Matrix basis;
+    std::unique_ptr<EntityPass> pass;
+    bool used = true;
+  };
+
+  std::unordered_map<uint32_t, std::vector<Entry>> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListEntityCache);
+};
+
+}  // namespace impeller
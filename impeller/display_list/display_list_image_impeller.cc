@@ -32,6 +32,9 @@ sk_sp<DlImageImpeller> DlImageImpeller::MakeFromYUVTextures(
   entity.SetBlendMode(impeller::BlendMode::kSource);
   auto snapshot = yuv_to_rgb_filter_contents->RenderToSnapshot(
       aiks_context->GetContentContext(), entity);
+  if (!snapshot.has_value()) {
+    return nullptr;
+  }
   return impeller::DlImageImpeller::Make(snapshot->texture);
 }
 
@@ -17,6 +17,8 @@
 #include "flutter/display_list/effects/dl_image_filter.h"
 #include "flutter/display_list/effects/dl_mask_filter.h"
 #include "flutter/testing/testing.h"
+#include "impeller/display_list/display_list_dispatcher.h"
+#include "impeller/display_list/display_list_entity_cache.h"
 #include "impeller/display_list/display_list_image_impeller.h"
 #include "impeller/display_list/display_list_playground.h"
 #include "impeller/geometry/constants.h"
@@ -48,6 +50,38 @@ TEST_P(DisplayListTest, CanDrawRect) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+TEST_P(DisplayListTest, NestedDisplayListIsTranslatedOnce) {
+  flutter::DisplayListBuilder child_builder;
+  child_builder.DrawRect(SkRect::MakeXYWH(0, 0, 10, 10),
+                         flutter::DlPaint(flutter::DlColor::kBlue()));
+  auto child = child_builder.Build();
+
+  auto entity_cache = std::make_shared<DisplayListEntityCache>();
+  for (int frame = 0; frame < 2; frame++) {
+    flutter::DisplayListBuilder builder;
+    builder.Translate(frame * 10, 0);
+    builder.DrawDisplayList(child);
+
+    DisplayListDispatcher dispatcher(entity_cache);
+    builder.Build()->Dispatch(dispatcher);
+    auto picture = dispatcher.EndRecordingAsPicture();
+    entity_cache->EndFrame();
+    ASSERT_EQ(entity_cache->GetEntryCount(), 1u);
+
+    std::vector<Matrix> transforms;
+    picture.pass->IterateAllEntities([&transforms](Entity& entity) {
+      transforms.push_back(entity.GetTransformation());
+      return true;
+    });
+    ASSERT_EQ(transforms.size(), 1u);
+    ASSERT_EQ(transforms[0], Matrix::MakeTranslation({frame * 10.0f, 0, 0}));
+  }
+
+  // The cached pass is dropped once a frame doesn't draw the display list.
+  entity_cache->EndFrame();
+  ASSERT_EQ(entity_cache->GetEntryCount(), 0u);
+}
+
 TEST_P(DisplayListTest, CanDrawTextBlob) {
   flutter::DisplayListBuilder builder;
   builder.DrawTextBlob(SkTextBlob::MakeFromString("Hello", CreateTestFont()),
@@ -573,6 +607,46 @@ TEST_P(DisplayListTest, CanClampTheResultingColorOfColorMatrixFilter) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+TEST_P(DisplayListTest, CanDrawWithFoldedComposeImageFilters) {
+  auto texture = CreateTextureForFixture("boston.jpg");
+  const float invert_color_matrix[20] = {
+      -1, 0,  0,  0, 1,  //
+      0,  -1, 0,  0, 1,  //
+      0,  0,  -1, 0, 1,  //
+      0,  0,  0,  1, 0,  //
+  };
+  const float grayscale_color_matrix[20] = {
+      0.2126, 0.7152, 0.0722, 0,   0,  //
+      0.2126, 0.7152, 0.0722, 0,   0,  //
+      0.2126, 0.7152, 0.0722, 0,   0,  //
+      0,      0,      0,      0.5, 0,  //
+  };
+  auto invert = std::make_shared<flutter::DlColorFilterImageFilter>(
+      std::make_shared<flutter::DlMatrixColorFilter>(invert_color_matrix));
+  auto grayscale = std::make_shared<flutter::DlColorFilterImageFilter>(
+      std::make_shared<flutter::DlMatrixColorFilter>(grayscale_color_matrix));
+  auto color_matrices =
+      std::make_shared<flutter::DlComposeImageFilter>(grayscale, invert);
+
+  auto rotate = std::make_shared<flutter::DlMatrixImageFilter>(
+      SkMatrix::RotateDeg(10), flutter::DlImageSampling::kLinear);
+  auto scale = std::make_shared<flutter::DlMatrixImageFilter>(
+      SkMatrix::Scale(0.5, 0.5), flutter::DlImageSampling::kLinear);
+  auto matrices =
+      std::make_shared<flutter::DlComposeImageFilter>(rotate, scale);
+
+  flutter::DisplayListBuilder builder;
+  flutter::DlPaint paint;
+  paint.setImageFilter(color_matrices.get());
+  builder.DrawImage(DlImageImpeller::Make(texture), SkPoint::Make(100, 100),
+                    flutter::DlImageSampling::kNearestNeighbor, &paint);
+  builder.Translate(0, 700);
+  paint.setImageFilter(matrices.get());
+  builder.DrawImage(DlImageImpeller::Make(texture), SkPoint::Make(100, 100),
+                    flutter::DlImageSampling::kNearestNeighbor, &paint);
+  ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
+}
+
 TEST_P(DisplayListTest, CanDrawBackdropFilter) {
   auto texture = CreateTextureForFixture("embarcadero.jpg");
 
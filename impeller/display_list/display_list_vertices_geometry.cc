@@ -8,6 +8,7 @@
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/position_color.vert.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/entity/texture_fill.vert.h"
 #include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path_builder.h"
@@ -101,6 +102,62 @@ static PrimitiveType GetPrimitiveType(const flutter::DlVertices* vertices) {
   }
 }
 
+// Uploads the data and the indices of a mesh. Meshes with a key are stored in
+// a device buffer that the tessellation cache keeps across frames, the others
+// go to the transients buffer of the pass.
+static std::optional<VertexBuffer> UploadVertices(
+    const ContentContext& renderer,
+    RenderPass& pass,
+    std::optional<TessellationCache::Key> key,
+    const void* vertex_data,
+    size_t total_vtx_bytes,
+    size_t vertex_alignment,
+    const uint16_t* indices,
+    size_t index_count) {
+  size_t total_idx_bytes = index_count * sizeof(uint16_t);
+  if (!key.has_value()) {
+    auto& host_buffer = pass.GetTransientsBuffer();
+    return VertexBuffer{
+        .vertex_buffer =
+            host_buffer.Emplace(vertex_data, total_vtx_bytes, vertex_alignment),
+        .index_buffer =
+            host_buffer.Emplace(indices, total_idx_bytes, alignof(uint16_t)),
+        .index_count = index_count,
+        .index_type = IndexType::k16bit,
+    };
+  }
+
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
+  buffer_desc.storage_mode = StorageMode::kHostVisible;
+
+  auto buffer =
+      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  if (!buffer) {
+    return std::nullopt;
+  }
+  buffer->SetLabel("Cached Vertices");
+
+  if (!buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(vertex_data),
+                              Range{0, total_vtx_bytes}, 0)) {
+    return std::nullopt;
+  }
+  if (!buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(indices),
+                              Range{0, total_idx_bytes}, total_vtx_bytes)) {
+    return std::nullopt;
+  }
+
+  VertexBuffer vertex_buffer{
+      .vertex_buffer = {.buffer = buffer, .range = Range{0, total_vtx_bytes}},
+      .index_buffer = {.buffer = buffer,
+                       .range = Range{total_vtx_bytes, total_idx_bytes}},
+      .index_count = index_count,
+      .index_type = IndexType::k16bit,
+  };
+  renderer.GetTessellationCache()->Put(key.value(), vertex_buffer);
+  return vertex_buffer;
+}
+
 std::optional<Rect> DLVerticesGeometry::GetTextureCoordinateCoverge() const {
   if (!HasTextureCoordinates()) {
     return std::nullopt;
@@ -137,47 +194,30 @@ GeometryResult DLVerticesGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) {
-  auto index_count = normalized_indices_.size() == 0
-                         ? vertices_->index_count()
-                         : normalized_indices_.size();
-  auto vertex_count = vertices_->vertex_count();
-  auto* dl_indices = normalized_indices_.size() == 0
-                         ? vertices_->indices()
-                         : normalized_indices_.data();
-  auto* dl_vertices = vertices_->vertices();
-
-  size_t total_vtx_bytes = vertex_count * sizeof(float) * 2;
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(dl_vertices),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (!buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(dl_indices)),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
+  auto& cache = *renderer.GetTessellationCache();
+  auto key = TessellationCache::MakeVerticesKey(vertices_->content_hash(),
+                                                /*has_vertex_colors=*/false);
+  auto vertex_buffer = cache.Get(key);
+  if (!vertex_buffer.has_value()) {
+    auto index_count = normalized_indices_.size() == 0
+                           ? vertices_->index_count()
+                           : normalized_indices_.size();
+    auto* dl_indices = normalized_indices_.size() == 0
+                           ? vertices_->indices()
+                           : normalized_indices_.data();
+    vertex_buffer = UploadVertices(
+        renderer, pass,
+        cache.ShouldAdmit(key) ? std::make_optional(key) : std::nullopt,
+        vertices_->vertices(), vertices_->vertex_count() * sizeof(float) * 2,
+        alignof(float), dl_indices, index_count);
+    if (!vertex_buffer.has_value()) {
+      return {};
+    }
   }
 
   return GeometryResult{
       .type = GetPrimitiveType(vertices_),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .index_count = index_count,
-              .index_type = IndexType::k16bit,
-          },
+      .vertex_buffer = vertex_buffer.value(),
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation(),
       .prevent_overdraw = false,
@@ -190,63 +230,49 @@ GeometryResult DLVerticesGeometry::GetPositionColorBuffer(
     RenderPass& pass) {
   using VS = GeometryColorPipeline::VertexShader;
 
-  auto index_count = normalized_indices_.size() == 0
-                         ? vertices_->index_count()
-                         : normalized_indices_.size();
-  auto vertex_count = vertices_->vertex_count();
-  auto* dl_indices = normalized_indices_.size() == 0
-                         ? vertices_->indices()
-                         : normalized_indices_.data();
-  auto* dl_vertices = vertices_->vertices();
-  auto* dl_colors = vertices_->colors();
-
-  std::vector<VS::PerVertexData> vertex_data(vertex_count);
-  {
-    for (auto i = 0; i < vertex_count; i++) {
-      auto dl_color = dl_colors[i];
-      auto color = Color(dl_color.getRedF(), dl_color.getGreenF(),
-                         dl_color.getBlueF(), dl_color.getAlphaF())
-                       .Premultiply();
-      auto sk_point = dl_vertices[i];
-      vertex_data[i] = {
-          .position = Point(sk_point.x(), sk_point.y()),
-          .color = color,
-      };
+  auto& cache = *renderer.GetTessellationCache();
+  auto key = TessellationCache::MakeVerticesKey(vertices_->content_hash(),
+                                                /*has_vertex_colors=*/true);
+  auto vertex_buffer = cache.Get(key);
+  if (!vertex_buffer.has_value()) {
+    auto index_count = normalized_indices_.size() == 0
+                           ? vertices_->index_count()
+                           : normalized_indices_.size();
+    auto vertex_count = vertices_->vertex_count();
+    auto* dl_indices = normalized_indices_.size() == 0
+                           ? vertices_->indices()
+                           : normalized_indices_.data();
+    auto* dl_vertices = vertices_->vertices();
+    auto* dl_colors = vertices_->colors();
+
+    std::vector<VS::PerVertexData> vertex_data(vertex_count);
+    {
+      for (auto i = 0; i < vertex_count; i++) {
+        auto dl_color = dl_colors[i];
+        auto color = Color(dl_color.getRedF(), dl_color.getGreenF(),
+                           dl_color.getBlueF(), dl_color.getAlphaF())
+                         .Premultiply();
+        auto sk_point = dl_vertices[i];
+        vertex_data[i] = {
+            .position = Point(sk_point.x(), sk_point.y()),
+            .color = color,
+        };
+      }
     }
-  }
-
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
 
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (!buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(dl_indices)),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
+    vertex_buffer = UploadVertices(
+        renderer, pass,
+        cache.ShouldAdmit(key) ? std::make_optional(key) : std::nullopt,
+        vertex_data.data(), vertex_data.size() * sizeof(VS::PerVertexData),
+        alignof(VS::PerVertexData), dl_indices, index_count);
+    if (!vertex_buffer.has_value()) {
+      return {};
+    }
   }
 
   return GeometryResult{
       .type = GetPrimitiveType(vertices_),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .index_count = index_count,
-              .index_type = IndexType::k16bit,
-          },
+      .vertex_buffer = vertex_buffer.value(),
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation(),
       .prevent_overdraw = false,
@@ -292,38 +318,18 @@ GeometryResult DLVerticesGeometry::GetPositionUVBuffer(
     }
   }
 
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (!buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(dl_indices)),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
+  // The texture coordinates depend on the draw, so these are not cached.
+  auto vertex_buffer = UploadVertices(
+      renderer, pass, std::nullopt, vertex_data.data(),
+      vertex_data.size() * sizeof(VS::PerVertexData),
+      alignof(VS::PerVertexData), dl_indices, index_count);
+  if (!vertex_buffer.has_value()) {
     return {};
   }
 
   return GeometryResult{
       .type = GetPrimitiveType(vertices_),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .index_count = index_count,
-              .index_type = IndexType::k16bit,
-          },
+      .vertex_buffer = vertex_buffer.value(),
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation(),
       .prevent_overdraw = false,
@@ -45,7 +45,10 @@ Path ToPath(const SkPath& path) {
     };
   };
 
+  // Every segment of a path stores its start point again, so the path takes
+  // up about twice the points of the SkPath.
   PathBuilder builder;
+  builder.Reserve(path.countPoints() * 2, path.countVerbs() + 1);
   PathData data;
   auto verb = SkPath::Verb::kDone_Verb;
   do {
@@ -109,7 +112,10 @@ Path ToPath(const SkPath& path) {
       fill_type = FillType::kNonZero;
       break;
   }
-  return builder.TakePath(fill_type);
+  auto result = builder.TakePath(fill_type);
+  // The generation ID of an SkPath only changes when its geometry does.
+  result.SetIdentity(path.getGenerationID());
+  return result;
 }
 
 Path ToPath(const SkRRect& rrect) {
@@ -2,13 +2,17 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <limits>
 #include <optional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 
 #include "impeller/core/formats.h"
+#include "impeller/core/host_buffer.h"
+#include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
@@ -21,10 +25,52 @@
 #include "impeller/entity/texture_fill.vert.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/sampler_library.h"
-#include "impeller/renderer/vertex_buffer_builder.h"
 
 namespace impeller {
 
+template <typename IndexType>
+static BufferView CreateSpriteIndexBuffer(size_t sprite_count,
+                                          HostBuffer& host_buffer) {
+  std::vector<IndexType> indices(sprite_count * 6);
+  for (size_t i = 0; i < sprite_count; i++) {
+    auto base = static_cast<IndexType>(i * 4);
+    IndexType* quad = &indices[i * 6];
+    quad[0] = base;
+    quad[1] = base + 1;
+    quad[2] = base + 2;
+    quad[3] = base + 1;
+    quad[4] = base + 2;
+    quad[5] = base + 3;
+  }
+  return host_buffer.Emplace(indices.data(), indices.size() * sizeof(IndexType),
+                             alignof(IndexType));
+}
+
+/// Creates a vertex buffer that draws each run of four vertices as a quad.
+/// Sharing the corners of both triangles through the index buffer avoids
+/// generating six vertices per sprite.
+template <typename VertexType>
+static VertexBuffer CreateSpriteVertexBuffer(
+    const std::vector<VertexType>& vertices,
+    HostBuffer& host_buffer) {
+  auto sprite_count = vertices.size() / 4;
+  VertexBuffer buffer;
+  buffer.vertex_buffer =
+      host_buffer.Emplace(vertices.data(), vertices.size() * sizeof(VertexType),
+                          alignof(VertexType));
+  buffer.index_count = sprite_count * 6;
+  if (vertices.size() <= std::numeric_limits<uint16_t>::max() + 1u) {
+    buffer.index_buffer =
+        CreateSpriteIndexBuffer<uint16_t>(sprite_count, host_buffer);
+    buffer.index_type = IndexType::k16bit;
+  } else {
+    buffer.index_buffer =
+        CreateSpriteIndexBuffer<uint32_t>(sprite_count, host_buffer);
+    buffer.index_type = IndexType::k32bit;
+  }
+  return buffer;
+}
+
 AtlasContents::AtlasContents() = default;
 
 AtlasContents::~AtlasContents() = default;
@@ -63,6 +109,31 @@ void AtlasContents::SetCullRect(std::optional<Rect> cull_rect) {
   cull_rect_ = cull_rect;
 }
 
+bool AtlasContents::Merge(const AtlasContents& other) {
+  if (texture_ != other.texture_ || blend_mode_ != other.blend_mode_ ||
+      alpha_ != other.alpha_ ||
+      !(sampler_descriptor_ == other.sampler_descriptor_) ||
+      colors_.empty() != other.colors_.empty()) {
+    return false;
+  }
+
+  if (bounding_box_cache_.has_value()) {
+    bounding_box_cache_ =
+        bounding_box_cache_->Union(other.ComputeBoundingBox());
+  }
+  if (cull_rect_.has_value() && other.cull_rect_.has_value()) {
+    cull_rect_ = cull_rect_->Union(other.cull_rect_.value());
+  } else {
+    cull_rect_ = std::nullopt;
+  }
+  transforms_.insert(transforms_.end(), other.transforms_.begin(),
+                     other.transforms_.end());
+  texture_coords_.insert(texture_coords_.end(), other.texture_coords_.begin(),
+                         other.texture_coords_.end());
+  colors_.insert(colors_.end(), other.colors_.begin(), other.colors_.end());
+  return true;
+}
+
 struct AtlasBlenderKey {
   Color color;
   Rect rect;
@@ -309,45 +380,37 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
     return true;
   }
 
-  std::vector<Rect> texture_coords;
-  std::vector<Matrix> transforms;
-  if (subatlas_) {
-    texture_coords = use_destination_ ? subatlas_->result_texture_coords
-                                      : subatlas_->sub_texture_coords;
-    transforms = use_destination_ ? subatlas_->result_transforms
-                                  : subatlas_->sub_transforms;
-  } else {
-    texture_coords = parent_.GetTextureCoordinates();
-    transforms = parent_.GetTransforms();
+  const auto& texture_coords =
+      subatlas_ ? (use_destination_ ? subatlas_->result_texture_coords
+                                    : subatlas_->sub_texture_coords)
+                : parent_.GetTextureCoordinates();
+  const auto& transforms =
+      subatlas_ ? (use_destination_ ? subatlas_->result_transforms
+                                    : subatlas_->sub_transforms)
+                : parent_.GetTransforms();
+  if (texture_coords.empty()) {
+    return true;
   }
 
   const Size texture_size(texture->GetSize());
-  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
-  vertex_builder.Reserve(texture_coords.size() * 6);
-  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
-  constexpr Scalar width[6] = {0, 1, 0, 1, 0, 1};
-  constexpr Scalar height[6] = {0, 0, 1, 0, 1, 1};
+  std::vector<VS::PerVertexData> vertices(texture_coords.size() * 4);
+  constexpr Scalar width[4] = {0, 1, 0, 1};
+  constexpr Scalar height[4] = {0, 0, 1, 1};
   for (size_t i = 0; i < texture_coords.size(); i++) {
-    auto sample_rect = texture_coords[i];
-    auto matrix = transforms[i];
+    const auto& sample_rect = texture_coords[i];
     auto transformed_points =
-        Rect::MakeSize(sample_rect.size).GetTransformedPoints(matrix);
+        Rect::MakeSize(sample_rect.size).GetTransformedPoints(transforms[i]);
 
-    for (size_t j = 0; j < 6; j++) {
-      VS::PerVertexData data;
-      data.position = transformed_points[indices[j]];
+    for (size_t j = 0; j < 4; j++) {
+      auto& data = vertices[i * 4 + j];
+      data.position = transformed_points[j];
       data.texture_coords =
           (sample_rect.origin + Point(sample_rect.size.width * width[j],
                                       sample_rect.size.height * height[j])) /
           texture_size;
-      vertex_builder.AppendVertex(data);
     }
   }
 
-  if (!vertex_builder.HasVertices()) {
-    return true;
-  }
-
   Command cmd;
   cmd.label = "AtlasTexture";
 
@@ -364,7 +427,7 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
   auto options = OptionsFromPassAndEntity(pass, entity);
   cmd.pipeline = renderer.GetTexturePipeline(options);
   cmd.stencil_reference = entity.GetStencilDepth();
-  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+  cmd.BindVertices(CreateSpriteVertexBuffer(vertices, host_buffer));
   VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
   FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
   FS::BindTextureSampler(cmd, texture,
@@ -405,41 +468,29 @@ bool AtlasColorContents::Render(const ContentContext& renderer,
   using VS = GeometryColorPipeline::VertexShader;
   using FS = GeometryColorPipeline::FragmentShader;
 
-  std::vector<Rect> texture_coords;
-  std::vector<Matrix> transforms;
-  std::vector<Color> colors;
-  if (subatlas_.has_value()) {
-    auto subatlas = subatlas_.value();
-    texture_coords = subatlas->sub_texture_coords;
-    colors = subatlas->sub_colors;
-    transforms = subatlas->sub_transforms;
-  } else {
-    texture_coords = parent_.GetTextureCoordinates();
-    transforms = parent_.GetTransforms();
-    colors = parent_.GetColors();
+  const auto& subatlas = subatlas_.value_or(nullptr);
+  const auto& texture_coords = subatlas ? subatlas->sub_texture_coords
+                                        : parent_.GetTextureCoordinates();
+  const auto& transforms =
+      subatlas ? subatlas->sub_transforms : parent_.GetTransforms();
+  const auto& colors = subatlas ? subatlas->sub_colors : parent_.GetColors();
+  if (texture_coords.empty()) {
+    return true;
   }
 
-  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
-  vertex_builder.Reserve(texture_coords.size() * 6);
-  constexpr size_t indices[6] = {0, 1, 2, 1, 2, 3};
+  std::vector<VS::PerVertexData> vertices(texture_coords.size() * 4);
   for (size_t i = 0; i < texture_coords.size(); i++) {
-    auto sample_rect = texture_coords[i];
-    auto matrix = transforms[i];
-    auto transformed_points =
-        Rect::MakeSize(sample_rect.size).GetTransformedPoints(matrix);
-
-    for (size_t j = 0; j < 6; j++) {
-      VS::PerVertexData data;
-      data.position = transformed_points[indices[j]];
-      data.color = colors[i].Premultiply();
-      vertex_builder.AppendVertex(data);
+    auto transformed_points = Rect::MakeSize(texture_coords[i].size)
+                                  .GetTransformedPoints(transforms[i]);
+    auto color = colors[i].Premultiply();
+
+    for (size_t j = 0; j < 4; j++) {
+      auto& data = vertices[i * 4 + j];
+      data.position = transformed_points[j];
+      data.color = color;
     }
   }
 
-  if (!vertex_builder.HasVertices()) {
-    return true;
-  }
-
   Command cmd;
   cmd.label = "AtlasColors";
 
@@ -456,7 +507,7 @@ bool AtlasColorContents::Render(const ContentContext& renderer,
   opts.blend_mode = BlendMode::kSourceOver;
   cmd.pipeline = renderer.GetGeometryColorPipeline(opts);
   cmd.stencil_reference = entity.GetStencilDepth();
-  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+  cmd.BindVertices(CreateSpriteVertexBuffer(vertices, host_buffer));
   VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
   FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
   return pass.AddCommand(std::move(cmd));
@@ -53,6 +53,14 @@ class AtlasContents final : public Contents {
 
   void SetAlpha(Scalar alpha);
 
+  /// @brief  Append the sprites of `other` to these contents so that both
+  ///         draws render with a single set of commands.
+  ///
+  /// @return Whether `other` shares the texture, sampler, blend mode, alpha
+  ///         and use of colors that merging requires. Nothing is appended
+  ///         otherwise.
+  bool Merge(const AtlasContents& other);
+
   const SamplerDescriptor& GetSamplerDescriptor() const;
 
   const std::vector<Matrix>& GetTransforms() const;
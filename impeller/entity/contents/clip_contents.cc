@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cmath>
 #include <optional>
 
 #include "fml/logging.h"
@@ -34,6 +35,15 @@ std::optional<Rect> ClipContents::GetCoverage(const Entity& entity) const {
   return std::nullopt;
 };
 
+static bool IsPixelAligned(const Rect& rect) {
+  for (auto value : rect.GetLTRB()) {
+    if (!ScalarNearlyEqual(value, std::round(value))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Contents::StencilCoverage ClipContents::GetStencilCoverage(
     const Entity& entity,
     const std::optional<Rect>& current_stencil_coverage) const {
@@ -59,6 +69,10 @@ Contents::StencilCoverage ClipContents::GetStencilCoverage(
       return {
           .type = StencilCoverage::Type::kAppend,
           .coverage = current_stencil_coverage->Intersection(coverage.value()),
+          .is_pixel_aligned_rect =
+              IsPixelAligned(coverage.value()) &&
+              geometry_->CoversArea(entity.GetTransformation(),
+                                    coverage.value()),
       };
   }
   FML_UNREACHABLE();
@@ -128,7 +142,8 @@ bool ClipContents::Render(const ContentContext& renderer,
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
 
-  auto geometry_result = geometry_->GetPositionBuffer(renderer, entity, pass);
+  auto geometry_result =
+      geometry_->GetPositionBufferForMVP(renderer, entity, pass);
   options.primitive_type = geometry_result.type;
   cmd.pipeline = renderer.GetClipPipeline(options);
 
@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/color_batch_contents.h"
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/entity.h"
+#include "impeller/renderer/render_pass.h"
+
+namespace impeller {
+
+ColorBatchContents::ColorBatchContents() = default;
+
+ColorBatchContents::~ColorBatchContents() = default;
+
+bool ColorBatchContents::AddGeometry(const Geometry& geometry,
+                                     const Matrix& transform,
+                                     Color color) {
+  triangles_.clear();
+  if (!geometry.AppendTriangles(transform, triangles_)) {
+    return false;
+  }
+  if (triangles_.empty()) {
+    return true;
+  }
+  if (vtx_builder_.GetVertexCount() + triangles_.size() > kMaxVertexCount) {
+    return false;
+  }
+
+  VS::PerVertexData data;
+  data.color = color.Premultiply();
+  for (const auto& point : triangles_) {
+    data.position = point;
+    vtx_builder_.AppendVertex(data);
+  }
+
+  auto coverage = Rect::MakePointBounds(triangles_.begin(), triangles_.end());
+  if (coverage.has_value()) {
+    coverage_ = coverage_.has_value() ? coverage_->Union(coverage.value())
+                                      : coverage;
+  }
+  return true;
+}
+
+void ColorBatchContents::Clear() {
+  vtx_builder_ = {};
+  coverage_ = std::nullopt;
+}
+
+bool ColorBatchContents::IsEmpty() const {
+  return vtx_builder_.GetVertexCount() == 0u;
+}
+
+// |Contents|
+std::optional<Rect> ColorBatchContents::GetCoverage(
+    const Entity& entity) const {
+  if (!coverage_.has_value()) {
+    return std::nullopt;
+  }
+  return coverage_->TransformBounds(entity.GetTransformation());
+}
+
+// |Contents|
+bool ColorBatchContents::Render(const ContentContext& renderer,
+                                const Entity& entity,
+                                RenderPass& pass) const {
+  using FS = GeometryColorPipeline::FragmentShader;
+
+  if (IsEmpty()) {
+    return true;
+  }
+
+  Command cmd;
+  cmd.label = "Color Batch";
+  cmd.stencil_reference = entity.GetStencilDepth();
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  auto opts = OptionsFromPassAndEntity(pass, entity);
+  opts.primitive_type = PrimitiveType::kTriangle;
+  cmd.pipeline = renderer.GetGeometryColorPipeline(opts);
+  cmd.BindVertices(vtx_builder_.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = 1.0;
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+}  // namespace impeller
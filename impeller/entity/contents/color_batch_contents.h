@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/entity/geometry.h"
+#include "impeller/entity/position_color.vert.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Colored triangles that are collected from the contents of
+///             several entities and drawn with a single command.
+///
+///             The triangles are stored in the space of the render pass, so
+///             the batch is rendered with an entity that has an identity
+///             transform, as well as the blend mode and stencil depth shared
+///             by the batched entities. Triangles are drawn in the order they
+///             were added, so overlapping entities still blend in order.
+///
+class ColorBatchContents final : public Contents {
+ public:
+  ColorBatchContents();
+
+  ~ColorBatchContents() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the triangles of a geometry in the given solid color.
+  ///
+  /// @return     Whether the geometry could be triangulated on the CPU and
+  ///             fit in the batch. If not, the batch is unchanged.
+  ///
+  bool AddGeometry(const Geometry& geometry,
+                   const Matrix& transform,
+                   Color color);
+
+  void Clear();
+
+  bool IsEmpty() const;
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+ private:
+  using VS = PositionColorVertexShader;
+
+  static constexpr size_t kMaxVertexCount = 1u << 16;
+
+  VertexBufferBuilder<VS::PerVertexData, uint32_t> vtx_builder_;
+  std::vector<Point> triangles_;
+  std::optional<Rect> coverage_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ColorBatchContents);
+};
+
+}  // namespace impeller
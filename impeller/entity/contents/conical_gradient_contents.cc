@@ -9,6 +9,7 @@
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/gradient_generator.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/gradient_texture_cache.h"
 #include "impeller/entity/geometry.h"
 #include "impeller/geometry/gradient.h"
 #include "impeller/renderer/render_pass.h"
@@ -130,8 +131,8 @@ bool ConicalGradientContents::RenderTexture(const ContentContext& renderer,
   using FS = ConicalGradientFillPipeline::FragmentShader;
 
   auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = renderer.GetGradientTextureCache()->GetTexture(
+      gradient_data, renderer.GetContext());
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -4,12 +4,22 @@
 
 #include "impeller/entity/contents/content_context.h"
 
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <vector>
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/core/formats.h"
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/gradient_texture_cache.h"
+#include "impeller/entity/image_atlas.h"
+#include "impeller/entity/render_target_cache.h"
+#include "impeller/entity/shadow_texture_cache.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
@@ -161,11 +171,87 @@ static std::unique_ptr<PipelineT> CreateDefaultPipeline(
   return std::make_unique<PipelineT>(context, desc);
 }
 
+/// The caches whose entries only depend on what is drawn and on the
+/// allocator of the context they were created with. Engines spawned from the
+/// same |FlutterEngineGroup| render with the same context, so they use one
+/// set of these caches instead of each keeping copies of the same
+/// tessellations, gradient ramps, and shadow masks.
+struct SharedContentCaches {
+  std::shared_ptr<TessellationCache> tessellation_cache =
+      std::make_shared<TessellationCache>();
+  std::shared_ptr<GradientTextureCache> gradient_texture_cache =
+      std::make_shared<GradientTextureCache>();
+  std::shared_ptr<ShadowTextureCache> shadow_texture_cache =
+      std::make_shared<ShadowTextureCache>();
+};
+
+namespace {
+
+std::shared_ptr<SharedContentCaches> GetSharedContentCaches(
+    const std::shared_ptr<Context>& context) {
+  if (!context) {
+    return std::make_shared<SharedContentCaches>();
+  }
+  struct Entry {
+    std::weak_ptr<Context> context;
+    std::weak_ptr<SharedContentCaches> caches;
+  };
+  static std::mutex mutex;
+  static std::vector<Entry> entries;
+
+  std::scoped_lock lock(mutex);
+  std::shared_ptr<SharedContentCaches> caches;
+  for (auto it = entries.begin(); it != entries.end();) {
+    auto entry_context = it->context.lock();
+    auto entry_caches = it->caches.lock();
+    if (!entry_context || !entry_caches) {
+      it = entries.erase(it);
+      continue;
+    }
+    if (entry_context == context) {
+      caches = std::move(entry_caches);
+    }
+    ++it;
+  }
+  if (!caches) {
+    caches = std::make_shared<SharedContentCaches>();
+    entries.push_back({context, caches});
+  }
+  return caches;
+}
+
+}  // namespace
+
 ContentContext::ContentContext(std::shared_ptr<Context> context)
+    : ContentContext(std::move(context),
+                     PipelineVariantManifest::GetForProcess()) {}
+
+ContentContext::ContentContext(
+    std::shared_ptr<Context> context,
+    std::shared_ptr<PipelineVariantManifest> manifest)
+    : ContentContext(context,
+                     std::move(manifest),
+                     GetSharedContentCaches(context)) {}
+
+ContentContext::ContentContext(
+    std::shared_ptr<Context> context,
+    std::shared_ptr<PipelineVariantManifest> manifest,
+    std::shared_ptr<SharedContentCaches> shared_caches)
     : context_(std::move(context)),
       tessellator_(std::make_shared<Tessellator>()),
+      tessellation_cache_(shared_caches->tessellation_cache),
+      render_target_cache_(
+          context_ ? std::make_shared<RenderTargetCache>(
+                         context_->GetResourceAllocator())
+                   : nullptr),
+      gradient_texture_cache_(shared_caches->gradient_texture_cache),
+      shadow_texture_cache_(shared_caches->shadow_texture_cache),
+      shared_caches_(std::move(shared_caches)),
       glyph_atlas_context_(std::make_shared<GlyphAtlasContext>()),
-      scene_context_(std::make_shared<scene::SceneContext>(context_)) {
+      image_atlas_(context_ ? std::make_shared<ImageAtlas>(context_)
+                            : nullptr),
+      scene_context_(std::make_shared<scene::SceneContext>(context_)),
+      manifest_(std::move(manifest)) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -314,9 +400,129 @@ ContentContext::ContentContext(std::shared_ptr<Context> context)
     return;
   }
 
+  unit_quad_vertex_buffer_ = CreateUnitQuadVertexBuffer(*context_);
+  if (!unit_quad_vertex_buffer_) {
+    return;
+  }
+
+  if (manifest_) {
+    PrecompileManifestVariants();
+  }
+
   is_valid_ = true;
 }
 
+// static
+VertexBuffer ContentContext::CreateUnitQuadVertexBuffer(
+    const Context& context) {
+  constexpr Point kPositions[4] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+  constexpr uint16_t kIndices[4] = {0, 1, 2, 3};
+  constexpr size_t kIndexOffset = sizeof(kPositions);
+
+  uint8_t data[sizeof(kPositions) + sizeof(kIndices)];
+  memcpy(data, kPositions, sizeof(kPositions));
+  memcpy(data + kIndexOffset, kIndices, sizeof(kIndices));
+  auto buffer = context.GetResourceAllocator()->CreateBufferWithCopy(
+      data, sizeof(data));
+  if (!buffer) {
+    VALIDATION_LOG << "Could not create the unit quad vertex buffer.";
+    return {};
+  }
+  buffer->SetLabel("Unit Quad");
+
+  VertexBuffer vertex_buffer;
+  vertex_buffer.vertex_buffer = buffer->AsBufferView();
+  vertex_buffer.vertex_buffer.range = Range(0, sizeof(kPositions));
+  vertex_buffer.index_buffer = buffer->AsBufferView();
+  vertex_buffer.index_buffer.range = Range(kIndexOffset, sizeof(kIndices));
+  vertex_buffer.index_count = 4;
+  vertex_buffer.index_type = IndexType::k16bit;
+  return vertex_buffer;
+}
+
+void ContentContext::PrecompileManifestVariants() {
+  TRACE_EVENT0("impeller", "ContentContext::PrecompileManifestVariants");
+#ifdef IMPELLER_DEBUG
+  PrecompileVariants(checkerboard_pipelines_);
+#endif  // IMPELLER_DEBUG
+  PrecompileVariants(solid_fill_pipelines_);
+  PrecompileVariants(linear_gradient_fill_pipelines_);
+  PrecompileVariants(radial_gradient_fill_pipelines_);
+  PrecompileVariants(conical_gradient_fill_pipelines_);
+  PrecompileVariants(sweep_gradient_fill_pipelines_);
+  PrecompileVariants(linear_gradient_ssbo_fill_pipelines_);
+  PrecompileVariants(radial_gradient_ssbo_fill_pipelines_);
+  PrecompileVariants(conical_gradient_ssbo_fill_pipelines_);
+  PrecompileVariants(sweep_gradient_ssbo_fill_pipelines_);
+  PrecompileVariants(rrect_blur_pipelines_);
+  PrecompileVariants(texture_blend_pipelines_);
+  PrecompileVariants(texture_pipelines_);
+  PrecompileVariants(position_uv_pipelines_);
+  PrecompileVariants(tiled_texture_pipelines_);
+  PrecompileVariants(gaussian_blur_alpha_decal_pipelines_);
+  PrecompileVariants(gaussian_blur_alpha_nodecal_pipelines_);
+  PrecompileVariants(gaussian_blur_noalpha_decal_pipelines_);
+  PrecompileVariants(gaussian_blur_noalpha_nodecal_pipelines_);
+  PrecompileVariants(border_mask_blur_pipelines_);
+  PrecompileVariants(morphology_filter_pipelines_);
+  PrecompileVariants(color_matrix_color_filter_pipelines_);
+  PrecompileVariants(linear_to_srgb_filter_pipelines_);
+  PrecompileVariants(srgb_to_linear_filter_pipelines_);
+  PrecompileVariants(clip_pipelines_);
+  PrecompileVariants(glyph_atlas_pipelines_);
+  PrecompileVariants(glyph_atlas_sdf_pipelines_);
+  PrecompileVariants(geometry_color_pipelines_);
+  PrecompileVariants(yuv_to_rgb_filter_pipelines_);
+  PrecompileVariants(porter_duff_blend_pipelines_);
+  PrecompileVariants(blend_color_pipelines_);
+  PrecompileVariants(blend_colorburn_pipelines_);
+  PrecompileVariants(blend_colordodge_pipelines_);
+  PrecompileVariants(blend_darken_pipelines_);
+  PrecompileVariants(blend_difference_pipelines_);
+  PrecompileVariants(blend_exclusion_pipelines_);
+  PrecompileVariants(blend_hardlight_pipelines_);
+  PrecompileVariants(blend_hue_pipelines_);
+  PrecompileVariants(blend_lighten_pipelines_);
+  PrecompileVariants(blend_luminosity_pipelines_);
+  PrecompileVariants(blend_multiply_pipelines_);
+  PrecompileVariants(blend_overlay_pipelines_);
+  PrecompileVariants(blend_saturation_pipelines_);
+  PrecompileVariants(blend_screen_pipelines_);
+  PrecompileVariants(blend_softlight_pipelines_);
+  PrecompileVariants(framebuffer_blend_color_pipelines_);
+  PrecompileVariants(framebuffer_blend_colorburn_pipelines_);
+  PrecompileVariants(framebuffer_blend_colordodge_pipelines_);
+  PrecompileVariants(framebuffer_blend_darken_pipelines_);
+  PrecompileVariants(framebuffer_blend_difference_pipelines_);
+  PrecompileVariants(framebuffer_blend_exclusion_pipelines_);
+  PrecompileVariants(framebuffer_blend_hardlight_pipelines_);
+  PrecompileVariants(framebuffer_blend_hue_pipelines_);
+  PrecompileVariants(framebuffer_blend_lighten_pipelines_);
+  PrecompileVariants(framebuffer_blend_luminosity_pipelines_);
+  PrecompileVariants(framebuffer_blend_multiply_pipelines_);
+  PrecompileVariants(framebuffer_blend_overlay_pipelines_);
+  PrecompileVariants(framebuffer_blend_saturation_pipelines_);
+  PrecompileVariants(framebuffer_blend_screen_pipelines_);
+  PrecompileVariants(framebuffer_blend_softlight_pipelines_);
+}
+
+std::vector<ContentContextOptions> ContentContext::GetManifestVariants(
+    const std::string& pipeline_label) const {
+  return manifest_->GetVariants(pipeline_label);
+}
+
+void ContentContext::RecordVariantMiss(
+    const std::string& pipeline_label,
+    const ContentContextOptions& opts) const {
+  manifest_->RecordMiss(pipeline_label, opts);
+}
+
+void ContentContext::RecordPrecompiledVariantUse(const void* variant) const {
+  if (precompiled_variants_.erase(variant) > 0) {
+    manifest_->RecordHit();
+  }
+}
+
 ContentContext::~ContentContext() = default;
 
 bool ContentContext::IsValid() const {
@@ -333,11 +539,13 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
   RenderTarget subpass_target;
   if (context->GetCapabilities()->SupportsOffscreenMSAA() && msaa_enabled) {
     subpass_target = RenderTarget::CreateOffscreenMSAA(
-        *context, texture_size, SPrintF("%s Offscreen", label.c_str()),
+        *context, *render_target_cache_, texture_size,
+        SPrintF("%s Offscreen", label.c_str()),
         RenderTarget::kDefaultColorAttachmentConfigMSAA, std::nullopt);
   } else {
     subpass_target = RenderTarget::CreateOffscreen(
-        *context, texture_size, SPrintF("%s Offscreen", label.c_str()),
+        *context, *render_target_cache_, texture_size,
+        SPrintF("%s Offscreen", label.c_str()),
         RenderTarget::kDefaultColorAttachmentConfig, std::nullopt);
   }
   auto subpass_texture = subpass_target.GetRenderTargetTexture();
@@ -380,6 +588,30 @@ std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
   return tessellator_;
 }
 
+std::shared_ptr<TessellationCache> ContentContext::GetTessellationCache()
+    const {
+  return tessellation_cache_;
+}
+
+const VertexBuffer& ContentContext::GetUnitQuadVertexBuffer() const {
+  return unit_quad_vertex_buffer_;
+}
+
+std::shared_ptr<RenderTargetCache> ContentContext::GetRenderTargetCache()
+    const {
+  return render_target_cache_;
+}
+
+std::shared_ptr<GradientTextureCache> ContentContext::GetGradientTextureCache()
+    const {
+  return gradient_texture_cache_;
+}
+
+std::shared_ptr<ShadowTextureCache> ContentContext::GetShadowTextureCache()
+    const {
+  return shadow_texture_cache_;
+}
+
 std::shared_ptr<GlyphAtlasContext> ContentContext::GetGlyphAtlasContext()
     const {
   return glyph_atlas_context_;
@@ -397,4 +629,78 @@ void ContentContext::SetWireframe(bool wireframe) {
   wireframe_ = wireframe;
 }
 
+void ContentContext::SetComputeTessellationEnabled(bool enabled) {
+  compute_tessellation_enabled_ = enabled;
+}
+
+bool ContentContext::IsComputeTessellationEnabled() const {
+  // The stroke shader relies on subgroup operations.
+  return compute_tessellation_enabled_ &&
+         GetDeviceCapabilities().SupportsCompute() &&
+         GetDeviceCapabilities().SupportsComputeSubgroups();
+}
+
+void ContentContext::SetComputeFiltersEnabled(bool enabled) {
+  compute_filters_enabled_ = enabled;
+}
+
+bool ContentContext::IsComputeFiltersEnabled() const {
+  return compute_filters_enabled_ &&
+         GetDeviceCapabilities().SupportsCompute();
+}
+
+void ContentContext::SetOcclusionCullingEnabled(bool enabled) {
+  occlusion_culling_enabled_ = enabled;
+}
+
+bool ContentContext::IsOcclusionCullingEnabled() const {
+  return occlusion_culling_enabled_;
+}
+
+void ContentContext::SetBlurDownsamplingEnabled(bool enabled) {
+  blur_downsampling_enabled_ = enabled;
+}
+
+bool ContentContext::IsBlurDownsamplingEnabled() const {
+  return blur_downsampling_enabled_;
+}
+
+void ContentContext::SetImageAtlasEnabled(bool enabled) {
+  image_atlas_enabled_ = enabled;
+}
+
+bool ContentContext::IsImageAtlasEnabled() const {
+  return image_atlas_enabled_;
+}
+
+std::shared_ptr<ImageAtlas> ContentContext::GetImageAtlas() const {
+  return image_atlas_enabled_ ? image_atlas_ : nullptr;
+}
+
+void ContentContext::RecordDrawCalls(size_t draw_call_count,
+                                     size_t batched_entity_count,
+                                     size_t pipeline_switch_count) const {
+  draw_call_count_ += draw_call_count;
+  batched_entity_count_ += batched_entity_count;
+  pipeline_switch_count_ += pipeline_switch_count;
+}
+
+void ContentContext::ResetDrawCallCounts() {
+  draw_call_count_ = 0u;
+  batched_entity_count_ = 0u;
+  pipeline_switch_count_ = 0u;
+}
+
+size_t ContentContext::GetDrawCallCount() const {
+  return draw_call_count_;
+}
+
+size_t ContentContext::GetBatchedEntityCount() const {
+  return batched_entity_count_;
+}
+
+size_t ContentContext::GetPipelineSwitchCount() const {
+  return pipeline_switch_count_;
+}
+
 }  // namespace impeller
@@ -4,15 +4,20 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <optional>
-#include <unordered_map>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
+#include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/entity.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/pipeline.h"
@@ -320,15 +325,57 @@ struct ContentContextOptions {
     }
   };
 
+  /// Packs the options into an integer that is equal for equal options.
+  constexpr uint64_t ToKey() const {
+    const uint64_t pixel_format =
+        color_attachment_pixel_format.has_value()
+            ? static_cast<uint64_t>(color_attachment_pixel_format.value()) + 1
+            : 0;
+    uint64_t key = static_cast<uint64_t>(sample_count);
+    key |= static_cast<uint64_t>(blend_mode) << 8;
+    key |= static_cast<uint64_t>(stencil_compare) << 16;
+    key |= static_cast<uint64_t>(stencil_operation) << 24;
+    key |= static_cast<uint64_t>(primitive_type) << 32;
+    key |= pixel_format << 40;
+    key |= static_cast<uint64_t>(has_stencil_attachment) << 48;
+    key |= static_cast<uint64_t>(wireframe) << 49;
+    return key;
+  }
+
   void ApplyToPipelineDescriptor(PipelineDescriptor& desc) const;
 };
 
 class Tessellator;
+class TessellationCache;
+class RenderTargetCache;
+class GradientTextureCache;
+class ShadowTextureCache;
+class ImageAtlas;
+class PipelineVariantManifest;
+struct SharedContentCaches;
 
 class ContentContext {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a content context that records pipeline variants in
+  ///             the process-wide |PipelineVariantManifest|, if any.
+  ///
   explicit ContentContext(std::shared_ptr<Context> context);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a content context that precompiles the variants
+  ///             found in the given manifest and records any new variant it
+  ///             creates into it. The manifest may be nullptr.
+  ///
+  ///             The tessellation, gradient, and shadow caches are shared by
+  ///             every content context created with the same |Context|, so
+  ///             that engines spawned from one engine group don't each cache
+  ///             their own copies. The offscreen render target cache is
+  ///             recycled every frame and stays per content context.
+  ///
+  ContentContext(std::shared_ptr<Context> context,
+                 std::shared_ptr<PipelineVariantManifest> manifest);
+
   ~ContentContext();
 
   bool IsValid() const;
@@ -337,6 +384,39 @@ class ContentContext {
 
   std::shared_ptr<Tessellator> GetTessellator() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The cache of path tessellations that are reused across
+  ///             frames by the geometries rendered with this context, and
+  ///             with any other content context on the same |Context|.
+  ///
+  std::shared_ptr<TessellationCache> GetTessellationCache() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A triangle strip over the unit square, in a device buffer
+  ///             that is shared by every draw. Rect-like geometries bind it
+  ///             and fold the rect into their transform instead of writing
+  ///             four vertices per draw.
+  ///
+  const VertexBuffer& GetUnitQuadVertexBuffer() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The pool that the attachments of offscreen render targets
+  ///             created for subpasses are recycled from across frames.
+  ///
+  std::shared_ptr<RenderTargetCache> GetRenderTargetCache() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache of gradient color ramp textures that are shared by
+  ///             gradients with the same colors and stops across frames.
+  ///
+  std::shared_ptr<GradientTextureCache> GetGradientTextureCache() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The cache of the blurred masks of path shadows that are
+  ///             reused across frames.
+  ///
+  std::shared_ptr<ShadowTextureCache> GetShadowTextureCache() const;
+
 #ifdef IMPELLER_DEBUG
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetCheckerboardPipeline(
       ContentContextOptions opts) const {
@@ -669,6 +749,82 @@ class ContentContext {
 
   void SetWireframe(bool wireframe);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Allows geometries to tessellate on the GPU with compute
+  ///             shaders when the device supports them. Enabled by default.
+  ///
+  void SetComputeTessellationEnabled(bool enabled);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether compute tessellation is enabled and supported by the
+  ///             device.
+  ///
+  bool IsComputeTessellationEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allows directional blur and morphology filters to run as
+  ///             compute kernels that cache their input in shared memory when
+  ///             the device supports them. Enabled by default.
+  ///
+  void SetComputeFiltersEnabled(bool enabled);
+
+  bool IsComputeFiltersEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allows entity passes to skip the entities that are fully
+  ///             hidden behind opaque entities drawn after them in the same
+  ///             pass. Enabled by default.
+  ///
+  void SetOcclusionCullingEnabled(bool enabled);
+
+  bool IsOcclusionCullingEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allows Gaussian blurs with large sigmas to be rendered from
+  ///             downsampled copies of their inputs and upsampled bilinearly,
+  ///             trading some accuracy for fewer samples. Enabled by default.
+  ///
+  void SetBlurDownsamplingEnabled(bool enabled);
+
+  bool IsBlurDownsamplingEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allows small immutable images that are drawn often to be
+  ///             packed into the pages of an image atlas, so that textured
+  ///             draws of different images can be batched into a single draw.
+  ///             Disabled by default.
+  ///
+  void SetImageAtlasEnabled(bool enabled);
+
+  bool IsImageAtlasEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The image atlas that textured draws are resolved with, or
+  ///             nullptr if the image atlas is disabled.
+  ///
+  std::shared_ptr<ImageAtlas> GetImageAtlas() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records draw calls that entity passes added to their render
+  ///             passes, how many entities were merged into batched draws,
+  ///             and how often those draws switched pipelines. May be called
+  ///             from multiple threads.
+  ///
+  void RecordDrawCalls(size_t draw_call_count,
+                       size_t batched_entity_count,
+                       size_t pipeline_switch_count = 0u) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Resets the recorded counts, usually at the start of a frame.
+  ///
+  void ResetDrawCallCounts();
+
+  size_t GetDrawCallCount() const;
+
+  size_t GetBatchedEntityCount() const;
+
+  size_t GetPipelineSwitchCount() const;
+
   using SubpassCallback =
       std::function<bool(const ContentContext&, RenderPass&)>;
 
@@ -682,15 +838,45 @@ class ContentContext {
  private:
   std::shared_ptr<Context> context_;
 
+  // The variants of a pipeline, looked up by the packed key of their options.
+  // A pipeline rarely has more than a handful of variants, so scanning the
+  // contiguous keys costs less than hashing the options on every lookup.
   template <class T>
-  using Variants = std::unordered_map<ContentContextOptions,
-                                      std::unique_ptr<T>,
-                                      ContentContextOptions::Hash,
-                                      ContentContextOptions::Equal>;
+  class Variants {
+   public:
+    T* Get(const ContentContextOptions& opts) const {
+      const uint64_t key = opts.ToKey();
+      for (size_t i = 0; i < keys_.size(); i++) {
+        if (keys_[i] == key) {
+          return pipelines_[i].get();
+        }
+      }
+      return nullptr;
+    }
+
+    std::unique_ptr<T>& operator[](const ContentContextOptions& opts) {
+      const uint64_t key = opts.ToKey();
+      for (size_t i = 0; i < keys_.size(); i++) {
+        if (keys_[i] == key) {
+          return pipelines_[i];
+        }
+      }
+      keys_.push_back(key);
+      return pipelines_.emplace_back();
+    }
+
+    size_t size() const { return keys_.size(); }
+
+   private:
+    std::vector<uint64_t> keys_;
+    std::vector<std::unique_ptr<T>> pipelines_;
+  };
 
   // These are mutable because while the prototypes are created eagerly, any
   // variants requested from that are lazily created and cached in the variants
-  // map.
+  // map. Subpasses may be encoded concurrently, so the maps are guarded by
+  // |variants_mutex_|.
+  mutable std::mutex variants_mutex_;
 
 #ifdef IMPELLER_DEBUG
   mutable Variants<CheckerboardPipeline> checkerboard_pipelines_;
@@ -795,16 +981,20 @@ class ContentContext {
       opts.wireframe = true;
     }
 
-    if (auto found = container.find(opts); found != container.end()) {
-      return found->second->WaitAndGet();
+    std::scoped_lock lock(variants_mutex_);
+    if (auto found = container.Get(opts)) {
+      if (!precompiled_variants_.empty()) {
+        RecordPrecompiledVariantUse(found);
+      }
+      return found->WaitAndGet();
     }
 
-    auto prototype = container.find({});
+    auto prototype = container.Get({});
 
     // The prototype must always be initialized in the constructor.
-    FML_CHECK(prototype != container.end());
+    FML_CHECK(prototype != nullptr);
 
-    auto pipeline = prototype->second->WaitAndGet();
+    auto pipeline = prototype->WaitAndGet();
     if (!pipeline) {
       return nullptr;
     }
@@ -818,14 +1008,79 @@ class ContentContext {
     auto variant = std::make_unique<TypedPipeline>(std::move(variant_future));
     auto variant_pipeline = variant->WaitAndGet();
     container[opts] = std::move(variant);
+    if (manifest_) {
+      RecordVariantMiss(pipeline->GetDescriptor().GetLabel(), opts);
+    }
     return variant_pipeline;
   }
 
+  /// Starts compiling the variants of the given pipeline recorded in the
+  /// manifest. The backend pipeline libraries compile asynchronously so this
+  /// does not wait for the variants to be ready, |GetPipeline| does that on
+  /// first use.
+  template <class TypedPipeline>
+  void PrecompileVariants(Variants<TypedPipeline>& container) const {
+    auto prototype = container.Get({});
+    if (!prototype) {
+      return;
+    }
+    auto desc = prototype->GetDescriptor();
+    if (!desc.has_value()) {
+      return;
+    }
+    for (const auto& opts : GetManifestVariants(desc->GetLabel())) {
+      if (container.Get(opts)) {
+        continue;
+      }
+      auto variant_desc = desc.value();
+      opts.ApplyToPipelineDescriptor(variant_desc);
+      variant_desc.SetLabel(
+          SPrintF("%s V#%zu", desc->GetLabel().c_str(), container.size()));
+      auto variant = std::make_unique<TypedPipeline>(*context_, variant_desc);
+      precompiled_variants_.insert(variant.get());
+      container[opts] = std::move(variant);
+    }
+  }
+
+  void PrecompileManifestVariants();
+
+  std::vector<ContentContextOptions> GetManifestVariants(
+      const std::string& pipeline_label) const;
+
+  void RecordVariantMiss(const std::string& pipeline_label,
+                         const ContentContextOptions& opts) const;
+
+  void RecordPrecompiledVariantUse(const void* variant) const;
+
+  static VertexBuffer CreateUnitQuadVertexBuffer(const Context& context);
+
+  ContentContext(std::shared_ptr<Context> context,
+                 std::shared_ptr<PipelineVariantManifest> manifest,
+                 std::shared_ptr<SharedContentCaches> shared_caches);
+
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
+  std::shared_ptr<TessellationCache> tessellation_cache_;
+  VertexBuffer unit_quad_vertex_buffer_;
+  std::shared_ptr<RenderTargetCache> render_target_cache_;
+  std::shared_ptr<GradientTextureCache> gradient_texture_cache_;
+  std::shared_ptr<ShadowTextureCache> shadow_texture_cache_;
+  std::shared_ptr<SharedContentCaches> shared_caches_;
   std::shared_ptr<GlyphAtlasContext> glyph_atlas_context_;
+  std::shared_ptr<ImageAtlas> image_atlas_;
   std::shared_ptr<scene::SceneContext> scene_context_;
   bool wireframe_ = false;
+  bool compute_tessellation_enabled_ = true;
+  bool compute_filters_enabled_ = true;
+  bool occlusion_culling_enabled_ = true;
+  bool blur_downsampling_enabled_ = true;
+  bool image_atlas_enabled_ = false;
+  mutable std::atomic<size_t> draw_call_count_ = 0u;
+  mutable std::atomic<size_t> batched_entity_count_ = 0u;
+  mutable std::atomic<size_t> pipeline_switch_count_ = 0u;
+  std::shared_ptr<PipelineVariantManifest> manifest_;
+  // Variants precompiled from the manifest that have not been used yet.
+  mutable std::unordered_set<const void*> precompiled_variants_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContentContext);
 };
@@ -0,0 +1,124 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/vk/entity_shaders_vk.h"
+#include "impeller/entity/vk/modern_shaders_vk.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+namespace impeller {
+
+namespace {
+
+std::shared_ptr<ContextVK> CreateContext(
+    const std::shared_ptr<fml::ConcurrentMessageLoop>& loop) {
+  ContextVK::Settings settings;
+  settings.proc_address_callback = reinterpret_cast<PFN_vkGetInstanceProcAddr>(
+      &::glfwGetInstanceProcAddress);
+  settings.shader_libraries_data = {
+      std::make_shared<fml::NonOwnedMapping>(impeller_entity_shaders_vk_data,
+                                             impeller_entity_shaders_vk_length),
+      std::make_shared<fml::NonOwnedMapping>(impeller_modern_shaders_vk_data,
+                                             impeller_modern_shaders_vk_length),
+  };
+  // No cache directory, every iteration compiles all pipelines from scratch.
+  settings.worker_task_runner = loop->GetTaskRunner();
+  return ContextVK::Create(std::move(settings));
+}
+
+// Waits for the prototype of every pipeline that ContentContext creates
+// unconditionally at startup.
+bool WaitForPipelines(const ContentContext& context) {
+  ContentContextOptions opts;
+  bool ok = true;
+  ok &= !!context.GetLinearGradientFillPipeline(opts);
+  ok &= !!context.GetRadialGradientFillPipeline(opts);
+  ok &= !!context.GetConicalGradientFillPipeline(opts);
+  ok &= !!context.GetSweepGradientFillPipeline(opts);
+  ok &= !!context.GetRRectBlurPipeline(opts);
+  ok &= !!context.GetSolidFillPipeline(opts);
+  ok &= !!context.GetBlendPipeline(opts);
+  ok &= !!context.GetTexturePipeline(opts);
+  ok &= !!context.GetPositionUVPipeline(opts);
+  ok &= !!context.GetTiledTexturePipeline(opts);
+  ok &= !!context.GetGaussianBlurAlphaDecalPipeline(opts);
+  ok &= !!context.GetGaussianBlurAlphaPipeline(opts);
+  ok &= !!context.GetGaussianBlurDecalPipeline(opts);
+  ok &= !!context.GetGaussianBlurPipeline(opts);
+  ok &= !!context.GetBorderMaskBlurPipeline(opts);
+  ok &= !!context.GetMorphologyFilterPipeline(opts);
+  ok &= !!context.GetColorMatrixColorFilterPipeline(opts);
+  ok &= !!context.GetLinearToSrgbFilterPipeline(opts);
+  ok &= !!context.GetSrgbToLinearFilterPipeline(opts);
+  ok &= !!context.GetClipPipeline(opts);
+  ok &= !!context.GetGlyphAtlasPipeline(opts);
+  ok &= !!context.GetGlyphAtlasSdfPipeline(opts);
+  ok &= !!context.GetGeometryColorPipeline(opts);
+  ok &= !!context.GetYUVToRGBFilterPipeline(opts);
+  ok &= !!context.GetPorterDuffBlendPipeline(opts);
+  ok &= !!context.GetBlendColorPipeline(opts);
+  ok &= !!context.GetBlendColorBurnPipeline(opts);
+  ok &= !!context.GetBlendColorDodgePipeline(opts);
+  ok &= !!context.GetBlendDarkenPipeline(opts);
+  ok &= !!context.GetBlendDifferencePipeline(opts);
+  ok &= !!context.GetBlendExclusionPipeline(opts);
+  ok &= !!context.GetBlendHardLightPipeline(opts);
+  ok &= !!context.GetBlendHuePipeline(opts);
+  ok &= !!context.GetBlendLightenPipeline(opts);
+  ok &= !!context.GetBlendLuminosityPipeline(opts);
+  ok &= !!context.GetBlendMultiplyPipeline(opts);
+  ok &= !!context.GetBlendOverlayPipeline(opts);
+  ok &= !!context.GetBlendSaturationPipeline(opts);
+  ok &= !!context.GetBlendScreenPipeline(opts);
+  ok &= !!context.GetBlendSoftLightPipeline(opts);
+  return ok;
+}
+
+}  // namespace
+
+static void BM_ContentContextPipelineCompile(benchmark::State& state) {
+  const size_t worker_count = state.range(0);
+  if (!::glfwInit() || !::glfwVulkanSupported()) {
+    state.SkipWithError("Vulkan is not available.");
+    return;
+  }
+  auto loop = fml::ConcurrentMessageLoop::Create(worker_count);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto context = CreateContext(loop);
+    if (!context || !context->IsValid()) {
+      state.SkipWithError("Could not create a Vulkan context.");
+      break;
+    }
+    state.ResumeTiming();
+
+    {
+      ContentContext content_context(context, nullptr);
+      if (!content_context.IsValid() || !WaitForPipelines(content_context)) {
+        state.SkipWithError("Could not create the pipelines.");
+        break;
+      }
+    }
+
+    state.PauseTiming();
+    context.reset();
+    state.ResumeTiming();
+  }
+  state.counters["Workers"] = worker_count;
+}
+
+BENCHMARK(BM_ContentContextPipelineCompile)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace impeller
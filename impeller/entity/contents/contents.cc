@@ -99,6 +99,20 @@ void Contents::SetInheritedOpacity(Scalar opacity) {
                     "Contents::CanAcceptOpacity returns false.";
 }
 
+bool Contents::AddToBatch(const Entity& entity,
+                          ColorBatchContents& batch) const {
+  return false;
+}
+
+bool Contents::AddToTextureBatch(const Entity& entity,
+                                 TextureBatchContents& batch) const {
+  return false;
+}
+
+bool Contents::IsOpaqueOver(const Entity& entity, const Rect& rect) const {
+  return false;
+}
+
 bool Contents::ShouldRender(const Entity& entity,
                             const std::optional<Rect>& stencil_coverage) const {
   if (!stencil_coverage.has_value()) {
@@ -17,11 +17,13 @@
 
 namespace impeller {
 
+class ColorBatchContents;
 class ContentContext;
 struct ContentContextOptions;
 class Entity;
 class Surface;
 class RenderPass;
+class TextureBatchContents;
 
 ContentContextOptions OptionsFromPass(const RenderPass& pass);
 
@@ -35,6 +37,10 @@ class Contents {
 
     Type type = Type::kNoChange;
     std::optional<Rect> coverage = std::nullopt;
+    /// Whether an appended clip is a pixel aligned rectangle, so that
+    /// intersecting with `coverage` is all that it does. Such clips can be
+    /// applied with a scissor rect instead of the stencil buffer.
+    bool is_pixel_aligned_rect = false;
   };
 
   using RenderProc = std::function<bool(const ContentContext& renderer,
@@ -101,6 +107,32 @@ class Contents {
   ///        Use of this method is invalid if CanAcceptOpacity returns false.
   virtual void SetInheritedOpacity(Scalar opacity);
 
+  /// @brief Add this contents, drawn with the given entity, to a batch that
+  ///        is rendered with a single draw call.
+  ///
+  ///        By default all contents return false and leave the batch
+  ///        unchanged. Contents that return true must render exactly as
+  ///        they would on their own when the batch is rendered with the
+  ///        blend mode and stencil depth of the entity.
+  virtual bool AddToBatch(const Entity& entity,
+                          ColorBatchContents& batch) const;
+
+  /// @brief Add this contents, drawn with the given entity, to a batch of
+  ///        textured rectangles that is rendered with a single draw call.
+  ///
+  ///        Follows the same rules as `AddToBatch`.
+  virtual bool AddToTextureBatch(const Entity& entity,
+                                 TextureBatchContents& batch) const;
+
+  /// @brief Whether this contents, drawn with the given entity, paints every
+  ///        pixel of the given rectangle with an opaque color. The rectangle
+  ///        is in the same space as `GetCoverage`.
+  ///
+  ///        Entity passes skip the entities that are drawn before an opaque
+  ///        entity and are fully hidden by it. By default all contents return
+  ///        false, which is always safe.
+  virtual bool IsOpaqueOver(const Entity& entity, const Rect& rect) const;
+
  private:
   std::optional<Size> color_source_size_;
 
@@ -0,0 +1,243 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/filters/directional_compute_filter.h"
+
+#include <string>
+
+#include "impeller/core/formats.h"
+#include "impeller/core/sampler_descriptor.h"
+#include "impeller/entity/gaussian_blur.comp.h"
+#include "impeller/entity/morphology_filter.comp.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_pass.h"
+#include "impeller/renderer/compute_pipeline_builder.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/sampler_library.h"
+
+namespace impeller {
+
+namespace {
+
+/// Runs the directional filter kernel `CS` over the texture of `input`.
+///
+/// The output extends `offset` texels past both ends of the input along the
+/// axis. The kernel sets every pixel of the output. Compute passes can't write
+/// to textures, so the kernel writes packed RGBA8 pixels to a buffer that is
+/// then copied into the texture of the result.
+template <typename CS>
+std::optional<Snapshot> RenderDirectionalKernel(
+    const ContentContext& renderer,
+    const Snapshot& input,
+    const ComputeFilterAxis& axis,
+    uint32_t offset,
+    uint32_t radius,
+    const SamplerDescriptor& sampler_descriptor,
+    typename CS::FilterInfo filter_info,
+    const std::string& label) {
+  if (radius > kMaxComputeFilterRadius) {
+    return std::nullopt;
+  }
+
+  auto context = renderer.GetContext();
+  auto input_size = input.texture->GetSize();
+  auto output_size =
+      axis.along_x
+          ? ISize(input_size.width + offset * 2, input_size.height)
+          : ISize(input_size.width, input_size.height + offset * 2);
+  if (output_size.IsEmpty()) {
+    return std::nullopt;
+  }
+
+  auto pipeline_desc =
+      ComputePipelineBuilder<CS>::MakeDefaultPipelineDescriptor(*context);
+  if (!pipeline_desc.has_value()) {
+    return std::nullopt;
+  }
+  auto pipeline =
+      context->GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+  if (!pipeline) {
+    return std::nullopt;
+  }
+
+  auto& allocator = *context->GetResourceAllocator();
+  TextureDescriptor texture_desc;
+  texture_desc.storage_mode = StorageMode::kDevicePrivate;
+  texture_desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  texture_desc.size = output_size;
+  auto texture = allocator.CreateTexture(texture_desc);
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kDevicePrivate;
+  buffer_desc.size = texture_desc.GetByteSizeOfBaseMipLevel();
+  auto pixels = allocator.CreateBuffer(buffer_desc);
+  if (!texture || !pixels) {
+    return std::nullopt;
+  }
+  texture->SetLabel(label);
+  pixels->SetLabel(label);
+
+  auto cmd_buffer = context->CreateCommandBuffer();
+  if (!cmd_buffer) {
+    return std::nullopt;
+  }
+  auto compute_pass = cmd_buffer->CreateComputePass();
+  if (!compute_pass || !compute_pass->IsValid()) {
+    return std::nullopt;
+  }
+  compute_pass->SetLabel(label);
+
+  // The grid runs along the axis, and each row of it is covered by whole
+  // tiles.
+  compute_pass->SetGridSize(
+      axis.along_x ? output_size : ISize(output_size.height, output_size.width));
+  compute_pass->SetThreadGroupSize(ISize(kComputeFilterTileSize, 1));
+
+  filter_info.input_size = Vector2(input_size);
+  filter_info.output_width = output_size.width;
+  filter_info.output_height = output_size.height;
+  filter_info.along_x = axis.along_x ? 1u : 0u;
+  filter_info.offset = offset;
+  filter_info.radius = radius;
+
+  ComputeCommand cmd;
+  cmd.label = label;
+  cmd.pipeline = pipeline;
+  CS::BindFilterInfo(
+      cmd, compute_pass->GetTransientsBuffer().EmplaceUniform(filter_info));
+  CS::BindTextureSampler(
+      cmd, input.texture,
+      context->GetSamplerLibrary()->GetSampler(sampler_descriptor));
+  CS::BindPixels(cmd, pixels->AsBufferView());
+  if (!compute_pass->AddCommand(std::move(cmd)) ||
+      !compute_pass->EncodeCommands()) {
+    return std::nullopt;
+  }
+
+  auto blit_pass = cmd_buffer->CreateBlitPass();
+  if (!blit_pass ||
+      !blit_pass->AddCopy(pixels->AsBufferView(), texture,
+                          IRect::MakeSize(output_size), label) ||
+      !blit_pass->EncodeCommands(context->GetResourceAllocator())) {
+    return std::nullopt;
+  }
+
+  // Submitted ahead of the command buffer of the render pass that draws the
+  // result, on the same queue.
+  if (!cmd_buffer->SubmitCommands()) {
+    return std::nullopt;
+  }
+
+  auto origin = axis.along_x ? Vector2(-static_cast<Scalar>(offset), 0)
+                             : Vector2(0, -static_cast<Scalar>(offset));
+  SamplerDescriptor result_sampler_desc;
+  result_sampler_desc.min_filter = MinMagFilter::kLinear;
+  result_sampler_desc.mag_filter = MinMagFilter::kLinear;
+  return Snapshot{
+      .texture = texture,
+      .transform = input.transform * Matrix::MakeTranslation(origin),
+      .sampler_descriptor = result_sampler_desc,
+      .opacity = input.opacity};
+}
+
+/// Whole texels are read at their centers, so the kernels never filter
+/// between them.
+SamplerDescriptor MakeTexelSamplerDescriptor(const Snapshot& input,
+                                             SamplerAddressMode address_mode) {
+  SamplerDescriptor desc = input.sampler_descriptor;
+  desc.min_filter = MinMagFilter::kNearest;
+  desc.mag_filter = MinMagFilter::kNearest;
+  desc.width_address_mode = address_mode;
+  desc.height_address_mode = address_mode;
+  return desc;
+}
+
+}  // namespace
+
+std::optional<ComputeFilterAxis> GetComputeFilterAxis(const Snapshot& input,
+                                                      Vector2 direction) {
+  if (!input.transform.IsAffine() || direction.IsZero()) {
+    return std::nullopt;
+  }
+  direction = direction.Normalize();
+
+  // Filtering along a texel axis filters along the direction that the axis is
+  // transformed to, whatever the other axis is transformed to.
+  for (bool along_x : {true, false}) {
+    auto texel_axis = input.transform.TransformDirection(
+        along_x ? Vector2(1, 0) : Vector2(0, 1));
+    auto texel_length = texel_axis.GetLength();
+    if (ScalarNearlyZero(texel_length)) {
+      return std::nullopt;
+    }
+    if (ScalarNearlyZero(direction.Cross(texel_axis / texel_length))) {
+      return ComputeFilterAxis{.along_x = along_x,
+                               .texel_length = texel_length};
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<Snapshot> RenderComputeGaussianBlur(
+    const ContentContext& renderer,
+    const Snapshot& input,
+    const ComputeFilterAxis& axis,
+    Sigma sigma,
+    uint32_t radius,
+    Entity::TileMode tile_mode) {
+  using CS = GaussianBlurComputeShader;
+
+  SamplerAddressMode address_mode;
+  switch (tile_mode) {
+    case Entity::TileMode::kDecal:
+      if (!renderer.GetDeviceCapabilities().SupportsDecalTileMode()) {
+        return std::nullopt;
+      }
+      address_mode = SamplerAddressMode::kDecal;
+      break;
+    case Entity::TileMode::kClamp:
+      address_mode = SamplerAddressMode::kClampToEdge;
+      break;
+    case Entity::TileMode::kMirror:
+      address_mode = SamplerAddressMode::kMirror;
+      break;
+    case Entity::TileMode::kRepeat:
+      address_mode = SamplerAddressMode::kRepeat;
+      break;
+  }
+
+  CS::FilterInfo filter_info;
+  filter_info.sigma = sigma.sigma;
+  return RenderDirectionalKernel<CS>(
+      renderer, input, axis, /*offset=*/radius, radius,
+      MakeTexelSamplerDescriptor(input, address_mode), filter_info,
+      "Compute Gaussian Blur Filter");
+}
+
+std::optional<Snapshot> RenderComputeMorphology(
+    const ContentContext& renderer,
+    const Snapshot& input,
+    const ComputeFilterAxis& axis,
+    uint32_t radius,
+    FilterContents::MorphType morph_type) {
+  using CS = MorphologyFilterComputeShader;
+
+  // Texels past the edges of the input are transparent.
+  if (!renderer.GetDeviceCapabilities().SupportsDecalTileMode()) {
+    return std::nullopt;
+  }
+
+  CS::FilterInfo filter_info;
+  filter_info.morph_type = static_cast<uint32_t>(morph_type);
+  // Eroded pixels past the edges of the input are all transparent.
+  uint32_t offset =
+      morph_type == FilterContents::MorphType::kDilate ? radius : 0u;
+  return RenderDirectionalKernel<CS>(
+      renderer, input, axis, offset, radius,
+      MakeTexelSamplerDescriptor(input, SamplerAddressMode::kDecal),
+      filter_info, "Compute Morphology Filter");
+}
+
+}  // namespace impeller
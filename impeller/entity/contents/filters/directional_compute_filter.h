@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/geometry/sigma.h"
+#include "impeller/geometry/vector.h"
+#include "impeller/renderer/snapshot.h"
+
+namespace impeller {
+
+/// The number of pixels that each thread group of a compute filter writes.
+static constexpr uint32_t kComputeFilterTileSize = 256u;
+
+/// The largest radius, in texels, that compute filters can run with. The
+/// texels that a thread group reads are cached in shared memory, which bounds
+/// how far its pixels can reach.
+static constexpr uint32_t kMaxComputeFilterRadius = 128u;
+
+/// The input texture axis that a directional compute filter runs along.
+struct ComputeFilterAxis {
+  /// Whether the filter runs along the X axis of the input texture, rather
+  /// than along the Y axis.
+  bool along_x = true;
+  /// The length of an input texel along the axis, once transformed by the
+  /// snapshot transform.
+  Scalar texel_length = 1;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Returns the axis of the texture of `input` that runs along
+///             `direction`, which is in the space that the snapshot transform
+///             maps to.
+///
+///             Compute filters read whole texels, so they can only run when
+///             the filter direction lines up with the texels of the input.
+///             Returns `std::nullopt` otherwise.
+///
+std::optional<ComputeFilterAxis> GetComputeFilterAxis(const Snapshot& input,
+                                                      Vector2 direction);
+
+//------------------------------------------------------------------------------
+/// @brief      Blurs `input` along `axis` with a compute kernel. The result
+///             extends `radius` texels past both ends of the input along the
+///             axis, and texels past the edges of the input are sampled with
+///             `tile_mode`.
+///
+///             Returns `std::nullopt` if the kernel could not be run, in which
+///             case the blur should be rendered with its fragment shader.
+///
+std::optional<Snapshot> RenderComputeGaussianBlur(
+    const ContentContext& renderer,
+    const Snapshot& input,
+    const ComputeFilterAxis& axis,
+    Sigma sigma,
+    uint32_t radius,
+    Entity::TileMode tile_mode);
+
+//------------------------------------------------------------------------------
+/// @brief      Dilates or erodes `input` along `axis` with a compute kernel.
+///             Dilated results extend `radius` texels past both ends of the
+///             input along the axis.
+///
+///             Returns `std::nullopt` if the kernel could not be run, in which
+///             case the filter should be rendered with its fragment shader.
+///
+std::optional<Snapshot> RenderComputeMorphology(
+    const ContentContext& renderer,
+    const Snapshot& input,
+    const ComputeFilterAxis& axis,
+    uint32_t radius,
+    FilterContents::MorphType morph_type);
+
+}  // namespace impeller
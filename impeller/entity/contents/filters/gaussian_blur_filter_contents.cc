@@ -14,6 +14,7 @@
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/contents/texture_contents.h"
 #include "impeller/geometry/rect.h"
 #include "impeller/geometry/scalar.h"
 #include "impeller/renderer/command_buffer.h"
@@ -21,8 +22,106 @@
 #include "impeller/renderer/render_target.h"
 #include "impeller/renderer/sampler_library.h"
 
+#if IMPELLER_ENABLE_COMPUTE
+#include "impeller/entity/contents/filters/directional_compute_filter.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
+
 namespace impeller {
 
+namespace {
+
+// The largest sigma, in texels, that blurs are sampled with when downsampling
+// is enabled. Larger sigmas are sampled from a downsampled copy of the input.
+constexpr Scalar kMaxDownsampledSigma = 4.0;
+
+/// Halves the input along the blur direction until its texels are at least as
+/// large as the power of two that brings the blur sigma down to
+/// `kMaxDownsampledSigma`, and sets `texel_scale` to the number of pass space
+/// units each texel covers along the blur direction.
+///
+/// Returns `std::nullopt` if the blur is small enough to be sampled from the
+/// input, or if the input isn't axis aligned with the blur direction.
+std::optional<Snapshot> DownsampleAlongBlurDirection(
+    const ContentContext& renderer,
+    const Snapshot& input,
+    const Matrix& texture_rotate,
+    Sigma sigma,
+    Scalar& texel_scale) {
+  Scalar downsample = 1;
+  while (sigma.sigma / downsample > kMaxDownsampledSigma) {
+    downsample *= 2;
+  }
+  if (downsample <= 1) {
+    return std::nullopt;
+  }
+
+  auto pass_transform = texture_rotate * input.transform;
+  if (!pass_transform.IsAffine()) {
+    return std::nullopt;
+  }
+  auto x_axis = pass_transform.TransformDirection(Vector2(1, 0));
+  auto y_axis = pass_transform.TransformDirection(Vector2(0, 1));
+  bool blur_along_x;
+  if (ScalarNearlyZero(x_axis.y) && ScalarNearlyZero(y_axis.x)) {
+    blur_along_x = true;
+    texel_scale = std::abs(x_axis.x);
+  } else if (ScalarNearlyZero(x_axis.x) && ScalarNearlyZero(y_axis.y)) {
+    blur_along_x = false;
+    texel_scale = std::abs(y_axis.x);
+  } else {
+    return std::nullopt;
+  }
+
+  // Each halving averages pairs of texels with a single bilinear sample.
+  SamplerDescriptor sampler_desc;
+  sampler_desc.min_filter = MinMagFilter::kLinear;
+  sampler_desc.mag_filter = MinMagFilter::kLinear;
+
+  Snapshot result = input;
+  bool downsampled = false;
+  while (texel_scale * 2 <= downsample) {
+    auto size = result.texture->GetSize();
+    auto half_size =
+        blur_along_x
+            ? ISize(std::ceil(size.width / 2.0), size.height)
+            : ISize(size.width, std::ceil(size.height / 2.0));
+    if (half_size == size) {
+      break;
+    }
+
+    ContentContext::SubpassCallback callback =
+        [&](const ContentContext& renderer, RenderPass& pass) {
+          auto contents = TextureContents::MakeRect(Rect::MakeSize(half_size));
+          contents->SetTexture(result.texture);
+          contents->SetSourceRect(Rect::MakeSize(size));
+          contents->SetSamplerDescriptor(sampler_desc);
+          contents->SetStencilEnabled(false);
+
+          Entity entity;
+          entity.SetContents(std::move(contents));
+          entity.SetBlendMode(BlendMode::kSource);
+          return entity.Render(renderer, pass);
+        };
+    auto texture = renderer.MakeSubpass("Gaussian Blur Downsample", half_size,
+                                        callback, /*msaa_enabled=*/false);
+    if (!texture) {
+      return std::nullopt;
+    }
+
+    auto texel_ratio = Vector2(size) / Vector2(half_size);
+    result.texture = texture;
+    result.transform = result.transform * Matrix::MakeScale(texel_ratio);
+    texel_scale *= blur_along_x ? texel_ratio.x : texel_ratio.y;
+    downsampled = true;
+  }
+  if (!downsampled) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+}  // namespace
+
 DirectionalGaussianBlurFilterContents::DirectionalGaussianBlurFilterContents() =
     default;
 
@@ -132,6 +231,42 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
   auto texture_rotate = Matrix::MakeRotationZ(
       transformed_blur_radius.Normalize().AngleTo({1, 0}));
 
+  // Large blurs are sampled from a copy of the input that is downsampled
+  // along the blur direction, so that they take a bounded number of samples.
+  // The result is upsampled bilinearly when it's drawn.
+  Scalar texel_scale = 1;
+  if (renderer.IsBlurDownsamplingEnabled()) {
+    Scalar downsampled_texel_scale;
+    auto downsampled_snapshot = DownsampleAlongBlurDirection(
+        renderer, input_snapshot.value(), texture_rotate,
+        Sigma{Radius{transformed_blur_radius_length}},
+        downsampled_texel_scale);
+    if (downsampled_snapshot.has_value()) {
+      input_snapshot = downsampled_snapshot;
+      texel_scale = downsampled_texel_scale;
+    }
+  }
+
+#if IMPELLER_ENABLE_COMPUTE
+  // Blurs along a texel axis of the input run as a compute kernel that reads
+  // each input texel once per thread group, rather than once per tap. Masked
+  // blurs are left to the fragment shaders.
+  if (renderer.IsComputeFiltersEnabled() && blur_style_ == BlurStyle::kNormal) {
+    auto axis =
+        GetComputeFilterAxis(input_snapshot.value(), transformed_blur_radius);
+    if (axis.has_value()) {
+      auto r = Radius{transformed_blur_radius_length / axis->texel_length};
+      auto result = RenderComputeGaussianBlur(
+          renderer, input_snapshot.value(), axis.value(), Sigma{r},
+          std::round(r.radius), tile_mode_);
+      if (result.has_value()) {
+        return Entity::FromSnapshot(result.value(), entity.GetBlendMode(),
+                                    entity.GetStencilDepth());
+      }
+    }
+  }
+#endif  // IMPELLER_ENABLE_COMPUTE
+
   // Converts local pass space to screen space. This is just the snapshot space
   // rotated such that the blur direction is +X.
   auto pass_transform = texture_rotate * input_snapshot->transform;
@@ -192,15 +327,16 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     frame_info.alpha_mask_sampler_y_coord_scale =
         source_snapshot->texture->GetYCoordScale();
 
+    // The blur is sampled once per input texel along the blur direction.
     FS::BlurInfo frag_info;
-    auto r = Radius{transformed_blur_radius_length};
+    auto r = Radius{transformed_blur_radius_length / texel_scale};
     frag_info.blur_sigma = Sigma{r}.sigma;
     frag_info.blur_radius = std::round(r.radius);
 
     // The blur direction is in input UV space.
     frag_info.blur_uv_offset =
         pass_transform.Invert().TransformDirection(Vector2(1, 0)).Normalize() /
-        Point(input_snapshot->GetCoverage().value().size);
+        Point(input_snapshot->GetCoverage().value().size) * texel_scale;
 
     Command cmd;
     cmd.label = SPrintF("Gaussian Blur Filter (Radius=%.2f)",
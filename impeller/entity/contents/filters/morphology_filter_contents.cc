@@ -11,6 +11,10 @@
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/sampler_library.h"
 
+#if IMPELLER_ENABLE_COMPUTE
+#include "impeller/entity/contents/filters/directional_compute_filter.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
+
 namespace impeller {
 
 DirectionalMorphologyFilterContents::DirectionalMorphologyFilterContents() =
@@ -61,6 +65,29 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
                                 entity.GetStencilDepth());
   }
 
+  auto transform = entity.GetTransformation() * effect_transform.Basis();
+  auto transformed_radius =
+      transform.TransformDirection(direction_ * radius_.radius);
+
+#if IMPELLER_ENABLE_COMPUTE
+  // Filters along a texel axis of the input run as a compute kernel that reads
+  // each input texel once per thread group, rather than once per tap.
+  if (renderer.IsComputeFiltersEnabled()) {
+    auto axis =
+        GetComputeFilterAxis(input_snapshot.value(), transformed_radius);
+    if (axis.has_value()) {
+      auto result = RenderComputeMorphology(
+          renderer, input_snapshot.value(), axis.value(),
+          std::round(transformed_radius.GetLength() / axis->texel_length),
+          morph_type_);
+      if (result.has_value()) {
+        return Entity::FromSnapshot(result.value(), entity.GetBlendMode(),
+                                    entity.GetStencilDepth());
+      }
+    }
+  }
+#endif  // IMPELLER_ENABLE_COMPUTE
+
   auto maybe_input_uvs = input_snapshot->GetCoverageUVs(coverage);
   if (!maybe_input_uvs.has_value()) {
     return std::nullopt;
@@ -92,9 +119,6 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
     frame_info.texture_sampler_y_coord_scale =
         input_snapshot->texture->GetYCoordScale();
 
-    auto transform = entity.GetTransformation() * effect_transform.Basis();
-    auto transformed_radius =
-        transform.TransformDirection(direction_ * radius_.radius);
     auto transformed_texture_vertices =
         Rect(Size(input_snapshot->texture->GetSize()))
             .GetTransformedPoints(input_snapshot->transform);
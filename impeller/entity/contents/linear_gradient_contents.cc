@@ -10,6 +10,7 @@
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/gradient_generator.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/gradient_texture_cache.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/sampler_library.h"
 
@@ -60,8 +61,8 @@ bool LinearGradientContents::RenderTexture(const ContentContext& renderer,
   using FS = LinearGradientFillPipeline::FragmentShader;
 
   auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = renderer.GetGradientTextureCache()->GetTexture(
+      gradient_data, renderer.GetContext());
   if (gradient_texture == nullptr) {
     return false;
   }
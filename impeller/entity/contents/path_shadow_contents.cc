@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/path_shadow_contents.h"
+
+#include <optional>
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/filters/inputs/filter_input.h"
+#include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/entity/geometry.h"
+#include "impeller/entity/shadow_texture_cache.h"
+#include "impeller/entity/tessellation_cache.h"
+
+namespace impeller {
+
+PathShadowContents::PathShadowContents() = default;
+
+PathShadowContents::~PathShadowContents() = default;
+
+void PathShadowContents::SetPath(Path path) {
+  path_ = std::move(path);
+}
+
+void PathShadowContents::SetSigma(Sigma sigma) {
+  sigma_ = sigma;
+}
+
+void PathShadowContents::SetColor(Color color) {
+  color_ = color;
+}
+
+std::optional<Rect> PathShadowContents::GetCoverage(
+    const Entity& entity) const {
+  auto bounds = path_.GetBoundingBox();
+  if (!bounds.has_value()) {
+    return std::nullopt;
+  }
+  Scalar radius = Radius{sigma_}.radius;
+  auto ltrb = bounds->GetLTRB();
+  return Rect::MakeLTRB(ltrb[0] - radius, ltrb[1] - radius, ltrb[2] + radius,
+                        ltrb[3] + radius)
+      .TransformBounds(entity.GetTransformation());
+}
+
+std::shared_ptr<FilterContents> PathShadowContents::MakeBlur() const {
+  auto solid_color = std::make_shared<SolidColorContents>();
+  solid_color->SetGeometry(Geometry::MakeFillPath(path_));
+  solid_color->SetColor(color_);
+  return FilterContents::MakeGaussianBlur(FilterInput::Make(solid_color),
+                                          sigma_, sigma_);
+}
+
+bool PathShadowContents::Render(const ContentContext& renderer,
+                                const Entity& entity,
+                                RenderPass& pass) const {
+  auto& cache = *renderer.GetShadowTextureCache();
+  auto key = ShadowTextureCache::MakeKey(
+      path_, entity.GetTransformation().GetMaxBasisLength(), sigma_, color_);
+  std::optional<Snapshot> snapshot;
+  if (key.has_value()) {
+    snapshot = cache.Get(key.value());
+  }
+  if (!snapshot.has_value()) {
+    if (!key.has_value() || !cache.ShouldAdmit(key.value())) {
+      return MakeBlur()->Render(renderer, entity, pass);
+    }
+    // Blur the path without the translation and rotation of the entity so
+    // that the mask can be drawn anywhere in later frames.
+    auto scale = TessellationCache::GetBucketScale(key->scale_bucket);
+    Entity scaled_entity;
+    scaled_entity.SetTransformation(Matrix::MakeScale(Vector2(scale, scale)));
+    snapshot = MakeBlur()->RenderToSnapshot(renderer, scaled_entity);
+    if (!snapshot.has_value()) {
+      return true;
+    }
+    cache.Put(key.value(), snapshot.value());
+  }
+
+  // Map the mask from the scaled local space it was rendered in.
+  auto scale = TessellationCache::GetBucketScale(key->scale_bucket);
+  snapshot->transform = entity.GetTransformation() *
+                        Matrix::MakeScale(Vector2(1 / scale, 1 / scale)) *
+                        snapshot->transform;
+  auto mask_entity = Entity::FromSnapshot(snapshot, entity.GetBlendMode(),
+                                          entity.GetStencilDepth());
+  return mask_entity->Render(renderer, pass);
+}
+
+}  // namespace impeller
@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+
+#include "impeller/entity/contents/contents.h"
+#include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/path.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Fills a path with a solid color blurred by a normal mask blur,
+///             such as the elevation shadow of a physical shape that isn't a
+///             rounded rect.
+///
+///             The blurred mask of a path with an identity is stored in the
+///             |ShadowTextureCache| of the renderer, so a shadow that is
+///             drawn again in a later frame is only blurred once.
+///
+class PathShadowContents final : public Contents {
+ public:
+  PathShadowContents();
+
+  ~PathShadowContents() override;
+
+  void SetPath(Path path);
+
+  void SetSigma(Sigma sigma);
+
+  void SetColor(Color color);
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+ private:
+  Path path_;
+  Sigma sigma_;
+  Color color_;
+
+  std::shared_ptr<FilterContents> MakeBlur() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PathShadowContents);
+};
+
+}  // namespace impeller
@@ -0,0 +1,226 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
+
+#include <sstream>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+namespace {
+
+constexpr char kManifestHeader[] = "impeller-pipeline-variants 1";
+
+std::mutex gManifestMutex;
+std::shared_ptr<fml::UniqueFD> gManifestDirectory;
+std::shared_ptr<PipelineVariantManifest> gManifest;
+
+void WriteVariant(std::ostream& stream,
+                  const std::string& label,
+                  const ContentContextOptions& o) {
+  stream << static_cast<int>(o.sample_count) << ' '
+         << static_cast<int>(o.blend_mode) << ' '
+         << static_cast<int>(o.stencil_compare) << ' '
+         << static_cast<int>(o.stencil_operation) << ' '
+         << static_cast<int>(o.primitive_type) << ' '
+         << (o.color_attachment_pixel_format.has_value()
+                 ? static_cast<int>(*o.color_attachment_pixel_format)
+                 : -1)
+         << ' ' << o.has_stencil_attachment << ' ' << o.wireframe << ' '
+         << label << '\n';
+}
+
+bool ReadVariant(const std::string& line,
+                 std::string& label,
+                 ContentContextOptions& o) {
+  std::istringstream stream(line);
+  int sample_count, blend_mode, stencil_compare, stencil_operation,
+      primitive_type, pixel_format;
+  bool has_stencil_attachment, wireframe;
+  if (!(stream >> sample_count >> blend_mode >> stencil_compare >>
+        stencil_operation >> primitive_type >> pixel_format >>
+        has_stencil_attachment >> wireframe)) {
+    return false;
+  }
+  // The label is the remainder of the line and may contain spaces.
+  stream.get();
+  std::getline(stream, label);
+  if (label.empty()) {
+    return false;
+  }
+  if (blend_mode < 0 ||
+      blend_mode > static_cast<int>(Entity::kLastPipelineBlendMode)) {
+    return false;
+  }
+  o.sample_count = static_cast<SampleCount>(sample_count);
+  o.blend_mode = static_cast<BlendMode>(blend_mode);
+  o.stencil_compare = static_cast<CompareFunction>(stencil_compare);
+  o.stencil_operation = static_cast<StencilOperation>(stencil_operation);
+  o.primitive_type = static_cast<PrimitiveType>(primitive_type);
+  if (pixel_format >= 0) {
+    o.color_attachment_pixel_format = static_cast<PixelFormat>(pixel_format);
+  } else {
+    o.color_attachment_pixel_format = std::nullopt;
+  }
+  o.has_stencil_attachment = has_stencil_attachment;
+  o.wireframe = wireframe;
+  return true;
+}
+
+}  // namespace
+
+void PipelineVariantManifest::SetCacheDirectory(fml::UniqueFD directory) {
+  std::scoped_lock lock(gManifestMutex);
+  if (gManifest) {
+    FML_LOG(ERROR) << "The pipeline variant manifest cache directory can only "
+                      "be set before the manifest is first used.";
+    return;
+  }
+  gManifestDirectory = std::make_shared<fml::UniqueFD>(std::move(directory));
+}
+
+std::shared_ptr<PipelineVariantManifest>
+PipelineVariantManifest::GetForProcess() {
+  std::scoped_lock lock(gManifestMutex);
+  if (!gManifest && gManifestDirectory && gManifestDirectory->is_valid()) {
+    gManifest = std::make_shared<PipelineVariantManifest>(gManifestDirectory);
+  }
+  return gManifest;
+}
+
+PipelineVariantManifest::PipelineVariantManifest() = default;
+
+PipelineVariantManifest::PipelineVariantManifest(
+    std::shared_ptr<fml::UniqueFD> directory)
+    : directory_(std::move(directory)) {
+  if (!directory_ || !directory_->is_valid()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "PipelineVariantManifest::Load");
+  auto mapping =
+      fml::FileMapping::CreateReadOnly(*directory_, kManifestFileName);
+  if (mapping) {
+    Deserialize(*mapping);
+  }
+}
+
+PipelineVariantManifest::~PipelineVariantManifest() = default;
+
+std::vector<ContentContextOptions> PipelineVariantManifest::GetVariants(
+    const std::string& pipeline_label) const {
+  std::scoped_lock lock(mutex_);
+  auto found = variants_.find(pipeline_label);
+  if (found == variants_.end()) {
+    return {};
+  }
+  return {found->second.begin(), found->second.end()};
+}
+
+void PipelineVariantManifest::RecordMiss(const std::string& pipeline_label,
+                                         const ContentContextOptions& options) {
+  {
+    std::scoped_lock lock(mutex_);
+    miss_count_++;
+    if (!variants_[pipeline_label].insert(options).second) {
+      // Another content context sharing this manifest already recorded the
+      // variant.
+      TraceCounts();
+      return;
+    }
+    TraceCounts();
+  }
+  Store();
+}
+
+void PipelineVariantManifest::RecordHit() {
+  std::scoped_lock lock(mutex_);
+  hit_count_++;
+  TraceCounts();
+}
+
+size_t PipelineVariantManifest::GetHitCount() const {
+  std::scoped_lock lock(mutex_);
+  return hit_count_;
+}
+
+size_t PipelineVariantManifest::GetMissCount() const {
+  std::scoped_lock lock(mutex_);
+  return miss_count_;
+}
+
+size_t PipelineVariantManifest::GetVariantCount() const {
+  std::scoped_lock lock(mutex_);
+  size_t count = 0;
+  for (const auto& [label, options] : variants_) {
+    count += options.size();
+  }
+  return count;
+}
+
+std::unique_ptr<fml::Mapping> PipelineVariantManifest::Serialize() const {
+  std::ostringstream stream;
+  stream << kManifestHeader << '\n';
+  {
+    std::scoped_lock lock(mutex_);
+    for (const auto& [label, options_set] : variants_) {
+      for (const auto& options : options_set) {
+        WriteVariant(stream, label, options);
+      }
+    }
+  }
+  auto contents = stream.str();
+  return std::make_unique<fml::DataMapping>(
+      std::vector<uint8_t>(contents.begin(), contents.end()));
+}
+
+size_t PipelineVariantManifest::Deserialize(const fml::Mapping& mapping) {
+  if (mapping.GetMapping() == nullptr) {
+    return 0;
+  }
+  std::istringstream stream(
+      std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                  mapping.GetSize()));
+  std::string line;
+  if (!std::getline(stream, line) || line != kManifestHeader) {
+    // Written by an incompatible version of the engine.
+    return 0;
+  }
+  size_t count = 0;
+  std::scoped_lock lock(mutex_);
+  while (std::getline(stream, line)) {
+    std::string label;
+    ContentContextOptions options;
+    if (!ReadVariant(line, label, options)) {
+      continue;
+    }
+    if (variants_[label].insert(options).second) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void PipelineVariantManifest::TraceCounts() const {
+  FML_TRACE_COUNTER("impeller", "PipelineVariantManifest",
+                    reinterpret_cast<int64_t>(this),  //
+                    "Hits", hit_count_,               //
+                    "Misses", miss_count_);
+}
+
+void PipelineVariantManifest::Store() const {
+  if (!directory_ || !directory_->is_valid()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "PipelineVariantManifest::Store");
+  auto mapping = Serialize();
+  if (!fml::WriteAtomically(*directory_, kManifestFileName, *mapping)) {
+    FML_LOG(WARNING) << "Could not store the pipeline variant manifest.";
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/entity/contents/content_context.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A record of the |ContentContextOptions| variants that were
+///             actually requested for each pipeline by a |ContentContext|.
+///
+///             Creating a pipeline variant the first time it is used
+///             stalls the raster thread while the backend compiles it. When
+///             a manifest is backed by a directory, every variant that is
+///             created is appended to a file in that directory so that the
+///             next launch can seed the pipeline library with the same
+///             variants before the first frame, much like the SkSL
+///             |PersistentCache| does for Skia.
+///
+///             The manifest is thread-safe and may be shared by the content
+///             contexts of several engines.
+///
+class PipelineVariantManifest {
+ public:
+  static constexpr char kManifestFileName[] = "impeller_pipeline_variants";
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the directory the process-wide manifest is loaded from
+  ///             and stored to. Must be called before the first call to
+  ///             |GetForProcess| for it to take effect.
+  ///
+  static void SetCacheDirectory(fml::UniqueFD directory);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The process-wide manifest, or nullptr if no cache directory
+  ///             has been set.
+  ///
+  static std::shared_ptr<PipelineVariantManifest> GetForProcess();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates an in-memory manifest that is never persisted.
+  ///
+  PipelineVariantManifest();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a manifest that is loaded from and stored to the
+  ///             given directory.
+  ///
+  explicit PipelineVariantManifest(std::shared_ptr<fml::UniqueFD> directory);
+
+  ~PipelineVariantManifest();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The variants recorded for the pipeline with the given label.
+  ///
+  std::vector<ContentContextOptions> GetVariants(
+      const std::string& pipeline_label) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a variant that was created because it was not in
+  ///             the manifest and counts it as a miss. The manifest is
+  ///             stored again if it is backed by a directory.
+  ///
+  void RecordMiss(const std::string& pipeline_label,
+                  const ContentContextOptions& options);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Counts the first use of a variant that was precompiled
+  ///             from the manifest.
+  ///
+  void RecordHit();
+
+  size_t GetHitCount() const;
+
+  size_t GetMissCount() const;
+
+  size_t GetVariantCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Serializes all recorded variants, one per line.
+  ///
+  std::unique_ptr<fml::Mapping> Serialize() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the variants from a mapping produced by |Serialize|.
+  ///             Malformed lines are skipped.
+  ///
+  /// @return     The number of variants that were read.
+  ///
+  size_t Deserialize(const fml::Mapping& mapping);
+
+ private:
+  using OptionsSet = std::unordered_set<ContentContextOptions,
+                                        ContentContextOptions::Hash,
+                                        ContentContextOptions::Equal>;
+
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, OptionsSet> variants_;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+
+  void TraceCounts() const;
+
+  void Store() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineVariantManifest);
+};
+
+}  // namespace impeller
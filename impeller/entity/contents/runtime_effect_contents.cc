@@ -41,82 +41,73 @@ bool RuntimeEffectContents::CanInheritOpacity(const Entity& entity) const {
   return false;
 }
 
-bool RuntimeEffectContents::Render(const ContentContext& renderer,
-                                   const Entity& entity,
-                                   RenderPass& pass) const {
-  auto context = renderer.GetContext();
-  auto library = context->GetShaderLibrary();
-
-  //--------------------------------------------------------------------------
-  /// Get or register shader.
-  ///
-
-  // TODO(113719): Register the shader function earlier.
+/// Registers the shader function of the runtime stage with the library of the
+/// context, replacing a stale function with the same entry point.
+static std::shared_ptr<const ShaderFunction> RegisterShaderFunction(
+    const Context& context,
+    RuntimeStage& runtime_stage) {
+  auto library = context.GetShaderLibrary();
 
   std::shared_ptr<const ShaderFunction> function = library->GetFunction(
-      runtime_stage_->GetEntrypoint(), ShaderStage::kFragment);
+      runtime_stage.GetEntrypoint(), ShaderStage::kFragment);
 
-  if (function && runtime_stage_->IsDirty()) {
-    context->GetPipelineLibrary()->RemovePipelinesWithEntryPoint(function);
-    library->UnregisterFunction(runtime_stage_->GetEntrypoint(),
+  if (function && runtime_stage.IsDirty()) {
+    context.GetPipelineLibrary()->RemovePipelinesWithEntryPoint(function);
+    library->UnregisterFunction(runtime_stage.GetEntrypoint(),
                                 ShaderStage::kFragment);
 
     function = nullptr;
   }
 
-  if (!function) {
-    std::promise<bool> promise;
-    auto future = promise.get_future();
-
-    library->RegisterFunction(
-        runtime_stage_->GetEntrypoint(),
-        ToShaderStage(runtime_stage_->GetShaderStage()),
-        runtime_stage_->GetCodeMapping(),
-        fml::MakeCopyable([promise = std::move(promise)](bool result) mutable {
-          promise.set_value(result);
-        }));
-
-    if (!future.get()) {
-      VALIDATION_LOG << "Failed to build runtime effect (entry point: "
-                     << runtime_stage_->GetEntrypoint() << ")";
-      return false;
-    }
-
-    function = library->GetFunction(runtime_stage_->GetEntrypoint(),
-                                    ShaderStage::kFragment);
-    if (!function) {
-      VALIDATION_LOG
-          << "Failed to fetch runtime effect function immediately after "
-             "registering it (entry point: "
-          << runtime_stage_->GetEntrypoint() << ")";
-      return false;
-    }
-
-    runtime_stage_->SetClean();
+  if (function) {
+    return function;
   }
 
-  //--------------------------------------------------------------------------
-  /// Resolve geometry.
-  ///
+  std::promise<bool> promise;
+  auto future = promise.get_future();
+
+  library->RegisterFunction(
+      runtime_stage.GetEntrypoint(),
+      ToShaderStage(runtime_stage.GetShaderStage()),
+      runtime_stage.GetCodeMapping(),
+      fml::MakeCopyable([promise = std::move(promise)](bool result) mutable {
+        promise.set_value(result);
+      }));
+
+  if (!future.get()) {
+    VALIDATION_LOG << "Failed to build runtime effect (entry point: "
+                   << runtime_stage.GetEntrypoint() << ")";
+    return nullptr;
+  }
 
-  auto geometry_result =
-      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
+  function = library->GetFunction(runtime_stage.GetEntrypoint(),
+                                  ShaderStage::kFragment);
+  if (!function) {
+    VALIDATION_LOG
+        << "Failed to fetch runtime effect function immediately after "
+           "registering it (entry point: "
+        << runtime_stage.GetEntrypoint() << ")";
+    return nullptr;
+  }
 
-  //--------------------------------------------------------------------------
-  /// Get or create runtime stage pipeline.
-  ///
+  runtime_stage.SetClean();
+  return function;
+}
 
-  const auto& caps = context->GetCapabilities();
+static PipelineDescriptor CreatePipelineDescriptor(
+    const Context& context,
+    const std::shared_ptr<const ShaderFunction>& function,
+    const ContentContextOptions& options) {
+  const auto& caps = context.GetCapabilities();
   const auto color_attachment_format = caps->GetDefaultColorFormat();
   const auto stencil_attachment_format = caps->GetDefaultStencilFormat();
 
   using VS = RuntimeEffectVertexShader;
   PipelineDescriptor desc;
   desc.SetLabel("Runtime Stage");
-  desc.AddStageEntrypoint(
-      library->GetFunction(VS::kEntrypointName, ShaderStage::kVertex));
-  desc.AddStageEntrypoint(library->GetFunction(runtime_stage_->GetEntrypoint(),
-                                               ShaderStage::kFragment));
+  desc.AddStageEntrypoint(context.GetShaderLibrary()->GetFunction(
+      VS::kEntrypointName, ShaderStage::kVertex));
+  desc.AddStageEntrypoint(function);
   auto vertex_descriptor = std::make_shared<VertexDescriptor>();
   if (!vertex_descriptor->SetStageInputs(VS::kAllShaderStageInputs)) {
     VALIDATION_LOG << "Failed to set stage inputs for runtime effect pipeline.";
@@ -126,16 +117,91 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
       0u, {.format = color_attachment_format, .blending_enabled = true});
   desc.SetStencilAttachmentDescriptors({});
   desc.SetStencilPixelFormat(stencil_attachment_format);
+  options.ApplyToPipelineDescriptor(desc);
+  return desc;
+}
+
+bool RuntimeEffectContents::BootstrapShader(
+    const std::shared_ptr<Context>& context,
+    const std::shared_ptr<RuntimeStage>& runtime_stage) {
+  if (!context || !runtime_stage) {
+    return false;
+  }
+  auto function = RegisterShaderFunction(*context, *runtime_stage);
+  if (!function) {
+    return false;
+  }
 
+  // Warm up the variants most draws end up using so that the first frame
+  // doesn't have to wait for them: source-over rects and paths, with and
+  // without MSAA.
+  std::vector<SampleCount> sample_counts = {SampleCount::kCount1};
+  if (context->GetCapabilities()->SupportsOffscreenMSAA()) {
+    sample_counts.push_back(SampleCount::kCount4);
+  }
+  std::vector<PipelineFuture<PipelineDescriptor>> pipelines;
+  for (auto sample_count : sample_counts) {
+    for (auto primitive_type :
+         {PrimitiveType::kTriangle, PrimitiveType::kTriangleStrip}) {
+      ContentContextOptions options;
+      options.sample_count = sample_count;
+      options.primitive_type = primitive_type;
+      pipelines.push_back(context->GetPipelineLibrary()->GetPipeline(
+          CreatePipelineDescriptor(*context, function, options)));
+    }
+  }
+
+  bool result = true;
+  for (auto& pipeline : pipelines) {
+    if (!pipeline.IsValid() || !pipeline.Get()) {
+      VALIDATION_LOG << "Failed to create runtime effect pipeline (entry "
+                        "point: "
+                     << runtime_stage->GetEntrypoint() << ")";
+      result = false;
+    }
+  }
+  return result;
+}
+
+bool RuntimeEffectContents::Render(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass) const {
+  auto context = renderer.GetContext();
+
+  //--------------------------------------------------------------------------
+  /// Get or register shader.
+  ///
+
+  // The shader function is usually registered ahead of time by
+  // `BootstrapShader`, but hot reload replaces the runtime stage.
+  auto function = RegisterShaderFunction(*context, *runtime_stage_);
+  if (!function) {
+    return false;
+  }
+
+  //--------------------------------------------------------------------------
+  /// Resolve geometry.
+  ///
+
+  auto geometry_result =
+      GetGeometry()->GetPositionBuffer(renderer, entity, pass);
+
+  //--------------------------------------------------------------------------
+  /// Get or create runtime stage pipeline.
+  ///
+
+  using VS = RuntimeEffectVertexShader;
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
     options.stencil_compare = CompareFunction::kEqual;
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
   options.primitive_type = geometry_result.type;
-  options.ApplyToPipelineDescriptor(desc);
 
-  auto pipeline = context->GetPipelineLibrary()->GetPipeline(desc).Get();
+  auto pipeline =
+      context->GetPipelineLibrary()
+          ->GetPipeline(CreatePipelineDescriptor(*context, function, options))
+          .Get();
   if (!pipeline) {
     VALIDATION_LOG << "Failed to get or create runtime effect pipeline.";
     return false;
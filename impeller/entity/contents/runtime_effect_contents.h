@@ -8,6 +8,7 @@
 
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/color_source_contents.h"
+#include "impeller/renderer/context.h"
 #include "impeller/runtime_stage/runtime_stage.h"
 
 namespace impeller {
@@ -19,6 +20,19 @@ class RuntimeEffectContents final : public ColorSourceContents {
     std::shared_ptr<Texture> texture;
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      Registers the shader function of the runtime stage and
+  ///             creates the pipelines it is most commonly drawn with, so
+  ///             that the first frame using it doesn't stall on shader
+  ///             compilation. Blocks until the pipelines are ready and may be
+  ///             called from any thread.
+  ///
+  /// @return     Whether the shader and all of its pipelines could be created.
+  ///
+  static bool BootstrapShader(
+      const std::shared_ptr<Context>& context,
+      const std::shared_ptr<RuntimeStage>& runtime_stage);
+
   void SetRuntimeStage(std::shared_ptr<RuntimeStage> runtime_stage);
 
   void SetUniformData(std::shared_ptr<std::vector<uint8_t>> uniform_data);
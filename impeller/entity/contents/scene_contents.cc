@@ -8,6 +8,7 @@
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/tiled_texture_contents.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/render_target_cache.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/scene/camera.h"
 #include "impeller/scene/scene.h"
@@ -45,9 +46,10 @@ bool SceneContents::Render(const ContentContext& renderer,
   }
 
   RenderTarget subpass_target = RenderTarget::CreateOffscreenMSAA(
-      *renderer.GetContext(),        // context
-      ISize(coverage.value().size),  // size
-      "SceneContents",               // label
+      *renderer.GetContext(),            // context
+      *renderer.GetRenderTargetCache(),  // allocator
+      ISize(coverage.value().size),      // size
+      "SceneContents",                   // label
       RenderTarget::AttachmentConfigMSAA{
           .storage_mode = StorageMode::kDeviceTransient,
           .resolve_storage_mode = StorageMode::kDevicePrivate,
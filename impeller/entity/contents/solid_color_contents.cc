@@ -5,6 +5,7 @@
 #include "solid_color_contents.h"
 
 #include "impeller/entity/contents/clip_contents.h"
+#include "impeller/entity/contents/color_batch_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
 #include "impeller/geometry/path.h"
@@ -68,7 +69,8 @@ bool SolidColorContents::Render(const ContentContext& renderer,
   cmd.label = "Solid Fill";
   cmd.stencil_reference = entity.GetStencilDepth();
 
-  auto geometry_result = geometry_->GetPositionBuffer(renderer, entity, pass);
+  auto geometry_result =
+      geometry_->GetPositionBufferForMVP(renderer, entity, pass);
 
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
@@ -100,6 +102,20 @@ bool SolidColorContents::Render(const ContentContext& renderer,
   return true;
 }
 
+bool SolidColorContents::AddToBatch(const Entity& entity,
+                                    ColorBatchContents& batch) const {
+  if (geometry_ == nullptr) {
+    return false;
+  }
+  return batch.AddGeometry(*geometry_, entity.GetTransformation(), GetColor());
+}
+
+bool SolidColorContents::IsOpaqueOver(const Entity& entity,
+                                      const Rect& rect) const {
+  return GetColor().IsOpaque() && geometry_ &&
+         geometry_->CoversArea(entity.GetTransformation(), rect);
+}
+
 std::unique_ptr<SolidColorContents> SolidColorContents::Make(const Path& path,
                                                              Color color) {
   auto contents = std::make_unique<SolidColorContents>();
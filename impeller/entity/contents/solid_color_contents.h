@@ -53,6 +53,13 @@ class SolidColorContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool AddToBatch(const Entity& entity,
+                  ColorBatchContents& batch) const override;
+
+  // |Contents|
+  bool IsOpaqueOver(const Entity& entity, const Rect& rect) const override;
+
  private:
   std::shared_ptr<Geometry> geometry_;
 
@@ -95,7 +95,12 @@ static bool CommonRender(
   VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
 
   SamplerDescriptor sampler_desc;
-  if (entity.GetTransformation().IsTranslationScaleOnly()) {
+  if constexpr (std::is_same_v<TPipeline, GlyphAtlasSdfPipeline>) {
+    // Signed-distance fields are stored at a fixed size and have to be
+    // interpolated at every other one.
+    sampler_desc.min_filter = MinMagFilter::kLinear;
+    sampler_desc.mag_filter = MinMagFilter::kLinear;
+  } else if (entity.GetTransformation().IsTranslationScaleOnly()) {
     sampler_desc.min_filter = MinMagFilter::kNearest;
     sampler_desc.mag_filter = MinMagFilter::kNearest;
   } else {
@@ -270,12 +275,21 @@ bool TextContents::Render(const ContentContext& renderer,
 
   // Information shared by all glyph draw calls.
   Command cmd;
-  cmd.label = "TextFrame";
   auto opts = OptionsFromPassAndEntity(pass, entity);
   opts.primitive_type = PrimitiveType::kTriangle;
-  cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
   cmd.stencil_reference = entity.GetStencilDepth();
 
+  // The text render context hands out signed-distance fields in place of
+  // alpha bitmaps while the scale of the text animates.
+  if (atlas->GetType() == GlyphAtlas::Type::kSignedDistanceField) {
+    cmd.label = "TextFrameSDF";
+    cmd.pipeline = renderer.GetGlyphAtlasSdfPipeline(opts);
+    return CommonRender<GlyphAtlasSdfPipeline>(renderer, entity, pass, color,
+                                               frame_, offset_, atlas, cmd);
+  }
+
+  cmd.label = "TextFrame";
+  cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
   return CommonRender<GlyphAtlasPipeline>(renderer, entity, pass, color, frame_,
                                           offset_, atlas, cmd);
 }
@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/texture_batch_contents.h"
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/entity.h"
+#include "impeller/entity/texture_fill.frag.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/sampler_library.h"
+
+namespace impeller {
+
+TextureBatchContents::TextureBatchContents(std::shared_ptr<ImageAtlas> atlas)
+    : atlas_(std::move(atlas)) {}
+
+TextureBatchContents::~TextureBatchContents() = default;
+
+const std::shared_ptr<ImageAtlas>& TextureBatchContents::GetImageAtlas()
+    const {
+  return atlas_;
+}
+
+bool TextureBatchContents::AddRect(const Rect& rect,
+                                   const Matrix& transform,
+                                   const std::shared_ptr<Texture>& texture,
+                                   const Rect& source_rect,
+                                   const SamplerDescriptor& sampler_descriptor,
+                                   Scalar opacity) {
+  if (!texture || !transform.IsAffine()) {
+    return false;
+  }
+  if (!IsEmpty() &&
+      (texture != texture_ || !sampler_descriptor.IsEqual(sampler_descriptor_) ||
+       opacity != opacity_)) {
+    return false;
+  }
+  if (vtx_builder_.GetVertexCount() + 6 > kMaxVertexCount) {
+    return false;
+  }
+
+  auto points = rect.GetTransformedPoints(transform);
+  auto uvs = source_rect.GetTransformedPoints(
+      Matrix::MakeScale(1.0f / Vector2(texture->GetSize())));
+  for (auto i : {0, 1, 2, 1, 2, 3}) {
+    VS::PerVertexData data;
+    data.position = points[i];
+    data.texture_coords = uvs[i];
+    vtx_builder_.AppendVertex(data);
+  }
+
+  texture_ = texture;
+  sampler_descriptor_ = sampler_descriptor;
+  opacity_ = opacity;
+  auto coverage = Rect::MakePointBounds(points.begin(), points.end());
+  if (coverage.has_value()) {
+    coverage_ = coverage_.has_value() ? coverage_->Union(coverage.value())
+                                      : coverage;
+  }
+  return true;
+}
+
+void TextureBatchContents::Clear() {
+  vtx_builder_ = {};
+  texture_ = nullptr;
+  coverage_ = std::nullopt;
+}
+
+bool TextureBatchContents::IsEmpty() const {
+  return vtx_builder_.GetVertexCount() == 0u;
+}
+
+// |Contents|
+std::optional<Rect> TextureBatchContents::GetCoverage(
+    const Entity& entity) const {
+  if (!coverage_.has_value()) {
+    return std::nullopt;
+  }
+  return coverage_->TransformBounds(entity.GetTransformation());
+}
+
+// |Contents|
+bool TextureBatchContents::Render(const ContentContext& renderer,
+                                  const Entity& entity,
+                                  RenderPass& pass) const {
+  using FS = TextureFillFragmentShader;
+
+  if (IsEmpty()) {
+    return true;
+  }
+
+  Command cmd;
+  cmd.label = "Texture Batch";
+  cmd.stencil_reference = entity.GetStencilDepth();
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  auto opts = OptionsFromPassAndEntity(pass, entity);
+  opts.primitive_type = PrimitiveType::kTriangle;
+  cmd.pipeline = renderer.GetTexturePipeline(opts);
+  cmd.BindVertices(vtx_builder_.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation();
+  frame_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = opacity_;
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+  FS::BindTextureSampler(cmd, texture_,
+                         renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                             sampler_descriptor_));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+}  // namespace impeller
@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/sampler_descriptor.h"
+#include "impeller/core/texture.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/entity/image_atlas.h"
+#include "impeller/entity/texture_fill.vert.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Textured rectangles that are collected from the contents of
+///             several entities and drawn with a single command. Every
+///             rectangle samples the same texture with the same sampler and
+///             opacity, which is what packing images into the |ImageAtlas|
+///             makes possible for draws of different images.
+///
+///             Like the |ColorBatchContents|, the rectangles are stored in the
+///             space of the render pass and drawn in the order they were
+///             added.
+///
+class TextureBatchContents final : public Contents {
+ public:
+  /// @param atlas  The atlas that the textures of added contents are
+  ///               resolved with, if any.
+  explicit TextureBatchContents(std::shared_ptr<ImageAtlas> atlas);
+
+  ~TextureBatchContents() override;
+
+  const std::shared_ptr<ImageAtlas>& GetImageAtlas() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a rectangle that samples the given region of the
+  ///             texture, in texels.
+  ///
+  /// @return     Whether the rectangle fit in the batch and can be drawn with
+  ///             the texture, sampler, and opacity of the batch. If not, the
+  ///             batch is unchanged.
+  ///
+  bool AddRect(const Rect& rect,
+               const Matrix& transform,
+               const std::shared_ptr<Texture>& texture,
+               const Rect& source_rect,
+               const SamplerDescriptor& sampler_descriptor,
+               Scalar opacity);
+
+  void Clear();
+
+  bool IsEmpty() const;
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+ private:
+  using VS = TextureFillVertexShader;
+
+  static constexpr size_t kMaxVertexCount = 1u << 16;
+
+  const std::shared_ptr<ImageAtlas> atlas_;
+  VertexBufferBuilder<VS::PerVertexData, uint32_t> vtx_builder_;
+  std::shared_ptr<Texture> texture_;
+  SamplerDescriptor sampler_descriptor_;
+  Scalar opacity_ = 1.0f;
+  std::optional<Rect> coverage_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TextureBatchContents);
+};
+
+}  // namespace impeller
@@ -10,7 +10,9 @@
 
 #include "impeller/core/formats.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/texture_batch_contents.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/image_atlas.h"
 #include "impeller/entity/texture_fill.frag.h"
 #include "impeller/entity/texture_fill.vert.h"
 #include "impeller/geometry/constants.h"
@@ -110,6 +112,53 @@ static TextureFillVertexShader::PerVertexData ComputeVertexData(
   return data;
 }
 
+std::pair<std::shared_ptr<Texture>, Rect> TextureContents::ResolveTexture(
+    ImageAtlas* atlas,
+    const Entity& entity) const {
+  if (!atlas || !ImageAtlas::CanPack(*texture_)) {
+    return {texture_, source_rect_};
+  }
+
+  // Packed images are clamped to their edges by their border, and must not
+  // be sampled past it.
+  if (sampler_descriptor_.width_address_mode !=
+          SamplerAddressMode::kClampToEdge ||
+      sampler_descriptor_.height_address_mode !=
+          SamplerAddressMode::kClampToEdge ||
+      !Rect::MakeSize(texture_->GetSize()).Contains(source_rect_)) {
+    return {texture_, source_rect_};
+  }
+
+  // Pages have no mip levels, so minified draws of images that have them are
+  // drawn from their own texture.
+  if (texture_->GetTextureDescriptor().mip_count > 1u) {
+    auto scale = entity.GetTransformation().GetScale();
+    if (scale.x * rect_.size.width < source_rect_.size.width ||
+        scale.y * rect_.size.height < source_rect_.size.height) {
+      return {texture_, source_rect_};
+    }
+  }
+
+  auto entry = atlas->Find(texture_);
+  if (!entry.has_value()) {
+    return {texture_, source_rect_};
+  }
+  return {entry->page, source_rect_.Shift(Point(entry->origin))};
+}
+
+bool TextureContents::AddToTextureBatch(const Entity& entity,
+                                        TextureBatchContents& batch) const {
+  // The batch is drawn with the stencil test of the entity.
+  if (!stencil_enabled_ || rect_.size.IsEmpty() || source_rect_.IsEmpty() ||
+      texture_ == nullptr || texture_->GetSize().IsEmpty()) {
+    return false;
+  }
+  auto [texture, source_rect] =
+      ResolveTexture(batch.GetImageAtlas().get(), entity);
+  return batch.AddRect(rect_, entity.GetTransformation(), texture, source_rect,
+                       sampler_descriptor_, GetOpacity());
+}
+
 bool TextureContents::Render(const ContentContext& renderer,
                              const Entity& entity,
                              RenderPass& pass) const {
@@ -123,10 +172,13 @@ bool TextureContents::Render(const ContentContext& renderer,
     return true;
   }
 
+  auto [texture, source_rect] =
+      ResolveTexture(renderer.GetImageAtlas().get(), entity);
+
   VertexBufferBuilder<VS::PerVertexData> vertex_builder;
   for (const auto vtx : rect_.GetPoints()) {
     vertex_builder.AppendVertex(ComputeVertexData(
-        vtx, coverage_rect, texture_->GetSize(), source_rect_));
+        vtx, coverage_rect, texture->GetSize(), source_rect));
   }
 
   auto& host_buffer = pass.GetTransientsBuffer();
@@ -134,7 +186,7 @@ bool TextureContents::Render(const ContentContext& renderer,
   VS::FrameInfo frame_info;
   frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation();
-  frame_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
+  frame_info.texture_sampler_y_coord_scale = texture->GetYCoordScale();
 
   FS::FragInfo frag_info;
   frag_info.alpha = GetOpacity();
@@ -156,7 +208,7 @@ bool TextureContents::Render(const ContentContext& renderer,
   cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
   VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
   FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
-  FS::BindTextureSampler(cmd, texture_,
+  FS::BindTextureSampler(cmd, texture,
                          renderer.GetContext()->GetSamplerLibrary()->GetSampler(
                              sampler_descriptor_));
   pass.AddCommand(std::move(cmd));
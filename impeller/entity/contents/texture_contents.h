@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -15,6 +16,7 @@
 
 namespace impeller {
 
+class ImageAtlas;
 class Texture;
 
 class TextureContents final : public Contents {
@@ -65,6 +67,10 @@ class TextureContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool AddToTextureBatch(const Entity& entity,
+                         TextureBatchContents& batch) const override;
+
   // |Contents|
   bool CanInheritOpacity(const Entity& entity) const override;
 
@@ -74,6 +80,13 @@ class TextureContents final : public Contents {
   void SetDeferApplyingOpacity(bool defer_applying_opacity);
 
  private:
+  /// The texture to sample and the region of it to sample, in texels. These
+  /// are the ones of the image atlas page when the texture is packed into the
+  /// image atlas of the renderer.
+  std::pair<std::shared_ptr<Texture>, Rect> ResolveTexture(
+      ImageAtlas* atlas,
+      const Entity& entity) const;
+
   std::string label_;
 
   Rect rect_;
@@ -4,7 +4,13 @@
 
 #include "impeller/entity/entity_pass.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <utility>
 #include <variant>
 
@@ -17,13 +23,16 @@
 #include "impeller/core/formats.h"
 #include "impeller/core/texture.h"
 #include "impeller/entity/contents/clip_contents.h"
+#include "impeller/entity/contents/color_batch_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
+#include "impeller/entity/contents/texture_batch_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/inline_pass_context.h"
+#include "impeller/entity/render_target_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/renderer/command.h"
@@ -71,19 +80,51 @@ size_t EntityPass::GetSubpassesDepth() const {
 
 std::optional<Rect> EntityPass::GetElementsCoverage(
     std::optional<Rect> coverage_crop) const {
+  // The coverage of the clips in this pass, indexed by their depth relative to
+  // the pass. Elements are cropped to the clips they are drawn under, so that
+  // content clipped inside of the pass doesn't grow its coverage. Like in the
+  // stencil coverage stack, a missing rect means that everything is clipped.
+  std::vector<std::optional<Rect>> clip_coverage_stack = {
+      coverage_crop.value_or(Rect::MakeMaximum())};
+
   std::optional<Rect> result;
   for (const auto& element : elements_) {
     std::optional<Rect> coverage;
+    const std::optional<Rect>& clip_coverage = clip_coverage_stack.back();
 
     if (auto entity = std::get_if<Entity>(&element)) {
-      coverage = entity->GetCoverage();
+      auto stencil_coverage = entity->GetStencilCoverage(clip_coverage);
+      switch (stencil_coverage.type) {
+        case Contents::StencilCoverage::Type::kNoChange:
+          break;
+        case Contents::StencilCoverage::Type::kAppend:
+          clip_coverage_stack.push_back(stencil_coverage.coverage);
+          continue;
+        case Contents::StencilCoverage::Type::kRestore: {
+          auto restoration_depth =
+              entity->GetStencilDepth() > stencil_depth_
+                  ? entity->GetStencilDepth() - stencil_depth_
+                  : 0u;
+          if (restoration_depth + 1 < clip_coverage_stack.size()) {
+            clip_coverage_stack.resize(restoration_depth + 1);
+          }
+          continue;
+        }
+      }
 
-      if (coverage.has_value() && coverage_crop.has_value()) {
-        coverage = coverage->Intersection(coverage_crop.value());
+      if (!clip_coverage.has_value()) {
+        continue;
+      }
+      coverage = entity->GetCoverage();
+      if (coverage.has_value()) {
+        coverage = coverage->Intersection(clip_coverage.value());
       }
     } else if (auto subpass =
                    std::get_if<std::unique_ptr<EntityPass>>(&element)) {
-      coverage = GetSubpassCoverage(*subpass->get(), coverage_crop);
+      if (!clip_coverage.has_value()) {
+        continue;
+      }
+      coverage = GetSubpassCoverage(*subpass->get(), clip_coverage);
     } else {
       FML_UNREACHABLE();
     }
@@ -148,6 +189,25 @@ EntityPass* EntityPass::AddSubpass(std::unique_ptr<EntityPass> pass) {
   return subpass_pointer;
 }
 
+void EntityPass::AppendElements(std::unique_ptr<EntityPass> pass) {
+  if (!pass) {
+    return;
+  }
+  for (auto& element : pass->elements_) {
+    if (auto entity = std::get_if<Entity>(&element)) {
+      AddEntity(std::move(*entity));
+      continue;
+    }
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      subpass->get()->superpass_ = nullptr;
+      AddSubpass(std::move(*subpass));
+      continue;
+    }
+    FML_UNREACHABLE();
+  }
+  pass->elements_.clear();
+}
+
 static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
                                            ISize size,
                                            bool readable,
@@ -155,16 +215,18 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
   auto context = renderer.GetContext();
 
   /// All of the load/store actions are managed by `InlinePassContext` when
-  /// `RenderPasses` are created, so we just set them to `kDontCare` here.
-  /// What's important is the `StorageMode` of the textures, which cannot be
-  /// changed for the lifetime of the textures.
+  /// `RenderPasses` are created. The actions given here only decide the
+  /// `StorageMode` of the textures, which cannot be changed for the lifetime
+  /// of the textures: a stencil that later passes read back has to be
+  /// stored, and anything else can be transient.
 
   RenderTarget target;
   if (context->GetCapabilities()->SupportsOffscreenMSAA()) {
     target = RenderTarget::CreateOffscreenMSAA(
-        *context,      // context
-        size,          // size
-        "EntityPass",  // label
+        *context,                          // context
+        *renderer.GetRenderTargetCache(),  // allocator
+        size,                              // size
+        "EntityPass",                      // label
         RenderTarget::AttachmentConfigMSAA{
             .storage_mode = StorageMode::kDeviceTransient,
             .resolve_storage_mode = StorageMode::kDevicePrivate,
@@ -175,14 +237,16 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
             .storage_mode = readable ? StorageMode::kDevicePrivate
                                      : StorageMode::kDeviceTransient,
             .load_action = LoadAction::kDontCare,
-            .store_action = StoreAction::kDontCare,
+            .store_action =
+                readable ? StoreAction::kStore : StoreAction::kDontCare,
         }  // stencil_attachment_config
     );
   } else {
     target = RenderTarget::CreateOffscreen(
-        *context,      // context
-        size,          // size
-        "EntityPass",  // label
+        *context,                          // context
+        *renderer.GetRenderTargetCache(),  // allocator
+        size,                              // size
+        "EntityPass",                      // label
         RenderTarget::AttachmentConfig{
             .storage_mode = StorageMode::kDevicePrivate,
             .load_action = LoadAction::kDontCare,
@@ -192,7 +256,8 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
             .storage_mode = readable ? StorageMode::kDevicePrivate
                                      : StorageMode::kDeviceTransient,
             .load_action = LoadAction::kDontCare,
-            .store_action = StoreAction::kDontCare,
+            .store_action =
+                readable ? StoreAction::kStore : StoreAction::kDontCare,
         }  // stencil_attachment_config
     );
   }
@@ -208,13 +273,42 @@ uint32_t EntityPass::GetTotalPassReads(ContentContext& renderer) const {
                    advanced_blend_reads_from_pass_texture_;
 }
 
+// static
+bool EntityPass::CanRenderDamage(const ContentContext& renderer,
+                                 const RenderTarget& render_target) {
+  auto color0 = render_target.GetColorAttachments().find(0u);
+  if (color0 == render_target.GetColorAttachments().end()) {
+    return false;
+  }
+  // Multisampled attachments are transient, so their contents can't be
+  // loaded; only the resolve texture keeps the pixels of the last frame. The
+  // pass is rendered offscreen and the damage copied into it instead.
+  return !color0->second.resolve_texture ||
+         renderer.GetDeviceCapabilities().SupportsTextureToTextureBlits();
+}
+
 bool EntityPass::Render(ContentContext& renderer,
-                        const RenderTarget& render_target) const {
+                        const RenderTarget& render_target,
+                        std::optional<IRect> damage) const {
   if (render_target.GetColorAttachments().empty()) {
     VALIDATION_LOG << "The root RenderTarget must have a color attachment.";
     return false;
   }
 
+  if (damage.has_value()) {
+    if (!CanRenderDamage(renderer, render_target)) {
+      VALIDATION_LOG << "The root RenderTarget can't be partially rendered.";
+      return false;
+    }
+    damage = damage->Intersection(
+        IRect::MakeSize(render_target.GetRenderTargetSize()));
+    if (!damage.has_value()) {
+      return true;
+    }
+  }
+  const bool has_resolve =
+      !!render_target.GetColorAttachments().find(0u)->second.resolve_texture;
+
   StencilCoverageStack stencil_coverage_stack = {StencilCoverageLayer{
       .coverage = Rect::MakeSize(render_target.GetRenderTargetSize()),
       .stencil_depth = 0}};
@@ -225,7 +319,8 @@ bool EntityPass::Render(ContentContext& renderer,
       // If the backend doesn't have `SupportsReadFromResolve`, we need to flip
       // between two textures when restoring a previous MSAA pass.
       renderer.GetDeviceCapabilities().SupportsReadFromResolve();
-  if (!supports_root_pass_reads && GetTotalPassReads(renderer) > 0) {
+  if ((!supports_root_pass_reads && GetTotalPassReads(renderer) > 0) ||
+      (damage.has_value() && has_resolve)) {
     auto offscreen_target =
         CreateRenderTarget(renderer, render_target.GetRenderTargetSize(), true,
                            clear_color_.Premultiply());
@@ -252,9 +347,12 @@ bool EntityPass::Render(ContentContext& renderer,
             ->SupportsTextureToTextureBlits()) {
       auto blit_pass = command_buffer->CreateBlitPass();
 
+      // Only the damage is copied, the rest of the root render target keeps
+      // its contents.
       blit_pass->AddCopy(
           offscreen_target.GetRenderTarget().GetRenderTargetTexture(),
-          render_target.GetRenderTargetTexture());
+          render_target.GetRenderTargetTexture(), damage,
+          damage.has_value() ? damage->origin : IPoint{});
 
       if (!blit_pass->EncodeCommands(
               renderer.GetContext()->GetResourceAllocator())) {
@@ -262,12 +360,21 @@ bool EntityPass::Render(ContentContext& renderer,
         return false;
       }
     } else {
-      auto render_pass = command_buffer->CreateRenderPass(render_target);
+      auto root_render_target = render_target;
+      if (damage.has_value()) {
+        auto color0 = root_render_target.GetColorAttachments().find(0)->second;
+        color0.load_action = LoadAction::kLoad;
+        root_render_target.SetColorAttachment(color0, 0);
+      }
+
+      auto render_pass = command_buffer->CreateRenderPass(root_render_target);
       render_pass->SetLabel("EntityPass Root Render Pass");
 
       {
-        auto size_rect = Rect::MakeSize(
-            offscreen_target.GetRenderTarget().GetRenderTargetSize());
+        auto size_rect = damage.has_value()
+                             ? Rect(damage.value())
+                             : Rect::MakeSize(offscreen_target.GetRenderTarget()
+                                                  .GetRenderTargetSize());
         auto contents = TextureContents::MakeRect(size_rect);
         contents->SetTexture(
             offscreen_target.GetRenderTarget().GetRenderTargetTexture());
@@ -293,9 +400,13 @@ bool EntityPass::Render(ContentContext& renderer,
     return true;
   }
 
-  // Set up the clear color of the root pass.
+  // Set up the clear color of the root pass. When rendering damage, the rest
+  // of the render target keeps its contents instead.
   auto color0 = render_target.GetColorAttachments().find(0)->second;
   color0.clear_color = clear_color_.Premultiply();
+  if (damage.has_value()) {
+    color0.load_action = LoadAction::kLoad;
+  }
 
   auto root_render_target = render_target;
   root_render_target.SetColorAttachment(color0, 0);
@@ -390,100 +501,355 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       pass_context.EndPass();
     }
 
-    auto subpass_coverage =
-        GetSubpassCoverage(*subpass, Rect::MakeSize(root_pass_size));
-    if (subpass->cover_whole_screen_) {
+    auto pass_target_size =
+        pass_context.GetPassTarget().GetRenderTarget().GetRenderTargetSize();
+    return GetEntityForSubpass(*subpass, renderer, pass_target_size,
+                               root_pass_size, global_pass_position,
+                               pass_depth, stencil_coverage_stack,
+                               std::move(backdrop_filter_contents));
+  } else {
+    FML_UNREACHABLE();
+  }
+
+  return EntityPass::EntityResult::Success(element_entity);
+}
+
+EntityPass::EntityResult EntityPass::GetEntityForSubpass(
+    const EntityPass& subpass,
+    ContentContext& renderer,
+    ISize pass_target_size,
+    ISize root_pass_size,
+    Point global_pass_position,
+    uint32_t pass_depth,
+    StencilCoverageStack& stencil_coverage_stack,
+    std::shared_ptr<Contents> backdrop_filter_contents) const {
+  // The subpass texture is clipped when it is drawn into this pass, so the
+  // parts of the subpass outside of the current clip don't need to be
+  // rendered, unless they are moved into the clip by a filter.
+  std::optional<Rect> coverage_clip = Rect::MakeSize(root_pass_size);
+  if (subpass.delegate_->CanClipSubpassTarget()) {
+    coverage_clip = stencil_coverage_stack.back().coverage;
+    if (!coverage_clip.has_value()) {
+      // Everything is clipped, so the subpass is not visible.
+      return EntityPass::EntityResult::Skip();
+    }
+  }
+  auto subpass_coverage = GetSubpassCoverage(subpass, coverage_clip);
+  if (subpass.cover_whole_screen_) {
+    subpass_coverage = Rect(global_pass_position, Size(pass_target_size));
+  }
+  if (backdrop_filter_contents) {
+    auto backdrop_coverage = backdrop_filter_contents->GetCoverage(Entity{});
+    if (backdrop_coverage.has_value()) {
+      backdrop_coverage->origin += global_pass_position;
+
       subpass_coverage =
-          Rect(global_pass_position, Size(pass_context.GetPassTarget()
-                                              .GetRenderTarget()
-                                              .GetRenderTargetSize()));
-    }
-    if (backdrop_filter_contents) {
-      auto backdrop_coverage = backdrop_filter_contents->GetCoverage(Entity{});
-      if (backdrop_coverage.has_value()) {
-        backdrop_coverage->origin += global_pass_position;
-
-        subpass_coverage =
-            subpass_coverage.has_value()
-                ? subpass_coverage->Union(backdrop_coverage.value())
-                : backdrop_coverage;
+          subpass_coverage.has_value()
+              ? subpass_coverage->Union(backdrop_coverage.value())
+              : backdrop_coverage;
+    }
+  }
+
+  if (!subpass_coverage.has_value()) {
+    // The subpass doesn't contain anything visible, so skip it.
+    return EntityPass::EntityResult::Skip();
+  }
+
+  subpass_coverage =
+      subpass_coverage->Intersection(Rect::MakeSize(root_pass_size));
+  if (!subpass_coverage.has_value() ||
+      ISize(subpass_coverage->size).IsEmpty()) {
+    // The subpass doesn't contain anything visible, so skip it.
+    return EntityPass::EntityResult::Skip();
+  }
+
+  auto subpass_target =
+      CreateRenderTarget(renderer,                                 //
+                         ISize(subpass_coverage->size),            //
+                         subpass.GetTotalPassReads(renderer) > 0,  //
+                         clear_color_.Premultiply());
+
+  if (!subpass_target.IsValid()) {
+    VALIDATION_LOG << "Subpass render target is invalid.";
+    return EntityPass::EntityResult::Failure();
+  }
+
+  // Stencil textures aren't shared between EntityPasses (as much of the
+  // time they are transient).
+  if (!subpass.OnRender(renderer,                  // renderer
+                        root_pass_size,            // root_pass_size
+                        subpass_target,            // pass_target
+                        subpass_coverage->origin,  // global_pass_position
+                        subpass_coverage->origin -
+                            global_pass_position,  // local_pass_position
+                        pass_depth + 1,            // pass_depth
+                        stencil_coverage_stack,    // stencil_coverage_stack
+                        subpass.stencil_depth_,    // stencil_depth_floor
+                        backdrop_filter_contents  // backdrop_filter_contents
+                        )) {
+    // Validation error messages are triggered for all `OnRender()` failure
+    // cases.
+    return EntityPass::EntityResult::Failure();
+  }
+
+  // The subpass target's texture may have changed during OnRender.
+  auto subpass_texture =
+      subpass_target.GetRenderTarget().GetRenderTargetTexture();
+
+  auto offscreen_texture_contents =
+      subpass.delegate_->CreateContentsForSubpassTarget(
+          subpass_texture,
+          Matrix::MakeTranslation(Vector3{-global_pass_position}) *
+              subpass.xformation_);
+
+  if (!offscreen_texture_contents) {
+    // This is an error because the subpass delegate said the pass couldn't
+    // be collapsed into its parent. Yet, when asked how it want's to
+    // postprocess the offscreen texture, it couldn't give us an answer.
+    //
+    // Theoretically, we could collapse the pass now. But that would be
+    // wasteful as we already have the offscreen texture and we don't want
+    // to discard it without ever using it. Just make the delegate do the
+    // right thing.
+    return EntityPass::EntityResult::Failure();
+  }
+
+  Entity element_entity;
+  element_entity.SetContents(std::move(offscreen_texture_contents));
+  element_entity.SetStencilDepth(subpass.stencil_depth_);
+  element_entity.SetBlendMode(subpass.blend_mode_);
+  element_entity.SetTransformation(Matrix::MakeTranslation(
+      Vector3(subpass_coverage->origin - global_pass_position)));
+  return EntityPass::EntityResult::Success(element_entity);
+}
+
+namespace {
+
+/// Renders a batch of subpasses. The calling thread and the workers claim
+/// subpasses one at a time, so waiting for the batch only ever waits on
+/// subpasses that are already being rendered.
+class SubpassRenderJob {
+ public:
+  using RenderCallback = std::function<void(size_t)>;
+
+  SubpassRenderJob(size_t count, RenderCallback callback)
+      : count_(count), callback_(std::move(callback)) {}
+
+  void Render() {
+    while (true) {
+      auto index = next_index_.fetch_add(1u);
+      if (index >= count_) {
+        return;
+      }
+      callback_(index);
+      std::scoped_lock lock(mutex_);
+      if (++completed_count_ == count_) {
+        completed_.notify_all();
       }
     }
+  }
 
-    if (!subpass_coverage.has_value()) {
-      // The subpass doesn't contain anything visible, so skip it.
-      return EntityPass::EntityResult::Skip();
+  void RenderAndWait() {
+    Render();
+    std::unique_lock lock(mutex_);
+    completed_.wait(lock, [&] { return completed_count_ == count_; });
+  }
+
+ private:
+  const size_t count_;
+  const RenderCallback callback_;
+  std::atomic<size_t> next_index_ = 0u;
+  std::mutex mutex_;
+  std::condition_variable completed_;
+  size_t completed_count_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SubpassRenderJob);
+};
+
+}  // namespace
+
+std::vector<std::optional<EntityPass::EntityResult>>
+EntityPass::RenderSubpassesConcurrently(ContentContext& renderer,
+                                        ISize pass_target_size,
+                                        ISize root_pass_size,
+                                        Point global_pass_position,
+                                        uint32_t pass_depth) const {
+  std::vector<std::optional<EntityResult>> results;
+  auto worker_task_runner = renderer.GetContext()->GetWorkerTaskRunner();
+  if (!worker_task_runner) {
+    return results;
+  }
+
+  // Subpasses with backdrop filters read from this pass and collapsed
+  // subpasses render into it, so those are rendered in order.
+  std::vector<size_t> subpass_indices;
+  for (size_t i = 0; i < elements_.size(); i++) {
+    auto subpass_ptr = std::get_if<std::unique_ptr<EntityPass>>(&elements_[i]);
+    if (!subpass_ptr) {
+      continue;
+    }
+    auto subpass = subpass_ptr->get();
+    if (subpass->backdrop_filter_proc_.has_value() ||
+        subpass->delegate_->CanElide() ||
+        subpass->delegate_->CanCollapseIntoParentPass(subpass)) {
+      continue;
     }
+    subpass_indices.push_back(i);
+  }
+  if (subpass_indices.size() < 2u) {
+    return results;
+  }
 
-    subpass_coverage =
-        subpass_coverage->Intersection(Rect::MakeSize(root_pass_size));
-    if (!subpass_coverage.has_value() ||
-        ISize(subpass_coverage->size).IsEmpty()) {
-      // The subpass doesn't contain anything visible, so skip it.
-      return EntityPass::EntityResult::Skip();
+  TRACE_EVENT1("impeller", "EntityPass::RenderSubpassesConcurrently",
+               "Subpasses", std::to_string(subpass_indices.size()).c_str());
+  results.resize(elements_.size());
+  auto job = std::make_shared<SubpassRenderJob>(
+      subpass_indices.size(), [&](size_t i) {
+        auto index = subpass_indices[i];
+        const auto& subpass =
+            *std::get<std::unique_ptr<EntityPass>>(elements_[index]);
+        // Each subpass gets its own coverage stack. Clips only ever append to
+        // the stack above the depth of the subpass, and the clips of this
+        // pass are applied when the subpass texture is drawn into it.
+        StencilCoverageStack stencil_coverage_stack;
+        for (size_t depth = 0; depth <= subpass.stencil_depth_; depth++) {
+          stencil_coverage_stack.push_back(StencilCoverageLayer{
+              .coverage = Rect::MakeSize(root_pass_size),
+              .stencil_depth = depth});
+        }
+        results[index] = GetEntityForSubpass(
+            subpass, renderer, pass_target_size, root_pass_size,
+            global_pass_position, pass_depth, stencil_coverage_stack, nullptr);
+      });
+  for (size_t i = 1; i < subpass_indices.size(); i++) {
+    worker_task_runner->PostTask([job]() {
+      TRACE_EVENT0("impeller", "RenderSubpassOnWorker");
+      job->Render();
+    });
+  }
+  job->RenderAndWait();
+  return results;
+}
+
+std::vector<bool> EntityPass::GetOccludedElements(
+    const ContentContext& renderer) const {
+  std::vector<bool> occluded;
+  if (!renderer.IsOcclusionCullingEnabled()) {
+    return occluded;
+  }
+  occluded.resize(elements_.size(), false);
+
+  // Walk the elements back to front, and check each entity against the opaque
+  // entities that are drawn after it. Only a few of the largest occluders are
+  // kept to bound the cost of the walk.
+  static constexpr size_t kMaxOccluders = 8u;
+  struct Occluder {
+    const Entity* entity;
+    Scalar area;
+  };
+  std::vector<Occluder> occluders;
+  for (size_t i = elements_.size(); i > 0; i--) {
+    const auto& element = elements_[i - 1];
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      // Backdrop filters may sample the pixels around the area they're drawn
+      // into, so nothing drawn before them can be skipped.
+      if (subpass->get()->backdrop_filter_proc_.has_value()) {
+        occluders.clear();
+      }
+      continue;
+    }
+    const auto& entity = std::get<Entity>(element);
+    const auto& contents = entity.GetContents();
+    if (!contents) {
+      continue;
+    }
+    auto coverage = entity.GetCoverage();
+    if (!coverage.has_value() ||
+        entity.GetStencilCoverage(std::nullopt).type !=
+            Contents::StencilCoverage::Type::kNoChange) {
+      continue;
     }
 
-    auto subpass_target =
-        CreateRenderTarget(renderer,                                  //
-                           ISize(subpass_coverage->size),             //
-                           subpass->GetTotalPassReads(renderer) > 0,  //
-                           clear_color_.Premultiply());
+    bool is_occluded = false;
+    for (const auto& occluder : occluders) {
+      if (occluder.entity->GetContents()->IsOpaqueOver(*occluder.entity,
+                                                       coverage.value())) {
+        is_occluded = true;
+        break;
+      }
+    }
+    if (is_occluded) {
+      occluded[i - 1] = true;
+      continue;
+    }
 
-    if (!subpass_target.IsValid()) {
-      VALIDATION_LOG << "Subpass render target is invalid.";
-      return EntityPass::EntityResult::Failure();
-    }
-
-    // Stencil textures aren't shared between EntityPasses (as much of the
-    // time they are transient).
-    if (!subpass->OnRender(renderer,                  // renderer
-                           root_pass_size,            // root_pass_size
-                           subpass_target,            // pass_target
-                           subpass_coverage->origin,  // global_pass_position
-                           subpass_coverage->origin -
-                               global_pass_position,  // local_pass_position
-                           ++pass_depth,              // pass_depth
-                           stencil_coverage_stack,    // stencil_coverage_stack
-                           subpass->stencil_depth_,   // stencil_depth_floor
-                           backdrop_filter_contents  // backdrop_filter_contents
-                           )) {
-      // Validation error messages are triggered for all `OnRender()` failure
-      // cases.
-      return EntityPass::EntityResult::Failure();
-    }
-
-    // The subpass target's texture may have changed during OnRender.
-    auto subpass_texture =
-        subpass_target.GetRenderTarget().GetRenderTargetTexture();
-
-    auto offscreen_texture_contents =
-        subpass->delegate_->CreateContentsForSubpassTarget(
-            subpass_texture,
-            Matrix::MakeTranslation(Vector3{-global_pass_position}) *
-                subpass->xformation_);
-
-    if (!offscreen_texture_contents) {
-      // This is an error because the subpass delegate said the pass couldn't
-      // be collapsed into its parent. Yet, when asked how it want's to
-      // postprocess the offscreen texture, it couldn't give us an answer.
-      //
-      // Theoretically, we could collapse the pass now. But that would be
-      // wasteful as we already have the offscreen texture and we don't want
-      // to discard it without ever using it. Just make the delegate do the
-      // right thing.
-      return EntityPass::EntityResult::Failure();
-    }
-
-    element_entity.SetContents(std::move(offscreen_texture_contents));
-    element_entity.SetStencilDepth(subpass->stencil_depth_);
-    element_entity.SetBlendMode(subpass->blend_mode_);
-    element_entity.SetTransformation(Matrix::MakeTranslation(
-        Vector3(subpass_coverage->origin - global_pass_position)));
-  } else {
-    FML_UNREACHABLE();
+    // Entities at deeper stencil depths are clipped by this pass, and may not
+    // draw all of their coverage.
+    if (entity.GetStencilDepth() != stencil_depth_ ||
+        (entity.GetBlendMode() != BlendMode::kSource &&
+         entity.GetBlendMode() != BlendMode::kSourceOver) ||
+        !contents->IsOpaqueOver(entity, coverage.value())) {
+      continue;
+    }
+    auto area = coverage->size.Area();
+    if (occluders.size() < kMaxOccluders) {
+      occluders.push_back({&entity, area});
+      continue;
+    }
+    auto smallest = std::min_element(
+        occluders.begin(), occluders.end(),
+        [](const Occluder& a, const Occluder& b) { return a.area < b.area; });
+    if (smallest->area < area) {
+      *smallest = {&entity, area};
+    }
   }
+  return occluded;
+}
 
-  return EntityPass::EntityResult::Success(element_entity);
+/// Clips that are applied as scissor rects don't write to the stencil buffer,
+/// so the stencil reference of an entity only counts the stencil clips
+/// appended above the depth floor of the pass.
+static size_t GetStencilReference(
+    const EntityPass::StencilCoverageStack& stencil_coverage_stack,
+    size_t stencil_depth,
+    size_t stencil_depth_floor) {
+  size_t reference = 0;
+  for (size_t depth = stencil_depth_floor + 1; depth <= stencil_depth;
+       depth++) {
+    if (depth >= stencil_coverage_stack.size() ||
+        !stencil_coverage_stack[depth].is_scissor) {
+      reference++;
+    }
+  }
+  return reference;
+}
+
+/// Returns the pass local scissor rect of the clips above the depth floor of
+/// the pass that are applied as scissor rects. The coverage of every layer is
+/// contained by the coverage of the layers below it, so the topmost scissor
+/// layer determines the rect.
+static std::optional<IRect> GetClipScissor(
+    const EntityPass::StencilCoverageStack& stencil_coverage_stack,
+    size_t stencil_depth_floor,
+    Point global_pass_position) {
+  for (size_t depth = stencil_coverage_stack.size();
+       depth > stencil_depth_floor + 1; depth--) {
+    const auto& layer = stencil_coverage_stack[depth - 1];
+    if (!layer.is_scissor) {
+      continue;
+    }
+    if (!layer.coverage.has_value()) {
+      return IRect();
+    }
+    auto coverage = layer.coverage.value();
+    coverage.origin -= global_pass_position;
+    auto [left, top, right, bottom] = coverage.GetLTRB();
+    return IRect::MakeLTRB(static_cast<int64_t>(std::floor(left)),
+                           static_cast<int64_t>(std::floor(top)),
+                           static_cast<int64_t>(std::ceil(right)),
+                           static_cast<int64_t>(std::ceil(bottom)));
+  }
+  return std::nullopt;
 }
 
 bool EntityPass::OnRender(
@@ -517,9 +883,102 @@ bool EntityPass::OnRender(
     pass_context.GetRenderPass(pass_depth);
   }
 
+  auto render_entity = [&renderer, &stencil_coverage_stack,
+                        &stencil_depth_floor, &global_pass_position](
+                           Entity& entity, RenderPass& pass,
+                           size_t batched_entity_count) {
+    auto clip_scissor = GetClipScissor(
+        stencil_coverage_stack, stencil_depth_floor, global_pass_position);
+    if (clip_scissor.has_value()) {
+      clip_scissor = clip_scissor->Intersection(
+          IRect::MakeSize(pass.GetRenderTargetSize()));
+      if (!clip_scissor.has_value()) {
+        return true;  // Nothing to render.
+      }
+    }
+    auto command_count = pass.GetCommandCount();
+    auto pipeline_switch_count = pass.GetPipelineSwitchCount();
+    pass.SetClipScissor(clip_scissor);
+    auto success = entity.Render(renderer, pass);
+    pass.SetClipScissor(std::nullopt);
+    if (!success) {
+      VALIDATION_LOG << "Failed to render entity.";
+      return false;
+    }
+    renderer.RecordDrawCalls(
+        pass.GetCommandCount() - command_count, batched_entity_count,
+        pass.GetPipelineSwitchCount() - pipeline_switch_count);
+    return true;
+  };
+
+  // Consecutive entities that share a blend mode and stencil depth, and whose
+  // contents can be batched, are merged into a single draw. The batch is
+  // rendered before anything else is drawn into the pass or the pass ends.
+  // Solid colors and textured rectangles are batched separately, and only one
+  // of the batches holds entities at a time.
+  auto color_batch = std::make_shared<ColorBatchContents>();
+  auto texture_batch =
+      std::make_shared<TextureBatchContents>(renderer.GetImageAtlas());
+  std::vector<Entity> batched_entities;
+
+  auto add_to_batch = [&color_batch, &texture_batch,
+                       &batched_entities](const Entity& entity) {
+    if (!entity.GetContents() ||
+        entity.GetBlendMode() > Entity::kLastPipelineBlendMode) {
+      return false;
+    }
+    if (!batched_entities.empty() &&
+        (entity.GetBlendMode() != batched_entities.front().GetBlendMode() ||
+         entity.GetStencilDepth() !=
+             batched_entities.front().GetStencilDepth())) {
+      return false;
+    }
+    const auto& contents = *entity.GetContents();
+    if (!(texture_batch->IsEmpty() &&
+          contents.AddToBatch(entity, *color_batch)) &&
+        !(color_batch->IsEmpty() &&
+          contents.AddToTextureBatch(entity, *texture_batch))) {
+      return false;
+    }
+    batched_entities.push_back(entity);
+    return true;
+  };
+
+  auto flush_batch = [&color_batch, &texture_batch, &batched_entities,
+                      &pass_context, &pass_depth, &render_entity]() {
+    if (batched_entities.empty()) {
+      return true;
+    }
+    auto result = pass_context.GetRenderPass(pass_depth);
+    if (!result.pass) {
+      return false;
+    }
+    bool success;
+    if (batched_entities.size() == 1u) {
+      // Nothing to merge, so render the entity the way it would be otherwise.
+      success = render_entity(batched_entities.front(), *result.pass, 0u);
+    } else {
+      Entity batch_entity;
+      if (texture_batch->IsEmpty()) {
+        batch_entity.SetContents(color_batch);
+      } else {
+        batch_entity.SetContents(texture_batch);
+      }
+      batch_entity.SetBlendMode(batched_entities.front().GetBlendMode());
+      batch_entity.SetStencilDepth(batched_entities.front().GetStencilDepth());
+      success = render_entity(batch_entity, *result.pass,
+                              batched_entities.size());
+    }
+    batched_entities.clear();
+    color_batch->Clear();
+    texture_batch->Clear();
+    return success;
+  };
+
   auto render_element = [&stencil_depth_floor, &pass_context, &pass_depth,
-                         &renderer, &stencil_coverage_stack,
-                         &global_pass_position](Entity& element_entity) {
+                         &stencil_coverage_stack, &global_pass_position,
+                         &renderer, &add_to_batch, &flush_batch,
+                         &render_entity](Entity& element_entity) {
     auto result = pass_context.GetRenderPass(pass_depth);
 
     if (!result.pass) {
@@ -568,6 +1027,13 @@ bool EntityPass::OnRender(
       stencil_coverage.coverage->origin += global_pass_position;
     }
 
+    // Batched entities are rendered with the clip scissor of the stack at the
+    // time they are flushed, so flush them before the stack changes.
+    if (stencil_coverage.type != Contents::StencilCoverage::Type::kNoChange &&
+        !flush_batch()) {
+      return false;
+    }
+
     switch (stencil_coverage.type) {
       case Contents::StencilCoverage::Type::kNoChange:
         break;
@@ -575,7 +1041,8 @@ bool EntityPass::OnRender(
         auto op = stencil_coverage_stack.back().coverage;
         stencil_coverage_stack.push_back(StencilCoverageLayer{
             .coverage = stencil_coverage.coverage,
-            .stencil_depth = element_entity.GetStencilDepth() + 1});
+            .stencil_depth = element_entity.GetStencilDepth() + 1,
+            .is_scissor = stencil_coverage.is_pixel_aligned_rect});
         FML_DCHECK(stencil_coverage_stack.back().stencil_depth ==
                    stencil_coverage_stack.size() - 1);
 
@@ -584,6 +1051,12 @@ bool EntityPass::OnRender(
           // screen is already being clipped, so skip it.
           return true;
         }
+
+        if (stencil_coverage_stack.back().is_scissor) {
+          // Pixel aligned rect clips are applied as a scissor rect to the
+          // entities drawn above them, which avoids writing the stencil.
+          return true;
+        }
       } break;
       case Contents::StencilCoverage::Type::kRestore: {
         if (stencil_coverage_stack.back().stencil_depth <=
@@ -605,6 +1078,12 @@ bool EntityPass::OnRender(
           // Make the coverage rectangle relative to the current pass.
           restore_coverage->origin -= global_pass_position;
         }
+        auto restores_stencil = std::any_of(
+            stencil_coverage_stack.begin() + restoration_depth + 1,
+            stencil_coverage_stack.end(),
+            [](const StencilCoverageLayer& layer) {
+              return !layer.is_scissor;
+            });
         stencil_coverage_stack.resize(restoration_depth + 1);
 
         if (!stencil_coverage_stack.back().coverage.has_value()) {
@@ -612,6 +1091,11 @@ bool EntityPass::OnRender(
           return true;
         }
 
+        if (!restores_stencil) {
+          // Only scissor clips were removed, which didn't touch the stencil.
+          return true;
+        }
+
         auto restore_contents = static_cast<ClipRestoreContents*>(
             element_entity.GetContents().get());
         restore_contents->SetRestoreCoverage(restore_coverage);
@@ -619,13 +1103,20 @@ bool EntityPass::OnRender(
       } break;
     }
 
-    element_entity.SetStencilDepth(element_entity.GetStencilDepth() -
-                                   stencil_depth_floor);
-    if (!element_entity.Render(renderer, *result.pass)) {
-      VALIDATION_LOG << "Failed to render entity.";
+    element_entity.SetStencilDepth(
+        GetStencilReference(stencil_coverage_stack,
+                            element_entity.GetStencilDepth(),
+                            stencil_depth_floor));
+    if (add_to_batch(element_entity)) {
+      return true;
+    }
+    if (!flush_batch()) {
       return false;
     }
-    return true;
+    if (add_to_batch(element_entity)) {
+      return true;
+    }
+    return render_entity(element_entity, *result.pass, 0u);
   };
 
   if (backdrop_filter_proc_.has_value()) {
@@ -647,16 +1138,39 @@ bool EntityPass::OnRender(
     render_element(backdrop_entity);
   }
 
-  for (const auto& element : elements_) {
-    EntityResult result =
-        GetEntityForElement(element,                 // element
-                            renderer,                // renderer
-                            pass_context,            // pass_context
-                            root_pass_size,          // root_pass_size
-                            global_pass_position,    // global_pass_position
-                            pass_depth,              // pass_depth
-                            stencil_coverage_stack,  // stencil_coverage_stack
-                            stencil_depth_floor);    // stencil_depth_floor
+  auto subpass_results = RenderSubpassesConcurrently(
+      renderer,                                             // renderer
+      pass_target.GetRenderTarget().GetRenderTargetSize(),  // pass_target_size
+      root_pass_size,                                       // root_pass_size
+      global_pass_position,  // global_pass_position
+      pass_depth);           // pass_depth
+
+  auto occluded_elements = GetOccludedElements(renderer);
+
+  for (size_t i = 0; i < elements_.size(); i++) {
+    if (i < occluded_elements.size() && occluded_elements[i]) {
+      continue;
+    }
+
+    EntityResult result;
+    if (i < subpass_results.size() && subpass_results[i].has_value()) {
+      result = subpass_results[i].value();
+    } else {
+      // Subpasses may render into the current pass or end it.
+      if (std::holds_alternative<std::unique_ptr<EntityPass>>(elements_[i]) &&
+          !flush_batch()) {
+        return false;
+      }
+      result =
+          GetEntityForElement(elements_[i],            // element
+                              renderer,                // renderer
+                              pass_context,            // pass_context
+                              root_pass_size,          // root_pass_size
+                              global_pass_position,    // global_pass_position
+                              pass_depth,              // pass_depth
+                              stencil_coverage_stack,  // stencil_coverage_stack
+                              stencil_depth_floor);    // stencil_depth_floor
+    }
 
     switch (result.status) {
       case EntityResult::kSuccess:
@@ -692,7 +1206,7 @@ bool EntityPass::OnRender(
         // for blending (otherwise the blend pass will end up executing before
         // all the previous commands in the active pass).
 
-        if (!pass_context.EndPass()) {
+        if (!flush_batch() || !pass_context.EndPass()) {
           VALIDATION_LOG
               << "Failed to end the current render pass in order to read from "
                  "the backdrop texture and apply an advanced blend.";
@@ -730,6 +1244,10 @@ bool EntityPass::OnRender(
     }
   }
 
+  if (!flush_batch()) {
+    return false;
+  }
+
 #ifdef IMPELLER_DEBUG
   //--------------------------------------------------------------------------
   /// Draw debug checkerboard over offscreen textures.
@@ -802,26 +1320,55 @@ size_t EntityPass::GetElementCount() const {
 }
 
 std::unique_ptr<EntityPass> EntityPass::Clone() const {
-  std::vector<Element> new_elements;
-  new_elements.reserve(elements_.size());
-
+  auto pass = std::make_unique<EntityPass>();
+  pass->elements_.reserve(elements_.size());
   for (const auto& element : elements_) {
     if (auto entity = std::get_if<Entity>(&element)) {
-      new_elements.push_back(*entity);
+      pass->elements_.push_back(*entity);
       continue;
     }
     if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
-      new_elements.push_back(subpass->get()->Clone());
+      auto subpass_clone = subpass->get()->Clone();
+      subpass_clone->superpass_ = pass.get();
+      pass->elements_.push_back(std::move(subpass_clone));
       continue;
     }
     FML_UNREACHABLE();
   }
 
-  auto pass = std::make_unique<EntityPass>();
-  pass->SetElements(std::move(new_elements));
+  pass->xformation_ = xformation_;
+  pass->stencil_depth_ = stencil_depth_;
+  pass->blend_mode_ = blend_mode_;
+  pass->cover_whole_screen_ = cover_whole_screen_;
+  pass->clear_color_ = clear_color_;
+  pass->enable_offscreen_debug_checkerboard_ =
+      enable_offscreen_debug_checkerboard_;
+  pass->advanced_blend_reads_from_pass_texture_ =
+      advanced_blend_reads_from_pass_texture_;
+  pass->backdrop_filter_reads_from_pass_texture_ =
+      backdrop_filter_reads_from_pass_texture_;
+  pass->backdrop_filter_proc_ = backdrop_filter_proc_;
+  pass->delegate_ = delegate_;
   return pass;
 }
 
+void EntityPass::Reposition(const Matrix& xformation, size_t stencil_depth) {
+  xformation_ = xformation * xformation_;
+  stencil_depth_ += stencil_depth;
+  for (auto& element : elements_) {
+    if (auto entity = std::get_if<Entity>(&element)) {
+      entity->SetTransformation(xformation * entity->GetTransformation());
+      entity->IncrementStencilDepth(stencil_depth);
+      continue;
+    }
+    if (auto subpass = std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      subpass->get()->Reposition(xformation, stencil_depth);
+      continue;
+    }
+    FML_UNREACHABLE();
+  }
+}
+
 void EntityPass::SetTransformation(Matrix xformation) {
   xformation_ = xformation;
 }
@@ -44,6 +44,9 @@ class EntityPass {
   struct StencilCoverageLayer {
     std::optional<Rect> coverage;
     size_t stencil_depth;
+    /// Whether the clip that pushed this layer is applied as a scissor rect
+    /// instead of being written to the stencil buffer.
+    bool is_scissor = false;
   };
 
   using StencilCoverageStack = std::vector<StencilCoverageLayer>;
@@ -56,18 +59,47 @@ class EntityPass {
 
   size_t GetSubpassesDepth() const;
 
+  /// @brief  Creates a copy of the pass and of its subpasses. The copied
+  ///         entities share their contents with the original ones.
   std::unique_ptr<EntityPass> Clone() const;
 
+  /// @brief  Prepends |xformation| to the transformation of this pass, of its
+  ///         subpasses and of all of their entities, and raises their stencil
+  ///         depths by |stencil_depth|. Used to draw a pass that was recorded
+  ///         on its own into another one.
+  void Reposition(const Matrix& xformation, size_t stencil_depth);
+
   void AddEntity(Entity entity);
 
   void SetElements(std::vector<Element> elements);
 
   EntityPass* AddSubpass(std::unique_ptr<EntityPass> pass);
 
+  /// @brief  Moves the entities and subpasses of |pass| to the end of this
+  ///         pass.
+  void AppendElements(std::unique_ptr<EntityPass> pass);
+
   EntityPass* GetSuperpass() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Renders the pass into the given root render target.
+  ///
+  /// @param[in]  damage  If set, only the pixels of the render target within
+  ///                     this rect are rendered, and the others keep their
+  ///                     contents. The elements of the pass must not draw
+  ///                     outside of it, usually because they are clipped to
+  ///                     it. See `CanRenderDamage()`.
+  ///
   bool Render(ContentContext& renderer,
-              const RenderTarget& render_target) const;
+              const RenderTarget& render_target,
+              std::optional<IRect> damage = std::nullopt) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the root render target can be rendered partially,
+  ///             by passing a damage rect to `Render()`.
+  ///
+  static bool CanRenderDamage(const ContentContext& renderer,
+                              const RenderTarget& render_target);
 
   void IterateAllEntities(const std::function<bool(Entity&)>& iterator);
 
@@ -134,6 +166,50 @@ class EntityPass {
                                    StencilCoverageStack& stencil_coverage_stack,
                                    size_t stencil_depth_floor) const;
 
+  /// @brief     Renders a subpass that can't be collapsed into this pass to
+  ///            its own offscreen render target, and resolves the `Entity`
+  ///            that draws the offscreen texture into this pass.
+  EntityResult GetEntityForSubpass(
+      const EntityPass& subpass,
+      ContentContext& renderer,
+      ISize pass_target_size,
+      ISize root_pass_size,
+      Point global_pass_position,
+      uint32_t pass_depth,
+      StencilCoverageStack& stencil_coverage_stack,
+      std::shared_ptr<Contents> backdrop_filter_contents) const;
+
+  /// @brief     Renders the subpasses of this pass that don't read from or
+  ///            render into this pass concurrently, on the worker task
+  ///            runner of the context and the calling thread. Each subpass
+  ///            records and submits its own command buffers, which are all
+  ///            submitted before any of the commands of this pass that sample
+  ///            their textures.
+  ///
+  ///            Subpasses are culled against the root pass coverage instead
+  ///            of the current stencil coverage, which only draws more of
+  ///            them: the clips of this pass apply when the subpass textures
+  ///            are drawn into it.
+  ///
+  /// @return    The resolved entities, indexed by element. Elements that were
+  ///            not rendered are `std::nullopt` and are resolved with
+  ///            `GetEntityForElement()` in order.
+  std::vector<std::optional<EntityResult>> RenderSubpassesConcurrently(
+      ContentContext& renderer,
+      ISize pass_target_size,
+      ISize root_pass_size,
+      Point global_pass_position,
+      uint32_t pass_depth) const;
+
+  /// @brief     Finds the entities of this pass that are fully hidden behind
+  ///            opaque entities drawn after them, and so don't need to be
+  ///            rendered. Only entities that aren't clipped by this pass cover
+  ///            others, and clips and subpasses are never skipped.
+  ///
+  /// @return    Whether each element is occluded, indexed by element. Empty
+  ///            if occlusion culling is disabled.
+  std::vector<bool> GetOccludedElements(const ContentContext& renderer) const;
+
   /// @brief     OnRender is the internal command recording routine for
   ///            `EntityPass`. Its job is to walk through each `Element` which
   ///            was appended to the scene (either an `Entity` via `AddEntity()`
@@ -228,7 +304,9 @@ class EntityPass {
 
   std::optional<BackdropFilterProc> backdrop_filter_proc_ = std::nullopt;
 
-  std::unique_ptr<EntityPassDelegate> delegate_ =
+  // Shared with the clones of this pass. Delegates don't hold any state that
+  // is specific to the pass they are set on.
+  std::shared_ptr<EntityPassDelegate> delegate_ =
       EntityPassDelegate::MakeDefault();
 
   FML_DISALLOW_COPY_AND_ASSIGN(EntityPass);
@@ -29,6 +29,9 @@ class DefaultEntityPassDelegate final : public EntityPassDelegate {
     return true;
   }
 
+  // |EntityPassDelegate|
+  bool CanClipSubpassTarget() override { return true; }
+
   // |EntityPassDelegate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
@@ -30,6 +30,11 @@ class EntityPassDelegate {
   ///         If true, this method may modify the entities for the current pass.
   virtual bool CanCollapseIntoParentPass(EntityPass* entity_pass) = 0;
 
+  /// @brief  Whether the subpass target only needs to cover the clip of the
+  ///         parent pass. This isn't the case when the contents created for
+  ///         the target move pixels into the clip, as blurs do.
+  virtual bool CanClipSubpassTarget() = 0;
+
   virtual std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
       const Matrix& effect_transform) = 0;
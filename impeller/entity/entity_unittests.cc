@@ -15,16 +15,19 @@
 #include "gtest/gtest.h"
 #include "impeller/entity/contents/atlas_contents.h"
 #include "impeller/entity/contents/clip_contents.h"
+#include "impeller/entity/contents/color_batch_contents.h"
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/contents/filters/blend_filter_contents.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/linear_gradient_contents.h"
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
 #include "impeller/entity/contents/rrect_shadow_contents.h"
 #include "impeller/entity/contents/runtime_effect_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/text_contents.h"
+#include "impeller/entity/contents/texture_batch_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/contents/tiled_texture_contents.h"
 #include "impeller/entity/contents/vertices_contents.h"
@@ -33,12 +36,19 @@
 #include "impeller/entity/entity_pass_delegate.h"
 #include "impeller/entity/entity_playground.h"
 #include "impeller/entity/geometry.h"
+#include "impeller/entity/gradient_texture_cache.h"
+#include "impeller/entity/image_atlas.h"
+#include "impeller/entity/inline_pass_context.h"
+#include "impeller/entity/render_target_cache.h"
+#include "impeller/entity/shadow_texture_cache.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/geometry/sigma.h"
 #include "impeller/playground/playground.h"
 #include "impeller/playground/widgets.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
 #include "impeller/runtime_stage/runtime_stage.h"
@@ -79,6 +89,9 @@ class TestPassDelegate final : public EntityPassDelegate {
     return collapse_;
   }
 
+  // |EntityPassDelgate|
+  bool CanClipSubpassTarget() override { return true; }
+
   // |EntityPassDelgate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
@@ -91,6 +104,39 @@ class TestPassDelegate final : public EntityPassDelegate {
   const bool collapse_;
 };
 
+class BudgetedAllocator final : public Allocator {
+ public:
+  explicit BudgetedAllocator(std::shared_ptr<Allocator> allocator)
+      : allocator_(std::move(allocator)) {}
+
+  std::optional<DeviceMemoryBudget> budget;
+
+  // |Allocator|
+  std::optional<DeviceMemoryBudget> GetDeviceMemoryBudget() const override {
+    return budget;
+  }
+
+  // |Allocator|
+  ISize GetMaxTextureSizeSupported() const override {
+    return allocator_->GetMaxTextureSizeSupported();
+  }
+
+ private:
+  std::shared_ptr<Allocator> allocator_;
+
+  // |Allocator|
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    return allocator_->CreateBuffer(desc);
+  }
+
+  // |Allocator|
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return allocator_->CreateTexture(desc);
+  }
+};
+
 auto CreatePassWithRectPath(Rect rect,
                             std::optional<Rect> bounds_hint,
                             bool collapse = false) {
@@ -182,6 +228,49 @@ TEST_P(EntityTest, EntityPassCoverageRespectsCoverageLimit) {
   }
 }
 
+TEST_P(EntityTest, EntityPassCoverageRespectsClips) {
+  EntityPass pass;
+
+  auto add_rect = [&pass](Rect rect, uint32_t stencil_depth) {
+    auto contents = std::make_unique<SolidColorContents>();
+    contents->SetGeometry(Geometry::MakeRect(rect));
+    contents->SetColor(Color::Red());
+    Entity entity;
+    entity.SetContents(std::move(contents));
+    entity.SetStencilDepth(stencil_depth);
+    pass.AddEntity(entity);
+  };
+
+  auto clip = std::make_shared<ClipContents>();
+  clip->SetGeometry(Geometry::MakeRect(Rect::MakeLTRB(0, 0, 50, 50)));
+  clip->SetClipOperation(Entity::ClipOperation::kIntersect);
+  Entity clip_entity;
+  clip_entity.SetContents(clip);
+  clip_entity.SetStencilDepth(0);
+  pass.AddEntity(clip_entity);
+
+  // Drawn under the clip.
+  add_rect(Rect::MakeLTRB(0, 0, 200, 200), 1);
+  {
+    auto coverage = pass.GetElementsCoverage(std::nullopt);
+    ASSERT_TRUE(coverage.has_value());
+    ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(0, 0, 50, 50));
+  }
+
+  Entity restore_entity;
+  restore_entity.SetContents(std::make_shared<ClipRestoreContents>());
+  restore_entity.SetStencilDepth(0);
+  pass.AddEntity(restore_entity);
+
+  // Drawn after the clip was restored.
+  add_rect(Rect::MakeLTRB(100, 100, 150, 150), 0);
+  {
+    auto coverage = pass.GetElementsCoverage(std::nullopt);
+    ASSERT_TRUE(coverage.has_value());
+    ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(0, 0, 150, 150));
+  }
+}
+
 TEST_P(EntityTest, FilterCoverageRespectsCropRect) {
   auto image = CreateTextureForFixture("boston.jpg");
   auto filter = ColorFilterContents::MakeBlend(BlendMode::kSoftLight,
@@ -1675,6 +1764,52 @@ TEST_P(EntityTest, ClipContentsGetStencilCoverageIsCorrect) {
   }
 }
 
+TEST_P(EntityTest, ClipContentsDetectsPixelAlignedRectClips) {
+  auto get_stencil_coverage = [](std::unique_ptr<Geometry> geometry,
+                                 Entity::ClipOperation clip_op,
+                                 const Matrix& transform) {
+    auto clip = std::make_shared<ClipContents>();
+    clip->SetClipOperation(clip_op);
+    clip->SetGeometry(std::move(geometry));
+    Entity entity;
+    entity.SetTransformation(transform);
+    return clip->GetStencilCoverage(entity, Rect::MakeLTRB(0, 0, 100, 100));
+  };
+
+  // Rect clips under a scale and translate can be scissored.
+  ASSERT_TRUE(get_stencil_coverage(
+                  Geometry::MakeRect(Rect::MakeLTRB(5, 5, 25, 25)),
+                  Entity::ClipOperation::kIntersect,
+                  Matrix::MakeTranslation({10, 20}) * Matrix::MakeScale({2, 2}))
+                  .is_pixel_aligned_rect);
+
+  // Fractional edges would lose their antialiasing.
+  ASSERT_FALSE(get_stencil_coverage(
+                   Geometry::MakeRect(Rect::MakeLTRB(5.5, 5, 25, 25)),
+                   Entity::ClipOperation::kIntersect, Matrix())
+                   .is_pixel_aligned_rect);
+
+  // Rotated rects don't cover their bounds.
+  ASSERT_FALSE(get_stencil_coverage(
+                   Geometry::MakeRect(Rect::MakeLTRB(5, 5, 25, 25)),
+                   Entity::ClipOperation::kIntersect,
+                   Matrix::MakeRotationZ(Degrees(45)))
+                   .is_pixel_aligned_rect);
+
+  // Paths and difference clips always use the stencil.
+  ASSERT_FALSE(get_stencil_coverage(
+                   Geometry::MakeFillPath(
+                       PathBuilder{}
+                           .AddCircle(Point(50, 50), 20)
+                           .TakePath()),
+                   Entity::ClipOperation::kIntersect, Matrix())
+                   .is_pixel_aligned_rect);
+  ASSERT_FALSE(get_stencil_coverage(
+                   Geometry::MakeRect(Rect::MakeLTRB(5, 5, 25, 25)),
+                   Entity::ClipOperation::kDifference, Matrix())
+                   .is_pixel_aligned_rect);
+}
+
 TEST_P(EntityTest, RRectShadowTest) {
   auto callback = [&](ContentContext& context, RenderPass& pass) {
     static Color color = Color::Red();
@@ -2547,5 +2682,660 @@ TEST_P(EntityTest, CoverageForStrokePathWithNegativeValuesInTransform) {
   ASSERT_RECT_NEAR(coverage.value(), Rect::MakeXYWH(102.5, 342.5, 85, 155));
 }
 
+TEST_P(EntityTest, ContentContextOptionsKeysMatchEquality) {
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kLuminosity,
+      .stencil_compare = CompareFunction::kGreaterEqual,
+      .stencil_operation = StencilOperation::kIncrementClamp,
+      .primitive_type = PrimitiveType::kTriangleStrip,
+      .color_attachment_pixel_format = PixelFormat::kR8G8B8A8UNormInt,
+  };
+  ContentContextOptions copy = opts;
+  ASSERT_EQ(opts.ToKey(), copy.ToKey());
+  ASSERT_NE(opts.ToKey(), ContentContextOptions{}.ToKey());
+
+  auto variants = std::vector<ContentContextOptions>(8, opts);
+  variants[0].sample_count = SampleCount::kCount1;
+  variants[1].blend_mode = BlendMode::kColor;
+  variants[2].stencil_compare = CompareFunction::kLess;
+  variants[3].stencil_operation = StencilOperation::kDecrementClamp;
+  variants[4].primitive_type = PrimitiveType::kTriangle;
+  variants[5].color_attachment_pixel_format = std::nullopt;
+  variants[6].has_stencil_attachment = false;
+  variants[7].wireframe = true;
+  for (const auto& variant : variants) {
+    ASSERT_NE(variant.ToKey(), opts.ToKey());
+  }
+}
+
+TEST_P(EntityTest, PipelineVariantManifestRoundTrips) {
+  PipelineVariantManifest manifest;
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kSource,
+      .stencil_compare = CompareFunction::kGreaterEqual,
+      .stencil_operation = StencilOperation::kIncrementClamp,
+      .primitive_type = PrimitiveType::kTriangleStrip,
+      .color_attachment_pixel_format = PixelFormat::kR8G8B8A8UNormInt,
+      .has_stencil_attachment = false,
+  };
+  manifest.RecordMiss("SolidFill Pipeline", opts);
+  manifest.RecordMiss("SolidFill Pipeline", {});
+  manifest.RecordMiss("Texture Fill Pipeline", opts);
+  ASSERT_EQ(manifest.GetVariantCount(), 3u);
+  ASSERT_EQ(manifest.GetMissCount(), 3u);
+
+  PipelineVariantManifest loaded;
+  ASSERT_EQ(loaded.Deserialize(*manifest.Serialize()), 3u);
+  auto variants = loaded.GetVariants("SolidFill Pipeline");
+  ASSERT_EQ(variants.size(), 2u);
+  ASSERT_TRUE(std::any_of(variants.begin(), variants.end(),
+                          [&opts](const ContentContextOptions& variant) {
+                            return ContentContextOptions::Equal{}(variant,
+                                                                  opts);
+                          }));
+  ASSERT_EQ(loaded.GetVariants("Texture Fill Pipeline").size(), 1u);
+  ASSERT_TRUE(loaded.GetVariants("Unknown Pipeline").empty());
+  // Nothing was looked up against the loaded manifest yet.
+  ASSERT_EQ(loaded.GetHitCount(), 0u);
+  ASSERT_EQ(loaded.GetMissCount(), 0u);
+}
+
+TEST_P(EntityTest, PipelineVariantManifestIgnoresIncompatibleData) {
+  PipelineVariantManifest manifest;
+  fml::DataMapping garbage(std::string("not a manifest\n1 2 3\n"));
+  ASSERT_EQ(manifest.Deserialize(garbage), 0u);
+  ASSERT_EQ(manifest.GetVariantCount(), 0u);
+}
+
+TEST_P(EntityTest, ContentContextPrecompilesManifestVariants) {
+  auto manifest = std::make_shared<PipelineVariantManifest>();
+  auto opts = ContentContextOptions{
+      .blend_mode = BlendMode::kSource,
+      .color_attachment_pixel_format = PixelFormat::kB8G8R8A8UNormInt,
+  };
+  {
+    ContentContext content_context(GetContext(), manifest);
+    ASSERT_TRUE(content_context.IsValid());
+    ASSERT_NE(content_context.GetSolidFillPipeline(opts), nullptr);
+    ASSERT_NE(content_context.GetSolidFillPipeline(opts), nullptr);
+  }
+  ASSERT_EQ(manifest->GetMissCount(), 1u);
+  ASSERT_EQ(manifest->GetHitCount(), 0u);
+
+  ContentContext content_context(GetContext(), manifest);
+  ASSERT_TRUE(content_context.IsValid());
+  ASSERT_NE(content_context.GetSolidFillPipeline(opts), nullptr);
+  ASSERT_NE(content_context.GetSolidFillPipeline(opts), nullptr);
+  ASSERT_EQ(manifest->GetMissCount(), 1u);
+  ASSERT_EQ(manifest->GetHitCount(), 1u);
+}
+
+TEST_P(EntityTest, TessellationCacheBucketsScales) {
+  ASSERT_EQ(TessellationCache::GetScaleBucket(1.0), 0);
+  ASSERT_EQ(TessellationCache::GetScaleBucket(2.0), 4);
+  ASSERT_EQ(TessellationCache::GetScaleBucket(1.1),
+            TessellationCache::GetScaleBucket(1.15));
+  ASSERT_NE(TessellationCache::GetScaleBucket(1.0),
+            TessellationCache::GetScaleBucket(1.5));
+  // Tessellations are never coarser than the requested scale.
+  for (auto scale : {0.3f, 1.0f, 1.1f, 3.7f}) {
+    auto bucket = TessellationCache::GetScaleBucket(scale);
+    ASSERT_GE(TessellationCache::GetBucketScale(bucket) * 1.0001f, scale);
+  }
+  ASSERT_EQ(TessellationCache::GetBucketScale(
+                TessellationCache::GetScaleBucket(0)),
+            0);
+
+  auto path = PathBuilder{}.AddCircle({100, 100}, 50).TakePath();
+  ASSERT_FALSE(TessellationCache::MakeFillKey(path, 1.0).has_value());
+  path.SetIdentity(42);
+  auto key = TessellationCache::MakeFillKey(path, 1.0);
+  ASSERT_TRUE(key.has_value());
+  auto stroke_key = TessellationCache::MakeStrokeKey(path, 1.0, 2.0, 4.0,
+                                                     Cap::kButt, Join::kMiter);
+  ASSERT_FALSE(
+      TessellationCache::Key::Equal{}(key.value(), stroke_key.value()));
+
+  auto generation = path.GetGeneration();
+  path.SetContourClosed(true);
+  ASSERT_NE(path.GetGeneration(), generation);
+  ASSERT_FALSE(TessellationCache::Key::Equal{}(
+      key.value(), TessellationCache::MakeFillKey(path, 1.0).value()));
+}
+
+TEST_P(EntityTest, TessellationCacheEvictsLeastRecentlyUsed) {
+  auto allocator = GetContext()->GetResourceAllocator();
+  auto make_vertex_buffer = [&allocator]() {
+    VertexBufferBuilder<Point> builder;
+    for (auto i = 0; i < 16; i++) {
+      builder.AppendVertex(Point(i, i));
+    }
+    return builder.CreateVertexBuffer(*allocator);
+  };
+  auto entry_size = [](const VertexBuffer& buffer) {
+    return buffer.vertex_buffer.range.length + buffer.index_buffer.range.length;
+  };
+  auto make_key = [](uint64_t identity) {
+    TessellationCache::Key key;
+    key.identity = identity;
+    return key;
+  };
+
+  auto first = make_vertex_buffer();
+  ASSERT_TRUE(first);
+  TessellationCache cache(entry_size(first) * 2);
+
+  ASSERT_FALSE(cache.ShouldAdmit(make_key(1)));
+  ASSERT_TRUE(cache.ShouldAdmit(make_key(1)));
+  cache.Put(make_key(1), first);
+  cache.Put(make_key(2), make_vertex_buffer());
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+  ASSERT_EQ(cache.GetMemoryUsage(), entry_size(first) * 2);
+
+  // Using the first entry makes the second one the least recently used.
+  ASSERT_TRUE(cache.Get(make_key(1)).has_value());
+  cache.Put(make_key(3), make_vertex_buffer());
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+  ASSERT_EQ(cache.GetEvictionCount(), 1u);
+  ASSERT_TRUE(cache.Get(make_key(1)).has_value());
+  ASSERT_FALSE(cache.Get(make_key(2)).has_value());
+  ASSERT_TRUE(cache.Get(make_key(3)).has_value());
+  ASSERT_EQ(cache.GetHitCount(), 3u);
+  ASSERT_EQ(cache.GetMissCount(), 1u);
+
+  cache.Clear();
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetMemoryUsage(), 0u);
+}
+
+TEST_P(EntityTest, RenderTargetCacheRecyclesTexturesAcrossFrames) {
+  auto context = GetContext();
+  RenderTargetCache cache(context->GetResourceAllocator());
+
+  cache.Start();
+  auto first = RenderTarget::CreateOffscreen(*context, cache, {100, 100});
+  ASSERT_TRUE(first.IsValid());
+  auto first_texture = first.GetRenderTargetTexture().get();
+  // Textures are handed out at most once per frame.
+  auto second = RenderTarget::CreateOffscreen(*context, cache, {100, 100});
+  ASSERT_NE(second.GetRenderTargetTexture().get(), first_texture);
+  cache.End();
+  ASSERT_EQ(cache.GetCachedTextureCount(), 4u);
+  ASSERT_EQ(cache.GetMissCount(), 4u);
+
+  first = {};
+  second = {};
+  cache.Start();
+  auto third = RenderTarget::CreateOffscreen(*context, cache, {100, 100});
+  ASSERT_EQ(cache.GetHitCount(), 2u);
+  // A different size doesn't match any pooled texture.
+  auto fourth = RenderTarget::CreateOffscreen(*context, cache, {200, 100});
+  ASSERT_EQ(cache.GetMissCount(), 6u);
+  cache.End();
+  // The attachments of the second target were not used this frame.
+  ASSERT_EQ(cache.GetCachedTextureCount(), 4u);
+
+  third = {};
+  fourth = {};
+  cache.SetMemoryBudget(0);
+  cache.Start();
+  cache.End();
+  ASSERT_EQ(cache.GetCachedTextureCount(), 0u);
+  ASSERT_EQ(cache.GetMemoryUsage(), 0u);
+}
+
+TEST_P(EntityTest, RenderTargetCacheShrinksUnderMemoryPressure) {
+  auto context = GetContext();
+  auto allocator =
+      std::make_shared<BudgetedAllocator>(context->GetResourceAllocator());
+  RenderTargetCache cache(allocator);
+
+  cache.Start();
+  for (auto i = 0; i < 4; i++) {
+    RenderTarget::CreateOffscreen(*context, cache, {100, 100});
+  }
+  cache.End();
+  ASSERT_EQ(cache.GetCachedTextureCount(), 8u);
+
+  allocator->budget = DeviceMemoryBudget{.usage = 95u, .budget = 100u};
+  cache.Start();
+  for (auto i = 0; i < 4; i++) {
+    RenderTarget::CreateOffscreen(*context, cache, {100, 100});
+  }
+  cache.End();
+  ASSERT_EQ(cache.GetCachedTextureCount(), 4u);
+
+  allocator->budget = DeviceMemoryBudget{.usage = 50u, .budget = 100u};
+  cache.Start();
+  cache.End();
+  // Textures that were not used this frame are still released.
+  ASSERT_EQ(cache.GetCachedTextureCount(), 0u);
+}
+
+TEST_P(EntityTest, GradientTextureCacheSharesRampsWithTheSameColors) {
+  auto context = GetContext();
+  GradientTextureCache cache(/*max_entry_count=*/2u);
+
+  auto red_blue = CreateGradientBuffer({Color::Red(), Color::Blue()}, {0, 1});
+  auto first = cache.GetTexture(red_blue, context);
+  ASSERT_NE(first, nullptr);
+  // A gradient with the same colors and stops gets the same texture.
+  auto second = cache.GetTexture(
+      CreateGradientBuffer({Color::Red(), Color::Blue()}, {0, 1}), context);
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(cache.GetHitCount(), 1u);
+  ASSERT_EQ(cache.GetMissCount(), 1u);
+
+  auto green_blue =
+      CreateGradientBuffer({Color::Green(), Color::Blue()}, {0, 1});
+  ASSERT_NE(cache.GetTexture(green_blue, context), first);
+  auto red_green = CreateGradientBuffer({Color::Red(), Color::Green()}, {0, 1});
+  cache.GetTexture(red_green, context);
+  // The least recently used ramp was evicted.
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+  ASSERT_NE(cache.GetTexture(red_blue, context), first);
+  ASSERT_EQ(cache.GetMissCount(), 4u);
+
+  cache.Clear();
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+}
+
+TEST_P(EntityTest, ShadowTextureCacheKeysMasksByPathSigmaAndScale) {
+  auto path = PathBuilder{}.AddOval(Rect::MakeXYWH(0, 0, 100, 50)).TakePath();
+  ASSERT_FALSE(ShadowTextureCache::MakeKey(path, 1.0, Sigma{4}, Color::Black())
+                   .has_value());
+  path.SetIdentity(42);
+  auto key =
+      ShadowTextureCache::MakeKey(path, 1.1, Sigma{4}, Color::Black()).value();
+  ShadowTextureCache::Key::Equal equal;
+  // Slightly different scales share a mask.
+  ASSERT_TRUE(equal(key, ShadowTextureCache::MakeKey(path, 1.15, Sigma{4},
+                                                     Color::Black())
+                             .value()));
+  ASSERT_FALSE(equal(
+      key,
+      ShadowTextureCache::MakeKey(path, 2.0, Sigma{4}, Color::Black()).value()));
+  ASSERT_FALSE(equal(
+      key,
+      ShadowTextureCache::MakeKey(path, 1.1, Sigma{8}, Color::Black()).value()));
+  ASSERT_FALSE(equal(
+      key,
+      ShadowTextureCache::MakeKey(path, 1.1, Sigma{4}, Color::Red()).value()));
+  ASSERT_FALSE(
+      ShadowTextureCache::MakeKey(path, 0.0, Sigma{4}, Color::Black())
+          .has_value());
+
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {16, 16};
+  auto allocator = GetContext()->GetResourceAllocator();
+  auto make_snapshot = [&allocator, &desc]() {
+    return Snapshot{.texture = allocator->CreateTexture(desc)};
+  };
+  auto make_key = [](uint64_t identity) {
+    ShadowTextureCache::Key key;
+    key.identity = identity;
+    return key;
+  };
+
+  ShadowTextureCache cache(desc.GetByteSizeOfBaseMipLevel() * 2);
+  ASSERT_FALSE(cache.ShouldAdmit(make_key(1)));
+  ASSERT_TRUE(cache.ShouldAdmit(make_key(1)));
+  auto first = make_snapshot();
+  ASSERT_NE(first.texture, nullptr);
+  cache.Put(make_key(1), first);
+  cache.Put(make_key(2), make_snapshot());
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+
+  // Using the first mask makes the second one the least recently used.
+  ASSERT_EQ(cache.Get(make_key(1))->texture, first.texture);
+  cache.Put(make_key(3), make_snapshot());
+  ASSERT_EQ(cache.GetEvictionCount(), 1u);
+  ASSERT_TRUE(cache.Get(make_key(1)).has_value());
+  ASSERT_FALSE(cache.Get(make_key(2)).has_value());
+  ASSERT_EQ(cache.GetMemoryUsage(), desc.GetByteSizeOfBaseMipLevel() * 2);
+
+  cache.Clear();
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetMemoryUsage(), 0u);
+}
+
+TEST_P(EntityTest, RenderTargetUsesTransientStorageForDiscardedAttachments) {
+  auto context = GetContext();
+  auto target = RenderTarget::CreateOffscreen(
+      *context, {100, 100}, "Offscreen",
+      RenderTarget::kDefaultColorAttachmentConfig,
+      RenderTarget::AttachmentConfig{
+          .storage_mode = StorageMode::kDevicePrivate,
+          .load_action = LoadAction::kClear,
+          .store_action = StoreAction::kDontCare,
+      });
+  ASSERT_TRUE(target.IsValid());
+  ASSERT_EQ(target.GetStencilAttachment()
+                ->texture->GetTextureDescriptor()
+                .storage_mode,
+            StorageMode::kDeviceTransient);
+  ASSERT_EQ(
+      target.GetRenderTargetTexture()->GetTextureDescriptor().storage_mode,
+      StorageMode::kDevicePrivate);
+
+  // Attachments that are stored or loaded keep the requested storage mode.
+  auto stored = RenderTarget::CreateOffscreen(
+      *context, {100, 100}, "Offscreen",
+      RenderTarget::kDefaultColorAttachmentConfig,
+      RenderTarget::AttachmentConfig{
+          .storage_mode = StorageMode::kDevicePrivate,
+          .load_action = LoadAction::kClear,
+          .store_action = StoreAction::kStore,
+      });
+  ASSERT_TRUE(stored.IsValid());
+  ASSERT_EQ(stored.GetStencilAttachment()
+                ->texture->GetTextureDescriptor()
+                .storage_mode,
+            StorageMode::kDevicePrivate);
+}
+
+TEST_P(EntityTest, EntityPassBatchesSolidColorEntities) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+
+  EntityPass pass;
+  for (auto i = 0; i < 10; i++) {
+    auto contents = std::make_shared<SolidColorContents>();
+    contents->SetGeometry(
+        Geometry::MakeRRect(Rect::MakeXYWH(i * 20, 0, 15, 15), 4));
+    contents->SetColor(i % 2 ? Color::Red() : Color::Blue());
+    Entity entity;
+    entity.SetContents(std::move(contents));
+    pass.AddEntity(entity);
+  }
+  // Path fills are tessellated on their own, which ends the batch.
+  Entity path_entity;
+  path_entity.SetContents(SolidColorContents::Make(
+      PathBuilder{}.AddCircle({100, 100}, 50).TakePath(), Color::Green()));
+  pass.AddEntity(path_entity);
+
+  auto render_target =
+      RenderTarget::CreateOffscreen(*GetContext(), ISize{256, 256});
+  content_context.ResetDrawCallCounts();
+  ASSERT_TRUE(pass.Render(content_context, render_target));
+  ASSERT_EQ(content_context.GetDrawCallCount(), 2u);
+  ASSERT_EQ(content_context.GetBatchedEntityCount(), 10u);
+}
+
+TEST_P(EntityTest, RectGeometryDrawsTheSharedUnitQuad) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+  ASSERT_TRUE(content_context.GetUnitQuadVertexBuffer());
+
+  auto render_target =
+      RenderTarget::CreateOffscreen(*GetContext(), ISize{256, 256});
+  auto command_buffer = GetContext()->CreateCommandBuffer();
+  auto render_pass = command_buffer->CreateRenderPass(render_target);
+  ASSERT_TRUE(render_pass);
+
+  Entity entity;
+  entity.SetTransformation(Matrix::MakeScale({2, 2, 1}));
+  auto rect = Geometry::MakeRect(Rect::MakeXYWH(10, 20, 30, 40));
+  auto result =
+      rect->GetPositionBufferForMVP(content_context, entity, *render_pass);
+  ASSERT_EQ(result.type, PrimitiveType::kTriangleStrip);
+  ASSERT_EQ(result.vertex_buffer.vertex_buffer.buffer,
+            content_context.GetUnitQuadVertexBuffer().vertex_buffer.buffer);
+
+  // The unit quad lands on the transformed rect.
+  auto to_pass = Matrix::MakeOrthographic(ISize{256, 256}).Invert() *
+                 result.transform;
+  ASSERT_POINT_NEAR(to_pass * Point(0, 0), Point(20, 40));
+  ASSERT_POINT_NEAR(to_pass * Point(1, 1), Point(80, 120));
+}
+
+TEST_P(EntityTest, ColorBatchContentsRejectsGeometriesWithoutTriangles) {
+  ColorBatchContents batch;
+  ASSERT_TRUE(batch.IsEmpty());
+
+  auto rect = Geometry::MakeRect(Rect::MakeXYWH(10, 10, 10, 10));
+  ASSERT_TRUE(batch.AddGeometry(*rect, Matrix::MakeTranslation({10, 0}),
+                                Color::Red()));
+  auto path = Geometry::MakeFillPath(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 10, 10)).TakePath());
+  ASSERT_FALSE(batch.AddGeometry(*path, Matrix(), Color::Red()));
+
+  auto coverage = batch.GetCoverage(Entity{});
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeXYWH(20, 10, 10, 10));
+
+  batch.Clear();
+  ASSERT_TRUE(batch.IsEmpty());
+  ASSERT_FALSE(batch.GetCoverage(Entity{}).has_value());
+}
+
+TEST_P(EntityTest, ImageAtlasPacksImmutableImagesDrawnMoreThanOnce) {
+  ImageAtlas atlas(GetContext());
+
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {64, 32};
+  auto image = GetContext()->GetResourceAllocator()->CreateTexture(desc);
+  ASSERT_TRUE(image);
+  image->SetIntent(TextureIntent::kUploadFromHost);
+
+  // Textures that may still be written to are never packed.
+  ASSERT_FALSE(ImageAtlas::CanPack(*image));
+  image->SetImmutable();
+  ASSERT_TRUE(ImageAtlas::CanPack(*image));
+
+  ASSERT_FALSE(atlas.Find(image).has_value());
+  ASSERT_EQ(atlas.GetPageCount(), 0u);
+  auto entry = atlas.Find(image);
+  ASSERT_TRUE(entry.has_value());
+  ASSERT_EQ(atlas.GetPageCount(), 1u);
+  ASSERT_EQ(entry->page->GetSize(), ImageAtlas::kPageSize);
+
+  // The image stays where it was packed.
+  auto again = atlas.Find(image);
+  ASSERT_TRUE(again.has_value());
+  ASSERT_EQ(again->page, entry->page);
+  ASSERT_EQ(again->origin, entry->origin);
+
+  desc.size = {ImageAtlas::kMaxImageSize + 1, 32};
+  auto large_image = GetContext()->GetResourceAllocator()->CreateTexture(desc);
+  ASSERT_TRUE(large_image);
+  large_image->SetIntent(TextureIntent::kUploadFromHost);
+  large_image->SetImmutable();
+  ASSERT_FALSE(ImageAtlas::CanPack(*large_image));
+}
+
+TEST_P(EntityTest, TextureBatchContentsOnlyMergesDrawsOfOneTexture) {
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {16, 16};
+  auto texture = GetContext()->GetResourceAllocator()->CreateTexture(desc);
+  auto other_texture =
+      GetContext()->GetResourceAllocator()->CreateTexture(desc);
+  ASSERT_TRUE(texture && other_texture);
+
+  TextureBatchContents batch(nullptr);
+  ASSERT_TRUE(batch.IsEmpty());
+  auto source_rect = Rect::MakeSize(texture->GetSize());
+  ASSERT_TRUE(batch.AddRect(Rect::MakeXYWH(0, 0, 16, 16),
+                            Matrix::MakeTranslation({10, 0}), texture,
+                            source_rect, {}, 1.0f));
+  ASSERT_TRUE(batch.AddRect(Rect::MakeXYWH(40, 0, 16, 16), Matrix(), texture,
+                            source_rect, {}, 1.0f));
+  ASSERT_FALSE(batch.AddRect(Rect::MakeXYWH(0, 0, 16, 16), Matrix(),
+                             other_texture, source_rect, {}, 1.0f));
+  ASSERT_FALSE(batch.AddRect(Rect::MakeXYWH(0, 0, 16, 16), Matrix(), texture,
+                             source_rect, {}, 0.5f));
+
+  auto coverage = batch.GetCoverage(Entity{});
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeXYWH(10, 0, 46, 16));
+
+  batch.Clear();
+  ASSERT_TRUE(batch.IsEmpty());
+  ASSERT_FALSE(batch.GetCoverage(Entity{}).has_value());
+}
+
+TEST_P(EntityTest, EntityPassSkipsOccludedEntities) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+
+  auto make_pass = [](Color cover_color) {
+    auto pass = std::make_unique<EntityPass>();
+    Entity path_entity;
+    path_entity.SetContents(SolidColorContents::Make(
+        PathBuilder{}.AddCircle({100, 100}, 50).TakePath(), Color::Green()));
+    pass->AddEntity(path_entity);
+    Entity cover_entity;
+    auto contents = std::make_shared<SolidColorContents>();
+    contents->SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(25, 25, 150, 150)));
+    contents->SetColor(cover_color);
+    cover_entity.SetContents(std::move(contents));
+    pass->AddEntity(cover_entity);
+    return pass;
+  };
+
+  auto render_target =
+      RenderTarget::CreateOffscreen(*GetContext(), ISize{256, 256});
+
+  content_context.ResetDrawCallCounts();
+  ASSERT_TRUE(make_pass(Color::Red())->Render(content_context, render_target));
+  ASSERT_EQ(content_context.GetDrawCallCount(), 1u);
+
+  // Translucent entities don't hide what's drawn before them.
+  content_context.ResetDrawCallCounts();
+  ASSERT_TRUE(make_pass(Color::Red().WithAlpha(0.5))
+                  ->Render(content_context, render_target));
+  ASSERT_EQ(content_context.GetDrawCallCount(), 2u);
+
+  content_context.SetOcclusionCullingEnabled(false);
+  content_context.ResetDrawCallCounts();
+  ASSERT_TRUE(make_pass(Color::Red())->Render(content_context, render_target));
+  ASSERT_EQ(content_context.GetDrawCallCount(), 2u);
+}
+
+TEST_P(EntityTest, RectAndRRectGeometriesCoverAreasUnderAlignedTransforms) {
+  auto rect = Geometry::MakeRect(Rect::MakeXYWH(0, 0, 100, 100));
+  ASSERT_TRUE(rect->CoversArea(Matrix(), Rect::MakeXYWH(10, 10, 80, 80)));
+  ASSERT_TRUE(rect->CoversArea(Matrix::MakeScale({2, 2, 1}),
+                               Rect::MakeXYWH(10, 10, 180, 180)));
+  ASSERT_FALSE(rect->CoversArea(Matrix(), Rect::MakeXYWH(10, 10, 100, 80)));
+  ASSERT_FALSE(rect->CoversArea(Matrix::MakeRotationZ(Radians{0.1}),
+                                Rect::MakeXYWH(40, 40, 10, 10)));
+
+  auto rrect = Geometry::MakeRRect(Rect::MakeXYWH(0, 0, 100, 100), 10);
+  ASSERT_TRUE(rrect->CoversArea(Matrix(), Rect::MakeXYWH(0, 10, 100, 80)));
+  ASSERT_TRUE(rrect->CoversArea(Matrix(), Rect::MakeXYWH(10, 0, 80, 100)));
+  ASSERT_FALSE(rrect->CoversArea(Matrix(), Rect::MakeXYWH(0, 0, 20, 20)));
+
+  auto cover = Geometry::MakeCover();
+  ASSERT_TRUE(cover->CoversArea(Matrix(), Rect::MakeXYWH(0, 0, 1000, 1000)));
+}
+
+TEST_P(EntityTest, GaussianBlurDownsamplingPreservesCoverage) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+  auto boston = CreateTextureForFixture("boston.jpg");
+  ASSERT_TRUE(boston);
+
+  auto blur = FilterContents::MakeGaussianBlur(FilterInput::Make(boston),
+                                               Sigma{40}, Sigma{20});
+  Entity entity;
+  entity.SetTransformation(Matrix::MakeScale({0.5, 0.5, 1}));
+
+  ASSERT_TRUE(content_context.IsBlurDownsamplingEnabled());
+  auto downsampled = blur->GetEntity(content_context, entity);
+  content_context.SetBlurDownsamplingEnabled(false);
+  auto full_resolution = blur->GetEntity(content_context, entity);
+  ASSERT_TRUE(downsampled.has_value());
+  ASSERT_TRUE(full_resolution.has_value());
+
+  auto downsampled_coverage = downsampled->GetCoverage();
+  auto full_resolution_coverage = full_resolution->GetCoverage();
+  ASSERT_TRUE(downsampled_coverage.has_value());
+  ASSERT_TRUE(full_resolution_coverage.has_value());
+  ASSERT_RECT_NEAR(downsampled_coverage.value(),
+                   full_resolution_coverage.value());
+}
+
+TEST_P(EntityTest, ComputeMorphologyFilterPreservesCoverage) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+  if (!content_context.IsComputeFiltersEnabled()) {
+    GTEST_SKIP_("This backend doesn't support compute filters.");
+  }
+  auto boston = CreateTextureForFixture("boston.jpg");
+  ASSERT_TRUE(boston);
+
+  auto dilate = FilterContents::MakeMorphology(
+      FilterInput::Make(boston), Radius{10}, Radius{20},
+      FilterContents::MorphType::kDilate);
+  Entity entity;
+  entity.SetTransformation(Matrix::MakeTranslation({100, 50}));
+
+  auto compute = dilate->GetEntity(content_context, entity);
+  content_context.SetComputeFiltersEnabled(false);
+  auto fragment = dilate->GetEntity(content_context, entity);
+  ASSERT_TRUE(compute.has_value());
+  ASSERT_TRUE(fragment.has_value());
+
+  auto compute_coverage = compute->GetCoverage();
+  auto fragment_coverage = fragment->GetCoverage();
+  ASSERT_TRUE(compute_coverage.has_value());
+  ASSERT_TRUE(fragment_coverage.has_value());
+  ASSERT_RECT_NEAR(compute_coverage.value(), fragment_coverage.value());
+}
+
+TEST_P(EntityTest, ContentContextsOnTheSameContextShareContentCaches) {
+  ContentContext content_context(GetContext());
+  ContentContext spawned_content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+  ASSERT_TRUE(spawned_content_context.IsValid());
+
+  EXPECT_EQ(content_context.GetTessellationCache(),
+            spawned_content_context.GetTessellationCache());
+  EXPECT_EQ(content_context.GetGradientTextureCache(),
+            spawned_content_context.GetGradientTextureCache());
+  EXPECT_EQ(content_context.GetShadowTextureCache(),
+            spawned_content_context.GetShadowTextureCache());
+  // Render targets are recycled per frame, so each context keeps its own.
+  EXPECT_NE(content_context.GetRenderTargetCache(),
+            spawned_content_context.GetRenderTargetCache());
+}
+
+TEST_P(EntityTest, InlinePassContextKeepsContentsOnlyWhenAsked) {
+  auto context = GetContext();
+  for (auto initial_load_action : {LoadAction::kClear, LoadAction::kLoad}) {
+    auto target = RenderTarget::CreateOffscreen(
+        *context, {100, 100}, "Offscreen",
+        RenderTarget::AttachmentConfig{
+            .storage_mode = StorageMode::kDevicePrivate,
+            .load_action = initial_load_action,
+            .store_action = StoreAction::kStore,
+        });
+    ASSERT_TRUE(target.IsValid());
+    EntityPassTarget pass_target(
+        target, context->GetCapabilities()->SupportsReadFromResolve());
+    InlinePassContext pass_context(context, pass_target, 0u);
+    auto result = pass_context.GetRenderPass(0u);
+    ASSERT_TRUE(result.pass);
+
+    auto color0 =
+        result.pass->GetRenderTarget().GetColorAttachments().find(0)->second;
+    EXPECT_EQ(color0.load_action, initial_load_action);
+    EXPECT_EQ(color0.store_action, StoreAction::kStore);
+    // Nothing reads the stencil of a single pass back.
+    EXPECT_EQ(
+        result.pass->GetRenderTarget().GetStencilAttachment()->store_action,
+        StoreAction::kDontCare);
+  }
+}
+
 }  // namespace testing
 }  // namespace impeller
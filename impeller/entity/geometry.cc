@@ -4,22 +4,39 @@
 
 #include "impeller/entity/geometry.h"
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
 #include "impeller/core/device_buffer.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/position_color.vert.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/entity/texture_fill.vert.h"
 #include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/tessellator/tessellator.h"
 
+#if IMPELLER_ENABLE_COMPUTE
+#include "impeller/renderer/compute_tessellator.h"
+#include "impeller/renderer/stroke.comp.h"
+#endif  // IMPELLER_ENABLE_COMPUTE
+
 namespace impeller {
 
 Geometry::Geometry() = default;
 
 Geometry::~Geometry() = default;
 
+GeometryResult Geometry::GetPositionBufferForMVP(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  return GetPositionBuffer(renderer, entity, pass);
+}
+
 GeometryResult Geometry::GetPositionUVBuffer(Rect texture_coverage,
                                              Matrix effect_transform,
                                              const ContentContext& renderer,
@@ -28,6 +45,15 @@ GeometryResult Geometry::GetPositionUVBuffer(Rect texture_coverage,
   return {};
 }
 
+bool Geometry::AppendTriangles(const Matrix& transform,
+                               std::vector<Point>& triangles) const {
+  return false;
+}
+
+bool Geometry::CoversArea(const Matrix& transform, const Rect& rect) const {
+  return false;
+}
+
 // static
 std::unique_ptr<Geometry> Geometry::MakeFillPath(const Path& path) {
   return std::make_unique<FillPathGeometry>(path);
@@ -103,25 +129,66 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) {
+  auto scale = entity.GetTransformation().GetMaxBasisLength();
+  auto& cache = *renderer.GetTessellationCache();
+  auto key = TessellationCache::MakeFillKey(path_, scale);
+  auto admit = false;
+  if (key.has_value()) {
+    if (auto cached = cache.Get(key.value()); cached.has_value()) {
+      return GeometryResult{
+          .type = PrimitiveType::kTriangle,
+          .vertex_buffer = cached.value(),
+          .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                       entity.GetTransformation(),
+          .prevent_overdraw = false,
+      };
+    }
+    // Tessellate at the scale of the bucket so that the result can be reused
+    // for every scale within it.
+    scale = TessellationCache::GetBucketScale(key->scale_bucket);
+    admit = cache.ShouldAdmit(key.value());
+  }
+
   VertexBuffer vertex_buffer;
   auto& host_buffer = pass.GetTransientsBuffer();
-  auto tesselation_result = renderer.GetTessellator()->Tessellate(
-      path_.GetFillType(),
-      path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()),
-      [&vertex_buffer, &host_buffer](
+  auto& allocator = *renderer.GetContext()->GetResourceAllocator();
+  auto tesselation_result = renderer.GetTessellator()->TessellatePath(
+      path_, scale,
+      [&vertex_buffer, &host_buffer, &allocator, &admit](
           const float* vertices, size_t vertices_count, const uint16_t* indices,
           size_t indices_count) {
+        vertex_buffer.index_count = indices_count;
+        vertex_buffer.index_type = IndexType::k16bit;
+        if (admit) {
+          // Cached tessellations outlive the frame and can't be placed in the
+          // transients buffer.
+          auto vertices_buffer = allocator.CreateBufferWithCopy(
+              reinterpret_cast<const uint8_t*>(vertices),
+              vertices_count * sizeof(float));
+          auto indices_buffer = allocator.CreateBufferWithCopy(
+              reinterpret_cast<const uint8_t*>(indices),
+              indices_count * sizeof(uint16_t));
+          if (vertices_buffer && indices_buffer) {
+            vertices_buffer->SetLabel("Cached Path Vertices");
+            indices_buffer->SetLabel("Cached Path Indices");
+            vertex_buffer.vertex_buffer = vertices_buffer->AsBufferView();
+            vertex_buffer.index_buffer = indices_buffer->AsBufferView();
+            return true;
+          }
+          admit = false;
+        }
         vertex_buffer.vertex_buffer = host_buffer.Emplace(
             vertices, vertices_count * sizeof(float), alignof(float));
         vertex_buffer.index_buffer = host_buffer.Emplace(
             indices, indices_count * sizeof(uint16_t), alignof(uint16_t));
-        vertex_buffer.index_count = indices_count;
-        vertex_buffer.index_type = IndexType::k16bit;
         return true;
       });
   if (tesselation_result != Tessellator::Result::kSuccess) {
     return {};
   }
+  if (admit) {
+    cache.Put(key.value(), vertex_buffer);
+  }
   return GeometryResult{
       .type = PrimitiveType::kTriangle,
       .vertex_buffer = vertex_buffer,
@@ -141,9 +208,8 @@ GeometryResult FillPathGeometry::GetPositionUVBuffer(
   using VS = TextureFillVertexShader;
 
   VertexBufferBuilder<VS::PerVertexData> vertex_builder;
-  auto tesselation_result = renderer.GetTessellator()->Tessellate(
-      path_.GetFillType(),
-      path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()),
+  auto tesselation_result = renderer.GetTessellator()->TessellatePath(
+      path_, entity.GetTransformation().GetMaxBasisLength(),
       [&vertex_builder, &texture_coverage, &effect_transform](
           const float* vertices, size_t vertices_count, const uint16_t* indices,
           size_t indices_count) {
@@ -522,6 +588,80 @@ StrokePathGeometry::CreateSolidStrokeVertices(
   return vtx_builder;
 }
 
+#if IMPELLER_ENABLE_COMPUTE
+// The stroke compute shader emits a single triangle strip with butt caps. Bevel
+// joins fall out of the strip connecting consecutive segments, which matches
+// the CPU tessellation for single open contours.
+static bool CanStrokeWithCompute(const Path& path, Cap cap, Join join) {
+  if (cap != Cap::kButt || join != Join::kBevel) {
+    return false;
+  }
+  if (path.GetComponentCount(Path::ComponentType::kContour) != 1 ||
+      path.GetComponentCount() < 2) {
+    return false;
+  }
+  ContourComponent contour;
+  return path.GetContourComponentAtIndex(0, contour) && !contour.is_closed;
+}
+
+static std::optional<VertexBuffer> CreateComputeStrokeVertices(
+    const ContentContext& renderer,
+    const Path& path,
+    Scalar stroke_width,
+    Scalar scale) {
+  using SS = StrokeComputeShader;
+
+  auto vertex_count = ComputeTessellator::GetMaxStrokeVertexCount(path);
+  if (!vertex_count.has_value() ||
+      vertex_count.value() > std::numeric_limits<uint16_t>::max()) {
+    return std::nullopt;
+  }
+
+  auto context = renderer.GetContext();
+  auto& allocator = *context->GetResourceAllocator();
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.size =
+      vertex_count.value() * sizeof(SolidFillVertexShader::PerVertexData);
+  auto vertices = allocator.CreateBuffer(desc);
+  SS::VertexBufferCount count = {};
+  auto count_buffer = allocator.CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(&count), sizeof(count));
+  std::vector<uint16_t> indices(vertex_count.value());
+  std::iota(indices.begin(), indices.end(), 0);
+  auto index_buffer = allocator.CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(indices.data()),
+      indices.size() * sizeof(uint16_t));
+  if (!vertices || !count_buffer || !index_buffer) {
+    return std::nullopt;
+  }
+  vertices->SetLabel("Compute Stroke Vertices");
+  index_buffer->SetLabel("Compute Stroke Indices");
+
+  // Tolerances are in the local space of the path.
+  ComputeTessellator tessellator;
+  tessellator.SetStrokeWidth(stroke_width);
+  if (scale > 0) {
+    tessellator.SetCubicAccuracy(kDefaultCurveTolerance / scale)
+        .SetQuadraticTolerance(0.1f / scale);
+  }
+  // Submitted ahead of the command buffer of the render pass, on the same
+  // queue. The draw waits for the compute pass to finish writing the
+  // vertices.
+  auto status = tessellator.Tessellate(path, context, vertices->AsBufferView(),
+                                       count_buffer->AsBufferView());
+  if (status != ComputeTessellator::Status::kOk) {
+    return std::nullopt;
+  }
+  return VertexBuffer{
+      .vertex_buffer = vertices->AsBufferView(),
+      .index_buffer = index_buffer->AsBufferView(),
+      .index_count = vertex_count.value(),
+      .index_type = IndexType::k16bit,
+  };
+}
+#endif  // IMPELLER_ENABLE_COMPUTE
+
 GeometryResult StrokePathGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
@@ -537,15 +677,49 @@ GeometryResult StrokePathGeometry::GetPositionBuffer(
   Scalar min_size = 1.0f / sqrt(std::abs(determinant));
   Scalar stroke_width = std::max(stroke_width_, min_size);
 
-  auto& host_buffer = pass.GetTransientsBuffer();
-  auto vertex_builder = CreateSolidStrokeVertices(
-      path_, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-      entity.GetTransformation().GetMaxBasisLength());
+  Scalar scaled_miter_limit = miter_limit_ * stroke_width_ * 0.5;
+  auto scale = entity.GetTransformation().GetMaxBasisLength();
+  auto& cache = *renderer.GetTessellationCache();
+  auto key = TessellationCache::MakeStrokeKey(
+      path_, scale, stroke_width, scaled_miter_limit, stroke_cap_,
+      stroke_join_);
+  std::optional<VertexBuffer> vertex_buffer;
+  if (key.has_value()) {
+    vertex_buffer = cache.Get(key.value());
+    scale = TessellationCache::GetBucketScale(key->scale_bucket);
+  }
+
+#if IMPELLER_ENABLE_COMPUTE
+  if (!vertex_buffer.has_value() && renderer.IsComputeTessellationEnabled() &&
+      CanStrokeWithCompute(path_, stroke_cap_, stroke_join_)) {
+    vertex_buffer =
+        CreateComputeStrokeVertices(renderer, path_, stroke_width, scale);
+    if (vertex_buffer.has_value() && key.has_value() &&
+        cache.ShouldAdmit(key.value())) {
+      cache.Put(key.value(), vertex_buffer.value());
+    }
+  }
+#endif  // IMPELLER_ENABLE_COMPUTE
+
+  if (!vertex_buffer.has_value()) {
+    auto vertex_builder = CreateSolidStrokeVertices(
+        path_, stroke_width, scaled_miter_limit, GetJoinProc(stroke_join_),
+        GetCapProc(stroke_cap_), scale);
+    if (key.has_value() && cache.ShouldAdmit(key.value())) {
+      vertex_builder.SetLabel("Cached Stroke");
+      vertex_buffer = vertex_builder.CreateVertexBuffer(
+          *renderer.GetContext()->GetResourceAllocator());
+      cache.Put(key.value(), vertex_buffer.value());
+    }
+    if (!vertex_buffer.has_value() || !vertex_buffer.value()) {
+      vertex_buffer =
+          vertex_builder.CreateVertexBuffer(pass.GetTransientsBuffer());
+    }
+  }
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
-      .vertex_buffer = vertex_builder.CreateVertexBuffer(host_buffer),
+      .vertex_buffer = vertex_buffer.value(),
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation(),
       .prevent_overdraw = true,
@@ -658,6 +832,21 @@ GeometryResult CoverGeometry::GetPositionBuffer(const ContentContext& renderer,
   };
 }
 
+// |Geometry|
+GeometryResult CoverGeometry::GetPositionBufferForMVP(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  auto size = pass.GetRenderTargetSize();
+  return GeometryResult{
+      .type = PrimitiveType::kTriangleStrip,
+      .vertex_buffer = renderer.GetUnitQuadVertexBuffer(),
+      .transform = Matrix::MakeOrthographic(size) *
+                   Matrix::MakeScale(Vector2(size.width, size.height)),
+      .prevent_overdraw = false,
+  };
+}
+
 // |Geometry|
 GeometryResult CoverGeometry::GetPositionUVBuffer(
     Rect texture_coverage,
@@ -678,6 +867,11 @@ std::optional<Rect> CoverGeometry::GetCoverage(const Matrix& transform) const {
   return Rect::MakeMaximum();
 }
 
+bool CoverGeometry::CoversArea(const Matrix& transform,
+                               const Rect& rect) const {
+  return true;
+}
+
 /////// Rect Geometry ///////
 
 RectGeometry::RectGeometry(Rect rect) : rect_(rect) {}
@@ -706,6 +900,23 @@ GeometryResult RectGeometry::GetPositionBuffer(const ContentContext& renderer,
   };
 }
 
+// |Geometry|
+GeometryResult RectGeometry::GetPositionBufferForMVP(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  return GeometryResult{
+      .type = PrimitiveType::kTriangleStrip,
+      .vertex_buffer = renderer.GetUnitQuadVertexBuffer(),
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation() *
+                   Matrix::MakeTranslation(rect_.origin) *
+                   Matrix::MakeScale(
+                       Vector2(rect_.size.width, rect_.size.height)),
+      .prevent_overdraw = false,
+  };
+}
+
 // |Geometry|
 GeometryResult RectGeometry::GetPositionUVBuffer(Rect texture_coverage,
                                                  Matrix effect_transform,
@@ -724,6 +935,25 @@ std::optional<Rect> RectGeometry::GetCoverage(const Matrix& transform) const {
   return rect_.TransformBounds(transform);
 }
 
+bool RectGeometry::AppendTriangles(const Matrix& transform,
+                                   std::vector<Point>& triangles) const {
+  if (!transform.IsAffine()) {
+    return false;
+  }
+  auto points = rect_.GetTransformedPoints(transform);
+  triangles.insert(triangles.end(), {points[0], points[1], points[2],  //
+                                     points[1], points[2], points[3]});
+  return true;
+}
+
+bool RectGeometry::CoversArea(const Matrix& transform, const Rect& rect) const {
+  if (!transform.IsTranslationScaleOnly()) {
+    return false;
+  }
+  auto coverage = GetCoverage(transform);
+  return coverage.has_value() && coverage->Contains(rect);
+}
+
 /////// RRect Geometry ///////
 
 RRectGeometry::RRectGeometry(Rect rect, Scalar corner_radius)
@@ -744,7 +974,7 @@ static void AppendRRectCorner(Path::Polyline polyline,
 }
 
 VertexBufferBuilder<Point> RRectGeometry::CreatePositionBuffer(
-    const Entity& entity) const {
+    Scalar scale) const {
   VertexBufferBuilder<Point> vtx_builder;
 
   // The rounded rectangle is split into parts:
@@ -763,25 +993,25 @@ VertexBufferBuilder<Point> RRectGeometry::CreatePositionBuffer(
           .MoveTo({rect_.origin.x, rect_.origin.y + corner_radius_})
           .AddRoundedRectTopLeft(rect_, radii)
           .TakePath()
-          .CreatePolyline(entity.GetTransformation().GetMaxBasisLength());
+          .CreatePolyline(scale);
   auto topRight =
       PathBuilder{}
           .MoveTo({right - radii.top_right.x, rect_.origin.y})
           .AddRoundedRectTopRight(rect_, radii)
           .TakePath()
-          .CreatePolyline(entity.GetTransformation().GetMaxBasisLength());
+          .CreatePolyline(scale);
   auto bottomLeft =
       PathBuilder{}
           .MoveTo({left + corner_radius_, bottom})
           .AddRoundedRectBottomLeft(rect_, radii)
           .TakePath()
-          .CreatePolyline(entity.GetTransformation().GetMaxBasisLength());
+          .CreatePolyline(scale);
   auto bottomRight =
       PathBuilder{}
           .MoveTo({right, bottom - corner_radius_})
           .AddRoundedRectBottomRight(rect_, radii)
           .TakePath()
-          .CreatePolyline(entity.GetTransformation().GetMaxBasisLength());
+          .CreatePolyline(scale);
 
   vtx_builder.Reserve(12 * (topLeft.points.size() - 1) + 18);
 
@@ -834,7 +1064,8 @@ VertexBufferBuilder<Point> RRectGeometry::CreatePositionBuffer(
 GeometryResult RRectGeometry::GetPositionBuffer(const ContentContext& renderer,
                                                 const Entity& entity,
                                                 RenderPass& pass) {
-  auto vtx_builder = CreatePositionBuffer(entity);
+  auto vtx_builder =
+      CreatePositionBuffer(entity.GetTransformation().GetMaxBasisLength());
 
   return GeometryResult{
       .type = PrimitiveType::kTriangle,
@@ -852,7 +1083,8 @@ GeometryResult RRectGeometry::GetPositionUVBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) {
-  auto vtx_builder = CreatePositionBuffer(entity);
+  auto vtx_builder =
+      CreatePositionBuffer(entity.GetTransformation().GetMaxBasisLength());
 
   VertexBufferBuilder<TextureFillVertexShader::PerVertexData> vertex_builder;
   vtx_builder.IterateVertices(
@@ -883,4 +1115,36 @@ std::optional<Rect> RRectGeometry::GetCoverage(const Matrix& transform) const {
   return rect_.TransformBounds(transform);
 }
 
+bool RRectGeometry::AppendTriangles(const Matrix& transform,
+                                    std::vector<Point>& triangles) const {
+  if (!transform.IsAffine()) {
+    return false;
+  }
+  auto vtx_builder = CreatePositionBuffer(transform.GetMaxBasisLength());
+  triangles.reserve(triangles.size() + vtx_builder.GetVertexCount());
+  vtx_builder.IterateVertices([&triangles, &transform](Point& point) {
+    triangles.push_back(transform * point);
+  });
+  return true;
+}
+
+bool RRectGeometry::CoversArea(const Matrix& transform,
+                               const Rect& rect) const {
+  if (!transform.IsTranslationScaleOnly()) {
+    return false;
+  }
+  // The rounded corners only cut into the bands along the edges, so the
+  // cross formed by the rectangle inset by the radius on either axis is
+  // fully covered.
+  auto radius = std::min(corner_radius_, std::min(rect_.size.width / 2,
+                                                  rect_.size.height / 2));
+  auto horizontal = Rect::MakeLTRB(rect_.GetLeft(), rect_.GetTop() + radius,
+                                   rect_.GetRight(), rect_.GetBottom() - radius)
+                        .TransformBounds(transform);
+  auto vertical = Rect::MakeLTRB(rect_.GetLeft() + radius, rect_.GetTop(),
+                                 rect_.GetRight() - radius, rect_.GetBottom())
+                      .TransformBounds(transform);
+  return horizontal.Contains(rect) || vertical.Contains(rect);
+}
+
 }  // namespace impeller
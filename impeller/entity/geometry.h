@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "impeller/core/allocator.h"
 #include "impeller/core/host_buffer.h"
 #include "impeller/core/vertex_buffer.h"
@@ -58,6 +60,17 @@ class Geometry {
                                            const Entity& entity,
                                            RenderPass& pass) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Like |GetPositionBuffer|, but the positions may be in any
+  ///             space that the returned transform maps to clip space. This
+  ///             is for contents whose shaders only read the positions
+  ///             through the transform, and lets rect-like geometries bind
+  ///             the shared unit quad instead of writing vertices.
+  ///
+  virtual GeometryResult GetPositionBufferForMVP(const ContentContext& renderer,
+                                                 const Entity& entity,
+                                                 RenderPass& pass);
+
   virtual GeometryResult GetPositionUVBuffer(Rect texture_coverage,
                                              Matrix effect_transform,
                                              const ContentContext& renderer,
@@ -67,6 +80,22 @@ class Geometry {
   virtual GeometryVertexType GetVertexType() const = 0;
 
   virtual std::optional<Rect> GetCoverage(const Matrix& transform) const = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends the triangles of this geometry, transformed by the
+  ///             given affine transform, to a triangle list. Geometries that
+  ///             are expensive to triangulate on the CPU, or that need more
+  ///             than a single draw, return false without appending anything.
+  ///
+  virtual bool AppendTriangles(const Matrix& transform,
+                               std::vector<Point>& triangles) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether this geometry, drawn with the given transform, covers
+  ///             every point of the given rectangle. It is always safe to
+  ///             return false.
+  ///
+  virtual bool CoversArea(const Matrix& transform, const Rect& rect) const;
 };
 
 /// @brief A geometry that is created from a vertices object.
@@ -211,12 +240,20 @@ class CoverGeometry : public Geometry {
                                    const Entity& entity,
                                    RenderPass& pass) override;
 
+  // |Geometry|
+  GeometryResult GetPositionBufferForMVP(const ContentContext& renderer,
+                                         const Entity& entity,
+                                         RenderPass& pass) override;
+
   // |Geometry|
   GeometryVertexType GetVertexType() const override;
 
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  bool CoversArea(const Matrix& transform, const Rect& rect) const override;
+
   // |Geometry|
   GeometryResult GetPositionUVBuffer(Rect texture_coverage,
                                      Matrix effect_transform,
@@ -239,12 +276,24 @@ class RectGeometry : public Geometry {
                                    const Entity& entity,
                                    RenderPass& pass) override;
 
+  // |Geometry|
+  GeometryResult GetPositionBufferForMVP(const ContentContext& renderer,
+                                         const Entity& entity,
+                                         RenderPass& pass) override;
+
   // |Geometry|
   GeometryVertexType GetVertexType() const override;
 
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  bool AppendTriangles(const Matrix& transform,
+                       std::vector<Point>& triangles) const override;
+
+  // |Geometry|
+  bool CoversArea(const Matrix& transform, const Rect& rect) const override;
+
   // |Geometry|
   GeometryResult GetPositionUVBuffer(Rect texture_coverage,
                                      Matrix effect_transform,
@@ -282,7 +331,14 @@ class RRectGeometry : public Geometry {
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
-  VertexBufferBuilder<Point> CreatePositionBuffer(const Entity& entity) const;
+  // |Geometry|
+  bool AppendTriangles(const Matrix& transform,
+                       std::vector<Point>& triangles) const override;
+
+  // |Geometry|
+  bool CoversArea(const Matrix& transform, const Rect& rect) const override;
+
+  VertexBufferBuilder<Point> CreatePositionBuffer(Scalar scale) const;
 
   Rect rect_;
   Scalar corner_radius_;
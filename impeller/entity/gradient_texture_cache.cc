@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/gradient_texture_cache.h"
+
+#include <string_view>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/entity/contents/gradient_generator.h"
+
+namespace impeller {
+
+std::size_t GradientTextureCache::Key::Hash::operator()(const Key& key) const {
+  const std::string_view bytes(
+      reinterpret_cast<const char*>(key.color_bytes.data()),
+      key.color_bytes.size());
+  return fml::HashCombine(std::hash<std::string_view>{}(bytes),
+                          key.texture_size);
+}
+
+bool GradientTextureCache::Key::Equal::operator()(const Key& lhs,
+                                                  const Key& rhs) const {
+  return lhs.texture_size == rhs.texture_size &&
+         lhs.color_bytes == rhs.color_bytes;
+}
+
+GradientTextureCache::GradientTextureCache(size_t max_entry_count)
+    : max_entry_count_(max_entry_count) {}
+
+GradientTextureCache::~GradientTextureCache() = default;
+
+std::shared_ptr<Texture> GradientTextureCache::GetTexture(
+    const GradientData& gradient_data,
+    const std::shared_ptr<Context>& context) {
+  Key key{gradient_data.color_bytes, gradient_data.texture_size};
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+      hit_count_++;
+      // Move the entry to the front of the list, which is most recently used.
+      entries_.splice(entries_.begin(), entries_, found->second);
+      TraceCounts();
+      return found->second->texture;
+    }
+    miss_count_++;
+  }
+
+  // Uploading the ramp doesn't need the lock.
+  auto texture = CreateGradientTexture(gradient_data, context);
+  if (!texture || max_entry_count_ == 0) {
+    return texture;
+  }
+
+  std::scoped_lock lock(mutex_);
+  // Another thread may have created the same ramp in the meantime.
+  if (auto found = index_.find(key); found != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return found->second->texture;
+  }
+  while (entries_.size() >= max_entry_count_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{key, texture});
+  index_.emplace(std::move(key), entries_.begin());
+  TraceCounts();
+  return texture;
+}
+
+void GradientTextureCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  entries_.clear();
+  index_.clear();
+}
+
+size_t GradientTextureCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t GradientTextureCache::GetHitCount() const {
+  std::scoped_lock lock(mutex_);
+  return hit_count_;
+}
+
+size_t GradientTextureCache::GetMissCount() const {
+  std::scoped_lock lock(mutex_);
+  return miss_count_;
+}
+
+void GradientTextureCache::TraceCounts() const {
+  FML_TRACE_COUNTER("impeller", "GradientTextureCache",
+                    reinterpret_cast<int64_t>(this),  //
+                    "Hits", hit_count_,               //
+                    "Misses", miss_count_,            //
+                    "Textures", entries_.size());
+}
+
+}  // namespace impeller
@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/texture.h"
+#include "impeller/geometry/gradient.h"
+
+namespace impeller {
+
+class Context;
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of the color ramp textures that
+///             gradients are sampled from on devices without SSBO support.
+///
+///             Entries are keyed by the contents of the ramp, so gradients
+///             with the same colors and stops share one texture regardless
+///             of their geometry. The tile mode is applied when the ramp is
+///             sampled and does not affect the texture. Ramp textures are
+///             never written after they are created, so an entry can be
+///             handed out any number of times in the same frame.
+///
+///             The cache is meant to be used by a single |ContentContext|,
+///             and may be used from the threads that subpasses are encoded
+///             on concurrently.
+///
+class GradientTextureCache {
+ public:
+  static constexpr size_t kDefaultMaxEntryCount = 64u;
+
+  explicit GradientTextureCache(size_t max_entry_count = kDefaultMaxEntryCount);
+
+  ~GradientTextureCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the ramp texture for the given gradient data,
+  ///             creating it with |CreateGradientTexture| if it isn't cached
+  ///             yet. The least recently used entry is evicted when the cache
+  ///             is full.
+  ///
+  std::shared_ptr<Texture> GetTexture(const GradientData& gradient_data,
+                                      const std::shared_ptr<Context>& context);
+
+  void Clear();
+
+  size_t GetEntryCount() const;
+
+  size_t GetHitCount() const;
+
+  size_t GetMissCount() const;
+
+ private:
+  struct Key {
+    std::vector<uint8_t> color_bytes;
+    uint32_t texture_size = 0;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const;
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const;
+    };
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<Texture> texture;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const size_t max_entry_count_;
+  mutable std::mutex mutex_;
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, Key::Hash, Key::Equal> index_;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+
+  void TraceCounts() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GradientTextureCache);
+};
+
+}  // namespace impeller
@@ -0,0 +1,197 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/image_atlas.h"
+
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/formats.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
+#include "third_party/skia/src/core/SkIPoint16.h"   // nogncheck
+#include "third_party/skia/src/gpu/GrRectanizer.h"  // nogncheck
+
+namespace impeller {
+
+// The images are surrounded by a border of this many texels.
+static constexpr int64_t kBorder = 1;
+
+ImageAtlas::ImageAtlas(std::shared_ptr<Context> context)
+    : context_(std::move(context)) {}
+
+ImageAtlas::~ImageAtlas() = default;
+
+// static
+bool ImageAtlas::CanPack(const Texture& texture) {
+  const auto& desc = texture.GetTextureDescriptor();
+  // Pages have the orientation of uploaded textures, and no mip levels. Draws
+  // that would sample other mip levels must not read packed images.
+  return texture.IsImmutable() &&
+         texture.GetIntent() == TextureIntent::kUploadFromHost &&
+         desc.type == TextureType::kTexture2D &&
+         desc.sample_count == SampleCount::kCount1 &&
+         !IsCompressedPixelFormat(desc.format) && !desc.size.IsEmpty() &&
+         desc.size.width <= kMaxImageSize && desc.size.height <= kMaxImageSize;
+}
+
+std::optional<ImageAtlas::Entry> ImageAtlas::Find(
+    const std::shared_ptr<Texture>& texture) {
+  if (!texture || !CanPack(*texture)) {
+    return std::nullopt;
+  }
+
+  std::scoped_lock lock(mutex_);
+  PruneExpiredRecords();
+
+  auto& record = records_[texture.get()];
+  if (record.texture.lock() != texture) {
+    // A new texture, or one that was allocated where an expired one was.
+    record = Record{.texture = texture};
+  }
+
+  if (auto page = record.page.lock()) {
+    return Entry{.page = page->texture, .origin = record.origin};
+  }
+
+  if (++record.draw_count < kDrawsBeforePacking) {
+    return std::nullopt;
+  }
+
+  auto page = Pack(texture, record.origin);
+  if (!page) {
+    // Try again once the texture has been drawn as often again.
+    record.draw_count = 0u;
+    return std::nullopt;
+  }
+  record.page = page;
+  return Entry{.page = page->texture, .origin = record.origin};
+}
+
+size_t ImageAtlas::GetPageCount() const {
+  std::scoped_lock lock(mutex_);
+  return pages_.size();
+}
+
+std::shared_ptr<ImageAtlas::Page> ImageAtlas::Pack(
+    const std::shared_ptr<Texture>& texture,
+    IPoint& origin) {
+  TRACE_EVENT0("impeller", "ImageAtlas::Pack");
+  auto format = texture->GetTextureDescriptor().format;
+  auto size = texture->GetSize();
+
+  auto try_pack = [&](const std::shared_ptr<Page>& page) {
+    SkIPoint16 location;
+    if (page->texture->GetTextureDescriptor().format != format ||
+        !page->rect_packer->addRect(size.width + kBorder * 2,
+                                    size.height + kBorder * 2, &location)) {
+      return false;
+    }
+    origin = IPoint(location.x() + kBorder, location.y() + kBorder);
+    return true;
+  };
+
+  std::shared_ptr<Page> page;
+  auto found = std::find_if(pages_.begin(), pages_.end(), try_pack);
+  if (found != pages_.end()) {
+    page = *found;
+  } else {
+    if (pages_.size() >= kMaxPageCount) {
+      // The images of the oldest page are unpacked once the records of the
+      // page expire with it.
+      pages_.pop_front();
+    }
+    page = CreatePage(format);
+    if (!page || !try_pack(page)) {
+      return nullptr;
+    }
+    pages_.push_back(page);
+  }
+
+  if (!Copy(texture, *page, origin)) {
+    return nullptr;
+  }
+  return page;
+}
+
+std::shared_ptr<ImageAtlas::Page> ImageAtlas::CreatePage(
+    PixelFormat format) const {
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = format;
+  desc.size = kPageSize;
+  auto texture = context_->GetResourceAllocator()->CreateTexture(desc);
+  if (!texture) {
+    return nullptr;
+  }
+  texture->SetLabel("Image Atlas Page");
+  texture->SetIntent(TextureIntent::kUploadFromHost);
+
+  auto page = std::make_shared<Page>();
+  page->texture = std::move(texture);
+  page->rect_packer = std::shared_ptr<GrRectanizer>(
+      GrRectanizer::Factory(kPageSize.width, kPageSize.height));
+  return page;
+}
+
+bool ImageAtlas::Copy(const std::shared_ptr<Texture>& texture,
+                      const Page& page,
+                      IPoint origin) const {
+  auto cmd_buffer = context_->CreateCommandBuffer();
+  if (!cmd_buffer) {
+    return false;
+  }
+  cmd_buffer->SetLabel("Image Atlas Command Buffer");
+  auto blit_pass = cmd_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return false;
+  }
+  blit_pass->SetLabel("Image Atlas Blit Pass");
+
+  // The image, followed by its edges and corners repeated into its border.
+  auto w = texture->GetSize().width;
+  auto h = texture->GetSize().height;
+  struct {
+    IRect source;
+    IPoint offset;
+  } copies[] = {
+      {IRect::MakeXYWH(0, 0, w, h), IPoint(0, 0)},
+      {IRect::MakeXYWH(0, 0, w, 1), IPoint(0, -1)},
+      {IRect::MakeXYWH(0, h - 1, w, 1), IPoint(0, h)},
+      {IRect::MakeXYWH(0, 0, 1, h), IPoint(-1, 0)},
+      {IRect::MakeXYWH(w - 1, 0, 1, h), IPoint(w, 0)},
+      {IRect::MakeXYWH(0, 0, 1, 1), IPoint(-1, -1)},
+      {IRect::MakeXYWH(w - 1, 0, 1, 1), IPoint(w, -1)},
+      {IRect::MakeXYWH(0, h - 1, 1, 1), IPoint(-1, h)},
+      {IRect::MakeXYWH(w - 1, h - 1, 1, 1), IPoint(w, h)},
+  };
+  for (const auto& copy : copies) {
+    if (!blit_pass->AddCopy(texture, page.texture, copy.source,
+                            origin + copy.offset, "Image Atlas Copy")) {
+      return false;
+    }
+  }
+
+  // Submitted ahead of the command buffer of the pass that draws the image,
+  // on the same queue.
+  return blit_pass->EncodeCommands(context_->GetResourceAllocator()) &&
+         cmd_buffer->SubmitCommands();
+}
+
+void ImageAtlas::PruneExpiredRecords() {
+  if (records_.size() < prune_threshold_) {
+    return;
+  }
+  for (auto it = records_.begin(); it != records_.end();) {
+    if (it->second.texture.expired()) {
+      it = records_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  prune_threshold_ = std::max<size_t>(64u, records_.size() * 2);
+}
+
+}  // namespace impeller
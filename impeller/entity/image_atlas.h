@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/texture.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/renderer/context.h"
+
+namespace skgpu {
+class Rectanizer;
+}
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Packs small immutable images that are drawn often into shared
+///             atlas pages, so that draws of different images can bind the
+///             same texture and be batched into a single draw.
+///
+///             An image is only packed the |kDrawsBeforePacking|th time it is
+///             looked up, so that images drawn once don't take up space. It is
+///             copied into its page with a blit that is submitted right away,
+///             ahead of the command buffer of the pass that draws it. Each
+///             image is surrounded by a one texel border that repeats its
+///             edges, so that bilinear sampling at its edges clamps like it
+///             does in its own texture.
+///
+///             Pages are never written where images were already packed. When
+///             every page is full, the oldest one is dropped along with its
+///             images, which are packed again into a new page if they keep
+///             being drawn.
+///
+///             The atlas is meant to be used by a single |ContentContext|,
+///             and may be used from the threads that subpasses are encoded
+///             on concurrently.
+///
+class ImageAtlas {
+ public:
+  static constexpr ISize kPageSize = ISize(1024, 1024);
+  static constexpr int64_t kMaxImageSize = 256;
+  static constexpr size_t kMaxPageCount = 4u;
+  static constexpr size_t kDrawsBeforePacking = 2u;
+
+  /// Where an image is packed.
+  struct Entry {
+    std::shared_ptr<Texture> page;
+    /// The origin of the image in the page, in texels.
+    IPoint origin;
+  };
+
+  explicit ImageAtlas(std::shared_ptr<Context> context);
+
+  ~ImageAtlas();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the texture is an immutable, single sampled 2D
+  ///             texture that is small enough to be packed.
+  ///
+  static bool CanPack(const Texture& texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records a draw of the texture and returns where it is
+  ///             packed, packing it if it has been drawn often enough.
+  ///
+  /// @return     std::nullopt if the texture isn't packed, in which case it
+  ///             should be drawn from its own texture.
+  ///
+  std::optional<Entry> Find(const std::shared_ptr<Texture>& texture);
+
+  size_t GetPageCount() const;
+
+ private:
+  struct Page {
+    std::shared_ptr<Texture> texture;
+    std::shared_ptr<skgpu::Rectanizer> rect_packer;
+  };
+
+  struct Record {
+    std::weak_ptr<Texture> texture;
+    size_t draw_count = 0u;
+    std::weak_ptr<Page> page;
+    IPoint origin;
+  };
+
+  const std::shared_ptr<Context> context_;
+  mutable std::mutex mutex_;
+  std::deque<std::shared_ptr<Page>> pages_;
+  std::unordered_map<const Texture*, Record> records_;
+  size_t prune_threshold_ = 64u;
+
+  std::shared_ptr<Page> Pack(const std::shared_ptr<Texture>& texture,
+                             IPoint& origin);
+
+  std::shared_ptr<Page> CreatePage(PixelFormat format) const;
+
+  bool Copy(const std::shared_ptr<Texture>& texture,
+            const Page& page,
+            IPoint origin) const;
+
+  void PruneExpiredRecords();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageAtlas);
+};
+
+}  // namespace impeller
@@ -26,6 +26,12 @@ InlinePassContext::InlinePassContext(
   if (collapsed_parent_pass.has_value()) {
     pass_ = collapsed_parent_pass.value().pass;
   }
+  const auto& color_attachments =
+      pass_target_.GetRenderTarget().GetColorAttachments();
+  if (auto color0 = color_attachments.find(0);
+      color0 != color_attachments.end()) {
+    load_initial_contents_ = color0->second.load_action == LoadAction::kLoad;
+  }
 }
 
 InlinePassContext::~InlinePassContext() {
@@ -115,9 +121,26 @@ InlinePassContext::RenderPassResult InlinePassContext::GetRenderPass(
   auto color0 =
       pass_target_.GetRenderTarget().GetColorAttachments().find(0)->second;
 
-  color0.load_action =
-      pass_count_ > 0 ? LoadAction::kDontCare : LoadAction::kClear;
+  // The load and store actions are inferred from where the contents of the
+  // pass come from and who reads them, instead of loading and storing
+  // everything. That saves tile memory bandwidth on tiling GPUs.
+  if (pass_count_ == 0) {
+    // Only the contents that are explicitly kept are loaded, everything else
+    // starts from the clear color.
+    color0.load_action =
+        load_initial_contents_ ? LoadAction::kLoad : LoadAction::kClear;
+  } else if (color0.resolve_texture) {
+    // The multisample texture was flipped, and the previous contents are
+    // restored by drawing the backdrop texture that was resolved into.
+    color0.load_action = LoadAction::kDontCare;
+  } else {
+    // Single sample targets aren't flipped, the previous pass stored to the
+    // very texture that is attached again.
+    color0.load_action = LoadAction::kLoad;
+  }
 
+  // Multisample textures are only ever read through their resolve texture,
+  // so their samples are never stored.
   color0.store_action = color0.resolve_texture
                             ? StoreAction::kMultisampleResolve
                             : StoreAction::kStore;
@@ -41,6 +41,9 @@ class InlinePassContext {
   std::shared_ptr<RenderPass> pass_;
   uint32_t pass_count_ = 0;
   uint32_t total_pass_reads_ = 0;
+  // Whether the first pass has to keep the contents that the render target
+  // already had, such as the undamaged area of the root render target.
+  bool load_initial_contents_ = false;
   // Whether this context is collapsed into a parent entity pass.
   bool is_collapsed_ = false;
 
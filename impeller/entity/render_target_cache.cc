@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                                     size_t memory_budget)
+    : RenderTargetAllocator(std::move(allocator)),
+      memory_budget_(memory_budget) {}
+
+RenderTargetCache::~RenderTargetCache() = default;
+
+void RenderTargetCache::Start() {
+  std::scoped_lock lock(mutex_);
+  for (auto& entry : entries_) {
+    entry.used_this_frame = false;
+  }
+}
+
+void RenderTargetCache::End() {
+  TRACE_EVENT0("impeller", "RenderTargetCache::End");
+  std::scoped_lock lock(mutex_);
+  // Release the textures that were not needed this frame, and then the most
+  // recently created ones until the pool fits in the budget again.
+  auto unused = std::stable_partition(
+      entries_.begin(), entries_.end(),
+      [](const TextureEntry& entry) { return entry.used_this_frame; });
+  entries_.erase(unused, entries_.end());
+  memory_usage_ = 0;
+  for (const auto& entry : entries_) {
+    memory_usage_ += entry.size;
+  }
+  // Give back half of the pool every frame while the device is running out
+  // of memory.
+  auto memory_budget = memory_budget_;
+  if (IsUnderMemoryPressure()) {
+    memory_budget = std::min(memory_budget, memory_usage_ / 2);
+  }
+  while (!entries_.empty() && memory_usage_ > memory_budget) {
+    memory_usage_ -= entries_.back().size;
+    entries_.pop_back();
+  }
+  TraceCounts();
+}
+
+std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
+    const TextureDescriptor& desc) {
+  std::scoped_lock lock(mutex_);
+  for (auto& entry : entries_) {
+    // A texture that is still referenced outside the pool, for instance by a
+    // snapshot that outlived its frame, must not be drawn into.
+    if (!entry.used_this_frame && entry.texture.use_count() == 1 &&
+        IsCompatible(entry.desc, desc)) {
+      entry.used_this_frame = true;
+      hit_count_++;
+      return entry.texture;
+    }
+  }
+  miss_count_++;
+  auto texture = RenderTargetAllocator::CreateTexture(desc);
+  if (!texture) {
+    return nullptr;
+  }
+  const auto size = GetTextureSize(desc);
+  if (memory_usage_ + size <= memory_budget_) {
+    entries_.push_back(TextureEntry{
+        .desc = desc,
+        .texture = texture,
+        .size = size,
+        .used_this_frame = true,
+    });
+    memory_usage_ += size;
+  }
+  return texture;
+}
+
+void RenderTargetCache::SetMemoryBudget(size_t memory_budget) {
+  std::scoped_lock lock(mutex_);
+  memory_budget_ = memory_budget;
+}
+
+void RenderTargetCache::Trim(size_t max_bytes) {
+  std::scoped_lock lock(mutex_);
+  while (!entries_.empty() && memory_usage_ > max_bytes) {
+    memory_usage_ -= entries_.back().size;
+    entries_.pop_back();
+  }
+  TraceCounts();
+}
+
+size_t RenderTargetCache::GetMemoryBudget() const {
+  std::scoped_lock lock(mutex_);
+  return memory_budget_;
+}
+
+size_t RenderTargetCache::GetCachedTextureCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t RenderTargetCache::GetMemoryUsage() const {
+  std::scoped_lock lock(mutex_);
+  return memory_usage_;
+}
+
+size_t RenderTargetCache::GetHitCount() const {
+  std::scoped_lock lock(mutex_);
+  return hit_count_;
+}
+
+size_t RenderTargetCache::GetMissCount() const {
+  std::scoped_lock lock(mutex_);
+  return miss_count_;
+}
+
+// static
+size_t RenderTargetCache::GetTextureSize(const TextureDescriptor& desc) {
+  return desc.GetByteSizeOfBaseMipLevel() *
+         static_cast<size_t>(desc.sample_count);
+}
+
+// static
+bool RenderTargetCache::IsCompatible(const TextureDescriptor& a,
+                                     const TextureDescriptor& b) {
+  return a.storage_mode == b.storage_mode &&  //
+         a.type == b.type &&                  //
+         a.format == b.format &&              //
+         a.size == b.size &&                  //
+         a.mip_count == b.mip_count &&        //
+         a.usage == b.usage &&                //
+         a.sample_count == b.sample_count &&  //
+         a.compression_type == b.compression_type;
+}
+
+bool RenderTargetCache::IsUnderMemoryPressure() const {
+  auto budget = GetAllocator()->GetDeviceMemoryBudget();
+  return budget.has_value() && budget->budget > 0 &&
+         budget->usage >= budget->budget * kMemoryPressureRatio;
+}
+
+void RenderTargetCache::TraceCounts() const {
+  FML_TRACE_COUNTER("impeller", "RenderTargetCache",
+                    reinterpret_cast<int64_t>(this),  //
+                    "Textures", entries_.size(),      //
+                    "Bytes", memory_usage_);
+}
+
+}  // namespace impeller
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/texture.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A render target allocator that recycles the attachments of
+///             offscreen render targets from one frame to the next.
+///
+///             Textures are pooled by their descriptor, so a texture is only
+///             reused for attachments of exactly the same size, format,
+///             sample count and storage mode. A pooled texture is handed out
+///             at most once per frame, and textures that were not used
+///             during a frame are released at its end. Textures that would
+///             take the pool past its memory budget are handed out without
+///             being retained. While the allocator reports that the device
+///             is close to its memory budget, the pool shrinks by half at the
+///             end of every frame.
+///
+///             Reusing a texture in the next frame is safe because the
+///             command buffers of the previous frame keep the textures they
+///             reference alive until the GPU is done with them, and are
+///             executed in submission order.
+///
+///             Textures may be created from the threads that subpasses are
+///             encoded on concurrently.
+///
+class RenderTargetCache : public RenderTargetAllocator {
+ public:
+  static constexpr size_t kDefaultMemoryBudget = 64u * 1024u * 1024u;
+
+  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                             size_t memory_budget = kDefaultMemoryBudget);
+
+  ~RenderTargetCache() override;
+
+  // |RenderTargetAllocator|
+  std::shared_ptr<Texture> CreateTexture(
+      const TextureDescriptor& desc) override;
+
+  // |RenderTargetAllocator|
+  void Start() override;
+
+  // |RenderTargetAllocator|
+  void End() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the number of bytes the pooled textures may take up.
+  ///             Takes effect at the end of the current frame.
+  ///
+  void SetMemoryBudget(size_t memory_budget);
+
+  size_t GetMemoryBudget() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the most recently created textures of the pool until
+  ///             it takes up at most |max_bytes|. Textures that are still in
+  ///             use stay alive until they are no longer referenced.
+  ///
+  void Trim(size_t max_bytes);
+
+  size_t GetCachedTextureCount() const;
+
+  size_t GetMemoryUsage() const;
+
+  size_t GetHitCount() const;
+
+  size_t GetMissCount() const;
+
+ private:
+  struct TextureEntry {
+    TextureDescriptor desc;
+    std::shared_ptr<Texture> texture;
+    size_t size = 0;
+    bool used_this_frame = false;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<TextureEntry> entries_;
+  size_t memory_budget_;
+  size_t memory_usage_ = 0;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+
+  // The fraction of the device memory budget past which the pool shrinks.
+  static constexpr double kMemoryPressureRatio = 0.9;
+
+  static size_t GetTextureSize(const TextureDescriptor& desc);
+
+  static bool IsCompatible(const TextureDescriptor& a,
+                           const TextureDescriptor& b);
+
+  bool IsUnderMemoryPressure() const;
+
+  void TraceCounts() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetCache);
+};
+
+}  // namespace impeller
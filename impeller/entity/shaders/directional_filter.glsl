@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tiling for directional filters that run as compute kernels.
+//
+// Each thread group filters a run of kTileSize pixels along one row (or
+// column) of the output. The group first caches every input texel that any of
+// its pixels is filtered from in shared memory, so that each texel is sampled
+// once per group rather than once per kernel tap.
+//
+// Kernels declare a `filter_info` uniform block that starts with the members
+// below before including this file:
+//
+//   vec2 input_size;     // The size of the input texture, in texels.
+//   uint output_width;   // The size of the output, in pixels.
+//   uint output_height;
+//   uint along_x;        // 1 to filter along the X axis of the input, 0 for Y.
+//   uint offset;         // How far the output extends past either end of the
+//                        // input along the filter axis, in texels.
+//   uint radius;         // The number of taps on either side of a pixel.
+
+// These values must correspond to `kComputeFilterTileSize` and
+// `kMaxComputeFilterRadius` in 'directional_compute_filter.h'.
+#define TILE_SIZE 256
+#define MAX_RADIUS 128
+
+layout(local_size_x = TILE_SIZE, local_size_y = 1) in;
+layout(std430) buffer;
+
+uniform sampler2D texture_sampler;
+
+// Unorm RGBA8 pixels, in rows of `output_width`.
+layout(binding = 0) writeonly buffer Pixels {
+  uint data[];
+}
+pixels;
+
+shared vec4 tile[TILE_SIZE + 2 * MAX_RADIUS];
+
+ivec2 ToCoords(int along, int across) {
+  return filter_info.along_x != 0u ? ivec2(along, across)
+                                   : ivec2(across, along);
+}
+
+/// Caches the input texels that the pixels of this thread group are filtered
+/// from. Must be called by every invocation of the group.
+void LoadTile() {
+  int tile_start = int(gl_WorkGroupID.x) * TILE_SIZE -
+                   int(filter_info.offset) - int(filter_info.radius);
+  int across = int(gl_WorkGroupID.y);
+  uint tile_length = TILE_SIZE + 2u * filter_info.radius;
+  // Texels past the edges of the input are resolved by the address mode of
+  // the sampler, like they are for the fragment shader filters.
+  for (uint i = gl_LocalInvocationID.x; i < tile_length; i += TILE_SIZE) {
+    vec2 coords = vec2(ToCoords(tile_start + int(i), across)) + 0.5;
+    tile[i] = textureLod(texture_sampler, coords / filter_info.input_size, 0.0);
+  }
+  barrier();
+}
+
+/// Returns the cached input texel `tap` texels away from the one under the
+/// pixel of this invocation.
+vec4 TileTexel(int tap) {
+  return tile[int(gl_LocalInvocationID.x) + int(filter_info.radius) + tap];
+}
+
+/// Writes the pixel of this invocation, unless it's past the end of the
+/// output.
+void StorePixel(vec4 color) {
+  ivec2 coords =
+      ToCoords(int(gl_GlobalInvocationID.x), int(gl_GlobalInvocationID.y));
+  if (coords.x < int(filter_info.output_width) &&
+      coords.y < int(filter_info.output_height)) {
+    pixels.data[coords.y * int(filter_info.output_width) + coords.x] =
+        packUnorm4x8(color);
+  }
+}
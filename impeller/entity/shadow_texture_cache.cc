@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/shadow_texture_cache.h"
+
+#include <cmath>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/core/texture.h"
+#include "impeller/entity/tessellation_cache.h"
+
+namespace impeller {
+
+std::size_t ShadowTextureCache::Key::Hash::operator()(const Key& key) const {
+  return fml::HashCombine(key.identity, key.generation, key.scale_bucket,
+                          key.fill_type, key.sigma, key.color);
+}
+
+bool ShadowTextureCache::Key::Equal::operator()(const Key& lhs,
+                                                const Key& rhs) const {
+  return lhs.identity == rhs.identity &&          //
+         lhs.generation == rhs.generation &&      //
+         lhs.scale_bucket == rhs.scale_bucket &&  //
+         lhs.fill_type == rhs.fill_type &&        //
+         lhs.sigma == rhs.sigma &&                //
+         lhs.color == rhs.color;
+}
+
+// static
+std::optional<ShadowTextureCache::Key> ShadowTextureCache::MakeKey(
+    const Path& path,
+    Scalar scale,
+    Sigma sigma,
+    Color color) {
+  if (path.GetIdentity() == 0 || !(scale > 0) || !std::isfinite(scale) ||
+      !std::isfinite(sigma.sigma)) {
+    return std::nullopt;
+  }
+  Key key;
+  key.identity = path.GetIdentity();
+  key.generation = path.GetGeneration();
+  key.scale_bucket = TessellationCache::GetScaleBucket(scale);
+  key.fill_type = path.GetFillType();
+  key.sigma = sigma.sigma;
+  key.color = Color::ToIColor(color);
+  return key;
+}
+
+ShadowTextureCache::ShadowTextureCache(size_t memory_budget)
+    : memory_budget_(memory_budget) {}
+
+ShadowTextureCache::~ShadowTextureCache() = default;
+
+std::optional<Snapshot> ShadowTextureCache::Get(const Key& key) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    miss_count_++;
+    TraceCounts();
+    return std::nullopt;
+  }
+  hit_count_++;
+  // Move the entry to the front of the list, which is most recently used.
+  entries_.splice(entries_.begin(), entries_, found->second);
+  TraceCounts();
+  return found->second->snapshot;
+}
+
+bool ShadowTextureCache::ShouldAdmit(const Key& key) {
+  std::scoped_lock lock(mutex_);
+  if (pending_keys_.erase(key) > 0) {
+    return true;
+  }
+  if (pending_keys_.size() >= kMaxPendingKeys) {
+    pending_keys_.clear();
+  }
+  pending_keys_.insert(key);
+  return false;
+}
+
+void ShadowTextureCache::Put(const Key& key, Snapshot snapshot) {
+  if (!snapshot.texture) {
+    return;
+  }
+  const auto size =
+      snapshot.texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  if (size > memory_budget_) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    memory_usage_ -= found->second->size;
+    entries_.erase(found->second);
+    index_.erase(found);
+  }
+  EvictToFit(size);
+  entries_.push_front(Entry{key, std::move(snapshot), size});
+  index_[key] = entries_.begin();
+  memory_usage_ += size;
+  TraceCounts();
+}
+
+void ShadowTextureCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  pending_keys_.clear();
+  memory_usage_ = 0;
+}
+
+size_t ShadowTextureCache::GetMemoryUsage() const {
+  std::scoped_lock lock(mutex_);
+  return memory_usage_;
+}
+
+size_t ShadowTextureCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t ShadowTextureCache::GetHitCount() const {
+  std::scoped_lock lock(mutex_);
+  return hit_count_;
+}
+
+size_t ShadowTextureCache::GetMissCount() const {
+  std::scoped_lock lock(mutex_);
+  return miss_count_;
+}
+
+size_t ShadowTextureCache::GetEvictionCount() const {
+  std::scoped_lock lock(mutex_);
+  return eviction_count_;
+}
+
+void ShadowTextureCache::EvictToFit(size_t size) {
+  while (!entries_.empty() && memory_usage_ + size > memory_budget_) {
+    const auto& entry = entries_.back();
+    memory_usage_ -= entry.size;
+    index_.erase(entry.key);
+    entries_.pop_back();
+    eviction_count_++;
+  }
+}
+
+void ShadowTextureCache::TraceCounts() const {
+  FML_TRACE_COUNTER("impeller", "ShadowTextureCache",
+                    reinterpret_cast<int64_t>(this),  //
+                    "Hits", hit_count_,               //
+                    "Misses", miss_count_,            //
+                    "Evictions", eviction_count_,     //
+                    "Bytes", memory_usage_);
+}
+
+}  // namespace impeller
@@ -0,0 +1,144 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/path.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/geometry/sigma.h"
+#include "impeller/renderer/snapshot.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of the blurred masks of paths,
+///             such as the elevation shadows of physical shapes, that are
+///             reused across frames.
+///
+///             Entries are keyed by the identity and generation of a path
+///             (see |Path::SetIdentity|), the sigma and color of the blur,
+///             and the scale the mask was rendered at. Masks are rendered in
+///             the local space of the path scaled by the bucket of the
+///             transform scale (see |TessellationCache::GetScaleBucket|), so
+///             a shadow that is translated or slightly scaled every frame
+///             still hits.
+///
+///             Like the |TessellationCache|, a key is only admitted the
+///             second time it is seen so that animated shadows don't render
+///             masks that are never reused. The textures of the cached
+///             snapshots are never written after they are rendered, and are
+///             not recycled by the |RenderTargetCache| while they are
+///             referenced here.
+///
+///             The cache is meant to be used by a single |ContentContext|,
+///             and may be used from the threads that subpasses are encoded
+///             on concurrently.
+///
+class ShadowTextureCache {
+ public:
+  static constexpr size_t kDefaultMemoryBudget = 16u * 1024u * 1024u;
+
+  struct Key {
+    uint64_t identity = 0;
+    uint32_t generation = 0;
+    int32_t scale_bucket = 0;
+    FillType fill_type = FillType::kNonZero;
+    Scalar sigma = 0;
+    uint32_t color = 0;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const;
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const;
+    };
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the key for blurring the given path at the given
+  ///             transform scale, or std::nullopt if the mask can't be
+  ///             cached.
+  ///
+  static std::optional<Key> MakeKey(const Path& path,
+                                    Scalar scale,
+                                    Sigma sigma,
+                                    Color color);
+
+  explicit ShadowTextureCache(size_t memory_budget = kDefaultMemoryBudget);
+
+  ~ShadowTextureCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Looks up the mask for the given key and marks it as most
+  ///             recently used. The transform of the snapshot maps the
+  ///             texture into the local space of the path scaled by the
+  ///             scale of the bucket of the key.
+  ///
+  std::optional<Snapshot> Get(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a mask for the given key should be stored with |Put|
+  ///             after it has been rendered. Returns false the first time a
+  ///             key is seen.
+  ///
+  bool ShouldAdmit(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stores a mask, evicting least recently used entries to stay
+  ///             within the memory budget. Masks larger than the budget are
+  ///             not stored.
+  ///
+  void Put(const Key& key, Snapshot snapshot);
+
+  void Clear();
+
+  size_t GetMemoryUsage() const;
+
+  size_t GetEntryCount() const;
+
+  size_t GetHitCount() const;
+
+  size_t GetMissCount() const;
+
+  size_t GetEvictionCount() const;
+
+ private:
+  // Bounds the number of keys that were seen only once.
+  static constexpr size_t kMaxPendingKeys = 256u;
+
+  struct Entry {
+    Key key;
+    Snapshot snapshot;
+    size_t size = 0;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const size_t memory_budget_;
+  mutable std::mutex mutex_;
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, Key::Hash, Key::Equal> index_;
+  std::unordered_set<Key, Key::Hash, Key::Equal> pending_keys_;
+  size_t memory_usage_ = 0;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+  size_t eviction_count_ = 0;
+
+  void EvictToFit(size_t size);
+
+  void TraceCounts() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShadowTextureCache);
+};
+
+}  // namespace impeller
@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include <cmath>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/geometry.h"
+#include "impeller/entity/mtl/entity_shaders.h"
+#include "impeller/entity/mtl/modern_shaders.h"
+#include "impeller/geometry/path_builder.h"
+#include "impeller/renderer/backend/metal/context_mtl.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/mtl/compute_shaders.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+namespace {
+
+std::shared_ptr<ContextMTL> CreateContext() {
+  return ContextMTL::Create(
+      {
+          std::make_shared<fml::NonOwnedMapping>(
+              impeller_entity_shaders_data, impeller_entity_shaders_length),
+          std::make_shared<fml::NonOwnedMapping>(
+              impeller_modern_shaders_data, impeller_modern_shaders_length),
+          std::make_shared<fml::NonOwnedMapping>(
+              impeller_compute_shaders_data, impeller_compute_shaders_length),
+      },
+      "Stroke Benchmarks Library");
+}
+
+// The series of a line chart, each a single open polyline.
+std::vector<Path> CreateChartSeries(size_t series_count, size_t point_count) {
+  std::vector<Path> series;
+  series.reserve(series_count);
+  for (size_t i = 0; i < series_count; i++) {
+    PathBuilder builder;
+    builder.MoveTo({0, 500});
+    for (size_t j = 1; j < point_count; j++) {
+      builder.LineTo({j * 2.0f, 500 + std::sin((i + j) * 0.1f) * 400});
+    }
+    series.push_back(builder.TakePath());
+  }
+  return series;
+}
+
+}  // namespace
+
+static void BM_StrokeChartSeries(benchmark::State& state, bool use_compute) {
+  auto context = CreateContext();
+  if (!context || !context->IsValid()) {
+    state.SkipWithError("Could not create a Metal context.");
+    return;
+  }
+  ContentContext renderer(context, nullptr);
+  if (!renderer.IsValid()) {
+    state.SkipWithError("Could not create the content context.");
+    return;
+  }
+  renderer.SetComputeTessellationEnabled(use_compute);
+  if (use_compute && !renderer.IsComputeTessellationEnabled()) {
+    state.SkipWithError("Compute tessellation is not supported.");
+    return;
+  }
+
+  const auto series = CreateChartSeries(state.range(0), 256);
+  auto render_target =
+      RenderTarget::CreateOffscreen(*context, ISize{1024, 1024});
+  Entity entity;
+
+  for (auto _ : state) {
+    auto cmd_buffer = context->CreateCommandBuffer();
+    auto pass = cmd_buffer->CreateRenderPass(render_target);
+    for (const auto& path : series) {
+      auto geometry = Geometry::MakeStrokePath(path, 1.5, 4.0, Cap::kButt,
+                                               Join::kBevel);
+      auto result = geometry->GetPositionBuffer(renderer, entity, *pass);
+      benchmark::DoNotOptimize(result);
+    }
+    if (!pass->EncodeCommands()) {
+      state.SkipWithError("Could not encode the render pass.");
+      break;
+    }
+    // Compute passes are submitted to the same queue ahead of this command
+    // buffer, so its completion includes the GPU tessellation.
+    fml::AutoResetWaitableEvent latch;
+    if (!cmd_buffer->SubmitCommands(
+            [&latch](CommandBuffer::Status) { latch.Signal(); })) {
+      state.SkipWithError("Could not submit the command buffer.");
+      break;
+    }
+    latch.Wait();
+  }
+  state.SetItemsProcessed(state.iterations() * series.size());
+}
+
+BENCHMARK_CAPTURE(BM_StrokeChartSeries, cpu, false)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_StrokeChartSeries, compute, true)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace impeller
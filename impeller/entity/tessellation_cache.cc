@@ -0,0 +1,219 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/tessellation_cache.h"
+
+#include <cmath>
+#include <limits>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+namespace {
+
+constexpr Scalar kScaleBucketsPerOctave = 4.0f;
+
+// Curves are flattened into lines when the scale is zero.
+constexpr int32_t kZeroScaleBucket = std::numeric_limits<int32_t>::min();
+
+}  // namespace
+
+std::size_t TessellationCache::Key::Hash::operator()(const Key& key) const {
+  return fml::HashCombine(key.identity, key.generation, key.scale_bucket,
+                          key.fill_type, key.is_stroke, key.stroke_width,
+                          key.miter_limit, key.stroke_cap, key.stroke_join,
+                          key.is_vertices, key.has_vertex_colors);
+}
+
+bool TessellationCache::Key::Equal::operator()(const Key& lhs,
+                                               const Key& rhs) const {
+  return lhs.identity == rhs.identity &&          //
+         lhs.generation == rhs.generation &&      //
+         lhs.scale_bucket == rhs.scale_bucket &&  //
+         lhs.fill_type == rhs.fill_type &&        //
+         lhs.is_stroke == rhs.is_stroke &&        //
+         lhs.stroke_width == rhs.stroke_width &&  //
+         lhs.miter_limit == rhs.miter_limit &&    //
+         lhs.stroke_cap == rhs.stroke_cap &&      //
+         lhs.stroke_join == rhs.stroke_join &&    //
+         lhs.is_vertices == rhs.is_vertices &&    //
+         lhs.has_vertex_colors == rhs.has_vertex_colors;
+}
+
+// static
+int32_t TessellationCache::GetScaleBucket(Scalar scale) {
+  if (!(scale > 0) || !std::isfinite(scale)) {
+    return kZeroScaleBucket;
+  }
+  return static_cast<int32_t>(
+      std::ceil(std::log2(scale) * kScaleBucketsPerOctave));
+}
+
+// static
+Scalar TessellationCache::GetBucketScale(int32_t bucket) {
+  if (bucket == kZeroScaleBucket) {
+    return 0;
+  }
+  return std::exp2(bucket / kScaleBucketsPerOctave);
+}
+
+// static
+std::optional<TessellationCache::Key> TessellationCache::MakeFillKey(
+    const Path& path,
+    Scalar scale) {
+  if (path.GetIdentity() == 0) {
+    return std::nullopt;
+  }
+  Key key;
+  key.identity = path.GetIdentity();
+  key.generation = path.GetGeneration();
+  key.scale_bucket = GetScaleBucket(scale);
+  key.fill_type = path.GetFillType();
+  return key;
+}
+
+// static
+std::optional<TessellationCache::Key> TessellationCache::MakeStrokeKey(
+    const Path& path,
+    Scalar scale,
+    Scalar stroke_width,
+    Scalar miter_limit,
+    Cap stroke_cap,
+    Join stroke_join) {
+  if (path.GetIdentity() == 0) {
+    return std::nullopt;
+  }
+  Key key;
+  key.identity = path.GetIdentity();
+  key.generation = path.GetGeneration();
+  key.scale_bucket = GetScaleBucket(scale);
+  key.is_stroke = true;
+  key.stroke_width = stroke_width;
+  key.miter_limit = miter_limit;
+  key.stroke_cap = stroke_cap;
+  key.stroke_join = stroke_join;
+  return key;
+}
+
+// static
+TessellationCache::Key TessellationCache::MakeVerticesKey(
+    uint64_t content_hash,
+    bool has_vertex_colors) {
+  Key key;
+  key.identity = content_hash;
+  key.is_vertices = true;
+  key.has_vertex_colors = has_vertex_colors;
+  return key;
+}
+
+TessellationCache::TessellationCache(size_t memory_budget)
+    : memory_budget_(memory_budget) {}
+
+TessellationCache::~TessellationCache() = default;
+
+std::optional<VertexBuffer> TessellationCache::Get(const Key& key) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    miss_count_++;
+    TraceCounts();
+    return std::nullopt;
+  }
+  hit_count_++;
+  // Move the entry to the front of the list, which is most recently used.
+  entries_.splice(entries_.begin(), entries_, found->second);
+  TraceCounts();
+  return found->second->vertex_buffer;
+}
+
+bool TessellationCache::ShouldAdmit(const Key& key) {
+  std::scoped_lock lock(mutex_);
+  if (pending_keys_.erase(key) > 0) {
+    return true;
+  }
+  if (pending_keys_.size() >= kMaxPendingKeys) {
+    pending_keys_.clear();
+  }
+  pending_keys_.insert(key);
+  return false;
+}
+
+void TessellationCache::Put(const Key& key, VertexBuffer vertex_buffer) {
+  if (!vertex_buffer) {
+    return;
+  }
+  const auto size = vertex_buffer.vertex_buffer.range.length +
+                    vertex_buffer.index_buffer.range.length;
+  if (size > memory_budget_) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    memory_usage_ -= found->second->size;
+    entries_.erase(found->second);
+    index_.erase(found);
+  }
+  EvictToFit(size);
+  entries_.push_front(Entry{key, std::move(vertex_buffer), size});
+  index_[key] = entries_.begin();
+  memory_usage_ += size;
+  TraceCounts();
+}
+
+void TessellationCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  pending_keys_.clear();
+  memory_usage_ = 0;
+}
+
+size_t TessellationCache::GetMemoryUsage() const {
+  std::scoped_lock lock(mutex_);
+  return memory_usage_;
+}
+
+size_t TessellationCache::GetEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t TessellationCache::GetHitCount() const {
+  std::scoped_lock lock(mutex_);
+  return hit_count_;
+}
+
+size_t TessellationCache::GetMissCount() const {
+  std::scoped_lock lock(mutex_);
+  return miss_count_;
+}
+
+size_t TessellationCache::GetEvictionCount() const {
+  std::scoped_lock lock(mutex_);
+  return eviction_count_;
+}
+
+void TessellationCache::EvictToFit(size_t size) {
+  while (!entries_.empty() && memory_usage_ + size > memory_budget_) {
+    const auto& entry = entries_.back();
+    memory_usage_ -= entry.size;
+    index_.erase(entry.key);
+    entries_.pop_back();
+    eviction_count_++;
+  }
+}
+
+void TessellationCache::TraceCounts() const {
+  FML_TRACE_COUNTER("impeller", "TessellationCache",
+                    reinterpret_cast<int64_t>(this),  //
+                    "Hits", hit_count_,               //
+                    "Misses", miss_count_,            //
+                    "Evictions", eviction_count_,     //
+                    "Bytes", memory_usage_);
+}
+
+}  // namespace impeller
@@ -0,0 +1,176 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/path.h"
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A least recently used cache of path tessellations that live in
+///             device buffers and are reused across frames.
+///
+///             Entries are keyed by the identity and generation of a path, so
+///             only paths with an identity (see |Path::SetIdentity|) can be
+///             cached. Since tessellations are computed in the local space of
+///             the path, the only part of the transform that affects them is
+///             its scale. Scales are quantized into buckets so that a path
+///             that is translated or slightly scaled every frame still hits.
+///
+///             A path is only admitted into the cache the second time it is
+///             seen, so that one-off and animated paths don't pay for device
+///             allocations. When the memory budget is exceeded, the least
+///             recently used entries are evicted. Evicted buffers that are
+///             still referenced by pending commands stay alive until those
+///             are done with them.
+///
+///             Vertex meshes are cached in the same way, keyed by the hash of
+///             their contents instead of a path identity.
+///
+///             The cache is meant to be used by a single |ContentContext|,
+///             and may be used from the threads that subpasses are encoded
+///             on concurrently.
+///
+class TessellationCache {
+ public:
+  static constexpr size_t kDefaultMemoryBudget = 8u * 1024u * 1024u;
+
+  struct Key {
+    uint64_t identity = 0;
+    uint32_t generation = 0;
+    int32_t scale_bucket = 0;
+    FillType fill_type = FillType::kNonZero;
+    bool is_stroke = false;
+    Scalar stroke_width = 0;
+    Scalar miter_limit = 0;
+    Cap stroke_cap = Cap::kButt;
+    Join stroke_join = Join::kMiter;
+    bool is_vertices = false;
+    bool has_vertex_colors = false;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const;
+    };
+
+    struct Equal {
+      bool operator()(const Key& lhs, const Key& rhs) const;
+    };
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The bucket the given transform scale falls into. There are
+  ///             four buckets per power of two.
+  ///
+  static int32_t GetScaleBucket(Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The scale that paths in the given bucket are tessellated at.
+  ///             This is the largest scale in the bucket so that curves are
+  ///             never flattened more coarsely than they would have been.
+  ///
+  static Scalar GetBucketScale(int32_t bucket);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the key for filling the given path at the given
+  ///             transform scale, or std::nullopt if the path can't be
+  ///             cached.
+  ///
+  static std::optional<Key> MakeFillKey(const Path& path, Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the key for stroking the given path at the given
+  ///             transform scale, or std::nullopt if the path can't be
+  ///             cached.
+  ///
+  static std::optional<Key> MakeStrokeKey(const Path& path,
+                                          Scalar scale,
+                                          Scalar stroke_width,
+                                          Scalar miter_limit,
+                                          Cap stroke_cap,
+                                          Join stroke_join);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the key for the buffer that a vertex mesh with the
+  ///             given content hash is uploaded to, with or without its
+  ///             colors.
+  ///
+  static Key MakeVerticesKey(uint64_t content_hash, bool has_vertex_colors);
+
+  explicit TessellationCache(size_t memory_budget = kDefaultMemoryBudget);
+
+  ~TessellationCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Looks up the tessellation for the given key and marks it as
+  ///             most recently used.
+  ///
+  std::optional<VertexBuffer> Get(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a tessellation for the given key should be stored
+  ///             with |Put| after it has been computed. Returns false the
+  ///             first time a key is seen.
+  ///
+  bool ShouldAdmit(const Key& key);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stores a tessellation whose buffers are not transient,
+  ///             evicting least recently used entries to stay within the
+  ///             memory budget. Tessellations larger than the budget are not
+  ///             stored.
+  ///
+  void Put(const Key& key, VertexBuffer vertex_buffer);
+
+  void Clear();
+
+  size_t GetMemoryUsage() const;
+
+  size_t GetEntryCount() const;
+
+  size_t GetHitCount() const;
+
+  size_t GetMissCount() const;
+
+  size_t GetEvictionCount() const;
+
+ private:
+  // Bounds the number of keys that were seen only once.
+  static constexpr size_t kMaxPendingKeys = 1024u;
+
+  struct Entry {
+    Key key;
+    VertexBuffer vertex_buffer;
+    size_t size = 0;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  const size_t memory_budget_;
+  mutable std::mutex mutex_;
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, Key::Hash, Key::Equal> index_;
+  std::unordered_set<Key, Key::Hash, Key::Equal> pending_keys_;
+  size_t memory_usage_ = 0;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+  size_t eviction_count_ = 0;
+
+  void EvictToFit(size_t size);
+
+  void TraceCounts() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TessellationCache);
+};
+
+}  // namespace impeller
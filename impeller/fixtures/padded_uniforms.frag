@@ -0,0 +1,18 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+uniform FragInfo {
+  float alpha;
+  vec4 color;
+  float beta;
+  vec4 tint;
+}
+frag_info;
+
+out vec4 frag_color;
+
+void main() {
+  frag_color = frag_info.color * frag_info.alpha +
+               frag_info.tint * frag_info.beta;
+}
@@ -4,8 +4,10 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 
+#include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
@@ -29,7 +31,9 @@ static void BM_Polyline(benchmark::State& state, Args&&... args) {
   size_t point_count = 0u;
   size_t single_point_count = 0u;
   while (state.KeepRunning()) {
-    auto polyline = path.CreatePolyline(1.0f);
+    // Copies of a path start without cached polylines, so every iteration
+    // flattens the curves.
+    auto polyline = Path(path).CreatePolyline(1.0f);
     single_point_count = polyline.points.size();
     point_count += single_point_count;
     if (tessellate) {
@@ -48,6 +52,85 @@ BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline_tess, CreateCubic(), true);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline_tess, CreateQuadratic(), true);
 
+/// Transforms that are representative of deep layer trees: mostly
+/// translations and scales with the occasional rotation.
+static std::vector<Matrix> CreateTransforms(size_t count) {
+  std::vector<Matrix> transforms;
+  transforms.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    auto transform = Matrix::MakeTranslation({i * 0.5f, i * 0.25f, 0});
+    if (i % 4 == 0) {
+      transform = transform * Matrix::MakeRotationZ(Degrees(i));
+    }
+    if (i % 3 == 0) {
+      transform = transform * Matrix::MakeScale({1.01f, 0.99f, 1});
+    }
+    transforms.push_back(transform);
+  }
+  return transforms;
+}
+
+static void BM_MatrixMultiply(benchmark::State& state) {
+  auto transforms = CreateTransforms(64);
+  while (state.KeepRunning()) {
+    Matrix result;
+    for (const auto& transform : transforms) {
+      result = result * transform;
+    }
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * transforms.size());
+}
+
+static void BM_MatrixMultiplyScalar(benchmark::State& state) {
+  auto transforms = CreateTransforms(64);
+  while (state.KeepRunning()) {
+    Matrix result;
+    for (const auto& transform : transforms) {
+      result = result.Multiply(transform);
+    }
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * transforms.size());
+}
+
+template <class... Args>
+static void BM_MatrixInvert(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto transform = std::get<Matrix>(args_tuple);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(transform.Invert());
+  }
+}
+
+template <class... Args>
+static void BM_TransformBounds(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto transform = std::get<Matrix>(args_tuple);
+  auto rect = Rect::MakeXYWH(10, 20, 300, 400);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(rect.TransformBounds(transform));
+  }
+}
+
+BENCHMARK(BM_MatrixMultiply);
+BENCHMARK(BM_MatrixMultiplyScalar);
+BENCHMARK_CAPTURE(BM_MatrixInvert,
+                  affine,
+                  Matrix::MakeTranslation({10, 20, 0}) *
+                      Matrix::MakeRotationZ(Degrees(30)));
+BENCHMARK_CAPTURE(BM_MatrixInvert,
+                  perspective,
+                  Matrix::MakePerspective(Degrees(60), 1.5f, 0.1f, 100.0f));
+BENCHMARK_CAPTURE(BM_TransformBounds,
+                  affine,
+                  Matrix::MakeTranslation({10, 20, 0}) *
+                      Matrix::MakeRotationZ(Degrees(30)));
+BENCHMARK_CAPTURE(BM_TransformBounds,
+                  perspective,
+                  Matrix::MakeTranslation({0, 0, 500}) *
+                      Matrix::MakePerspective(Degrees(60), 1.5f, 0.1f, 1000));
+
 namespace {
 Path CreateCubic() {
   return PathBuilder{}
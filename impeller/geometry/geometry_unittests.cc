@@ -4,6 +4,7 @@
 
 #include "impeller/geometry/geometry_asserts.h"
 
+#include <cmath>
 #include <limits>
 #include <sstream>
 
@@ -90,6 +91,30 @@ TEST(GeometryTest, InvertMultMatrix) {
   }
 }
 
+TEST(GeometryTest, AffineInvertMatchesGeneralInvert) {
+  auto matrix = Matrix::MakeTranslation({10, -20, 0}) *
+                Matrix::MakeRotationZ(Radians{kPiOver4}) *
+                Matrix::MakeScale(Vector2{2, 3});
+  ASSERT_TRUE(matrix.IsAffine());
+  ASSERT_MATRIX_NEAR(matrix * matrix.Invert(), Matrix{});
+  ASSERT_MATRIX_NEAR(matrix.Invert() * matrix, Matrix{});
+
+  // A degenerate affine matrix has no inverse.
+  auto degenerate = Matrix::MakeScale(Vector2{0, 1});
+  ASSERT_MATRIX_NEAR(degenerate.Invert(), Matrix{});
+}
+
+TEST(GeometryTest, MatrixMultiplyMatchesScalarMultiply) {
+  auto a = Matrix{1,  2,  3,  4,   //
+                  5,  6,  7,  8,   //
+                  9,  10, 11, 12,  //
+                  13, 14, 15, 16};
+  auto b = Matrix::MakePerspective(Radians{kPiOver4}, 1.5, 0.1, 100) *
+           Matrix::MakeRotationZ(Radians{kPiOver4});
+  ASSERT_MATRIX_NEAR(a * b, a.Multiply(b));
+  ASSERT_MATRIX_NEAR(b * a, b.Multiply(a));
+}
+
 TEST(GeometryTest, MatrixBasis) {
   auto matrix = Matrix{1,  2,  3,  4,   //
                        5,  6,  7,  8,   //
@@ -1754,6 +1779,22 @@ TEST(GeometryTest, RectGetTransformedPoints) {
   ASSERT_POINT_NEAR(points[3], Point(410, 620));
 }
 
+TEST(GeometryTest, RectTransformBoundsMatchesTransformedPoints) {
+  Rect r(100, 200, 300, 400);
+  auto transforms = {
+      Matrix::MakeTranslation({10, 20}),
+      Matrix::MakeRotationZ(Radians{kPiOver4}) * Matrix::MakeScale({-2, 3, 1}),
+      Matrix::MakeTranslation({0, 0, 500}) *
+          Matrix::MakePerspective(Radians{kPiOver4}, 1.5, 0.1, 1000),
+  };
+  for (const auto& transform : transforms) {
+    auto points = r.GetTransformedPoints(transform);
+    auto expected =
+        Rect::MakePointBounds(points.begin(), points.end()).value();
+    ASSERT_RECT_NEAR(r.TransformBounds(transform), expected);
+  }
+}
+
 TEST(GeometryTest, RectMakePointBounds) {
   {
     std::vector<Point> points{{1, 5}, {4, -1}, {0, 6}};
@@ -1791,6 +1832,118 @@ TEST(GeometryTest, CubicPathComponentPolylineDoesNotIncludePointOne) {
   ASSERT_EQ(polyline.back().y, 40);
 }
 
+TEST(GeometryTest, CubicPathComponentPolylineStaysWithinTolerance) {
+  CubicPathComponent component({10, 10}, {20, 135}, {135, 20}, {140, 140});
+  for (auto scale : {0.5f, 1.0f, 4.0f}) {
+    auto polyline = component.CreatePolyline(scale);
+    ASSERT_GT(polyline.size(), 1u);
+    ASSERT_EQ(polyline.back(), component.p2);
+
+    // The points are spaced evenly in t, so the midpoint of each segment can
+    // be compared against the curve.
+    auto step = 1.0f / polyline.size();
+    auto previous = component.p1;
+    for (size_t i = 0; i < polyline.size(); i++) {
+      auto mid = component.Solve((i + 0.5f) * step);
+      auto chord_mid = (previous + polyline[i]) / 2;
+      ASSERT_LE(mid.GetDistance(chord_mid),
+                kDefaultCurveTolerance / scale + kEhCloseEnough);
+      previous = polyline[i];
+    }
+  }
+}
+
+TEST(GeometryTest, PathIsConvex) {
+  ASSERT_TRUE(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 10, 10)).TakePath().IsConvex());
+  ASSERT_TRUE(PathBuilder{}.AddCircle({50, 50}, 20).TakePath().IsConvex());
+  ASSERT_TRUE(PathBuilder{}
+                  .AddRoundedRect(Rect::MakeXYWH(0, 0, 100, 50), 10)
+                  .TakePath()
+                  .IsConvex());
+
+  auto l_shape = PathBuilder{}
+                     .MoveTo({0, 0})
+                     .LineTo({10, 0})
+                     .LineTo({10, 5})
+                     .LineTo({5, 5})
+                     .LineTo({5, 10})
+                     .LineTo({0, 10})
+                     .Close()
+                     .TakePath();
+  ASSERT_FALSE(l_shape.IsConvex());
+
+  auto two_rects = PathBuilder{}
+                       .AddRect(Rect::MakeXYWH(0, 0, 10, 10))
+                       .AddRect(Rect::MakeXYWH(20, 0, 10, 10))
+                       .TakePath();
+  ASSERT_FALSE(two_rects.IsConvex());
+
+  // A star turns the same way at every point, but winds around twice.
+  PathBuilder star;
+  star.MoveTo({50, 0});
+  for (auto i = 1; i <= 5; i++) {
+    auto angle = kPi * 2.0f * (i * 2 % 5) / 5.0f;
+    star.LineTo({50 + 50 * std::sin(angle), 50 - 50 * std::cos(angle)});
+  }
+  ASSERT_FALSE(star.Close().TakePath().IsConvex());
+}
+
+TEST(GeometryTest, PathCreatePolylineReusesPolylineOfScaleBucket) {
+  Path path;
+  path.AddCubicComponent({10, 10}, {20, 135}, {135, 20}, {140, 140});
+
+  auto polyline = path.CreatePolyline(1.1f);
+  // Scales are rounded up to a quarter of a power of two.
+  auto rounded = Path(path).CreatePolyline(std::exp2(0.25f));
+  ASSERT_EQ(polyline.points, rounded.points);
+  ASSERT_EQ(path.CreatePolyline(1.15f).points, polyline.points);
+  ASSERT_GT(path.CreatePolyline(8.0f).points.size(), polyline.points.size());
+
+  CubicPathComponent cubic({10, 10}, {20, 35}, {35, 20}, {40, 40});
+  path.UpdateCubicComponentAtIndex(1, cubic);
+  ASSERT_EQ(path.CreatePolyline(1.1f).points,
+            Path(path).CreatePolyline(1.1f).points);
+  ASSERT_NE(path.CreatePolyline(1.1f).points, polyline.points);
+}
+
+TEST(GeometryTest, PathTransformMovesEveryComponent) {
+  auto path = PathBuilder{}
+                  .MoveTo({10, 10})
+                  .LineTo({20, 10})
+                  .QuadraticCurveTo({30, 10}, {30, 20})
+                  .CubicCurveTo({30, 30}, {20, 30}, {10, 30})
+                  .Close()
+                  .TakePath();
+  path.SetIdentity(42);
+  auto generation = path.GetGeneration();
+
+  path.Transform(Matrix::MakeTranslation({5, 0}) *
+                 Matrix::MakeScale({2, 2, 1}));
+  ASSERT_EQ(path.GetIdentity(), 0u);
+  ASSERT_NE(path.GetGeneration(), generation);
+  ASSERT_EQ(path.GetComponentCount(), 6u);
+
+  ContourComponent contour;
+  ASSERT_TRUE(path.GetContourComponentAtIndex(0, contour));
+  ASSERT_POINT_NEAR(contour.destination, Point(25, 20));
+  ASSERT_TRUE(contour.is_closed);
+  LinearPathComponent linear;
+  ASSERT_TRUE(path.GetLinearComponentAtIndex(1, linear));
+  ASSERT_POINT_NEAR(linear.p2, Point(45, 20));
+  QuadraticPathComponent quad;
+  ASSERT_TRUE(path.GetQuadraticComponentAtIndex(2, quad));
+  ASSERT_POINT_NEAR(quad.cp, Point(65, 20));
+  CubicPathComponent cubic;
+  ASSERT_TRUE(path.GetCubicComponentAtIndex(3, cubic));
+  ASSERT_POINT_NEAR(cubic.p2, Point(25, 60));
+  ASSERT_FALSE(path.GetCubicComponentAtIndex(2, cubic));
+
+  auto bounds = path.GetBoundingBox();
+  ASSERT_TRUE(bounds.has_value());
+  ASSERT_RECT_NEAR(bounds.value(), Rect::MakeLTRB(25, 20, 65, 60));
+}
+
 TEST(GeometryTest, PathCreatePolyLineDoesNotDuplicatePoints) {
   Path path;
   path.AddContourComponent({10, 10});
@@ -7,6 +7,14 @@
 #include <climits>
 #include <sstream>
 
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#define IMPELLER_GEOMETRY_NEON 1
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define IMPELLER_GEOMETRY_SSE 1
+#endif
+
 namespace impeller {
 
 Matrix::Matrix(const MatrixDecomposition& d) : Matrix() {
@@ -94,7 +102,62 @@ Matrix Matrix::operator+(const Matrix& o) const {
   );
 }
 
+Matrix Matrix::operator*(const Matrix& o) const {
+  // Each column of the result is a linear combination of the columns of this
+  // matrix. The multiplications and additions happen in the same order as in
+  // |Multiply| so that both produce the same results.
+#if IMPELLER_GEOMETRY_NEON
+  const float32x4_t c0 = vld1q_f32(&m[0]);
+  const float32x4_t c1 = vld1q_f32(&m[4]);
+  const float32x4_t c2 = vld1q_f32(&m[8]);
+  const float32x4_t c3 = vld1q_f32(&m[12]);
+  Matrix result;
+  for (int i = 0; i < 4; i++) {
+    float32x4_t column = vmulq_n_f32(c0, o.m[i * 4 + 0]);
+    column = vaddq_f32(column, vmulq_n_f32(c1, o.m[i * 4 + 1]));
+    column = vaddq_f32(column, vmulq_n_f32(c2, o.m[i * 4 + 2]));
+    column = vaddq_f32(column, vmulq_n_f32(c3, o.m[i * 4 + 3]));
+    vst1q_f32(&result.m[i * 4], column);
+  }
+  return result;
+#elif IMPELLER_GEOMETRY_SSE
+  const __m128 c0 = _mm_loadu_ps(&m[0]);
+  const __m128 c1 = _mm_loadu_ps(&m[4]);
+  const __m128 c2 = _mm_loadu_ps(&m[8]);
+  const __m128 c3 = _mm_loadu_ps(&m[12]);
+  Matrix result;
+  for (int i = 0; i < 4; i++) {
+    __m128 column = _mm_mul_ps(c0, _mm_set1_ps(o.m[i * 4 + 0]));
+    column = _mm_add_ps(column, _mm_mul_ps(c1, _mm_set1_ps(o.m[i * 4 + 1])));
+    column = _mm_add_ps(column, _mm_mul_ps(c2, _mm_set1_ps(o.m[i * 4 + 2])));
+    column = _mm_add_ps(column, _mm_mul_ps(c3, _mm_set1_ps(o.m[i * 4 + 3])));
+    _mm_storeu_ps(&result.m[i * 4], column);
+  }
+  return result;
+#else
+  return Multiply(o);
+#endif
+}
+
 Matrix Matrix::Invert() const {
+  if (IsAffine()) {
+    // Only the upper 2x2 basis and the translation are interesting.
+    Scalar det = m[0] * m[5] - m[1] * m[4];
+    if (det == 0) {
+      return {};
+    }
+    det = 1.0 / det;
+    // clang-format off
+    return {
+         m[5] * det, -m[1] * det, 0, 0,
+        -m[4] * det,  m[0] * det, 0, 0,
+         0,           0,          1, 0,
+        (m[4] * m[13] - m[5] * m[12]) * det,
+        (m[1] * m[12] - m[0] * m[13]) * det, 0, 1,
+    };
+    // clang-format on
+  }
+
   Matrix tmp{
       m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] +
           m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10],
@@ -284,6 +284,11 @@ struct Matrix {
     // clang-format on
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      The inverse of this matrix, or the identity matrix if it is
+  ///             not invertible. 2D affine matrices, by far the most common,
+  ///             are inverted without computing the full adjugate.
+  ///
   Matrix Invert() const;
 
   Scalar GetDeterminant() const;
@@ -384,7 +389,11 @@ struct Matrix {
 
   Matrix operator-(const Vector3& t) const { return Translate(-t); }
 
-  Matrix operator*(const Matrix& m) const { return Multiply(m); }
+  //----------------------------------------------------------------------------
+  /// @brief      Same as |Multiply| but uses NEON or SSE when available. Not
+  ///             constexpr, use |Multiply| in constant expressions.
+  ///
+  Matrix operator*(const Matrix& m) const;
 
   Matrix operator+(const Matrix& m) const;
 
@@ -4,6 +4,8 @@
 
 #include "impeller/geometry/path.h"
 
+#include <algorithm>
+#include <cmath>
 #include <optional>
 #include <variant>
 
@@ -31,43 +33,82 @@ std::tuple<size_t, size_t> Path::Polyline::GetContourPointBounds(
 
 size_t Path::GetComponentCount(std::optional<ComponentType> type) const {
   if (type.has_value()) {
-    switch (type.value()) {
-      case ComponentType::kLinear:
-        return linears_.size();
-      case ComponentType::kQuadratic:
-        return quads_.size();
-      case ComponentType::kCubic:
-        return cubics_.size();
-      case ComponentType::kContour:
-        return contours_.size();
-    }
+    return component_counts_[static_cast<size_t>(type.value())];
   }
   return components_.size();
 }
 
 void Path::SetFillType(FillType fill) {
   fill_ = fill;
+  generation_++;
 }
 
 FillType Path::GetFillType() const {
   return fill_;
 }
 
+void Path::SetIdentity(uint64_t identity) {
+  identity_ = identity;
+}
+
+uint64_t Path::GetIdentity() const {
+  return identity_;
+}
+
+uint32_t Path::GetGeneration() const {
+  return generation_;
+}
+
+void Path::Reserve(size_t point_count, size_t component_count) {
+  points_.reserve(point_count);
+  components_.reserve(component_count);
+}
+
+void Path::Transform(const Matrix& transform) {
+  for (auto& point : points_) {
+    point = transform * point;
+  }
+  identity_ = 0;
+  generation_++;
+}
+
+void Path::AddComponent(ComponentType type,
+                        std::initializer_list<Point> points,
+                        bool is_closed) {
+  components_.push_back({.type = type,
+                         .is_closed = is_closed,
+                         .point_index = static_cast<uint32_t>(points_.size())});
+  points_.insert(points_.end(), points);
+  component_counts_[static_cast<size_t>(type)]++;
+  generation_++;
+}
+
+const Point* Path::GetComponentPoints(size_t index, ComponentType type) const {
+  if (index >= components_.size() || components_[index].type != type) {
+    return nullptr;
+  }
+  return &points_[components_[index].point_index];
+}
+
+Point* Path::GetComponentPoints(size_t index, ComponentType type) {
+  if (index >= components_.size() || components_[index].type != type) {
+    return nullptr;
+  }
+  return &points_[components_[index].point_index];
+}
+
 Path& Path::AddLinearComponent(Point p1, Point p2) {
-  linears_.emplace_back(p1, p2);
-  components_.emplace_back(ComponentType::kLinear, linears_.size() - 1);
+  AddComponent(ComponentType::kLinear, {p1, p2});
   return *this;
 }
 
 Path& Path::AddQuadraticComponent(Point p1, Point cp, Point p2) {
-  quads_.emplace_back(p1, cp, p2);
-  components_.emplace_back(ComponentType::kQuadratic, quads_.size() - 1);
+  AddComponent(ComponentType::kQuadratic, {p1, cp, p2});
   return *this;
 }
 
 Path& Path::AddCubicComponent(Point p1, Point cp1, Point cp2, Point p2) {
-  cubics_.emplace_back(p1, cp1, cp2, p2);
-  components_.emplace_back(ComponentType::kCubic, cubics_.size() - 1);
+  AddComponent(ComponentType::kCubic, {p1, cp1, cp2, p2});
   return *this;
 }
 
@@ -75,16 +116,23 @@ Path& Path::AddContourComponent(Point destination, bool is_closed) {
   if (components_.size() > 0 &&
       components_.back().type == ComponentType::kContour) {
     // Never insert contiguous contours.
-    contours_.back() = ContourComponent(destination, is_closed);
+    components_.back().is_closed = is_closed;
+    points_.back() = destination;
+    generation_++;
   } else {
-    contours_.emplace_back(ContourComponent(destination, is_closed));
-    components_.emplace_back(ComponentType::kContour, contours_.size() - 1);
+    AddComponent(ComponentType::kContour, {destination}, is_closed);
   }
   return *this;
 }
 
 void Path::SetContourClosed(bool is_closed) {
-  contours_.back().is_closed = is_closed;
+  for (auto it = components_.rbegin(); it != components_.rend(); ++it) {
+    if (it->type == ComponentType::kContour) {
+      it->is_closed = is_closed;
+      break;
+    }
+  }
+  generation_++;
 }
 
 void Path::EnumerateComponents(
@@ -92,149 +140,282 @@ void Path::EnumerateComponents(
     const Applier<QuadraticPathComponent>& quad_applier,
     const Applier<CubicPathComponent>& cubic_applier,
     const Applier<ContourComponent>& contour_applier) const {
-  size_t currentIndex = 0;
-  for (const auto& component : components_) {
+  for (size_t i = 0; i < components_.size(); i++) {
+    const auto& component = components_[i];
+    const Point* p = &points_[component.point_index];
     switch (component.type) {
       case ComponentType::kLinear:
         if (linear_applier) {
-          linear_applier(currentIndex, linears_[component.index]);
+          linear_applier(i, LinearPathComponent(p[0], p[1]));
         }
         break;
       case ComponentType::kQuadratic:
         if (quad_applier) {
-          quad_applier(currentIndex, quads_[component.index]);
+          quad_applier(i, QuadraticPathComponent(p[0], p[1], p[2]));
         }
         break;
       case ComponentType::kCubic:
         if (cubic_applier) {
-          cubic_applier(currentIndex, cubics_[component.index]);
+          cubic_applier(i, CubicPathComponent(p[0], p[1], p[2], p[3]));
         }
         break;
       case ComponentType::kContour:
         if (contour_applier) {
-          contour_applier(currentIndex, contours_[component.index]);
+          contour_applier(i, ContourComponent(p[0], component.is_closed));
         }
         break;
     }
-    currentIndex++;
   }
 }
 
 bool Path::GetLinearComponentAtIndex(size_t index,
                                      LinearPathComponent& linear) const {
-  if (index >= components_.size()) {
-    return false;
-  }
-
-  if (components_[index].type != ComponentType::kLinear) {
+  auto p = GetComponentPoints(index, ComponentType::kLinear);
+  if (!p) {
     return false;
   }
-
-  linear = linears_[components_[index].index];
+  linear = LinearPathComponent(p[0], p[1]);
   return true;
 }
 
 bool Path::GetQuadraticComponentAtIndex(
     size_t index,
     QuadraticPathComponent& quadratic) const {
-  if (index >= components_.size()) {
+  auto p = GetComponentPoints(index, ComponentType::kQuadratic);
+  if (!p) {
     return false;
   }
-
-  if (components_[index].type != ComponentType::kQuadratic) {
-    return false;
-  }
-
-  quadratic = quads_[components_[index].index];
+  quadratic = QuadraticPathComponent(p[0], p[1], p[2]);
   return true;
 }
 
 bool Path::GetCubicComponentAtIndex(size_t index,
                                     CubicPathComponent& cubic) const {
-  if (index >= components_.size()) {
-    return false;
-  }
-
-  if (components_[index].type != ComponentType::kCubic) {
+  auto p = GetComponentPoints(index, ComponentType::kCubic);
+  if (!p) {
     return false;
   }
-
-  cubic = cubics_[components_[index].index];
+  cubic = CubicPathComponent(p[0], p[1], p[2], p[3]);
   return true;
 }
 
 bool Path::GetContourComponentAtIndex(size_t index,
                                       ContourComponent& move) const {
-  if (index >= components_.size()) {
-    return false;
-  }
-
-  if (components_[index].type != ComponentType::kContour) {
+  auto p = GetComponentPoints(index, ComponentType::kContour);
+  if (!p) {
     return false;
   }
-
-  move = contours_[components_[index].index];
+  move = ContourComponent(p[0], components_[index].is_closed);
   return true;
 }
 
 bool Path::UpdateLinearComponentAtIndex(size_t index,
                                         const LinearPathComponent& linear) {
-  if (index >= components_.size()) {
-    return false;
-  }
-
-  if (components_[index].type != ComponentType::kLinear) {
+  auto p = GetComponentPoints(index, ComponentType::kLinear);
+  if (!p) {
     return false;
   }
-
-  linears_[components_[index].index] = linear;
+  p[0] = linear.p1;
+  p[1] = linear.p2;
+  generation_++;
   return true;
 }
 
 bool Path::UpdateQuadraticComponentAtIndex(
     size_t index,
     const QuadraticPathComponent& quadratic) {
-  if (index >= components_.size()) {
-    return false;
-  }
-
-  if (components_[index].type != ComponentType::kQuadratic) {
+  auto p = GetComponentPoints(index, ComponentType::kQuadratic);
+  if (!p) {
     return false;
   }
-
-  quads_[components_[index].index] = quadratic;
+  p[0] = quadratic.p1;
+  p[1] = quadratic.cp;
+  p[2] = quadratic.p2;
+  generation_++;
   return true;
 }
 
 bool Path::UpdateCubicComponentAtIndex(size_t index,
                                        CubicPathComponent& cubic) {
-  if (index >= components_.size()) {
-    return false;
-  }
-
-  if (components_[index].type != ComponentType::kCubic) {
+  auto p = GetComponentPoints(index, ComponentType::kCubic);
+  if (!p) {
     return false;
   }
-
-  cubics_[components_[index].index] = cubic;
+  p[0] = cubic.p1;
+  p[1] = cubic.cp1;
+  p[2] = cubic.cp2;
+  p[3] = cubic.p2;
+  generation_++;
   return true;
 }
 
 bool Path::UpdateContourComponentAtIndex(size_t index,
                                          const ContourComponent& move) {
-  if (index >= components_.size()) {
+  auto p = GetComponentPoints(index, ComponentType::kContour);
+  if (!p) {
     return false;
   }
+  p[0] = move.destination;
+  components_[index].is_closed = move.is_closed;
+  generation_++;
+  return true;
+}
 
-  if (components_[index].type != ComponentType::kContour) {
-    return false;
+Path::Polyline Path::CreatePolyline(Scalar scale) const {
+  if (!(scale > 0) || !std::isfinite(scale)) {
+    return FlattenComponents(scale);
   }
 
-  contours_[components_[index].index] = move;
-  return true;
+  // Flattening at a slightly larger scale only adds points, so rounding the
+  // scale up keeps the polyline within tolerance of the curves.
+  auto scale_bucket = static_cast<int32_t>(std::ceil(std::log2(scale) * 4));
+  if (auto polyline = polyline_cache_.Get(generation_, scale_bucket)) {
+    return std::move(polyline.value());
+  }
+  auto polyline = FlattenComponents(std::exp2(scale_bucket / 4.0f));
+  polyline_cache_.Put(generation_, scale_bucket, polyline);
+  return polyline;
 }
 
-Path::Polyline Path::CreatePolyline(Scalar scale) const {
+std::optional<Path::Polyline> Path::PolylineCache::Get(uint32_t generation,
+                                                       int32_t scale_bucket) {
+  std::scoped_lock lock(mutex_);
+  for (const auto& entry : entries_) {
+    if (entry.generation == generation && entry.scale_bucket == scale_bucket) {
+      return entry.polyline;
+    }
+  }
+  return std::nullopt;
+}
+
+void Path::PolylineCache::Put(uint32_t generation,
+                              int32_t scale_bucket,
+                              const Polyline& polyline) {
+  std::scoped_lock lock(mutex_);
+  // Polylines of earlier generations are never looked up again.
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [generation](const Entry& entry) {
+                                  return entry.generation != generation;
+                                }),
+                 entries_.end());
+  if (entries_.size() >= kMaxCachedPolylines) {
+    entries_.erase(entries_.begin());
+  }
+  entries_.push_back({generation, scale_bucket, polyline});
+}
+
+std::optional<bool> Path::PolylineCache::GetConvexity(uint32_t generation) {
+  std::scoped_lock lock(mutex_);
+  if (convexity_.has_value() && convexity_->first == generation) {
+    return convexity_->second;
+  }
+  return std::nullopt;
+}
+
+void Path::PolylineCache::PutConvexity(uint32_t generation, bool is_convex) {
+  std::scoped_lock lock(mutex_);
+  convexity_ = {generation, is_convex};
+}
+
+void Path::PolylineCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  entries_.clear();
+  convexity_.reset();
+}
+
+bool Path::IsConvex() const {
+  if (auto is_convex = polyline_cache_.GetConvexity(generation_)) {
+    return is_convex.value();
+  }
+  auto is_convex = ComputeConvexity();
+  polyline_cache_.PutConvexity(generation_, is_convex);
+  return is_convex;
+}
+
+bool Path::ComputeConvexity() const {
+  // There must be one contour, which may be followed by an empty one.
+  size_t point_end = points_.size();
+  for (size_t i = 1; i < components_.size(); i++) {
+    if (components_[i].type != ComponentType::kContour) {
+      continue;
+    }
+    if (i != components_.size() - 1) {
+      return false;
+    }
+    point_end = components_[i].point_index;
+  }
+
+  // Walk the edges between the points of the closed contour, and the first
+  // edge once more. They must all turn the same way, and their directions
+  // may only flip sign twice along each axis so that they turn only once.
+  std::optional<Point> first_point;
+  std::optional<Vector2> first_edge;
+  Point last_point;
+  Vector2 last_edge;
+  int turn = 0;
+  int x_flips = 0;
+  int y_flips = 0;
+  int last_x_sign = 0;
+  int last_y_sign = 0;
+  size_t edge_count = 0;
+  auto sign = [](Scalar value) { return (value > 0) - (value < 0); };
+  auto add_edge = [&](const Vector2& edge) {
+    if (edge_count > 0) {
+      auto cross = last_edge.Cross(edge);
+      if (cross == 0 && last_edge.Dot(edge) < 0) {
+        // The contour doubles back on itself.
+        return false;
+      }
+      if (cross != 0) {
+        if (turn != 0 && sign(cross) != turn) {
+          return false;
+        }
+        turn = sign(cross);
+      }
+    }
+    if (auto x_sign = sign(edge.x); x_sign != 0) {
+      x_flips += last_x_sign != 0 && x_sign != last_x_sign;
+      last_x_sign = x_sign;
+    }
+    if (auto y_sign = sign(edge.y); y_sign != 0) {
+      y_flips += last_y_sign != 0 && y_sign != last_y_sign;
+      last_y_sign = y_sign;
+    }
+    last_edge = edge;
+    edge_count++;
+    return x_flips <= 2 && y_flips <= 2;
+  };
+
+  for (size_t i = 0; i < point_end; i++) {
+    const auto& point = points_[i];
+    if (!first_point.has_value()) {
+      first_point = point;
+      last_point = point;
+      continue;
+    }
+    if (point == last_point) {
+      continue;
+    }
+    auto edge = point - last_point;
+    if (!first_edge.has_value()) {
+      first_edge = edge;
+    }
+    if (!add_edge(edge)) {
+      return false;
+    }
+    last_point = point;
+  }
+  if (!first_edge.has_value()) {
+    return false;
+  }
+  if (last_point != first_point.value() &&
+      !add_edge(first_point.value() - last_point)) {
+    return false;
+  }
+  return add_edge(first_edge.value()) && turn != 0;
+}
+
+Path::Polyline Path::FlattenComponents(Scalar scale) const {
   Polyline polyline;
 
   std::optional<Point> previous_contour_point;
@@ -255,31 +436,40 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
     }
   };
 
-  auto get_path_component = [this](size_t component_i) -> PathComponentVariant {
-    if (component_i >= components_.size()) {
-      return std::monostate{};
-    }
+  auto is_segment = [this](size_t component_i) {
+    return component_i < components_.size() &&
+           components_[component_i].type != ComponentType::kContour;
+  };
+
+  // The direction at the start or end of a segment, if it is not a point.
+  auto get_direction = [this](size_t component_i,
+                              bool start) -> std::optional<Vector2> {
     const auto& component = components_[component_i];
+    const Point* p = &points_[component.point_index];
     switch (component.type) {
-      case ComponentType::kLinear:
-        return &linears_[component.index];
-      case ComponentType::kQuadratic:
-        return &quads_[component.index];
-      case ComponentType::kCubic:
-        return &cubics_[component.index];
+      case ComponentType::kLinear: {
+        LinearPathComponent linear(p[0], p[1]);
+        return start ? linear.GetStartDirection() : linear.GetEndDirection();
+      }
+      case ComponentType::kQuadratic: {
+        QuadraticPathComponent quad(p[0], p[1], p[2]);
+        return start ? quad.GetStartDirection() : quad.GetEndDirection();
+      }
+      case ComponentType::kCubic: {
+        CubicPathComponent cubic(p[0], p[1], p[2], p[3]);
+        return start ? cubic.GetStartDirection() : cubic.GetEndDirection();
+      }
       case ComponentType::kContour:
-        return std::monostate{};
+        return std::nullopt;
     }
+    return std::nullopt;
   };
 
   auto compute_contour_start_direction =
-      [&get_path_component](size_t current_path_component_index) {
+      [&is_segment, &get_direction](size_t current_path_component_index) {
         size_t next_component_index = current_path_component_index + 1;
-        while (!std::holds_alternative<std::monostate>(
-            get_path_component(next_component_index))) {
-          auto next_component = get_path_component(next_component_index);
-          auto maybe_vector =
-              std::visit(PathComponentStartDirectionVisitor(), next_component);
+        while (is_segment(next_component_index)) {
+          auto maybe_vector = get_direction(next_component_index, true);
           if (maybe_vector.has_value()) {
             return maybe_vector.value();
           } else {
@@ -290,8 +480,8 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
       };
 
   std::optional<size_t> previous_path_component_index;
-  auto end_contour = [&polyline, &previous_path_component_index,
-                      &get_path_component]() {
+  auto end_contour = [&polyline, &previous_path_component_index, &is_segment,
+                      &get_direction]() {
     // Whenever a contour has ended, extract the exact end direction from the
     // last component.
     if (polyline.contours.empty()) {
@@ -306,11 +496,8 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
     contour.end_direction = Vector2(0, 1);
 
     size_t previous_index = previous_path_component_index.value();
-    while (!std::holds_alternative<std::monostate>(
-        get_path_component(previous_index))) {
-      auto previous_component = get_path_component(previous_index);
-      auto maybe_vector =
-          std::visit(PathComponentEndDirectionVisitor(), previous_component);
+    while (is_segment(previous_index)) {
+      auto maybe_vector = get_direction(previous_index, false);
       if (maybe_vector.has_value()) {
         contour.end_direction = maybe_vector.value();
         break;
@@ -326,17 +513,20 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
   for (size_t component_i = 0; component_i < components_.size();
        component_i++) {
     const auto& component = components_[component_i];
+    const Point* p = &points_[component.point_index];
     switch (component.type) {
       case ComponentType::kLinear:
-        collect_points(linears_[component.index].CreatePolyline());
+        collect_points(LinearPathComponent(p[0], p[1]).CreatePolyline());
         previous_path_component_index = component_i;
         break;
       case ComponentType::kQuadratic:
-        collect_points(quads_[component.index].CreatePolyline(scale));
+        collect_points(
+            QuadraticPathComponent(p[0], p[1], p[2]).CreatePolyline(scale));
         previous_path_component_index = component_i;
         break;
       case ComponentType::kCubic:
-        collect_points(cubics_[component.index].CreatePolyline(scale));
+        collect_points(CubicPathComponent(p[0], p[1], p[2], p[3])
+                           .CreatePolyline(scale));
         previous_path_component_index = component_i;
         break;
       case ComponentType::kContour:
@@ -348,12 +538,11 @@ Path::Polyline Path::CreatePolyline(Scalar scale) const {
         end_contour();
 
         Vector2 start_direction = compute_contour_start_direction(component_i);
-        const auto& contour = contours_[component.index];
         polyline.contours.push_back({.start_index = polyline.points.size(),
-                                     .is_closed = contour.is_closed,
+                                     .is_closed = component.is_closed,
                                      .start_direction = start_direction});
         previous_contour_point = std::nullopt;
-        collect_points({contour.destination});
+        collect_points({p[0]});
         break;
     }
     end_contour();
@@ -382,7 +571,8 @@ std::optional<Rect> Path::GetTransformedBoundingBox(
 }
 
 std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
-  if (linears_.empty() && quads_.empty() && cubics_.empty()) {
+  if (component_counts_[static_cast<size_t>(ComponentType::kContour)] ==
+      components_.size()) {
     return std::nullopt;
   }
 
@@ -402,20 +592,27 @@ std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
     }
   };
 
-  for (const auto& linear : linears_) {
-    clamp(linear.p1);
-    clamp(linear.p2);
-  }
-
-  for (const auto& quad : quads_) {
-    for (const Point& point : quad.Extrema()) {
-      clamp(point);
-    }
-  }
-
-  for (const auto& cubic : cubics_) {
-    for (const Point& point : cubic.Extrema()) {
-      clamp(point);
+  for (const auto& component : components_) {
+    const Point* p = &points_[component.point_index];
+    switch (component.type) {
+      case ComponentType::kLinear:
+        clamp(p[0]);
+        clamp(p[1]);
+        break;
+      case ComponentType::kQuadratic:
+        for (const Point& point :
+             QuadraticPathComponent(p[0], p[1], p[2]).Extrema()) {
+          clamp(point);
+        }
+        break;
+      case ComponentType::kCubic:
+        for (const Point& point :
+             CubicPathComponent(p[0], p[1], p[2], p[3]).Extrema()) {
+          clamp(point);
+        }
+        break;
+      case ComponentType::kContour:
+        break;
     }
   }
 
@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
+#include <initializer_list>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <tuple>
@@ -47,9 +50,13 @@ enum class FillType {
 ///             Creating paths that describe complex shapes is usually done by a
 ///             path builder.
 ///
+///             The points of all of the components are stored in a single
+///             buffer, in the order of the components, next to a compact
+///             array of the component types.
+///
 class Path {
  public:
-  enum class ComponentType {
+  enum class ComponentType : uint8_t {
     kLinear,
     kQuadratic,
     kCubic,
@@ -95,6 +102,41 @@ class Path {
 
   FillType GetFillType() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets an identifier shared by all paths describing the same
+  ///             geometry, like the generation ID of the |SkPath| this path
+  ///             was converted from. Caches use the identity together with
+  ///             the generation to recognize a path across frames.
+  ///
+  void SetIdentity(uint64_t identity);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The identity of this path, or 0 if it has none.
+  ///
+  uint64_t GetIdentity() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A counter that is incremented on every mutation of this path.
+  ///
+  uint32_t GetGeneration() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reserves room for the given number of components that take
+  ///             up the given number of points together. A linear component
+  ///             has 2 points, a quadratic 3, a cubic 4 and a contour 1.
+  ///
+  void Reserve(size_t point_count, size_t component_count);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Transforms every point of this path. This is exact for
+  ///             affine transforms only, as the curves of a path are not
+  ///             rational.
+  ///
+  ///             The path loses its identity, as it no longer describes the
+  ///             same geometry.
+  ///
+  void Transform(const Matrix& transform);
+
   Path& AddLinearComponent(Point p1, Point p2);
 
   Path& AddQuadraticComponent(Point p1, Point cp, Point p2);
@@ -140,8 +182,22 @@ class Path {
   ///
   /// It is suitable to use the max basis length of the matrix used to transform
   /// the path. If the provided scale is 0, curves will revert to lines.
+  ///
+  /// The scale is rounded up to a quarter of a power of two, and the polylines
+  /// of the last few rounded scales are kept for the current generation of
+  /// the path. Copies of a path start without any polylines.
   Polyline CreatePolyline(Scalar scale) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether this path is a single contour that encloses a convex
+  ///             area, so that it can be filled with a triangle fan. A curve
+  ///             is convex when its control points are, so this holds for the
+  ///             polyline of the path at any scale as well.
+  ///
+  ///             The result is kept for the current generation of the path.
+  ///
+  bool IsConvex() const;
+
   std::optional<Rect> GetBoundingBox() const;
 
   std::optional<Rect> GetTransformedBoundingBox(const Matrix& transform) const;
@@ -149,22 +205,70 @@ class Path {
   std::optional<std::pair<Point, Point>> GetMinMaxCoveragePoints() const;
 
  private:
-  struct ComponentIndexPair {
-    ComponentType type = ComponentType::kLinear;
-    size_t index = 0;
+  static constexpr size_t kMaxCachedPolylines = 4;
 
-    ComponentIndexPair() {}
+  class PolylineCache {
+   public:
+    PolylineCache() = default;
 
-    ComponentIndexPair(ComponentType a_type, size_t a_index)
-        : type(a_type), index(a_index) {}
+    PolylineCache(const PolylineCache& other) {}
+
+    PolylineCache& operator=(const PolylineCache& other) {
+      Clear();
+      return *this;
+    }
+
+    std::optional<Polyline> Get(uint32_t generation, int32_t scale_bucket);
+
+    std::optional<bool> GetConvexity(uint32_t generation);
+
+    void PutConvexity(uint32_t generation, bool is_convex);
+
+    void Put(uint32_t generation,
+             int32_t scale_bucket,
+             const Polyline& polyline);
+
+    void Clear();
+
+   private:
+    struct Entry {
+      uint32_t generation = 0;
+      int32_t scale_bucket = 0;
+      Polyline polyline;
+    };
+
+    std::mutex mutex_;
+    std::vector<Entry> entries_;
+    std::optional<std::pair<uint32_t, bool>> convexity_;
+  };
+
+  struct Component {
+    ComponentType type = ComponentType::kLinear;
+    /// Whether the contour is closed, for contour components.
+    bool is_closed = false;
+    /// The index of the first point of the component in |points_|.
+    uint32_t point_index = 0;
   };
 
   FillType fill_ = FillType::kNonZero;
-  std::vector<ComponentIndexPair> components_;
-  std::vector<LinearPathComponent> linears_;
-  std::vector<QuadraticPathComponent> quads_;
-  std::vector<CubicPathComponent> cubics_;
-  std::vector<ContourComponent> contours_;
+  uint64_t identity_ = 0;
+  uint32_t generation_ = 0;
+  std::vector<Component> components_;
+  std::vector<Point> points_;
+  std::array<size_t, 4> component_counts_ = {};
+  mutable PolylineCache polyline_cache_;
+
+  void AddComponent(ComponentType type,
+                    std::initializer_list<Point> points,
+                    bool is_closed = false);
+
+  const Point* GetComponentPoints(size_t index, ComponentType type) const;
+
+  Point* GetComponentPoints(size_t index, ComponentType type);
+
+  Polyline FlattenComponents(Scalar scale) const;
+
+  bool ComputeConvexity() const;
 };
 
 }  // namespace impeller
@@ -19,11 +19,19 @@ Path PathBuilder::CopyPath(FillType fill) const {
 }
 
 Path PathBuilder::TakePath(FillType fill) {
-  auto path = prototype_;
+  auto path = std::move(prototype_);
   path.SetFillType(fill);
+  prototype_ = Path();
+  subpath_start_ = Point();
+  current_ = Point();
   return path;
 }
 
+PathBuilder& PathBuilder::Reserve(size_t point_count, size_t component_count) {
+  prototype_.Reserve(point_count, component_count);
+  return *this;
+}
+
 PathBuilder& PathBuilder::MoveTo(Point point, bool relative) {
   current_ = relative ? current_ + point : point;
   subpath_start_ = current_;
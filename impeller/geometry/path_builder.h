@@ -27,8 +27,18 @@ class PathBuilder {
 
   Path CopyPath(FillType fill = FillType::kNonZero) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Moves the path out of the builder, which starts over with an
+  ///             empty path.
+  ///
   Path TakePath(FillType fill = FillType::kNonZero);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Reserves room in the path for the given number of points and
+  ///             components, as counted by |Path::Reserve|.
+  ///
+  PathBuilder& Reserve(size_t point_count, size_t component_count);
+
   const Path& GetCurrentPath() const;
 
   PathBuilder& MoveTo(Point point, bool relative = false);
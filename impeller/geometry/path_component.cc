@@ -188,14 +188,39 @@ Point CubicPathComponent::SolveDerivative(Scalar time) const {
 }
 
 std::vector<Point> CubicPathComponent::CreatePolyline(Scalar scale) const {
-  auto quads = ToQuadraticPathComponents(.1);
   std::vector<Point> points;
-  for (const auto& quad : quads) {
-    quad.FillPointsForPolyline(points, scale);
-  }
+  FillPointsForPolyline(points, scale);
   return points;
 }
 
+void CubicPathComponent::FillPointsForPolyline(std::vector<Point>& points,
+                                               Scalar scale_factor) const {
+  auto tolerance = kDefaultCurveTolerance / scale_factor;
+
+  // Wang's formula for a curve of degree 3: n = sqrt(3 * 2 / 8 * M / tol),
+  // where M is the length of the largest second difference of the points.
+  auto d1 = p1 - 2 * cp1 + cp2;
+  auto d2 = cp1 - 2 * cp2 + p2;
+  auto max_length = std::sqrt(std::max(d1.Dot(d1), d2.Dot(d2)));
+  Scalar line_count = std::ceil(std::sqrt(0.75f * max_length / tolerance));
+  if (!std::isfinite(line_count) || line_count < 1) {
+    line_count = 1;
+  }
+
+  // Evaluate the curve in its power basis, which has no dependencies between
+  // the steps of the loop.
+  auto a = p2 - p1 + 3 * (cp1 - cp2);
+  auto b = 3 * (p1 - 2 * cp1 + cp2);
+  auto c = 3 * (cp1 - p1);
+  auto step = 1 / line_count;
+  points.reserve(points.size() + static_cast<size_t>(line_count));
+  for (size_t i = 1; i < line_count; i++) {
+    auto t = i * step;
+    points.emplace_back(((a * t + b) * t + c) * t + p1);
+  }
+  points.emplace_back(p2);
+}
+
 inline QuadraticPathComponent CubicPathComponent::Lower() const {
   return QuadraticPathComponent(3.0 * (cp1 - p1), 3.0 * (cp2 - cp1),
                                 3.0 * (p2 - cp2));
@@ -108,12 +108,17 @@ struct CubicPathComponent {
 
   Point SolveDerivative(Scalar time) const;
 
-  // This method approximates the cubic component with quadratics, and then
-  // generates a polyline from those quadratics.
+  // Subdivides the cubic uniformly in `t`, with the number of segments given
+  // by Wang's formula. This is the smallest count for which the polyline is
+  // guaranteed to stay within the tolerance of the curve, and it is computed
+  // without any recursion or intermediate quadratics.
   //
-  // See the note on QuadraticPathComponent::CreatePolyline for references.
+  // See "Pyramid Algorithms" (Goldman, 2002), section 5.6.3.
   std::vector<Point> CreatePolyline(Scalar scale) const;
 
+  void FillPointsForPolyline(std::vector<Point>& points,
+                             Scalar scale_factor) const;
+
   std::vector<Point> Extrema() const;
 
   std::vector<QuadraticPathComponent> ToQuadraticPathComponents(
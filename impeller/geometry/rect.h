@@ -181,6 +181,22 @@ struct TRect {
   /// @brief  Creates a new bounding box that contains this transformed
   ///         rectangle.
   constexpr TRect TransformBounds(const Matrix& transform) const {
+    if (transform.m[3] == 0 && transform.m[7] == 0 && transform.m[15] == 1) {
+      // Without perspective, the extrema along each axis are found by picking
+      // the smaller and larger contribution of each edge independently instead
+      // of transforming and dividing all four corners.
+      auto [left, top, right, bottom] = GetLTRB();
+      const auto& m = transform.m;
+      auto x_min = std::min(left * m[0], right * m[0]) +
+                   std::min(top * m[4], bottom * m[4]) + m[12];
+      auto x_max = std::max(left * m[0], right * m[0]) +
+                   std::max(top * m[4], bottom * m[4]) + m[12];
+      auto y_min = std::min(left * m[1], right * m[1]) +
+                   std::min(top * m[5], bottom * m[5]) + m[13];
+      auto y_max = std::max(left * m[1], right * m[1]) +
+                   std::max(top * m[5], bottom * m[5]) + m[13];
+      return TRect::MakeLTRB(x_min, y_min, x_max, y_max);
+    }
     auto points = GetTransformedPoints(transform);
     return TRect::MakePointBounds(points.begin(), points.end()).value();
   }
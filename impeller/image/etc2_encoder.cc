@@ -0,0 +1,279 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/image/etc2_encoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <limits>
+
+namespace impeller {
+
+namespace {
+
+using RGB = std::array<int, 3>;
+
+/// The pixels of one of the two halves of a block that share a base color,
+/// with their coordinates in the block.
+struct Subblock {
+  std::array<RGB, 8> pixels;
+  std::array<int, 8> x;
+  std::array<int, 8> y;
+};
+
+struct SubblockFit {
+  uint32_t table = 0u;
+  std::array<uint32_t, 8> codes = {};
+  int64_t error = std::numeric_limits<int64_t>::max();
+};
+
+struct BlockFit {
+  uint64_t bits = 0u;
+  int64_t error = std::numeric_limits<int64_t>::max();
+};
+
+/// The magnitudes of the small and the large modifier of each intensity
+/// modifier table.
+constexpr int kModifierTables[8][2] = {
+    {2, 8},   {5, 17},  {9, 29},   {13, 42},
+    {18, 60}, {24, 80}, {33, 106}, {47, 183},
+};
+
+/// The pixel index codes of the modifiers -large, -small, +small and +large.
+constexpr uint32_t kModifierCodes[4] = {3u, 2u, 0u, 1u};
+
+size_t GetBlockCount(int64_t pixels) {
+  return static_cast<size_t>((pixels + 3) / 4);
+}
+
+int ExpandChannel4(int value) {
+  return (value << 4) | value;
+}
+
+int ExpandChannel5(int value) {
+  return (value << 3) | (value >> 2);
+}
+
+int QuantizeChannel(int value, int max) {
+  return (value * max + 127) / 255;
+}
+
+RGB GetAverage(const Subblock& subblock) {
+  RGB sum = {0, 0, 0};
+  for (const auto& pixel : subblock.pixels) {
+    for (size_t c = 0; c < 3; c++) {
+      sum[c] += pixel[c];
+    }
+  }
+  return {(sum[0] + 4) / 8, (sum[1] + 4) / 8, (sum[2] + 4) / 8};
+}
+
+/// Picks the modifier table and the modifier of each pixel that reproduce the
+/// subblock best from `base`. The modifier of a pixel is the one nearest to
+/// its mean offset from the base color, which is exact unless a channel is
+/// clamped.
+SubblockFit FitSubblock(const Subblock& subblock, const RGB& base) {
+  SubblockFit best;
+  for (uint32_t table = 0u; table < 8u; table++) {
+    const int small = kModifierTables[table][0];
+    const int large = kModifierTables[table][1];
+    const int modifiers[4] = {-large, -small, small, large};
+
+    SubblockFit fit;
+    fit.table = table;
+    fit.error = 0;
+    for (size_t i = 0; i < subblock.pixels.size() && fit.error < best.error;
+         i++) {
+      const auto& pixel = subblock.pixels[i];
+      const int offset =
+          ((pixel[0] - base[0]) + (pixel[1] - base[1]) + (pixel[2] - base[2])) /
+          3;
+      size_t modifier = 0;
+      for (size_t m = 1; m < 4; m++) {
+        if (std::abs(offset - modifiers[m]) <
+            std::abs(offset - modifiers[modifier])) {
+          modifier = m;
+        }
+      }
+      for (size_t c = 0; c < 3; c++) {
+        const int64_t delta =
+            pixel[c] - std::clamp(base[c] + modifiers[modifier], 0, 255);
+        fit.error += delta * delta;
+      }
+      fit.codes[i] = kModifierCodes[modifier];
+    }
+    if (fit.error < best.error) {
+      best = fit;
+    }
+  }
+  return best;
+}
+
+uint64_t GetPixelIndexBits(const Subblock& subblock, const SubblockFit& fit) {
+  uint64_t bits = 0u;
+  for (size_t i = 0; i < subblock.pixels.size(); i++) {
+    // Pixels are indexed in column major order, with the most significant bit
+    // of each index in the upper half of the 32 index bits.
+    const auto index = subblock.x[i] * 4 + subblock.y[i];
+    bits |= static_cast<uint64_t>(fit.codes[i] >> 1) << (index + 16);
+    bits |= static_cast<uint64_t>(fit.codes[i] & 1u) << index;
+  }
+  return bits;
+}
+
+BlockFit FitBlock(const std::array<Subblock, 2>& subblocks, bool flip) {
+  const std::array<RGB, 2> averages = {GetAverage(subblocks[0]),
+                                       GetAverage(subblocks[1])};
+  const uint64_t flip_bit = flip ? 1u : 0u;
+
+  BlockFit best;
+
+  // The differential mode has more precise base colors, as long as the
+  // second one is close enough to the first one.
+  {
+    std::array<RGB, 2> quantized;
+    std::array<RGB, 2> bases;
+    bool fits = true;
+    for (size_t s = 0; s < 2; s++) {
+      for (size_t c = 0; c < 3; c++) {
+        quantized[s][c] = QuantizeChannel(averages[s][c], 31);
+        bases[s][c] = ExpandChannel5(quantized[s][c]);
+      }
+    }
+    for (size_t c = 0; c < 3; c++) {
+      const auto delta = quantized[1][c] - quantized[0][c];
+      fits = fits && delta >= -4 && delta <= 3;
+    }
+    if (fits) {
+      const auto fit0 = FitSubblock(subblocks[0], bases[0]);
+      const auto fit1 = FitSubblock(subblocks[1], bases[1]);
+      uint64_t bits = 0u;
+      for (size_t c = 0; c < 3; c++) {
+        const auto shift = 59 - c * 8;
+        const auto delta = quantized[1][c] - quantized[0][c];
+        bits |= static_cast<uint64_t>(quantized[0][c]) << shift;
+        bits |= static_cast<uint64_t>(delta & 0x7) << (shift - 3);
+      }
+      bits |= static_cast<uint64_t>(fit0.table) << 37;
+      bits |= static_cast<uint64_t>(fit1.table) << 34;
+      bits |= uint64_t{1u} << 33;
+      bits |= flip_bit << 32;
+      bits |= GetPixelIndexBits(subblocks[0], fit0);
+      bits |= GetPixelIndexBits(subblocks[1], fit1);
+      best = {bits, fit0.error + fit1.error};
+    }
+  }
+
+  // The individual mode can represent any pair of base colors.
+  {
+    std::array<RGB, 2> quantized;
+    std::array<RGB, 2> bases;
+    for (size_t s = 0; s < 2; s++) {
+      for (size_t c = 0; c < 3; c++) {
+        quantized[s][c] = QuantizeChannel(averages[s][c], 15);
+        bases[s][c] = ExpandChannel4(quantized[s][c]);
+      }
+    }
+    const auto fit0 = FitSubblock(subblocks[0], bases[0]);
+    const auto fit1 = FitSubblock(subblocks[1], bases[1]);
+    if (fit0.error + fit1.error < best.error) {
+      uint64_t bits = 0u;
+      for (size_t c = 0; c < 3; c++) {
+        const auto shift = 60 - c * 8;
+        bits |= static_cast<uint64_t>(quantized[0][c]) << shift;
+        bits |= static_cast<uint64_t>(quantized[1][c]) << (shift - 4);
+      }
+      bits |= static_cast<uint64_t>(fit0.table) << 37;
+      bits |= static_cast<uint64_t>(fit1.table) << 34;
+      bits |= flip_bit << 32;
+      bits |= GetPixelIndexBits(subblocks[0], fit0);
+      bits |= GetPixelIndexBits(subblocks[1], fit1);
+      best = {bits, fit0.error + fit1.error};
+    }
+  }
+
+  return best;
+}
+
+uint64_t EncodeBlock(const std::array<std::array<RGB, 4>, 4>& block) {
+  BlockFit best;
+  for (const bool flip : {false, true}) {
+    // Without a flip the subblocks are the left and right 2x4 halves of the
+    // block, and with it the top and bottom 4x2 halves.
+    std::array<Subblock, 2> subblocks;
+    std::array<size_t, 2> counts = {0u, 0u};
+    for (int x = 0; x < 4; x++) {
+      for (int y = 0; y < 4; y++) {
+        const auto s = flip ? y / 2 : x / 2;
+        const auto i = counts[s]++;
+        subblocks[s].pixels[i] = block[y][x];
+        subblocks[s].x[i] = x;
+        subblocks[s].y[i] = y;
+      }
+    }
+    const auto fit = FitBlock(subblocks, flip);
+    if (fit.error < best.error) {
+      best = fit;
+    }
+  }
+  return best.bits;
+}
+
+}  // namespace
+
+// static
+size_t ETC2Encoder::GetEncodedSize(ISize size) {
+  if (size.IsEmpty()) {
+    return 0u;
+  }
+  return GetBlockCount(size.width) * GetBlockCount(size.height) *
+         kBytesPerBlock;
+}
+
+// static
+size_t ETC2Encoder::GetBlockRowCount(ISize size) {
+  if (size.IsEmpty()) {
+    return 0u;
+  }
+  return GetBlockCount(size.height);
+}
+
+// static
+void ETC2Encoder::EncodeBlockRows(const uint8_t* pixels,
+                                  size_t row_bytes,
+                                  ISize size,
+                                  size_t first_block_row,
+                                  size_t block_row_count,
+                                  uint8_t* blocks) {
+  const auto block_columns = GetBlockCount(size.width);
+  const auto last_block_row =
+      std::min(first_block_row + block_row_count, GetBlockRowCount(size));
+  for (size_t block_row = first_block_row; block_row < last_block_row;
+       block_row++) {
+    for (size_t block_column = 0; block_column < block_columns;
+         block_column++) {
+      std::array<std::array<RGB, 4>, 4> block;
+      for (int y = 0; y < 4; y++) {
+        const auto pixel_y =
+            std::min<int64_t>(block_row * 4 + y, size.height - 1);
+        const auto* row = pixels + pixel_y * row_bytes;
+        for (int x = 0; x < 4; x++) {
+          const auto pixel_x =
+              std::min<int64_t>(block_column * 4 + x, size.width - 1);
+          const auto* pixel = row + pixel_x * 4;
+          block[y][x] = {pixel[0], pixel[1], pixel[2]};
+        }
+      }
+      const auto bits = EncodeBlock(block);
+      auto* out =
+          blocks + (block_row * block_columns + block_column) * kBytesPerBlock;
+      for (size_t i = 0; i < kBytesPerBlock; i++) {
+        out[i] = static_cast<uint8_t>(bits >> (56 - i * 8));
+      }
+    }
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/size.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Compresses RGBA8888 pixels into the blocks of
+///             `PixelFormat::kETC2R8G8B8UNormInt` textures on the CPU.
+///
+///             Every 4x4 block of pixels is encoded in the individual or the
+///             differential mode that ETC2 inherits from ETC1, whichever fits
+///             the block best. Alpha is ignored, so only opaque images should
+///             be encoded. The pixels of partial blocks at the right and
+///             bottom edges are repeated from the last column and row.
+///
+///             Rows of blocks are encoded independently of each other, so an
+///             image may be encoded in parallel by encoding disjoint ranges
+///             of block rows on different threads.
+///
+class ETC2Encoder {
+ public:
+  /// The number of bytes a block of 4x4 pixels is encoded in.
+  static constexpr size_t kBytesPerBlock = 8u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of bytes the blocks of an image of the given size
+  ///             take up.
+  ///
+  static size_t GetEncodedSize(ISize size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of rows of blocks an image of the given size is
+  ///             encoded in.
+  ///
+  static size_t GetBlockRowCount(ISize size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encodes a range of rows of blocks of an image.
+  ///
+  /// @param[in]  pixels           The RGBA8888 pixels of the whole image.
+  /// @param[in]  row_bytes        The number of bytes between the starts of
+  ///                              two rows of `pixels`.
+  /// @param[in]  size             The size of the image in pixels.
+  /// @param[in]  first_block_row  The first row of blocks to encode.
+  /// @param[in]  block_row_count  The number of rows of blocks to encode.
+  /// @param[out] blocks           The blocks of the whole image, of
+  ///                              `GetEncodedSize(size)` bytes. Only the
+  ///                              blocks of the encoded rows are written.
+  ///
+  static void EncodeBlockRows(const uint8_t* pixels,
+                              size_t row_bytes,
+                              ISize size,
+                              size_t first_block_row,
+                              size_t block_row_count,
+                              uint8_t* blocks);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(ETC2Encoder);
+};
+
+}  // namespace impeller
@@ -0,0 +1,159 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/image/etc2_encoder.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+using Pixels = std::vector<uint8_t>;
+
+constexpr int kModifierTables[8][2] = {
+    {2, 8},   {5, 17},  {9, 29},   {13, 42},
+    {18, 60}, {24, 80}, {33, 106}, {47, 183},
+};
+
+// Decodes an ETC1 compatible block, as specified by the Khronos Data Format
+// Specification.
+std::array<std::array<std::array<int, 3>, 4>, 4> DecodeBlock(
+    const uint8_t* block) {
+  uint64_t bits = 0u;
+  for (size_t i = 0; i < 8; i++) {
+    bits = (bits << 8) | block[i];
+  }
+  const bool differential = (bits >> 33) & 1u;
+  const bool flip = (bits >> 32) & 1u;
+  std::array<std::array<int, 3>, 2> bases;
+  for (size_t c = 0; c < 3; c++) {
+    if (differential) {
+      const int base = (bits >> (59 - c * 8)) & 0x1f;
+      int delta = (bits >> (56 - c * 8)) & 0x7;
+      delta = delta >= 4 ? delta - 8 : delta;
+      bases[0][c] = (base << 3) | (base >> 2);
+      bases[1][c] = ((base + delta) << 3) | ((base + delta) >> 2);
+    } else {
+      const int base0 = (bits >> (60 - c * 8)) & 0xf;
+      const int base1 = (bits >> (56 - c * 8)) & 0xf;
+      bases[0][c] = (base0 << 4) | base0;
+      bases[1][c] = (base1 << 4) | base1;
+    }
+  }
+  const std::array<int, 2> tables = {static_cast<int>((bits >> 37) & 0x7),
+                                     static_cast<int>((bits >> 34) & 0x7)};
+  std::array<std::array<std::array<int, 3>, 4>, 4> pixels;
+  for (int x = 0; x < 4; x++) {
+    for (int y = 0; y < 4; y++) {
+      const auto index = x * 4 + y;
+      const auto code = (((bits >> (index + 16)) & 1u) << 1) |  //
+                        ((bits >> index) & 1u);
+      const auto subblock = flip ? y / 2 : x / 2;
+      const auto* table = kModifierTables[tables[subblock]];
+      const int modifiers[4] = {table[0], table[1], -table[0], -table[1]};
+      for (size_t c = 0; c < 3; c++) {
+        pixels[y][x][c] =
+            std::clamp(bases[subblock][c] + modifiers[code], 0, 255);
+      }
+    }
+  }
+  return pixels;
+}
+
+Pixels Encode(const Pixels& pixels, ISize size) {
+  Pixels blocks(ETC2Encoder::GetEncodedSize(size));
+  ETC2Encoder::EncodeBlockRows(pixels.data(), size.width * 4, size, 0,
+                               ETC2Encoder::GetBlockRowCount(size),
+                               blocks.data());
+  return blocks;
+}
+
+// Returns the largest difference of a channel of a pixel of the image from
+// the pixel decoded from the blocks.
+int GetMaxError(const Pixels& pixels, ISize size, const Pixels& blocks) {
+  const auto block_columns = (size.width + 3) / 4;
+  int max_error = 0;
+  for (int64_t y = 0; y < size.height; y++) {
+    for (int64_t x = 0; x < size.width; x++) {
+      const auto decoded =
+          DecodeBlock(blocks.data() + ((y / 4) * block_columns + x / 4) *
+                                          ETC2Encoder::kBytesPerBlock);
+      for (size_t c = 0; c < 3; c++) {
+        const int expected = pixels[(y * size.width + x) * 4 + c];
+        max_error =
+            std::max(max_error, std::abs(decoded[y % 4][x % 4][c] - expected));
+      }
+    }
+  }
+  return max_error;
+}
+
+Pixels MakeGradient(ISize size) {
+  Pixels pixels(size.Area() * 4);
+  for (int64_t y = 0; y < size.height; y++) {
+    for (int64_t x = 0; x < size.width; x++) {
+      auto* pixel = pixels.data() + (y * size.width + x) * 4;
+      pixel[0] = static_cast<uint8_t>(x * 255 / (size.width - 1));
+      pixel[1] = static_cast<uint8_t>(y * 255 / (size.height - 1));
+      pixel[2] = 128;
+      pixel[3] = 255;
+    }
+  }
+  return pixels;
+}
+
+}  // namespace
+
+TEST(ETC2EncoderTest, EncodedSizeIsPaddedToWholeBlocks) {
+  ASSERT_EQ(ETC2Encoder::GetEncodedSize(ISize(4, 4)), 8u);
+  ASSERT_EQ(ETC2Encoder::GetEncodedSize(ISize(5, 3)), 16u);
+  ASSERT_EQ(ETC2Encoder::GetEncodedSize(ISize(0, 3)), 0u);
+  ASSERT_EQ(ETC2Encoder::GetBlockRowCount(ISize(5, 9)), 3u);
+}
+
+TEST(ETC2EncoderTest, EncodesSolidColorsClosely) {
+  const ISize size(8, 8);
+  for (const auto& color : std::vector<std::array<uint8_t, 3>>{
+           {0, 0, 0}, {255, 255, 255}, {200, 30, 90}, {17, 128, 240}}) {
+    Pixels pixels(size.Area() * 4);
+    for (int64_t i = 0; i < size.Area(); i++) {
+      std::copy(color.begin(), color.end(), pixels.begin() + i * 4);
+      pixels[i * 4 + 3] = 255;
+    }
+    ASSERT_LE(GetMaxError(pixels, size, Encode(pixels, size)), 6);
+  }
+}
+
+TEST(ETC2EncoderTest, EncodesGradientsClosely) {
+  const ISize size(64, 48);
+  const auto pixels = MakeGradient(size);
+  ASSERT_LE(GetMaxError(pixels, size, Encode(pixels, size)), 24);
+}
+
+TEST(ETC2EncoderTest, RepeatsEdgePixelsInPartialBlocks) {
+  const ISize size(30, 18);
+  const auto pixels = MakeGradient(size);
+  ASSERT_LE(GetMaxError(pixels, size, Encode(pixels, size)), 24);
+}
+
+TEST(ETC2EncoderTest, EncodesBlockRowsIndependently) {
+  const ISize size(32, 30);
+  const auto pixels = MakeGradient(size);
+  const auto expected = Encode(pixels, size);
+  Pixels blocks(ETC2Encoder::GetEncodedSize(size));
+  for (size_t row = 0; row < ETC2Encoder::GetBlockRowCount(size); row += 3) {
+    ETC2Encoder::EncodeBlockRows(pixels.data(), size.width * 4, size, row, 3,
+                                 blocks.data());
+  }
+  ASSERT_EQ(blocks, expected);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -14,6 +14,7 @@
 #include <QuartzCore/QuartzCore.h>
 
 #include "flutter/fml/mapping.h"
+#include "impeller/entity/mtl/compute_filter_shaders.h"
 #include "impeller/entity/mtl/entity_shaders.h"
 #include "impeller/entity/mtl/framebuffer_blend_shaders.h"
 #include "impeller/entity/mtl/modern_shaders.h"
@@ -48,7 +49,10 @@ ShaderLibraryMappingsForPlayground() {
           std::make_shared<fml::NonOwnedMapping>(impeller_scene_shaders_data,
                                                  impeller_scene_shaders_length),
           std::make_shared<fml::NonOwnedMapping>(
-              impeller_compute_shaders_data, impeller_compute_shaders_length)
+              impeller_compute_shaders_data, impeller_compute_shaders_length),
+          std::make_shared<fml::NonOwnedMapping>(
+              impeller_compute_filter_shaders_data,
+              impeller_compute_filter_shaders_length)
 
   };
 }
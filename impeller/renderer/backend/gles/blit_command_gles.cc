@@ -102,16 +102,17 @@ bool BlitCopyTextureToTextureCommandGLES::Encode(
   gl.Disable(GL_DEPTH_TEST);
   gl.Disable(GL_STENCIL_TEST);
 
-  gl.BlitFramebuffer(source_region.origin.x,     // srcX0
-                     source_region.origin.y,     // srcY0
-                     source_region.size.width,   // srcX1
-                     source_region.size.height,  // srcY1
-                     destination_origin.x,       // dstX0
-                     destination_origin.y,       // dstY0
-                     source_region.size.width,   // dstX1
-                     source_region.size.height,  // dstY1
-                     GL_COLOR_BUFFER_BIT,        // mask
-                     GL_NEAREST                  // filter
+  gl.BlitFramebuffer(
+      source_region.origin.x,                              // srcX0
+      source_region.origin.y,                              // srcY0
+      source_region.origin.x + source_region.size.width,   // srcX1
+      source_region.origin.y + source_region.size.height,  // srcY1
+      destination_origin.x,                                // dstX0
+      destination_origin.y,                                // dstY0
+      destination_origin.x + source_region.size.width,     // dstX1
+      destination_origin.y + source_region.size.height,    // dstY1
+      GL_COLOR_BUFFER_BIT,                                 // mask
+      GL_NEAREST                                           // filter
   );
 
   return true;
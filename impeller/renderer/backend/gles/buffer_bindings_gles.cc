@@ -174,6 +174,18 @@ bool BufferBindingsGLES::BindUniformData(
   return true;
 }
 
+bool BufferBindingsGLES::UniformValueChanged(GLint location,
+                                             const void* data,
+                                             size_t length) const {
+  auto& value = uniform_values_[location];
+  if (value.size() == length && std::memcmp(value.data(), data, length) == 0) {
+    return false;
+  }
+  value.assign(static_cast<const uint8_t*>(data),
+               static_cast<const uint8_t*>(data) + length);
+  return true;
+}
+
 bool BufferBindingsGLES::UnbindVertexAttributes(const ProcTableGLES& gl) const {
   for (const auto& array : vertex_attrib_arrays_) {
     gl.DisableVertexAttribArray(array.index);
@@ -248,6 +260,11 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
           reinterpret_cast<const GLfloat*>(array_element_buffer.data());
     }
 
+    if (!UniformValueChanged(location->second, buffer_data,
+                             member.size * element_count)) {
+      continue;
+    }
+
     switch (member.type) {
       case ShaderType::kFloat:
         switch (member.size) {
@@ -303,6 +320,7 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
       case ShaderType::kSampler:
         VALIDATION_LOG << "Could not bind uniform buffer data for key: "
                        << member_key;
+        uniform_values_.erase(location->second);
         return false;
     }
   }
@@ -360,7 +378,11 @@ bool BufferBindingsGLES::BindTextures(const ProcTableGLES& gl,
     //--------------------------------------------------------------------------
     /// Set the texture uniform location.
     ///
-    gl.Uniform1i(uniform->second, active_index);
+    const GLint texture_unit = active_index;
+    if (UniformValueChanged(uniform->second, &texture_unit,
+                            sizeof(texture_unit))) {
+      gl.Uniform1i(uniform->second, texture_unit);
+    }
 
     //--------------------------------------------------------------------------
     /// Bump up the active index at binding.
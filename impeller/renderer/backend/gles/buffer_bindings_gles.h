@@ -5,6 +5,7 @@
 #pragma once
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -54,6 +55,14 @@ class BufferBindingsGLES {
   };
   std::vector<VertexAttribPointer> vertex_attrib_arrays_;
   std::map<std::string, GLint> uniform_locations_;
+  // The values last uploaded to each uniform location of the program. The
+  // program keeps its uniform values between draws, so uploading the same
+  // value again is a redundant driver call.
+  mutable std::unordered_map<GLint, std::vector<uint8_t>> uniform_values_;
+
+  bool UniformValueChanged(GLint location,
+                           const void* data,
+                           size_t length) const;
 
   bool BindUniformBuffer(const ProcTableGLES& gl,
                          Allocator& transients_allocator,
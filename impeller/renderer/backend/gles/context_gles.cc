@@ -11,14 +11,16 @@ namespace impeller {
 
 std::shared_ptr<ContextGLES> ContextGLES::Create(
     std::unique_ptr<ProcTableGLES> gl,
-    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries) {
-  return std::shared_ptr<ContextGLES>(
-      new ContextGLES(std::move(gl), shader_libraries));
+    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+    fml::UniqueFD cache_directory) {
+  return std::shared_ptr<ContextGLES>(new ContextGLES(
+      std::move(gl), shader_libraries, std::move(cache_directory)));
 }
 
-ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
-                         const std::vector<std::shared_ptr<fml::Mapping>>&
-                             shader_libraries_mappings) {
+ContextGLES::ContextGLES(
+    std::unique_ptr<ProcTableGLES> gl,
+    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_mappings,
+    fml::UniqueFD cache_directory) {
   reactor_ = std::make_shared<ReactorGLES>(std::move(gl));
   if (!reactor_->IsValid()) {
     VALIDATION_LOG << "Could not create valid reactor.";
@@ -38,8 +40,13 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
 
   // Create the pipeline library.
   {
-    pipeline_library_ =
-        std::shared_ptr<PipelineLibraryGLES>(new PipelineLibraryGLES(reactor_));
+    std::shared_ptr<ProgramBinaryCacheGLES> program_binary_cache;
+    if (cache_directory.is_valid()) {
+      program_binary_cache = std::make_shared<ProgramBinaryCacheGLES>(
+          std::move(cache_directory));
+    }
+    pipeline_library_ = std::shared_ptr<PipelineLibraryGLES>(
+        new PipelineLibraryGLES(reactor_, std::move(program_binary_cache)));
   }
 
   // Create allocators.
@@ -60,6 +67,12 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
 
   // Create the device capabilities.
   {
+    // Advanced blends read the destination through the framebuffer fetch
+    // extension. The shaders are only remapped for it on OpenGL ES.
+    const auto* description = reactor_->GetProcTable().GetDescription();
+    const bool supports_framebuffer_fetch =
+        description->IsES() &&
+        description->HasExtension("GL_EXT_shader_framebuffer_fetch");
     device_capabilities_ =
         CapabilitiesBuilder()
             .SetHasThreadingRestrictions(true)
@@ -67,15 +80,22 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
             .SetSupportsSSBO(false)
             .SetSupportsTextureToTextureBlits(
                 reactor_->GetProcTable().BlitFramebuffer.IsAvailable())
-            .SetSupportsFramebufferFetch(false)
+            .SetSupportsBufferToTextureBlits(false)
+            .SetSupportsFramebufferFetch(supports_framebuffer_fetch)
             .SetDefaultColorFormat(PixelFormat::kB8G8R8A8UNormInt)
             .SetDefaultStencilFormat(PixelFormat::kS8UInt)
             .SetSupportsCompute(false, false)
             .SetSupportsReadFromResolve(false)
             .SetSupportsReadFromOnscreenTexture(false)
+            .SetSupportsTextureCompressionETC2(false)
             .Build();
   }
 
+  if (TimerQueriesGLES::IsSupported(reactor_->GetProcTable())) {
+    timer_queries_ =
+        std::make_shared<TimerQueriesGLES>(std::make_shared<GPUTracer>());
+  }
+
   is_valid_ = true;
 }
 
@@ -100,6 +120,14 @@ bool ContextGLES::RemoveReactorWorker(ReactorGLES::WorkerID id) {
   return reactor_->RemoveWorker(id);
 }
 
+const std::shared_ptr<TimerQueriesGLES>& ContextGLES::GetTimerQueries() const {
+  return timer_queries_;
+}
+
+Context::BackendType ContextGLES::GetBackendType() const {
+  return Context::BackendType::kOpenGLES;
+}
+
 bool ContextGLES::IsValid() const {
   return is_valid_;
 }
@@ -136,4 +164,9 @@ const std::shared_ptr<const Capabilities>& ContextGLES::GetCapabilities()
   return device_capabilities_;
 }
 
+// |Context|
+std::shared_ptr<GPUTracer> ContextGLES::GetGPUTracer() const {
+  return timer_queries_ ? timer_queries_->GetTracer() : nullptr;
+}
+
 }  // namespace impeller
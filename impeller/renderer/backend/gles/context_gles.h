@@ -5,6 +5,7 @@
 #pragma once
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/renderer/backend/gles/allocator_gles.h"
 #include "impeller/renderer/backend/gles/command_buffer_gles.h"
@@ -12,6 +13,7 @@
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/backend/gles/sampler_library_gles.h"
 #include "impeller/renderer/backend/gles/shader_library_gles.h"
+#include "impeller/renderer/backend/gles/timer_queries_gles.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/context.h"
 
@@ -20,9 +22,15 @@ namespace impeller {
 class ContextGLES final : public Context,
                           public BackendCast<ContextGLES, Context> {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a context. When a cache directory is given, the
+  ///             binaries of linked programs are persisted to it and loaded
+  ///             by later launches instead of compiling the shaders again.
+  ///
   static std::shared_ptr<ContextGLES> Create(
       std::unique_ptr<ProcTableGLES> gl,
-      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries);
+      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+      fml::UniqueFD cache_directory = {});
 
   // |Context|
   ~ContextGLES() override;
@@ -34,6 +42,12 @@ class ContextGLES final : public Context,
 
   bool RemoveReactorWorker(ReactorGLES::WorkerID id);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The timer queries that measure render passes, or `nullptr` if
+  ///             the driver doesn't support `GL_EXT_disjoint_timer_query`.
+  ///
+  const std::shared_ptr<TimerQueriesGLES>& GetTimerQueries() const;
+
  private:
   ReactorGLES::Ref reactor_;
   std::shared_ptr<ShaderLibraryGLES> shader_library_;
@@ -41,11 +55,16 @@ class ContextGLES final : public Context,
   std::shared_ptr<SamplerLibraryGLES> sampler_library_;
   std::shared_ptr<AllocatorGLES> resource_allocator_;
   std::shared_ptr<const Capabilities> device_capabilities_;
+  std::shared_ptr<TimerQueriesGLES> timer_queries_;
   bool is_valid_ = false;
 
   ContextGLES(
       std::unique_ptr<ProcTableGLES> gl,
-      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries);
+      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+      fml::UniqueFD cache_directory);
+
+  // |Context|
+  BackendType GetBackendType() const override;
 
   // |Context|
   bool IsValid() const override;
@@ -68,6 +87,9 @@ class ContextGLES final : public Context,
   // |Context|
   const std::shared_ptr<const Capabilities>& GetCapabilities() const override;
 
+  // |Context|
+  std::shared_ptr<GPUTracer> GetGPUTracer() const override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ContextGLES);
 };
 
@@ -102,6 +102,18 @@ bool DescriptionGLES::IsValid() const {
   return is_valid_;
 }
 
+const Version& DescriptionGLES::GetGlVersion() const {
+  return gl_version_;
+}
+
+const std::string& DescriptionGLES::GetRendererString() const {
+  return renderer_;
+}
+
+const std::string& DescriptionGLES::GetGLVersionString() const {
+  return gl_version_string_;
+}
+
 std::string DescriptionGLES::GetString() const {
   if (!IsValid()) {
     return "Unknown Renderer.";
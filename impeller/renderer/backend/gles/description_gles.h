@@ -26,6 +26,12 @@ class DescriptionGLES {
 
   std::string GetString() const;
 
+  const Version& GetGlVersion() const;
+
+  const std::string& GetRendererString() const;
+
+  const std::string& GetGLVersionString() const;
+
   bool HasExtension(const std::string& ext) const;
 
   bool HasDebugExtension() const;
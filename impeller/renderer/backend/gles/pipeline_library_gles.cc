@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/gles/pipeline_library_gles.h"
 
+#include <optional>
 #include <sstream>
 #include <string>
 
@@ -15,8 +16,11 @@
 
 namespace impeller {
 
-PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor)
-    : reactor_(std::move(reactor)) {}
+PipelineLibraryGLES::PipelineLibraryGLES(
+    ReactorGLES::Ref reactor,
+    std::shared_ptr<ProgramBinaryCacheGLES> program_binary_cache)
+    : reactor_(std::move(reactor)),
+      program_binary_cache_(std::move(program_binary_cache)) {}
 
 static std::string GetShaderInfoLog(const ProcTableGLES& gl, GLuint shader) {
   GLint log_length = 0;
@@ -73,7 +77,8 @@ static bool LinkProgram(
     const ReactorGLES& reactor,
     const std::shared_ptr<PipelineGLES>& pipeline,
     const std::shared_ptr<const ShaderFunction>& vert_function,
-    const std::shared_ptr<const ShaderFunction>& frag_function) {
+    const std::shared_ptr<const ShaderFunction>& frag_function,
+    const ProgramBinaryCacheGLES* program_binary_cache) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   const auto& descriptor = pipeline->GetDescriptor();
@@ -85,6 +90,31 @@ static bool LinkProgram(
 
   const auto& gl = reactor.GetProcTable();
 
+  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
+  if (!program.has_value()) {
+    VALIDATION_LOG << "Could not get program handle from reactor.";
+    return false;
+  }
+
+  ProgramBinaryCacheGLES::AttributeBindings attribute_bindings;
+  for (const auto& stage_input :
+       descriptor.GetVertexDescriptor()->GetStageInputs()) {
+    attribute_bindings.emplace_back(static_cast<GLuint>(stage_input.location),
+                                    stage_input.name);
+  }
+
+  // Skip compiling and linking altogether if a previous launch left the
+  // binary of the program in the cache.
+  std::optional<std::string> program_binary_key;
+  if (program_binary_cache && ProgramBinaryCacheGLES::IsSupported(gl)) {
+    program_binary_key = ProgramBinaryCacheGLES::MakeKey(
+        gl, *vert_mapping, *frag_mapping, attribute_bindings);
+    if (program_binary_cache->LoadProgram(gl, *program,
+                                          program_binary_key.value())) {
+      return true;
+    }
+  }
+
   auto vert_shader = gl.CreateShader(GL_VERTEX_SHADER);
   auto frag_shader = gl.CreateShader(GL_FRAGMENT_SHADER);
 
@@ -128,12 +158,6 @@ static bool LinkProgram(
     return false;
   }
 
-  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
-  if (!program.has_value()) {
-    VALIDATION_LOG << "Could not get program handle from reactor.";
-    return false;
-  }
-
   gl.AttachShader(*program, vert_shader);
   gl.AttachShader(*program, frag_shader);
 
@@ -146,12 +170,12 @@ static bool LinkProgram(
         gl.DetachShader(program, frag_shader);
       });
 
-  for (const auto& stage_input :
-       descriptor.GetVertexDescriptor()->GetStageInputs()) {
-    gl.BindAttribLocation(*program,                                   //
-                          static_cast<GLuint>(stage_input.location),  //
-                          stage_input.name                            //
-    );
+  for (const auto& [location, name] : attribute_bindings) {
+    gl.BindAttribLocation(*program, location, name.c_str());
+  }
+
+  if (program_binary_key.has_value()) {
+    program_binary_cache->PrepareProgramForStore(gl, *program);
   }
 
   gl.LinkProgram(*program);
@@ -164,6 +188,11 @@ static bool LinkProgram(
                    << gl.GetProgramInfoLogString(*program);
     return false;
   }
+
+  if (program_binary_key.has_value()) {
+    program_binary_cache->StoreProgram(gl, *program,
+                                       program_binary_key.value());
+  }
   return true;
 }
 
@@ -205,7 +234,8 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
 
   auto result = reactor_->AddOperation(
       [promise, weak_this, reactor_ptr = reactor_, descriptor, vert_function,
-       frag_function](const ReactorGLES& reactor) {
+       frag_function, program_binary_cache = program_binary_cache_](
+          const ReactorGLES& reactor) {
         auto strong_this = weak_this.lock();
         if (!strong_this) {
           promise->set_value(nullptr);
@@ -221,10 +251,11 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
           VALIDATION_LOG << "Could not obtain program handle.";
           return;
         }
-        const auto link_result = LinkProgram(reactor,        //
-                                             pipeline,       //
-                                             vert_function,  //
-                                             frag_function   //
+        const auto link_result = LinkProgram(reactor,                    //
+                                             pipeline,                   //
+                                             vert_function,              //
+                                             frag_function,              //
+                                             program_binary_cache.get()  //
         );
         if (!link_result) {
           promise->set_value(nullptr);
@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <memory>
+
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/pipeline_library.h"
 
@@ -21,9 +24,12 @@ class PipelineLibraryGLES final : public PipelineLibrary {
   friend ContextGLES;
 
   ReactorGLES::Ref reactor_;
+  std::shared_ptr<ProgramBinaryCacheGLES> program_binary_cache_;
   PipelineMap pipelines_;
 
-  PipelineLibraryGLES(ReactorGLES::Ref reactor);
+  PipelineLibraryGLES(
+      ReactorGLES::Ref reactor,
+      std::shared_ptr<ProgramBinaryCacheGLES> program_binary_cache);
 
   // |PipelineLibrary|
   bool IsValid() const override;
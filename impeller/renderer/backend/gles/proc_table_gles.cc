@@ -111,6 +111,37 @@ ProcTableGLES::ProcTableGLES(Resolver resolver) {
     DiscardFramebufferEXT.Reset();
   }
 
+  if (!description_->HasExtension("GL_EXT_disjoint_timer_query")) {
+    GenQueriesEXT.Reset();
+    DeleteQueriesEXT.Reset();
+    BeginQueryEXT.Reset();
+    EndQueryEXT.Reset();
+    GetQueryObjectuivEXT.Reset();
+    GetQueryObjectui64vEXT.Reset();
+  }
+
+  // Sync objects are core in OpenGL ES 3.0 and OpenGL 3.2.
+  auto gl_version = description_->GetGlVersion();
+  if (!gl_version.IsAtLeast(description_->IsES() ? Version(3, 0)
+                                                 : Version(3, 2))) {
+    FenceSync.Reset();
+    WaitSync.Reset();
+    DeleteSync.Reset();
+  }
+
+  // Program binaries are core in OpenGL ES 3.0 and OpenGL 4.1.
+  if (!gl_version.IsAtLeast(description_->IsES() ? Version(3, 0)
+                                                 : Version(4, 1))) {
+    GetProgramBinary.Reset();
+    ProgramBinary.Reset();
+    ProgramParameteri.Reset();
+  }
+
+  if (!description_->HasExtension("GL_OES_get_program_binary")) {
+    GetProgramBinaryOES.Reset();
+    ProgramBinaryOES.Reset();
+  }
+
   capabilities_ = std::make_unique<CapabilitiesGLES>(*this);
 
   is_valid_ = true;
@@ -119,6 +119,7 @@ struct GLProc {
   PROC(DrawElements);                        \
   PROC(Enable);                              \
   PROC(EnableVertexAttribArray);             \
+  PROC(Flush);                               \
   PROC(FramebufferRenderbuffer);             \
   PROC(FramebufferTexture2D);                \
   PROC(FrontFace);                           \
@@ -165,13 +166,28 @@ struct GLProc {
   PROC(Viewport);                            \
   PROC(ReadPixels);
 
-#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) PROC(BlitFramebuffer);
+#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) \
+  PROC(BlitFramebuffer);                   \
+  PROC(DeleteSync);                        \
+  PROC(FenceSync);                         \
+  PROC(GetProgramBinary);                  \
+  PROC(ProgramBinary);                     \
+  PROC(ProgramParameteri);                 \
+  PROC(WaitSync);
 
 #define FOR_EACH_IMPELLER_EXT_PROC(PROC) \
   PROC(DiscardFramebufferEXT);           \
   PROC(PushDebugGroupKHR);               \
   PROC(PopDebugGroupKHR);                \
-  PROC(ObjectLabelKHR);
+  PROC(ObjectLabelKHR);                  \
+  PROC(GenQueriesEXT);                   \
+  PROC(DeleteQueriesEXT);                \
+  PROC(BeginQueryEXT);                   \
+  PROC(EndQueryEXT);                     \
+  PROC(GetQueryObjectuivEXT);            \
+  PROC(GetQueryObjectui64vEXT);          \
+  PROC(GetProgramBinaryOES);             \
+  PROC(ProgramBinaryOES);
 
 enum class DebugResourceType {
   kTexture,
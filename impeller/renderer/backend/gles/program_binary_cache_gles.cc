@@ -0,0 +1,187 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+static constexpr const char* kProgramBinaryFilePrefix =
+    "flutter.impeller.glprogram.";
+
+/// The header written in front of the program binary returned by the driver.
+struct ProgramBinaryHeaderGLES {
+  static constexpr uint32_t kMagic = 0x47504248;  // 'GPBH'
+  static constexpr uint32_t kVersion = 1u;
+
+  uint32_t magic = kMagic;
+  uint32_t version = kVersion;
+  uint32_t binary_format = 0u;
+  uint32_t reserved = 0u;
+  uint64_t binary_size = 0u;
+};
+
+/// FNV-1a, which unlike |std::hash| is guaranteed to be stable across
+/// launches and toolchains.
+static void HashBytes(uint64_t& hash, const void* data, size_t size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  // Separate the pieces so that moving bytes between them changes the hash.
+  const uint8_t separator = 0xFF;
+  hash ^= separator;
+  hash *= 1099511628211ull;
+}
+
+static void HashString(uint64_t& hash, const std::string& string) {
+  HashBytes(hash, string.data(), string.size());
+}
+
+static std::string GetFileName(const std::string& key) {
+  return kProgramBinaryFilePrefix + key;
+}
+
+ProgramBinaryCacheGLES::ProgramBinaryCacheGLES(fml::UniqueFD cache_directory)
+    : cache_directory_(std::move(cache_directory)) {}
+
+ProgramBinaryCacheGLES::~ProgramBinaryCacheGLES() = default;
+
+bool ProgramBinaryCacheGLES::IsSupported(const ProcTableGLES& gl) {
+  const bool has_procs =
+      (gl.GetProgramBinary.IsAvailable() && gl.ProgramBinary.IsAvailable()) ||
+      (gl.GetProgramBinaryOES.IsAvailable() &&
+       gl.ProgramBinaryOES.IsAvailable());
+  if (!has_procs) {
+    return false;
+  }
+  // Some drivers expose the entry points without supporting any format.
+  GLint format_count = 0;
+  gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+  return format_count > 0;
+}
+
+std::string ProgramBinaryCacheGLES::MakeKey(
+    const ProcTableGLES& gl,
+    const fml::Mapping& vert_source,
+    const fml::Mapping& frag_source,
+    const AttributeBindings& attribute_bindings) {
+  uint64_t hash = 14695981039346656037ull;
+  HashBytes(hash, vert_source.GetMapping(), vert_source.GetSize());
+  HashBytes(hash, frag_source.GetMapping(), frag_source.GetSize());
+  for (const auto& [location, name] : attribute_bindings) {
+    HashBytes(hash, &location, sizeof(location));
+    HashString(hash, name);
+  }
+  HashString(hash, gl.GetDescription()->GetRendererString());
+  HashString(hash, gl.GetDescription()->GetGLVersionString());
+
+  std::stringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return stream.str();
+}
+
+bool ProgramBinaryCacheGLES::LoadProgram(const ProcTableGLES& gl,
+                                         GLuint program,
+                                         const std::string& key) const {
+  if (!cache_directory_.is_valid()) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "ProgramBinaryCacheGLES::LoadProgram");
+  const auto file_name = GetFileName(key);
+  auto mapping = fml::FileMapping::CreateReadOnly(cache_directory_, file_name);
+  if (!mapping || mapping->GetMapping() == nullptr ||
+      mapping->GetSize() < sizeof(ProgramBinaryHeaderGLES)) {
+    return false;
+  }
+
+  ProgramBinaryHeaderGLES header;
+  std::memcpy(&header, mapping->GetMapping(), sizeof(header));
+  const auto binary_size = mapping->GetSize() - sizeof(header);
+  if (header.magic != ProgramBinaryHeaderGLES::kMagic ||
+      header.version != ProgramBinaryHeaderGLES::kVersion ||
+      header.binary_size != binary_size) {
+    fml::UnlinkFile(cache_directory_, file_name.c_str());
+    return false;
+  }
+
+  const auto* binary = mapping->GetMapping() + sizeof(header);
+  if (gl.ProgramBinary.IsAvailable()) {
+    gl.ProgramBinary(program, header.binary_format, binary, binary_size);
+  } else {
+    gl.ProgramBinaryOES(program, header.binary_format, binary, binary_size);
+  }
+
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(program, GL_LINK_STATUS, &link_status);
+  if (link_status != GL_TRUE) {
+    // The driver is free to reject binaries at any time, for instance after
+    // an update that didn't change the version string.
+    FML_LOG(INFO) << "Discarding a program binary rejected by the driver.";
+    fml::UnlinkFile(cache_directory_, file_name.c_str());
+    return false;
+  }
+  return true;
+}
+
+void ProgramBinaryCacheGLES::PrepareProgramForStore(const ProcTableGLES& gl,
+                                                    GLuint program) const {
+  if (!cache_directory_.is_valid() || !gl.ProgramParameteri.IsAvailable()) {
+    return;
+  }
+  gl.ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+bool ProgramBinaryCacheGLES::StoreProgram(const ProcTableGLES& gl,
+                                          GLuint program,
+                                          const std::string& key) const {
+  if (!cache_directory_.is_valid()) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "ProgramBinaryCacheGLES::StoreProgram");
+  GLint binary_length = 0;
+  gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_length);
+  if (binary_length <= 0) {
+    return false;
+  }
+
+  std::vector<uint8_t> data(sizeof(ProgramBinaryHeaderGLES) + binary_length);
+  auto* binary = data.data() + sizeof(ProgramBinaryHeaderGLES);
+  GLsizei written_length = 0;
+  GLenum binary_format = 0;
+  if (gl.GetProgramBinary.IsAvailable()) {
+    gl.GetProgramBinary(program, binary_length, &written_length,
+                        &binary_format, binary);
+  } else {
+    gl.GetProgramBinaryOES(program, binary_length, &written_length,
+                           &binary_format, binary);
+  }
+  if (written_length <= 0 || written_length > binary_length) {
+    return false;
+  }
+  data.resize(sizeof(ProgramBinaryHeaderGLES) + written_length);
+
+  ProgramBinaryHeaderGLES header;
+  header.binary_format = binary_format;
+  header.binary_size = written_length;
+  std::memcpy(data.data(), &header, sizeof(header));
+
+  fml::DataMapping mapping(std::move(data));
+  if (!fml::WriteAtomically(cache_directory_, GetFileName(key).c_str(),
+                            mapping)) {
+    FML_LOG(ERROR) << "Could not write the program binary to the cache.";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace impeller
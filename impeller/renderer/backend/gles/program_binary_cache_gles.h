@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Persists the binaries of linked programs to the cache directory
+///             so that later launches can load them with `glProgramBinary`
+///             instead of compiling and linking the shaders from source.
+///
+///             Programs are keyed by the hash of their shader sources and
+///             attribute bindings along with the `GL_RENDERER` and
+///             `GL_VERSION` strings, so a driver update doesn't even attempt
+///             to load the binaries of the old driver. A binary the driver
+///             still rejects is deleted and the program is linked from source
+///             again.
+///
+///             Program binaries are used from OpenGL ES 3.0 and OpenGL 4.1,
+///             or with `GL_OES_get_program_binary`.
+///
+///             All of the methods that take a proc table must be called on a
+///             thread with the GL context current, which is why they are
+///             called from reactor operations.
+///
+class ProgramBinaryCacheGLES {
+ public:
+  using AttributeBindings = std::vector<std::pair<GLuint, std::string>>;
+
+  explicit ProgramBinaryCacheGLES(fml::UniqueFD cache_directory);
+
+  ~ProgramBinaryCacheGLES();
+
+  static bool IsSupported(const ProcTableGLES& gl);
+
+  static std::string MakeKey(const ProcTableGLES& gl,
+                             const fml::Mapping& vert_source,
+                             const fml::Mapping& frag_source,
+                             const AttributeBindings& attribute_bindings);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Loads the cached binary for the key into the program.
+  ///
+  /// @return     If the program was loaded and linked. Otherwise, the program
+  ///             must be linked from source.
+  ///
+  bool LoadProgram(const ProcTableGLES& gl,
+                   GLuint program,
+                   const std::string& key) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Asks the driver to keep the binary of the program around
+  ///             once it is linked. Must be called before linking.
+  ///
+  void PrepareProgramForStore(const ProcTableGLES& gl, GLuint program) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the binary of the linked program to the cache.
+  ///
+  bool StoreProgram(const ProcTableGLES& gl,
+                    GLuint program,
+                    const std::string& key) const;
+
+ private:
+  const fml::UniqueFD cache_directory_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ProgramBinaryCacheGLES);
+};
+
+}  // namespace impeller
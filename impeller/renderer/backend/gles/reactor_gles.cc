@@ -40,8 +40,7 @@ bool ReactorGLES::RemoveWorker(WorkerID worker) {
 }
 
 bool ReactorGLES::HasPendingOperations() const {
-  Lock ops_lock(ops_mutex_);
-  return !ops_.empty();
+  return pending_ops_count_.load() > 0u;
 }
 
 const ProcTableGLES& ReactorGLES::GetProcTable() const {
@@ -74,59 +73,105 @@ bool ReactorGLES::AddOperation(Operation operation) {
   {
     Lock ops_lock(ops_mutex_);
     ops_.emplace_back(std::move(operation));
+    pending_ops_count_ = ops_.size();
   }
   // Attempt a reaction if able but it is not an error if this isn't possible.
   [[maybe_unused]] auto result = React();
   return true;
 }
 
-static std::optional<GLuint> CreateGLHandle(const ProcTableGLES& gl,
-                                            HandleType type) {
-  GLuint handle = GL_NONE;
+static bool GenerateGLNames(const ProcTableGLES& gl,
+                            HandleType type,
+                            GLsizei count,
+                            GLuint* names) {
   switch (type) {
     case HandleType::kUnknown:
-      return std::nullopt;
+    case HandleType::kProgram:
+      return false;
     case HandleType::kTexture:
-      gl.GenTextures(1u, &handle);
-      return handle;
+      gl.GenTextures(count, names);
+      return true;
     case HandleType::kBuffer:
-      gl.GenBuffers(1u, &handle);
-      return handle;
-    case HandleType::kProgram:
-      return gl.CreateProgram();
+      gl.GenBuffers(count, names);
+      return true;
     case HandleType::kRenderBuffer:
-      gl.GenRenderbuffers(1u, &handle);
-      return handle;
+      gl.GenRenderbuffers(count, names);
+      return true;
     case HandleType::kFrameBuffer:
-      gl.GenFramebuffers(1u, &handle);
-      return handle;
+      gl.GenFramebuffers(count, names);
+      return true;
   }
-  return std::nullopt;
+  return false;
 }
 
-static bool CollectGLHandle(const ProcTableGLES& gl,
-                            HandleType type,
-                            GLuint handle) {
+static void CollectGLNames(const ProcTableGLES& gl,
+                           HandleType type,
+                           const std::vector<GLuint>& names) {
+  if (names.empty()) {
+    return;
+  }
+  const auto count = static_cast<GLsizei>(names.size());
   switch (type) {
     case HandleType::kUnknown:
-      return false;
+      return;
     case HandleType::kTexture:
-      gl.DeleteTextures(1u, &handle);
-      return true;
+      gl.DeleteTextures(count, names.data());
+      return;
     case HandleType::kBuffer:
-      gl.DeleteBuffers(1u, &handle);
-      return true;
+      gl.DeleteBuffers(count, names.data());
+      return;
     case HandleType::kProgram:
-      gl.DeleteProgram(handle);
-      return true;
+      for (auto name : names) {
+        gl.DeleteProgram(name);
+      }
+      return;
     case HandleType::kRenderBuffer:
-      gl.DeleteRenderbuffers(1u, &handle);
-      return true;
+      gl.DeleteRenderbuffers(count, names.data());
+      return;
     case HandleType::kFrameBuffer:
-      gl.DeleteFramebuffers(1u, &handle);
-      return true;
+      gl.DeleteFramebuffers(count, names.data());
+      return;
   }
-  return false;
+}
+
+void ReactorGLES::ReserveGLNames(HandleType type, size_t count) {
+  auto& pool = name_pools_[static_cast<size_t>(type)];
+  if (pool.size() >= count) {
+    return;
+  }
+  // Generate the names of a whole batch of handles in a single call instead of
+  // one call per handle.
+  const auto old_size = pool.size();
+  const auto new_size = std::max(count, old_size + kNamePoolBatchSize);
+  pool.resize(new_size);
+  if (!GenerateGLNames(GetProcTable(), type,
+                       static_cast<GLsizei>(new_size - old_size),
+                       pool.data() + old_size)) {
+    pool.resize(old_size);
+  }
+}
+
+std::optional<GLuint> ReactorGLES::AcquireGLName(HandleType type) {
+  if (type == HandleType::kUnknown) {
+    return std::nullopt;
+  }
+  if (type == HandleType::kProgram) {
+    // Program names cannot be generated ahead of time.
+    return GetProcTable().CreateProgram();
+  }
+  ReserveGLNames(type, 1u);
+  auto& pool = name_pools_[static_cast<size_t>(type)];
+  if (pool.empty()) {
+    return std::nullopt;
+  }
+  auto name = pool.back();
+  pool.pop_back();
+  return name;
+}
+
+void ReactorGLES::AddPendingHandle(const HandleGLES& handle) {
+  pending_handles_.push_back(handle);
+  has_pending_handles_ = true;
 }
 
 HandleGLES ReactorGLES::CreateHandle(HandleType type) {
@@ -138,10 +183,12 @@ HandleGLES ReactorGLES::CreateHandle(HandleType type) {
     return HandleGLES::DeadHandle();
   }
   WriterLock handles_lock(handles_mutex_);
-  auto gl_handle = CanReactOnCurrentThread()
-                       ? CreateGLHandle(GetProcTable(), type)
-                       : std::nullopt;
+  auto gl_handle =
+      CanReactOnCurrentThread() ? AcquireGLName(type) : std::nullopt;
   handles_[new_handle] = LiveHandle{gl_handle};
+  if (!gl_handle.has_value()) {
+    AddPendingHandle(new_handle);
+  }
   return new_handle;
 }
 
@@ -149,6 +196,7 @@ void ReactorGLES::CollectHandle(HandleGLES handle) {
   WriterLock handles_lock(handles_mutex_);
   if (auto found = handles_.find(handle); found != handles_.end()) {
     found->second.pending_collection = true;
+    AddPendingHandle(handle);
   }
 }
 
@@ -192,24 +240,57 @@ bool ReactorGLES::ReactOnce() {
 }
 
 bool ReactorGLES::ConsolidateHandles() {
+  // Most reactions happen with no handles to create or collect. Don't take the
+  // handles lock for those.
+  if (!has_pending_handles_.load()) {
+    return true;
+  }
   TRACE_EVENT0("impeller", __FUNCTION__);
   const auto& gl = GetProcTable();
   WriterLock handles_lock(handles_mutex_);
-  std::vector<HandleGLES> handles_to_delete;
-  for (auto& handle : handles_) {
+
+  // Size the name pools for all the handles that need a name first so that
+  // the names are generated in one call per handle type.
+  std::array<size_t, std::tuple_size_v<NamePools>> names_needed = {};
+  for (const auto& pending : pending_handles_) {
+    if (auto found = handles_.find(pending); found != handles_.end()) {
+      if (!found->second.pending_collection &&
+          !found->second.name.has_value()) {
+        names_needed[static_cast<size_t>(pending.type)]++;
+      }
+    }
+  }
+  for (size_t i = 0; i < names_needed.size(); i++) {
+    if (names_needed[i] > 0u) {
+      ReserveGLNames(static_cast<HandleType>(i), names_needed[i]);
+    }
+  }
+
+  std::array<std::vector<GLuint>, std::tuple_size_v<NamePools>>
+      names_to_collect;
+  std::vector<HandleGLES> still_pending;
+  for (const auto& pending : pending_handles_) {
+    auto found = handles_.find(pending);
+    // The handle may be listed more than once, and could have been collected
+    // by an earlier entry.
+    if (found == handles_.end()) {
+      continue;
+    }
+    auto& handle = *found;
     // Collect dead handles.
     if (handle.second.pending_collection) {
       // This could be false if the handle was created and collected without
       // use. We still need to get rid of map entry.
       if (handle.second.name.has_value()) {
-        CollectGLHandle(gl, handle.first.type, handle.second.name.value());
+        names_to_collect[static_cast<size_t>(handle.first.type)].push_back(
+            handle.second.name.value());
       }
-      handles_to_delete.push_back(handle.first);
+      handles_.erase(found);
       continue;
     }
     // Create live handles.
     if (!handle.second.name.has_value()) {
-      auto gl_handle = CreateGLHandle(gl, handle.first.type);
+      auto gl_handle = AcquireGLName(handle.first.type);
       if (!gl_handle) {
         VALIDATION_LOG << "Could not create GL handle.";
         return false;
@@ -222,12 +303,16 @@ bool ReactorGLES::ConsolidateHandles() {
                            handle.second.name.value(),
                            handle.second.pending_debug_label.value())) {
         handle.second.pending_debug_label = std::nullopt;
+      } else {
+        still_pending.push_back(handle.first);
       }
     }
   }
-  for (const auto& handle_to_delete : handles_to_delete) {
-    handles_.erase(handle_to_delete);
+  for (size_t i = 0; i < names_to_collect.size(); i++) {
+    CollectGLNames(gl, static_cast<HandleType>(i), names_to_collect[i]);
   }
+  pending_handles_ = std::move(still_pending);
+  has_pending_handles_ = !pending_handles_.empty();
   return true;
 }
 
@@ -239,6 +324,7 @@ bool ReactorGLES::FlushOps() {
   {
     Lock ops_lock(ops_mutex_);
     std::swap(ops_, ops);
+    pending_ops_count_ = 0u;
   }
   for (const auto& op : ops) {
     TRACE_EVENT0("impeller", "ReactorGLES::Operation");
@@ -257,6 +343,7 @@ void ReactorGLES::SetDebugLabel(const HandleGLES& handle, std::string label) {
   WriterLock handles_lock(handles_mutex_);
   if (auto found = handles_.find(handle); found != handles_.end()) {
     found->second.pending_debug_label = std::move(label);
+    AddPendingHandle(handle);
   }
 }
 
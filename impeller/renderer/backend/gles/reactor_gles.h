@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -69,10 +71,22 @@ class ReactorGLES {
     constexpr bool IsLive() const { return name.has_value(); }
   };
 
+  // The number of names generated at once when a name pool runs dry.
+  static constexpr size_t kNamePoolBatchSize = 16u;
+
+  // One pool of generated but unused GL names per HandleType. Like the names
+  // of live handles, these are released along with the GL context.
+  using NamePools =
+      std::array<std::vector<GLuint>,
+                 static_cast<size_t>(HandleType::kFrameBuffer) + 1u>;
+
   std::unique_ptr<ProcTableGLES> proc_table_;
 
   mutable Mutex ops_mutex_;
   std::vector<Operation> ops_ IPLR_GUARDED_BY(ops_mutex_);
+  // Mirrors the size of ops_ so that checking for pending operations does not
+  // need to take the lock.
+  std::atomic_size_t pending_ops_count_ = 0u;
 
   // Make sure the container is one where erasing items during iteration doesn't
   // invalidate other iterators.
@@ -82,6 +96,13 @@ class ReactorGLES {
                                          HandleGLES::Equal>;
   mutable RWMutex handles_mutex_;
   LiveHandles handles_ IPLR_GUARDED_BY(handles_mutex_);
+  // The handles that need a name, a debug label, or collecting during the
+  // next reaction. Only these are visited when consolidating handles.
+  std::vector<HandleGLES> pending_handles_ IPLR_GUARDED_BY(handles_mutex_);
+  // Whether pending_handles_ is non-empty, so that reactions with nothing to
+  // consolidate do not need to take the lock.
+  std::atomic_bool has_pending_handles_ = false;
+  NamePools name_pools_ IPLR_GUARDED_BY(handles_mutex_);
 
   mutable Mutex workers_mutex_;
   mutable std::map<WorkerID, std::weak_ptr<Worker>> workers_
@@ -98,6 +119,15 @@ class ReactorGLES {
 
   bool ConsolidateHandles();
 
+  void AddPendingHandle(const HandleGLES& handle)
+      IPLR_REQUIRES(handles_mutex_);
+
+  void ReserveGLNames(HandleType type, size_t count)
+      IPLR_REQUIRES(handles_mutex_);
+
+  std::optional<GLuint> AcquireGLName(HandleType type)
+      IPLR_REQUIRES(handles_mutex_);
+
   bool FlushOps();
 
   FML_DISALLOW_COPY_AND_ASSIGN(ReactorGLES);
@@ -5,10 +5,14 @@
 #include "impeller/renderer/backend/gles/render_pass_gles.h"
 
 #include <algorithm>
+#include <array>
+#include <optional>
+#include <utility>
 
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/config.h"
 #include "impeller/base/validation.h"
+#include "impeller/renderer/backend/gles/context_gles.h"
 #include "impeller/renderer/backend/gles/device_buffer_gles.h"
 #include "impeller/renderer/backend/gles/formats_gles.h"
 #include "impeller/renderer/backend/gles/pipeline_gles.h"
@@ -111,6 +115,30 @@ void ConfigureStencil(const ProcTableGLES& gl,
   }
 }
 
+//------------------------------------------------------------------------------
+/// @brief      Shadows the GL state set by the commands of a render pass so
+///             that state shared with the previous command is not set again.
+///
+///             The state is only tracked from the point the pass resets it
+///             before the clear, since other reactor operations may change it
+///             between passes.
+///
+struct RenderPassStateGLES {
+  /// The pipeline and stencil reference that the blend, stencil, depth,
+  /// culling and winding state was last configured for.
+  const PipelineGLES* pipeline = nullptr;
+  uint32_t stencil_reference = 0u;
+
+  /// The pipeline whose program is in use.
+  const PipelineGLES* bound_program = nullptr;
+
+  std::optional<std::array<GLint, 4>> viewport;
+  std::optional<std::pair<Scalar, Scalar>> depth_range;
+  /// The scissor box when the scissor test is enabled, or std::nullopt when it
+  /// is disabled.
+  std::optional<std::array<GLint, 4>> scissor;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      Encapsulates data that will be needed in the reactor for the
 ///             encoding of commands for this render pass.
@@ -231,6 +259,13 @@ struct RenderPassData {
 
   gl.Clear(clear_bits);
 
+  RenderPassStateGLES state;
+  fml::ScopedCleanupClosure unbind_program([&state]() {
+    if (state.bound_program) {
+      [[maybe_unused]] auto unbound = state.bound_program->UnbindProgram();
+    }
+  });
+
   for (const auto& command : commands) {
     if (command.instance_count != 1u) {
       VALIDATION_LOG << "GLES backend does not support instanced rendering.";
@@ -261,26 +296,63 @@ struct RenderPassData {
     }
 
     //--------------------------------------------------------------------------
-    /// Configure blending.
-    ///
-    ConfigureBlending(gl, color_attachment);
-
-    //--------------------------------------------------------------------------
-    /// Setup stencil.
+    /// Configure the fixed function state derived from the pipeline, unless
+    /// the previous command already did.
     ///
-    ConfigureStencil(gl, pipeline.GetDescriptor(), command.stencil_reference);
+    if (state.pipeline != &pipeline ||
+        state.stencil_reference != command.stencil_reference) {
+      //------------------------------------------------------------------------
+      /// Configure blending.
+      ///
+      ConfigureBlending(gl, color_attachment);
+
+      //------------------------------------------------------------------------
+      /// Setup stencil.
+      ///
+      ConfigureStencil(gl, pipeline.GetDescriptor(), command.stencil_reference);
+
+      //------------------------------------------------------------------------
+      /// Configure depth.
+      ///
+      if (auto depth =
+              pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
+          depth.has_value()) {
+        gl.Enable(GL_DEPTH_TEST);
+        gl.DepthFunc(ToCompareFunction(depth->depth_compare));
+        gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
+      } else {
+        gl.Disable(GL_DEPTH_TEST);
+      }
 
-    //--------------------------------------------------------------------------
-    /// Configure depth.
-    ///
-    if (auto depth =
-            pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
-        depth.has_value()) {
-      gl.Enable(GL_DEPTH_TEST);
-      gl.DepthFunc(ToCompareFunction(depth->depth_compare));
-      gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
-    } else {
-      gl.Disable(GL_DEPTH_TEST);
+      //------------------------------------------------------------------------
+      /// Setup culling.
+      ///
+      switch (pipeline.GetDescriptor().GetCullMode()) {
+        case CullMode::kNone:
+          gl.Disable(GL_CULL_FACE);
+          break;
+        case CullMode::kFrontFace:
+          gl.Enable(GL_CULL_FACE);
+          gl.CullFace(GL_FRONT);
+          break;
+        case CullMode::kBackFace:
+          gl.Enable(GL_CULL_FACE);
+          gl.CullFace(GL_BACK);
+          break;
+      }
+      //------------------------------------------------------------------------
+      /// Setup winding order.
+      ///
+      switch (pipeline.GetDescriptor().GetWindingOrder()) {
+        case WindingOrder::kClockwise:
+          gl.FrontFace(GL_CW);
+          break;
+        case WindingOrder::kCounterClockwise:
+          gl.FrontFace(GL_CCW);
+          break;
+      }
+      state.pipeline = &pipeline;
+      state.stencil_reference = command.stencil_reference;
     }
 
     // Both the viewport and scissor are specified in framebuffer coordinates.
@@ -292,14 +364,25 @@ struct RenderPassData {
     /// Setup the viewport.
     ///
     const auto& viewport = command.viewport.value_or(pass_data.viewport);
-    gl.Viewport(viewport.rect.origin.x,  // x
-                target_size.height - viewport.rect.origin.y -
-                    viewport.rect.size.height,  // y
-                viewport.rect.size.width,       // width
-                viewport.rect.size.height       // height
-    );
+    const std::array<GLint, 4> viewport_box = {
+        static_cast<GLint>(viewport.rect.origin.x),  // x
+        static_cast<GLint>(target_size.height - viewport.rect.origin.y -
+                           viewport.rect.size.height),  // y
+        static_cast<GLint>(viewport.rect.size.width),   // width
+        static_cast<GLint>(viewport.rect.size.height)   // height
+    };
+    if (state.viewport != viewport_box) {
+      gl.Viewport(viewport_box[0], viewport_box[1], viewport_box[2],
+                  viewport_box[3]);
+      state.viewport = viewport_box;
+    }
     if (pass_data.depth_attachment) {
-      gl.DepthRangef(viewport.depth_range.z_near, viewport.depth_range.z_far);
+      const auto depth_range = std::make_pair(viewport.depth_range.z_near,
+                                              viewport.depth_range.z_far);
+      if (state.depth_range != depth_range) {
+        gl.DepthRangef(depth_range.first, depth_range.second);
+        state.depth_range = depth_range;
+      }
     }
 
     //--------------------------------------------------------------------------
@@ -307,43 +390,24 @@ struct RenderPassData {
     ///
     if (command.scissor.has_value()) {
       const auto& scissor = command.scissor.value();
-      gl.Enable(GL_SCISSOR_TEST);
-      gl.Scissor(
-          scissor.origin.x,                                             // x
-          target_size.height - scissor.origin.y - scissor.size.height,  // y
-          scissor.size.width,                                           // width
-          scissor.size.height  // height
-      );
-    } else {
+      const std::array<GLint, 4> scissor_box = {
+          static_cast<GLint>(scissor.origin.x),  // x
+          static_cast<GLint>(target_size.height - scissor.origin.y -
+                             scissor.size.height),   // y
+          static_cast<GLint>(scissor.size.width),    // width
+          static_cast<GLint>(scissor.size.height)    // height
+      };
+      if (!state.scissor.has_value()) {
+        gl.Enable(GL_SCISSOR_TEST);
+      }
+      if (state.scissor != scissor_box) {
+        gl.Scissor(scissor_box[0], scissor_box[1], scissor_box[2],
+                   scissor_box[3]);
+      }
+      state.scissor = scissor_box;
+    } else if (state.scissor.has_value()) {
       gl.Disable(GL_SCISSOR_TEST);
-    }
-
-    //--------------------------------------------------------------------------
-    /// Setup culling.
-    ///
-    switch (pipeline.GetDescriptor().GetCullMode()) {
-      case CullMode::kNone:
-        gl.Disable(GL_CULL_FACE);
-        break;
-      case CullMode::kFrontFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_FRONT);
-        break;
-      case CullMode::kBackFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_BACK);
-        break;
-    }
-    //--------------------------------------------------------------------------
-    /// Setup winding order.
-    ///
-    switch (pipeline.GetDescriptor().GetWindingOrder()) {
-      case WindingOrder::kClockwise:
-        gl.FrontFace(GL_CW);
-        break;
-      case WindingOrder::kCounterClockwise:
-        gl.FrontFace(GL_CCW);
-        break;
+      state.scissor = std::nullopt;
     }
 
     if (command.index_type == IndexType::kUnknown) {
@@ -385,8 +449,11 @@ struct RenderPassData {
     //--------------------------------------------------------------------------
     /// Bind the pipeline program.
     ///
-    if (!pipeline.BindProgram()) {
-      return false;
+    if (state.bound_program != &pipeline) {
+      if (!pipeline.BindProgram()) {
+        return false;
+      }
+      state.bound_program = &pipeline;
     }
 
     //--------------------------------------------------------------------------
@@ -436,13 +503,14 @@ struct RenderPassData {
     if (!vertex_desc_gles->UnbindVertexAttributes(gl)) {
       return false;
     }
+  }
 
-    //--------------------------------------------------------------------------
-    /// Unbind the program pipeline.
-    ///
-    if (!pipeline.UnbindProgram()) {
-      return false;
-    }
+  //----------------------------------------------------------------------------
+  /// Unbind the program pipeline of the last command.
+  ///
+  unbind_program.Release();
+  if (state.bound_program && !state.bound_program->UnbindProgram()) {
+    return false;
   }
 
   if (gl.DiscardFramebufferEXT.IsAvailable()) {
@@ -521,14 +589,22 @@ bool RenderPassGLES::OnEncodeCommands(const Context& context) const {
   }
 
   std::shared_ptr<const RenderPassGLES> shared_this = shared_from_this();
-  return reactor_->AddOperation([pass_data,
-                                 allocator = context.GetResourceAllocator(),
-                                 render_pass = std::move(shared_this)](
-                                    const auto& reactor) {
-    auto result = EncodeCommandsInReactor(*pass_data, allocator, reactor,
-                                          render_pass->commands_);
-    FML_CHECK(result) << "Must be able to encode GL commands without error.";
-  });
+  return reactor_->AddOperation(
+      [pass_data, allocator = context.GetResourceAllocator(),
+       timer_queries = ContextGLES::Cast(context).GetTimerQueries(),
+       render_pass = std::move(shared_this)](const auto& reactor) {
+        const auto& gl = reactor.GetProcTable();
+        const auto timed_pass =
+            timer_queries ? timer_queries->BeginPass(gl, pass_data->label)
+                          : std::nullopt;
+        auto result = EncodeCommandsInReactor(*pass_data, allocator, reactor,
+                                              render_pass->commands_);
+        if (timed_pass.has_value()) {
+          timer_queries->EndPass(gl, timed_pass.value());
+        }
+        FML_CHECK(result)
+            << "Must be able to encode GL commands without error.";
+      });
 }
 
 }  // namespace impeller
@@ -4,24 +4,28 @@
 
 #include "impeller/renderer/backend/gles/shader_library_gles.h"
 
+#include <optional>
 #include <sstream>
 
 #include "flutter/fml/closure.h"
 #include "impeller/base/config.h"
 #include "impeller/base/validation.h"
-#include "impeller/blobcat/blob_library.h"
 #include "impeller/renderer/backend/gles/shader_function_gles.h"
 
 namespace impeller {
 
-static ShaderStage ToShaderStage(BlobShaderType type) {
-  switch (type) {
-    case BlobShaderType::kVertex:
-      return ShaderStage::kVertex;
-    case BlobShaderType::kFragment:
-      return ShaderStage::kFragment;
-    case BlobShaderType::kCompute:
-      return ShaderStage::kCompute;
+static std::optional<BlobShaderType> ToBlobShaderType(ShaderStage stage) {
+  switch (stage) {
+    case ShaderStage::kVertex:
+      return BlobShaderType::kVertex;
+    case ShaderStage::kFragment:
+      return BlobShaderType::kFragment;
+    case ShaderStage::kCompute:
+      return BlobShaderType::kCompute;
+    case ShaderStage::kUnknown:
+    case ShaderStage::kTessellationControl:
+    case ShaderStage::kTessellationEvaluation:
+      return std::nullopt;
   }
   FML_UNREACHABLE();
 }
@@ -56,36 +60,39 @@ static std::string GLESShaderNameToShaderKeyName(const std::string& name,
 
 ShaderLibraryGLES::ShaderLibraryGLES(
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries) {
-  ShaderFunctionMap functions;
-  auto iterator = [&functions, library_id = library_id_](auto type,           //
-                                                         const auto& name,    //
-                                                         const auto& mapping  //
-                                                         ) -> bool {
-    const auto stage = ToShaderStage(type);
-    const auto key_name = GLESShaderNameToShaderKeyName(name, stage);
-
-    functions[ShaderKey{key_name, stage}] = std::shared_ptr<ShaderFunctionGLES>(
-        new ShaderFunctionGLES(library_id,  //
-                               stage,       //
-                               key_name,    //
-                               mapping      //
-                               ));
-
-    return true;
-  };
   for (auto library : shader_libraries) {
     auto blob_library = BlobLibrary{std::move(library)};
     if (!blob_library.IsValid()) {
       VALIDATION_LOG << "Could not construct blob library for shaders.";
       return;
     }
-    blob_library.IterateAllBlobs(iterator);
+    blob_libraries_.emplace_back(std::move(blob_library));
   }
 
-  functions_ = functions;
   is_valid_ = true;
 }
 
+std::shared_ptr<fml::Mapping> ShaderLibraryGLES::FindBlob(
+    std::string_view key_name,
+    ShaderStage stage) const {
+  const auto type = ToBlobShaderType(stage);
+  // Functions are looked up by the key name of the blob they were created
+  // from, which is the blob name followed by a suffix for the stage.
+  const auto suffix = GLESShaderNameToShaderKeyName("", stage);
+  if (!type.has_value() || key_name.size() <= suffix.size() ||
+      key_name.substr(key_name.size() - suffix.size()) != suffix) {
+    return nullptr;
+  }
+  const auto name = key_name.substr(0, key_name.size() - suffix.size());
+  // Later libraries take precedence over earlier ones.
+  for (auto i = blob_libraries_.rbegin(); i != blob_libraries_.rend(); i++) {
+    if (auto mapping = i->GetMapping(type.value(), name)) {
+      return mapping;
+    }
+  }
+  return nullptr;
+}
+
 // |ShaderLibrary|
 ShaderLibraryGLES::~ShaderLibraryGLES() = default;
 
@@ -98,12 +105,31 @@ bool ShaderLibraryGLES::IsValid() const {
 std::shared_ptr<const ShaderFunction> ShaderLibraryGLES::GetFunction(
     std::string_view name,
     ShaderStage stage) {
-  ReaderLock lock(functions_mutex_);
   const auto key = ShaderKey{name, stage};
-  if (auto found = functions_.find(key); found != functions_.end()) {
-    return found->second;
+  {
+    ReaderLock lock(functions_mutex_);
+    if (auto found = functions_.find(key); found != functions_.end()) {
+      return found->second;
+    }
   }
-  return nullptr;
+
+  auto mapping = FindBlob(name, stage);
+  if (!mapping) {
+    return nullptr;
+  }
+
+  WriterLock lock(functions_mutex_);
+  // Another thread may have created the function in the meantime.
+  auto& function = functions_[key];
+  if (!function) {
+    function = std::shared_ptr<ShaderFunctionGLES>(
+        new ShaderFunctionGLES(library_id_,        //
+                               stage,              //
+                               std::string{name},  //
+                               std::move(mapping)  //
+                               ));
+  }
+  return function;
 }
 
 // |ShaderLibrary|
@@ -5,11 +5,13 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "impeller/base/comparable.h"
 #include "impeller/base/thread.h"
+#include "impeller/blobcat/blob_library.h"
 #include "impeller/renderer/shader_key.h"
 #include "impeller/renderer/shader_library.h"
 
@@ -28,6 +30,8 @@ class ShaderLibraryGLES final : public ShaderLibrary {
   const UniqueID library_id_;
   mutable RWMutex functions_mutex_;
   ShaderFunctionMap functions_ IPLR_GUARDED_BY(functions_mutex_);
+  // Functions are only created for the blobs once they are first asked for.
+  std::vector<BlobLibrary> blob_libraries_;
   bool is_valid_ = false;
 
   ShaderLibraryGLES(
@@ -46,6 +50,9 @@ class ShaderLibraryGLES final : public ShaderLibrary {
   // |ShaderLibrary|
   void UnregisterFunction(std::string name, ShaderStage stage) override;
 
+  std::shared_ptr<fml::Mapping> FindBlob(std::string_view key_name,
+                                         ShaderStage stage) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(ShaderLibraryGLES);
 };
 
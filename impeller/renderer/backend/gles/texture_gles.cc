@@ -4,8 +4,11 @@
 
 #include "impeller/renderer/backend/gles/texture_gles.h"
 
+#include <atomic>
+#include <mutex>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
@@ -28,6 +31,37 @@ static TextureGLES::Type GetTextureTypeFromDescriptor(
   return TextureGLES::Type::kTexture;
 }
 
+struct TextureGLES::UploadFences {
+  std::mutex mutex;
+  std::vector<GLsync> syncs;
+  // Mirrors whether syncs is non-empty so that binds don't take the lock.
+  std::atomic_bool has_syncs = false;
+
+  void Signal(const ProcTableGLES& gl) {
+    if (!gl.FenceSync.IsAvailable()) {
+      // Without sync objects, flushing is the best that can be done to make
+      // the upload visible to the other contexts of the share group.
+      gl.Flush();
+      return;
+    }
+    auto sync = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    // The fence must be flushed before another context can wait on it.
+    gl.Flush();
+    std::scoped_lock lock(mutex);
+    syncs.push_back(sync);
+    has_syncs = true;
+  }
+
+  std::vector<GLsync> Take() {
+    if (!has_syncs.load()) {
+      return {};
+    }
+    std::scoped_lock lock(mutex);
+    has_syncs = false;
+    return std::move(syncs);
+  }
+};
+
 HandleType ToHandleType(TextureGLES::Type type) {
   switch (type) {
     case TextureGLES::Type::kTexture:
@@ -53,6 +87,7 @@ TextureGLES::TextureGLES(std::shared_ptr<ReactorGLES> reactor,
       reactor_(std::move(reactor)),
       type_(GetTextureTypeFromDescriptor(GetTextureDescriptor())),
       handle_(reactor_->CreateHandle(ToHandleType(type_))),
+      upload_fences_(std::make_shared<UploadFences>()),
       is_wrapped_(is_wrapped) {
   // Ensure the texture descriptor itself is valid.
   if (!GetTextureDescriptor().IsValid()) {
@@ -74,6 +109,14 @@ TextureGLES::TextureGLES(std::shared_ptr<ReactorGLES> reactor,
 // |Texture|
 TextureGLES::~TextureGLES() {
   reactor_->CollectHandle(handle_);
+  if (auto syncs = upload_fences_->Take(); !syncs.empty()) {
+    [[maybe_unused]] auto result = reactor_->AddOperation(
+        [syncs = std::move(syncs)](const ReactorGLES& reactor) {
+          for (auto sync : syncs) {
+            reactor.GetProcTable().DeleteSync(sync);
+          }
+        });
+  }
 }
 
 // |Texture|
@@ -125,6 +168,7 @@ struct TexImage2DData {
       case PixelFormat::kB10G10R10XRSRGB:
       case PixelFormat::kB10G10R10XR:
       case PixelFormat::kB10G10R10A10XR:
+      case PixelFormat::kETC2R8G8B8UNormInt:
         return;
     }
     is_valid_ = true;
@@ -173,6 +217,7 @@ struct TexImage2DData {
       case PixelFormat::kB10G10R10XRSRGB:
       case PixelFormat::kB10G10R10XR:
       case PixelFormat::kB10G10R10A10XR:
+      case PixelFormat::kETC2R8G8B8UNormInt:
         return;
     }
     is_valid_ = true;
@@ -259,7 +304,8 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
                                            data,                        //
                                            size = tex_descriptor.size,  //
                                            texture_type,                //
-                                           texture_target               //
+                                           texture_target,              //
+                                           fences = upload_fences_      //
   ](const auto& reactor) {
     auto gl_handle = reactor.GetGLHandle(handle);
     if (!gl_handle.has_value()) {
@@ -288,6 +334,7 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
                     tex_data                // data
       );
     }
+    fences->Signal(gl);
   };
 
   contents_initialized_ = reactor_->AddOperation(texture_upload);
@@ -321,6 +368,7 @@ static std::optional<GLenum> ToRenderBufferFormat(PixelFormat format) {
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8UNormInt:
       return std::nullopt;
   }
   FML_UNREACHABLE();
@@ -415,6 +463,7 @@ bool TextureGLES::Bind() const {
         VALIDATION_LOG << "Could not bind texture of this type.";
         return false;
       }
+      WaitForUploads(gl);
       gl.BindTexture(target.value(), handle.value());
     } break;
     case Type::kRenderBuffer:
@@ -425,6 +474,14 @@ bool TextureGLES::Bind() const {
   return true;
 }
 
+void TextureGLES::WaitForUploads(const ProcTableGLES& gl) const {
+  for (auto sync : upload_fences_->Take()) {
+    // Only the GPU waits, the thread carries on recording.
+    gl.WaitSync(sync, 0, GL_TIMEOUT_IGNORED);
+    gl.DeleteSync(sync);
+  }
+}
+
 bool TextureGLES::GenerateMipmap() {
   if (!IsValid()) {
     return false;
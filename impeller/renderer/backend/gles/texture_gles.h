@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/core/texture.h"
@@ -55,9 +57,16 @@ class TextureGLES final : public Texture,
  private:
   friend class AllocatorMTL;
 
+  struct UploadFences;
+
   ReactorGLES::Ref reactor_;
   const Type type_;
   HandleGLES handle_;
+  // The fences signaled by the uploads of the contents. Uploads usually run
+  // on the IO thread, whose context is in the share group of the context
+  // the texture is sampled from. Binding the texture waits on these fences on
+  // the GPU instead of relying on the uploads happening to be done.
+  std::shared_ptr<UploadFences> upload_fences_;
   mutable bool contents_initialized_ = false;
   const bool is_wrapped_;
   bool is_valid_ = false;
@@ -89,6 +98,8 @@ class TextureGLES final : public Texture,
 
   void InitializeContentsIfNecessary() const;
 
+  void WaitForUploads(const ProcTableGLES& gl) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(TextureGLES);
 };
 
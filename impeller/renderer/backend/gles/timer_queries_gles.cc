@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/timer_queries_gles.h"
+
+namespace impeller {
+
+TimerQueriesGLES::TimerQueriesGLES(std::shared_ptr<GPUTracer> tracer)
+    : tracer_(std::move(tracer)) {}
+
+TimerQueriesGLES::~TimerQueriesGLES() {
+  // The queries themselves are collected along with the GL context.
+  for (const auto& pass : pending_passes_) {
+    tracer_->EndPass(pass.frame, pass.label, std::nullopt);
+  }
+}
+
+// static
+bool TimerQueriesGLES::IsSupported(const ProcTableGLES& gl) {
+  return gl.GenQueriesEXT.IsAvailable() &&
+         gl.DeleteQueriesEXT.IsAvailable() &&
+         gl.BeginQueryEXT.IsAvailable() && gl.EndQueryEXT.IsAvailable() &&
+         gl.GetQueryObjectuivEXT.IsAvailable() &&
+         gl.GetQueryObjectui64vEXT.IsAvailable();
+}
+
+const std::shared_ptr<GPUTracer>& TimerQueriesGLES::GetTracer() const {
+  return tracer_;
+}
+
+std::optional<uint64_t> TimerQueriesGLES::BeginPass(const ProcTableGLES& gl,
+                                                    const std::string& label) {
+  std::scoped_lock lock(mutex_);
+  PollPendingPasses(gl);
+  if (!tracer_->IsEnabled() || pending_passes_.size() >= kMaxPendingPasses) {
+    return std::nullopt;
+  }
+  GLuint query = GL_NONE;
+  gl.GenQueriesEXT(1u, &query);
+  gl.BeginQueryEXT(GL_TIME_ELAPSED_EXT, query);
+  pending_passes_.push_back({
+      .id = next_pass_id_++,
+      .frame = tracer_->BeginPass(),
+      .label = label,
+      .query = query,
+  });
+  return pending_passes_.back().id;
+}
+
+void TimerQueriesGLES::EndPass(const ProcTableGLES& gl, uint64_t pass) {
+  std::scoped_lock lock(mutex_);
+  gl.EndQueryEXT(GL_TIME_ELAPSED_EXT);
+  for (auto& pending_pass : pending_passes_) {
+    if (pending_pass.id == pass) {
+      pending_pass.ended = true;
+      break;
+    }
+  }
+}
+
+void TimerQueriesGLES::PollPendingPasses(const ProcTableGLES& gl) {
+  // Reading the disjoint state also clears it, so it applies to all of the
+  // passes that are pending at this point.
+  GLint disjoint = GL_FALSE;
+  gl.GetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+  while (!pending_passes_.empty()) {
+    auto& pass = pending_passes_.front();
+    if (!pass.ended) {
+      break;
+    }
+    std::optional<fml::TimeDelta> gpu_time;
+    if (!disjoint) {
+      GLuint available = GL_FALSE;
+      gl.GetQueryObjectuivEXT(pass.query, GL_QUERY_RESULT_AVAILABLE_EXT,
+                              &available);
+      // Queries become available in the order they were issued in.
+      if (!available) {
+        break;
+      }
+      GLuint64 elapsed = 0u;
+      gl.GetQueryObjectui64vEXT(pass.query, GL_QUERY_RESULT_EXT, &elapsed);
+      gpu_time = fml::TimeDelta::FromNanoseconds(elapsed);
+    }
+    gl.DeleteQueriesEXT(1u, &pass.query);
+    tracer_->EndPass(pass.frame, pass.label, gpu_time);
+    pending_passes_.pop_front();
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,75 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/gpu_tracer.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Measures the GPU time of render passes with the time elapsed
+///             queries of `GL_EXT_disjoint_timer_query`, and reports it to a
+///             GPU tracer.
+///
+///             Queries are only ever polled for their results, which are
+///             reported the next time a pass begins. Results of queries that
+///             were pending while the GPU timer was disjoint are discarded.
+///
+///             All of the methods must be called on a thread with the GL
+///             context the queries belong to current, which is why they are
+///             called from reactor operations.
+///
+class TimerQueriesGLES {
+ public:
+  explicit TimerQueriesGLES(std::shared_ptr<GPUTracer> tracer);
+
+  ~TimerQueriesGLES();
+
+  static bool IsSupported(const ProcTableGLES& gl);
+
+  const std::shared_ptr<GPUTracer>& GetTracer() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reports the results of the passes that completed, and starts
+  ///             timing the commands issued next.
+  ///
+  /// @return     The pass to end with `EndPass`, or `std::nullopt` if GPU
+  ///             tracing is disabled or too many passes are pending.
+  ///
+  std::optional<uint64_t> BeginPass(const ProcTableGLES& gl,
+                                    const std::string& label);
+
+  void EndPass(const ProcTableGLES& gl, uint64_t pass);
+
+ private:
+  static constexpr size_t kMaxPendingPasses = 64u;
+
+  struct Pass {
+    uint64_t id = 0;
+    GPUTracer::FrameID frame = 0;
+    std::string label;
+    GLuint query = GL_NONE;
+    bool ended = false;
+  };
+
+  const std::shared_ptr<GPUTracer> tracer_;
+  std::mutex mutex_;
+  std::deque<Pass> pending_passes_;
+  uint64_t next_pass_id_ = 0;
+
+  void PollPendingPasses(const ProcTableGLES& gl);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TimerQueriesGLES);
+};
+
+}  // namespace impeller
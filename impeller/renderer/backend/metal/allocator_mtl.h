@@ -7,6 +7,7 @@
 #include <Metal/Metal.h>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/core/allocator.h"
 
 namespace impeller {
@@ -27,6 +28,18 @@ class AllocatorMTL final : public Allocator {
   bool supports_uma_ = false;
   bool is_valid_ = false;
   ISize max_texture_supported_;
+  // Private render targets are suballocated from this heap when they fit, so
+  // that the offscreen targets created and dropped every frame do not each
+  // need a fresh device allocation. Created on first use.
+  Mutex render_target_heap_mutex_;
+  id<MTLHeap> render_target_heap_ IPLR_GUARDED_BY(render_target_heap_mutex_);
+  bool render_target_heap_failed_ IPLR_GUARDED_BY(render_target_heap_mutex_) =
+      false;
+
+  id<MTLHeap> GetRenderTargetHeap();
+
+  id<MTLTexture> NewRenderTargetTextureFromHeap(
+      MTLTextureDescriptor* descriptor);
 
   AllocatorMTL(id<MTLDevice> device, std::string label);
 
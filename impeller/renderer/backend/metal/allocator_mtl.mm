@@ -89,6 +89,11 @@ static bool SupportsLossyTextureCompression(id<MTLDevice> device) {
 #endif
 }
 
+// The size of the heap private render targets are suballocated from. Larger
+// targets, or targets that do not fit in what is left of the heap, are
+// allocated from the device directly.
+static constexpr NSUInteger kRenderTargetHeapSize = 32u * 1024u * 1024u;
+
 AllocatorMTL::AllocatorMTL(id<MTLDevice> device, std::string label)
     : device_(device), allocator_label_(std::move(label)) {
   if (!device_) {
@@ -213,11 +218,58 @@ std::shared_ptr<Texture> AllocatorMTL::OnCreateTexture(
     }
   }
 
-  auto texture = [device_ newTextureWithDescriptor:mtl_texture_desc];
+  id<MTLTexture> texture = nil;
+  if (mtl_texture_desc.storageMode == MTLStorageModePrivate &&
+      TextureUsageIsRenderTarget(desc.usage)) {
+    texture = NewRenderTargetTextureFromHeap(mtl_texture_desc);
+  }
+  if (!texture) {
+    texture = [device_ newTextureWithDescriptor:mtl_texture_desc];
+  }
   if (!texture) {
     return nullptr;
   }
-  return std::make_shared<TextureMTL>(desc, texture);
+  auto texture_mtl = std::make_shared<TextureMTL>(desc, texture);
+  texture_mtl->CountAllocatedMemory();
+  return texture_mtl;
+}
+
+id<MTLHeap> AllocatorMTL::GetRenderTargetHeap() {
+  Lock lock(render_target_heap_mutex_);
+  if (render_target_heap_ || render_target_heap_failed_) {
+    return render_target_heap_;
+  }
+  // Resources on heaps are not hazard tracked by default, and the render
+  // passes rely on Metal tracking their attachments.
+  if (@available(macOS 10.15, iOS 13.0, tvOS 13.0, *)) {
+    MTLHeapDescriptor* heap_desc = [[MTLHeapDescriptor alloc] init];
+    heap_desc.type = MTLHeapTypeAutomatic;
+    heap_desc.storageMode = MTLStorageModePrivate;
+    heap_desc.hazardTrackingMode = MTLHazardTrackingModeTracked;
+    heap_desc.size = kRenderTargetHeapSize;
+    render_target_heap_ = [device_ newHeapWithDescriptor:heap_desc];
+    if (render_target_heap_) {
+      render_target_heap_.label = [NSString
+          stringWithFormat:@"%s Render Targets", allocator_label_.c_str()];
+    }
+  }
+  render_target_heap_failed_ = !render_target_heap_;
+  return render_target_heap_;
+}
+
+id<MTLTexture> AllocatorMTL::NewRenderTargetTextureFromHeap(
+    MTLTextureDescriptor* descriptor) {
+  id<MTLHeap> heap = GetRenderTargetHeap();
+  if (!heap) {
+    return nil;
+  }
+  const auto size_and_align =
+      [device_ heapTextureSizeAndAlignWithDescriptor:descriptor];
+  if (size_and_align.size >
+      [heap maxAvailableSizeWithAlignment:size_and_align.align]) {
+    return nil;
+  }
+  return [heap newTextureWithDescriptor:descriptor];
 }
 
 uint16_t AllocatorMTL::MinimumBytesPerRow(PixelFormat format) const {
@@ -42,6 +42,10 @@ class CommandBufferMTL final : public CommandBuffer {
   // |CommandBuffer|
   std::shared_ptr<ComputePass> OnCreateComputePass() const override;
 
+  // Reports the GPU time of the command buffer to the GPU tracer of the
+  // context once it completes.
+  void TraceGPUTime() const API_AVAILABLE(ios(10.3), macos(10.15));
+
   FML_DISALLOW_COPY_AND_ASSIGN(CommandBufferMTL);
 };
 
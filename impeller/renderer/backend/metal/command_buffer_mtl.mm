@@ -7,6 +7,7 @@
 #include "impeller/renderer/backend/metal/blit_pass_mtl.h"
 #include "impeller/renderer/backend/metal/compute_pass_mtl.h"
 #include "impeller/renderer/backend/metal/render_pass_mtl.h"
+#include "impeller/renderer/gpu_tracer.h"
 
 namespace impeller {
 
@@ -153,7 +154,32 @@ static CommandBuffer::Status ToCommitResult(MTLCommandBufferStatus status) {
   return CommandBufferMTL::Status::kError;
 }
 
+void CommandBufferMTL::TraceGPUTime() const {
+  auto context = context_.lock();
+  if (!context) {
+    return;
+  }
+  auto tracer = context->GetGPUTracer();
+  if (!tracer || !tracer->IsEnabled()) {
+    return;
+  }
+  const auto frame = tracer->BeginPass();
+  const std::string label =
+      buffer_.label ? buffer_.label.UTF8String : "CommandBuffer";
+  [buffer_ addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+    std::optional<fml::TimeDelta> gpu_time;
+    if (buffer.status == MTLCommandBufferStatusCompleted) {
+      gpu_time =
+          fml::TimeDelta::FromSecondsF(buffer.GPUEndTime - buffer.GPUStartTime);
+    }
+    tracer->EndPass(frame, label, gpu_time);
+  }];
+}
+
 bool CommandBufferMTL::OnSubmitCommands(CompletionCallback callback) {
+  if (@available(iOS 10.3, macOS 10.15, *)) {
+    TraceGPUTime();
+  }
   if (callback) {
     [buffer_
         addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
@@ -247,8 +247,22 @@ bool ComputePassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
     // sizes.
     // https://github.com/flutter/flutter/issues/110619
 
-    // For now, check that the sizes are uniform.
-    FML_DCHECK(grid_size == thread_group_size);
+    if (grid_size != thread_group_size) {
+      // The grid is covered with whole thread groups. Kernels skip the
+      // invocations that fall outside of the grid.
+      auto group_size = MTLSizeMake(thread_group_size.width,
+                                    thread_group_size.height, 1);
+      auto group_count = MTLSizeMake(
+          (grid_size.width + thread_group_size.width - 1) /
+              thread_group_size.width,
+          (grid_size.height + thread_group_size.height - 1) /
+              thread_group_size.height,
+          1);
+      [encoder dispatchThreadgroups:group_count
+              threadsPerThreadgroup:group_size];
+      continue;
+    }
+
     auto width = grid_size.width;
     auto height = grid_size.height;
     while (width * height >
@@ -36,6 +36,9 @@ class ContextMTL final : public Context,
 
   id<MTLDevice> GetMTLDevice() const;
 
+  // |Context|
+  BackendType GetBackendType() const override;
+
   // |Context|
   bool IsValid() const override;
 
@@ -57,6 +60,9 @@ class ContextMTL final : public Context,
   // |Context|
   const std::shared_ptr<const Capabilities>& GetCapabilities() const override;
 
+  // |Context|
+  std::shared_ptr<GPUTracer> GetGPUTracer() const override;
+
   // |Context|
   bool UpdateOffscreenLayerPixelFormat(PixelFormat format) override;
 
@@ -68,6 +74,7 @@ class ContextMTL final : public Context,
   std::shared_ptr<SamplerLibrary> sampler_library_;
   std::shared_ptr<AllocatorMTL> resource_allocator_;
   std::shared_ptr<const Capabilities> device_capabilities_;
+  std::shared_ptr<GPUTracer> gpu_tracer_;
   bool is_valid_ = false;
 
   ContextMTL(id<MTLDevice> device, NSArray<id<MTLLibrary>>* shader_libraries);
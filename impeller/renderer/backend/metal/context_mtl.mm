@@ -12,6 +12,7 @@
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/renderer/backend/metal/sampler_library_mtl.h"
 #include "impeller/renderer/capabilities.h"
+#include "impeller/renderer/gpu_tracer.h"
 
 namespace impeller {
 
@@ -45,6 +46,18 @@ static bool DeviceSupportsComputeSubgroups(id<MTLDevice> device) {
   return supports_subgroups;
 }
 
+static bool DeviceSupportsTextureCompressionETC2(id<MTLDevice> device) {
+  // ETC2 is supported by all Apple family GPUs, but not by Intel and AMD Macs.
+  if (@available(macOS 10.15, iOS 13, tvOS 13, *)) {
+    return [device supportsFamily:MTLGPUFamilyApple1];
+  }
+#if FML_OS_IOS
+  return true;
+#else
+  return false;
+#endif  // FML_OS_IOS
+}
+
 static std::unique_ptr<Capabilities> InferMetalCapabilities(
     id<MTLDevice> device,
     PixelFormat color_format) {
@@ -53,6 +66,7 @@ static std::unique_ptr<Capabilities> InferMetalCapabilities(
       .SetSupportsOffscreenMSAA(true)
       .SetSupportsSSBO(true)
       .SetSupportsTextureToTextureBlits(true)
+      .SetSupportsBufferToTextureBlits(true)
       .SetSupportsDecalTileMode(true)
       .SetSupportsFramebufferFetch(DeviceSupportsFramebufferFetch(device))
       .SetDefaultColorFormat(color_format)
@@ -60,6 +74,8 @@ static std::unique_ptr<Capabilities> InferMetalCapabilities(
       .SetSupportsCompute(true, DeviceSupportsComputeSubgroups(device))
       .SetSupportsReadFromResolve(true)
       .SetSupportsReadFromOnscreenTexture(true)
+      .SetSupportsTextureCompressionETC2(
+          DeviceSupportsTextureCompressionETC2(device))
       .Build();
 }
 
@@ -124,6 +140,8 @@ ContextMTL::ContextMTL(id<MTLDevice> device,
   device_capabilities_ =
       InferMetalCapabilities(device_, PixelFormat::kB8G8R8A8UNormInt);
 
+  gpu_tracer_ = std::make_shared<GPUTracer>();
+
   is_valid_ = true;
 }
 
@@ -225,6 +243,11 @@ std::shared_ptr<ContextMTL> ContextMTL::Create(
 
 ContextMTL::~ContextMTL() = default;
 
+// |Context|
+Context::BackendType ContextMTL::GetBackendType() const {
+  return Context::BackendType::kMetal;
+}
+
 // |Context|
 bool ContextMTL::IsValid() const {
   return is_valid_;
@@ -245,6 +268,11 @@ std::shared_ptr<SamplerLibrary> ContextMTL::GetSamplerLibrary() const {
   return sampler_library_;
 }
 
+// |Context|
+std::shared_ptr<GPUTracer> ContextMTL::GetGPUTracer() const {
+  return gpu_tracer_;
+}
+
 // |Context|
 std::shared_ptr<CommandBuffer> ContextMTL::CreateCommandBuffer() const {
   return CreateCommandBufferInQueue(command_queue_);
@@ -62,6 +62,10 @@ MTLPixelFormat SafeMTLPixelFormatBGR10_XR();
 /// Returns PixelFormat::kUnknown if MTLPixelFormatBGR10_XR isn't supported.
 MTLPixelFormat SafeMTLPixelFormatBGRA10_XR();
 
+/// Safe accessor for MTLPixelFormatETC2_RGB8.
+/// Returns PixelFormat::kUnknown if MTLPixelFormatETC2_RGB8 isn't supported.
+MTLPixelFormat SafeMTLPixelFormatETC2_RGB8();
+
 constexpr MTLPixelFormat ToMTLPixelFormat(PixelFormat format) {
   switch (format) {
     case PixelFormat::kUnknown:
@@ -94,6 +98,8 @@ constexpr MTLPixelFormat ToMTLPixelFormat(PixelFormat format) {
       return SafeMTLPixelFormatBGR10_XR();
     case PixelFormat::kB10G10R10A10XR:
       return SafeMTLPixelFormatBGRA10_XR();
+    case PixelFormat::kETC2R8G8B8UNormInt:
+      return SafeMTLPixelFormatETC2_RGB8();
   }
   return MTLPixelFormatInvalid;
 };
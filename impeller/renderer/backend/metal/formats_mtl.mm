@@ -128,4 +128,12 @@ MTLPixelFormat SafeMTLPixelFormatBGRA10_XR() {
   }
 }
 
+MTLPixelFormat SafeMTLPixelFormatETC2_RGB8() {
+  if (@available(iOS 8, macOS 11.0, *)) {
+    return MTLPixelFormatETC2_RGB8;
+  } else {
+    return MTLPixelFormatInvalid;
+  }
+}
+
 }  // namespace impeller
@@ -6,7 +6,10 @@
 
 #include <QuartzCore/CAMetalLayer.h>
 
+#include <optional>
+
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/surface.h"
 
@@ -42,8 +45,16 @@ class SurfaceMTL final : public Surface {
 
   id<MTLDrawable> drawable() const { return drawable_; }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the time at which the drawable should be shown, such as
+  ///             the target time of the frame. Without one, or if it has
+  ///             passed, the drawable is shown as soon as possible.
+  ///
+  void SetPresentationTime(std::optional<fml::TimePoint> presentation_time);
+
  private:
   id<MTLDrawable> drawable_ = nil;
+  std::optional<fml::TimePoint> presentation_time_;
 
   SurfaceMTL(const RenderTarget& target, id<MTLDrawable> drawable);
 
@@ -121,12 +121,26 @@ SurfaceMTL::SurfaceMTL(const RenderTarget& target, id<MTLDrawable> drawable)
 // |Surface|
 SurfaceMTL::~SurfaceMTL() = default;
 
+void SurfaceMTL::SetPresentationTime(
+    std::optional<fml::TimePoint> presentation_time) {
+  presentation_time_ = presentation_time;
+}
+
 // |Surface|
 bool SurfaceMTL::Present() const {
   if (drawable_ == nil) {
     return false;
   }
 
+  if (presentation_time_.has_value()) {
+    // The drawable is scheduled relative to the media time of Core Animation,
+    // whose clock may not match the one of fml::TimePoint.
+    const auto delay = presentation_time_.value() - fml::TimePoint::Now();
+    if (delay > fml::TimeDelta::Zero()) {
+      [drawable_ presentAtTime:CACurrentMediaTime() + delay.ToSecondsF()];
+      return true;
+    }
+  }
   [drawable_ present];
   return true;
 }
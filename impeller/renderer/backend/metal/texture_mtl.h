@@ -7,6 +7,7 @@
 #include <Metal/Metal.h>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/memory/memory_counter.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/core/texture.h"
 
@@ -31,10 +32,18 @@ class TextureMTL final : public Texture,
 
   bool GenerateMipmap(id<MTLBlitCommandEncoder> encoder);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Counts the memory of the texture on the "texture" memory
+  ///             counter for as long as it lives. Only called for textures
+  ///             that the allocator created the memory of.
+  ///
+  void CountAllocatedMemory();
+
  private:
   id<MTLTexture> texture_ = nullptr;
   bool is_valid_ = false;
   bool is_wrapped_ = false;
+  fml::ScopedMemoryCount memory_count_;
 
   // |Texture|
   void SetLabel(std::string_view label) override;
@@ -92,6 +92,18 @@ bool TextureMTL::IsWrapped() const {
   return is_wrapped_;
 }
 
+void TextureMTL::CountAllocatedMemory() {
+  if (!texture_) {
+    return;
+  }
+  static auto& counter = fml::MemoryCounter::Get("texture");
+  size_t bytes = GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  if (@available(macOS 10.13, iOS 11.0, tvOS 11.0, *)) {
+    bytes = texture_.allocatedSize;
+  }
+  memory_count_ = fml::ScopedMemoryCount(counter, bytes);
+}
+
 bool TextureMTL::GenerateMipmap(id<MTLBlitCommandEncoder> encoder) {
   if (!texture_) {
     return false;
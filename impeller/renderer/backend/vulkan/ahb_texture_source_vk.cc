@@ -0,0 +1,332 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/ahb_texture_source_vk.h"
+
+#include <optional>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
+
+namespace impeller {
+
+bool YUVConversionDescriptorVK::operator==(
+    const YUVConversionDescriptorVK& other) const {
+  return format == other.format && external_format == other.external_format &&
+         model == other.model && range == other.range &&
+         components == other.components &&
+         x_chroma_offset == other.x_chroma_offset &&
+         y_chroma_offset == other.y_chroma_offset &&
+         chroma_filter == other.chroma_filter;
+}
+
+YUVConversionVK::YUVConversionVK(const vk::Device& device,
+                                 const YUVConversionDescriptorVK& desc)
+    : desc_(desc) {
+  vk::StructureChain<vk::SamplerYcbcrConversionCreateInfo,
+                     vk::ExternalFormatANDROID>
+      conversion_chain;
+  auto& conversion_info =
+      conversion_chain.get<vk::SamplerYcbcrConversionCreateInfo>();
+  conversion_info.format = desc.format;
+  conversion_info.ycbcrModel = desc.model;
+  conversion_info.ycbcrRange = desc.range;
+  conversion_info.components = desc.components;
+  conversion_info.xChromaOffset = desc.x_chroma_offset;
+  conversion_info.yChromaOffset = desc.y_chroma_offset;
+  conversion_info.chromaFilter = desc.chroma_filter;
+  conversion_info.forceExplicitReconstruction = VK_FALSE;
+  conversion_chain.get<vk::ExternalFormatANDROID>().externalFormat =
+      desc.external_format;
+
+  auto [conversion_result, conversion] =
+      device.createSamplerYcbcrConversionUnique(conversion_info);
+  if (conversion_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create the YCbCr conversion: "
+                   << vk::to_string(conversion_result);
+    return;
+  }
+
+  vk::StructureChain<vk::SamplerCreateInfo, vk::SamplerYcbcrConversionInfo>
+      sampler_chain;
+  auto& sampler_info = sampler_chain.get<vk::SamplerCreateInfo>();
+  // Unless the format supports separate reconstruction filters, these must
+  // match the chroma filter.
+  sampler_info.magFilter = desc.chroma_filter;
+  sampler_info.minFilter = desc.chroma_filter;
+  sampler_info.mipmapMode = vk::SamplerMipmapMode::eNearest;
+  sampler_info.addressModeU = vk::SamplerAddressMode::eClampToEdge;
+  sampler_info.addressModeV = vk::SamplerAddressMode::eClampToEdge;
+  sampler_info.addressModeW = vk::SamplerAddressMode::eClampToEdge;
+  sampler_info.anisotropyEnable = VK_FALSE;
+  sampler_info.unnormalizedCoordinates = VK_FALSE;
+  sampler_chain.get<vk::SamplerYcbcrConversionInfo>().conversion =
+      conversion.get();
+
+  auto [sampler_result, sampler] = device.createSamplerUnique(sampler_info);
+  if (sampler_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create the YCbCr sampler: "
+                   << vk::to_string(sampler_result);
+    return;
+  }
+
+  SamplerDescriptor sampler_desc;
+  const auto filter = desc.chroma_filter == vk::Filter::eLinear
+                          ? MinMagFilter::kLinear
+                          : MinMagFilter::kNearest;
+  sampler_desc.min_filter = filter;
+  sampler_desc.mag_filter = filter;
+  sampler_desc.label = "YCbCr Sampler";
+
+  conversion_ = std::move(conversion);
+  sampler_ = std::make_shared<SamplerVK>(sampler_desc, std::move(sampler));
+}
+
+YUVConversionVK::~YUVConversionVK() = default;
+
+bool YUVConversionVK::IsValid() const {
+  return conversion_ && sampler_;
+}
+
+const YUVConversionDescriptorVK& YUVConversionVK::GetDescriptor() const {
+  return desc_;
+}
+
+vk::SamplerYcbcrConversion YUVConversionVK::GetConversion() const {
+  return conversion_.get();
+}
+
+const std::shared_ptr<SamplerVK>& YUVConversionVK::GetSampler() const {
+  return sampler_;
+}
+
+static bool IsYUVFormat(vk::Format format) {
+  switch (format) {
+    case vk::Format::eG8B8R83Plane420Unorm:
+    case vk::Format::eG8B8R82Plane420Unorm:
+    case vk::Format::eG10X6B10X6R10X62Plane420Unorm3Pack16:
+    case vk::Format::eG8B8R83Plane422Unorm:
+    case vk::Format::eG8B8R82Plane422Unorm:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static TextureDescriptor ToTextureDescriptor(const AHardwareBuffer_Desc& desc) {
+  TextureDescriptor texture_desc;
+  texture_desc.storage_mode = StorageMode::kDevicePrivate;
+  texture_desc.type = TextureType::kTexture2D;
+  // YUV buffers are sampled as RGB through their conversion.
+  texture_desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  texture_desc.size = ISize(desc.width, desc.height);
+  texture_desc.mip_count = 1u;
+  texture_desc.usage =
+      static_cast<TextureUsageMask>(TextureUsage::kShaderRead);
+  return texture_desc;
+}
+
+static std::optional<uint32_t> FindMemoryTypeIndex(uint32_t memory_type_bits) {
+  for (uint32_t i = 0; i < 32u; i++) {
+    if (memory_type_bits & (1u << i)) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+AHBTextureSourceVK::AHBTextureSourceVK(
+    const std::shared_ptr<ContextVK>& context,
+    AHardwareBuffer* buffer,
+    const AHardwareBuffer_Desc& ahb_desc,
+    std::shared_ptr<YUVConversionVK> yuv_conversion)
+    : TextureSourceVK(ToTextureDescriptor(ahb_desc)) {
+  TRACE_EVENT0("impeller", "AHBTextureSourceVK::Import");
+  if (!context || !buffer ||
+      !CapabilitiesVK::Cast(*context->GetCapabilities())
+           .SupportsAndroidHardwareBufferImport()) {
+    return;
+  }
+  const auto device = context->GetDevice();
+
+  auto [props_result, props_chain] =
+      device.getAndroidHardwareBufferPropertiesANDROID<
+          vk::AndroidHardwareBufferPropertiesANDROID,
+          vk::AndroidHardwareBufferFormatPropertiesANDROID>(*buffer);
+  if (props_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not get the properties of the hardware buffer: "
+                   << vk::to_string(props_result);
+    return;
+  }
+  const auto& props =
+      props_chain.get<vk::AndroidHardwareBufferPropertiesANDROID>();
+  const auto& format_props =
+      props_chain.get<vk::AndroidHardwareBufferFormatPropertiesANDROID>();
+
+  // Formats Vulkan doesn't know about, which is most of what decoders and
+  // cameras produce, are sampled through their external format.
+  const bool uses_external_format =
+      format_props.format == vk::Format::eUndefined;
+
+  //----------------------------------------------------------------------------
+  /// Create the image.
+  ///
+  vk::StructureChain<vk::ImageCreateInfo, vk::ExternalMemoryImageCreateInfo,
+                     vk::ExternalFormatANDROID>
+      image_chain;
+  auto& image_info = image_chain.get<vk::ImageCreateInfo>();
+  image_info.imageType = vk::ImageType::e2D;
+  image_info.format = format_props.format;
+  image_info.extent = vk::Extent3D{ahb_desc.width, ahb_desc.height, 1u};
+  image_info.mipLevels = 1u;
+  image_info.arrayLayers = 1u;
+  image_info.samples = vk::SampleCountFlagBits::e1;
+  image_info.tiling = vk::ImageTiling::eOptimal;
+  image_info.usage = vk::ImageUsageFlagBits::eSampled;
+  image_info.sharingMode = vk::SharingMode::eExclusive;
+  image_info.initialLayout = vk::ImageLayout::eUndefined;
+  image_chain.get<vk::ExternalMemoryImageCreateInfo>().handleTypes =
+      vk::ExternalMemoryHandleTypeFlagBits::eAndroidHardwareBufferANDROID;
+  if (uses_external_format) {
+    image_chain.get<vk::ExternalFormatANDROID>().externalFormat =
+        format_props.externalFormat;
+  } else {
+    image_chain.unlink<vk::ExternalFormatANDROID>();
+  }
+
+  auto [image_result, image] = device.createImageUnique(image_info);
+  if (image_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create the image of the hardware buffer: "
+                   << vk::to_string(image_result);
+    return;
+  }
+
+  //----------------------------------------------------------------------------
+  /// Import the memory of the buffer and bind it to the image.
+  ///
+  const auto memory_type_index = FindMemoryTypeIndex(props.memoryTypeBits);
+  if (!memory_type_index.has_value()) {
+    VALIDATION_LOG << "No memory type can import the hardware buffer.";
+    return;
+  }
+  vk::StructureChain<vk::MemoryAllocateInfo,
+                     vk::ImportAndroidHardwareBufferInfoANDROID,
+                     vk::MemoryDedicatedAllocateInfo>
+      memory_chain;
+  auto& memory_info = memory_chain.get<vk::MemoryAllocateInfo>();
+  memory_info.allocationSize = props.allocationSize;
+  memory_info.memoryTypeIndex = memory_type_index.value();
+  memory_chain.get<vk::ImportAndroidHardwareBufferInfoANDROID>().buffer =
+      buffer;
+  memory_chain.get<vk::MemoryDedicatedAllocateInfo>().image = image.get();
+
+  auto [memory_result, device_memory] =
+      device.allocateMemoryUnique(memory_info);
+  if (memory_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not import the memory of the hardware buffer: "
+                   << vk::to_string(memory_result);
+    return;
+  }
+  if (auto result = device.bindImageMemory(image.get(), device_memory.get(), 0);
+      result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not bind the memory of the hardware buffer: "
+                   << vk::to_string(result);
+    return;
+  }
+
+  //----------------------------------------------------------------------------
+  /// Find or create the YCbCr conversion.
+  ///
+  if (uses_external_format || IsYUVFormat(format_props.format)) {
+    YUVConversionDescriptorVK conversion_desc;
+    conversion_desc.format = format_props.format;
+    conversion_desc.external_format =
+        uses_external_format ? format_props.externalFormat : 0u;
+    conversion_desc.model = format_props.suggestedYcbcrModel;
+    conversion_desc.range = format_props.suggestedYcbcrRange;
+    conversion_desc.components = format_props.samplerYcbcrConversionComponents;
+    conversion_desc.x_chroma_offset = format_props.suggestedXChromaOffset;
+    conversion_desc.y_chroma_offset = format_props.suggestedYChromaOffset;
+    conversion_desc.chroma_filter =
+        (format_props.formatFeatures &
+         vk::FormatFeatureFlagBits::eSampledImageYcbcrConversionLinearFilter)
+            ? vk::Filter::eLinear
+            : vk::Filter::eNearest;
+    if (yuv_conversion && yuv_conversion->GetDescriptor() == conversion_desc) {
+      yuv_conversion_ = std::move(yuv_conversion);
+    } else {
+      yuv_conversion_ =
+          std::make_shared<YUVConversionVK>(device, conversion_desc);
+      if (!yuv_conversion_->IsValid()) {
+        return;
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Create the image view.
+  ///
+  vk::StructureChain<vk::ImageViewCreateInfo, vk::SamplerYcbcrConversionInfo>
+      view_chain;
+  auto& view_info = view_chain.get<vk::ImageViewCreateInfo>();
+  view_info.image = image.get();
+  view_info.viewType = vk::ImageViewType::e2D;
+  view_info.format = format_props.format;
+  view_info.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+  view_info.subresourceRange.baseMipLevel = 0u;
+  view_info.subresourceRange.baseArrayLayer = 0u;
+  view_info.subresourceRange.levelCount = 1u;
+  view_info.subresourceRange.layerCount = 1u;
+  if (yuv_conversion_) {
+    view_chain.get<vk::SamplerYcbcrConversionInfo>().conversion =
+        yuv_conversion_->GetConversion();
+  } else {
+    view_chain.unlink<vk::SamplerYcbcrConversionInfo>();
+  }
+
+  auto [view_result, image_view] = device.createImageViewUnique(view_info);
+  if (view_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create the image view of the hardware buffer: "
+                   << vk::to_string(view_result);
+    return;
+  }
+
+  ContextVK::SetDebugName(device, image.get(), "AHB Image");
+  ContextVK::SetDebugName(device, image_view.get(), "AHB Image View");
+
+  image_ = std::move(image);
+  device_memory_ = std::move(device_memory);
+  image_view_ = std::move(image_view);
+  is_valid_ = true;
+}
+
+// |TextureSourceVK|
+AHBTextureSourceVK::~AHBTextureSourceVK() = default;
+
+bool AHBTextureSourceVK::IsValid() const {
+  return is_valid_;
+}
+
+// |TextureSourceVK|
+vk::Image AHBTextureSourceVK::GetImage() const {
+  return image_.get();
+}
+
+// |TextureSourceVK|
+vk::ImageView AHBTextureSourceVK::GetImageView() const {
+  return image_view_.get();
+}
+
+// |TextureSourceVK|
+std::shared_ptr<SamplerVK> AHBTextureSourceVK::GetImmutableSamplerVariant()
+    const {
+  return yuv_conversion_ ? yuv_conversion_->GetSampler() : nullptr;
+}
+
+const std::shared_ptr<YUVConversionVK>& AHBTextureSourceVK::GetYUVConversion()
+    const {
+  return yuv_conversion_;
+}
+
+}  // namespace impeller
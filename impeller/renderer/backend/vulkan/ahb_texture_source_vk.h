@@ -0,0 +1,128 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <android/hardware_buffer.h>
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/sampler_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_source_vk.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+struct YUVConversionDescriptorVK {
+  vk::Format format = vk::Format::eUndefined;
+  /// The Android external format, used when the format is undefined.
+  uint64_t external_format = 0u;
+  vk::SamplerYcbcrModelConversion model =
+      vk::SamplerYcbcrModelConversion::eRgbIdentity;
+  vk::SamplerYcbcrRange range = vk::SamplerYcbcrRange::eItuFull;
+  vk::ComponentMapping components;
+  vk::ChromaLocation x_chroma_offset = vk::ChromaLocation::eCositedEven;
+  vk::ChromaLocation y_chroma_offset = vk::ChromaLocation::eCositedEven;
+  vk::Filter chroma_filter = vk::Filter::eNearest;
+
+  bool operator==(const YUVConversionDescriptorVK& other) const;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A YCbCr conversion along with the immutable sampler that
+///             samples images through it.
+///
+///             Conversions only depend on the format of the buffers, so all
+///             of the buffers of a stream share one, and with it the pipeline
+///             variants that sample them.
+///
+class YUVConversionVK {
+ public:
+  YUVConversionVK(const vk::Device& device,
+                  const YUVConversionDescriptorVK& desc);
+
+  ~YUVConversionVK();
+
+  bool IsValid() const;
+
+  const YUVConversionDescriptorVK& GetDescriptor() const;
+
+  vk::SamplerYcbcrConversion GetConversion() const;
+
+  const std::shared_ptr<SamplerVK>& GetSampler() const;
+
+ private:
+  const YUVConversionDescriptorVK desc_;
+  vk::UniqueSamplerYcbcrConversion conversion_;
+  std::shared_ptr<SamplerVK> sampler_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(YUVConversionVK);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      A texture source that imports an `AHardwareBuffer` without
+///             copying it, through
+///             `VK_ANDROID_external_memory_android_hardware_buffer`.
+///
+///             Buffers in a YUV or driver specific format, which is what
+///             camera and video decoders produce, are sampled as RGB through
+///             a YCbCr conversion.
+///
+///             The imported memory holds a reference to the buffer. It is
+///             still up to the caller to keep the producer from writing into
+///             the buffer while it is being sampled.
+///
+///             Only available when
+///             `CapabilitiesVK::SupportsAndroidHardwareBufferImport`.
+///
+class AHBTextureSourceVK final : public TextureSourceVK {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Imports the buffer.
+  ///
+  /// @param[in]  context         The context.
+  /// @param[in]  buffer          The buffer to import.
+  /// @param[in]  ahb_desc        The description of the buffer.
+  /// @param[in]  yuv_conversion  The conversion of a previously imported
+  ///                             buffer of the same stream. It is reused if
+  ///                             it is compatible with this buffer.
+  ///
+  AHBTextureSourceVK(const std::shared_ptr<ContextVK>& context,
+                     AHardwareBuffer* buffer,
+                     const AHardwareBuffer_Desc& ahb_desc,
+                     std::shared_ptr<YUVConversionVK> yuv_conversion = nullptr);
+
+  // |TextureSourceVK|
+  ~AHBTextureSourceVK() override;
+
+  bool IsValid() const;
+
+  // |TextureSourceVK|
+  vk::Image GetImage() const override;
+
+  // |TextureSourceVK|
+  vk::ImageView GetImageView() const override;
+
+  // |TextureSourceVK|
+  std::shared_ptr<SamplerVK> GetImmutableSamplerVariant() const override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The conversion the buffer is sampled through, if any. Pass it
+  ///             along when importing the next buffer of the stream.
+  ///
+  const std::shared_ptr<YUVConversionVK>& GetYUVConversion() const;
+
+ private:
+  vk::UniqueDeviceMemory device_memory_;
+  vk::UniqueImage image_;
+  vk::UniqueImageView image_view_;
+  std::shared_ptr<YUVConversionVK> yuv_conversion_;
+  bool is_valid_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AHBTextureSourceVK);
+};
+
+}  // namespace impeller
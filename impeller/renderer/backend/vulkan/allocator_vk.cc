@@ -5,7 +5,9 @@
 #include "impeller/renderer/backend/vulkan/allocator_vk.h"
 
 #include <memory>
+#include <vector>
 
+#include "flutter/fml/memory/memory_counter.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
@@ -14,13 +16,25 @@
 
 namespace impeller {
 
+static constexpr vk::BufferUsageFlags kBufferUsageFlags =
+    vk::BufferUsageFlagBits::eVertexBuffer |
+    vk::BufferUsageFlagBits::eIndexBuffer |
+    vk::BufferUsageFlagBits::eUniformBuffer |
+    vk::BufferUsageFlagBits::eTransferSrc |
+    vk::BufferUsageFlagBits::eTransferDst;
+
+// Large enough for the host buffers of a few frames, but much smaller than
+// the blocks VMA picks for large heaps by default.
+static constexpr VkDeviceSize kStagingBufferPoolBlockSize = 4u * 1024u * 1024u;
+
 AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
                          uint32_t vulkan_api_version,
                          const vk::PhysicalDevice& physical_device,
                          const vk::Device& logical_device,
                          const vk::Instance& instance,
                          PFN_vkGetInstanceProcAddr get_instance_proc_address,
-                         PFN_vkGetDeviceProcAddr get_device_proc_address)
+                         PFN_vkGetDeviceProcAddr get_device_proc_address,
+                         bool enable_memory_budget)
     : context_(std::move(context)), device_(logical_device) {
   vk_ = fml::MakeRefCounted<vulkan::VulkanProcTable>(get_instance_proc_address);
 
@@ -81,6 +95,9 @@ AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
   allocator_info.device = logical_device;
   allocator_info.instance = instance;
   allocator_info.pVulkanFunctions = &proc_table;
+  if (enable_memory_budget) {
+    allocator_info.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+  }
 
   VmaAllocator allocator = {};
   auto result = vk::Result{::vmaCreateAllocator(&allocator_info, &allocator)};
@@ -89,15 +106,41 @@ AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
     return;
   }
   allocator_ = allocator;
+  staging_buffer_pool_ = CreateStagingBufferPool(allocator_);
   is_valid_ = true;
 }
 
 AllocatorVK::~AllocatorVK() {
+  if (staging_buffer_pool_) {
+    ::vmaDestroyPool(allocator_, staging_buffer_pool_);
+  }
   if (allocator_) {
     ::vmaDestroyAllocator(allocator_);
   }
 }
 
+// |Allocator|
+std::optional<DeviceMemoryBudget> AllocatorVK::GetDeviceMemoryBudget() const {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+  const VkPhysicalDeviceMemoryProperties* memory_properties = nullptr;
+  ::vmaGetMemoryProperties(allocator_, &memory_properties);
+  // Without VK_EXT_memory_budget, VMA estimates the usage from its own
+  // allocations and the budget from the heap sizes.
+  std::vector<VmaBudget> budgets(memory_properties->memoryHeapCount);
+  ::vmaGetHeapBudgets(allocator_, budgets.data());
+  DeviceMemoryBudget result;
+  for (auto i = 0u; i < memory_properties->memoryHeapCount; i++) {
+    if (memory_properties->memoryHeaps[i].flags &
+        VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+      result.usage += budgets[i].usage;
+      result.budget += budgets[i].budget;
+    }
+  }
+  return result;
+}
+
 // |Allocator|
 bool AllocatorVK::IsValid() const {
   return is_valid_;
@@ -208,6 +251,49 @@ static VmaAllocationCreateFlags ToVmaAllocationCreateFlags(StorageMode mode,
   FML_UNREACHABLE();
 }
 
+// static
+VmaPool AllocatorVK::CreateStagingBufferPool(VmaAllocator allocator) {
+  vk::BufferCreateInfo buffer_info;
+  buffer_info.usage = kBufferUsageFlags;
+  buffer_info.size = 1u;
+  buffer_info.sharingMode = vk::SharingMode::eExclusive;
+  auto buffer_info_native =
+      static_cast<vk::BufferCreateInfo::NativeType>(buffer_info);
+
+  VmaAllocationCreateInfo allocation_info = {};
+  allocation_info.usage = VMA_MEMORY_USAGE_AUTO;
+  allocation_info.preferredFlags =
+      ToVKMemoryPropertyFlags(StorageMode::kHostVisible, false);
+  allocation_info.flags =
+      ToVmaAllocationCreateFlags(StorageMode::kHostVisible, false);
+
+  uint32_t memory_type_index = 0u;
+  auto result = vk::Result{::vmaFindMemoryTypeIndexForBufferInfo(
+      allocator, &buffer_info_native, &allocation_info, &memory_type_index)};
+  if (result != vk::Result::eSuccess) {
+    return {};
+  }
+
+  VmaPoolCreateInfo pool_info = {};
+  pool_info.memoryTypeIndex = memory_type_index;
+  pool_info.blockSize = kStagingBufferPoolBlockSize;
+  // Buffers and images never share the blocks of this pool.
+  pool_info.flags = VMA_POOL_CREATE_IGNORE_BUFFER_IMAGE_GRANULARITY_BIT;
+
+  VmaPool pool = {};
+  result = vk::Result{::vmaCreatePool(allocator, &pool_info, &pool)};
+  if (result != vk::Result::eSuccess) {
+    return {};
+  }
+  ::vmaSetPoolName(allocator, pool, "Staging Buffer Pool");
+  return pool;
+}
+
+static fml::MemoryCounter& GetTextureMemoryCounter() {
+  static auto& counter = fml::MemoryCounter::Get("texture");
+  return counter;
+}
+
 class AllocatedTextureSourceVK final : public TextureSourceVK {
  public:
   AllocatedTextureSourceVK(const TextureDescriptor& desc,
@@ -271,6 +357,8 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
     image_ = vk::Image{vk_image};
     allocator_ = allocator;
     allocation_ = allocation;
+    memory_count_ =
+        fml::ScopedMemoryCount(GetTextureMemoryCounter(), allocation_info.size);
 
     vk::ImageViewCreateInfo view_info = {};
     view_info.image = image_;
@@ -322,6 +410,7 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
   VmaAllocator allocator_ = {};
   VmaAllocation allocation_ = {};
   vk::UniqueImageView image_view_;
+  fml::ScopedMemoryCount memory_count_;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AllocatedTextureSourceVK);
@@ -347,11 +436,7 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
 std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
     const DeviceBufferDescriptor& desc) {
   vk::BufferCreateInfo buffer_info;
-  buffer_info.usage = vk::BufferUsageFlagBits::eVertexBuffer |
-                      vk::BufferUsageFlagBits::eIndexBuffer |
-                      vk::BufferUsageFlagBits::eUniformBuffer |
-                      vk::BufferUsageFlagBits::eTransferSrc |
-                      vk::BufferUsageFlagBits::eTransferDst;
+  buffer_info.usage = kBufferUsageFlags;
   buffer_info.size = desc.size;
   buffer_info.sharingMode = vk::SharingMode::eExclusive;
   auto buffer_info_native =
@@ -362,6 +447,11 @@ std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
   allocation_info.preferredFlags =
       ToVKMemoryPropertyFlags(desc.storage_mode, false);
   allocation_info.flags = ToVmaAllocationCreateFlags(desc.storage_mode, false);
+  // Buffers larger than a block of the pool get blocks of their own anyway.
+  if (desc.storage_mode == StorageMode::kHostVisible && staging_buffer_pool_ &&
+      desc.size <= kStagingBufferPoolBlockSize) {
+    allocation_info.pool = staging_buffer_pool_;
+  }
 
   VkBuffer buffer = {};
   VmaAllocation buffer_allocation = {};
@@ -13,6 +13,7 @@
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 #include <memory>
+#include <optional>
 
 namespace impeller {
 
@@ -21,11 +22,17 @@ class AllocatorVK final : public Allocator {
   // |Allocator|
   ~AllocatorVK() override;
 
+  // |Allocator|
+  std::optional<DeviceMemoryBudget> GetDeviceMemoryBudget() const override;
+
  private:
   friend class ContextVK;
 
   fml::RefPtr<vulkan::VulkanProcTable> vk_;
   VmaAllocator allocator_ = {};
+  // Host visible buffers are small and short lived, and are suballocated from
+  // blocks of this pool instead of the default blocks of their memory type.
+  VmaPool staging_buffer_pool_ = {};
   std::weak_ptr<Context> context_;
   vk::Device device_;
   ISize max_texture_size_;
@@ -37,7 +44,10 @@ class AllocatorVK final : public Allocator {
               const vk::Device& logical_device,
               const vk::Instance& instance,
               PFN_vkGetInstanceProcAddr get_instance_proc_address,
-              PFN_vkGetDeviceProcAddr get_device_proc_address);
+              PFN_vkGetDeviceProcAddr get_device_proc_address,
+              bool enable_memory_budget);
+
+  static VmaPool CreateStagingBufferPool(VmaAllocator allocator);
 
   // |Allocator|
   bool IsValid() const;
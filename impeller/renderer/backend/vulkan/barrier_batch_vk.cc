@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/barrier_batch_vk.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+/// Narrows the source scope of a transition to the accesses that an image in
+/// the old layout can have been subject to.
+static void NarrowSourceScope(vk::ImageLayout old_layout,
+                              vk::PipelineStageFlags& stage,
+                              vk::AccessFlags& access) {
+  switch (old_layout) {
+    case vk::ImageLayout::eUndefined:
+      // The contents are discarded, there is nothing to wait on.
+      stage = vk::PipelineStageFlagBits::eTopOfPipe;
+      access = {};
+      return;
+    case vk::ImageLayout::eColorAttachmentOptimal:
+      stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+      access = vk::AccessFlagBits::eColorAttachmentWrite;
+      return;
+    case vk::ImageLayout::eTransferDstOptimal:
+      stage = vk::PipelineStageFlagBits::eTransfer;
+      access = vk::AccessFlagBits::eTransferWrite;
+      return;
+    case vk::ImageLayout::eTransferSrcOptimal:
+      // Reads only need an execution dependency.
+      stage = vk::PipelineStageFlagBits::eTransfer;
+      access = {};
+      return;
+    case vk::ImageLayout::eShaderReadOnlyOptimal:
+      stage = vk::PipelineStageFlagBits::eVertexShader |
+              vk::PipelineStageFlagBits::eFragmentShader |
+              vk::PipelineStageFlagBits::eComputeShader;
+      access = {};
+      return;
+    default:
+      // Images in the general layout may have been written by anything, keep
+      // the scope of the caller.
+      return;
+  }
+}
+
+BarrierBatchVK::BarrierBatchVK(vk::CommandBuffer cmd_buffer)
+    : cmd_buffer_(cmd_buffer) {}
+
+BarrierBatchVK::~BarrierBatchVK() {
+  FML_DCHECK(image_barriers_.empty())
+      << "Layout transitions were batched but never encoded.";
+}
+
+void BarrierBatchVK::AddLayoutTransition(const TextureSourceVK& source,
+                                         const LayoutTransition& transition) {
+  const auto old_layout =
+      source.SetLayoutWithoutEncoding(transition.new_layout);
+  if (old_layout == transition.new_layout) {
+    return;
+  }
+
+  auto src_stage = transition.src_stage;
+  auto src_access = transition.src_access;
+  NarrowSourceScope(old_layout, src_stage, src_access);
+
+  const auto& desc = source.GetTextureDescriptor();
+  vk::ImageMemoryBarrier image_barrier;
+  image_barrier.srcAccessMask = src_access;
+  image_barrier.dstAccessMask = transition.dst_access;
+  image_barrier.oldLayout = old_layout;
+  image_barrier.newLayout = transition.new_layout;
+  image_barrier.image = source.GetImage();
+  image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  image_barrier.subresourceRange.aspectMask = ToImageAspectFlags(desc.format);
+  image_barrier.subresourceRange.baseMipLevel = 0u;
+  image_barrier.subresourceRange.levelCount = desc.mip_count;
+  image_barrier.subresourceRange.baseArrayLayer = 0u;
+  image_barrier.subresourceRange.layerCount = ToArrayLayerCount(desc.type);
+  image_barriers_.push_back(image_barrier);
+
+  src_stage_ |= src_stage;
+  dst_stage_ |= transition.dst_stage;
+}
+
+void BarrierBatchVK::Encode() {
+  if (image_barriers_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "BarrierBatchVK::Encode");
+  cmd_buffer_.pipelineBarrier(src_stage_,      // src stage
+                              dst_stage_,      // dst stage
+                              {},              // dependency flags
+                              nullptr,         // memory barriers
+                              nullptr,         // buffer barriers
+                              image_barriers_  // image barriers
+  );
+  image_barriers_.clear();
+  src_stage_ = {};
+  dst_stage_ = {};
+}
+
+size_t BarrierBatchVK::GetBarrierCount() const {
+  return image_barriers_.size();
+}
+
+}  // namespace impeller
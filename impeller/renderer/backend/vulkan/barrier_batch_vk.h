@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/formats_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_source_vk.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the image layout transitions needed before a render
+///             pass or a blit and records all of them with a single
+///             `vkCmdPipelineBarrier`, instead of one barrier per texture.
+///
+///             The source scope of each transition is narrowed to what can
+///             have touched the image in its old layout. For instance, an
+///             image leaving the transfer destination layout only waits on
+///             transfer writes, not on every stage the caller listed.
+///
+///             Textures already in the requested layout don't add a barrier,
+///             so a texture bound by many commands of a pass is only
+///             transitioned once.
+///
+class BarrierBatchVK {
+ public:
+  explicit BarrierBatchVK(vk::CommandBuffer cmd_buffer);
+
+  ~BarrierBatchVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Updates the layout tracked for the texture and queues the
+  ///             barrier for the transition, if any. The command buffer of
+  ///             the transition is ignored.
+  ///
+  void AddLayoutTransition(const TextureSourceVK& source,
+                           const LayoutTransition& transition);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the queued barriers, if any, and clears the batch.
+  ///
+  void Encode();
+
+  size_t GetBarrierCount() const;
+
+ private:
+  const vk::CommandBuffer cmd_buffer_;
+  std::vector<vk::ImageMemoryBarrier> image_barriers_;
+  vk::PipelineStageFlags src_stage_ = {};
+  vk::PipelineStageFlags dst_stage_ = {};
+
+  FML_DISALLOW_COPY_AND_ASSIGN(BarrierBatchVK);
+};
+
+}  // namespace impeller
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/vulkan/blit_command_vk.h"
 
+#include "impeller/renderer/backend/vulkan/barrier_batch_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
 
@@ -30,7 +31,6 @@ bool BlitCopyTextureToTextureCommandVK::Encode(
   const auto& dst = TextureVK::Cast(*destination);
 
   LayoutTransition src_tran;
-  src_tran.cmd_buffer = cmd_buffer;
   src_tran.new_layout = vk::ImageLayout::eTransferSrcOptimal;
   src_tran.src_access = vk::AccessFlagBits::eTransferWrite |
                         vk::AccessFlagBits::eShaderWrite |
@@ -42,18 +42,25 @@ bool BlitCopyTextureToTextureCommandVK::Encode(
   src_tran.dst_stage = vk::PipelineStageFlagBits::eTransfer;
 
   LayoutTransition dst_tran;
-  dst_tran.cmd_buffer = cmd_buffer;
   dst_tran.new_layout = vk::ImageLayout::eTransferDstOptimal;
   dst_tran.src_access = {};
   dst_tran.src_stage = vk::PipelineStageFlagBits::eTopOfPipe;
-  dst_tran.dst_access = vk::AccessFlagBits::eShaderRead;
-  dst_tran.dst_stage = vk::PipelineStageFlagBits::eFragmentShader;
+  dst_tran.dst_access = vk::AccessFlagBits::eTransferWrite;
+  dst_tran.dst_stage = vk::PipelineStageFlagBits::eTransfer;
 
-  if (!src.SetLayout(src_tran) || !dst.SetLayout(dst_tran)) {
+  auto src_source = src.GetTextureSource();
+  auto dst_source = dst.GetTextureSource();
+  if (!src_source || !dst_source) {
     VALIDATION_LOG << "Could not complete layout transitions.";
     return false;
   }
 
+  // Both transitions go in the same barrier.
+  BarrierBatchVK barriers(cmd_buffer);
+  barriers.AddLayoutTransition(*src_source, src_tran);
+  barriers.AddLayoutTransition(*dst_source, dst_tran);
+  barriers.Encode();
+
   vk::ImageCopy image_copy;
 
   image_copy.setSrcSubresource(
@@ -136,6 +143,63 @@ bool BlitCopyTextureToBufferCommandVK::Encode(CommandEncoderVK& encoder) const {
   return true;
 }
 
+//------------------------------------------------------------------------------
+/// BlitCopyBufferToTextureCommandVK
+///
+
+BlitCopyBufferToTextureCommandVK::~BlitCopyBufferToTextureCommandVK() = default;
+
+std::string BlitCopyBufferToTextureCommandVK::GetLabel() const {
+  return label;
+}
+
+bool BlitCopyBufferToTextureCommandVK::Encode(CommandEncoderVK& encoder) const {
+  const auto& cmd_buffer = encoder.GetCommandBuffer();
+
+  // Like the other backends, blits read straight from device buffers.
+  auto src = std::static_pointer_cast<const DeviceBuffer>(source.buffer);
+  const auto& dst = TextureVK::Cast(*destination);
+
+  if (!encoder.Track(src) || !encoder.Track(destination)) {
+    return false;
+  }
+
+  // Only the region is overwritten so the existing contents of the image must
+  // be preserved. The previous layout is kept track of by the texture.
+  LayoutTransition transition;
+  transition.cmd_buffer = cmd_buffer;
+  transition.new_layout = vk::ImageLayout::eTransferDstOptimal;
+  transition.src_access = {};
+  transition.src_stage = vk::PipelineStageFlagBits::eFragmentShader |
+                         vk::PipelineStageFlagBits::eTransfer;
+  transition.dst_access = vk::AccessFlagBits::eTransferWrite;
+  transition.dst_stage = vk::PipelineStageFlagBits::eTransfer;
+
+  if (!dst.SetLayout(transition)) {
+    VALIDATION_LOG << "Could not encode layout transition.";
+    return false;
+  }
+
+  vk::BufferImageCopy image_copy;
+  image_copy.setBufferOffset(source.range.offset);
+  image_copy.setBufferRowLength(0);    // 0u means tightly packed per spec.
+  image_copy.setBufferImageHeight(0);  // 0u means tightly packed per spec.
+  image_copy.setImageSubresource(
+      vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1));
+  image_copy.setImageOffset(vk::Offset3D(destination_region.origin.x,
+                                         destination_region.origin.y, 0));
+  image_copy.setImageExtent(vk::Extent3D(destination_region.size.width,
+                                         destination_region.size.height, 1));
+
+  cmd_buffer.copyBufferToImage(DeviceBufferVK::Cast(*src).GetBuffer(),  //
+                               dst.GetImage(),                          //
+                               transition.new_layout,                   //
+                               image_copy                               //
+  );
+
+  return true;
+}
+
 //------------------------------------------------------------------------------
 /// BlitGenerateMipmapCommandVK
 ///
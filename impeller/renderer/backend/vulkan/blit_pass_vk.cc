@@ -87,6 +87,23 @@ bool BlitPassVK::OnCopyTextureToBufferCommand(
   return true;
 }
 
+// |BlitPass|
+bool BlitPassVK::OnCopyBufferToTextureCommand(
+    BufferView source,
+    std::shared_ptr<Texture> destination,
+    IRect destination_region,
+    std::string label) {
+  auto command = std::make_unique<BlitCopyBufferToTextureCommandVK>();
+
+  command->source = std::move(source);
+  command->destination = std::move(destination);
+  command->destination_region = destination_region;
+  command->label = std::move(label);
+
+  commands_.push_back(std::move(command));
+  return true;
+}
+
 // |BlitPass|
 bool BlitPassVK::OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
                                          std::string label) {
@@ -174,9 +174,62 @@ CapabilitiesVK::GetRequiredDeviceExtensions(
   if (exts.find("VK_KHR_portability_subset") != exts.end()) {
     required.push_back("VK_KHR_portability_subset");
   }
+
+  // Optional, lets the compositor update only the damaged area of partially
+  // repainted frames.
+  if (exts.find("VK_KHR_incremental_present") != exts.end()) {
+    required.push_back("VK_KHR_incremental_present");
+  }
+
+  // Optional, lets the allocator track how much device memory the process may
+  // use before the system starts to struggle.
+  if (exts.find("VK_EXT_memory_budget") != exts.end()) {
+    required.push_back("VK_EXT_memory_budget");
+  }
+
+  // Optional, lets external textures sample the buffers of image readers
+  // without copies. The other dependencies of the extension are core in
+  // Vulkan 1.1.
+  if (CanImportAndroidHardwareBuffers(physical_device)) {
+    required.push_back("VK_ANDROID_external_memory_android_hardware_buffer");
+    required.push_back("VK_EXT_queue_family_foreign");
+  }
   return required;
 }
 
+bool CapabilitiesVK::CanImportAndroidHardwareBuffers(
+    const vk::PhysicalDevice& physical_device) {
+#if FML_OS_ANDROID
+  if (physical_device.getProperties().apiVersion < VK_API_VERSION_1_1) {
+    return false;
+  }
+  auto device_extensions = physical_device.enumerateDeviceExtensionProperties();
+  if (device_extensions.result != vk::Result::eSuccess) {
+    return false;
+  }
+  bool has_ahb_extension = false;
+  bool has_foreign_queue_extension = false;
+  for (const auto& device_extension : device_extensions.value) {
+    const std::string name = device_extension.extensionName;
+    if (name == "VK_ANDROID_external_memory_android_hardware_buffer") {
+      has_ahb_extension = true;
+    } else if (name == "VK_EXT_queue_family_foreign") {
+      has_foreign_queue_extension = true;
+    }
+  }
+  if (!has_ahb_extension || !has_foreign_queue_extension) {
+    return false;
+  }
+  auto features = physical_device.getFeatures2<
+      vk::PhysicalDeviceFeatures2,
+      vk::PhysicalDeviceSamplerYcbcrConversionFeatures>();
+  return features.get<vk::PhysicalDeviceSamplerYcbcrConversionFeatures>()
+      .samplerYcbcrConversion;
+#else
+  return false;
+#endif  // FML_OS_ANDROID
+}
+
 static bool HasSuitableColorFormat(const vk::PhysicalDevice& device,
                                    vk::Format format) {
   const auto props = device.getFormatProperties(format);
@@ -256,6 +309,10 @@ CapabilitiesVK::GetRequiredDeviceFeatures(
   // necessarily a big deal if we don't have this feature.
   required.fillModeNonSolid = device_features.fillModeNonSolid;
 
+  // Compressed textures are only created when this is supported, see
+  // `SupportsTextureCompressionETC2`.
+  required.textureCompressionETC2 = device_features.textureCompressionETC2;
+
   return required;
 }
 
@@ -295,9 +352,44 @@ bool CapabilitiesVK::SetDevice(const vk::PhysicalDevice& device) {
 
   device_properties_ = device.getProperties();
 
+  supports_incremental_present_ = false;
+  supports_memory_budget_ = false;
+  supports_android_hardware_buffer_import_ =
+      CanImportAndroidHardwareBuffers(device);
+  if (auto device_extensions = device.enumerateDeviceExtensionProperties();
+      device_extensions.result == vk::Result::eSuccess) {
+    for (const auto& device_extension : device_extensions.value) {
+      const std::string name = device_extension.extensionName;
+      if (name == "VK_KHR_incremental_present") {
+        supports_incremental_present_ = true;
+      } else if (name == "VK_EXT_memory_budget") {
+        supports_memory_budget_ = true;
+      }
+    }
+  }
+
+  supports_texture_compression_etc2_ =
+      device.getFeatures().textureCompressionETC2 &&
+      static_cast<bool>(
+          device.getFormatProperties(vk::Format::eEtc2R8G8B8UnormBlock)
+              .optimalTilingFeatures &
+          vk::FormatFeatureFlagBits::eSampledImage);
+
   return true;
 }
 
+bool CapabilitiesVK::SupportsIncrementalPresent() const {
+  return supports_incremental_present_;
+}
+
+bool CapabilitiesVK::SupportsMemoryBudget() const {
+  return supports_memory_budget_;
+}
+
+bool CapabilitiesVK::SupportsAndroidHardwareBufferImport() const {
+  return supports_android_hardware_buffer_import_;
+}
+
 // |Capabilities|
 bool CapabilitiesVK::HasThreadingRestrictions() const {
   return false;
@@ -318,6 +410,11 @@ bool CapabilitiesVK::SupportsTextureToTextureBlits() const {
   return true;
 }
 
+// |Capabilities|
+bool CapabilitiesVK::SupportsBufferToTextureBlits() const {
+  return true;
+}
+
 // |Capabilities|
 bool CapabilitiesVK::SupportsFramebufferFetch() const {
   return false;
@@ -347,6 +444,11 @@ bool CapabilitiesVK::SupportsDecalTileMode() const {
   return true;
 }
 
+// |Capabilities|
+bool CapabilitiesVK::SupportsTextureCompressionETC2() const {
+  return supports_texture_compression_etc2_;
+}
+
 // |Capabilities|
 PixelFormat CapabilitiesVK::GetDefaultColorFormat() const {
   return color_format_;
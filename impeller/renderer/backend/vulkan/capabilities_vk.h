@@ -42,10 +42,39 @@ class CapabilitiesVK final : public Capabilities,
   std::optional<vk::PhysicalDeviceFeatures> GetRequiredDeviceFeatures(
       const vk::PhysicalDevice& physical_device) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the device can import Android hardware buffers and
+  ///             sample them through YCbCr conversions. When it can, the
+  ///             extensions are part of the required device extensions and
+  ///             the `samplerYcbcrConversion` feature must be enabled along
+  ///             with the required features.
+  ///
+  static bool CanImportAndroidHardwareBuffers(
+      const vk::PhysicalDevice& physical_device);
+
   [[nodiscard]] bool SetDevice(const vk::PhysicalDevice& physical_device);
 
   const vk::PhysicalDeviceProperties& GetPhysicalDeviceProperties() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether VK_KHR_incremental_present is enabled, so that
+  ///             presents can be limited to the damaged area of the frame.
+  ///
+  bool SupportsIncrementalPresent() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether VK_EXT_memory_budget is enabled, so that the
+  ///             allocator can report the device memory budget of the
+  ///             process.
+  ///
+  bool SupportsMemoryBudget() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether `AHardwareBuffer`s can be imported as textures. See
+  ///             `CanImportAndroidHardwareBuffers`.
+  ///
+  bool SupportsAndroidHardwareBufferImport() const;
+
   // |Capabilities|
   bool HasThreadingRestrictions() const override;
 
@@ -58,6 +87,9 @@ class CapabilitiesVK final : public Capabilities,
   // |Capabilities|
   bool SupportsTextureToTextureBlits() const override;
 
+  // |Capabilities|
+  bool SupportsBufferToTextureBlits() const override;
+
   // |Capabilities|
   bool SupportsFramebufferFetch() const override;
 
@@ -76,6 +108,9 @@ class CapabilitiesVK final : public Capabilities,
   // |Capabilities|
   bool SupportsDecalTileMode() const override;
 
+  // |Capabilities|
+  bool SupportsTextureCompressionETC2() const override;
+
   // |Capabilities|
   PixelFormat GetDefaultColorFormat() const override;
 
@@ -88,6 +123,10 @@ class CapabilitiesVK final : public Capabilities,
   PixelFormat color_format_ = PixelFormat::kUnknown;
   PixelFormat depth_stencil_format_ = PixelFormat::kUnknown;
   vk::PhysicalDeviceProperties device_properties_;
+  bool supports_incremental_present_ = false;
+  bool supports_memory_budget_ = false;
+  bool supports_android_hardware_buffer_import_ = false;
+  bool supports_texture_compression_etc2_ = false;
   bool is_valid_ = false;
 
   bool HasExtension(const std::string& ext) const;
@@ -9,14 +9,17 @@
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
+#include "impeller/renderer/gpu_tracer.h"
 
 namespace impeller {
 
 class TrackedObjectsVK {
  public:
-  explicit TrackedObjectsVK(const vk::Device& device,
-                            const std::shared_ptr<CommandPoolVK>& pool)
-      : desc_pool_(device) {
+  explicit TrackedObjectsVK(
+      const vk::Device& device,
+      const std::shared_ptr<CommandPoolVK>& pool,
+      std::weak_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler)
+      : desc_pool_(device, std::move(descriptor_pool_recycler)) {
     if (!pool) {
       return;
     }
@@ -25,7 +28,7 @@ class TrackedObjectsVK {
       return;
     }
     pool_ = pool;
-    buffer_ = std::move(buffer);
+    buffer_ = buffer;
     is_valid_ = true;
   }
 
@@ -39,11 +42,40 @@ class TrackedObjectsVK {
           << "Command pool died before a command buffer could be recycled.";
       return;
     }
-    pool->CollectGraphicsCommandBuffer(std::move(buffer_));
+    pool->CollectGraphicsCommandBuffer(buffer_);
+    pool->CollectGraphicsCommandBuffer(acquire_buffer_);
+    for (const auto& [secondary_pool, secondary_buffer] : secondary_buffers_) {
+      if (auto strong_pool = secondary_pool.lock()) {
+        strong_pool->CollectGraphicsCommandBuffer(secondary_buffer);
+      }
+    }
   }
 
   bool IsValid() const { return is_valid_; }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the command buffer that acquires textures released
+  ///             by other queue families, which is submitted ahead of the
+  ///             main command buffer.
+  ///
+  vk::CommandBuffer CreateAcquireCommandBuffer() {
+    auto pool = pool_.lock();
+    if (!pool) {
+      return {};
+    }
+    acquire_buffer_ = pool->CreateGraphicsCommandBuffer();
+    return acquire_buffer_;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Keeps a secondary buffer recorded on another thread until the
+  ///             submission has completed, then returns it to its pool.
+  ///
+  void TrackSecondary(const std::shared_ptr<CommandPoolVK>& pool,
+                      vk::CommandBuffer buffer) {
+    secondary_buffers_.emplace_back(pool, buffer);
+  }
+
   void Track(std::shared_ptr<SharedObjectVK> object) {
     if (!object) {
       return;
@@ -65,14 +97,17 @@ class TrackedObjectsVK {
     tracked_textures_.insert(std::move(texture));
   }
 
-  vk::CommandBuffer GetCommandBuffer() const { return *buffer_; }
+  vk::CommandBuffer GetCommandBuffer() const { return buffer_; }
 
   DescriptorPoolVK& GetDescriptorPool() { return desc_pool_; }
 
  private:
   DescriptorPoolVK desc_pool_;
   std::weak_ptr<CommandPoolVK> pool_;
-  vk::UniqueCommandBuffer buffer_;
+  vk::CommandBuffer buffer_;
+  vk::CommandBuffer acquire_buffer_;
+  std::vector<std::pair<std::weak_ptr<CommandPoolVK>, vk::CommandBuffer>>
+      secondary_buffers_;
   std::set<std::shared_ptr<SharedObjectVK>> tracked_objects_;
   std::set<std::shared_ptr<const DeviceBuffer>> tracked_buffers_;
   std::set<std::shared_ptr<const TextureSourceVK>> tracked_textures_;
@@ -81,12 +116,108 @@ class TrackedObjectsVK {
   FML_DISALLOW_COPY_AND_ASSIGN(TrackedObjectsVK);
 };
 
-CommandEncoderVK::CommandEncoderVK(vk::Device device,
-                                   const std::shared_ptr<QueueVK>& queue,
-                                   const std::shared_ptr<CommandPoolVK>& pool,
-                                   std::shared_ptr<FenceWaiterVK> fence_waiter)
+// The timestamps written around the timed passes of a command buffer, which
+// are read back once the GPU is done with it. Passes that could not be read
+// back are reported without timings when the queries are collected.
+class TimestampQueriesVK {
+ public:
+  TimestampQueriesVK(std::shared_ptr<GPUTracer> tracer, float timestamp_period)
+      : tracer_(std::move(tracer)), timestamp_period_(timestamp_period) {}
+
+  ~TimestampQueriesVK() {
+    for (const auto& pass : passes_) {
+      tracer_->EndPass(pass.frame, pass.label, std::nullopt);
+    }
+  }
+
+  std::optional<size_t> Begin(vk::Device device,
+                              vk::CommandBuffer buffer,
+                              const std::string& label) {
+    if (!tracer_->IsEnabled() || passes_.size() == kMaxPasses) {
+      return std::nullopt;
+    }
+    if (!pool_) {
+      vk::QueryPoolCreateInfo info;
+      info.queryType = vk::QueryType::eTimestamp;
+      info.queryCount = kMaxPasses * 2;
+      auto [result, pool] = device.createQueryPoolUnique(info);
+      if (result != vk::Result::eSuccess) {
+        VALIDATION_LOG << "Could not create timestamp query pool: "
+                       << vk::to_string(result);
+        return std::nullopt;
+      }
+      pool_ = std::move(pool);
+      buffer.resetQueryPool(*pool_, 0, kMaxPasses * 2);
+    }
+    const auto index = passes_.size();
+    buffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, *pool_,
+                          index * 2);
+    passes_.push_back({.label = label, .frame = tracer_->BeginPass()});
+    return index;
+  }
+
+  void End(vk::CommandBuffer buffer, size_t index) {
+    buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *pool_,
+                          index * 2 + 1);
+    passes_[index].ended = true;
+  }
+
+  void ReadBack(vk::Device device) {
+    for (size_t i = 0; i < passes_.size(); i++) {
+      const auto& pass = passes_[i];
+      uint64_t timestamps[2] = {};
+      if (!pass.ended ||
+          device.getQueryPoolResults(*pool_, i * 2, 2, sizeof(timestamps),
+                                     timestamps, sizeof(uint64_t),
+                                     vk::QueryResultFlagBits::e64) !=
+              vk::Result::eSuccess) {
+        tracer_->EndPass(pass.frame, pass.label, std::nullopt);
+        continue;
+      }
+      const auto ticks = timestamps[1] - timestamps[0];
+      tracer_->EndPass(pass.frame, pass.label,
+                       fml::TimeDelta::FromNanoseconds(
+                           static_cast<int64_t>(ticks * timestamp_period_)));
+    }
+    passes_.clear();
+  }
+
+ private:
+  static constexpr uint32_t kMaxPasses = 32;
+
+  struct Pass {
+    std::string label;
+    GPUTracer::FrameID frame = 0;
+    bool ended = false;
+  };
+
+  const std::shared_ptr<GPUTracer> tracer_;
+  const float timestamp_period_;
+  vk::UniqueQueryPool pool_;
+  std::vector<Pass> passes_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TimestampQueriesVK);
+};
+
+CommandEncoderVK::CommandEncoderVK(
+    vk::Device device,
+    const std::shared_ptr<QueueVK>& queue,
+    const std::shared_ptr<CommandPoolVK>& pool,
+    std::shared_ptr<FenceWaiterVK> fence_waiter,
+    std::weak_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler,
+    std::shared_ptr<GPUTracer> gpu_tracer,
+    float timestamp_period,
+    std::shared_ptr<QueueOwnershipTransfersVK> ownership_transfers)
     : fence_waiter_(std::move(fence_waiter)),
-      tracked_objects_(std::make_shared<TrackedObjectsVK>(device, pool)) {
+      tracked_objects_(std::make_shared<TrackedObjectsVK>(
+          device,
+          pool,
+          std::move(descriptor_pool_recycler))),
+      ownership_transfers_(std::move(ownership_transfers)) {
+  if (gpu_tracer) {
+    timestamp_queries_ = std::make_shared<TimestampQueriesVK>(
+        std::move(gpu_tracer), timestamp_period);
+  }
   if (!fence_waiter_ || !tracked_objects_->IsValid() || !queue) {
     return;
   }
@@ -128,16 +259,67 @@ bool CommandEncoderVK::Submit() {
     return false;
   }
 
-  vk::SubmitInfo submit_info;
-  std::vector<vk::CommandBuffer> buffers = {command_buffer};
-  submit_info.setCommandBuffers(buffers);
-  if (queue_->Submit(submit_info, *fence) != vk::Result::eSuccess) {
+  const vk::Fence submit_fence = fence.get();
+  auto submit = [&](const std::vector<QueueOwnershipTransfersVK::Transfer>&
+                        transfers) {
+    std::vector<vk::CommandBuffer> buffers;
+    std::vector<vk::Semaphore> wait_semaphores;
+    std::vector<vk::PipelineStageFlags> wait_stages;
+    if (!transfers.empty()) {
+      auto acquire_buffer = tracked_objects_->CreateAcquireCommandBuffer();
+      vk::CommandBufferBeginInfo begin_info;
+      begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+      if (!acquire_buffer ||
+          acquire_buffer.begin(begin_info) != vk::Result::eSuccess) {
+        VALIDATION_LOG << "Could not begin the queue family acquire buffer.";
+        return false;
+      }
+      std::vector<vk::ImageMemoryBarrier> barriers;
+      for (const auto& transfer : transfers) {
+        barriers.push_back(transfer.acquire_barrier);
+        wait_semaphores.push_back(transfer.semaphore->Get());
+        wait_stages.push_back(vk::PipelineStageFlagBits::eAllCommands);
+        tracked_objects_->Track(transfer.texture);
+        tracked_objects_->Track(transfer.semaphore);
+      }
+      acquire_buffer.pipelineBarrier(
+          vk::PipelineStageFlagBits::eAllCommands,  // src stage
+          vk::PipelineStageFlagBits::eAllCommands,  // dst stage
+          {},                                       // dependency flags
+          nullptr,                                  // memory barriers
+          nullptr,                                  // buffer barriers
+          barriers                                  // image barriers
+      );
+      if (acquire_buffer.end() != vk::Result::eSuccess) {
+        return false;
+      }
+      buffers.push_back(acquire_buffer);
+    }
+    buffers.push_back(command_buffer);
+
+    vk::SubmitInfo submit_info;
+    submit_info.setCommandBuffers(buffers);
+    submit_info.setWaitSemaphores(wait_semaphores);
+    submit_info.setWaitDstStageMask(wait_stages);
+    submit_info.setSignalSemaphores(signal_semaphores_);
+    return queue_->Submit(submit_info, submit_fence) == vk::Result::eSuccess;
+  };
+  // Only the graphics queue acquires textures uploaded on other queues.
+  const auto submitted = ownership_transfers_
+                             ? ownership_transfers_->Acquire(submit)
+                             : submit({});
+  if (!submitted) {
     return false;
   }
 
   return fence_waiter_->AddFence(
-      std::move(fence), [tracked_objects = std::move(tracked_objects_)] {
-        // Nothing to do, we just drop the tracked objects on the floor.
+      std::move(fence), [tracked_objects = std::move(tracked_objects_),
+                         timestamp_queries = std::move(timestamp_queries_),
+                         device = device_] {
+        if (timestamp_queries) {
+          timestamp_queries->ReadBack(device);
+        }
+        // Nothing else to do, we just drop the tracked objects on the floor.
       });
 }
 
@@ -150,9 +332,12 @@ vk::CommandBuffer CommandEncoderVK::GetCommandBuffer() const {
 
 void CommandEncoderVK::Reset() {
   tracked_objects_.reset();
+  timestamp_queries_.reset();
 
   queue_ = nullptr;
   device_ = nullptr;
+  ownership_transfers_.reset();
+  signal_semaphores_.clear();
   is_valid_ = false;
 }
 
@@ -180,6 +365,27 @@ bool CommandEncoderVK::Track(std::shared_ptr<const TextureSourceVK> texture) {
   return true;
 }
 
+bool CommandEncoderVK::AddSignalSemaphore(
+    SharedHandleVK<vk::Semaphore> semaphore) {
+  if (!IsValid() || !semaphore) {
+    return false;
+  }
+  signal_semaphores_.push_back(semaphore->Get());
+  tracked_objects_->Track(std::move(semaphore));
+  return true;
+}
+
+bool CommandEncoderVK::ExecuteSecondaryCommandBuffer(
+    const std::shared_ptr<CommandPoolVK>& pool,
+    vk::CommandBuffer buffer) {
+  if (!IsValid() || !pool || !buffer) {
+    return false;
+  }
+  GetCommandBuffer().executeCommands(buffer);
+  tracked_objects_->TrackSecondary(pool, buffer);
+  return true;
+}
+
 bool CommandEncoderVK::Track(const std::shared_ptr<const Texture>& texture) {
   if (!IsValid()) {
     return false;
@@ -198,6 +404,23 @@ std::optional<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSet(
   return tracked_objects_->GetDescriptorPool().AllocateDescriptorSet(layout);
 }
 
+std::optional<vk::DescriptorSet> CommandEncoderVK::FindDescriptorSet(
+    const DescriptorSetKeyVK& key) const {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+  return tracked_objects_->GetDescriptorPool().FindDescriptorSet(key);
+}
+
+void CommandEncoderVK::CacheDescriptorSet(DescriptorSetKeyVK key,
+                                          vk::DescriptorSet set) {
+  if (!IsValid()) {
+    return;
+  }
+  tracked_objects_->GetDescriptorPool().CacheDescriptorSet(std::move(key),
+                                                           set);
+}
+
 void CommandEncoderVK::PushDebugGroup(const char* label) const {
   if (!HasValidationLayers()) {
     return;
@@ -232,4 +455,19 @@ void CommandEncoderVK::InsertDebugMarker(const char* label) const {
   }
 }
 
+std::optional<size_t> CommandEncoderVK::BeginTimedPass(
+    const std::string& label) {
+  if (!IsValid() || !timestamp_queries_) {
+    return std::nullopt;
+  }
+  return timestamp_queries_->Begin(device_, GetCommandBuffer(), label);
+}
+
+void CommandEncoderVK::EndTimedPass(size_t pass) {
+  if (!IsValid() || !timestamp_queries_) {
+    return;
+  }
+  timestamp_queries_->End(GetCommandBuffer(), pass);
+}
+
 }  // namespace impeller
@@ -6,10 +6,13 @@
 
 #include <optional>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/queue_ownership_transfers_vk.h"
 #include "impeller/renderer/backend/vulkan/queue_vk.h"
 #include "impeller/renderer/backend/vulkan/shared_object_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
@@ -22,6 +25,8 @@ class Texture;
 class TextureSourceVK;
 class TrackedObjectsVK;
 class FenceWaiterVK;
+class GPUTracer;
+class TimestampQueriesVK;
 
 class CommandEncoderVK {
  public:
@@ -39,6 +44,22 @@ class CommandEncoderVK {
 
   bool Track(std::shared_ptr<const TextureSourceVK> texture);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Signals the semaphore once the commands of this encoder have
+  ///             completed on its queue.
+  ///
+  bool AddSignalSemaphore(SharedHandleVK<vk::Semaphore> semaphore);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Executes a secondary command buffer recorded from the given
+  ///             pool, usually on a worker thread, within the render pass
+  ///             currently being recorded. The render pass must have been
+  ///             begun with secondary command buffer contents. The buffer is
+  ///             returned to its pool once the submission has completed.
+  ///
+  bool ExecuteSecondaryCommandBuffer(const std::shared_ptr<CommandPoolVK>& pool,
+                                     vk::CommandBuffer buffer);
+
   vk::CommandBuffer GetCommandBuffer() const;
 
   void PushDebugGroup(const char* label) const;
@@ -50,6 +71,28 @@ class CommandEncoderVK {
   std::optional<vk::DescriptorSet> AllocateDescriptorSet(
       const vk::DescriptorSetLayout& layout);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Finds a descriptor set already allocated and written by an
+  ///             earlier command in this command buffer with the same
+  ///             resources.
+  ///
+  std::optional<vk::DescriptorSet> FindDescriptorSet(
+      const DescriptorSetKeyVK& key) const;
+
+  void CacheDescriptorSet(DescriptorSetKeyVK key, vk::DescriptorSet set);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes a timestamp before the commands recorded next, so that
+  ///             the GPU time of the pass they make up is reported to the GPU
+  ///             tracer of the context once the command buffer completes.
+  ///
+  /// @return     The pass to end with `EndTimedPass`, or `std::nullopt` if
+  ///             GPU tracing is disabled or unsupported.
+  ///
+  std::optional<size_t> BeginTimedPass(const std::string& label);
+
+  void EndTimedPass(size_t pass);
+
  private:
   friend class ContextVK;
 
@@ -57,12 +100,20 @@ class CommandEncoderVK {
   std::shared_ptr<QueueVK> queue_;
   std::shared_ptr<FenceWaiterVK> fence_waiter_;
   std::shared_ptr<TrackedObjectsVK> tracked_objects_;
+  std::shared_ptr<TimestampQueriesVK> timestamp_queries_;
+  std::shared_ptr<QueueOwnershipTransfersVK> ownership_transfers_;
+  std::vector<vk::Semaphore> signal_semaphores_;
   bool is_valid_ = false;
 
-  CommandEncoderVK(vk::Device device,
-                   const std::shared_ptr<QueueVK>& queue,
-                   const std::shared_ptr<CommandPoolVK>& pool,
-                   std::shared_ptr<FenceWaiterVK> fence_waiter);
+  CommandEncoderVK(
+      vk::Device device,
+      const std::shared_ptr<QueueVK>& queue,
+      const std::shared_ptr<CommandPoolVK>& pool,
+      std::shared_ptr<FenceWaiterVK> fence_waiter,
+      std::weak_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler,
+      std::shared_ptr<GPUTracer> gpu_tracer,
+      float timestamp_period,
+      std::shared_ptr<QueueOwnershipTransfersVK> ownership_transfers);
 
   void Reset();
 
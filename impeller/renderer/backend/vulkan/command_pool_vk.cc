@@ -6,6 +6,7 @@
 
 #include <map>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "flutter/fml/thread_local.h"
@@ -14,8 +15,9 @@
 
 namespace impeller {
 
-using CommandPoolMap =
-    std::map<const ContextVK*, std::shared_ptr<CommandPoolVK>>;
+// Pools are keyed by their context and queue family.
+using CommandPoolMap = std::map<std::pair<const ContextVK*, size_t>,
+                                std::shared_ptr<CommandPoolVK>>;
 
 FML_THREAD_LOCAL fml::ThreadLocalUniquePtr<CommandPoolMap> tls_command_pool;
 
@@ -25,7 +27,8 @@ static std::unordered_map<const ContextVK*,
     g_all_pools IPLR_GUARDED_BY(g_all_pools_mutex);
 
 std::shared_ptr<CommandPoolVK> CommandPoolVK::GetThreadLocal(
-    const ContextVK* context) {
+    const ContextVK* context,
+    size_t queue_family) {
   if (!context) {
     return nullptr;
   }
@@ -33,15 +36,17 @@ std::shared_ptr<CommandPoolVK> CommandPoolVK::GetThreadLocal(
     tls_command_pool.reset(new CommandPoolMap());
   }
   CommandPoolMap& pool_map = *tls_command_pool.get();
-  auto found = pool_map.find(context);
+  const auto key = std::make_pair(context, queue_family);
+  auto found = pool_map.find(key);
   if (found != pool_map.end() && found->second->IsValid()) {
     return found->second;
   }
-  auto pool = std::shared_ptr<CommandPoolVK>(new CommandPoolVK(context));
+  auto pool = std::shared_ptr<CommandPoolVK>(
+      new CommandPoolVK(context, queue_family));
   if (!pool->IsValid()) {
     return nullptr;
   }
-  pool_map[context] = pool;
+  pool_map[key] = pool;
   {
     Lock pool_lock(g_all_pools_mutex);
     g_all_pools[context].push_back(pool);
@@ -66,19 +71,23 @@ void CommandPoolVK::ClearAllPools(const ContextVK* context) {
   }
 }
 
-CommandPoolVK::CommandPoolVK(const ContextVK* context)
+CommandPoolVK::CommandPoolVK(const ContextVK* context, size_t queue_family)
     : owner_id_(std::this_thread::get_id()) {
   vk::CommandPoolCreateInfo pool_info;
 
-  pool_info.queueFamilyIndex = context->GetGraphicsQueue()->GetIndex().family;
+  pool_info.queueFamilyIndex = queue_family;
   pool_info.flags = vk::CommandPoolCreateFlagBits::eTransient;
-  auto pool = context->GetDevice().createCommandPoolUnique(pool_info);
-  if (pool.result != vk::Result::eSuccess) {
-    return;
+
+  Lock lock(slots_mutex_);
+  for (auto& slot : slots_) {
+    auto pool = context->GetDevice().createCommandPoolUnique(pool_info);
+    if (pool.result != vk::Result::eSuccess) {
+      return;
+    }
+    slot.pool = std::move(pool.value);
   }
 
   device_ = context->GetDevice();
-  graphics_pool_ = std::move(pool.value);
   is_valid_ = true;
 }
 
@@ -89,47 +98,96 @@ bool CommandPoolVK::IsValid() const {
 }
 
 void CommandPoolVK::Reset() {
-  Lock lock(buffers_to_collect_mutex_);
-  GarbageCollectBuffersIfAble();
-  graphics_pool_.reset();
+  Lock lock(slots_mutex_);
+  // Destroying the pools frees all of their buffers, including those that
+  // have not been collected yet.
+  for (auto& slot : slots_) {
+    slot = {};
+  }
+  buffer_slots_.clear();
   is_valid_ = false;
 }
 
-vk::CommandPool CommandPoolVK::GetGraphicsCommandPool() const {
-  return graphics_pool_.get();
+void CommandPoolVK::AdvanceToFrame(uint64_t frame_index) {
+  if (std::this_thread::get_id() != owner_id_) {
+    return;
+  }
+  Lock lock(slots_mutex_);
+  if (frame_index == current_frame_) {
+    return;
+  }
+  current_frame_ = frame_index;
+  current_slot_ = frame_index % kFrameSlotCount;
+  ResetSlotIfAble(slots_[current_slot_]);
+}
+
+vk::CommandBuffer CommandPoolVK::CreateGraphicsCommandBuffer() {
+  return CreateCommandBuffer(vk::CommandBufferLevel::ePrimary);
 }
 
-vk::UniqueCommandBuffer CommandPoolVK::CreateGraphicsCommandBuffer() {
+vk::CommandBuffer CommandPoolVK::CreateSecondaryCommandBuffer() {
+  return CreateCommandBuffer(vk::CommandBufferLevel::eSecondary);
+}
+
+vk::CommandBuffer CommandPoolVK::CreateCommandBuffer(
+    vk::CommandBufferLevel level) {
   if (std::this_thread::get_id() != owner_id_) {
     return {};
   }
-  {
-    Lock lock(buffers_to_collect_mutex_);
-    GarbageCollectBuffersIfAble();
-  }
-  vk::CommandBufferAllocateInfo alloc_info;
-  alloc_info.commandPool = graphics_pool_.get();
-  alloc_info.commandBufferCount = 1u;
-  alloc_info.level = vk::CommandBufferLevel::ePrimary;
-  auto [result, buffers] = device_.allocateCommandBuffersUnique(alloc_info);
-  if (result != vk::Result::eSuccess) {
+  Lock lock(slots_mutex_);
+  auto& slot = slots_[current_slot_];
+  if (!slot.pool) {
     return {};
   }
-  return std::move(buffers[0]);
+  // A slot whose work drained while it was current can be recycled in place.
+  ResetSlotIfAble(slot);
+
+  const bool primary = level == vk::CommandBufferLevel::ePrimary;
+  auto& buffers = primary ? slot.primary_buffers : slot.secondary_buffers;
+  auto& in_use = primary ? slot.primary_in_use : slot.secondary_in_use;
+  if (in_use == buffers.size()) {
+    vk::CommandBufferAllocateInfo alloc_info;
+    alloc_info.commandPool = slot.pool.get();
+    alloc_info.commandBufferCount = 1u;
+    alloc_info.level = level;
+    auto [result, allocated] = device_.allocateCommandBuffers(alloc_info);
+    if (result != vk::Result::eSuccess) {
+      return {};
+    }
+    buffers.push_back(allocated[0]);
+  }
+  auto buffer = buffers[in_use++];
+  slot.outstanding++;
+  buffer_slots_[static_cast<VkCommandBuffer>(buffer)] = current_slot_;
+  return buffer;
 }
 
-void CommandPoolVK::CollectGraphicsCommandBuffer(
-    vk::UniqueCommandBuffer buffer) {
-  Lock lock(buffers_to_collect_mutex_);
-  buffers_to_collect_.insert(MakeSharedVK(std::move(buffer)));
-  GarbageCollectBuffersIfAble();
+void CommandPoolVK::CollectGraphicsCommandBuffer(vk::CommandBuffer buffer) {
+  if (!buffer) {
+    return;
+  }
+  Lock lock(slots_mutex_);
+  auto found = buffer_slots_.find(static_cast<VkCommandBuffer>(buffer));
+  if (found == buffer_slots_.end()) {
+    // The pool was reset since the buffer was created.
+    return;
+  }
+  slots_[found->second].outstanding--;
+  buffer_slots_.erase(found);
+  // The slot is reset on the owning thread the next time it is used since
+  // the pool is externally synchronized.
 }
 
-void CommandPoolVK::GarbageCollectBuffersIfAble() {
-  if (std::this_thread::get_id() != owner_id_) {
+void CommandPoolVK::ResetSlotIfAble(FrameSlot& slot) {
+  if (slot.outstanding > 0u ||
+      (slot.primary_in_use == 0u && slot.secondary_in_use == 0u)) {
+    return;
+  }
+  if (device_.resetCommandPool(slot.pool.get()) != vk::Result::eSuccess) {
     return;
   }
-  buffers_to_collect_.clear();
+  slot.primary_in_use = 0u;
+  slot.secondary_in_use = 0u;
 }
 
 }  // namespace impeller
@@ -4,23 +4,30 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
-#include <set>
 #include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/base/thread.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/shared_object_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
 
-class ContextVK;
-
 class CommandPoolVK {
  public:
-  static std::shared_ptr<CommandPoolVK> GetThreadLocal(
-      const ContextVK* context);
+  //----------------------------------------------------------------------------
+  /// @brief      The pool of the calling thread for command buffers that are
+  ///             submitted to queues of the given family. Pools are created
+  ///             on demand.
+  ///
+  static std::shared_ptr<CommandPoolVK> GetThreadLocal(const ContextVK* context,
+                                                       size_t queue_family);
 
   static void ClearAllPools(const ContextVK* context);
 
@@ -30,24 +37,61 @@ class CommandPoolVK {
 
   void Reset();
 
-  vk::CommandPool GetGraphicsCommandPool() const;
-
-  vk::UniqueCommandBuffer CreateGraphicsCommandBuffer();
-
-  void CollectGraphicsCommandBuffer(vk::UniqueCommandBuffer buffer);
+  //----------------------------------------------------------------------------
+  /// @brief      Moves allocations to the frame slot of the given frame. Slots
+  ///             are reset as a whole with vkResetCommandPool once every
+  ///             buffer allocated from them has been collected, after which
+  ///             their buffers are reused instead of being freed.
+  ///
+  void AdvanceToFrame(uint64_t frame_index);
+
+  vk::CommandBuffer CreateGraphicsCommandBuffer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a secondary command buffer that a worker thread can
+  ///             record render pass commands into. It is executed from a
+  ///             primary command buffer on the queue of the same family.
+  ///
+  vk::CommandBuffer CreateSecondaryCommandBuffer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a primary or secondary buffer whose work has
+  ///             completed. This may be called from any thread.
+  ///
+  void CollectGraphicsCommandBuffer(vk::CommandBuffer buffer);
 
  private:
+  // Command buffers are collected some time after their frame has completed
+  // on the GPU, so there is one more slot than frames in flight.
+  static constexpr size_t kFrameSlotCount = ContextVK::kMaxFramesInFlight + 1u;
+
+  struct FrameSlot {
+    vk::UniqueCommandPool pool;
+    // Buffers stay allocated across resets of the pool. The first
+    // |*_in_use| entries have been handed out since the last reset.
+    std::vector<vk::CommandBuffer> primary_buffers;
+    std::vector<vk::CommandBuffer> secondary_buffers;
+    size_t primary_in_use = 0u;
+    size_t secondary_in_use = 0u;
+    // Buffers handed out from this slot that have not been collected yet.
+    size_t outstanding = 0u;
+  };
+
   const std::thread::id owner_id_;
   vk::Device device_ = {};
-  vk::UniqueCommandPool graphics_pool_;
-  Mutex buffers_to_collect_mutex_;
-  std::set<SharedHandleVK<vk::CommandBuffer>> buffers_to_collect_
-      IPLR_GUARDED_BY(buffers_to_collect_mutex_);
+  Mutex slots_mutex_;
+  std::array<FrameSlot, kFrameSlotCount> slots_ IPLR_GUARDED_BY(slots_mutex_);
+  std::unordered_map<VkCommandBuffer, size_t> buffer_slots_
+      IPLR_GUARDED_BY(slots_mutex_);
+  size_t current_slot_ IPLR_GUARDED_BY(slots_mutex_) = 0u;
+  uint64_t current_frame_ IPLR_GUARDED_BY(slots_mutex_) = 0u;
   bool is_valid_ = false;
 
-  explicit CommandPoolVK(const ContextVK* context);
+  CommandPoolVK(const ContextVK* context, size_t queue_family);
+
+  vk::CommandBuffer CreateCommandBuffer(vk::CommandBufferLevel level);
 
-  void GarbageCollectBuffersIfAble() IPLR_REQUIRES(buffers_to_collect_mutex_);
+  void ResetSlotIfAble(FrameSlot& slot) IPLR_REQUIRES(slots_mutex_);
 
   FML_DISALLOW_COPY_AND_ASSIGN(CommandPoolVK);
 };
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <optional>
@@ -15,17 +16,20 @@
 #include "flutter/fml/string_conversion.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
+#include "impeller/core/host_buffer_ring.h"
 #include "impeller/renderer/backend/vulkan/allocator_vk.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/debug_report_vk.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/capabilities.h"
+#include "impeller/renderer/gpu_tracer.h"
 
 VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
 
@@ -77,6 +81,17 @@ static std::optional<QueueIndexVK> PickQueue(const vk::PhysicalDevice& device,
   // This can be modified to ensure that dedicated queues are returned for each
   // queue type depending on support.
   const auto families = device.getQueueFamilyProperties();
+  // Transfer only families are usually backed by DMA engines that copy in
+  // parallel with rendering.
+  if (flags == vk::QueueFlagBits::eTransfer) {
+    for (size_t i = 0u; i < families.size(); i++) {
+      if ((families[i].queueFlags & flags) &&
+          !(families[i].queueFlags & (vk::QueueFlagBits::eGraphics |
+                                      vk::QueueFlagBits::eCompute))) {
+        return QueueIndexVK{.family = i, .index = 0};
+      }
+    }
+  }
   for (size_t i = 0u; i < families.size(); i++) {
     if (!(families[i].queueFlags & flags)) {
       continue;
@@ -101,6 +116,10 @@ ContextVK::~ContextVK() {
   if (device_) {
     [[maybe_unused]] auto result = device_->waitIdle();
   }
+  if (pipeline_library_) {
+    // The workers may already be gone, write the cache on this thread.
+    pipeline_library_->PersistPipelineCacheToDiskNow();
+  }
   CommandPoolVK::ClearAllPools(this);
 }
 
@@ -262,6 +281,13 @@ void ContextVK::Setup(Settings settings) {
   device_info.setQueueCreateInfos(queue_create_infos);
   device_info.setPEnabledExtensionNames(enabled_device_extensions_c);
   device_info.setPEnabledFeatures(&required_features.value());
+  // Imported hardware buffers are usually YUV and need YCbCr conversions.
+  vk::PhysicalDeviceSamplerYcbcrConversionFeatures ycbcr_features;
+  if (CapabilitiesVK::CanImportAndroidHardwareBuffers(
+          physical_device.value())) {
+    ycbcr_features.samplerYcbcrConversion = VK_TRUE;
+    device_info.setPNext(&ycbcr_features);
+  }
   // Device layers are deprecated and ignored.
 
   auto device = physical_device->createDeviceUnique(device_info);
@@ -285,7 +311,8 @@ void ContextVK::Setup(Settings settings) {
       device.value.get(),                //
       instance.value.get(),              //
       dispatcher.vkGetInstanceProcAddr,  //
-      dispatcher.vkGetDeviceProcAddr     //
+      dispatcher.vkGetDeviceProcAddr,    //
+      caps->SupportsMemoryBudget()       //
       ));
 
   if (!allocator->IsValid()) {
@@ -358,6 +385,26 @@ void ContextVK::Setup(Settings settings) {
   queues_ = std::move(queues);
   device_capabilities_ = std::move(caps);
   fence_waiter_ = std::move(fence_waiter);
+  descriptor_pool_recycler_ =
+      std::make_shared<DescriptorPoolRecyclerVK>(device_.get());
+  ownership_transfers_ = std::make_shared<QueueOwnershipTransfersVK>();
+  // Device buffers referenced by a command buffer are tracked until its fence
+  // is signaled, so blocks of the ring are only reused once the GPU is done
+  // with them.
+  host_buffer_ring_ = std::make_shared<HostBufferRing>(allocator_);
+  worker_task_runner_ = settings.worker_task_runner;
+  max_frames_in_flight_ = std::clamp<size_t>(settings.max_frames_in_flight, 1u,
+                                             kMaxFramesInFlight);
+  preferred_present_mode_ = settings.preferred_present_mode;
+  // Timestamps can only be written on queues that support them, and are only
+  // meaningful to compare on the same queue.
+  const auto queue_families = physical_device_.getQueueFamilyProperties();
+  if (graphics_queue->family < queue_families.size() &&
+      queue_families[graphics_queue->family].timestampValidBits > 0) {
+    gpu_tracer_ = std::make_shared<GPUTracer>();
+    timestamp_period_ =
+        physical_device_.getProperties().limits.timestampPeriod;
+  }
   is_valid_ = true;
 
   //----------------------------------------------------------------------------
@@ -367,6 +414,10 @@ void ContextVK::Setup(Settings settings) {
   SetDebugName(device_.get(), device_.get(), "ImpellerDevice");
 }
 
+Context::BackendType ContextVK::GetBackendType() const {
+  return Context::BackendType::kVulkan;
+}
+
 bool ContextVK::IsValid() const {
   return is_valid_;
 }
@@ -375,6 +426,15 @@ std::shared_ptr<Allocator> ContextVK::GetResourceAllocator() const {
   return allocator_;
 }
 
+std::shared_ptr<HostBufferRing> ContextVK::GetHostBufferRing() const {
+  return host_buffer_ring_;
+}
+
+std::shared_ptr<fml::ConcurrentTaskRunner> ContextVK::GetWorkerTaskRunner()
+    const {
+  return worker_task_runner_;
+}
+
 std::shared_ptr<ShaderLibrary> ContextVK::GetShaderLibrary() const {
   return shader_library_;
 }
@@ -406,6 +466,12 @@ vk::Device ContextVK::GetDevice() const {
   return *device_;
 }
 
+void ContextVK::PersistPipelineCacheToDisk() const {
+  if (pipeline_library_) {
+    pipeline_library_->PersistPipelineCacheToDisk();
+  }
+}
+
 std::unique_ptr<Surface> ContextVK::AcquireNextSurface() {
   TRACE_EVENT0("impeller", __FUNCTION__);
   auto surface = swapchain_ ? swapchain_->AcquireNextDrawable() : nullptr;
@@ -455,25 +521,94 @@ const std::shared_ptr<QueueVK>& ContextVK::GetGraphicsQueue() const {
   return queues_.graphics_queue;
 }
 
+const std::shared_ptr<QueueVK>& ContextVK::GetTransferQueue() const {
+  return queues_.transfer_queue;
+}
+
+bool ContextVK::HasDedicatedTransferQueue() const {
+  return queues_.transfer_queue->GetIndex().family !=
+         queues_.graphics_queue->GetIndex().family;
+}
+
+const std::shared_ptr<QueueOwnershipTransfersVK>&
+ContextVK::GetQueueOwnershipTransfers() const {
+  return ownership_transfers_;
+}
+
 vk::PhysicalDevice ContextVK::GetPhysicalDevice() const {
   return physical_device_;
 }
 
+std::shared_ptr<GPUTracer> ContextVK::GetGPUTracer() const {
+  return gpu_tracer_;
+}
+
 std::shared_ptr<FenceWaiterVK> ContextVK::GetFenceWaiter() const {
   return fence_waiter_;
 }
 
+size_t ContextVK::GetMaxFramesInFlight() const {
+  return max_frames_in_flight_;
+}
+
+vk::PresentModeKHR ContextVK::GetPreferredPresentMode() const {
+  return preferred_present_mode_;
+}
+
+void ContextVK::AdvanceFrame() {
+  frame_index_++;
+}
+
+std::shared_ptr<CommandPoolVK> ContextVK::GetGraphicsCommandPool() const {
+  auto tls_pool = CommandPoolVK::GetThreadLocal(
+      this, queues_.graphics_queue->GetIndex().family);
+  if (tls_pool) {
+    tls_pool->AdvanceToFrame(frame_index_.load());
+  }
+  return tls_pool;
+}
+
 std::unique_ptr<CommandEncoderVK> ContextVK::CreateGraphicsCommandEncoder()
     const {
-  auto tls_pool = CommandPoolVK::GetThreadLocal(this);
+  auto tls_pool = GetGraphicsCommandPool();
+  if (!tls_pool) {
+    return nullptr;
+  }
+  auto encoder = std::unique_ptr<CommandEncoderVK>(new CommandEncoderVK(
+      *device_,                   //
+      queues_.graphics_queue,     //
+      tls_pool,                   //
+      fence_waiter_,              //
+      descriptor_pool_recycler_,  //
+      gpu_tracer_,                //
+      timestamp_period_,          //
+      ownership_transfers_        //
+      ));
+  if (!encoder->IsValid()) {
+    return nullptr;
+  }
+  return encoder;
+}
+
+std::unique_ptr<CommandEncoderVK> ContextVK::CreateTransferCommandEncoder()
+    const {
+  auto tls_pool = CommandPoolVK::GetThreadLocal(
+      this, queues_.transfer_queue->GetIndex().family);
   if (!tls_pool) {
     return nullptr;
   }
+  tls_pool->AdvanceToFrame(frame_index_.load());
+  // Timestamps of different queues can't be compared, so transfers are not
+  // traced.
   auto encoder = std::unique_ptr<CommandEncoderVK>(new CommandEncoderVK(
-      *device_,                //
-      queues_.graphics_queue,  //
-      tls_pool,                //
-      fence_waiter_            //
+      *device_,                   //
+      queues_.transfer_queue,     //
+      tls_pool,                   //
+      fence_waiter_,              //
+      descriptor_pool_recycler_,  //
+      nullptr,                    //
+      0.0f,                       //
+      nullptr                     //
       ));
   if (!encoder->IsValid()) {
     return nullptr;
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include "flutter/fml/concurrent_message_loop.h"
@@ -13,6 +14,7 @@
 #include "impeller/base/backend_cast.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/backend/vulkan/pipeline_library_vk.h"
+#include "impeller/renderer/backend/vulkan/queue_ownership_transfers_vk.h"
 #include "impeller/renderer/backend/vulkan/queue_vk.h"
 #include "impeller/renderer/backend/vulkan/sampler_library_vk.h"
 #include "impeller/renderer/backend/vulkan/shader_library_vk.h"
@@ -27,17 +29,30 @@ namespace impeller {
 bool HasValidationLayers();
 
 class CommandEncoderVK;
+class CommandPoolVK;
 class DebugReportVK;
+class DescriptorPoolRecyclerVK;
 class FenceWaiterVK;
 
 class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
  public:
+  static constexpr size_t kMaxFramesInFlight = 3u;
+
   struct Settings {
     PFN_vkGetInstanceProcAddr proc_address_callback = nullptr;
     std::vector<std::shared_ptr<fml::Mapping>> shader_libraries_data;
     fml::UniqueFD cache_directory;
     std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner;
     bool enable_validation = false;
+    /// The number of frames that may be encoded while the GPU is still
+    /// rendering earlier ones. More frames in flight hide longer GPU frames,
+    /// at the cost of latency and memory. Clamped to [1, 3].
+    size_t max_frames_in_flight = kMaxFramesInFlight;
+    /// The present mode of swapchains, if the surface supports it. FIFO,
+    /// which every surface supports, is used otherwise. MAILBOX replaces
+    /// queued images instead of blocking, and FIFO_RELAXED presents late
+    /// frames immediately.
+    vk::PresentModeKHR preferred_present_mode = vk::PresentModeKHR::eFifo;
 
     Settings() = default;
 
@@ -49,6 +64,9 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
   // |Context|
   ~ContextVK() override;
 
+  // |Context|
+  BackendType GetBackendType() const override;
+
   // |Context|
   bool IsValid() const override;
 
@@ -67,9 +85,19 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
   // |Context|
   std::shared_ptr<CommandBuffer> CreateCommandBuffer() const override;
 
+  // |Context|
+  std::shared_ptr<HostBufferRing> GetHostBufferRing() const override;
+
+  // |Context|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetWorkerTaskRunner()
+      const override;
+
   // |Context|
   const std::shared_ptr<const Capabilities>& GetCapabilities() const override;
 
+  // |Context|
+  std::shared_ptr<GPUTracer> GetGPUTracer() const override;
+
   template <typename T>
   bool SetDebugName(T handle, std::string_view label) const {
     return SetDebugName(*device_, handle, label);
@@ -113,10 +141,57 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
 
   const std::shared_ptr<QueueVK>& GetGraphicsQueue() const;
 
+  const std::shared_ptr<QueueVK>& GetTransferQueue() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the transfer queue belongs to a different family than
+  ///             the graphics queue, so that uploads on it run in parallel
+  ///             with rendering.
+  ///
+  bool HasDedicatedTransferQueue() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The textures uploaded on the transfer queue that the next
+  ///             graphics queue submission acquires.
+  ///
+  const std::shared_ptr<QueueOwnershipTransfersVK>& GetQueueOwnershipTransfers()
+      const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates an encoder for commands submitted to the transfer
+  ///             queue. Only transfer commands may be recorded into it.
+  ///
+  std::unique_ptr<CommandEncoderVK> CreateTransferCommandEncoder() const;
+
   vk::PhysicalDevice GetPhysicalDevice() const;
 
   std::shared_ptr<FenceWaiterVK> GetFenceWaiter() const;
 
+  size_t GetMaxFramesInFlight() const;
+
+  vk::PresentModeKHR GetPreferredPresentMode() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Marks the start of a frame. Command buffers are recycled in
+  ///             per frame slots of their pools.
+  ///
+  void AdvanceFrame();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The command pool of the calling thread for buffers submitted
+  ///             to the graphics queue. Worker threads allocate the secondary
+  ///             command buffers they record render passes into from it.
+  ///
+  std::shared_ptr<CommandPoolVK> GetGraphicsCommandPool() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Schedules the pipeline cache to be written to the cache
+  ///             directory on a worker. Embedders should call this when the
+  ///             application moves to the background since it may be killed
+  ///             without the context ever being destroyed.
+  ///
+  void PersistPipelineCacheToDisk() const;
+
  private:
   vk::UniqueInstance instance_;
   std::unique_ptr<DebugReportVK> debug_report_;
@@ -130,6 +205,15 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
   std::shared_ptr<SwapchainVK> swapchain_;
   std::shared_ptr<const Capabilities> device_capabilities_;
   std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler_;
+  std::shared_ptr<QueueOwnershipTransfersVK> ownership_transfers_;
+  std::shared_ptr<HostBufferRing> host_buffer_ring_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+  std::shared_ptr<GPUTracer> gpu_tracer_;
+  float timestamp_period_ = 0.0f;
+  size_t max_frames_in_flight_ = kMaxFramesInFlight;
+  vk::PresentModeKHR preferred_present_mode_ = vk::PresentModeKHR::eFifo;
+  std::atomic<uint64_t> frame_index_ = 0u;
 
   bool is_valid_ = false;
 
@@ -4,14 +4,81 @@
 
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 
+#include <algorithm>
+
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 
 namespace impeller {
 
-DescriptorPoolVK::DescriptorPoolVK(vk::Device device) : device_(device) {}
+std::size_t DescriptorSetKeyVK::Hash::operator()(
+    const DescriptorSetKeyVK& key) const {
+  auto hash = std::hash<VkDescriptorSetLayout>{}(
+      static_cast<VkDescriptorSetLayout>(key.layout));
+  for (auto binding : key.bindings) {
+    fml::HashCombineSeed(hash, binding);
+  }
+  return hash;
+}
+
+DescriptorPoolRecyclerVK::DescriptorPoolRecyclerVK(vk::Device device)
+    : device_(device) {}
+
+DescriptorPoolRecyclerVK::~DescriptorPoolRecyclerVK() = default;
 
-DescriptorPoolVK::~DescriptorPoolVK() = default;
+void DescriptorPoolRecyclerVK::Reclaim(vk::UniqueDescriptorPool pool,
+                                       uint32_t pool_size) {
+  if (!pool) {
+    return;
+  }
+  // Resetting returns all descriptor sets allocated from the pool in one go,
+  // which is much cheaper than destroying it and creating another.
+  device_.resetDescriptorPool(*pool);
+  Lock lock(recycled_mutex_);
+  if (recycled_.size() >= kMaxRecycledPools) {
+    // Keep the larger pools, they are the ones that avoid growing.
+    auto smallest = std::min_element(
+        recycled_.begin(), recycled_.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; });
+    if (smallest->second >= pool_size) {
+      return;
+    }
+    recycled_.erase(smallest);
+  }
+  recycled_.emplace_back(std::move(pool), pool_size);
+}
+
+std::optional<std::pair<vk::UniqueDescriptorPool, uint32_t>>
+DescriptorPoolRecyclerVK::Take() {
+  Lock lock(recycled_mutex_);
+  if (recycled_.empty()) {
+    return std::nullopt;
+  }
+  auto largest = std::max_element(
+      recycled_.begin(), recycled_.end(),
+      [](const auto& a, const auto& b) { return a.second < b.second; });
+  auto pool = std::move(*largest);
+  recycled_.erase(largest);
+  return pool;
+}
+
+DescriptorPoolVK::DescriptorPoolVK(
+    vk::Device device,
+    std::weak_ptr<DescriptorPoolRecyclerVK> recycler)
+    : device_(device), recycler_(std::move(recycler)) {}
+
+DescriptorPoolVK::~DescriptorPoolVK() {
+  // This pool is collected once the fence of the command buffer that used it
+  // has signaled, hand the pools to the recycler for the next frames.
+  auto recycler = recycler_.lock();
+  if (!recycler) {
+    return;
+  }
+  for (auto& [pool, size] : pools_) {
+    recycler->Reclaim(std::move(pool), size);
+  }
+}
 
 static vk::UniqueDescriptorPool CreatePool(const vk::Device& device,
                                            uint32_t pool_count) {
@@ -56,11 +123,31 @@ std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
   return sets[0];
 }
 
+std::optional<vk::DescriptorSet> DescriptorPoolVK::FindDescriptorSet(
+    const DescriptorSetKeyVK& key) const {
+  if (auto found = cached_sets_.find(key); found != cached_sets_.end()) {
+    return found->second;
+  }
+  return std::nullopt;
+}
+
+void DescriptorPoolVK::CacheDescriptorSet(DescriptorSetKeyVK key,
+                                          vk::DescriptorSet set) {
+  cached_sets_[std::move(key)] = set;
+}
+
 std::optional<vk::DescriptorPool> DescriptorPoolVK::GetDescriptorPool() {
   if (pools_.empty()) {
+    if (auto recycler = recycler_.lock()) {
+      if (auto recycled = recycler->Take(); recycled.has_value()) {
+        pool_size_ = std::max(pool_size_, recycled->second);
+        pools_.push_back(std::move(recycled.value()));
+        return *pools_.back().first;
+      }
+    }
     return GrowPool() ? GetDescriptorPool() : std::nullopt;
   }
-  return *pools_.back();
+  return *pools_.back().first;
 }
 
 bool DescriptorPoolVK::GrowPool() {
@@ -70,7 +157,7 @@ bool DescriptorPoolVK::GrowPool() {
     return false;
   }
   pool_size_ = new_pool_size;
-  pools_.push(std::move(new_pool));
+  pools_.emplace_back(std::move(new_pool), new_pool_size);
   return true;
 }
 
@@ -4,14 +4,76 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
-#include <queue>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      Identifies the contents of a descriptor set: its layout and
+///             the resources written to each of its bindings. Two commands
+///             in the same command buffer with equal keys can share a
+///             descriptor set.
+///
+struct DescriptorSetKeyVK {
+  vk::DescriptorSetLayout layout;
+  std::vector<uint64_t> bindings;
+
+  struct Hash {
+    std::size_t operator()(const DescriptorSetKeyVK& key) const;
+  };
+
+  struct Equal {
+    bool operator()(const DescriptorSetKeyVK& lhs,
+                    const DescriptorSetKeyVK& rhs) const {
+      return lhs.layout == rhs.layout && lhs.bindings == rhs.bindings;
+    }
+  };
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Holds on to the descriptor pools of command buffers whose
+///             fences have signaled so that they can be reset and reused by
+///             later command buffers instead of being destroyed and created
+///             again every frame.
+///
+///             The recycler is thread-safe. Pools are returned on the fence
+///             waiter thread and picked up on the threads encoding commands.
+///
+class DescriptorPoolRecyclerVK {
+ public:
+  static constexpr size_t kMaxRecycledPools = 32u;
+
+  explicit DescriptorPoolRecyclerVK(vk::Device device);
+
+  ~DescriptorPoolRecyclerVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Resets the pool and keeps it for reuse. All descriptor sets
+  ///             allocated from it must no longer be in use by the GPU.
+  ///
+  void Reclaim(vk::UniqueDescriptorPool pool, uint32_t pool_size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the largest recycled pool, if there is one.
+  ///
+  std::optional<std::pair<vk::UniqueDescriptorPool, uint32_t>> Take();
+
+ private:
+  const vk::Device device_;
+  Mutex recycled_mutex_;
+  std::vector<std::pair<vk::UniqueDescriptorPool, uint32_t>> recycled_
+      IPLR_GUARDED_BY(recycled_mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DescriptorPoolRecyclerVK);
+};
+
 //------------------------------------------------------------------------------
 /// @brief      A short-lived dynamically-sized descriptor pool. Descriptors
 ///             from this pool don't need to be freed individually. Instead, the
@@ -22,21 +84,40 @@ namespace impeller {
 ///             threads.
 ///
 ///             Encoders create pools as necessary as they have the same
-///             threading and lifecycle restrictions.
+///             threading and lifecycle restrictions. The underlying Vulkan
+///             pools are taken from and handed back to the recycler, if any,
+///             so that steady state frames don't create or destroy pools.
 ///
 class DescriptorPoolVK {
  public:
-  explicit DescriptorPoolVK(vk::Device device);
+  explicit DescriptorPoolVK(
+      vk::Device device,
+      std::weak_ptr<DescriptorPoolRecyclerVK> recycler = {});
 
   ~DescriptorPoolVK();
 
   std::optional<vk::DescriptorSet> AllocateDescriptorSet(
       const vk::DescriptorSetLayout& layout);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Finds a descriptor set previously allocated from this pool
+  ///             whose bindings were written with the same resources.
+  ///
+  std::optional<vk::DescriptorSet> FindDescriptorSet(
+      const DescriptorSetKeyVK& key) const;
+
+  void CacheDescriptorSet(DescriptorSetKeyVK key, vk::DescriptorSet set);
+
  private:
   const vk::Device device_;
+  const std::weak_ptr<DescriptorPoolRecyclerVK> recycler_;
   uint32_t pool_size_ = 31u;
-  std::queue<vk::UniqueDescriptorPool> pools_;
+  std::vector<std::pair<vk::UniqueDescriptorPool, uint32_t>> pools_;
+  std::unordered_map<DescriptorSetKeyVK,
+                     vk::DescriptorSet,
+                     DescriptorSetKeyVK::Hash,
+                     DescriptorSetKeyVK::Equal>
+      cached_sets_;
 
   std::optional<vk::DescriptorPool> GetDescriptorPool();
 
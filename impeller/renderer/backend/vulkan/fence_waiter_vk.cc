@@ -5,6 +5,7 @@
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 
 #include <chrono>
+#include <string>
 
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
@@ -32,11 +33,17 @@ bool FenceWaiterVK::AddFence(vk::UniqueFence fence,
   if (!IsValid() || !fence || !callback) {
     return false;
   }
+  bool was_idle = false;
   {
     std::scoped_lock lock(wait_set_mutex_);
-    wait_set_[MakeSharedVK(std::move(fence))] = callback;
+    was_idle = pending_entries_.empty();
+    pending_entries_.push_back({std::move(fence), callback});
+  }
+  // The waiter picks up new fences every time it wakes, it only needs
+  // signaling for the first fence in a batch.
+  if (was_idle) {
+    wait_set_cv_.notify_one();
   }
-  wait_set_cv_.notify_one();
   return true;
 }
 
@@ -46,57 +53,83 @@ void FenceWaiterVK::Main() {
 
   using namespace std::literals::chrono_literals;
 
-  while (true) {
-    std::unique_lock lock(wait_set_mutex_);
-
-    wait_set_cv_.wait(lock, [&]() { return !wait_set_.empty() || terminate_; });
-
-    auto wait_set = TrimAndCreateWaitSetLocked();
-
-    lock.unlock();
-
-    if (!wait_set.has_value()) {
-      break;
-    }
-    if (wait_set->empty()) {
+  while (TakePendingEntries()) {
+    if (wait_fences_.empty()) {
       continue;
     }
 
     auto result = device_.waitForFences(
-        wait_set->size(),                        // fences count
-        wait_set->data(),                        // fences
+        wait_fences_.size(),                     // fences count
+        wait_fences_.data(),                     // fences
         false,                                   // wait for all
         std::chrono::nanoseconds{100ms}.count()  // timeout (ns)
     );
     if (!(result == vk::Result::eSuccess || result == vk::Result::eTimeout)) {
       break;
     }
+
+    auto callbacks = TrimSignaledEntries();
+    if (!callbacks.has_value()) {
+      break;
+    }
+    if (callbacks->empty()) {
+      continue;
+    }
+
+    // Dispatch all the callbacks of the fences that signaled together and
+    // outside the lock so that submissions are never blocked on the
+    // reclamation of resources.
+    TRACE_EVENT1("impeller", "FenceCallbacks", "Count",
+                 std::to_string(callbacks->size()).c_str());
+    for (const auto& callback : callbacks.value()) {
+      callback();
+    }
   }
+
+  // The remaining callbacks are dropped without being called, their fences
+  // never signaled.
+  wait_entries_.clear();
+  wait_fences_.clear();
 }
 
-std::optional<std::vector<vk::Fence>>
-FenceWaiterVK::TrimAndCreateWaitSetLocked() {
+bool FenceWaiterVK::TakePendingEntries() {
+  std::unique_lock lock(wait_set_mutex_);
+  wait_set_cv_.wait(lock, [&]() {
+    return !pending_entries_.empty() || !wait_entries_.empty() || terminate_;
+  });
   if (terminate_) {
-    return std::nullopt;
+    return false;
+  }
+  for (auto& entry : pending_entries_) {
+    wait_fences_.push_back(entry.fence.get());
+    wait_entries_.push_back(std::move(entry));
   }
+  pending_entries_.clear();
+  return true;
+}
+
+std::optional<std::vector<fml::closure>>
+FenceWaiterVK::TrimSignaledEntries() {
   TRACE_EVENT0("impeller", "TrimFences");
-  std::vector<vk::Fence> fences;
-  fences.reserve(wait_set_.size());
-  for (auto it = wait_set_.begin(); it != wait_set_.end();) {
-    switch (device_.getFenceStatus(it->first->Get())) {
+  std::vector<fml::closure> callbacks;
+  for (size_t i = 0; i < wait_entries_.size();) {
+    switch (device_.getFenceStatus(wait_fences_[i])) {
       case vk::Result::eSuccess:  // Signalled.
-        it->second();
-        it = wait_set_.erase(it);
+        callbacks.push_back(std::move(wait_entries_[i].callback));
+        // Order doesn't matter, swap the last entry into this slot.
+        std::swap(wait_entries_[i], wait_entries_.back());
+        std::swap(wait_fences_[i], wait_fences_.back());
+        wait_entries_.pop_back();
+        wait_fences_.pop_back();
         break;
       case vk::Result::eNotReady:  // Un-signalled.
-        fences.push_back(it->first->Get());
-        it++;
+        i++;
         break;
       default:
         return std::nullopt;
     }
   }
-  return fences;
+  return callbacks;
 }
 
 void FenceWaiterVK::Terminate() {
@@ -8,7 +8,7 @@
 #include <memory>
 #include <optional>
 #include <thread>
-#include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -33,19 +33,32 @@ class FenceWaiterVK {
  private:
   friend class ContextVK;
 
+  struct WaitEntry {
+    vk::UniqueFence fence;
+    fml::closure callback;
+  };
+
   const vk::Device device_;
   std::unique_ptr<std::thread> waiter_thread_;
   std::mutex wait_set_mutex_;
   std::condition_variable wait_set_cv_;
-  std::unordered_map<SharedHandleVK<vk::Fence>, fml::closure> wait_set_;
+  // Fences added since the waiter last woke up. Guarded by |wait_set_mutex_|.
+  std::vector<WaitEntry> pending_entries_;
   bool terminate_ = false;
   bool is_valid_ = false;
 
+  // Only accessed on the waiter thread. |wait_fences_| mirrors the fences in
+  // |wait_entries_| so the wait set doesn't have to be rebuilt on each wake.
+  std::vector<WaitEntry> wait_entries_;
+  std::vector<vk::Fence> wait_fences_;
+
   explicit FenceWaiterVK(vk::Device device);
 
   void Main();
 
-  std::optional<std::vector<vk::Fence>> TrimAndCreateWaitSetLocked();
+  bool TakePendingEntries();
+
+  std::optional<std::vector<fml::closure>> TrimSignaledEntries();
 
   FML_DISALLOW_COPY_AND_ASSIGN(FenceWaiterVK);
 };
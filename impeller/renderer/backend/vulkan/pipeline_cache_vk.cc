@@ -6,28 +6,100 @@
 
 #include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
 
+#include <cstring>
 #include <sstream>
 
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
 
 namespace impeller {
 
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
 
+/// The header written in front of the opaque pipeline cache data. The driver
+/// validates its own header too, but some drivers have been known to crash
+/// rather than reject a cache written by a different device or driver, so the
+/// identity of the device is checked before the data is handed to it.
+struct PipelineCacheHeaderVK {
+  static constexpr uint32_t kMagic = 0x564B4348;  // 'VKCH'
+  static constexpr uint32_t kVersion = 1u;
+
+  uint32_t magic = kMagic;
+  uint32_t version = kVersion;
+  uint32_t vendor_id = 0u;
+  uint32_t device_id = 0u;
+  uint32_t driver_version = 0u;
+  uint8_t pipeline_cache_uuid[VK_UUID_SIZE] = {};
+  uint64_t data_size = 0u;
+
+  explicit PipelineCacheHeaderVK(const CapabilitiesVK& caps,
+                                 uint64_t p_data_size = 0u)
+      : data_size(p_data_size) {
+    const auto& props = caps.GetPhysicalDeviceProperties();
+    vendor_id = props.vendorID;
+    device_id = props.deviceID;
+    driver_version = props.driverVersion;
+    std::memcpy(pipeline_cache_uuid, props.pipelineCacheUUID.data(),
+                VK_UUID_SIZE);
+  }
+
+  bool IsCompatibleWith(const PipelineCacheHeaderVK& other) const {
+    return magic == other.magic &&                        //
+           version == other.version &&                    //
+           vendor_id == other.vendor_id &&                //
+           device_id == other.device_id &&                //
+           driver_version == other.driver_version &&      //
+           std::memcmp(pipeline_cache_uuid,               //
+                       other.pipeline_cache_uuid,         //
+                       VK_UUID_SIZE) == 0;
+  }
+};
+
 static bool VerifyExistingCache(const fml::Mapping& mapping,
                                 const CapabilitiesVK& caps) {
-  return true;
+  if (mapping.GetMapping() == nullptr ||
+      mapping.GetSize() < sizeof(PipelineCacheHeaderVK)) {
+    return false;
+  }
+  const PipelineCacheHeaderVK expected(caps);
+  PipelineCacheHeaderVK header(caps);
+  std::memcpy(&header, mapping.GetMapping(), sizeof(header));
+  if (!expected.IsCompatibleWith(header)) {
+    FML_LOG(INFO) << "Discarding a pipeline cache written by a different "
+                     "device or driver.";
+    return false;
+  }
+  return header.data_size == mapping.GetSize() - sizeof(header);
 }
 
 static std::shared_ptr<fml::Mapping> DecorateCacheWithMetadata(
-    std::shared_ptr<fml::Mapping> data) {
-  return data;
+    std::shared_ptr<fml::Mapping> data,
+    const CapabilitiesVK& caps) {
+  if (!data) {
+    return nullptr;
+  }
+  PipelineCacheHeaderVK header(caps, data->GetSize());
+  std::vector<uint8_t> decorated(sizeof(header) + data->GetSize());
+  std::memcpy(decorated.data(), &header, sizeof(header));
+  std::memcpy(decorated.data() + sizeof(header), data->GetMapping(),
+              data->GetSize());
+  return std::make_shared<fml::DataMapping>(std::move(decorated));
 }
 
 static std::unique_ptr<fml::Mapping> RemoveMetadataFromCache(
     std::unique_ptr<fml::Mapping> data) {
-  return data;
+  if (!data || data->GetSize() < sizeof(PipelineCacheHeaderVK)) {
+    return nullptr;
+  }
+  // Avoid copying the cache data, the mapping of the file is kept alive by
+  // the release proc of the returned mapping instead.
+  const uint8_t* cache_data =
+      data->GetMapping() + sizeof(PipelineCacheHeaderVK);
+  const size_t cache_size = data->GetSize() - sizeof(PipelineCacheHeaderVK);
+  std::shared_ptr<fml::Mapping> file_mapping = std::move(data);
+  return std::make_unique<fml::NonOwnedMapping>(
+      cache_data, cache_size, [file_mapping](auto, auto) {});
 }
 
 static std::unique_ptr<fml::Mapping> OpenCacheFile(
@@ -84,6 +156,9 @@ PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
 
   if (result == vk::Result::eSuccess) {
     cache_ = std::move(existing_cache);
+    if (existing_cache_data) {
+      last_persisted_size_ = existing_cache_data->GetSize();
+    }
   } else {
     // Even though we perform consistency checks because we don't trust the
     // driver, the driver may have additional information that may cause it to
@@ -110,17 +185,96 @@ bool PipelineCacheVK::IsValid() const {
   return is_valid_;
 }
 
+PipelineCacheVK::ThreadCache* PipelineCacheVK::GetThreadCache() {
+  const auto thread_id = std::this_thread::get_id();
+  {
+    Lock lock(thread_caches_mutex_);
+    if (auto found = thread_caches_.find(thread_id);
+        found != thread_caches_.end()) {
+      return found->second.get();
+    }
+  }
+
+  // Seed the cache of this thread with everything known so far, including
+  // what was loaded from disk, so that it still hits on pipelines compiled
+  // by previous launches or by other threads before the last merge.
+  auto seed = CopyPipelineCacheData();
+  vk::PipelineCacheCreateInfo cache_info;
+  if (seed) {
+    cache_info.initialDataSize = seed->GetSize();
+    cache_info.pInitialData = seed->GetMapping();
+  }
+  auto [result, cache] = device_.createPipelineCacheUnique(cache_info);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create per-thread pipeline cache: "
+                   << vk::to_string(result);
+    return nullptr;
+  }
+  auto thread_cache = std::make_unique<ThreadCache>();
+  thread_cache->cache = std::move(cache);
+
+  Lock lock(thread_caches_mutex_);
+  auto& entry = thread_caches_[thread_id];
+  if (!entry) {
+    entry = std::move(thread_cache);
+  }
+  return entry.get();
+}
+
 vk::UniquePipeline PipelineCacheVK::CreatePipeline(
     const vk::GraphicsPipelineCreateInfo& info) {
-  Lock lock(cache_mutex_);
-  auto [result, pipeline] = device_.createGraphicsPipelineUnique(*cache_, info);
+  auto thread_cache = GetThreadCache();
+  if (!thread_cache) {
+    // Fallback to the primary cache, serializing with other threads.
+    Lock lock(cache_mutex_);
+    auto [result, pipeline] =
+        device_.createGraphicsPipelineUnique(*cache_, info);
+    if (result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not create graphics pipeline: "
+                     << vk::to_string(result);
+    }
+    return std::move(pipeline);
+  }
+
+  // The per-thread cache is only used by this thread for creation, merges
+  // only read from it and caches are internally synchronized.
+  auto [result, pipeline] =
+      device_.createGraphicsPipelineUnique(*thread_cache->cache, info);
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not create graphics pipeline: "
                    << vk::to_string(result);
   }
+  thread_cache->has_new_pipelines = true;
   return std::move(pipeline);
 }
 
+void PipelineCacheVK::MergeThreadCaches() const {
+  if (!IsValid()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "PipelineCacheVK::MergeThreadCaches");
+  std::vector<vk::PipelineCache> sources;
+  {
+    Lock lock(thread_caches_mutex_);
+    for (const auto& [thread_id, thread_cache] : thread_caches_) {
+      if (thread_cache->has_new_pipelines.exchange(false)) {
+        sources.push_back(*thread_cache->cache);
+      }
+    }
+  }
+  if (sources.empty()) {
+    return;
+  }
+  // Thread caches are never collected before this cache so the handles stay
+  // valid outside the lock.
+  Lock lock(cache_mutex_);
+  auto result = device_.mergePipelineCaches(*cache_, sources);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not merge pipeline caches: "
+                   << vk::to_string(result);
+  }
+}
+
 std::shared_ptr<fml::Mapping> PipelineCacheVK::CopyPipelineCacheData() const {
   if (!IsValid()) {
     return nullptr;
@@ -141,12 +295,25 @@ void PipelineCacheVK::PersistCacheToDisk() const {
   if (!cache_directory_.is_valid()) {
     return;
   }
+  TRACE_EVENT0("impeller", "PipelineCacheVK::PersistCacheToDisk");
+  // Persisting may be requested from the worker and from the context being
+  // torn down at the same time. Serialize them so they don't race on the
+  // temporary file written by |fml::WriteAtomically|.
+  Lock persist_lock(persist_mutex_);
+  MergeThreadCaches();
   auto data = CopyPipelineCacheData();
   if (!data) {
     VALIDATION_LOG << "Could not copy pipeline cache data.";
     return;
   }
-  data = DecorateCacheWithMetadata(std::move(data));
+  // The cache only ever grows, so an unchanged size means no new pipelines
+  // were compiled since the last time it was written.
+  if (data->GetSize() == last_persisted_size_) {
+    return;
+  }
+  const size_t persisted_size = data->GetSize();
+  data = DecorateCacheWithMetadata(std::move(data),
+                                   CapabilitiesVK::Cast(*caps_));
   if (!data) {
     VALIDATION_LOG
         << "Could not decorate pipeline cache with additional metadata.";
@@ -156,6 +323,7 @@ void PipelineCacheVK::PersistCacheToDisk() const {
     VALIDATION_LOG << "Could not persist pipeline cache to disk.";
     return;
   }
+  last_persisted_size_ = persisted_size;
 }
 
 }  // namespace impeller
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
 #include "flutter/fml/file.h"
 #include "flutter/fml/macros.h"
 #include "impeller/base/thread.h"
@@ -22,8 +26,27 @@ class PipelineCacheVK {
 
   bool IsValid() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a pipeline using a cache private to the calling
+  ///             thread so that pipelines may be created concurrently on all
+  ///             workers. The per-thread caches are seeded from the primary
+  ///             cache and folded back into it by |MergeThreadCaches|.
+  ///
   vk::UniquePipeline CreatePipeline(const vk::GraphicsPipelineCreateInfo& info);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Merges the per-thread caches that created pipelines since
+  ///             the last merge into the primary cache. Meant to be called
+  ///             when pipeline creation goes idle.
+  ///
+  void MergeThreadCaches() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the cache data, prefixed with the identity of the
+  ///             device and driver that produced it, to the cache directory.
+  ///             Nothing is written if the cache did not grow since it was
+  ///             last loaded or persisted.
+  ///
   void PersistCacheToDisk() const;
 
  private:
@@ -32,10 +55,21 @@ class PipelineCacheVK {
   const fml::UniqueFD cache_directory_;
   mutable Mutex cache_mutex_;
   vk::UniquePipelineCache cache_ IPLR_GUARDED_BY(cache_mutex_);
+  struct ThreadCache {
+    vk::UniquePipelineCache cache;
+    std::atomic_bool has_new_pipelines = false;
+  };
+  mutable Mutex thread_caches_mutex_;
+  std::unordered_map<std::thread::id, std::unique_ptr<ThreadCache>>
+      thread_caches_ IPLR_GUARDED_BY(thread_caches_mutex_);
+  mutable Mutex persist_mutex_;
+  mutable size_t last_persisted_size_ IPLR_GUARDED_BY(persist_mutex_) = 0u;
   bool is_valid_ = false;
 
   std::shared_ptr<fml::Mapping> CopyPipelineCacheData() const;
 
+  ThreadCache* GetThreadCache();
+
   FML_DISALLOW_COPY_AND_ASSIGN(PipelineCacheVK);
 };
 
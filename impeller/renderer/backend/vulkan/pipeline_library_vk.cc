@@ -138,7 +138,8 @@ constexpr vk::FrontFace ToVKFrontFace(WindingOrder order) {
 }
 
 std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
-    const PipelineDescriptor& desc) {
+    const PipelineDescriptor& desc,
+    const std::shared_ptr<SamplerVK>& immutable_sampler) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   vk::GraphicsPipelineCreateInfo pipeline_info;
 
@@ -269,9 +270,15 @@ std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
   /// Pipeline Layout a.k.a the descriptor sets and uniforms.
   ///
   std::vector<vk::DescriptorSetLayoutBinding> desc_bindings;
+  vk::Sampler vk_immutable_sampler =
+      immutable_sampler ? immutable_sampler->GetSampler() : vk::Sampler{};
 
   for (auto layout : desc.GetVertexDescriptor()->GetDescriptorSetLayouts()) {
     auto vk_desc_layout = ToVKDescriptorSetLayoutBinding(layout);
+    if (vk_immutable_sampler && vk_desc_layout.descriptorType ==
+                                    vk::DescriptorType::eCombinedImageSampler) {
+      vk_desc_layout.setImmutableSamplers(vk_immutable_sampler);
+    }
     desc_bindings.push_back(vk_desc_layout);
   }
 
@@ -356,6 +363,7 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
 
   auto weak_this = weak_from_this();
 
+  ++pending_pipelines_;
   worker_task_runner_->PostTask([descriptor, weak_this, promise]() {
     auto thiz = weak_this.lock();
     if (!thiz) {
@@ -365,7 +373,13 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
       return;
     }
 
-    auto pipeline = PipelineLibraryVK::Cast(*thiz).CreatePipeline(descriptor);
+    auto& library = PipelineLibraryVK::Cast(*thiz);
+    auto pipeline = library.CreatePipeline(descriptor);
+    // Pipelines are created on the per-thread caches of the workers. Fold
+    // them into the primary cache once the burst of compilation is over.
+    if (--library.pending_pipelines_ == 0u) {
+      library.pso_cache_->MergeThreadCaches();
+    }
     if (!pipeline) {
       promise->set_value(nullptr);
       VALIDATION_LOG << "Could not create pipeline: " << descriptor.GetLabel();
@@ -415,4 +429,8 @@ void PipelineLibraryVK::PersistPipelineCacheToDisk() {
       });
 }
 
+void PipelineLibraryVK::PersistPipelineCacheToDiskNow() {
+  pso_cache_->PersistCacheToDisk();
+}
+
 }  // namespace impeller
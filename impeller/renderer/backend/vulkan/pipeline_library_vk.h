@@ -33,6 +33,7 @@ class PipelineLibraryVK final
 
  private:
   friend ContextVK;
+  friend class PipelineVK;
 
   vk::Device device_;
   std::shared_ptr<PipelineCacheVK> pso_cache_;
@@ -40,6 +41,7 @@ class PipelineLibraryVK final
   Mutex pipelines_mutex_;
   PipelineMap pipelines_ IPLR_GUARDED_BY(pipelines_mutex_);
   std::atomic_size_t frames_acquired_ = 0u;
+  std::atomic_size_t pending_pipelines_ = 0u;
   bool is_valid_ = false;
 
   PipelineLibraryVK(
@@ -63,10 +65,14 @@ class PipelineLibraryVK final
   void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) override;
 
-  std::unique_ptr<PipelineVK> CreatePipeline(const PipelineDescriptor& desc);
+  std::unique_ptr<PipelineVK> CreatePipeline(
+      const PipelineDescriptor& desc,
+      const std::shared_ptr<SamplerVK>& immutable_sampler = nullptr);
 
   void PersistPipelineCacheToDisk();
 
+  void PersistPipelineCacheToDiskNow();
+
   FML_DISALLOW_COPY_AND_ASSIGN(PipelineLibraryVK);
 };
 
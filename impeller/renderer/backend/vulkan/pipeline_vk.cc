@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
 
+#include "impeller/renderer/backend/vulkan/pipeline_library_vk.h"
+
 namespace impeller {
 
 PipelineVK::PipelineVK(std::weak_ptr<PipelineLibrary> library,
@@ -12,7 +14,8 @@ PipelineVK::PipelineVK(std::weak_ptr<PipelineLibrary> library,
                        vk::UniqueRenderPass render_pass,
                        vk::UniquePipelineLayout layout,
                        vk::UniqueDescriptorSetLayout descriptor_set_layout)
-    : Pipeline(std::move(library), desc),
+    : Pipeline(library, desc),
+      pipeline_library_(std::move(library)),
       pipeline_(std::move(pipeline)),
       render_pass_(std::move(render_pass)),
       layout_(std::move(layout)),
@@ -42,4 +45,32 @@ const vk::DescriptorSetLayout& PipelineVK::GetDescriptorSetLayout() const {
   return *descriptor_set_layout_;
 }
 
+const PipelineVK* PipelineVK::GetOrCreateImmutableSamplerVariant(
+    const std::shared_ptr<SamplerVK>& immutable_sampler) const {
+  if (!immutable_sampler) {
+    return this;
+  }
+  Lock lock(variants_mutex_);
+  for (const auto& variant : variants_) {
+    if (variant.immutable_sampler == immutable_sampler) {
+      return variant.pipeline.get();
+    }
+  }
+  auto library = pipeline_library_.lock();
+  if (!library) {
+    return nullptr;
+  }
+  auto pipeline = PipelineLibraryVK::Cast(*library).CreatePipeline(
+      GetDescriptor(), immutable_sampler);
+  if (!pipeline) {
+    VALIDATION_LOG << "Could not create the immutable sampler variant of "
+                      "pipeline: "
+                   << GetDescriptor().GetLabel();
+    return nullptr;
+  }
+  const auto* variant = pipeline.get();
+  variants_.push_back({immutable_sampler, std::move(pipeline)});
+  return variant;
+}
+
 }  // namespace impeller
@@ -5,9 +5,12 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/backend/vulkan/sampler_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/pipeline.h"
 
@@ -35,13 +38,36 @@ class PipelineVK final
 
   const vk::DescriptorSetLayout& GetDescriptorSetLayout() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Gets a variant of this pipeline whose combined image samplers
+  ///             are the given immutable sampler, which is how images with a
+  ///             YCbCr conversion must be sampled.
+  ///
+  ///             Variants are created synchronously on first use and live as
+  ///             long as this pipeline. There is one per conversion, which
+  ///             external textures share between the buffers of a stream.
+  ///
+  /// @return     The variant, or null if it could not be created.
+  ///
+  const PipelineVK* GetOrCreateImmutableSamplerVariant(
+      const std::shared_ptr<SamplerVK>& immutable_sampler) const;
+
  private:
   friend class PipelineLibraryVK;
 
+  struct ImmutableSamplerVariant {
+    std::shared_ptr<SamplerVK> immutable_sampler;
+    std::unique_ptr<PipelineVK> pipeline;
+  };
+
+  const std::weak_ptr<PipelineLibrary> pipeline_library_;
   const vk::UniquePipeline pipeline_;
   const vk::UniqueRenderPass render_pass_;
   const vk::UniquePipelineLayout layout_;
   const vk::UniqueDescriptorSetLayout descriptor_set_layout_;
+  mutable Mutex variants_mutex_;
+  mutable std::vector<ImmutableSamplerVariant> variants_
+      IPLR_GUARDED_BY(variants_mutex_);
   bool is_valid_ = false;
 
   // |Pipeline|
@@ -0,0 +1,29 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/queue_ownership_transfers_vk.h"
+
+#include "impeller/renderer/backend/vulkan/texture_source_vk.h"
+
+namespace impeller {
+
+QueueOwnershipTransfersVK::QueueOwnershipTransfersVK() = default;
+
+QueueOwnershipTransfersVK::~QueueOwnershipTransfersVK() = default;
+
+void QueueOwnershipTransfersVK::AddPendingTransfer(Transfer transfer) {
+  Lock lock(mutex_);
+  pending_transfers_.emplace_back(std::move(transfer));
+}
+
+bool QueueOwnershipTransfersVK::Acquire(const SubmitCallback& submit) {
+  Lock lock(mutex_);
+  if (!submit(pending_transfers_)) {
+    return false;
+  }
+  pending_transfers_.clear();
+  return true;
+}
+
+}  // namespace impeller
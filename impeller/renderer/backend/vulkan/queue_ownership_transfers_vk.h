@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/backend/vulkan/shared_object_vk.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+class TextureSourceVK;
+
+//------------------------------------------------------------------------------
+/// @brief      The textures whose contents were uploaded on a dedicated
+///             transfer queue and released to the graphics queue family, but
+///             not acquired by it yet.
+///
+///             The next submission to the graphics queue acquires all pending
+///             textures and waits for the semaphores that their uploads
+///             signal. Since pending textures are taken and submitted while
+///             the transfers are locked, no command buffer that uses an
+///             uploaded texture can reach the graphics queue before the one
+///             that acquires it.
+///
+class QueueOwnershipTransfersVK {
+ public:
+  struct Transfer {
+    std::shared_ptr<const TextureSourceVK> texture;
+    SharedHandleVK<vk::Semaphore> semaphore;
+    vk::ImageMemoryBarrier acquire_barrier;
+  };
+
+  using SubmitCallback = std::function<bool(const std::vector<Transfer>&)>;
+
+  QueueOwnershipTransfersVK();
+
+  ~QueueOwnershipTransfersVK();
+
+  void AddPendingTransfer(Transfer transfer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Calls `submit` with the pending transfers, which are removed
+  ///             if it succeeds. The callback must acquire them in the
+  ///             submission it makes. No transfer can be added in the
+  ///             meantime.
+  ///
+  bool Acquire(const SubmitCallback& submit);
+
+ private:
+  Mutex mutex_;
+  std::vector<Transfer> pending_transfers_ IPLR_GUARDED_BY(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(QueueOwnershipTransfersVK);
+};
+
+}  // namespace impeller
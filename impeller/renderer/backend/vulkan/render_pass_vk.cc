@@ -15,6 +15,7 @@
 #include "impeller/core/formats.h"
 #include "impeller/core/sampler.h"
 #include "impeller/core/shader_types.h"
+#include "impeller/renderer/backend/vulkan/barrier_batch_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
@@ -243,39 +244,50 @@ SharedHandleVK<vk::Framebuffer> RenderPassVK::CreateVKFramebuffer(
 }
 
 static bool UpdateBindingLayouts(const Bindings& bindings,
-                                 const vk::CommandBuffer& buffer) {
+                                 vk::PipelineStageFlags dst_stage,
+                                 BarrierBatchVK& barriers) {
   LayoutTransition transition;
-  transition.cmd_buffer = buffer;
   transition.src_access = vk::AccessFlagBits::eColorAttachmentWrite |
                           vk::AccessFlagBits::eTransferWrite;
   transition.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
                          vk::PipelineStageFlagBits::eTransfer;
   transition.dst_access = vk::AccessFlagBits::eShaderRead;
-  transition.dst_stage = vk::PipelineStageFlagBits::eFragmentShader;
+  transition.dst_stage = dst_stage;
 
   transition.new_layout = vk::ImageLayout::eShaderReadOnlyOptimal;
 
   for (const auto& [_, texture] : bindings.textures) {
-    if (!TextureVK::Cast(*texture.resource).SetLayout(transition)) {
+    auto source = TextureVK::Cast(*texture.resource).GetTextureSource();
+    if (!source) {
       return false;
     }
+    barriers.AddLayoutTransition(*source, transition);
   }
   return true;
 }
 
 static bool UpdateBindingLayouts(const Command& command,
-                                 const vk::CommandBuffer& buffer) {
-  return UpdateBindingLayouts(command.vertex_bindings, buffer) &&
-         UpdateBindingLayouts(command.fragment_bindings, buffer);
+                                 BarrierBatchVK& barriers) {
+  return UpdateBindingLayouts(command.vertex_bindings,
+                              vk::PipelineStageFlagBits::eVertexShader,
+                              barriers) &&
+         UpdateBindingLayouts(command.fragment_bindings,
+                              vk::PipelineStageFlagBits::eFragmentShader,
+                              barriers);
 }
 
+// The textures sampled by the pass are transitioned with a single barrier
+// before the pass begins, since barriers can't be recorded within it.
 static bool UpdateBindingLayouts(const std::vector<Command>& commands,
                                  const vk::CommandBuffer& buffer) {
+  BarrierBatchVK barriers(buffer);
   for (const auto& command : commands) {
-    if (!UpdateBindingLayouts(command, buffer)) {
+    if (!UpdateBindingLayouts(command, barriers)) {
+      barriers.Encode();
       return false;
     }
   }
+  barriers.Encode();
   return true;
 }
 
@@ -283,12 +295,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
                                           const Command& command,
                                           CommandEncoderVK& encoder,
                                           const PipelineVK& pipeline) {
-  auto desc_set =
-      encoder.AllocateDescriptorSet(pipeline.GetDescriptorSetLayout());
-  if (!desc_set) {
-    return false;
-  }
-
   auto& allocator = *context.GetResourceAllocator();
 
   std::unordered_map<uint32_t, vk::DescriptorBufferInfo> buffers;
@@ -297,8 +303,7 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
 
   auto bind_images = [&encoder,  //
                       &images,   //
-                      &writes,   //
-                      &desc_set  //
+                      &writes    //
   ](const Bindings& bindings) -> bool {
     for (const auto& [index, sampler_handle] : bindings.samplers) {
       if (bindings.textures.find(index) == bindings.textures.end()) {
@@ -307,7 +312,12 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
 
       auto texture = bindings.textures.at(index).resource;
       const auto& texture_vk = TextureVK::Cast(*texture);
-      const SamplerVK& sampler = SamplerVK::Cast(*sampler_handle.resource);
+      // The sampler of a YCbCr image is part of the pipeline layout, and the
+      // descriptor must match it.
+      const auto immutable_sampler = texture_vk.GetImmutableSamplerVariant();
+      const SamplerVK& sampler = immutable_sampler
+                                     ? *immutable_sampler
+                                     : SamplerVK::Cast(*sampler_handle.resource);
 
       if (!encoder.Track(texture) ||
           !encoder.Track(sampler.GetSharedSampler())) {
@@ -322,7 +332,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       image_info.imageView = texture_vk.GetImageView();
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = desc_set.value();
       write_set.dstBinding = slot.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = vk::DescriptorType::eCombinedImageSampler;
@@ -337,8 +346,7 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
   auto bind_buffers = [&allocator,  //
                        &encoder,    //
                        &buffers,    //
-                       &writes,     //
-                       &desc_set    //
+                       &writes      //
   ](const Bindings& bindings) -> bool {
     for (const auto& [buffer_index, view] : bindings.buffers) {
       const auto& buffer_view = view.resource.buffer;
@@ -373,7 +381,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       const ShaderUniformSlot& uniform = bindings.uniforms.at(buffer_index);
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = desc_set.value();
       write_set.dstBinding = uniform.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = vk::DescriptorType::eUniformBuffer;
@@ -390,7 +397,39 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
     return false;
   }
 
-  context.GetDevice().updateDescriptorSets(writes, {});
+  // Commands that bind the same resources with the same layout (common for
+  // runs of glyphs or solid fills sharing a uniform buffer) reuse the set
+  // already written for this command buffer.
+  DescriptorSetKeyVK key;
+  key.layout = pipeline.GetDescriptorSetLayout();
+  key.bindings.reserve(writes.size() * 4u);
+  for (const auto& write : writes) {
+    key.bindings.push_back(write.dstBinding);
+    if (write.pBufferInfo) {
+      key.bindings.push_back(reinterpret_cast<uint64_t>(
+          static_cast<VkBuffer>(write.pBufferInfo->buffer)));
+      key.bindings.push_back(write.pBufferInfo->offset);
+      key.bindings.push_back(write.pBufferInfo->range);
+    } else {
+      key.bindings.push_back(reinterpret_cast<uint64_t>(
+          static_cast<VkImageView>(write.pImageInfo->imageView)));
+      key.bindings.push_back(reinterpret_cast<uint64_t>(
+          static_cast<VkSampler>(write.pImageInfo->sampler)));
+    }
+  }
+
+  auto desc_set = encoder.FindDescriptorSet(key);
+  if (!desc_set) {
+    desc_set = encoder.AllocateDescriptorSet(key.layout);
+    if (!desc_set) {
+      return false;
+    }
+    for (auto& write : writes) {
+      write.dstSet = desc_set.value();
+    }
+    context.GetDevice().updateDescriptorSets(writes, {});
+    encoder.CacheDescriptorSet(std::move(key), desc_set.value());
+  }
 
   encoder.GetCommandBuffer().bindDescriptorSets(
       vk::PipelineBindPoint::eGraphics,  // bind point
@@ -425,6 +464,16 @@ static void SetViewportAndScissor(const Command& command,
   cmd_buffer.setScissor(0, 1, &scissor);
 }
 
+static std::shared_ptr<SamplerVK> GetImmutableSampler(const Command& command) {
+  for (const auto& [index, texture] : command.fragment_bindings.textures) {
+    if (auto sampler =
+            TextureVK::Cast(*texture.resource).GetImmutableSamplerVariant()) {
+      return sampler;
+    }
+  }
+  return nullptr;
+}
+
 static bool EncodeCommand(const Context& context,
                           const Command& command,
                           CommandEncoderVK& encoder,
@@ -443,7 +492,14 @@ static bool EncodeCommand(const Context& context,
 
   const auto& cmd_buffer = encoder.GetCommandBuffer();
 
-  const auto& pipeline_vk = PipelineVK::Cast(*command.pipeline);
+  const auto* pipeline = &PipelineVK::Cast(*command.pipeline);
+  if (auto immutable_sampler = GetImmutableSampler(command)) {
+    pipeline = pipeline->GetOrCreateImmutableSamplerVariant(immutable_sampler);
+    if (!pipeline) {
+      return false;
+    }
+  }
+  const auto& pipeline_vk = *pipeline;
 
   if (!AllocateAndBindDescriptorSets(ContextVK::Cast(context),  //
                                      command,                   //
@@ -574,10 +630,16 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
   {
     TRACE_EVENT0("impeller", "EncodeRenderPassCommands");
+    const auto timed_pass = encoder->BeginTimedPass(debug_label_);
     cmd_buffer.beginRenderPass(pass_info, vk::SubpassContents::eInline);
 
-    fml::ScopedCleanupClosure end_render_pass(
-        [cmd_buffer]() { cmd_buffer.endRenderPass(); });
+    fml::ScopedCleanupClosure end_render_pass([cmd_buffer, timed_pass,
+                                               &encoder]() {
+      cmd_buffer.endRenderPass();
+      if (timed_pass.has_value()) {
+        encoder->EndTimedPass(timed_pass.value());
+      }
+    });
 
     for (const auto& command : commands_) {
       if (!command.pipeline) {
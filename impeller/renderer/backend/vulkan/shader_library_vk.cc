@@ -4,22 +4,27 @@
 
 #include "impeller/renderer/backend/vulkan/shader_library_vk.h"
 
+#include <optional>
+
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
-#include "impeller/blobcat/blob_library.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/shader_function_vk.h"
 
 namespace impeller {
 
-static ShaderStage ToShaderStage(BlobShaderType type) {
-  switch (type) {
-    case BlobShaderType::kVertex:
-      return ShaderStage::kVertex;
-    case BlobShaderType::kFragment:
-      return ShaderStage::kFragment;
-    case BlobShaderType::kCompute:
-      return ShaderStage::kCompute;
+static std::optional<BlobShaderType> ToBlobShaderType(ShaderStage stage) {
+  switch (stage) {
+    case ShaderStage::kVertex:
+      return BlobShaderType::kVertex;
+    case ShaderStage::kFragment:
+      return BlobShaderType::kFragment;
+    case ShaderStage::kCompute:
+      return BlobShaderType::kCompute;
+    case ShaderStage::kUnknown:
+    case ShaderStage::kTessellationControl:
+    case ShaderStage::kTessellationEvaluation:
+      return std::nullopt;
   }
   FML_UNREACHABLE();
 }
@@ -57,30 +62,15 @@ ShaderLibraryVK::ShaderLibraryVK(
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data)
     : device_(device) {
   TRACE_EVENT0("impeller", "CreateShaderLibrary");
-  bool success = true;
-  auto iterator = [&](auto type,         //
-                      const auto& name,  //
-                      const auto& code   //
-                      ) -> bool {
-    if (!RegisterFunction(name, ToShaderStage(type), code)) {
-      success = false;
-      return false;
-    }
-    return true;
-  };
   for (const auto& library_data : shader_libraries_data) {
     auto blob_library = BlobLibrary{library_data};
     if (!blob_library.IsValid()) {
       VALIDATION_LOG << "Could not construct shader blob library.";
       return;
     }
-    blob_library.IterateAllBlobs(iterator);
+    blob_libraries_.emplace_back(std::move(blob_library));
   }
 
-  if (!success) {
-    VALIDATION_LOG << "Could not create shader modules for all shader blobs.";
-    return;
-  }
   is_valid_ = true;
 }
 
@@ -94,12 +84,38 @@ bool ShaderLibraryVK::IsValid() const {
 std::shared_ptr<const ShaderFunction> ShaderLibraryVK::GetFunction(
     std::string_view name,
     ShaderStage stage) {
-  ReaderLock lock(functions_mutex_);
-
   const auto key = ShaderKey{{name.data(), name.size()}, stage};
-  auto found = functions_.find(key);
-  if (found != functions_.end()) {
-    return found->second;
+  {
+    ReaderLock lock(functions_mutex_);
+    auto found = functions_.find(key);
+    if (found != functions_.end()) {
+      return found->second;
+    }
+  }
+
+  // Functions are looked up by the key name of the blob they were created
+  // from, which is the blob name followed by a suffix for the stage.
+  const auto type = ToBlobShaderType(stage);
+  const auto suffix = VKShaderNameToShaderKeyName("", stage);
+  if (!type.has_value() || name.size() <= suffix.size() ||
+      name.substr(name.size() - suffix.size()) != suffix) {
+    return nullptr;
+  }
+  const auto blob_name = name.substr(0, name.size() - suffix.size());
+
+  // Later libraries take precedence over earlier ones.
+  for (auto i = blob_libraries_.rbegin(); i != blob_libraries_.rend(); i++) {
+    auto code = i->GetMapping(type.value(), blob_name);
+    if (!code) {
+      continue;
+    }
+    TRACE_EVENT0("impeller", "CreateShaderModule");
+    if (!RegisterFunction(std::string{blob_name}, stage, code)) {
+      return nullptr;
+    }
+    ReaderLock lock(functions_mutex_);
+    auto found = functions_.find(key);
+    return found != functions_.end() ? found->second : nullptr;
   }
   return nullptr;
 }
@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/comparable.h"
 #include "impeller/base/thread.h"
+#include "impeller/blobcat/blob_library.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/shader_key.h"
 #include "impeller/renderer/shader_library.h"
@@ -27,6 +30,9 @@ class ShaderLibraryVK final : public ShaderLibrary {
   const UniqueID library_id_;
   mutable RWMutex functions_mutex_;
   ShaderFunctionMap functions_ IPLR_GUARDED_BY(functions_mutex_);
+  // Shader modules are only created for the blobs once they are first asked
+  // for.
+  std::vector<BlobLibrary> blob_libraries_;
   bool is_valid_ = false;
 
   ShaderLibraryVK(
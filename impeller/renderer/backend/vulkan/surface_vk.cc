@@ -13,6 +13,7 @@ namespace impeller {
 std::unique_ptr<SurfaceVK> SurfaceVK::WrapSwapchainImage(
     const std::shared_ptr<Context>& context,
     const std::shared_ptr<SwapchainImageVK>& swapchain_image,
+    std::optional<IRect> existing_damage,
     SwapCallback swap_callback) {
   if (!context || !swapchain_image || !swap_callback) {
     return nullptr;
@@ -88,17 +89,25 @@ std::unique_ptr<SurfaceVK> SurfaceVK::WrapSwapchainImage(
   render_target_desc.SetStencilAttachment(stencil0);
 
   // The constructor is private. So make_unique may not be used.
-  return std::unique_ptr<SurfaceVK>(
-      new SurfaceVK(render_target_desc, std::move(swap_callback)));
+  return std::unique_ptr<SurfaceVK>(new SurfaceVK(
+      render_target_desc, existing_damage, std::move(swap_callback)));
 }
 
-SurfaceVK::SurfaceVK(const RenderTarget& target, SwapCallback swap_callback)
-    : Surface(target), swap_callback_(std::move(swap_callback)) {}
+SurfaceVK::SurfaceVK(const RenderTarget& target,
+                     std::optional<IRect> existing_damage,
+                     SwapCallback swap_callback)
+    : Surface(target),
+      swap_callback_(std::move(swap_callback)),
+      existing_damage_(existing_damage) {}
 
 SurfaceVK::~SurfaceVK() = default;
 
+std::optional<IRect> SurfaceVK::GetExistingDamage() const {
+  return existing_damage_;
+}
+
 bool SurfaceVK::Present() const {
-  return swap_callback_ ? swap_callback_() : false;
+  return swap_callback_ ? swap_callback_(GetFrameDamage()) : false;
 }
 
 }  // namespace impeller
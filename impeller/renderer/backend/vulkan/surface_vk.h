@@ -15,20 +15,34 @@ namespace impeller {
 
 class SurfaceVK final : public Surface {
  public:
-  using SwapCallback = std::function<bool(void)>;
-
+  using SwapCallback =
+      std::function<bool(const std::optional<IRect>& frame_damage)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Wraps a swapchain image. The existing damage is the area of
+  ///             the image that changed in the frames presented since the
+  ///             image was last presented, or `std::nullopt` if its contents
+  ///             are undefined.
+  ///
   static std::unique_ptr<SurfaceVK> WrapSwapchainImage(
       const std::shared_ptr<Context>& context,
       const std::shared_ptr<SwapchainImageVK>& swapchain_image,
+      std::optional<IRect> existing_damage,
       SwapCallback swap_callback);
 
   // |Surface|
   ~SurfaceVK() override;
 
+  // |Surface|
+  std::optional<IRect> GetExistingDamage() const override;
+
  private:
   SwapCallback swap_callback_;
+  std::optional<IRect> existing_damage_;
 
-  SurfaceVK(const RenderTarget& target, SwapCallback swap_callback);
+  SurfaceVK(const RenderTarget& target,
+            std::optional<IRect> existing_damage,
+            SwapCallback swap_callback);
 
   // |Surface|
   bool Present() const override;
@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/vulkan/swapchain_impl_vk.h"
 
+#include "flutter/fml/trace_event.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -13,8 +15,6 @@
 
 namespace impeller {
 
-static constexpr size_t kMaxFramesInFlight = 3u;
-
 struct FrameSynchronizer {
   vk::UniqueFence acquire;
   vk::UniqueSemaphore render_ready;
@@ -104,6 +104,16 @@ static std::optional<vk::CompositeAlphaFlagBitsKHR> ChooseAlphaCompositionMode(
   return std::nullopt;
 }
 
+static vk::PresentModeKHR ChoosePresentMode(
+    const std::vector<vk::PresentModeKHR>& modes,
+    vk::PresentModeKHR preference) {
+  if (std::find(modes.begin(), modes.end(), preference) != modes.end()) {
+    return preference;
+  }
+  // FIFO is the only mode that is required to be supported.
+  return vk::PresentModeKHR::eFifo;
+}
+
 static std::optional<vk::Queue> ChoosePresentQueue(
     const vk::PhysicalDevice& physical_device,
     const vk::Device& device,
@@ -167,6 +177,16 @@ SwapchainImplVK::SwapchainImplVK(const std::shared_ptr<Context>& context,
     return;
   }
 
+  auto [modes_result, modes] =
+      vk_context.GetPhysicalDevice().getSurfacePresentModesKHR(*surface);
+  if (modes_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not get surface present modes: "
+                   << vk::to_string(modes_result);
+    return;
+  }
+  const auto present_mode =
+      ChoosePresentMode(modes, vk_context.GetPreferredPresentMode());
+
   auto present_queue = ChoosePresentQueue(vk_context.GetPhysicalDevice(),  //
                                           vk_context.GetDevice(),          //
                                           *surface                         //
@@ -180,21 +200,31 @@ SwapchainImplVK::SwapchainImplVK(const std::shared_ptr<Context>& context,
   swapchain_info.surface = *surface;
   swapchain_info.imageFormat = format.value().format;
   swapchain_info.imageColorSpace = format.value().colorSpace;
-  swapchain_info.presentMode = vk::PresentModeKHR::eFifo;
+  swapchain_info.presentMode = present_mode;
   swapchain_info.imageExtent = vk::Extent2D{
       std::clamp(caps.currentExtent.width, caps.minImageExtent.width,
                  caps.maxImageExtent.width),
       std::clamp(caps.currentExtent.height, caps.minImageExtent.height,
                  caps.maxImageExtent.height),
   };
+  // Every frame in flight holds on to an image until it is presented, and
+  // one more image is needed for the compositor to display.
+  const auto frames_in_flight = vk_context.GetMaxFramesInFlight();
+  const auto preferred_image_count = std::max<uint32_t>(
+      caps.minImageCount + 1u, static_cast<uint32_t>(frames_in_flight) + 1u);
   swapchain_info.minImageCount = std::clamp(
-      caps.minImageCount + 1u,  // preferred image count
-      caps.minImageCount,       // min count cannot be zero
-      caps.maxImageCount == 0u ? caps.minImageCount + 1u
+      preferred_image_count,  // preferred image count
+      caps.minImageCount,     // min count cannot be zero
+      caps.maxImageCount == 0u ? preferred_image_count
                                : caps.maxImageCount  // max zero means no limit
   );
   swapchain_info.imageArrayLayers = 1u;
   swapchain_info.imageUsage = vk::ImageUsageFlagBits::eColorAttachment;
+  // Partially repainted frames of multisampled surfaces are resolved offscreen
+  // and copied into the swapchain image.
+  if (caps.supportedUsageFlags & vk::ImageUsageFlagBits::eTransferDst) {
+    swapchain_info.imageUsage |= vk::ImageUsageFlagBits::eTransferDst;
+  }
   swapchain_info.preTransform = caps.currentTransform;
   swapchain_info.compositeAlpha = composite.value();
   // If we set the clipped value to true, Vulkan expects we will never read back
@@ -252,7 +282,7 @@ SwapchainImplVK::SwapchainImplVK(const std::shared_ptr<Context>& context,
   }
 
   std::vector<std::unique_ptr<FrameSynchronizer>> synchronizers;
-  for (size_t i = 0u; i < kMaxFramesInFlight; i++) {
+  for (size_t i = 0u; i < frames_in_flight; i++) {
     auto sync = std::make_unique<FrameSynchronizer>(vk_context.GetDevice());
     if (!sync->is_valid) {
       VALIDATION_LOG << "Could not create frame synchronizers.";
@@ -268,6 +298,12 @@ SwapchainImplVK::SwapchainImplVK(const std::shared_ptr<Context>& context,
   surface_format_ = swapchain_info.imageFormat;
   swapchain_ = std::move(swapchain);
   images_ = std::move(swapchain_images);
+  // Nothing has been rendered into the images yet, so none of their contents
+  // can be reused.
+  image_damage_.assign(images_.size(), std::nullopt);
+  supports_incremental_present_ =
+      CapabilitiesVK::Cast(*vk_context.GetCapabilities())
+          .SupportsIncrementalPresent();
   synchronizers_ = std::move(synchronizers);
   current_frame_ = synchronizers_.size() - 1u;
   is_valid_ = true;
@@ -294,6 +330,7 @@ SwapchainImplVK::DestroySwapchain() {
   is_valid_ = false;
   synchronizers_.clear();
   images_.clear();
+  image_damage_.clear();
   context_.reset();
   return {std::move(surface_), std::move(swapchain_)};
 }
@@ -312,7 +349,8 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
     return {};
   }
 
-  const auto& context = ContextVK::Cast(*context_strong);
+  auto& context = ContextVK::Cast(*context_strong);
+  context.AdvanceFrame();
 
   current_frame_ = (current_frame_ + 1u) % synchronizers_.size();
 
@@ -321,20 +359,29 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
   //----------------------------------------------------------------------------
   /// Wait on the host for the synchronizer fence.
   ///
-  if (!sync->WaitForFence(context.GetDevice())) {
-    VALIDATION_LOG << "Could not wait for fence.";
-    return {};
+  {
+    // Blocks while the maximum number of frames are in flight.
+    TRACE_EVENT0("impeller", "SwapchainFrameInFlightWait");
+    if (!sync->WaitForFence(context.GetDevice())) {
+      VALIDATION_LOG << "Could not wait for fence.";
+      return {};
+    }
   }
 
   //----------------------------------------------------------------------------
   /// Get the next image index.
   ///
-  auto [acq_result, index] = context.GetDevice().acquireNextImageKHR(
-      *swapchain_,                           // swapchain
-      std::numeric_limits<uint64_t>::max(),  // timeout (nanoseconds)
-      *sync->render_ready,                   // signal semaphore
-      nullptr                                // fence
-  );
+  vk::ResultValue<uint32_t> acquire_result(vk::Result::eNotReady, 0u);
+  {
+    TRACE_EVENT0("impeller", "SwapchainAcquireImage");
+    acquire_result = context.GetDevice().acquireNextImageKHR(
+        *swapchain_,                           // swapchain
+        std::numeric_limits<uint64_t>::max(),  // timeout (nanoseconds)
+        *sync->render_ready,                   // signal semaphore
+        nullptr                                // fence
+    );
+  }
+  auto [acq_result, index] = acquire_result;
 
   if (acq_result == vk::Result::eSuboptimalKHR ||
       acq_result == vk::Result::eErrorOutOfDateKHR) {
@@ -355,20 +402,23 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
   auto image = images_[index % images_.size()];
   uint32_t image_index = index;
   return AcquireResult{SurfaceVK::WrapSwapchainImage(
-      context_strong,  // context
-      image,           // swapchain image
-      [weak_swapchain = weak_from_this(), image, image_index]() -> bool {
+      context_strong,        // context
+      image,                 // swapchain image
+      image_damage_[index],  // existing damage
+      [weak_swapchain = weak_from_this(), image,
+       image_index](const std::optional<IRect>& frame_damage) -> bool {
         auto swapchain = weak_swapchain.lock();
         if (!swapchain) {
           return false;
         }
-        return swapchain->Present(image, image_index);
+        return swapchain->Present(image, image_index, frame_damage);
       }  // swap callback
       )};
 }
 
 bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
-                              uint32_t index) {
+                              uint32_t index,
+                              const std::optional<IRect>& frame_damage) {
   auto context_strong = context_.lock();
   if (!context_strong) {
     return false;
@@ -393,8 +443,10 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     LayoutTransition transition;
     transition.new_layout = vk::ImageLayout::ePresentSrcKHR;
     transition.cmd_buffer = vk_cmd_buffer;
-    transition.src_access = vk::AccessFlagBits::eColorAttachmentWrite;
-    transition.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    transition.src_access = vk::AccessFlagBits::eColorAttachmentWrite |
+                            vk::AccessFlagBits::eTransferWrite;
+    transition.src_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput |
+                           vk::PipelineStageFlagBits::eTransfer;
     transition.dst_access = {};
     transition.dst_stage = vk::PipelineStageFlagBits::eBottomOfPipe;
 
@@ -436,6 +488,25 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
   present_info.setImageIndices(indices);
   present_info.setWaitSemaphores(*sync->present_ready);
 
+  // Let the compositor know which part of the image changed.
+  vk::RectLayerKHR present_rect;
+  vk::PresentRegionKHR present_region;
+  vk::PresentRegionsKHR present_regions;
+  if (supports_incremental_present_ && frame_damage.has_value()) {
+    present_rect.offset =
+        vk::Offset2D{static_cast<int32_t>(frame_damage->origin.x),
+                     static_cast<int32_t>(frame_damage->origin.y)};
+    present_rect.extent =
+        vk::Extent2D{static_cast<uint32_t>(frame_damage->size.width),
+                     static_cast<uint32_t>(frame_damage->size.height)};
+    present_region.setRectangles(present_rect);
+    present_regions.setRegions(present_region);
+    present_info.setPNext(&present_regions);
+  }
+
+  UpdateImageDamage(index, frame_damage);
+
+  TRACE_EVENT0("impeller", "SwapchainPresent");
   switch (auto result = present_queue_.presentKHR(present_info)) {
     case vk::Result::eErrorOutOfDateKHR:
       // Caller will recreate the impl on acquisition, not submission.
@@ -454,4 +525,24 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
   return false;
 }
 
+void SwapchainImplVK::UpdateImageDamage(
+    size_t index,
+    const std::optional<IRect>& frame_damage) {
+  // The presented image is now up to date, and every other image that was
+  // rendered into before misses this frame's changes on top of its own.
+  const auto damage =
+      frame_damage.value_or(IRect::MakeSize(images_[index]->GetSize()));
+  for (size_t i = 0; i < image_damage_.size(); i++) {
+    if (i == index) {
+      image_damage_[i] = IRect{};
+    } else if (!image_damage_[i].has_value() || damage.IsEmpty()) {
+      continue;
+    } else if (image_damage_[i]->IsEmpty()) {
+      image_damage_[i] = damage;
+    } else {
+      image_damage_[i] = image_damage_[i]->Union(damage);
+    }
+  }
+}
+
 }  // namespace impeller
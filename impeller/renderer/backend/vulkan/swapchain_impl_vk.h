@@ -5,9 +5,12 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <variant>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
@@ -62,15 +65,24 @@ class SwapchainImplVK final
   vk::Format surface_format_ = vk::Format::eUndefined;
   vk::UniqueSwapchainKHR swapchain_;
   std::vector<std::shared_ptr<SwapchainImageVK>> images_;
+  // The region of each image that is out of date with the last presented
+  // frame, or `std::nullopt` if the image was never rendered into.
+  std::vector<std::optional<IRect>> image_damage_;
   std::vector<std::unique_ptr<FrameSynchronizer>> synchronizers_;
   size_t current_frame_ = 0u;
+  bool supports_incremental_present_ = false;
   bool is_valid_ = false;
 
   SwapchainImplVK(const std::shared_ptr<Context>& context,
                   vk::UniqueSurfaceKHR surface,
                   vk::SwapchainKHR old_swapchain);
 
-  bool Present(const std::shared_ptr<SwapchainImageVK>& image, uint32_t index);
+  bool Present(const std::shared_ptr<SwapchainImageVK>& image,
+               uint32_t index,
+               const std::optional<IRect>& frame_damage);
+
+  void UpdateImageDamage(size_t index,
+                         const std::optional<IRect>& frame_damage);
 
   void WaitIdle() const;
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "flutter/fml/macros.h"
 #include "impeller/base/thread.h"
 #include "impeller/core/texture_descriptor.h"
@@ -12,6 +14,8 @@
 
 namespace impeller {
 
+class SamplerVK;
+
 class TextureSourceVK {
  public:
   virtual ~TextureSourceVK();
@@ -28,6 +32,15 @@ class TextureSourceVK {
 
   vk::ImageLayout GetLayout() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The sampler that must be used to sample this texture, if any.
+  ///             Images sampled through a YCbCr conversion can only be
+  ///             sampled by pipelines with the sampler baked into their
+  ///             descriptor set layouts. See
+  ///             `PipelineVK::GetOrCreateImmutableSamplerVariant`.
+  ///
+  virtual std::shared_ptr<SamplerVK> GetImmutableSamplerVariant() const;
+
  protected:
   const TextureDescriptor desc_;
 
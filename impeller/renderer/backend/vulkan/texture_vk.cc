@@ -28,6 +28,25 @@ void TextureVK::SetLabel(std::string_view label) {
   ContextVK::Cast(*context).SetDebugName(GetImageView(), label);
 }
 
+static vk::BufferImageCopy MakeBaseLevelCopy(const TextureDescriptor& desc,
+                                             size_t slice) {
+  vk::BufferImageCopy copy;
+  copy.bufferOffset = 0u;
+  copy.bufferRowLength = 0u;    // 0u means tightly packed per spec.
+  copy.bufferImageHeight = 0u;  // 0u means tightly packed per spec.
+  copy.imageOffset.x = 0u;
+  copy.imageOffset.y = 0u;
+  copy.imageOffset.z = 0u;
+  copy.imageExtent.width = desc.size.width;
+  copy.imageExtent.height = desc.size.height;
+  copy.imageExtent.depth = 1u;
+  copy.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+  copy.imageSubresource.mipLevel = 0u;
+  copy.imageSubresource.baseArrayLayer = slice;
+  copy.imageSubresource.layerCount = 1u;
+  return copy;
+}
+
 bool TextureVK::OnSetContents(const uint8_t* contents,
                               size_t length,
                               size_t slice) {
@@ -57,6 +76,15 @@ bool TextureVK::OnSetContents(const uint8_t* contents,
     return false;
   }
 
+  // The first upload into a 2D texture may run on a dedicated transfer queue.
+  // Its previous contents are undefined, so no queue owns the image yet.
+  const auto& context_vk = ContextVK::Cast(*context);
+  if (context_vk.HasDedicatedTransferQueue() &&
+      desc.type == TextureType::kTexture2D &&
+      GetLayout() == vk::ImageLayout::eUndefined) {
+    return SetContentsOnTransferQueue(context_vk, staging_buffer, slice);
+  }
+
   auto cmd_buffer = context->CreateCommandBuffer();
 
   if (!cmd_buffer) {
@@ -83,20 +111,7 @@ bool TextureVK::OnSetContents(const uint8_t* contents,
     return false;
   }
 
-  vk::BufferImageCopy copy;
-  copy.bufferOffset = 0u;
-  copy.bufferRowLength = 0u;    // 0u means tightly packed per spec.
-  copy.bufferImageHeight = 0u;  // 0u means tightly packed per spec.
-  copy.imageOffset.x = 0u;
-  copy.imageOffset.y = 0u;
-  copy.imageOffset.z = 0u;
-  copy.imageExtent.width = desc.size.width;
-  copy.imageExtent.height = desc.size.height;
-  copy.imageExtent.depth = 1u;
-  copy.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
-  copy.imageSubresource.mipLevel = 0u;
-  copy.imageSubresource.baseArrayLayer = slice;
-  copy.imageSubresource.layerCount = 1u;
+  const auto copy = MakeBaseLevelCopy(desc, slice);
 
   vk_cmd_buffer.copyBufferToImage(
       DeviceBufferVK::Cast(*staging_buffer).GetBuffer(),  // src buffer
@@ -109,6 +124,85 @@ bool TextureVK::OnSetContents(const uint8_t* contents,
   return cmd_buffer->SubmitCommands();
 }
 
+bool TextureVK::SetContentsOnTransferQueue(
+    const ContextVK& context,
+    const std::shared_ptr<DeviceBuffer>& staging_buffer,
+    size_t slice) {
+  const auto& desc = GetTextureDescriptor();
+  auto encoder = context.CreateTransferCommandEncoder();
+  if (!encoder || !encoder->Track(staging_buffer) || !encoder->Track(source_)) {
+    return false;
+  }
+  auto [semaphore_result, semaphore] =
+      context.GetDevice().createSemaphoreUnique({});
+  if (semaphore_result != vk::Result::eSuccess) {
+    return false;
+  }
+  auto shared_semaphore = MakeSharedVK(std::move(semaphore));
+  if (!encoder->AddSignalSemaphore(shared_semaphore)) {
+    return false;
+  }
+
+  const auto& vk_cmd_buffer = encoder->GetCommandBuffer();
+
+  LayoutTransition transition;
+  transition.cmd_buffer = vk_cmd_buffer;
+  transition.new_layout = vk::ImageLayout::eTransferDstOptimal;
+  transition.src_access = {};
+  transition.src_stage = vk::PipelineStageFlagBits::eTopOfPipe;
+  transition.dst_access = vk::AccessFlagBits::eTransferWrite;
+  transition.dst_stage = vk::PipelineStageFlagBits::eTransfer;
+  if (!SetLayout(transition)) {
+    return false;
+  }
+
+  const auto copy = MakeBaseLevelCopy(desc, slice);
+  vk_cmd_buffer.copyBufferToImage(
+      DeviceBufferVK::Cast(*staging_buffer).GetBuffer(),  // src buffer
+      GetImage(),                                         // dst image
+      transition.new_layout,                              // dst image layout
+      1u,                                                 // region count
+      &copy                                               // regions
+  );
+
+  // Release the image to the graphics queue family, which acquires it with
+  // the same barrier before its first use. The layout transition happens
+  // once, between the two halves of the transfer.
+  vk::ImageMemoryBarrier barrier;
+  barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+  barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+  barrier.image = GetImage();
+  barrier.srcQueueFamilyIndex = context.GetTransferQueue()->GetIndex().family;
+  barrier.dstQueueFamilyIndex = context.GetGraphicsQueue()->GetIndex().family;
+  barrier.subresourceRange.aspectMask = ToImageAspectFlags(desc.format);
+  barrier.subresourceRange.baseMipLevel = 0u;
+  barrier.subresourceRange.levelCount = desc.mip_count;
+  barrier.subresourceRange.baseArrayLayer = 0u;
+  barrier.subresourceRange.layerCount = ToArrayLayerCount(desc.type);
+
+  auto release_barrier = barrier;
+  release_barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+  vk_cmd_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                                vk::PipelineStageFlagBits::eBottomOfPipe,
+                                {}, nullptr, nullptr, release_barrier);
+  SetLayoutWithoutEncoding(barrier.newLayout);
+
+  if (!encoder->Submit()) {
+    return false;
+  }
+
+  // Mipmaps are generated from the base level with transfer reads.
+  auto acquire_barrier = barrier;
+  acquire_barrier.dstAccessMask =
+      vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eTransferRead;
+  context.GetQueueOwnershipTransfers()->AddPendingTransfer({
+      .texture = source_,
+      .semaphore = std::move(shared_semaphore),
+      .acquire_barrier = acquire_barrier,
+  });
+  return true;
+}
+
 bool TextureVK::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
                               size_t slice) {
   // Vulkan has no threading restrictions. So we can pass this data along to the
@@ -136,6 +230,10 @@ std::shared_ptr<const TextureSourceVK> TextureVK::GetTextureSource() const {
   return source_;
 }
 
+std::shared_ptr<SamplerVK> TextureVK::GetImmutableSamplerVariant() const {
+  return source_ ? source_->GetImmutableSamplerVariant() : nullptr;
+}
+
 bool TextureVK::SetLayout(const LayoutTransition& transition) const {
   return source_ ? source_->SetLayout(transition) : false;
 }
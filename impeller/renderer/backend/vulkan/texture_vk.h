@@ -37,6 +37,8 @@ class TextureVK final : public Texture, public BackendCast<TextureVK, Texture> {
 
   std::shared_ptr<const TextureSourceVK> GetTextureSource() const;
 
+  std::shared_ptr<SamplerVK> GetImmutableSamplerVariant() const;
+
  private:
   std::weak_ptr<Context> context_;
   std::shared_ptr<TextureSourceVK> source_;
@@ -47,6 +49,11 @@ class TextureVK final : public Texture, public BackendCast<TextureVK, Texture> {
   // |Texture|
   void SetLabel(std::string_view label) override;
 
+  bool SetContentsOnTransferQueue(
+      const ContextVK& context,
+      const std::shared_ptr<DeviceBuffer>& staging_buffer,
+      size_t slice);
+
   // |Texture|
   bool OnSetContents(const uint8_t* contents,
                      size_t length,
@@ -104,6 +104,27 @@ class BlitPass {
                IPoint destination_origin = {},
                std::string label = "");
 
+  //----------------------------------------------------------------------------
+  /// @brief      Record a command to copy the contents of the buffer to a
+  ///             region of the texture. The buffer must contain tightly
+  ///             packed rows of pixels for exactly the given region.
+  ///             No work is encoded into the command buffer at this time.
+  ///
+  /// @param[in]  source              The buffer view to read for copying.
+  /// @param[in]  destination         The texture to overwrite using the source
+  ///                                 contents.
+  /// @param[in]  destination_region  The region of the destination texture to
+  ///                                 overwrite. Must lie within the texture.
+  /// @param[in]  label               The optional debug label to give the
+  ///                                 command.
+  ///
+  /// @return     If the command was valid for subsequent commitment.
+  ///
+  bool AddCopy(BufferView source,
+               std::shared_ptr<Texture> destination,
+               IRect destination_region,
+               std::string label = "");
+
   //----------------------------------------------------------------------------
   /// @brief      Record a command to generate all mip levels for a texture.
   ///             No work is encoded into the command buffer at this time.
@@ -150,7 +171,7 @@ class BlitPass {
   virtual bool OnCopyBufferToTextureCommand(
       BufferView source,
       std::shared_ptr<Texture> destination,
-      IPoint destination_origin,
+      IRect destination_region,
       std::string label) = 0;
 
   virtual bool OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
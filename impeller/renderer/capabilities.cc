@@ -33,6 +33,11 @@ class StandardCapabilities final : public Capabilities {
     return supports_texture_to_texture_blits_;
   }
 
+  // |Capabilities|
+  bool SupportsBufferToTextureBlits() const override {
+    return supports_buffer_to_texture_blits_;
+  }
+
   // |Capabilities|
   bool SupportsFramebufferFetch() const override {
     return supports_framebuffer_fetch_;
@@ -61,6 +66,11 @@ class StandardCapabilities final : public Capabilities {
     return supports_decal_tile_mode_;
   }
 
+  // |Capabilities|
+  bool SupportsTextureCompressionETC2() const override {
+    return supports_texture_compression_etc2_;
+  }
+
   // |Capabilities|
   PixelFormat GetDefaultColorFormat() const override {
     return default_color_format_;
@@ -76,18 +86,21 @@ class StandardCapabilities final : public Capabilities {
                        bool supports_offscreen_msaa,
                        bool supports_ssbo,
                        bool supports_texture_to_texture_blits,
+                       bool supports_buffer_to_texture_blits,
                        bool supports_framebuffer_fetch,
                        bool supports_compute,
                        bool supports_compute_subgroups,
                        bool supports_read_from_onscreen_texture,
                        bool supports_read_from_resolve,
                        bool supports_decal_tile_mode,
+                       bool supports_texture_compression_etc2,
                        PixelFormat default_color_format,
                        PixelFormat default_stencil_format)
       : has_threading_restrictions_(has_threading_restrictions),
         supports_offscreen_msaa_(supports_offscreen_msaa),
         supports_ssbo_(supports_ssbo),
         supports_texture_to_texture_blits_(supports_texture_to_texture_blits),
+        supports_buffer_to_texture_blits_(supports_buffer_to_texture_blits),
         supports_framebuffer_fetch_(supports_framebuffer_fetch),
         supports_compute_(supports_compute),
         supports_compute_subgroups_(supports_compute_subgroups),
@@ -95,6 +108,7 @@ class StandardCapabilities final : public Capabilities {
             supports_read_from_onscreen_texture),
         supports_read_from_resolve_(supports_read_from_resolve),
         supports_decal_tile_mode_(supports_decal_tile_mode),
+        supports_texture_compression_etc2_(supports_texture_compression_etc2),
         default_color_format_(default_color_format),
         default_stencil_format_(default_stencil_format) {}
 
@@ -104,12 +118,14 @@ class StandardCapabilities final : public Capabilities {
   bool supports_offscreen_msaa_ = false;
   bool supports_ssbo_ = false;
   bool supports_texture_to_texture_blits_ = false;
+  bool supports_buffer_to_texture_blits_ = false;
   bool supports_framebuffer_fetch_ = false;
   bool supports_compute_ = false;
   bool supports_compute_subgroups_ = false;
   bool supports_read_from_onscreen_texture_ = false;
   bool supports_read_from_resolve_ = false;
   bool supports_decal_tile_mode_ = false;
+  bool supports_texture_compression_etc2_ = false;
   PixelFormat default_color_format_ = PixelFormat::kUnknown;
   PixelFormat default_stencil_format_ = PixelFormat::kUnknown;
 
@@ -142,6 +158,12 @@ CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsTextureToTextureBlits(
   return *this;
 }
 
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsBufferToTextureBlits(
+    bool value) {
+  supports_buffer_to_texture_blits_ = value;
+  return *this;
+}
+
 CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsFramebufferFetch(
     bool value) {
   supports_framebuffer_fetch_ = value;
@@ -184,18 +206,26 @@ CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsDecalTileMode(bool value) {
   return *this;
 }
 
+CapabilitiesBuilder& CapabilitiesBuilder::SetSupportsTextureCompressionETC2(
+    bool value) {
+  supports_texture_compression_etc2_ = value;
+  return *this;
+}
+
 std::unique_ptr<Capabilities> CapabilitiesBuilder::Build() {
   return std::unique_ptr<StandardCapabilities>(new StandardCapabilities(  //
       has_threading_restrictions_,                                        //
       supports_offscreen_msaa_,                                           //
       supports_ssbo_,                                                     //
       supports_texture_to_texture_blits_,                                 //
+      supports_buffer_to_texture_blits_,                                  //
       supports_framebuffer_fetch_,                                        //
       supports_compute_,                                                  //
       supports_compute_subgroups_,                                        //
       supports_read_from_onscreen_texture_,                               //
       supports_read_from_resolve_,                                        //
       supports_decal_tile_mode_,                                          //
+      supports_texture_compression_etc2_,                                 //
       *default_color_format_,                                             //
       *default_stencil_format_                                            //
       ));
@@ -23,6 +23,8 @@ class Capabilities {
 
   virtual bool SupportsTextureToTextureBlits() const = 0;
 
+  virtual bool SupportsBufferToTextureBlits() const = 0;
+
   virtual bool SupportsFramebufferFetch() const = 0;
 
   virtual bool SupportsCompute() const = 0;
@@ -35,6 +37,8 @@ class Capabilities {
 
   virtual bool SupportsDecalTileMode() const = 0;
 
+  virtual bool SupportsTextureCompressionETC2() const = 0;
+
   virtual PixelFormat GetDefaultColorFormat() const = 0;
 
   virtual PixelFormat GetDefaultStencilFormat() const = 0;
@@ -59,6 +63,8 @@ class CapabilitiesBuilder {
 
   CapabilitiesBuilder& SetSupportsTextureToTextureBlits(bool value);
 
+  CapabilitiesBuilder& SetSupportsBufferToTextureBlits(bool value);
+
   CapabilitiesBuilder& SetSupportsFramebufferFetch(bool value);
 
   CapabilitiesBuilder& SetSupportsCompute(bool compute, bool subgroups);
@@ -74,6 +80,8 @@ class CapabilitiesBuilder {
 
   CapabilitiesBuilder& SetSupportsDecalTileMode(bool value);
 
+  CapabilitiesBuilder& SetSupportsTextureCompressionETC2(bool value);
+
   std::unique_ptr<Capabilities> Build();
 
  private:
@@ -81,12 +89,14 @@ class CapabilitiesBuilder {
   bool supports_offscreen_msaa_ = false;
   bool supports_ssbo_ = false;
   bool supports_texture_to_texture_blits_ = false;
+  bool supports_buffer_to_texture_blits_ = false;
   bool supports_framebuffer_fetch_ = false;
   bool supports_compute_ = false;
   bool supports_compute_subgroups_ = false;
   bool supports_read_from_onscreen_texture_ = false;
   bool supports_read_from_resolve_ = false;
   bool supports_decal_tile_mode_ = false;
+  bool supports_texture_compression_etc2_ = false;
   std::optional<PixelFormat> default_color_format_ = std::nullopt;
   std::optional<PixelFormat> default_stencil_format_ = std::nullopt;
 
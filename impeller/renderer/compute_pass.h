@@ -32,6 +32,12 @@ class ComputePass {
 
   void SetGridSize(const ISize& size);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the number of threads in each thread group. If it differs
+  ///             from the grid size, the grid is covered with as many whole
+  ///             thread groups as it takes, and kernels must skip the
+  ///             invocations that fall outside of the grid.
+  ///
   void SetThreadGroupSize(const ISize& size);
 
   HostBuffer& GetTransientsBuffer();
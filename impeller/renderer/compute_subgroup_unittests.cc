@@ -490,5 +490,49 @@ TEST_P(ComputeSubgroupTest, QuadAndCubicInOnePath) {
   }
 }
 
+TEST_P(ComputeSubgroupTest, StrokePadsVertexBufferWithLastVertex) {
+  using SS = StrokeComputeShader;
+
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  ASSERT_TRUE(context->GetCapabilities()->SupportsComputeSubgroups());
+
+  auto vertex_buffer = CreateHostVisibleDeviceBuffer<SS::VertexBuffer<2048>>(
+      context, "VertexBuffer");
+  auto vertex_buffer_count =
+      CreateHostVisibleDeviceBuffer<SS::VertexBufferCount>(context,
+                                                           "VertexBufferCount");
+  ::memset(vertex_buffer_count->AsBufferView().contents, 0,
+           sizeof(SS::VertexBufferCount));
+
+  auto path = PathBuilder{}.MoveTo({10, 10}).LineTo({100, 10}).TakePath();
+  auto max_vertex_count = ComputeTessellator::GetMaxStrokeVertexCount(path);
+  ASSERT_TRUE(max_vertex_count.has_value());
+  ASSERT_EQ(max_vertex_count.value(), 6u);
+
+  fml::AutoResetWaitableEvent latch;
+  auto status = ComputeTessellator{}.SetStrokeWidth(4).Tessellate(
+      path, context, vertex_buffer->AsBufferView(),
+      vertex_buffer_count->AsBufferView(),
+      [&latch](CommandBuffer::Status status) {
+        EXPECT_EQ(status, CommandBuffer::Status::kCompleted);
+        latch.Signal();
+      });
+  ASSERT_EQ(status, ComputeTessellator::Status::kOk);
+  latch.Wait();
+
+  auto vertex_count = reinterpret_cast<SS::VertexBufferCount*>(
+                          vertex_buffer_count->AsBufferView().contents)
+                          ->count;
+  ASSERT_EQ(vertex_count, 6u);
+  auto vertex_buffer_data = reinterpret_cast<SS::VertexBuffer<2048>*>(
+      vertex_buffer->AsBufferView().contents);
+  auto last = vertex_buffer_data->position[vertex_count - 1];
+  for (size_t i = vertex_count; i < 2048; i++) {
+    ASSERT_EQ(vertex_buffer_data->position[i].x, last.x);
+    ASSERT_EQ(vertex_buffer_data->position[i].y, last.y);
+  }
+}
+
 }  // namespace testing
 }  // namespace impeller
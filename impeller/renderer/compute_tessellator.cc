@@ -58,6 +58,45 @@ ComputeTessellator& ComputeTessellator::SetQuadraticTolerance(Scalar value) {
   return *this;
 }
 
+namespace {
+
+struct ComponentCounts {
+  size_t cubic_count = 0;
+  size_t quad_count = 0;
+  size_t line_count = 0;
+};
+
+// Quadratics and lines are estimated for the worst case of six per
+// subdivided component.
+std::optional<ComponentCounts> GetComponentCounts(const Path& path) {
+  ComponentCounts counts;
+  counts.cubic_count = path.GetComponentCount(Path::ComponentType::kCubic);
+  counts.quad_count = path.GetComponentCount(Path::ComponentType::kQuadratic) +
+                      (counts.cubic_count * 6);
+  counts.line_count = path.GetComponentCount(Path::ComponentType::kLinear) +
+                      (counts.quad_count * 6);
+  if (counts.cubic_count > ComputeTessellator::kMaxCubicCount ||
+      counts.quad_count > ComputeTessellator::kMaxQuadCount ||
+      counts.line_count > ComputeTessellator::kMaxLineCount) {
+    return std::nullopt;
+  }
+  return counts;
+}
+
+}  // namespace
+
+// static
+std::optional<size_t> ComputeTessellator::GetMaxStrokeVertexCount(
+    const Path& path) {
+  auto counts = GetComponentCounts(path);
+  // The polyline has one more point than there are lines.
+  if (!counts.has_value() || counts->line_count >= kMaxPolylinePointCount) {
+    return std::nullopt;
+  }
+  // Four vertices per line and two more for the end of the stroke.
+  return counts->line_count * 4 + 2;
+}
+
 ComputeTessellator::Status ComputeTessellator::Tessellate(
     const Path& path,
     const std::shared_ptr<Context>& context,
@@ -68,15 +107,11 @@ ComputeTessellator::Status ComputeTessellator::Tessellate(
   using PS = PathPolylineComputeShader;
   using SS = StrokeComputeShader;
 
-  auto cubic_count = path.GetComponentCount(Path::ComponentType::kCubic);
-  auto quad_count = path.GetComponentCount(Path::ComponentType::kQuadratic) +
-                    (cubic_count * 6);
-  auto line_count =
-      path.GetComponentCount(Path::ComponentType::kLinear) + (quad_count * 6);
-  if (cubic_count > kMaxCubicCount || quad_count > kMaxQuadCount ||
-      line_count > kMaxLineCount) {
+  auto counts = GetComponentCounts(path);
+  if (!counts.has_value()) {
     return Status::kTooManyComponents;
   }
+  auto line_count = counts->line_count;
   PS::Cubics<kMaxCubicCount> cubics{.count = 0};
   PS::Quads<kMaxQuadCount> quads{.count = 0};
   PS::Lines<kMaxLineCount> lines{.count = 0};
@@ -103,7 +138,8 @@ ComputeTessellator::Status ComputeTessellator::Tessellate(
       [](size_t index, const ContourComponent& contour) {});
 
   auto polyline_buffer =
-      CreateDeviceBuffer<PS::Polyline<2048>>(context, "Polyline");
+      CreateDeviceBuffer<PS::Polyline<kMaxPolylinePointCount>>(context,
+                                                               "Polyline");
 
   auto cmd_buffer = context->CreateCommandBuffer();
   auto pass = cmd_buffer->CreateComputePass();
@@ -160,6 +196,8 @@ ComputeTessellator::Status ComputeTessellator::Tessellate(
         .cap = static_cast<uint32_t>(stroke_cap_),
         .join = static_cast<uint32_t>(stroke_join_),
         .miter_limit = miter_limit_,
+        .vertex_capacity =
+            static_cast<uint32_t>(vertex_buffer.range.length / sizeof(Point)),
     };
     SS::BindConfig(cmd, pass->GetTransientsBuffer().EmplaceUniform(config));
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include "flutter/fml/macros.h"
 #include "impeller/core/buffer_view.h"
 #include "impeller/geometry/path.h"
@@ -27,6 +29,7 @@ class ComputeTessellator {
   static constexpr size_t kMaxLineCount = 4096;
   static constexpr size_t kMaxComponentCount =
       kMaxCubicCount + kMaxQuadCount + kMaxLineCount;
+  static constexpr size_t kMaxPolylinePointCount = 2048;
 
   enum class Status {
     kCommandInvalid,
@@ -47,6 +50,15 @@ class ComputeTessellator {
   ComputeTessellator& SetCubicAccuracy(Scalar value);
   ComputeTessellator& SetQuadraticTolerance(Scalar value);
 
+  //----------------------------------------------------------------------------
+  /// @brief      An upper bound for the number of vertices in the triangle
+  ///             strip generated for a stroke of the path.
+  ///
+  /// @return     The bound, or std::nullopt if the path has too many
+  ///             components to be tessellated on the GPU.
+  ///
+  static std::optional<size_t> GetMaxStrokeVertexCount(const Path& path);
+
   //----------------------------------------------------------------------------
   /// @brief      Generates triangles from the path.
   ///             If the data needs to be synchronized back to the CPU, e.g.
@@ -58,6 +70,10 @@ class ComputeTessellator {
   ///             the buffers are not heap allocated, so no additional
   ///             synchronization mechanism is provided.
   ///
+  ///             Vertices in |vertex_buffer| past the end of the stroke are
+  ///             set to its last vertex, so the whole buffer may be drawn as
+  ///             a triangle strip without knowing the vertex count.
+  ///
   /// @return  A |Status| value indicating success or failure of the submission.
   ///
   // TODO(dnfield): Provide additional synchronization methods here for Vulkan
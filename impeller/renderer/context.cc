@@ -14,4 +14,17 @@ bool Context::UpdateOffscreenLayerPixelFormat(PixelFormat format) {
   return false;
 }
 
+std::shared_ptr<HostBufferRing> Context::GetHostBufferRing() const {
+  return nullptr;
+}
+
+std::shared_ptr<fml::ConcurrentTaskRunner> Context::GetWorkerTaskRunner()
+    const {
+  return nullptr;
+}
+
+std::shared_ptr<GPUTracer> Context::GetGPUTracer() const {
+  return nullptr;
+}
+
 }  // namespace impeller
@@ -11,6 +11,10 @@
 #include "impeller/core/formats.h"
 #include "impeller/renderer/capabilities.h"
 
+namespace fml {
+class ConcurrentTaskRunner;
+}  // namespace fml
+
 namespace impeller {
 
 class ShaderLibrary;
@@ -18,11 +22,25 @@ class SamplerLibrary;
 class CommandBuffer;
 class PipelineLibrary;
 class Allocator;
+class HostBufferRing;
+class GPUTracer;
 
 class Context : public std::enable_shared_from_this<Context> {
  public:
+  enum class BackendType {
+    kMetal,
+    kOpenGLES,
+    kVulkan,
+  };
+
   virtual ~Context();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The graphics API of the context, for embedders that need to
+  ///             reach into the backend, like external textures do.
+  ///
+  virtual BackendType GetBackendType() const = 0;
+
   virtual bool IsValid() const = 0;
 
   virtual const std::shared_ptr<const Capabilities>& GetCapabilities()
@@ -40,6 +58,28 @@ class Context : public std::enable_shared_from_this<Context> {
 
   virtual std::shared_ptr<CommandBuffer> CreateCommandBuffer() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The ring that the transients buffers of render passes write
+  ///             into, or nullptr if this backend can't tell when the GPU is
+  ///             done reading from a device buffer and the transients must
+  ///             be copied into a new device buffer for every pass.
+  ///
+  virtual std::shared_ptr<HostBufferRing> GetHostBufferRing() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A task runner that CPU side work like glyph rasterization may
+  ///             be spread over, or nullptr if the context wasn't given one.
+  ///
+  virtual std::shared_ptr<fml::ConcurrentTaskRunner> GetWorkerTaskRunner()
+      const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The tracer that collects the GPU timings of the passes of
+  ///             this context, or nullptr if the backend or device doesn't
+  ///             support timestamp queries.
+  ///
+  virtual std::shared_ptr<GPUTracer> GetGPUTracer() const;
+
  protected:
   Context();
 
@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/gpu_tracer.h"
+
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+GPUTracer::GPUTracer() = default;
+
+GPUTracer::~GPUTracer() = default;
+
+void GPUTracer::SetEnabled(bool enabled) {
+  enabled_ = enabled;
+}
+
+bool GPUTracer::IsEnabled() const {
+  return enabled_.load(std::memory_order_relaxed);
+}
+
+GPUTracer::FrameID GPUTracer::BeginPass() {
+  std::scoped_lock lock(mutex_);
+  auto& state = frames_[current_frame_];
+  state.passes++;
+  state.pending_passes++;
+  return current_frame_;
+}
+
+void GPUTracer::EndPass(FrameID frame,
+                        const std::string& label,
+                        std::optional<fml::TimeDelta> gpu_duration) {
+  if (gpu_duration.has_value()) {
+    // The GPU clock is not related to the CPU one, so the pass is placed so
+    // that it ends when its timings were read back.
+    const auto end = fml::TimePoint::Now();
+    fml::tracing::TraceEventAsyncComplete("impeller", "GPUPass",
+                                          end - gpu_duration.value(), end,
+                                          "label", label.c_str());
+  }
+
+  std::scoped_lock lock(mutex_);
+  auto found = frames_.find(frame);
+  if (found == frames_.end()) {
+    return;
+  }
+  auto& state = found->second;
+  if (state.pending_passes > 0) {
+    state.pending_passes--;
+  }
+  if (gpu_duration.has_value()) {
+    state.gpu_time = state.gpu_time + gpu_duration.value();
+  }
+  FinishFrameIfComplete(frame);
+}
+
+void GPUTracer::MarkFrameEnd() {
+  std::scoped_lock lock(mutex_);
+  const auto frame = current_frame_++;
+  frames_[frame].ended = true;
+  FinishFrameIfComplete(frame);
+  while (!frames_.empty() &&
+         frames_.begin()->first + kMaxPendingFrames < current_frame_) {
+    frames_.erase(frames_.begin());
+  }
+}
+
+std::optional<fml::TimeDelta> GPUTracer::GetLastFrameGPUTime() const {
+  std::scoped_lock lock(mutex_);
+  return last_frame_gpu_time_;
+}
+
+void GPUTracer::FinishFrameIfComplete(FrameID frame) {
+  auto found = frames_.find(frame);
+  if (found == frames_.end() || !found->second.ended ||
+      found->second.pending_passes > 0) {
+    return;
+  }
+  const auto state = found->second;
+  frames_.erase(found);
+  if (state.passes == 0) {
+    return;
+  }
+  last_frame_gpu_time_ = state.gpu_time;
+  FML_TRACE_COUNTER("impeller", "GPUFrameTime",
+                    reinterpret_cast<int64_t>(this),  //
+                    "Micros", last_frame_gpu_time_->ToMicroseconds());
+}
+
+}  // namespace impeller
@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the time the GPU took to execute passes, as measured
+///             by the timestamp queries of the backend, and adds them up per
+///             frame.
+///
+///             Backends call `BeginPass` when they encode a timed pass and
+///             `EndPass` once its timings are read back, usually on another
+///             thread after the GPU is done with it. The duration of each
+///             pass is emitted as a timeline event that ends when its
+///             timings were read back, and the duration of each frame as a
+///             timeline counter once all its passes were.
+///
+///             Tracing is disabled by default, in which case backends don't
+///             issue any queries. This class is thread safe.
+///
+class GPUTracer {
+ public:
+  using FrameID = uint64_t;
+
+  GPUTracer();
+
+  ~GPUTracer();
+
+  void SetEnabled(bool enabled);
+
+  bool IsEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the backend when it encodes a pass it will read
+  ///             the GPU timings of.
+  ///
+  /// @return     The frame the pass belongs to, to be passed to `EndPass`.
+  ///
+  FrameID BeginPass();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the backend with the GPU timings of a pass, or
+  ///             `std::nullopt` if they could not be read back.
+  ///
+  void EndPass(FrameID frame,
+               const std::string& label,
+               std::optional<fml::TimeDelta> gpu_duration);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Marks the end of the current frame. Passes that begin after
+  ///             this belong to the next frame.
+  ///
+  void MarkFrameEnd();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The GPU time of the passes of the last frame that had timed
+  ///             passes, once all of them were read back.
+  ///
+  std::optional<fml::TimeDelta> GetLastFrameGPUTime() const;
+
+ private:
+  // Frames that have more pending passes than this many frames later are
+  // dropped, so that lost query results can't grow `frames_`.
+  static constexpr FrameID kMaxPendingFrames = 8;
+
+  struct FrameState {
+    size_t passes = 0;
+    size_t pending_passes = 0;
+    fml::TimeDelta gpu_time;
+    bool ended = false;
+  };
+
+  std::atomic<bool> enabled_ = false;
+  mutable std::mutex mutex_;
+  FrameID current_frame_ = 0;
+  std::map<FrameID, FrameState> frames_;
+  std::optional<fml::TimeDelta> last_frame_gpu_time_;
+
+  void FinishFrameIfComplete(FrameID frame);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUTracer);
+};
+
+}  // namespace impeller
@@ -0,0 +1,61 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/gpu_tracer.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(GPUTracerTest, IsDisabledByDefault) {
+  GPUTracer tracer;
+  ASSERT_FALSE(tracer.IsEnabled());
+  tracer.SetEnabled(true);
+  ASSERT_TRUE(tracer.IsEnabled());
+}
+
+TEST(GPUTracerTest, AddsUpPassesOfAFrame) {
+  GPUTracer tracer;
+  ASSERT_FALSE(tracer.GetLastFrameGPUTime().has_value());
+
+  auto first = tracer.BeginPass();
+  auto second = tracer.BeginPass();
+  tracer.MarkFrameEnd();
+  auto next_frame = tracer.BeginPass();
+  ASSERT_EQ(first, second);
+  ASSERT_NE(first, next_frame);
+
+  tracer.EndPass(first, "first", fml::TimeDelta::FromMicroseconds(100));
+  // The frame isn't complete until all of its passes were read back.
+  ASSERT_FALSE(tracer.GetLastFrameGPUTime().has_value());
+  tracer.EndPass(second, "second", fml::TimeDelta::FromMicroseconds(50));
+  ASSERT_EQ(tracer.GetLastFrameGPUTime(),
+            fml::TimeDelta::FromMicroseconds(150));
+
+  // Passes of a frame that has not ended don't complete it.
+  tracer.EndPass(next_frame, "next", fml::TimeDelta::FromMicroseconds(10));
+  ASSERT_EQ(tracer.GetLastFrameGPUTime(),
+            fml::TimeDelta::FromMicroseconds(150));
+  tracer.MarkFrameEnd();
+  ASSERT_EQ(tracer.GetLastFrameGPUTime(), fml::TimeDelta::FromMicroseconds(10));
+}
+
+TEST(GPUTracerTest, SkipsPassesThatWereNotReadBack) {
+  GPUTracer tracer;
+  auto first = tracer.BeginPass();
+  auto second = tracer.BeginPass();
+  tracer.MarkFrameEnd();
+  tracer.EndPass(first, "first", fml::TimeDelta::FromMicroseconds(100));
+  tracer.EndPass(second, "second", std::nullopt);
+  ASSERT_EQ(tracer.GetLastFrameGPUTime(),
+            fml::TimeDelta::FromMicroseconds(100));
+
+  // Frames without timed passes don't replace the last frame GPU time.
+  tracer.MarkFrameEnd();
+  ASSERT_EQ(tracer.GetLastFrameGPUTime(),
+            fml::TimeDelta::FromMicroseconds(100));
+}
+
+}  // namespace testing
+}  // namespace impeller
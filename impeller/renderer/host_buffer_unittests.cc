@@ -2,12 +2,65 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cstring>
+#include <vector>
+
 #include "flutter/testing/testing.h"
+#include "impeller/core/allocator.h"
+#include "impeller/core/device_buffer.h"
 #include "impeller/core/host_buffer.h"
+#include "impeller/core/host_buffer_ring.h"
 
 namespace impeller {
 namespace testing {
 
+namespace {
+
+class TestDeviceBuffer final : public DeviceBuffer {
+ public:
+  explicit TestDeviceBuffer(const DeviceBufferDescriptor& desc)
+      : DeviceBuffer(desc), contents_(desc.size) {}
+
+  bool SetLabel(const std::string& label) override { return true; }
+
+  bool SetLabel(const std::string& label, Range range) override {
+    return true;
+  }
+
+  uint8_t* OnGetContents() const override {
+    return const_cast<uint8_t*>(contents_.data());
+  }
+
+ private:
+  std::vector<uint8_t> contents_;
+
+  bool OnCopyHostBuffer(const uint8_t* source,
+                        Range source_range,
+                        size_t offset) override {
+    ::memmove(contents_.data() + offset, source + source_range.offset,
+              source_range.length);
+    return true;
+  }
+};
+
+class TestAllocator final : public Allocator {
+ public:
+  ISize GetMaxTextureSizeSupported() const override { return {}; }
+
+ private:
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    return std::make_shared<TestDeviceBuffer>(desc);
+  }
+
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return nullptr;
+  }
+};
+
+}  // namespace
+
 TEST(HostBufferTest, TestInitialization) {
   ASSERT_TRUE(HostBuffer::Create());
   // Newly allocated buffers don't touch the heap till they have to.
@@ -75,5 +128,84 @@ TEST(HostBufferTest, CanEmplaceWithAlignment) {
   }
 }
 
+TEST(HostBufferTest, RingBackedBufferWritesIntoBlocks) {
+  auto ring = std::make_shared<HostBufferRing>(
+      std::make_shared<TestAllocator>(), /*block_length=*/64u);
+  auto buffer = HostBuffer::Create(ring);
+
+  struct alignas(16) Align16 {
+    uint8_t pad[16];
+  };
+  Align16 data = {};
+  data.pad[0] = 42u;
+
+  auto first = buffer->Emplace(uint8_t{7u});
+  ASSERT_TRUE(first);
+  ASSERT_EQ(first.range, Range(0u, 1u));
+
+  auto second = buffer->Emplace(data);
+  ASSERT_TRUE(second);
+  ASSERT_EQ(second.range, Range(16u, 16u));
+  // The view refers to the mapped block and not to the host buffer.
+  ASSERT_EQ(second.buffer, first.buffer);
+  ASSERT_EQ(second.contents[second.range.offset], 42u);
+
+  for (size_t i = 0; i < 2; i++) {
+    ASSERT_TRUE(buffer->Emplace(data));
+  }
+  // The block is full, the next emplacement starts a new one without
+  // moving what was already written.
+  auto overflow = buffer->Emplace(data);
+  ASSERT_TRUE(overflow);
+  ASSERT_EQ(overflow.range, Range(0u, 16u));
+  ASSERT_NE(overflow.buffer, first.buffer);
+  ASSERT_EQ(first.contents[0], 7u);
+  ASSERT_EQ(ring->GetAllocatedBlockCount(), 2u);
+}
+
+TEST(HostBufferTest, RingRecyclesBlocksOnlyOnceUnreferenced) {
+  auto ring = std::make_shared<HostBufferRing>(
+      std::make_shared<TestAllocator>(), /*block_length=*/64u);
+
+  std::shared_ptr<const Buffer> in_flight;
+  {
+    auto frame = HostBuffer::Create(ring);
+    auto view = frame->Emplace(uint32_t{1u});
+    ASSERT_TRUE(view);
+    // Stands in for the command buffer tracking the block until its fence
+    // is signaled.
+    in_flight = view.buffer;
+  }
+  ASSERT_EQ(ring->GetRetainedBlockCount(), 1u);
+
+  {
+    auto frame = HostBuffer::Create(ring);
+    auto view = frame->Emplace(uint32_t{2u});
+    ASSERT_TRUE(view);
+    ASSERT_NE(view.buffer, in_flight);
+  }
+  ASSERT_EQ(ring->GetRecycledBlockCount(), 0u);
+  ASSERT_EQ(ring->GetAllocatedBlockCount(), 2u);
+
+  in_flight.reset();
+  {
+    auto frame = HostBuffer::Create(ring);
+    ASSERT_TRUE(frame->Emplace(uint32_t{3u}));
+  }
+  ASSERT_EQ(ring->GetRecycledBlockCount(), 1u);
+  ASSERT_EQ(ring->GetAllocatedBlockCount(), 2u);
+
+  // Oversized emplacements get a dedicated buffer that isn't retained.
+  {
+    auto frame = HostBuffer::Create(ring);
+    std::vector<uint8_t> large(128u);
+    auto view = frame->Emplace(large.data(), large.size(), 1u);
+    ASSERT_TRUE(view);
+    ASSERT_EQ(view.range, Range(0u, 128u));
+  }
+  ASSERT_EQ(ring->GetAllocatedBlockCount(), 2u);
+  ASSERT_EQ(ring->GetRetainedBlockCount(), 2u);
+}
+
 }  // namespace  testing
 }  // namespace impeller
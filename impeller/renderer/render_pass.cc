@@ -4,13 +4,21 @@
 
 #include "impeller/renderer/render_pass.h"
 
+#include "impeller/renderer/context.h"
+
 namespace impeller {
 
+static std::shared_ptr<HostBufferRing> GetHostBufferRing(
+    const std::weak_ptr<const Context>& weak_context) {
+  auto context = weak_context.lock();
+  return context ? context->GetHostBufferRing() : nullptr;
+}
+
 RenderPass::RenderPass(std::weak_ptr<const Context> context,
                        const RenderTarget& target)
     : context_(std::move(context)),
       render_target_(target),
-      transients_buffer_(HostBuffer::Create()) {}
+      transients_buffer_(HostBuffer::Create(GetHostBufferRing(context_))) {}
 
 RenderPass::~RenderPass() = default;
 
@@ -49,6 +57,16 @@ bool RenderPass::AddCommand(Command command) {
     }
   }
 
+  if (clip_scissor_.has_value()) {
+    command.scissor = command.scissor.has_value()
+                          ? command.scissor->Intersection(clip_scissor_.value())
+                          : clip_scissor_;
+    if (!command.scissor.has_value()) {
+      // Nothing is inside the scissor, so there is nothing to draw.
+      return true;
+    }
+  }
+
   if (command.index_count == 0u) {
     // Essentially a no-op. Don't record the command but this is not necessary
     // an error either.
@@ -61,10 +79,25 @@ bool RenderPass::AddCommand(Command command) {
     return true;
   }
 
+  if (commands_.empty() || commands_.back().pipeline != command.pipeline) {
+    pipeline_switch_count_++;
+  }
   commands_.emplace_back(std::move(command));
   return true;
 }
 
+void RenderPass::SetClipScissor(std::optional<IRect> scissor) {
+  clip_scissor_ = scissor;
+}
+
+size_t RenderPass::GetCommandCount() const {
+  return commands_.size();
+}
+
+size_t RenderPass::GetPipelineSwitchCount() const {
+  return pipeline_switch_count_;
+}
+
 bool RenderPass::EncodeCommands() const {
   auto context = context_.lock();
   // The context could have been collected in the meantime.
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 
 #include "impeller/renderer/command.h"
@@ -48,6 +49,28 @@ class RenderPass {
   ///
   bool AddCommand(Command command);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Restrict the commands recorded from now on to a scissor rect,
+  ///             in addition to any scissor set on the commands themselves.
+  ///             Commands that end up with an empty scissor are dropped.
+  ///
+  /// @param[in]  scissor  The scissor rect, which must lie within the render
+  ///                      target, or std::nullopt to stop restricting
+  ///                      commands.
+  ///
+  void SetClipScissor(std::optional<IRect> scissor);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of commands recorded so far.
+  ///
+  size_t GetCommandCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of commands recorded so far that use a different
+  ///             pipeline than the command before them.
+  ///
+  size_t GetPipelineSwitchCount() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Encode the recorded commands to the underlying command buffer.
   ///
@@ -61,6 +84,8 @@ class RenderPass {
   const RenderTarget render_target_;
   std::shared_ptr<HostBuffer> transients_buffer_;
   std::vector<Command> commands_;
+  size_t pipeline_switch_count_ = 0u;
+  std::optional<IRect> clip_scissor_;
 
   RenderPass(std::weak_ptr<const Context> context, const RenderTarget& target);
 
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/render_target.h"
 
+#include "flutter/fml/logging.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/allocator.h"
@@ -12,6 +13,47 @@
 
 namespace impeller {
 
+RenderTargetAllocator::RenderTargetAllocator(
+    std::shared_ptr<Allocator> allocator)
+    : allocator_(std::move(allocator)) {}
+
+RenderTargetAllocator::~RenderTargetAllocator() = default;
+
+std::shared_ptr<Texture> RenderTargetAllocator::CreateTexture(
+    const TextureDescriptor& desc) {
+  return allocator_->CreateTexture(desc);
+}
+
+void RenderTargetAllocator::Start() {}
+
+void RenderTargetAllocator::End() {}
+
+const std::shared_ptr<Allocator>& RenderTargetAllocator::GetAllocator() const {
+  return allocator_;
+}
+
+/// Attachments that are never loaded from and whose contents are discarded at
+/// the end of the pass only live in tile memory on tile based GPUs. Use
+/// transient storage for them regardless of the requested storage mode so
+/// they need no backing allocation.
+static StorageMode GetAttachmentStorageMode(StorageMode requested,
+                                            LoadAction load_action,
+                                            StoreAction store_action) {
+  if (load_action == LoadAction::kLoad) {
+    return requested;
+  }
+  switch (store_action) {
+    case StoreAction::kDontCare:
+    // The multisample texture itself is discarded once it is resolved.
+    case StoreAction::kMultisampleResolve:
+      return StorageMode::kDeviceTransient;
+    case StoreAction::kStore:
+    case StoreAction::kStoreAndMultisampleResolve:
+      return requested;
+  }
+  FML_UNREACHABLE();
+}
+
 RenderTarget::RenderTarget() = default;
 
 RenderTarget::~RenderTarget() = default;
@@ -205,6 +247,18 @@ RenderTarget RenderTarget::CreateOffscreen(
     const std::string& label,
     AttachmentConfig color_attachment_config,
     std::optional<AttachmentConfig> stencil_attachment_config) {
+  RenderTargetAllocator allocator(context.GetResourceAllocator());
+  return CreateOffscreen(context, allocator, size, label,
+                         color_attachment_config, stencil_attachment_config);
+}
+
+RenderTarget RenderTarget::CreateOffscreen(
+    const Context& context,
+    RenderTargetAllocator& allocator,
+    ISize size,
+    const std::string& label,
+    AttachmentConfig color_attachment_config,
+    std::optional<AttachmentConfig> stencil_attachment_config) {
   if (size.IsEmpty()) {
     return {};
   }
@@ -222,7 +276,7 @@ RenderTarget RenderTarget::CreateOffscreen(
   color0.clear_color = Color::BlackTransparent();
   color0.load_action = color_attachment_config.load_action;
   color0.store_action = color_attachment_config.store_action;
-  color0.texture = context.GetResourceAllocator()->CreateTexture(color_tex0);
+  color0.texture = allocator.CreateTexture(color_tex0);
 
   if (!color0.texture) {
     return {};
@@ -232,7 +286,10 @@ RenderTarget RenderTarget::CreateOffscreen(
 
   if (stencil_attachment_config.has_value()) {
     TextureDescriptor stencil_tex0;
-    stencil_tex0.storage_mode = stencil_attachment_config->storage_mode;
+    stencil_tex0.storage_mode =
+        GetAttachmentStorageMode(stencil_attachment_config->storage_mode,
+                                 stencil_attachment_config->load_action,
+                                 stencil_attachment_config->store_action);
     stencil_tex0.format = context.GetCapabilities()->GetDefaultStencilFormat();
     stencil_tex0.size = size;
     stencil_tex0.usage =
@@ -242,8 +299,7 @@ RenderTarget RenderTarget::CreateOffscreen(
     stencil0.load_action = stencil_attachment_config->load_action;
     stencil0.store_action = stencil_attachment_config->store_action;
     stencil0.clear_stencil = 0u;
-    stencil0.texture =
-        context.GetResourceAllocator()->CreateTexture(stencil_tex0);
+    stencil0.texture = allocator.CreateTexture(stencil_tex0);
 
     if (!stencil0.texture) {
       return {};
@@ -263,6 +319,19 @@ RenderTarget RenderTarget::CreateOffscreenMSAA(
     const std::string& label,
     AttachmentConfigMSAA color_attachment_config,
     std::optional<AttachmentConfig> stencil_attachment_config) {
+  RenderTargetAllocator allocator(context.GetResourceAllocator());
+  return CreateOffscreenMSAA(context, allocator, size, label,
+                             color_attachment_config,
+                             stencil_attachment_config);
+}
+
+RenderTarget RenderTarget::CreateOffscreenMSAA(
+    const Context& context,
+    RenderTargetAllocator& allocator,
+    ISize size,
+    const std::string& label,
+    AttachmentConfigMSAA color_attachment_config,
+    std::optional<AttachmentConfig> stencil_attachment_config) {
   if (size.IsEmpty()) {
     return {};
   }
@@ -273,15 +342,17 @@ RenderTarget RenderTarget::CreateOffscreenMSAA(
   // Create MSAA color texture.
 
   TextureDescriptor color0_tex_desc;
-  color0_tex_desc.storage_mode = color_attachment_config.storage_mode;
+  color0_tex_desc.storage_mode =
+      GetAttachmentStorageMode(color_attachment_config.storage_mode,
+                               color_attachment_config.load_action,
+                               color_attachment_config.store_action);
   color0_tex_desc.type = TextureType::kTexture2DMultisample;
   color0_tex_desc.sample_count = SampleCount::kCount4;
   color0_tex_desc.format = pixel_format;
   color0_tex_desc.size = size;
   color0_tex_desc.usage = static_cast<uint64_t>(TextureUsage::kRenderTarget);
 
-  auto color0_msaa_tex =
-      context.GetResourceAllocator()->CreateTexture(color0_tex_desc);
+  auto color0_msaa_tex = allocator.CreateTexture(color0_tex_desc);
   if (!color0_msaa_tex) {
     VALIDATION_LOG << "Could not create multisample color texture.";
     return {};
@@ -301,8 +372,7 @@ RenderTarget RenderTarget::CreateOffscreenMSAA(
       static_cast<uint64_t>(TextureUsage::kRenderTarget) |
       static_cast<uint64_t>(TextureUsage::kShaderRead);
 
-  auto color0_resolve_tex =
-      context.GetResourceAllocator()->CreateTexture(color0_resolve_tex_desc);
+  auto color0_resolve_tex = allocator.CreateTexture(color0_resolve_tex_desc);
   if (!color0_resolve_tex) {
     VALIDATION_LOG << "Could not create color texture.";
     return {};
@@ -324,7 +394,10 @@ RenderTarget RenderTarget::CreateOffscreenMSAA(
 
   if (stencil_attachment_config.has_value()) {
     TextureDescriptor stencil_tex0;
-    stencil_tex0.storage_mode = stencil_attachment_config->storage_mode;
+    stencil_tex0.storage_mode =
+        GetAttachmentStorageMode(stencil_attachment_config->storage_mode,
+                                 stencil_attachment_config->load_action,
+                                 stencil_attachment_config->store_action);
     stencil_tex0.type = TextureType::kTexture2DMultisample;
     stencil_tex0.sample_count = SampleCount::kCount4;
     stencil_tex0.format = context.GetCapabilities()->GetDefaultStencilFormat();
@@ -336,8 +409,7 @@ RenderTarget RenderTarget::CreateOffscreenMSAA(
     stencil0.load_action = stencil_attachment_config->load_action;
     stencil0.store_action = stencil_attachment_config->store_action;
     stencil0.clear_stencil = 0u;
-    stencil0.texture =
-        context.GetResourceAllocator()->CreateTexture(stencil_tex0);
+    stencil0.texture = allocator.CreateTexture(stencil_tex0);
 
     if (!stencil0.texture) {
       return {};
@@ -17,6 +17,39 @@ namespace impeller {
 
 class Context;
 
+//------------------------------------------------------------------------------
+/// @brief      Creates the attachment textures of offscreen render targets.
+///             The default implementation allocates a new texture every time.
+///             Subclasses may recycle textures across frames instead.
+///
+class RenderTargetAllocator {
+ public:
+  explicit RenderTargetAllocator(std::shared_ptr<Allocator> allocator);
+
+  virtual ~RenderTargetAllocator();
+
+  virtual std::shared_ptr<Texture> CreateTexture(
+      const TextureDescriptor& desc);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called before the first render target of a frame is created.
+  ///
+  virtual void Start();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called once all render targets of a frame have been created.
+  ///
+  virtual void End();
+
+ protected:
+  const std::shared_ptr<Allocator>& GetAllocator() const;
+
+ private:
+  std::shared_ptr<Allocator> allocator_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetAllocator);
+};
+
 class RenderTarget final {
  public:
   struct AttachmentConfig {
@@ -70,6 +103,25 @@ class RenderTarget final {
       std::optional<AttachmentConfig> stencil_attachment_config =
           kDefaultStencilAttachmentConfig);
 
+  static RenderTarget CreateOffscreen(
+      const Context& context,
+      RenderTargetAllocator& allocator,
+      ISize size,
+      const std::string& label = "Offscreen",
+      AttachmentConfig color_attachment_config = kDefaultColorAttachmentConfig,
+      std::optional<AttachmentConfig> stencil_attachment_config =
+          kDefaultStencilAttachmentConfig);
+
+  static RenderTarget CreateOffscreenMSAA(
+      const Context& context,
+      RenderTargetAllocator& allocator,
+      ISize size,
+      const std::string& label = "Offscreen MSAA",
+      AttachmentConfigMSAA color_attachment_config =
+          kDefaultColorAttachmentConfigMSAA,
+      std::optional<AttachmentConfig> stencil_attachment_config =
+          kDefaultStencilAttachmentConfig);
+
   RenderTarget();
 
   ~RenderTarget();
@@ -687,6 +687,46 @@ TEST_P(RendererTest, CanBlitTextureToBuffer) {
   OpenPlaygroundHere(callback);
 }
 
+TEST_P(RendererTest, CanBlitBufferToTextureRegion) {
+  auto context = GetContext();
+  ASSERT_TRUE(context);
+  if (!context->GetCapabilities()->SupportsBufferToTextureBlits()) {
+    GTEST_SKIP_("Buffer to texture blits are not supported.");
+  }
+
+  TextureDescriptor texture_desc;
+  texture_desc.storage_mode = StorageMode::kHostVisible;
+  texture_desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  texture_desc.size = {16, 16};
+  auto texture = context->GetResourceAllocator()->CreateTexture(texture_desc);
+  ASSERT_TRUE(texture);
+
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kHostVisible;
+  buffer_desc.size = 4u * 4u * 4u;
+  auto device_buffer =
+      context->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  ASSERT_TRUE(device_buffer);
+
+  auto buffer = context->CreateCommandBuffer();
+  ASSERT_TRUE(buffer);
+  auto pass = buffer->CreateBlitPass();
+  ASSERT_TRUE(pass);
+
+  // Only the region needs to be covered by the buffer.
+  ASSERT_TRUE(pass->AddCopy(device_buffer->AsBufferView(), texture,
+                            IRect::MakeXYWH(8, 4, 4, 4)));
+  // The region must lie within the texture.
+  ASSERT_FALSE(pass->AddCopy(device_buffer->AsBufferView(), texture,
+                             IRect::MakeXYWH(14, 14, 4, 4)));
+  // The buffer must contain exactly the pixels of the region.
+  ASSERT_FALSE(pass->AddCopy(device_buffer->AsBufferView(), texture,
+                             IRect::MakeXYWH(0, 0, 2, 2)));
+
+  ASSERT_TRUE(pass->EncodeCommands(context->GetResourceAllocator()));
+  ASSERT_TRUE(buffer->SubmitCommands());
+}
+
 TEST_P(RendererTest, CanGenerateMipmaps) {
   auto context = GetContext();
   ASSERT_TRUE(context);
@@ -1032,5 +1072,29 @@ TEST_P(RendererTest, VertexBufferBuilder) {
   ASSERT_EQ(vertex_builder.GetVertexCount(), 4u);
 }
 
+TEST_P(RendererTest, VertexBufferBuilderPicksNarrowestIndexType) {
+  auto host_buffer = HostBuffer::Create();
+
+  VertexBufferBuilder<Point, uint32_t> wide;
+  for (auto i = 0; i < 4; i++) {
+    wide.AppendVertex(Point(i, i));
+  }
+  wide.AppendIndex(0).AppendIndex(1).AppendIndex(3);
+  auto narrowed = wide.CreateVertexBuffer(*host_buffer);
+  ASSERT_EQ(narrowed.index_type, IndexType::k16bit);
+  ASSERT_EQ(narrowed.index_count, 3u);
+  ASSERT_EQ(narrowed.index_buffer.range.length, 3 * sizeof(uint16_t));
+
+  // Generated indices do not wrap around once they no longer fit in 16 bits.
+  VertexBufferBuilder<Point> large;
+  for (auto i = 0; i < 70000; i++) {
+    large.AppendVertex(Point(i, i));
+  }
+  auto widened = large.CreateVertexBuffer(*host_buffer);
+  ASSERT_EQ(widened.index_type, IndexType::k32bit);
+  ASSERT_EQ(widened.index_count, 70000u);
+  ASSERT_EQ(widened.index_buffer.range.length, 70000 * sizeof(uint32_t));
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -6,8 +6,10 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 
 #include "flutter/fml/macros.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
@@ -30,9 +32,27 @@ class Surface {
 
   virtual bool Present() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the area of the surface that is out of date compared
+  ///             to the last presented frame, or `std::nullopt` if the
+  ///             contents of the surface are undefined and it must be
+  ///             rendered entirely.
+  ///
+  virtual std::optional<IRect> GetExistingDamage() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the area that changed since the last presented frame,
+  ///             which is passed on to the compositor when presenting. If
+  ///             unset, the entire surface is assumed to have changed.
+  ///
+  void SetFrameDamage(std::optional<IRect> frame_damage);
+
+  const std::optional<IRect>& GetFrameDamage() const;
+
  private:
   RenderTarget desc_;
   ISize size_;
+  std::optional<IRect> frame_damage_;
 
   bool is_valid_ = false;
 
@@ -64,7 +64,7 @@ class MockBlitPass : public BlitPass {
   MOCK_METHOD4(OnCopyBufferToTextureCommand,
                bool(BufferView source,
                     std::shared_ptr<Texture> destination,
-                    IPoint destination_origin,
+                    IRect destination_region,
                     std::string label));
   MOCK_METHOD2(OnGenerateMipmapCommand,
                bool(std::shared_ptr<Texture> texture, std::string label));
@@ -85,6 +85,8 @@ class MockCommandBuffer : public CommandBuffer {
 
 class MockImpellerContext : public Context {
  public:
+  MOCK_CONST_METHOD0(GetBackendType, Context::BackendType());
+
   MOCK_CONST_METHOD0(IsValid, bool());
 
   MOCK_CONST_METHOD0(GetResourceAllocator, std::shared_ptr<Allocator>());
@@ -5,7 +5,9 @@
 #pragma once
 
 #include <initializer_list>
+#include <limits>
 #include <map>
+#include <numeric>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -25,18 +27,28 @@ class VertexBufferBuilder {
   using VertexType = VertexType_;
   using IndexType = IndexType_;
 
+  static_assert(sizeof(IndexType) == 2 || sizeof(IndexType) == 4,
+                "Indices must be 16 or 32 bits wide.");
+
   VertexBufferBuilder() = default;
 
   ~VertexBufferBuilder() = default;
 
-  constexpr impeller::IndexType GetIndexType() const {
-    if constexpr (sizeof(IndexType) == 2) {
+  //----------------------------------------------------------------------------
+  /// @brief      The type of the indices in the buffers created by the
+  ///             builder. This may differ from `IndexType`: indices are
+  ///             narrowed to 16 bits whenever they can address every vertex,
+  ///             and generated indices are widened to 32 bits when they
+  ///             cannot.
+  ///
+  impeller::IndexType GetIndexType() const {
+    if (vertices_.size() <= kMax16BitIndexedVertices) {
       return impeller::IndexType::k16bit;
-    } else if (sizeof(IndexType) == 4) {
+    }
+    if (sizeof(IndexType) == 4 || indices_.empty()) {
       return impeller::IndexType::k32bit;
-    } else {
-      return impeller::IndexType::kUnknown;
     }
+    return impeller::IndexType::k16bit;
   }
 
   void SetLabel(std::string label) { label_ = std::move(label); }
@@ -121,32 +133,35 @@ class VertexBufferBuilder {
     return buffer->AsBufferView();
   }
 
-  std::vector<IndexType> CreateIndexBuffer() const {
+  static constexpr size_t kMax16BitIndexedVertices =
+      std::numeric_limits<uint16_t>::max() + 1u;
+
+  template <class T>
+  std::vector<T> CreateIndexBuffer() const {
     if (indices_.size() > 0) {
-      return indices_;
+      return std::vector<T>(indices_.begin(), indices_.end());
     }
 
     // So dumb! We don't actually need an index buffer right now. But we will
     // once de-duplication is done. So assume this is always done.
-    std::vector<IndexType> index_buffer;
-    for (size_t i = 0; i < vertices_.size(); i++) {
-      index_buffer.push_back(i);
-    }
+    std::vector<T> index_buffer(vertices_.size());
+    std::iota(index_buffer.begin(), index_buffer.end(), T{0});
     return index_buffer;
   }
 
-  BufferView CreateIndexBufferView(HostBuffer& buffer) const {
-    const auto index_buffer = CreateIndexBuffer();
-    return buffer.Emplace(index_buffer.data(),
-                          index_buffer.size() * sizeof(IndexType),
-                          alignof(IndexType));
+  template <class T>
+  BufferView EmplaceIndexBuffer(HostBuffer& buffer) const {
+    const auto index_buffer = CreateIndexBuffer<T>();
+    return buffer.Emplace(index_buffer.data(), index_buffer.size() * sizeof(T),
+                          alignof(T));
   }
 
-  BufferView CreateIndexBufferView(Allocator& allocator) const {
-    const auto index_buffer = CreateIndexBuffer();
+  template <class T>
+  BufferView AllocateIndexBuffer(Allocator& allocator) const {
+    const auto index_buffer = CreateIndexBuffer<T>();
     auto buffer = allocator.CreateBufferWithCopy(
         reinterpret_cast<const uint8_t*>(index_buffer.data()),
-        index_buffer.size() * sizeof(IndexType));
+        index_buffer.size() * sizeof(T));
     if (!buffer) {
       return {};
     }
@@ -155,6 +170,20 @@ class VertexBufferBuilder {
     }
     return buffer->AsBufferView();
   }
+
+  BufferView CreateIndexBufferView(HostBuffer& buffer) const {
+    if (GetIndexType() == impeller::IndexType::k16bit) {
+      return EmplaceIndexBuffer<uint16_t>(buffer);
+    }
+    return EmplaceIndexBuffer<uint32_t>(buffer);
+  }
+
+  BufferView CreateIndexBufferView(Allocator& allocator) const {
+    if (GetIndexType() == impeller::IndexType::k16bit) {
+      return AllocateIndexBuffer<uint16_t>(allocator);
+    }
+    return AllocateIndexBuffer<uint32_t>(allocator);
+  }
 };
 
 }  // namespace impeller
@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/time/time_point.h"
 #include "impeller/base/timing.h"
@@ -85,5 +86,14 @@ void AnimationPlayer::Update() {
   }
 }
 
+std::vector<Node*> AnimationPlayer::GetTargetNodes() const {
+  std::vector<Node*> nodes;
+  nodes.reserve(target_transforms_.size());
+  for (const auto& [node, _] : target_transforms_) {
+    nodes.push_back(node);
+  }
+  return nodes;
+}
+
 }  // namespace scene
 }  // namespace impeller
@@ -38,6 +38,9 @@ class AnimationPlayer final {
   /// @brief  Advanced all clips and updates animated properties in the scene.
   void Update();
 
+  /// @brief  The nodes whose transforms are animated by this player.
+  std::vector<Node*> GetTargetNodes() const;
+
  private:
   std::unordered_map<Node*, AnimationTransforms> target_transforms_;
 
@@ -6,6 +6,7 @@
 
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <ostream>
 
 #include "impeller/core/device_buffer_descriptor.h"
@@ -16,9 +17,11 @@
 #include "impeller/geometry/vector.h"
 #include "impeller/renderer/sampler_library.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
+#include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/shaders/skinned.vert.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
+#include "impeller/scene/shaders/unskinned_instanced.vert.h"
 
 namespace impeller {
 namespace scene {
@@ -64,6 +67,7 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
   const uint8_t* vertices_start;
   size_t vertices_bytes;
   bool is_skinned;
+  std::optional<GeometryBounds> bounds;
 
   switch (mesh.vertices_type()) {
     case fb::VertexBuffer::UnskinnedVertexBuffer: {
@@ -72,6 +76,15 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       vertices_start = reinterpret_cast<const uint8_t*>(vertices->Get(0));
       vertices_bytes = vertices->size() * sizeof(fb::Vertex);
       is_skinned = false;
+      // Skinned vertices move with their joints, so only unskinned geometry
+      // has static bounds.
+      for (const auto* vertex : *vertices) {
+        const auto position = importer::ToVector3(vertex->position());
+        bounds = bounds.has_value()
+                     ? GeometryBounds{bounds->min.Min(position),
+                                      bounds->max.Max(position)}
+                     : GeometryBounds{position, position};
+      }
       break;
     }
     case fb::VertexBuffer::SkinnedVertexBuffer: {
@@ -94,8 +107,20 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
     return nullptr;
   }
 
+  // The indices of the simplified levels are appended to the same buffer.
+  // Only unskinned geometry selects levels by its bounds on screen.
+  size_t lods_bytes = 0u;
+  if (!is_skinned && mesh.lods()) {
+    for (const auto* lod : *mesh.lods()) {
+      if (lod->indices() && lod->indices()->data() &&
+          lod->indices()->type() == mesh.indices()->type()) {
+        lods_bytes += lod->indices()->data()->size();
+      }
+    }
+  }
+
   DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = vertices_bytes + indices_bytes;
+  buffer_desc.size = vertices_bytes + indices_bytes + lods_bytes;
   buffer_desc.storage_mode = StorageMode::kHostVisible;
 
   auto buffer = allocator.CreateBuffer(buffer_desc);
@@ -116,10 +141,75 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       .index_count = mesh.indices()->count(),
       .index_type = index_type,
   };
+  if (!is_skinned) {
+    std::vector<GeometryLod> lods;
+    size_t lod_offset = vertices_bytes + indices_bytes;
+    for (size_t i = 0; lods_bytes > 0u && i < mesh.lods()->size(); i++) {
+      const auto* lod = mesh.lods()->Get(i);
+      if (!lod->indices() || !lod->indices()->data() ||
+          lod->indices()->type() != mesh.indices()->type()) {
+        continue;
+      }
+      const size_t lod_bytes = lod->indices()->data()->size();
+      if (!buffer->CopyHostBuffer(lod->indices()->data()->Data(),
+                                  Range(0, lod_bytes), lod_offset)) {
+        return nullptr;
+      }
+      lods.push_back(GeometryLod{
+          .vertex_buffer =
+              {
+                  .vertex_buffer = vertex_buffer.vertex_buffer,
+                  .index_buffer = {.buffer = buffer,
+                                   .range = Range(lod_offset, lod_bytes)},
+                  .index_count = lod->indices()->count(),
+                  .index_type = index_type,
+              },
+          .max_screen_size = lod->max_screen_size(),
+      });
+      lod_offset += lod_bytes;
+    }
+
+    auto result = std::make_shared<UnskinnedVertexBufferGeometry>();
+    result->SetVertexBuffer(std::move(vertex_buffer));
+    result->SetBounds(bounds);
+    result->SetLods(std::move(lods));
+    return result;
+  }
   return MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
 }
 
-void Geometry::SetJointsTexture(const std::shared_ptr<Texture>& texture) {}
+bool Geometry::BindToCommandInstanced(const SceneContext& scene_context,
+                                      HostBuffer& buffer,
+                                      const Matrix& view_transform,
+                                      BufferView instance_transforms,
+                                      Command& command) const {
+  return false;
+}
+
+std::optional<GeometryBounds> Geometry::GetBounds() const {
+  return std::nullopt;
+}
+
+void Geometry::SetJointsTexture(const std::shared_ptr<Texture>& texture,
+                                size_t joint_offset) {}
+
+size_t Geometry::SelectLod(Scalar screen_size) const {
+  return 0u;
+}
+
+void Geometry::BindLodToCommand(size_t lod, Command& command) const {}
+
+static void BindUnskinnedInstances(HostBuffer& buffer,
+                                   const Matrix& view_transform,
+                                   BufferView instance_transforms,
+                                   Command& command) {
+  UnskinnedInstancedVertexShader::FrameInfo info;
+  info.view_transform = view_transform;
+  UnskinnedInstancedVertexShader::BindFrameInfo(command,
+                                                buffer.EmplaceUniform(info));
+  UnskinnedInstancedVertexShader::BindInstanceInfo(
+      command, std::move(instance_transforms));
+}
 
 //------------------------------------------------------------------------------
 /// CuboidGeometry
@@ -173,6 +263,19 @@ void CuboidGeometry::BindToCommand(const SceneContext& scene_context,
   UnskinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
 }
 
+// |Geometry|
+bool CuboidGeometry::BindToCommandInstanced(const SceneContext& scene_context,
+                                            HostBuffer& buffer,
+                                            const Matrix& view_transform,
+                                            BufferView instance_transforms,
+                                            Command& command) const {
+  command.BindVertices(
+      GetVertexBuffer(*scene_context.GetContext()->GetResourceAllocator()));
+  BindUnskinnedInstances(buffer, view_transform, std::move(instance_transforms),
+                         command);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 /// UnskinnedVertexBufferGeometry
 ///
@@ -186,6 +289,15 @@ void UnskinnedVertexBufferGeometry::SetVertexBuffer(
   vertex_buffer_ = std::move(vertex_buffer);
 }
 
+void UnskinnedVertexBufferGeometry::SetBounds(
+    std::optional<GeometryBounds> bounds) {
+  bounds_ = bounds;
+}
+
+void UnskinnedVertexBufferGeometry::SetLods(std::vector<GeometryLod> lods) {
+  lods_ = std::move(lods);
+}
+
 // |Geometry|
 GeometryType UnskinnedVertexBufferGeometry::GetGeometryType() const {
   return GeometryType::kUnskinned;
@@ -211,6 +323,49 @@ void UnskinnedVertexBufferGeometry::BindToCommand(
   UnskinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
 }
 
+// |Geometry|
+bool UnskinnedVertexBufferGeometry::BindToCommandInstanced(
+    const SceneContext& scene_context,
+    HostBuffer& buffer,
+    const Matrix& view_transform,
+    BufferView instance_transforms,
+    Command& command) const {
+  command.BindVertices(
+      GetVertexBuffer(*scene_context.GetContext()->GetResourceAllocator()));
+  BindUnskinnedInstances(buffer, view_transform, std::move(instance_transforms),
+                         command);
+  return true;
+}
+
+// |Geometry|
+std::optional<GeometryBounds> UnskinnedVertexBufferGeometry::GetBounds()
+    const {
+  return bounds_;
+}
+
+// |Geometry|
+size_t UnskinnedVertexBufferGeometry::SelectLod(Scalar screen_size) const {
+  // Levels are ordered from the most to the least detailed, so the last level
+  // that still covers the size on screen is the cheapest one to draw.
+  size_t lod = 0u;
+  for (size_t i = 0; i < lods_.size(); i++) {
+    if (screen_size > lods_[i].max_screen_size) {
+      break;
+    }
+    lod = i + 1;
+  }
+  return lod;
+}
+
+// |Geometry|
+void UnskinnedVertexBufferGeometry::BindLodToCommand(size_t lod,
+                                                     Command& command) const {
+  if (lod == 0u || lod > lods_.size()) {
+    return;
+  }
+  command.BindVertices(lods_[lod - 1].vertex_buffer);
+}
+
 //------------------------------------------------------------------------------
 /// SkinnedVertexBufferGeometry
 ///
@@ -261,13 +416,16 @@ void SkinnedVertexBufferGeometry::BindToCommand(
   info.enable_skinning = joints_texture_ ? 1 : 0;
   info.joint_texture_size =
       joints_texture_ ? joints_texture_->GetSize().width : 1;
+  info.joint_offset = joint_offset_;
   SkinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
 }
 
 // |Geometry|
 void SkinnedVertexBufferGeometry::SetJointsTexture(
-    const std::shared_ptr<Texture>& texture) {
+    const std::shared_ptr<Texture>& texture,
+    size_t joint_offset) {
   joints_texture_ = texture;
+  joint_offset_ = joint_offset;
 }
 }  // namespace scene
 }  // namespace impeller
@@ -5,9 +5,12 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/allocator.h"
+#include "impeller/core/buffer_view.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/host_buffer.h"
 #include "impeller/core/vertex_buffer.h"
@@ -24,6 +27,20 @@ namespace scene {
 class CuboidGeometry;
 class UnskinnedVertexBufferGeometry;
 
+/// An axis aligned box in the local space of a geometry.
+struct GeometryBounds {
+  Vector3 min;
+  Vector3 max;
+};
+
+/// A simplified level of detail of a geometry. Its indices refer to the same
+/// vertices as the full detail geometry.
+struct GeometryLod {
+  VertexBuffer vertex_buffer;
+  /// The largest height on screen in pixels this level is drawn at.
+  Scalar max_screen_size = 0.0f;
+};
+
 class Geometry {
  public:
   virtual ~Geometry();
@@ -46,7 +63,44 @@ class Geometry {
                              const Matrix& transform,
                              Command& command) const = 0;
 
-  virtual void SetJointsTexture(const std::shared_ptr<Texture>& texture);
+  //----------------------------------------------------------------------------
+  /// @brief      Binds the geometry to draw once per transform in the
+  ///             storage buffer, which holds one world transform per instance.
+  ///
+  /// @return     Whether the geometry supports instancing. Skinned geometry
+  ///             does not.
+  ///
+  virtual bool BindToCommandInstanced(const SceneContext& scene_context,
+                                      HostBuffer& buffer,
+                                      const Matrix& view_transform,
+                                      BufferView instance_transforms,
+                                      Command& command) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The local space bounds of the vertices, if they are known.
+  ///             Geometry without bounds is never culled.
+  ///
+  virtual std::optional<GeometryBounds> GetBounds() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the joint palette that skinned geometry reads its joint
+  ///             matrices from, starting at the matrix at |joint_offset|.
+  ///
+  virtual void SetJointsTexture(const std::shared_ptr<Texture>& texture,
+                                size_t joint_offset);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Selects the level of detail to draw the geometry at when its
+  ///             bounds are `screen_size` pixels high on screen. Level 0 is
+  ///             the full detail geometry.
+  ///
+  virtual size_t SelectLod(Scalar screen_size) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Replaces the vertices bound by `BindToCommand` or
+  ///             `BindToCommandInstanced` with those of a simplified level.
+  ///
+  virtual void BindLodToCommand(size_t lod, Command& command) const;
 };
 
 class CuboidGeometry final : public Geometry {
@@ -69,6 +123,13 @@ class CuboidGeometry final : public Geometry {
                      const Matrix& transform,
                      Command& command) const override;
 
+  // |Geometry|
+  bool BindToCommandInstanced(const SceneContext& scene_context,
+                              HostBuffer& buffer,
+                              const Matrix& view_transform,
+                              BufferView instance_transforms,
+                              Command& command) const override;
+
  private:
   Vector3 size_;
 
@@ -83,6 +144,10 @@ class UnskinnedVertexBufferGeometry final : public Geometry {
 
   void SetVertexBuffer(VertexBuffer vertex_buffer);
 
+  void SetBounds(std::optional<GeometryBounds> bounds);
+
+  void SetLods(std::vector<GeometryLod> lods);
+
   // |Geometry|
   GeometryType GetGeometryType() const override;
 
@@ -95,8 +160,26 @@ class UnskinnedVertexBufferGeometry final : public Geometry {
                      const Matrix& transform,
                      Command& command) const override;
 
+  // |Geometry|
+  bool BindToCommandInstanced(const SceneContext& scene_context,
+                              HostBuffer& buffer,
+                              const Matrix& view_transform,
+                              BufferView instance_transforms,
+                              Command& command) const override;
+
+  // |Geometry|
+  std::optional<GeometryBounds> GetBounds() const override;
+
+  // |Geometry|
+  size_t SelectLod(Scalar screen_size) const override;
+
+  // |Geometry|
+  void BindLodToCommand(size_t lod, Command& command) const override;
+
  private:
   VertexBuffer vertex_buffer_;
+  std::optional<GeometryBounds> bounds_;
+  std::vector<GeometryLod> lods_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(UnskinnedVertexBufferGeometry);
 };
@@ -122,11 +205,13 @@ class SkinnedVertexBufferGeometry final : public Geometry {
                      Command& command) const override;
 
   // |Geometry|
-  void SetJointsTexture(const std::shared_ptr<Texture>& texture) override;
+  void SetJointsTexture(const std::shared_ptr<Texture>& texture,
+                        size_t joint_offset) override;
 
  private:
   VertexBuffer vertex_buffer_;
   std::shared_ptr<Texture> joints_texture_;
+  size_t joint_offset_ = 0u;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SkinnedVertexBufferGeometry);
 };
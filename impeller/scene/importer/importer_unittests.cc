@@ -2,11 +2,17 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <set>
+
 #include "flutter/testing/testing.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/matrix.h"
 #include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/importer.h"
+#include "impeller/scene/importer/mesh_optimizer.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 
 namespace impeller {
@@ -14,6 +20,39 @@ namespace scene {
 namespace importer {
 namespace testing {
 
+/// A flat grid of `size` by `size` quads in the XY plane.
+static void MakeGrid(size_t size,
+                     std::vector<Vector3>& positions,
+                     std::vector<uint32_t>& indices) {
+  for (size_t y = 0; y <= size; y++) {
+    for (size_t x = 0; x <= size; x++) {
+      positions.push_back(Vector3(x, y, 0));
+    }
+  }
+  for (size_t y = 0; y < size; y++) {
+    for (size_t x = 0; x < size; x++) {
+      uint32_t i = y * (size + 1) + x;
+      indices.insert(indices.end(), {i, i + 1, i + size + 2});
+      indices.insert(indices.end(), {i, i + size + 2, i + size + 1});
+    }
+  }
+}
+
+/// The triangles of an index list, rotated so that their winding is kept.
+static std::multiset<std::array<uint32_t, 3>> GetTriangles(
+    const std::vector<uint32_t>& indices) {
+  std::multiset<std::array<uint32_t, 3>> triangles;
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    std::array<uint32_t, 3> triangle = {indices[i], indices[i + 1],
+                                        indices[i + 2]};
+    std::rotate(triangle.begin(),
+                std::min_element(triangle.begin(), triangle.end()),
+                triangle.end());
+    triangles.insert(triangle);
+  }
+  return triangles;
+}
+
 TEST(ImporterTest, CanParseUnskinnedGLTF) {
   auto mapping =
       flutter::testing::OpenFixtureAsMapping("flutter_logo_baked.glb");
@@ -121,6 +160,66 @@ TEST(ImporterTest, CanParseSkinnedGLTF) {
                       Vector4(0.700151, 0.0989373, -0.0989373, 0.700151));
 }
 
+TEST(ImporterTest, VertexCacheOptimizationKeepsTriangles) {
+  std::vector<Vector3> positions;
+  std::vector<uint32_t> indices;
+  MakeGrid(16, positions, indices);
+
+  auto optimized = OptimizeVertexCache(indices, positions.size());
+  ASSERT_EQ(optimized.size(), indices.size());
+  ASSERT_EQ(GetTriangles(optimized), GetTriangles(indices));
+}
+
+TEST(ImporterTest, VertexCacheOptimizationIgnoresInvalidIndices) {
+  std::vector<uint32_t> indices = {0, 1, 2, 2, 1, 3};
+  ASSERT_EQ(OptimizeVertexCache(indices, 3), indices);
+}
+
+TEST(ImporterTest, SimplifyByClusteringReducesTriangles) {
+  std::vector<Vector3> positions;
+  std::vector<uint32_t> indices;
+  MakeGrid(16, positions, indices);
+
+  auto simplified = SimplifyByClustering(positions, indices, 4);
+  ASSERT_FALSE(simplified.empty());
+  ASSERT_EQ(simplified.size() % 3, 0u);
+  ASSERT_LT(simplified.size(), indices.size() / 4);
+  for (auto index : simplified) {
+    ASSERT_LT(index, positions.size());
+  }
+  // Every triangle of the flat grid keeps facing +Z.
+  for (size_t i = 0; i < simplified.size(); i += 3) {
+    auto normal = (positions[simplified[i + 1]] - positions[simplified[i]])
+                      .Cross(positions[simplified[i + 2]] -
+                             positions[simplified[i]]);
+    ASSERT_GT(normal.z, 0.0f);
+  }
+}
+
+TEST(ImporterTest, CanOptimizeGLTFMeshes) {
+  auto mapping =
+      flutter::testing::OpenFixtureAsMapping("flutter_logo_baked.glb");
+
+  fb::SceneT scene;
+  ASSERT_TRUE(ParseGLTF(*mapping, scene));
+  auto& mesh = *scene.nodes[scene.children[0]]->mesh_primitives[0];
+  auto index_count = mesh.indices->count;
+
+  OptimizeMeshes(scene);
+
+  ASSERT_EQ(mesh.indices->count, index_count);
+  ASSERT_EQ(mesh.indices->type, fb::IndexType::k16Bit);
+  auto previous_count = index_count;
+  auto previous_size = std::numeric_limits<float>::max();
+  for (const auto& lod : mesh.lods) {
+    ASSERT_LT(lod->indices->count, previous_count);
+    ASSERT_LT(lod->max_screen_size, previous_size);
+    ASSERT_EQ(lod->indices->type, fb::IndexType::k16Bit);
+    previous_count = lod->indices->count;
+    previous_size = lod->max_screen_size;
+  }
+}
+
 }  // namespace testing
 }  // namespace importer
 }  // namespace scene
@@ -0,0 +1,435 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/scene/importer/mesh_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+
+#include "impeller/scene/importer/conversions.h"
+
+namespace impeller {
+namespace scene {
+namespace importer {
+
+//------------------------------------------------------------------------------
+/// Vertex cache optimization.
+///
+
+static constexpr size_t kVertexCacheSize = 32u;
+
+static float GetVertexScore(int cache_position, uint32_t remaining_triangles) {
+  if (remaining_triangles == 0u) {
+    // The vertex isn't used by any more triangles.
+    return -1.0f;
+  }
+  float score = 0.0f;
+  if (cache_position >= 0) {
+    if (cache_position < 3) {
+      // The vertices of the last triangle get a fixed score so that the next
+      // triangle doesn't just reuse the same edge.
+      score = 0.75f;
+    } else {
+      score = std::pow(1.0f - static_cast<float>(cache_position - 3) /
+                                  (kVertexCacheSize - 3),
+                       1.5f);
+    }
+  }
+  // Prefer vertices with few remaining triangles so that they are finished
+  // and leave the cache.
+  return score + 2.0f / std::sqrt(static_cast<float>(remaining_triangles));
+}
+
+std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices,
+                                          size_t vertex_count) {
+  const size_t triangle_count = indices.size() / 3;
+  if (triangle_count < 2u || indices.size() % 3 != 0u) {
+    return indices;
+  }
+  for (auto index : indices) {
+    if (index >= vertex_count) {
+      return indices;
+    }
+  }
+
+  // The live triangles of each vertex are the first |remaining| entries of
+  // its range in |adjacency|.
+  std::vector<uint32_t> remaining(vertex_count, 0u);
+  for (auto index : indices) {
+    remaining[index]++;
+  }
+  std::vector<uint32_t> offsets(vertex_count + 1, 0u);
+  for (size_t v = 0; v < vertex_count; v++) {
+    offsets[v + 1] = offsets[v] + remaining[v];
+  }
+  std::vector<uint32_t> adjacency(indices.size());
+  {
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triangle_count; t++) {
+      for (size_t k = 0; k < 3; k++) {
+        auto v = indices[t * 3 + k];
+        adjacency[fill[v]++] = t;
+      }
+    }
+  }
+
+  std::vector<int> cache_positions(vertex_count, -1);
+  std::vector<float> vertex_scores(vertex_count);
+  for (size_t v = 0; v < vertex_count; v++) {
+    vertex_scores[v] = GetVertexScore(-1, remaining[v]);
+  }
+  std::vector<float> triangle_scores(triangle_count);
+  std::optional<size_t> best_triangle;
+  for (size_t t = 0; t < triangle_count; t++) {
+    triangle_scores[t] = vertex_scores[indices[t * 3]] +
+                         vertex_scores[indices[t * 3 + 1]] +
+                         vertex_scores[indices[t * 3 + 2]];
+    if (!best_triangle.has_value() ||
+        triangle_scores[t] > triangle_scores[best_triangle.value()]) {
+      best_triangle = t;
+    }
+  }
+
+  std::vector<bool> emitted(triangle_count, false);
+  std::vector<uint32_t> cache;
+  std::vector<uint32_t> next_cache;
+  std::vector<uint32_t> result;
+  result.reserve(indices.size());
+  size_t next_unemitted = 0u;
+
+  auto update_score = [&](uint32_t v) {
+    const auto score = GetVertexScore(cache_positions[v], remaining[v]);
+    const auto delta = score - vertex_scores[v];
+    vertex_scores[v] = score;
+    for (size_t i = 0; i < remaining[v]; i++) {
+      triangle_scores[adjacency[offsets[v] + i]] += delta;
+    }
+  };
+
+  while (result.size() < indices.size()) {
+    if (!best_triangle.has_value()) {
+      // None of the cached vertices have triangles left. Continue with the
+      // next triangle in the original order.
+      while (emitted[next_unemitted]) {
+        next_unemitted++;
+      }
+      best_triangle = next_unemitted;
+    }
+    const auto t = best_triangle.value();
+    emitted[t] = true;
+
+    next_cache.clear();
+    for (size_t k = 0; k < 3; k++) {
+      const auto v = indices[t * 3 + k];
+      result.push_back(v);
+      if (std::find(next_cache.begin(), next_cache.end(), v) ==
+          next_cache.end()) {
+        next_cache.push_back(v);
+      }
+      // Remove the triangle from the live triangles of the vertex.
+      const auto begin = adjacency.begin() + offsets[v];
+      const auto end = begin + remaining[v];
+      std::iter_swap(std::find(begin, end, t), end - 1);
+      remaining[v]--;
+    }
+    for (auto v : cache) {
+      if (std::find(next_cache.begin(), next_cache.end(), v) ==
+          next_cache.end()) {
+        next_cache.push_back(v);
+      }
+    }
+    for (size_t i = kVertexCacheSize; i < next_cache.size(); i++) {
+      cache_positions[next_cache[i]] = -1;
+      update_score(next_cache[i]);
+    }
+    next_cache.resize(std::min(next_cache.size(), kVertexCacheSize));
+    for (size_t i = 0; i < next_cache.size(); i++) {
+      cache_positions[next_cache[i]] = i;
+      update_score(next_cache[i]);
+    }
+    std::swap(cache, next_cache);
+
+    best_triangle.reset();
+    for (auto v : cache) {
+      for (size_t i = 0; i < remaining[v]; i++) {
+        const auto candidate = adjacency[offsets[v] + i];
+        if (!best_triangle.has_value() ||
+            triangle_scores[candidate] >
+                triangle_scores[best_triangle.value()]) {
+          best_triangle = candidate;
+        }
+      }
+    }
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+/// Simplification.
+///
+
+namespace {
+
+/// The symmetric matrix of a sum of squared distances to planes.
+struct Quadric {
+  std::array<double, 10> m = {};
+
+  static Quadric MakeFromPlane(double a, double b, double c, double d) {
+    return Quadric{{a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c,
+                    c * d, d * d}};
+  }
+
+  Quadric& operator+=(const Quadric& other) {
+    for (size_t i = 0; i < m.size(); i++) {
+      m[i] += other.m[i];
+    }
+    return *this;
+  }
+
+  Quadric operator*(double scale) const {
+    Quadric result = *this;
+    for (auto& value : result.m) {
+      value *= scale;
+    }
+    return result;
+  }
+
+  double GetError(const Vector3& p) const {
+    const double x = p.x, y = p.y, z = p.z;
+    return m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z +
+           2 * m[3] * x + m[4] * y * y + 2 * m[5] * y * z + 2 * m[6] * y +
+           m[7] * z * z + 2 * m[8] * z + m[9];
+  }
+};
+
+}  // namespace
+
+std::vector<uint32_t> SimplifyByClustering(
+    const std::vector<Vector3>& positions,
+    const std::vector<uint32_t>& indices,
+    size_t grid_size) {
+  if (positions.empty() || indices.size() % 3 != 0u || grid_size == 0u) {
+    return indices;
+  }
+  for (auto index : indices) {
+    if (index >= positions.size()) {
+      return indices;
+    }
+  }
+
+  Vector3 min = positions[0];
+  Vector3 max = positions[0];
+  for (const auto& position : positions) {
+    min = min.Min(position);
+    max = max.Max(position);
+  }
+  const auto extent = max - min;
+  const auto longest = std::max({extent.x, extent.y, extent.z});
+  if (longest <= 0.0f) {
+    return indices;
+  }
+  const auto cell_size = longest / grid_size;
+  auto get_cell = [&](const Vector3& p) -> uint64_t {
+    auto axis = [&](Scalar value, Scalar origin) -> uint64_t {
+      return std::min<uint64_t>(grid_size - 1,
+                                static_cast<uint64_t>((value - origin) /
+                                                      cell_size));
+    };
+    return axis(p.x, min.x) +
+           grid_size * (axis(p.y, min.y) + grid_size * axis(p.z, min.z));
+  };
+
+  // Assign every vertex to a cluster.
+  std::unordered_map<uint64_t, uint32_t> cluster_ids;
+  std::vector<uint32_t> vertex_clusters(positions.size());
+  for (size_t v = 0; v < positions.size(); v++) {
+    auto [it, _] = cluster_ids.try_emplace(get_cell(positions[v]),
+                                           cluster_ids.size());
+    vertex_clusters[v] = it->second;
+  }
+
+  // Accumulate the area weighted planes of the triangles around each cluster.
+  std::vector<Quadric> quadrics(cluster_ids.size());
+  for (size_t i = 0; i < indices.size(); i += 3) {
+    const auto& p0 = positions[indices[i]];
+    const auto& p1 = positions[indices[i + 1]];
+    const auto& p2 = positions[indices[i + 2]];
+    auto normal = (p1 - p0).Cross(p2 - p0);
+    const auto length = normal.Length();
+    if (length <= 0.0f) {
+      continue;
+    }
+    normal = normal / length;
+    const auto plane =
+        Quadric::MakeFromPlane(normal.x, normal.y, normal.z,
+                               -normal.Dot(p0)) *
+        (length * 0.5);
+    for (size_t k = 0; k < 3; k++) {
+      quadrics[vertex_clusters[indices[i + k]]] += plane;
+    }
+  }
+
+  // Collapse every cluster onto its vertex with the lowest error.
+  std::vector<uint32_t> representatives(cluster_ids.size());
+  std::vector<double> errors(cluster_ids.size(),
+                             std::numeric_limits<double>::max());
+  for (size_t v = 0; v < positions.size(); v++) {
+    const auto cluster = vertex_clusters[v];
+    const auto error = quadrics[cluster].GetError(positions[v]);
+    if (error < errors[cluster]) {
+      errors[cluster] = error;
+      representatives[cluster] = v;
+    }
+  }
+
+  std::vector<uint32_t> result;
+  std::set<std::tuple<uint32_t, uint32_t, uint32_t>> triangles;
+  for (size_t i = 0; i < indices.size(); i += 3) {
+    std::array<uint32_t, 3> triangle;
+    for (size_t k = 0; k < 3; k++) {
+      triangle[k] = representatives[vertex_clusters[indices[i + k]]];
+    }
+    if (triangle[0] == triangle[1] || triangle[1] == triangle[2] ||
+        triangle[0] == triangle[2]) {
+      continue;
+    }
+    // Rotate the smallest index to the front to find duplicates without
+    // flipping the winding of the triangle.
+    std::rotate(triangle.begin(),
+                std::min_element(triangle.begin(), triangle.end()),
+                triangle.end());
+    if (!triangles.insert({triangle[0], triangle[1], triangle[2]}).second) {
+      continue;
+    }
+    result.insert(result.end(), triangle.begin(), triangle.end());
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+/// Scene optimization.
+///
+
+/// The number of grid cells along the longest axis of each simplified level.
+static constexpr std::array<size_t, 3> kLodGridSizes = {64u, 32u, 16u};
+
+/// The largest size on screen of a grid cell of a level, in pixels.
+static constexpr Scalar kMaxLodCellScreenSize = 2.0f;
+
+static std::vector<uint32_t> ReadIndices(const fb::IndicesT& indices) {
+  std::vector<uint32_t> result(indices.count);
+  const size_t index_size = indices.type == fb::IndexType::k16Bit
+                                ? sizeof(uint16_t)
+                                : sizeof(uint32_t);
+  if (indices.data.size() < indices.count * index_size) {
+    return {};
+  }
+  for (size_t i = 0; i < indices.count; i++) {
+    if (indices.type == fb::IndexType::k16Bit) {
+      uint16_t index;
+      std::memcpy(&index, &indices.data[i * index_size], index_size);
+      result[i] = index;
+    } else {
+      std::memcpy(&result[i], &indices.data[i * index_size], index_size);
+    }
+  }
+  return result;
+}
+
+static std::unique_ptr<fb::IndicesT> MakeIndices(
+    const std::vector<uint32_t>& indices,
+    fb::IndexType type) {
+  auto result = std::make_unique<fb::IndicesT>();
+  result->type = type;
+  result->count = indices.size();
+  const size_t index_size =
+      type == fb::IndexType::k16Bit ? sizeof(uint16_t) : sizeof(uint32_t);
+  result->data.resize(indices.size() * index_size);
+  for (size_t i = 0; i < indices.size(); i++) {
+    if (type == fb::IndexType::k16Bit) {
+      const auto index = static_cast<uint16_t>(indices[i]);
+      std::memcpy(&result->data[i * index_size], &index, index_size);
+    } else {
+      std::memcpy(&result->data[i * index_size], &indices[i], index_size);
+    }
+  }
+  return result;
+}
+
+static void OptimizeMeshPrimitive(fb::MeshPrimitiveT& primitive) {
+  if (!primitive.indices) {
+    return;
+  }
+
+  std::vector<Vector3> positions;
+  size_t vertex_count = 0u;
+  if (auto unskinned = primitive.vertices.AsUnskinnedVertexBuffer()) {
+    vertex_count = unskinned->vertices.size();
+    positions.reserve(vertex_count);
+    for (const auto& vertex : unskinned->vertices) {
+      positions.push_back(ToVector3(vertex.position()));
+    }
+  } else if (auto skinned = primitive.vertices.AsSkinnedVertexBuffer()) {
+    vertex_count = skinned->vertices.size();
+  } else {
+    return;
+  }
+
+  const auto index_type = primitive.indices->type;
+  auto indices = ReadIndices(*primitive.indices);
+  if (indices.empty()) {
+    return;
+  }
+  indices = OptimizeVertexCache(indices, vertex_count);
+  primitive.indices = MakeIndices(indices, index_type);
+
+  // Skinned vertices move with their joints, so they have neither static
+  // bounds nor a size on screen to select a level by.
+  if (positions.empty()) {
+    return;
+  }
+  primitive.lods.clear();
+  size_t previous_count = indices.size();
+  for (auto grid_size : kLodGridSizes) {
+    auto simplified = SimplifyByClustering(positions, indices, grid_size);
+    if (simplified.empty()) {
+      break;
+    }
+    // Skip levels that barely reduce the triangle count.
+    if (simplified.size() * 4 > previous_count * 3) {
+      continue;
+    }
+    previous_count = simplified.size();
+    auto lod = std::make_unique<fb::MeshLodT>();
+    lod->indices =
+        MakeIndices(OptimizeVertexCache(simplified, vertex_count), index_type);
+    lod->max_screen_size = grid_size * kMaxLodCellScreenSize;
+    primitive.lods.push_back(std::move(lod));
+  }
+}
+
+void OptimizeMeshes(fb::SceneT& scene) {
+  for (auto& node : scene.nodes) {
+    if (!node) {
+      continue;
+    }
+    for (auto& primitive : node->mesh_primitives) {
+      if (primitive) {
+        OptimizeMeshPrimitive(*primitive);
+      }
+    }
+  }
+}
+
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
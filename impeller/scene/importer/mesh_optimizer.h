@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "impeller/geometry/vector.h"
+#include "impeller/scene/importer/scene_flatbuffers.h"
+
+namespace impeller {
+namespace scene {
+namespace importer {
+
+//------------------------------------------------------------------------------
+/// @brief      Reorders the triangles of an indexed triangle list so that
+///             consecutive triangles reuse the vertices still held in the
+///             post transform vertex cache of the GPU. This is an
+///             implementation of Tom Forsyth's linear-speed vertex cache
+///             optimization.
+///
+std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices,
+                                          size_t vertex_count);
+
+//------------------------------------------------------------------------------
+/// @brief      Simplifies an indexed triangle list by clustering its vertices
+///             into a grid with `grid_size` cells along the longest axis of
+///             the bounds. Every cluster collapses onto the vertex in it with
+///             the lowest quadric error, so the simplified triangles index
+///             into the same vertices. Collapsed and duplicate triangles are
+///             removed.
+///
+std::vector<uint32_t> SimplifyByClustering(
+    const std::vector<Vector3>& positions,
+    const std::vector<uint32_t>& indices,
+    size_t grid_size);
+
+//------------------------------------------------------------------------------
+/// @brief      Optimizes the indices of every mesh primitive in the scene for
+///             the vertex cache, and adds simplified levels of detail to
+///             unskinned primitives.
+///
+void OptimizeMeshes(fb::SceneT& scene);
+
+}  // namespace importer
+}  // namespace scene
+}  // namespace impeller
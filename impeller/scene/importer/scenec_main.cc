@@ -13,6 +13,7 @@
 #include "impeller/base/strings.h"
 #include "impeller/compiler/utilities.h"
 #include "impeller/scene/importer/importer.h"
+#include "impeller/scene/importer/mesh_optimizer.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/importer/switches.h"
 #include "impeller/scene/importer/types.h"
@@ -74,6 +75,8 @@ bool Main(const fml::CommandLine& command_line) {
     return false;
   }
 
+  OptimizeMeshes(scene);
+
   flatbuffers::FlatBufferBuilder builder;
   builder.Finish(fb::Scene::Pack(builder, &scene), fb::SceneIdentifier());
 
@@ -35,9 +35,10 @@ std::vector<Mesh::Primitive>& Mesh::GetPrimitives() {
 
 bool Mesh::Render(SceneEncoder& encoder,
                   const Matrix& transform,
-                  const std::shared_ptr<Texture>& joints) const {
+                  const std::shared_ptr<Texture>& joints,
+                  size_t joint_offset) const {
   for (const auto& mesh : primitives_) {
-    mesh.geometry->SetJointsTexture(joints);
+    mesh.geometry->SetJointsTexture(joints, joint_offset);
     SceneCommand command = {
         .label = "Mesh Primitive",
         .transform = transform,
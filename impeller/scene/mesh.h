@@ -35,7 +35,8 @@ class Mesh final {
 
   bool Render(SceneEncoder& encoder,
               const Matrix& transform,
-              const std::shared_ptr<Texture>& joints) const;
+              const std::shared_ptr<Texture>& joints,
+              size_t joint_offset) const;
 
  private:
   std::vector<Primitive> primitives_;
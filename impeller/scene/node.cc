@@ -7,9 +7,14 @@
 #include <inttypes.h>
 #include <atomic>
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/thread.h"
 #include "impeller/base/validation.h"
@@ -46,7 +51,8 @@ Node::MutationLog::Flush() {
 
 std::shared_ptr<Node> Node::MakeFromFlatbuffer(
     const fml::Mapping& ipscene_mapping,
-    Allocator& allocator) {
+    Allocator& allocator,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
   flatbuffers::Verifier verifier(ipscene_mapping.GetMapping(),
                                  ipscene_mapping.GetSize());
   if (!fb::VerifySceneBuffer(verifier)) {
@@ -55,15 +61,16 @@ std::shared_ptr<Node> Node::MakeFromFlatbuffer(
   }
 
   return Node::MakeFromFlatbuffer(*fb::GetScene(ipscene_mapping.GetMapping()),
-                                  allocator);
+                                  allocator, worker_task_runner);
 }
 
-static std::shared_ptr<Texture> UnpackTextureFromFlatbuffer(
-    const fb::Texture* iptexture,
-    Allocator& allocator) {
+/// Converts an embedded image to RGBA. The pixels are read straight out of
+/// the scene mapping.
+static std::optional<DecompressedImage> DecodeTextureFromFlatbuffer(
+    const fb::Texture* iptexture) {
   if (iptexture == nullptr || iptexture->embedded_image() == nullptr ||
       iptexture->embedded_image()->bytes() == nullptr) {
-    return nullptr;
+    return std::nullopt;
   }
 
   auto embedded = iptexture->embedded_image();
@@ -76,7 +83,7 @@ static std::shared_ptr<Texture> UnpackTextureFromFlatbuffer(
     case fb::ComponentType::k16Bit:
       // bytes_per_component = 2;
       FML_LOG(WARNING) << "16 bit textures not yet supported.";
-      return nullptr;
+      return std::nullopt;
   }
 
   DecompressedImage::Format format;
@@ -93,22 +100,30 @@ static std::shared_ptr<Texture> UnpackTextureFromFlatbuffer(
     default:
       FML_LOG(WARNING) << "Textures with " << embedded->component_count()
                        << " components are not supported." << std::endl;
-      return nullptr;
+      return std::nullopt;
   }
   if (embedded->bytes()->size() != bytes_per_component *
                                        embedded->component_count() *
                                        embedded->width() * embedded->height()) {
     FML_LOG(WARNING) << "Embedded texture has an unexpected size. Skipping."
                      << std::endl;
-    return nullptr;
+    return std::nullopt;
   }
 
   auto image_mapping = std::make_shared<fml::NonOwnedMapping>(
       embedded->bytes()->Data(), embedded->bytes()->size());
-  auto decompressed_image =
-      DecompressedImage(ISize(embedded->width(), embedded->height()), format,
-                        image_mapping)
-          .ConvertToRGBA();
+  return DecompressedImage(ISize(embedded->width(), embedded->height()), format,
+                           image_mapping)
+      .ConvertToRGBA();
+}
+
+static std::shared_ptr<Texture> UploadTexture(
+    const std::optional<DecompressedImage>& image,
+    Allocator& allocator) {
+  if (!image.has_value() || !image->IsValid()) {
+    return nullptr;
+  }
+  const auto& decompressed_image = image.value();
 
   auto texture_descriptor = TextureDescriptor{};
   texture_descriptor.storage_mode = StorageMode::kHostVisible;
@@ -132,16 +147,38 @@ static std::shared_ptr<Texture> UnpackTextureFromFlatbuffer(
   return texture;
 }
 
-std::shared_ptr<Node> Node::MakeFromFlatbuffer(const fb::Scene& scene,
-                                               Allocator& allocator) {
+std::shared_ptr<Node> Node::MakeFromFlatbuffer(
+    const fb::Scene& scene,
+    Allocator& allocator,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
   // Unpack textures.
   std::vector<std::shared_ptr<Texture>> textures;
   if (scene.textures()) {
-    for (const auto iptexture : *scene.textures()) {
+    const size_t texture_count = scene.textures()->size();
+    std::vector<std::optional<DecompressedImage>> images(texture_count);
+    if (worker_task_runner && texture_count > 1u) {
+      // Converting the images dominates the load time of large scenes, so it
+      // is spread over the workers. Only the uploads happen on this thread.
+      TRACE_EVENT1("impeller", "DecodeSceneTextures", "Textures",
+                   std::to_string(texture_count).c_str());
+      fml::CountDownLatch latch(texture_count);
+      for (size_t i = 0; i < texture_count; i++) {
+        worker_task_runner->PostTask([&scene, &images, &latch, i]() {
+          images[i] = DecodeTextureFromFlatbuffer(scene.textures()->Get(i));
+          latch.CountDown();
+        });
+      }
+      latch.Wait();
+    } else {
+      for (size_t i = 0; i < texture_count; i++) {
+        images[i] = DecodeTextureFromFlatbuffer(scene.textures()->Get(i));
+      }
+    }
+    for (const auto& image : images) {
       // The elements of the unpacked texture array must correspond exactly with
       // the ipscene texture array. So if a texture is empty or invalid, a
       // nullptr is inserted as a placeholder.
-      textures.push_back(UnpackTextureFromFlatbuffer(iptexture, allocator));
+      textures.push_back(UploadTexture(image, allocator));
     }
   }
 
@@ -351,9 +388,8 @@ bool Node::IsJoint() const {
   return is_joint_;
 }
 
-bool Node::Render(SceneEncoder& encoder,
-                  Allocator& allocator,
-                  const Matrix& parent_transform) {
+void Node::PrepareForRender(std::vector<AnimationPlayer*>& animation_players,
+                            std::vector<Skin*>& skins) {
   std::optional<std::vector<MutationLog::Entry>> log = mutation_log_.Flush();
   if (log.has_value()) {
     for (const auto& entry : log.value()) {
@@ -403,15 +439,28 @@ bool Node::Render(SceneEncoder& encoder,
   }
 
   if (animation_player_.has_value()) {
-    animation_player_->Update();
+    animation_players.push_back(&animation_player_.value());
+  }
+  if (skin_) {
+    skins.push_back(skin_.get());
   }
 
+  for (auto& child : children_) {
+    child->PrepareForRender(animation_players, skins);
+  }
+}
+
+bool Node::Render(SceneEncoder& encoder, const Matrix& parent_transform) {
   Matrix transform = parent_transform * local_transform_;
-  mesh_.Render(encoder, transform,
-               skin_ ? skin_->GetJointsTexture(allocator) : nullptr);
+  if (skin_) {
+    mesh_.Render(encoder, transform, skin_->GetJointPaletteTexture(),
+                 skin_->GetJointPaletteOffset());
+  } else {
+    mesh_.Render(encoder, transform, nullptr, 0u);
+  }
 
   for (auto& child : children_) {
-    if (!child->Render(encoder, allocator, transform)) {
+    if (!child->Render(encoder, transform)) {
       return false;
     }
   }
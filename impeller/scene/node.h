@@ -9,6 +9,7 @@
 #include <optional>
 #include <vector>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "impeller/base/thread.h"
 #include "impeller/base/thread_safety.h"
@@ -62,11 +63,22 @@ class Node final {
     friend Node;
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      Unpacks a scene. Vertex data is copied into device buffers
+  ///             straight from the flatbuffer, so the mapping is usually a
+  ///             file mapping of the asset. When a worker task runner is
+  ///             given, the embedded textures are decoded on its workers.
+  ///
   static std::shared_ptr<Node> MakeFromFlatbuffer(
       const fml::Mapping& ipscene_mapping,
-      Allocator& allocator);
-  static std::shared_ptr<Node> MakeFromFlatbuffer(const fb::Scene& scene,
-                                                  Allocator& allocator);
+      Allocator& allocator,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner =
+          nullptr);
+  static std::shared_ptr<Node> MakeFromFlatbuffer(
+      const fb::Scene& scene,
+      Allocator& allocator,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner =
+          nullptr);
 
   Node();
   ~Node();
@@ -98,9 +110,12 @@ class Node final {
   void SetIsJoint(bool is_joint);
   bool IsJoint() const;
 
-  bool Render(SceneEncoder& encoder,
-              Allocator& allocator,
-              const Matrix& parent_transform);
+  //----------------------------------------------------------------------------
+  /// @brief      Records the commands of this node and its children. The
+  ///             animations and joint palettes of the scene must have been
+  ///             updated for the frame.
+  ///
+  bool Render(SceneEncoder& encoder, const Matrix& parent_transform);
 
   void AddMutation(const MutationLog::Entry& entry);
 
@@ -111,6 +126,12 @@ class Node final {
       const std::vector<std::shared_ptr<Texture>>& textures,
       Allocator& allocator);
 
+  /// Applies the pending mutations of this node and its children, and
+  /// collects their animation players and skins so the scene can update
+  /// them before rendering.
+  void PrepareForRender(std::vector<AnimationPlayer*>& animation_players,
+                        std::vector<Skin*>& skins);
+
   mutable MutationLog mutation_log_;
 
   Matrix local_transform_;
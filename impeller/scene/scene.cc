@@ -4,10 +4,23 @@
 
 #include "impeller/scene/scene.h"
 
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/allocation.h"
+#include "impeller/core/allocator.h"
+#include "impeller/scene/animation/animation_player.h"
+#include "impeller/scene/skin.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/scene/scene_context.h"
 #include "impeller/scene/scene_encoder.h"
@@ -30,13 +43,173 @@ Node& Scene::GetRoot() {
   return root_;
 }
 
+namespace {
+
+/// Runs a callback once for each index. The calling thread and the workers
+/// claim indices one at a time, so waiting for the job only ever waits on
+/// work that is already running.
+class ParallelJob {
+ public:
+  using Callback = std::function<void(size_t)>;
+
+  ParallelJob(size_t count, Callback callback)
+      : count_(count), callback_(std::move(callback)) {}
+
+  void Run() {
+    while (true) {
+      auto index = next_index_.fetch_add(1u);
+      if (index >= count_) {
+        return;
+      }
+      callback_(index);
+      std::scoped_lock lock(mutex_);
+      if (++completed_count_ == count_) {
+        completed_.notify_all();
+      }
+    }
+  }
+
+  void RunAndWait() {
+    Run();
+    std::unique_lock lock(mutex_);
+    completed_.wait(lock, [&] { return completed_count_ == count_; });
+  }
+
+ private:
+  const size_t count_;
+  const Callback callback_;
+  std::atomic<size_t> next_index_ = 0u;
+  std::mutex mutex_;
+  std::condition_variable completed_;
+  size_t completed_count_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParallelJob);
+};
+
+}  // namespace
+
+static void RunInParallel(
+    size_t count,
+    const std::function<void(size_t)>& callback,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  if (!worker_task_runner || count < 2u) {
+    for (size_t i = 0; i < count; i++) {
+      callback(i);
+    }
+    return;
+  }
+  auto job = std::make_shared<ParallelJob>(count, callback);
+  for (size_t i = 1; i < count; i++) {
+    worker_task_runner->PostTask([job]() {
+      TRACE_EVENT0("impeller", "SceneJobOnWorker");
+      job->Run();
+    });
+  }
+  job->RunAndWait();
+}
+
+/// Players nested in the subtree of another player may animate the same
+/// nodes, in which case they have to be updated in order.
+static bool AnimateDisjointNodes(
+    const std::vector<AnimationPlayer*>& animation_players) {
+  std::unordered_set<Node*> targets;
+  for (const auto* player : animation_players) {
+    for (auto* node : player->GetTargetNodes()) {
+      if (!targets.insert(node).second) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static void UpdateAnimations(
+    const std::vector<AnimationPlayer*>& animation_players,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", "SceneUpdateAnimations");
+  RunInParallel(
+      animation_players.size(),
+      [&](size_t i) { animation_players[i]->Update(); },
+      AnimateDisjointNodes(animation_players) ? worker_task_runner : nullptr);
+}
+
+/// Packs the joint matrices of every skin into one texture that all skinned
+/// geometry in the scene reads from.
+static void UpdateJointPalette(
+    const std::vector<Skin*>& skins,
+    Allocator& allocator,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  if (skins.empty()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "SceneUpdateJointPalette");
+
+  std::vector<size_t> offsets;
+  offsets.reserve(skins.size());
+  size_t joint_count = 0u;
+  for (const auto* skin : skins) {
+    offsets.push_back(joint_count);
+    joint_count += skin->GetJointCount();
+  }
+
+  // Each joint has a matrix. 1 matrix = 16 floats. 1 pixel = 4 floats.
+  // Therefore, each joint needs 4 pixels, and rows must be at least 4 pixels
+  // wide for a matrix to never span two rows.
+  auto required_pixels = std::max<size_t>(joint_count, 1u) * 4;
+  auto dimension_size = std::max(
+      4u,
+      Allocation::NextPowerOfTwoSize(std::ceil(std::sqrt(required_pixels))));
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  texture_descriptor.format = PixelFormat::kR32G32B32A32Float;
+  texture_descriptor.size = {dimension_size, dimension_size};
+  texture_descriptor.mip_count = 1u;
+
+  auto texture = allocator.CreateTexture(texture_descriptor);
+  if (!texture) {
+    FML_LOG(ERROR) << "Could not create joint palette texture.";
+    return;
+  }
+  texture->SetLabel("Joint Palette Texture");
+
+  std::vector<Matrix> joints;
+  joints.resize(texture->GetSize().Area() / 4, Matrix());
+  FML_DCHECK(joints.size() >= joint_count);
+  // Skins only read the scene, and each writes its own range of the palette.
+  RunInParallel(
+      skins.size(),
+      [&](size_t i) { skins[i]->ComputeJointMatrices(&joints[offsets[i]]); },
+      worker_task_runner);
+
+  if (!texture->SetContents(reinterpret_cast<uint8_t*>(joints.data()),
+                            joints.size() * sizeof(Matrix))) {
+    FML_LOG(ERROR) << "Could not set contents of joint palette texture.";
+    return;
+  }
+
+  for (size_t i = 0; i < skins.size(); i++) {
+    skins[i]->SetJointPalette(texture, offsets[i]);
+  }
+}
+
 bool Scene::Render(const RenderTarget& render_target,
                    const Matrix& camera_transform) {
+  const auto& context = scene_context_->GetContext();
+  const auto worker_task_runner = context->GetWorkerTaskRunner();
+
+  // Apply pending mutations, then advance the animations and pack the joints
+  // they move before any commands are recorded.
+  std::vector<AnimationPlayer*> animation_players;
+  std::vector<Skin*> skins;
+  root_.PrepareForRender(animation_players, skins);
+  UpdateAnimations(animation_players, worker_task_runner);
+  UpdateJointPalette(skins, *context->GetResourceAllocator(),
+                     worker_task_runner);
+
   // Collect the render commands from the scene.
   SceneEncoder encoder;
-  if (!root_.Render(encoder,
-                    *scene_context_->GetContext()->GetResourceAllocator(),
-                    Matrix())) {
+  if (!root_.Render(encoder, Matrix())) {
     FML_LOG(ERROR) << "Failed to render frame.";
     return false;
   }
@@ -8,6 +8,7 @@
 #include "impeller/scene/shaders/skinned.vert.h"
 #include "impeller/scene/shaders/unlit.frag.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
+#include "impeller/scene/shaders/unskinned_instanced.vert.h"
 
 namespace impeller {
 namespace scene {
@@ -44,6 +45,13 @@ SceneContext::SceneContext(std::shared_ptr<Context> context)
           *context_);
   pipelines_[{PipelineKey{GeometryType::kSkinned, MaterialType::kUnlit}}] =
       MakePipelineVariants<SkinnedVertexShader, UnlitFragmentShader>(*context_);
+  if (context_->GetCapabilities()->SupportsSSBO()) {
+    pipelines_[{PipelineKey{GeometryType::kUnskinnedInstanced,
+                            MaterialType::kUnlit}}] =
+        MakePipelineVariants<UnskinnedInstancedVertexShader,
+                             UnlitFragmentShader>(*context_);
+    supports_instancing_ = true;
+  }
 
   {
     impeller::TextureDescriptor texture_descriptor;
@@ -88,6 +96,10 @@ bool SceneContext::IsValid() const {
   return is_valid_;
 }
 
+bool SceneContext::SupportsInstancing() const {
+  return supports_instancing_;
+}
+
 std::shared_ptr<Context> SceneContext::GetContext() const {
   return context_;
 }
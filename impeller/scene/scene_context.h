@@ -47,6 +47,12 @@ class SceneContext {
       PipelineKey key,
       SceneContextOptions opts) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether geometry can be drawn once per transform from a
+  ///             storage buffer. This requires SSBO support.
+  ///
+  bool SupportsInstancing() const;
+
   std::shared_ptr<Context> GetContext() const;
 
   std::shared_ptr<Texture> GetPlaceholderTexture() const;
@@ -118,6 +124,7 @@ class SceneContext {
   std::shared_ptr<Context> context_;
 
   bool is_valid_ = false;
+  bool supports_instancing_ = false;
   // A 1x1 opaque white texture that can be used as a placeholder binding.
   // Available for the lifetime of the scene context
   std::shared_ptr<Texture> placeholder_texture_;
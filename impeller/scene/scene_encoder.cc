@@ -4,7 +4,16 @@
 
 #include "flutter/fml/macros.h"
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include "flutter/fml/logging.h"
+#include "impeller/core/platform.h"
 #include "impeller/renderer/command.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/scene/scene_context.h"
@@ -23,7 +32,8 @@ void SceneEncoder::Add(const SceneCommand& command) {
 static void EncodeCommand(const SceneContext& scene_context,
                           const Matrix& view_transform,
                           RenderPass& render_pass,
-                          const SceneCommand& scene_command) {
+                          const SceneCommand& scene_command,
+                          size_t lod) {
   auto& host_buffer = render_pass.GetTransientsBuffer();
 
   Command cmd;
@@ -39,11 +49,92 @@ static void EncodeCommand(const SceneContext& scene_context,
   scene_command.geometry->BindToCommand(
       scene_context, host_buffer, view_transform * scene_command.transform,
       cmd);
+  scene_command.geometry->BindLodToCommand(lod, cmd);
   scene_command.material->BindToCommand(scene_context, host_buffer, cmd);
 
   render_pass.AddCommand(std::move(cmd));
 }
 
+static void EncodeInstancedCommand(const SceneContext& scene_context,
+                                   const Matrix& view_transform,
+                                   RenderPass& render_pass,
+                                   const SceneCommand& scene_command,
+                                   size_t lod,
+                                   const std::vector<Matrix>& transforms) {
+  auto& host_buffer = render_pass.GetTransientsBuffer();
+
+  Command cmd;
+  cmd.label = scene_command.label + " (Instanced)";
+  cmd.stencil_reference = 0;
+  cmd.instance_count = transforms.size();
+
+  cmd.pipeline = scene_context.GetPipeline(
+      PipelineKey{GeometryType::kUnskinnedInstanced,
+                  scene_command.material->GetMaterialType()},
+      scene_command.material->GetContextOptions(render_pass));
+
+  auto instance_transforms =
+      host_buffer.Emplace(transforms.data(), transforms.size() * sizeof(Matrix),
+                          DefaultUniformAlignment());
+  if (!scene_command.geometry->BindToCommandInstanced(
+          scene_context, host_buffer, view_transform,
+          std::move(instance_transforms), cmd)) {
+    return;
+  }
+  scene_command.geometry->BindLodToCommand(lod, cmd);
+  scene_command.material->BindToCommand(scene_context, host_buffer, cmd);
+
+  render_pass.AddCommand(std::move(cmd));
+}
+
+/// Whether the bounds lie entirely outside of one of the clip planes once
+/// transformed by the model view projection.
+static bool IsOutsideFrustum(const Matrix& mvp, const GeometryBounds& bounds) {
+  // One bit per clip plane, set while every corner so far is outside it.
+  uint8_t outside = 0x3f;
+  for (size_t i = 0; i < 8u; i++) {
+    const Vector4 corner =
+        mvp * Vector4((i & 1) ? bounds.max.x : bounds.min.x,
+                      (i & 2) ? bounds.max.y : bounds.min.y,
+                      (i & 4) ? bounds.max.z : bounds.min.z, 1.0f);
+    uint8_t corner_outside = 0;
+    corner_outside |= (corner.x < -corner.w) ? 1 << 0 : 0;
+    corner_outside |= (corner.x > corner.w) ? 1 << 1 : 0;
+    corner_outside |= (corner.y < -corner.w) ? 1 << 2 : 0;
+    corner_outside |= (corner.y > corner.w) ? 1 << 3 : 0;
+    corner_outside |= (corner.z < 0.0f) ? 1 << 4 : 0;
+    corner_outside |= (corner.z > corner.w) ? 1 << 5 : 0;
+    outside &= corner_outside;
+    if (outside == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// The height in pixels of the bounds on screen once transformed by the model
+/// view projection, or `std::nullopt` if they reach behind the camera.
+static std::optional<Scalar> GetScreenHeight(const Matrix& mvp,
+                                             const GeometryBounds& bounds,
+                                             Scalar viewport_height) {
+  Scalar min_y = std::numeric_limits<Scalar>::max();
+  Scalar max_y = std::numeric_limits<Scalar>::lowest();
+  for (size_t i = 0; i < 8u; i++) {
+    const Vector4 corner =
+        mvp * Vector4((i & 1) ? bounds.max.x : bounds.min.x,
+                      (i & 2) ? bounds.max.y : bounds.min.y,
+                      (i & 4) ? bounds.max.z : bounds.min.z, 1.0f);
+    if (corner.w <= 0.0f) {
+      return std::nullopt;
+    }
+    const auto y = corner.y / corner.w;
+    min_y = std::min(min_y, y);
+    max_y = std::max(max_y, y);
+  }
+  // Normalized device coordinates span two units across the viewport.
+  return (max_y - min_y) * 0.5f * viewport_height;
+}
+
 std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     const SceneContext& scene_context,
     const Matrix& camera_transform,
@@ -90,8 +181,53 @@ std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     return nullptr;
   }
 
-  for (auto& command : commands_) {
-    EncodeCommand(scene_context, camera_transform, *render_pass, command);
+  // Commands are grouped by their geometry, material and level of detail in
+  // the order they first appear. Each group with more than one visible
+  // unskinned command is drawn with a single instanced command.
+  struct CommandGroup {
+    const SceneCommand* command;
+    size_t lod;
+    std::vector<Matrix> transforms;
+  };
+  const auto viewport_height =
+      static_cast<Scalar>(render_target.GetRenderTargetSize().height);
+  std::vector<CommandGroup> groups;
+  std::map<std::tuple<Geometry*, Material*, size_t>, size_t> group_indices;
+  for (const auto& command : commands_) {
+    const auto mvp = camera_transform * command.transform;
+    size_t lod = 0u;
+    if (auto bounds = command.geometry->GetBounds(); bounds.has_value()) {
+      if (IsOutsideFrustum(mvp, *bounds)) {
+        continue;
+      }
+      // Geometry reaching behind the camera is drawn at full detail.
+      if (auto screen_height = GetScreenHeight(mvp, *bounds, viewport_height);
+          screen_height.has_value()) {
+        lod = command.geometry->SelectLod(*screen_height);
+      }
+    }
+    if (!scene_context.SupportsInstancing() ||
+        command.geometry->GetGeometryType() != GeometryType::kUnskinned) {
+      groups.push_back({&command, lod, {command.transform}});
+      continue;
+    }
+    const auto key = std::make_tuple(command.geometry, command.material, lod);
+    if (auto found = group_indices.find(key); found != group_indices.end()) {
+      groups[found->second].transforms.push_back(command.transform);
+      continue;
+    }
+    group_indices[key] = groups.size();
+    groups.push_back({&command, lod, {command.transform}});
+  }
+
+  for (const auto& group : groups) {
+    if (group.transforms.size() == 1u) {
+      EncodeCommand(scene_context, camera_transform, *render_pass,
+                    *group.command, group.lod);
+    } else {
+      EncodeInstancedCommand(scene_context, camera_transform, *render_pass,
+                             *group.command, group.lod, group.transforms);
+    }
   }
 
   if (!render_pass->EncodeCommands()) {
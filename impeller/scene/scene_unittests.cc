@@ -70,6 +70,46 @@ TEST_P(SceneTest, CuboidUnlit) {
   OpenPlaygroundHere(callback);
 }
 
+TEST_P(SceneTest, RepeatedCuboidsUnlit) {
+  auto scene_context = std::make_shared<SceneContext>(GetContext());
+
+  // Every node shares the same geometry and material, so the visible cuboids
+  // are drawn with a single instanced command when SSBOs are supported.
+  auto geometry = Geometry::MakeCuboid(Vector3(1, 1, 0));
+  auto material = Material::MakeUnlit();
+  material->SetColor(Color::Red());
+
+  Renderer::RenderCallback callback = [&](RenderTarget& render_target) {
+    auto scene = Scene(scene_context);
+
+    static constexpr int kGridSize = 40;
+    for (int x = 0; x < kGridSize; x++) {
+      for (int y = 0; y < kGridSize; y++) {
+        Mesh mesh;
+        mesh.AddPrimitive({geometry, material});
+
+        auto node = std::make_shared<Node>();
+        node->SetLocalTransform(Matrix::MakeTranslation(
+            {(x - kGridSize / 2) * 1.5f, (y - kGridSize / 2) * 1.5f, 0}));
+        node->SetMesh(std::move(mesh));
+        scene.GetRoot().AddChild(std::move(node));
+      }
+    }
+
+    auto camera = Camera::MakePerspective(
+                      /* fov */ Radians(kPiOver4),
+                      /* position */ {0, 0, -30})
+                      .LookAt(
+                          /* target */ Vector3(),
+                          /* up */ {0, 1, 0});
+
+    scene.Render(render_target, camera);
+    return true;
+  };
+
+  OpenPlaygroundHere(callback);
+}
+
 TEST_P(SceneTest, FlutterLogo) {
   auto allocator = GetContext()->GetResourceAllocator();
 
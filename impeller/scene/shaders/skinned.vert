@@ -6,6 +6,8 @@ uniform FrameInfo {
   mat4 mvp;
   float enable_skinning;
   float joint_texture_size;
+  // The index of the first joint matrix of this skin in the joint palette.
+  float joint_offset;
 }
 frame_info;
 
@@ -35,7 +37,8 @@ mat4 GetJoint(float joint_index) {
 
   // Each joint matrix takes up 4 pixels (16 floats), so we jump 4 pixels per
   // joint matrix.
-  float matrix_start = joint_index * kMatrixTexelStride;
+  float matrix_start = (frame_info.joint_offset + joint_index) *
+                       kMatrixTexelStride;
 
   // The texture space coordinates at the start of the matrix.
   float x = mod(matrix_start, frame_info.joint_texture_size);
@@ -27,13 +27,34 @@ class Skin final {
   Skin(Skin&&);
   Skin& operator=(Skin&&);
 
-  std::shared_ptr<Texture> GetJointsTexture(Allocator& allocator);
+  size_t GetJointCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the model space matrix of each joint relative to its
+  ///             bind pose to |joints|, which must have room for
+  ///             `GetJointCount()` matrices. This only reads the scene and may
+  ///             be called for different skins concurrently.
+  ///
+  void ComputeJointMatrices(Matrix* joints) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the texture that the joint matrices of all skins of the
+  ///             scene are packed into, and the index of the first matrix of
+  ///             this skin in it.
+  ///
+  void SetJointPalette(std::shared_ptr<Texture> texture, size_t offset);
+
+  const std::shared_ptr<Texture>& GetJointPaletteTexture() const;
+
+  size_t GetJointPaletteOffset() const;
 
  private:
   Skin();
 
   std::vector<std::shared_ptr<Node>> joints_;
   std::vector<Matrix> inverse_bind_matrices_;
+  std::shared_ptr<Texture> joint_palette_;
+  size_t joint_palette_offset_ = 0u;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Skin);
 };
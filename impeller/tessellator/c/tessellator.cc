@@ -4,6 +4,8 @@
 
 #include "tessellator.h"
 
+#include <algorithm>
+#include <thread>
 #include <vector>
 
 namespace impeller {
@@ -37,28 +39,44 @@ void Close(PathBuilder* builder) {
   builder->Close();
 }
 
+namespace {
+
+// Appends the triangles of the path to the points, with the shared vertices
+// re-duplicated.
+bool AppendTriangles(const Tessellator& tessellator,
+                     const PathBuilder& builder,
+                     FillType fill_type,
+                     Scalar tolerance,
+                     std::vector<float>& points) {
+  const auto& path = builder.GetCurrentPath();
+  auto polyline = path.CreatePolyline(tolerance);
+  return tessellator.Tessellate(
+             fill_type, polyline,
+             [&points](const float* vertices, size_t vertices_size,
+                       const uint16_t* indices, size_t indices_size) {
+               points.reserve(points.size() + indices_size * 2);
+               for (auto i = 0u; i < indices_size; i++) {
+                 points.push_back(vertices[indices[i] * 2]);
+                 points.push_back(vertices[indices[i] * 2 + 1]);
+               }
+               return true;
+             }) == Tessellator::Result::kSuccess;
+}
+
+// Paths are tessellated on the calling thread below this count.
+constexpr uint32_t kMinPathsPerThread = 64;
+
+}  // namespace
+
 struct Vertices* Tessellate(PathBuilder* builder,
                             int fill_type,
                             Scalar tolerance) {
-  auto path = builder->CopyPath(static_cast<FillType>(fill_type));
-  auto polyline = path.CreatePolyline(tolerance);
+  // Tessellations are serialized by the tessellator, which keeps its
+  // allocations between calls.
+  static Tessellator* tessellator = new Tessellator();
   std::vector<float> points;
-  if (Tessellator{}.Tessellate(
-          path.GetFillType(), polyline,
-          [&points](const float* vertices, size_t vertices_size,
-                    const uint16_t* indices, size_t indices_size) {
-            // Results are expected to be re-duplicated.
-            std::vector<Point> raw_points;
-            for (auto i = 0u; i < vertices_size; i += 2) {
-              raw_points.emplace_back(Point{vertices[i], vertices[i + 1]});
-            }
-            for (auto i = 0u; i < indices_size; i++) {
-              auto point = raw_points[indices[i]];
-              points.push_back(point.x);
-              points.push_back(point.y);
-            }
-            return true;
-          }) != Tessellator::Result::kSuccess) {
+  if (!AppendTriangles(*tessellator, *builder,
+                       static_cast<FillType>(fill_type), tolerance, points)) {
     return nullptr;
   }
 
@@ -72,6 +90,79 @@ struct Vertices* Tessellate(PathBuilder* builder,
   return vertices;
 }
 
+uint32_t TessellateBatch(PathBuilder** builders,
+                         uint32_t count,
+                         int fill_type,
+                         Scalar tolerance,
+                         float* points,
+                         uint32_t points_capacity,
+                         uint32_t* offsets) {
+  if (count == 0) {
+    offsets[0] = 0;
+    return 0;
+  }
+
+  // Each worker tessellates a contiguous range of the paths into its own
+  // buffer, recording where the triangles of every path end.
+  struct Chunk {
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    std::vector<float> points;
+    std::vector<uint32_t> ends;
+  };
+  uint32_t thread_count = std::max(
+      1u, std::min(std::thread::hardware_concurrency(),
+                   count / kMinPathsPerThread));
+  std::vector<Chunk> chunks(thread_count);
+  for (uint32_t i = 0; i < thread_count; i++) {
+    chunks[i].begin = static_cast<uint64_t>(count) * i / thread_count;
+    chunks[i].end = static_cast<uint64_t>(count) * (i + 1) / thread_count;
+  }
+
+  auto tessellate_chunk = [builders, fill_type, tolerance](Chunk& chunk) {
+    Tessellator tessellator;
+    chunk.ends.reserve(chunk.end - chunk.begin);
+    for (auto i = chunk.begin; i < chunk.end; i++) {
+      auto size = chunk.points.size();
+      if (!AppendTriangles(tessellator, *builders[i],
+                           static_cast<FillType>(fill_type), tolerance,
+                           chunk.points)) {
+        chunk.points.resize(size);
+      }
+      chunk.ends.push_back(chunk.points.size());
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(thread_count - 1);
+  for (uint32_t i = 1; i < thread_count; i++) {
+    workers.emplace_back(tessellate_chunk, std::ref(chunks[i]));
+  }
+  tessellate_chunk(chunks[0]);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  uint32_t total = 0;
+  for (const auto& chunk : chunks) {
+    uint32_t start = 0;
+    for (auto i = chunk.begin; i < chunk.end; i++) {
+      offsets[i] = total + start;
+      start = chunk.ends[i - chunk.begin];
+    }
+    total += chunk.points.size();
+  }
+  offsets[count] = total;
+
+  if (points && total <= points_capacity) {
+    uint32_t offset = 0;
+    for (const auto& chunk : chunks) {
+      std::copy(chunk.points.begin(), chunk.points.end(), points + offset);
+      offset += chunk.points.size();
+    }
+  }
+  return total;
+}
+
 void DestroyVertices(Vertices* vertices) {
   delete vertices->points;
   delete vertices;
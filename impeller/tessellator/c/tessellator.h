@@ -46,5 +46,24 @@ IMPELLER_API struct Vertices* Tessellate(PathBuilder* builder,
 
 IMPELLER_API void DestroyVertices(Vertices* vertices);
 
+/// Tessellates the paths of `count` builders with the same fill type and
+/// tolerance, spread across worker threads that each reuse one tessellator.
+///
+/// The triangles of every path are written one after the other to `points`,
+/// as x, y pairs. `offsets` must have room for `count + 1` entries: the
+/// triangles of path `i` take up the floats from `offsets[i]` up to
+/// `offsets[i + 1]`. Paths that are empty or fail to tessellate take up none.
+///
+/// Returns the number of floats that the triangles of all paths take up. The
+/// points are only written if that is at most `points_capacity`; otherwise
+/// the caller may retry with a larger buffer. The offsets are always written.
+IMPELLER_API uint32_t TessellateBatch(PathBuilder** builders,
+                                      uint32_t count,
+                                      int fill_type,
+                                      Scalar tolerance,
+                                      float* points,
+                                      uint32_t points_capacity,
+                                      uint32_t* offsets);
+
 }  // namespace impeller
 }
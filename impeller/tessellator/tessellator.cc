@@ -4,6 +4,8 @@
 
 #include "impeller/tessellator/tessellator.h"
 
+#include <limits>
+
 #include "third_party/libtess2/Include/tesselator.h"
 
 namespace impeller {
@@ -64,6 +66,7 @@ Tessellator::Result Tessellator::Tessellate(
     return Result::kInputError;
   }
 
+  std::scoped_lock lock(mutex_);
   auto tessellator = c_tessellator_.get();
   if (!tessellator) {
     return Result::kTessellationError;
@@ -122,6 +125,45 @@ Tessellator::Result Tessellator::Tessellate(
   return Result::kSuccess;
 }
 
+Tessellator::Result Tessellator::TessellatePath(
+    const Path& path,
+    Scalar scale,
+    const BuilderCallback& callback) const {
+  auto fill_type = path.GetFillType();
+  auto polyline = path.CreatePolyline(scale);
+  if ((fill_type != FillType::kNonZero && fill_type != FillType::kOdd) ||
+      !path.IsConvex()) {
+    return Tessellate(fill_type, polyline, callback);
+  }
+  if (!callback) {
+    return Result::kInputError;
+  }
+
+  // The polyline of a closed contour ends on its first point.
+  auto point_count = polyline.points.size();
+  if (point_count > 1 && polyline.points.back() == polyline.points.front()) {
+    point_count--;
+  }
+  if (point_count < 3 ||
+      point_count > std::numeric_limits<uint16_t>::max() + 1u) {
+    return Tessellate(fill_type, polyline, callback);
+  }
+
+  std::vector<uint16_t> indices;
+  indices.reserve((point_count - 2) * 3);
+  for (size_t i = 1; i + 1 < point_count; i++) {
+    indices.push_back(0);
+    indices.push_back(static_cast<uint16_t>(i));
+    indices.push_back(static_cast<uint16_t>(i + 1));
+  }
+  static_assert(sizeof(Point) == 2 * sizeof(float));
+  if (!callback(reinterpret_cast<const float*>(polyline.points.data()),
+                point_count * 2, indices.data(), indices.size())) {
+    return Result::kInputError;
+  }
+  return Result::kSuccess;
+}
+
 void DestroyTessellator(TESStesselator* tessellator) {
   if (tessellator != nullptr) {
     ::tessDeleteTess(tessellator);
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -51,7 +52,8 @@ class Tessellator {
 
   //----------------------------------------------------------------------------
   /// @brief      Generates filled triangles from the polyline. A callback is
-  ///             invoked once for the entire tessellation.
+  ///             invoked once for the entire tessellation. Calls from
+  ///             multiple threads are serialized.
   ///
   /// @param[in]  fill_type The fill rule to use when filling.
   /// @param[in]  polyline  The polyline
@@ -63,7 +65,25 @@ class Tessellator {
                                  const Path::Polyline& polyline,
                                  const BuilderCallback& callback) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Generates filled triangles from the polyline of the path at
+  ///             the given scale. Convex paths under the non-zero or even-odd
+  ///             rules are filled with a triangle fan, which needs neither
+  ///             the sweep of |Tessellate| nor its lock.
+  ///
+  /// @param[in]  path      The path to fill with its own fill type.
+  /// @param[in]  scale     The scale to create the polyline of the path at.
+  /// @param[in]  callback  The callback, return false to indicate failure.
+  ///
+  /// @return The result status of the tessellation.
+  ///
+  Tessellator::Result TessellatePath(const Path& path,
+                                     Scalar scale,
+                                     const BuilderCallback& callback) const;
+
  private:
+  // The C tessellator reuses its allocations between calls.
+  mutable std::mutex mutex_;
   CTessellator c_tessellator_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Tessellator);
@@ -84,5 +84,50 @@ TEST(TessellatorTest, TessellatorBuilderReturnsCorrectResultStatus) {
   }
 }
 
+TEST(TessellatorTest, TessellatePathFansConvexPaths) {
+  Tessellator t;
+  auto path = PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 10, 10)).TakePath();
+  size_t vertex_count = 0;
+  std::vector<uint16_t> fan;
+  auto result = t.TessellatePath(
+      path, 1.0f,
+      [&vertex_count, &fan](const float* vertices, size_t vertices_size,
+                            const uint16_t* indices, size_t indices_size) {
+        vertex_count = vertices_size / 2;
+        fan.assign(indices, indices + indices_size);
+        return true;
+      });
+
+  ASSERT_EQ(result, Tessellator::Result::kSuccess);
+  // The point closing the contour is not repeated.
+  ASSERT_EQ(vertex_count, 4u);
+  ASSERT_EQ(fan, (std::vector<uint16_t>{0, 1, 2, 0, 2, 3}));
+}
+
+TEST(TessellatorTest, TessellatePathSweepsConcavePaths) {
+  Tessellator t;
+  auto path = PathBuilder{}
+                  .MoveTo({0, 0})
+                  .LineTo({10, 0})
+                  .LineTo({10, 5})
+                  .LineTo({5, 5})
+                  .LineTo({5, 10})
+                  .LineTo({0, 10})
+                  .Close()
+                  .TakePath();
+  ASSERT_FALSE(path.IsConvex());
+  size_t triangle_count = 0;
+  auto result = t.TessellatePath(
+      path, 1.0f,
+      [&triangle_count](const float* vertices, size_t vertices_size,
+                        const uint16_t* indices, size_t indices_size) {
+        triangle_count = indices_size / 3;
+        return true;
+      });
+
+  ASSERT_EQ(result, Tessellator::Result::kSuccess);
+  ASSERT_EQ(triangle_count, 4u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/toolkit/android/hardware_buffer.h"
+
+#include "impeller/base/validation.h"
+#include "impeller/toolkit/android/proc_table.h"
+
+namespace impeller {
+namespace android {
+
+HardwareBufferDescriptor HardwareBufferDescriptor::MakeForSwapchainImage(
+    uint32_t width,
+    uint32_t height) {
+  return HardwareBufferDescriptor{
+      .width = width,
+      .height = height,
+      .format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM,
+  };
+}
+
+HardwareBuffer::HardwareBuffer(const HardwareBufferDescriptor& descriptor)
+    : descriptor_(descriptor) {
+  const auto& procs = GetProcTable();
+  if (!procs.IsHardwareBufferAvailable()) {
+    VALIDATION_LOG << "Hardware buffers are not available on this device.";
+    return;
+  }
+  AHardwareBuffer_Desc desc = {};
+  desc.width = descriptor.width;
+  desc.height = descriptor.height;
+  desc.layers = 1u;
+  desc.format = descriptor.format;
+  desc.usage = AHARDWAREBUFFER_USAGE_GPU_COLOR_OUTPUT |
+               AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE |
+               AHARDWAREBUFFER_USAGE_COMPOSER_OVERLAY;
+  if (procs.AHardwareBuffer_allocate(&desc, &buffer_) != 0) {
+    VALIDATION_LOG << "Could not allocate a hardware buffer of "
+                   << descriptor.width << "x" << descriptor.height << ".";
+    buffer_ = nullptr;
+  }
+}
+
+HardwareBuffer::~HardwareBuffer() {
+  if (buffer_) {
+    GetProcTable().AHardwareBuffer_release(buffer_);
+  }
+}
+
+bool HardwareBuffer::IsValid() const {
+  return buffer_ != nullptr;
+}
+
+AHardwareBuffer* HardwareBuffer::GetHandle() const {
+  return buffer_;
+}
+
+const HardwareBufferDescriptor& HardwareBuffer::GetDescriptor() const {
+  return descriptor_;
+}
+
+}  // namespace android
+}  // namespace impeller
@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <android/hardware_buffer.h>
+
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+namespace android {
+
+struct HardwareBufferDescriptor {
+  uint32_t width = 0u;
+  uint32_t height = 0u;
+  uint32_t format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+
+  //----------------------------------------------------------------------------
+  /// @brief      A descriptor for a buffer that the GPU renders into and the
+  ///             compositor presents directly.
+  ///
+  static HardwareBufferDescriptor MakeForSwapchainImage(uint32_t width,
+                                                        uint32_t height);
+};
+
+//------------------------------------------------------------------------------
+/// An owned AHardwareBuffer.
+///
+class HardwareBuffer {
+ public:
+  explicit HardwareBuffer(const HardwareBufferDescriptor& descriptor);
+
+  ~HardwareBuffer();
+
+  bool IsValid() const;
+
+  AHardwareBuffer* GetHandle() const;
+
+  const HardwareBufferDescriptor& GetDescriptor() const;
+
+ private:
+  const HardwareBufferDescriptor descriptor_;
+  AHardwareBuffer* buffer_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(HardwareBuffer);
+};
+
+}  // namespace android
+}  // namespace impeller
@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/toolkit/android/proc_table.h"
+
+#include "flutter/fml/native_library.h"
+
+namespace impeller {
+namespace android {
+
+namespace {
+
+template <class T>
+void ResolveProc(const fml::RefPtr<fml::NativeLibrary>& library,
+                 const char* name,
+                 T& proc) {
+  proc = library->ResolveFunction<T>(name).value_or(nullptr);
+}
+
+ProcTable CreateProcTable() {
+  ProcTable table;
+  auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+  if (!libandroid) {
+    return table;
+  }
+#define RESOLVE_PROC(name) ResolveProc(libandroid, #name, table.name)
+  RESOLVE_PROC(AHardwareBuffer_allocate);
+  RESOLVE_PROC(AHardwareBuffer_release);
+  RESOLVE_PROC(AHardwareBuffer_describe);
+  RESOLVE_PROC(AHardwareBuffer_acquire);
+  RESOLVE_PROC(AHardwareBuffer_fromHardwareBuffer);
+  RESOLVE_PROC(AHardwareBuffer_getId);
+  RESOLVE_PROC(ASurfaceControl_createFromWindow);
+  RESOLVE_PROC(ASurfaceControl_create);
+  RESOLVE_PROC(ASurfaceControl_release);
+  RESOLVE_PROC(ASurfaceTransaction_create);
+  RESOLVE_PROC(ASurfaceTransaction_delete);
+  RESOLVE_PROC(ASurfaceTransaction_apply);
+  RESOLVE_PROC(ASurfaceTransaction_setBuffer);
+  RESOLVE_PROC(ASurfaceTransaction_setVisibility);
+  RESOLVE_PROC(ASurfaceTransaction_setZOrder);
+  RESOLVE_PROC(ASurfaceTransaction_setOnComplete);
+  RESOLVE_PROC(ASurfaceTransactionStats_getPresentFenceFd);
+#undef RESOLVE_PROC
+  return table;
+}
+
+}  // namespace
+
+bool ProcTable::IsHardwareBufferAvailable() const {
+  return AHardwareBuffer_allocate && AHardwareBuffer_release &&
+         AHardwareBuffer_describe;
+}
+
+bool ProcTable::IsSurfaceControlAvailable() const {
+  return IsHardwareBufferAvailable() && ASurfaceControl_createFromWindow &&
+         ASurfaceControl_create && ASurfaceControl_release &&
+         ASurfaceTransaction_create && ASurfaceTransaction_delete &&
+         ASurfaceTransaction_apply && ASurfaceTransaction_setBuffer &&
+         ASurfaceTransaction_setVisibility && ASurfaceTransaction_setZOrder &&
+         ASurfaceTransaction_setOnComplete &&
+         ASurfaceTransactionStats_getPresentFenceFd;
+}
+
+bool ProcTable::IsHardwareBufferImportAvailable() const {
+  return IsHardwareBufferAvailable() && AHardwareBuffer_acquire &&
+         AHardwareBuffer_fromHardwareBuffer;
+}
+
+const ProcTable& GetProcTable() {
+  static const ProcTable table = CreateProcTable();
+  return table;
+}
+
+}  // namespace android
+}  // namespace impeller
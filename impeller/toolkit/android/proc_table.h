@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <android/hardware_buffer.h>
+#include <android/hardware_buffer_jni.h>
+#include <android/native_window.h>
+#include <android/surface_control.h>
+
+#include <cstdint>
+
+namespace impeller {
+namespace android {
+
+// Invoked on a binder thread when the transaction has been presented.
+using SurfaceTransactionOnComplete = void (*)(void* context,
+                                              ASurfaceTransactionStats* stats);
+
+//------------------------------------------------------------------------------
+/// The NDK functions used to present through surface controls and to import
+/// the hardware buffers of external textures.
+///
+/// They are only available on newer API levels than the engine supports, so
+/// they are resolved from libandroid at runtime. Unavailable functions are
+/// null.
+///
+struct ProcTable {
+  // API 26+.
+  int (*AHardwareBuffer_allocate)(const AHardwareBuffer_Desc* desc,
+                                  AHardwareBuffer** out_buffer) = nullptr;
+  void (*AHardwareBuffer_release)(AHardwareBuffer* buffer) = nullptr;
+  void (*AHardwareBuffer_describe)(const AHardwareBuffer* buffer,
+                                   AHardwareBuffer_Desc* out_desc) = nullptr;
+  void (*AHardwareBuffer_acquire)(AHardwareBuffer* buffer) = nullptr;
+  AHardwareBuffer* (*AHardwareBuffer_fromHardwareBuffer)(
+      JNIEnv* env,
+      jobject hardware_buffer) = nullptr;
+
+  // API 29+.
+  ASurfaceControl* (*ASurfaceControl_createFromWindow)(
+      ANativeWindow* parent,
+      const char* debug_name) = nullptr;
+  ASurfaceControl* (*ASurfaceControl_create)(ASurfaceControl* parent,
+                                             const char* debug_name) = nullptr;
+  void (*ASurfaceControl_release)(ASurfaceControl* surface_control) = nullptr;
+  ASurfaceTransaction* (*ASurfaceTransaction_create)() = nullptr;
+  void (*ASurfaceTransaction_delete)(ASurfaceTransaction* transaction) =
+      nullptr;
+  void (*ASurfaceTransaction_apply)(ASurfaceTransaction* transaction) = nullptr;
+  void (*ASurfaceTransaction_setBuffer)(ASurfaceTransaction* transaction,
+                                        ASurfaceControl* surface_control,
+                                        AHardwareBuffer* buffer,
+                                        int acquire_fence_fd) = nullptr;
+  void (*ASurfaceTransaction_setVisibility)(ASurfaceTransaction* transaction,
+                                            ASurfaceControl* surface_control,
+                                            int8_t visibility) = nullptr;
+  void (*ASurfaceTransaction_setZOrder)(ASurfaceTransaction* transaction,
+                                        ASurfaceControl* surface_control,
+                                        int32_t z_order) = nullptr;
+  void (*ASurfaceTransaction_setOnComplete)(
+      ASurfaceTransaction* transaction,
+      void* context,
+      SurfaceTransactionOnComplete callback) = nullptr;
+  int (*ASurfaceTransactionStats_getPresentFenceFd)(
+      ASurfaceTransactionStats* stats) = nullptr;
+
+  // API 31+.
+  int (*AHardwareBuffer_getId)(const AHardwareBuffer* buffer,
+                               uint64_t* out_id) = nullptr;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether hardware buffers can be allocated.
+  ///
+  bool IsHardwareBufferAvailable() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether hardware buffers can be presented with surface
+  ///             transactions. Implies IsHardwareBufferAvailable.
+  ///
+  bool IsSurfaceControlAvailable() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the hardware buffers backing Java `HardwareBuffer`
+  ///             objects can be referenced. Implies IsHardwareBufferAvailable.
+  ///
+  bool IsHardwareBufferImportAvailable() const;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The process wide table of the functions, resolved on first use.
+///
+const ProcTable& GetProcTable();
+
+}  // namespace android
+}  // namespace impeller
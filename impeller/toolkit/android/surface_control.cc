@@ -0,0 +1,51 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/toolkit/android/surface_control.h"
+
+#include "impeller/base/validation.h"
+#include "impeller/toolkit/android/proc_table.h"
+
+namespace impeller {
+namespace android {
+
+SurfaceControl::SurfaceControl(ANativeWindow* window, const char* debug_name) {
+  const auto& procs = GetProcTable();
+  if (!window || !procs.IsSurfaceControlAvailable()) {
+    return;
+  }
+  control_ = procs.ASurfaceControl_createFromWindow(window, debug_name);
+  if (!control_) {
+    VALIDATION_LOG << "Could not create a surface control.";
+  }
+}
+
+SurfaceControl::SurfaceControl(const SurfaceControl& parent,
+                               const char* debug_name) {
+  const auto& procs = GetProcTable();
+  if (!parent.IsValid()) {
+    return;
+  }
+  control_ = procs.ASurfaceControl_create(parent.GetHandle(), debug_name);
+  if (!control_) {
+    VALIDATION_LOG << "Could not create a surface control.";
+  }
+}
+
+SurfaceControl::~SurfaceControl() {
+  if (control_) {
+    GetProcTable().ASurfaceControl_release(control_);
+  }
+}
+
+bool SurfaceControl::IsValid() const {
+  return control_ != nullptr;
+}
+
+ASurfaceControl* SurfaceControl::GetHandle() const {
+  return control_;
+}
+
+}  // namespace android
+}  // namespace impeller
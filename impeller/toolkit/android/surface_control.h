@@ -0,0 +1,45 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <android/native_window.h>
+#include <android/surface_control.h>
+
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+namespace android {
+
+//------------------------------------------------------------------------------
+/// An owned ASurfaceControl, a layer in the system compositor that buffers are
+/// presented to with a SurfaceTransaction.
+///
+class SurfaceControl {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a layer that is a child of the surface of the window.
+  ///
+  SurfaceControl(ANativeWindow* window, const char* debug_name);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a layer that is a child of another layer, such as an
+  ///             overlay above a platform view.
+  ///
+  SurfaceControl(const SurfaceControl& parent, const char* debug_name);
+
+  ~SurfaceControl();
+
+  bool IsValid() const;
+
+  ASurfaceControl* GetHandle() const;
+
+ private:
+  ASurfaceControl* control_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SurfaceControl);
+};
+
+}  // namespace android
+}  // namespace impeller
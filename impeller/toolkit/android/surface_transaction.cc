@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/toolkit/android/surface_transaction.h"
+
+#include <memory>
+
+#include "impeller/base/validation.h"
+#include "impeller/toolkit/android/proc_table.h"
+
+namespace impeller {
+namespace android {
+
+SurfaceTransaction::SurfaceTransaction() {
+  const auto& procs = GetProcTable();
+  if (!procs.IsSurfaceControlAvailable()) {
+    return;
+  }
+  transaction_ = procs.ASurfaceTransaction_create();
+}
+
+SurfaceTransaction::~SurfaceTransaction() {
+  if (transaction_) {
+    GetProcTable().ASurfaceTransaction_delete(transaction_);
+  }
+}
+
+bool SurfaceTransaction::IsValid() const {
+  return transaction_ != nullptr;
+}
+
+bool SurfaceTransaction::SetContents(const SurfaceControl& control,
+                                     const HardwareBuffer& buffer,
+                                     fml::UniqueFD acquire_fence) {
+  if (!IsValid() || !control.IsValid() || !buffer.IsValid()) {
+    VALIDATION_LOG << "Invalid transaction, surface control or buffer.";
+    return false;
+  }
+  GetProcTable().ASurfaceTransaction_setBuffer(
+      transaction_, control.GetHandle(), buffer.GetHandle(),
+      acquire_fence.is_valid() ? acquire_fence.release() : -1);
+  return true;
+}
+
+bool SurfaceTransaction::SetVisibility(const SurfaceControl& control,
+                                       bool visible) {
+  if (!IsValid() || !control.IsValid()) {
+    return false;
+  }
+  GetProcTable().ASurfaceTransaction_setVisibility(
+      transaction_, control.GetHandle(),
+      visible ? ASURFACE_TRANSACTION_VISIBILITY_SHOW
+              : ASURFACE_TRANSACTION_VISIBILITY_HIDE);
+  return true;
+}
+
+bool SurfaceTransaction::SetZOrder(const SurfaceControl& control,
+                                   int32_t z_order) {
+  if (!IsValid() || !control.IsValid()) {
+    return false;
+  }
+  GetProcTable().ASurfaceTransaction_setZOrder(transaction_,
+                                               control.GetHandle(), z_order);
+  return true;
+}
+
+bool SurfaceTransaction::Apply(OnCompleteCallback callback) {
+  if (!IsValid()) {
+    return false;
+  }
+  const auto& procs = GetProcTable();
+  if (callback) {
+    auto* context = new OnCompleteCallback(std::move(callback));
+    procs.ASurfaceTransaction_setOnComplete(
+        transaction_, context,
+        [](void* context, ASurfaceTransactionStats* stats) {
+          std::unique_ptr<OnCompleteCallback> callback(
+              reinterpret_cast<OnCompleteCallback*>(context));
+          (*callback)(fml::UniqueFD{
+              GetProcTable().ASurfaceTransactionStats_getPresentFenceFd(
+                  stats)});
+        });
+  }
+  procs.ASurfaceTransaction_apply(transaction_);
+  procs.ASurfaceTransaction_delete(transaction_);
+  transaction_ = nullptr;
+  return true;
+}
+
+}  // namespace android
+}  // namespace impeller
@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <android/surface_control.h>
+
+#include <functional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/toolkit/android/hardware_buffer.h"
+#include "impeller/toolkit/android/surface_control.h"
+
+namespace impeller {
+namespace android {
+
+//------------------------------------------------------------------------------
+/// A set of changes to surface controls that the system compositor applies
+/// atomically, in the same display frame.
+///
+/// This lets the buffer of the Flutter layer and those of the overlays above
+/// platform views be presented together.
+///
+class SurfaceTransaction {
+ public:
+  /// Invoked on a binder thread once the transaction has been presented, with
+  /// a fence that signals when the frame is on the display. The fence is
+  /// invalid if the device does not report one.
+  using OnCompleteCallback = std::function<void(fml::UniqueFD present_fence)>;
+
+  SurfaceTransaction();
+
+  ~SurfaceTransaction();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Presents the buffer in the layer once the acquire fence has
+  ///             signaled. The transaction takes ownership of the fence.
+  ///
+  bool SetContents(const SurfaceControl& control,
+                   const HardwareBuffer& buffer,
+                   fml::UniqueFD acquire_fence = {});
+
+  bool SetVisibility(const SurfaceControl& control, bool visible);
+
+  bool SetZOrder(const SurfaceControl& control, int32_t z_order);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Applies the changes. A transaction may only be applied once.
+  ///
+  bool Apply(OnCompleteCallback callback = nullptr);
+
+ private:
+  ASurfaceTransaction* transaction_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SurfaceTransaction);
+};
+
+}  // namespace android
+}  // namespace impeller
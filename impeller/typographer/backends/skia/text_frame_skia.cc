@@ -4,6 +4,10 @@
 
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -38,15 +42,11 @@ static Rect ToRect(const SkRect& rect) {
   return Rect::MakeLTRB(rect.fLeft, rect.fTop, rect.fRight, rect.fBottom);
 }
 
-TextFrame TextFrameFromTextBlob(const sk_sp<SkTextBlob>& blob, Scalar scale) {
-  if (!blob) {
-    return {};
-  }
-
+static TextFrame ConvertTextBlob(const sk_sp<SkTextBlob>& blob) {
   TextFrame frame;
 
   for (SkTextBlobRunIterator run(blob.get()); !run.done(); run.next()) {
-    TextRun text_run(ToFont(run, scale));
+    TextRun text_run(ToFont(run, 1.0f));
 
     // TODO(jonahwilliams): ask Skia for a public API to look this up.
     // https://github.com/flutter/flutter/issues/112005
@@ -93,4 +93,72 @@ TextFrame TextFrameFromTextBlob(const sk_sp<SkTextBlob>& blob, Scalar scale) {
   return frame;
 }
 
+namespace {
+
+/// Text blobs are immutable and are drawn again on every frame their display
+/// list is, so their text frames are converted once and kept until the blobs
+/// are gone.
+class TextFrameCache {
+ public:
+  std::optional<TextFrame> Get(const SkTextBlob& blob) {
+    std::scoped_lock lock(mutex_);
+    auto found = frames_.find(blob.uniqueID());
+    if (found == frames_.end()) {
+      return std::nullopt;
+    }
+    return found->second.frame;
+  }
+
+  void Put(const sk_sp<SkTextBlob>& blob, const TextFrame& frame) {
+    std::scoped_lock lock(mutex_);
+    if (frames_.size() >= sweep_size_) {
+      Sweep();
+    }
+    frames_.insert_or_assign(blob->uniqueID(), Entry{blob, frame});
+  }
+
+ private:
+  static constexpr size_t kMinSweepSize = 64u;
+
+  struct Entry {
+    sk_sp<SkTextBlob> blob;
+    TextFrame frame;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<uint32_t, Entry> frames_;
+  size_t sweep_size_ = kMinSweepSize;
+
+  // Drops the frames of blobs that only the cache holds on to anymore. Sweeps
+  // happen whenever the cache doubles in size since the last one, so they
+  // take constant time per conversion.
+  void Sweep() {
+    for (auto it = frames_.begin(); it != frames_.end();) {
+      if (it->second.blob->unique()) {
+        it = frames_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    sweep_size_ = std::max(kMinSweepSize, frames_.size() * 2);
+  }
+};
+
+}  // namespace
+
+TextFrame TextFrameFromTextBlob(const sk_sp<SkTextBlob>& blob, Scalar scale) {
+  if (!blob) {
+    return {};
+  }
+
+  static TextFrameCache cache;
+  auto frame = cache.Get(*blob);
+  if (!frame.has_value()) {
+    frame = ConvertTextBlob(blob);
+    cache.Put(blob, frame.value());
+  }
+  frame->SetFontScale(scale);
+  return std::move(frame.value());
+}
+
 }  // namespace impeller
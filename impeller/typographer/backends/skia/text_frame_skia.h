@@ -10,6 +10,13 @@
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      Convert a text blob to a text frame whose fonts are rasterized
+///             at the given scale.
+///
+///             The conversion of each blob is cached for as long as the blob
+///             is alive, so drawing it again only applies the scale.
+///
 TextFrame TextFrameFromTextBlob(const sk_sp<SkTextBlob>& blob,
                                 Scalar scale = 1.0f);
 
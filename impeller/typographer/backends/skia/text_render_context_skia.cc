@@ -4,12 +4,20 @@
 
 #include "impeller/typographer/backends/skia/text_render_context_skia.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
 #include <utility>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/core/allocator.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/typographer/backends/skia/typeface_skia.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -45,11 +53,8 @@ static FontGlyphPair::Set CollectUniqueFontGlyphPairsSet(
   while (auto frame = frame_iterator()) {
     for (const auto& run : frame->GetRuns()) {
       auto font = run.GetFont();
-      // TODO(dnfield): If we're doing SDF here, we should be using a consistent
-      // point size.
-      // https://github.com/flutter/flutter/issues/112016
-      for (const auto& glyph_position : run.GetGlyphPositions()) {
-        set.insert({font, glyph_position.glyph});
+      for (const auto& glyph : run.GetUniqueGlyphs()) {
+        set.insert(GlyphAtlas::GetAtlasPair(type, {font, glyph}));
       }
     }
   }
@@ -69,6 +74,28 @@ static FontGlyphPair::Vector CollectUniqueFontGlyphPairs(
   return vector;
 }
 
+static std::vector<Scalar> CollectTextScales(
+    const FontGlyphPair::Vector& pairs) {
+  std::vector<Scalar> scales;
+  for (const auto& pair : pairs) {
+    auto scale = pair.font.GetMetrics().scale;
+    if (std::find(scales.begin(), scales.end(), scale) == scales.end()) {
+      scales.push_back(scale);
+    }
+  }
+  return scales;
+}
+
+static FontGlyphPair::Vector ToSignedDistanceFieldPairs(
+    const FontGlyphPair::Vector& pairs) {
+  FontGlyphPair::Set set;
+  for (const auto& pair : pairs) {
+    set.insert(GlyphAtlas::GetAtlasPair(GlyphAtlas::Type::kSignedDistanceField,
+                                        pair));
+  }
+  return FontGlyphPair::Vector(set.begin(), set.end());
+}
+
 static size_t PairsFitInAtlasOfSize(
     const FontGlyphPair::Vector& pairs,
     const ISize& atlas_size,
@@ -291,6 +318,33 @@ static void ConvertBitmapToSignedDistanceField(uint8_t* pixels,
 #undef nearestpt
 }
 
+/// Converts the cells of glyphs that were drawn into a signed-distance field
+/// atlas after it was created, leaving the fields of the other glyphs as is.
+static void ConvertGlyphsToSignedDistanceField(
+    SkBitmap& bitmap,
+    const std::vector<Rect>& glyph_positions) {
+  std::vector<uint8_t> cell;
+  for (const auto& position : glyph_positions) {
+    const auto size = ISize::Ceil(position.size);
+    const int x = position.origin.x;
+    const int y = position.origin.y;
+    const int width = std::min<int>(size.width + kPadding, bitmap.width() - x);
+    const int height =
+        std::min<int>(size.height + kPadding, bitmap.height() - y);
+    if (width <= 0 || height <= 0) {
+      continue;
+    }
+    cell.resize(width * height);
+    for (int row = 0; row < height; row++) {
+      ::memcpy(cell.data() + row * width, bitmap.getAddr8(x, y + row), width);
+    }
+    ConvertBitmapToSignedDistanceField(cell.data(), width, height);
+    for (int row = 0; row < height; row++) {
+      ::memcpy(bitmap.getAddr8(x, y + row), cell.data() + row * width, width);
+    }
+  }
+}
+
 static void DrawGlyph(SkCanvas* canvas,
                       const FontGlyphPair& font_glyph,
                       const Rect& location,
@@ -324,35 +378,144 @@ static void DrawGlyph(SkCanvas* canvas,
   );
 }
 
-static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
-                              const std::shared_ptr<SkBitmap>& bitmap,
-                              const FontGlyphPair::Vector& new_pairs) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
-  FML_DCHECK(bitmap != nullptr);
+using GlyphPlacements = std::vector<std::pair<FontGlyphPair, Rect>>;
+
+/// Glyphs are packed into disjoint cells of the atlas so they can be drawn
+/// into the same bitmap from several threads at once, each through a canvas of
+/// its own that is clipped to the cell of the glyph it draws.
+class GlyphDrawJob {
+ public:
+  static constexpr size_t kGlyphsPerChunk = 32u;
+
+  GlyphDrawJob(const SkPixmap& pixmap,
+               GlyphPlacements placements,
+               bool has_color)
+      : pixmap_(pixmap),
+        placements_(std::move(placements)),
+        has_color_(has_color),
+        chunk_count_((placements_.size() + kGlyphsPerChunk - 1) /
+                     kGlyphsPerChunk) {}
+
+  size_t GetChunkCount() const { return chunk_count_; }
+
+  //----------------------------------------------------------------------------
+  /// Draws chunks of glyphs until all of them have been claimed. Workers that
+  /// only get to run once the job is complete don't touch the bitmap.
+  ///
+  void DrawChunks() {
+    while (true) {
+      auto chunk = next_chunk_.fetch_add(1u);
+      if (chunk >= chunk_count_) {
+        return;
+      }
+      if (!DrawChunk(chunk)) {
+        success_ = false;
+      }
+      std::scoped_lock lock(mutex_);
+      if (++completed_chunks_ == chunk_count_) {
+        completed_.notify_all();
+      }
+    }
+  }
 
-  auto surface = SkSurface::MakeRasterDirect(bitmap->pixmap());
-  if (!surface) {
-    return false;
+  //----------------------------------------------------------------------------
+  /// Helps drawing glyphs and then waits for the chunks claimed by workers.
+  ///
+  bool DrawChunksAndWait() {
+    DrawChunks();
+    std::unique_lock lock(mutex_);
+    completed_.wait(lock, [&] { return completed_chunks_ == chunk_count_; });
+    return success_;
+  }
+
+ private:
+  const SkPixmap pixmap_;
+  const GlyphPlacements placements_;
+  const bool has_color_;
+  const size_t chunk_count_;
+  std::atomic<size_t> next_chunk_ = 0u;
+  std::atomic<bool> success_ = true;
+  std::mutex mutex_;
+  std::condition_variable completed_;
+  size_t completed_chunks_ = 0u;
+
+  bool DrawChunk(size_t chunk) const {
+    auto surface = SkSurface::MakeRasterDirect(pixmap_);
+    if (!surface) {
+      return false;
+    }
+    auto canvas = surface->getCanvas();
+    if (!canvas) {
+      return false;
+    }
+    auto end = std::min(placements_.size(), (chunk + 1) * kGlyphsPerChunk);
+    for (auto i = chunk * kGlyphsPerChunk; i < end; i++) {
+      const auto& [pair, location] = placements_[i];
+      canvas->save();
+      canvas->resetMatrix();
+      canvas->clipRect(SkRect::MakeXYWH(location.origin.x,               //
+                                        location.origin.y,               //
+                                        location.size.width + kPadding,  //
+                                        location.size.height + kPadding  //
+                                        ));
+      DrawGlyph(canvas, pair, location, has_color_);
+      canvas->restore();
+    }
+    return true;
   }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
-    return false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GlyphDrawJob);
+};
+
+static bool DrawGlyphs(
+    const SkPixmap& pixmap,
+    GlyphPlacements placements,
+    bool has_color,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT1("impeller", __FUNCTION__, "Glyphs",
+               std::to_string(placements.size()).c_str());
+  auto job =
+      std::make_shared<GlyphDrawJob>(pixmap, std::move(placements), has_color);
+  if (worker_task_runner) {
+    // The calling thread draws too so this never waits on workers that are
+    // busy with other tasks.
+    for (size_t i = 1; i < job->GetChunkCount(); i++) {
+      worker_task_runner->PostTask([job]() {
+        TRACE_EVENT0("impeller", "DrawGlyphsOnWorker");
+        job->DrawChunks();
+      });
+    }
   }
+  return job->DrawChunksAndWait();
+}
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+static bool UpdateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    const std::shared_ptr<SkBitmap>& bitmap,
+    const FontGlyphPair::Vector& new_pairs,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  FML_DCHECK(bitmap != nullptr);
 
+  GlyphPlacements placements;
+  placements.reserve(new_pairs.size());
   for (const auto& pair : new_pairs) {
     auto pos = atlas.FindFontGlyphBounds(pair);
     if (!pos.has_value()) {
       continue;
     }
-    DrawGlyph(canvas, pair, pos.value(), has_color);
+    placements.emplace_back(pair, pos.value());
   }
-  return true;
+
+  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+  return DrawGlyphs(bitmap->pixmap(), std::move(placements), has_color,
+                    worker_task_runner);
 }
 
-static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
-                                                   const ISize& atlas_size) {
+static std::shared_ptr<SkBitmap> CreateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    const ISize& atlas_size,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   auto bitmap = std::make_shared<SkBitmap>();
   SkImageInfo image_info;
@@ -372,23 +535,20 @@ static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
     return nullptr;
   }
 
-  auto surface = SkSurface::MakeRasterDirect(bitmap->pixmap());
-  if (!surface) {
-    return nullptr;
-  }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
-    return nullptr;
-  }
-
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
-  atlas.IterateGlyphs([canvas, has_color](const FontGlyphPair& font_glyph,
-                                          const Rect& location) -> bool {
-    DrawGlyph(canvas, font_glyph, location, has_color);
+  GlyphPlacements placements;
+  placements.reserve(atlas.GetGlyphCount());
+  atlas.IterateGlyphs([&placements](const FontGlyphPair& font_glyph,
+                                    const Rect& location) -> bool {
+    placements.emplace_back(font_glyph, location);
     return true;
   });
 
+  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+  if (!DrawGlyphs(bitmap->pixmap(), std::move(placements), has_color,
+                  worker_task_runner)) {
+    return nullptr;
+  }
+
   return bitmap;
 }
 
@@ -408,6 +568,92 @@ static bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
   return texture->SetContents(mapping);
 }
 
+/// Uploads only the regions of the atlas used by the given glyphs instead of
+/// the entire bitmap. Returns false if the regions could not be uploaded, in
+/// which case the caller must upload the entire bitmap.
+static bool UpdateGlyphTextureAtlasRegions(
+    const std::shared_ptr<Context>& context,
+    const SkBitmap& bitmap,
+    const std::shared_ptr<Texture>& texture,
+    const std::vector<Rect>& glyph_positions) {
+  TRACE_EVENT1("impeller", __FUNCTION__, "Glyphs",
+               std::to_string(glyph_positions.size()).c_str());
+  if (!context || !texture ||
+      !context->GetCapabilities()->SupportsBufferToTextureBlits()) {
+    return false;
+  }
+
+  const auto atlas_bounds = IRect::MakeSize(texture->GetSize());
+  const size_t bytes_per_pixel =
+      BytesPerPixelForPixelFormat(texture->GetTextureDescriptor().format);
+  // Vulkan requires the buffer offsets of copies to be multiples of 4 and of
+  // the texel size.
+  const size_t alignment = std::max<size_t>(4u, bytes_per_pixel);
+
+  std::vector<std::pair<IRect, size_t>> regions;
+  regions.reserve(glyph_positions.size());
+  size_t staging_length = 0u;
+  for (const auto& position : glyph_positions) {
+    // The rect packer reserved the padding around the glyph as well and it may
+    // contain antialiasing that spilled out of the glyph bounds.
+    const auto size = ISize::Ceil(position.size);
+    auto region =
+        IRect::MakeXYWH(static_cast<int64_t>(position.origin.x),  //
+                        static_cast<int64_t>(position.origin.y),  //
+                        size.width + kPadding,                    //
+                        size.height + kPadding                    //
+                        )
+            .Intersection(atlas_bounds);
+    if (!region.has_value() || region->IsEmpty()) {
+      continue;
+    }
+    staging_length = (staging_length + alignment - 1) / alignment * alignment;
+    regions.emplace_back(region.value(), staging_length);
+    staging_length += region->size.Area() * bytes_per_pixel;
+  }
+  if (regions.empty()) {
+    return true;
+  }
+
+  DeviceBufferDescriptor staging_desc;
+  staging_desc.storage_mode = StorageMode::kHostVisible;
+  staging_desc.size = staging_length;
+  auto staging_buffer =
+      context->GetResourceAllocator()->CreateBuffer(staging_desc);
+  if (!staging_buffer || !staging_buffer->OnGetContents()) {
+    return false;
+  }
+  staging_buffer->SetLabel("GlyphAtlas Staging");
+  auto staging_contents = staging_buffer->OnGetContents();
+
+  auto cmd_buffer = context->CreateCommandBuffer();
+  if (!cmd_buffer) {
+    return false;
+  }
+  auto blit_pass = cmd_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return false;
+  }
+  blit_pass->SetLabel("GlyphAtlas Update");
+
+  for (const auto& [region, offset] : regions) {
+    const size_t row_length = region.size.width * bytes_per_pixel;
+    for (int64_t row = 0; row < region.size.height; row++) {
+      ::memcpy(staging_contents + offset + row * row_length,
+               bitmap.getAddr(region.origin.x, region.origin.y + row),
+               row_length);
+    }
+    BufferView view{staging_buffer, staging_contents,
+                    Range{offset, row_length * region.size.height}};
+    if (!blit_pass->AddCopy(std::move(view), texture, region)) {
+      return false;
+    }
+  }
+
+  return blit_pass->EncodeCommands(context->GetResourceAllocator()) &&
+         cmd_buffer->SubmitCommands();
+}
+
 static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
     const std::shared_ptr<Allocator>& allocator,
     std::shared_ptr<SkBitmap> bitmap,
@@ -468,6 +714,17 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
     return last_atlas;
   }
 
+  // Text that is zoomed or scaled would have its glyphs rasterized again at
+  // every new scale. While the scales animate, draw alpha glyphs from
+  // signed-distance fields that are shared by every scale instead, and go back
+  // to exact bitmaps once the scales settle.
+  if (type != GlyphAtlas::Type::kSignedDistanceField &&
+      atlas_context->UpdateTextScales(CollectTextScales(font_glyph_pairs)) &&
+      type == GlyphAtlas::Type::kAlphaBitmap) {
+    type = GlyphAtlas::Type::kSignedDistanceField;
+    font_glyph_pairs = ToSignedDistanceFieldPairs(font_glyph_pairs);
+  }
+
   // ---------------------------------------------------------------------------
   // Step 2: Determine if the atlas type and font glyph pairs are compatible
   //         with the current atlas and reuse if possible.
@@ -502,14 +759,23 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
     // Step 5: Draw new font-glyph pairs into the existing bitmap.
     // ---------------------------------------------------------------------------
     auto bitmap = atlas_context->GetBitmap();
-    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
+    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs,
+                           GetContext()->GetWorkerTaskRunner())) {
       return nullptr;
     }
+    if (type == GlyphAtlas::Type::kSignedDistanceField) {
+      ConvertGlyphsToSignedDistanceField(*bitmap, glyph_positions);
+    }
 
     // ---------------------------------------------------------------------------
-    // Step 6: Update the existing texture with the updated bitmap.
+    // Step 6: Update the existing texture with the updated bitmap. Only the
+    // regions of the new glyphs are uploaded if the backend can blit them,
+    // otherwise the whole bitmap is.
     // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
+    if (!UpdateGlyphTextureAtlasRegions(GetContext(), *bitmap,
+                                        last_atlas->GetTexture(),
+                                        glyph_positions) &&
+        !UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
       return nullptr;
     }
     return last_atlas;
@@ -548,7 +814,8 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 7: Draw font-glyph pairs in the correct spot in the atlas.
   // ---------------------------------------------------------------------------
-  auto bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size);
+  auto bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size,
+                                  GetContext()->GetWorkerTaskRunner());
   if (!bitmap) {
     return nullptr;
   }
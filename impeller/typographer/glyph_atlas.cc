@@ -4,6 +4,7 @@
 
 #include "impeller/typographer/glyph_atlas.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace impeller {
@@ -45,7 +46,40 @@ void GlyphAtlasContext::UpdateRectPacker(
   rect_packer_ = std::move(rect_packer);
 }
 
-GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
+bool GlyphAtlasContext::UpdateTextScales(std::vector<Scalar> scales) {
+  std::sort(scales.begin(), scales.end());
+  scales.erase(std::unique(scales.begin(), scales.end()), scales.end());
+  auto replaced = !std::includes(scales.begin(), scales.end(),
+                                 text_scales_.begin(), text_scales_.end()) &&
+                  !std::includes(text_scales_.begin(), text_scales_.end(),
+                                 scales.begin(), scales.end());
+  text_scales_ = std::move(scales);
+  if (replaced) {
+    scale_changes_++;
+    settled_frames_ = 0u;
+  } else if (++settled_frames_ >= kSettledFrames) {
+    scale_changes_ = 0u;
+  }
+  return scale_changes_ >= kAnimatingScaleChanges;
+}
+
+// static
+FontGlyphPair GlyphAtlas::GetAtlasPair(Type type, const FontGlyphPair& pair) {
+  auto metrics = pair.font.GetMetrics();
+  if (type != Type::kSignedDistanceField || metrics.point_size <= 0) {
+    return pair;
+  }
+  metrics.scale = kSignedDistanceFieldEmSize / metrics.point_size;
+  return {Font{pair.font.GetTypeface(), metrics}, pair.glyph};
+}
+
+static fml::MemoryCounter& GetGlyphAtlasMemoryCounter() {
+  static auto& counter = fml::MemoryCounter::Get("glyph_atlas");
+  return counter;
+}
+
+GlyphAtlas::GlyphAtlas(Type type)
+    : type_(type), texture_memory_count_(GetGlyphAtlasMemoryCounter(), 0u) {}
 
 GlyphAtlas::~GlyphAtlas() = default;
 
@@ -63,6 +97,9 @@ const std::shared_ptr<Texture>& GlyphAtlas::GetTexture() const {
 
 void GlyphAtlas::SetTexture(std::shared_ptr<Texture> texture) {
   texture_ = std::move(texture);
+  texture_memory_count_.Update(
+      texture_ ? texture_->GetTextureDescriptor().GetByteSizeOfBaseMipLevel()
+               : 0u);
 }
 
 void GlyphAtlas::AddTypefaceGlyphPosition(const FontGlyphPair& pair,
@@ -72,7 +109,7 @@ void GlyphAtlas::AddTypefaceGlyphPosition(const FontGlyphPair& pair,
 
 std::optional<Rect> GlyphAtlas::FindFontGlyphBounds(
     const FontGlyphPair& pair) const {
-  auto found = positions_.find(pair);
+  auto found = positions_.find(GetAtlasPair(type_, pair));
   if (found == positions_.end()) {
     return std::nullopt;
   }
@@ -8,8 +8,10 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/memory/memory_counter.h"
 #include "impeller/core/texture.h"
 #include "impeller/geometry/rect.h"
 #include "impeller/renderer/pipeline.h"
@@ -52,6 +54,20 @@ class GlyphAtlas {
     kColorBitmap,
   };
 
+  //----------------------------------------------------------------------------
+  /// The size, in pixels, that the em of every font is rasterized at in
+  /// signed-distance field atlases, whatever the scale of the text.
+  ///
+  static constexpr Scalar kSignedDistanceFieldEmSize = 48.0f;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the font-glyph pair that stands in for the given one in
+  ///             atlases of the given type. Signed-distance fields are
+  ///             rasterized at a fixed size, so they are shared by the glyph
+  ///             at every scale.
+  ///
+  static FontGlyphPair GetAtlasPair(Type type, const FontGlyphPair& pair);
+
   //----------------------------------------------------------------------------
   /// @brief      Create an empty glyph atlas.
   ///
@@ -135,6 +151,8 @@ class GlyphAtlas {
  private:
   const Type type_;
   std::shared_ptr<Texture> texture_;
+  // Counts the texture on the "glyph_atlas" memory counter.
+  fml::ScopedMemoryCount texture_memory_count_;
 
   std::unordered_map<FontGlyphPair,
                      Rect,
@@ -178,11 +196,31 @@ class GlyphAtlasContext {
 
   void UpdateRectPacker(std::shared_ptr<skgpu::Rectanizer> rect_packer);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Record the scales that the text of a frame is drawn at.
+  ///
+  ///             The scales are animating once they have been replaced in
+  ///             |kAnimatingScaleChanges| frames in a row, and settle once they
+  ///             stay the same for |kSettledFrames| frames. Text that appears
+  ///             or disappears doesn't count as a change.
+  ///
+  /// @param[in]  scales  The scales of the fonts in the frame.
+  ///
+  /// @return     Whether the scales are animating.
+  ///
+  bool UpdateTextScales(std::vector<Scalar> scales);
+
+  static constexpr size_t kAnimatingScaleChanges = 2u;
+  static constexpr size_t kSettledFrames = 4u;
+
  private:
   std::shared_ptr<GlyphAtlas> atlas_;
   ISize atlas_size_;
   std::shared_ptr<SkBitmap> bitmap_;
   std::shared_ptr<skgpu::Rectanizer> rect_packer_;
+  std::vector<Scalar> text_scales_;
+  size_t scale_changes_ = 0u;
+  size_t settled_frames_ = 0u;
 
   FML_DISALLOW_COPY_AND_ASSIGN(GlyphAtlasContext);
 };
@@ -30,6 +30,7 @@ std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     GlyphAtlas::Type type,
     std::shared_ptr<GlyphAtlasContext> atlas_context,
     std::shared_ptr<Context> context) const {
+  std::scoped_lock lock(atlas_map_mutex_);
   {
     auto atlas_it = atlas_map_.find(type);
     if (atlas_it != atlas_map_.end()) {
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
@@ -30,6 +31,8 @@ class LazyGlyphAtlas {
 
  private:
   std::vector<TextFrame> frames_;
+  // Text in subpasses that are encoded concurrently shares the atlases.
+  mutable std::mutex atlas_map_mutex_;
   mutable std::unordered_map<GlyphAtlas::Type, std::shared_ptr<GlyphAtlas>>
       atlas_map_;
   bool has_color_ = false;
@@ -42,6 +42,12 @@ const std::vector<TextRun>& TextFrame::GetRuns() const {
   return runs_;
 }
 
+void TextFrame::SetFontScale(Scalar scale) {
+  for (auto& run : runs_) {
+    run.SetFontScale(scale);
+  }
+}
+
 bool TextFrame::HasColor() const {
   return has_color_;
 }
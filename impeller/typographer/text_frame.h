@@ -62,6 +62,13 @@ class TextFrame {
   ///             to apply opacity peephole optimizations to text blobs.
   bool MaybeHasOverlapping() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Set the scale that the fonts of every run are rasterized at.
+  ///
+  /// @param[in]  scale  The scale
+  ///
+  void SetFontScale(Scalar scale);
+
   //----------------------------------------------------------------------------
   /// @brief      Whether any run in this frame has color.
   bool HasColor() const;
@@ -4,6 +4,8 @@
 
 #include "impeller/typographer/text_run.h"
 
+#include <algorithm>
+
 namespace impeller {
 
 TextRun::TextRun(const Font& font) : font_(font) {
@@ -17,6 +19,14 @@ TextRun::~TextRun() = default;
 
 bool TextRun::AddGlyph(Glyph glyph, Point position) {
   glyphs_.emplace_back(GlyphPosition{glyph, position});
+  auto is_before = [](const Glyph& a, const Glyph& b) {
+    return a.index < b.index || (a.index == b.index && a.type < b.type);
+  };
+  auto unique = std::lower_bound(unique_glyphs_.begin(), unique_glyphs_.end(),
+                                 glyph, is_before);
+  if (unique == unique_glyphs_.end() || is_before(glyph, *unique)) {
+    unique_glyphs_.insert(unique, glyph);
+  }
   has_color_ |= glyph.type == Glyph::Type::kBitmap;
   return true;
 }
@@ -29,6 +39,10 @@ const std::vector<TextRun::GlyphPosition>& TextRun::GetGlyphPositions() const {
   return glyphs_;
 }
 
+const std::vector<Glyph>& TextRun::GetUniqueGlyphs() const {
+  return unique_glyphs_;
+}
+
 size_t TextRun::GetGlyphCount() const {
   return glyphs_.size();
 }
@@ -37,6 +51,15 @@ const Font& TextRun::GetFont() const {
   return font_;
 }
 
+void TextRun::SetFontScale(Scalar scale) {
+  auto metrics = font_.GetMetrics();
+  if (metrics.scale == scale) {
+    return;
+  }
+  metrics.scale = scale;
+  font_ = Font{font_.GetTypeface(), metrics};
+}
+
 bool TextRun::HasColor() const {
   return has_color_;
 }
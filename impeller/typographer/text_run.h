@@ -61,6 +61,14 @@ class TextRun {
   ///
   const std::vector<GlyphPosition>& GetGlyphPositions() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get the distinct glyphs of the run, ordered by index. These
+  ///             are what the run needs from a glyph atlas.
+  ///
+  /// @return     The unique glyphs.
+  ///
+  const std::vector<Glyph>& GetUniqueGlyphs() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Get the font for this run.
   ///
@@ -68,6 +76,13 @@ class TextRun {
   ///
   const Font& GetFont() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Set the scale that the font of the run is rasterized at.
+  ///
+  /// @param[in]  scale  The scale
+  ///
+  void SetFontScale(Scalar scale);
+
   //----------------------------------------------------------------------------
   /// @brief      Whether any glyph in this run has color.
   bool HasColor() const;
@@ -75,6 +90,7 @@ class TextRun {
  private:
   Font font_;
   std::vector<GlyphPosition> glyphs_;
+  std::vector<Glyph> unique_glyphs_;
   bool is_valid_ = false;
   bool has_color_ = false;
 };
@@ -29,6 +29,25 @@ TEST_P(TypographerTest, CanConvertTextBlob) {
   }
 }
 
+TEST_P(TypographerTest, TextBlobConversionIsReusedAtEveryScale) {
+  SkFont font;
+  auto blob = SkTextBlob::MakeFromString("hello hello", font);
+  ASSERT_TRUE(blob);
+
+  auto frame = TextFrameFromTextBlob(blob, 1.0f);
+  auto scaled_frame = TextFrameFromTextBlob(blob, 2.0f);
+  ASSERT_EQ(frame.GetRunCount(), 1u);
+  ASSERT_EQ(scaled_frame.GetRunCount(), 1u);
+  const auto& run = frame.GetRuns()[0];
+  const auto& scaled_run = scaled_frame.GetRuns()[0];
+  ASSERT_EQ(run.GetFont().GetMetrics().scale, 1.0f);
+  ASSERT_EQ(scaled_run.GetFont().GetMetrics().scale, 2.0f);
+  ASSERT_EQ(run.GetGlyphCount(), scaled_run.GetGlyphCount());
+  // "helo " has five distinct glyphs.
+  ASSERT_EQ(run.GetUniqueGlyphs().size(), 5u);
+  ASSERT_EQ(scaled_run.GetUniqueGlyphs().size(), 5u);
+}
+
 TEST_P(TypographerTest, CanCreateRenderContext) {
   auto context = TextRenderContext::Create(GetContext());
   ASSERT_TRUE(context && context->IsValid());
@@ -268,5 +287,37 @@ TEST_P(TypographerTest, MaybeHasOverlapping) {
   ASSERT_TRUE(frame_2.MaybeHasOverlapping());
 }
 
+TEST_P(TypographerTest, GlyphAtlasUsesSignedDistanceFieldsWhileScaleAnimates) {
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("zoom", sk_font);
+  ASSERT_TRUE(blob);
+
+  auto create_atlas = [&](Scalar scale) {
+    return context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap,
+                                     atlas_context,
+                                     TextFrameFromTextBlob(blob, scale));
+  };
+
+  auto atlas = create_atlas(1.0f);
+  ASSERT_EQ(atlas->GetType(), GlyphAtlas::Type::kAlphaBitmap);
+  atlas = create_atlas(1.1f);
+  ASSERT_EQ(atlas->GetType(), GlyphAtlas::Type::kAlphaBitmap);
+  atlas = create_atlas(1.2f);
+  ASSERT_EQ(atlas->GetType(), GlyphAtlas::Type::kSignedDistanceField);
+
+  // The fields are shared by every scale.
+  auto next_atlas = create_atlas(1.3f);
+  ASSERT_EQ(atlas, next_atlas);
+
+  for (size_t i = 1; i < GlyphAtlasContext::kSettledFrames; i++) {
+    ASSERT_EQ(create_atlas(1.3f)->GetType(),
+              GlyphAtlas::Type::kSignedDistanceField);
+  }
+  ASSERT_EQ(create_atlas(1.3f)->GetType(), GlyphAtlas::Type::kAlphaBitmap);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -562,3 +562,90 @@ class ChannelBuffers {
 ///
 /// * [BinaryMessenger], where [ChannelBuffers] are typically read.
 final ChannelBuffers channelBuffers = ChannelBuffers();
+
+/// A ring of messages that a plugin writes from native code, on any thread,
+/// and that Dart code reads in place.
+///
+/// Unlike messages sent on a channel, writing to a ring does not post a task
+/// for each message, and the messages are not copied into the Dart heap. This
+/// suits plugins that stream many small messages, such as sensor samples.
+///
+/// Rings are created by the embedder, which passes their identifier to the
+/// isolate, and are consumed by calling [drain]. When [drain] finds the ring
+/// empty, the embedder is expected to post the identifier of the ring to the
+/// port it was created with once more messages are written.
+class SharedRing extends NativeFieldWrapperClass1 {
+  SharedRing._();
+
+  static const int _kWrapMarker = 0xFFFFFFFF;
+
+  static const int _kHeaderSize = 4;
+
+  /// Attaches to the ring registered with the given identifier, or returns
+  /// null if there is no such ring.
+  static SharedRing? attach(int identifier) {
+    final SharedRing ring = SharedRing._();
+    if (!ring._attach(identifier)) {
+      return null;
+    }
+    return ring;
+  }
+
+  @Native<Bool Function(Handle, Int64)>(symbol: 'SharedRing::Attach')
+  external bool _attach(int identifier);
+
+  ByteData? _buffer;
+
+  /// Calls `onRecord` for each message available in the ring, and returns the
+  /// number of messages read.
+  ///
+  /// The [ByteData] passed to `onRecord` is a view of the memory of the ring,
+  /// and must not be used after `onRecord` returns.
+  int drain(void Function(ByteData record) onRecord) {
+    final ByteData buffer = _buffer ??= _getBuffer();
+    int count = 0;
+    int available = _acquire();
+    while (available > 0) {
+      int offset = _readOffset();
+      final int end = offset + available;
+      try {
+        while (offset < end) {
+          final int length = buffer.getUint32(offset, Endian.host);
+          if (length == _kWrapMarker) {
+            offset = end;
+            break;
+          }
+          final int start = offset + _kHeaderSize;
+          offset = start + ((length + 3) & ~3);
+          count += 1;
+          onRecord(ByteData.sublistView(buffer, start, start + length));
+        }
+      } finally {
+        _release(offset - (end - available));
+      }
+      available = _acquire();
+    }
+    return count;
+  }
+
+  @Native<Handle Function(Pointer<Void>)>(symbol: 'SharedRing::getBuffer')
+  external ByteData _getBuffer();
+
+  @Native<Int32 Function(Pointer<Void>)>(symbol: 'SharedRing::acquire', isLeaf: true)
+  external int _acquire();
+
+  @Native<Int32 Function(Pointer<Void>)>(symbol: 'SharedRing::readOffset', isLeaf: true)
+  external int _readOffset();
+
+  @Native<Void Function(Pointer<Void>, Int32)>(symbol: 'SharedRing::release', isLeaf: true)
+  external void _release(int size);
+
+  /// Detaches from the ring. The ring must not be used afterwards.
+  void dispose() {
+    _buffer = null;
+    _dispose();
+  }
+
+  @Native<Void Function(Pointer<Void>)>(symbol: 'SharedRing::dispose')
+  external void _dispose();
+}
@@ -97,12 +97,14 @@ static sk_sp<DlImage> CreateDeferredImage(
     uint32_t height,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
     fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    std::shared_ptr<RasterizationQueue> rasterization_queue,
     fml::RefPtr<SkiaUnrefQueue> unref_queue) {
 #if IMPELLER_SUPPORTS_RENDERING
   if (impeller) {
     return DlDeferredImageGPUImpeller::Make(
         std::move(layer_tree), SkISize::Make(width, height),
-        std::move(snapshot_delegate), std::move(raster_task_runner));
+        std::move(snapshot_delegate), std::move(raster_task_runner),
+        std::move(rasterization_queue));
   }
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
@@ -110,7 +112,8 @@ static sk_sp<DlImage> CreateDeferredImage(
       width, height, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
   return DlDeferredImageGPUSkia::MakeFromLayerTree(
       image_info, std::move(layer_tree), std::move(snapshot_delegate),
-      raster_task_runner, std::move(unref_queue));
+      raster_task_runner, std::move(rasterization_queue),
+      std::move(unref_queue));
 }
 
 void Scene::RasterizeToImage(uint32_t width,
@@ -128,7 +131,7 @@ void Scene::RasterizeToImage(uint32_t width,
   auto dl_image = CreateDeferredImage(
       dart_state->IsImpellerEnabled(), layer_tree_, width, height,
       std::move(snapshot_delegate), std::move(raster_task_runner),
-      std::move(unref_queue));
+      dart_state->GetRasterizationQueue(), std::move(unref_queue));
   image->set_image(dl_image);
   image->AssociateWithDartWrapper(raw_image_handle);
 }
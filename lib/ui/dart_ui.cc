@@ -37,6 +37,7 @@
 #include "flutter/lib/ui/text/paragraph.h"
 #include "flutter/lib/ui/text/paragraph_builder.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
+#include "flutter/lib/ui/window/shared_ring.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/logging/dart_error.h"
@@ -95,6 +96,7 @@ typedef CanvasPath Path;
   V(IsolateNameServerNatives::RemovePortNameMapping, 1)               \
   V(NativeStringAttribute::initLocaleStringAttribute, 4)              \
   V(NativeStringAttribute::initSpellOutStringAttribute, 3)            \
+  V(Paragraph::LayoutAll, 2)                                          \
   V(PlatformConfigurationNativeApi::ImplicitViewEnabled, 0)           \
   V(PlatformConfigurationNativeApi::DefaultRouteName, 0)              \
   V(PlatformConfigurationNativeApi::ScheduleFrame, 0)                 \
@@ -110,6 +112,7 @@ typedef CanvasPath Path;
   V(PlatformConfigurationNativeApi::GetRootIsolateToken, 0)           \
   V(PlatformConfigurationNativeApi::RegisterBackgroundIsolate, 1)     \
   V(PlatformConfigurationNativeApi::SendPortPlatformMessage, 4)       \
+  V(SharedRing::Attach, 2)                                            \
   V(DartRuntimeHooks::Logger_PrintDebugString, 1)                     \
   V(DartRuntimeHooks::Logger_PrintString, 1)                          \
   V(DartRuntimeHooks::ScheduleMicrotask, 1)                           \
@@ -155,6 +158,7 @@ typedef CanvasPath Path;
   V(Canvas, drawRect, 7)                               \
   V(Canvas, drawShadow, 5)                             \
   V(Canvas, drawVertices, 5)                           \
+  V(Canvas, flushCommands, 3)                          \
   V(Canvas, getDestinationClipBounds, 2)               \
   V(Canvas, getLocalClipBounds, 2)                     \
   V(Canvas, getSaveCount, 1)                           \
@@ -179,6 +183,7 @@ typedef CanvasPath Path;
   V(ColorFilter, initSrgbToLinearGamma, 1)             \
   V(EngineLayer, dispose, 1)                           \
   V(FragmentProgram, initFromAsset, 2)                 \
+  V(FragmentProgram, warmUp, 2)                        \
   V(ReusableFragmentShader, Dispose, 1)                \
   V(ReusableFragmentShader, SetImageSampler, 3)        \
   V(ReusableFragmentShader, ValidateSamplers, 1)       \
@@ -299,6 +304,11 @@ typedef CanvasPath Path;
   V(SemanticsUpdateBuilder, updateCustomAction, 5)     \
   V(SemanticsUpdateBuilder, updateNode, 36)            \
   V(SemanticsUpdate, dispose, 1)                       \
+  V(SharedRing, acquire, 1)                            \
+  V(SharedRing, dispose, 1)                            \
+  V(SharedRing, getBuffer, 1)                          \
+  V(SharedRing, readOffset, 1)                         \
+  V(SharedRing, release, 2)                            \
   V(Vertices, dispose, 1)
 
 #ifdef IMPELLER_ENABLE_3D
@@ -1044,3 +1044,106 @@ external void _callHook(
   Object? arg19,
   Object? arg20,
 ]);
+
+/// Records a picture that goes through the [Canvas] natives that can be
+/// called without an image or a view, for `ui_benchmarks`.
+@pragma('vm:entry-point')
+void recordCanvasNatives() {
+  final Paint paint = Paint()..color = const Color(0xFF00FF00);
+  final Path path = Path()..addRect(const Rect.fromLTRB(10, 10, 90, 90));
+  final RRect rrect = RRect.fromLTRBR(10, 10, 90, 90, const Radius.circular(5));
+  final Float64List matrix = Float64List(16)
+    ..[0] = 1.0
+    ..[5] = 1.0
+    ..[10] = 1.0
+    ..[15] = 1.0;
+  final Float32List points = Float32List.fromList(<double>[10, 10, 90, 90]);
+  final Vertices vertices = Vertices.raw(
+    VertexMode.triangles,
+    Float32List.fromList(<double>[0, 0, 100, 0, 0, 100]),
+  );
+
+  final PictureRecorder innerRecorder = PictureRecorder();
+  Canvas(innerRecorder).drawRect(const Rect.fromLTRB(0, 0, 10, 10), paint);
+  final Picture innerPicture = innerRecorder.endRecording();
+
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder, const Rect.fromLTRB(0, 0, 100, 100));
+  canvas.save();
+  canvas.saveLayer(null, paint);
+  canvas.saveLayer(const Rect.fromLTRB(0, 0, 50, 50), paint);
+  canvas.getSaveCount();
+  canvas.translate(1, 1);
+  canvas.scale(1, 1);
+  canvas.rotate(0);
+  canvas.skew(0, 0);
+  canvas.transform(matrix);
+  canvas.getTransform();
+  canvas.clipRect(const Rect.fromLTRB(0, 0, 100, 100));
+  canvas.clipRRect(rrect);
+  canvas.clipPath(path);
+  canvas.getLocalClipBounds();
+  canvas.getDestinationClipBounds();
+  canvas.drawColor(const Color(0xFF0000FF), BlendMode.srcOver);
+  canvas.drawLine(Offset.zero, const Offset(100, 100), paint);
+  canvas.drawPaint(paint);
+  canvas.drawRect(const Rect.fromLTRB(10, 10, 90, 90), paint);
+  canvas.drawRRect(rrect, paint);
+  canvas.drawDRRect(rrect, rrect.deflate(5), paint);
+  canvas.drawOval(const Rect.fromLTRB(10, 10, 90, 90), paint);
+  canvas.drawCircle(const Offset(50, 50), 40, paint);
+  canvas.drawArc(const Rect.fromLTRB(10, 10, 90, 90), 0, 1, true, paint);
+  canvas.drawPath(path, paint);
+  canvas.drawPicture(innerPicture);
+  canvas.drawRawPoints(PointMode.lines, points, paint);
+  canvas.drawVertices(vertices, BlendMode.srcOver, paint);
+  canvas.restoreToCount(2);
+  canvas.restore();
+  recorder.endRecording().dispose();
+  innerPicture.dispose();
+  vertices.dispose();
+}
+
+/// Builds a path through every [Path] native, for `ui_benchmarks`.
+@pragma('vm:entry-point')
+void buildPathNatives() {
+  final Float64List matrix = Float64List(16)
+    ..[0] = 1.0
+    ..[5] = 1.0
+    ..[10] = 1.0
+    ..[15] = 1.0;
+  final Path other = Path()..addOval(const Rect.fromLTRB(0, 0, 50, 50));
+  final Path path = Path();
+  path.fillType = PathFillType.evenOdd;
+  path.fillType;
+  path.moveTo(0, 0);
+  path.relativeMoveTo(1, 1);
+  path.lineTo(10, 10);
+  path.relativeLineTo(1, 1);
+  path.quadraticBezierTo(10, 20, 20, 20);
+  path.relativeQuadraticBezierTo(1, 2, 2, 2);
+  path.cubicTo(20, 30, 30, 30, 30, 40);
+  path.relativeCubicTo(1, 2, 2, 2, 2, 3);
+  path.conicTo(40, 50, 50, 50, 1);
+  path.relativeConicTo(1, 2, 2, 2, 1);
+  path.arcTo(const Rect.fromLTRB(0, 0, 20, 20), 0, 1, false);
+  path.arcToPoint(const Offset(60, 60));
+  path.relativeArcToPoint(const Offset(1, 1));
+  path.addRect(const Rect.fromLTRB(0, 0, 10, 10));
+  path.addOval(const Rect.fromLTRB(0, 0, 10, 10));
+  path.addArc(const Rect.fromLTRB(0, 0, 10, 10), 0, 1);
+  path.addPolygon(const <Offset>[Offset.zero, Offset(10, 0), Offset(0, 10)], true);
+  path.addRRect(RRect.fromLTRBR(0, 0, 10, 10, const Radius.circular(2)));
+  path.addPath(other, Offset.zero);
+  path.addPath(other, Offset.zero, matrix4: matrix);
+  path.extendWithPath(other, Offset.zero);
+  path.extendWithPath(other, Offset.zero, matrix4: matrix);
+  path.close();
+  path.contains(const Offset(5, 5));
+  path.shift(const Offset(1, 1));
+  path.transform(matrix);
+  path.getBounds();
+  Path.from(path);
+  Path.combine(PathOperation.union, path, other);
+  path.reset();
+}
@@ -86,6 +86,13 @@ void _dispatchPlatformMessage(String name, ByteData? data, int responseId) {
   PlatformDispatcher.instance._dispatchPlatformMessage(name, data, responseId);
 }
 
+@pragma('vm:entry-point')
+void _dispatchPlatformMessages(List<String> names, List<Object?> data, List<int> responseIds) {
+  for (int i = 0; i < names.length; i++) {
+    PlatformDispatcher.instance._dispatchPlatformMessage(names[i], data[i] as ByteData?, responseIds[i]);
+  }
+}
+
 @pragma('vm:entry-point')
 void _dispatchPointerDataPacket(ByteData packet) {
   PlatformDispatcher.instance._dispatchPointerDataPacket(packet);
@@ -2851,13 +2851,13 @@ class Path extends NativeFieldWrapperClass1 {
     if (matrix4 != null) {
       assert(_matrix4IsValid(matrix4));
       _addPathWithMatrix(path, offset.dx, offset.dy, matrix4);
-    } else {
-      _addPath(path, offset.dx, offset.dy);
+    } else if (!_addPath(path, offset.dx, offset.dy)) {
+      throw ArgumentError('Path.addPath called with non-genuine Path.');
     }
   }
 
-  @Native<Void Function(Pointer<Void>, Pointer<Void>, Double, Double)>(symbol: 'Path::addPath')
-  external void _addPath(Path path, double dx, double dy);
+  @Native<Bool Function(Pointer<Void>, Pointer<Void>, Double, Double)>(symbol: 'Path::addPath', isLeaf: true)
+  external bool _addPath(Path path, double dx, double dy);
 
   @Native<Void Function(Pointer<Void>, Pointer<Void>, Double, Double, Handle)>(symbol: 'Path::addPathWithMatrix')
   external void _addPathWithMatrix(Path path, double dx, double dy, Float64List matrix);
@@ -2874,13 +2874,13 @@ class Path extends NativeFieldWrapperClass1 {
     if (matrix4 != null) {
       assert(_matrix4IsValid(matrix4));
       _extendWithPathAndMatrix(path, offset.dx, offset.dy, matrix4);
-    } else {
-      _extendWithPath(path, offset.dx, offset.dy);
+    } else if (!_extendWithPath(path, offset.dx, offset.dy)) {
+      throw ArgumentError('Path.extendWithPath called with non-genuine Path.');
     }
   }
 
-  @Native<Void Function(Pointer<Void>, Pointer<Void>, Double, Double)>(symbol: 'Path::extendWithPath')
-  external void _extendWithPath(Path path, double dx, double dy);
+  @Native<Bool Function(Pointer<Void>, Pointer<Void>, Double, Double)>(symbol: 'Path::extendWithPath', isLeaf: true)
+  external bool _extendWithPath(Path path, double dx, double dy);
 
   @Native<Void Function(Pointer<Void>, Pointer<Void>, Double, Double, Handle)>(symbol: 'Path::extendWithPathAndMatrix')
   external void _extendWithPathAndMatrix(Path path, double dx, double dy, Float64List matrix);
@@ -2972,7 +2972,7 @@ class Path extends NativeFieldWrapperClass1 {
     throw StateError('Path.combine() failed.  This may be due an invalid path; in particular, check for NaN values.');
   }
 
-  @Native<Bool Function(Pointer<Void>, Pointer<Void>, Pointer<Void>, Int32)>(symbol: 'Path::op')
+  @Native<Bool Function(Pointer<Void>, Pointer<Void>, Pointer<Void>, Int32)>(symbol: 'Path::op', isLeaf: true)
   external bool _op(Path path1, Path path2, int operation);
 
   /// Creates a [PathMetrics] object for this path, which can describe various
@@ -4341,6 +4341,9 @@ class FragmentProgram extends NativeFieldWrapperClass1 {
   /// compiler. The constructed object should then be reused via the
   /// [fragmentShader] method to create [Shader] objects that can be used by
   /// [Paint.shader].
+  ///
+  /// The returned future completes once the shader has been compiled for the
+  /// GPU, so that the first frame drawing it doesn't have to wait for it.
   static Future<FragmentProgram> fromAsset(String assetKey) {
     // The flutter tool converts all asset keys with spaces into URI
     // encoded paths (replacing ' ' with '%20', for example). We perform
@@ -4351,13 +4354,32 @@ class FragmentProgram extends NativeFieldWrapperClass1 {
     if (program != null) {
       return Future<FragmentProgram>.value(program);
     }
-    return Future<FragmentProgram>.microtask(() {
+    final Future<FragmentProgram>? pending = _pendingPrograms[encodedKey];
+    if (pending != null) {
+      return pending;
+    }
+    final Future<FragmentProgram> result = Future<FragmentProgram>.microtask(() {
       final FragmentProgram program = FragmentProgram._fromAsset(encodedKey);
-      _shaderRegistry[encodedKey] = WeakReference<FragmentProgram>(program);
-      return program;
+      // The shader is compiled off of the UI thread, so that neither loading
+      // nor first drawing the program stalls a frame.
+      return _futurize((_Callback<void> callback) {
+        return program._warmUp(callback);
+      }).then((_) {
+        _shaderRegistry[encodedKey] = WeakReference<FragmentProgram>(program);
+        return program;
+      });
+    }).whenComplete(() {
+      _pendingPrograms.remove(encodedKey);
     });
+    _pendingPrograms[encodedKey] = result;
+    return result;
   }
 
+  // The programs that are still being compiled, so that concurrent requests
+  // for the same asset share one compilation.
+  static final Map<String, Future<FragmentProgram>> _pendingPrograms =
+      <String, Future<FragmentProgram>>{};
+
   // This is a cache of shaders that have been loaded by
   // FragmentProgram.fromAsset. It holds weak references to the FragmentPrograms
   // so that the case where an in-use program is requested again can be fast,
@@ -4398,6 +4420,9 @@ class FragmentProgram extends NativeFieldWrapperClass1 {
   @Native<Handle Function(Pointer<Void>, Handle)>(symbol: 'FragmentProgram::initFromAsset')
   external String _initFromAsset(String assetKey);
 
+  @Native<Handle Function(Pointer<Void>, Handle)>(symbol: 'FragmentProgram::warmUp')
+  external String? _warmUp(_Callback<void> callback);
+
   /// Returns a fresh instance of [FragmentShader].
   FragmentShader fragmentShader() => FragmentShader._(this, debugName: _debugName);
 }
@@ -4860,6 +4885,118 @@ class Canvas extends NativeFieldWrapperClass1 {
   // garbage collected until PictureRecorder.endRecording is called.
   PictureRecorder? _recorder;
 
+  // Commands recorded by this canvas that have not been sent to the engine yet.
+  //
+  // Rather than calling into the engine once per operation, save, restore, the
+  // axis-aligned transforms, clipRect, drawColor, and the primitive draws whose
+  // paint has no native objects append themselves to this buffer as 8-byte
+  // slots: an opcode followed by its arguments. The draws use the paint of the
+  // most recent _kCommandSetPaint, which is only encoded again when the paint
+  // data changes. Every other Canvas method, and PictureRecorder.endRecording,
+  // flushes the buffer first so that the commands keep their order, and the
+  // engine decodes the whole buffer in one native call.
+  //
+  // The binary format must match the decoding code in canvas.cc.
+  ByteData? _commands;
+  int _commandSlotCount = 0;
+  // The byte offset of the paint data of the most recent _kCommandSetPaint, or
+  // -1 if no paint has been encoded since the last flush.
+  int _commandPaintOffset = -1;
+
+  static const int _kCommandSave = 0;
+  static const int _kCommandRestore = 1;
+  static const int _kCommandTranslate = 2;
+  static const int _kCommandScale = 3;
+  static const int _kCommandRotate = 4;
+  static const int _kCommandSkew = 5;
+  static const int _kCommandClipRect = 6;
+  static const int _kCommandDrawColor = 7;
+  static const int _kCommandSetPaint = 8;
+  static const int _kCommandDrawLine = 9;
+  static const int _kCommandDrawRect = 10;
+  static const int _kCommandDrawOval = 11;
+  static const int _kCommandDrawCircle = 12;
+  static const int _kCommandDrawRRect = 13;
+
+  static const int _kCommandBufferSlotCount = 512;
+  static const int _kPaintSlotCount = Paint._kDataByteCount >> 3;
+
+  // Appends a command with room for `argumentCount` arguments and returns the
+  // byte offset of its first argument.
+  int _beginCommand(int opcode, int argumentCount) {
+    if (_commandSlotCount + 1 + argumentCount > _kCommandBufferSlotCount) {
+      _flushCommands();
+    }
+    final ByteData commands = _commands ??= ByteData(_kCommandBufferSlotCount << 3);
+    final int offset = _commandSlotCount << 3;
+    commands.setFloat64(offset, opcode.toDouble(), _kFakeHostEndian);
+    _commandSlotCount += 1 + argumentCount;
+    return offset + 8;
+  }
+
+  void _addCommand(int opcode, int argumentCount, [double a = 0.0, double b = 0.0, double c = 0.0, double d = 0.0]) {
+    final int offset = _beginCommand(opcode, argumentCount);
+    final ByteData commands = _commands!;
+    if (argumentCount > 0) {
+      commands.setFloat64(offset, a, _kFakeHostEndian);
+    }
+    if (argumentCount > 1) {
+      commands.setFloat64(offset + 8, b, _kFakeHostEndian);
+    }
+    if (argumentCount > 2) {
+      commands.setFloat64(offset + 16, c, _kFakeHostEndian);
+    }
+    if (argumentCount > 3) {
+      commands.setFloat64(offset + 24, d, _kFakeHostEndian);
+    }
+  }
+
+  // Makes `paint` the paint of the draw command with `argumentCount` arguments
+  // that the caller appends next, or returns false if the paint refers to
+  // native objects and the draw has to call into the engine directly.
+  bool _setCommandPaint(Paint paint, int argumentCount) {
+    if (paint._objects != null) {
+      return false;
+    }
+    // Keep the paint and the draw in the same flush.
+    if (_commandSlotCount + 2 + _kPaintSlotCount + argumentCount > _kCommandBufferSlotCount) {
+      _flushCommands();
+    }
+    final ByteData data = paint._data;
+    if (_commandPaintOffset >= 0) {
+      final ByteData commands = _commands!;
+      bool matches = true;
+      for (int i = 0; i < Paint._kDataByteCount; i += 8) {
+        if (commands.getInt64(_commandPaintOffset + i, _kFakeHostEndian) != data.getInt64(i, _kFakeHostEndian)) {
+          matches = false;
+          break;
+        }
+      }
+      if (matches) {
+        return true;
+      }
+    }
+    final int offset = _beginCommand(_kCommandSetPaint, _kPaintSlotCount);
+    final ByteData commands = _commands!;
+    for (int i = 0; i < Paint._kDataByteCount; i += 8) {
+      commands.setInt64(offset + i, data.getInt64(i, _kFakeHostEndian), _kFakeHostEndian);
+    }
+    _commandPaintOffset = offset;
+    return true;
+  }
+
+  void _flushCommands() {
+    if (_commandSlotCount == 0) {
+      return;
+    }
+    _flushCommandBuffer(_commands!, _commandSlotCount);
+    _commandSlotCount = 0;
+    _commandPaintOffset = -1;
+  }
+
+  @Native<Void Function(Pointer<Void>, Handle, Int32)>(symbol: 'Canvas::flushCommands')
+  external void _flushCommandBuffer(ByteData commands, int slotCount);
+
   /// Saves a copy of the current transform and clip on the save stack.
   ///
   /// Call [restore] to pop the save stack.
@@ -4868,8 +5005,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   ///  * [saveLayer], which does the same thing but additionally also groups the
   ///    commands done until the matching [restore].
-  @Native<Void Function(Pointer<Void>)>(symbol: 'Canvas::save', isLeaf: true)
-  external void save();
+  void save() => _addCommand(_kCommandSave, 0);
 
   /// Saves a copy of the current transform and clip on the save stack, and then
   /// creates a new group which subsequent calls will become a part of. When the
@@ -4981,6 +5117,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///  * [BlendMode], which discusses the use of [Paint.blendMode] with
   ///    [saveLayer].
   void saveLayer(Rect? bounds, Paint paint) {
+    _flushCommands();
     if (bounds == null) {
       _saveLayerWithoutBounds(paint._objects, paint._data);
     } else {
@@ -5002,8 +5139,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   /// If the state was pushed with [saveLayer], then this call will also
   /// cause the new layer to be composited into the previous layer.
-  @Native<Void Function(Pointer<Void>)>(symbol: 'Canvas::restore', isLeaf: true)
-  external void restore();
+  void restore() => _addCommand(_kCommandRestore, 0);
 
   /// Restores the save stack to a previous level as might be obtained from [getSaveCount].
   /// If [count] is less than 1, the stack is restored to its initial state.
@@ -5014,8 +5150,13 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// If any of the state stack levels restored by this call were pushed with
   /// [saveLayer], then this call will also cause those layers to be composited
   /// into their previous layers.
+  void restoreToCount(int count) {
+    _flushCommands();
+    _restoreToCount(count);
+  }
+
   @Native<Void Function(Pointer<Void>, Int32)>(symbol: 'Canvas::restoreToCount', isLeaf: true)
-  external void restoreToCount(int count);
+  external void _restoreToCount(int count);
 
   /// Returns the number of items on the save stack, including the
   /// initial state. This means it returns 1 for a clean canvas, and
@@ -5023,13 +5164,17 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// each matching call to [restore] decrements it.
   ///
   /// This number cannot go below 1.
+  int getSaveCount() {
+    _flushCommands();
+    return _getSaveCount();
+  }
+
   @Native<Int32 Function(Pointer<Void>)>(symbol: 'Canvas::getSaveCount', isLeaf: true)
-  external int getSaveCount();
+  external int _getSaveCount();
 
   /// Add a translation to the current transform, shifting the coordinate space
   /// horizontally by the first argument and vertically by the second argument.
-  @Native<Void Function(Pointer<Void>, Double, Double)>(symbol: 'Canvas::translate', isLeaf: true)
-  external void translate(double dx, double dy);
+  void translate(double dx, double dy) => _addCommand(_kCommandTranslate, 2, dx, dy);
 
   /// Add an axis-aligned scale to the current transform, scaling by the first
   /// argument in the horizontal direction and the second in the vertical
@@ -5037,21 +5182,16 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   /// If [sy] is unspecified, [sx] will be used for the scale in both
   /// directions.
-  void scale(double sx, [double? sy]) => _scale(sx, sy ?? sx);
-
-  @Native<Void Function(Pointer<Void>, Double, Double)>(symbol: 'Canvas::scale', isLeaf: true)
-  external void _scale(double sx, double sy);
+  void scale(double sx, [double? sy]) => _addCommand(_kCommandScale, 2, sx, sy ?? sx);
 
   /// Add a rotation to the current transform. The argument is in radians clockwise.
-  @Native<Void Function(Pointer<Void>, Double)>(symbol: 'Canvas::rotate', isLeaf: true)
-  external void rotate(double radians);
+  void rotate(double radians) => _addCommand(_kCommandRotate, 1, radians);
 
   /// Add an axis-aligned skew to the current transform, with the first argument
   /// being the horizontal skew in rise over run units clockwise around the
   /// origin, and the second argument being the vertical skew in rise over run
   /// units clockwise around the origin.
-  @Native<Void Function(Pointer<Void>, Double, Double)>(symbol: 'Canvas::skew', isLeaf: true)
-  external void skew(double sx, double sy);
+  void skew(double sx, double sy) => _addCommand(_kCommandSkew, 2, sx, sy);
 
   /// Multiply the current transform by the specified 4⨉4 transformation matrix
   /// specified as a list of values in column-major order.
@@ -5059,6 +5199,7 @@ class Canvas extends NativeFieldWrapperClass1 {
     if (matrix4.length != 16) {
       throw ArgumentError('"matrix4" must have 16 entries.');
     }
+    _flushCommands();
     _transform(matrix4);
   }
 
@@ -5074,6 +5215,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// the current transform by restoring it to the same value it had before its
   /// associated [save] or [saveLayer] call.
   Float64List getTransform() {
+    _flushCommands();
     final Float64List matrix4 = Float64List(16);
     _getTransform(matrix4);
     return matrix4;
@@ -5097,12 +5239,16 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// current clip.
   void clipRect(Rect rect, { ClipOp clipOp = ClipOp.intersect, bool doAntiAlias = true }) {
     assert(_rectIsValid(rect));
-    _clipRect(rect.left, rect.top, rect.right, rect.bottom, clipOp.index, doAntiAlias);
+    final int offset = _beginCommand(_kCommandClipRect, 6);
+    _commands!
+      ..setFloat64(offset, rect.left, _kFakeHostEndian)
+      ..setFloat64(offset + 8, rect.top, _kFakeHostEndian)
+      ..setFloat64(offset + 16, rect.right, _kFakeHostEndian)
+      ..setFloat64(offset + 24, rect.bottom, _kFakeHostEndian)
+      ..setFloat64(offset + 32, clipOp.index.toDouble(), _kFakeHostEndian)
+      ..setFloat64(offset + 40, doAntiAlias ? 1.0 : 0.0, _kFakeHostEndian);
   }
 
-  @Native<Void Function(Pointer<Void>, Double, Double, Double, Double, Int32, Bool)>(symbol: 'Canvas::clipRect', isLeaf: true)
-  external void _clipRect(double left, double top, double right, double bottom, int clipOp, bool doAntiAlias);
-
   /// Reduces the clip region to the intersection of the current clip and the
   /// given rounded rectangle.
   ///
@@ -5115,6 +5261,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// discussion of how to address that and some examples of using [clipRRect].
   void clipRRect(RRect rrect, {bool doAntiAlias = true}) {
     assert(_rrectIsValid(rrect));
+    _flushCommands();
     _clipRRect(rrect._getValue32(), doAntiAlias);
   }
 
@@ -5132,11 +5279,14 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// in incorrect blending at the clip boundary. See [saveLayer] for a
   /// discussion of how to address that.
   void clipPath(Path path, {bool doAntiAlias = true}) {
-    _clipPath(path, doAntiAlias);
+    _flushCommands();
+    if (!_clipPath(path, doAntiAlias)) {
+      throw ArgumentError('Canvas.clipPath called with non-genuine Path.');
+    }
   }
 
-  @Native<Void Function(Pointer<Void>, Pointer<Void>, Bool)>(symbol: 'Canvas::clipPath')
-  external void _clipPath(Path path, bool doAntiAlias);
+  @Native<Bool Function(Pointer<Void>, Pointer<Void>, Bool)>(symbol: 'Canvas::clipPath', isLeaf: true)
+  external bool _clipPath(Path path, bool doAntiAlias);
 
   /// Returns the conservative bounds of the combined result of all clip methods
   /// executed within the current save stack of this [Canvas] object, as measured
@@ -5191,6 +5341,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// [saveLayer] call.
   /// {@endtemplate}
   Rect getLocalClipBounds() {
+    _flushCommands();
     final Float64List bounds = Float64List(4);
     _getLocalClipBounds(bounds);
     return Rect.fromLTRB(bounds[0], bounds[1], bounds[2], bounds[3]);
@@ -5214,6 +5365,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   /// {@macro dart.ui.canvas.conservativeClipBounds}
   Rect getDestinationClipBounds() {
+    _flushCommands();
     final Float64List bounds = Float64List(4);
     _getDestinationClipBounds(bounds);
     return Rect.fromLTRB(bounds[0], bounds[1], bounds[2], bounds[3]);
@@ -5226,12 +5378,9 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// [BlendMode], with the given color being the source and the background
   /// being the destination.
   void drawColor(Color color, BlendMode blendMode) {
-    _drawColor(color.value, blendMode.index);
+    _addCommand(_kCommandDrawColor, 2, color.value.toDouble(), blendMode.index.toDouble());
   }
 
-  @Native<Void Function(Pointer<Void>, Uint32, Int32)>(symbol: 'Canvas::drawColor', isLeaf: true)
-  external void _drawColor(int color, int blendMode);
-
   /// Draws a line between the given points using the given paint. The line is
   /// stroked, the value of the [Paint.style] is ignored for this call.
   ///
@@ -5242,6 +5391,11 @@ class Canvas extends NativeFieldWrapperClass1 {
   void drawLine(Offset p1, Offset p2, Paint paint) {
     assert(_offsetIsValid(p1));
     assert(_offsetIsValid(p2));
+    if (_setCommandPaint(paint, 4)) {
+      _addCommand(_kCommandDrawLine, 4, p1.dx, p1.dy, p2.dx, p2.dy);
+      return;
+    }
+    _flushCommands();
     _drawLine(p1.dx, p1.dy, p2.dx, p2.dy, paint._objects, paint._data);
   }
 
@@ -5253,6 +5407,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// To fill the canvas with a solid color and blend mode, consider
   /// [drawColor] instead.
   void drawPaint(Paint paint) {
+    _flushCommands();
     _drawPaint(paint._objects, paint._data);
   }
 
@@ -5266,6 +5421,11 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// ![](https://flutter.github.io/assets-for-api-docs/assets/dart-ui/canvas_rect_dark.png#gh-dark-mode-only)
   void drawRect(Rect rect, Paint paint) {
     assert(_rectIsValid(rect));
+    if (_setCommandPaint(paint, 4)) {
+      _addCommand(_kCommandDrawRect, 4, rect.left, rect.top, rect.right, rect.bottom);
+      return;
+    }
+    _flushCommands();
     _drawRect(rect.left, rect.top, rect.right, rect.bottom, paint._objects, paint._data);
   }
 
@@ -5279,6 +5439,24 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// ![](https://flutter.github.io/assets-for-api-docs/assets/dart-ui/canvas_rrect_dark.png#gh-dark-mode-only)
   void drawRRect(RRect rrect, Paint paint) {
     assert(_rrectIsValid(rrect));
+    if (_setCommandPaint(paint, 12)) {
+      final int offset = _beginCommand(_kCommandDrawRRect, 12);
+      _commands!
+        ..setFloat64(offset, rrect.left, _kFakeHostEndian)
+        ..setFloat64(offset + 8, rrect.top, _kFakeHostEndian)
+        ..setFloat64(offset + 16, rrect.right, _kFakeHostEndian)
+        ..setFloat64(offset + 24, rrect.bottom, _kFakeHostEndian)
+        ..setFloat64(offset + 32, rrect.tlRadiusX, _kFakeHostEndian)
+        ..setFloat64(offset + 40, rrect.tlRadiusY, _kFakeHostEndian)
+        ..setFloat64(offset + 48, rrect.trRadiusX, _kFakeHostEndian)
+        ..setFloat64(offset + 56, rrect.trRadiusY, _kFakeHostEndian)
+        ..setFloat64(offset + 64, rrect.brRadiusX, _kFakeHostEndian)
+        ..setFloat64(offset + 72, rrect.brRadiusY, _kFakeHostEndian)
+        ..setFloat64(offset + 80, rrect.blRadiusX, _kFakeHostEndian)
+        ..setFloat64(offset + 88, rrect.blRadiusY, _kFakeHostEndian);
+      return;
+    }
+    _flushCommands();
     _drawRRect(rrect._getValue32(), paint._objects, paint._data);
   }
 
@@ -5293,6 +5471,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   void drawDRRect(RRect outer, RRect inner, Paint paint) {
     assert(_rrectIsValid(outer));
     assert(_rrectIsValid(inner));
+    _flushCommands();
     _drawDRRect(outer._getValue32(), inner._getValue32(), paint._objects, paint._data);
   }
 
@@ -5307,6 +5486,11 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// ![](https://flutter.github.io/assets-for-api-docs/assets/dart-ui/canvas_oval_dark.png#gh-dark-mode-only)
   void drawOval(Rect rect, Paint paint) {
     assert(_rectIsValid(rect));
+    if (_setCommandPaint(paint, 4)) {
+      _addCommand(_kCommandDrawOval, 4, rect.left, rect.top, rect.right, rect.bottom);
+      return;
+    }
+    _flushCommands();
     _drawOval(rect.left, rect.top, rect.right, rect.bottom, paint._objects, paint._data);
   }
 
@@ -5322,6 +5506,11 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// ![](https://flutter.github.io/assets-for-api-docs/assets/dart-ui/canvas_circle_dark.png#gh-dark-mode-only)
   void drawCircle(Offset c, double radius, Paint paint) {
     assert(_offsetIsValid(c));
+    if (_setCommandPaint(paint, 3)) {
+      _addCommand(_kCommandDrawCircle, 3, c.dx, c.dy, radius);
+      return;
+    }
+    _flushCommands();
     _drawCircle(c.dx, c.dy, radius, paint._objects, paint._data);
   }
 
@@ -5344,6 +5533,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// This method is optimized for drawing arcs and should be faster than [Path.arcTo].
   void drawArc(Rect rect, double startAngle, double sweepAngle, bool useCenter, Paint paint) {
     assert(_rectIsValid(rect));
+    _flushCommands();
     _drawArc(rect.left, rect.top, rect.right, rect.bottom, startAngle, sweepAngle, useCenter, paint._objects, paint._data);
   }
 
@@ -5365,6 +5555,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// [Paint.style]. If the path is filled, then sub-paths within it are
   /// implicitly closed (see [Path.close]).
   void drawPath(Path path, Paint paint) {
+    _flushCommands();
     _drawPath(path, paint._objects, paint._data);
   }
 
@@ -5376,6 +5567,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   void drawImage(Image image, Offset offset, Paint paint) {
     assert(!image.debugDisposed);
     assert(_offsetIsValid(offset));
+    _flushCommands();
     final String? error = _drawImage(image._image, offset.dx, offset.dy, paint._objects, paint._data, paint.filterQuality.index);
     if (error != null) {
       throw PictureRasterizationException._(error, stack: image._debugStack);
@@ -5398,6 +5590,7 @@ class Canvas extends NativeFieldWrapperClass1 {
     assert(!image.debugDisposed);
     assert(_rectIsValid(src));
     assert(_rectIsValid(dst));
+    _flushCommands();
     final String? error = _drawImageRect(image._image,
                                          src.left,
                                          src.top,
@@ -5447,6 +5640,7 @@ class Canvas extends NativeFieldWrapperClass1 {
     assert(!image.debugDisposed);
     assert(_rectIsValid(center));
     assert(_rectIsValid(dst));
+    _flushCommands();
     final String? error = _drawImageNine(image._image,
                                          center.left,
                                          center.top,
@@ -5483,6 +5677,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   /// [PictureRecorder].
   void drawPicture(Picture picture) {
     assert(!picture.debugDisposed);
+    _flushCommands();
     _drawPicture(picture);
   }
 
@@ -5513,6 +5708,7 @@ class Canvas extends NativeFieldWrapperClass1 {
     assert(!paragraph.debugDisposed);
     assert(_offsetIsValid(offset));
     assert(!paragraph._needsLayout);
+    _flushCommands();
     paragraph._paint(this, offset.dx, offset.dy);
   }
 
@@ -5528,6 +5724,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///  * [drawRawPoints], which takes `points` as a [Float32List] rather than a
   ///    [List<Offset>].
   void drawPoints(PointMode pointMode, List<Offset> points, Paint paint) {
+    _flushCommands();
     _drawPoints(paint._objects, paint._data, pointMode.index, _encodePointList(points));
   }
 
@@ -5547,6 +5744,7 @@ class Canvas extends NativeFieldWrapperClass1 {
     if (points.length % 2 != 0) {
       throw ArgumentError('"points" must have an even number of values.');
     }
+    _flushCommands();
     _drawPoints(paint._objects, paint._data, pointMode.index, points);
   }
 
@@ -5583,6 +5781,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///   * [paint], Image shaders can be used to draw images on a triangular mesh.
   void drawVertices(Vertices vertices, BlendMode blendMode, Paint paint) {
     assert(!vertices.debugDisposed);
+    _flushCommands();
     _drawVertices(vertices, blendMode.index, paint._objects, paint._data);
   }
 
@@ -5763,6 +5962,7 @@ class Canvas extends NativeFieldWrapperClass1 {
     final Float32List? cullRectBuffer = cullRect?._getValue32();
     final int qualityIndex = paint.filterQuality.index;
 
+    _flushCommands();
     final String? error = _drawAtlas(
       paint._objects, paint._data, qualityIndex, atlas._image, rstTransformBuffer, rectBuffer,
       colorBuffer, (blendMode ?? BlendMode.src).index, cullRectBuffer
@@ -5941,6 +6141,7 @@ class Canvas extends NativeFieldWrapperClass1 {
     }
     final int qualityIndex = paint.filterQuality.index;
 
+    _flushCommands();
     final String? error = _drawAtlas(
       paint._objects, paint._data, qualityIndex, atlas._image, rstTransforms, rects,
       colors, (blendMode ?? BlendMode.src).index, cullRect?._getValue32()
@@ -5970,6 +6171,7 @@ class Canvas extends NativeFieldWrapperClass1 {
   ///
   /// The arguments must not be null.
   void drawShadow(Path path, Color color, double elevation, bool transparentOccluder) {
+    _flushCommands();
     _drawShadow(path, color.value, elevation, transparentOccluder);
   }
 
@@ -6136,6 +6338,7 @@ class PictureRecorder extends NativeFieldWrapperClass1 {
     if (_canvas == null) {
       throw StateError('PictureRecorder did not start recording.');
     }
+    _canvas!._flushCommands();
     final Picture picture = Picture._();
     _endRecording(picture);
     _canvas!._recorder = null;
@@ -14,6 +14,7 @@
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
 #include "flutter/lib/ui/window/window.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
 
 using tonic::ToDart;
 
@@ -179,16 +180,15 @@ void Canvas::clipRRect(const RRect& rrect, bool doAntiAlias) {
   }
 }
 
-void Canvas::clipPath(const CanvasPath* path, bool doAntiAlias) {
+bool Canvas::clipPath(const CanvasPath* path, bool doAntiAlias) {
   if (!path) {
-    Dart_ThrowException(
-        ToDart("Canvas.clipPath called with non-genuine Path."));
-    return;
+    return false;
   }
   if (display_list_builder_) {
     builder()->ClipPath(path->path(), DlCanvas::ClipOp::kIntersect,
                         doAntiAlias);
   }
+  return true;
 }
 
 void Canvas::getDestinationClipBounds(Dart_Handle rect_handle) {
@@ -639,6 +639,138 @@ void Canvas::drawShadow(const CanvasPath* path,
   }
 }
 
+namespace {
+
+// Must be kept in sync with the Canvas command opcodes in painting.dart.
+enum CanvasCommand {
+  kSave,
+  kRestore,
+  kTranslate,
+  kScale,
+  kRotate,
+  kSkew,
+  kClipRect,
+  kDrawColor,
+  kSetPaint,
+  kDrawLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+  kDrawRRect,
+};
+
+constexpr size_t kPaintSlotCount = Paint::kDataByteCount / sizeof(double);
+
+}  // namespace
+
+void Canvas::flushCommands(Dart_Handle commands_handle, int slot_count) {
+  tonic::DartByteData byte_data(commands_handle);
+  FML_CHECK(slot_count >= 0);
+  FML_CHECK(static_cast<size_t>(slot_count) <=
+            byte_data.length_in_bytes() / sizeof(double));
+  if (!display_list_builder_) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "ui.Canvas::flushCommands");
+
+  // Each command is an opcode slot followed by its arguments. Slots are
+  // doubles, except for the paint data of kSetPaint, which is copied verbatim
+  // from the Paint's ByteData.
+  const double* slots = static_cast<const double*>(byte_data.data());
+  const double* end = slots + slot_count;
+  DlPaint dl_paint;
+  while (slots < end) {
+    const double* args = slots + 1;
+    switch (static_cast<CanvasCommand>(slots[0])) {
+      case kSave:
+        save();
+        slots = args;
+        break;
+      case kRestore:
+        restore();
+        slots = args;
+        break;
+      case kTranslate:
+        translate(args[0], args[1]);
+        slots = args + 2;
+        break;
+      case kScale:
+        scale(args[0], args[1]);
+        slots = args + 2;
+        break;
+      case kRotate:
+        rotate(args[0]);
+        slots = args + 1;
+        break;
+      case kSkew:
+        skew(args[0], args[1]);
+        slots = args + 2;
+        break;
+      case kClipRect:
+        clipRect(args[0], args[1], args[2], args[3],
+                 static_cast<DlCanvas::ClipOp>(args[4]), args[5] != 0.0);
+        slots = args + 6;
+        break;
+      case kDrawColor:
+        drawColor(static_cast<SkColor>(args[0]),
+                  static_cast<DlBlendMode>(args[1]));
+        slots = args + 2;
+        break;
+      case kSetPaint:
+        dl_paint = DlPaint();
+        Paint::dataToDlPaint(args, dl_paint);
+        slots = args + kPaintSlotCount;
+        break;
+      case kDrawLine:
+        builder()->DrawLine(
+            SkPoint::Make(SafeNarrow(args[0]), SafeNarrow(args[1])),
+            SkPoint::Make(SafeNarrow(args[2]), SafeNarrow(args[3])), dl_paint);
+        slots = args + 4;
+        break;
+      case kDrawRect:
+        builder()->DrawRect(
+            SkRect::MakeLTRB(SafeNarrow(args[0]), SafeNarrow(args[1]),
+                             SafeNarrow(args[2]), SafeNarrow(args[3])),
+            dl_paint);
+        slots = args + 4;
+        break;
+      case kDrawOval:
+        builder()->DrawOval(
+            SkRect::MakeLTRB(SafeNarrow(args[0]), SafeNarrow(args[1]),
+                             SafeNarrow(args[2]), SafeNarrow(args[3])),
+            dl_paint);
+        slots = args + 4;
+        break;
+      case kDrawCircle:
+        builder()->DrawCircle(
+            SkPoint::Make(SafeNarrow(args[0]), SafeNarrow(args[1])),
+            SafeNarrow(args[2]), dl_paint);
+        slots = args + 3;
+        break;
+      case kDrawRRect: {
+        // Narrowed like the Float32List of RRect._getValue32.
+        SkVector radii[4] = {
+            {static_cast<float>(args[4]), static_cast<float>(args[5])},
+            {static_cast<float>(args[6]), static_cast<float>(args[7])},
+            {static_cast<float>(args[8]), static_cast<float>(args[9])},
+            {static_cast<float>(args[10]), static_cast<float>(args[11])}};
+        SkRRect rrect;
+        rrect.setRectRadii(SkRect::MakeLTRB(static_cast<float>(args[0]),
+                                            static_cast<float>(args[1]),
+                                            static_cast<float>(args[2]),
+                                            static_cast<float>(args[3])),
+                           radii);
+        builder()->DrawRRect(rrect, dl_paint);
+        slots = args + 12;
+        break;
+      }
+      default:
+        FML_DCHECK(false) << "Unknown canvas command " << slots[0];
+        return;
+    }
+  }
+}
+
 void Canvas::Invalidate() {
   display_list_builder_ = nullptr;
   if (dart_wrapper()) {
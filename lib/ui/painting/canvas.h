@@ -61,7 +61,7 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                 DlCanvas::ClipOp clipOp,
                 bool doAntiAlias = true);
   void clipRRect(const RRect& rrect, bool doAntiAlias = true);
-  void clipPath(const CanvasPath* path, bool doAntiAlias = true);
+  bool clipPath(const CanvasPath* path, bool doAntiAlias = true);
   void getDestinationClipBounds(Dart_Handle rect_handle);
   void getLocalClipBounds(Dart_Handle rect_handle);
 
@@ -184,6 +184,11 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                   double elevation,
                   bool transparentOccluder);
 
+  // Decodes the commands that the Dart Canvas batched into `commands_handle`,
+  // a ByteData of `slot_count` 8-byte slots. The format must match the
+  // encoding code in painting.dart.
+  void flushCommands(Dart_Handle commands_handle, int slot_count);
+
   void Invalidate();
 
   DisplayListBuilder* builder() { return display_list_builder_.get(); }
@@ -13,22 +13,24 @@ sk_sp<DlDeferredImageGPUImpeller> DlDeferredImageGPUImpeller::Make(
     std::shared_ptr<LayerTree> layer_tree,
     const SkISize& size,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
-    fml::RefPtr<fml::TaskRunner> raster_task_runner) {
+    fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    std::shared_ptr<RasterizationQueue> rasterization_queue) {
   return sk_sp<DlDeferredImageGPUImpeller>(new DlDeferredImageGPUImpeller(
       DlDeferredImageGPUImpeller::ImageWrapper::Make(
           std::move(layer_tree), size, std::move(snapshot_delegate),
-          std::move(raster_task_runner))));
+          std::move(raster_task_runner), std::move(rasterization_queue))));
 }
 
 sk_sp<DlDeferredImageGPUImpeller> DlDeferredImageGPUImpeller::Make(
     sk_sp<DisplayList> display_list,
     const SkISize& size,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
-    fml::RefPtr<fml::TaskRunner> raster_task_runner) {
+    fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    std::shared_ptr<RasterizationQueue> rasterization_queue) {
   return sk_sp<DlDeferredImageGPUImpeller>(new DlDeferredImageGPUImpeller(
       DlDeferredImageGPUImpeller::ImageWrapper::Make(
           std::move(display_list), size, std::move(snapshot_delegate),
-          std::move(raster_task_runner))));
+          std::move(raster_task_runner), std::move(rasterization_queue))));
 }
 
 DlDeferredImageGPUImpeller::DlDeferredImageGPUImpeller(
@@ -91,10 +93,11 @@ DlDeferredImageGPUImpeller::ImageWrapper::Make(
     sk_sp<DisplayList> display_list,
     const SkISize& size,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
-    fml::RefPtr<fml::TaskRunner> raster_task_runner) {
+    fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    std::shared_ptr<RasterizationQueue> rasterization_queue) {
   auto wrapper = std::shared_ptr<ImageWrapper>(new ImageWrapper(
       std::move(display_list), size, std::move(snapshot_delegate),
-      std::move(raster_task_runner)));
+      std::move(raster_task_runner), std::move(rasterization_queue)));
   wrapper->SnapshotDisplayList();
   return wrapper;
 }
@@ -104,10 +107,11 @@ DlDeferredImageGPUImpeller::ImageWrapper::Make(
     std::shared_ptr<LayerTree> layer_tree,
     const SkISize& size,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
-    fml::RefPtr<fml::TaskRunner> raster_task_runner) {
-  auto wrapper = std::shared_ptr<ImageWrapper>(
-      new ImageWrapper(nullptr, size, std::move(snapshot_delegate),
-                       std::move(raster_task_runner)));
+    fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    std::shared_ptr<RasterizationQueue> rasterization_queue) {
+  auto wrapper = std::shared_ptr<ImageWrapper>(new ImageWrapper(
+      nullptr, size, std::move(snapshot_delegate),
+      std::move(raster_task_runner), std::move(rasterization_queue)));
   wrapper->SnapshotDisplayList(std::move(layer_tree));
   return wrapper;
 }
@@ -116,11 +120,13 @@ DlDeferredImageGPUImpeller::ImageWrapper::ImageWrapper(
     sk_sp<DisplayList> display_list,
     const SkISize& size,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
-    fml::RefPtr<fml::TaskRunner> raster_task_runner)
+    fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    std::shared_ptr<RasterizationQueue> rasterization_queue)
     : size_(size),
       display_list_(std::move(display_list)),
       snapshot_delegate_(std::move(snapshot_delegate)),
-      raster_task_runner_(std::move(raster_task_runner)) {}
+      raster_task_runner_(std::move(raster_task_runner)),
+      rasterization_queue_(std::move(rasterization_queue)) {}
 
 DlDeferredImageGPUImpeller::ImageWrapper::~ImageWrapper() {
   fml::TaskRunner::RunNowOrPostTask(
@@ -148,8 +154,8 @@ bool DlDeferredImageGPUImpeller::ImageWrapper::isTextureBacked() const {
 
 void DlDeferredImageGPUImpeller::ImageWrapper::SnapshotDisplayList(
     std::shared_ptr<LayerTree> layer_tree) {
-  fml::TaskRunner::RunNowOrPostTask(
-      raster_task_runner_,
+  rasterization_queue_->Enqueue(
+      RasterizationQueue::Priority::kVisible,
       [weak_this = weak_from_this(), layer_tree = std::move(layer_tree)] {
         TRACE_EVENT0("flutter", "SnapshotDisplayList (impeller)");
         auto wrapper = weak_this.lock();
@@ -178,7 +184,9 @@ void DlDeferredImageGPUImpeller::ImageWrapper::SnapshotDisplayList(
           return;
         }
         wrapper->texture_ = snapshot->impeller_texture();
-      });
+      },
+      // The wrapper only outlives its image in pending raster tasks.
+      [weak_this = weak_from_this()] { return weak_this.expired(); });
 }
 
 std::optional<std::string>
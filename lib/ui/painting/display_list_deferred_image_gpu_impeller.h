@@ -10,6 +10,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/lib/ui/painting/rasterization_queue.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "impeller/core/texture.h"
 
@@ -21,13 +22,15 @@ class DlDeferredImageGPUImpeller final : public DlImage {
       std::shared_ptr<LayerTree> layer_tree,
       const SkISize& size,
       fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
-      fml::RefPtr<fml::TaskRunner> raster_task_runner);
+      fml::RefPtr<fml::TaskRunner> raster_task_runner,
+      std::shared_ptr<RasterizationQueue> rasterization_queue);
 
   static sk_sp<DlDeferredImageGPUImpeller> Make(
       sk_sp<DisplayList> display_list,
       const SkISize& size,
       fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
-      fml::RefPtr<fml::TaskRunner> raster_task_runner);
+      fml::RefPtr<fml::TaskRunner> raster_task_runner,
+      std::shared_ptr<RasterizationQueue> rasterization_queue);
 
   // |DlImage|
   ~DlDeferredImageGPUImpeller() override;
@@ -65,13 +68,15 @@ class DlDeferredImageGPUImpeller final : public DlImage {
         sk_sp<DisplayList> display_list,
         const SkISize& size,
         fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
-        fml::RefPtr<fml::TaskRunner> raster_task_runner);
+        fml::RefPtr<fml::TaskRunner> raster_task_runner,
+        std::shared_ptr<RasterizationQueue> rasterization_queue);
 
     static std::shared_ptr<ImageWrapper> Make(
         std::shared_ptr<LayerTree> layer_tree,
         const SkISize& size,
         fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
-        fml::RefPtr<fml::TaskRunner> raster_task_runner);
+        fml::RefPtr<fml::TaskRunner> raster_task_runner,
+        std::shared_ptr<RasterizationQueue> rasterization_queue);
 
     bool isTextureBacked() const;
 
@@ -89,6 +94,7 @@ class DlDeferredImageGPUImpeller final : public DlImage {
     std::shared_ptr<impeller::Texture> texture_;
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate_;
     fml::RefPtr<fml::TaskRunner> raster_task_runner_;
+    std::shared_ptr<RasterizationQueue> rasterization_queue_;
     std::shared_ptr<TextureRegistry> texture_registry_;
 
     mutable std::mutex error_mutex_;
@@ -98,7 +104,8 @@ class DlDeferredImageGPUImpeller final : public DlImage {
         sk_sp<DisplayList> display_list,
         const SkISize& size,
         fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
-        fml::RefPtr<fml::TaskRunner> raster_task_runner);
+        fml::RefPtr<fml::TaskRunner> raster_task_runner,
+        std::shared_ptr<RasterizationQueue> rasterization_queue);
 
     // If a layer tree is provided, it will be flattened during the raster
     // thread task spwaned by this method. After being flattened into a display
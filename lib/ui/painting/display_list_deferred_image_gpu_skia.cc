@@ -15,10 +15,12 @@ sk_sp<DlDeferredImageGPUSkia> DlDeferredImageGPUSkia::Make(
     sk_sp<DisplayList> display_list,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
     const fml::RefPtr<fml::TaskRunner>& raster_task_runner,
+    std::shared_ptr<RasterizationQueue> rasterization_queue,
     fml::RefPtr<SkiaUnrefQueue> unref_queue) {
   return sk_sp<DlDeferredImageGPUSkia>(new DlDeferredImageGPUSkia(
       ImageWrapper::Make(image_info, std::move(display_list),
                          std::move(snapshot_delegate), raster_task_runner,
+                         std::move(rasterization_queue),
                          std::move(unref_queue)),
       raster_task_runner));
 }
@@ -28,11 +30,13 @@ sk_sp<DlDeferredImageGPUSkia> DlDeferredImageGPUSkia::MakeFromLayerTree(
     std::shared_ptr<LayerTree> layer_tree,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
     const fml::RefPtr<fml::TaskRunner>& raster_task_runner,
+    std::shared_ptr<RasterizationQueue> rasterization_queue,
     fml::RefPtr<SkiaUnrefQueue> unref_queue) {
   return sk_sp<DlDeferredImageGPUSkia>(new DlDeferredImageGPUSkia(
       ImageWrapper::MakeFromLayerTree(
           image_info, std::move(layer_tree), std::move(snapshot_delegate),
-          raster_task_runner, std::move(unref_queue)),
+          raster_task_runner, std::move(rasterization_queue),
+          std::move(unref_queue)),
       raster_task_runner));
 }
 
@@ -44,6 +48,9 @@ DlDeferredImageGPUSkia::DlDeferredImageGPUSkia(
 
 // |DlImage|
 DlDeferredImageGPUSkia::~DlDeferredImageGPUSkia() {
+  if (image_wrapper_) {
+    image_wrapper_->Cancel();
+  }
   fml::TaskRunner::RunNowOrPostTask(raster_task_runner_,
                                     [image_wrapper = image_wrapper_]() {
                                       if (!image_wrapper) {
@@ -98,10 +105,12 @@ DlDeferredImageGPUSkia::ImageWrapper::Make(
     sk_sp<DisplayList> display_list,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
     fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    std::shared_ptr<RasterizationQueue> rasterization_queue,
     fml::RefPtr<SkiaUnrefQueue> unref_queue) {
   auto wrapper = std::shared_ptr<ImageWrapper>(new ImageWrapper(
       image_info, std::move(display_list), std::move(snapshot_delegate),
-      std::move(raster_task_runner), std::move(unref_queue)));
+      std::move(raster_task_runner), std::move(rasterization_queue),
+      std::move(unref_queue)));
   wrapper->SnapshotDisplayList();
   return wrapper;
 }
@@ -112,10 +121,12 @@ DlDeferredImageGPUSkia::ImageWrapper::MakeFromLayerTree(
     std::shared_ptr<LayerTree> layer_tree,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
     fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    std::shared_ptr<RasterizationQueue> rasterization_queue,
     fml::RefPtr<SkiaUnrefQueue> unref_queue) {
-  auto wrapper = std::shared_ptr<ImageWrapper>(
-      new ImageWrapper(image_info, nullptr, std::move(snapshot_delegate),
-                       std::move(raster_task_runner), std::move(unref_queue)));
+  auto wrapper = std::shared_ptr<ImageWrapper>(new ImageWrapper(
+      image_info, nullptr, std::move(snapshot_delegate),
+      std::move(raster_task_runner), std::move(rasterization_queue),
+      std::move(unref_queue)));
   wrapper->SnapshotDisplayList(std::move(layer_tree));
   return wrapper;
 }
@@ -125,11 +136,13 @@ DlDeferredImageGPUSkia::ImageWrapper::ImageWrapper(
     sk_sp<DisplayList> display_list,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
     fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    std::shared_ptr<RasterizationQueue> rasterization_queue,
     fml::RefPtr<SkiaUnrefQueue> unref_queue)
     : image_info_(image_info),
       display_list_(std::move(display_list)),
       snapshot_delegate_(std::move(snapshot_delegate)),
       raster_task_runner_(std::move(raster_task_runner)),
+      rasterization_queue_(std::move(rasterization_queue)),
       unref_queue_(std::move(unref_queue)) {}
 
 void DlDeferredImageGPUSkia::ImageWrapper::OnGrContextCreated() {
@@ -160,8 +173,8 @@ bool DlDeferredImageGPUSkia::ImageWrapper::isTextureBacked() const {
 
 void DlDeferredImageGPUSkia::ImageWrapper::SnapshotDisplayList(
     std::shared_ptr<LayerTree> layer_tree) {
-  fml::TaskRunner::RunNowOrPostTask(
-      raster_task_runner_,
+  rasterization_queue_->Enqueue(
+      RasterizationQueue::Priority::kVisible,
       [weak_this = weak_from_this(), layer_tree = std::move(layer_tree)]() {
         auto wrapper = weak_this.lock();
         if (!wrapper) {
@@ -194,6 +207,10 @@ void DlDeferredImageGPUSkia::ImageWrapper::SnapshotDisplayList(
           std::scoped_lock lock(wrapper->error_mutex_);
           wrapper->error_ = result->error;
         }
+      },
+      [weak_this = weak_from_this()]() {
+        auto wrapper = weak_this.lock();
+        return !wrapper || wrapper->cancelled_;
       });
 }
 
@@ -209,6 +226,10 @@ void DlDeferredImageGPUSkia::ImageWrapper::Unregister() {
   }
 }
 
+void DlDeferredImageGPUSkia::ImageWrapper::Cancel() {
+  cancelled_ = true;
+}
+
 void DlDeferredImageGPUSkia::ImageWrapper::DeleteTexture() {
   if (texture_.isValid()) {
     unref_queue_->DeleteTexture(texture_);
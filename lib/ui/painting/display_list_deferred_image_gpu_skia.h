@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_DISPLAY_LIST_DEFERRED_IMAGE_GPU_SKIA_H_
 #define FLUTTER_LIB_UI_PAINTING_DISPLAY_LIST_DEFERRED_IMAGE_GPU_SKIA_H_
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 
@@ -16,6 +17,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/rasterization_queue.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
 
 namespace flutter {
@@ -27,6 +29,7 @@ class DlDeferredImageGPUSkia final : public DlImage {
       sk_sp<DisplayList> display_list,
       fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
       const fml::RefPtr<fml::TaskRunner>& raster_task_runner,
+      std::shared_ptr<RasterizationQueue> rasterization_queue,
       fml::RefPtr<SkiaUnrefQueue> unref_queue);
 
   static sk_sp<DlDeferredImageGPUSkia> MakeFromLayerTree(
@@ -34,6 +37,7 @@ class DlDeferredImageGPUSkia final : public DlImage {
       std::shared_ptr<LayerTree> layer_tree,
       fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
       const fml::RefPtr<fml::TaskRunner>& raster_task_runner,
+      std::shared_ptr<RasterizationQueue> rasterization_queue,
       fml::RefPtr<SkiaUnrefQueue> unref_queue);
 
   // |DlImage|
@@ -79,6 +83,7 @@ class DlDeferredImageGPUSkia final : public DlImage {
         sk_sp<DisplayList> display_list,
         fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
         fml::RefPtr<fml::TaskRunner> raster_task_runner,
+        std::shared_ptr<RasterizationQueue> rasterization_queue,
         fml::RefPtr<SkiaUnrefQueue> unref_queue);
 
     static std::shared_ptr<ImageWrapper> MakeFromLayerTree(
@@ -86,6 +91,7 @@ class DlDeferredImageGPUSkia final : public DlImage {
         std::shared_ptr<LayerTree> layer_tree,
         fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
         fml::RefPtr<fml::TaskRunner> raster_task_runner,
+        std::shared_ptr<RasterizationQueue> rasterization_queue,
         fml::RefPtr<SkiaUnrefQueue> unref_queue);
 
     const SkImageInfo image_info() const { return image_info_; }
@@ -95,13 +101,18 @@ class DlDeferredImageGPUSkia final : public DlImage {
     sk_sp<SkImage> CreateSkiaImage() const;
     void Unregister();
     void DeleteTexture();
+    // Drops the rasterization of the image if it hasn't run yet. Called when
+    // the image is disposed.
+    void Cancel();
 
    private:
     const SkImageInfo image_info_;
     sk_sp<DisplayList> display_list_;
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate_;
     fml::RefPtr<fml::TaskRunner> raster_task_runner_;
+    std::shared_ptr<RasterizationQueue> rasterization_queue_;
     fml::RefPtr<SkiaUnrefQueue> unref_queue_;
+    std::atomic<bool> cancelled_ = false;
     std::shared_ptr<TextureRegistry> texture_registry_;
 
     mutable std::mutex error_mutex_;
@@ -117,6 +128,7 @@ class DlDeferredImageGPUSkia final : public DlImage {
         sk_sp<DisplayList> display_list,
         fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
         fml::RefPtr<fml::TaskRunner> raster_task_runner,
+        std::shared_ptr<RasterizationQueue> rasterization_queue,
         fml::RefPtr<SkiaUnrefQueue> unref_queue);
 
     // If a layer tree is provided, it will be flattened during the raster
@@ -9,17 +9,24 @@
 #include "flutter/lib/ui/painting/fragment_program.h"
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/runtime_stage/runtime_stage.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
 
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/entity/contents/runtime_effect_contents.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 #include "third_party/skia/include/core/SkString.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/dart_persistent_value.h"
+#include "third_party/tonic/logging/dart_invoke.h"
 #include "third_party/tonic/typed_data/typed_list.h"
 
 namespace flutter {
@@ -95,6 +102,69 @@ std::string FragmentProgram::initFromAsset(const std::string& asset_name) {
   return "";
 }
 
+Dart_Handle FragmentProgram::warmUp(Dart_Handle callback_handle) {
+  if (!Dart_IsClosure(callback_handle)) {
+    return tonic::ToDart("Callback must be a function");
+  }
+
+  std::shared_ptr<impeller::RuntimeStage> runtime_stage =
+      runtime_effect_ ? runtime_effect_->runtime_stage() : nullptr;
+  if (!runtime_stage) {
+    // Skia compiles runtime effects when they are first drawn.
+    tonic::DartInvoke(callback_handle, {Dart_TypeVoid()});
+    return Dart_Null();
+  }
+
+#if IMPELLER_SUPPORTS_RENDERING
+  auto dart_state = UIDartState::Current();
+  const auto& task_runners = dart_state->GetTaskRunners();
+  auto callback = std::make_unique<tonic::DartPersistentValue>(
+      tonic::DartState::Current(), callback_handle);
+
+  auto on_ready = [callback = std::move(callback),
+                   ui_task_runner =
+                       task_runners.GetUITaskRunner()](bool success) mutable {
+    ui_task_runner->PostTask(fml::MakeCopyable(
+        [callback = std::move(callback), success]() mutable {
+          auto dart_state = callback->dart_state().lock();
+          if (!dart_state) {
+            return;
+          }
+          tonic::DartState::Scope scope(dart_state);
+          tonic::DartInvoke(callback->Get(),
+                            {success ? Dart_TypeVoid() : Dart_Null()});
+        }));
+  };
+
+  // The context may only be obtained on the IO thread, but compiling the
+  // shader there would hold up texture uploads.
+  // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
+  task_runners.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+      [on_ready = std::move(on_ready), runtime_stage,
+       io_manager = dart_state->GetIOManager(),
+       concurrent_task_runner =
+           dart_state->GetConcurrentTaskRunner()]() mutable {
+        auto context =
+            io_manager ? io_manager->GetImpellerContext() : nullptr;
+        if (!context) {
+          // Without a context the shader is compiled when it is first drawn.
+          on_ready(true);
+          return;
+        }
+        concurrent_task_runner->PostTask(fml::MakeCopyable(
+            [on_ready = std::move(on_ready), runtime_stage,
+             context]() mutable {
+              TRACE_EVENT0("flutter", "FragmentProgram::warmUp");
+              on_ready(impeller::RuntimeEffectContents::BootstrapShader(
+                  context, runtime_stage));
+            }));
+      }));
+#else
+  tonic::DartInvoke(callback_handle, {Dart_TypeVoid()});
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  return Dart_Null();
+}
+
 std::shared_ptr<DlColorSource> FragmentProgram::MakeDlColorSource(
     std::shared_ptr<std::vector<uint8_t>> float_uniforms,
     const std::vector<std::shared_ptr<DlColorSource>>& children) {
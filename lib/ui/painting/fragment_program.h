@@ -30,6 +30,10 @@ class FragmentProgram : public RefCountedDartWrappable<FragmentProgram> {
 
   std::string initFromAsset(const std::string& asset_name);
 
+  /// Compiles the shader and its most common pipelines on a worker, and
+  /// invokes the callback on the UI thread once they are ready.
+  Dart_Handle warmUp(Dart_Handle callback_handle);
+
   fml::RefPtr<FragmentShader> shader(Dart_Handle shader,
                                      Dart_Handle uniforms_handle,
                                      Dart_Handle samplers);
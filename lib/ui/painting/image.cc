@@ -38,6 +38,12 @@ void CanvasImage::dispose() {
   ClearDartWrapper();
 }
 
+size_t CanvasImage::GetAllocationSize() const {
+  // Includes the memory of the texture backing the image, so that the Dart GC
+  // collects discarded images before they pile up in GPU memory.
+  return sizeof(CanvasImage) + (image_ ? image_->GetApproximateByteSize() : 0);
+}
+
 int CanvasImage::colorSpace() {
   if (image_->skia_image()) {
     return ColorSpace::kSRGB;
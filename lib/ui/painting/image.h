@@ -41,10 +41,16 @@ class CanvasImage final : public RefCountedDartWrappable<CanvasImage> {
 
   sk_sp<DlImage> image() const { return image_; }
 
-  void set_image(sk_sp<DlImage> image) { image_ = image; }
+  void set_image(sk_sp<DlImage> image) {
+    image_ = std::move(image);
+    UpdateDartWrapperExternalSize();
+  }
 
   int colorSpace();
 
+  // |tonic::DartWrappable|
+  size_t GetAllocationSize() const override;
+
  private:
   CanvasImage();
 
@@ -23,7 +23,8 @@ std::unique_ptr<ImageDecoder> ImageDecoder::Make(
         runners,                            //
         std::move(concurrent_task_runner),  //
         std::move(io_manager),              //
-        settings.enable_wide_gamut);
+        settings.enable_wide_gamut,         //
+        settings.enable_image_texture_compression);
   }
 #endif  // IMPELLER_SUPPORTS_RENDERING
   return std::make_unique<ImageDecoderSkia>(
@@ -4,20 +4,33 @@
 
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/memory_counter.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/impeller/aiks/aiks_context.h"
 #include "flutter/impeller/core/allocator.h"
 #include "flutter/impeller/core/texture.h"
 #include "flutter/impeller/display_list/display_list_image_impeller.h"
+#include "flutter/impeller/entity/contents/content_context.h"
+#include "flutter/impeller/entity/render_target_cache.h"
+#include "flutter/impeller/image/etc2_encoder.h"
 #include "flutter/impeller/renderer/command_buffer.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 #include "impeller/base/strings.h"
 #include "impeller/display_list/skia_conversions.h"
 #include "impeller/geometry/size.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/codec/SkEncodedOrigin.h"
 #include "third_party/skia/include/core/SkAlphaType.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
@@ -29,6 +42,8 @@
 #include "third_party/skia/include/core/SkPoint.h"
 #include "third_party/skia/include/core/SkSamplingOptions.h"
 #include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/core/SkYUVAInfo.h"
+#include "third_party/skia/include/core/SkYUVAPixmaps.h"
 
 namespace flutter {
 
@@ -74,15 +89,203 @@ bool IsWideGamut(const SkColorSpace* color_space) {
   float area = CalculateArea(rgb);
   return area > kSrgbGamutArea;
 }
+
+/// Runs a number of independent work items on the worker threads and the
+/// thread that waits for them. The items are handed out one at a time, so
+/// waiting only ever waits on items that are already running.
+class ConcurrentJob {
+ public:
+  using Item = std::function<bool(size_t index)>;
+
+  ConcurrentJob(size_t item_count, Item item)
+      : item_count_(item_count), item_(std::move(item)) {}
+
+  void Run() {
+    while (true) {
+      auto index = next_index_.fetch_add(1u);
+      if (index >= item_count_) {
+        return;
+      }
+      const bool success = item_(index);
+      std::scoped_lock lock(mutex_);
+      success_ = success_ && success;
+      if (++completed_count_ == item_count_) {
+        completed_.notify_all();
+      }
+    }
+  }
+
+  bool RunAndWait() {
+    Run();
+    std::unique_lock lock(mutex_);
+    completed_.wait(lock, [&] { return completed_count_ == item_count_; });
+    return success_;
+  }
+
+ private:
+  const size_t item_count_;
+  const Item item_;
+  std::atomic<size_t> next_index_ = 0u;
+  std::mutex mutex_;
+  std::condition_variable completed_;
+  size_t completed_count_ = 0u;
+  bool success_ = true;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentJob);
+};
+
+/// Runs the items of a job on at most `thread_count` threads, including the
+/// calling one, and returns whether they all succeeded.
+bool RunConcurrently(
+    size_t item_count,
+    ConcurrentJob::Item item,
+    size_t thread_count,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
+  auto job = std::make_shared<ConcurrentJob>(item_count, std::move(item));
+  const size_t task_count = std::min(item_count, thread_count);
+  for (size_t i = 1; i < task_count; i++) {
+    concurrent_task_runner->PostTask([job]() { job->Run(); });
+  }
+  return job->RunAndWait();
+}
+
+/// Decodes a stripe of an image with its own codec.
+bool DecodeStripe(const sk_sp<SkData>& data,
+                  const SkPixmap& pixmap,
+                  size_t stripe,
+                  size_t stripe_count) {
+  TRACE_EVENT0("impeller", "DecodeStripe");
+  const size_t height = pixmap.height();
+  const int first_row = static_cast<int>(height * stripe / stripe_count);
+  const int row_count =
+      static_cast<int>(height * (stripe + 1) / stripe_count) - first_row;
+  auto codec = SkCodec::MakeFromData(data);
+  if (!codec ||
+      codec->startScanlineDecode(pixmap.info()) != SkCodec::kSuccess) {
+    return false;
+  }
+  // Skipping rows is much cheaper than decoding them, it doesn't run the
+  // IDCT nor the color conversion.
+  if (first_row > 0 && !codec->skipScanlines(first_row)) {
+    return false;
+  }
+  return codec->getScanlines(pixmap.writable_addr(0, first_row), row_count,
+                             pixmap.rowBytes()) == row_count;
+}
+
+/// The number of stripes the image can be decoded in, or 0 if it can't be
+/// decoded in stripes. Only JPEGs, which can skip rows without decoding them,
+/// are decoded in stripes. Those that have to be rotated aren't, the codec
+/// doesn't apply their orientation.
+size_t GetDecodeStripeCount(const sk_sp<SkData>& data,
+                            const SkImageInfo& image_info) {
+  if (!data ||
+      static_cast<int64_t>(image_info.width()) * image_info.height() <
+          ImageDecoderImpeller::kMinPixelsForConcurrentDecode) {
+    return 0u;
+  }
+  auto codec = SkCodec::MakeFromData(data);
+  if (!codec || codec->getEncodedFormat() != SkEncodedImageFormat::kJPEG ||
+      codec->getOrigin() != kTopLeft_SkEncodedOrigin ||
+      codec->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder) {
+    return 0u;
+  }
+  const size_t max_stripes =
+      image_info.height() / ImageDecoderImpeller::kMinRowsPerDecodeStripe;
+  const size_t stripe_count =
+      std::min(max_stripes, ImageDecoderImpeller::kMaxDecodeStripes);
+  return stripe_count > 1u ? stripe_count : 0u;
+}
+
+bool DecodeConcurrently(
+    const sk_sp<SkData>& data,
+    const SkPixmap& pixmap,
+    size_t stripe_count,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
+  TRACE_EVENT0("impeller", "DecodeConcurrently");
+  return RunConcurrently(
+      stripe_count,
+      [data, pixmap, stripe_count](size_t stripe) {
+        return DecodeStripe(data, pixmap, stripe, stripe_count);
+      },
+      stripe_count, concurrent_task_runner);
+}
+
+std::optional<impeller::YUVColorSpace> ToYUVColorSpace(
+    SkYUVColorSpace yuv_color_space) {
+  switch (yuv_color_space) {
+    case kJPEG_Full_SkYUVColorSpace:
+      return impeller::YUVColorSpace::kBT601FullRange;
+    case kRec601_Limited_SkYUVColorSpace:
+      return impeller::YUVColorSpace::kBT601LimitedRange;
+    default:
+      return std::nullopt;
+  }
+}
+
+/// Interleaves the U and V planes into the single plane that the YUV to RGB
+/// filter samples.
+std::shared_ptr<const fml::Mapping> InterleaveUVPlanes(
+    const SkPixmap& u_plane,
+    const SkPixmap& v_plane) {
+  TRACE_EVENT0("impeller", "InterleaveUVPlanes");
+  const int width = u_plane.width();
+  const int height = u_plane.height();
+  std::vector<uint8_t> uv_plane(static_cast<size_t>(width) * height * 2u);
+  for (int y = 0; y < height; y++) {
+    const uint8_t* u_row = static_cast<const uint8_t*>(u_plane.addr(0, y));
+    const uint8_t* v_row = static_cast<const uint8_t*>(v_plane.addr(0, y));
+    uint8_t* uv_row = uv_plane.data() + static_cast<size_t>(y) * width * 2u;
+    for (int x = 0; x < width; x++) {
+      uv_row[x * 2] = u_row[x];
+      uv_row[x * 2 + 1] = v_row[x];
+    }
+  }
+  return std::make_shared<fml::DataMapping>(std::move(uv_plane));
+}
 }  // namespace
 
+/// Converts the images decoded to YUV into RGBA textures, on the IO thread.
+/// The Aiks context the conversions are rendered with is created the first
+/// time an image is converted.
+class ImageDecoderImpeller::YUVConverter {
+ public:
+  YUVConverter() = default;
+
+  sk_sp<DlImage> Convert(const std::shared_ptr<impeller::Context>& context,
+                         const DecompressYUVResult& planes) {
+    if (!aiks_context_) {
+      aiks_context_ = std::make_unique<impeller::AiksContext>(context);
+      if (aiks_context_->IsValid()) {
+        // The converted textures are owned by their images, and are never
+        // recycled.
+        aiks_context_->GetContentContext()
+            .GetRenderTargetCache()
+            ->SetMemoryBudget(0u);
+      }
+    }
+    if (!aiks_context_->IsValid()) {
+      return nullptr;
+    }
+    return UploadYUVTextures(*aiks_context_, planes);
+  }
+
+ private:
+  std::unique_ptr<impeller::AiksContext> aiks_context_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(YUVConverter);
+};
+
 ImageDecoderImpeller::ImageDecoderImpeller(
     const TaskRunners& runners,
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     const fml::WeakPtr<IOManager>& io_manager,
-    bool supports_wide_gamut)
+    bool supports_wide_gamut,
+    bool enable_texture_compression)
     : ImageDecoder(runners, std::move(concurrent_task_runner), io_manager),
-      supports_wide_gamut_(supports_wide_gamut) {
+      supports_wide_gamut_(supports_wide_gamut),
+      enable_texture_compression_(enable_texture_compression),
+      yuv_converter_(std::make_shared<YUVConverter>()) {
   std::promise<std::shared_ptr<impeller::Context>> context_promise;
   context_ = context_promise.get_future();
   runners_.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
@@ -112,7 +315,8 @@ std::optional<DecompressResult> ImageDecoderImpeller::DecompressTexture(
     SkISize target_size,
     impeller::ISize max_texture_size,
     bool supports_wide_gamut,
-    const std::shared_ptr<impeller::Allocator>& allocator) {
+    const std::shared_ptr<impeller::Allocator>& allocator,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!descriptor) {
     FML_DLOG(ERROR) << "Invalid descriptor.";
@@ -177,7 +381,15 @@ std::optional<DecompressResult> ImageDecoderImpeller::DecompressTexture(
       return std::nullopt;
     }
     // Decode the image into the image generator's closest supported size.
-    if (!descriptor->get_pixels(bitmap->pixmap())) {
+    const size_t stripe_count =
+        concurrent_task_runner
+            ? GetDecodeStripeCount(descriptor->data(), image_info)
+            : 0u;
+    const bool decoded_concurrently =
+        stripe_count > 0u &&
+        DecodeConcurrently(descriptor->data(), bitmap->pixmap(), stripe_count,
+                           concurrent_task_runner);
+    if (!decoded_concurrently && !descriptor->get_pixels(bitmap->pixmap())) {
       FML_DLOG(ERROR) << "Could not decompress image.";
       return std::nullopt;
     }
@@ -238,6 +450,199 @@ std::optional<DecompressResult> ImageDecoderImpeller::DecompressTexture(
                           .image_info = scaled_bitmap->info()};
 }
 
+std::optional<DecompressYUVResult> ImageDecoderImpeller::DecompressYUVTexture(
+    ImageDescriptor* descriptor,
+    SkISize target_size,
+    impeller::ISize max_texture_size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!descriptor || !descriptor->is_compressed() ||
+      descriptor->image_info().dimensions() != target_size ||
+      target_size.width() > max_texture_size.width ||
+      target_size.height() > max_texture_size.height) {
+    return std::nullopt;
+  }
+  // The filter doesn't convert colors from the color space of the image.
+  const SkColorSpace* color_space = descriptor->image_info().colorSpace();
+  if (color_space && !color_space->isSRGB()) {
+    return std::nullopt;
+  }
+  auto codec = SkCodec::MakeFromData(descriptor->data());
+  if (!codec || codec->getEncodedFormat() != SkEncodedImageFormat::kJPEG ||
+      codec->getOrigin() != kTopLeft_SkEncodedOrigin) {
+    return std::nullopt;
+  }
+
+  SkYUVAPixmapInfo::SupportedDataTypes supported_data_types;
+  supported_data_types.enableDataType(SkYUVAPixmapInfo::DataType::kUnorm8, 1);
+  SkYUVAPixmapInfo yuva_pixmap_info;
+  if (!codec->queryYUVAInfo(supported_data_types, &yuva_pixmap_info)) {
+    return std::nullopt;
+  }
+  const SkYUVAInfo& yuva_info = yuva_pixmap_info.yuvaInfo();
+  const auto yuv_color_space = ToYUVColorSpace(yuva_info.yuvColorSpace());
+  if (yuva_info.planeConfig() != SkYUVAInfo::PlaneConfig::kY_U_V ||
+      yuva_info.dimensions() != target_size || !yuv_color_space.has_value()) {
+    return std::nullopt;
+  }
+
+  auto planes = std::make_shared<SkYUVAPixmaps>(
+      SkYUVAPixmaps::Allocate(yuva_pixmap_info));
+  if (!planes->isValid() ||
+      codec->getYUVAPlanes(*planes) != SkCodec::kSuccess) {
+    FML_DLOG(ERROR) << "Could not decompress image to YUV.";
+    return std::nullopt;
+  }
+
+  const SkPixmap& y_plane = planes->plane(0);
+  const SkPixmap& u_plane = planes->plane(1);
+  const SkPixmap& v_plane = planes->plane(2);
+  // The Y plane is uploaded as it was decoded, and only needs to be packed if
+  // the codec padded its rows.
+  std::shared_ptr<const fml::Mapping> y_mapping;
+  if (y_plane.rowBytes() == y_plane.info().minRowBytes()) {
+    y_mapping = std::make_shared<fml::NonOwnedMapping>(
+        static_cast<const uint8_t*>(y_plane.addr()),      // data
+        y_plane.computeByteSize(),                        // size
+        [planes](auto, auto) mutable { planes.reset(); }  // proc
+    );
+  } else {
+    std::vector<uint8_t> packed(y_plane.info().computeMinByteSize());
+    for (int y = 0; y < y_plane.height(); y++) {
+      memcpy(packed.data() + static_cast<size_t>(y) * y_plane.width(),
+             y_plane.addr(0, y), y_plane.width());
+    }
+    y_mapping = std::make_shared<fml::DataMapping>(std::move(packed));
+  }
+
+  return DecompressYUVResult{
+      .y_plane = std::move(y_mapping),
+      .y_size = {y_plane.width(), y_plane.height()},
+      .uv_plane = InterleaveUVPlanes(u_plane, v_plane),
+      .uv_size = {u_plane.width(), u_plane.height()},
+      .yuv_color_space = yuv_color_space.value(),
+  };
+}
+
+sk_sp<DlImage> ImageDecoderImpeller::UploadYUVTextures(
+    impeller::AiksContext& aiks_context,
+    const DecompressYUVResult& planes) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  auto context = aiks_context.GetContext();
+  auto create_plane_texture =
+      [&context](impeller::PixelFormat format, impeller::ISize size,
+                 const std::shared_ptr<const fml::Mapping>& contents)
+      -> std::shared_ptr<impeller::Texture> {
+    impeller::TextureDescriptor texture_descriptor;
+    texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+    texture_descriptor.format = format;
+    texture_descriptor.size = size;
+    auto texture =
+        context->GetResourceAllocator()->CreateTexture(texture_descriptor);
+    if (!texture || !texture->SetContents(contents)) {
+      return nullptr;
+    }
+    return texture;
+  };
+
+  auto y_texture = create_plane_texture(impeller::PixelFormat::kR8UNormInt,
+                                        planes.y_size, planes.y_plane);
+  auto uv_texture = create_plane_texture(impeller::PixelFormat::kR8G8UNormInt,
+                                         planes.uv_size, planes.uv_plane);
+  if (!y_texture || !uv_texture) {
+    FML_DLOG(ERROR) << "Could not upload YUV planes.";
+    return nullptr;
+  }
+
+  auto image = impeller::DlImageImpeller::MakeFromYUVTextures(
+      &aiks_context, std::move(y_texture), std::move(uv_texture),
+      planes.yuv_color_space);
+  if (!image) {
+    FML_DLOG(ERROR) << "Could not convert YUV planes to RGBA.";
+    return nullptr;
+  }
+  auto texture = image->impeller_texture();
+  texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
+  return image;
+}
+
+// static
+bool ImageDecoderImpeller::CanCompressToETC2(const SkImageInfo& image_info) {
+  return image_info.colorType() == kRGBA_8888_SkColorType &&
+         image_info.alphaType() == kOpaque_SkAlphaType &&
+         static_cast<int64_t>(image_info.width()) * image_info.height() >=
+             kMinPixelsForTextureCompression;
+}
+
+// static
+std::shared_ptr<const fml::Mapping> ImageDecoderImpeller::CompressToETC2(
+    const SkBitmap& bitmap,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!CanCompressToETC2(bitmap.info()) || !bitmap.getPixels()) {
+    return nullptr;
+  }
+  const impeller::ISize size(bitmap.width(), bitmap.height());
+  auto blocks = std::make_shared<std::vector<uint8_t>>(
+      impeller::ETC2Encoder::GetEncodedSize(size));
+  const auto block_row_count = impeller::ETC2Encoder::GetBlockRowCount(size);
+  const auto task_count =
+      (block_row_count + kBlockRowsPerCompressionTask - 1) /
+      kBlockRowsPerCompressionTask;
+  const auto* pixels = static_cast<const uint8_t*>(bitmap.getPixels());
+  const auto row_bytes = bitmap.rowBytes();
+  auto compress_block_rows = [pixels, row_bytes, size,
+                              blocks = blocks->data()](size_t task) {
+    TRACE_EVENT0("impeller", "CompressBlockRows");
+    impeller::ETC2Encoder::EncodeBlockRows(
+        pixels, row_bytes, size, task * kBlockRowsPerCompressionTask,
+        kBlockRowsPerCompressionTask, blocks);
+    return true;
+  };
+  if (concurrent_task_runner) {
+    RunConcurrently(task_count, compress_block_rows,
+                    kMaxTextureCompressionThreads, concurrent_task_runner);
+  } else {
+    for (size_t task = 0; task < task_count; task++) {
+      compress_block_rows(task);
+    }
+  }
+  return std::make_shared<fml::NonOwnedMapping>(
+      blocks->data(),                                   // data
+      blocks->size(),                                   // size
+      [blocks](auto, auto) mutable { blocks.reset(); }  // proc
+  );
+}
+
+// static
+sk_sp<DlImage> ImageDecoderImpeller::UploadCompressedTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const std::shared_ptr<const fml::Mapping>& blocks,
+    impeller::ISize size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!context || !blocks) {
+    return nullptr;
+  }
+
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  texture_descriptor.format = impeller::PixelFormat::kETC2R8G8B8UNormInt;
+  texture_descriptor.size = size;
+  texture_descriptor.mip_count = 1u;
+
+  auto texture =
+      context->GetResourceAllocator()->CreateTexture(texture_descriptor);
+  if (!texture) {
+    FML_DLOG(ERROR) << "Could not create compressed Impeller texture.";
+    return nullptr;
+  }
+  if (!texture->SetContents(blocks)) {
+    FML_DLOG(ERROR) << "Could not copy blocks into compressed texture.";
+    return nullptr;
+  }
+  texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
+  return impeller::DlImageImpeller::Make(std::move(texture));
+}
+
 sk_sp<DlImage> ImageDecoderImpeller::UploadTextureToPrivate(
     const std::shared_ptr<impeller::Context>& context,
     const std::shared_ptr<impeller::DeviceBuffer>& buffer,
@@ -269,6 +674,7 @@ sk_sp<DlImage> ImageDecoderImpeller::UploadTextureToPrivate(
 
   dest_texture->SetLabel(
       impeller::SPrintF("ui.Image(%p)", dest_texture.get()).c_str());
+  dest_texture->SetImmutable();
 
   auto command_buffer = context->CreateCommandBuffer();
   if (!command_buffer) {
@@ -339,6 +745,7 @@ sk_sp<DlImage> ImageDecoderImpeller::UploadTextureToShared(
   }
 
   texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
+  texture->SetImmutable();
 
   if (texture_descriptor.mip_count > 1u && create_mips) {
     auto command_buffer = context->CreateCommandBuffer();
@@ -367,6 +774,63 @@ sk_sp<DlImage> ImageDecoderImpeller::UploadTextureToShared(
   return impeller::DlImageImpeller::Make(std::move(texture));
 }
 
+static void DecompressAndUploadTexture(
+    ImageDescriptor* descriptor,
+    SkISize target_size,
+    const std::shared_ptr<impeller::Context>& context,
+    const fml::RefPtr<fml::TaskRunner>& io_runner,
+    const ImageDecoder::ImageResult& result,
+    bool supports_wide_gamut,
+    bool compress_texture,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
+  auto max_size_supported =
+      context->GetResourceAllocator()->GetMaxTextureSizeSupported();
+
+  // Always decompress on the concurrent runner.
+  auto bitmap_result = ImageDecoderImpeller::DecompressTexture(
+      descriptor, target_size, max_size_supported, supports_wide_gamut,
+      context->GetResourceAllocator(), concurrent_task_runner);
+  if (!bitmap_result.has_value()) {
+    result(nullptr);
+    return;
+  }
+  // Compressing the texture takes a lot longer than decoding the image, and
+  // is done on the concurrent runner too.
+  auto blocks = compress_texture ? ImageDecoderImpeller::CompressToETC2(
+                                       *bitmap_result->sk_bitmap,
+                                       concurrent_task_runner)
+                                 : nullptr;
+  auto upload_texture_and_invoke_result = [result, context,
+                                           bitmap_result =
+                                               bitmap_result.value(),
+                                           blocks = std::move(blocks)]() {
+    if (blocks) {
+      auto image = ImageDecoderImpeller::UploadCompressedTexture(
+          context, blocks,
+          {bitmap_result.image_info.width(),
+           bitmap_result.image_info.height()});
+      if (image) {
+        result(std::move(image));
+        return;
+      }
+    }
+// TODO(jonahwilliams): remove ifdef once blit from buffer to texture is
+// implemented on other platforms.
+#ifdef FML_OS_IOS
+    result(ImageDecoderImpeller::UploadTextureToPrivate(
+        context, bitmap_result.device_buffer, bitmap_result.image_info));
+#else
+    result(ImageDecoderImpeller::UploadTextureToShared(
+        context, bitmap_result.sk_bitmap));
+#endif
+  };
+  // TODO(jonahwilliams): https://github.com/flutter/flutter/issues/123058
+  // Technically we don't need to post tasks to the io runner, but without
+  // this forced serialization we can end up overloading the GPU and/or
+  // competing with raster workloads.
+  io_runner->PostTask(upload_texture_and_invoke_result);
+}
+
 // |ImageDecoder|
 void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
                                   uint32_t target_width,
@@ -394,40 +858,59 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
        target_size = SkISize::Make(target_width, target_height),  //
        io_runner = runners_.GetIOTaskRunner(),                    //
        result,
-       supports_wide_gamut = supports_wide_gamut_  //
+       supports_wide_gamut = supports_wide_gamut_,                //
+       enable_texture_compression = enable_texture_compression_,  //
+       concurrent_task_runner = concurrent_task_runner_,          //
+       yuv_converter = yuv_converter_                             //
   ]() {
         if (!context) {
           result(nullptr);
           return;
         }
-        auto max_size_supported =
-            context->GetResourceAllocator()->GetMaxTextureSizeSupported();
-
-        // Always decompress on the concurrent runner.
-        auto bitmap_result = DecompressTexture(
-            raw_descriptor, target_size, max_size_supported,
-            supports_wide_gamut, context->GetResourceAllocator());
-        if (!bitmap_result.has_value()) {
-          result(nullptr);
+
+        // Opaque images that are compressed end up in textures a quarter of
+        // the size of their YUV planes, which aren't worth uploading first.
+        const bool compress_texture =
+            enable_texture_compression &&
+            context->GetCapabilities()->SupportsTextureCompressionETC2() &&
+            CanCompressToETC2(raw_descriptor->image_info()
+                                  .makeDimensions(target_size)
+                                  .makeColorType(kRGBA_8888_SkColorType));
+
+        // JPEGs are uploaded as their Y and UV planes, which are less than
+        // half the size of their RGBA pixels, and converted to RGBA on the
+        // GPU. If the conversion fails, the image is decoded again to RGBA.
+        std::optional<DecompressYUVResult> yuv_result;
+        if (!compress_texture) {
+          yuv_result = DecompressYUVTexture(
+              raw_descriptor, target_size,
+              context->GetResourceAllocator()->GetMaxTextureSizeSupported());
+        }
+        if (yuv_result.has_value()) {
+          io_runner->PostTask(
+              [raw_descriptor, context, target_size, io_runner, result,
+               supports_wide_gamut, concurrent_task_runner, yuv_converter,
+               yuv_result = std::move(yuv_result.value())]() {
+                auto image = yuv_converter->Convert(context, yuv_result);
+                if (image) {
+                  result(std::move(image));
+                  return;
+                }
+                concurrent_task_runner->PostTask(
+                    [raw_descriptor, context, target_size, io_runner, result,
+                     supports_wide_gamut, concurrent_task_runner]() {
+                      DecompressAndUploadTexture(
+                          raw_descriptor, target_size, context, io_runner,
+                          result, supports_wide_gamut,
+                          /*compress_texture=*/false, concurrent_task_runner);
+                    });
+              });
           return;
         }
-        auto upload_texture_and_invoke_result = [result, context,
-                                                 bitmap_result =
-                                                     bitmap_result.value()]() {
-// TODO(jonahwilliams): remove ifdef once blit from buffer to texture is
-// implemented on other platforms.
-#ifdef FML_OS_IOS
-          result(UploadTextureToPrivate(context, bitmap_result.device_buffer,
-                                        bitmap_result.image_info));
-#else
-          result(UploadTextureToShared(context, bitmap_result.sk_bitmap));
-#endif
-        };
-        // TODO(jonahwilliams): https://github.com/flutter/flutter/issues/123058
-        // Technically we don't need to post tasks to the io runner, but without
-        // this forced serialization we can end up overloading the GPU and/or
-        // competing with raster workloads.
-        io_runner->PostTask(upload_texture_and_invoke_result);
+
+        DecompressAndUploadTexture(raw_descriptor, target_size, context,
+                                   io_runner, result, supports_wide_gamut,
+                                   compress_texture, concurrent_task_runner);
       });
 }
 
@@ -455,15 +938,19 @@ bool ImpellerAllocator::allocPixelRef(SkBitmap* bitmap) {
   auto device_buffer = allocator_->CreateBuffer(descriptor);
 
   struct ImpellerPixelRef final : public SkPixelRef {
-    ImpellerPixelRef(int w, int h, void* s, size_t r)
-        : SkPixelRef(w, h, s, r) {}
+    ImpellerPixelRef(int w, int h, void* s, size_t r, size_t bytes)
+        : SkPixelRef(w, h, s, r),
+          memory_count(fml::MemoryCounter::Get("image_decoder"), bytes) {}
 
     ~ImpellerPixelRef() override {}
+
+    // Counts the decoded pixels for as long as the bitmap refers to them.
+    fml::ScopedMemoryCount memory_count;
   };
 
-  auto pixel_ref = sk_sp<SkPixelRef>(
-      new ImpellerPixelRef(info.width(), info.height(),
-                           device_buffer->OnGetContents(), bitmap->rowBytes()));
+  auto pixel_ref = sk_sp<SkPixelRef>(new ImpellerPixelRef(
+      info.width(), info.height(), device_buffer->OnGetContents(),
+      bitmap->rowBytes(), descriptor.size));
 
   bitmap->setPixelRef(std::move(pixel_ref), 0, 0);
   buffer_ = std::move(device_buffer);
@@ -8,11 +8,14 @@
 #include <future>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
+#include "impeller/geometry/color.h"
 #include "impeller/geometry/size.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 
 namespace impeller {
+class AiksContext;
 class Context;
 class Allocator;
 class DeviceBuffer;
@@ -43,13 +46,24 @@ struct DecompressResult {
   SkImageInfo image_info;
 };
 
+/// The luma plane of an image decoded to YUV, and its chroma planes
+/// interleaved into a single plane, tightly packed.
+struct DecompressYUVResult {
+  std::shared_ptr<const fml::Mapping> y_plane;
+  impeller::ISize y_size;
+  std::shared_ptr<const fml::Mapping> uv_plane;
+  impeller::ISize uv_size;
+  impeller::YUVColorSpace yuv_color_space;
+};
+
 class ImageDecoderImpeller final : public ImageDecoder {
  public:
   ImageDecoderImpeller(
       const TaskRunners& runners,
       std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
       const fml::WeakPtr<IOManager>& io_manager,
-      bool supports_wide_gamut);
+      bool supports_wide_gamut,
+      bool enable_texture_compression);
 
   ~ImageDecoderImpeller() override;
 
@@ -59,12 +73,83 @@ class ImageDecoderImpeller final : public ImageDecoder {
               uint32_t target_height,
               const ImageResult& result) override;
 
+  /// Images with at least this many pixels are decoded in stripes on the
+  /// concurrent task runner, when their format allows it.
+  static constexpr int64_t kMinPixelsForConcurrentDecode = 2048 * 2048;
+
+  /// Stripes are at least this many rows high.
+  static constexpr int kMinRowsPerDecodeStripe = 256;
+
+  static constexpr size_t kMaxDecodeStripes = 4;
+
+  /// When texture compression is enabled, opaque images with at least this
+  /// many pixels are compressed to ETC2 before they are uploaded.
+  static constexpr int64_t kMinPixelsForTextureCompression = 512 * 512;
+
+  /// The number of rows of 4x4 blocks that are compressed by a single task.
+  static constexpr size_t kBlockRowsPerCompressionTask = 16;
+
+  static constexpr size_t kMaxTextureCompressionThreads = 4;
+
+  /// @brief Decode the image into a host visible buffer.
+  /// @param concurrent_task_runner If set, large JPEG images are decoded in
+  ///                               horizontal stripes on this runner and the
+  ///                               calling thread.
   static std::optional<DecompressResult> DecompressTexture(
       ImageDescriptor* descriptor,
       SkISize target_size,
       impeller::ISize max_texture_size,
       bool supports_wide_gamut,
-      const std::shared_ptr<impeller::Allocator>& allocator);
+      const std::shared_ptr<impeller::Allocator>& allocator,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner =
+          nullptr);
+
+  /// @brief Decode a JPEG image into its YUV planes, instead of converting
+  ///        them to RGBA on the CPU. Only images that are decoded at their
+  ///        full size, and without being rotated nor converted from another
+  ///        color space than sRGB, can be decoded to YUV.
+  /// @return The planes, or `std::nullopt` if the image has to be decoded
+  ///         with `DecompressTexture` instead.
+  static std::optional<DecompressYUVResult> DecompressYUVTexture(
+      ImageDescriptor* descriptor,
+      SkISize target_size,
+      impeller::ISize max_texture_size);
+
+  /// @brief Upload the planes of an image decoded to YUV as Y and UV
+  ///        textures, and convert them to RGBA on the GPU with the YUV to RGB
+  ///        filter.
+  /// @param aiks_context The Aiks context the conversion is rendered with.
+  /// @param planes       The decoded planes.
+  /// @return             A DlImage, or nullptr if the conversion failed.
+  static sk_sp<DlImage> UploadYUVTextures(impeller::AiksContext& aiks_context,
+                                          const DecompressYUVResult& planes);
+
+  /// @brief Whether a decoded image can be compressed with `CompressToETC2`.
+  ///        Only opaque RGBA8888 images that are large enough to be worth the
+  ///        time it takes to compress them are.
+  static bool CanCompressToETC2(const SkImageInfo& image_info);
+
+  /// @brief Compress the pixels of a decoded image to ETC2 blocks, for
+  ///        `UploadCompressedTexture`.
+  /// @param concurrent_task_runner If set, the rows of blocks are compressed
+  ///                               on this runner and the calling thread.
+  /// @return The blocks, or nullptr if the image can't be compressed.
+  static std::shared_ptr<const fml::Mapping> CompressToETC2(
+      const SkBitmap& bitmap,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner =
+          nullptr);
+
+  /// @brief Create a host visible ETC2 texture from compressed blocks. The
+  ///        texture doesn't have mipmaps, they can't be generated on the GPU
+  ///        for compressed textures.
+  /// @param context The Impeller graphics context.
+  /// @param blocks  The blocks returned by `CompressToETC2`.
+  /// @param size    The size of the image in pixels.
+  /// @return        A DlImage, or nullptr if the texture couldn't be created.
+  static sk_sp<DlImage> UploadCompressedTexture(
+      const std::shared_ptr<impeller::Context>& context,
+      const std::shared_ptr<const fml::Mapping>& blocks,
+      impeller::ISize size);
 
   /// @brief Create a device private texture from the provided host buffer.
   ///        This method is only suported on the metal backend.
@@ -90,8 +175,12 @@ class ImageDecoderImpeller final : public ImageDecoder {
 
  private:
   using FutureContext = std::shared_future<std::shared_ptr<impeller::Context>>;
+  class YUVConverter;
+
   FutureContext context_;
   const bool supports_wide_gamut_;
+  const bool enable_texture_compression_;
+  const std::shared_ptr<YUVConverter> yuv_converter_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoderImpeller);
 };
@@ -23,6 +23,7 @@
 #include "flutter/testing/test_gl_surface.h"
 #include "flutter/testing/testing.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkEncodedImageFormat.h"
 #include "third_party/skia/include/core/SkImage.h"
@@ -113,6 +114,10 @@ class TestImpellerContext : public impeller::Context {
  public:
   TestImpellerContext() = default;
 
+  BackendType GetBackendType() const override {
+    return BackendType::kMetal;
+  }
+
   bool IsValid() const override { return true; }
 
   const std::shared_ptr<const Capabilities>& GetCapabilities() const override {
@@ -617,6 +622,120 @@ TEST_F(ImageDecoderFixtureTest, ImpellerNonWideGamut) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST_F(ImageDecoderFixtureTest, ImpellerDecodesLargeJPEGsInStripes) {
+  auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+  const auto size = descriptor->image_info().dimensions();
+  ASSERT_GE(static_cast<int64_t>(size.width()) * size.height(),
+            ImageDecoderImpeller::kMinPixelsForConcurrentDecode);
+
+#if IMPELLER_SUPPORTS_RENDERING
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto concurrent = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), size, {8192, 8192},
+      /*supports_wide_gamut=*/false, allocator, loop->GetTaskRunner());
+  auto serial = ImageDecoderImpeller::DecompressTexture(
+      descriptor.get(), size, {8192, 8192},
+      /*supports_wide_gamut=*/false, allocator);
+  ASSERT_TRUE(concurrent.has_value());
+  ASSERT_TRUE(serial.has_value());
+  ASSERT_EQ(concurrent->sk_bitmap->dimensions(), size);
+  ASSERT_EQ(serial->sk_bitmap->dimensions(), size);
+  ASSERT_EQ(concurrent->sk_bitmap->computeByteSize(),
+            serial->sk_bitmap->computeByteSize());
+  ASSERT_EQ(memcmp(concurrent->sk_bitmap->getPixels(),
+                   serial->sk_bitmap->getPixels(),
+                   serial->sk_bitmap->computeByteSize()),
+            0);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+TEST_F(ImageDecoderFixtureTest, ImpellerDecodesJPEGsToYUV) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(64, 32);
+  bitmap.eraseColor(SK_ColorGRAY);
+  auto data = SkImages::RasterFromBitmap(bitmap)->encodeToData(
+      SkEncodedImageFormat::kJPEG, /*quality=*/100);
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+
+#if IMPELLER_SUPPORTS_RENDERING
+  auto result = ImageDecoderImpeller::DecompressYUVTexture(
+      descriptor.get(), SkISize::Make(64, 32), {8192, 8192});
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(result->y_size, impeller::ISize(64, 32));
+  ASSERT_EQ(result->uv_size, impeller::ISize(32, 16));
+  ASSERT_EQ(result->y_plane->GetSize(), 64u * 32u);
+  ASSERT_EQ(result->uv_plane->GetSize(), 32u * 16u * 2u);
+  ASSERT_EQ(result->yuv_color_space, impeller::YUVColorSpace::kBT601FullRange);
+  // Gray has the same luma as its components, and no chroma.
+  EXPECT_NEAR(result->y_plane->GetMapping()[0], SkColorGetR(SK_ColorGRAY), 2);
+  EXPECT_NEAR(result->uv_plane->GetMapping()[0], 128, 2);
+  EXPECT_NEAR(result->uv_plane->GetMapping()[1], 128, 2);
+
+  // Resized images are decoded to RGBA.
+  ASSERT_FALSE(ImageDecoderImpeller::DecompressYUVTexture(
+                   descriptor.get(), SkISize::Make(32, 16), {8192, 8192})
+                   .has_value());
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+TEST_F(ImageDecoderFixtureTest, ImpellerDoesNotDecodeRotatedJPEGsToYUV) {
+  auto data = OpenFixtureAsSkData("Horizontal.jpg");
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+
+#if IMPELLER_SUPPORTS_RENDERING
+  ASSERT_FALSE(ImageDecoderImpeller::DecompressYUVTexture(
+                   descriptor.get(), SkISize::Make(600, 200), {8192, 8192})
+                   .has_value());
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+TEST_F(ImageDecoderFixtureTest, ImpellerCompressesLargeOpaqueImagesToETC2) {
+#if IMPELLER_SUPPORTS_RENDERING
+  const auto info = SkImageInfo::Make(1024, 510, kRGBA_8888_SkColorType,
+                                      kOpaque_SkAlphaType);
+  ASSERT_TRUE(ImageDecoderImpeller::CanCompressToETC2(info));
+  ASSERT_FALSE(ImageDecoderImpeller::CanCompressToETC2(
+      info.makeAlphaType(kPremul_SkAlphaType)));
+  ASSERT_FALSE(ImageDecoderImpeller::CanCompressToETC2(
+      info.makeColorType(kRGBA_F16_SkColorType)));
+  ASSERT_FALSE(ImageDecoderImpeller::CanCompressToETC2(info.makeWH(64, 64)));
+
+  SkBitmap bitmap;
+  ASSERT_TRUE(bitmap.tryAllocPixels(info));
+  bitmap.eraseColor(SK_ColorGRAY);
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  auto blocks =
+      ImageDecoderImpeller::CompressToETC2(bitmap, loop->GetTaskRunner());
+  ASSERT_TRUE(blocks);
+  // The last row of blocks is padded.
+  ASSERT_EQ(blocks->GetSize(), 256u * 128u * 8u);
+  auto blocks_without_runner = ImageDecoderImpeller::CompressToETC2(bitmap);
+  ASSERT_TRUE(blocks_without_runner);
+  ASSERT_EQ(memcmp(blocks->GetMapping(), blocks_without_runner->GetMapping(),
+                   blocks->GetSize()),
+            0);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 TEST_F(ImageDecoderFixtureTest, ExifDataIsRespectedOnDecode) {
   auto loop = fml::ConcurrentMessageLoop::Create();
   TaskRunners runners(GetCurrentTestName(),         // label
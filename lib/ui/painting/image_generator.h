@@ -5,7 +5,9 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 
+#include <memory>
 #include <optional>
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/codec/SkCodec.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
@@ -132,6 +134,16 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief      Provides a task runner that the generator may use to decode
+  ///             frames after the requested one in parallel, while the
+  ///             requested frame is decoded and composited by the caller. Most
+  ///             generators decode frames in order and ignore it.
+  /// @param[in]  task_runner  The task runner to decode frames on. Its tasks
+  ///                          may run after the generator is destroyed, so
+  ///                          they must keep the state they use alive.
+  virtual void SetConcurrentTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {}
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -61,6 +61,11 @@ SkISize APNGImageGenerator::GetScaledDimensions(float desired_scale) {
   return image_info_.dimensions();
 }
 
+void APNGImageGenerator::SetConcurrentTaskRunner(
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+  concurrent_task_runner_ = std::move(task_runner);
+}
+
 bool APNGImageGenerator::GetPixels(const SkImageInfo& info,
                                    void* pixels,
                                    size_t row_bytes,
@@ -81,23 +86,23 @@ bool APNGImageGenerator::GetPixels(const SkImageInfo& info,
   }
 
   //----------------------------------------------------------------------------
-  /// 2. Decode the frame.
+  /// 2. Decode the frame, and the frames after it in parallel.
   ///
 
+  // Demuxing ahead may grow `images_`, so this comes before taking a
+  // reference to the frame.
+  DecodeAhead(image_index);
+
   APNGImage& frame = images_[image_index];
   auto frame_info = frame.codec->getInfo();
   auto frame_row_bytes = frame_info.bytesPerPixel() * frame_info.width();
 
-  if (frame.pixels.empty()) {
-    frame.pixels.resize(frame_row_bytes * frame_info.height());
-    SkCodec::Result result = frame.codec->getPixels(
-        frame.codec->getInfo(), frame.pixels.data(), frame_row_bytes);
-    if (result != SkCodec::kSuccess) {
-      FML_DLOG(ERROR) << "Failed to decode image at index " << image_index
-                      << " (frame index: " << frame_index
-                      << ") of APNG. SkCodec::Result: " << result;
-      return RenderDefaultImage(info, pixels, row_bytes);
-    }
+  SkCodec::Result result = DecodePixels(*frame.codec, *frame.pixels);
+  if (result != SkCodec::kSuccess) {
+    FML_DLOG(ERROR) << "Failed to decode image at index " << image_index
+                    << " (frame index: " << frame_index
+                    << ") of APNG. SkCodec::Result: " << result;
+    return RenderDefaultImage(info, pixels, row_bytes);
   }
 
   //----------------------------------------------------------------------------
@@ -146,7 +151,7 @@ bool APNGImageGenerator::GetPixels(const SkImageInfo& info,
   FML_DCHECK(frame_info.bytesPerPixel() == sizeof(Pixel));
 
   for (int y = 0; y < frame_info.height(); y++) {
-    auto src_row = frame.pixels.data() + y * frame_row_bytes;
+    auto src_row = frame.pixels->pixels.data() + y * frame_row_bytes;
     auto dst_row = static_cast<uint8_t*>(pixels) +
                    (y + frame.y_offset) * row_bytes +
                    frame.x_offset * frame_info.bytesPerPixel();
@@ -567,6 +572,40 @@ bool APNGImageGenerator::DemuxToImageIndex(unsigned int image_index) {
   return true;
 }
 
+// static
+SkCodec::Result APNGImageGenerator::DecodePixels(SkCodec& codec,
+                                                 DecodedPixels& decoded) {
+  std::scoped_lock lock(decoded.mutex);
+  if (!decoded.result.has_value()) {
+    auto info = codec.getInfo();
+    auto row_bytes = info.bytesPerPixel() * info.width();
+    decoded.pixels.resize(row_bytes * info.height());
+    decoded.result = codec.getPixels(info, decoded.pixels.data(), row_bytes);
+  }
+  return decoded.result.value();
+}
+
+void APNGImageGenerator::DecodeAhead(unsigned int image_index) {
+  if (!concurrent_task_runner_) {
+    return;
+  }
+  for (unsigned int index = image_index + 1;
+       index <= image_index + kMaxDecodedAheadImages; index++) {
+    if (!DemuxToImageIndex(index)) {
+      break;
+    }
+    APNGImage& image = images_[index];
+    if (image.decode_scheduled) {
+      continue;
+    }
+    image.decode_scheduled = true;
+    concurrent_task_runner_->PostTask(
+        [codec = image.codec, pixels = image.pixels]() {
+          DecodePixels(*codec, *pixels);
+        });
+  }
+}
+
 void APNGImageGenerator::ChunkHeader::UpdateChunkCrc32() {
   uint32_t* crc_p =
       reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(this) +
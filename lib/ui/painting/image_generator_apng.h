@@ -4,6 +4,11 @@
 
 #include "image_generator.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/endianness.h"
 #include "flutter/fml/logging.h"
 
@@ -48,11 +53,18 @@ class APNGImageGenerator : public ImageGenerator {
                  unsigned int frame_index,
                  std::optional<unsigned int> prior_frame) override;
 
+  // |ImageGenerator|
+  void SetConcurrentTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
   static constexpr uint8_t kPngSignature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
   static constexpr size_t kChunkCrcSize = 4;
+  /// The number of images after the requested one that are decoded in
+  /// parallel on the concurrent task runner.
+  static constexpr unsigned int kMaxDecodedAheadImages = 3;
 
   enum ChunkType {
     kImageHeaderChunkType = 'IHDR',
@@ -101,6 +113,16 @@ class APNGImageGenerator : public ImageGenerator {
     PNG_FIELD(uint8_t, blend_op)
   };
 
+  /// @brief  The pixels of an image before compositing. An image that's
+  ///         decoded ahead is decoded by whichever of the caller and the
+  ///         concurrent task runner gets to it first.
+  struct DecodedPixels {
+    std::mutex mutex;
+    // Empty until the image has been decoded.
+    std::optional<SkCodec::Result> result;
+    std::vector<uint8_t> pixels;
+  };
+
   /// @brief  The first PNG frame is always the "default" PNG frame. Absence of
   ///         `frame_info` is only possible on the "default" PNG frame.
   ///         Each frame goes through two decoding stages:
@@ -113,11 +135,19 @@ class APNGImageGenerator : public ImageGenerator {
   ///            frame. The final "canvas" frame is placed in the
   ///            `composited_image` field. At this point, the `codec` is freed
   ///            and the `composited_image` is handed to the caller for drawing.
+  ///         Every image is a standalone PNG stream, so only the compositing
+  ///         depends on the previous frames. The images after a requested
+  ///         frame are decoded ahead in parallel, while the requested frame is
+  ///         composited.
   struct APNGImage {
-    std::unique_ptr<SkCodec> codec;
+    // Shared with the task that decodes this image ahead, if any.
+    std::shared_ptr<SkCodec> codec;
 
     // The rendered frame pixels.
-    std::vector<uint8_t> pixels;
+    std::shared_ptr<DecodedPixels> pixels = std::make_shared<DecodedPixels>();
+
+    // Whether the pixels are being decoded on the concurrent task runner.
+    bool decode_scheduled = false;
 
     // Absence of frame info is possible on the "default" image.
     std::optional<ImageGenerator::FrameInfo> frame_info;
@@ -193,6 +223,14 @@ class APNGImageGenerator : public ImageGenerator {
 
   bool DemuxToImageIndex(unsigned int image_index);
 
+  /// @brief  Decodes the image with the given codec into `decoded` unless it
+  ///         already was. Safe to call from any thread.
+  static SkCodec::Result DecodePixels(SkCodec& codec, DecodedPixels& decoded);
+
+  /// @brief  Demuxes the images after the given one and decodes them on the
+  ///         concurrent task runner, if there is one.
+  void DecodeAhead(unsigned int image_index);
+
   bool RenderDefaultImage(const SkImageInfo& info,
                           void* pixels,
                           size_t row_bytes);
@@ -211,6 +249,8 @@ class APNGImageGenerator : public ImageGenerator {
 
   const void* next_chunk_p_;
   std::vector<uint8_t> header_;
+
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
 };
 
 }  // namespace flutter
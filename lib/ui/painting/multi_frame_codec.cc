@@ -4,9 +4,12 @@
 
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
+#include <atomic>
+#include <optional>
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
@@ -20,6 +23,27 @@
 
 namespace flutter {
 
+namespace {
+
+// The number of bytes taken up by the frames decoded ahead by all the codecs.
+std::atomic<size_t> gDecodedAheadBytes = 0u;
+
+bool ReserveDecodedAheadBytes(size_t bytes) {
+  auto used = gDecodedAheadBytes.load();
+  do {
+    if (used + bytes > MultiFrameCodec::kDecodeAheadMemoryBudget) {
+      return false;
+    }
+  } while (!gDecodedAheadBytes.compare_exchange_weak(used, used + bytes));
+  return true;
+}
+
+void ReleaseDecodedAheadBytes(size_t bytes) {
+  gDecodedAheadBytes.fetch_sub(bytes);
+}
+
+}  // namespace
+
 MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
     : state_(new State(std::move(generator))) {}
 
@@ -33,7 +57,21 @@ MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
                            ? -1
                            : generator_->GetPlayCount() - 1),
       is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()),
-      nextFrameIndex_(0) {}
+      concurrent_task_runner_(
+          UIDartState::Current()->GetConcurrentTaskRunner()),
+      nextFrameIndex_(0) {
+  generator_->SetConcurrentTaskRunner(concurrent_task_runner_);
+}
+
+MultiFrameCodec::State::~State() {
+  ReleaseDecodedAheadBytes(decoded_frames_.size() *
+                           GetDecodeInfo().computeMinByteSize());
+}
+
+// static
+size_t MultiFrameCodec::GetDecodedAheadBytes() {
+  return gDecodedAheadBytes.load();
+}
 
 static void InvokeNextFrameCallback(
     const fml::RefPtr<CanvasImage>& image,
@@ -84,29 +122,33 @@ static bool CopyToBitmap(SkBitmap* dst,
   return true;
 }
 
-sk_sp<DlImage> MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    const std::shared_ptr<impeller::Context>& impeller_context,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
-  SkBitmap bitmap = SkBitmap();
+SkImageInfo MultiFrameCodec::State::GetDecodeInfo() const {
   SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
   if (info.alphaType() == kUnpremul_SkAlphaType) {
-    SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
-    info = updated;
+    info = info.makeAlphaType(kPremul_SkAlphaType);
   }
-  if (!bitmap.tryAllocPixels(info)) {
+  return info;
+}
+
+MultiFrameCodec::State::DecodedFrame
+MultiFrameCodec::State::DecodeNextFrame() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeNextFrame");
+  DecodedFrame frame;
+  frame.index = nextFrameIndex_;
+  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
+
+  auto bitmap = std::make_shared<SkBitmap>();
+  SkImageInfo info = GetDecodeInfo();
+  if (!bitmap->tryAllocPixels(info)) {
     FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
                    << info.computeMinByteSize() << "B";
-    return nullptr;
+    return frame;
   }
 
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frame.index);
 
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
-  std::optional<unsigned int> prior_frame_index = std::nullopt;
 
   if (requiredFrameIndex != SkCodec::kNoFrame) {
     // We currently assume that frames can only ever depend on the immediately
@@ -114,33 +156,144 @@ sk_sp<DlImage> MultiFrameCodec::State::GetNextFrameImage(
     // `DisposalMethod::kRestorePrevious` is not supported.
     if (lastRequiredFrame_ == nullptr) {
       FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
+          << "Frame " << frame.index << " depends on frame "
           << requiredFrameIndex
           << " and no required frames are cached. Using blank slate instead.";
     } else {
       // Copy the previous frame's output buffer into the current frame as the
       // starting point.
-      if (lastRequiredFrame_->getPixels() &&
-          CopyToBitmap(&bitmap, lastRequiredFrame_->colorType(),
-                       *lastRequiredFrame_)) {
-        prior_frame_index = requiredFrameIndex;
+      if (lastRequiredFrame_->getPixels()) {
+        CopyToBitmap(bitmap.get(), lastRequiredFrame_->colorType(),
+                     *lastRequiredFrame_);
       }
     }
   }
 
   // Write the new frame to the output buffer. The bitmap pixels as supplied
   // are already set in accordance with the previous frame's disposal policy.
-  if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
-    FML_LOG(ERROR) << "Could not getPixels for frame " << nextFrameIndex_;
-    return nullptr;
+  if (!generator_->GetPixels(info, bitmap->getPixels(), bitmap->rowBytes(),
+                             frame.index, requiredFrameIndex)) {
+    FML_LOG(ERROR) << "Could not getPixels for frame " << frame.index;
+    return frame;
   }
 
-  // Hold onto this if we need it to decode future frames.
+  // Hold onto this if we need it to decode future frames. The pixels of the
+  // frame are shared, and never written to again.
   if (frameInfo.disposal_method == SkCodecAnimation::DisposalMethod::kKeep ||
       lastRequiredFrame_) {
-    lastRequiredFrame_ = std::make_unique<SkBitmap>(bitmap);
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrame_ = bitmap;
+    lastRequiredFrameIndex_ = frame.index;
+  }
+
+  frame.duration = frameInfo.duration;
+  frame.bitmap = std::move(bitmap);
+  frame.required_frame = lastRequiredFrame_;
+  frame.required_frame_index = lastRequiredFrameIndex_;
+  return frame;
+}
+
+MultiFrameCodec::State::DecodedFrame MultiFrameCodec::State::TakeNextFrame() {
+  auto take_decoded_frame = [&]() -> std::optional<DecodedFrame> {
+    std::scoped_lock lock(frames_mutex_);
+    if (decoded_frames_.empty()) {
+      return std::nullopt;
+    }
+    auto frame = std::move(decoded_frames_.front());
+    decoded_frames_.pop_front();
+    ReleaseDecodedAheadBytes(GetDecodeInfo().computeMinByteSize());
+    return frame;
+  };
+
+  auto frame = take_decoded_frame();
+  if (!frame.has_value()) {
+    // The next frame may be being decoded ahead right now, in which case it
+    // is handed out as soon as it is decoded.
+    std::scoped_lock decode_lock(decode_mutex_);
+    frame = take_decoded_frame();
+    if (!frame.has_value()) {
+      frame = DecodeNextFrame();
+    }
+  }
+
+  std::scoped_lock lock(frames_mutex_);
+  handed_out_frame_count_++;
+  handed_out_required_frame_ = frame->required_frame;
+  handed_out_required_frame_index_ = frame->required_frame_index;
+  return std::move(frame.value());
+}
+
+void MultiFrameCodec::State::ScheduleDecodeAhead() {
+  if (!concurrent_task_runner_ || frameCount_ < 2) {
+    return;
+  }
+  {
+    std::scoped_lock lock(frames_mutex_);
+    if (decode_ahead_scheduled_ ||
+        decoded_frames_.size() >= kMaxDecodedAheadFrames) {
+      return;
+    }
+    decode_ahead_scheduled_ = true;
+  }
+  concurrent_task_runner_->PostTask(
+      [weak_state = weak_from_this()]() {
+        if (auto state = weak_state.lock()) {
+          state->DecodeAhead();
+        }
+      });
+}
+
+void MultiFrameCodec::State::DecodeAhead() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeAhead");
+  const size_t frame_bytes = GetDecodeInfo().computeMinByteSize();
+  while (true) {
+    std::scoped_lock decode_lock(decode_mutex_);
+    {
+      std::scoped_lock lock(frames_mutex_);
+      if (decoded_frames_.size() >= kMaxDecodedAheadFrames ||
+          !ReserveDecodedAheadBytes(frame_bytes)) {
+        decode_ahead_scheduled_ = false;
+        return;
+      }
+    }
+    auto frame = DecodeNextFrame();
+    std::scoped_lock lock(frames_mutex_);
+    const bool decoded = frame.bitmap != nullptr;
+    // Frames that failed to decode are handed out too, so that the framework
+    // finds out about the failure.
+    decoded_frames_.push_back(std::move(frame));
+    if (!decoded) {
+      decode_ahead_scheduled_ = false;
+      return;
+    }
+  }
+}
+
+void MultiFrameCodec::State::DropDecodedFramesIfPaused(
+    uint64_t handed_out_frame_count) {
+  std::scoped_lock decode_lock(decode_mutex_);
+  std::scoped_lock lock(frames_mutex_);
+  if (handed_out_frame_count != handed_out_frame_count_ ||
+      decoded_frames_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DropDecodedFrames");
+  // Resume decoding from the first dropped frame.
+  nextFrameIndex_ = decoded_frames_.front().index;
+  lastRequiredFrame_ = handed_out_required_frame_;
+  lastRequiredFrameIndex_ = handed_out_required_frame_index_;
+  ReleaseDecodedAheadBytes(decoded_frames_.size() *
+                           GetDecodeInfo().computeMinByteSize());
+  decoded_frames_.clear();
+}
+
+sk_sp<DlImage> MultiFrameCodec::State::UploadFrame(
+    const std::shared_ptr<SkBitmap>& frame_bitmap,
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
+  if (!frame_bitmap) {
+    return nullptr;
   }
 
 #if IMPELLER_SUPPORTS_RENDERING
@@ -148,11 +301,11 @@ sk_sp<DlImage> MultiFrameCodec::State::GetNextFrameImage(
     // This is safe regardless of whether the GPU is available or not because
     // without mipmap creation there is no command buffer encoding done.
     return ImageDecoderImpeller::UploadTextureToShared(
-        impeller_context, std::make_shared<SkBitmap>(bitmap),
-        /*create_mips=*/false);
+        impeller_context, frame_bitmap, /*create_mips=*/false);
   }
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
+  const SkBitmap& bitmap = *frame_bitmap;
   sk_sp<SkImage> skImage;
   gpu_disable_sync_switch->Execute(
       fml::SyncSwitch::Handlers()
@@ -182,6 +335,7 @@ sk_sp<DlImage> MultiFrameCodec::State::GetNextFrameImage(
 void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     std::unique_ptr<DartPersistentValue> callback,
     const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
+    const fml::RefPtr<fml::TaskRunner>& io_task_runner,
     fml::WeakPtr<GrDirectContext> resourceContext,
     fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
@@ -189,17 +343,16 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     const std::shared_ptr<impeller::Context>& impeller_context) {
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
+  DecodedFrame frame = TakeNextFrame();
   sk_sp<DlImage> dlImage =
-      GetNextFrameImage(std::move(resourceContext), gpu_disable_sync_switch,
-                        impeller_context, std::move(unref_queue));
+      UploadFrame(frame.bitmap, std::move(resourceContext),
+                  gpu_disable_sync_switch, impeller_context,
+                  std::move(unref_queue));
   if (dlImage) {
     image = CanvasImage::Create();
     image->set_image(dlImage);
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
+    duration = frame.duration;
   }
-  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -208,6 +361,22 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
                                               duration, trace_id]() mutable {
     InvokeNextFrameCallback(image, duration, std::move(callback), trace_id);
   }));
+
+  // Decode the next frames while this one is displayed, and drop them if the
+  // framework doesn't ask for the next one in time.
+  ScheduleDecodeAhead();
+  uint64_t handed_out_frame_count;
+  {
+    std::scoped_lock lock(frames_mutex_);
+    handed_out_frame_count = handed_out_frame_count_;
+  }
+  io_task_runner->PostDelayedTask(
+      [weak_state = weak_from_this(), handed_out_frame_count]() {
+        if (auto state = weak_state.lock()) {
+          state->DropDecodedFramesIfPaused(handed_out_frame_count);
+        }
+      },
+      fml::TimeDelta::FromMilliseconds(duration) + kPausedAnimationTimeout);
 }
 
 Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
@@ -238,6 +407,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
            tonic::DartState::Current(), callback_handle),
        weak_state = std::weak_ptr<MultiFrameCodec::State>(state_), trace_id,
        ui_task_runner = task_runners.GetUITaskRunner(),
+       io_task_runner = task_runners.GetIOTaskRunner(),
        io_manager = dart_state->GetIOManager()]() mutable {
         auto state = weak_state.lock();
         if (!state) {
@@ -246,7 +416,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
           return;
         }
         state->GetNextFrameAndInvokeCallback(
-            std::move(callback), ui_task_runner,
+            std::move(callback), ui_task_runner, io_task_runner,
             io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
             io_manager->GetIsGpuDisabledSyncSwitch(), trace_id,
             io_manager->GetImpellerContext());
@@ -5,7 +5,12 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 #define FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 
+#include <deque>
+#include <memory>
+#include <mutex>
+
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
 
@@ -15,6 +20,20 @@ namespace flutter {
 
 class MultiFrameCodec : public Codec {
  public:
+  /// The number of frames each codec decodes ahead of the frame the
+  /// framework asks for next, on the concurrent task runner.
+  static constexpr size_t kMaxDecodedAheadFrames = 2;
+
+  /// The number of bytes the frames decoded ahead by all the codecs may take
+  /// up together. Codecs whose next frame doesn't fit decode it on demand.
+  static constexpr size_t kDecodeAheadMemoryBudget = 64u * 1024u * 1024u;
+
+  /// Frames decoded ahead are dropped once the next frame hasn't been asked
+  /// for this long after the duration of the current one, which happens
+  /// when the animation is paused or not visible anymore.
+  static constexpr fml::TimeDelta kPausedAnimationTimeout =
+      fml::TimeDelta::FromSeconds(1);
+
   explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
 
   ~MultiFrameCodec() override;
@@ -28,35 +47,87 @@ class MultiFrameCodec : public Codec {
   // |Codec|
   Dart_Handle getNextFrame(Dart_Handle args) override;
 
+  /// The number of bytes taken up by the frames decoded ahead by all the
+  /// codecs.
+  static size_t GetDecodedAheadBytes();
+
  private:
   // Captures the state shared between the IO and UI task runners.
   //
   // The state is initialized on the UI task runner when the Dart object is
-  // created. Decoding occurs on the IO task runner. Since it is possible for
-  // the UI object to be collected independently of the IO task runner work,
-  // it is not safe for this state to live directly on the MultiFrameCodec.
-  // Instead, the MultiFrameCodec creates this object when it is constructed,
-  // shares it with the IO task runner's decoding work, and sets the live_
-  // member to false when it is destructed.
-  struct State {
+  // created. Decoding occurs on the IO task runner, and ahead of time on the
+  // concurrent task runner. Since it is possible for the UI object to be
+  // collected independently of the IO task runner work, it is not safe for
+  // this state to live directly on the MultiFrameCodec. Instead, the
+  // MultiFrameCodec creates this object when it is constructed, shares it
+  // with the decoding work, and the decoding work only holds onto it weakly
+  // between tasks.
+  struct State : public std::enable_shared_from_this<State> {
     explicit State(std::shared_ptr<ImageGenerator> generator);
 
+    ~State();
+
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
     bool is_impeller_enabled_ = false;
-
-    // The non-const members and functions below here are only read or written
-    // to on the IO thread. They are not safe to access or write on the UI
-    // thread.
+    const std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
+
+    // The pixels of a frame that hasn't been uploaded yet.
+    struct DecodedFrame {
+      int index = 0;
+      int duration = 0;
+      // Null if the frame couldn't be decoded.
+      std::shared_ptr<SkBitmap> bitmap;
+      // The last decoded frame that's required to decode the frames after
+      // this one, and its index.
+      std::shared_ptr<SkBitmap> required_frame;
+      int required_frame_index = -1;
+    };
+
+    // Frames are decoded one at a time and in order, since each may depend on
+    // the previous one, either on the IO thread or on the concurrent task
+    // runner. The members below are guarded by this mutex.
+    std::mutex decode_mutex_;
     int nextFrameIndex_;
     // The last decoded frame that's required to decode any subsequent frames.
-    std::unique_ptr<SkBitmap> lastRequiredFrame_;
-
+    std::shared_ptr<SkBitmap> lastRequiredFrame_;
     // The index of the last decoded required frame.
     int lastRequiredFrameIndex_ = -1;
 
-    sk_sp<DlImage> GetNextFrameImage(
+    // Guards the members below, which are also accessed by the IO thread
+    // while a frame is being decoded ahead.
+    std::mutex frames_mutex_;
+    // The frames decoded ahead, in order, starting with the next frame to
+    // hand out.
+    std::deque<DecodedFrame> decoded_frames_;
+    bool decode_ahead_scheduled_ = false;
+    // The number of frames handed out, to find out whether the animation is
+    // still running.
+    uint64_t handed_out_frame_count_ = 0u;
+    // The decoder state after the last frame that was handed out, which
+    // decoding resumes from after the frames decoded ahead are dropped.
+    std::shared_ptr<SkBitmap> handed_out_required_frame_;
+    int handed_out_required_frame_index_ = -1;
+
+    SkImageInfo GetDecodeInfo() const;
+
+    // Decodes the frame at `nextFrameIndex_`. Must be called with
+    // `decode_mutex_` held.
+    DecodedFrame DecodeNextFrame();
+
+    // Hands out the next frame, either one that was decoded ahead or one
+    // that is decoded on demand.
+    DecodedFrame TakeNextFrame();
+
+    void ScheduleDecodeAhead();
+
+    void DecodeAhead();
+
+    void DropDecodedFramesIfPaused(uint64_t handed_out_frame_count);
+
+    sk_sp<DlImage> UploadFrame(
+        const std::shared_ptr<SkBitmap>& bitmap,
         fml::WeakPtr<GrDirectContext> resourceContext,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         const std::shared_ptr<impeller::Context>& impeller_context,
@@ -65,6 +136,7 @@ class MultiFrameCodec : public Codec {
     void GetNextFrameAndInvokeCallback(
         std::unique_ptr<DartPersistentValue> callback,
         const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
+        const fml::RefPtr<fml::TaskRunner>& io_task_runner,
         fml::WeakPtr<GrDirectContext> resourceContext,
         fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
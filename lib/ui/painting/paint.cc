@@ -35,7 +35,7 @@ constexpr int kMaskFilterBlurStyleIndex = 10;
 constexpr int kMaskFilterSigmaIndex = 11;
 constexpr int kInvertColorIndex = 12;
 constexpr int kDitherIndex = 13;
-constexpr size_t kDataByteCount = 56;  // 4 * (last index + 1)
+static_assert(Paint::kDataByteCount == 4 * (kDitherIndex + 1));
 
 // Indices for objects.
 constexpr int kShaderIndex = 0;
@@ -207,7 +207,6 @@ void Paint::toDlPaint(DlPaint& paint) const {
   FML_CHECK(byte_data.length_in_bytes() == kDataByteCount);
 
   const uint32_t* uint_data = static_cast<const uint32_t*>(byte_data.data());
-  const float* float_data = static_cast<const float*>(byte_data.data());
 
   Dart_Handle values[kObjectCount];
   if (!Dart_IsNull(paint_objects_)) {
@@ -245,6 +244,13 @@ void Paint::toDlPaint(DlPaint& paint) const {
     }
   }
 
+  dataToDlPaint(uint_data, paint);
+}
+
+void Paint::dataToDlPaint(const void* paint_data, DlPaint& paint) {
+  const uint32_t* uint_data = static_cast<const uint32_t*>(paint_data);
+  const float* float_data = static_cast<const float*>(paint_data);
+
   paint.setAntiAlias(uint_data[kIsAntiAliasIndex] == 0);
 
   uint32_t encoded_color = uint_data[kColorIndex];
@@ -22,6 +22,13 @@ class Paint {
 
   void toDlPaint(DlPaint& paint) const;
 
+  // Decodes the fields of the paint data encoded by painting.dart into
+  // `paint`, leaving the attributes that come from the paint objects alone.
+  static void dataToDlPaint(const void* paint_data, DlPaint& paint);
+
+  // Must be kept in sync with _kDataByteCount in painting.dart.
+  static constexpr size_t kDataByteCount = 56;
+
   bool isNull() const { return Dart_IsNull(paint_data_); }
   bool isNotNull() const { return !Dart_IsNull(paint_data_); }
 
@@ -38,6 +38,17 @@ void CanvasPath::resetVolatility() {
     tracked_path_->tracking_volatility = true;
     path_tracker_->Track(tracked_path_);
   }
+  // The storage of a path grows geometrically, so this only reports a new
+  // size a few times while the path is built up.
+  const size_t allocation_size = GetAllocationSize();
+  if (allocation_size != reported_allocation_size_) {
+    reported_allocation_size_ = allocation_size;
+    UpdateDartWrapperExternalSize();
+  }
+}
+
+size_t CanvasPath::GetAllocationSize() const {
+  return sizeof(CanvasPath) + path().approximateBytesUsed();
 }
 
 int CanvasPath::getFillType() {
@@ -211,14 +222,14 @@ void CanvasPath::addRRect(const RRect& rrect) {
   resetVolatility();
 }
 
-void CanvasPath::addPath(CanvasPath* path, double dx, double dy) {
+bool CanvasPath::addPath(CanvasPath* path, double dx, double dy) {
   if (!path) {
-    Dart_ThrowException(ToDart("Path.addPath called with non-genuine Path."));
-    return;
+    return false;
   }
   mutable_path().addPath(path->path(), SafeNarrow(dx), SafeNarrow(dy),
                          SkPath::kAppend_AddPathMode);
   resetVolatility();
+  return true;
 }
 
 void CanvasPath::addPathWithMatrix(CanvasPath* path,
@@ -242,15 +253,14 @@ void CanvasPath::addPathWithMatrix(CanvasPath* path,
   resetVolatility();
 }
 
-void CanvasPath::extendWithPath(CanvasPath* path, double dx, double dy) {
+bool CanvasPath::extendWithPath(CanvasPath* path, double dx, double dy) {
   if (!path) {
-    Dart_ThrowException(
-        ToDart("Path.extendWithPath called with non-genuine Path."));
-    return;
+    return false;
   }
   mutable_path().addPath(path->path(), SafeNarrow(dx), SafeNarrow(dy),
                          SkPath::kExtend_AddPathMode);
   resetVolatility();
+  return true;
 }
 
 void CanvasPath::extendWithPathAndMatrix(CanvasPath* path,
@@ -293,6 +303,7 @@ void CanvasPath::shift(Dart_Handle path_handle, double dx, double dy) {
   auto& other_mutable_path = path->mutable_path();
   mutable_path().offset(SafeNarrow(dx), SafeNarrow(dy), &other_mutable_path);
   resetVolatility();
+  path->resetVolatility();
 }
 
 void CanvasPath::transform(Dart_Handle path_handle,
@@ -303,6 +314,7 @@ void CanvasPath::transform(Dart_Handle path_handle,
   fml::RefPtr<CanvasPath> path = Create(path_handle);
   auto& other_mutable_path = path->mutable_path();
   mutable_path().transform(sk_matrix, &other_mutable_path);
+  path->resetVolatility();
 }
 
 tonic::Float32List CanvasPath::getBounds() {
@@ -316,9 +328,13 @@ tonic::Float32List CanvasPath::getBounds() {
 }
 
 bool CanvasPath::op(CanvasPath* path1, CanvasPath* path2, int operation) {
-  return Op(path1->path(), path2->path(), static_cast<SkPathOp>(operation),
-            &tracked_path_->path);
+  if (!path1 || !path2) {
+    return false;
+  }
+  bool result = Op(path1->path(), path2->path(),
+                   static_cast<SkPathOp>(operation), &tracked_path_->path);
   resetVolatility();
+  return result;
 }
 
 void CanvasPath::clone(Dart_Handle path_handle) {
@@ -326,6 +342,7 @@ void CanvasPath::clone(Dart_Handle path_handle) {
   // per Skia docs, this will create a fast copy
   // data is shared until the source path or dest path are mutated
   path->mutable_path() = this->path();
+  path->resetVolatility();
 }
 
 }  // namespace flutter
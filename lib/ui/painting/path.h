@@ -24,8 +24,8 @@ class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
 
   static void CreateFrom(Dart_Handle path_handle, const SkPath& src) {
     auto path = fml::MakeRefCounted<CanvasPath>();
-    path->AssociateWithDartWrapper(path_handle);
     path->tracked_path_->path = src;
+    path->AssociateWithDartWrapper(path_handle);
   }
 
   static fml::RefPtr<CanvasPath> Create(Dart_Handle wrapper) {
@@ -89,14 +89,14 @@ class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
               double sweepAngle);
   void addPolygon(const tonic::Float32List& points, bool close);
   void addRRect(const RRect& rrect);
-  void addPath(CanvasPath* path, double dx, double dy);
+  bool addPath(CanvasPath* path, double dx, double dy);
 
   void addPathWithMatrix(CanvasPath* path,
                          double dx,
                          double dy,
                          Dart_Handle matrix4_handle);
 
-  void extendWithPath(CanvasPath* path, double dx, double dy);
+  bool extendWithPath(CanvasPath* path, double dx, double dy);
 
   void extendWithPathAndMatrix(CanvasPath* path,
                                double dx,
@@ -116,13 +116,18 @@ class CanvasPath : public RefCountedDartWrappable<CanvasPath> {
 
   const SkPath& path() const { return tracked_path_->path; }
 
+  // |tonic::DartWrappable|
+  size_t GetAllocationSize() const override;
+
  private:
   CanvasPath();
 
   std::shared_ptr<VolatilePathTracker> path_tracker_;
   std::shared_ptr<VolatilePathTracker::TrackedPath> tracked_path_;
+  size_t reported_allocation_size_ = 0;
 
-  // Must be called whenever the path is created or mutated.
+  // Must be called whenever the path is created or mutated. Also reports the
+  // allocation size of the path to the Dart VM when it has changed.
   void resetVolatility();
 
   SkPath& mutable_path() { return tracked_path_->path; }
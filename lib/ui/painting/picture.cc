@@ -10,6 +10,7 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/lib/ui/painting/canvas.h"
 #include "flutter/lib/ui/painting/display_list_deferred_image_gpu_skia.h"
+#include "flutter/lib/ui/painting/rasterization_queue.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #if IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/painting/display_list_deferred_image_gpu_impeller.h"
@@ -64,12 +65,14 @@ static sk_sp<DlImage> CreateDeferredImage(
     uint32_t height,
     fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
     fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    std::shared_ptr<RasterizationQueue> rasterization_queue,
     fml::RefPtr<SkiaUnrefQueue> unref_queue) {
 #if IMPELLER_SUPPORTS_RENDERING
   if (impeller) {
     return DlDeferredImageGPUImpeller::Make(
         std::move(display_list), SkISize::Make(width, height),
-        std::move(snapshot_delegate), std::move(raster_task_runner));
+        std::move(snapshot_delegate), std::move(raster_task_runner),
+        std::move(rasterization_queue));
   }
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
@@ -77,7 +80,8 @@ static sk_sp<DlImage> CreateDeferredImage(
       width, height, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
   return DlDeferredImageGPUSkia::Make(
       image_info, std::move(display_list), std::move(snapshot_delegate),
-      raster_task_runner, std::move(unref_queue));
+      raster_task_runner, std::move(rasterization_queue),
+      std::move(unref_queue));
 }
 
 // static
@@ -97,7 +101,7 @@ void Picture::RasterizeToImageSync(sk_sp<DisplayList> display_list,
   auto dl_image = CreateDeferredImage(
       dart_state->IsImpellerEnabled(), std::move(display_list), width, height,
       std::move(snapshot_delegate), std::move(raster_task_runner),
-      std::move(unref_queue));
+      dart_state->GetRasterizationQueue(), std::move(unref_queue));
   image->set_image(dl_image);
   image->AssociateWithDartWrapper(raw_image_handle);
 }
@@ -150,8 +154,12 @@ Dart_Handle Picture::RasterizeToImage(const sk_sp<DisplayList>& display_list,
       dart_state, raw_image_callback);
   auto unref_queue = dart_state->GetSkiaUnrefQueue();
   auto ui_task_runner = dart_state->GetTaskRunners().GetUITaskRunner();
-  auto raster_task_runner = dart_state->GetTaskRunners().GetRasterTaskRunner();
+  auto rasterization_queue = dart_state->GetRasterizationQueue();
   auto snapshot_delegate = dart_state->GetSnapshotDelegate();
+  // Nobody is left to call back once the isolate is gone.
+  auto is_cancelled = [weak_dart_state = image_callback->dart_state()]() {
+    return weak_dart_state.expired();
+  };
 
   // We can't create an image on this task runner because we don't have a
   // graphics context. Even if we did, it would be slow anyway. Also, this
@@ -194,9 +202,10 @@ Dart_Handle Picture::RasterizeToImage(const sk_sp<DisplayList>& display_list,
         image_callback.reset();
       });
 
-  // Kick things off on the raster rask runner.
-  fml::TaskRunner::RunNowOrPostTask(
-      raster_task_runner,
+  // Kick things off on the raster rask runner, after the images that may be
+  // drawn in the next frame.
+  rasterization_queue->Enqueue(
+      RasterizationQueue::Priority::kBackground,
       [ui_task_runner, snapshot_delegate, display_list, picture_bounds, ui_task,
        layer_tree = std::move(layer_tree)] {
         sk_sp<DlImage> image;
@@ -215,7 +224,8 @@ Dart_Handle Picture::RasterizeToImage(const sk_sp<DisplayList>& display_list,
 
         fml::TaskRunner::RunNowOrPostTask(
             ui_task_runner, [ui_task, image]() { ui_task(image); });
-      });
+      },
+      std::move(is_cancelled));
 
   return Dart_Null();
 }
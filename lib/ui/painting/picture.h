@@ -40,7 +40,8 @@ class Picture : public RefCountedDartWrappable<Picture> {
 
   void dispose();
 
-  size_t GetAllocationSize() const;
+  // |tonic::DartWrappable|
+  size_t GetAllocationSize() const override;
 
   static void RasterizeToImageSync(sk_sp<DisplayList> display_list,
                                    uint32_t width,
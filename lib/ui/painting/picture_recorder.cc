@@ -26,8 +26,13 @@ PictureRecorder::PictureRecorder() {}
 PictureRecorder::~PictureRecorder() {}
 
 sk_sp<DisplayListBuilder> PictureRecorder::BeginRecording(SkRect bounds) {
-  display_list_builder_ =
-      sk_make_sp<DisplayListBuilder>(bounds, /*prepare_rtree=*/true);
+  // Pictures are recorded on the UI thread, so recording into its arena
+  // lets each frame reuse the op storage released by the previous frames.
+  display_list_builder_ = sk_make_sp<DisplayListBuilder>(
+      bounds, /*prepare_rtree=*/true, DlStorageArena::ForCurrentThread());
+  // Framework pictures often contain ops that cannot affect the rendering,
+  // dropping them while recording saves dispatching them every frame.
+  display_list_builder_->SetOptimizeOps(true);
   return display_list_builder_;
 }
 
@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/rasterization_queue.h"
+
+#include <utility>
+
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+RasterizationQueue::RasterizationQueue(
+    fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    fml::TimeDelta drain_budget)
+    : raster_task_runner_(std::move(raster_task_runner)),
+      drain_budget_(drain_budget) {}
+
+RasterizationQueue::~RasterizationQueue() = default;
+
+void RasterizationQueue::Enqueue(Priority priority,
+                                 fml::closure task,
+                                 std::function<bool()> is_cancelled) {
+  FML_DCHECK(task);
+  bool drain_now = false;
+  {
+    std::scoped_lock lock(mutex_);
+    auto& requests = priority == Priority::kVisible ? visible_requests_
+                                                    : background_requests_;
+    requests.push_back({std::move(task), std::move(is_cancelled)});
+    drain_now = raster_task_runner_->RunsTasksOnCurrentThread() && !draining_;
+    if (!drain_now) {
+      ScheduleDrainLocked();
+    }
+  }
+  if (drain_now) {
+    Drain();
+  }
+}
+
+size_t RasterizationQueue::GetPendingCount() const {
+  std::scoped_lock lock(mutex_);
+  return visible_requests_.size() + background_requests_.size();
+}
+
+size_t RasterizationQueue::GetCancelledCount() const {
+  std::scoped_lock lock(mutex_);
+  return cancelled_count_;
+}
+
+void RasterizationQueue::ScheduleDrainLocked() {
+  if (drain_scheduled_) {
+    return;
+  }
+  drain_scheduled_ = true;
+  raster_task_runner_->PostTask([weak_queue = weak_from_this()]() {
+    if (auto queue = weak_queue.lock()) {
+      queue->Drain();
+    }
+  });
+}
+
+void RasterizationQueue::Drain() {
+  TRACE_EVENT0("flutter", "RasterizationQueue::Drain");
+  const auto deadline = fml::TimePoint::Now() + drain_budget_;
+  {
+    std::scoped_lock lock(mutex_);
+    draining_ = true;
+  }
+  size_t rasterized_count = 0;
+  while (true) {
+    Request request;
+    {
+      std::scoped_lock lock(mutex_);
+      auto& requests = visible_requests_.empty() ? background_requests_
+                                                 : visible_requests_;
+      if (requests.empty()) {
+        drain_scheduled_ = false;
+        draining_ = false;
+        break;
+      }
+      if (rasterized_count > 0 && fml::TimePoint::Now() > deadline) {
+        // Leave the remaining requests to another task so that frames can be
+        // rasterized in between.
+        draining_ = false;
+        drain_scheduled_ = false;
+        ScheduleDrainLocked();
+        break;
+      }
+      request = std::move(requests.front());
+      requests.pop_front();
+    }
+    if (request.is_cancelled && request.is_cancelled()) {
+      std::scoped_lock lock(mutex_);
+      cancelled_count_++;
+      continue;
+    }
+    request.task();
+    rasterized_count++;
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_RASTERIZATION_QUEUE_H_
+#define FLUTTER_LIB_UI_PAINTING_RASTERIZATION_QUEUE_H_
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Batches the rasterization of the images requested by `Picture.toImage`,
+/// `Picture.toImageSync` and their `Scene` counterparts.
+///
+/// Instead of posting one raster task per image, requests are queued and the
+/// raster task runner drains all of the pending requests in one task. Images
+/// from `toImageSync` may be drawn in the very next frame, so they are
+/// rasterized before the images handed to `toImage` callbacks regardless of
+/// the order they were requested in. A request whose image was disposed
+/// before it got its turn is dropped without being rasterized.
+///
+/// A drain that takes longer than its budget leaves the remaining requests
+/// to another task, so that frames can be rasterized in between when
+/// hundreds of images are requested at once.
+///
+/// A queue is owned by the |UIDartState| of an isolate, and requests may be
+/// enqueued from any thread.
+///
+class RasterizationQueue
+    : public std::enable_shared_from_this<RasterizationQueue> {
+ public:
+  enum class Priority {
+    /// Images from `toImageSync`, which are likely to be drawn next frame.
+    kVisible,
+    /// Images that are handed to a `toImage` callback.
+    kBackground,
+  };
+
+  static constexpr fml::TimeDelta kDefaultDrainBudget =
+      fml::TimeDelta::FromMilliseconds(8);
+
+  explicit RasterizationQueue(fml::RefPtr<fml::TaskRunner> raster_task_runner,
+                              fml::TimeDelta drain_budget = kDefaultDrainBudget);
+
+  ~RasterizationQueue();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Queues a rasterization to run on the raster task runner.
+  ///             When called on the raster task runner, the pending requests
+  ///             are drained right away.
+  ///
+  /// @param[in]  priority      Requests are run in order of priority, and in
+  ///                           the order they were enqueued otherwise.
+  /// @param[in]  task          The rasterization.
+  /// @param[in]  is_cancelled  Optionally checked on the raster task runner
+  ///                           right before the task would run. Cancelled
+  ///                           tasks are destroyed without being run.
+  ///
+  void Enqueue(Priority priority,
+               fml::closure task,
+               std::function<bool()> is_cancelled = nullptr);
+
+  size_t GetPendingCount() const;
+
+  size_t GetCancelledCount() const;
+
+ private:
+  struct Request {
+    fml::closure task;
+    std::function<bool()> is_cancelled;
+  };
+
+  const fml::RefPtr<fml::TaskRunner> raster_task_runner_;
+  const fml::TimeDelta drain_budget_;
+  mutable std::mutex mutex_;
+  std::deque<Request> visible_requests_;
+  std::deque<Request> background_requests_;
+  bool drain_scheduled_ = false;
+  bool draining_ = false;
+  size_t cancelled_count_ = 0;
+
+  void ScheduleDrainLocked();
+
+  void Drain();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterizationQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_RASTERIZATION_QUEUE_H_
@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/rasterization_queue.h"
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(RasterizationQueueTest, RunsVisibleRequestsBeforeBackgroundRequests) {
+  fml::Thread raster_thread("raster");
+  auto queue =
+      std::make_shared<RasterizationQueue>(raster_thread.GetTaskRunner());
+  std::vector<int> order;
+  fml::AutoResetWaitableEvent latch;
+
+  // Block the raster thread so that all of the requests are pending at once.
+  fml::AutoResetWaitableEvent blocked;
+  raster_thread.GetTaskRunner()->PostTask([&blocked]() { blocked.Wait(); });
+
+  queue->Enqueue(RasterizationQueue::Priority::kBackground,
+                 [&order]() { order.push_back(1); });
+  queue->Enqueue(RasterizationQueue::Priority::kVisible,
+                 [&order]() { order.push_back(2); });
+  queue->Enqueue(RasterizationQueue::Priority::kBackground,
+                 [&order]() { order.push_back(3); });
+  queue->Enqueue(RasterizationQueue::Priority::kVisible,
+                 [&order]() { order.push_back(4); });
+  EXPECT_EQ(queue->GetPendingCount(), 4u);
+
+  blocked.Signal();
+  raster_thread.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  EXPECT_EQ(order, (std::vector<int>{2, 4, 1, 3}));
+  EXPECT_EQ(queue->GetPendingCount(), 0u);
+}
+
+TEST(RasterizationQueueTest, SkipsCancelledRequests) {
+  fml::Thread raster_thread("raster");
+  auto queue =
+      std::make_shared<RasterizationQueue>(raster_thread.GetTaskRunner());
+  bool ran = false;
+  fml::AutoResetWaitableEvent latch;
+
+  queue->Enqueue(
+      RasterizationQueue::Priority::kVisible, [&ran]() { ran = true; },
+      []() { return true; });
+  raster_thread.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  EXPECT_FALSE(ran);
+  EXPECT_EQ(queue->GetCancelledCount(), 1u);
+  EXPECT_EQ(queue->GetPendingCount(), 0u);
+}
+
+TEST(RasterizationQueueTest, DrainsInlineOnTheRasterThread) {
+  fml::Thread raster_thread("raster");
+  auto queue =
+      std::make_shared<RasterizationQueue>(raster_thread.GetTaskRunner());
+  fml::AutoResetWaitableEvent latch;
+
+  raster_thread.GetTaskRunner()->PostTask([&queue, &latch]() {
+    bool ran = false;
+    queue->Enqueue(RasterizationQueue::Priority::kVisible,
+                   [&ran]() { ran = true; });
+    EXPECT_TRUE(ran);
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -54,15 +54,6 @@ std::string SceneNode::initFromAsset(const std::string& asset_name,
 
   auto& task_runners = dart_state->GetTaskRunners();
 
-  std::promise<std::shared_ptr<impeller::Context>> context_promise;
-  auto impeller_context_promise = context_promise.get_future();
-  task_runners.GetIOTaskRunner()->PostTask(
-      fml::MakeCopyable([promise = std::move(context_promise),
-                         io_manager = dart_state->GetIOManager()]() mutable {
-        promise.set_value(io_manager ? io_manager->GetImpellerContext()
-                                     : nullptr);
-      }));
-
   auto persistent_completion_callback =
       std::make_unique<tonic::DartPersistentValue>(dart_state,
                                                    completion_callback_handle);
@@ -85,12 +76,20 @@ std::string SceneNode::initFromAsset(const std::string& asset_name,
         callback.reset();
       });
 
-  task_runners.GetRasterTaskRunner()->PostTask(
-      fml::MakeCopyable([ui_task = std::move(ui_task), task_runners,
-                         impeller_context = impeller_context_promise.get(),
-                         data = std::move(data)]() {
-        auto node = impeller::scene::Node::MakeFromFlatbuffer(
-            *data, *impeller_context->GetResourceAllocator());
+  // Scenes are unpacked on the IO thread so that neither the UI thread nor
+  // frames on the raster thread wait for large assets to load.
+  task_runners.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+      [ui_task = std::move(ui_task), task_runners,
+       io_manager = dart_state->GetIOManager(), data = std::move(data)]() {
+        auto impeller_context =
+            io_manager ? io_manager->GetImpellerContext() : nullptr;
+        std::shared_ptr<impeller::scene::Node> node;
+        if (impeller_context) {
+          TRACE_EVENT0("flutter", "SceneNode::UnpackScene");
+          node = impeller::scene::Node::MakeFromFlatbuffer(
+              *data, *impeller_context->GetResourceAllocator(),
+              impeller_context->GetWorkerTaskRunner());
+        }
 
         task_runners.GetUITaskRunner()->PostTask(
             [ui_task, node = std::move(node)]() { ui_task(node); });
@@ -2754,6 +2754,32 @@ class Paragraph extends NativeFieldWrapperClass1 {
   @Native<Void Function(Pointer<Void>, Double)>(symbol: 'Paragraph::layout', isLeaf: true)
   external void _layout(double width);
 
+  /// Computes the size and position of each glyph of each of the [paragraphs],
+  /// like calling [layout] on each of them with the [ParagraphConstraints] at
+  /// the same index of [constraints].
+  ///
+  /// The paragraphs are shaped and broken into lines in parallel on the
+  /// engine's worker threads, and this returns once all of them are laid out.
+  /// This is faster than laying the paragraphs out one by one when many
+  /// paragraphs are laid out at once, for example for the rows of a list.
+  static void layoutAll(List<Paragraph> paragraphs, List<ParagraphConstraints> constraints) {
+    assert(paragraphs.length == constraints.length);
+    final Float64List widths = Float64List(paragraphs.length);
+    for (int index = 0; index < paragraphs.length; index += 1) {
+      assert(!paragraphs[index].debugDisposed);
+      widths[index] = constraints[index].width;
+    }
+    _layoutAll(paragraphs, widths);
+    assert(() {
+      for (final Paragraph paragraph in paragraphs) {
+        paragraph._needsLayout = false;
+      }
+      return true;
+    }());
+  }
+  @Native<Void Function(Handle, Handle)>(symbol: 'Paragraph::LayoutAll')
+  external static void _layoutAll(List<Paragraph> paragraphs, Float64List widths);
+
   List<TextBox> _decodeTextBoxes(Float32List encoded) {
     final int count = encoded.length ~/ 5;
     final List<TextBox> boxes = <TextBox>[];
@@ -4,6 +4,9 @@
 
 #include "flutter/lib/ui/text/asset_manager_font_provider.h"
 
+#include <mutex>
+#include <algorithm>
+#include <unordered_map>
 #include <utility>
 
 #include "flutter/fml/logging.h"
@@ -20,11 +23,99 @@ void MappingReleaseProc(const void* ptr, void* context) {
   delete reinterpret_cast<fml::Mapping*>(context);
 }
 
+// The number of leading bytes of a font file that identify its contents. The
+// table directory at the start of an sfnt file holds a checksum of every table
+// in the font, so two font files with the same leading bytes and size have the
+// same tables.
+constexpr size_t kFontFingerprintSize = 4096u;
+
+// A process wide cache of the typefaces created from font assets, so that
+// engines that use the same font asset share one typeface and one copy of its
+// data instead of each holding their own. The cache only keeps weak references
+// to the typefaces, so a typeface is still collected once the last engine
+// using it releases it.
+class TypefaceCache {
+ public:
+  static TypefaceCache& GetInstance() {
+    static TypefaceCache* cache = new TypefaceCache();
+    return *cache;
+  }
+
+  // Returns the typeface for the asset, or creates one from the mapping and
+  // caches it if there is none yet.
+  sk_sp<SkTypeface> GetOrCreate(const std::string& asset_name,
+                                std::unique_ptr<fml::Mapping> mapping) {
+    if (mapping->GetSize() == 0u) {
+      return nullptr;
+    }
+    const auto* data = reinterpret_cast<const char*>(mapping->GetMapping());
+    std::string key = asset_name;
+    key.push_back('\0');
+    key.append(std::to_string(mapping->GetSize()));
+    key.push_back('\0');
+    key.append(data, std::min(mapping->GetSize(), kFontFingerprintSize));
+
+    std::scoped_lock lock(mutex_);
+    auto found = typefaces_.find(key);
+    if (found != typefaces_.end()) {
+      if (found->second->try_ref()) {
+        return sk_sp<SkTypeface>(found->second);
+      }
+      found->second->weak_unref();
+      typefaces_.erase(found);
+    }
+
+    fml::Mapping* mapping_ptr = mapping.release();
+    sk_sp<SkData> asset_data =
+        SkData::MakeWithProc(mapping_ptr->GetMapping(), mapping_ptr->GetSize(),
+                             MappingReleaseProc, mapping_ptr);
+    // Ownership of the stream is transferred.
+    sk_sp<SkTypeface> typeface =
+        SkTypeface::MakeFromStream(SkMemoryStream::Make(asset_data));
+    if (!typeface) {
+      return nullptr;
+    }
+
+    PurgeCollectedTypefacesLocked();
+    typeface->weak_ref();
+    typefaces_.emplace(std::move(key), typeface.get());
+    return typeface;
+  }
+
+  // Drops the typefaces that are no longer referenced. A typeface keeps its
+  // data until the cache drops its weak reference.
+  void PurgeCollectedTypefaces() {
+    std::scoped_lock lock(mutex_);
+    PurgeCollectedTypefacesLocked();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, SkTypeface*> typefaces_;
+
+  TypefaceCache() = default;
+
+  void PurgeCollectedTypefacesLocked() {
+    for (auto it = typefaces_.begin(); it != typefaces_.end();) {
+      if (it->second->weak_expired()) {
+        it->second->weak_unref();
+        it = typefaces_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TypefaceCache);
+};
+
 }  // anonymous namespace
 
 AssetManagerFontProvider::AssetManagerFontProvider(
-    std::shared_ptr<AssetManager> asset_manager)
-    : asset_manager_(std::move(asset_manager)) {}
+    std::shared_ptr<AssetManager> asset_manager,
+    std::shared_ptr<fml::BasicTaskRunner> read_task_runner)
+    : asset_manager_(std::move(asset_manager)),
+      read_task_runner_(std::move(read_task_runner)) {}
 
 AssetManagerFontProvider::~AssetManagerFontProvider() = default;
 
@@ -58,7 +149,8 @@ void AssetManagerFontProvider::RegisterAsset(const std::string& family_name,
     family_names_.push_back(family_name);
     auto value = std::make_pair(
         canonical_name,
-        sk_make_sp<AssetManagerFontStyleSet>(asset_manager_, family_name));
+        sk_make_sp<AssetManagerFontStyleSet>(asset_manager_, family_name,
+                                             read_task_runner_));
     family_it = registered_families_.emplace(value).first;
   }
 
@@ -67,11 +159,16 @@ void AssetManagerFontProvider::RegisterAsset(const std::string& family_name,
 
 AssetManagerFontStyleSet::AssetManagerFontStyleSet(
     std::shared_ptr<AssetManager> asset_manager,
-    std::string family_name)
+    std::string family_name,
+    std::shared_ptr<fml::BasicTaskRunner> read_task_runner)
     : asset_manager_(std::move(asset_manager)),
-      family_name_(std::move(family_name)) {}
+      family_name_(std::move(family_name)),
+      read_task_runner_(std::move(read_task_runner)) {}
 
-AssetManagerFontStyleSet::~AssetManagerFontStyleSet() = default;
+AssetManagerFontStyleSet::~AssetManagerFontStyleSet() {
+  assets_.clear();
+  TypefaceCache::GetInstance().PurgeCollectedTypefaces();
+}
 
 void AssetManagerFontStyleSet::registerAsset(const std::string& asset) {
   assets_.emplace_back(asset);
@@ -102,30 +199,43 @@ auto AssetManagerFontStyleSet::createTypeface(int i) -> CreateTypefaceRet {
     return nullptr;
   }
 
+  std::scoped_lock lock(typefaces_mutex_);
   TypefaceAsset& asset = assets_[index];
   if (!asset.typeface) {
-    std::unique_ptr<fml::Mapping> asset_mapping =
-        asset_manager_->GetAsMapping(asset.asset);
-    if (asset_mapping == nullptr) {
+    CreateMissingTypefaces();
+    if (!asset.typeface) {
       return nullptr;
     }
+  }
 
-    fml::Mapping* asset_mapping_ptr = asset_mapping.release();
-    sk_sp<SkData> asset_data = SkData::MakeWithProc(
-        asset_mapping_ptr->GetMapping(), asset_mapping_ptr->GetSize(),
-        MappingReleaseProc, asset_mapping_ptr);
-    std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(asset_data);
+  return CreateTypefaceRet(SkRef(asset.typeface.get()));
+}
 
-    // Ownership of the stream is transferred.
-    asset.typeface = SkTypeface::MakeFromStream(std::move(stream));
+void AssetManagerFontStyleSet::CreateMissingTypefaces() {
+  // Matching a style creates the typeface of every asset of the family, so
+  // their assets are all read at once rather than one by one.
+  std::vector<TypefaceAsset*> missing_assets;
+  std::vector<std::string> missing_names;
+  for (auto& asset : assets_) {
     if (!asset.typeface) {
+      missing_assets.push_back(&asset);
+      missing_names.push_back(asset.asset);
+    }
+  }
+  auto mappings = asset_manager_->GetAsMappingsConcurrently(missing_names,
+                                                            read_task_runner_);
+  for (size_t i = 0; i < missing_assets.size() && i < mappings.size(); i++) {
+    if (mappings[i] == nullptr) {
+      continue;
+    }
+    TypefaceAsset* asset = missing_assets[i];
+    asset->typeface = TypefaceCache::GetInstance().GetOrCreate(
+        asset->asset, std::move(mappings[i]));
+    if (!asset->typeface) {
       FML_DLOG(ERROR) << "Unable to load font asset for family: "
                       << family_name_;
-      return nullptr;
     }
   }
-
-  return CreateTypefaceRet(SkRef(asset.typeface.get()));
 }
 
 auto AssetManagerFontStyleSet::matchStyle(const SkFontStyle& pattern)
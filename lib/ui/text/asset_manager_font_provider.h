@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_TEXT_ASSET_MANAGER_FONT_PROVIDER_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -20,8 +21,10 @@ namespace flutter {
 
 class AssetManagerFontStyleSet : public SkFontStyleSet {
  public:
-  AssetManagerFontStyleSet(std::shared_ptr<AssetManager> asset_manager,
-                           std::string family_name);
+  AssetManagerFontStyleSet(
+      std::shared_ptr<AssetManager> asset_manager,
+      std::string family_name,
+      std::shared_ptr<fml::BasicTaskRunner> read_task_runner = nullptr);
 
   ~AssetManagerFontStyleSet() override;
 
@@ -46,6 +49,7 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
  private:
   std::shared_ptr<AssetManager> asset_manager_;
   std::string family_name_;
+  std::shared_ptr<fml::BasicTaskRunner> read_task_runner_;
 
   struct TypefaceAsset {
     explicit TypefaceAsset(std::string a);
@@ -57,15 +61,28 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
     std::string asset;
     sk_sp<SkTypeface> typeface;
   };
+  // Guards the lazily created typefaces of |assets_|, since paragraphs may be
+  // laid out on multiple threads at once.
+  std::mutex typefaces_mutex_;
   std::vector<TypefaceAsset> assets_;
 
+  // Creates the typefaces of all the assets of the family that have none yet.
+  // Must be called with |typefaces_mutex_| held.
+  void CreateMissingTypefaces();
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManagerFontStyleSet);
 };
 
 class AssetManagerFontProvider : public txt::FontAssetProvider {
  public:
+  //----------------------------------------------------------------------------
+  /// @param[in]  asset_manager     The asset manager to read the fonts from.
+  /// @param[in]  read_task_runner  The task runner that the fonts of a family
+  ///                               are read on concurrently, if any.
+  ///
   explicit AssetManagerFontProvider(
-      std::shared_ptr<AssetManager> asset_manager);
+      std::shared_ptr<AssetManager> asset_manager,
+      std::shared_ptr<fml::BasicTaskRunner> read_task_runner = nullptr);
 
   ~AssetManagerFontProvider() override;
 
@@ -82,6 +99,7 @@ class AssetManagerFontProvider : public txt::FontAssetProvider {
 
  private:
   std::shared_ptr<AssetManager> asset_manager_;
+  std::shared_ptr<fml::BasicTaskRunner> read_task_runner_;
   std::unordered_map<std::string, sk_sp<AssetManagerFontStyleSet>>
       registered_families_;
   std::vector<std::string> family_names_;
@@ -62,7 +62,8 @@ void FontCollection::SetupDefaultFontManager(
 //
 // Structure described in https://docs.flutter.dev/cookbook/design/fonts
 void FontCollection::RegisterFonts(
-    const std::shared_ptr<AssetManager>& asset_manager) {
+    const std::shared_ptr<AssetManager>& asset_manager,
+    const std::shared_ptr<fml::BasicTaskRunner>& read_task_runner) {
   std::unique_ptr<fml::Mapping> manifest_mapping =
       asset_manager->GetAsMapping("FontManifest.json");
   if (manifest_mapping == nullptr) {
@@ -86,7 +87,8 @@ void FontCollection::RegisterFonts(
   }
 
   auto font_provider =
-      std::make_unique<AssetManagerFontProvider>(asset_manager);
+      std::make_unique<AssetManagerFontProvider>(asset_manager,
+                                                 read_task_runner);
 
   for (const auto& family : document.GetArray()) {
     auto family_name = family.FindMember("family");
@@ -26,7 +26,14 @@ class FontCollection {
 
   void SetupDefaultFontManager(uint32_t font_initialization_data);
 
-  void RegisterFonts(const std::shared_ptr<AssetManager>& asset_manager);
+  //----------------------------------------------------------------------------
+  /// @brief      Registers the fonts listed in the font manifest of the
+  ///             assets. The fonts of a family are read concurrently on
+  ///             `read_task_runner` when it is first used, if one is given.
+  ///
+  void RegisterFonts(
+      const std::shared_ptr<AssetManager>& asset_manager,
+      const std::shared_ptr<fml::BasicTaskRunner>& read_task_runner = nullptr);
 
   void RegisterTestFonts();
 
@@ -4,10 +4,19 @@
 
 #include "flutter/lib/ui/text/paragraph.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
@@ -17,6 +26,50 @@ namespace flutter {
 
 IMPLEMENT_WRAPPERTYPEINFO(ui, Paragraph);
 
+namespace {
+
+// The largest number of worker threads that lay out paragraphs in parallel,
+// in addition to the UI thread.
+constexpr size_t kMaxLayoutWorkers = 3u;
+
+// The paragraphs of a call to |Paragraph::LayoutAll|. The UI thread and the
+// workers take the next paragraph to lay out until there are none left. A
+// worker that starts after all paragraphs have been taken doesn't touch the
+// paragraphs, so they only need to outlive the call.
+class ConcurrentLayout {
+ public:
+  explicit ConcurrentLayout(
+      std::vector<std::pair<txt::Paragraph*, double>> paragraphs)
+      : paragraphs_(std::move(paragraphs)) {}
+
+  void Run() {
+    for (size_t index = next_++; index < paragraphs_.size(); index = next_++) {
+      auto [paragraph, width] = paragraphs_[index];
+      paragraph->LayoutConcurrently(width);
+      std::scoped_lock lock(mutex_);
+      if (++laid_out_count_ == paragraphs_.size()) {
+        done_.notify_all();
+      }
+    }
+  }
+
+  void Wait() {
+    std::unique_lock lock(mutex_);
+    done_.wait(lock, [&] { return laid_out_count_ == paragraphs_.size(); });
+  }
+
+ private:
+  const std::vector<std::pair<txt::Paragraph*, double>> paragraphs_;
+  std::atomic<size_t> next_ = 0;
+  std::mutex mutex_;
+  std::condition_variable done_;
+  size_t laid_out_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentLayout);
+};
+
+}  // namespace
+
 Paragraph::Paragraph(std::unique_ptr<txt::Paragraph> paragraph)
     : m_paragraph(std::move(paragraph)) {}
 
@@ -58,6 +111,43 @@ void Paragraph::layout(double width) {
   m_paragraph->Layout(width);
 }
 
+// static
+void Paragraph::LayoutAll(Dart_Handle paragraphs_handle,
+                          Dart_Handle widths_handle) {
+  intptr_t count = 0;
+  Dart_ListLength(paragraphs_handle, &count);
+  tonic::Float64List widths(widths_handle);
+  FML_CHECK(static_cast<size_t>(count) == widths.num_elements());
+
+  std::vector<std::pair<txt::Paragraph*, double>> paragraphs;
+  paragraphs.reserve(count);
+  for (intptr_t i = 0; i < count; i++) {
+    auto* paragraph = tonic::DartConverter<Paragraph*>::FromDart(
+        Dart_ListGetAt(paragraphs_handle, i));
+    if (paragraph && paragraph->m_paragraph) {
+      paragraphs.emplace_back(paragraph->m_paragraph.get(), widths[i]);
+    }
+  }
+  widths.Release();
+
+  auto task_runner = UIDartState::Current()->GetConcurrentTaskRunner();
+  if (paragraphs.size() < 2 || !task_runner) {
+    for (const auto& [paragraph, width] : paragraphs) {
+      paragraph->Layout(width);
+    }
+    return;
+  }
+
+  const size_t worker_count =
+      std::min(paragraphs.size() - 1, kMaxLayoutWorkers);
+  auto layout = std::make_shared<ConcurrentLayout>(std::move(paragraphs));
+  for (size_t i = 0; i < worker_count; i++) {
+    task_runner->PostTask([layout]() { layout->Run(); });
+  }
+  layout->Run();
+  layout->Wait();
+}
+
 void Paragraph::paint(Canvas* canvas, double x, double y) {
   if (!m_paragraph || !canvas) {
     // disposed.
@@ -37,6 +37,19 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
   bool didExceedMaxLines();
 
   void layout(double width);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Lays out each of the paragraphs of a list at the width at the
+  ///             same index of `widths_handle`, like calling `layout` on each
+  ///             of them. The paragraphs are laid out in parallel on the
+  ///             concurrent task runner and the calling UI thread, and this
+  ///             returns once all of them are laid out.
+  ///
+  /// @param[in]  paragraphs_handle  A `List<Paragraph>`.
+  /// @param[in]  widths_handle      A `Float64List` of the same length.
+  ///
+  static void LayoutAll(Dart_Handle paragraphs_handle,
+                        Dart_Handle widths_handle);
   void paint(Canvas* canvas, double x, double y);
 
   tonic::Float32List getRectsForRange(unsigned start,
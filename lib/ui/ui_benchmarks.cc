@@ -10,6 +10,8 @@
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/fixture_test.h"
+#include "third_party/tonic/logging/dart_error.h"
+#include "third_party/tonic/logging/dart_invoke.h"
 
 #include <future>
 
@@ -112,9 +114,44 @@ static void BM_PathVolatilityTracker(benchmark::State& state) {
   }
 }
 
+// Calls the given fixture entrypoint once per iteration. The entrypoints go
+// through the dart:ui natives for recording pictures and building paths, so
+// this measures the cost of the native transitions as much as the recording.
+static void BM_DartUINatives(benchmark::State& state, const char* entrypoint) {
+  ThreadHost thread_host(ThreadHost::ThreadHostConfig(
+      "test", ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                  ThreadHost::Type::IO | ThreadHost::Type::UI));
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  Fixture fixture;
+  auto settings = fixture.CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto isolate =
+      testing::RunDartCodeInIsolate(vm_ref, settings, task_runners, "main", {},
+                                    testing::GetDefaultKernelFilePath(), {});
+  FML_CHECK(isolate);
+
+  while (state.KeepRunning()) {
+    bool successful = isolate->RunInIsolateScope([&]() -> bool {
+      Dart_Handle result =
+          tonic::DartInvokeField(Dart_RootLibrary(), entrypoint, {});
+      return !tonic::CheckAndHandleError(result);
+    });
+    FML_CHECK(successful);
+  }
+}
+
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
 BENCHMARK(BM_PathVolatilityTracker)->Unit(benchmark::kMillisecond);
 
+BENCHMARK_CAPTURE(BM_DartUINatives, CanvasNatives, "recordCanvasNatives")
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DartUINatives, PathNatives, "buildPathNatives")
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "flutter/fml/message_loop.h"
+#include "flutter/lib/ui/painting/rasterization_queue.h"
 #include "flutter/lib/ui/window/platform_configuration.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_message_handler.h"
@@ -69,6 +70,10 @@ UIDartState::UIDartState(
       log_message_callback_(std::move(log_message_callback)),
       isolate_name_server_(std::move(isolate_name_server)),
       context_(context) {
+  if (auto raster_task_runner = context_.task_runners.GetRasterTaskRunner()) {
+    rasterization_queue_ =
+        std::make_shared<RasterizationQueue>(std::move(raster_task_runner));
+  }
   AddOrRemoveTaskObserver(true /* add */);
 }
 
@@ -123,6 +128,27 @@ void UIDartState::SetPlatformConfiguration(
   }
 }
 
+void UIDartState::SetEngineContext(const UIDartState::Context& context) {
+  FML_DCHECK(IsRootIsolate());
+  FML_DCHECK(context.task_runners.GetUITaskRunner() ==
+             context_.task_runners.GetUITaskRunner());
+  context_.snapshot_delegate = context.snapshot_delegate;
+  context_.io_manager = context.io_manager;
+  context_.unref_queue = context.unref_queue;
+  context_.image_decoder = context.image_decoder;
+  context_.image_generator_registry = context.image_generator_registry;
+  context_.advisory_script_uri = context.advisory_script_uri;
+  context_.advisory_script_entrypoint = context.advisory_script_entrypoint;
+  context_.volatile_path_tracker = context.volatile_path_tracker;
+  context_.concurrent_task_runner = context.concurrent_task_runner;
+  context_.enable_impeller = context.enable_impeller;
+
+  std::ostringstream debug_name;
+  debug_name << context_.advisory_script_uri << "$"
+             << context_.advisory_script_entrypoint << "-" << main_port_;
+  SetDebugName(debug_name.str());
+}
+
 void UIDartState::SetPlatformMessageHandler(
     std::weak_ptr<PlatformMessageHandler> handler) {
   FML_DCHECK(!IsRootIsolate());
@@ -184,6 +210,11 @@ UIDartState::GetSnapshotDelegate() const {
   return context_.snapshot_delegate;
 }
 
+std::shared_ptr<RasterizationQueue> UIDartState::GetRasterizationQueue()
+    const {
+  return rasterization_queue_;
+}
+
 fml::WeakPtr<ImageDecoder> UIDartState::GetImageDecoder() const {
   return context_.image_decoder;
 }
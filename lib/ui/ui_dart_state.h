@@ -32,6 +32,7 @@ class FontSelector;
 class ImageGeneratorRegistry;
 class PlatformConfiguration;
 class PlatformMessage;
+class RasterizationQueue;
 
 class UIDartState : public tonic::DartState {
  public:
@@ -137,6 +138,10 @@ class UIDartState : public tonic::DartState {
 
   fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> GetSnapshotDelegate() const;
 
+  /// The queue that the images requested by `toImage` and `toImageSync` are
+  /// rasterized through, or nullptr if there is no raster task runner.
+  std::shared_ptr<RasterizationQueue> GetRasterizationQueue() const;
+
   fml::WeakPtr<ImageDecoder> GetImageDecoder() const;
 
   fml::WeakPtr<ImageGeneratorRegistry> GetImageGeneratorRegistry() const;
@@ -190,6 +195,11 @@ class UIDartState : public tonic::DartState {
   void SetPlatformConfiguration(
       std::unique_ptr<PlatformConfiguration> platform_configuration);
 
+  // Rebinds the engine-owned state of a root isolate that was created before
+  // the engine that will run it. The task runners of |context| must be the
+  // ones the isolate was created with.
+  void SetEngineContext(const UIDartState::Context& context);
+
   const std::string& GetAdvisoryScriptURI() const;
 
  private:
@@ -208,6 +218,7 @@ class UIDartState : public tonic::DartState {
   LogMessageCallback log_message_callback_;
   const std::shared_ptr<IsolateNameServer> isolate_name_server_;
   UIDartState::Context context_;
+  std::shared_ptr<RasterizationQueue> rasterization_queue_;
 
   void AddOrRemoveTaskObserver(bool add);
 };
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/window/platform_configuration.h"
 
+#include <cstdlib>
 #include <cstring>
 
 #include "flutter/lib/ui/compositing/scene.h"
@@ -28,6 +29,26 @@ Dart_Handle ToByteData(const fml::Mapping& buffer) {
   return tonic::DartByteData::Create(buffer.GetMapping(), buffer.GetSize());
 }
 
+void FreeByteData(void* isolate_callback_data, void* peer) {
+  free(peer);
+}
+
+// Like |ToByteData|, but large buffers are handed over to the Dart VM instead
+// of being copied into a new allocation.
+Dart_Handle MoveToByteData(fml::MallocMapping&& buffer) {
+  const size_t size = buffer.GetSize();
+  if (size < tonic::DartByteData::kExternalSizeThreshold) {
+    return ToByteData(buffer);
+  }
+  uint8_t* data = buffer.Release();
+  Dart_Handle byte_data = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, data, size, data, size, FreeByteData);
+  if (Dart_IsError(byte_data)) {
+    free(data);
+  }
+  return byte_data;
+}
+
 }  // namespace
 
 PlatformConfigurationClient::~PlatformConfigurationClient() {}
@@ -60,6 +81,9 @@ void PlatformConfiguration::DidCreateIsolate() {
   dispatch_platform_message_.Set(
       tonic::DartState::Current(),
       Dart_GetField(library, tonic::ToDart("_dispatchPlatformMessage")));
+  dispatch_platform_messages_.Set(
+      tonic::DartState::Current(),
+      Dart_GetField(library, tonic::ToDart("_dispatchPlatformMessages")));
   dispatch_semantics_action_.Set(
       tonic::DartState::Current(),
       Dart_GetField(library, tonic::ToDart("_dispatchSemanticsAction")));
@@ -159,7 +183,8 @@ void PlatformConfiguration::DispatchPlatformMessage(
   }
   tonic::DartState::Scope scope(dart_state);
   Dart_Handle data_handle =
-      (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+      (message->hasData()) ? MoveToByteData(message->releaseData())
+                           : Dart_Null();
   if (Dart_IsError(data_handle)) {
     FML_DLOG(WARNING)
         << "Dropping platform message because of a Dart error on channel: "
@@ -179,6 +204,53 @@ void PlatformConfiguration::DispatchPlatformMessage(
                          tonic::ToDart(response_id)}));
 }
 
+void PlatformConfiguration::DispatchPlatformMessages(
+    std::vector<std::unique_ptr<PlatformMessage>> messages) {
+  if (messages.size() == 1) {
+    DispatchPlatformMessage(std::move(messages.front()));
+    return;
+  }
+  std::shared_ptr<tonic::DartState> dart_state =
+      dispatch_platform_messages_.dart_state().lock();
+  if (!dart_state) {
+    FML_DLOG(WARNING) << "Dropping " << messages.size()
+                      << " platform messages for lack of DartState.";
+    return;
+  }
+  tonic::DartState::Scope scope(dart_state);
+
+  std::vector<std::string> names;
+  std::vector<int> response_ids;
+  Dart_Handle data_handles = Dart_NewList(messages.size());
+  if (Dart_IsError(data_handles)) {
+    return;
+  }
+  for (auto& message : messages) {
+    Dart_Handle data_handle =
+        (message->hasData()) ? MoveToByteData(message->releaseData())
+                             : Dart_Null();
+    if (Dart_IsError(data_handle)) {
+      FML_DLOG(WARNING)
+          << "Dropping platform message because of a Dart error on channel: "
+          << message->channel();
+      continue;
+    }
+    Dart_ListSetAt(data_handles, names.size(), data_handle);
+
+    int response_id = 0;
+    if (auto response = message->response()) {
+      response_id = next_response_id_++;
+      pending_responses_[response_id] = response;
+    }
+    names.push_back(message->channel());
+    response_ids.push_back(response_id);
+  }
+
+  tonic::CheckAndHandleError(tonic::DartInvoke(
+      dispatch_platform_messages_.Get(),
+      {tonic::ToDart(names), data_handles, tonic::ToDart(response_ids)}));
+}
+
 void PlatformConfiguration::DispatchSemanticsAction(int32_t node_id,
                                                     SemanticsAction action,
                                                     fml::MallocMapping args) {
@@ -190,7 +262,7 @@ void PlatformConfiguration::DispatchSemanticsAction(int32_t node_id,
   tonic::DartState::Scope scope(dart_state);
 
   Dart_Handle args_handle =
-      (args.GetSize() <= 0) ? Dart_Null() : ToByteData(args);
+      (args.GetSize() <= 0) ? Dart_Null() : MoveToByteData(std::move(args));
 
   if (Dart_IsError(args_handle)) {
     return;
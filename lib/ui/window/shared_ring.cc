@@ -0,0 +1,201 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/shared_ring.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+#include "third_party/dart/runtime/include/dart_native_api.h"
+#include "third_party/tonic/dart_binding_macros.h"
+
+namespace flutter {
+
+namespace {
+
+size_t AlignRecordSize(size_t size) {
+  return (size + 3) & ~static_cast<size_t>(3);
+}
+
+struct SharedRingRegistry {
+  std::mutex mutex;
+  int64_t next_identifier = 1;
+  std::unordered_map<int64_t, fml::RefPtr<SharedRingBuffer>> rings;
+};
+
+SharedRingRegistry& GetRegistry() {
+  static SharedRingRegistry* registry = new SharedRingRegistry();
+  return *registry;
+}
+
+void ReleaseRing(void* isolate_callback_data, void* peer) {
+  reinterpret_cast<SharedRingBuffer*>(peer)->Release();
+}
+
+}  // namespace
+
+// static
+fml::RefPtr<SharedRingBuffer> SharedRingBuffer::Create(size_t capacity,
+                                                       Dart_Port port) {
+  capacity = AlignRecordSize(capacity);
+  if (capacity <= kHeaderSize ||
+      capacity > std::numeric_limits<uint32_t>::max()) {
+    return nullptr;
+  }
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  int64_t identifier = registry.next_identifier++;
+  auto ring = fml::MakeRefCounted<SharedRingBuffer>(identifier, capacity, port);
+  registry.rings[identifier] = ring;
+  return ring;
+}
+
+// static
+fml::RefPtr<SharedRingBuffer> SharedRingBuffer::Lookup(int64_t identifier) {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  auto found = registry.rings.find(identifier);
+  if (found == registry.rings.end()) {
+    return nullptr;
+  }
+  return found->second;
+}
+
+SharedRingBuffer::SharedRingBuffer(int64_t identifier,
+                                   size_t capacity,
+                                   Dart_Port port)
+    : identifier_(identifier),
+      capacity_(capacity),
+      port_(port),
+      data_(new uint8_t[capacity]) {}
+
+SharedRingBuffer::~SharedRingBuffer() = default;
+
+void SharedRingBuffer::Close() {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  registry.rings.erase(identifier_);
+}
+
+bool SharedRingBuffer::Write(const uint8_t* data, size_t size) {
+  const size_t record_size = kHeaderSize + AlignRecordSize(size);
+  if (record_size > capacity_) {
+    return false;
+  }
+
+  uint64_t write_position = write_position_.load(std::memory_order_relaxed);
+  const uint64_t read_position =
+      read_position_.load(std::memory_order_acquire);
+  size_t offset = write_position % capacity_;
+  // Records are contiguous, so one that does not fit before the end of the
+  // buffer skips the rest of it.
+  const size_t skipped =
+      capacity_ - offset < record_size ? capacity_ - offset : 0;
+  if (write_position + skipped + record_size - read_position > capacity_) {
+    return false;
+  }
+  if (skipped > 0) {
+    std::memcpy(data_.get() + offset, &kWrapMarker, kHeaderSize);
+    write_position += skipped;
+    offset = 0;
+  }
+
+  const uint32_t length = static_cast<uint32_t>(size);
+  std::memcpy(data_.get() + offset, &length, kHeaderSize);
+  if (size > 0) {
+    std::memcpy(data_.get() + offset + kHeaderSize, data, size);
+  }
+  write_position_.store(write_position + record_size,
+                        std::memory_order_release);
+
+  if (consumer_waiting_.exchange(false) && port_ != ILLEGAL_PORT) {
+    Dart_PostInteger(port_, identifier_);
+  }
+  return true;
+}
+
+size_t SharedRingBuffer::Acquire() {
+  const uint64_t read_position =
+      read_position_.load(std::memory_order_relaxed);
+  uint64_t write_position = write_position_.load(std::memory_order_acquire);
+  if (write_position == read_position) {
+    // Check again after asking to be notified, so that a record written in
+    // between is not missed.
+    consumer_waiting_.store(true);
+    write_position = write_position_.load();
+    if (write_position == read_position) {
+      return 0;
+    }
+    consumer_waiting_.store(false);
+  }
+  const size_t offset = read_position % capacity_;
+  const uint64_t available = write_position - read_position;
+  return static_cast<size_t>(
+      std::min<uint64_t>(available, capacity_ - offset));
+}
+
+size_t SharedRingBuffer::GetReadOffset() const {
+  return read_position_.load(std::memory_order_relaxed) % capacity_;
+}
+
+void SharedRingBuffer::Consume(size_t size) {
+  read_position_.fetch_add(size, std::memory_order_release);
+}
+
+IMPLEMENT_WRAPPERTYPEINFO(ui, SharedRing);
+
+SharedRing::SharedRing(fml::RefPtr<SharedRingBuffer> ring)
+    : ring_(std::move(ring)) {}
+
+SharedRing::~SharedRing() = default;
+
+bool SharedRing::Attach(Dart_Handle wrapper, int64_t identifier) {
+  auto ring_buffer = SharedRingBuffer::Lookup(identifier);
+  if (!ring_buffer) {
+    return false;
+  }
+  auto ring = fml::MakeRefCounted<SharedRing>(std::move(ring_buffer));
+  ring->AssociateWithDartWrapper(wrapper);
+  return true;
+}
+
+Dart_Handle SharedRing::getBuffer() {
+  if (!ring_) {
+    return Dart_Null();
+  }
+  // The buffer keeps the memory of the ring alive, even if it outlives this
+  // object.
+  ring_->AddRef();
+  Dart_Handle buffer = Dart_NewExternalTypedDataWithFinalizer(
+      Dart_TypedData_kByteData, ring_->data(), ring_->capacity(), ring_.get(),
+      ring_->capacity(), ReleaseRing);
+  if (Dart_IsError(buffer)) {
+    ring_->Release();
+  }
+  return buffer;
+}
+
+int SharedRing::acquire() {
+  return ring_ ? ring_->Acquire() : 0;
+}
+
+int SharedRing::readOffset() {
+  return ring_ ? ring_->GetReadOffset() : 0;
+}
+
+void SharedRing::release(int size) {
+  if (ring_ && size > 0) {
+    ring_->Consume(size);
+  }
+}
+
+void SharedRing::dispose() {
+  ring_ = nullptr;
+  ClearDartWrapper();
+}
+
+}  // namespace flutter
@@ -0,0 +1,159 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_WINDOW_SHARED_RING_H_
+#define FLUTTER_LIB_UI_WINDOW_SHARED_RING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_counted.h"
+#include "flutter/lib/ui/dart_wrapper.h"
+#include "third_party/dart/runtime/include/dart_api.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A single producer, single consumer ring of variable sized records that
+/// native code writes and a Dart isolate reads in place.
+///
+/// Each record is a 32-bit length in host byte order followed by the payload,
+/// padded to 4 bytes. A record that does not fit before the end of the
+/// buffer is preceded by `kWrapMarker`, and written at its start instead.
+///
+/// Writing does not post any tasks. The consumer is only notified, by posting
+/// the identifier of the ring to its Dart port, when a record is written
+/// after the consumer found the ring empty.
+///
+/// Rings are registered by identifier for the whole process, so that a Dart
+/// isolate can find a ring created by the embedder.
+///
+class SharedRingBuffer : public fml::RefCountedThreadSafe<SharedRingBuffer> {
+ public:
+  /// The length written in place of a record header to skip the rest of the
+  /// buffer.
+  static constexpr uint32_t kWrapMarker = 0xffffffff;
+
+  /// The size of the length that precedes each record.
+  static constexpr size_t kHeaderSize = sizeof(uint32_t);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates and registers a ring.
+  ///
+  /// @param[in]  capacity  The size of the buffer in bytes, which is rounded
+  ///                       up to a multiple of 4.
+  /// @param[in]  port      The port that is notified when records are
+  ///                       available, or `ILLEGAL_PORT` if the consumer
+  ///                       polls the ring instead.
+  ///
+  /// @return     The ring, or null if the capacity is invalid.
+  ///
+  static fml::RefPtr<SharedRingBuffer> Create(size_t capacity, Dart_Port port);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Finds a ring registered by `Create` and not closed yet.
+  ///
+  static fml::RefPtr<SharedRingBuffer> Lookup(int64_t identifier);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Unregisters the ring. The memory of the ring stays valid
+  ///             until the last reference to it is dropped.
+  ///
+  void Close();
+
+  int64_t identifier() const { return identifier_; }
+
+  size_t capacity() const { return capacity_; }
+
+  uint8_t* data() const { return data_.get(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copies a record into the ring. Must only be called by the
+  ///             producer.
+  ///
+  /// @return     Whether there was enough space for the record.
+  ///
+  bool Write(const uint8_t* data, size_t size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of bytes of records that can be read from
+  ///             `GetReadOffset` without wrapping around. Must only be called
+  ///             by the consumer. If there are none, the consumer is notified
+  ///             when the next record is written.
+  ///
+  size_t Acquire();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The offset in the buffer of the next record to read.
+  ///
+  size_t GetReadOffset() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns `size` bytes of read records to the producer. Must
+  ///             only be called by the consumer.
+  ///
+  void Consume(size_t size);
+
+ private:
+  const int64_t identifier_;
+  const size_t capacity_;
+  const Dart_Port port_;
+  std::unique_ptr<uint8_t[]> data_;
+  // Positions only ever grow. Offsets in the buffer are positions modulo the
+  // capacity.
+  std::atomic<uint64_t> write_position_ = 0;
+  std::atomic<uint64_t> read_position_ = 0;
+  std::atomic<bool> consumer_waiting_ = true;
+
+  SharedRingBuffer(int64_t identifier, size_t capacity, Dart_Port port);
+
+  ~SharedRingBuffer();
+
+  FML_FRIEND_MAKE_REF_COUNTED(SharedRingBuffer);
+  FML_FRIEND_REF_COUNTED_THREAD_SAFE(SharedRingBuffer);
+  FML_DISALLOW_COPY_AND_ASSIGN(SharedRingBuffer);
+};
+
+//------------------------------------------------------------------------------
+/// The Dart side of a `SharedRingBuffer`, which consumes its records.
+///
+class SharedRing : public RefCountedDartWrappable<SharedRing> {
+  DEFINE_WRAPPERTYPEINFO();
+  FML_FRIEND_MAKE_REF_COUNTED(SharedRing);
+
+ public:
+  ~SharedRing() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Associates `wrapper` with the ring registered as
+  ///             `identifier`.
+  ///
+  /// @return     Whether the ring was found.
+  ///
+  static bool Attach(Dart_Handle wrapper, int64_t identifier);
+
+  /// An external ByteData over the memory of the ring.
+  Dart_Handle getBuffer();
+
+  int acquire();
+
+  int readOffset();
+
+  void release(int size);
+
+  void dispose();
+
+ private:
+  explicit SharedRing(fml::RefPtr<SharedRingBuffer> ring);
+
+  fml::RefPtr<SharedRingBuffer> ring_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SharedRing);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_WINDOW_SHARED_RING_H_
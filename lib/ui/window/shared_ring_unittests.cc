@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/window/shared_ring.h"
+
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+uint32_t ReadLength(const SharedRingBuffer& ring, size_t offset) {
+  uint32_t length = 0;
+  std::memcpy(&length, ring.data() + offset, sizeof(length));
+  return length;
+}
+
+bool Write(SharedRingBuffer& ring, const std::string& message) {
+  return ring.Write(reinterpret_cast<const uint8_t*>(message.data()),
+                    message.size());
+}
+
+}  // namespace
+
+TEST(SharedRingBufferTest, RejectsInvalidCapacities) {
+  ASSERT_FALSE(SharedRingBuffer::Create(0, ILLEGAL_PORT));
+  ASSERT_FALSE(SharedRingBuffer::Create(4, ILLEGAL_PORT));
+  auto ring = SharedRingBuffer::Create(30, ILLEGAL_PORT);
+  ASSERT_TRUE(ring);
+  ASSERT_EQ(ring->capacity(), 32u);
+  ring->Close();
+}
+
+TEST(SharedRingBufferTest, CanBeLookedUpUntilClosed) {
+  auto ring = SharedRingBuffer::Create(64, ILLEGAL_PORT);
+  ASSERT_TRUE(ring);
+  ASSERT_EQ(SharedRingBuffer::Lookup(ring->identifier()), ring);
+  ring->Close();
+  ASSERT_FALSE(SharedRingBuffer::Lookup(ring->identifier()));
+}
+
+TEST(SharedRingBufferTest, ReadsRecordsInPlace) {
+  auto ring = SharedRingBuffer::Create(64, ILLEGAL_PORT);
+  ASSERT_EQ(ring->Acquire(), 0u);
+
+  ASSERT_TRUE(Write(*ring, "hello"));
+  ASSERT_TRUE(Write(*ring, ""));
+  ASSERT_EQ(ring->Acquire(), 16u);
+  ASSERT_EQ(ring->GetReadOffset(), 0u);
+  ASSERT_EQ(ReadLength(*ring, 0), 5u);
+  ASSERT_EQ(std::memcmp(ring->data() + 4, "hello", 5), 0);
+  ASSERT_EQ(ReadLength(*ring, 12), 0u);
+
+  ring->Consume(16);
+  ASSERT_EQ(ring->GetReadOffset(), 16u);
+  ASSERT_EQ(ring->Acquire(), 0u);
+  ring->Close();
+}
+
+TEST(SharedRingBufferTest, RejectsRecordsThatDoNotFit) {
+  auto ring = SharedRingBuffer::Create(32, ILLEGAL_PORT);
+  ASSERT_FALSE(Write(*ring, std::string(29, 'a')));
+  ASSERT_TRUE(Write(*ring, std::string(12, 'a')));
+  ASSERT_TRUE(Write(*ring, std::string(12, 'b')));
+  ASSERT_FALSE(Write(*ring, ""));
+
+  ring->Consume(ring->Acquire());
+  ASSERT_TRUE(Write(*ring, std::string(28, 'c')));
+  ring->Close();
+}
+
+TEST(SharedRingBufferTest, WrapsRecordsToTheStartOfTheBuffer) {
+  auto ring = SharedRingBuffer::Create(32, ILLEGAL_PORT);
+  ASSERT_TRUE(Write(*ring, std::string(16, 'a')));
+  ring->Consume(ring->Acquire());
+
+  // Only 12 bytes are left before the end of the buffer.
+  ASSERT_TRUE(Write(*ring, std::string(12, 'b')));
+  ASSERT_EQ(ring->Acquire(), 12u);
+  ASSERT_EQ(ReadLength(*ring, 20), SharedRingBuffer::kWrapMarker);
+  ring->Consume(12);
+
+  ASSERT_EQ(ring->Acquire(), 16u);
+  ASSERT_EQ(ring->GetReadOffset(), 0u);
+  ASSERT_EQ(ReadLength(*ring, 0), 12u);
+  ASSERT_EQ(ring->data()[4], 'b');
+  ring->Consume(16);
+  ASSERT_EQ(ring->Acquire(), 0u);
+  ring->Close();
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -260,3 +260,16 @@ class ChannelBuffers {
 }
 
 final ChannelBuffers channelBuffers = ChannelBuffers();
+
+class SharedRing {
+  SharedRing._();
+
+  // Rings are created by native embedders, so there are none on the web.
+  static SharedRing? attach(int identifier) => null;
+
+  int drain(void Function(ByteData record) onRecord) {
+    throw UnsupportedError('SharedRing is not supported on the web.');
+  }
+
+  void dispose() {}
+}
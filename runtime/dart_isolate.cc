@@ -97,7 +97,8 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
     const std::vector<std::string>& dart_entrypoint_args,
     std::unique_ptr<IsolateConfiguration> isolate_configuration,
     const UIDartState::Context& context,
-    const DartIsolate* spawning_isolate) {
+    const DartIsolate* spawning_isolate,
+    std::shared_ptr<DartIsolate> prewarmed_isolate) {
   if (!isolate_snapshot) {
     FML_LOG(ERROR) << "Invalid isolate snapshot.";
     return {};
@@ -112,16 +113,24 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
       isolate_configuration->IsNullSafetyEnabled(*isolate_snapshot));
   isolate_flags.SetIsDontNeedSafe(isolate_snapshot->IsDontNeedSafe());
 
-  auto isolate = CreateRootIsolate(settings,                           //
-                                   isolate_snapshot,                   //
-                                   std::move(platform_configuration),  //
-                                   isolate_flags,                      //
-                                   isolate_create_callback,            //
-                                   isolate_shutdown_callback,          //
-                                   context,                            //
-                                   spawning_isolate                    //
-                                   )
-                     .lock();
+  std::shared_ptr<DartIsolate> isolate;
+  if (prewarmed_isolate) {
+    FML_DCHECK(spawning_isolate);
+    isolate = std::move(prewarmed_isolate);
+    isolate->SetEngineContext(context);
+    isolate->SetPlatformConfiguration(std::move(platform_configuration));
+  } else {
+    isolate = CreateRootIsolate(settings,                           //
+                                isolate_snapshot,                   //
+                                std::move(platform_configuration),  //
+                                isolate_flags,                      //
+                                isolate_create_callback,            //
+                                isolate_shutdown_callback,          //
+                                context,                            //
+                                spawning_isolate                    //
+                                )
+                  .lock();
+  }
 
   if (!isolate) {
     FML_LOG(ERROR) << "Could not create root isolate.";
@@ -179,6 +188,33 @@ std::weak_ptr<DartIsolate> DartIsolate::CreateRunningRootIsolate(
   return isolate;
 }
 
+// static
+std::weak_ptr<DartIsolate> DartIsolate::CreatePrewarmedRootIsolate(
+    const Settings& settings,
+    const fml::RefPtr<const DartSnapshot>& isolate_snapshot,
+    const UIDartState::Context& context,
+    const DartIsolate& spawning_isolate) {
+  TRACE_EVENT0("flutter", "DartIsolate::CreatePrewarmedRootIsolate");
+  if (!isolate_snapshot || !DartVM::IsRunningPrecompiledCode()) {
+    return {};
+  }
+
+  Flags isolate_flags;
+  isolate_flags.SetNullSafetyEnabled(
+      isolate_snapshot->IsNullSafetyEnabled(nullptr));
+  isolate_flags.SetIsDontNeedSafe(isolate_snapshot->IsDontNeedSafe());
+
+  return CreateRootIsolate(settings,          //
+                           isolate_snapshot,  //
+                           nullptr,           // platform configuration
+                           isolate_flags,     //
+                           nullptr,           // isolate create callback
+                           nullptr,           // isolate shutdown callback
+                           context,           //
+                           &spawning_isolate  //
+  );
+}
+
 void DartIsolate::SpawnIsolateShutdownCallback(
     std::shared_ptr<DartIsolateGroupData>* isolate_group_data,
     std::shared_ptr<DartIsolate>* isolate_data) {
@@ -200,6 +200,12 @@ class DartIsolate : public UIDartState {
   ///                                         accessed by the root dart isolate.
   /// @param[in]  spawning_isolate            The isolate that is spawning the
   ///                                         new isolate.
+  /// @param[in]  prewarmed_isolate           A root isolate previously created
+  ///                                         by `CreatePrewarmedRootIsolate`
+  ///                                         in the group of
+  ///                                         `spawning_isolate` to run instead
+  ///                                         of creating a new one, or
+  ///                                         nullptr.
   /// @return     A weak pointer to the root Dart isolate. The caller must
   ///             ensure that the isolate is not referenced for long periods of
   ///             time as it prevents isolate collection when the isolate
@@ -219,7 +225,41 @@ class DartIsolate : public UIDartState {
       const std::vector<std::string>& dart_entrypoint_args,
       std::unique_ptr<IsolateConfiguration> isolate_configuration,
       const UIDartState::Context& context,
-      const DartIsolate* spawning_isolate = nullptr);
+      const DartIsolate* spawning_isolate = nullptr,
+      std::shared_ptr<DartIsolate> prewarmed_isolate = nullptr);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a root isolate in the isolate group of
+  ///             `spawning_isolate` without running it or binding it to a
+  ///             platform configuration. The isolate is left in the
+  ///             `Phase::LibrariesSetup` phase and can later be passed to
+  ///             `CreateRunningRootIsolate` by an engine spawned from the one
+  ///             owning `spawning_isolate`, which rebinds it to its own
+  ///             context. This moves the cost of creating the isolate out of
+  ///             the critical path of spawning an engine.
+  ///
+  ///             Only isolates created from precompiled snapshots may be
+  ///             created ahead of time since the isolate configuration of the
+  ///             spawned engine is not known yet.
+  ///
+  /// @param[in]  settings                    The settings used to create the
+  ///                                         isolate.
+  /// @param[in]  isolate_snapshot            The snapshot of the isolate group
+  ///                                         of `spawning_isolate`.
+  /// @param[in]  context                     Engine-owned state which is
+  ///                                         accessed by the isolate until it
+  ///                                         is rebound.
+  /// @param[in]  spawning_isolate            The isolate in whose group the new
+  ///                                         isolate is created.
+  ///
+  /// @return     A weak pointer to the root Dart isolate. The isolate must be
+  ///             shut down by the caller if it is never run.
+  ///
+  static std::weak_ptr<DartIsolate> CreatePrewarmedRootIsolate(
+      const Settings& settings,
+      const fml::RefPtr<const DartSnapshot>& isolate_snapshot,
+      const UIDartState::Context& context,
+      const DartIsolate& spawning_isolate);
 
   // |UIDartState|
   ~DartIsolate() override;
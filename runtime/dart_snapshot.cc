@@ -6,6 +6,7 @@
 
 #include <sstream>
 
+#include "flutter/fml/mapping.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
@@ -264,6 +265,16 @@ bool DartSnapshot::IsDontNeedSafe() const {
   return true;
 }
 
+void DartSnapshot::Prefetch() const {
+  TRACE_EVENT0("flutter", "DartSnapshot::Prefetch");
+  if (data_) {
+    fml::PrefetchMapping(*data_);
+  }
+  if (instructions_) {
+    fml::PrefetchMapping(*instructions_);
+  }
+}
+
 bool DartSnapshot::IsNullSafetyEnabled(const fml::Mapping* kernel) const {
   return ::Dart_DetectNullSafety(
       nullptr,           // script_uri (unsupported by Flutter)
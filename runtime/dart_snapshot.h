@@ -165,6 +165,15 @@ class DartSnapshot : public fml::RefCountedThreadSafe<DartSnapshot> {
   ///             safe to use with madvise(DONTNEED).
   bool IsDontNeedSafe() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Hints the OS that the data and instructions of this snapshot
+  ///             will be accessed soon so that their pages are read ahead
+  ///             instead of being faulted in one by one while the first frame
+  ///             is produced. This may issue I/O and should be called on a
+  ///             background thread.
+  ///
+  void Prefetch() const;
+
   bool IsNullSafetyEnabled(
       const fml::Mapping* application_kernel_mapping) const;
 
@@ -285,7 +285,7 @@ DartVM::DartVM(const std::shared_ptr<const DartVMData>& vm_data,
     : settings_(vm_data->GetSettings()),
       concurrent_message_loop_(fml::ConcurrentMessageLoop::Create()),
       skia_concurrent_executor_(
-          [runner = concurrent_message_loop_->GetTaskRunner()](
+          [runner = concurrent_message_loop_->GetTaskRunner("skia")](
               const fml::closure& work) { runner->PostTask(work); }),
       vm_data_(vm_data),
       isolate_name_server_(std::move(isolate_name_server)),
@@ -302,6 +302,15 @@ DartVM::DartVM(const std::shared_ptr<const DartVMData>& vm_data,
   FML_DCHECK(isolate_name_server_);
   FML_DCHECK(service_protocol_);
 
+  // Read the snapshots ahead while the VM initializes so that launching the
+  // root isolate and producing the first frame don't fault their pages in one
+  // by one.
+  concurrent_message_loop_->GetTaskRunner("snapshot_prefetch")
+      ->PostTask([vm_data = vm_data_]() {
+        vm_data->GetVMSnapshot().Prefetch();
+        vm_data->GetIsolateSnapshot()->Prefetch();
+      });
+
   {
     TRACE_EVENT0("flutter", "dart::bin::BootstrapDartIo");
     dart::bin::BootstrapDartIo();
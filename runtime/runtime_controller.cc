@@ -4,6 +4,8 @@
 
 #include "flutter/runtime/runtime_controller.h"
 
+#include <deque>
+#include <string>
 #include <utility>
 
 #include "flutter/fml/message_loop.h"
@@ -20,6 +22,84 @@
 
 namespace flutter {
 
+// Keeps up to a fixed number of root isolates created ahead of time in the
+// group of a root isolate. The pool is refilled one isolate per UI task so that
+// creating the isolates doesn't delay frames.
+class RuntimeController::SpawnIsolatePool
+    : public std::enable_shared_from_this<SpawnIsolatePool> {
+ public:
+  SpawnIsolatePool(const Settings& settings,
+                   fml::RefPtr<const DartSnapshot> isolate_snapshot,
+                   const UIDartState::Context& context,
+                   std::weak_ptr<DartIsolate> root_isolate,
+                   size_t size)
+      : settings_(settings),
+        isolate_snapshot_(std::move(isolate_snapshot)),
+        context_(context),
+        root_isolate_(std::move(root_isolate)),
+        size_(size) {}
+
+  ~SpawnIsolatePool() {
+    for (const auto& weak_isolate : isolates_) {
+      if (auto isolate = weak_isolate.lock()) {
+        isolate->Shutdown();
+      }
+    }
+  }
+
+  std::shared_ptr<DartIsolate> Take() {
+    std::shared_ptr<DartIsolate> isolate;
+    while (!isolate && !isolates_.empty()) {
+      isolate = isolates_.front().lock();
+      isolates_.pop_front();
+    }
+    ScheduleRefill();
+    return isolate;
+  }
+
+  void ScheduleRefill() {
+    if (refill_pending_ || isolates_.size() >= size_) {
+      return;
+    }
+    refill_pending_ = true;
+    context_.task_runners.GetUITaskRunner()->PostTask(
+        [weak_pool = weak_from_this()]() {
+          if (auto pool = weak_pool.lock()) {
+            pool->Refill();
+          }
+        });
+  }
+
+ private:
+  const Settings settings_;
+  const fml::RefPtr<const DartSnapshot> isolate_snapshot_;
+  const UIDartState::Context context_;
+  const std::weak_ptr<DartIsolate> root_isolate_;
+  const size_t size_;
+  std::deque<std::weak_ptr<DartIsolate>> isolates_;
+  bool refill_pending_ = false;
+
+  void Refill() {
+    TRACE_EVENT0("flutter", "RuntimeController::SpawnIsolatePool::Refill");
+    refill_pending_ = false;
+    auto root_isolate = root_isolate_.lock();
+    if (!root_isolate ||
+        root_isolate->GetPhase() != DartIsolate::Phase::Running) {
+      return;
+    }
+    auto isolate = DartIsolate::CreatePrewarmedRootIsolate(
+        settings_, isolate_snapshot_, context_, *root_isolate);
+    if (!isolate.lock()) {
+      FML_LOG(ERROR) << "Could not create an isolate for the spawn pool.";
+      return;
+    }
+    isolates_.push_back(std::move(isolate));
+    ScheduleRefill();
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SpawnIsolatePool);
+};
+
 RuntimeController::RuntimeController(RuntimeDelegate& p_client,
                                      const TaskRunners& task_runners)
     : client_(p_client), vm_(nullptr), context_(task_runners) {}
@@ -74,12 +154,19 @@ std::unique_ptr<RuntimeController> RuntimeController::Spawn(
                                           p_persistent_isolate_data,     //
                                           spawned_context);              //
   result->spawning_isolate_ = root_isolate_;
+  if (spawn_isolate_pool_) {
+    result->prewarmed_isolate_ = spawn_isolate_pool_->Take();
+  }
   result->platform_data_.viewport_metrics = ViewportMetrics();
   return result;
 }
 
 RuntimeController::~RuntimeController() {
   FML_DCHECK(Dart_CurrentIsolate() == nullptr);
+  spawn_isolate_pool_.reset();
+  if (auto prewarmed_isolate = prewarmed_isolate_.lock()) {
+    prewarmed_isolate->Shutdown();
+  }
   std::shared_ptr<DartIsolate> root_isolate = root_isolate_.lock();
   if (root_isolate) {
     root_isolate->SetReturnCodeCallback(nullptr);
@@ -268,6 +355,21 @@ bool RuntimeController::DispatchPlatformMessage(
   return false;
 }
 
+bool RuntimeController::DispatchPlatformMessages(
+    std::vector<std::unique_ptr<PlatformMessage>> messages) {
+  if (messages.size() == 1) {
+    return DispatchPlatformMessage(std::move(messages.front()));
+  }
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    TRACE_EVENT1("flutter", "RuntimeController::DispatchPlatformMessages",
+                 "count", std::to_string(messages.size()).c_str());
+    platform_configuration->DispatchPlatformMessages(std::move(messages));
+    return true;
+  }
+
+  return false;
+}
+
 bool RuntimeController::DispatchPointerDataPacket(
     const PointerDataPacket& packet) {
   if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
@@ -416,8 +518,10 @@ bool RuntimeController::LaunchRootIsolate(
           dart_entrypoint_args,                           //
           std::move(isolate_configuration),               //
           context_,                                       //
-          spawning_isolate_.lock().get())                 //
+          spawning_isolate_.lock().get(),                 //
+          prewarmed_isolate_.lock())                      //
           .lock();
+  prewarmed_isolate_.reset();
 
   if (!strong_root_isolate) {
     FML_LOG(ERROR) << "Could not create root isolate.";
@@ -450,6 +554,14 @@ bool RuntimeController::LaunchRootIsolate(
 
   FML_DCHECK(Dart_CurrentIsolate() == nullptr);
 
+  if (settings.spawn_isolate_pool_size > 0 && !spawning_isolate_.lock() &&
+      DartVM::IsRunningPrecompiledCode()) {
+    spawn_isolate_pool_ = std::make_shared<SpawnIsolatePool>(
+        settings, isolate_snapshot_, context_, root_isolate_,
+        settings.spawn_isolate_pool_size);
+    spawn_isolate_pool_->ScheduleRefill();
+  }
+
   client_.OnRootIsolateCreated();
 
   return true;
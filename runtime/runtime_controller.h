@@ -92,7 +92,10 @@ class RuntimeController : public PlatformConfigurationClient {
   //----------------------------------------------------------------------------
   /// @brief      Create a RuntimeController that shares as many resources as
   ///             possible with the calling RuntimeController such that together
-  ///             they occupy less memory.
+  ///             they occupy less memory. If the settings this runtime
+  ///             controller was launched with enabled the spawn isolate pool,
+  ///             the spawned runtime controller runs one of the isolates
+  ///             created ahead of time instead of creating a new one.
   /// @return     A RuntimeController with a running isolate.
   /// @see        RuntimeController::RuntimeController
   ///
@@ -394,6 +397,18 @@ class RuntimeController : public PlatformConfigurationClient {
   virtual bool DispatchPlatformMessage(
       std::unique_ptr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Dispatch the specified platform messages to the running root
+  ///             isolate in order, with a single entry into Dart.
+  ///
+  /// @param[in]  messages  The messages to dispatch to the isolate.
+  ///
+  /// @return     If the messages were dispatched to the running root isolate.
+  ///             This may fail is an isolate is not running.
+  ///
+  virtual bool DispatchPlatformMessages(
+      std::vector<std::unique_ptr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Dispatch the specified pointer data message to the running
   ///             root isolate.
@@ -514,7 +529,7 @@ class RuntimeController : public PlatformConfigurationClient {
   /// @param[in]  snapshot_data    Dart snapshot instructions of the loading
   ///                              unit's shared library.
   ///
-  void LoadDartDeferredLibrary(
+  virtual void LoadDartDeferredLibrary(
       intptr_t loading_unit_id,
       std::unique_ptr<const fml::Mapping> snapshot_data,
       std::unique_ptr<const fml::Mapping> snapshot_instructions);
@@ -602,6 +617,14 @@ class RuntimeController : public PlatformConfigurationClient {
   PlatformData platform_data_;
   std::weak_ptr<DartIsolate> root_isolate_;
   std::weak_ptr<DartIsolate> spawning_isolate_;
+  // The isolate taken from the spawn isolate pool of the spawning runtime
+  // controller that is run by |LaunchRootIsolate|, if any.
+  std::weak_ptr<DartIsolate> prewarmed_isolate_;
+  // The pool of isolates created ahead of time for the runtime controllers
+  // spawned from this one. Only set on the first runtime controller of a group
+  // launched with a non-zero |Settings::spawn_isolate_pool_size|.
+  class SpawnIsolatePool;
+  std::shared_ptr<SpawnIsolatePool> spawn_isolate_pool_;
   std::optional<uint32_t> root_isolate_return_code_;
   const fml::closure isolate_create_callback_;
   const fml::closure isolate_shutdown_callback_;
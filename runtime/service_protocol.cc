@@ -37,6 +37,19 @@ const std::string_view ServiceProtocol::kGetSkSLsExtensionName =
 const std::string_view
     ServiceProtocol::kEstimateRasterCacheMemoryExtensionName =
         "_flutter.estimateRasterCacheMemory";
+const std::string_view ServiceProtocol::kGetRasterCacheMetricsExtensionName =
+    "_flutter.getRasterCacheMetrics";
+const std::string_view
+    ServiceProtocol::kGetFrameTimingPercentilesExtensionName =
+        "_flutter.getFrameTimingPercentiles";
+const std::string_view ServiceProtocol::kGetNativeStackSamplesExtensionName =
+    "_flutter.getNativeStackSamples";
+const std::string_view ServiceProtocol::kGetGCMetricsExtensionName =
+    "_flutter.getGCMetrics";
+const std::string_view ServiceProtocol::kGetEngineMemoryUsageExtensionName =
+    "_flutter.getEngineMemoryUsage";
+const std::string_view ServiceProtocol::kGetLayerCostsExtensionName =
+    "_flutter.getLayerCosts";
 const std::string_view
     ServiceProtocol::kRenderFrameWithRasterStatsExtensionName =
         "_flutter.renderFrameWithRasterStats";
@@ -61,6 +74,12 @@ ServiceProtocol::ServiceProtocol()
           kGetDisplayRefreshRateExtensionName,
           kGetSkSLsExtensionName,
           kEstimateRasterCacheMemoryExtensionName,
+          kGetRasterCacheMetricsExtensionName,
+          kGetFrameTimingPercentilesExtensionName,
+          kGetNativeStackSamplesExtensionName,
+          kGetGCMetricsExtensionName,
+          kGetEngineMemoryUsageExtensionName,
+          kGetLayerCostsExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
           kReloadAssetFonts,
       }),
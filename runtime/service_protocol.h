@@ -29,6 +29,12 @@ class ServiceProtocol {
   static const std::string_view kGetDisplayRefreshRateExtensionName;
   static const std::string_view kGetSkSLsExtensionName;
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
+  static const std::string_view kGetRasterCacheMetricsExtensionName;
+  static const std::string_view kGetFrameTimingPercentilesExtensionName;
+  static const std::string_view kGetNativeStackSamplesExtensionName;
+  static const std::string_view kGetGCMetricsExtensionName;
+  static const std::string_view kGetEngineMemoryUsageExtensionName;
+  static const std::string_view kGetLayerCostsExtensionName;
   static const std::string_view kRenderFrameWithRasterStatsExtensionName;
   static const std::string_view kReloadAssetFonts;
 
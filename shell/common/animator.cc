@@ -5,6 +5,8 @@
 #include "flutter/shell/common/animator.h"
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/fml/make_copyable.h"
+#include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -19,26 +21,39 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+uint32_t GetDefaultPipelineDepth(const TaskRunners& task_runners) {
+#if SHELL_ENABLE_METAL
+  return 2;
+#else   // SHELL_ENABLE_METAL
+  // TODO(dnfield): We should remove this logic and set the pipeline depth
+  // back to 2 in this case. See
+  // https://github.com/flutter/engine/pull/9132 for discussion.
+  return task_runners.GetPlatformTaskRunner() ==
+                 task_runners.GetRasterTaskRunner()
+             ? 1
+             : 2;
+#endif  // SHELL_ENABLE_METAL
+}
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
                    const TaskRunners& task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   uint32_t pipeline_depth,
+                   fml::TimeDelta latency_budget,
+                   std::shared_ptr<const FrameDeadlineScheduler>
+                       deadline_scheduler,
+                   std::unique_ptr<FrameRateSelector> frame_rate_selector)
     : delegate_(delegate),
       task_runners_(task_runners),
       waiter_(std::move(waiter)),
-#if SHELL_ENABLE_METAL
-      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(2)),
-#else   // SHELL_ENABLE_METAL
-      // TODO(dnfield): We should remove this logic and set the pipeline depth
-      // back to 2 in this case. See
-      // https://github.com/flutter/engine/pull/9132 for discussion.
       layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(
-          task_runners.GetPlatformTaskRunner() ==
-                  task_runners.GetRasterTaskRunner()
-              ? 1
-              : 2)),
-#endif  // SHELL_ENABLE_METAL
+          pipeline_depth > 0 ? pipeline_depth
+                             : GetDefaultPipelineDepth(task_runners))),
+      latency_budget_(latency_budget),
+      deadline_scheduler_(std::move(deadline_scheduler)),
+      frame_rate_selector_(std::move(frame_rate_selector)),
       pending_frame_semaphore_(1),
       weak_factory_(this) {
 }
@@ -57,6 +72,13 @@ void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
       });
 }
 
+void Animator::NotifyPointerInput() {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (frame_rate_selector_) {
+    frame_rate_selector_->OnPointerInput(fml::TimePoint::Now());
+  }
+}
+
 void Animator::BeginFrame(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
   TRACE_EVENT_ASYNC_END0("flutter", "Frame Request Pending",
@@ -78,7 +100,18 @@ void Animator::BeginFrame(
   regenerate_layer_tree_ = false;
   pending_frame_semaphore_.Signal();
 
+  // The frame starts, idle tasks have to wait for it to end.
+  SetIdlePeriodEnd(fml::TimePoint::Min());
+
   if (!producer_continuation_) {
+    if (IsOverLatencyBudget()) {
+      // Producing ahead of the rasterizer would show this frame too late.
+      // Wait for the queued frames to be consumed first.
+      TRACE_EVENT0("flutter", "PipelineOverLatencyBudget");
+      RequestFrame();
+      return;
+    }
+
     // We may already have a valid pipeline continuation in case a previous
     // begin frame did not result in an Animator::Render. Simply reuse that
     // instead of asking the pipeline for a fresh continuation.
@@ -122,12 +155,39 @@ void Animator::BeginFrame(
             TRACE_EVENT0("flutter", "BeginFrame idle callback");
             self->delegate_.OnAnimatorNotifyIdle(
                 now + fml::TimeDelta::FromMilliseconds(100));
+            self->SetIdlePeriodEnd(fml::TimePoint::Now() +
+                                   fml::TimeDelta::FromMilliseconds(100));
           }
         },
         kNotifyIdleTaskWaitTime);
   }
 }
 
+void Animator::ScheduleBeginFrame(
+    std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+  if (deadline_scheduler_) {
+    const auto build_start = deadline_scheduler_->GetBuildStartTime(
+        frame_timings_recorder->GetVsyncStartTime(),
+        frame_timings_recorder->GetVsyncTargetTime());
+    if (build_start > fml::TimePoint::Now()) {
+      TRACE_EVENT0("flutter", "Animator::DeferBeginFrame");
+      // Until the frame starts, the UI thread is idle.
+      SetIdlePeriodEnd(build_start);
+      task_runners_.GetUITaskRunner()->PostTaskForTime(
+          fml::MakeCopyable(
+              [self = weak_factory_.GetWeakPtr(),
+               recorder = std::move(frame_timings_recorder)]() mutable {
+                if (self) {
+                  self->BeginFrame(std::move(recorder));
+                }
+              }),
+          build_start);
+      return;
+    }
+  }
+  BeginFrame(std::move(frame_timings_recorder));
+}
+
 void Animator::Render(std::shared_ptr<flutter::LayerTree> layer_tree) {
   has_rendered_ = true;
   last_layer_tree_size_ = layer_tree->frame_size();
@@ -147,6 +207,10 @@ void Animator::Render(std::shared_ptr<flutter::LayerTree> layer_tree) {
   delegate_.OnAnimatorUpdateLatestFrameTargetTime(
       frame_timings_recorder_->GetVsyncTargetTime());
 
+  // The UI thread is done with this frame, the time until its target time can
+  // be used by idle tasks.
+  SetIdlePeriodEnd(frame_timings_recorder_->GetVsyncTargetTime());
+
   auto layer_tree_item = std::make_unique<LayerTreeItem>(
       std::move(layer_tree), std::move(frame_timings_recorder_));
   // Commit the pending continuation.
@@ -168,6 +232,32 @@ void Animator::Render(std::shared_ptr<flutter::LayerTree> layer_tree) {
   delegate_.OnAnimatorDraw(layer_tree_pipeline_);
 }
 
+void Animator::SetIdlePeriodEnd(fml::TimePoint end) {
+  idle_period_end_ = end;
+  fml::MessageLoopTaskQueues::GetInstance()->SetIdlePeriodEnd(
+      task_runners_.GetUITaskRunner()->GetTaskQueueId(), end);
+}
+
+fml::TimePoint Animator::GetIdlePeriodEnd() const {
+  return idle_period_end_;
+}
+
+bool Animator::IsOverLatencyBudget() const {
+  if (latency_budget_ <= fml::TimeDelta::Zero()) {
+    return false;
+  }
+  // Each frame waiting for the rasterizer delays this one by about a frame
+  // interval past its vsync target time.
+  const auto queued_frames = layer_tree_pipeline_->GetQueueSize();
+  if (queued_frames == 0) {
+    return false;
+  }
+  const auto frame_interval = frame_timings_recorder_->GetVsyncTargetTime() -
+                              frame_timings_recorder_->GetVsyncStartTime();
+  return frame_interval * static_cast<int64_t>(queued_frames) >
+         latency_budget_;
+}
+
 const std::weak_ptr<VsyncWaiter> Animator::GetVsyncWaiter() const {
   std::weak_ptr<VsyncWaiter> weak = waiter_;
   return weak;
@@ -229,6 +319,10 @@ void Animator::RequestFrame(bool regenerate_layer_tree) {
 }
 
 void Animator::AwaitVSync() {
+  if (frame_rate_selector_) {
+    waiter_->SetPreferredFrameRate(
+        frame_rate_selector_->GetPreferredFrameRate(fml::TimePoint::Now()));
+  }
   waiter_->AsyncWaitForVsync(
       [self = weak_factory_.GetWeakPtr()](
           std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
@@ -236,7 +330,7 @@ void Animator::AwaitVSync() {
           if (self->CanReuseLastLayerTree()) {
             self->DrawLastLayerTree(std::move(frame_timings_recorder));
           } else {
-            self->BeginFrame(std::move(frame_timings_recorder));
+            self->ScheduleBeginFrame(std::move(frame_timings_recorder));
           }
         }
       });
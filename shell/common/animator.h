@@ -13,6 +13,8 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_deadline_scheduler.h"
+#include "flutter/shell/common/frame_rate_selector.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -46,9 +48,30 @@ class Animator final {
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
   };
 
+  //--------------------------------------------------------------------------
+  /// @param[in]  pipeline_depth  The number of layer trees that may be
+  ///                             produced ahead of the rasterizer, or 0 for
+  ///                             the platform default.
+  /// @param[in]  latency_budget  How much later than its vsync target time a
+  ///                             layer tree produced ahead of the rasterizer
+  ///                             may be expected to be displayed. Frames are
+  ///                             not produced past this budget. Zero means no
+  ///                             limit.
+  /// @param[in]  deadline_scheduler  If set, frames start as late after their
+  ///                                 vsync as it predicts they can while still
+  ///                                 being rasterized before their target
+  ///                                 time, instead of right at their vsync.
+  /// @param[in]  frame_rate_selector  If set, picks the frame rate the vsync
+  ///                                  waiter is hinted at before each frame.
+  ///
   Animator(Delegate& delegate,
            const TaskRunners& task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           uint32_t pipeline_depth = 0,
+           fml::TimeDelta latency_budget = fml::TimeDelta::Zero(),
+           std::shared_ptr<const FrameDeadlineScheduler> deadline_scheduler =
+               nullptr,
+           std::unique_ptr<FrameRateSelector> frame_rate_selector = nullptr);
 
   ~Animator();
 
@@ -81,11 +104,30 @@ class Animator final {
   // rendering.
   void EnqueueTraceFlowId(uint64_t trace_flow_id);
 
+  // Lets the frame rate selector know that the user is interacting with the
+  // app. Must be called on the UI thread.
+  void NotifyPointerInput();
+
+  // The end of the current idle period of the UI task runner, which lasts until
+  // the next frame is predicted to start building, or a time in the past while
+  // a frame is being produced. Must be called on the UI thread.
+  fml::TimePoint GetIdlePeriodEnd() const;
+
  private:
   void BeginFrame(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
+  // Begins the frame now, or at the time the deadline scheduler predicts it
+  // must start at.
+  void ScheduleBeginFrame(
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
+
   bool CanReuseLastLayerTree();
 
+  bool IsOverLatencyBudget() const;
+
+  // Lets the idle tasks of the UI task runner run until |end|.
+  void SetIdlePeriodEnd(fml::TimePoint end);
+
   void DrawLastLayerTree(
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
@@ -102,6 +144,9 @@ class Animator final {
   uint64_t frame_request_number_ = 1;
   fml::TimeDelta dart_frame_deadline_;
   std::shared_ptr<LayerTreePipeline> layer_tree_pipeline_;
+  fml::TimeDelta latency_budget_;
+  std::shared_ptr<const FrameDeadlineScheduler> deadline_scheduler_;
+  std::unique_ptr<FrameRateSelector> frame_rate_selector_;
   fml::Semaphore pending_frame_semaphore_;
   LayerTreePipeline::ProducerContinuation producer_continuation_;
   bool regenerate_layer_tree_ = false;
@@ -109,6 +154,7 @@ class Animator final {
   SkISize last_layer_tree_size_ = {0, 0};
   std::deque<uint64_t> trace_flow_ids_;
   bool has_rendered_ = false;
+  fml::TimePoint idle_period_end_;
 
   fml::WeakPtrFactory<Animator> weak_factory_;
 
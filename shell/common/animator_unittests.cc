@@ -44,6 +44,22 @@ class FakeAnimatorDelegate : public Animator::Delegate {
   bool notify_idle_called_ = false;
 };
 
+// Fires each vsync right away, with a target time an interval later.
+class ImmediateVsyncWaiter : public VsyncWaiter {
+ public:
+  ImmediateVsyncWaiter(TaskRunners task_runners, fml::TimeDelta interval)
+      : VsyncWaiter(std::move(task_runners)), interval_(interval) {}
+
+ protected:
+  void AwaitVSync() override {
+    const auto now = fml::TimePoint::Now();
+    FireCallback(now, now + interval_);
+  }
+
+ private:
+  const fml::TimeDelta interval_;
+};
+
 TEST_F(ShellTest, VSyncTargetTime) {
   // Add native callbacks to listen for window.onBeginFrame
   int64_t target_time;
@@ -247,6 +263,58 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyDelegateIfPipelineIsNotEmpty) {
   PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
 }
 
+TEST_F(ShellTest, AnimatorDefersBeginFrameToThePredictedStartTime) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+
+  // Frames are predicted to take 10ms of a 50ms interval.
+  auto deadline_scheduler = std::make_shared<FrameDeadlineScheduler>();
+  for (size_t i = 0; i < FrameDeadlineScheduler::kFrameHistorySize; i++) {
+    FrameTiming timing;
+    const auto start = fml::TimePoint::Now();
+    timing.Set(FrameTiming::kBuildStart, start);
+    timing.Set(FrameTiming::kBuildFinish, start);
+    timing.Set(FrameTiming::kRasterStart, start);
+    timing.Set(FrameTiming::kRasterFinish,
+               start + fml::TimeDelta::FromMilliseconds(10));
+    deadline_scheduler->AddFrameTiming(timing);
+  }
+  const auto interval = fml::TimeDelta::FromMilliseconds(50);
+
+  std::shared_ptr<Animator> animator;
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    auto vsync_waiter = static_cast<std::unique_ptr<VsyncWaiter>>(
+        std::make_unique<ImmediateVsyncWaiter>(task_runners, interval));
+    animator = std::make_unique<Animator>(delegate, task_runners,
+                                          std::move(vsync_waiter), 0,
+                                          fml::TimeDelta::Zero(),
+                                          deadline_scheduler);
+  });
+
+  fml::AutoResetWaitableEvent begin_frame_latch;
+  fml::TimePoint begin_frame_time;
+  EXPECT_CALL(delegate, OnAnimatorBeginFrame)
+      .WillOnce([&](fml::TimePoint frame_target_time, uint64_t frame_number) {
+        begin_frame_time = fml::TimePoint::Now();
+        begin_frame_latch.Signal();
+      });
+
+  const auto request_time = fml::TimePoint::Now();
+  task_runners.GetUITaskRunner()->PostTask([&] { animator->RequestFrame(); });
+  begin_frame_latch.Wait();
+  ASSERT_GE(begin_frame_time - request_time,
+            interval - fml::TimeDelta::FromMilliseconds(10) -
+                FrameDeadlineScheduler::kSafetyMargin);
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
+}
+
 }  // namespace testing
 }  // namespace flutter
 
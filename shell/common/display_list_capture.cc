@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/display_list_capture.h"
+
+#include <iomanip>
+#include <sstream>
+
+#include "flutter/display_list/dl_serialization.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+std::unique_ptr<DisplayListCapture> DisplayListCapture::Create(
+    const Settings& settings,
+    fml::RefPtr<fml::TaskRunner> io_task_runner) {
+  if (settings.display_list_capture_frame_count == 0u) {
+    return nullptr;
+  }
+  std::string path = settings.display_list_capture_directory;
+  if (path.empty()) {
+    path = fml::CreateTemporaryDirectory();
+  }
+  auto directory = std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      path.c_str(), true, fml::FilePermission::kReadWrite));
+  if (!directory->is_valid()) {
+    FML_LOG(ERROR) << "Could not open the DisplayList capture directory "
+                   << path << ".";
+    return nullptr;
+  }
+  FML_LOG(INFO) << "Capturing "
+                << settings.display_list_capture_frame_count
+                << " frames as DisplayLists to " << path << ".";
+  return std::make_unique<DisplayListCapture>(
+      std::move(directory), settings.display_list_capture_frame_count,
+      std::move(io_task_runner));
+}
+
+DisplayListCapture::DisplayListCapture(
+    std::shared_ptr<fml::UniqueFD> directory,
+    uint32_t frame_count,
+    fml::RefPtr<fml::TaskRunner> io_task_runner)
+    : directory_(std::move(directory)),
+      frame_count_(frame_count),
+      io_task_runner_(std::move(io_task_runner)) {}
+
+DisplayListCapture::~DisplayListCapture() = default;
+
+bool DisplayListCapture::CaptureFrame(
+    uint64_t frame_number,
+    LayerTree& layer_tree,
+    const std::shared_ptr<TextureRegistry>& texture_registry,
+    GrDirectContext* gr_context) {
+  if (captured_frame_count_ >= frame_count_) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "DisplayListCapture::CaptureFrame");
+
+  DlCapturedFrame frame;
+  frame.frame_number = frame_number;
+  frame.frame_size = layer_tree.frame_size();
+  frame.device_pixel_ratio = layer_tree.device_pixel_ratio();
+  frame.display_list = layer_tree.Flatten(
+      SkRect::Make(layer_tree.frame_size()), texture_registry, gr_context);
+
+  // Names sort in the order the frames were captured in.
+  std::stringstream name_stream;
+  name_stream << "frame_" << std::setw(6) << std::setfill('0')
+              << captured_frame_count_ << ".dlframe";
+  captured_frame_count_++;
+
+  // DisplayLists are immutable, so the serialization is safely done off of
+  // the raster thread.
+  io_task_runner_->PostTask([directory = directory_, frame = std::move(frame),
+                             file_name = name_stream.str()]() {
+    TRACE_EVENT0("flutter", "DisplayListCapture::WriteFrame");
+    auto data = DlSerializeCapturedFrame(frame);
+    fml::NonOwnedMapping mapping(data->bytes(), data->size());
+    if (!fml::WriteAtomically(*directory, file_name.c_str(), mapping)) {
+      FML_LOG(ERROR) << "Could not write the captured frame " << file_name
+                     << ".";
+    }
+  });
+  return captured_frame_count_ < frame_count_;
+}
+
+}  // namespace flutter
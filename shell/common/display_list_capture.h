@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_DISPLAY_LIST_CAPTURE_H_
+#define FLUTTER_SHELL_COMMON_DISPLAY_LIST_CAPTURE_H_
+
+#include <memory>
+#include <string>
+
+#include "flutter/common/settings.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Writes the frames rasterized by the engine to disk as
+///             serialized DisplayLists, so that they can be replayed outside
+///             of the app by the dl_replay tool.
+///
+///             Each frame has its layer tree flattened into a single
+///             DisplayList on the raster thread, which is then serialized
+///             and written on the IO thread, one file per frame.
+///
+///             Enabled with `--capture-display-lists=<frame count>`.
+///
+class DisplayListCapture {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the capture requested by the settings, or returns
+  ///             nullptr when no capture was requested or the capture
+  ///             directory could not be opened.
+  ///
+  static std::unique_ptr<DisplayListCapture> Create(
+      const Settings& settings,
+      fml::RefPtr<fml::TaskRunner> io_task_runner);
+
+  DisplayListCapture(std::shared_ptr<fml::UniqueFD> directory,
+                     uint32_t frame_count,
+                     fml::RefPtr<fml::TaskRunner> io_task_runner);
+
+  ~DisplayListCapture();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Captures a frame that was just rasterized.
+  ///
+  /// @return     Whether more frames are to be captured.
+  ///
+  bool CaptureFrame(uint64_t frame_number,
+                    LayerTree& layer_tree,
+                    const std::shared_ptr<TextureRegistry>& texture_registry,
+                    GrDirectContext* gr_context);
+
+ private:
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  const uint32_t frame_count_;
+  const fml::RefPtr<fml::TaskRunner> io_task_runner_;
+  uint32_t captured_frame_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListCapture);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_DISPLAY_LIST_CAPTURE_H_
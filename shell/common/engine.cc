@@ -5,6 +5,7 @@
 #include "flutter/shell/common/engine.h"
 
 #include <cstring>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
@@ -30,6 +31,13 @@ static constexpr char kLocalizationChannel[] = "flutter/localization";
 static constexpr char kSettingsChannel[] = "flutter/settings";
 static constexpr char kIsolateChannel[] = "flutter/isolate";
 
+// Assets that the framework reads while the root isolate starts up, before
+// the first frame. They are prefetched as soon as the asset manager is known.
+static const char* const kStartupAssets[] = {
+    "AssetManifest.bin",
+    "AssetManifest.json",
+};
+
 namespace {
 fml::MallocMapping MakeMapping(const std::string& str) {
   return fml::MallocMapping::Copy(str.c_str(), str.length());
@@ -56,6 +64,7 @@ Engine::Engine(
                                         std::move(image_decoder_task_runner),
                                         std::move(io_manager))),
       task_runners_(task_runners),
+      gc_scheduler_(*this, task_runners.GetUITaskRunner()),
       weak_factory_(this) {
   pointer_data_dispatcher_ = dispatcher_maker(*this);
 }
@@ -175,9 +184,18 @@ bool Engine::UpdateAssetManager(
     return false;
   }
 
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner;
+  if (DartVM* vm = runtime_controller_ ? runtime_controller_->GetDartVM()
+                                       : nullptr) {
+    concurrent_task_runner = vm->GetConcurrentWorkerTaskRunner();
+    asset_manager_->Prefetch(
+        {std::begin(kStartupAssets), std::end(kStartupAssets)},
+        concurrent_task_runner);
+  }
+
   // Using libTXT as the text engine.
   if (settings_.use_asset_fonts) {
-    font_collection_->RegisterFonts(asset_manager_);
+    font_collection_->RegisterFonts(asset_manager_, concurrent_task_runner);
   }
 
   if (settings_.use_test_fonts) {
@@ -258,14 +276,38 @@ void Engine::ReportTimings(std::vector<int64_t> timings) {
 }
 
 void Engine::NotifyIdle(fml::TimeDelta deadline) {
-  runtime_controller_->NotifyIdle(deadline);
+  gc_scheduler_.NotifyIdle(deadline);
 }
 
 void Engine::NotifyDestroyed() {
   TRACE_EVENT0("flutter", "Engine::NotifyDestroyed");
+  gc_scheduler_.ScheduleCollection(
+      GCScheduler::CollectionReason::kViewDestroyed);
+}
+
+void Engine::NotifyLowMemoryWarning() {
+  TRACE_EVENT0("flutter", "Engine::NotifyLowMemoryWarning");
+  gc_scheduler_.ScheduleCollection(GCScheduler::CollectionReason::kLowMemory);
+}
+
+fml::TimePoint Engine::GetGCIdlePeriodEnd() {
+  return animator_ ? animator_->GetIdlePeriodEnd() : fml::TimePoint();
+}
+
+bool Engine::OnGCSchedulerNotifyIdle(fml::TimeDelta deadline) {
+  return runtime_controller_->NotifyIdle(deadline);
+}
+
+void Engine::OnGCSchedulerNotifyDestroyed() {
   runtime_controller_->NotifyDestroyed();
 }
 
+void Engine::OnGCSchedulerNotifyLowMemory() {
+  // This does not require a current isolate but does require a running VM,
+  // which the runtime controller keeps alive.
+  ::Dart_NotifyLowMemory();
+}
+
 std::optional<uint32_t> Engine::GetUIIsolateReturnCode() {
   return runtime_controller_->GetRootIsolateReturnCode();
 }
@@ -319,6 +361,35 @@ void Engine::DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message) {
   FML_DLOG(WARNING) << "Dropping platform message on channel: " << channel;
 }
 
+void Engine::DispatchPlatformMessages(
+    std::vector<std::unique_ptr<PlatformMessage>> messages) {
+  std::vector<std::unique_ptr<PlatformMessage>> batch;
+  auto dispatch_batch = [&]() {
+    if (batch.empty()) {
+      return;
+    }
+    size_t count = batch.size();
+    if (!runtime_controller_->IsRootIsolateRunning() ||
+        !runtime_controller_->DispatchPlatformMessages(std::move(batch))) {
+      FML_DLOG(WARNING) << "Dropping " << count << " platform messages.";
+    }
+    batch.clear();
+  };
+  for (auto& message : messages) {
+    // Messages on the channels the engine intercepts keep going through
+    // |DispatchPlatformMessage|, after the messages sent before them.
+    const std::string& channel = message->channel();
+    if (channel == kLifecycleChannel || channel == kLocalizationChannel ||
+        channel == kSettingsChannel || channel == kNavigationChannel) {
+      dispatch_batch();
+      DispatchPlatformMessage(std::move(message));
+    } else {
+      batch.push_back(std::move(message));
+    }
+  }
+  dispatch_batch();
+}
+
 bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
   std::string state(reinterpret_cast<const char*>(data.GetMapping()),
@@ -502,6 +573,7 @@ FontCollection& Engine::GetFontCollection() {
 void Engine::DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
                               uint64_t trace_flow_id) {
   animator_->EnqueueTraceFlowId(trace_flow_id);
+  animator_->NotifyPointerInput();
   if (runtime_controller_) {
     runtime_controller_->DispatchPointerDataPacket(*packet);
   }
@@ -548,7 +620,24 @@ const std::vector<std::string>& Engine::GetLastEntrypointArgs() const {
 
 // |RuntimeDelegate|
 void Engine::RequestDartDeferredLibrary(intptr_t loading_unit_id) {
-  return delegate_.RequestDartDeferredLibrary(loading_unit_id);
+  auto prefetched = prefetched_loading_units_.find(loading_unit_id);
+  if (prefetched == prefetched_loading_units_.end()) {
+    return delegate_.RequestDartDeferredLibrary(loading_unit_id);
+  }
+  TRACE_EVENT1("flutter", "Engine::LoadPrefetchedDartDeferredLibrary",
+               "loading_unit_id", std::to_string(loading_unit_id).c_str());
+  // The request is completed in a task of its own, as the embedder's would
+  // be, rather than from within the deferred load handler of the Dart VM.
+  task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
+      [engine = GetWeakPtr(), loading_unit_id,
+       unit = std::move(prefetched->second)]() mutable {
+        if (engine) {
+          engine->LoadDartDeferredLibrary(
+              loading_unit_id, std::move(unit.snapshot_data),
+              std::move(unit.snapshot_instructions));
+        }
+      }));
+  prefetched_loading_units_.erase(prefetched);
 }
 
 std::weak_ptr<PlatformMessageHandler> Engine::GetPlatformMessageHandler()
@@ -579,6 +668,14 @@ void Engine::LoadDartDeferredLibraryError(intptr_t loading_unit_id,
   }
 }
 
+void Engine::PrefetchDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::unique_ptr<const fml::Mapping> snapshot_data,
+    std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  prefetched_loading_units_[loading_unit_id] = {
+      std::move(snapshot_data), std::move(snapshot_instructions)};
+}
+
 const std::weak_ptr<VsyncWaiter> Engine::GetVsyncWaiter() const {
   return animator_->GetVsyncWaiter();
 }
@@ -7,6 +7,8 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/common/task_runners.h"
@@ -27,6 +29,7 @@
 #include "flutter/runtime/runtime_delegate.h"
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
+#include "flutter/shell/common/gc_scheduler.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/rasterizer.h"
@@ -72,7 +75,9 @@ namespace flutter {
 ///           name and it does happen to be one of the older classes in the
 ///           repository.
 ///
-class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
+class Engine final : public RuntimeDelegate,
+                     PointerDataDispatcher::Delegate,
+                     GCScheduler::Delegate {
  public:
   //----------------------------------------------------------------------------
   /// @brief      Indicates the result of the call to `Engine::Run`.
@@ -558,9 +563,24 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   /// @brief      Notifies the engine that the attached flutter view has been
   ///             destroyed.
   ///             This enables the engine to notify the Dart VM so it can do
-  ///             some cleanp activities.
+  ///             some cleanp activities. The cleanup is deferred to the next
+  ///             idle period of the UI task runner.
   void NotifyDestroyed();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that the system is low on memory. The Dart
+  ///             VM is asked to collect as much garbage as it can in the next
+  ///             idle period of the UI task runner, so the collection doesn't
+  ///             delay a frame.
+  void NotifyLowMemoryWarning();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The metrics of the garbage collections this engine scheduled,
+  ///             including the number that may have delayed frames.
+  const GCScheduler::Metrics& GetGCMetrics() const {
+    return gc_scheduler_.GetMetrics();
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      Dart code cannot fully measure the time it takes for a
   ///             specific frame to be rendered. This is because Dart code only
@@ -695,6 +715,18 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that the embedder has sent it several
+  ///             messages in a burst. Messages that the engine does not
+  ///             handle itself are delivered to the Dart application in
+  ///             order, with as few entries into Dart as possible.
+  ///
+  /// @param[in]  messages  The messages sent from the embedder to the Dart
+  ///                       application, in the order they were sent.
+  ///
+  void DispatchPlatformMessages(
+      std::vector<std::unique_ptr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder has sent it a pointer
   ///             data packet. A pointer data packet may contain multiple
@@ -878,6 +910,29 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
                                     const std::string& error_message,
                                     bool transient);
 
+  //--------------------------------------------------------------------------
+  /// @brief      Holds on to the mappings of a deferred library that is likely
+  ///             to be loaded soon. When the Dart VM requests the loading
+  ///             unit, the request is completed with these mappings instead
+  ///             of being forwarded to the delegate.
+  ///
+  ///             The pages of the mappings should already have been faulted
+  ///             in, as they are loaded on the UI thread.
+  ///
+  /// @param[in]  loading_unit_id        The unique id of the deferred
+  ///                                    library's loading unit.
+  ///
+  /// @param[in]  snapshot_data          Dart snapshot data of the loading
+  ///                                    unit's shared library.
+  ///
+  /// @param[in]  snapshot_instructions  Dart snapshot instructions of the
+  ///                                    loading unit's shared library.
+  ///
+  void PrefetchDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions);
+
   //--------------------------------------------------------------------------
   /// @brief      Accessor for the RuntimeController.
   ///
@@ -924,6 +979,18 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
 
   void SetNeedsReportTimings(bool value) override;
 
+  // |GCScheduler::Delegate|
+  fml::TimePoint GetGCIdlePeriodEnd() override;
+
+  // |GCScheduler::Delegate|
+  bool OnGCSchedulerNotifyIdle(fml::TimeDelta deadline) override;
+
+  // |GCScheduler::Delegate|
+  void OnGCSchedulerNotifyDestroyed() override;
+
+  // |GCScheduler::Delegate|
+  void OnGCSchedulerNotifyLowMemory() override;
+
   bool HandleLifecyclePlatformMessage(PlatformMessage* message);
 
   bool HandleNavigationPlatformMessage(
@@ -937,6 +1004,11 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
 
   bool GetAssetAsBuffer(const std::string& name, std::vector<uint8_t>* data);
 
+  struct PrefetchedLoadingUnit {
+    std::unique_ptr<const fml::Mapping> snapshot_data;
+    std::unique_ptr<const fml::Mapping> snapshot_instructions;
+  };
+
   friend class testing::ShellTest;
 
   Engine::Delegate& delegate_;
@@ -955,9 +1027,11 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   std::string initial_route_;
   std::shared_ptr<AssetManager> asset_manager_;
   std::shared_ptr<FontCollection> font_collection_;
+  std::unordered_map<intptr_t, PrefetchedLoadingUnit> prefetched_loading_units_;
   const std::unique_ptr<ImageDecoder> image_decoder_;
   ImageGeneratorRegistry image_generator_registry_;
   TaskRunners task_runners_;
+  GCScheduler gc_scheduler_;
   fml::WeakPtrFactory<Engine> weak_factory_;  // Must be the last member.
   FML_DISALLOW_COPY_AND_ASSIGN(Engine);
 };
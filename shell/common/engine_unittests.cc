@@ -75,6 +75,12 @@ class MockRuntimeController : public RuntimeController {
       : RuntimeController(client, p_task_runners) {}
   MOCK_METHOD0(IsRootIsolateRunning, bool());
   MOCK_METHOD1(DispatchPlatformMessage, bool(std::unique_ptr<PlatformMessage>));
+  MOCK_METHOD1(DispatchPlatformMessages,
+               bool(std::vector<std::unique_ptr<PlatformMessage>>));
+  MOCK_METHOD3(LoadDartDeferredLibrary,
+               void(intptr_t,
+                    std::unique_ptr<const fml::Mapping>,
+                    std::unique_ptr<const fml::Mapping>));
   MOCK_METHOD3(LoadDartDeferredLibraryError,
                void(intptr_t, const std::string, bool));
   MOCK_CONST_METHOD0(GetDartVM, DartVM*());
@@ -193,6 +199,50 @@ TEST_F(EngineTest, DispatchPlatformMessageUnknown) {
   });
 }
 
+TEST_F(EngineTest, DispatchPlatformMessagesBatchesMessagesInOrder) {
+  PostUITaskSync([this] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    EXPECT_CALL(*mock_runtime_controller, IsRootIsolateRunning())
+        .WillRepeatedly(::testing::Return(true));
+    {
+      ::testing::InSequence sequence;
+      EXPECT_CALL(*mock_runtime_controller,
+                  DispatchPlatformMessages(::testing::SizeIs(2)))
+          .WillOnce(::testing::Return(true));
+      EXPECT_CALL(*mock_runtime_controller,
+                  DispatchPlatformMessage(::testing::_))
+          .WillOnce(::testing::Return(true));
+      EXPECT_CALL(*mock_runtime_controller,
+                  DispatchPlatformMessages(::testing::SizeIs(1)))
+          .WillOnce(::testing::Return(true));
+    }
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller));
+
+    fml::RefPtr<PlatformMessageResponse> response =
+        fml::MakeRefCounted<MockResponse>();
+    std::vector<std::unique_ptr<PlatformMessage>> messages;
+    messages.push_back(std::make_unique<PlatformMessage>("foo", response));
+    messages.push_back(std::make_unique<PlatformMessage>("bar", response));
+    messages.push_back(
+        MakePlatformMessage("flutter/navigation",
+                            {{"method", "pushRoute"}, {"args", "route"}},
+                            response));
+    messages.push_back(std::make_unique<PlatformMessage>("baz", response));
+    engine->DispatchPlatformMessages(std::move(messages));
+  });
+}
+
 TEST_F(EngineTest, DispatchPlatformMessageInitialRoute) {
   PostUITaskSync([this] {
     MockRuntimeDelegate client;
@@ -411,4 +461,39 @@ TEST_F(EngineTest, PassesLoadDartDeferredLibraryErrorToRuntime) {
   });
 }
 
+TEST_F(EngineTest, LoadsPrefetchedDartDeferredLibraryWithoutRequest) {
+  MockRuntimeDelegate client;
+  std::unique_ptr<Engine> engine;
+  PostUITaskSync([this, &client, &engine] {
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    EXPECT_CALL(*mock_runtime_controller, IsRootIsolateRunning())
+        .WillRepeatedly(::testing::Return(true));
+    EXPECT_CALL(*mock_runtime_controller,
+                LoadDartDeferredLibrary(2, ::testing::_, ::testing::_))
+        .Times(1);
+    EXPECT_CALL(delegate_, RequestDartDeferredLibrary(2)).Times(0);
+    EXPECT_CALL(delegate_, RequestDartDeferredLibrary(3)).Times(1);
+    engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller));
+
+    engine->PrefetchDartDeferredLibrary(
+        2, std::make_unique<fml::DataMapping>(std::vector<uint8_t>{1}),
+        std::make_unique<fml::DataMapping>(std::vector<uint8_t>{2}));
+    RuntimeDelegate& runtime_delegate = *engine;
+    runtime_delegate.RequestDartDeferredLibrary(2);
+    runtime_delegate.RequestDartDeferredLibrary(3);
+  });
+  // Destroys the engine after the task that loads the prefetched library.
+  PostUITaskSync([&engine] { engine.reset(); });
+}
+
 }  // namespace flutter
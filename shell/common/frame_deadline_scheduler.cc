@@ -0,0 +1,55 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_deadline_scheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace flutter {
+
+FrameDeadlineScheduler::FrameDeadlineScheduler() = default;
+
+FrameDeadlineScheduler::~FrameDeadlineScheduler() = default;
+
+void FrameDeadlineScheduler::AddFrameTiming(const FrameTiming& timing) {
+  // The time the frame waited for the raster thread doesn't count, starting
+  // the frame later doesn't make it any shorter.
+  const auto frame_time = (timing.Get(FrameTiming::kBuildFinish) -
+                           timing.Get(FrameTiming::kBuildStart)) +
+                          (timing.Get(FrameTiming::kRasterFinish) -
+                           timing.Get(FrameTiming::kRasterStart));
+  std::scoped_lock lock(mutex_);
+  frame_times_.push_back(frame_time);
+  if (frame_times_.size() > kFrameHistorySize) {
+    frame_times_.pop_front();
+  }
+}
+
+fml::TimeDelta FrameDeadlineScheduler::GetPredictedFrameTime() const {
+  std::vector<fml::TimeDelta> frame_times;
+  {
+    std::scoped_lock lock(mutex_);
+    if (frame_times_.size() < kMinFrameHistorySize) {
+      return fml::TimeDelta::Zero();
+    }
+    frame_times.assign(frame_times_.begin(), frame_times_.end());
+  }
+  const auto percentile = frame_times.begin() + frame_times.size() * 9 / 10;
+  std::nth_element(frame_times.begin(), percentile, frame_times.end());
+  return *percentile;
+}
+
+fml::TimePoint FrameDeadlineScheduler::GetBuildStartTime(
+    fml::TimePoint vsync_start,
+    fml::TimePoint vsync_target) const {
+  const auto predicted_frame_time = GetPredictedFrameTime();
+  if (predicted_frame_time <= fml::TimeDelta::Zero()) {
+    return vsync_start;
+  }
+  return std::max(vsync_start,
+                  vsync_target - predicted_frame_time - kSafetyMargin);
+}
+
+}  // namespace flutter
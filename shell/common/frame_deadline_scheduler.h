@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_DEADLINE_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_FRAME_DEADLINE_SCHEDULER_H_
+
+#include <deque>
+#include <mutex>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Predicts how long the next frames take to build and rasterize from the
+/// timings of the recent ones, so the |Animator| can start building each frame
+/// as late after its vsync as possible while still rasterizing it before its
+/// target time. Input that arrives in the meantime makes it into the frame
+/// instead of the next one.
+///
+/// Timings are added on the raster thread, and predictions are made on the UI
+/// thread.
+class FrameDeadlineScheduler {
+ public:
+  /// The number of recent frames the predictions are made from.
+  static constexpr size_t kFrameHistorySize = 30;
+
+  /// Frames start right at their vsync until this many frames were timed.
+  static constexpr size_t kMinFrameHistorySize = 5;
+
+  /// How much earlier than the predicted time frames start, for the jitter
+  /// of the predictions and of the start of the frame itself.
+  static constexpr fml::TimeDelta kSafetyMargin =
+      fml::TimeDelta::FromMilliseconds(2);
+
+  FrameDeadlineScheduler();
+
+  ~FrameDeadlineScheduler();
+
+  void AddFrameTiming(const FrameTiming& timing);
+
+  /// The 90th percentile of the time the recent frames took to build plus the
+  /// time they took to rasterize, or zero if too few frames were timed.
+  fml::TimeDelta GetPredictedFrameTime() const;
+
+  /// When to start building the frame for the given vsync. This is the vsync
+  /// start time if the frame is predicted to take the whole interval.
+  fml::TimePoint GetBuildStartTime(fml::TimePoint vsync_start,
+                                   fml::TimePoint vsync_target) const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::deque<fml::TimeDelta> frame_times_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameDeadlineScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_DEADLINE_SCHEDULER_H_
@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_deadline_scheduler.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+FrameTiming CreateFrameTiming(fml::TimeDelta build_time,
+                              fml::TimeDelta raster_time) {
+  const auto vsync_start = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+  // The frame waits for the raster thread for a while, which doesn't count.
+  const auto raster_start = vsync_start + build_time +
+                            fml::TimeDelta::FromMilliseconds(5);
+  FrameTiming timing;
+  timing.Set(FrameTiming::kVsyncStart, vsync_start);
+  timing.Set(FrameTiming::kBuildStart, vsync_start);
+  timing.Set(FrameTiming::kBuildFinish, vsync_start + build_time);
+  timing.Set(FrameTiming::kRasterStart, raster_start);
+  timing.Set(FrameTiming::kRasterFinish, raster_start + raster_time);
+  timing.Set(FrameTiming::kRasterFinishWallTime, raster_start + raster_time);
+  return timing;
+}
+
+}  // namespace
+
+TEST(FrameDeadlineSchedulerTest, StartsAtVsyncWithoutEnoughTimings) {
+  FrameDeadlineScheduler scheduler;
+  const auto vsync_start = fml::TimePoint::Now();
+  const auto vsync_target = vsync_start + fml::TimeDelta::FromMilliseconds(16);
+  ASSERT_EQ(scheduler.GetBuildStartTime(vsync_start, vsync_target),
+            vsync_start);
+
+  for (size_t i = 1; i < FrameDeadlineScheduler::kMinFrameHistorySize; i++) {
+    scheduler.AddFrameTiming(
+        CreateFrameTiming(fml::TimeDelta::FromMilliseconds(2),
+                          fml::TimeDelta::FromMilliseconds(2)));
+  }
+  ASSERT_EQ(scheduler.GetPredictedFrameTime(), fml::TimeDelta::Zero());
+  ASSERT_EQ(scheduler.GetBuildStartTime(vsync_start, vsync_target),
+            vsync_start);
+}
+
+TEST(FrameDeadlineSchedulerTest, StartsAsLateAsPredicted) {
+  FrameDeadlineScheduler scheduler;
+  for (size_t i = 0; i < FrameDeadlineScheduler::kFrameHistorySize; i++) {
+    scheduler.AddFrameTiming(
+        CreateFrameTiming(fml::TimeDelta::FromMilliseconds(3),
+                          fml::TimeDelta::FromMilliseconds(4)));
+  }
+  ASSERT_EQ(scheduler.GetPredictedFrameTime(),
+            fml::TimeDelta::FromMilliseconds(7));
+
+  const auto vsync_start = fml::TimePoint::Now();
+  const auto vsync_target = vsync_start + fml::TimeDelta::FromMilliseconds(16);
+  ASSERT_EQ(scheduler.GetBuildStartTime(vsync_start, vsync_target),
+            vsync_target - fml::TimeDelta::FromMilliseconds(7) -
+                FrameDeadlineScheduler::kSafetyMargin);
+}
+
+TEST(FrameDeadlineSchedulerTest, PredictsFromTheSlowRecentFrames) {
+  FrameDeadlineScheduler scheduler;
+  for (size_t i = 0; i < FrameDeadlineScheduler::kFrameHistorySize; i++) {
+    scheduler.AddFrameTiming(
+        CreateFrameTiming(fml::TimeDelta::FromMilliseconds(20),
+                          fml::TimeDelta::FromMilliseconds(20)));
+  }
+  // The old slow frames are forgotten.
+  for (size_t i = 0; i < FrameDeadlineScheduler::kFrameHistorySize; i++) {
+    const auto build_time = fml::TimeDelta::FromMilliseconds(i % 10 == 0 ? 9
+                                                                        : 1);
+    scheduler.AddFrameTiming(
+        CreateFrameTiming(build_time, fml::TimeDelta::FromMilliseconds(1)));
+  }
+  ASSERT_EQ(scheduler.GetPredictedFrameTime(),
+            fml::TimeDelta::FromMilliseconds(10));
+}
+
+TEST(FrameDeadlineSchedulerTest, StartsAtVsyncIfFramesTakeTheWholeInterval) {
+  FrameDeadlineScheduler scheduler;
+  for (size_t i = 0; i < FrameDeadlineScheduler::kFrameHistorySize; i++) {
+    scheduler.AddFrameTiming(
+        CreateFrameTiming(fml::TimeDelta::FromMilliseconds(10),
+                          fml::TimeDelta::FromMilliseconds(10)));
+  }
+  const auto vsync_start = fml::TimePoint::Now();
+  const auto vsync_target = vsync_start + fml::TimeDelta::FromMilliseconds(16);
+  ASSERT_EQ(scheduler.GetBuildStartTime(vsync_start, vsync_target),
+            vsync_start);
+}
+
+}  // namespace testing
+}  // namespace flutter
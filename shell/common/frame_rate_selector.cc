@@ -0,0 +1,25 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_rate_selector.h"
+
+namespace flutter {
+
+FrameRateSelector::FrameRateSelector() = default;
+
+FrameRateSelector::~FrameRateSelector() = default;
+
+void FrameRateSelector::OnPointerInput(fml::TimePoint time) {
+  last_pointer_input_ = time;
+  has_pointer_input_ = true;
+}
+
+double FrameRateSelector::GetPreferredFrameRate(fml::TimePoint now) const {
+  if (has_pointer_input_ && now - last_pointer_input_ < kInteractionTimeout) {
+    return 0.0;
+  }
+  return kIdleFrameRate;
+}
+
+}  // namespace flutter
@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_RATE_SELECTOR_H_
+#define FLUTTER_SHELL_COMMON_FRAME_RATE_SELECTOR_H_
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Picks the rate the |Animator| asks the display to produce vsyncs at. On
+/// variable refresh rate displays, frames are produced as fast as the display
+/// refreshes while the user interacts with the app, where latency and
+/// smoothness are the most visible, and at a lower rate for the animations
+/// that run on their own, which saves power.
+///
+/// Used on the UI thread only.
+class FrameRateSelector {
+ public:
+  /// The frame rate of the frames that aren't driven by input.
+  static constexpr double kIdleFrameRate = 60.0;
+
+  /// How long after the last pointer event the frames are still driven by
+  /// input. This covers the fling that usually follows a scroll.
+  static constexpr fml::TimeDelta kInteractionTimeout =
+      fml::TimeDelta::FromMilliseconds(1000);
+
+  FrameRateSelector();
+
+  ~FrameRateSelector();
+
+  void OnPointerInput(fml::TimePoint time);
+
+  /// The preferred frame rate of the frame that starts at `now`, in frames per
+  /// second, or 0 to produce frames as fast as the display refreshes.
+  double GetPreferredFrameRate(fml::TimePoint now) const;
+
+ private:
+  fml::TimePoint last_pointer_input_;
+  bool has_pointer_input_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameRateSelector);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_RATE_SELECTOR_H_
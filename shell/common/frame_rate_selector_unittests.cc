@@ -0,0 +1,42 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_rate_selector.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(FrameRateSelectorTest, PrefersIdleFrameRateWithoutInput) {
+  FrameRateSelector selector;
+  ASSERT_EQ(selector.GetPreferredFrameRate(fml::TimePoint::Now()),
+            FrameRateSelector::kIdleFrameRate);
+}
+
+TEST(FrameRateSelectorTest, PrefersDisplayRefreshRateDuringInteraction) {
+  FrameRateSelector selector;
+  const auto input_time = fml::TimePoint::Now();
+  selector.OnPointerInput(input_time);
+
+  ASSERT_EQ(selector.GetPreferredFrameRate(input_time), 0.0);
+  ASSERT_EQ(selector.GetPreferredFrameRate(
+                input_time + FrameRateSelector::kInteractionTimeout -
+                fml::TimeDelta::FromMilliseconds(1)),
+            0.0);
+  ASSERT_EQ(selector.GetPreferredFrameRate(
+                input_time + FrameRateSelector::kInteractionTimeout),
+            FrameRateSelector::kIdleFrameRate);
+
+  // More input extends the interaction.
+  const auto later_input_time =
+      input_time + fml::TimeDelta::FromMilliseconds(500);
+  selector.OnPointerInput(later_input_time);
+  ASSERT_EQ(selector.GetPreferredFrameRate(
+                input_time + FrameRateSelector::kInteractionTimeout),
+            0.0);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/gc_scheduler.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+GCScheduler::GCScheduler(Delegate& delegate,
+                         fml::RefPtr<fml::TaskRunner> ui_task_runner)
+    : delegate_(delegate),
+      ui_task_runner_(std::move(ui_task_runner)),
+      weak_factory_(this) {}
+
+GCScheduler::~GCScheduler() = default;
+
+void GCScheduler::NotifyIdle(fml::TimeDelta deadline) {
+  FML_DCHECK(ui_task_runner_->RunsTasksOnCurrentThread());
+  // The deadline and the timeline share the time base of fml::TimePoint.
+  const auto now = fml::TimePoint::Now();
+  const auto idle_period_end = delegate_.GetGCIdlePeriodEnd();
+  if (idle_period_end > now) {
+    deadline = std::min(deadline, idle_period_end.ToEpochDelta());
+  }
+
+  if (deadline - now.ToEpochDelta() < kMinIdleTime) {
+    metrics_.skipped_idle_notification_count++;
+    return;
+  }
+
+  if (!delegate_.OnGCSchedulerNotifyIdle(deadline)) {
+    return;
+  }
+
+  const auto end = fml::TimePoint::Now();
+  metrics_.idle_notification_count++;
+  metrics_.total_time = metrics_.total_time + (end - now);
+  if (end.ToEpochDelta() > deadline) {
+    TRACE_EVENT0("flutter", "GCScheduler::IdleNotificationOverranDeadline");
+    metrics_.frame_overlap_count++;
+  }
+}
+
+void GCScheduler::ScheduleCollection(CollectionReason reason) {
+  FML_DCHECK(ui_task_runner_->RunsTasksOnCurrentThread());
+  bool& pending = IsCollectionPending(reason);
+  if (pending) {
+    metrics_.coalesced_collection_count++;
+    return;
+  }
+  pending = true;
+  ui_task_runner_->PostIdleTask(
+      [weak = weak_factory_.GetWeakPtr(), reason]() {
+        if (weak) {
+          weak->RunCollection(reason);
+        }
+      },
+      fml::TimePoint::Now() + kMaxCollectionDelay);
+}
+
+bool& GCScheduler::IsCollectionPending(CollectionReason reason) {
+  switch (reason) {
+    case CollectionReason::kViewDestroyed:
+      return view_destroyed_collection_pending_;
+    case CollectionReason::kLowMemory:
+      return low_memory_collection_pending_;
+  }
+  FML_UNREACHABLE();
+}
+
+void GCScheduler::RunCollection(CollectionReason reason) {
+  TRACE_EVENT0("flutter", "GCScheduler::RunCollection");
+  IsCollectionPending(reason) = false;
+
+  const auto start = fml::TimePoint::Now();
+  const auto idle_period_end = delegate_.GetGCIdlePeriodEnd();
+  switch (reason) {
+    case CollectionReason::kViewDestroyed:
+      delegate_.OnGCSchedulerNotifyDestroyed();
+      break;
+    case CollectionReason::kLowMemory:
+      delegate_.OnGCSchedulerNotifyLowMemory();
+      break;
+  }
+  const auto end = fml::TimePoint::Now();
+
+  metrics_.collection_count++;
+  metrics_.total_time = metrics_.total_time + (end - start);
+  if (end > idle_period_end) {
+    metrics_.frame_overlap_count++;
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_GC_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_GC_SCHEDULER_H_
+
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Decides when the Dart VM is told that it may collect garbage, so that the
+/// collections don't land in the middle of the frames built on the UI task
+/// runner.
+///
+/// Idle notifications are shortened to the idle period the |Animator| predicts
+/// before the next frame starts to build. The collections requested when the
+/// view is destroyed or the system is low on memory are deferred to idle tasks
+/// of the UI task runner, so they run between frames.
+///
+/// All methods must be called on the UI task runner.
+class GCScheduler {
+ public:
+  class Delegate {
+   public:
+    /// The end of the current idle period of the UI task runner, or a time in
+    /// the past while a frame is being produced.
+    virtual fml::TimePoint GetGCIdlePeriodEnd() = 0;
+
+    /// Passes an idle notification with the given deadline, in the time base
+    /// of `Dart_TimelineGetMicros`, on to the VM. Returns whether it did.
+    virtual bool OnGCSchedulerNotifyIdle(fml::TimeDelta deadline) = 0;
+
+    /// Notifies the VM that the view was destroyed.
+    virtual void OnGCSchedulerNotifyDestroyed() = 0;
+
+    /// Notifies the VM that the system is low on memory.
+    virtual void OnGCSchedulerNotifyLowMemory() = 0;
+  };
+
+  /// Why a collection was requested.
+  enum class CollectionReason {
+    kViewDestroyed,
+    kLowMemory,
+  };
+
+  struct Metrics {
+    /// The idle notifications passed on to the VM.
+    uint64_t idle_notification_count = 0;
+    /// The idle notifications dropped because the idle period was too short.
+    uint64_t skipped_idle_notification_count = 0;
+    /// The collections run for destroyed views or low memory.
+    uint64_t collection_count = 0;
+    /// The requests dropped because the same collection was already pending.
+    uint64_t coalesced_collection_count = 0;
+    /// The idle notifications and collections that were still running in the
+    /// VM when the next frame was predicted to start building, or that had to
+    /// run outside of an idle period, and may have delayed a frame.
+    uint64_t frame_overlap_count = 0;
+    /// The time spent in the idle notifications and collections.
+    fml::TimeDelta total_time;
+  };
+
+  /// Idle notifications shorter than this are not worth passing on to the VM.
+  static constexpr fml::TimeDelta kMinIdleTime =
+      fml::TimeDelta::FromMilliseconds(1);
+
+  /// How long a requested collection waits for an idle period at most.
+  static constexpr fml::TimeDelta kMaxCollectionDelay =
+      fml::TimeDelta::FromMilliseconds(100);
+
+  GCScheduler(Delegate& delegate, fml::RefPtr<fml::TaskRunner> ui_task_runner);
+
+  ~GCScheduler();
+
+  /// Called when the |Animator| reports that the UI task runner is idle until
+  /// the given deadline, in the time base of `Dart_TimelineGetMicros`.
+  void NotifyIdle(fml::TimeDelta deadline);
+
+  /// Runs the collection for the given reason in the next idle period of the
+  /// UI task runner, or after |kMaxCollectionDelay| if there is none.
+  void ScheduleCollection(CollectionReason reason);
+
+  const Metrics& GetMetrics() const { return metrics_; }
+
+ private:
+  Delegate& delegate_;
+  fml::RefPtr<fml::TaskRunner> ui_task_runner_;
+  Metrics metrics_;
+  bool view_destroyed_collection_pending_ = false;
+  bool low_memory_collection_pending_ = false;
+
+  bool& IsCollectionPending(CollectionReason reason);
+
+  void RunCollection(CollectionReason reason);
+
+  fml::WeakPtrFactory<GCScheduler> weak_factory_;  // Must be the last member.
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GCScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_GC_SCHEDULER_H_
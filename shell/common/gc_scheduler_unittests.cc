@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/gc_scheduler.h"
+
+#include <memory>
+
+#include "flutter/fml/message_loop_task_queues.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class TestGCSchedulerDelegate : public GCScheduler::Delegate {
+ public:
+  fml::TimePoint idle_period_end;
+  fml::TimeDelta last_idle_deadline;
+  size_t idle_notification_count = 0;
+  size_t destroyed_count = 0;
+  size_t low_memory_count = 0;
+  fml::CountDownLatch* collection_latch = nullptr;
+
+  // |GCScheduler::Delegate|
+  fml::TimePoint GetGCIdlePeriodEnd() override { return idle_period_end; }
+
+  // |GCScheduler::Delegate|
+  bool OnGCSchedulerNotifyIdle(fml::TimeDelta deadline) override {
+    last_idle_deadline = deadline;
+    idle_notification_count++;
+    return true;
+  }
+
+  // |GCScheduler::Delegate|
+  void OnGCSchedulerNotifyDestroyed() override {
+    destroyed_count++;
+    collection_latch->CountDown();
+  }
+
+  // |GCScheduler::Delegate|
+  void OnGCSchedulerNotifyLowMemory() override {
+    low_memory_count++;
+    collection_latch->CountDown();
+  }
+};
+
+void PostSync(const fml::RefPtr<fml::TaskRunner>& task_runner,
+              const fml::closure& task) {
+  fml::AutoResetWaitableEvent latch;
+  task_runner->PostTask([&]() {
+    task();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+}  // namespace
+
+TEST(GCSchedulerTest, ShortensIdleNotificationsToTheIdlePeriod) {
+  fml::Thread thread("ui");
+  auto task_runner = thread.GetTaskRunner();
+  TestGCSchedulerDelegate delegate;
+  std::unique_ptr<GCScheduler> scheduler;
+  PostSync(task_runner, [&]() {
+    scheduler = std::make_unique<GCScheduler>(delegate, task_runner);
+    const auto now = fml::TimePoint::Now();
+    delegate.idle_period_end = now + fml::TimeDelta::FromMilliseconds(50);
+    scheduler->NotifyIdle(
+        (now + fml::TimeDelta::FromMilliseconds(100)).ToEpochDelta());
+    EXPECT_EQ(delegate.idle_notification_count, 1u);
+    EXPECT_EQ(delegate.last_idle_deadline,
+              delegate.idle_period_end.ToEpochDelta());
+
+    // The animator's deadline is used if no idle period is open.
+    delegate.idle_period_end = fml::TimePoint();
+    const auto deadline =
+        (now + fml::TimeDelta::FromMilliseconds(100)).ToEpochDelta();
+    scheduler->NotifyIdle(deadline);
+    EXPECT_EQ(delegate.idle_notification_count, 2u);
+    EXPECT_EQ(delegate.last_idle_deadline, deadline);
+    EXPECT_EQ(scheduler->GetMetrics().idle_notification_count, 2u);
+    scheduler.reset();
+  });
+}
+
+TEST(GCSchedulerTest, SkipsIdleNotificationsForShortIdlePeriods) {
+  fml::Thread thread("ui");
+  auto task_runner = thread.GetTaskRunner();
+  TestGCSchedulerDelegate delegate;
+  PostSync(task_runner, [&]() {
+    GCScheduler scheduler(delegate, task_runner);
+    const auto now = fml::TimePoint::Now();
+    // The next frame starts building before the VM could do any work.
+    delegate.idle_period_end = now + fml::TimeDelta::FromMicroseconds(500);
+    scheduler.NotifyIdle(
+        (now + fml::TimeDelta::FromMilliseconds(100)).ToEpochDelta());
+    EXPECT_EQ(delegate.idle_notification_count, 0u);
+    EXPECT_EQ(scheduler.GetMetrics().skipped_idle_notification_count, 1u);
+  });
+}
+
+TEST(GCSchedulerTest, CoalescesCollectionsAndRunsThemWhenIdle) {
+  fml::Thread thread("ui");
+  auto task_runner = thread.GetTaskRunner();
+  TestGCSchedulerDelegate delegate;
+  fml::CountDownLatch collection_latch(2);
+  delegate.collection_latch = &collection_latch;
+  std::unique_ptr<GCScheduler> scheduler;
+  PostSync(task_runner, [&]() {
+    scheduler = std::make_unique<GCScheduler>(delegate, task_runner);
+    const auto idle_period_end =
+        fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10);
+    delegate.idle_period_end = idle_period_end;
+    fml::MessageLoopTaskQueues::GetInstance()->SetIdlePeriodEnd(
+        task_runner->GetTaskQueueId(), idle_period_end);
+    scheduler->ScheduleCollection(GCScheduler::CollectionReason::kLowMemory);
+    scheduler->ScheduleCollection(GCScheduler::CollectionReason::kLowMemory);
+    scheduler->ScheduleCollection(
+        GCScheduler::CollectionReason::kViewDestroyed);
+    // Nothing runs until the current task yields to the idle period.
+    EXPECT_EQ(delegate.low_memory_count, 0u);
+  });
+
+  collection_latch.Wait();
+  PostSync(task_runner, [&]() {
+    EXPECT_EQ(delegate.low_memory_count, 1u);
+    EXPECT_EQ(delegate.destroyed_count, 1u);
+    const auto& metrics = scheduler->GetMetrics();
+    EXPECT_EQ(metrics.collection_count, 2u);
+    EXPECT_EQ(metrics.coalesced_collection_count, 1u);
+    EXPECT_EQ(metrics.frame_overlap_count, 0u);
+    scheduler.reset();
+  });
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/memory_governor.h"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+MemoryGovernor::MemoryGovernor(size_t budget_bytes)
+    : budget_bytes_(budget_bytes) {}
+
+MemoryGovernor::~MemoryGovernor() = default;
+
+int64_t MemoryGovernor::AddClient(Client client) {
+  FML_DCHECK(client.task_runner && client.get_usage && client.trim);
+  std::scoped_lock lock(mutex_);
+  int64_t id = next_client_id_++;
+  clients_.emplace(id, std::move(client));
+  return id;
+}
+
+void MemoryGovernor::RemoveClient(int64_t id) {
+  std::scoped_lock lock(mutex_);
+  clients_.erase(id);
+}
+
+MemoryPressureLevel MemoryGovernor::GetMemoryPressureLevel() const {
+  std::scoped_lock lock(mutex_);
+  return level_;
+}
+
+// static
+double MemoryGovernor::GetRetainedFraction(MemoryPressureLevel level,
+                                           Priority priority) {
+  switch (level) {
+    case MemoryPressureLevel::kNone:
+      return 1.0;
+    case MemoryPressureLevel::kModerate:
+      if (priority == Priority::kLow) {
+        return 0.0;
+      }
+      return priority == Priority::kNormal ? 0.5 : 1.0;
+    case MemoryPressureLevel::kCritical:
+      return 0.0;
+  }
+  return 1.0;
+}
+
+void MemoryGovernor::NotifyMemoryPressure(MemoryPressureLevel level) {
+  TRACE_EVENT0("flutter", "MemoryGovernor::NotifyMemoryPressure");
+  std::vector<Client> clients;
+  size_t total_weight = 0;
+  {
+    std::scoped_lock lock(mutex_);
+    level_ = level;
+    for (const auto& [id, client] : clients_) {
+      clients.push_back(client);
+      total_weight += client.weight;
+    }
+  }
+  const int64_t trace_id = reinterpret_cast<int64_t>(this);
+  FML_TRACE_COUNTER("flutter", "MemoryPressureLevel", trace_id,  //
+                    "Level", static_cast<int>(level));
+
+  std::stable_sort(clients.begin(), clients.end(),
+                   [](const Client& a, const Client& b) {
+                     return a.priority < b.priority;
+                   });
+  for (auto& client : clients) {
+    std::optional<size_t> share;
+    if (budget_bytes_ > 0 && total_weight > 0) {
+      share = budget_bytes_ * client.weight / total_weight;
+    }
+    const double fraction = GetRetainedFraction(level, client.priority);
+    if (!share.has_value() && fraction >= 1.0) {
+      continue;
+    }
+    auto task_runner = client.task_runner;
+    task_runner->PostTask([client = std::move(client), share, fraction,
+                           trace_id]() {
+      const size_t usage = client.get_usage();
+      const size_t max_bytes =
+          static_cast<size_t>(share.value_or(usage) * fraction);
+      if (usage <= max_bytes) {
+        return;
+      }
+      TRACE_EVENT1("flutter", "MemoryGovernor::Trim", "cache", client.name);
+      client.trim(max_bytes);
+      FML_TRACE_COUNTER("flutter", "MemoryGovernor", trace_id,  //
+                        client.name, client.get_usage());
+    });
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_MEMORY_GOVERNOR_H_
+#define FLUTTER_SHELL_COMMON_MEMORY_GOVERNOR_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/task_runner.h"
+
+namespace flutter {
+
+/// How short the process is on memory, as reported by the platform.
+enum class MemoryPressureLevel {
+  /// Memory is not running low.
+  kNone,
+  /// Memory is running low, or the application was moved to the background.
+  /// The caches that are cheap to refill are dropped, and the others are
+  /// halved.
+  kModerate,
+  /// The process is about to be killed for its memory use. All of the caches
+  /// are dropped.
+  kCritical,
+};
+
+//------------------------------------------------------------------------------
+/// Splits a global memory budget across the caches of the engine, and trims
+/// the caches when the platform reports memory pressure.
+///
+/// Each cache registers a client that reports how many bytes it takes up and
+/// trims it to a number of bytes, on the task runner that owns the cache. The
+/// caches with the lowest priority are trimmed first, and hardest.
+///
+/// A governor is shared by a shell and the shells spawned from it. It may be
+/// used from any thread.
+///
+class MemoryGovernor {
+ public:
+  enum class Priority {
+    /// Caches that are cheap to refill, such as tessellated paths.
+    kLow,
+    kNormal,
+    /// Caches that are needed to draw the next frame without a hitch, such as
+    /// the GPU resources of the rendering context.
+    kHigh,
+  };
+
+  struct Client {
+    /// The name under which the trimming is reported in the timeline. Must
+    /// be a string literal.
+    const char* name = "";
+    Priority priority = Priority::kNormal;
+    /// The share of the global budget that the cache gets, relative to the
+    /// weights of the other clients.
+    size_t weight = 1;
+    /// The task runner that the callbacks are invoked on.
+    fml::RefPtr<fml::TaskRunner> task_runner;
+    /// Returns the number of bytes the cache takes up.
+    std::function<size_t()> get_usage;
+    /// Trims the cache to at most the given number of bytes.
+    std::function<void(size_t max_bytes)> trim;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  budget_bytes  The number of bytes the registered caches may
+  ///                           take up together, or 0 for no budget. Without
+  ///                           a budget, the caches are only trimmed relative
+  ///                           to what they take up under memory pressure.
+  ///
+  explicit MemoryGovernor(size_t budget_bytes);
+
+  ~MemoryGovernor();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Registers a cache with the governor.
+  ///
+  /// @return     The id to remove the client with.
+  ///
+  int64_t AddClient(Client client);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes a client. Its callbacks may still be invoked by tasks
+  ///             that were posted before, so they must not outlive the cache.
+  ///
+  void RemoveClient(int64_t id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Trims each registered cache to what it may keep at the given
+  ///             level, in order of increasing priority.
+  ///
+  void NotifyMemoryPressure(MemoryPressureLevel level);
+
+  MemoryPressureLevel GetMemoryPressureLevel() const;
+
+  size_t GetBudgetBytes() const { return budget_bytes_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The fraction of its share of the budget, or of what it takes
+  ///             up if there is no budget, that a cache with the given
+  ///             priority may keep at the given level.
+  ///
+  static double GetRetainedFraction(MemoryPressureLevel level,
+                                    Priority priority);
+
+ private:
+  const size_t budget_bytes_;
+  mutable std::mutex mutex_;
+  std::map<int64_t, Client> clients_;
+  int64_t next_client_id_ = 0;
+  MemoryPressureLevel level_ = MemoryPressureLevel::kNone;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MemoryGovernor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_MEMORY_GOVERNOR_H_
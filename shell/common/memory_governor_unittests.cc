@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/memory_governor.h"
+
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+struct TestCache {
+  size_t usage = 0;
+  std::vector<size_t> trims;
+};
+
+MemoryGovernor::Client MakeClient(TestCache* cache,
+                                  const char* name,
+                                  MemoryGovernor::Priority priority,
+                                  size_t weight,
+                                  fml::RefPtr<fml::TaskRunner> task_runner) {
+  return {
+      .name = name,
+      .priority = priority,
+      .weight = weight,
+      .task_runner = std::move(task_runner),
+      .get_usage = [cache]() { return cache->usage; },
+      .trim =
+          [cache](size_t max_bytes) {
+            cache->trims.push_back(max_bytes);
+            cache->usage = max_bytes;
+          },
+  };
+}
+
+void Flush(const fml::RefPtr<fml::TaskRunner>& task_runner) {
+  fml::AutoResetWaitableEvent latch;
+  task_runner->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+}
+
+}  // namespace
+
+TEST(MemoryGovernorTest, TrimsByPriorityWithoutBudget) {
+  fml::Thread thread("cache");
+  auto task_runner = thread.GetTaskRunner();
+  MemoryGovernor governor(0);
+  TestCache low{.usage = 100};
+  TestCache normal{.usage = 100};
+  TestCache high{.usage = 100};
+  governor.AddClient(MakeClient(&low, "Low", MemoryGovernor::Priority::kLow, 1,
+                                task_runner));
+  governor.AddClient(MakeClient(
+      &normal, "Normal", MemoryGovernor::Priority::kNormal, 1, task_runner));
+  governor.AddClient(MakeClient(&high, "High", MemoryGovernor::Priority::kHigh,
+                                1, task_runner));
+
+  // Without a budget, nothing is trimmed while there is no memory pressure.
+  governor.NotifyMemoryPressure(MemoryPressureLevel::kNone);
+  Flush(task_runner);
+  EXPECT_TRUE(low.trims.empty());
+  EXPECT_TRUE(normal.trims.empty());
+  EXPECT_TRUE(high.trims.empty());
+
+  governor.NotifyMemoryPressure(MemoryPressureLevel::kModerate);
+  Flush(task_runner);
+  EXPECT_EQ(governor.GetMemoryPressureLevel(), MemoryPressureLevel::kModerate);
+  EXPECT_EQ(low.trims, std::vector<size_t>{0u});
+  EXPECT_EQ(normal.trims, std::vector<size_t>{50u});
+  EXPECT_TRUE(high.trims.empty());
+
+  governor.NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+  Flush(task_runner);
+  // The low priority cache is empty already.
+  EXPECT_EQ(low.trims, std::vector<size_t>{0u});
+  EXPECT_EQ(normal.trims, (std::vector<size_t>{50u, 0u}));
+  EXPECT_EQ(high.trims, std::vector<size_t>{0u});
+}
+
+TEST(MemoryGovernorTest, SplitsBudgetByWeight) {
+  fml::Thread thread("cache");
+  auto task_runner = thread.GetTaskRunner();
+  MemoryGovernor governor(400);
+  TestCache small{.usage = 300};
+  TestCache large{.usage = 300};
+  governor.AddClient(MakeClient(
+      &small, "Small", MemoryGovernor::Priority::kHigh, 1, task_runner));
+  governor.AddClient(MakeClient(
+      &large, "Large", MemoryGovernor::Priority::kHigh, 3, task_runner));
+
+  governor.NotifyMemoryPressure(MemoryPressureLevel::kNone);
+  Flush(task_runner);
+  EXPECT_EQ(small.trims, std::vector<size_t>{100u});
+  // The cache is within its share of the budget.
+  EXPECT_TRUE(large.trims.empty());
+}
+
+TEST(MemoryGovernorTest, RemovedClientsAreNotTrimmed) {
+  fml::Thread thread("cache");
+  auto task_runner = thread.GetTaskRunner();
+  MemoryGovernor governor(0);
+  TestCache cache{.usage = 100};
+  auto id = governor.AddClient(MakeClient(
+      &cache, "Cache", MemoryGovernor::Priority::kLow, 1, task_runner));
+  governor.RemoveClient(id);
+
+  governor.NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+  Flush(task_runner);
+  EXPECT_TRUE(cache.trims.empty());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -362,5 +362,63 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(PersistentCacheTest, LoadsSkSLsInRecordedUsageOrder) {
+  sk_sp<SkData> key_a = SkData::MakeWithCString("key_a");
+  sk_sp<SkData> key_b = SkData::MakeWithCString("key_b");
+  sk_sp<SkData> shader_value = SkData::MakeWithCString("value");
+
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto settings = CreateSettingsForFixture();
+  settings.cache_sksl = true;
+  auto config = RunConfiguration::InferFromSettings(settings);
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  RunEngine(shell.get(), std::move(config));
+
+  // Skia stores the shaders in the order it first uses them in.
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  StorePersistentCache(persistent_cache, *key_b, *shader_value);
+  StorePersistentCache(persistent_cache, *key_a, *shader_value);
+  StorePersistentCache(persistent_cache, *key_b, *shader_value);
+  WaitForIO(shell.get());
+  ASSERT_EQ(persistent_cache->GetSkSLUsage(*key_b)->first_use, 0u);
+  ASSERT_EQ(persistent_cache->GetSkSLUsage(*key_a)->first_use, 1u);
+  ASSERT_EQ(persistent_cache->GetSkSLUsage(*key_a)->run_count, 1u);
+
+  auto sksls = persistent_cache->LoadSkSLs();
+  ASSERT_EQ(sksls.size(), 2u);
+  ASSERT_TRUE(sksls[0].key->equals(key_b.get()));
+  ASSERT_TRUE(sksls[1].key->equals(key_a.get()));
+  DestroyShell(std::move(shell));
+
+  // A new run reads the usage back, and adds to it.
+  PersistentCache::ResetCacheForProcess();
+  persistent_cache = PersistentCache::GetCacheForProcess();
+  ASSERT_EQ(persistent_cache->GetSkSLUsage(*key_b)->run_count, 1u);
+  persistent_cache->load(*key_a);
+  ASSERT_EQ(persistent_cache->GetSkSLUsage(*key_a)->first_use, 0u);
+  ASSERT_EQ(persistent_cache->GetSkSLUsage(*key_a)->run_count, 2u);
+
+  sksls = persistent_cache->LoadSkSLs();
+  ASSERT_EQ(sksls.size(), 2u);
+  ASSERT_TRUE(sksls[0].key->equals(key_a.get()));
+  ASSERT_TRUE(sksls[1].key->equals(key_b.get()));
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, EagerSkSLWarmupCountIsSetFromSettings) {
+  auto settings = CreateSettingsForFixture();
+  settings.eager_sksl_warmup_count = 4;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  ASSERT_EQ(PersistentCache::eager_sksl_warmup_count(), 4u);
+  DestroyShell(std::move(shell));
+  PersistentCache::SetEagerSkSLWarmupCount(0);
+}
+
 }  // namespace testing
 }  // namespace flutter
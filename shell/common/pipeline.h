@@ -131,6 +131,12 @@ class Pipeline {
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  /// The number of produced resources waiting for the consumer.
+  size_t GetQueueSize() {
+    std::scoped_lock lock(queue_mutex_);
+    return queue_.size();
+  }
+
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
   ///
@@ -173,6 +179,13 @@ class Pipeline {
         GetNextPipelineTraceID()};         // trace id
   }
 
+  /// Whether a produced resource is waiting to be consumed. When called from
+  /// a consumer, whether one was produced after the one being consumed.
+  bool HasAvailable() {
+    std::scoped_lock lock(queue_mutex_);
+    return !queue_.empty();
+  }
+
   using Consumer = std::function<void(ResourcePtr)>;
 
   /// @note Procedure doesn't copy all closures.
@@ -35,6 +35,31 @@ TEST(PipelineTest, ConsumeOneVal) {
   ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, HasAvailableWhileConsumingOlderVal) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(2);
+  ASSERT_FALSE(pipeline->HasAvailable());
+
+  PipelineProduceResult result =
+      pipeline->Produce().Complete(std::make_unique<int>(1));
+  ASSERT_TRUE(result.success);
+  result = pipeline->Produce().Complete(std::make_unique<int>(2));
+  ASSERT_TRUE(result.success);
+  ASSERT_TRUE(pipeline->HasAvailable());
+
+  PipelineConsumeResult consume_result =
+      pipeline->Consume([&pipeline](std::unique_ptr<int> v) {
+        ASSERT_EQ(*v, 1);
+        ASSERT_TRUE(pipeline->HasAvailable());
+      });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+
+  consume_result = pipeline->Consume([&pipeline](std::unique_ptr<int> v) {
+    ASSERT_EQ(*v, 2);
+    ASSERT_FALSE(pipeline->HasAvailable());
+  });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+}
+
 TEST(PipelineTest, ContinuationCanOnlyBeUsedOnce) {
   std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(2);
 
@@ -144,5 +169,24 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, QueueSizeCountsUnconsumedItems) {
+  const int depth = 3;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+  ASSERT_EQ(pipeline->GetQueueSize(), 0u);
+
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_EQ(pipeline->GetQueueSize(), 0u);
+
+  continuation_1.Complete(std::make_unique<int>(1));
+  continuation_2.Complete(std::make_unique<int>(2));
+  ASSERT_EQ(pipeline->GetQueueSize(), 2u);
+
+  PipelineConsumeResult consume_result =
+      pipeline->Consume([](std::unique_ptr<int> v) { ASSERT_EQ(*v, 1); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::MoreAvailable);
+  ASSERT_EQ(pipeline->GetQueueSize(), 1u);
+}
+
 }  // namespace testing
 }  // namespace flutter
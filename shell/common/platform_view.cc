@@ -178,6 +178,15 @@ void PlatformView::LoadDartDeferredLibraryError(
         error_message,  // NOLINT(performance-unnecessary-value-param)
     bool transient) {}
 
+void PlatformView::PrefetchDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::unique_ptr<const fml::Mapping> snapshot_data,
+    std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  delegate_.PrefetchDartDeferredLibrary(loading_unit_id,
+                                        std::move(snapshot_data),
+                                        std::move(snapshot_instructions));
+}
+
 void PlatformView::UpdateAssetResolverByType(
     std::unique_ptr<AssetResolver> updated_asset_resolver,
     AssetResolver::AssetResolverType type) {
@@ -286,6 +286,30 @@ class PlatformView {
                                               const std::string error_message,
                                               bool transient) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Hands the engine the mappings of a deferred library that is
+    ///             likely to be loaded soon, before the Dart VM requests it.
+    ///
+    ///             The pages of the mappings are faulted in on the IO thread,
+    ///             and a later RequestDartDeferredLibrary for the same loading
+    ///             unit is completed with these mappings instead of being
+    ///             forwarded to the embedder, so that the Dart loadLibrary()
+    ///             call completes without waiting on I/O.
+    ///
+    /// @param[in]  loading_unit_id  The unique id of the deferred library's
+    ///                              loading unit.
+    ///
+    /// @param[in]  snapshot_data    Dart snapshot data of the loading unit's
+    ///                              shared library.
+    ///
+    /// @param[in]  snapshot_instructions  Dart snapshot instructions of the
+    ///                                     loading unit's shared library.
+    ///
+    virtual void PrefetchDartDeferredLibrary(
+        intptr_t loading_unit_id,
+        std::unique_ptr<const fml::Mapping> snapshot_data,
+        std::unique_ptr<const fml::Mapping> snapshot_instructions) = 0;
+
     //--------------------------------------------------------------------------
     /// @brief      Replaces the asset resolver handled by the engine's
     ///             AssetManager of the specified `type` with
@@ -768,6 +792,33 @@ class PlatformView {
                                             const std::string error_message,
                                             bool transient);
 
+  //--------------------------------------------------------------------------
+  /// @brief      Hints that the deferred library of the specified loading unit
+  ///             is likely to be loaded soon, for example because the user is
+  ///             about to navigate to a route that imports it.
+  ///
+  ///             The engine faults in the pages of the mappings ahead of time
+  ///             and holds on to them, so that when the Dart VM requests the
+  ///             loading unit, the request is completed by the engine without
+  ///             a call to RequestDartDeferredLibrary. The loading unit must
+  ///             already be installed; callers should open and resolve a
+  ///             SymbolMapping from the shared library as they would for
+  ///             LoadDartDeferredLibrary.
+  ///
+  /// @param[in]  loading_unit_id  The unique id of the deferred library's
+  ///                              loading unit.
+  ///
+  /// @param[in]  snapshot_data    Dart snapshot data of the loading unit's
+  ///                              shared library.
+  ///
+  /// @param[in]  snapshot_instructions  Dart snapshot instructions of the
+  ///                                     loading unit's shared library.
+  ///
+  virtual void PrefetchDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions);
+
   //--------------------------------------------------------------------------
   /// @brief      Replaces the asset resolver handled by the engine's
   ///             AssetManager of the specified `type` with
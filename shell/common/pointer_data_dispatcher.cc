@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -15,6 +17,11 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+ResamplingPointerDataDispatcher::ResamplingPointerDataDispatcher(
+    Delegate& delegate)
+    : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
+ResamplingPointerDataDispatcher::~ResamplingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -68,4 +75,125 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void ResamplingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0("flutter", "ResamplingPointerDataDispatcher::DispatchPacket");
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  for (size_t i = 0; i < packet->GetLength(); i++) {
+    pending_events_.push_back(packet->GetPointerData(i));
+  }
+  pending_trace_flow_ids_.push_back(trace_flow_id);
+  ScheduleSecondaryVsyncCallback();
+}
+
+void ResamplingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  if (is_callback_scheduled_) {
+    return;
+  }
+  is_callback_scheduled_ = true;
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher) {
+          dispatcher->DispatchPendingEvents(fml::TimePoint::Now());
+        }
+      });
+}
+
+void ResamplingPointerDataDispatcher::DispatchPendingEvents(
+    fml::TimePoint sample_time) {
+  is_callback_scheduled_ = false;
+  if (pending_trace_flow_ids_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter",
+               "ResamplingPointerDataDispatcher::DispatchPendingEvents");
+
+  // Coalesce the consecutive moves of each device, and record the positions
+  // they are resampled from.
+  std::vector<PointerData> events;
+  std::map<int64_t, size_t> trailing_moves;
+  for (const auto& data : pending_events_) {
+    DeviceState& device = devices_[data.device];
+    device.previous = device.last;
+    device.last = Sample{data.time_stamp, data.physical_x, data.physical_y};
+    if (!IsResampled(data)) {
+      trailing_moves.erase(data.device);
+      events.push_back(data);
+      continue;
+    }
+    auto found = trailing_moves.find(data.device);
+    if (found != trailing_moves.end()) {
+      events[found->second] = data;
+    } else {
+      trailing_moves[data.device] = events.size();
+      events.push_back(data);
+    }
+  }
+  pending_events_.clear();
+
+  const int64_t sample_time_stamp =
+      sample_time.ToEpochDelta().ToMicroseconds();
+  for (const auto& [device, index] : trailing_moves) {
+    Resample(events[index], devices_[device], sample_time_stamp);
+  }
+
+  // The deltas of the moves are relative to the last position the framework
+  // got, which isn't the position of the previous event anymore.
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    PointerData& data = events[i];
+    DeviceState& device = devices_[data.device];
+    if (IsResampled(data) && device.dispatched) {
+      data.physical_delta_x = data.physical_x - device.dispatched->x;
+      data.physical_delta_y = data.physical_y - device.dispatched->y;
+    }
+    device.dispatched = Sample{data.time_stamp, data.physical_x,
+                               data.physical_y};
+    if (data.change == PointerData::Change::kRemove) {
+      devices_.erase(data.device);
+    }
+    packet->SetPointerData(i, data);
+  }
+
+  const uint64_t trace_flow_id = pending_trace_flow_ids_.back();
+  pending_trace_flow_ids_.pop_back();
+  for (auto coalesced_trace_flow_id : pending_trace_flow_ids_) {
+    TRACE_FLOW_END("flutter", "PointerEvent", coalesced_trace_flow_id);
+  }
+  pending_trace_flow_ids_.clear();
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               trace_flow_id);
+}
+
+// static
+bool ResamplingPointerDataDispatcher::IsResampled(const PointerData& data) {
+  return (data.change == PointerData::Change::kMove ||
+          data.change == PointerData::Change::kHover) &&
+         data.signal_kind == PointerData::SignalKind::kNone;
+}
+
+void ResamplingPointerDataDispatcher::Resample(PointerData& data,
+                                               const DeviceState& device,
+                                               int64_t sample_time) const {
+  if (!device.previous || !device.last ||
+      device.last->time_stamp <= device.previous->time_stamp) {
+    return;
+  }
+  const Sample& previous = device.previous.value();
+  const Sample& last = device.last.value();
+  // Interpolate between the last two samples, or extrapolate past the last
+  // one for a short while.
+  const int64_t time_stamp =
+      std::clamp(sample_time, previous.time_stamp,
+                 last.time_stamp + kMaxPrediction.ToMicroseconds());
+  const double t = static_cast<double>(time_stamp - last.time_stamp) /
+                   static_cast<double>(last.time_stamp - previous.time_stamp);
+  data.time_stamp = time_stamp;
+  data.physical_x = last.x + (last.x - previous.x) * t;
+  data.physical_y = last.y + (last.y - previous.y) * t;
+}
+
 }  // namespace flutter
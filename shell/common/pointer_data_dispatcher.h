@@ -5,6 +5,12 @@
 #ifndef POINTER_DATA_DISPATCHER_H_
 #define POINTER_DATA_DISPATCHER_H_
 
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -163,6 +169,76 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that dispatches the events received during a VSYNC interval
+/// together at the next VSYNC, as a single packet.
+///
+/// Consecutive move and hover events of the same device are coalesced into
+/// the last of them, so that the framework handles at most one of them per
+/// device and per frame no matter the sampling rate of the digitizer. The
+/// position of the move that ends a packet is then resampled to the VSYNC
+/// time from the last two positions of its device. Hence positions follow the
+/// frames at a steady pace instead of the irregular times the events were
+/// sampled at, which makes scrolling smoother.
+///
+/// Positions are extrapolated `kMaxPrediction` past the last sample at most.
+/// This assumes that the pointer timestamps are in the same clock as
+/// `fml::TimePoint`, which is the case on Android and iOS.
+///
+/// Packets that were coalesced end their trace flows when the packet they were
+/// coalesced into is dispatched.
+class ResamplingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  /// How far past the last sample positions may be extrapolated.
+  static constexpr fml::TimeDelta kMaxPrediction =
+      fml::TimeDelta::FromMilliseconds(8);
+
+  explicit ResamplingPointerDataDispatcher(Delegate& delegate);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~ResamplingPointerDataDispatcher();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Dispatches the events received since the last VSYNC, with
+  ///             positions resampled to `sample_time`. Called at VSYNC.
+  ///             Made public for testing.
+  ///
+  void DispatchPendingEvents(fml::TimePoint sample_time);
+
+ private:
+  struct Sample {
+    int64_t time_stamp;
+    double x;
+    double y;
+  };
+
+  struct DeviceState {
+    std::optional<Sample> previous;
+    std::optional<Sample> last;
+    std::optional<Sample> dispatched;
+  };
+
+  std::vector<PointerData> pending_events_;
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  std::map<int64_t, DeviceState> devices_;
+  bool is_callback_scheduled_ = false;
+
+  static bool IsResampled(const PointerData& data);
+
+  void ScheduleSecondaryVsyncCallback();
+
+  void Resample(PointerData& data,
+                const DeviceState& device,
+                int64_t sample_time) const;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<ResamplingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(ResamplingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
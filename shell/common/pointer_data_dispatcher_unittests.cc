@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class FakeDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    packets.push_back(std::move(packet));
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    callbacks.push_back(callback);
+  }
+
+  std::vector<std::unique_ptr<PointerDataPacket>> packets;
+  std::vector<fml::closure> callbacks;
+};
+
+std::unique_ptr<PointerDataPacket> CreatePacket(PointerData::Change change,
+                                                int64_t time_stamp,
+                                                double x) {
+  PointerData data;
+  data.Clear();
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.time_stamp = time_stamp;
+  data.physical_x = x;
+  data.physical_y = 2 * x;
+  auto packet = std::make_unique<PointerDataPacket>(1);
+  packet->SetPointerData(0, data);
+  return packet;
+}
+
+fml::TimePoint FromMicroseconds(int64_t micros) {
+  return fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMicroseconds(micros));
+}
+
+}  // namespace
+
+TEST(ResamplingPointerDataDispatcherTest, CoalescesMovesOncePerVsync) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+  dispatcher.DispatchPacket(CreatePacket(PointerData::Change::kDown, 0, 0), 1);
+  dispatcher.DispatchPacket(CreatePacket(PointerData::Change::kMove, 4000, 4),
+                            2);
+  dispatcher.DispatchPacket(CreatePacket(PointerData::Change::kMove, 8000, 8),
+                            3);
+  ASSERT_EQ(delegate.callbacks.size(), 1u);
+  ASSERT_TRUE(delegate.packets.empty());
+
+  dispatcher.DispatchPendingEvents(FromMicroseconds(8000));
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  const auto& packet = delegate.packets[0];
+  ASSERT_EQ(packet->GetLength(), 2u);
+  ASSERT_EQ(packet->GetPointerData(0).change, PointerData::Change::kDown);
+  const auto move = packet->GetPointerData(1);
+  ASSERT_EQ(move.change, PointerData::Change::kMove);
+  ASSERT_EQ(move.time_stamp, 8000);
+  ASSERT_DOUBLE_EQ(move.physical_x, 8);
+  ASSERT_DOUBLE_EQ(move.physical_y, 16);
+  ASSERT_DOUBLE_EQ(move.physical_delta_x, 8);
+  ASSERT_DOUBLE_EQ(move.physical_delta_y, 16);
+
+  // Nothing is dispatched at the vsync without events.
+  dispatcher.DispatchPendingEvents(FromMicroseconds(16000));
+  ASSERT_EQ(delegate.packets.size(), 1u);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, ResamplesMovesToTheSampleTime) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+  dispatcher.DispatchPacket(CreatePacket(PointerData::Change::kDown, 0, 0), 1);
+  dispatcher.DispatchPacket(CreatePacket(PointerData::Change::kMove, 4000, 4),
+                            2);
+  // Extrapolated past the last sample.
+  dispatcher.DispatchPendingEvents(FromMicroseconds(6000));
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  auto move = delegate.packets[0]->GetPointerData(1);
+  ASSERT_EQ(move.time_stamp, 6000);
+  ASSERT_DOUBLE_EQ(move.physical_x, 6);
+
+  // Interpolated between the last two samples, with the delta relative to the
+  // extrapolated position.
+  dispatcher.DispatchPacket(CreatePacket(PointerData::Change::kMove, 8000, 8),
+                            3);
+  dispatcher.DispatchPendingEvents(FromMicroseconds(7000));
+  ASSERT_EQ(delegate.packets.size(), 2u);
+  move = delegate.packets[1]->GetPointerData(0);
+  ASSERT_EQ(move.time_stamp, 7000);
+  ASSERT_DOUBLE_EQ(move.physical_x, 7);
+  ASSERT_DOUBLE_EQ(move.physical_delta_x, 1);
+
+  // Not extrapolated further than the max prediction.
+  dispatcher.DispatchPacket(CreatePacket(PointerData::Change::kMove, 12000, 12),
+                            4);
+  dispatcher.DispatchPendingEvents(FromMicroseconds(100000));
+  ASSERT_EQ(delegate.packets.size(), 3u);
+  move = delegate.packets[2]->GetPointerData(0);
+  const int64_t max_time_stamp =
+      12000 + ResamplingPointerDataDispatcher::kMaxPrediction.ToMicroseconds();
+  ASSERT_EQ(move.time_stamp, max_time_stamp);
+  ASSERT_DOUBLE_EQ(move.physical_x, max_time_stamp / 1000.0);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, DoesNotCoalesceOtherEvents) {
+  FakeDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate);
+  dispatcher.DispatchPacket(CreatePacket(PointerData::Change::kDown, 0, 0), 1);
+  dispatcher.DispatchPacket(CreatePacket(PointerData::Change::kMove, 4000, 4),
+                            2);
+  dispatcher.DispatchPacket(CreatePacket(PointerData::Change::kUp, 8000, 8), 3);
+  dispatcher.DispatchPacket(CreatePacket(PointerData::Change::kDown, 9000, 20),
+                            4);
+  delegate.callbacks[0]();
+
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  const auto& packet = delegate.packets[0];
+  ASSERT_EQ(packet->GetLength(), 4u);
+  ASSERT_EQ(packet->GetPointerData(0).change, PointerData::Change::kDown);
+  // The move ending before the up isn't resampled.
+  ASSERT_EQ(packet->GetPointerData(1).change, PointerData::Change::kMove);
+  ASSERT_EQ(packet->GetPointerData(1).time_stamp, 4000);
+  ASSERT_DOUBLE_EQ(packet->GetPointerData(1).physical_x, 4);
+  ASSERT_EQ(packet->GetPointerData(2).change, PointerData::Change::kUp);
+  ASSERT_EQ(packet->GetPointerData(3).change, PointerData::Change::kDown);
+}
+
+}  // namespace testing
+}  // namespace flutter
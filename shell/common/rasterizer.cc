@@ -24,6 +24,13 @@
 #include "third_party/skia/include/core/SkSurfaceCharacterization.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 
+#if IMPELLER_SUPPORTS_RENDERING
+#include "impeller/entity/contents/content_context.h"  // nogncheck
+#include "impeller/entity/render_target_cache.h"       // nogncheck
+#include "impeller/entity/tessellation_cache.h"        // nogncheck
+#include "impeller/renderer/gpu_tracer.h"              // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 namespace flutter {
 
 // The rasterizer will tell Skia to purge cached resources that have not been
@@ -38,11 +45,23 @@ Rasterizer::Rasterizer(Delegate& delegate,
       user_override_resource_cache_bytes_(false),
       snapshot_controller_(
           SnapshotController::Make(*this, delegate.GetSettings())),
+      skia_cache_memory_count_(fml::MemoryCounter::Get("skia_resource_cache"),
+                               0u),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+  const Settings& settings = delegate.GetSettings();
+  if (settings.display_list_capture_frame_count > 0u) {
+    display_list_capture_ = DisplayListCapture::Create(
+        settings, delegate.GetTaskRunners().GetIOTaskRunner());
+  }
+  auto& layer_cost_store = compositor_context_->layer_cost_store();
+  layer_cost_store.SetSampleInterval(settings.layer_cost_sample_interval);
+  layer_cost_store.SetHeatmapEnabled(settings.show_layer_cost_heatmap);
 }
 
-Rasterizer::~Rasterizer() = default;
+Rasterizer::~Rasterizer() {
+  SetMemoryGovernor(nullptr);
+}
 
 fml::TaskRunnerAffineWeakPtr<Rasterizer> Rasterizer::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
@@ -56,10 +75,18 @@ fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> Rasterizer::GetSnapshotDelegate()
 void Rasterizer::SetImpellerContext(
     std::weak_ptr<impeller::Context> impeller_context) {
   impeller_context_ = std::move(impeller_context);
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto context = impeller_context_.lock()) {
+    if (auto tracer = context->GetGPUTracer()) {
+      tracer->SetEnabled(delegate_.GetSettings().enable_impeller_gpu_tracing);
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
 void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
   surface_ = std::move(surface);
+  last_layer_tree_presented_ = false;
 
   if (max_cache_bytes_.has_value()) {
     SetResourceCacheMaxBytes(max_cache_bytes_.value(),
@@ -71,6 +98,16 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
     compositor_context_->OnGrContextCreated();
   }
 
+  if (surface_->GetAiksContext()) {
+    // Impeller surfaces have no |GrDirectContext| to rasterize cache entries
+    // with, so they are rendered into Impeller textures like snapshots are.
+    compositor_context_->raster_cache().SetDisplayListRasterizer(
+        [this](sk_sp<DisplayList> display_list, SkISize size) {
+          return snapshot_controller_->MakeRasterSnapshot(
+              std::move(display_list), size);
+        });
+  }
+
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
       !raster_thread_merger_) {
@@ -106,10 +143,14 @@ void Rasterizer::Teardown() {
         context->purgeUnlockedResources(/*scratchResourcesOnly=*/false);
       }
     }
+    if (surface_->GetAiksContext()) {
+      compositor_context_->raster_cache().SetDisplayListRasterizer(nullptr);
+    }
     surface_.reset();
   }
 
   last_layer_tree_.reset();
+  last_layer_tree_presented_ = false;
 
   if (raster_thread_merger_.get() != nullptr &&
       raster_thread_merger_.get()->IsMerged()) {
@@ -150,6 +191,127 @@ void Rasterizer::NotifyLowMemoryWarning() const {
   context->performDeferredCleanup(std::chrono::milliseconds(0));
 }
 
+void Rasterizer::SetMemoryGovernor(
+    std::shared_ptr<MemoryGovernor> memory_governor) {
+  if (memory_governor_) {
+    for (int64_t id : memory_governor_client_ids_) {
+      memory_governor_->RemoveClient(id);
+    }
+  }
+  memory_governor_client_ids_.clear();
+  memory_governor_ = std::move(memory_governor);
+  if (!memory_governor_) {
+    return;
+  }
+
+  auto task_runner = delegate_.GetTaskRunners().GetRasterTaskRunner();
+  auto add_client = [&](const char* name, MemoryGovernor::Priority priority,
+                        size_t weight,
+                        std::function<size_t(Rasterizer&)> get_usage,
+                        std::function<void(Rasterizer&, size_t)> trim) {
+    memory_governor_client_ids_.push_back(memory_governor_->AddClient({
+        .name = name,
+        .priority = priority,
+        .weight = weight,
+        .task_runner = task_runner,
+        .get_usage =
+            [weak = GetWeakPtr(), get_usage]() {
+              return weak ? get_usage(*weak) : 0u;
+            },
+        .trim =
+            [weak = GetWeakPtr(), trim](size_t max_bytes) {
+              if (weak) {
+                trim(*weak, max_bytes);
+              }
+            },
+    }));
+  };
+
+  add_client(
+      "SkiaResourceCache", MemoryGovernor::Priority::kHigh, 4,
+      [](Rasterizer& rasterizer) { return rasterizer.GetResourceCacheUsage(); },
+      [](Rasterizer& rasterizer, size_t max_bytes) {
+        rasterizer.TrimResourceCache(max_bytes);
+      });
+  // The raster cache can't drop single entries. It is cleared, and refilled
+  // from the layers that are still drawn.
+  add_client(
+      "RasterCache", MemoryGovernor::Priority::kNormal, 2,
+      [](Rasterizer& rasterizer) {
+        auto& raster_cache = rasterizer.compositor_context_->raster_cache();
+        return raster_cache.EstimateLayerCacheByteSize() +
+               raster_cache.EstimatePictureCacheByteSize();
+      },
+      [](Rasterizer& rasterizer, size_t max_bytes) {
+        rasterizer.compositor_context_->raster_cache().Clear();
+      });
+#if IMPELLER_SUPPORTS_RENDERING
+  auto get_content_context =
+      [](Rasterizer& rasterizer) -> impeller::ContentContext* {
+    if (!rasterizer.surface_) {
+      return nullptr;
+    }
+    auto aiks_context = rasterizer.surface_->GetAiksContext();
+    return aiks_context ? &aiks_context->GetContentContext() : nullptr;
+  };
+  add_client(
+      "RenderTargetCache", MemoryGovernor::Priority::kNormal, 2,
+      [get_content_context](Rasterizer& rasterizer) -> size_t {
+        auto* content_context = get_content_context(rasterizer);
+        return content_context
+                   ? content_context->GetRenderTargetCache()->GetMemoryUsage()
+                   : 0u;
+      },
+      [get_content_context](Rasterizer& rasterizer, size_t max_bytes) {
+        if (auto* content_context = get_content_context(rasterizer)) {
+          content_context->GetRenderTargetCache()->Trim(max_bytes);
+        }
+      });
+  add_client(
+      "TessellationCache", MemoryGovernor::Priority::kLow, 1,
+      [get_content_context](Rasterizer& rasterizer) -> size_t {
+        auto* content_context = get_content_context(rasterizer);
+        return content_context
+                   ? content_context->GetTessellationCache()->GetMemoryUsage()
+                   : 0u;
+      },
+      [get_content_context](Rasterizer& rasterizer, size_t max_bytes) {
+        if (auto* content_context = get_content_context(rasterizer)) {
+          content_context->GetTessellationCache()->Clear();
+        }
+      });
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+size_t Rasterizer::GetResourceCacheUsage() const {
+  GrDirectContext* context = surface_ ? surface_->GetContext() : nullptr;
+  if (!context) {
+    return 0;
+  }
+  size_t bytes = 0;
+  context->getResourceCacheUsage(nullptr, &bytes);
+  return bytes;
+}
+
+void Rasterizer::TrimResourceCache(size_t max_bytes) {
+  GrDirectContext* context = surface_ ? surface_->GetContext() : nullptr;
+  if (!context) {
+    return;
+  }
+  auto context_switch = surface_->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    return;
+  }
+  size_t bytes = 0;
+  context->getResourceCacheUsage(nullptr, &bytes);
+  if (max_bytes == 0) {
+    context->performDeferredCleanup(std::chrono::milliseconds(0));
+  } else if (bytes > max_bytes) {
+    context->purgeUnlockedResources(bytes - max_bytes,
+                                    /*preferScratchResources=*/true);
+  }
+}
+
 std::shared_ptr<flutter::TextureRegistry> Rasterizer::GetTextureRegistry() {
   return compositor_context_->texture_registry();
 }
@@ -167,8 +329,15 @@ void Rasterizer::DrawLastLayerTree(
   if (!last_layer_tree_ || !surface_) {
     return;
   }
+  // The last layer tree is drawn again when external textures have new
+  // frames, none of which may be visible.
+  if (IsUnchangedFrame(*last_layer_tree_)) {
+    TRACE_EVENT0("flutter", "Rasterizer::DrawLastLayerTree Unchanged");
+    return;
+  }
   RasterStatus raster_status =
       DrawToSurface(*frame_timings_recorder, *last_layer_tree_);
+  last_layer_tree_presented_ = raster_status == RasterStatus::kSuccess;
 
   // EndFrame should perform cleanups for the external_view_embedder.
   if (external_view_embedder_ && external_view_embedder_->GetUsedThisFrame()) {
@@ -193,22 +362,39 @@ RasterStatus Rasterizer::Draw(
                  ->RunsTasksOnCurrentThread());
 
   RasterStatus raster_status = RasterStatus::kFailed;
+  bool skipped_frame = false;
   LayerTreePipeline::Consumer consumer =
       [&](std::unique_ptr<LayerTreeItem> item) {
         std::shared_ptr<LayerTree> layer_tree = std::move(item->layer_tree);
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder =
             std::move(item->frame_timings_recorder);
+        skipped_frame = true;
         if (discard_callback(*layer_tree.get())) {
+          // Frames built for an obsolete size, e.g. while the window is being
+          // resized, are never shown.
+          TRACE_EVENT0("flutter", "Rasterizer::DiscardFrame");
+          raster_status = RasterStatus::kDiscarded;
+        } else if (ShouldDropStaleFrame(*frame_timings_recorder, *pipeline)) {
+          TRACE_EVENT0("flutter", "Rasterizer::DropStaleFrame");
           raster_status = RasterStatus::kDiscarded;
+          delegate_.OnFrameDropped();
         } else {
+          skipped_frame = false;
           raster_status =
               DoDraw(std::move(frame_timings_recorder), std::move(layer_tree));
         }
       };
 
-  PipelineConsumeResult consume_result = pipeline->Consume(consumer);
+  // Discarded and stale frames are skipped up to the newest frame in the
+  // pipeline, which is drawn right away rather than after yielding to the
+  // event loop.
+  PipelineConsumeResult consume_result;
+  do {
+    consume_result = pipeline->Consume(consumer);
+  } while (skipped_frame &&
+           consume_result == PipelineConsumeResult::MoreAvailable);
   if (consume_result == PipelineConsumeResult::NoneAvailable) {
-    return RasterStatus::kFailed;
+    return skipped_frame ? raster_status : RasterStatus::kFailed;
   }
   // if the raster status is to resubmit the frame, we push the frame to the
   // front of the queue and also change the consume status to more available.
@@ -260,6 +446,21 @@ bool Rasterizer::ShouldResubmitFrame(const RasterStatus& raster_status) {
          raster_status == RasterStatus::kSkipAndRetry;
 }
 
+bool Rasterizer::ShouldDropStaleFrame(
+    const FrameTimingsRecorder& frame_timings_recorder,
+    LayerTreePipeline& pipeline) {
+  const uint32_t threshold_frames =
+      delegate_.GetSettings().stale_frame_threshold_frames;
+  // The last frame in the pipeline is always drawn.
+  if (threshold_frames == 0 || !pipeline.HasAvailable()) {
+    return false;
+  }
+  const auto threshold = fml::TimeDelta::FromMillisecondsF(
+      delegate_.GetFrameBudget().count() * threshold_frames);
+  return fml::TimePoint::Now() - frame_timings_recorder.GetVsyncTargetTime() >
+         threshold;
+}
+
 namespace {
 std::unique_ptr<SnapshotDelegate::GpuImageResult> MakeBitmapImage(
     const sk_sp<DisplayList>& display_list,
@@ -389,8 +590,20 @@ RasterStatus Rasterizer::DoDraw(
   PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
   persistent_cache->ResetStoredNewShaders();
 
-  RasterStatus raster_status =
-      DrawToSurface(*frame_timings_recorder, *layer_tree);
+  RasterStatus raster_status;
+  if (IsUnchangedFrame(*layer_tree)) {
+    // The surface already shows this frame, so it is neither rasterized nor
+    // presented again.
+    TRACE_EVENT0("flutter", "Rasterizer::SkipUnchangedFrame");
+    frame_timings_recorder->RecordRasterStart(fml::TimePoint::Now());
+    frame_timings_recorder->RecordRasterEnd(
+        &compositor_context_->raster_cache());
+    FireNextFrameCallbackIfPresent();
+    raster_status = RasterStatus::kSuccess;
+  } else {
+    raster_status = DrawToSurface(*frame_timings_recorder, *layer_tree);
+    last_layer_tree_presented_ = raster_status == RasterStatus::kSuccess;
+  }
   if (raster_status == RasterStatus::kSuccess) {
     last_layer_tree_ = std::move(layer_tree);
   } else if (ShouldResubmitFrame(raster_status)) {
@@ -409,11 +622,29 @@ RasterStatus Rasterizer::DoDraw(
     persistent_cache->DumpSkp(*screenshot.data);
   }
 
+  if (display_list_capture_ && raster_status == RasterStatus::kSuccess) {
+    if (!display_list_capture_->CaptureFrame(
+            frame_timings_recorder->GetFrameNumber(), *last_layer_tree_,
+            compositor_context_->texture_registry(),
+            surface_->GetContext())) {
+      display_list_capture_.reset();
+    }
+  }
+
   // TODO(liyuqian): in Fuchsia, the rasterization doesn't finish when
   // Rasterizer::DoDraw finishes. Future work is needed to adapt the timestamp
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
   delegate_.OnFrameRasterized(frame_timings_recorder->GetRecordedTime());
 
+#if IMPELLER_SUPPORTS_RENDERING
+  // The GPU time of the passes of this frame is reported once they complete.
+  if (auto context = impeller_context_.lock()) {
+    if (auto tracer = context->GetGPUTracer()) {
+      tracer->MarkFrameEnd();
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 // SceneDisplayLag events are disabled on Fuchsia.
 // see: https://github.com/flutter/flutter/issues/56598
 #if !defined(OS_FUCHSIA)
@@ -448,6 +679,20 @@ RasterStatus Rasterizer::DoDraw(
   }
 #endif
 
+  // Spend the time that is left before the target time of this frame on the
+  // SkSLs that the warmup has not precompiled yet.
+  if (persistent_cache->HasPendingSkSLs() && surface_->GetContext()) {
+    const fml::TimePoint deadline =
+        frame_timings_recorder->GetVsyncTargetTime();
+    if (fml::TimePoint::Now() < deadline) {
+      auto context_switch = surface_->MakeRenderContextCurrent();
+      if (context_switch->GetResult()) {
+        persistent_cache->PrecompilePendingSkSLs(surface_->GetContext(),
+                                                 deadline);
+      }
+    }
+  }
+
   // Pipeline pressure is applied from a couple of places:
   // rasterizer: When there are more items as of the time of Consume.
   // animator (via shell): Frame gets produces every vsync.
@@ -474,6 +719,22 @@ RasterStatus Rasterizer::DoDraw(
   return raster_status;
 }
 
+bool Rasterizer::IsUnchangedFrame(flutter::LayerTree& layer_tree) {
+  if (!surface_->AllowsSkippingUnchangedFrames()) {
+    return false;
+  }
+  // Every layer tree is diffed, even the ones that can't be skipped, so that
+  // the paint regions the next layer tree is diffed against are known.
+  FrameDamage damage;
+  damage.SetPreviousLayerTree(last_layer_tree_.get());
+  damage.SetTextureRegistry(compositor_context_->texture_registry().get());
+  const bool unchanged = damage.IsUnchanged(
+      layer_tree, surface_->EnableRasterCache() &&
+                      !layer_tree.is_leaf_layer_tracing_enabled());
+  return unchanged && last_layer_tree_presented_ &&
+         !layer_tree.is_leaf_layer_tracing_enabled();
+}
+
 RasterStatus Rasterizer::DrawToSurface(
     FrameTimingsRecorder& frame_timings_recorder,
     flutter::LayerTree& layer_tree) {
@@ -554,6 +815,11 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
   if (compositor_frame) {
     compositor_context_->raster_cache().BeginFrame();
 
+    if (!embedder_root_canvas && !frame->GetDisplayListBuilder() &&
+        frame->framebuffer_info().supports_readback) {
+      compositor_frame->set_readback_surface(frame->SkiaSurface().get());
+    }
+
     std::unique_ptr<FrameDamage> damage;
     // when leaf layer tracing is enabled we wish to repaint the whole frame
     // for accurate performance metrics.
@@ -568,6 +834,7 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
           (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
 
       damage = std::make_unique<FrameDamage>();
+      damage->SetTextureRegistry(compositor_context_->texture_registry().get());
       if (frame->framebuffer_info().existing_damage && !force_full_repaint) {
         damage->SetPreviousLayerTree(last_layer_tree_.get());
         damage->AddAdditionalDamage(*frame->framebuffer_info().existing_damage);
@@ -618,6 +885,10 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
       frame->Submit();
     }
 
+    // The next frame only needs to repaint the textures that change after
+    // this one.
+    compositor_context_->texture_registry()->ClearDirtyTextures();
+
     // Do not update raster cache metrics for kResubmit because that status
     // indicates that the frame was not actually painted.
     if (raster_status != RasterStatus::kResubmit) {
@@ -630,6 +901,7 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
 
     if (surface_->GetContext()) {
       surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
+      skia_cache_memory_count_.Update(GetResourceCacheUsage());
     }
 
     return raster_status;
@@ -669,11 +941,10 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
   return recorder.finishRecordingAsPicture()->serialize(&procs);
 }
 
-sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
+sk_sp<SkImage> Rasterizer::ScreenshotLayerTreeAsImage(
     flutter::LayerTree* tree,
     flutter::CompositorContext& compositor_context,
-    GrDirectContext* surface_context,
-    bool compressed) {
+    GrDirectContext* surface_context) {
   // Attempt to create a snapshot surface depending on whether we have access
   // to a valid GPU rendering context.
   std::unique_ptr<OffscreenSurface> snapshot_surface =
@@ -717,46 +988,59 @@ sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
   frame->Raster(*tree, true, nullptr);
   canvas->Flush();
 
-  return snapshot_surface->GetRasterData(compressed);
+  return snapshot_surface->GetRasterImage();
 }
 
-Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
-    Rasterizer::ScreenshotType type,
-    bool base64_encode) {
+Rasterizer::ScreenshotCapture Rasterizer::CaptureLastLayerTree(
+    Rasterizer::ScreenshotType type) {
   auto* layer_tree = GetLastLayerTree();
   if (layer_tree == nullptr) {
     FML_LOG(ERROR) << "Last layer tree was null when screenshotting.";
     return {};
   }
 
-  sk_sp<SkData> data = nullptr;
-  std::string format;
+  ScreenshotCapture capture;
+  capture.frame_size = layer_tree->frame_size();
 
   GrDirectContext* surface_context =
       surface_ ? surface_->GetContext() : nullptr;
 
   switch (type) {
     case ScreenshotType::SkiaPicture:
-      format = "ScreenshotType::SkiaPicture";
-      data = ScreenshotLayerTreeAsPicture(layer_tree, *compositor_context_);
+      capture.format = "ScreenshotType::SkiaPicture";
+      // The picture may reference GPU images, so it is serialized here.
+      capture.data =
+          ScreenshotLayerTreeAsPicture(layer_tree, *compositor_context_);
       break;
     case ScreenshotType::UncompressedImage:
-      format = "ScreenshotType::UncompressedImage";
-      data = ScreenshotLayerTreeAsImage(layer_tree, *compositor_context_,
-                                        surface_context, false);
+      capture.format = "ScreenshotType::UncompressedImage";
+      capture.image = ScreenshotLayerTreeAsImage(
+          layer_tree, *compositor_context_, surface_context);
       break;
     case ScreenshotType::CompressedImage:
-      format = "ScreenshotType::CompressedImage";
-      data = ScreenshotLayerTreeAsImage(layer_tree, *compositor_context_,
-                                        surface_context, true);
+      capture.format = "ScreenshotType::CompressedImage";
+      capture.image = ScreenshotLayerTreeAsImage(
+          layer_tree, *compositor_context_, surface_context);
+      capture.compressed = true;
       break;
     case ScreenshotType::SurfaceData: {
       Surface::SurfaceData surface_data = surface_->GetSurfaceData();
-      format = surface_data.pixel_format;
-      data = surface_data.data;
+      capture.format = surface_data.pixel_format;
+      capture.data = surface_data.data;
       break;
     }
   }
+  return capture;
+}
+
+Rasterizer::Screenshot Rasterizer::FinishScreenshot(ScreenshotCapture capture,
+                                                    bool base64_encode) {
+  sk_sp<SkData> data = std::move(capture.data);
+  if (capture.image) {
+    TRACE_EVENT0("flutter", "Rasterizer::EncodeScreenshot");
+    data = OffscreenSurface::EncodeRasterImage(capture.image,
+                                               capture.compressed);
+  }
 
   if (data == nullptr) {
     FML_LOG(ERROR) << "Screenshot data was null.";
@@ -767,10 +1051,35 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
     size_t b64_size = SkBase64::Encode(data->data(), data->size(), nullptr);
     auto b64_data = SkData::MakeUninitialized(b64_size);
     SkBase64::Encode(data->data(), data->size(), b64_data->writable_data());
-    return Rasterizer::Screenshot{b64_data, layer_tree->frame_size(), format};
+    return Rasterizer::Screenshot{b64_data, capture.frame_size,
+                                  capture.format};
   }
 
-  return Rasterizer::Screenshot{data, layer_tree->frame_size(), format};
+  return Rasterizer::Screenshot{data, capture.frame_size, capture.format};
+}
+
+Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
+    Rasterizer::ScreenshotType type,
+    bool base64_encode) {
+  return FinishScreenshot(CaptureLastLayerTree(type), base64_encode);
+}
+
+void Rasterizer::ScreenshotLastLayerTree(
+    Rasterizer::ScreenshotType type,
+    bool base64_encode,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner,
+    const std::function<void(Screenshot)>& callback) {
+  ScreenshotCapture capture = CaptureLastLayerTree(type);
+  bool needs_encoding =
+      capture.image || (capture.data != nullptr && base64_encode);
+  if (!worker_task_runner || !needs_encoding) {
+    callback(FinishScreenshot(std::move(capture), base64_encode));
+    return;
+  }
+  worker_task_runner->PostTask(
+      [capture = std::move(capture), base64_encode, callback]() mutable {
+        callback(FinishScreenshot(std::move(capture), base64_encode));
+      });
 }
 
 void Rasterizer::SetNextFrameCallback(const fml::closure& callback) {
@@ -5,6 +5,7 @@
 #ifndef SHELL_COMMON_RASTERIZER_H_
 #define SHELL_COMMON_RASTERIZER_H_
 
+#include <functional>
 #include <memory>
 #include <optional>
 
@@ -17,6 +18,8 @@
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/memory/memory_counter.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
@@ -29,6 +32,8 @@
 #include "flutter/impeller/renderer/context.h"   // nogncheck
 #endif                                           // IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/snapshot_delegate.h"
+#include "flutter/shell/common/display_list_capture.h"
+#include "flutter/shell/common/memory_governor.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/snapshot_controller.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
@@ -93,6 +98,14 @@ class Rasterizer final : public SnapshotDelegate,
     ///
     virtual void OnFrameRasterized(const FrameTiming& frame_timing) = 0;
 
+    /// Notifies the delegate that a frame was dropped without being
+    /// rasterized, because its target time had long passed and a newer frame
+    /// was waiting to be rasterized.
+    ///
+    /// @see        `Settings::stale_frame_threshold_frames`
+    ///
+    virtual void OnFrameDropped() = 0;
+
     /// Time limit for a smooth frame.
     ///
     /// See: `DisplayManager::GetMainDisplayRefreshRate`.
@@ -194,6 +207,19 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   void NotifyLowMemoryWarning() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Registers the caches of the rasterizer with the memory
+  ///             governor, which trims them under memory pressure. These are
+  ///             the GPU resource cache of the Skia context, the raster cache,
+  ///             and the render target pool and tessellation cache of
+  ///             Impeller. The caches are removed from the governor when the
+  ///             rasterizer is destroyed.
+  ///
+  /// @param[in]  memory_governor  The governor, or nullptr to only remove the
+  ///                              caches from the current one.
+  ///
+  void SetMemoryGovernor(std::shared_ptr<MemoryGovernor> memory_governor);
+
   //----------------------------------------------------------------------------
   /// @brief      Gets a weak pointer to the rasterizer. The rasterizer may only
   ///             be accessed on the raster task runner.
@@ -381,6 +407,31 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   Screenshot ScreenshotLastLayerTree(ScreenshotType type, bool base64_encode);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Screenshots the last layer tree like the synchronous variant,
+  ///             but only renders and reads back the layer tree on the raster
+  ///             thread. The PNG and Base 64 encoding of the data are
+  ///             performed on the given worker task runner, so that large
+  ///             screenshots do not hold up the frames that follow.
+  ///
+  /// @param[in]  type                The type of the screenshot to gather.
+  /// @param[in]  base64_encode       Whether Base 64 encoding must be applied
+  ///                                 to the data after a screenshot has been
+  ///                                 captured.
+  /// @param[in]  worker_task_runner  The task runner on which the data is
+  ///                                 encoded. If it is null, the data is
+  ///                                 encoded on the raster thread.
+  /// @param[in]  callback            The callback invoked with the screenshot.
+  ///                                 It is invoked on the worker task runner,
+  ///                                 or on the raster thread if there is
+  ///                                 nothing left to encode.
+  ///
+  void ScreenshotLastLayerTree(
+      ScreenshotType type,
+      bool base64_encode,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner,
+      const std::function<void(Screenshot)>& callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Sets a callback that will be executed when the next layer tree
   ///             in rendered to the on-screen surface. This is used by
@@ -548,16 +599,35 @@ class Rasterizer final : public SnapshotDelegate,
     return delegate_.GetIsGpuDisabledSyncSwitch();
   }
 
-  sk_sp<SkData> ScreenshotLayerTreeAsImage(
+  // The part of a screenshot that is gathered on the raster thread. Either
+  // |data| holds the data of the screenshot, or |image| holds the raster
+  // image that still has to be encoded into it.
+  struct ScreenshotCapture {
+    sk_sp<SkData> data;
+    sk_sp<SkImage> image;
+    bool compressed = false;
+    SkISize frame_size = SkISize::MakeEmpty();
+    std::string format;
+  };
+
+  ScreenshotCapture CaptureLastLayerTree(ScreenshotType type);
+
+  static Screenshot FinishScreenshot(ScreenshotCapture capture,
+                                     bool base64_encode);
+
+  sk_sp<SkImage> ScreenshotLayerTreeAsImage(
       flutter::LayerTree* tree,
       flutter::CompositorContext& compositor_context,
-      GrDirectContext* surface_context,
-      bool compressed);
+      GrDirectContext* surface_context);
 
   RasterStatus DoDraw(
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder,
       std::shared_ptr<flutter::LayerTree> layer_tree);
 
+  // Whether the layer tree renders identically to the last layer tree, which
+  // the surface is still showing.
+  bool IsUnchangedFrame(flutter::LayerTree& layer_tree);
+
   RasterStatus DrawToSurface(FrameTimingsRecorder& frame_timings_recorder,
                              flutter::LayerTree& layer_tree);
 
@@ -566,17 +636,29 @@ class Rasterizer final : public SnapshotDelegate,
 
   void FireNextFrameCallbackIfPresent();
 
+  size_t GetResourceCacheUsage() const;
+
+  void TrimResourceCache(size_t max_bytes);
+
   static bool NoDiscard(const flutter::LayerTree& layer_tree) { return false; }
   static bool ShouldResubmitFrame(const RasterStatus& raster_status);
 
+  // Whether the frame is stale enough to be dropped for a newer one that is
+  // waiting in the pipeline.
+  bool ShouldDropStaleFrame(const FrameTimingsRecorder& frame_timings_recorder,
+                            LayerTreePipeline& pipeline);
+
   Delegate& delegate_;
   MakeGpuImageBehavior gpu_image_behavior_;
   std::weak_ptr<impeller::Context> impeller_context_;
   std::unique_ptr<Surface> surface_;
   std::unique_ptr<SnapshotSurfaceProducer> snapshot_surface_producer_;
   std::unique_ptr<flutter::CompositorContext> compositor_context_;
-  // This is the last successfully rasterized layer tree.
+  // This is the last successfully rasterized layer tree, or the last layer
+  // tree that was found to render identically to it.
   std::shared_ptr<flutter::LayerTree> last_layer_tree_;
+  // Whether the surface shows |last_layer_tree_|.
+  bool last_layer_tree_presented_ = false;
   // Set when we need attempt to rasterize the layer tree again. This layer_tree
   // has not successfully rasterized. This can happen due to the change in the
   // thread configuration. This will be inserted to the front of the pipeline.
@@ -588,6 +670,12 @@ class Rasterizer final : public SnapshotDelegate,
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<SnapshotController> snapshot_controller_;
+  std::unique_ptr<DisplayListCapture> display_list_capture_;
+  std::shared_ptr<MemoryGovernor> memory_governor_;
+  std::vector<int64_t> memory_governor_client_ids_;
+  // The Skia resource cache usage as of the last frame, on the
+  // "skia_resource_cache" memory counter.
+  fml::ScopedMemoryCount skia_cache_memory_count_;
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
@@ -10,6 +10,9 @@
 #include <optional>
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/texture_layer.h"
+#include "flutter/flow/testing/mock_texture.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
@@ -30,6 +33,7 @@ namespace {
 class MockDelegate : public Rasterizer::Delegate {
  public:
   MOCK_METHOD1(OnFrameRasterized, void(const FrameTiming& frame_timing));
+  MOCK_METHOD0(OnFrameDropped, void());
   MOCK_METHOD0(GetFrameBudget, fml::Milliseconds());
   MOCK_CONST_METHOD0(GetLatestFrameTargetTime, fml::TimePoint());
   MOCK_CONST_METHOD0(GetTaskRunners, const TaskRunners&());
@@ -1175,4 +1179,283 @@ TEST(RasterizerTest, presentationTimeNotSetWhenVsyncTargetInPast) {
   latch.Wait();
 }
 
+TEST(RasterizerTest, unchangedFramesAreNotPresented) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  ON_CALL(delegate, GetTaskRunners()).WillByDefault(ReturnRef(task_runners));
+  // Skipped frames are still reported as rasterized.
+  EXPECT_CALL(delegate, OnFrameRasterized(_)).Times(3);
+
+  const SkISize frame_size = SkISize::Make(800, 600);
+  int frames_submitted = 0;
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  ON_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillByDefault(Return(true));
+  ON_CALL(*surface, MakeRenderContextCurrent())
+      .WillByDefault(::testing::Invoke(
+          [] { return std::make_unique<GLContextDefaultResult>(true); }));
+  EXPECT_CALL(*surface, AcquireFrame(frame_size))
+      .Times(2)
+      .WillRepeatedly(::testing::Invoke([&](const SkISize& size) {
+        SurfaceFrame::FramebufferInfo framebuffer_info;
+        framebuffer_info.supports_readback = true;
+        return std::make_unique<SurfaceFrame>(
+            SkSurface::MakeRasterN32Premul(size.width(), size.height()),
+            framebuffer_info,
+            /*submit_callback=*/
+            [&](const SurfaceFrame&, DlCanvas*) {
+              frames_submitted++;
+              return true;
+            },
+            size);
+      }));
+
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto rasterizer = std::make_unique<Rasterizer>(delegate);
+    rasterizer->Setup(std::move(surface));
+    auto draw = [&](float device_pixel_ratio) {
+      auto layer_tree =
+          std::make_shared<LayerTree>(frame_size, device_pixel_ratio);
+      layer_tree->set_root_layer(std::make_shared<ContainerLayer>());
+      auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/10);
+      auto layer_tree_item = std::make_unique<LayerTreeItem>(
+          std::move(layer_tree), CreateFinishedBuildRecorder());
+      PipelineProduceResult result =
+          pipeline->Produce().Complete(std::move(layer_tree_item));
+      EXPECT_TRUE(result.success);
+      auto no_discard = [](LayerTree&) { return false; };
+      return rasterizer->Draw(pipeline, no_discard);
+    };
+
+    EXPECT_EQ(draw(2.0f), RasterStatus::kSuccess);
+    EXPECT_EQ(frames_submitted, 1);
+    // The second frame renders identically to the first one.
+    EXPECT_EQ(draw(2.0f), RasterStatus::kSuccess);
+    EXPECT_EQ(frames_submitted, 1);
+    // The third frame doesn't.
+    EXPECT_EQ(draw(3.0f), RasterStatus::kSuccess);
+    EXPECT_EQ(frames_submitted, 2);
+
+    rasterizer.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST(RasterizerTest, drawLastLayerTreeOnlyPresentsNewTextureFrames) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  ON_CALL(delegate, GetTaskRunners()).WillByDefault(ReturnRef(task_runners));
+
+  const SkISize frame_size = SkISize::Make(800, 600);
+  int frames_submitted = 0;
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  ON_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillByDefault(Return(true));
+  ON_CALL(*surface, MakeRenderContextCurrent())
+      .WillByDefault(::testing::Invoke(
+          [] { return std::make_unique<GLContextDefaultResult>(true); }));
+  EXPECT_CALL(*surface, AcquireFrame(frame_size))
+      .Times(2)
+      .WillRepeatedly(::testing::Invoke([&](const SkISize& size) {
+        SurfaceFrame::FramebufferInfo framebuffer_info;
+        framebuffer_info.supports_readback = true;
+        return std::make_unique<SurfaceFrame>(
+            SkSurface::MakeRasterN32Premul(size.width(), size.height()),
+            framebuffer_info,
+            /*submit_callback=*/
+            [&](const SurfaceFrame&, DlCanvas*) {
+              frames_submitted++;
+              return true;
+            },
+            size);
+      }));
+
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto rasterizer = std::make_unique<Rasterizer>(delegate);
+    rasterizer->Setup(std::move(surface));
+    auto registry = rasterizer->GetTextureRegistry();
+    registry->RegisterTexture(std::make_shared<MockTexture>(0));
+
+    auto layer_tree = std::make_shared<LayerTree>(frame_size, 1.0f);
+    auto root = std::make_shared<ContainerLayer>();
+    root->Add(std::make_shared<TextureLayer>(
+        SkPoint::Make(0, 0), SkSize::Make(100, 100), 0, false,
+        DlImageSampling::kLinear));
+    layer_tree->set_root_layer(root);
+    auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/10);
+    auto layer_tree_item = std::make_unique<LayerTreeItem>(
+        std::move(layer_tree), CreateFinishedBuildRecorder());
+    PipelineProduceResult result =
+        pipeline->Produce().Complete(std::move(layer_tree_item));
+    EXPECT_TRUE(result.success);
+    auto no_discard = [](LayerTree&) { return false; };
+    EXPECT_EQ(rasterizer->Draw(pipeline, no_discard), RasterStatus::kSuccess);
+    EXPECT_EQ(frames_submitted, 1);
+
+    // The texture has no new frame, so the surface already shows the frame.
+    rasterizer->DrawLastLayerTree(CreateFinishedBuildRecorder());
+    EXPECT_EQ(frames_submitted, 1);
+
+    registry->MarkNewFrameAvailable(0);
+    rasterizer->DrawLastLayerTree(CreateFinishedBuildRecorder());
+    EXPECT_EQ(frames_submitted, 2);
+
+    rasterizer.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST(RasterizerTest, drawDropsStaleFramesForNewestFrame) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.stale_frame_threshold_frames = 2;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  ON_CALL(delegate, GetTaskRunners()).WillByDefault(ReturnRef(task_runners));
+  ON_CALL(delegate, GetFrameBudget())
+      .WillByDefault(Return(fml::Milliseconds(16)));
+  // The two stale frames are dropped, and only the newest one is rasterized.
+  EXPECT_CALL(delegate, OnFrameDropped()).Times(2);
+  EXPECT_CALL(delegate, OnFrameRasterized(_)).Times(1);
+
+  const SkISize frame_size = SkISize::Make(800, 600);
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  ON_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillByDefault(Return(true));
+  ON_CALL(*surface, MakeRenderContextCurrent())
+      .WillByDefault(::testing::Invoke(
+          [] { return std::make_unique<GLContextDefaultResult>(true); }));
+  EXPECT_CALL(*surface, AcquireFrame(frame_size))
+      .WillOnce(::testing::Invoke([&](const SkISize& size) {
+        SurfaceFrame::FramebufferInfo framebuffer_info;
+        framebuffer_info.supports_readback = true;
+        return std::make_unique<SurfaceFrame>(
+            SkSurface::MakeRasterN32Premul(size.width(), size.height()),
+            framebuffer_info,
+            /*submit_callback=*/
+            [](const SurfaceFrame&, DlCanvas*) { return true; }, size);
+      }));
+
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto rasterizer = std::make_unique<Rasterizer>(delegate);
+    rasterizer->Setup(std::move(surface));
+    auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/10);
+    const auto now = fml::TimePoint::Now();
+    for (auto target_time : {now - fml::TimeDelta::FromMilliseconds(100),
+                             now - fml::TimeDelta::FromMilliseconds(50),
+                             now}) {
+      auto layer_tree =
+          std::make_shared<LayerTree>(frame_size, /*device_pixel_ratio=*/2.0f);
+      layer_tree->set_root_layer(std::make_shared<ContainerLayer>());
+      auto layer_tree_item = std::make_unique<LayerTreeItem>(
+          std::move(layer_tree), CreateFinishedBuildRecorder(target_time));
+      PipelineProduceResult result =
+          pipeline->Produce().Complete(std::move(layer_tree_item));
+      EXPECT_TRUE(result.success);
+    }
+    auto no_discard = [](LayerTree&) { return false; };
+    EXPECT_EQ(rasterizer->Draw(pipeline, no_discard), RasterStatus::kSuccess);
+    EXPECT_FALSE(pipeline->HasAvailable());
+
+    rasterizer.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
+TEST(RasterizerTest, drawDiscardsFramesOfObsoleteSizesForNewestFrame) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  ON_CALL(delegate, GetTaskRunners()).WillByDefault(ReturnRef(task_runners));
+  // Discarded frames aren't counted as dropped.
+  EXPECT_CALL(delegate, OnFrameDropped()).Times(0);
+  EXPECT_CALL(delegate, OnFrameRasterized(_)).Times(1);
+
+  const SkISize frame_size = SkISize::Make(800, 600);
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  ON_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillByDefault(Return(true));
+  ON_CALL(*surface, MakeRenderContextCurrent())
+      .WillByDefault(::testing::Invoke(
+          [] { return std::make_unique<GLContextDefaultResult>(true); }));
+  EXPECT_CALL(*surface, AcquireFrame(frame_size))
+      .WillOnce(::testing::Invoke([&](const SkISize& size) {
+        SurfaceFrame::FramebufferInfo framebuffer_info;
+        framebuffer_info.supports_readback = true;
+        return std::make_unique<SurfaceFrame>(
+            SkSurface::MakeRasterN32Premul(size.width(), size.height()),
+            framebuffer_info,
+            /*submit_callback=*/
+            [](const SurfaceFrame&, DlCanvas*) { return true; }, size);
+      }));
+
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto rasterizer = std::make_unique<Rasterizer>(delegate);
+    rasterizer->Setup(std::move(surface));
+    auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/10);
+    // Frames built while the window was being resized to 800x600.
+    for (auto size : {SkISize::Make(400, 300), SkISize::Make(600, 450),
+                      frame_size}) {
+      auto layer_tree =
+          std::make_shared<LayerTree>(size, /*device_pixel_ratio=*/2.0f);
+      layer_tree->set_root_layer(std::make_shared<ContainerLayer>());
+      auto layer_tree_item = std::make_unique<LayerTreeItem>(
+          std::move(layer_tree), CreateFinishedBuildRecorder());
+      PipelineProduceResult result =
+          pipeline->Produce().Complete(std::move(layer_tree_item));
+      EXPECT_TRUE(result.success);
+    }
+    auto discard_obsolete_sizes = [&](LayerTree& tree) {
+      return tree.frame_size() != frame_size;
+    };
+    EXPECT_EQ(rasterizer->Draw(pipeline, discard_obsolete_sizes),
+              RasterStatus::kSuccess);
+    EXPECT_FALSE(pipeline->HasAvailable());
+
+    rasterizer.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 #include "flutter/shell/common/shell.h"
 
+#include <charconv>
 #include <memory>
 #include <sstream>
 #include <utility>
@@ -13,11 +14,13 @@
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/base32.h"
+#include "flutter/fml/build_config.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
 #include "flutter/fml/log_settings.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/memory_counter.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
@@ -32,6 +35,11 @@
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
+#include "txt/platform.h"
+
+#if IMPELLER_SUPPORTS_RENDERING
+#include "impeller/entity/contents/pipeline_variant_manifest.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
 
 namespace flutter {
 
@@ -114,6 +122,36 @@ void PerformInitializationTasks(Settings& settings) {
   });
 
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
+  PersistentCache::SetEagerSkSLWarmupCount(settings.eager_sksl_warmup_count);
+
+#if IMPELLER_SUPPORTS_RENDERING
+  if (settings.enable_impeller && !PersistentCache::gIsReadOnly) {
+    static std::once_flag gPipelineVariantManifestInitialization = {};
+    std::call_once(gPipelineVariantManifestInitialization, [] {
+      impeller::PipelineVariantManifest::SetCacheDirectory(
+          fml::OpenDirectory(fml::paths::GetCachesDirectory(), "impeller",
+                             true, fml::FilePermission::kReadWrite));
+    });
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+// Reads the mapping one page at a time so that its pages are resident before
+// it is accessed from a thread that shouldn't wait on storage.
+void PrefaultMapping(const fml::Mapping* mapping) {
+  if (!mapping || !mapping->GetMapping()) {
+    return;
+  }
+  fml::PrefetchMapping(*mapping);
+  // Strides by the smallest page size in use, which touches pages more than
+  // once where they are larger but never skips one.
+  constexpr size_t kPageSize = 4096u;
+  const volatile uint8_t* bytes = mapping->GetMapping();
+  uint8_t sum = 0u;
+  for (size_t offset = 0u; offset < mapping->GetSize(); offset += kPageSize) {
+    sum += bytes[offset];
+  }
+  (void)sum;
 }
 
 }  // namespace
@@ -133,11 +171,35 @@ std::unique_ptr<Shell> Shell::Create(
   // Always use the `vm_snapshot` and `isolate_snapshot` provided by the
   // settings to launch the VM.  If the VM is already running, the snapshot
   // arguments are ignored.
-  auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
-  auto isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
-  auto vm = DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
+  fml::RefPtr<const DartSnapshot> vm_snapshot;
+  fml::RefPtr<const DartSnapshot> isolate_snapshot;
+  {
+    TRACE_EVENT0("flutter", "ShellMapSnapshots");
+    vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
+    isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
+  }
+  auto vm = [&]() {
+    TRACE_EVENT0("flutter", "ShellCreateDartVM");
+    return DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
+  }();
   FML_CHECK(vm) << "Must be able to initialize the VM.";
 
+  // Loading the system fonts is slow and is otherwise only started once the
+  // engine has been created. Start it now on a worker, so that it overlaps
+  // with the creation of the platform view, the GPU contexts and the engine.
+  // The default font manager of the platform is shared by the process, so the
+  // manager set up by the engine later is the one that is loaded here. This
+  // does not hold on Fuchsia, where a new manager is created for each engine.
+#if !defined(OS_FUCHSIA)
+  if (!settings.prefetched_default_font_manager) {
+    vm->GetConcurrentWorkerTaskRunner()->PostTask(
+        [font_initialization_data = settings.font_initialization_data]() {
+          TRACE_EVENT0("flutter", "ShellPrefetchDefaultFontManager");
+          txt::GetDefaultFontManager(font_initialization_data);
+        });
+  }
+#endif  // !defined(OS_FUCHSIA)
+
   // If the settings did not specify an `isolate_snapshot`, fall back to the
   // one the VM was launched with.
   if (!isolate_snapshot) {
@@ -146,11 +208,14 @@ std::unique_ptr<Shell> Shell::Create(
   auto resource_cache_limit_calculator =
       std::make_shared<ResourceCacheLimitCalculator>(
           settings.resource_cache_max_bytes_threshold);
+  auto memory_governor =
+      std::make_shared<MemoryGovernor>(settings.memory_budget_bytes);
   return CreateWithSnapshot(platform_data,                    //
                             task_runners,                     //
                             /*parent_merger=*/nullptr,        //
                             /*parent_io_manager=*/nullptr,    //
                             resource_cache_limit_calculator,  //
+                            memory_governor,                  //
                             settings,                         //
                             std::move(vm),                    //
                             std::move(isolate_snapshot),      //
@@ -165,6 +230,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     std::shared_ptr<ShellIOManager> parent_io_manager,
     const std::shared_ptr<ResourceCacheLimitCalculator>&
         resource_cache_limit_calculator,
+    const std::shared_ptr<MemoryGovernor>& memory_governor,
     const TaskRunners& task_runners,
     const PlatformData& platform_data,
     const Settings& settings,
@@ -180,14 +246,18 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
   auto shell = std::unique_ptr<Shell>(
       new Shell(std::move(vm), task_runners, std::move(parent_merger),
-                resource_cache_limit_calculator, settings,
+                resource_cache_limit_calculator, memory_governor, settings,
                 std::make_shared<VolatilePathTracker>(
                     task_runners.GetUITaskRunner(),
                     !settings.skia_deterministic_rendering_on_cpu),
                 is_gpu_disabled));
 
   // Create the platform view on the platform thread (this thread).
-  auto platform_view = on_create_platform_view(*shell.get());
+  std::unique_ptr<PlatformView> platform_view;
+  {
+    TRACE_EVENT0("flutter", "ShellSetupPlatformView");
+    platform_view = on_create_platform_view(*shell.get());
+  }
   if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
@@ -209,6 +279,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
         rasterizer->SetImpellerContext(impeller_context);
+        rasterizer->SetMemoryGovernor(shell->memory_governor_);
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
@@ -265,6 +336,11 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  if (settings.enable_pointer_resampling) {
+    dispatcher_maker = [](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<ResamplingPointerDataDispatcher>(delegate);
+    };
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -286,8 +362,16 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
+        const auto& settings = shell->GetSettings();
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            settings.frame_pipeline_depth,
+            fml::TimeDelta::FromMilliseconds(
+                settings.frame_pipeline_latency_budget_ms),
+            shell->frame_deadline_scheduler_,
+            settings.enable_adaptive_frame_rate
+                ? std::make_unique<FrameRateSelector>()
+                : nullptr);
 
         engine_promise.set_value(
             on_create_engine(*shell,                          //
@@ -322,6 +406,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
     const std::shared_ptr<ShellIOManager>& parent_io_manager,
     const std::shared_ptr<ResourceCacheLimitCalculator>&
         resource_cache_limit_calculator,
+    const std::shared_ptr<MemoryGovernor>& memory_governor,
     Settings settings,
     DartVMRef vm,
     fml::RefPtr<const DartSnapshot> isolate_snapshot,
@@ -350,6 +435,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
                          parent_thread_merger,                               //
                          parent_io_manager,                                  //
                          resource_cache_limit_calculator,                    //
+                         memory_governor,                                    //
                          task_runners = task_runners,                        //
                          platform_data = platform_data,                      //
                          settings = settings,                                //
@@ -363,6 +449,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
                                             parent_thread_merger,             //
                                             parent_io_manager,                //
                                             resource_cache_limit_calculator,  //
+                                            memory_governor,                  //
                                             task_runners,                     //
                                             platform_data,                    //
                                             settings,                         //
@@ -381,12 +468,14 @@ Shell::Shell(DartVMRef vm,
              fml::RefPtr<fml::RasterThreadMerger> parent_merger,
              const std::shared_ptr<ResourceCacheLimitCalculator>&
                  resource_cache_limit_calculator,
+             const std::shared_ptr<MemoryGovernor>& memory_governor,
              const Settings& settings,
              std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
              bool is_gpu_disabled)
     : task_runners_(task_runners),
       parent_raster_thread_merger_(std::move(parent_merger)),
       resource_cache_limit_calculator_(resource_cache_limit_calculator),
+      memory_governor_(memory_governor),
       settings_(settings),
       vm_(std::move(vm)),
       is_gpu_disabled_sync_switch_(new fml::SyncSwitch(is_gpu_disabled)),
@@ -398,6 +487,9 @@ Shell::Shell(DartVMRef vm,
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
   display_manager_ = std::make_unique<DisplayManager>();
+  if (settings_.enable_deadline_frame_scheduling) {
+    frame_deadline_scheduler_ = std::make_shared<FrameDeadlineScheduler>();
+  }
   resource_cache_limit_calculator->AddResourceCacheLimitItem(
       weak_factory_.GetWeakPtr());
 
@@ -448,6 +540,34 @@ Shell::Shell(DartVMRef vm,
           task_runners_.GetRasterTaskRunner(),
           std::bind(&Shell::OnServiceProtocolEstimateRasterCacheMemory, this,
                     std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetRasterCacheMetricsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetRasterCacheMetrics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFrameTimingPercentilesExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFrameTimingPercentiles, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetNativeStackSamplesExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetNativeStackSamples, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetGCMetricsExtensionName] = {
+      task_runners_.GetUITaskRunner(),
+      std::bind(&Shell::OnServiceProtocolGetGCMetrics, this,
+                std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetEngineMemoryUsageExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetEngineMemoryUsage, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetLayerCostsExtensionName] = {
+      task_runners_.GetRasterTaskRunner(),
+      std::bind(&Shell::OnServiceProtocolGetLayerCosts, this,
+                std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_
       [ServiceProtocol::kRenderFrameWithRasterStatsExtensionName] = {
           task_runners_.GetRasterTaskRunner(),
@@ -460,6 +580,8 @@ Shell::Shell(DartVMRef vm,
 }
 
 Shell::~Shell() {
+  stack_sampler_.reset();
+
   PersistentCache::GetCacheForProcess()->RemoveWorkerTaskRunner(
       task_runners_.GetIOTaskRunner());
 
@@ -526,9 +648,9 @@ std::unique_ptr<Shell> Shell::Spawn(
           .SetIfTrue([&is_gpu_disabled] { is_gpu_disabled = true; }));
   std::unique_ptr<Shell> result = CreateWithSnapshot(
       PlatformData{}, task_runners_, rasterizer_->GetRasterThreadMerger(),
-      io_manager_, resource_cache_limit_calculator_, GetSettings(), vm_,
-      vm_->GetVMData()->GetIsolateSnapshot(), on_create_platform_view,
-      on_create_rasterizer,
+      io_manager_, resource_cache_limit_calculator_, memory_governor_,
+      GetSettings(), vm_, vm_->GetVMData()->GetIsolateSnapshot(),
+      on_create_platform_view, on_create_rasterizer,
       [engine = this->engine_.get(), initial_route](
           Engine::Delegate& delegate,
           const PointerDataDispatcherMaker& dispatcher_maker, DartVM& vm,
@@ -554,23 +676,29 @@ std::unique_ptr<Shell> Shell::Spawn(
 }
 
 void Shell::NotifyLowMemoryWarning() const {
+  NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+}
+
+void Shell::NotifyMemoryPressure(MemoryPressureLevel level) const {
   auto trace_id = fml::tracing::TraceNonce();
-  TRACE_EVENT_ASYNC_BEGIN0("flutter", "Shell::NotifyLowMemoryWarning",
-                           trace_id);
-  // This does not require a current isolate but does require a running VM.
-  // Since a valid shell will not be returned to the embedder without a valid
-  // DartVMRef, we can be certain that this is a safe spot to assume a VM is
-  // running.
-  ::Dart_NotifyLowMemory();
+  TRACE_EVENT_ASYNC_BEGIN0("flutter", "Shell::NotifyMemoryPressure", trace_id);
+  if (level == MemoryPressureLevel::kCritical) {
+    // The engine defers the collection of the Dart heap to the next idle
+    // period of the UI task runner, so it doesn't land in the middle of a
+    // frame.
+    task_runners_.GetUITaskRunner()->PostTask([engine = weak_engine_]() {
+      if (engine) {
+        engine->NotifyLowMemoryWarning();
+      }
+    });
+  }
 
-  task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id]() {
-        if (rasterizer) {
-          rasterizer->NotifyLowMemoryWarning();
-        }
-        TRACE_EVENT_ASYNC_END0("flutter", "Shell::NotifyLowMemoryWarning",
-                               trace_id);
-      });
+  // The caches of the rasterizer are registered with the governor, which
+  // trims them on the raster task runner ahead of the task below.
+  memory_governor_->NotifyMemoryPressure(level);
+  task_runners_.GetRasterTaskRunner()->PostTask([trace_id = trace_id]() {
+    TRACE_EVENT_ASYNC_END0("flutter", "Shell::NotifyMemoryPressure", trace_id);
+  });
   // The IO Manager uses resource cache limits of 0, so it is not necessary
   // to purge them.
 }
@@ -707,6 +835,23 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
     PersistentCache::GetCacheForProcess()->Purge();
   }
 
+  if (settings_.native_stack_samples_per_second > 0 &&
+      StackSampler::IsSupported()) {
+    stack_sampler_ = std::make_shared<StackSampler>(
+        settings_.native_stack_samples_per_second);
+    std::weak_ptr<StackSampler> weak_sampler = stack_sampler_;
+    const auto register_thread = [weak_sampler](const char* name) {
+      return [weak_sampler, name]() {
+        if (auto sampler = weak_sampler.lock()) {
+          sampler->RegisterCurrentThread(name);
+        }
+      };
+    };
+    task_runners_.GetUITaskRunner()->PostTask(register_thread("ui"));
+    task_runners_.GetRasterTaskRunner()->PostTask(register_thread("raster"));
+    stack_sampler_->Start();
+  }
+
   return true;
 }
 
@@ -714,6 +859,10 @@ const Settings& Shell::GetSettings() const {
   return settings_;
 }
 
+const FrameTimingHistograms& Shell::GetFrameTimingHistograms() const {
+  return frame_timing_histograms_;
+}
+
 const TaskRunners& Shell::GetTaskRunners() const {
   return task_runners_;
 }
@@ -854,6 +1003,8 @@ void Shell::OnPlatformViewDestroyed() {
   // This incorrect assumption can lead to deadlock.
   rasterizer_->DisableThreadMergerIfNeeded();
 
+  platform_message_batch_.reset();
+
   // Notify the Dart VM that the PlatformView has been destroyed and some
   // cleanup activity can be done (e.g: garbage collect the Dart heap).
   task_runners_.GetUITaskRunner()->PostTask([engine = engine_->GetWeakPtr()]() {
@@ -918,6 +1069,7 @@ void Shell::OnPlatformViewScheduleFrame() {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  platform_message_batch_.reset();
   task_runners_.GetUITaskRunner()->PostTask([engine = engine_->GetWeakPtr()]() {
     if (engine) {
       engine->ScheduleFrame();
@@ -949,6 +1101,7 @@ void Shell::OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) {
         }
       });
 
+  platform_message_batch_.reset();
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), metrics]() {
         if (engine) {
@@ -970,14 +1123,32 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
-  // The static leak checker gets confused by the use of fml::MakeCopyable.
-  // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-  task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
-      [engine = engine_->GetWeakPtr(), message = std::move(message)]() mutable {
+  // Messages sent before the UI thread got to the last batch are appended to
+  // it, so that a burst of messages costs a single task and a single entry
+  // into Dart.
+  if (platform_message_batch_) {
+    std::scoped_lock lock(platform_message_batch_->mutex);
+    if (!platform_message_batch_->dispatched) {
+      platform_message_batch_->messages.push_back(std::move(message));
+      return;
+    }
+  }
+  auto batch = std::make_shared<PlatformMessageBatch>();
+  batch->messages.push_back(std::move(message));
+  platform_message_batch_ = batch;
+
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = engine_->GetWeakPtr(), batch = std::move(batch)]() {
+        std::vector<std::unique_ptr<PlatformMessage>> messages;
+        {
+          std::scoped_lock lock(batch->mutex);
+          batch->dispatched = true;
+          messages.swap(batch->messages);
+        }
         if (engine) {
-          engine->DispatchPlatformMessage(std::move(message));
+          engine->DispatchPlatformMessages(std::move(messages));
         }
-      }));
+      });
 }
 
 // |PlatformView::Delegate|
@@ -987,6 +1158,7 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  platform_message_batch_.reset();
   task_runners_.GetUITaskRunner()->PostTask(
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
                          flow_id = next_pointer_flow_id_]() mutable {
@@ -1004,6 +1176,7 @@ void Shell::OnPlatformViewDispatchSemanticsAction(int32_t node_id,
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  platform_message_batch_.reset();
   task_runners_.GetUITaskRunner()->PostTask(
       fml::MakeCopyable([engine = engine_->GetWeakPtr(), node_id, action,
                          args = std::move(args)]() mutable {
@@ -1018,6 +1191,7 @@ void Shell::OnPlatformViewSetSemanticsEnabled(bool enabled) {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  platform_message_batch_.reset();
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), enabled] {
         if (engine) {
@@ -1031,6 +1205,7 @@ void Shell::OnPlatformViewSetAccessibilityFeatures(int32_t flags) {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  platform_message_batch_.reset();
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), flags] {
         if (engine) {
@@ -1084,16 +1259,13 @@ void Shell::OnPlatformViewMarkTextureFrameAvailable(int64_t texture_id) {
           return;
         }
 
-        auto texture = registry->GetTexture(texture_id);
-
-        if (!texture) {
-          return;
-        }
-
-        texture->MarkNewFrameAvailable();
+        registry->MarkNewFrameAvailable(texture_id);
       });
 
-  // Schedule a new frame without having to rebuild the layer tree.
+  platform_message_batch_.reset();
+
+  // Schedule a new frame without having to rebuild the layer tree. Only the
+  // texture layers showing the texture are damaged when it is rasterized.
   task_runners_.GetUITaskRunner()->PostTask([engine = engine_->GetWeakPtr()]() {
     if (engine) {
       engine->ScheduleFrame(false);
@@ -1166,9 +1338,7 @@ void Shell::OnAnimatorDraw(std::shared_ptr<LayerTreePipeline> pipeline) {
   FML_DCHECK(is_setup_);
 
   auto discard_callback = [this](flutter::LayerTree& tree) {
-    std::scoped_lock<std::mutex> lock(resize_mutex_);
-    return !expected_frame_size_.isEmpty() &&
-           tree.frame_size() != expected_frame_size_;
+    return ShouldDiscardLayerTree(tree);
   };
 
   task_runners_.GetRasterTaskRunner()->PostTask(fml::MakeCopyable(
@@ -1197,16 +1367,29 @@ void Shell::OnAnimatorDrawLastLayerTree(
   FML_DCHECK(is_setup_);
 
   auto task = fml::MakeCopyable(
-      [rasterizer = rasterizer_->GetWeakPtr(),
+      [this, rasterizer = rasterizer_->GetWeakPtr(),
        frame_timings_recorder = std::move(frame_timings_recorder)]() mutable {
-        if (rasterizer) {
-          rasterizer->DrawLastLayerTree(std::move(frame_timings_recorder));
+        if (!rasterizer) {
+          return;
+        }
+        // Redrawing the last layer tree for new texture frames while the
+        // window is being resized would only draw a frame that is discarded.
+        auto last_layer_tree = rasterizer->GetLastLayerTree();
+        if (last_layer_tree && ShouldDiscardLayerTree(*last_layer_tree)) {
+          return;
         }
+        rasterizer->DrawLastLayerTree(std::move(frame_timings_recorder));
       });
 
   task_runners_.GetRasterTaskRunner()->PostTask(task);
 }
 
+bool Shell::ShouldDiscardLayerTree(const flutter::LayerTree& tree) {
+  std::scoped_lock<std::mutex> lock(resize_mutex_);
+  return !expected_frame_size_.isEmpty() &&
+         tree.frame_size() != expected_frame_size_;
+}
+
 // |Engine::Delegate|
 void Shell::OnEngineUpdateSemantics(SemanticsNodeUpdates update,
                                     CustomAccessibilityActionUpdates actions) {
@@ -1399,6 +1582,33 @@ void Shell::LoadDartDeferredLibraryError(intptr_t loading_unit_id,
       });
 }
 
+void Shell::PrefetchDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::unique_ptr<const fml::Mapping> snapshot_data,
+    std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  // The pages are faulted in on the IO thread before the mappings are handed
+  // to the engine, so that loading the unit on the UI thread doesn't block on
+  // reads from storage.
+  task_runners_.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+      [engine = weak_engine_, ui_task_runner = task_runners_.GetUITaskRunner(),
+       loading_unit_id, data = std::move(snapshot_data),
+       instructions = std::move(snapshot_instructions)]() mutable {
+        TRACE_EVENT1("flutter", "Shell::PrefetchDartDeferredLibrary",
+                     "loading_unit_id",
+                     std::to_string(loading_unit_id).c_str());
+        PrefaultMapping(data.get());
+        PrefaultMapping(instructions.get());
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [engine, loading_unit_id, data = std::move(data),
+             instructions = std::move(instructions)]() mutable {
+              if (engine) {
+                engine->PrefetchDartDeferredLibrary(
+                    loading_unit_id, std::move(data), std::move(instructions));
+              }
+            }));
+      }));
+}
+
 void Shell::UpdateAssetResolverByType(
     std::unique_ptr<AssetResolver> updated_asset_resolver,
     AssetResolver::AssetResolverType type) {
@@ -1454,6 +1664,11 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  frame_timing_histograms_.AddFrameTiming(timing);
+  if (frame_deadline_scheduler_) {
+    frame_deadline_scheduler_->AddFrameTiming(timing);
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1512,6 +1727,12 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   }
 }
 
+void Shell::OnFrameDropped() {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  frame_timing_histograms_.AddDroppedFrame();
+}
+
 fml::Milliseconds Shell::GetFrameBudget() {
   double display_refresh_rate = display_manager_->GetMainDisplayRefreshRate();
   if (display_refresh_rate > 0) {
@@ -1797,6 +2018,220 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+static rapidjson::Value SerializeRasterCacheMetrics(
+    const RasterCacheMetrics& metrics,
+    rapidjson::Document* response) {
+  auto& allocator = response->GetAllocator();
+  rapidjson::Value result;
+  result.SetObject();
+  result.AddMember<uint64_t>("count", metrics.total_count(), allocator);
+  result.AddMember<uint64_t>("bytes", metrics.total_bytes(), allocator);
+  result.AddMember<uint64_t>("hits", metrics.hit_count, allocator);
+  result.AddMember<uint64_t>("misses", metrics.miss_count, allocator);
+  result.AddMember<uint64_t>("evictions", metrics.eviction_count, allocator);
+  result.AddMember<uint64_t>("evictionBytes", metrics.eviction_bytes,
+                             allocator);
+  result.AddMember<int64_t>("timeSavedMicros",
+                            metrics.time_saved.ToMicroseconds(), allocator);
+  return result;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetRasterCacheMetrics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  const auto& raster_cache = rasterizer_->compositor_context()->raster_cache();
+  response->SetObject();
+  auto& allocator = response->GetAllocator();
+  response->AddMember("type", "RasterCacheMetrics", allocator);
+  response->AddMember<uint64_t>("byteBudget", raster_cache.byte_budget(),
+                                allocator);
+  rapidjson::Value layer =
+      SerializeRasterCacheMetrics(raster_cache.layer_metrics(), response);
+  response->AddMember("layer", layer, allocator);
+  rapidjson::Value picture =
+      SerializeRasterCacheMetrics(raster_cache.picture_metrics(), response);
+  response->AddMember("picture", picture, allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetFrameTimingPercentiles(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  response->SetObject();
+  auto& allocator = response->GetAllocator();
+  response->AddMember("type", "FrameTimingPercentiles", allocator);
+  response->AddMember<uint64_t>(
+      "frameCount", frame_timing_histograms_.GetFrameCount(), allocator);
+  response->AddMember<uint64_t>("droppedFrameCount",
+                                frame_timing_histograms_.GetDroppedFrameCount(),
+                                allocator);
+  const auto add_metric = [&](const char* name,
+                              FrameTimingHistograms::Metric metric) {
+    const auto percentiles = frame_timing_histograms_.GetPercentiles(metric);
+    rapidjson::Value value;
+    value.SetObject();
+    value.AddMember<int64_t>("p50", percentiles.p50.ToMicroseconds(),
+                             allocator);
+    value.AddMember<int64_t>("p90", percentiles.p90.ToMicroseconds(),
+                             allocator);
+    value.AddMember<int64_t>("p99", percentiles.p99.ToMicroseconds(),
+                             allocator);
+    value.AddMember<int64_t>("max", percentiles.max.ToMicroseconds(),
+                             allocator);
+    response->AddMember(rapidjson::StringRef(name), value, allocator);
+  };
+  add_metric("buildTime", FrameTimingHistograms::Metric::kBuildTime);
+  add_metric("rasterTime", FrameTimingHistograms::Metric::kRasterTime);
+  add_metric("vsyncOverhead", FrameTimingHistograms::Metric::kVsyncOverhead);
+  add_metric("latency", FrameTimingHistograms::Metric::kLatency);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetNativeStackSamples(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  if (!stack_sampler_) {
+    ServiceProtocolFailureError(
+        response,
+        "Native stack sampling is not enabled. Use the "
+        "--native-stack-samples-per-second flag to enable it.");
+    return false;
+  }
+  response->SetObject();
+  auto& allocator = response->GetAllocator();
+  response->AddMember("type", "NativeStackSamples", allocator);
+  response->AddMember<uint64_t>(
+      "sampleCount", stack_sampler_->GetSampleCount(), allocator);
+  rapidjson::Value stacks;
+  stacks.SetArray();
+  for (const auto& folded_stack : stack_sampler_->GetFoldedStacks()) {
+    stacks.PushBack(rapidjson::Value(folded_stack.c_str(), allocator),
+                    allocator);
+  }
+  response->AddMember("stacks", stacks, allocator);
+  if (params.count("reset") != 0 && params.at("reset") == "true") {
+    stack_sampler_->Reset();
+  }
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetGCMetrics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  const auto& metrics = engine_->GetGCMetrics();
+  response->SetObject();
+  auto& allocator = response->GetAllocator();
+  response->AddMember("type", "GCMetrics", allocator);
+  response->AddMember<uint64_t>("idleNotifications",
+                                metrics.idle_notification_count, allocator);
+  response->AddMember<uint64_t>("skippedIdleNotifications",
+                                metrics.skipped_idle_notification_count,
+                                allocator);
+  response->AddMember<uint64_t>("collections", metrics.collection_count,
+                                allocator);
+  response->AddMember<uint64_t>("coalescedCollections",
+                                metrics.coalesced_collection_count, allocator);
+  response->AddMember<uint64_t>("frameOverlaps", metrics.frame_overlap_count,
+                                allocator);
+  response->AddMember<int64_t>(
+      "totalTimeMicros", metrics.total_time.ToMicroseconds(), allocator);
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetEngineMemoryUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  response->SetObject();
+  auto& allocator = response->GetAllocator();
+  response->AddMember("type", "EngineMemoryUsage", allocator);
+  rapidjson::Value subsystems;
+  subsystems.SetArray();
+  for (const auto& usage : fml::MemoryCounter::GetAllUsage()) {
+    rapidjson::Value subsystem;
+    subsystem.SetObject();
+    subsystem.AddMember("name", rapidjson::Value(usage.name.c_str(), allocator),
+                        allocator);
+    subsystem.AddMember<uint64_t>("bytes", usage.bytes, allocator);
+    subsystem.AddMember<uint64_t>("peakBytes", usage.peak_bytes, allocator);
+    subsystems.PushBack(subsystem, allocator);
+  }
+  response->AddMember("subsystems", subsystems, allocator);
+  if (params.count("resetPeaks") != 0 && params.at("resetPeaks") == "true") {
+    fml::MemoryCounter::ResetAllPeaks();
+  }
+  return true;
+}
+
+// Service protocol handler
+bool Shell::OnServiceProtocolGetLayerCosts(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  auto& cost_store = rasterizer_->compositor_context()->layer_cost_store();
+
+  if (params.count("sampleInterval") != 0) {
+    const std::string& value = params.at("sampleInterval");
+    size_t sample_interval = 0;
+    auto result = std::from_chars(value.data(), value.data() + value.size(),
+                                  sample_interval);
+    if (result.ec != std::errc() || result.ptr != value.data() + value.size()) {
+      ServiceProtocolParameterError(
+          response, "'sampleInterval' parameter is not a frame count.");
+      return false;
+    }
+    cost_store.SetSampleInterval(sample_interval);
+  }
+  if (params.count("heatmap") != 0) {
+    cost_store.SetHeatmapEnabled(params.at("heatmap") == "true");
+  }
+
+  response->SetObject();
+  auto& allocator = response->GetAllocator();
+  response->AddMember("type", "LayerCosts", allocator);
+  response->AddMember<uint64_t>("sampleInterval",
+                                cost_store.GetSampleInterval(), allocator);
+  response->AddMember<uint64_t>("sampledFrameCount",
+                                cost_store.GetSampledFrameCount(), allocator);
+  rapidjson::Value layers;
+  layers.SetArray();
+  for (const auto& cost : cost_store.GetCosts()) {
+    rapidjson::Value layer;
+    layer.SetObject();
+    layer.AddMember<uint64_t>("layerId", cost.original_layer_id, allocator);
+    layer.AddMember<uint64_t>("uniqueId", cost.layer_unique_id, allocator);
+    layer.AddMember<uint64_t>("sampleCount", cost.sample_count, allocator);
+    layer.AddMember<int64_t>("totalSelfTimeMicros",
+                             cost.total_self_time.ToMicroseconds(), allocator);
+    layer.AddMember<int64_t>("maxSelfTimeMicros",
+                             cost.max_self_time.ToMicroseconds(), allocator);
+    layer.AddMember<int64_t>("totalTimeMicros",
+                             cost.total_time.ToMicroseconds(), allocator);
+    rapidjson::Value bounds;
+    bounds.SetObject();
+    bounds.AddMember("left", cost.device_bounds.left(), allocator);
+    bounds.AddMember("top", cost.device_bounds.top(), allocator);
+    bounds.AddMember("width", cost.device_bounds.width(), allocator);
+    bounds.AddMember("height", cost.device_bounds.height(), allocator);
+    layer.AddMember("deviceBounds", bounds, allocator);
+    layers.PushBack(layer, allocator);
+  }
+  response->AddMember("layers", layers, allocator);
+  if (params.count("reset") != 0 && params.at("reset") == "true") {
+    cost_store.Reset();
+  }
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -1981,18 +2416,27 @@ Rasterizer::Screenshot Shell::Screenshot(
   TRACE_EVENT0("flutter", "Shell::Screenshot");
   fml::AutoResetWaitableEvent latch;
   Rasterizer::Screenshot screenshot;
+  // Only the rendering of the screenshot happens on the raster thread, its
+  // encoding is left to the worker pool.
   fml::TaskRunner::RunNowOrPostTask(
-      task_runners_.GetRasterTaskRunner(), [&latch,                        //
-                                            rasterizer = GetRasterizer(),  //
-                                            &screenshot,                   //
-                                            screenshot_type,               //
-                                            base64_encode                  //
+      task_runners_.GetRasterTaskRunner(),
+      [&latch,                                                    //
+       rasterizer = GetRasterizer(),                              //
+       &screenshot,                                               //
+       screenshot_type,                                           //
+       base64_encode,                                             //
+       worker_task_runner = vm_->GetConcurrentWorkerTaskRunner()  //
   ]() {
-        if (rasterizer) {
-          screenshot = rasterizer->ScreenshotLastLayerTree(screenshot_type,
-                                                           base64_encode);
+        if (!rasterizer) {
+          latch.Signal();
+          return;
         }
-        latch.Signal();
+        rasterizer->ScreenshotLastLayerTree(
+            screenshot_type, base64_encode, worker_task_runner,
+            [&latch, &screenshot](Rasterizer::Screenshot result) {
+              screenshot = std::move(result);
+              latch.Signal();
+            });
       });
   latch.Wait();
   return screenshot;
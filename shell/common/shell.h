@@ -6,14 +6,17 @@
 #define SHELL_COMMON_SHELL_H_
 
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/texture.h"
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/flow/frame_timings.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -36,10 +39,13 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/frame_deadline_scheduler.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/memory_governor.h"
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
 #include "flutter/shell/common/shell_io_manager.h"
+#include "flutter/shell/profiling/stack_sampler.h"
 
 namespace flutter {
 
@@ -218,6 +224,14 @@ class Shell final : public PlatformView::Delegate,
   ///
   const Settings& GetSettings() const override;
 
+  //------------------------------------------------------------------------------
+  /// @brief      Histograms of the phase durations of all the frames
+  ///             rasterized by this shell. These are collected regardless of
+  ///             whether the timings are reported to Dart, and can be read
+  ///             from any thread.
+  ///
+  const FrameTimingHistograms& GetFrameTimingHistograms() const;
+
   //------------------------------------------------------------------------------
   /// @brief      If callers wish to interact directly with any shell
   ///             subcomponents, they must (on the platform thread) obtain a
@@ -281,10 +295,19 @@ class Shell final : public PlatformView::Delegate,
 
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to notify that there is a low memory
-  ///             warning. The shell will attempt to purge caches. Current, only
-  ///             the rasterizer cache is purged.
+  ///             warning. The shell will attempt to purge caches. This is the
+  ///             same as a |MemoryPressureLevel::kCritical| memory pressure
+  ///             notification.
   void NotifyLowMemoryWarning() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to notify the memory pressure level
+  ///             reported by the platform. The caches registered with the
+  ///             memory governor are trimmed to what they may keep at that
+  ///             level, and a critical level also collects the Dart heap.
+  ///
+  void NotifyMemoryPressure(MemoryPressureLevel level) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to check if all shell subcomponents are
   ///             initialized. It is the embedder's responsibility to make this
@@ -413,6 +436,7 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<ResourceCacheLimitCalculator>
       resource_cache_limit_calculator_;
   size_t resource_cache_limit_;
+  const std::shared_ptr<MemoryGovernor> memory_governor_;
   const Settings settings_;
   DartVMRef vm_;
   mutable std::mutex time_recorder_mutex_;
@@ -426,6 +450,17 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
   std::atomic<bool> route_messages_through_platform_thread_ = false;
 
+  // Platform messages that are waiting for the UI thread, to be dispatched to
+  // the engine in one go. The batch is only appended to until the UI thread
+  // gets to it, or until the platform thread posts any other task to the UI
+  // thread, which preserves the order of messages and other events.
+  struct PlatformMessageBatch {
+    std::mutex mutex;
+    bool dispatched = false;
+    std::vector<std::unique_ptr<PlatformMessage>> messages;
+  };
+  std::shared_ptr<PlatformMessageBatch> platform_message_batch_;
+
   fml::WeakPtr<Engine> weak_engine_;  // to be shared across threads
   fml::TaskRunnerAffineWeakPtr<Rasterizer>
       weak_rasterizer_;  // to be shared across threads
@@ -460,6 +495,16 @@ class Shell final : public PlatformView::Delegate,
   // here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
 
+  FrameTimingHistograms frame_timing_histograms_;
+
+  // Predicts when frames must start from the timings of the recent ones, if
+  // enabled with |Settings::enable_deadline_frame_scheduling|.
+  std::shared_ptr<FrameDeadlineScheduler> frame_deadline_scheduler_;
+
+  // Samples the native stacks of the UI and raster threads if enabled with
+  // |Settings::native_stack_samples_per_second|.
+  std::shared_ptr<StackSampler> stack_sampler_;
+
   /// Manages the displays. This class is thread safe, can be accessed from any
   /// of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
@@ -482,6 +527,7 @@ class Shell final : public PlatformView::Delegate,
         fml::RefPtr<fml::RasterThreadMerger> parent_merger,
         const std::shared_ptr<ResourceCacheLimitCalculator>&
             resource_cache_limit_calculator,
+        const std::shared_ptr<MemoryGovernor>& memory_governor,
         const Settings& settings,
         std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
         bool is_gpu_disabled);
@@ -492,6 +538,7 @@ class Shell final : public PlatformView::Delegate,
       std::shared_ptr<ShellIOManager> parent_io_manager,
       const std::shared_ptr<ResourceCacheLimitCalculator>&
           resource_cache_limit_calculator,
+      const std::shared_ptr<MemoryGovernor>& memory_governor,
       const TaskRunners& task_runners,
       const PlatformData& platform_data,
       const Settings& settings,
@@ -508,6 +555,7 @@ class Shell final : public PlatformView::Delegate,
       const std::shared_ptr<ShellIOManager>& parent_io_manager,
       const std::shared_ptr<ResourceCacheLimitCalculator>&
           resource_cache_limit_calculator,
+      const std::shared_ptr<MemoryGovernor>& memory_governor,
       Settings settings,
       DartVMRef vm,
       fml::RefPtr<const DartSnapshot> isolate_snapshot,
@@ -523,6 +571,10 @@ class Shell final : public PlatformView::Delegate,
 
   void ReportTimings();
 
+  // Whether the layer tree was built for a size that the view no longer has,
+  // e.g. while the window is being resized, and must not be shown.
+  bool ShouldDiscardLayerTree(const flutter::LayerTree& tree);
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -581,6 +633,12 @@ class Shell final : public PlatformView::Delegate,
                                     const std::string error_message,
                                     bool transient) override;
 
+  // |PlatformView::Delegate|
+  void PrefetchDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions) override;
+
   // |PlatformView::Delegate|
   void UpdateAssetResolverByType(
       std::unique_ptr<AssetResolver> updated_asset_resolver,
@@ -641,6 +699,9 @@ class Shell final : public PlatformView::Delegate,
   // |Rasterizer::Delegate|
   void OnFrameRasterized(const FrameTiming&) override;
 
+  // |Rasterizer::Delegate|
+  void OnFrameDropped() override;
+
   // |Rasterizer::Delegate|
   fml::Milliseconds GetFrameBudget() override;
 
@@ -703,6 +764,62 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Responds with the byte budget of the raster cache and the metrics of its
+  // layer and picture entries in the last frame.
+  bool OnServiceProtocolGetRasterCacheMetrics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the percentiles of the build time, raster time, vsync
+  // overhead and latency of the frames rasterized so far, in microseconds,
+  // and the number of frames dropped because they were stale.
+  bool OnServiceProtocolGetFrameTimingPercentiles(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the native stack samples of the UI and raster threads
+  // captured so far, as folded stacks that flame graph tools read. Clears the
+  // samples if the `reset` parameter is `true`.
+  bool OnServiceProtocolGetNativeStackSamples(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the counts of the idle notifications and garbage collections
+  // the engine scheduled, and of those that may have delayed a frame.
+  bool OnServiceProtocolGetGCMetrics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the native memory held by each subsystem of the engine that
+  // counts it, and the most it has held, in bytes. The counters are shared by
+  // every engine in the process, and some overlap, for example the raster
+  // cache and glyph atlases are also counted as textures. Resets the peaks to
+  // the current usage if the `resetPeaks` parameter is `true`.
+  bool OnServiceProtocolGetEngineMemoryUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the time each layer took to paint, summed over the frames
+  // sampled so far, most expensive first. The `sampleInterval` parameter sets
+  // the number of frames between sampled frames, with 0 disabling sampling,
+  // and the `heatmap` parameter whether the costs are drawn over each frame.
+  // Clears the costs if the `reset` parameter is `true`.
+  bool OnServiceProtocolGetLayerCosts(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   //
   // Renders a frame and responds with various statistics pertaining to the
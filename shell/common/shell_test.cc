@@ -265,6 +265,24 @@ void ShellTest::OnServiceProtocol(
       case ServiceProtocolEnum::kEstimateRasterCacheMemory:
         shell->OnServiceProtocolEstimateRasterCacheMemory(params, response);
         break;
+      case ServiceProtocolEnum::kGetRasterCacheMetrics:
+        shell->OnServiceProtocolGetRasterCacheMetrics(params, response);
+        break;
+      case ServiceProtocolEnum::kGetFrameTimingPercentiles:
+        shell->OnServiceProtocolGetFrameTimingPercentiles(params, response);
+        break;
+      case ServiceProtocolEnum::kGetNativeStackSamples:
+        shell->OnServiceProtocolGetNativeStackSamples(params, response);
+        break;
+      case ServiceProtocolEnum::kGetGCMetrics:
+        shell->OnServiceProtocolGetGCMetrics(params, response);
+        break;
+      case ServiceProtocolEnum::kGetEngineMemoryUsage:
+        shell->OnServiceProtocolGetEngineMemoryUsage(params, response);
+        break;
+      case ServiceProtocolEnum::kGetLayerCosts:
+        shell->OnServiceProtocolGetLayerCosts(params, response);
+        break;
       case ServiceProtocolEnum::kSetAssetBundlePath:
         shell->OnServiceProtocolSetAssetBundlePath(params, response);
         break;
@@ -105,6 +105,12 @@ class ShellTest : public FixtureTest {
   enum ServiceProtocolEnum {
     kGetSkSLs,
     kEstimateRasterCacheMemory,
+    kGetRasterCacheMetrics,
+    kGetFrameTimingPercentiles,
+    kGetNativeStackSamples,
+    kGetGCMetrics,
+    kGetEngineMemoryUsage,
+    kGetLayerCosts,
     kSetAssetBundlePath,
     kRunInView,
     kRenderFrameWithRasterStats,
@@ -25,8 +25,10 @@
 #include "flutter/flow/layers/transform_layer.h"
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/dart/dart_converter.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/memory/memory_counter.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -112,6 +114,11 @@ class MockPlatformViewDelegate : public PlatformView::Delegate {
                     const std::string error_message,
                     bool transient));
 
+  MOCK_METHOD3(PrefetchDartDeferredLibrary,
+               void(intptr_t loading_unit_id,
+                    std::unique_ptr<const fml::Mapping> snapshot_data,
+                    std::unique_ptr<const fml::Mapping> snapshot_instructions));
+
   MOCK_METHOD2(UpdateAssetResolverByType,
                void(std::unique_ptr<AssetResolver> updated_asset_resolver,
                     AssetResolver::AssetResolverType type));
@@ -2128,6 +2135,73 @@ TEST_F(ShellTest, Screenshot) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, ScreenshotIsEncodedOnWorkerTaskRunner) {
+  auto settings = CreateSettingsForFixture();
+  fml::AutoResetWaitableEvent firstFrameLatch;
+  settings.frame_rasterized_callback =
+      [&firstFrameLatch](const FrameTiming& t) { firstFrameLatch.Signal(); };
+
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Create the surface needed by rasterizer
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  LayerTreeBuilder builder = [&](const std::shared_ptr<ContainerLayer>& root) {
+    fml::RefPtr<SkiaUnrefQueue> queue = fml::MakeRefCounted<SkiaUnrefQueue>(
+        this->GetCurrentTaskRunner(), fml::TimeDelta::Zero());
+    auto display_list_layer = std::make_shared<DisplayListLayer>(
+        SkPoint::Make(10, 10),
+        flutter::SkiaGPUObject<DisplayList>(
+            {MakeSizedDisplayList(80, 80), queue}),
+        false, false);
+    root->Add(display_list_layer);
+  };
+
+  PumpOneFrame(shell.get(), 100, 100, builder);
+  firstFrameLatch.Wait();
+
+  auto worker_loop = fml::ConcurrentMessageLoop::Create(1);
+  std::promise<Rasterizer::Screenshot> screenshot_promise;
+  auto screenshot_future = screenshot_promise.get_future();
+  bool encoded_on_raster_thread = true;
+
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(),
+      [&screenshot_promise, &shell, &encoded_on_raster_thread,
+       worker_task_runner = worker_loop->GetTaskRunner()]() {
+        auto raster_task_runner = shell->GetTaskRunners().GetRasterTaskRunner();
+        shell->GetRasterizer()->ScreenshotLastLayerTree(
+            Rasterizer::ScreenshotType::CompressedImage, false,
+            worker_task_runner,
+            [&screenshot_promise, &encoded_on_raster_thread,
+             raster_task_runner](Rasterizer::Screenshot screenshot) {
+              encoded_on_raster_thread =
+                  raster_task_runner->RunsTasksOnCurrentThread();
+              screenshot_promise.set_value(screenshot);
+            });
+      });
+
+  auto fixtures_dir =
+      fml::OpenDirectory(GetFixturesPath(), false, fml::FilePermission::kRead);
+
+  auto reference_png = fml::FileMapping::CreateReadOnly(
+      fixtures_dir, "shelltest_screenshot.png");
+
+  sk_sp<SkData> reference_data = SkData::MakeWithoutCopy(
+      reference_png->GetMapping(), reference_png->GetSize());
+
+  sk_sp<SkData> screenshot_data = screenshot_future.get().data;
+  ASSERT_FALSE(encoded_on_raster_thread);
+  ASSERT_TRUE(reference_data->equals(screenshot_data.get()));
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, CanConvertToAndFromMappings) {
   const size_t buffer_size = 2 << 20;
 
@@ -2548,6 +2622,184 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetGCMetricsWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetGCMetrics,
+                    shell->GetTaskRunners().GetUITaskRunner(), empty_params,
+                    &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string expected_json =
+      "{\"type\":\"GCMetrics\",\"idleNotifications\":0,"
+      "\"skippedIdleNotifications\":0,\"collections\":0,"
+      "\"coalescedCollections\":0,\"frameOverlaps\":0,"
+      "\"totalTimeMicros\":0}";
+  std::string actual_json = buffer.GetString();
+  ASSERT_EQ(actual_json, expected_json);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetEngineMemoryUsageWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  auto& counter = fml::MemoryCounter::Get("shell_unittests");
+  fml::ScopedMemoryCount count(counter, 1024);
+  count.Update(256);
+
+  ServiceProtocol::Handler::ServiceProtocolMap params;
+  params["resetPeaks"] = "true";
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetEngineMemoryUsage,
+                    shell->GetTaskRunners().GetIOTaskRunner(), params,
+                    &document);
+  ASSERT_TRUE(document.IsObject());
+  ASSERT_EQ(std::string{document["type"].GetString()}, "EngineMemoryUsage");
+  ASSERT_TRUE(document["subsystems"].IsArray());
+  bool found = false;
+  for (const auto& subsystem : document["subsystems"].GetArray()) {
+    if (std::string{subsystem["name"].GetString()} == "shell_unittests") {
+      found = true;
+      EXPECT_EQ(subsystem["bytes"].GetUint64(), 256u);
+      EXPECT_EQ(subsystem["peakBytes"].GetUint64(), 1024u);
+    }
+  }
+  ASSERT_TRUE(found);
+  // The peak was reset after it was reported.
+  EXPECT_EQ(counter.GetPeakBytes(), 256u);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetLayerCostsWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap params;
+  params["sampleInterval"] = "4";
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetLayerCosts,
+                    shell->GetTaskRunners().GetRasterTaskRunner(), params,
+                    &document);
+  ASSERT_TRUE(document.IsObject());
+  ASSERT_EQ(std::string{document["type"].GetString()}, "LayerCosts");
+  EXPECT_EQ(document["sampleInterval"].GetUint64(), 4u);
+  EXPECT_EQ(document["sampledFrameCount"].GetUint64(), 0u);
+  ASSERT_TRUE(document["layers"].IsArray());
+  EXPECT_TRUE(document["layers"].GetArray().Empty());
+
+  params["sampleInterval"] = "four";
+  rapidjson::Document error_document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetLayerCosts,
+                    shell->GetTaskRunners().GetRasterTaskRunner(), params,
+                    &error_document);
+  ASSERT_TRUE(error_document.IsObject());
+  EXPECT_EQ(std::string{error_document["message"].GetString()},
+            "Invalid params");
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetRasterCacheMetricsWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(
+      shell.get(), ServiceProtocolEnum::kGetRasterCacheMetrics,
+      shell->GetTaskRunners().GetRasterTaskRunner(), empty_params, &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string empty_metrics =
+      "{\"count\":0,\"bytes\":0,\"hits\":0,\"misses\":0,\"evictions\":0,"
+      "\"evictionBytes\":0,\"timeSavedMicros\":0}";
+  std::string expected_json =
+      "{\"type\":\"RasterCacheMetrics\",\"byteBudget\":" +
+      std::to_string(RasterCacheUtil::kDefaultCacheByteBudget) +
+      ",\"layer\":" + empty_metrics + ",\"picture\":" + empty_metrics + "}";
+  std::string actual_json = buffer.GetString();
+  ASSERT_EQ(actual_json, expected_json);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetFrameTimingPercentilesWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(
+      shell.get(), ServiceProtocolEnum::kGetFrameTimingPercentiles,
+      shell->GetTaskRunners().GetRasterTaskRunner(), empty_params, &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string empty_percentiles = "{\"p50\":0,\"p90\":0,\"p99\":0,\"max\":0}";
+  std::string expected_json =
+      "{\"type\":\"FrameTimingPercentiles\",\"frameCount\":0,"
+      "\"droppedFrameCount\":0,\"buildTime\":" +
+      empty_percentiles + ",\"rasterTime\":" + empty_percentiles +
+      ",\"vsyncOverhead\":" + empty_percentiles +
+      ",\"latency\":" + empty_percentiles + "}";
+  std::string actual_json = buffer.GetString();
+  ASSERT_EQ(actual_json, expected_json);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetNativeStackSamplesWorks) {
+  if (!StackSampler::IsSupported()) {
+    GTEST_SKIP() << "Native stack sampling is not supported.";
+  }
+  Settings settings = CreateSettingsForFixture();
+  settings.native_stack_samples_per_second = 1000;
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap params;
+  params["reset"] = "true";
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetNativeStackSamples,
+                    shell->GetTaskRunners().GetIOTaskRunner(), params,
+                    &document);
+  ASSERT_TRUE(document.IsObject());
+  ASSERT_EQ(std::string{document["type"].GetString()}, "NativeStackSamples");
+  ASSERT_TRUE(document["sampleCount"].IsUint64());
+  ASSERT_TRUE(document["stacks"].IsArray());
+  for (const auto& stack : document["stacks"].GetArray()) {
+    const std::string folded_stack = stack.GetString();
+    ASSERT_TRUE(folded_stack.rfind("ui;", 0) == 0 ||
+                folded_stack.rfind("raster;", 0) == 0)
+        << folded_stack;
+  }
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, OnServiceProtocolGetNativeStackSamplesFailsWhenDisabled) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetNativeStackSamples,
+                    shell->GetTaskRunners().GetIOTaskRunner(), empty_params,
+                    &document);
+  ASSERT_TRUE(document.IsObject());
+  ASSERT_TRUE(document.HasMember("code"));
+  ASSERT_FALSE(document.HasMember("stacks"));
+
+  DestroyShell(std::move(shell));
+}
+
 // ktz
 TEST_F(ShellTest, OnServiceProtocolRenderFrameWithRasterStatsWorks) {
   auto settings = CreateSettingsForFixture();
@@ -3004,6 +3256,43 @@ TEST_F(ShellTest, AssetManagerMulti) {
   }
 }
 
+TEST_F(ShellTest, AssetManagerReadsConcurrently) {
+  fml::ScopedTemporaryDirectory front_dir;
+  fml::ScopedTemporaryDirectory back_dir;
+  fml::UniqueFD front_dir_fd = fml::OpenDirectory(
+      front_dir.path().c_str(), false, fml::FilePermission::kRead);
+  fml::UniqueFD back_dir_fd = fml::OpenDirectory(
+      back_dir.path().c_str(), false, fml::FilePermission::kRead);
+
+  ASSERT_TRUE(fml::WriteAtomically(front_dir_fd, "shared",
+                                   fml::DataMapping("front shared")));
+  ASSERT_TRUE(fml::WriteAtomically(back_dir_fd, "shared",
+                                   fml::DataMapping("back shared")));
+  ASSERT_TRUE(fml::WriteAtomically(back_dir_fd, "back",
+                                   fml::DataMapping("back only")));
+
+  AssetManager asset_manager;
+  asset_manager.PushBack(
+      std::make_unique<DirectoryAssetBundle>(std::move(front_dir_fd), false));
+  asset_manager.PushBack(
+      std::make_unique<DirectoryAssetBundle>(std::move(back_dir_fd), false));
+
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  auto mappings = asset_manager.GetAsMappingsConcurrently(
+      {"back", "missing", "shared"}, loop->GetTaskRunner());
+  auto to_string = [](const fml::Mapping& mapping) {
+    return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                       mapping.GetSize());
+  };
+  ASSERT_EQ(mappings.size(), 3u);
+  ASSERT_NE(mappings[0], nullptr);
+  EXPECT_EQ(to_string(*mappings[0]), "back only");
+  EXPECT_EQ(mappings[1], nullptr);
+  // Resolvers in front take precedence, like they do for GetAsMapping.
+  ASSERT_NE(mappings[2], nullptr);
+  EXPECT_EQ(to_string(*mappings[2]), "front shared");
+}
+
 #if defined(OS_FUCHSIA)
 TEST_F(ShellTest, AssetManagerMultiSubdir) {
   std::string subdir_path = "subdir";
@@ -3169,6 +3458,77 @@ TEST_F(ShellTest, Spawn) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, SpawnRunsIsolateFromSpawnIsolatePool) {
+  if (!DartVM::IsRunningPrecompiledCode()) {
+    GTEST_SKIP() << "The spawn isolate pool is only used in AOT mode.";
+    return;
+  }
+  auto settings = CreateSettingsForFixture();
+  settings.spawn_isolate_pool_size = 1;
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  ASSERT_TRUE(configuration.IsValid());
+  configuration.SetEntrypoint("fixturesAreFunctionalMain");
+
+  auto second_configuration = RunConfiguration::InferFromSettings(settings);
+  ASSERT_TRUE(second_configuration.IsValid());
+  second_configuration.SetEntrypoint("testCanLaunchSecondaryIsolate");
+
+  fml::AutoResetWaitableEvent main_latch;
+  AddNativeCallback(
+      "SayHiFromFixturesAreFunctionalMain",
+      CREATE_NATIVE_ENTRY([&](auto args) { main_latch.Signal(); }));
+  fml::CountDownLatch second_latch(2);
+  AddNativeCallback(
+      "NotifyNative",
+      CREATE_NATIVE_ENTRY([&](auto args) { second_latch.CountDown(); }));
+
+  RunEngine(shell.get(), std::move(configuration));
+  main_latch.Wait();
+  // Let the pool be filled before spawning.
+  PostSync(shell->GetTaskRunners().GetUITaskRunner(), [] {});
+
+  PostSync(
+      shell->GetTaskRunners().GetPlatformTaskRunner(),
+      [this, &spawner = shell, &second_configuration, &second_latch]() {
+        MockPlatformViewDelegate platform_view_delegate;
+        auto spawn = spawner->Spawn(
+            std::move(second_configuration), "/",
+            [&platform_view_delegate](Shell& shell) {
+              auto result = std::make_unique<MockPlatformView>(
+                  platform_view_delegate, shell.GetTaskRunners());
+              ON_CALL(*result, CreateRenderingSurface())
+                  .WillByDefault(::testing::Invoke(
+                      [] { return std::make_unique<MockSurface>(); }));
+              return result;
+            },
+            [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+        ASSERT_NE(nullptr, spawn.get());
+        ASSERT_TRUE(ValidateShell(spawn.get()));
+
+        PostSync(spawner->GetTaskRunners().GetUITaskRunner(), [&spawn,
+                                                               &spawner] {
+          ASSERT_EQ("testCanLaunchSecondaryIsolate",
+                    spawn->GetEngine()->GetLastEntrypoint());
+          ASSERT_EQ(spawner->GetEngine()
+                        ->GetRuntimeController()
+                        ->GetRootIsolateGroup(),
+                    spawn->GetEngine()
+                        ->GetRuntimeController()
+                        ->GetRootIsolateGroup());
+        });
+
+        second_latch.Wait();
+
+        DestroyShell(std::move(spawn));
+      });
+
+  DestroyShell(std::move(shell));
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 TEST_F(ShellTest, SpawnWithDartEntrypointArgs) {
   auto settings = CreateSettingsForFixture();
   auto shell = CreateShell(settings);
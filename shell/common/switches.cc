@@ -453,6 +453,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_vulkan_validation =
       command_line.HasOption(FlagForSwitch(Switch::EnableVulkanValidation));
 
+  settings.enable_impeller_gpu_tracing =
+      command_line.HasOption(FlagForSwitch(Switch::EnableImpellerGPUTracing));
+
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
 
@@ -479,6 +482,16 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.dump_skp_on_shader_compilation =
       command_line.HasOption(FlagForSwitch(Switch::DumpSkpOnShaderCompilation));
 
+  if (command_line.HasOption(FlagForSwitch(Switch::CaptureDisplayLists))) {
+    std::string frame_count;
+    command_line.GetOptionValue(FlagForSwitch(Switch::CaptureDisplayLists),
+                                &frame_count);
+    settings.display_list_capture_frame_count = std::stoi(frame_count);
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::CaptureDisplayListsDirectory),
+        &settings.display_list_capture_directory);
+  }
+
   settings.cache_sksl =
       command_line.HasOption(FlagForSwitch(Switch::CacheSkSL));
 
@@ -502,6 +515,93 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(FlagForSwitch(Switch::SpawnIsolatePoolSize))) {
+    std::string spawn_isolate_pool_size;
+    command_line.GetOptionValue(FlagForSwitch(Switch::SpawnIsolatePoolSize),
+                                &spawn_isolate_pool_size);
+    settings.spawn_isolate_pool_size = std::stoi(spawn_isolate_pool_size);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::FramePipelineDepth))) {
+    std::string frame_pipeline_depth;
+    command_line.GetOptionValue(FlagForSwitch(Switch::FramePipelineDepth),
+                                &frame_pipeline_depth);
+    settings.frame_pipeline_depth = std::stoi(frame_pipeline_depth);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::FramePipelineLatencyBudget))) {
+    std::string frame_pipeline_latency_budget;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::FramePipelineLatencyBudget),
+        &frame_pipeline_latency_budget);
+    settings.frame_pipeline_latency_budget_ms =
+        std::stoi(frame_pipeline_latency_budget);
+  }
+
+  settings.enable_deadline_frame_scheduling = command_line.HasOption(
+      FlagForSwitch(Switch::EnableDeadlineFrameScheduling));
+
+  settings.enable_adaptive_frame_rate =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAdaptiveFrameRate));
+
+  settings.enable_pointer_resampling =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePointerResampling));
+
+  settings.prefer_platform_image_decoders = command_line.HasOption(
+      FlagForSwitch(Switch::PreferPlatformImageDecoders));
+
+  settings.enable_image_texture_compression = command_line.HasOption(
+      FlagForSwitch(Switch::EnableImageTextureCompression));
+
+  settings.enable_unmerged_platform_views = command_line.HasOption(
+      FlagForSwitch(Switch::EnableUnmergedPlatformViews));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::EagerSkSLWarmupCount))) {
+    std::string eager_sksl_warmup_count;
+    command_line.GetOptionValue(FlagForSwitch(Switch::EagerSkSLWarmupCount),
+                                &eager_sksl_warmup_count);
+    settings.eager_sksl_warmup_count = std::stoi(eager_sksl_warmup_count);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::MemoryBudgetBytes))) {
+    std::string memory_budget_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::MemoryBudgetBytes),
+                                &memory_budget_bytes);
+    settings.memory_budget_bytes = std::stoull(memory_budget_bytes);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::NativeStackSamplesPerSecond))) {
+    std::string native_stack_samples_per_second;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::NativeStackSamplesPerSecond),
+        &native_stack_samples_per_second);
+    settings.native_stack_samples_per_second =
+        std::stoi(native_stack_samples_per_second);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::StaleFrameThresholdFrames))) {
+    std::string stale_frame_threshold_frames;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::StaleFrameThresholdFrames),
+        &stale_frame_threshold_frames);
+    settings.stale_frame_threshold_frames =
+        std::stoi(stale_frame_threshold_frames);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::LayerCostSampleInterval))) {
+    std::string layer_cost_sample_interval;
+    command_line.GetOptionValue(FlagForSwitch(Switch::LayerCostSampleInterval),
+                                &layer_cost_sample_interval);
+    settings.layer_cost_sample_interval =
+        std::stoi(layer_cost_sample_interval);
+  }
+
+  settings.show_layer_cost_heatmap =
+      command_line.HasOption(FlagForSwitch(Switch::ShowLayerCostHeatmap));
+
   if (command_line.HasOption(FlagForSwitch(Switch::MsaaSamples))) {
     std::string msaa_samples;
     command_line.GetOptionValue(FlagForSwitch(Switch::MsaaSamples),
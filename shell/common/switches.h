@@ -181,6 +181,15 @@ DEF_SWITCH(DumpSkpOnShaderCompilation,
            "Automatically dump the skp that triggers new shader compilations. "
            "This is useful for writing custom ShaderWarmUp to reduce jank. "
            "By default, this is not enabled to reduce the overhead. ")
+DEF_SWITCH(CaptureDisplayLists,
+           "capture-display-lists",
+           "Write the first N rasterized frames to disk as serialized "
+           "DisplayLists, where N is the value of the flag. The frames can "
+           "then be replayed and timed with the dl_replay tool.")
+DEF_SWITCH(CaptureDisplayListsDirectory,
+           "capture-display-lists-directory",
+           "The directory the frames captured with --capture-display-lists "
+           "are written to. By default, a temporary directory is created.")
 DEF_SWITCH(CacheSkSL,
            "cache-sksl",
            "Only cache the shader in SkSL instead of binary or GLSL. This "
@@ -257,6 +266,81 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(ResourceCacheMaxBytesThreshold,
            "resource-cache-max-bytes-threshold",
            "The max bytes threshold of resource cache, or 0 for unlimited.")
+DEF_SWITCH(SpawnIsolatePoolSize,
+           "spawn-isolate-pool-size",
+           "The number of root isolates created ahead of time for the engines "
+           "spawned from this one, or 0 to create them on demand. Only used "
+           "in AOT mode.")
+DEF_SWITCH(FramePipelineDepth,
+           "frame-pipeline-depth",
+           "The number of frames the UI thread may produce ahead of the raster "
+           "thread, or 0 for the platform default.")
+DEF_SWITCH(FramePipelineLatencyBudget,
+           "frame-pipeline-latency-budget",
+           "How many milliseconds later than their vsync target time frames "
+           "produced ahead of the raster thread may be displayed, or 0 for no "
+           "limit.")
+DEF_SWITCH(EnableDeadlineFrameScheduling,
+           "enable-deadline-frame-scheduling",
+           "Start building each frame as late after its vsync as the timings "
+           "of the recent frames predict it can while still being rasterized "
+           "before its target time, so that it can include more recent "
+           "input.")
+DEF_SWITCH(EnableAdaptiveFrameRate,
+           "enable-adaptive-frame-rate",
+           "On variable refresh rate displays, produce frames at 60Hz unless "
+           "the user is interacting with the app, and as fast as the display "
+           "refreshes while they are.")
+DEF_SWITCH(EnablePointerResampling,
+           "enable-pointer-resampling",
+           "Dispatch pointer events once per frame, with the consecutive moves "
+           "of each pointer coalesced and resampled to the vsync time.")
+DEF_SWITCH(PreferPlatformImageDecoders,
+           "prefer-platform-image-decoders",
+           "Decode JPEG and HEIF images with the hardware decoders of the "
+           "platform, at the size they are displayed at, instead of with the "
+           "builtin software decoders.")
+DEF_SWITCH(EnableImageTextureCompression,
+           "enable-image-texture-compression",
+           "Compress large opaque images to ETC2 textures when they are "
+           "uploaded by Impeller, on devices that support it.")
+DEF_SWITCH(EnableUnmergedPlatformViews,
+           "enable-unmerged-platform-views",
+           "Keep rasterizing on the raster thread while Android platform views "
+           "are displayed, instead of merging it into the platform thread.")
+DEF_SWITCH(EagerSkSLWarmupCount,
+           "eager-sksl-warmup-count",
+           "The number of known SkSLs, in the order earlier runs first used "
+           "them, to precompile when the rendering context is created. The "
+           "others are precompiled in the idle time of later frames. 0, the "
+           "default, precompiles all of them at once.")
+DEF_SWITCH(MemoryBudgetBytes,
+           "memory-budget-bytes",
+           "The number of bytes the GPU and raster caches of the engine may "
+           "take up together when the platform reports memory pressure. 0, "
+           "the default, only trims them relative to what they take up.")
+DEF_SWITCH(NativeStackSamplesPerSecond,
+           "native-stack-samples-per-second",
+           "The number of times per second the native stacks of the UI and "
+           "raster threads are sampled for the flame graph served by the "
+           "_flutter.getNativeStackSamples service protocol extension, or 0 "
+           "to not sample them.")
+DEF_SWITCH(StaleFrameThresholdFrames,
+           "stale-frame-threshold-frames",
+           "The number of frame budgets by which the target time of a frame "
+           "may have passed before the rasterizer drops it in favor of a newer "
+           "frame waiting to be rasterized. 0, the default, rasterizes every "
+           "frame.")
+DEF_SWITCH(LayerCostSampleInterval,
+           "layer-cost-sample-interval",
+           "The number of frames between the frames whose layers are timed as "
+           "they paint, for the costs served by the _flutter.getLayerCosts "
+           "service protocol extension, or 0 to not time them.")
+DEF_SWITCH(ShowLayerCostHeatmap,
+           "show-layer-cost-heatmap",
+           "Draw the layers of the last frame whose layers were timed over "
+           "each frame, tinted from blue to red by how long they took to "
+           "paint. Requires --layer-cost-sample-interval.")
 DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
@@ -266,6 +350,11 @@ DEF_SWITCH(EnableVulkanValidation,
            "Enable loading Vulkan validation layers. The layers must be "
            "available to the application and loadable. On non-Vulkan backends, "
            "this flag does nothing.")
+DEF_SWITCH(EnableImpellerGPUTracing,
+           "enable-impeller-gpu-tracing",
+           "Measure the GPU time of the render passes of each frame rendered "
+           "with Impeller, and add it to the timeline. On backends that can't "
+           "measure GPU time, this flag does nothing.")
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
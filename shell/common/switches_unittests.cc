@@ -76,6 +76,20 @@ TEST(SwitchesTest, MsaaSamples) {
   EXPECT_EQ(settings.msaa_samples, 0);
 }
 
+TEST(SwitchesTest, FramePipeline) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--frame-pipeline-depth=3",
+       "--frame-pipeline-latency-budget=20"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.frame_pipeline_depth, 3u);
+  EXPECT_EQ(settings.frame_pipeline_latency_budget_ms, 20);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.frame_pipeline_depth, 0u);
+  EXPECT_EQ(settings.frame_pipeline_latency_budget_ms, 0);
+}
+
 TEST(SwitchesTest, EnableEmbedderAPI) {
   {
     // enable
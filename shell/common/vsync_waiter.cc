@@ -84,6 +84,16 @@ void VsyncWaiter::ScheduleSecondaryCallback(uintptr_t id,
   AwaitVSyncForSecondaryCallback();
 }
 
+void VsyncWaiter::SetPreferredFrameRate(double frame_rate) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  if (frame_rate == preferred_frame_rate_) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "VsyncWaiter::SetPreferredFrameRate");
+  preferred_frame_rate_ = frame_rate;
+  OnPreferredFrameRateChanged(frame_rate);
+}
+
 void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
                                fml::TimePoint frame_target_time,
                                bool pause_secondary_tasks) {
@@ -126,21 +136,30 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
     fml::TaskQueueId ui_task_queue_id =
         task_runners_.GetUITaskRunner()->GetTaskQueueId();
 
-    task_runners_.GetUITaskRunner()->PostTask(
-        [ui_task_queue_id, callback, flow_identifier, frame_start_time,
-         frame_target_time, pause_secondary_tasks]() {
-          FML_TRACE_EVENT("flutter", kVsyncTraceName, "StartTime",
-                          frame_start_time, "TargetTime", frame_target_time);
-          std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder =
-              std::make_unique<FrameTimingsRecorder>();
-          frame_timings_recorder->RecordVsync(frame_start_time,
-                                              frame_target_time);
-          callback(std::move(frame_timings_recorder));
-          TRACE_FLOW_END("flutter", kVsyncFlowName, flow_identifier);
-          if (pause_secondary_tasks) {
-            ResumeDartMicroTasks(ui_task_queue_id);
-          }
-        });
+    auto begin_frame = [ui_task_queue_id, callback, flow_identifier,
+                        frame_start_time, frame_target_time,
+                        pause_secondary_tasks]() {
+      FML_TRACE_EVENT("flutter", kVsyncTraceName, "StartTime", frame_start_time,
+                      "TargetTime", frame_target_time);
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder =
+          std::make_unique<FrameTimingsRecorder>();
+      frame_timings_recorder->RecordVsync(frame_start_time, frame_target_time);
+      callback(std::move(frame_timings_recorder));
+      TRACE_FLOW_END("flutter", kVsyncFlowName, flow_identifier);
+      if (pause_secondary_tasks) {
+        ResumeDartMicroTasks(ui_task_queue_id);
+      }
+    };
+
+    if (pause_secondary_tasks) {
+      // The frame is critical to user interaction, start it ahead of the
+      // other tasks that are already due on the UI thread.
+      fml::MessageLoopTaskQueues::GetInstance()->RegisterTask(
+          ui_task_queue_id, begin_frame, fml::TimePoint::Now(),
+          fml::TaskSourceGrade::kUserInteraction);
+    } else {
+      task_runners_.GetUITaskRunner()->PostTask(begin_frame);
+    }
   }
 
   for (auto& secondary_callback : secondary_callbacks) {
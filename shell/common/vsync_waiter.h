@@ -32,6 +32,12 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   /// |Animator::ScheduleMaybeClearTraceFlowIds|.
   void ScheduleSecondaryCallback(uintptr_t id, const fml::closure& callback);
 
+  /// Hints the platform at the rate the next frames are wanted at, in frames
+  /// per second. Zero means as fast as the display can refresh, which is the
+  /// default. Platforms with variable refresh rate displays may use it to
+  /// produce vsyncs at a lower rate. Must be called on the UI thread.
+  void SetPreferredFrameRate(double frame_rate);
+
  protected:
   // On some backends, the |FireCallback| needs to be made from a static C
   // method.
@@ -65,6 +71,10 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   // as AwaitVSync().
   virtual void AwaitVSyncForSecondaryCallback() { AwaitVSync(); }
 
+  // Invoked on the UI thread when the preferred frame rate changes. The
+  // default implementation ignores it.
+  virtual void OnPreferredFrameRateChanged(double frame_rate) {}
+
   // Schedules the callback on the UI task runner. Needs to be invoked as close
   // to the `frame_start_time` as possible.
   void FireCallback(fml::TimePoint frame_start_time,
@@ -75,6 +85,7 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   std::mutex callback_mutex_;
   Callback callback_;
   std::unordered_map<uintptr_t, fml::closure> secondary_callbacks_;
+  double preferred_frame_rate_ = 0.0;
 
   void PauseDartMicroTasks();
   static void ResumeDartMicroTasks(fml::TaskQueueId ui_task_queue_id);
@@ -11,6 +11,15 @@
 
 namespace flutter {
 
+static std::optional<impeller::IRect> ToIRect(
+    const std::optional<SkIRect>& rect) {
+  if (!rect.has_value()) {
+    return std::nullopt;
+  }
+  return impeller::IRect::MakeLTRB(rect->left(), rect->top(), rect->right(),
+                                   rect->bottom());
+}
+
 GPUSurfaceGLImpeller::GPUSurfaceGLImpeller(
     GPUSurfaceGLDelegate* delegate,
     std::shared_ptr<impeller::Context> context)
@@ -57,16 +66,20 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
     return nullptr;
   }
 
-  auto swap_callback = [weak = weak_factory_.GetWeakPtr(),
-                        delegate = delegate_]() -> bool {
+  // The damage of the frame is only known once it is submitted, which happens
+  // before the surface is presented.
+  auto submit_info = std::make_shared<SurfaceFrame::SubmitInfo>();
+
+  auto swap_callback = [weak = weak_factory_.GetWeakPtr(), delegate = delegate_,
+                        submit_info]() -> bool {
     if (weak) {
       GLPresentInfo present_info = {
           .fbo_id = 0,
-          .frame_damage = std::nullopt,
+          .frame_damage = submit_info->frame_damage,
           // TODO (https://github.com/flutter/flutter/issues/105597): wire-up
           // presentation time to impeller backend.
           .presentation_time = std::nullopt,
-          .buffer_damage = std::nullopt,
+          .buffer_damage = submit_info->buffer_damage,
       };
       delegate->GLContextPresent(present_info);
     }
@@ -88,10 +101,25 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
       impeller::ISize{size.width(), size.height()}  // fbo_size
   );
 
+  GLFrameInfo frame_info = {static_cast<uint32_t>(size.width()),
+                            static_cast<uint32_t>(size.height())};
+  const GLFBOInfo fbo_info = delegate_->GLContextFBO(frame_info);
+  SurfaceFrame::FramebufferInfo framebuffer_info =
+      delegate_->GLContextFramebufferInfo();
+  framebuffer_info.supports_partial_repaint =
+      fbo_info.partial_repaint_enabled && surface &&
+      aiks_context_->CanRenderDamage(surface->GetTargetRenderPassDescriptor());
+  if (!framebuffer_info.existing_damage.has_value()) {
+    framebuffer_info.existing_damage = fbo_info.existing_damage;
+  }
+
   SurfaceFrame::SubmitCallback submit_callback =
       fml::MakeCopyable([renderer = impeller_renderer_,  //
                          aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+                         entity_cache = entity_cache_,   //
+                         surface = std::move(surface),   //
+                         delegate = delegate_,           //
+                         submit_info                     //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -103,26 +131,34 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
           return false;
         }
 
-        impeller::DisplayListDispatcher impeller_dispatcher;
+        impeller::DisplayListDispatcher impeller_dispatcher(entity_cache);
         display_list->Dispatch(impeller_dispatcher);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        entity_cache->EndFrame();
+
+        // Only the buffer damage needs to be rendered, the rest of the
+        // framebuffer still holds the frames it was last presented with.
+        *submit_info = surface_frame.submit_info();
+        delegate->GLContextSetDamageRegion(submit_info->buffer_damage);
+        auto buffer_damage = ToIRect(submit_info->buffer_damage);
 
         return renderer->Render(
             std::move(surface),
             fml::MakeCopyable(
-                [aiks_context, picture = std::move(picture)](
-                    impeller::RenderTarget& render_target) -> bool {
-                  return aiks_context->Render(picture, render_target);
+                [aiks_context, picture = std::move(picture),
+                 buffer_damage](impeller::RenderTarget& render_target) -> bool {
+                  return aiks_context->Render(picture, render_target,
+                                              buffer_damage);
                 }));
       });
 
   return std::make_unique<SurfaceFrame>(
-      nullptr,                          // surface
-      SurfaceFrame::FramebufferInfo{},  // framebuffer info
-      submit_callback,                  // submit callback
-      size,                             // frame size
-      std::move(context_switch),        // context result
-      true                              // display list fallback
+      nullptr,                    // surface
+      framebuffer_info,           // framebuffer info
+      submit_callback,            // submit callback
+      size,                       // frame size
+      std::move(context_switch),  // context result
+      true                        // display list fallback
   );
 }
 
@@ -156,7 +192,7 @@ bool GPUSurfaceGLImpeller::AllowsDrawingWhenGpuDisabled() const {
 
 // |Surface|
 bool GPUSurfaceGLImpeller::EnableRasterCache() const {
-  return false;
+  return true;
 }
 
 // |Surface|
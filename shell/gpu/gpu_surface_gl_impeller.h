@@ -10,6 +10,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/display_list/display_list_entity_cache.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
 
@@ -31,6 +32,9 @@ class GPUSurfaceGLImpeller final : public Surface {
   std::shared_ptr<impeller::Context> impeller_context_;
   std::shared_ptr<impeller::Renderer> impeller_renderer_;
   std::shared_ptr<impeller::AiksContext> aiks_context_;
+  // The entity passes of the retained display lists, kept across frames.
+  std::shared_ptr<impeller::DisplayListEntityCache> entity_cache_ =
+      std::make_shared<impeller::DisplayListEntityCache>();
   bool is_valid_ = false;
   fml::WeakPtrFactory<GPUSurfaceGLImpeller> weak_factory_;
 
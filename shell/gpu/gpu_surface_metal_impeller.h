@@ -11,6 +11,7 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/platform/darwin/scoped_nsobject.h"
 #include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/display_list/display_list_entity_cache.h"
 #include "flutter/impeller/renderer/renderer.h"
 #include "flutter/shell/gpu/gpu_surface_metal_delegate.h"
 
@@ -33,6 +34,9 @@ class SK_API_AVAILABLE_CA_METAL_LAYER GPUSurfaceMetalImpeller : public Surface {
   const GPUSurfaceMetalDelegate* delegate_;
   std::shared_ptr<impeller::Renderer> impeller_renderer_;
   std::shared_ptr<impeller::AiksContext> aiks_context_;
+  // The entity passes of the retained display lists, kept across frames.
+  std::shared_ptr<impeller::DisplayListEntityCache> entity_cache_ =
+      std::make_shared<impeller::DisplayListEntityCache>();
   fml::scoped_nsprotocol<id<MTLDrawable>> last_drawable_;
 
   // |Surface|
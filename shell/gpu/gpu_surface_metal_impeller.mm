@@ -57,18 +57,17 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrame(const SkISiz
     return nullptr;
   }
 
-  auto* mtl_layer = (CAMetalLayer*)layer;
-
-  auto surface = impeller::SurfaceMTL::WrapCurrentMetalLayerDrawable(
-      impeller_renderer_->GetContext(), mtl_layer);
-  if (Settings::kSurfaceDataAccessible) {
-    last_drawable_.reset([surface->drawable() retain]);
-  }
+  // The drawable is acquired when the frame is submitted, once the display list has been
+  // converted to a picture, instead of here. Acquiring it blocks until the compositor has released
+  // one, which can take up to a frame, and the compositor has had longer to do so by then.
+  fml::scoped_nsobject<CAMetalLayer> mtl_layer([(CAMetalLayer*)layer retain]);
 
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([renderer = impeller_renderer_,  //
+      fml::MakeCopyable([this,                           //
+                         renderer = impeller_renderer_,  //
                          aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+                         entity_cache = entity_cache_,   //
+                         mtl_layer                       //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -80,9 +79,24 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrame(const SkISiz
           return false;
         }
 
-        impeller::DisplayListDispatcher impeller_dispatcher;
+        impeller::DisplayListDispatcher impeller_dispatcher(entity_cache);
         display_list->Dispatch(impeller_dispatcher);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        entity_cache->EndFrame();
+
+        auto surface = impeller::SurfaceMTL::WrapCurrentMetalLayerDrawable(renderer->GetContext(),
+                                                                           mtl_layer.get());
+        if (!surface) {
+          return false;
+        }
+        if (Settings::kSurfaceDataAccessible) {
+          last_drawable_.reset([surface->drawable() retain]);
+        }
+        // Drawables presented with a transaction are shown with the transaction of the platform
+        // views instead.
+        if (!mtl_layer.get().presentsWithTransaction) {
+          surface->SetPresentationTime(surface_frame.submit_info().presentation_time);
+        }
 
         return renderer->Render(
             std::move(surface),
@@ -125,7 +139,7 @@ bool GPUSurfaceMetalImpeller::AllowsDrawingWhenGpuDisabled() const {
 
 // |Surface|
 bool GPUSurfaceMetalImpeller::EnableRasterCache() const {
-  return false;
+  return true;
 }
 
 // |Surface|
@@ -6,16 +6,79 @@
 
 #include <memory>
 
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
-GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                                       bool render_to_surface)
+namespace {
+
+// The size of the tiles that recorded frames are split into.
+constexpr int32_t kTileSize = 256;
+
+// Finds backdrop filters, which read the pixels around the tile being
+// rasterized and so require the frame to be rasterized as a whole.
+class BackdropFilterSpy final : public virtual DlOpReceiver,
+                                private IgnoreAttributeDispatchHelper,
+                                private IgnoreClipDispatchHelper,
+                                private IgnoreTransformDispatchHelper,
+                                private IgnoreDrawDispatchHelper {
+ public:
+  bool has_backdrop_filter() const { return has_backdrop_filter_; }
+
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    has_backdrop_filter_ = has_backdrop_filter_ || backdrop != nullptr;
+  }
+
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    if (!has_backdrop_filter_) {
+      display_list->Dispatch(*this);
+    }
+  }
+
+ private:
+  bool has_backdrop_filter_ = false;
+};
+
+void RasterizeDisplayList(const sk_sp<DisplayList>& display_list,
+                          SkSurface* surface,
+                          const std::shared_ptr<fml::BasicTaskRunner>& runner) {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizeDisplayList");
+  BackdropFilterSpy spy;
+  display_list->Dispatch(spy);
+
+  SkPixmap pixmap;
+  if (!spy.has_backdrop_filter() && surface->peekPixels(&pixmap)) {
+    // The pixels are written behind the back of the surface.
+    surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+    DlSkCanvasDispatcher::DrawToPixmapTiled(
+        *display_list, pixmap, SkISize::Make(kTileSize, kTileSize), runner);
+    return;
+  }
+
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->resetMatrix();
+  DlSkCanvasAdapter(canvas).DrawDisplayList(display_list);
+  canvas->flush();
+}
+
+}  // namespace
+
+GPUSurfaceSoftware::GPUSurfaceSoftware(
+    GPUSurfaceSoftwareDelegate* delegate,
+    bool render_to_surface,
+    std::shared_ptr<fml::BasicTaskRunner> tile_task_runner)
     : delegate_(delegate),
       render_to_surface_(render_to_surface),
+      tile_task_runner_(std::move(tile_task_runner)),
       weak_factory_(this) {}
 
 GPUSurfaceSoftware::~GPUSurfaceSoftware() = default;
@@ -58,6 +121,34 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return nullptr;
   }
 
+  if (tile_task_runner_) {
+    // Record the frame, so that its tiles can be rasterized concurrently once
+    // it is submitted.
+    SurfaceFrame::SubmitCallback on_submit =
+        [self = weak_factory_.GetWeakPtr(), backing_store](
+            SurfaceFrame& surface_frame, DlCanvas* canvas) -> bool {
+      // If the surface itself went away, there is nothing more to do.
+      if (!self || !self->IsValid() || canvas == nullptr) {
+        return false;
+      }
+
+      auto display_list = surface_frame.BuildDisplayList();
+      if (!display_list) {
+        return false;
+      }
+      RasterizeDisplayList(display_list, backing_store.get(),
+                           self->tile_task_runner_);
+
+      return self->delegate_->PresentBackingStore(backing_store);
+    };
+
+    return std::make_unique<SurfaceFrame>(nullptr, framebuffer_info, on_submit,
+                                          logical_size,
+                                          /*context_result=*/nullptr,
+                                          /*display_list_fallback=*/true,
+                                          /*display_list_rtree=*/true);
+  }
+
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
@@ -5,17 +5,32 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
+#include <memory>
+
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/shell/gpu/gpu_surface_software_delegate.h"
 
 namespace flutter {
 
 class GPUSurfaceSoftware : public Surface {
  public:
-  GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                     bool render_to_surface);
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a surface that rasterizes frames on the CPU.
+  ///
+  /// @param[in]  delegate           The platform surface backing this one.
+  /// @param[in]  render_to_surface  Whether frames are rendered into the
+  ///                                backing stores of the delegate.
+  /// @param[in]  tile_task_runner   If set, frames are recorded and their
+  ///                                tiles rasterized concurrently on this
+  ///                                runner and on the raster thread.
+  ///
+  GPUSurfaceSoftware(
+      GPUSurfaceSoftwareDelegate* delegate,
+      bool render_to_surface,
+      std::shared_ptr<fml::BasicTaskRunner> tile_task_runner = nullptr);
 
   ~GPUSurfaceSoftware() override;
 
@@ -38,6 +53,7 @@ class GPUSurfaceSoftware : public Surface {
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
+  const std::shared_ptr<fml::BasicTaskRunner> tile_task_runner_;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
@@ -11,6 +11,24 @@
 
 namespace flutter {
 
+static std::optional<impeller::IRect> ToIRect(
+    const std::optional<SkIRect>& rect) {
+  if (!rect.has_value()) {
+    return std::nullopt;
+  }
+  return impeller::IRect::MakeLTRB(rect->left(), rect->top(), rect->right(),
+                                   rect->bottom());
+}
+
+static std::optional<SkIRect> ToSkIRect(
+    const std::optional<impeller::IRect>& rect) {
+  if (!rect.has_value()) {
+    return std::nullopt;
+  }
+  return SkIRect::MakeXYWH(rect->origin.x, rect->origin.y, rect->size.width,
+                           rect->size.height);
+}
+
 GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     std::shared_ptr<impeller::Context> context)
     : weak_factory_(this) {
@@ -58,9 +76,17 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
   auto& context_vk = impeller::ContextVK::Cast(*impeller_context_);
   std::unique_ptr<impeller::Surface> surface = context_vk.AcquireNextSurface();
 
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  if (surface && surface->IsValid()) {
+    framebuffer_info.supports_partial_repaint = aiks_context_->CanRenderDamage(
+        surface->GetTargetRenderPassDescriptor());
+    framebuffer_info.existing_damage = ToSkIRect(surface->GetExistingDamage());
+  }
+
   SurfaceFrame::SubmitCallback submit_callback =
       fml::MakeCopyable([renderer = impeller_renderer_,  //
                          aiks_context = aiks_context_,   //
+                         entity_cache = entity_cache_,   //
                          surface = std::move(surface)    //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
@@ -73,22 +99,32 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
           return false;
         }
 
-        impeller::DisplayListDispatcher impeller_dispatcher;
+        impeller::DisplayListDispatcher impeller_dispatcher(entity_cache);
         display_list->Dispatch(impeller_dispatcher);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        entity_cache->EndFrame();
+
+        // Only the buffer damage needs to be rendered, the rest of the
+        // swapchain image still holds the frames it was last presented with.
+        const auto& submit_info = surface_frame.submit_info();
+        auto buffer_damage = ToIRect(submit_info.buffer_damage);
+        if (surface) {
+          surface->SetFrameDamage(ToIRect(submit_info.frame_damage));
+        }
 
         return renderer->Render(
             std::move(surface),
             fml::MakeCopyable(
-                [aiks_context, picture = std::move(picture)](
-                    impeller::RenderTarget& render_target) -> bool {
-                  return aiks_context->Render(picture, render_target);
+                [aiks_context, picture = std::move(picture),
+                 buffer_damage](impeller::RenderTarget& render_target) -> bool {
+                  return aiks_context->Render(picture, render_target,
+                                              buffer_damage);
                 }));
       });
 
   return std::make_unique<SurfaceFrame>(
-      nullptr,                          // surface
-      SurfaceFrame::FramebufferInfo{},  // framebuffer info
+      nullptr,           // surface
+      framebuffer_info,  // framebuffer info
       submit_callback,                  // submit callback
       size,                             // frame size
       nullptr,                          // context result
@@ -118,7 +154,7 @@ GPUSurfaceVulkanImpeller::MakeRenderContextCurrent() {
 
 // |Surface|
 bool GPUSurfaceVulkanImpeller::EnableRasterCache() const {
-  return false;
+  return true;
 }
 
 // |Surface|
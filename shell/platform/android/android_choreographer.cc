@@ -6,6 +6,8 @@
 
 #include "flutter/fml/native_library.h"
 
+#include <optional>
+
 // Only avialalbe on API 24+
 typedef void AChoreographer;
 // Only available on API 29+ or API 24+ if the architecture is 64-bit.
@@ -20,6 +22,38 @@ typedef void (*AChoreographer_postFrameCallback_FPN)(
 static AChoreographer_getInstance_FPN AChoreographer_getInstance;
 static AChoreographer_postFrameCallback_FPN AChoreographer_postFrameCallback;
 
+// Only available on API 33+
+typedef void AChoreographerFrameCallbackData;
+typedef void (*AChoreographer_vsyncCallback)(
+    const AChoreographerFrameCallbackData* callback_data,
+    void* data);
+typedef int (*AChoreographer_postVsyncCallback_FPN)(
+    AChoreographer* choreographer,
+    AChoreographer_vsyncCallback callback,
+    void* data);
+typedef int64_t (*AChoreographerFrameCallbackData_getFrameTimeNanos_FPN)(
+    const AChoreographerFrameCallbackData* data);
+typedef size_t (
+    *AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex_FPN)(
+    const AChoreographerFrameCallbackData* data);
+typedef int64_t (
+    *AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos_FPN)(
+    const AChoreographerFrameCallbackData* data,
+    size_t index);
+typedef int64_t (
+    *AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos_FPN)(
+    const AChoreographerFrameCallbackData* data,
+    size_t index);
+static AChoreographer_postVsyncCallback_FPN AChoreographer_postVsyncCallback;
+static AChoreographerFrameCallbackData_getFrameTimeNanos_FPN
+    AChoreographerFrameCallbackData_getFrameTimeNanos;
+static AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex_FPN
+    AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex;
+static AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos_FPN
+    AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos;
+static AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos_FPN
+    AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos;
+
 namespace flutter {
 
 bool AndroidChoreographer::ShouldUseNDKChoreographer() {
@@ -58,4 +92,80 @@ void AndroidChoreographer::PostFrameCallback(OnFrameCallback callback,
   AChoreographer_postFrameCallback(choreographer, callback, data);
 }
 
+bool AndroidChoreographer::ShouldUseVsyncCallback() {
+  static std::optional<bool> use_vsync_callback;
+  if (use_vsync_callback) {
+    return use_vsync_callback.value();
+  }
+  use_vsync_callback = false;
+  if (!ShouldUseNDKChoreographer()) {
+    return false;
+  }
+  auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+  FML_DCHECK(libandroid);
+  auto post_vsync_callback_fn =
+      libandroid->ResolveFunction<AChoreographer_postVsyncCallback_FPN>(
+          "AChoreographer_postVsyncCallback");
+  auto get_frame_time_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getFrameTimeNanos_FPN>(
+      "AChoreographerFrameCallbackData_getFrameTimeNanos");
+  auto get_preferred_index_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex_FPN>(
+      "AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex");
+  auto get_deadline_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos_FPN>(
+      "AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos");
+  auto get_expected_present_time_fn = libandroid->ResolveFunction<
+      AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos_FPN>(
+      "AChoreographerFrameCallbackData_"
+      "getFrameTimelineExpectedPresentationTimeNanos");
+  if (post_vsync_callback_fn && get_frame_time_fn && get_preferred_index_fn &&
+      get_deadline_fn && get_expected_present_time_fn) {
+    AChoreographer_postVsyncCallback = post_vsync_callback_fn.value();
+    AChoreographerFrameCallbackData_getFrameTimeNanos =
+        get_frame_time_fn.value();
+    AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex =
+        get_preferred_index_fn.value();
+    AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos =
+        get_deadline_fn.value();
+    AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos =
+        get_expected_present_time_fn.value();
+    use_vsync_callback = true;
+  }
+  return use_vsync_callback.value();
+}
+
+namespace {
+
+struct VsyncCallbackBaton {
+  AndroidChoreographer::OnVsyncCallback callback;
+  void* data;
+};
+
+void OnChoreographerVsync(const AChoreographerFrameCallbackData* callback_data,
+                          void* data) {
+  auto* baton = reinterpret_cast<VsyncCallbackBaton*>(data);
+  size_t index =
+      AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex(
+          callback_data);
+  baton->callback(
+      AChoreographerFrameCallbackData_getFrameTimeNanos(callback_data),
+      AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos(
+          callback_data, index),
+      AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos(
+          callback_data, index),
+      baton->data);
+  delete baton;
+}
+
+}  // namespace
+
+void AndroidChoreographer::PostVsyncCallback(OnVsyncCallback callback,
+                                             void* data) {
+  AChoreographer* choreographer = AChoreographer_getInstance();
+  AChoreographer_postVsyncCallback(
+      choreographer, &OnChoreographerVsync,
+      new VsyncCallbackBaton{.callback = callback, .data = data});
+}
+
 }  // namespace flutter
@@ -19,9 +19,21 @@ namespace flutter {
 class AndroidChoreographer {
  public:
   typedef void (*OnFrameCallback)(int64_t frame_time_nanos, void* data);
+  /// |deadline_nanos| is the time by which the frame must be submitted for it
+  /// to be presented at |expected_present_time_nanos|, in the frame timeline
+  /// that the platform prefers.
+  typedef void (*OnVsyncCallback)(int64_t frame_time_nanos,
+                                  int64_t deadline_nanos,
+                                  int64_t expected_present_time_nanos,
+                                  void* data);
   static bool ShouldUseNDKChoreographer();
   static void PostFrameCallback(OnFrameCallback callback, void* data);
 
+  /// Whether frame timelines are available, which is on API 33+. Implies
+  /// |ShouldUseNDKChoreographer|.
+  static bool ShouldUseVsyncCallback();
+  static void PostVsyncCallback(OnVsyncCallback callback, void* data);
+
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidChoreographer);
 };
 
@@ -0,0 +1,145 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_external_image_texture_vk.h"
+
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+#include "flutter/impeller/display_list/display_list_image_impeller.h"
+#include "flutter/impeller/renderer/backend/vulkan/texture_vk.h"
+#include "flutter/impeller/toolkit/android/proc_table.h"
+
+namespace flutter {
+
+AndroidExternalImageTextureVK::AndroidExternalImageTextureVK(
+    int64_t id,
+    const fml::jni::ScopedJavaGlobalRef<jobject>& image_consumer,
+    std::shared_ptr<impeller::ContextVK> context,
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade)
+    : Texture(id),
+      jni_facade_(std::move(jni_facade)),
+      image_consumer_(image_consumer),
+      context_(std::move(context)) {}
+
+AndroidExternalImageTextureVK::~AndroidExternalImageTextureVK() {
+  CloseOpenImages(0u);
+}
+
+void AndroidExternalImageTextureVK::OnGrContextCreated() {}
+
+void AndroidExternalImageTextureVK::OnGrContextDestroyed() {
+  current_image_ = nullptr;
+  cached_images_.clear();
+  yuv_conversion_ = nullptr;
+}
+
+void AndroidExternalImageTextureVK::MarkNewFrameAvailable() {
+  new_frame_ready_ = true;
+}
+
+void AndroidExternalImageTextureVK::OnTextureUnregistered() {
+  unregistered_ = true;
+  OnGrContextDestroyed();
+  CloseOpenImages(0u);
+}
+
+void AndroidExternalImageTextureVK::Paint(PaintContext& context,
+                                          const SkRect& bounds,
+                                          bool freeze,
+                                          const DlImageSampling sampling) {
+  if (unregistered_) {
+    return;
+  }
+  if (!freeze && new_frame_ready_) {
+    ProcessNextImage();
+    new_frame_ready_ = false;
+  }
+  if (!current_image_) {
+    return;
+  }
+  context.canvas->DrawImageRect(current_image_,
+                                SkRect::Make(current_image_->bounds()),
+                                bounds, sampling, context.paint);
+}
+
+void AndroidExternalImageTextureVK::ProcessNextImage() {
+  TRACE_EVENT0("flutter", "AndroidExternalImageTextureVK::ProcessNextImage");
+  JavaLocalRef image =
+      jni_facade_->ImageConsumerTextureRegistryAcquireLatestImage(
+          fml::jni::ScopedJavaLocalRef<jobject>(image_consumer_));
+  if (image.is_null()) {
+    return;
+  }
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+  open_images_.emplace_back(env, image.obj());
+
+  JavaLocalRef hardware_buffer = jni_facade_->ImageGetHardwareBuffer(image);
+  const auto& procs = impeller::android::GetProcTable();
+  if (!hardware_buffer.is_null() && procs.IsHardwareBufferImportAvailable()) {
+    // The buffer is only referenced by the Java object, but the imported
+    // memory takes a reference of its own.
+    if (auto buffer = procs.AHardwareBuffer_fromHardwareBuffer(
+            env, hardware_buffer.obj())) {
+      if (auto dl_image = FindOrImportImage(buffer)) {
+        current_image_ = std::move(dl_image);
+      }
+    }
+  }
+  jni_facade_->HardwareBufferClose(hardware_buffer);
+  CloseOpenImages(kMaxOpenImages);
+}
+
+sk_sp<DlImage> AndroidExternalImageTextureVK::FindOrImportImage(
+    AHardwareBuffer* buffer) {
+  const auto& procs = impeller::android::GetProcTable();
+
+  // IDs are only available from API 31. Before that, the address of the
+  // buffer is just as unique while the cached image keeps the buffer alive.
+  uint64_t buffer_id = reinterpret_cast<uint64_t>(buffer);
+  if (procs.AHardwareBuffer_getId) {
+    procs.AHardwareBuffer_getId(buffer, &buffer_id);
+  }
+
+  for (auto it = cached_images_.begin(); it != cached_images_.end(); ++it) {
+    if (it->buffer_id == buffer_id) {
+      auto cached_image = std::move(*it);
+      cached_images_.erase(it);
+      cached_images_.push_back(cached_image);
+      return cached_image.image;
+    }
+  }
+
+  AHardwareBuffer_Desc desc = {};
+  procs.AHardwareBuffer_describe(buffer, &desc);
+  auto source = std::make_shared<impeller::AHBTextureSourceVK>(
+      context_, buffer, desc, yuv_conversion_);
+  if (!source->IsValid()) {
+    FML_LOG(ERROR) << "Could not import the hardware buffer of an image.";
+    return nullptr;
+  }
+  if (source->GetYUVConversion()) {
+    yuv_conversion_ = source->GetYUVConversion();
+  }
+  auto texture =
+      std::make_shared<impeller::TextureVK>(context_, std::move(source));
+  auto image = impeller::DlImageImpeller::Make(std::move(texture),
+                                               DlImage::OwningContext::kRaster);
+
+  cached_images_.push_back({buffer_id, image});
+  while (cached_images_.size() > kMaxCachedImages) {
+    cached_images_.pop_front();
+  }
+  return image;
+}
+
+void AndroidExternalImageTextureVK::CloseOpenImages(size_t keep_count) {
+  while (open_images_.size() > keep_count) {
+    jni_facade_->ImageClose(
+        fml::jni::ScopedJavaLocalRef<jobject>(open_images_.front()));
+    open_images_.pop_front();
+  }
+}
+
+}  // namespace flutter
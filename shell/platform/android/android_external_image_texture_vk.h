@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_EXTERNAL_IMAGE_TEXTURE_VK_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_EXTERNAL_IMAGE_TEXTURE_VK_H_
+
+#include <android/hardware_buffer.h>
+
+#include <deque>
+#include <memory>
+
+#include "flutter/common/graphics/texture.h"
+#include "flutter/impeller/renderer/backend/vulkan/ahb_texture_source_vk.h"
+#include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
+#include "flutter/shell/platform/android/platform_view_android_jni_impl.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Displays the `android.media.Image`s pushed to an image texture
+///             entry, such as the frames of an `ImageReader` fed by a video
+///             decoder or a camera, with Impeller on Vulkan.
+///
+///             The hardware buffers backing the images are imported without
+///             copies. Image readers cycle through a handful of buffers, so
+///             the imported images are cached by buffer ID and every buffer
+///             is only imported once.
+///
+class AndroidExternalImageTextureVK : public flutter::Texture {
+ public:
+  AndroidExternalImageTextureVK(
+      int64_t id,
+      const fml::jni::ScopedJavaGlobalRef<jobject>& image_consumer,
+      std::shared_ptr<impeller::ContextVK> context,
+      std::shared_ptr<PlatformViewAndroidJNI> jni_facade);
+
+  ~AndroidExternalImageTextureVK() override;
+
+  void Paint(PaintContext& context,
+             const SkRect& bounds,
+             bool freeze,
+             const DlImageSampling sampling) override;
+
+  void OnGrContextCreated() override;
+
+  void OnGrContextDestroyed() override;
+
+  void MarkNewFrameAvailable() override;
+
+  void OnTextureUnregistered() override;
+
+ private:
+  struct CachedImage {
+    uint64_t buffer_id = 0u;
+    sk_sp<DlImage> image;
+  };
+
+  // Image readers usually have 2 to 4 buffers. The rest makes room for the
+  // buffers of a stream that was just resized.
+  static constexpr size_t kMaxCachedImages = 8u;
+
+  // The image drawn last frame may still be sampled by the GPU, so it is only
+  // given back to the producer once the image after it is drawn.
+  static constexpr size_t kMaxOpenImages = 2u;
+
+  std::shared_ptr<PlatformViewAndroidJNI> jni_facade_;
+  fml::jni::ScopedJavaGlobalRef<jobject> image_consumer_;
+  std::shared_ptr<impeller::ContextVK> context_;
+  std::shared_ptr<impeller::YUVConversionVK> yuv_conversion_;
+  // Least recently used first.
+  std::deque<CachedImage> cached_images_;
+  std::deque<fml::jni::ScopedJavaGlobalRef<jobject>> open_images_;
+  sk_sp<DlImage> current_image_;
+  bool new_frame_ready_ = false;
+  bool unregistered_ = false;
+
+  void ProcessNextImage();
+
+  sk_sp<DlImage> FindOrImportImage(AHardwareBuffer* buffer);
+
+  void CloseOpenImages(size_t keep_count);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidExternalImageTextureVK);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_EXTERNAL_IMAGE_TEXTURE_VK_H_
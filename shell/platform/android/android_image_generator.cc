@@ -4,6 +4,9 @@
 
 #include "flutter/shell/platform/android/android_image_generator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -17,8 +20,30 @@
 namespace flutter {
 
 static fml::jni::ScopedJavaGlobalRef<jclass>* g_flutter_jni_class = nullptr;
+static jmethodID g_decode_image_header_method = nullptr;
 static jmethodID g_decode_image_method = nullptr;
 
+// Whether the data starts like a JPEG image, or like a HEIF image, whose ISO
+// base media file starts with an `ftyp` box that lists a HEIF brand.
+static bool IsHardwareDecodedFormat(const SkData& data) {
+  static constexpr uint8_t kJPEGSignature[] = {0xFF, 0xD8, 0xFF};
+  if (data.size() >= sizeof(kJPEGSignature) &&
+      memcmp(data.bytes(), kJPEGSignature, sizeof(kJPEGSignature)) == 0) {
+    return true;
+  }
+  static constexpr const char* kHEIFBrands[] = {"heic", "heix", "hevc",
+                                                "hevx", "mif1", "msf1"};
+  if (data.size() < 12 || memcmp(data.bytes() + 4, "ftyp", 4) != 0) {
+    return false;
+  }
+  for (const char* brand : kHEIFBrands) {
+    if (memcmp(data.bytes() + 8, brand, 4) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 AndroidImageGenerator::~AndroidImageGenerator() = default;
 
 AndroidImageGenerator::AndroidImageGenerator(sk_sp<SkData> data)
@@ -45,7 +70,12 @@ const ImageGenerator::FrameInfo AndroidImageGenerator::GetFrameInfo(
 }
 
 SkISize AndroidImageGenerator::GetScaledDimensions(float desired_scale) {
-  return GetInfo().dimensions();
+  // The decoder can decode the image straight at any size.
+  const SkISize dimensions = GetInfo().dimensions();
+  const float scale = std::clamp(desired_scale, 0.0f, 1.0f);
+  return SkISize::Make(
+      std::max(1, static_cast<int>(std::round(dimensions.width() * scale))),
+      std::max(1, static_cast<int>(std::round(dimensions.height() * scale))));
 }
 
 bool AndroidImageGenerator::GetPixels(const SkImageInfo& info,
@@ -53,9 +83,10 @@ bool AndroidImageGenerator::GetPixels(const SkImageInfo& info,
                                       size_t row_bytes,
                                       unsigned int frame_index,
                                       std::optional<unsigned int> prior_frame) {
-  fully_decoded_latch_.Wait();
+  FML_DCHECK(g_flutter_jni_class);
+  FML_DCHECK(g_decode_image_method);
 
-  if (!software_decoded_data_) {
+  if (GetInfo().isEmpty() || frame_index != 0) {
     return false;
   }
 
@@ -75,27 +106,71 @@ bool AndroidImageGenerator::GetPixels(const SkImageInfo& info,
       return false;
   }
 
+  // Call FlutterJNI.decodeImage, which decodes the image at the requested size
+  // on this thread.
+
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  // Create a frame to ensure that all local JNI references used here are
+  // freed.
+  fml::jni::ScopedJavaLocalFrame scoped_local_reference_frame(env);
+
+  jobject direct_buffer =
+      env->NewDirectByteBuffer(const_cast<void*>(data_->data()), data_->size());
+
+  jobject bitmap = env->CallStaticObjectMethod(
+      g_flutter_jni_class->obj(), g_decode_image_method, direct_buffer,
+      static_cast<jint>(info.width()), static_cast<jint>(info.height()));
+  FML_CHECK(fml::jni::CheckException(env));
+
+  if (bitmap == nullptr) {
+    return false;
+  }
+
+  AndroidBitmapInfo bitmap_info;
+  [[maybe_unused]] int status;
+  if ((status = AndroidBitmap_getInfo(env, bitmap, &bitmap_info)) < 0) {
+    FML_DLOG(ERROR) << "Failed to get bitmap info, status=" << status;
+    return false;
+  }
+  FML_DCHECK(bitmap_info.format == ANDROID_BITMAP_FORMAT_RGBA_8888);
+  if (static_cast<int>(bitmap_info.width) != info.width() ||
+      static_cast<int>(bitmap_info.height) != info.height()) {
+    FML_DLOG(ERROR) << "Decoded bitmap does not have the requested size";
+    return false;
+  }
+
+  void* pixel_lock;
+  if ((status = AndroidBitmap_lockPixels(env, bitmap, &pixel_lock)) < 0) {
+    FML_DLOG(ERROR) << "Failed to lock pixels, error=" << status;
+    return false;
+  }
+
   // TODO(bdero): Override `GetImage()` to use `SkImage::FromAHardwareBuffer` on
   // API level 30+ once it's updated to do symbol lookups and not get
-  // preprocessed out in Skia. This will allow for avoiding this copy in
-  // cases where the result image doesn't need to be resized.
-  memcpy(pixels, software_decoded_data_->data(),
-         software_decoded_data_->size());
+  // preprocessed out in Skia. This will allow for avoiding this copy.
+  const size_t min_row_bytes = info.minRowBytes();
+  for (int row = 0; row < info.height(); row++) {
+    memcpy(static_cast<uint8_t*>(pixels) + row * row_bytes,
+           static_cast<const uint8_t*>(pixel_lock) + row * bitmap_info.stride,
+           min_row_bytes);
+  }
+
+  AndroidBitmap_unlockPixels(env, bitmap);
   return true;
 }
 
-void AndroidImageGenerator::DecodeImage() {
-  DoDecodeImage();
+void AndroidImageGenerator::DecodeImageHeader() {
+  DoDecodeImageHeader();
 
   header_decoded_latch_.Signal();
-  fully_decoded_latch_.Signal();
 }
 
-void AndroidImageGenerator::DoDecodeImage() {
+void AndroidImageGenerator::DoDecodeImageHeader() {
   FML_DCHECK(g_flutter_jni_class);
-  FML_DCHECK(g_decode_image_method);
+  FML_DCHECK(g_decode_image_header_method);
 
-  // Call FlutterJNI.decodeImage
+  // Call FlutterJNI.decodeImageHeader
 
   JNIEnv* env = fml::jni::AttachCurrentThread();
 
@@ -106,44 +181,10 @@ void AndroidImageGenerator::DoDecodeImage() {
   jobject direct_buffer =
       env->NewDirectByteBuffer(const_cast<void*>(data_->data()), data_->size());
 
-  auto bitmap = std::make_unique<fml::jni::ScopedJavaGlobalRef<jobject>>(
-      env, env->CallStaticObjectMethod(g_flutter_jni_class->obj(),
-                                       g_decode_image_method, direct_buffer,
-                                       reinterpret_cast<jlong>(this)));
+  env->CallStaticBooleanMethod(g_flutter_jni_class->obj(),
+                               g_decode_image_header_method, direct_buffer,
+                               reinterpret_cast<jlong>(this));
   FML_CHECK(fml::jni::CheckException(env));
-
-  if (bitmap->is_null()) {
-    return;
-  }
-
-  AndroidBitmapInfo info;
-  [[maybe_unused]] int status;
-  if ((status = AndroidBitmap_getInfo(env, bitmap->obj(), &info)) < 0) {
-    FML_DLOG(ERROR) << "Failed to get bitmap info, status=" << status;
-    return;
-  }
-  FML_DCHECK(info.format == ANDROID_BITMAP_FORMAT_RGBA_8888);
-
-  // Lock the android buffer in a shared pointer
-
-  void* pixel_lock;
-  if ((status = AndroidBitmap_lockPixels(env, bitmap->obj(), &pixel_lock)) <
-      0) {
-    FML_DLOG(ERROR) << "Failed to lock pixels, error=" << status;
-    return;
-  }
-
-  SkData::ReleaseProc on_release = [](const void* ptr, void* context) -> void {
-    fml::jni::ScopedJavaGlobalRef<jobject>* bitmap =
-        reinterpret_cast<fml::jni::ScopedJavaGlobalRef<jobject>*>(context);
-    auto env = fml::jni::AttachCurrentThread();
-    AndroidBitmap_unlockPixels(env, bitmap->obj());
-    delete bitmap;
-  };
-
-  software_decoded_data_ = SkData::MakeWithProc(
-      pixel_lock, info.width * info.height * sizeof(uint32_t), on_release,
-      bitmap.release());
 }
 
 bool AndroidImageGenerator::Register(JNIEnv* env) {
@@ -151,9 +192,14 @@ bool AndroidImageGenerator::Register(JNIEnv* env) {
       env, env->FindClass("io/flutter/embedding/engine/FlutterJNI"));
   FML_DCHECK(!g_flutter_jni_class->is_null());
 
+  g_decode_image_header_method =
+      env->GetStaticMethodID(g_flutter_jni_class->obj(), "decodeImageHeader",
+                             "(Ljava/nio/ByteBuffer;J)Z");
+  FML_DCHECK(g_decode_image_header_method);
+
   g_decode_image_method = env->GetStaticMethodID(
       g_flutter_jni_class->obj(), "decodeImage",
-      "(Ljava/nio/ByteBuffer;J)Landroid/graphics/Bitmap;");
+      "(Ljava/nio/ByteBuffer;II)Landroid/graphics/Bitmap;");
   FML_DCHECK(g_decode_image_method);
 
   static const JNINativeMethod header_decoded_method = {
@@ -174,12 +220,17 @@ bool AndroidImageGenerator::Register(JNIEnv* env) {
 
 std::shared_ptr<ImageGenerator> AndroidImageGenerator::MakeFromData(
     sk_sp<SkData> data,
-    const fml::RefPtr<fml::TaskRunner>& task_runner) {
+    const fml::RefPtr<fml::TaskRunner>& task_runner,
+    bool hardware_decoded_formats_only) {
+  if (hardware_decoded_formats_only && !IsHardwareDecodedFormat(*data)) {
+    return nullptr;
+  }
+
   std::shared_ptr<AndroidImageGenerator> generator(
       new AndroidImageGenerator(std::move(data)));
 
   fml::TaskRunner::RunNowOrPostTask(
-      task_runner, [generator]() { generator->DecodeImage(); });
+      task_runner, [generator]() { generator->DecodeImageHeader(); });
 
   if (generator->IsValidImageData()) {
     return generator;
@@ -202,7 +253,7 @@ void AndroidImageGenerator::NativeImageHeaderCallback(JNIEnv* env,
 }
 
 bool AndroidImageGenerator::IsValidImageData() {
-  // The generator kicks off an IO task to decode everything, and calls to
+  // The generator kicks off an IO task to decode the header, and calls to
   // "GetInfo()" block until either the header has been decoded or decoding has
   // failed, whichever is sooner. The decoder is initialized with a width and
   // height of -1 and will update the dimensions if the image is able to be
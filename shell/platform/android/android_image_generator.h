@@ -14,6 +14,14 @@
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// @brief      Decodes images with the `ImageDecoder` of the Android SDK, which
+///             uses the hardware JPEG and HEIF decoders of the device.
+///
+///             Only the header of the image is decoded when the generator is
+///             created. The pixels are decoded when they are requested,
+///             straight at the requested size.
+///
 class AndroidImageGenerator : public ImageGenerator {
  private:
   explicit AndroidImageGenerator(sk_sp<SkData> buffer);
@@ -44,13 +52,19 @@ class AndroidImageGenerator : public ImageGenerator {
                  unsigned int frame_index,
                  std::optional<unsigned int> prior_frame) override;
 
-  void DecodeImage();
+  void DecodeImageHeader();
 
   static bool Register(JNIEnv* env);
 
+  //----------------------------------------------------------------------------
+  /// @param[in]  hardware_decoded_formats_only  Whether to return `nullptr`
+  ///             for the images that aren't JPEG or HEIF images, so that they
+  ///             are decoded by the other generators.
+  ///
   static std::shared_ptr<ImageGenerator> MakeFromData(
       sk_sp<SkData> data,
-      const fml::RefPtr<fml::TaskRunner>& task_runner);
+      const fml::RefPtr<fml::TaskRunner>& task_runner,
+      bool hardware_decoded_formats_only = false);
 
   static void NativeImageHeaderCallback(JNIEnv* env,
                                         jclass jcaller,
@@ -60,7 +74,6 @@ class AndroidImageGenerator : public ImageGenerator {
 
  private:
   sk_sp<SkData> data_;
-  sk_sp<SkData> software_decoded_data_;
 
   SkImageInfo image_info_;
 
@@ -68,10 +81,7 @@ class AndroidImageGenerator : public ImageGenerator {
   /// dimensions have been determined.
   fml::ManualResetWaitableEvent header_decoded_latch_;
 
-  /// Blocks until the image has been fully decoded.
-  fml::ManualResetWaitableEvent fully_decoded_latch_;
-
-  void DoDecodeImage();
+  void DoDecodeImageHeader();
 
   bool IsValidImageData();
 
@@ -16,6 +16,7 @@
 #include <string>
 #include <utility>
 
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
@@ -38,6 +39,11 @@ static void AndroidPlatformThreadConfigSetter(
     const fml::Thread::ThreadConfig& config) {
   // set thread name
   fml::Thread::SetCurrentThreadName(config);
+  // keep the thread on the requested cores, so that the scheduler does not
+  // migrate the UI and raster threads onto the little cores mid-animation
+  if (config.affinity.has_value()) {
+    fml::RequestAffinity(config.affinity.value());
+  }
   // set thread priority
   switch (config.priority) {
     case fml::Thread::ThreadPriority::BACKGROUND: {
@@ -93,14 +99,17 @@ AndroidShellHolder::AndroidShellHolder(
       flutter::ThreadHost::ThreadHostConfig::MakeThreadName(
           flutter::ThreadHost::Type::UI, thread_label),
       fml::Thread::ThreadPriority::DISPLAY);
+  host_config.ui_config->affinity = fml::CpuAffinity::kPerformance;
   host_config.raster_config = fml::Thread::ThreadConfig(
       flutter::ThreadHost::ThreadHostConfig::MakeThreadName(
           flutter::ThreadHost::Type::RASTER, thread_label),
       fml::Thread::ThreadPriority::RASTER);
+  host_config.raster_config->affinity = fml::CpuAffinity::kPerformance;
   host_config.io_config = fml::Thread::ThreadConfig(
       flutter::ThreadHost::ThreadHostConfig::MakeThreadName(
           flutter::ThreadHost::Type::IO, thread_label),
       fml::Thread::ThreadPriority::NORMAL);
+  host_config.io_config->affinity = fml::CpuAffinity::kNotPerformance;
 
   thread_host_ = std::make_shared<ThreadHost>(host_config);
 
@@ -162,11 +171,18 @@ AndroidShellHolder::AndroidShellHolder(
       }
     });
 
+    // The SDK decoder is only a fallback for the formats that Skia can't
+    // decode, unless it is preferred for the formats it decodes in hardware.
+    const bool prefer_platform_decoder =
+        settings_.prefer_platform_image_decoders;
     shell_->RegisterImageDecoder(
-        [runner = task_runners.GetIOTaskRunner()](sk_sp<SkData> buffer) {
-          return AndroidImageGenerator::MakeFromData(std::move(buffer), runner);
+        [runner = task_runners.GetIOTaskRunner(),
+         prefer_platform_decoder](sk_sp<SkData> buffer) {
+          return AndroidImageGenerator::MakeFromData(
+              std::move(buffer), runner,
+              /*hardware_decoded_formats_only=*/prefer_platform_decoder);
         },
-        -1);
+        prefer_platform_decoder ? 1 : -1);
     FML_DLOG(INFO) << "Registered Android SDK image decoder (API level 28+)";
   }
 
@@ -311,6 +327,11 @@ void AndroidShellHolder::NotifyLowMemoryWarning() {
   shell_->NotifyLowMemoryWarning();
 }
 
+void AndroidShellHolder::NotifyMemoryPressure(MemoryPressureLevel level) {
+  FML_DCHECK(shell_);
+  shell_->NotifyMemoryPressure(level);
+}
+
 std::optional<RunConfiguration> AndroidShellHolder::BuildRunConfiguration(
     const std::string& entrypoint,
     const std::string& libraryUrl,
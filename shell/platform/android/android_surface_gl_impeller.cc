@@ -5,6 +5,7 @@
 #include "flutter/shell/platform/android/android_surface_gl_impeller.h"
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/paths.h"
 #include "flutter/impeller/renderer/backend/gles/context_gles.h"
 #include "flutter/impeller/renderer/backend/gles/proc_table_gles.h"
 #include "flutter/impeller/toolkit/egl/context.h"
@@ -64,8 +65,8 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
           impeller_scene_shaders_gles_data, impeller_scene_shaders_gles_length),
   };
 
-  auto context =
-      impeller::ContextGLES::Create(std::move(proc_table), shader_mappings);
+  auto context = impeller::ContextGLES::Create(
+      std::move(proc_table), shader_mappings, fml::paths::GetCachesDirectory());
   if (!context) {
     FML_LOG(ERROR) << "Could not create OpenGLES Impeller Context.";
     return nullptr;
@@ -65,7 +65,12 @@ bool AndroidSurfaceVulkanImpeller::IsValid() const {
 }
 
 void AndroidSurfaceVulkanImpeller::TeardownOnScreenContext() {
-  // Nothing to do.
+  // The on-screen surface is torn down when the application is backgrounded,
+  // after which the process may be killed at any time. Save the pipelines
+  // compiled so far so that the next cold start doesn't recompile them.
+  if (impeller_context_) {
+    impeller::ContextVK::Cast(*impeller_context_).PersistPipelineCacheToDisk();
+  }
 }
 
 std::unique_ptr<Surface> AndroidSurfaceVulkanImpeller::CreateGPUSurface(
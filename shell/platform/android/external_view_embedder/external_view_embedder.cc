@@ -3,22 +3,41 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/android/external_view_embedder/external_view_embedder.h"
+
+#include <optional>
+
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
+namespace {
+
+// The overlays of one or more platform views that are drawn in the same
+// surface, above the platform view at |host_index| in the composition order.
+struct OverlayGroup {
+  size_t host_index = 0;
+  SkRect rect = SkRect::MakeEmpty();
+  std::vector<int64_t> view_ids;
+};
+
+}  // namespace
+
 AndroidExternalViewEmbedder::AndroidExternalViewEmbedder(
     const AndroidContext& android_context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
     std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-    const TaskRunners& task_runners)
+    const TaskRunners& task_runners,
+    bool use_thread_merging,
+    fml::closure schedule_frame)
     : ExternalViewEmbedder(),
       android_context_(android_context),
       jni_facade_(std::move(jni_facade)),
       surface_factory_(std::move(surface_factory)),
-      surface_pool_(std::make_unique<SurfacePool>()),
-      task_runners_(task_runners) {}
+      surface_pool_(std::make_shared<SurfacePool>()),
+      task_runners_(task_runners),
+      use_thread_merging_(use_thread_merging),
+      schedule_frame_(std::move(schedule_frame)) {}
 
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::PrerollCompositeEmbeddedView(
@@ -139,42 +158,97 @@ void AndroidExternalViewEmbedder::SubmitFrame(
   // Manually trigger the DlAutoCanvasRestore before we submit the frame
   save.Restore();
 
+  // Each overlay takes a surface the size of the frame, so the overlays of
+  // consecutive platform views are drawn in one surface where possible. An
+  // overlay can be moved above the following platform views as long as it
+  // doesn't intersect them.
+  std::vector<OverlayGroup> overlay_groups;
+  std::optional<OverlayGroup> current_group;
+  for (size_t i = 0; i < current_frame_view_count; i++) {
+    int64_t view_id = composition_order_[i];
+    if (current_group.has_value() &&
+        current_group->rect.intersects(GetViewRect(view_id))) {
+      overlay_groups.push_back(std::move(current_group.value()));
+      current_group.reset();
+    }
+    auto overlay = overlay_layers.find(view_id);
+    if (overlay != overlay_layers.end()) {
+      if (!current_group.has_value()) {
+        current_group = OverlayGroup{};
+      }
+      current_group->rect.join(overlay->second);
+      current_group->view_ids.push_back(view_id);
+    }
+    if (current_group.has_value()) {
+      current_group->host_index = i;
+    }
+  }
+  if (current_group.has_value()) {
+    overlay_groups.push_back(std::move(current_group.value()));
+  }
+
   // Submit the background canvas frame before switching the GL context to
   // the overlay surfaces.
   //
   // Skip a frame if the embedding is switching surfaces, and indicate in
   // `PostPrerollAction` that this frame must be resubmitted.
   auto should_submit_current_frame = previous_frame_view_count_ > 0;
+  if (!use_thread_merging_) {
+    // The overlay surfaces can only be created on the platform thread, so
+    // the frame is dropped if some are missing and is drawn again once its
+    // platform transaction has created them. Without a thread merger there
+    // is no `PostPrerollAction` to resubmit the frame that switches the
+    // surfaces either, so it is drawn again the same way.
+    size_t available_layer_count = surface_pool_->GetAvailableLayerCount();
+    if (available_layer_count < overlay_groups.size()) {
+      missing_overlay_surface_count_ =
+          overlay_groups.size() - available_layer_count;
+      should_submit_current_frame = false;
+    }
+    needs_redraw_ = !should_submit_current_frame;
+  }
   if (should_submit_current_frame) {
     frame->Submit();
   }
 
-  for (int64_t view_id : composition_order_) {
+  auto next_group = overlay_groups.begin();
+  for (size_t i = 0; i < composition_order_.size(); i++) {
+    int64_t view_id = composition_order_[i];
     SkRect view_rect = GetViewRect(view_id);
     const EmbeddedViewParams& params = view_params_.at(view_id);
     // Display the platform view. If it's already displayed, then it's
     // just positioned and sized.
-    jni_facade_->FlutterViewOnDisplayPlatformView(
-        view_id,             //
-        view_rect.x(),       //
-        view_rect.y(),       //
-        view_rect.width(),   //
-        view_rect.height(),  //
-        params.sizePoints().width() * device_pixel_ratio_,
-        params.sizePoints().height() * device_pixel_ratio_,
-        params.mutatorsStack()  //
-    );
-    std::unordered_map<int64_t, SkRect>::const_iterator overlay =
-        overlay_layers.find(view_id);
-    if (overlay == overlay_layers.end()) {
+    RunOnPlatformThread(
+        [jni_facade = jni_facade_, view_id, view_rect,
+         view_width = params.sizePoints().width() * device_pixel_ratio_,
+         view_height = params.sizePoints().height() * device_pixel_ratio_,
+         mutators_stack = params.mutatorsStack()]() {
+          jni_facade->FlutterViewOnDisplayPlatformView(
+              view_id,             //
+              view_rect.x(),       //
+              view_rect.y(),       //
+              view_rect.width(),   //
+              view_rect.height(),  //
+              view_width,          //
+              view_height,         //
+              mutators_stack       //
+          );
+        });
+    if (next_group == overlay_groups.end() || next_group->host_index != i) {
+      continue;
+    }
+    const OverlayGroup& group = *next_group++;
+    if (!use_thread_merging_ && !should_submit_current_frame) {
+      // The overlay surfaces may be missing.
       continue;
     }
+    std::vector<std::pair<EmbedderViewSlice*, SkRect>> group_slices;
+    for (int64_t group_view_id : group.view_ids) {
+      group_slices.emplace_back(slices_.at(group_view_id).get(),
+                                overlay_layers.at(group_view_id));
+    }
     std::unique_ptr<SurfaceFrame> frame =
-        CreateSurfaceIfNeeded(context,                    //
-                              view_id,                    //
-                              slices_.at(view_id).get(),  //
-                              overlay->second             //
-        );
+        CreateSurfaceIfNeeded(context, group_slices, group.rect);
     if (should_submit_current_frame) {
       frame->Submit();
     }
@@ -183,10 +257,10 @@ void AndroidExternalViewEmbedder::SubmitFrame(
 
 // |ExternalViewEmbedder|
 std::unique_ptr<SurfaceFrame>
-AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
-                                                   int64_t view_id,
-                                                   EmbedderViewSlice* slice,
-                                                   const SkRect& rect) {
+AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(
+    GrDirectContext* context,
+    const std::vector<std::pair<EmbedderViewSlice*, SkRect>>& slices,
+    const SkRect& rect) {
   std::shared_ptr<OverlayLayer> layer = surface_pool_->GetLayer(
       context, android_context_, jni_facade_, surface_factory_);
 
@@ -194,18 +268,26 @@ AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
       layer->surface->AcquireFrame(frame_size_);
   // Display the overlay surface. If it's already displayed, then it's
   // just positioned and sized.
-  jni_facade_->FlutterViewDisplayOverlaySurface(layer->id,     //
-                                                rect.x(),      //
-                                                rect.y(),      //
-                                                rect.width(),  //
-                                                rect.height()  //
-  );
+  RunOnPlatformThread([jni_facade = jni_facade_, id = layer->id, rect]() {
+    jni_facade->FlutterViewDisplayOverlaySurface(id,            //
+                                                 rect.x(),      //
+                                                 rect.y(),      //
+                                                 rect.width(),  //
+                                                 rect.height()  //
+    );
+  });
   DlCanvas* overlay_canvas = frame->Canvas();
   overlay_canvas->Clear(DlColor::kTransparent());
   // Offset the picture since its absolute position on the scene is determined
   // by the position of the overlay view.
   overlay_canvas->Translate(-rect.x(), -rect.y());
-  slice->render_into(overlay_canvas);
+  for (const auto& [slice, slice_rect] : slices) {
+    // The rest of the slice is drawn in the background, below the platform
+    // views.
+    DlAutoCanvasRestore save(overlay_canvas, /*doSave=*/true);
+    overlay_canvas->ClipRect(slice_rect);
+    slice->render_into(overlay_canvas);
+  }
   return frame;
 }
 
@@ -241,6 +323,47 @@ bool AndroidExternalViewEmbedder::FrameHasPlatformLayers() {
   return !composition_order_.empty();
 }
 
+void AndroidExternalViewEmbedder::RunOnPlatformThread(fml::closure task) {
+  if (use_thread_merging_) {
+    task();
+  } else {
+    platform_transaction_.push_back(std::move(task));
+  }
+}
+
+void AndroidExternalViewEmbedder::SubmitPlatformTransaction() {
+  // The frame that follows the last frame with platform views still needs
+  // a transaction to remove them.
+  if (!FrameHasPlatformLayers() && previous_frame_view_count_ == 0) {
+    return;
+  }
+  TRACE_EVENT0("flutter",
+               "AndroidExternalViewEmbedder::SubmitPlatformTransaction");
+  task_runners_.GetPlatformTaskRunner()->PostTask(
+      [jni_facade = jni_facade_, surface_pool = surface_pool_,
+       frame_size = frame_size_, transaction = std::move(platform_transaction_),
+       overlay_surface_count = missing_overlay_surface_count_,
+       schedule_frame = needs_redraw_ ? schedule_frame_ : fml::closure()]() {
+        TRACE_EVENT0("flutter",
+                     "AndroidExternalViewEmbedder::PlatformTransaction");
+        jni_facade->FlutterViewBeginFrame();
+        for (const fml::closure& task : transaction) {
+          task();
+        }
+        for (size_t i = 0; i < overlay_surface_count; i++) {
+          surface_pool->AddOverlaySurface(
+              frame_size, jni_facade->FlutterViewCreateOverlaySurface());
+        }
+        jni_facade->FlutterViewEndFrame();
+        if (schedule_frame) {
+          schedule_frame();
+        }
+      });
+  platform_transaction_.clear();
+  missing_overlay_surface_count_ = 0;
+  needs_redraw_ = false;
+}
+
 // |ExternalViewEmbedder|
 DlCanvas* AndroidExternalViewEmbedder::GetRootCanvas() {
   // On Android, the root surface is created from the on-screen render target.
@@ -252,6 +375,9 @@ void AndroidExternalViewEmbedder::Reset() {
 
   composition_order_.clear();
   slices_.clear();
+  platform_transaction_.clear();
+  missing_overlay_surface_count_ = 0;
+  needs_redraw_ = false;
 }
 
 // |ExternalViewEmbedder|
@@ -268,8 +394,9 @@ void AndroidExternalViewEmbedder::BeginFrame(
     DestroySurfaces();
   }
   surface_pool_->SetFrameSize(frame_size);
-  // JNI method must be called on the platform thread.
-  if (raster_thread_merger->IsOnPlatformThread()) {
+  // JNI method must be called on the platform thread. Without a thread
+  // merger, it is called by the platform transaction of the frame.
+  if (raster_thread_merger && raster_thread_merger->IsOnPlatformThread()) {
     jni_facade_->FlutterViewBeginFrame();
   }
 
@@ -287,6 +414,10 @@ void AndroidExternalViewEmbedder::EndFrame(
     bool should_resubmit_frame,
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger) {
   surface_pool_->RecycleLayers();
+  if (!use_thread_merging_) {
+    SubmitPlatformTransaction();
+    return;
+  }
   // JNI method must be called on the platform thread.
   if (raster_thread_merger->IsOnPlatformThread()) {
     jni_facade_->FlutterViewEndFrame();
@@ -295,7 +426,7 @@ void AndroidExternalViewEmbedder::EndFrame(
 
 // |ExternalViewEmbedder|
 bool AndroidExternalViewEmbedder::SupportsDynamicThreadMerging() {
-  return true;
+  return use_thread_merging_;
 }
 
 // |ExternalViewEmbedder|
@@ -305,6 +436,19 @@ void AndroidExternalViewEmbedder::Teardown() {
 
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::DestroySurfaces() {
+  if (!use_thread_merging_) {
+    // The layers are released here, on the raster thread where their
+    // surfaces are used, and only the removal of their Android views is
+    // handed off to the platform thread, so the raster thread never waits
+    // for the platform thread.
+    if (surface_pool_->ReleaseLayers()) {
+      task_runners_.GetPlatformTaskRunner()->PostTask(
+          [jni_facade = jni_facade_]() {
+            jni_facade->FlutterViewDestroyOverlaySurfaces();
+          });
+    }
+    return;
+  }
   if (!surface_pool_->HasLayers()) {
     return;
   }
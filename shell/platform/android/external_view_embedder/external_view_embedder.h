@@ -6,10 +6,13 @@
 #define FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_H_
 
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/rtree.h"
+#include "flutter/fml/closure.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/external_view_embedder/surface_pool.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
@@ -28,13 +31,22 @@ namespace flutter {
 /// that render above (by Z order) the Android view corresponding to
 /// |flutter::PlatformViewLayer|.
 ///
+/// By default, the raster thread is merged into the platform thread while
+/// platform views are on screen so that the JNI calls can be made while
+/// the frame is rasterized. When constructed with `use_thread_merging`
+/// set to false, the frames are rasterized and the overlay surfaces are
+/// submitted on the raster thread instead, and the JNI calls of each frame
+/// are handed off to the platform thread as a single transaction.
+///
 class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
  public:
   AndroidExternalViewEmbedder(
       const AndroidContext& android_context,
       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
       std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-      const TaskRunners& task_runners);
+      const TaskRunners& task_runners,
+      bool use_thread_merging = true,
+      fml::closure schedule_frame = nullptr);
 
   // |ExternalViewEmbedder|
   void PrerollCompositeEmbeddedView(
@@ -96,11 +108,33 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   const std::shared_ptr<AndroidSurfaceFactory> surface_factory_;
 
   // Holds surfaces. Allows to recycle surfaces or allocate new ones.
-  const std::unique_ptr<SurfacePool> surface_pool_;
+  const std::shared_ptr<SurfacePool> surface_pool_;
 
   // The task runners.
   const TaskRunners task_runners_;
 
+  // Whether the raster thread is merged into the platform thread while
+  // platform views are displayed.
+  const bool use_thread_merging_;
+
+  // Called on the platform thread to request a new frame when a frame was
+  // dropped because the platform views weren't ready to compose it. Only
+  // used when the threads aren't merged.
+  const fml::closure schedule_frame_;
+
+  // The JNI calls of the current frame, which are run by a single task on
+  // the platform thread at the end of the frame when the threads aren't
+  // merged.
+  std::vector<fml::closure> platform_transaction_;
+
+  // The number of overlay surfaces that the platform transaction of the
+  // current frame needs to create for the next frames.
+  size_t missing_overlay_surface_count_ = 0;
+
+  // Whether the current frame was dropped and must be drawn again once its
+  // platform transaction has run.
+  bool needs_redraw_ = false;
+
   // The size of the root canvas.
   SkISize frame_size_;
 
@@ -135,12 +169,22 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // Whether the layer tree in the current frame has platform layers.
   bool FrameHasPlatformLayers();
 
+  // Runs |task| right away when the threads are merged, as the raster
+  // tasks then already run on the platform thread. Otherwise, adds it to
+  // the platform transaction of the current frame.
+  void RunOnPlatformThread(fml::closure task);
+
+  // Posts the platform transaction of the current frame to the platform
+  // thread. Only used when the threads aren't merged.
+  void SubmitPlatformTransaction();
+
   // Creates a Surface when needed or recycles an existing one.
-  // Finally, draws the picture on the frame's canvas.
-  std::unique_ptr<SurfaceFrame> CreateSurfaceIfNeeded(GrDirectContext* context,
-                                                      int64_t view_id,
-                                                      EmbedderViewSlice* slice,
-                                                      const SkRect& rect);
+  // Finally, draws each slice, clipped to its overlay rect, on the frame's
+  // canvas.
+  std::unique_ptr<SurfaceFrame> CreateSurfaceIfNeeded(
+      GrDirectContext* context,
+      const std::vector<std::pair<EmbedderViewSlice*, SkRect>>& slices,
+      const SkRect& rect);
 };
 
 }  // namespace flutter
@@ -561,6 +561,101 @@ TEST(AndroidExternalViewEmbedder, OverlayCoverTwoPlatformViews) {
   embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
 }
 
+TEST(AndroidExternalViewEmbedder, MergesOverlaysOfDisjointPlatformViews) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(nullptr);
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto frame_size = SkISize::Make(1000, 1000);
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  auto surface_factory = std::make_shared<TestAndroidSurfaceFactory>(
+      [&android_context, gr_context, window, frame_size, framebuffer_info]() {
+        auto surface_frame_1 = std::make_unique<SurfaceFrame>(
+            SkSurface::MakeNull(1000, 1000), framebuffer_info,
+            [](const SurfaceFrame& surface_frame, DlCanvas* canvas) {
+              return true;
+            },
+            /*frame_size=*/SkISize::Make(800, 600));
+
+        auto surface_mock = std::make_unique<SurfaceMock>();
+        EXPECT_CALL(*surface_mock, AcquireFrame(frame_size))
+            .Times(1 /* frames */)
+            .WillOnce(Return(ByMove(std::move(surface_frame_1))));
+
+        auto android_surface_mock =
+            std::make_unique<AndroidSurfaceMock>(android_context);
+        EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
+
+        EXPECT_CALL(*android_surface_mock, CreateGPUSurface(gr_context.get()))
+            .WillOnce(Return(ByMove(std::move(surface_mock))));
+
+        EXPECT_CALL(*android_surface_mock, SetNativeWindow(window));
+        return android_surface_mock;
+      });
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      *android_context, jni_mock, surface_factory, GetTaskRunnersForFixture());
+
+  auto raster_thread_merger = GetThreadMergerFromPlatformThread();
+
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
+  embedder->BeginFrame(frame_size, nullptr, 1.5, raster_thread_merger);
+
+  auto rect_paint = DlPaint();
+  rect_paint.setColor(DlColor::kCyan());
+  rect_paint.setDrawStyle(DlDrawStyle::kFill);
+
+  {
+    // Add first Android view.
+    SkMatrix matrix = SkMatrix::Translate(100, 100);
+    MutatorsStack stack;
+    embedder->PrerollCompositeEmbeddedView(
+        0, std::make_unique<EmbeddedViewParams>(matrix, SkSize::Make(100, 100),
+                                                stack));
+    EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(
+                               0, 100, 100, 100, 100, 150, 150, stack));
+  }
+  // This simulates Flutter UI that intersects with the first Android view.
+  embedder->CompositeEmbeddedView(0)->DrawRect(
+      SkRect::MakeXYWH(150, 150, 20, 20), rect_paint);
+
+  {
+    // Add second Android view, which doesn't intersect the first one.
+    SkMatrix matrix = SkMatrix::Translate(300, 100);
+    MutatorsStack stack;
+    embedder->PrerollCompositeEmbeddedView(
+        1, std::make_unique<EmbeddedViewParams>(matrix, SkSize::Make(100, 100),
+                                                stack));
+    EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(
+                               1, 300, 100, 100, 100, 150, 150, stack));
+  }
+  // This simulates Flutter UI that intersects with the second Android view.
+  embedder->CompositeEmbeddedView(1)->DrawRect(
+      SkRect::MakeXYWH(350, 150, 20, 20), rect_paint);
+
+  // Both overlays are drawn in a single overlay surface.
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+      .WillOnce(Return(
+          ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+              0, window))));
+  EXPECT_CALL(*jni_mock,
+              FlutterViewDisplayOverlaySurface(0, 150, 150, 220, 20))
+      .Times(1);
+
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      SkSurface::MakeNull(1000, 1000), framebuffer_info,
+      [](const SurfaceFrame& surface_frame, DlCanvas* canvas) mutable {
+        return true;
+      },
+      /*frame_size=*/SkISize::Make(800, 600));
+
+  embedder->SubmitFrame(gr_context.get(), std::move(surface_frame));
+
+  EXPECT_CALL(*jni_mock, FlutterViewEndFrame());
+  embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
+}
+
 TEST(AndroidExternalViewEmbedder, SubmitFrameOverlayComposition) {
   auto jni_mock = std::make_shared<JNIMock>();
   auto android_context =
@@ -940,6 +1035,155 @@ TEST(AndroidExternalViewEmbedder, SupportsDynamicThreadMerging) {
   ASSERT_TRUE(embedder->SupportsDynamicThreadMerging());
 }
 
+TEST(AndroidExternalViewEmbedder, SupportsDynamicThreadMergingCanBeDisabled) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, GetTaskRunnersForFixture(),
+      /*use_thread_merging=*/false);
+  ASSERT_FALSE(embedder->SupportsDynamicThreadMerging());
+}
+
+TEST(AndroidExternalViewEmbedder, UnmergedFrameSubmitsOnePlatformTransaction) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto frame_size = SkISize::Make(1000, 1000);
+  size_t scheduled_frame_count = 0;
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      android_context, jni_mock, nullptr, GetTaskRunnersForFixture(),
+      /*use_thread_merging=*/false,
+      [&scheduled_frame_count]() { scheduled_frame_count++; });
+
+  MutatorsStack stack;
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  for (size_t frame = 0; frame < 2; frame++) {
+    embedder->BeginFrame(frame_size, nullptr, 1.5, nullptr);
+    embedder->PrerollCompositeEmbeddedView(
+        0, std::make_unique<EmbeddedViewParams>(SkMatrix(),
+                                                SkSize::Make(200, 200), stack));
+
+    bool submitted = false;
+    auto surface_frame = std::make_unique<SurfaceFrame>(
+        SkSurface::MakeNull(1000, 1000), framebuffer_info,
+        [&submitted](const SurfaceFrame& surface_frame, DlCanvas* canvas) {
+          submitted = true;
+          return true;
+        },
+        /*frame_size=*/SkISize::Make(800, 600));
+
+    // The JNI methods are only called by the platform transaction.
+    EXPECT_CALL(*jni_mock, FlutterViewBeginFrame()).Times(0);
+    EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView).Times(0);
+    EXPECT_CALL(*jni_mock, FlutterViewEndFrame()).Times(0);
+    embedder->SubmitFrame(gr_context.get(), std::move(surface_frame));
+    embedder->EndFrame(/*should_resubmit_frame=*/false, nullptr);
+    ::testing::Mock::VerifyAndClearExpectations(jni_mock.get());
+
+    // The first frame switches the surfaces, so it is dropped and drawn
+    // again once the transaction has run.
+    ASSERT_EQ(submitted, frame > 0);
+
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
+    EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(0, 0, 0, 200, 200,
+                                                            300, 300, stack));
+    EXPECT_CALL(*jni_mock, FlutterViewEndFrame());
+    fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+    ::testing::Mock::VerifyAndClearExpectations(jni_mock.get());
+    ASSERT_EQ(scheduled_frame_count, 1u);
+  }
+}
+
+TEST(AndroidExternalViewEmbedder,
+     UnmergedFrameCreatesOverlaySurfacesOnPlatformThread) {
+  auto jni_mock = std::make_shared<JNIMock>();
+
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+  auto window = fml::MakeRefCounted<AndroidNativeWindow>(nullptr);
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto frame_size = SkISize::Make(1000, 1000);
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  auto surface_factory = std::make_shared<TestAndroidSurfaceFactory>(
+      [&android_context, gr_context, window, frame_size, framebuffer_info]() {
+        auto surface_frame_1 = std::make_unique<SurfaceFrame>(
+            SkSurface::MakeNull(1000, 1000), framebuffer_info,
+            [](const SurfaceFrame& surface_frame, DlCanvas* canvas) {
+              return true;
+            },
+            /*frame_size=*/SkISize::Make(800, 600));
+
+        auto surface_mock = std::make_unique<SurfaceMock>();
+        EXPECT_CALL(*surface_mock, AcquireFrame(frame_size))
+            .WillOnce(Return(ByMove(std::move(surface_frame_1))));
+
+        auto android_surface_mock =
+            std::make_unique<AndroidSurfaceMock>(android_context);
+        EXPECT_CALL(*android_surface_mock, IsValid()).WillOnce(Return(true));
+
+        EXPECT_CALL(*android_surface_mock, CreateGPUSurface(gr_context.get()))
+            .WillOnce(Return(ByMove(std::move(surface_mock))));
+
+        EXPECT_CALL(*android_surface_mock, SetNativeWindow(window));
+
+        return android_surface_mock;
+      });
+  size_t scheduled_frame_count = 0;
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      *android_context, jni_mock, surface_factory, GetTaskRunnersForFixture(),
+      /*use_thread_merging=*/false,
+      [&scheduled_frame_count]() { scheduled_frame_count++; });
+
+  MutatorsStack stack;
+  for (size_t frame = 0; frame < 2; frame++) {
+    embedder->BeginFrame(frame_size, nullptr, 1.5, nullptr);
+    embedder->PrerollCompositeEmbeddedView(
+        0, std::make_unique<EmbeddedViewParams>(SkMatrix(),
+                                                SkSize::Make(200, 200), stack));
+    // This simulates Flutter UI that intersects with the Android view.
+    embedder->CompositeEmbeddedView(0)->DrawRect(
+        SkRect::MakeXYWH(50, 50, 200, 200), DlPaint());
+
+    bool submitted = false;
+    auto surface_frame = std::make_unique<SurfaceFrame>(
+        SkSurface::MakeNull(1000, 1000), framebuffer_info,
+        [&submitted](const SurfaceFrame& surface_frame, DlCanvas* canvas) {
+          submitted = true;
+          return true;
+        },
+        /*frame_size=*/SkISize::Make(800, 600));
+
+    // The overlay surface is never created on the raster thread.
+    EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface()).Times(0);
+    EXPECT_CALL(*jni_mock, FlutterViewDisplayOverlaySurface).Times(0);
+    embedder->SubmitFrame(gr_context.get(), std::move(surface_frame));
+    embedder->EndFrame(/*should_resubmit_frame=*/false, nullptr);
+    ::testing::Mock::VerifyAndClearExpectations(jni_mock.get());
+    ASSERT_EQ(submitted, frame > 0);
+
+    ::testing::InSequence sequence;
+    EXPECT_CALL(*jni_mock, FlutterViewBeginFrame());
+    EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(0, 0, 0, 200, 200,
+                                                            300, 300, stack));
+    if (frame == 0) {
+      // The first frame is missing its overlay surface, so the transaction
+      // creates it and schedules a new frame.
+      EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface())
+          .WillOnce(Return(
+              ByMove(std::make_unique<PlatformViewAndroidJNI::OverlayMetadata>(
+                  0, window))));
+    } else {
+      EXPECT_CALL(*jni_mock,
+                  FlutterViewDisplayOverlaySurface(0, 50, 50, 150, 150));
+    }
+    EXPECT_CALL(*jni_mock, FlutterViewEndFrame());
+    fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+    ::testing::Mock::VerifyAndClearExpectations(jni_mock.get());
+    ASSERT_EQ(scheduled_frame_count, 1u);
+  }
+}
+
 TEST(AndroidExternalViewEmbedder, DisableThreadMerger) {
   auto jni_mock = std::make_shared<JNIMock>();
   auto android_context = AndroidContext(AndroidRenderingAPI::kSoftware);
@@ -41,8 +41,13 @@ std::shared_ptr<OverlayLayer> SurfacePool::GetLayer(
         << "Could not create an OpenGL, Vulkan or Software surface to set up "
            "rendering.";
 
-    std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> java_metadata =
-        jni_facade->FlutterViewCreateOverlaySurface();
+    std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> java_metadata;
+    if (overlay_surfaces_.empty()) {
+      java_metadata = jni_facade->FlutterViewCreateOverlaySurface();
+    } else {
+      java_metadata = std::move(overlay_surfaces_.back());
+      overlay_surfaces_.pop_back();
+    }
 
     FML_CHECK(java_metadata->window);
     android_surface->SetNativeWindow(java_metadata->window);
@@ -98,9 +103,39 @@ void SurfacePool::DestroyLayersLocked(
   }
   jni_facade->FlutterViewDestroyOverlaySurfaces();
   layers_.clear();
+  overlay_surfaces_.clear();
   available_layer_index_ = 0;
 }
 
+void SurfacePool::AddOverlaySurface(
+    SkISize frame_size,
+    std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> metadata) {
+  std::lock_guard lock(mutex_);
+  if (frame_size != requested_frame_size_ || !metadata) {
+    return;
+  }
+  overlay_surfaces_.push_back(std::move(metadata));
+}
+
+size_t SurfacePool::GetAvailableLayerCount() {
+  std::lock_guard lock(mutex_);
+  if (requested_frame_size_ != current_frame_size_) {
+    // |GetLayer| destroys the layers of the previous frame size, and with
+    // them any of the overlay surfaces.
+    return layers_.empty() ? overlay_surfaces_.size() : 0;
+  }
+  return layers_.size() - available_layer_index_ + overlay_surfaces_.size();
+}
+
+bool SurfacePool::ReleaseLayers() {
+  std::lock_guard lock(mutex_);
+  bool had_layers = !layers_.empty() || !overlay_surfaces_.empty();
+  layers_.clear();
+  overlay_surfaces_.clear();
+  available_layer_index_ = 0;
+  return had_layers;
+}
+
 std::vector<std::shared_ptr<OverlayLayer>> SurfacePool::GetUnusedLayers() {
   std::lock_guard lock(mutex_);
   std::vector<std::shared_ptr<OverlayLayer>> results;
@@ -76,6 +76,23 @@ class SurfacePool {
   // Returns true if the current pool has layers in use.
   bool HasLayers();
 
+  // Adds an overlay surface that was created on the platform thread for a
+  // frame of size |frame_size|, so that |GetLayer| can use it instead of
+  // creating one. The surface is dropped if the frame size has changed
+  // since.
+  void AddOverlaySurface(
+      SkISize frame_size,
+      std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata> metadata);
+
+  // The number of layers that |GetLayer| can return for the current frame
+  // without creating a new overlay surface.
+  size_t GetAvailableLayerCount();
+
+  // Drops the layers in the pool and the overlay surfaces added with
+  // |AddOverlaySurface|, without destroying their Android views. Returns
+  // true if there was any.
+  bool ReleaseLayers();
+
  private:
   // The index of the entry in the layers_ vector that determines the beginning
   // of the unused layers. For example, consider the following vector:
@@ -94,6 +111,11 @@ class SurfacePool {
   // The layers in the pool.
   std::vector<std::shared_ptr<OverlayLayer>> layers_;
 
+  // The overlay surfaces created on the platform thread that no layer uses
+  // yet.
+  std::vector<std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata>>
+      overlay_surfaces_;
+
   // The frame size of the layers in the pool.
   SkISize current_frame_size_;
 
@@ -33,6 +33,7 @@ import io.flutter.plugin.platform.PlatformViewsController;
 import io.flutter.util.Preconditions;
 import io.flutter.view.AccessibilityBridge;
 import io.flutter.view.FlutterCallbackInformation;
+import io.flutter.view.TextureRegistry;
 import java.io.IOException;
 import java.lang.ref.WeakReference;
 import java.nio.ByteBuffer;
@@ -521,17 +522,53 @@ public class FlutterJNI {
   public static native void nativeImageHeaderCallback(
       long imageGeneratorPointer, int width, int height);
 
+  /** Thrown from the header listener to stop the decoding once the header is decoded. */
+  private static class ImageHeaderDecodedException extends RuntimeException {}
+
+  /**
+   * Called by native to decode the header of an image, which reports its size to {@code
+   * nativeImageHeaderCallback}. The pixels are decoded later by {@link #decodeImage}. Unlike most
+   * other methods called from native, this method is expected to be called on a worker thread,
+   * since it only uses thread safe methods.
+   *
+   * @return whether the header was decoded.
+   */
+  @SuppressWarnings("unused")
+  @VisibleForTesting
+  public static boolean decodeImageHeader(@NonNull ByteBuffer buffer, long imageGeneratorAddress) {
+    if (Build.VERSION.SDK_INT >= 28) {
+      ImageDecoder.Source source = ImageDecoder.createSource(buffer);
+      try {
+        ImageDecoder.decodeBitmap(
+            source,
+            (decoder, info, src) -> {
+              Size size = info.getSize();
+              nativeImageHeaderCallback(imageGeneratorAddress, size.getWidth(), size.getHeight());
+              throw new ImageHeaderDecodedException();
+            });
+      } catch (ImageHeaderDecodedException e) {
+        return true;
+      } catch (IOException e) {
+        Log.e(TAG, "Failed to decode image header", e);
+      }
+    }
+    return false;
+  }
+
   /**
-   * Called by native as a fallback method of image decoding. There are other ways to decode images
-   * on lower API levels, they involve copying the native data _and_ do not support any additional
-   * formats, whereas ImageDecoder supports HEIF images. Unlike most other methods called from
-   * native, this method is expected to be called on a worker thread, since it only uses thread safe
-   * methods and may take multiple frames to complete.
+   * Called by native as a fallback method of image decoding, or in preference to the builtin
+   * decoders when they are asked to use the hardware decoders of the device. There are other ways
+   * to decode images on lower API levels, they involve copying the native data _and_ do not
+   * support any additional formats, whereas ImageDecoder supports HEIF images. The image is
+   * decoded straight at the given size, which the decoder samples the image down to while decoding
+   * it. Unlike most other methods called from native, this method is expected to be called on a
+   * worker thread, since it only uses thread safe methods and may take multiple frames to
+   * complete.
    */
   @SuppressWarnings("unused")
   @VisibleForTesting
   @Nullable
-  public static Bitmap decodeImage(@NonNull ByteBuffer buffer, long imageGeneratorAddress) {
+  public static Bitmap decodeImage(@NonNull ByteBuffer buffer, int targetWidth, int targetHeight) {
     if (Build.VERSION.SDK_INT >= 28) {
       ImageDecoder.Source source = ImageDecoder.createSource(buffer);
       try {
@@ -545,9 +582,7 @@ public class FlutterJNI {
               // `SkImage::MakeFromAHardwareBuffer` via dynamic lookups:
               // https://skia-review.googlesource.com/c/skia/+/428960
               decoder.setAllocator(ImageDecoder.ALLOCATOR_SOFTWARE);
-
-              Size size = info.getSize();
-              nativeImageHeaderCallback(imageGeneratorAddress, size.getWidth(), size.getHeight());
+              decoder.setTargetSize(targetWidth, targetHeight);
             });
       } catch (IOException e) {
         Log.e(TAG, "Failed to decode image", e);
@@ -885,6 +920,26 @@ public class FlutterJNI {
       long textureId,
       @NonNull WeakReference<SurfaceTextureWrapper> textureWrapper);
 
+  /**
+   * Gives control of an image texture to Flutter so that Flutter can display the images pushed to
+   * it within Flutter's UI.
+   */
+  @UiThread
+  public void registerImageTexture(
+      long textureId, @NonNull TextureRegistry.ImageConsumer imageTexture) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativeRegisterImageTexture(
+        nativeShellHolderId,
+        textureId,
+        new WeakReference<TextureRegistry.ImageConsumer>(imageTexture));
+  }
+
+  private native void nativeRegisterImageTexture(
+      long nativeShellHolderId,
+      long textureId,
+      @NonNull WeakReference<TextureRegistry.ImageConsumer> imageTexture);
+
   /**
    * Call this method to inform Flutter that a texture previously registered with {@link
    * #registerTexture(long, SurfaceTextureWrapper)} has a new frame available.
@@ -1329,6 +1384,31 @@ public class FlutterJNI {
   private native void nativeLoadDartDeferredLibrary(
       long nativeShellHolderId, int loadingUnitId, @NonNull String[] searchPaths);
 
+  /**
+   * Searches each of the provided paths for a valid Dart shared library .so file and hands it to
+   * the engine ahead of the Dart VM requesting it.
+   *
+   * <p>This is a hint that the Dart deferred library is likely to be loaded soon, for example
+   * because the user is about to navigate to a route that uses it. The engine reads the library
+   * into memory off the main thread, and when loadLibrary() is later called on the Dart deferred
+   * library, the returned future completes without calling {@link #requestDartDeferredLibrary}.
+   * The deferred component containing the library must already be installed.
+   *
+   * @param loadingUnitId The loadingUnitId assigned by gen_snapshot to the Dart deferred library
+   *     that is likely to be loaded.
+   * @param searchPaths An array of paths in which to look for valid dart shared libraries, in the
+   *     same format as for {@link #loadDartDeferredLibrary}.
+   */
+  @UiThread
+  public void prefetchDartDeferredLibrary(int loadingUnitId, @NonNull String[] searchPaths) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativePrefetchDartDeferredLibrary(nativeShellHolderId, loadingUnitId, searchPaths);
+  }
+
+  private native void nativePrefetchDartDeferredLibrary(
+      long nativeShellHolderId, int loadingUnitId, @NonNull String[] searchPaths);
+
   /**
    * Adds the specified AssetManager as an APKAssetResolver in the Flutter Engine's AssetManager.
    *
@@ -1426,6 +1506,20 @@ public class FlutterJNI {
 
   private native void nativeNotifyLowMemoryWarning(long nativeShellHolderId);
 
+  /**
+   * Notifies the engine of a memory trim level delivered to {@link
+   * android.content.ComponentCallbacks2#onTrimMemory(int)}, so that it trims its caches to what
+   * they may keep at that level.
+   */
+  @UiThread
+  public void notifyMemoryPressure(int level) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativeNotifyMemoryPressure(nativeShellHolderId, level);
+  }
+
+  private native void nativeNotifyMemoryPressure(long nativeShellHolderId, int level);
+
   private void ensureRunningOnMainThread() {
     if (Looper.myLooper() != mainLooper) {
       throw new RuntimeException(
@@ -7,6 +7,7 @@ package io.flutter.embedding.engine.renderer;
 import android.graphics.Bitmap;
 import android.graphics.Rect;
 import android.graphics.SurfaceTexture;
+import android.media.Image;
 import android.os.Build;
 import android.os.Handler;
 import android.view.Surface;
@@ -158,8 +159,25 @@ public class FlutterRenderer implements TextureRegistry {
     return entry;
   }
 
+  /**
+   * Creates and returns a texture that displays the {@link Image}s pushed to it, and makes it
+   * available to Flutter code.
+   */
+  @Override
+  @NonNull
+  public ImageTextureEntry createImageTexture() {
+    final ImageTextureRegistryEntry entry =
+        new ImageTextureRegistryEntry(nextTextureId.getAndIncrement());
+    Log.v(TAG, "New ImageTextureEntry ID: " + entry.id());
+    registerImageTexture(entry.id(), entry);
+    return entry;
+  }
+
   @Override
   public void onTrimMemory(int level) {
+    if (flutterJNI.isAttached()) {
+      flutterJNI.notifyMemoryPressure(level);
+    }
     final Iterator<WeakReference<OnTrimMemoryListener>> iterator = onTrimMemoryListeners.iterator();
     while (iterator.hasNext()) {
       WeakReference<OnTrimMemoryListener> listenerRef = iterator.next();
@@ -287,6 +305,90 @@ public class FlutterRenderer implements TextureRegistry {
     }
   }
 
+  final class ImageTextureRegistryEntry
+      implements TextureRegistry.ImageTextureEntry, TextureRegistry.ImageConsumer {
+    private final long id;
+    private boolean released;
+    @Nullable private Image image;
+
+    ImageTextureRegistryEntry(long id) {
+      this.id = id;
+    }
+
+    @Override
+    public long id() {
+      return id;
+    }
+
+    @Override
+    public void release() {
+      if (released) {
+        return;
+      }
+      released = true;
+      Log.v(TAG, "Releasing an ImageTexture (" + id + ").");
+      final Image toClose;
+      synchronized (this) {
+        toClose = image;
+        image = null;
+      }
+      if (toClose != null) {
+        toClose.close();
+      }
+      unregisterTexture(id);
+    }
+
+    @Override
+    public void pushImage(@Nullable Image image) {
+      if (released) {
+        if (image != null) {
+          image.close();
+        }
+        return;
+      }
+      final Image toClose;
+      synchronized (this) {
+        toClose = this.image;
+        this.image = image;
+      }
+      // The previous image was never acquired, so the engine doesn't hold it.
+      if (toClose != null) {
+        toClose.close();
+      }
+      if (image != null) {
+        markTextureFrameAvailable(id);
+      }
+    }
+
+    @Override
+    @Nullable
+    public Image acquireLatestImage() {
+      synchronized (this) {
+        final Image latest = image;
+        image = null;
+        return latest;
+      }
+    }
+
+    @Override
+    protected void finalize() throws Throwable {
+      try {
+        if (released) {
+          return;
+        }
+        synchronized (this) {
+          if (image != null) {
+            image.close();
+            image = null;
+          }
+        }
+        handler.post(new SurfaceTextureFinalizerRunnable(id, flutterJNI));
+      } finally {
+        super.finalize();
+      }
+    }
+  }
+
   static final class SurfaceTextureFinalizerRunnable implements Runnable {
     private final long id;
     private final FlutterJNI flutterJNI;
@@ -488,6 +590,11 @@ public class FlutterRenderer implements TextureRegistry {
     flutterJNI.registerTexture(textureId, textureWrapper);
   }
 
+  private void registerImageTexture(
+      long textureId, @NonNull TextureRegistry.ImageConsumer imageTexture) {
+    flutterJNI.registerImageTexture(textureId, imageTexture);
+  }
+
   // TODO(mattcarroll): describe the native behavior that this invokes
   private void markTextureFrameAvailable(long textureId) {
     flutterJNI.markTextureFrameAvailable(textureId);
@@ -5,6 +5,8 @@
 package io.flutter.view;
 
 import android.graphics.SurfaceTexture;
+import android.media.Image;
+import androidx.annotation.Keep;
 import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
 
@@ -31,6 +33,20 @@ public interface TextureRegistry {
   @NonNull
   SurfaceTextureEntry registerSurfaceTexture(@NonNull SurfaceTexture surfaceTexture);
 
+  /**
+   * Creates and registers a texture that displays the {@link Image}s pushed to it, such as the
+   * frames an {@link android.media.ImageReader} receives from a video decoder or a camera.
+   *
+   * <p>With Impeller on Vulkan, the hardware buffers backing the images are sampled without
+   * copies. Other renderers don't support image textures yet.
+   *
+   * @return An ImageTextureEntry.
+   */
+  @NonNull
+  default ImageTextureEntry createImageTexture() {
+    throw new UnsupportedOperationException("Image textures are not supported by this registry.");
+  }
+
   /**
    * Callback invoked when memory is low.
    *
@@ -57,6 +73,39 @@ public interface TextureRegistry {
     default void setOnTrimMemoryListener(@Nullable OnTrimMemoryListener listener) {}
   }
 
+  /** A registry entry for a texture that displays the images pushed to it. */
+  interface ImageTextureEntry {
+    /** @return The identity of this texture. */
+    long id();
+
+    /** Deregisters and releases this texture, closing the image it holds, if any. */
+    void release();
+
+    /**
+     * Pushes the next image to display. Must be called on the main thread.
+     *
+     * <p>The texture takes ownership of the image and closes it once it is no longer displayed. An
+     * image that is replaced before Flutter acquired it is closed right away, so producers never
+     * run out of buffers when Flutter renders less often than they produce frames.
+     *
+     * @param image The image, which must be backed by a {@link android.hardware.HardwareBuffer}.
+     */
+    void pushImage(@Nullable Image image);
+  }
+
+  /** Hands the images pushed to an image texture to the engine. */
+  @Keep
+  interface ImageConsumer {
+    /**
+     * Retrieves the most recently pushed image. Called by the engine on the raster thread.
+     *
+     * @return The image, owned by the caller from then on, or null if none was pushed since the
+     *     last call.
+     */
+    @Nullable
+    Image acquireLatestImage();
+  }
+
   /** Listener invoked when the most recent image has been consumed. */
   interface OnFrameConsumedListener {
     /**
@@ -64,6 +64,23 @@ class JNIMock final : public PlatformViewAndroidJNI {
               (JavaLocalRef surface_texture),
               (override));
 
+  MOCK_METHOD(JavaLocalRef,
+              ImageConsumerTextureRegistryAcquireLatestImage,
+              (JavaLocalRef image_consumer),
+              (override));
+
+  MOCK_METHOD(JavaLocalRef,
+              ImageGetHardwareBuffer,
+              (JavaLocalRef image),
+              (override));
+
+  MOCK_METHOD(void, ImageClose, (JavaLocalRef image), (override));
+
+  MOCK_METHOD(void,
+              HardwareBufferClose,
+              (JavaLocalRef hardware_buffer),
+              (override));
+
   MOCK_METHOD(void,
               FlutterViewOnDisplayPlatformView,
               (int view_id,
@@ -109,6 +109,36 @@ class PlatformViewAndroidJNI {
   virtual void SurfaceTextureDetachFromGLContext(
       JavaLocalRef surface_texture) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Acquires the most recent image pushed to an image texture.
+  ///             The caller must close the image.
+  ///
+  /// @return     The `android.media.Image`, or null if no image was pushed
+  ///             since the last one was acquired.
+  ///
+  virtual JavaLocalRef ImageConsumerTextureRegistryAcquireLatestImage(
+      JavaLocalRef image_consumer) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the hardware buffer backing an `android.media.Image`.
+  ///             The caller must close the hardware buffer.
+  ///
+  /// @return     The `android.hardware.HardwareBuffer`, or null if the image
+  ///             isn't backed by one or the API level is below 28.
+  ///
+  virtual JavaLocalRef ImageGetHardwareBuffer(JavaLocalRef image) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Closes an `android.media.Image`, which gives its buffer back
+  ///             to the producer.
+  ///
+  virtual void ImageClose(JavaLocalRef image) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Closes an `android.hardware.HardwareBuffer`.
+  ///
+  virtual void HardwareBufferClose(JavaLocalRef hardware_buffer) = 0;
+
   //----------------------------------------------------------------------------
   /// @brief      Positions and sizes a platform view if using hybrid
   ///             composition.
@@ -12,6 +12,7 @@
 #include "flutter/shell/gpu/gpu_surface_gl_delegate.h"
 #include "flutter/shell/platform/android/android_context_gl_impeller.h"
 #include "flutter/shell/platform/android/android_context_gl_skia.h"
+#include "flutter/shell/platform/android/android_external_image_texture_vk.h"
 #include "flutter/shell/platform/android/android_external_texture_gl.h"
 #include "flutter/shell/platform/android/android_surface_gl_impeller.h"
 #include "flutter/shell/platform/android/android_surface_gl_skia.h"
@@ -132,6 +133,8 @@ PlatformViewAndroid::~PlatformViewAndroid() = default;
 
 void PlatformViewAndroid::NotifyCreated(
     fml::RefPtr<AndroidNativeWindow> native_window) {
+  native_window_ = native_window;
+  ApplyPreferredFrameRate();
   if (android_surface_) {
     InstallFirstFrameCallback();
 
@@ -151,6 +154,8 @@ void PlatformViewAndroid::NotifyCreated(
 
 void PlatformViewAndroid::NotifySurfaceWindowChanged(
     fml::RefPtr<AndroidNativeWindow> native_window) {
+  native_window_ = native_window;
+  ApplyPreferredFrameRate();
   if (android_surface_) {
     fml::AutoResetWaitableEvent latch;
     fml::TaskRunner::RunNowOrPostTask(
@@ -167,6 +172,7 @@ void PlatformViewAndroid::NotifySurfaceWindowChanged(
 
 void PlatformViewAndroid::NotifyDestroyed() {
   PlatformView::NotifyDestroyed();
+  native_window_ = nullptr;
 
   if (android_surface_) {
     fml::AutoResetWaitableEvent latch;
@@ -279,9 +285,47 @@ void PlatformViewAndroid::RegisterExternalTexture(
   }
 }
 
+void PlatformViewAndroid::RegisterImageTexture(
+    int64_t texture_id,
+    const fml::jni::ScopedJavaGlobalRef<jobject>& image_consumer) {
+  auto impeller_context = GetImpellerContext();
+  if (impeller_context && impeller_context->GetBackendType() ==
+                              impeller::Context::BackendType::kVulkan) {
+    RegisterTexture(std::make_shared<AndroidExternalImageTextureVK>(
+        texture_id, image_consumer,
+        std::static_pointer_cast<impeller::ContextVK>(impeller_context),
+        jni_facade_));
+  } else {
+    FML_LOG(INFO) << "Attempted to use an image texture without Impeller on "
+                     "Vulkan.";
+  }
+}
+
 // |PlatformView|
 std::unique_ptr<VsyncWaiter> PlatformViewAndroid::CreateVSyncWaiter() {
-  return std::make_unique<VsyncWaiterAndroid>(task_runners_);
+  return std::make_unique<VsyncWaiterAndroid>(
+      task_runners_,
+      [weak_view = GetWeakPtr(),
+       platform_task_runner =
+           task_runners_.GetPlatformTaskRunner()](double frame_rate) {
+        platform_task_runner->PostTask([weak_view, frame_rate]() {
+          if (weak_view) {
+            static_cast<PlatformViewAndroid*>(weak_view.get())
+                ->SetPreferredFrameRate(frame_rate);
+          }
+        });
+      });
+}
+
+void PlatformViewAndroid::SetPreferredFrameRate(double frame_rate) {
+  preferred_frame_rate_ = frame_rate;
+  ApplyPreferredFrameRate();
+}
+
+void PlatformViewAndroid::ApplyPreferredFrameRate() {
+  if (native_window_) {
+    native_window_->SetFrameRate(static_cast<float>(preferred_frame_rate_));
+  }
 }
 
 // |PlatformView|
@@ -297,7 +341,13 @@ std::unique_ptr<Surface> PlatformViewAndroid::CreateRenderingSurface() {
 std::shared_ptr<ExternalViewEmbedder>
 PlatformViewAndroid::CreateExternalViewEmbedder() {
   return std::make_shared<AndroidExternalViewEmbedder>(
-      *android_context_, jni_facade_, surface_factory_, task_runners_);
+      *android_context_, jni_facade_, surface_factory_, task_runners_,
+      /*use_thread_merging=*/!GetSettings().enable_unmerged_platform_views,
+      [weak_platform_view = GetWeakPtr()]() {
+        if (weak_platform_view) {
+          weak_platform_view->ScheduleFrame();
+        }
+      });
 }
 
 // |PlatformView|
@@ -95,6 +95,10 @@ class PlatformViewAndroid final : public PlatformView {
       int64_t texture_id,
       const fml::jni::ScopedJavaGlobalRef<jobject>& surface_texture);
 
+  void RegisterImageTexture(
+      int64_t texture_id,
+      const fml::jni::ScopedJavaGlobalRef<jobject>& image_consumer);
+
   // |PlatformView|
   void LoadDartDeferredLibrary(
       intptr_t loading_unit_id,
@@ -129,6 +133,15 @@ class PlatformViewAndroid final : public PlatformView {
   std::unique_ptr<AndroidSurface> android_surface_;
   std::shared_ptr<PlatformMessageHandlerAndroid> platform_message_handler_;
 
+  // The window the preferred frame rate of the engine is applied to, and
+  // that rate.
+  fml::RefPtr<AndroidNativeWindow> native_window_;
+  double preferred_frame_rate_ = 0;
+
+  void SetPreferredFrameRate(double frame_rate);
+
+  void ApplyPreferredFrameRate();
+
   // |PlatformView|
   void UpdateSemantics(
       flutter::SemanticsNodeUpdates update,
@@ -104,6 +104,20 @@ static jmethodID g_get_transform_matrix_method = nullptr;
 
 static jmethodID g_detach_from_gl_context_method = nullptr;
 
+static fml::jni::ScopedJavaGlobalRef<jclass>* g_image_consumer_class = nullptr;
+
+static jmethodID g_acquire_latest_image_method = nullptr;
+
+static fml::jni::ScopedJavaGlobalRef<jclass>* g_image_class = nullptr;
+
+static jmethodID g_image_get_hardware_buffer_method = nullptr;
+
+static jmethodID g_image_close_method = nullptr;
+
+static fml::jni::ScopedJavaGlobalRef<jclass>* g_hardware_buffer_class = nullptr;
+
+static jmethodID g_hardware_buffer_close_method = nullptr;
+
 static jmethodID g_compute_platform_resolved_locale_method = nullptr;
 
 static jmethodID g_request_dart_deferred_library_method = nullptr;
@@ -465,6 +479,17 @@ static void RegisterTexture(JNIEnv* env,
   );
 }
 
+static void RegisterImageTexture(JNIEnv* env,
+                                 jobject jcaller,
+                                 jlong shell_holder,
+                                 jlong texture_id,
+                                 jobject image_consumer) {
+  ANDROID_SHELL_HOLDER->GetPlatformView()->RegisterImageTexture(
+      static_cast<int64_t>(texture_id),                            //
+      fml::jni::ScopedJavaGlobalRef<jobject>(env, image_consumer)  //
+  );
+}
+
 static void MarkTextureFrameAvailable(JNIEnv* env,
                                       jobject jcaller,
                                       jlong shell_holder,
@@ -510,6 +535,26 @@ static void NotifyLowMemoryWarning(JNIEnv* env,
   ANDROID_SHELL_HOLDER->NotifyLowMemoryWarning();
 }
 
+// The levels passed to ComponentCallbacks2.onTrimMemory.
+static constexpr jint kTrimMemoryRunningCritical = 15;
+static constexpr jint kTrimMemoryModerate = 60;
+
+static void NotifyMemoryPressure(JNIEnv* env,
+                                 jobject obj,
+                                 jlong shell_holder,
+                                 jint trim_level) {
+  // Every level that is reported to a running application, or to one in the
+  // background, is some pressure. The process is about to be killed at the
+  // critical running level, or once it is in the middle of the background
+  // LRU list.
+  MemoryPressureLevel level = MemoryPressureLevel::kModerate;
+  if (trim_level == kTrimMemoryRunningCritical ||
+      trim_level >= kTrimMemoryModerate) {
+    level = MemoryPressureLevel::kCritical;
+  }
+  ANDROID_SHELL_HOLDER->NotifyMemoryPressure(level);
+}
+
 static jboolean FlutterTextUtilsIsEmoji(JNIEnv* env,
                                         jobject obj,
                                         jint codePoint) {
@@ -556,16 +601,10 @@ static void DeferredComponentInstallFailure(JNIEnv* env,
                          static_cast<bool>(jTransient));
 }
 
-static void LoadDartDeferredLibrary(JNIEnv* env,
-                                    jobject obj,
-                                    jlong shell_holder,
-                                    jint jLoadingUnitId,
-                                    jobjectArray jSearchPaths) {
-  // Convert java->c++
-  intptr_t loading_unit_id = static_cast<intptr_t>(jLoadingUnitId);
-  std::vector<std::string> search_paths =
-      fml::jni::StringArrayToVector(env, jSearchPaths);
-
+// Opens the first shared library found in `search_paths`, trying them last to
+// first.
+static fml::RefPtr<fml::NativeLibrary> OpenLoadingUnitLibrary(
+    std::vector<std::string> search_paths) {
   // Use dlopen here to directly check if handle is nullptr before creating a
   // NativeLibrary.
   void* handle = nullptr;
@@ -575,12 +614,25 @@ static void LoadDartDeferredLibrary(JNIEnv* env,
     search_paths.pop_back();
   }
   if (handle == nullptr) {
+    return nullptr;
+  }
+  return fml::NativeLibrary::CreateWithHandle(handle, false);
+}
+
+static void LoadDartDeferredLibrary(JNIEnv* env,
+                                    jobject obj,
+                                    jlong shell_holder,
+                                    jint jLoadingUnitId,
+                                    jobjectArray jSearchPaths) {
+  // Convert java->c++
+  intptr_t loading_unit_id = static_cast<intptr_t>(jLoadingUnitId);
+  fml::RefPtr<fml::NativeLibrary> native_lib = OpenLoadingUnitLibrary(
+      fml::jni::StringArrayToVector(env, jSearchPaths));
+  if (native_lib == nullptr) {
     LoadLoadingUnitFailure(loading_unit_id,
                            "No lib .so found for provided search paths.", true);
     return;
   }
-  fml::RefPtr<fml::NativeLibrary> native_lib =
-      fml::NativeLibrary::CreateWithHandle(handle, false);
 
   // Resolve symbols.
   std::unique_ptr<const fml::SymbolMapping> data_mapping =
@@ -595,6 +647,30 @@ static void LoadDartDeferredLibrary(JNIEnv* env,
       std::move(instructions_mapping));
 }
 
+static void PrefetchDartDeferredLibrary(JNIEnv* env,
+                                        jobject obj,
+                                        jlong shell_holder,
+                                        jint jLoadingUnitId,
+                                        jobjectArray jSearchPaths) {
+  intptr_t loading_unit_id = static_cast<intptr_t>(jLoadingUnitId);
+  fml::RefPtr<fml::NativeLibrary> native_lib = OpenLoadingUnitLibrary(
+      fml::jni::StringArrayToVector(env, jSearchPaths));
+  if (native_lib == nullptr) {
+    // This is only a hint; the library is looked for again when Dart requests
+    // the loading unit.
+    FML_LOG(WARNING) << "No lib .so found to prefetch loading unit "
+                     << loading_unit_id << ".";
+    return;
+  }
+
+  ANDROID_SHELL_HOLDER->GetPlatformView()->PrefetchDartDeferredLibrary(
+      loading_unit_id,
+      std::make_unique<const fml::SymbolMapping>(
+          native_lib, DartSnapshot::kIsolateDataSymbol),
+      std::make_unique<const fml::SymbolMapping>(
+          native_lib, DartSnapshot::kIsolateInstructionsSymbol));
+}
+
 static void UpdateJavaAssetManager(JNIEnv* env,
                                    jobject obj,
                                    jlong shell_holder,
@@ -669,6 +745,11 @@ bool RegisterApi(JNIEnv* env) {
           .signature = "(J)V",
           .fnPtr = reinterpret_cast<void*>(&NotifyLowMemoryWarning),
       },
+      {
+          .name = "nativeNotifyMemoryPressure",
+          .signature = "(JI)V",
+          .fnPtr = reinterpret_cast<void*>(&NotifyMemoryPressure),
+      },
 
       // Start of methods from FlutterView
       {
@@ -732,6 +813,12 @@ bool RegisterApi(JNIEnv* env) {
                        "WeakReference;)V",
           .fnPtr = reinterpret_cast<void*>(&RegisterTexture),
       },
+      {
+          .name = "nativeRegisterImageTexture",
+          .signature = "(JJLjava/lang/ref/"
+                       "WeakReference;)V",
+          .fnPtr = reinterpret_cast<void*>(&RegisterImageTexture),
+      },
       {
           .name = "nativeMarkTextureFrameAvailable",
           .signature = "(JJ)V",
@@ -784,6 +871,11 @@ bool RegisterApi(JNIEnv* env) {
           .signature = "(JI[Ljava/lang/String;)V",
           .fnPtr = reinterpret_cast<void*>(&LoadDartDeferredLibrary),
       },
+      {
+          .name = "nativePrefetchDartDeferredLibrary",
+          .signature = "(JI[Ljava/lang/String;)V",
+          .fnPtr = reinterpret_cast<void*>(&PrefetchDartDeferredLibrary),
+      },
       {
           .name = "nativeUpdateJavaAssetManager",
           .signature =
@@ -1112,6 +1204,57 @@ bool PlatformViewAndroid::Register(JNIEnv* env) {
     return false;
   }
 
+  g_image_consumer_class = new fml::jni::ScopedJavaGlobalRef<jclass>(
+      env, env->FindClass("io/flutter/view/TextureRegistry$ImageConsumer"));
+  if (g_image_consumer_class->is_null()) {
+    FML_LOG(ERROR) << "Could not locate TextureRegistry.ImageConsumer class";
+    return false;
+  }
+
+  g_acquire_latest_image_method =
+      env->GetMethodID(g_image_consumer_class->obj(), "acquireLatestImage",
+                       "()Landroid/media/Image;");
+  if (g_acquire_latest_image_method == nullptr) {
+    FML_LOG(ERROR) << "Could not locate acquireLatestImage method";
+    return false;
+  }
+
+  g_image_class = new fml::jni::ScopedJavaGlobalRef<jclass>(
+      env, env->FindClass("android/media/Image"));
+  if (g_image_class->is_null()) {
+    FML_LOG(ERROR) << "Could not locate android.media.Image class";
+    return false;
+  }
+
+  g_image_close_method = env->GetMethodID(g_image_class->obj(), "close", "()V");
+  if (g_image_close_method == nullptr) {
+    FML_LOG(ERROR) << "Could not locate Image.close method";
+    return false;
+  }
+
+  // Hardware buffers are only available from API 28. Image textures can't be
+  // imported without them, but everything else still works.
+  g_image_get_hardware_buffer_method =
+      env->GetMethodID(g_image_class->obj(), "getHardwareBuffer",
+                       "()Landroid/hardware/HardwareBuffer;");
+  if (g_image_get_hardware_buffer_method == nullptr) {
+    fml::jni::ClearException(env);
+  } else {
+    g_hardware_buffer_class = new fml::jni::ScopedJavaGlobalRef<jclass>(
+        env, env->FindClass("android/hardware/HardwareBuffer"));
+    if (g_hardware_buffer_class->is_null()) {
+      fml::jni::ClearException(env);
+      g_image_get_hardware_buffer_method = nullptr;
+    } else {
+      g_hardware_buffer_close_method =
+          env->GetMethodID(g_hardware_buffer_class->obj(), "close", "()V");
+      if (g_hardware_buffer_close_method == nullptr) {
+        fml::jni::ClearException(env);
+        g_image_get_hardware_buffer_method = nullptr;
+      }
+    }
+  }
+
   g_compute_platform_resolved_locale_method = env->GetMethodID(
       g_flutter_jni_class->obj(), "computePlatformResolvedLocale",
       "([Ljava/lang/String;)[Ljava/lang/String;");
@@ -1405,6 +1548,69 @@ void PlatformViewAndroidJNIImpl::SurfaceTextureDetachFromGLContext(
   FML_CHECK(fml::jni::CheckException(env));
 }
 
+JavaLocalRef
+PlatformViewAndroidJNIImpl::ImageConsumerTextureRegistryAcquireLatestImage(
+    JavaLocalRef image_consumer) {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  if (image_consumer.is_null()) {
+    return JavaLocalRef();
+  }
+
+  fml::jni::ScopedJavaLocalRef<jobject> image_consumer_local_ref(
+      env, env->CallObjectMethod(image_consumer.obj(),
+                                 g_java_weak_reference_get_method));
+  if (image_consumer_local_ref.is_null()) {
+    return JavaLocalRef();
+  }
+
+  JavaLocalRef image(env,
+                     env->CallObjectMethod(image_consumer_local_ref.obj(),
+                                           g_acquire_latest_image_method));
+  FML_CHECK(fml::jni::CheckException(env));
+  return image;
+}
+
+JavaLocalRef PlatformViewAndroidJNIImpl::ImageGetHardwareBuffer(
+    JavaLocalRef image) {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  if (image.is_null() || g_image_get_hardware_buffer_method == nullptr) {
+    return JavaLocalRef();
+  }
+
+  JavaLocalRef hardware_buffer(
+      env,
+      env->CallObjectMethod(image.obj(), g_image_get_hardware_buffer_method));
+  FML_CHECK(fml::jni::CheckException(env));
+  return hardware_buffer;
+}
+
+void PlatformViewAndroidJNIImpl::ImageClose(JavaLocalRef image) {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  if (image.is_null()) {
+    return;
+  }
+
+  env->CallVoidMethod(image.obj(), g_image_close_method);
+
+  FML_CHECK(fml::jni::CheckException(env));
+}
+
+void PlatformViewAndroidJNIImpl::HardwareBufferClose(
+    JavaLocalRef hardware_buffer) {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  if (hardware_buffer.is_null() || g_hardware_buffer_close_method == nullptr) {
+    return;
+  }
+
+  env->CallVoidMethod(hardware_buffer.obj(), g_hardware_buffer_close_method);
+
+  FML_CHECK(fml::jni::CheckException(env));
+}
+
 void PlatformViewAndroidJNIImpl::FlutterViewOnDisplayPlatformView(
     int view_id,
     int x,
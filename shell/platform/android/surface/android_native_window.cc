@@ -4,8 +4,40 @@
 
 #include "flutter/shell/platform/android/surface/android_native_window.h"
 
+#include <optional>
+
+#include "flutter/fml/native_library.h"
+
 namespace flutter {
 
+namespace {
+
+// Only available on API 30+.
+typedef int32_t (*ANativeWindow_setFrameRate_FPN)(
+    AndroidNativeWindow::Handle window,
+    float frame_rate,
+    int8_t compatibility);
+
+// ANATIVEWINDOW_FRAME_RATE_COMPATIBILITY_DEFAULT
+constexpr int8_t kFrameRateCompatibilityDefault = 0;
+
+ANativeWindow_setFrameRate_FPN GetSetFrameRateProc() {
+  static std::optional<ANativeWindow_setFrameRate_FPN> set_frame_rate;
+  if (set_frame_rate) {
+    return set_frame_rate.value();
+  }
+  set_frame_rate = nullptr;
+  auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+  if (libandroid) {
+    auto proc = libandroid->ResolveFunction<ANativeWindow_setFrameRate_FPN>(
+        "ANativeWindow_setFrameRate");
+    set_frame_rate = proc.value_or(nullptr);
+  }
+  return set_frame_rate.value();
+}
+
+}  // namespace
+
 AndroidNativeWindow::AndroidNativeWindow(Handle window, bool is_fake_window)
     : window_(window), is_fake_window_(is_fake_window) {}
 
@@ -39,4 +71,16 @@ SkISize AndroidNativeWindow::GetSize() const {
 #endif  // FML_OS_ANDROID
 }
 
+bool AndroidNativeWindow::SetFrameRate(float frame_rate) {
+  if (window_ == nullptr || is_fake_window_) {
+    return false;
+  }
+  auto set_frame_rate = GetSetFrameRateProc();
+  if (!set_frame_rate) {
+    return false;
+  }
+  return set_frame_rate(window_, frame_rate, kFrameRateCompatibilityDefault) ==
+         0;
+}
+
 }  // namespace flutter
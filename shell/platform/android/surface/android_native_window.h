@@ -32,6 +32,11 @@ class AndroidNativeWindow
 
   SkISize GetSize() const;
 
+  /// Hints the compositor at the rate frames are produced at for this window,
+  /// in frames per second. Zero means no preference. Returns false if the
+  /// device doesn't support it, which needs API 30+.
+  bool SetFrameRate(float frame_rate);
+
   /// Returns true when this AndroidNativeWindow is not backed by a real window
   /// (used for testing).
   bool IsFakeWindow() const { return is_fake_window_; }
@@ -5,6 +5,7 @@
 #include "flutter/shell/platform/android/vsync_waiter_android.h"
 
 #include <cmath>
+#include <string>
 #include <utility>
 
 #include "flutter/common/task_runners.h"
@@ -21,16 +22,27 @@ static fml::jni::ScopedJavaGlobalRef<jclass>* g_vsync_waiter_class = nullptr;
 static jmethodID g_async_wait_for_vsync_method_ = nullptr;
 static std::atomic_uint g_refresh_rate_ = 60;
 
-VsyncWaiterAndroid::VsyncWaiterAndroid(const flutter::TaskRunners& task_runners)
+VsyncWaiterAndroid::VsyncWaiterAndroid(
+    const flutter::TaskRunners& task_runners,
+    PreferredFrameRateCallback on_preferred_frame_rate_changed)
     : VsyncWaiter(task_runners),
-      use_ndk_choreographer_(
-          AndroidChoreographer::ShouldUseNDKChoreographer()) {}
+      use_ndk_choreographer_(AndroidChoreographer::ShouldUseNDKChoreographer()),
+      use_vsync_callback_(AndroidChoreographer::ShouldUseVsyncCallback()),
+      on_preferred_frame_rate_changed_(
+          std::move(on_preferred_frame_rate_changed)) {}
 
 VsyncWaiterAndroid::~VsyncWaiterAndroid() = default;
 
 // |VsyncWaiter|
 void VsyncWaiterAndroid::AwaitVSync() {
-  if (use_ndk_choreographer_) {
+  if (use_vsync_callback_) {
+    auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(), [weak_this]() {
+          AndroidChoreographer::PostVsyncCallback(&OnVsyncFromNDKWithDeadline,
+                                                  weak_this);
+        });
+  } else if (use_ndk_choreographer_) {
     auto* weak_this = new std::weak_ptr<VsyncWaiter>(shared_from_this());
     fml::TaskRunner::RunNowOrPostTask(
         task_runners_.GetUITaskRunner(), [weak_this]() {
@@ -50,6 +62,13 @@ void VsyncWaiterAndroid::AwaitVSync() {
   }
 }
 
+// |VsyncWaiter|
+void VsyncWaiterAndroid::OnPreferredFrameRateChanged(double frame_rate) {
+  if (on_preferred_frame_rate_changed_) {
+    on_preferred_frame_rate_changed_(frame_rate);
+  }
+}
+
 // static
 void VsyncWaiterAndroid::OnVsyncFromNDK(int64_t frame_nanos, void* data) {
   auto frame_time = fml::TimePoint::FromEpochDelta(
@@ -70,6 +89,41 @@ void VsyncWaiterAndroid::OnVsyncFromNDK(int64_t frame_nanos, void* data) {
   ConsumePendingCallback(weak_this, frame_time, target_time);
 }
 
+// static
+void VsyncWaiterAndroid::OnVsyncFromNDKWithDeadline(
+    int64_t frame_nanos,
+    int64_t deadline_nanos,
+    int64_t expected_present_time_nanos,
+    void* data) {
+  auto frame_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(frame_nanos));
+  auto now = fml::TimePoint::Now();
+  if (frame_time > now) {
+    frame_time = now;
+  }
+  // The deadline of the timeline that the platform picked is when the frame
+  // must be submitted to be presented on time. It accounts for the refresh
+  // rate that is in use, and for how long the compositor takes.
+  auto target_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromNanoseconds(deadline_nanos));
+  if (target_time <= frame_time) {
+    target_time = frame_time + fml::TimeDelta::FromNanoseconds(
+                                   1000000000.0 / g_refresh_rate_);
+  }
+
+  TRACE_EVENT2_INT("flutter", "PlatformVsync", "frame_start_time",
+                   frame_time.ToEpochDelta().ToMicroseconds(),
+                   "frame_target_time",
+                   target_time.ToEpochDelta().ToMicroseconds());
+  std::string expected_present_time =
+      std::to_string(expected_present_time_nanos / 1000);
+  TRACE_EVENT_INSTANT1("flutter", "ExpectedPresentTime",
+                       "expected_present_time", expected_present_time.c_str());
+
+  auto* weak_this = reinterpret_cast<std::weak_ptr<VsyncWaiter>*>(data);
+  ConsumePendingCallback(weak_this, frame_time, target_time);
+}
+
 // static
 void VsyncWaiterAndroid::OnVsyncFromJava(JNIEnv* env,
                                          jclass jcaller,
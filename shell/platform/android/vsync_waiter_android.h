@@ -7,6 +7,7 @@
 
 #include <jni.h>
 
+#include <functional>
 #include <memory>
 
 #include "flutter/fml/macros.h"
@@ -20,7 +21,13 @@ class VsyncWaiterAndroid final : public VsyncWaiter {
  public:
   static bool Register(JNIEnv* env);
 
-  explicit VsyncWaiterAndroid(const flutter::TaskRunners& task_runners);
+  using PreferredFrameRateCallback = std::function<void(double frame_rate)>;
+
+  /// |on_preferred_frame_rate_changed| is invoked on the UI thread with the
+  /// frame rate the engine prefers, so that it can be applied to the window.
+  explicit VsyncWaiterAndroid(
+      const flutter::TaskRunners& task_runners,
+      PreferredFrameRateCallback on_preferred_frame_rate_changed = nullptr);
 
   ~VsyncWaiterAndroid() override;
 
@@ -28,8 +35,16 @@ class VsyncWaiterAndroid final : public VsyncWaiter {
   // |VsyncWaiter|
   void AwaitVSync() override;
 
+  // |VsyncWaiter|
+  void OnPreferredFrameRateChanged(double frame_rate) override;
+
   static void OnVsyncFromNDK(int64_t frame_nanos, void* data);
 
+  static void OnVsyncFromNDKWithDeadline(int64_t frame_nanos,
+                                         int64_t deadline_nanos,
+                                         int64_t expected_present_time_nanos,
+                                         void* data);
+
   static void OnVsyncFromJava(JNIEnv* env,
                               jclass jcaller,
                               jlong frameDelayNanos,
@@ -45,6 +60,8 @@ class VsyncWaiterAndroid final : public VsyncWaiter {
                                   jfloat refresh_rate);
 
   const bool use_ndk_choreographer_;
+  const bool use_vsync_callback_;
+  const PreferredFrameRateCallback on_preferred_frame_rate_changed_;
   FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterAndroid);
 };
 
@@ -4,6 +4,7 @@
 
 #include "accessibility_bridge.h"
 
+#include <algorithm>
 #include <functional>
 #include <utility>
 
@@ -57,7 +58,15 @@ void AccessibilityBridge::CommitUpdates() {
   // First, start by removing nodes if necessary.
   std::optional<ui::AXTreeUpdate> remove_reparented =
       CreateRemoveReparentedNodesUpdate();
-  if (remove_reparented.has_value()) {
+  if (!remove_reparented.has_value()) {
+    // A node that is moved to a new parent is re-added with its subtree, so
+    // none of the updates may be dropped then.
+    RemoveUnchangedNodeUpdates();
+    if (pending_semantics_node_updates_.empty()) {
+      pending_semantics_custom_action_updates_.clear();
+      return;
+    }
+  } else {
     tree_->Unserialize(remove_reparented.value());
 
     std::string error = tree_->error();
@@ -83,15 +92,15 @@ void AccessibilityBridge::CommitUpdates() {
   std::vector<std::vector<SemanticsNode>> results;
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
-    std::vector<SemanticsNode> sub_tree_list;
-    GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
+    SemanticsNode target = std::move(begin->second);
     pending_semantics_node_updates_.erase(begin);
+    std::vector<SemanticsNode> sub_tree_list;
+    GetSubTreeList(std::move(target), sub_tree_list);
+    results.push_back(std::move(sub_tree_list));
   }
 
   for (size_t i = results.size(); i > 0; i--) {
-    for (SemanticsNode node : results[i - 1]) {
+    for (const SemanticsNode& node : results[i - 1]) {
       ConvertFlutterUpdate(node, update);
     }
   }
@@ -114,6 +123,15 @@ void AccessibilityBridge::CommitUpdates() {
     FML_LOG(ERROR) << "Failed to update ui::AXTree, error: " << error;
     return;
   }
+  for (auto& list : results) {
+    for (auto& node : list) {
+      // Nodes that the update removed from the tree again are not kept.
+      if (tree_->GetFromId(node.id)) {
+        int32_t id = node.id;
+        committed_semantics_nodes_[id] = std::move(node);
+      }
+    }
+  }
   // Handles accessibility events as the result of the semantics update.
   for (const auto& targeted_event : event_generator_) {
     auto event_target =
@@ -190,6 +208,7 @@ void AccessibilityBridge::OnNodeDeleted(ui::AXTree* tree,
   if (id_wrapper_map_.find(node_id) != id_wrapper_map_.end()) {
     id_wrapper_map_.erase(node_id);
   }
+  committed_semantics_nodes_.erase(node_id);
 }
 
 void AccessibilityBridge::OnAtomicUpdateFinished(
@@ -215,7 +234,7 @@ std::optional<ui::AXTreeUpdate>
 AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
   std::unordered_map<int32_t, ui::AXNodeData> updates;
 
-  for (auto node_update : pending_semantics_node_updates_) {
+  for (const auto& node_update : pending_semantics_node_updates_) {
     for (int32_t child_id : node_update.second.children_in_traversal_order) {
       // Skip nodes that don't exist or have a parent in the current tree.
       ui::AXNode* child = tree_->GetFromId(child_id);
@@ -260,23 +279,79 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
       .nodes = std::vector<ui::AXNodeData>(),
   };
 
-  for (std::pair<int32_t, ui::AXNodeData> data : updates) {
+  for (auto& data : updates) {
     update.nodes.push_back(std::move(data.second));
   }
 
   return update;
 }
 
+void AccessibilityBridge::RemoveUnchangedNodeUpdates() {
+  for (auto iter = pending_semantics_node_updates_.begin();
+       iter != pending_semantics_node_updates_.end();) {
+    auto committed = committed_semantics_nodes_.find(iter->first);
+    // The custom actions are resolved when the node is converted, so a node
+    // with updated custom actions is applied again.
+    const auto& actions = iter->second.custom_accessibility_actions;
+    bool has_pending_actions =
+        std::any_of(actions.begin(), actions.end(), [this](int32_t action) {
+          return pending_semantics_custom_action_updates_.count(action) > 0;
+        });
+    if (committed != committed_semantics_nodes_.end() &&
+        !has_pending_actions && tree_->GetFromId(iter->first) &&
+        IsSameSemanticsNode(committed->second, iter->second)) {
+      iter = pending_semantics_node_updates_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+// static
+bool AccessibilityBridge::IsSameSemanticsNode(const SemanticsNode& a,
+                                              const SemanticsNode& b) {
+  return a.id == b.id && a.flags == b.flags && a.actions == b.actions &&
+         a.text_selection_base == b.text_selection_base &&
+         a.text_selection_extent == b.text_selection_extent &&
+         a.scroll_child_count == b.scroll_child_count &&
+         a.scroll_index == b.scroll_index &&
+         a.scroll_position == b.scroll_position &&
+         a.scroll_extent_max == b.scroll_extent_max &&
+         a.scroll_extent_min == b.scroll_extent_min &&
+         a.elevation == b.elevation && a.thickness == b.thickness &&
+         a.label == b.label && a.hint == b.hint && a.value == b.value &&
+         a.increased_value == b.increased_value &&
+         a.decreased_value == b.decreased_value && a.tooltip == b.tooltip &&
+         a.text_direction == b.text_direction &&
+         a.rect.left == b.rect.left && a.rect.top == b.rect.top &&
+         a.rect.right == b.rect.right && a.rect.bottom == b.rect.bottom &&
+         a.transform.scaleX == b.transform.scaleX &&
+         a.transform.skewX == b.transform.skewX &&
+         a.transform.transX == b.transform.transX &&
+         a.transform.skewY == b.transform.skewY &&
+         a.transform.scaleY == b.transform.scaleY &&
+         a.transform.transY == b.transform.transY &&
+         a.transform.pers0 == b.transform.pers0 &&
+         a.transform.pers1 == b.transform.pers1 &&
+         a.transform.pers2 == b.transform.pers2 &&
+         a.children_in_traversal_order == b.children_in_traversal_order &&
+         a.custom_accessibility_actions == b.custom_accessibility_actions;
+}
+
 // Private method.
-void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
+void AccessibilityBridge::GetSubTreeList(SemanticsNode target,
                                          std::vector<SemanticsNode>& result) {
-  result.push_back(target);
-  for (int32_t child : target.children_in_traversal_order) {
+  result.push_back(std::move(target));
+  // Copy the children, as the reference to the target is invalidated when
+  // more nodes are added to the result.
+  const std::vector<int32_t> children =
+      result.back().children_in_traversal_order;
+  for (int32_t child : children) {
     auto iter = pending_semantics_node_updates_.find(child);
     if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
+      SemanticsNode node = std::move(iter->second);
       pending_semantics_node_updates_.erase(iter);
+      GetSubTreeList(std::move(node), result);
     }
   }
 }
@@ -75,6 +75,12 @@ class AccessibilityBridge
   ///             state. For example if a node reparents from A to B, callers
   ///             should only call this method when both removal from A and
   ///             addition to B are in the pending updates.
+  ///
+  ///             Only the nodes that are new, or differ from the version that
+  ///             was last committed, are applied to the accessibility tree.
+  ///             The framework also sends the nodes that it marked dirty
+  ///             without changing them, and re-serializing those made large
+  ///             trees slow to update.
   void CommitUpdates();
 
   //------------------------------------------------------------------------------
@@ -209,6 +215,8 @@ class AccessibilityBridge
   std::unique_ptr<ui::AXTree> tree_;
   ui::AXEventGenerator event_generator_;
   std::unordered_map<int32_t, SemanticsNode> pending_semantics_node_updates_;
+  // The last committed version of each node in the tree.
+  std::unordered_map<int32_t, SemanticsNode> committed_semantics_nodes_;
   std::unordered_map<int32_t, SemanticsCustomAction>
       pending_semantics_custom_action_updates_;
   AccessibilityNodeId last_focused_id_ = ui::AXNode::kInvalidAXID;
@@ -219,8 +227,14 @@ class AccessibilityBridge
   // pending_semantics_updates_. Returns std::nullopt if none are reparented.
   std::optional<ui::AXTreeUpdate> CreateRemoveReparentedNodesUpdate();
 
-  void GetSubTreeList(const SemanticsNode& target,
-                      std::vector<SemanticsNode>& result);
+  // Drop the pending updates of the nodes that are in the tree already, and
+  // equal to their last committed version.
+  void RemoveUnchangedNodeUpdates();
+
+  static bool IsSameSemanticsNode(const SemanticsNode& a,
+                                  const SemanticsNode& b);
+
+  void GetSubTreeList(SemanticsNode target, std::vector<SemanticsNode>& result);
   void ConvertFlutterUpdate(const SemanticsNode& node,
                             ui::AXTreeUpdate& tree_update);
   void SetRoleFromFlutterUpdate(ui::AXNodeData& node_data,
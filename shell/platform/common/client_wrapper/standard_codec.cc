@@ -11,6 +11,7 @@
 #include <cstring>
 #include <iostream>
 #include <map>
+#include <utility>
 #include <string>
 #include <vector>
 
@@ -78,6 +79,82 @@ EncodedType EncodedTypeForValue(const EncodableValue& value) {
   return EncodedType::kNull;
 }
 
+// Returns the number of bytes WriteSize uses to encode |size|.
+size_t GetEncodedSizeLength(size_t size) {
+  if (size < 254) {
+    return 1;
+  }
+  return size <= 0xffff ? 3 : 5;
+}
+
+size_t AlignOffset(size_t offset, size_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+template <typename T>
+size_t GetVectorEnd(const std::vector<T>& vector, size_t offset) {
+  offset += GetEncodedSizeLength(vector.size());
+  if (vector.empty()) {
+    return offset;
+  }
+  if (sizeof(T) > 1) {
+    offset = AlignOffset(offset, sizeof(T));
+  }
+  return offset + vector.size() * sizeof(T);
+}
+
+// Returns the offset at which the standard encoding of |value| ends when it
+// is written at |offset|, so that buffers can be sized before encoding into
+// them. Custom values are counted as their type byte only, so the result is
+// only a lower bound for messages that contain them.
+size_t GetEncodedEnd(const EncodableValue& value, size_t offset) {
+  // The type byte.
+  offset++;
+  switch (value.index()) {
+    case 0:
+    case 1:
+      return offset;
+    case 2:
+      return offset + sizeof(int32_t);
+    case 3:
+      return offset + sizeof(int64_t);
+    case 4:
+      return AlignOffset(offset, 8) + sizeof(double);
+    case 5: {
+      size_t size = std::get<std::string>(value).size();
+      return offset + GetEncodedSizeLength(size) + size;
+    }
+    case 6:
+      return GetVectorEnd(std::get<std::vector<uint8_t>>(value), offset);
+    case 7:
+      return GetVectorEnd(std::get<std::vector<int32_t>>(value), offset);
+    case 8:
+      return GetVectorEnd(std::get<std::vector<int64_t>>(value), offset);
+    case 9:
+      return GetVectorEnd(std::get<std::vector<double>>(value), offset);
+    case 10: {
+      const auto& list = std::get<EncodableList>(value);
+      offset += GetEncodedSizeLength(list.size());
+      for (const auto& item : list) {
+        offset = GetEncodedEnd(item, offset);
+      }
+      return offset;
+    }
+    case 11: {
+      const auto& map = std::get<EncodableMap>(value);
+      offset += GetEncodedSizeLength(map.size());
+      for (const auto& pair : map) {
+        offset = GetEncodedEnd(pair.first, offset);
+        offset = GetEncodedEnd(pair.second, offset);
+      }
+      return offset;
+    }
+    case 13:
+      return GetVectorEnd(std::get<std::vector<float>>(value), offset);
+  }
+  return offset;
+}
+
 }  // namespace
 
 StandardCodecSerializer::StandardCodecSerializer() = default;
@@ -188,7 +265,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       std::string string_value;
       string_value.resize(size);
       stream->ReadBytes(reinterpret_cast<uint8_t*>(&string_value[0]), size);
-      return EncodableValue(string_value);
+      return EncodableValue(std::move(string_value));
     }
     case EncodedType::kUInt8List:
       return ReadVector<uint8_t>(stream);
@@ -205,7 +282,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       for (size_t i = 0; i < length; ++i) {
         list_value.push_back(ReadValue(stream));
       }
-      return EncodableValue(list_value);
+      return EncodableValue(std::move(list_value));
     }
     case EncodedType::kMap: {
       size_t length = ReadSize(stream);
@@ -215,7 +292,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
         EncodableValue value = ReadValue(stream);
         map_value.emplace(std::move(key), std::move(value));
       }
-      return EncodableValue(map_value);
+      return EncodableValue(std::move(map_value));
     }
     case EncodedType::kFloat32List: {
       return ReadVector<float>(stream);
@@ -268,11 +345,11 @@ EncodableValue StandardCodecSerializer::ReadVector(
   }
   stream->ReadBytes(reinterpret_cast<uint8_t*>(vector.data()),
                     count * type_size);
-  return EncodableValue(vector);
+  return EncodableValue(std::move(vector));
 }
 
 template <typename T>
-void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
+void StandardCodecSerializer::WriteVector(const std::vector<T>& vector,
                                           ByteStreamWriter* stream) const {
   size_t count = vector.size();
   WriteSize(count, stream);
@@ -329,6 +406,7 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMessageCodec::EncodeMessageInternal(
     const EncodableValue& message) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  encoded->reserve(GetEncodedEnd(message, 0));
   ByteBufferStreamWriter stream(encoded.get());
   serializer_->WriteValue(message, &stream);
   return encoded;
@@ -383,8 +461,13 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeMethodCallInternal(
     const MethodCall<EncodableValue>& method_call) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  EncodableValue method_name(method_call.method_name());
+  size_t size = GetEncodedEnd(method_name, 0);
+  encoded->reserve(method_call.arguments()
+                       ? GetEncodedEnd(*method_call.arguments(), size)
+                       : size + 1);
   ByteBufferStreamWriter stream(encoded.get());
-  serializer_->WriteValue(EncodableValue(method_call.method_name()), &stream);
+  serializer_->WriteValue(method_name, &stream);
   if (method_call.arguments()) {
     serializer_->WriteValue(*method_call.arguments(), &stream);
   } else {
@@ -397,6 +480,7 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMethodCodec::EncodeSuccessEnvelopeInternal(
     const EncodableValue* result) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
+  encoded->reserve(result ? GetEncodedEnd(*result, 1) : 2);
   ByteBufferStreamWriter stream(encoded.get());
   stream.WriteByte(0);
   if (result) {
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+
+namespace flutter {
+
+namespace {
+
+// A map like the ones desktop plugins send, with |entry_count| entries of
+// mixed scalar, string and typed list values.
+EncodableValue CreateMapPayload(int64_t entry_count) {
+  EncodableMap map;
+  for (int64_t i = 0; i < entry_count; i++) {
+    map[EncodableValue("entry" + std::to_string(i))] = EncodableValue(
+        EncodableMap{{EncodableValue("id"), EncodableValue(i)},
+                     {EncodableValue("name"),
+                      EncodableValue("Entry number " + std::to_string(i))},
+                     {EncodableValue("enabled"), EncodableValue(i % 2 == 0)},
+                     {EncodableValue("scale"), EncodableValue(i * 0.5)},
+                     {EncodableValue("samples"),
+                      EncodableValue(std::vector<double>(16, 1.0))}});
+  }
+  return EncodableValue(std::move(map));
+}
+
+EncodableValue CreateBytesPayload(int64_t size) {
+  return EncodableValue(std::vector<uint8_t>(size, 0x42));
+}
+
+EncodableValue CreateFloat64ListPayload(int64_t count) {
+  return EncodableValue(std::vector<double>(count, 3.14));
+}
+
+void EncodeMessage(benchmark::State& state, const EncodableValue& message) {
+  const auto& codec = StandardMessageCodec::GetInstance();
+  size_t encoded_size = 0;
+  while (state.KeepRunning()) {
+    auto encoded = codec.EncodeMessage(message);
+    encoded_size = encoded->size();
+    benchmark::DoNotOptimize(encoded);
+  }
+  state.SetBytesProcessed(state.iterations() * encoded_size);
+}
+
+void DecodeMessage(benchmark::State& state, const EncodableValue& message) {
+  const auto& codec = StandardMessageCodec::GetInstance();
+  auto encoded = codec.EncodeMessage(message);
+  while (state.KeepRunning()) {
+    auto decoded = codec.DecodeMessage(*encoded);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(state.iterations() * encoded->size());
+}
+
+}  // namespace
+
+static void BM_StandardMessageCodecEncodeMap(benchmark::State& state) {
+  EncodeMessage(state, CreateMapPayload(state.range(0)));
+}
+
+BENCHMARK(BM_StandardMessageCodecEncodeMap)->Range(1, 1 << 12);
+
+static void BM_StandardMessageCodecDecodeMap(benchmark::State& state) {
+  DecodeMessage(state, CreateMapPayload(state.range(0)));
+}
+
+BENCHMARK(BM_StandardMessageCodecDecodeMap)->Range(1, 1 << 12);
+
+static void BM_StandardMessageCodecEncodeUint8List(benchmark::State& state) {
+  EncodeMessage(state, CreateBytesPayload(state.range(0)));
+}
+
+BENCHMARK(BM_StandardMessageCodecEncodeUint8List)->Range(1 << 10, 1 << 22);
+
+static void BM_StandardMessageCodecDecodeUint8List(benchmark::State& state) {
+  DecodeMessage(state, CreateBytesPayload(state.range(0)));
+}
+
+BENCHMARK(BM_StandardMessageCodecDecodeUint8List)->Range(1 << 10, 1 << 22);
+
+static void BM_StandardMessageCodecEncodeFloat64List(
+    benchmark::State& state) {
+  EncodeMessage(state, CreateFloat64ListPayload(state.range(0)));
+}
+
+BENCHMARK(BM_StandardMessageCodecEncodeFloat64List)->Range(1 << 7, 1 << 19);
+
+static void BM_StandardMessageCodecDecodeFloat64List(
+    benchmark::State& state) {
+  DecodeMessage(state, CreateFloat64ListPayload(state.range(0)));
+}
+
+BENCHMARK(BM_StandardMessageCodecDecodeFloat64List)->Range(1 << 7, 1 << 19);
+
+}  // namespace flutter
@@ -100,6 +100,16 @@ typedef struct {
   void (*release_callback)(void* release_context);
   // Opaque data passed to |release_callback|.
   void* release_context;
+  // An optional shared |HANDLE| of an |ID3D11Fence| that is signaled once the
+  // surface has been written to.
+  //
+  // If provided, Flutter waits on the GPU for the fence to reach
+  // |fence_value| before sampling the surface, instead of the producer having
+  // to flush or copy the surface. The fence has to be created with
+  // |D3D11_FENCE_FLAG_SHARED| on the adapter used by Flutter.
+  void* fence_handle;
+  // The value of |fence_handle| to wait for.
+  uint64_t fence_value;
 } FlutterDesktopGpuSurfaceDescriptor;
 
 // The pixel buffer copy callback definition provided to
@@ -22,6 +22,27 @@ bool IsTrailingSurrogate(char32_t code_point) {
   return (code_point & 0xFFFFFC00) == 0xDC00;
 }
 
+// Returns the number of bytes that the first |length| UTF-16 code units of
+// |text| take up in UTF-8.
+size_t Utf8Length(const std::u16string& text, size_t length) {
+  size_t utf8_length = 0;
+  for (size_t i = 0; i < length; i++) {
+    char16_t code_unit = text[i];
+    if (code_unit < 0x80) {
+      utf8_length += 1;
+    } else if (code_unit < 0x800) {
+      utf8_length += 2;
+    } else if (IsLeadingSurrogate(code_unit) && i + 1 < length &&
+               IsTrailingSurrogate(text[i + 1])) {
+      utf8_length += 4;
+      i++;
+    } else {
+      utf8_length += 3;
+    }
+  }
+  return utf8_length;
+}
+
 }  // namespace
 
 TextInputModel::TextInputModel() = default;
@@ -32,6 +53,7 @@ bool TextInputModel::SetText(const std::string& text,
                              const TextRange& selection,
                              const TextRange& composing_range) {
   text_ = fml::Utf8ToUtf16(text);
+  TextChanged();
   if (!text_range().Contains(selection) ||
       !text_range().Contains(composing_range)) {
     return false;
@@ -76,6 +98,7 @@ void TextInputModel::UpdateComposingText(const std::u16string& text) {
   }
   DeleteSelected();
   text_.replace(composing_range_.start(), composing_range_.length(), text);
+  TextChanged();
   composing_range_.set_end(composing_range_.start() + text.length());
   selection_ = TextRange(composing_range_.end());
 }
@@ -104,6 +127,7 @@ bool TextInputModel::DeleteSelected() {
   }
   size_t start = selection_.start();
   text_.erase(start, selection_.length());
+  TextChanged();
   selection_ = TextRange(start);
   if (composing_) {
     // This occurs only immediately after composing has begun with a selection.
@@ -128,14 +152,17 @@ void TextInputModel::AddCodePoint(char32_t c) {
 
 void TextInputModel::AddText(const std::u16string& text) {
   DeleteSelected();
+  size_t position = selection_.position();
+  size_t replaced_length = 0;
   if (composing_) {
-    // Delete the current composing text, set the cursor to composing start.
-    text_.erase(composing_range_.start(), composing_range_.length());
-    selection_ = TextRange(composing_range_.start());
+    // Replace the current composing text, starting at composing start. This
+    // moves the text after it once rather than twice.
+    position = composing_range_.start();
+    replaced_length = composing_range_.length();
     composing_range_.set_end(composing_range_.start() + text.length());
   }
-  size_t position = selection_.position();
-  text_.insert(position, text);
+  text_.replace(position, replaced_length, text);
+  TextChanged();
   selection_ = TextRange(position + text.length());
 }
 
@@ -152,6 +179,7 @@ bool TextInputModel::Backspace() {
   if (position != editable_range().start()) {
     int count = IsTrailingSurrogate(text_.at(position - 1)) ? 2 : 1;
     text_.erase(position - count, count);
+    TextChanged();
     selection_ = TextRange(position - count);
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
@@ -170,6 +198,7 @@ bool TextInputModel::Delete() {
   if (position < editable_range().end()) {
     int count = IsLeadingSurrogate(text_.at(position)) ? 2 : 1;
     text_.erase(position, count);
+    TextChanged();
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
     }
@@ -208,6 +237,7 @@ bool TextInputModel::DeleteSurrounding(int offset_from_cursor, int count) {
 
   auto deleted_length = end - start;
   text_.erase(start, deleted_length);
+  TextChanged();
 
   // Cursor moves only if deleted area is before it.
   selection_ = TextRange(offset_from_cursor <= 0 ? start : selection_.start());
@@ -288,14 +318,15 @@ bool TextInputModel::MoveCursorBack() {
 }
 
 std::string TextInputModel::GetText() const {
-  return fml::Utf16ToUtf8(text_);
+  if (!utf8_text_.has_value()) {
+    utf8_text_ = fml::Utf16ToUtf8(text_);
+  }
+  return utf8_text_.value();
 }
 
 int TextInputModel::GetCursorOffset() const {
   // Measure the length of the current text up to the selection extent.
-  // There is probably a much more efficient way of doing this.
-  auto leading_text = text_.substr(0, selection_.extent());
-  return fml::Utf16ToUtf8(leading_text).size();
+  return Utf8Length(text_, selection_.extent());
 }
 
 }  // namespace flutter
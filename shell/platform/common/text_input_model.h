@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_COMMON_TEXT_INPUT_MODEL_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "flutter/shell/platform/common/text_range.h"
@@ -218,7 +219,17 @@ class TextInputModel {
     return composing_ ? composing_range_ : text_range();
   }
 
+  // Drops the UTF-8 copy of the text. Must be called whenever |text_| is
+  // modified.
+  void TextChanged() { utf8_text_.reset(); }
+
   std::u16string text_;
+  // The UTF-8 encoding of |text_|, if it was requested since the last change.
+  //
+  // The platform plugins read the text several times per edit, to report the
+  // text before and after the change, and converting large documents each time
+  // stalled the input.
+  mutable std::optional<std::string> utf8_text_;
   TextRange selection_ = TextRange(0);
   TextRange composing_range_ = TextRange(0);
   bool composing_ = false;
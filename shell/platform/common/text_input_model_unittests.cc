@@ -1688,6 +1688,26 @@ TEST(TextInputModel, SelectToEndEndReverseComposing) {
   EXPECT_STREQ(model->GetText().c_str(), "ABCDE");
 }
 
+TEST(TextInputModel, GetTextAfterEdits) {
+  auto model = std::make_unique<TextInputModel>();
+  model->SetText("ABCDE", TextRange(5));
+  EXPECT_STREQ(model->GetText().c_str(), "ABCDE");
+  model->AddText(u"F");
+  EXPECT_STREQ(model->GetText().c_str(), "ABCDEF");
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_STREQ(model->GetText().c_str(), "ABCD");
+  model->BeginComposing();
+  model->UpdateComposingText(u"\u00e9");
+  EXPECT_STREQ(model->GetText().c_str(), "ABCD\u00e9");
+  EXPECT_EQ(model->GetCursorOffset(), 6);
+  model->AddText(u"G");
+  model->EndComposing();
+  EXPECT_STREQ(model->GetText().c_str(), "ABCDG");
+  EXPECT_TRUE(model->DeleteSurrounding(-5, 1));
+  EXPECT_STREQ(model->GetText().c_str(), "BCDG");
+}
+
 TEST(TextInputModel, GetCursorOffset) {
   auto model = std::make_unique<TextInputModel>();
   // These characters take 1, 2, 3 and 4 bytes in UTF-8.
@@ -3,6 +3,9 @@
 // found in the LICENSE file.
 
 #import "flutter/shell/platform/darwin/graphics/FlutterDarwinExternalTextureMetal.h"
+
+#import <IOSurface/IOSurfaceRef.h>
+
 #include "flutter/display_list/image/dl_image.h"
 #include "impeller/base/validation.h"
 #include "impeller/display_list/display_list_image_impeller.h"
@@ -25,6 +28,10 @@ FLUTTER_ASSERT_ARC
   CVPixelBufferRef _lastPixelBuffer;
   OSType _pixelFormat;
   BOOL _enableImpeller;
+  // Whether |_externalImage| was made from |_lastPixelBuffer|, and the seed of the IOSurface of the
+  // pixel buffer at that time. The seed changes whenever the surface is modified.
+  BOOL _externalImageIsCurrent;
+  uint32_t _externalImageSurfaceSeed;
 }
 
 - (instancetype)initWithTextureCache:(nonnull CVMetalTextureCacheRef)textureCache
@@ -75,9 +82,22 @@ FLUTTER_ASSERT_ARC
 
 - (void)onNeedsUpdatedTexture:(flutter::Texture::PaintContext&)context {
   CVPixelBufferRef pixelBuffer = [_externalTexture copyPixelBuffer];
+  if (pixelBuffer && pixelBuffer == _lastPixelBuffer && _externalImage && _externalImageIsCurrent) {
+    // Producers often mark a frame available more often than they produce one, and hand out the
+    // same pixel buffer again. A pool cannot recycle the buffer while it is retained here, so it
+    // holds the same frame unless its surface was written to. Skip wrapping it again, which for
+    // YUV frames on Impeller is a conversion pass into a new texture.
+    IOSurfaceRef surface = CVPixelBufferGetIOSurface(pixelBuffer);
+    if (surface && IOSurfaceGetSeed(surface) == _externalImageSurfaceSeed) {
+      CVPixelBufferRelease(pixelBuffer);
+      _textureFrameAvailable = false;
+      return;
+    }
+  }
   if (pixelBuffer) {
     CVPixelBufferRelease(_lastPixelBuffer);
     _lastPixelBuffer = pixelBuffer;
+    _externalImageIsCurrent = NO;
     _pixelFormat = CVPixelBufferGetPixelFormatType(_lastPixelBuffer);
   }
 
@@ -87,6 +107,9 @@ FLUTTER_ASSERT_ARC
   if (image) {
     _externalImage = image;
     _textureFrameAvailable = false;
+    IOSurfaceRef surface = CVPixelBufferGetIOSurface(_lastPixelBuffer);
+    _externalImageIsCurrent = surface != nullptr;
+    _externalImageSurfaceSeed = surface ? IOSurfaceGetSeed(surface) : 0;
   }
 }
 
@@ -102,6 +125,7 @@ FLUTTER_ASSERT_ARC
   // buffer will be used to materialize the image in case the application fails to provide a new
   // one.
   _externalImage.reset();
+  _externalImageIsCurrent = NO;
   CVMetalTextureCacheFlush(_textureCache,  // cache
                            0               // options (must be zero)
   );
@@ -31,6 +31,7 @@
 #import "flutter/shell/platform/darwin/ios/framework/Source/FlutterUndoManagerPlugin.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/FlutterViewController_Internal.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/connection_collection.h"
+#import "flutter/shell/platform/darwin/ios/framework/Source/image_generator_ios.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/platform_message_response_darwin.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/profiler_metrics_ios.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/vsync_waiter_ios.h"
@@ -730,6 +731,14 @@ static constexpr int kNumProfilerSamplesPerSec = 5;
 - (void)setupShell:(std::unique_ptr<flutter::Shell>)shell
     withVMServicePublication:(BOOL)doesVMServicePublication {
   _shell = std::move(shell);
+  if (_shell->GetSettings().prefer_platform_image_decoders) {
+    // Takes precedence over the builtin decoders, which are registered at priority 0.
+    _shell->RegisterImageDecoder(
+        [](sk_sp<SkData> buffer) {
+          return flutter::ImageGeneratorIOS::MakeFromData(std::move(buffer));
+        },
+        1);
+  }
   [self setupChannels];
   [self onLocaleUpdated:nil];
   [self initializeDisplays];
@@ -114,6 +114,10 @@ class FlutterPlatformViewsTestMockPlatformViewDelegate : public PlatformView::De
   void LoadDartDeferredLibraryError(intptr_t loading_unit_id,
                                     const std::string error_message,
                                     bool transient) override {}
+  void PrefetchDartDeferredLibrary(intptr_t loading_unit_id,
+                                   std::unique_ptr<const fml::Mapping> snapshot_data,
+                                   std::unique_ptr<const fml::Mapping> snapshot_instructions) override {
+  }
   void UpdateAssetResolverByType(std::unique_ptr<flutter::AssetResolver> updated_asset_resolver,
                                  flutter::AssetResolver::AssetResolverType type) override {}
 
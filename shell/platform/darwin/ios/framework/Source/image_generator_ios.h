@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_DARWIN_IOS_FRAMEWORK_SOURCE_IMAGE_GENERATOR_IOS_H_
+#define FLUTTER_SHELL_PLATFORM_DARWIN_IOS_FRAMEWORK_SOURCE_IMAGE_GENERATOR_IOS_H_
+
+#include <ImageIO/ImageIO.h>
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/platform/darwin/cf_utils.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Decodes JPEG and HEIF images with ImageIO, which uses the
+///             hardware decoders of the device. Images are decoded as
+///             thumbnails straight at the size they are requested at, instead
+///             of being decoded at their full size and scaled afterwards.
+///
+class ImageGeneratorIOS : public ImageGenerator {
+ public:
+  static std::shared_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+  ~ImageGeneratorIOS() override;
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override;
+
+ private:
+  // The data the image source reads from, without copying it.
+  const sk_sp<SkData> data_;
+  const fml::CFRef<CGImageSourceRef> source_;
+  const SkImageInfo image_info_;
+
+  ImageGeneratorIOS(sk_sp<SkData> data,
+                    fml::CFRef<CGImageSourceRef> source,
+                    const SkImageInfo& image_info);
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(ImageGeneratorIOS);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_DARWIN_IOS_FRAMEWORK_SOURCE_IMAGE_GENERATOR_IOS_H_
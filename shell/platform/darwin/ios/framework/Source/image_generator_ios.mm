@@ -0,0 +1,169 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#import "flutter/shell/platform/darwin/ios/framework/Source/image_generator_ios.h"
+
+#include <CoreGraphics/CoreGraphics.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/codec/SkCodecAnimation.h"
+
+namespace flutter {
+
+namespace {
+
+bool IsDecodedInHardware(CGImageSourceRef source) {
+  CFStringRef type = CGImageSourceGetType(source);
+  return type != nullptr && (CFStringCompare(type, CFSTR("public.jpeg"), 0) == kCFCompareEqualTo ||
+                             CFStringCompare(type, CFSTR("public.heic"), 0) == kCFCompareEqualTo);
+}
+
+int GetIntProperty(CFDictionaryRef properties, CFStringRef key) {
+  int value = 0;
+  auto number = static_cast<CFNumberRef>(CFDictionaryGetValue(properties, key));
+  if (number != nullptr) {
+    CFNumberGetValue(number, kCFNumberIntType, &value);
+  }
+  return value;
+}
+
+}  // namespace
+
+// static
+std::shared_ptr<ImageGenerator> ImageGeneratorIOS::MakeFromData(sk_sp<SkData> data) {
+  if (!data || data->isEmpty()) {
+    return nullptr;
+  }
+  fml::CFRef<CFDataRef> cf_data(CFDataCreateWithBytesNoCopy(
+      kCFAllocatorDefault, data->bytes(), data->size(), kCFAllocatorNull));
+  fml::CFRef<CGImageSourceRef> source(CGImageSourceCreateWithData(cf_data, nullptr));
+  // Animated images are left to the other generators.
+  if (!source || CGImageSourceGetCount(source) != 1 || !IsDecodedInHardware(source)) {
+    return nullptr;
+  }
+
+  fml::CFRef<CFDictionaryRef> properties(CGImageSourceCopyPropertiesAtIndex(source, 0, nullptr));
+  if (!properties) {
+    return nullptr;
+  }
+  int width = GetIntProperty(properties, kCGImagePropertyPixelWidth);
+  int height = GetIntProperty(properties, kCGImagePropertyPixelHeight);
+  if (width <= 0 || height <= 0) {
+    return nullptr;
+  }
+  // Thumbnails are created with the EXIF orientation applied, and orientations 5 to 8 are rotated
+  // by 90 degrees.
+  if (GetIntProperty(properties, kCGImagePropertyOrientation) >= 5) {
+    std::swap(width, height);
+  }
+  auto has_alpha =
+      static_cast<CFBooleanRef>(CFDictionaryGetValue(properties, kCGImagePropertyHasAlpha));
+  const SkAlphaType alpha_type = has_alpha != nullptr && CFBooleanGetValue(has_alpha)
+                                     ? kPremul_SkAlphaType
+                                     : kOpaque_SkAlphaType;
+
+  return std::shared_ptr<ImageGenerator>(new ImageGeneratorIOS(
+      std::move(data), std::move(source),
+      SkImageInfo::Make(width, height, kRGBA_8888_SkColorType, alpha_type)));
+}
+
+ImageGeneratorIOS::ImageGeneratorIOS(sk_sp<SkData> data,
+                                     fml::CFRef<CGImageSourceRef> source,
+                                     const SkImageInfo& image_info)
+    : data_(std::move(data)), source_(std::move(source)), image_info_(image_info) {}
+
+ImageGeneratorIOS::~ImageGeneratorIOS() = default;
+
+const SkImageInfo& ImageGeneratorIOS::GetInfo() {
+  return image_info_;
+}
+
+unsigned int ImageGeneratorIOS::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int ImageGeneratorIOS::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo ImageGeneratorIOS::GetFrameInfo(unsigned int frame_index) {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize ImageGeneratorIOS::GetScaledDimensions(float desired_scale) {
+  // Thumbnails can be created at any size.
+  const float scale = std::clamp(desired_scale, 0.0f, 1.0f);
+  return SkISize::Make(std::max(1, static_cast<int>(std::round(image_info_.width() * scale))),
+                       std::max(1, static_cast<int>(std::round(image_info_.height() * scale))));
+}
+
+bool ImageGeneratorIOS::GetPixels(const SkImageInfo& info,
+                                  void* pixels,
+                                  size_t row_bytes,
+                                  unsigned int frame_index,
+                                  std::optional<unsigned int> prior_frame) {
+  TRACE_EVENT0("flutter", "ImageGeneratorIOS::GetPixels");
+  if (frame_index != 0 || info.colorType() != kRGBA_8888_SkColorType || info.isEmpty()) {
+    return false;
+  }
+  CGBitmapInfo bitmap_info = kCGBitmapByteOrder32Big;
+  switch (info.alphaType()) {
+    case kOpaque_SkAlphaType:
+      if (image_info_.alphaType() != kOpaque_SkAlphaType) {
+        return false;
+      }
+      bitmap_info |= kCGImageAlphaNoneSkipLast;
+      break;
+    case kPremul_SkAlphaType:
+      bitmap_info |= kCGImageAlphaPremultipliedLast;
+      break;
+    default:
+      return false;
+  }
+
+  const int max_pixel_size = std::max(info.width(), info.height());
+  fml::CFRef<CFNumberRef> cf_max_pixel_size(
+      CFNumberCreate(kCFAllocatorDefault, kCFNumberIntType, &max_pixel_size));
+  const void* keys[] = {
+      kCGImageSourceCreateThumbnailFromImageAlways,
+      kCGImageSourceCreateThumbnailWithTransform,
+      kCGImageSourceShouldCacheImmediately,
+      kCGImageSourceThumbnailMaxPixelSize,
+  };
+  const void* values[] = {
+      kCFBooleanTrue,
+      kCFBooleanTrue,
+      kCFBooleanTrue,
+      cf_max_pixel_size,
+  };
+  fml::CFRef<CFDictionaryRef> options(CFDictionaryCreate(
+      kCFAllocatorDefault, keys, values, sizeof(keys) / sizeof(keys[0]),
+      &kCFTypeDictionaryKeyCallBacks, &kCFTypeDictionaryValueCallBacks));
+  fml::CFRef<CGImageRef> image(CGImageSourceCreateThumbnailAtIndex(source_, 0, options));
+  if (!image) {
+    FML_DLOG(ERROR) << "Could not decode image with ImageIO.";
+    return false;
+  }
+
+  fml::CFRef<CGColorSpaceRef> color_space(CGColorSpaceCreateWithName(kCGColorSpaceSRGB));
+  fml::CFRef<CGContextRef> context(CGBitmapContextCreate(
+      pixels, info.width(), info.height(), 8, row_bytes, color_space, bitmap_info));
+  if (!context) {
+    return false;
+  }
+  // The thumbnail size is rounded differently than the requested size, which the drawing scales
+  // it to.
+  CGContextSetInterpolationQuality(context, kCGInterpolationHigh);
+  CGContextSetBlendMode(context, kCGBlendModeCopy);
+  CGContextDrawImage(context, CGRectMake(0, 0, info.width(), info.height()), image);
+  return true;
+}
+
+}  // namespace flutter
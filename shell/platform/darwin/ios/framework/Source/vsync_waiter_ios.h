@@ -82,7 +82,12 @@ class VsyncWaiterIOS final : public VsyncWaiter, public VariableRefreshRateRepor
 
  private:
   fml::scoped_nsobject<VSyncClient> client_;
+  // The max refresh rate the display link was last set to.
   double max_refresh_rate_;
+  double preferred_frame_rate_ = 0;
+
+  // |VsyncWaiter|
+  void OnPreferredFrameRateChanged(double frame_rate) override;
 
   FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiterIOS);
 };
@@ -49,6 +49,11 @@ void VsyncWaiterIOS::AwaitVSync() {
     // the same time.
     new_max_refresh_rate = 80;
   }
+  if (preferred_frame_rate_ > 0) {
+    // The engine doesn't need frames as fast as the display can produce them, let it refresh at a
+    // lower rate to save power.
+    new_max_refresh_rate = fmin(new_max_refresh_rate, preferred_frame_rate_);
+  }
   if (fabs(new_max_refresh_rate - max_refresh_rate_) > kRefreshRateDiffToIgnore) {
     max_refresh_rate_ = new_max_refresh_rate;
     [client_.get() setMaxRefreshRate:max_refresh_rate_];
@@ -56,6 +61,12 @@ void VsyncWaiterIOS::AwaitVSync() {
   [client_.get() await];
 }
 
+// |VsyncWaiter|
+void VsyncWaiterIOS::OnPreferredFrameRateChanged(double frame_rate) {
+  // Applied at the next |AwaitVSync|.
+  preferred_frame_rate_ = frame_rate;
+}
+
 // |VariableRefreshRateReporter|
 double VsyncWaiterIOS::GetRefreshRate() const {
   return [client_.get() getRefreshRate];
@@ -46,6 +46,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/window/shared_ring.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -632,12 +633,16 @@ InferSoftwarePlatformViewCreationCallback(
       [software_dispatch_table, platform_dispatch_table,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
+        // Frames are rasterized in tiles on the concurrent workers of the VM.
+        auto tile_task_runner =
+            shell.GetDartVM()->GetConcurrentWorkerTaskRunner();
         return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                             // delegate
-            shell.GetTaskRunners(),            // task runners
-            software_dispatch_table,           // software dispatch table
-            platform_dispatch_table,           // platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
+            shell,                              // delegate
+            shell.GetTaskRunners(),             // task runners
+            software_dispatch_table,            // software dispatch table
+            platform_dispatch_table,            // platform dispatch table
+            std::move(external_view_embedder),  // external view embedder
+            tile_task_runner                    // tile task runner
         );
       });
 }
@@ -2363,9 +2368,20 @@ FlutterEngineResult FlutterEngineSendKeyEvent(FLUTTER_API_SYMBOL(FlutterEngine)
       message_data);
 }
 
-FlutterEngineResult FlutterEngineSendPlatformMessage(
+static FlutterEngineResult SendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
-    const FlutterPlatformMessage* flutter_message) {
+    const FlutterPlatformMessage* flutter_message,
+    bool takes_ownership) {
+  // Buffers handed over to the engine are freed even if the message cannot be
+  // sent, so that the embedder never has to track whether they were consumed.
+  fml::MallocMapping owned_data =
+      takes_ownership && flutter_message != nullptr
+          ? fml::MallocMapping(
+                const_cast<uint8_t*>(
+                    SAFE_ACCESS(flutter_message, message, nullptr)),
+                SAFE_ACCESS(flutter_message, message_size, 0))
+          : fml::MallocMapping();
+
   if (engine == nullptr) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
   }
@@ -2403,7 +2419,9 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
   } else {
     message = std::make_unique<flutter::PlatformMessage>(
         flutter_message->channel,
-        fml::MallocMapping::Copy(message_data, message_size), response);
+        takes_ownership ? std::move(owned_data)
+                        : fml::MallocMapping::Copy(message_data, message_size),
+        response);
   }
 
   return reinterpret_cast<flutter::EmbedderEngine*>(engine)
@@ -2414,6 +2432,18 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
                                   "Flutter application.");
 }
 
+FlutterEngineResult FlutterEngineSendPlatformMessage(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message) {
+  return SendPlatformMessage(engine, flutter_message, false);
+}
+
+FlutterEngineResult FlutterEngineSendPlatformMessageTakingOwnership(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* flutter_message) {
+  return SendPlatformMessage(engine, flutter_message, true);
+}
+
 FlutterEngineResult FlutterPlatformMessageCreateResponseHandle(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterDataCallback data_callback,
@@ -2697,6 +2727,26 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                   "Could not run the specified task.");
 }
 
+FlutterEngineResult FlutterEngineRunExpiredTasks(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner,
+    size_t* tasks_run_out) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  auto tasks_run = reinterpret_cast<flutter::EmbedderEngine*>(engine)
+                       ->RunExpiredTasks(task_runner);
+  if (!tasks_run.has_value()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Could not find the specified task runner.");
+  }
+  if (tasks_run_out != nullptr) {
+    *tasks_run_out = tasks_run.value();
+  }
+  return kSuccess;
+}
+
 static bool DispatchJSONPlatformMessage(FLUTTER_API_SYMBOL(FlutterEngine)
                                             engine,
                                         const rapidjson::Document& document,
@@ -2938,6 +2988,78 @@ FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
                    "Could not dispatch the low memory notification message.");
 }
 
+struct _FlutterEngineSharedRing {
+  fml::RefPtr<flutter::SharedRingBuffer> ring;
+};
+
+FlutterEngineResult FlutterEngineCreateSharedRing(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t capacity,
+    FlutterEngineDartPort port,
+    FlutterEngineSharedRing* ring_out,
+    int64_t* identifier_out) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine not running.");
+  }
+
+  if (port == ILLEGAL_PORT) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Attempted to create a shared ring with an "
+                              "illegal port.");
+  }
+
+  if (ring_out == nullptr || identifier_out == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The shared ring and its identifier must be "
+                              "returned to the embedder.");
+  }
+
+  auto ring = flutter::SharedRingBuffer::Create(capacity, port);
+  if (!ring) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid shared ring capacity.");
+  }
+
+  *identifier_out = ring->identifier();
+  *ring_out = new _FlutterEngineSharedRing{std::move(ring)};
+  return kSuccess;
+}
+
+FlutterEngineResult FlutterEngineSharedRingWrite(FlutterEngineSharedRing ring,
+                                                 const uint8_t* data,
+                                                 size_t size) {
+  if (ring == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid shared ring.");
+  }
+
+  if (data == nullptr && size > 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Message data must not be null if its size is "
+                              "not zero.");
+  }
+
+  // A full ring is expected when the isolate falls behind, so it is left to
+  // the embedder to report.
+  return ring->ring->Write(data, size) ? kSuccess : kInternalInconsistency;
+}
+
+FlutterEngineResult FlutterEngineCollectSharedRing(
+    FlutterEngineSharedRing ring) {
+  if (ring == nullptr) {
+    // Deleting a null object should be a no-op.
+    return kSuccess;
+  }
+
+  // Created in `FlutterEngineCreateSharedRing`.
+  ring->ring->Close();
+  delete ring;
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEnginePostCallbackOnAllNativeThreads(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     FlutterNativeThreadCallback callback,
@@ -3060,6 +3182,56 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
   return kSuccess;
 }
 
+FlutterEngineResult FlutterEngineGetFrameTimingPercentiles(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingMetric metric,
+    FlutterFrameTimingPercentiles* percentiles) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid engine handle.");
+  }
+
+  if (percentiles == nullptr ||
+      percentiles->struct_size < sizeof(FlutterFrameTimingPercentiles)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Invalid frame timing percentiles.");
+  }
+
+  flutter::FrameTimingHistograms::Metric histogram_metric;
+  switch (metric) {
+    case kFlutterFrameTimingMetricBuildTime:
+      histogram_metric = flutter::FrameTimingHistograms::Metric::kBuildTime;
+      break;
+    case kFlutterFrameTimingMetricRasterTime:
+      histogram_metric = flutter::FrameTimingHistograms::Metric::kRasterTime;
+      break;
+    case kFlutterFrameTimingMetricVsyncOverhead:
+      histogram_metric =
+          flutter::FrameTimingHistograms::Metric::kVsyncOverhead;
+      break;
+    case kFlutterFrameTimingMetricLatency:
+      histogram_metric = flutter::FrameTimingHistograms::Metric::kLatency;
+      break;
+    default:
+      return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                "Invalid frame timing metric.");
+  }
+
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  if (!embedder_engine->IsValid()) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine not running.");
+  }
+
+  const auto result =
+      embedder_engine->GetShell().GetFrameTimingHistograms().GetPercentiles(
+          histogram_metric);
+  percentiles->frame_count = result.frame_count;
+  percentiles->p50_micros = result.p50.ToMicroseconds();
+  percentiles->p90_micros = result.p90.ToMicroseconds();
+  percentiles->p99_micros = result.p99.ToMicroseconds();
+  percentiles->max_micros = result.max.ToMicroseconds();
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEngineGetProcAddresses(
     FlutterEngineProcTable* table) {
   if (!table) {
@@ -3112,6 +3284,13 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
   SET_PROC(ScheduleFrame, FlutterEngineScheduleFrame);
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
+  SET_PROC(GetFrameTimingPercentiles, FlutterEngineGetFrameTimingPercentiles);
+  SET_PROC(SendPlatformMessageTakingOwnership,
+           FlutterEngineSendPlatformMessageTakingOwnership);
+  SET_PROC(CreateSharedRing, FlutterEngineCreateSharedRing);
+  SET_PROC(SharedRingWrite, FlutterEngineSharedRingWrite);
+  SET_PROC(CollectSharedRing, FlutterEngineCollectSharedRing);
+  SET_PROC(RunExpiredTasks, FlutterEngineRunExpiredTasks);
 #undef SET_PROC
 
   return kSuccess;
@@ -371,6 +371,13 @@ typedef struct {
   size_t width;
   /// Height of the texture.
   size_t height;
+  /// Optional. A `GLsync` fence, created in the share group of the engine's
+  /// GL context, that is signaled once the embedder is done writing to the
+  /// texture. The engine waits for the fence on the GPU before sampling the
+  /// texture, so that the embedder doesn't have to call `glFinish` before
+  /// returning it. The fence must stay valid until the destruction callback is
+  /// invoked.
+  void* sync;
 } FlutterOpenGLTexture;
 
 typedef struct {
@@ -588,6 +595,9 @@ typedef const void* FlutterMetalCommandQueueHandle;
 /// Alias for id<MTLTexture>.
 typedef const void* FlutterMetalTextureHandle;
 
+/// Alias for id<MTLSharedEvent>.
+typedef const void* FlutterMetalSharedEventHandle;
+
 /// Pixel format for the external texture.
 typedef enum {
   kYUVA,
@@ -622,6 +632,13 @@ typedef struct {
   FlutterMetalTextureHandle* textures;
   /// The YUV color space of the YUV external texture.
   FlutterMetalExternalTextureYUVColorSpace yuv_color_space;
+  /// Optional. An event that reaches `shared_event_value` once the embedder
+  /// is done writing to the textures. The engine waits for it on the GPU
+  /// before sampling the textures, so that the embedder doesn't have to wait
+  /// for its command buffers to complete before returning them.
+  FlutterMetalSharedEventHandle shared_event;
+  /// The value of `shared_event` that signals the textures are ready.
+  uint64_t shared_event_value;
 } FlutterMetalExternalTexture;
 
 /// Callback to provide an external texture for a given texture_id.
@@ -1349,6 +1366,13 @@ typedef struct {
   /// A unique identifier for the task runner. If multiple task runners service
   /// tasks on the same thread, their identifiers must match.
   size_t identifier;
+  /// Whether the embedder runs the tasks of this task runner in batches with
+  /// `FlutterEngineRunExpiredTasks` instead of one by one with
+  /// `FlutterEngineRunTask`. If true, the `post_task_callback` is only invoked
+  /// when the embedder needs to run expired tasks at the given target time,
+  /// and the task handle it is given must not be passed to
+  /// `FlutterEngineRunTask`.
+  bool batch_tasks;
 } FlutterTaskRunnerDescription;
 
 typedef struct {
@@ -1363,6 +1387,13 @@ typedef struct {
   /// run. The same task runner description can be specified for both the render
   /// and platform task runners. This makes the Flutter engine use the same
   /// thread for both task runners.
+  ///
+  /// Each engine rasterizes its view on its own render task runner. Embedders
+  /// that show several views, each with its own engine, should give every
+  /// engine a different render task runner, or leave this null to have the
+  /// engine create a raster thread, so that a view that is slow to rasterize
+  /// does not delay the others. Engines that share a render task runner
+  /// rasterize their views one after the other.
   const FlutterTaskRunnerDescription* render_task_runner;
   /// Specify a callback that is used to set the thread priority for embedder
   /// task runners.
@@ -1576,6 +1607,17 @@ typedef struct {
   FlutterPoint offset;
   /// The size of the layer (in physical pixels).
   FlutterSize size;
+  /// The area of the backing store (in physical pixels) whose contents differ
+  /// from what the previous frame presented in the same place, that is, in
+  /// the backing store layer above the same platform view, or in the bottom
+  /// layer. A damage region without rectangles means nothing changed. The
+  /// whole backing store is damaged in the first frame, and after the size or
+  /// transformation of the root surface changes. Null on layers that are not
+  /// of type `kFlutterLayerContentTypeBackingStore`.
+  ///
+  /// Compositors may use this to only re-composite the parts of the screen
+  /// that changed. The engine always renders the entire backing store.
+  const FlutterDamage* backing_store_damage;
 } FlutterLayer;
 
 typedef bool (*FlutterBackingStoreCreateCallback)(
@@ -1687,8 +1729,40 @@ typedef enum {
   kFlutterEngineDisplaysUpdateTypeCount,
 } FlutterEngineDisplaysUpdateType;
 
+/// A duration measured for each rasterized frame, whose percentiles are
+/// returned by `FlutterEngineGetFrameTimingPercentiles`.
+typedef enum {
+  /// From the start to the end of the frame build on the UI thread.
+  kFlutterFrameTimingMetricBuildTime,
+  /// From the start to the end of the frame rasterization on the raster
+  /// thread.
+  kFlutterFrameTimingMetricRasterTime,
+  /// From the vsync signal to the start of the frame build.
+  kFlutterFrameTimingMetricVsyncOverhead,
+  /// From the vsync signal to the end of the frame rasterization.
+  kFlutterFrameTimingMetricLatency,
+} FlutterFrameTimingMetric;
+
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTimingPercentiles).
+  size_t struct_size;
+  /// The number of frames rasterized by the engine so far.
+  uint64_t frame_count;
+  /// The median duration, in microseconds.
+  uint64_t p50_micros;
+  /// The 90th percentile duration, in microseconds.
+  uint64_t p90_micros;
+  /// The 99th percentile duration, in microseconds.
+  uint64_t p99_micros;
+  /// The longest duration, in microseconds.
+  uint64_t max_micros;
+} FlutterFrameTimingPercentiles;
+
 typedef int64_t FlutterEngineDartPort;
 
+/// A ring buffer created with `FlutterEngineCreateSharedRing`.
+typedef struct _FlutterEngineSharedRing* FlutterEngineSharedRing;
+
 typedef enum {
   kFlutterEngineDartObjectTypeNull,
   kFlutterEngineDartObjectTypeBool,
@@ -2284,6 +2358,30 @@ FlutterEngineResult FlutterEngineSendPlatformMessage(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPlatformMessage* message);
 
+//------------------------------------------------------------------------------
+/// @brief      Sends a platform message to the engine like
+///             `FlutterEngineSendPlatformMessage`, but hands the message data
+///             over to the engine instead of having it copied.
+///
+///             The `message` buffer of the platform message must have been
+///             allocated with `malloc`. The engine takes ownership of it and
+///             releases it with `free` once the message has been consumed,
+///             including when this call fails. Large messages are delivered
+///             to the Dart application without any further copies, so this
+///             variant should be preferred for messages of more than a few
+///             kilobytes, such as images or files.
+///
+/// @param[in]  engine   A running engine instance.
+/// @param[in]  message  The platform message to send. The embedder must not
+///                      access `message->message` after this call.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSendPlatformMessageTakingOwnership(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message);
+
 //------------------------------------------------------------------------------
 /// @brief     Creates a platform message response handle that allows the
 ///            embedder to set a native callback for a response to a message.
@@ -2613,6 +2711,26 @@ FlutterEngineResult FlutterEngineRunTask(FLUTTER_API_SYMBOL(FlutterEngine)
                                              engine,
                                          const FlutterTask* task);
 
+//------------------------------------------------------------------------------
+/// @brief      Inform the engine to run all the tasks of a task runner whose
+///             target time has passed, in order of their target times. The
+///             task runner must have been described with `batch_tasks` set,
+///             and this call must be made on the thread associated with it.
+///             Tasks posted while this call runs are left to the next one.
+///
+/// @param[in]  engine          A running engine instance.
+/// @param[in]  task_runner     The task runner given to the
+///                             `post_task_callback`.
+/// @param[out] tasks_run_out   Optional. The number of tasks that were run.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRunExpiredTasks(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner,
+    size_t* tasks_run_out);
+
 //------------------------------------------------------------------------------
 /// @brief      Notify a running engine instance that the locale has been
 ///             updated. The preferred locale must be the first item in the list
@@ -2703,6 +2821,77 @@ FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineNotifyLowMemoryWarning(
     FLUTTER_API_SYMBOL(FlutterEngine) engine);
 
+//------------------------------------------------------------------------------
+/// @brief      Creates a ring buffer that the embedder writes messages to and
+///             that a Dart isolate reads in place, using the `SharedRing`
+///             class of `dart:ui`.
+///
+///             This is an alternative to platform messages for plugins that
+///             stream many small messages, such as sensor samples. Writing to
+///             a ring does not post a task to the engine for each message,
+///             and the messages are not copied again before the Dart
+///             application reads them. The ring only posts its identifier to
+///             `port` when a message is written while the isolate waits for
+///             one.
+///
+///             The identifier of the ring must be passed to the isolate, for
+///             example with `FlutterEnginePostDartObject`, so that it can call
+///             `SharedRing.attach`.
+///
+/// @param[in]  engine         A running engine instance.
+/// @param[in]  capacity       The size of the ring in bytes. Each message
+///                            takes its size rounded up to a multiple of 4,
+///                            plus 4 bytes.
+/// @param[in]  port           The port that the isolate reading the ring
+///                            listens on.
+/// @param[out] ring_out       The created ring. It must be collected with
+///                            `FlutterEngineCollectSharedRing`.
+/// @param[out] identifier_out The identifier of the ring.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCreateSharedRing(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t capacity,
+    FlutterEngineDartPort port,
+    FlutterEngineSharedRing* ring_out,
+    int64_t* identifier_out);
+
+//------------------------------------------------------------------------------
+/// @brief      Copies a message into a ring created with
+///             `FlutterEngineCreateSharedRing`.
+///
+///             Messages may be written on any thread, but only one thread may
+///             write to a given ring at a time.
+///
+/// @param[in]  ring  The ring to write to.
+/// @param[in]  data  The message.
+/// @param[in]  size  The size of the message in bytes.
+///
+/// @return     `kSuccess` if the message was written, or
+///             `kInternalInconsistency` if the ring does not have enough free
+///             space for it. Messages that do not fit are not logged, so that
+///             the embedder can retry them later or drop them.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineSharedRingWrite(FlutterEngineSharedRing ring,
+                                                 const uint8_t* data,
+                                                 size_t size);
+
+//------------------------------------------------------------------------------
+/// @brief      Collects a ring created with `FlutterEngineCreateSharedRing`.
+///             Isolates can no longer attach to the ring, but the ones that
+///             already did may read the messages that are left.
+///
+/// @param[in]  ring  The ring to collect.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineCollectSharedRing(
+    FlutterEngineSharedRing ring);
+
 //------------------------------------------------------------------------------
 /// @brief      Schedule a callback to be run on all engine managed threads.
 ///             The engine will attempt to service this callback the next time
@@ -2790,6 +2979,26 @@ FlutterEngineResult FlutterEngineSetNextFrameCallback(
     VoidCallback callback,
     void* user_data);
 
+//------------------------------------------------------------------------------
+/// @brief      Gets the percentiles of a duration measured for every frame
+///             the engine has rasterized so far. The engine keeps these in
+///             histograms whose precision is about three percent, whether or
+///             not the frame timings are reported to Dart. Can be called on
+///             any thread.
+///
+/// @param[in]  engine       A running engine instance.
+/// @param[in]  metric       The frame duration to get the percentiles of.
+/// @param[out] percentiles  The percentiles of the duration. Its
+///                          `struct_size` must be set by the caller.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineGetFrameTimingPercentiles(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingMetric metric,
+    FlutterFrameTimingPercentiles* percentiles);
+
 #endif  // !FLUTTER_ENGINE_NO_PROTOTYPES
 
 // Typedefs for the function pointers in FlutterEngineProcTable.
@@ -2912,6 +3121,30 @@ typedef FlutterEngineResult (*FlutterEngineSetNextFrameCallbackFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     VoidCallback callback,
     void* user_data);
+typedef FlutterEngineResult (*FlutterEngineGetFrameTimingPercentilesFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterFrameTimingMetric metric,
+    FlutterFrameTimingPercentiles* percentiles);
+typedef FlutterEngineResult (
+    *FlutterEngineSendPlatformMessageTakingOwnershipFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPlatformMessage* message);
+typedef FlutterEngineResult (*FlutterEngineCreateSharedRingFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t capacity,
+    FlutterEngineDartPort port,
+    FlutterEngineSharedRing* ring_out,
+    int64_t* identifier_out);
+typedef FlutterEngineResult (*FlutterEngineSharedRingWriteFnPtr)(
+    FlutterEngineSharedRing ring,
+    const uint8_t* data,
+    size_t size);
+typedef FlutterEngineResult (*FlutterEngineCollectSharedRingFnPtr)(
+    FlutterEngineSharedRing ring);
+typedef FlutterEngineResult (*FlutterEngineRunExpiredTasksFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterTaskRunner task_runner,
+    size_t* tasks_run_out);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -2958,6 +3191,13 @@ typedef struct {
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
   FlutterEngineScheduleFrameFnPtr ScheduleFrame;
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
+  FlutterEngineGetFrameTimingPercentilesFnPtr GetFrameTimingPercentiles;
+  FlutterEngineSendPlatformMessageTakingOwnershipFnPtr
+      SendPlatformMessageTakingOwnership;
+  FlutterEngineCreateSharedRingFnPtr CreateSharedRing;
+  FlutterEngineSharedRingWriteFnPtr SharedRingWrite;
+  FlutterEngineCollectSharedRingFnPtr CollectSharedRing;
+  FlutterEngineRunExpiredTasksFnPtr RunExpiredTasks;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
@@ -246,6 +246,12 @@ bool EmbedderEngine::RunTask(const FlutterTask* task) {
                                 task->task);
 }
 
+std::optional<size_t> EmbedderEngine::RunExpiredTasks(
+    FlutterTaskRunner runner) {
+  // Like `RunTask`, this doesn't need the shell to be running.
+  return thread_host_->RunExpiredTasks(reinterpret_cast<int64_t>(runner));
+}
+
 bool EmbedderEngine::PostTaskOnEngineManagedNativeThreads(
     const std::function<void(FlutterNativeThreadType)>& closure) const {
   if (!IsValid() || closure == nullptr) {
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_ENGINE_H_
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
@@ -79,6 +80,8 @@ class EmbedderEngine {
 
   bool RunTask(const FlutterTask* task);
 
+  std::optional<size_t> RunExpiredTasks(FlutterTaskRunner runner);
+
   bool PostTaskOnEngineManagedNativeThreads(
       const std::function<void(FlutterNativeThreadType)>& closure) const;
 
@@ -12,6 +12,7 @@
 #include "third_party/skia/include/core/SkColorType.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/gpu/GrBackendSemaphore.h"
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 #include "third_party/skia/include/gpu/ganesh/SkImageGanesh.h"
@@ -66,6 +67,17 @@ sk_sp<DlImage> EmbedderExternalTextureGL::ResolveTexture(
     return nullptr;
   }
 
+  if (texture->sync != nullptr) {
+    // Make the GPU wait for the embedder's writes to the texture, instead of
+    // the embedder blocking on them.
+    GrBackendSemaphore semaphore;
+    semaphore.initGL(static_cast<GrGLsync>(texture->sync));
+    if (!context->wait(1, &semaphore, /*deleteSemaphoresAfterWait=*/false)) {
+      FML_LOG(ERROR) << "Could not wait for the sync fence of external texture "
+                     << texture_id << ".";
+    }
+  }
+
   GrGLTextureInfo gr_texture_info = {texture->target, texture->name,
                                      texture->format};
 
@@ -9,6 +9,7 @@
 #import "flutter/shell/platform/darwin/graphics/FlutterDarwinExternalTextureMetal.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/gpu/GrBackendSemaphore.h"
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
@@ -64,6 +65,16 @@ sk_sp<DlImage> EmbedderExternalTextureMetal::ResolveTexture(int64_t texture_id,
     return nullptr;
   }
 
+  if (texture->shared_event != nullptr) {
+    // Make the GPU wait for the embedder's writes to the textures, instead of
+    // the embedder blocking on them.
+    GrBackendSemaphore semaphore;
+    semaphore.initMetal(texture->shared_event, texture->shared_event_value);
+    if (!context->wait(1, &semaphore, /*deleteSemaphoresAfterWait=*/false)) {
+      FML_LOG(ERROR) << "Could not wait for the shared event of external texture: " << texture_id;
+    }
+  }
+
   sk_sp<SkImage> image;
 
   switch (texture->pixel_format) {
@@ -37,7 +37,7 @@ EmbedderExternalView::~EmbedderExternalView() = default;
 
 EmbedderExternalView::RenderTargetDescriptor
 EmbedderExternalView::CreateRenderTargetDescriptor() const {
-  return {view_identifier_, render_surface_size_};
+  return RenderTargetDescriptor{render_surface_size_};
 }
 
 DlCanvas* EmbedderExternalView::GetCanvas() {
@@ -106,6 +106,30 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
   return true;
 }
 
+sk_sp<DisplayList> EmbedderExternalView::GetDisplayList() {
+  TryEndRecording();
+  return slice_->display_list();
+}
+
+SkIRect EmbedderExternalView::ComputeDamage(
+    const sk_sp<DisplayList>& previous_contents) {
+  const auto surface_rect = SkIRect::MakeSize(render_surface_size_);
+  const auto contents = GetDisplayList();
+  if (!previous_contents || !contents) {
+    return surface_rect;
+  }
+  if (contents->Equals(previous_contents.get())) {
+    return SkIRect::MakeEmpty();
+  }
+  auto bounds = contents->bounds();
+  bounds.join(previous_contents->bounds());
+  auto damage = surface_transformation_.mapRect(bounds).roundOut();
+  if (!damage.intersect(surface_rect)) {
+    return SkIRect::MakeEmpty();
+  }
+  return damage;
+}
+
 void EmbedderExternalView::TryEndRecording() const {
   if (slice_->recording_ended()) {
     return;
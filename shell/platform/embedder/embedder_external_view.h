@@ -45,29 +45,26 @@ class EmbedderExternalView {
     };
   };
 
+  // Render targets are interchangeable between views as long as they match
+  // this description.
   struct RenderTargetDescriptor {
-    ViewIdentifier view_identifier;
     SkISize surface_size;
 
-    RenderTargetDescriptor(ViewIdentifier p_view_identifier,
-                           SkISize p_surface_size)
-        : view_identifier(p_view_identifier), surface_size(p_surface_size) {}
+    explicit RenderTargetDescriptor(SkISize p_surface_size)
+        : surface_size(p_surface_size) {}
 
     struct Hash {
       constexpr std::size_t operator()(
           const RenderTargetDescriptor& desc) const {
         return fml::HashCombine(desc.surface_size.width(),
-                                desc.surface_size.height(),
-                                ViewIdentifier::Hash{}(desc.view_identifier));
+                                desc.surface_size.height());
       }
     };
 
     struct Equal {
       bool operator()(const RenderTargetDescriptor& lhs,
                       const RenderTargetDescriptor& rhs) const {
-        return lhs.surface_size == rhs.surface_size &&
-               ViewIdentifier::Equal{}(lhs.view_identifier,
-                                       rhs.view_identifier);
+        return lhs.surface_size == rhs.surface_size;
       }
     };
   };
@@ -109,6 +106,14 @@ class EmbedderExternalView {
 
   bool Render(const EmbedderRenderTarget& render_target);
 
+  // The contents recorded for the render surface.
+  sk_sp<DisplayList> GetDisplayList();
+
+  // The area of the render surface whose contents differ from the display
+  // list the same view rendered in the previous frame. The whole surface is
+  // damaged if there is no previous display list.
+  SkIRect ComputeDamage(const sk_sp<DisplayList>& previous_contents);
+
  private:
   // End the recording of the slice.
   // Noop if the slice's recording has already ended.
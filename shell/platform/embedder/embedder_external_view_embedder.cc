@@ -216,6 +216,12 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
     EmbedderLayers presented_layers(pending_frame_size_,
                                     pending_device_pixel_ratio_,
                                     pending_surface_transformation_);
+    // The contents of the previous frame can only be compared with if they
+    // were rendered the same way.
+    const bool can_compute_damage =
+        presented_frame_size_ == pending_frame_size_ &&
+        presented_surface_transformation_ == pending_surface_transformation_;
+    decltype(presented_contents_) rendered_contents;
     // In composition order, submit backing stores and platform views to the
     // embedder.
     for (const auto& view_id : composition_order_) {
@@ -235,8 +241,17 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
       // platform view.
       if (external_view->HasEngineRenderedContents()) {
         const auto& exteral_render_target = matched_render_targets.at(view_id);
+        sk_sp<DisplayList> previous_contents;
+        if (can_compute_damage) {
+          auto found = presented_contents_.find(view_id);
+          if (found != presented_contents_.end()) {
+            previous_contents = found->second;
+          }
+        }
         presented_layers.PushBackingStoreLayer(
-            exteral_render_target->GetBackingStore());
+            exteral_render_target->GetBackingStore(),
+            external_view->ComputeDamage(previous_contents));
+        rendered_contents[view_id] = external_view->GetDisplayList();
       }
     }
 
@@ -244,6 +259,10 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
     //
     // @warning: Embedder may trample on our OpenGL context here.
     presented_layers.InvokePresentCallback(present_callback_);
+
+    presented_contents_ = std::move(rendered_contents);
+    presented_frame_size_ = pending_frame_size_;
+    presented_surface_transformation_ = pending_surface_transformation_;
   }
 
   // See why this is necessary in the comment where this collection in realized.
@@ -255,8 +274,7 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   // see if they may be reused next frame.
   for (auto& render_target : matched_render_targets) {
     if (!avoid_backing_store_cache_) {
-      render_target_cache_.CacheRenderTarget(render_target.first,
-                                             std::move(render_target.second));
+      render_target_cache_.CacheRenderTarget(std::move(render_target.second));
     }
   }
 
@@ -111,6 +111,15 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   EmbedderExternalView::PendingViews pending_views_;
   std::vector<EmbedderExternalView::ViewIdentifier> composition_order_;
   EmbedderRenderTargetCache render_target_cache_;
+  // What each view rendered in the last presented frame, to compute the
+  // damage of its layer in the next one.
+  std::unordered_map<EmbedderExternalView::ViewIdentifier,
+                     sk_sp<DisplayList>,
+                     EmbedderExternalView::ViewIdentifier::Hash,
+                     EmbedderExternalView::ViewIdentifier::Equal>
+      presented_contents_;
+  SkISize presented_frame_size_ = SkISize::Make(0, 0);
+  SkMatrix presented_surface_transformation_;
 
   void Reset();
 
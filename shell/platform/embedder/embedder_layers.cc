@@ -17,7 +17,8 @@ EmbedderLayers::EmbedderLayers(SkISize frame_size,
 
 EmbedderLayers::~EmbedderLayers() = default;
 
-void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store) {
+void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store,
+                                           std::optional<SkIRect> damage) {
   FlutterLayer layer = {};
 
   layer.struct_size = sizeof(FlutterLayer);
@@ -35,6 +36,24 @@ void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store) {
   layer.size.width = transformed_layer_bounds.width();
   layer.size.height = transformed_layer_bounds.height();
 
+  if (damage.has_value()) {
+    auto damage_rect = std::make_unique<FlutterRect>();
+    damage_rect->left = damage->left();
+    damage_rect->top = damage->top();
+    damage_rect->right = damage->right();
+    damage_rect->bottom = damage->bottom();
+
+    auto layer_damage = std::make_unique<FlutterDamage>();
+    layer_damage->struct_size = sizeof(FlutterDamage);
+    // An empty damage region tells the embedder nothing changed.
+    layer_damage->num_rects = damage->isEmpty() ? 0 : 1;
+    layer_damage->damage = damage_rect.get();
+
+    layer.backing_store_damage = layer_damage.get();
+    damage_rects_referenced_.push_back(std::move(damage_rect));
+    damages_referenced_.push_back(std::move(layer_damage));
+  }
+
   presented_layers_.push_back(layer);
 }
 
@@ -6,7 +6,17 @@
 
 namespace flutter {
 
-EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
+namespace {
+
+// Render targets are assumed to use 4 bytes per pixel.
+size_t GetRenderTargetBytes(const SkISize& size) {
+  return static_cast<size_t>(size.width()) * size.height() * 4;
+}
+
+}  // namespace
+
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(size_t max_cached_bytes)
+    : max_cached_bytes_(max_cached_bytes) {}
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
@@ -22,14 +32,15 @@ EmbedderRenderTargetCache::GetExistingTargetsInCache(
     if (!external_view->HasEngineRenderedContents()) {
       continue;
     }
-    auto& compatible_targets =
-        cached_render_targets_[external_view->CreateRenderTargetDescriptor()];
+    const auto desc = external_view->CreateRenderTargetDescriptor();
+    auto& compatible_targets = cached_render_targets_[desc];
     if (compatible_targets.empty()) {
       unmatched_identifiers.insert(view.first);
     } else {
       std::unique_ptr<EmbedderRenderTarget> target =
           std::move(compatible_targets.top());
       compatible_targets.pop();
+      cached_bytes_ -= GetRenderTargetBytes(desc.surface_size);
       resolved_render_targets[view.first] = std::move(target);
     }
   }
@@ -47,18 +58,24 @@ EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
     }
   }
   cached_render_targets_.clear();
+  cached_bytes_ = 0;
   return cleared_targets;
 }
 
 void EmbedderRenderTargetCache::CacheRenderTarget(
-    EmbedderExternalView::ViewIdentifier view_identifier,
     std::unique_ptr<EmbedderRenderTarget> target) {
   if (target == nullptr) {
     return;
   }
   auto surface = target->GetRenderSurface();
   auto desc = EmbedderExternalView::RenderTargetDescriptor{
-      view_identifier, SkISize::Make(surface->width(), surface->height())};
+      SkISize::Make(surface->width(), surface->height())};
+  const auto target_bytes = GetRenderTargetBytes(desc.surface_size);
+  if (cached_bytes_ + target_bytes > max_cached_bytes_) {
+    // The embedder collects targets that are over budget right away.
+    return;
+  }
+  cached_bytes_ += target_bytes;
   cached_render_targets_[desc].push(std::move(target));
 }
 
@@ -70,4 +87,8 @@ size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
   return count;
 }
 
+size_t EmbedderRenderTargetCache::GetCachedBytes() const {
+  return cached_bytes_;
+}
+
 }  // namespace flutter
@@ -19,9 +19,17 @@ namespace flutter {
 /// @brief      A cache used to reference render targets that are owned by the
 ///             embedder but needed by th engine to render a frame.
 ///
+///             Render targets are recycled between all views that need a
+///             render target of the same description, and only as many are
+///             held as fit in the memory budget of the cache.
+///
 class EmbedderRenderTargetCache {
  public:
-  EmbedderRenderTargetCache();
+  /// The default memory budget, enough for a handful of 4K layers.
+  static constexpr size_t kDefaultMaxCachedBytes = 256 * 1024 * 1024;
+
+  explicit EmbedderRenderTargetCache(
+      size_t max_cached_bytes = kDefaultMaxCachedBytes);
 
   ~EmbedderRenderTargetCache();
 
@@ -38,11 +46,12 @@ class EmbedderRenderTargetCache {
   std::set<std::unique_ptr<EmbedderRenderTarget>>
   ClearAllRenderTargetsInCache();
 
-  void CacheRenderTarget(EmbedderExternalView::ViewIdentifier view_identifier,
-                         std::unique_ptr<EmbedderRenderTarget> target);
+  void CacheRenderTarget(std::unique_ptr<EmbedderRenderTarget> target);
 
   size_t GetCachedTargetsCount() const;
 
+  size_t GetCachedBytes() const;
+
  private:
   using CachedRenderTargets =
       std::unordered_map<EmbedderExternalView::RenderTargetDescriptor,
@@ -50,7 +59,9 @@ class EmbedderRenderTargetCache {
                          EmbedderExternalView::RenderTargetDescriptor::Hash,
                          EmbedderExternalView::RenderTargetDescriptor::Equal>;
 
+  const size_t max_cached_bytes_;
   CachedRenderTargets cached_render_targets_;
+  size_t cached_bytes_ = 0;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
 };
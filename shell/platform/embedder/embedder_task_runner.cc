@@ -37,15 +37,26 @@ void EmbedderTaskRunner::PostTaskForTime(const fml::closure& task,
   }
 
   uint64_t baton = 0;
+  bool wake_embedder = true;
 
   {
     // Release the lock before the jump via the dispatch table.
     std::scoped_lock lock(tasks_mutex_);
     baton = ++last_baton_;
     pending_tasks_[baton] = task;
+    if (dispatch_table_.batch_tasks) {
+      task_deadlines_.push({target_time, baton});
+      wake_embedder =
+          !next_wake_time_.has_value() || target_time < next_wake_time_.value();
+      if (wake_embedder) {
+        next_wake_time_ = target_time;
+      }
+    }
   }
 
-  dispatch_table_.post_task_callback(this, baton, target_time);
+  if (wake_embedder) {
+    dispatch_table_.post_task_callback(this, baton, target_time);
+  }
 }
 
 void EmbedderTaskRunner::PostDelayedTask(const fml::closure& task,
@@ -53,6 +64,13 @@ void EmbedderTaskRunner::PostDelayedTask(const fml::closure& task,
   PostTaskForTime(task, fml::TimePoint::Now() + delay);
 }
 
+void EmbedderTaskRunner::PostIdleTask(const fml::closure& task,
+                                      fml::TimePoint deadline) {
+  // The embedder doesn't know when its thread is idle, run idle tasks at their
+  // deadline.
+  PostTaskForTime(task, deadline);
+}
+
 bool EmbedderTaskRunner::RunsTasksOnCurrentThread() {
   return dispatch_table_.runs_task_on_current_thread_callback();
 }
@@ -78,6 +96,57 @@ bool EmbedderTaskRunner::PostTask(uint64_t baton) {
   return true;
 }
 
+size_t EmbedderTaskRunner::RunExpiredTasks() {
+  // Tasks posted while the batch runs are left to the next one, even if they
+  // have expired, so that a task that keeps reposting itself can't starve the
+  // embedder's loop.
+  const auto now = fml::TimePoint::Now();
+  size_t run_count = 0;
+
+  while (true) {
+    fml::closure task;
+
+    {
+      std::scoped_lock lock(tasks_mutex_);
+      if (task_deadlines_.empty() || task_deadlines_.top().first > now) {
+        break;
+      }
+      auto found = pending_tasks_.find(task_deadlines_.top().second);
+      task_deadlines_.pop();
+      if (found == pending_tasks_.end()) {
+        // The task was already run via `PostTask(uint64_t)`.
+        continue;
+      }
+      task = std::move(found->second);
+      pending_tasks_.erase(found);
+
+      // Let go of the tasks mutex before executing the task.
+    }
+
+    FML_DCHECK(task);
+    task();
+    run_count++;
+  }
+
+  std::optional<TaskDeadline> next_deadline;
+
+  {
+    std::scoped_lock lock(tasks_mutex_);
+    if (task_deadlines_.empty()) {
+      next_wake_time_ = std::nullopt;
+    } else {
+      next_deadline = task_deadlines_.top();
+      next_wake_time_ = next_deadline->first;
+    }
+  }
+
+  if (next_deadline.has_value()) {
+    dispatch_table_.post_task_callback(this, next_deadline->second,
+                                       next_deadline->first);
+  }
+  return run_count;
+}
+
 // |fml::TaskRunner|
 fml::TaskQueueId EmbedderTaskRunner::GetTaskQueueId() {
   return placeholder_id_;
@@ -5,8 +5,13 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_TASK_RUNNER_H_
 
+#include <functional>
 #include <mutex>
+#include <optional>
+#include <queue>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
@@ -39,6 +44,14 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
     /// thread.
     ///
     std::function<bool(void)> runs_task_on_current_thread_callback;
+    //--------------------------------------------------------------------------
+    /// Whether the embedder runs the expired tasks of this task runner in
+    /// batches via `EmbedderTaskRunner::RunExpiredTasks`. If so, the
+    /// `post_task_callback` is only invoked when the embedder needs to wake
+    /// up, which is when a task is due before all the others it knows about
+    /// and after a batch that left tasks pending.
+    ///
+    bool batch_tasks = false;
   };
 
   //----------------------------------------------------------------------------
@@ -71,12 +84,32 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
 
   bool PostTask(uint64_t baton);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Runs all the tasks whose target time has passed, in order of
+  ///             their target times. Tasks are only tracked for this when the
+  ///             dispatch table batches tasks.
+  ///
+  /// @return     The number of tasks that were run.
+  ///
+  size_t RunExpiredTasks();
+
  private:
+  using TaskDeadline = std::pair<fml::TimePoint, uint64_t>;
+
   const size_t embedder_identifier_;
   DispatchTable dispatch_table_;
   std::mutex tasks_mutex_;
   uint64_t last_baton_ = 0;
   std::unordered_map<uint64_t, fml::closure> pending_tasks_;
+  // The batons of the pending tasks by target time, and for tasks with the
+  // same target time in the order they were posted. Only used when the
+  // dispatch table batches tasks.
+  std::priority_queue<TaskDeadline,
+                      std::vector<TaskDeadline>,
+                      std::greater<TaskDeadline>>
+      task_deadlines_;
+  // The earliest time the embedder was asked to run expired tasks at.
+  std::optional<fml::TimePoint> next_wake_time_;
   fml::TaskQueueId placeholder_id_;
 
   // |fml::TaskRunner|
@@ -89,6 +122,9 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
   // |fml::TaskRunner|
   void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay) override;
 
+  // |fml::TaskRunner|
+  void PostIdleTask(const fml::closure& task, fml::TimePoint deadline) override;
+
   // |fml::TaskRunner|
   bool RunsTasksOnCurrentThread() override;
 
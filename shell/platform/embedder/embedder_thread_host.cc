@@ -72,7 +72,9 @@ CreateEmbedderTaskRunner(const FlutterTaskRunnerDescription* description) {
       // runs_task_on_current_thread_callback
       [runs_task_on_current_thread_callback_c, user_data]() -> bool {
         return runs_task_on_current_thread_callback_c(user_data);
-      }};
+      },
+      // batch_tasks
+      SAFE_ACCESS(description, batch_tasks, false)};
 
   return {true, fml::MakeRefCounted<EmbedderTaskRunner>(
                     task_runner_dispatch_table,
@@ -295,4 +297,13 @@ bool EmbedderThreadHost::PostTask(int64_t runner, uint64_t task) const {
   return found->second->PostTask(task);
 }
 
+std::optional<size_t> EmbedderThreadHost::RunExpiredTasks(
+    int64_t runner) const {
+  auto found = runners_map_.find(runner);
+  if (found == runners_map_.end()) {
+    return std::nullopt;
+  }
+  return found->second->RunExpiredTasks();
+}
+
 }  // namespace flutter
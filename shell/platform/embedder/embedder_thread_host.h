@@ -7,6 +7,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 
 #include "flutter/common/task_runners.h"
@@ -38,6 +39,8 @@ class EmbedderThreadHost {
 
   bool PostTask(int64_t runner, uint64_t task) const;
 
+  std::optional<size_t> RunExpiredTasks(int64_t runner) const;
+
  private:
   ThreadHost host_;
   flutter::TaskRunners runners_;
@@ -51,14 +51,16 @@ class PlatformViewEmbedder final : public PlatformView {
     OnPreEngineRestartCallback on_pre_engine_restart_callback;  // optional
   };
 
-  // Create a platform view that sets up a software rasterizer.
+  // Create a platform view that sets up a software rasterizer. If a tile task
+  // runner is given, frames are split into tiles that are rasterized on it.
   PlatformViewEmbedder(
       PlatformView::Delegate& delegate,
       const flutter::TaskRunners& task_runners,
       const EmbedderSurfaceSoftware::SoftwareDispatchTable&
           software_dispatch_table,
       PlatformDispatchTable platform_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      std::shared_ptr<fml::BasicTaskRunner> tile_task_runner = nullptr);
 
 #ifdef SHELL_ENABLE_GL
   // Creates a platform view that sets up an OpenGL rasterizer.
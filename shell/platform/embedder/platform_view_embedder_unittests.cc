@@ -46,6 +46,10 @@ class MockDelegate : public PlatformView::Delegate {
                void(intptr_t loading_unit_id,
                     const std::string error_message,
                     bool transient));
+  MOCK_METHOD3(PrefetchDartDeferredLibrary,
+               void(intptr_t loading_unit_id,
+                    std::unique_ptr<const fml::Mapping> snapshot_data,
+                    std::unique_ptr<const fml::Mapping> snapshot_instructions));
   MOCK_METHOD2(UpdateAssetResolverByType,
                void(std::unique_ptr<AssetResolver> updated_asset_resolver,
                     AssetResolver::AssetResolverType type));
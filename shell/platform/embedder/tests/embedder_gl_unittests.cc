@@ -168,6 +168,56 @@ TEST_F(EmbedderTest, CompositorMustBeAbleToRenderToOpenGLFramebuffer) {
   latch.Wait();
 }
 
+TEST_F(EmbedderTest, CompositorReportsFullDamageForTheFirstFrame) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(800, 600));
+  builder.SetCompositor();
+  builder.SetDartEntrypoint("can_composite_platform_views");
+
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLFramebuffer);
+
+  fml::CountDownLatch latch(3);
+  context.GetCompositor().SetNextPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        ASSERT_EQ(layers_count, 3u);
+
+        for (size_t i : {0u, 2u}) {
+          const auto* damage = layers[i]->backing_store_damage;
+          ASSERT_NE(damage, nullptr);
+          ASSERT_EQ(damage->num_rects, 1u);
+          ASSERT_EQ(damage->damage[0].left, 0.0);
+          ASSERT_EQ(damage->damage[0].top, 0.0);
+          ASSERT_EQ(damage->damage[0].right, 800.0);
+          ASSERT_EQ(damage->damage[0].bottom, 600.0);
+        }
+        ASSERT_EQ(layers[1]->backing_store_damage, nullptr);
+
+        latch.CountDown();
+      });
+
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&latch](Dart_NativeArguments args) { latch.CountDown(); }));
+
+  auto engine = builder.LaunchEngine();
+
+  // Send a window metrics events so frames may be scheduled.
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+  ASSERT_TRUE(engine.is_valid());
+
+  latch.Wait();
+}
+
 //------------------------------------------------------------------------------
 /// Layers in a hierarchy containing a platform view should not be cached. The
 /// other layers in the hierarchy should be, however.
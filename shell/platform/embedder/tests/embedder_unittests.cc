@@ -10,6 +10,7 @@
 
 #include "embedder.h"
 #include "embedder_engine.h"
+#include "embedder_task_runner.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/make_copyable.h"
@@ -272,6 +273,42 @@ TEST(EmbedderTestNoFixture, CanGetCurrentTimeInNanoseconds) {
   ASSERT_LT((point2 - point1), fml::TimeDelta::FromMilliseconds(1));
 }
 
+TEST(EmbedderTestNoFixture, TaskRunnerRunsExpiredTasksInBatches) {
+  std::vector<fml::TimePoint> wake_times;
+  EmbedderTaskRunner::DispatchTable table = {
+      // .post_task_callback
+      [&wake_times](EmbedderTaskRunner* task_runner, uint64_t task_baton,
+                    fml::TimePoint target_time) {
+        wake_times.push_back(target_time);
+      },
+      // .runs_task_on_current_thread_callback
+      []() { return true; },
+      // .batch_tasks
+      true,
+  };
+  auto embedder_task_runner = fml::MakeRefCounted<EmbedderTaskRunner>(table, 0);
+  fml::RefPtr<fml::TaskRunner> task_runner = embedder_task_runner;
+
+  std::vector<int> order;
+  const auto now = fml::TimePoint::Now();
+  task_runner->PostTaskForTime([&order]() { order.push_back(1); },
+                               now - fml::TimeDelta::FromMilliseconds(1));
+  task_runner->PostTaskForTime([&order]() { order.push_back(2); },
+                               now - fml::TimeDelta::FromMilliseconds(2));
+  task_runner->PostTaskForTime([&order]() { order.push_back(3); },
+                               now + fml::TimeDelta::FromSeconds(60));
+
+  // The embedder is only woken up for tasks due before those it knows about.
+  ASSERT_EQ(wake_times.size(), 2u);
+
+  // Expired tasks run in order of their target times, and the embedder is
+  // woken up again for the task that is left.
+  EXPECT_EQ(embedder_task_runner->RunExpiredTasks(), 2u);
+  EXPECT_EQ(order, (std::vector<int>{2, 1}));
+  ASSERT_EQ(wake_times.size(), 3u);
+  EXPECT_EQ(wake_times.back(), now + fml::TimeDelta::FromSeconds(60));
+}
+
 TEST_F(EmbedderTest, CanReloadSystemFonts) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
   EmbedderConfigBuilder builder(context);
@@ -463,6 +500,54 @@ TEST_F(EmbedderTest, PlatformMessagesCanBeSentWithoutResponseHandles) {
   message.Wait();
 }
 
+//------------------------------------------------------------------------------
+/// Tests that the engine can take ownership of the data of a platform message
+/// that is large enough to be handed over to Dart without a copy.
+///
+TEST_F(EmbedderTest, PlatformMessagesCanBeSentTakingOwnershipOfTheirData) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+  builder.SetDartEntrypoint("platform_messages_no_response");
+
+  const std::string message_data(64 * 1024, 'x');
+
+  fml::AutoResetWaitableEvent ready, message;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready](Dart_NativeArguments args) { ready.Signal(); }));
+  context.AddNativeCallback(
+      "SignalNativeMessage",
+      CREATE_NATIVE_ENTRY(
+          ([&message, &message_data](Dart_NativeArguments args) {
+            auto received_message = tonic::DartConverter<std::string>::FromDart(
+                Dart_GetNativeArgument(args, 0));
+            ASSERT_EQ(received_message, message_data);
+            message.Signal();
+          })));
+
+  auto engine = builder.LaunchEngine();
+
+  ASSERT_TRUE(engine.is_valid());
+  ready.Wait();
+
+  auto* data = static_cast<uint8_t*>(malloc(message_data.size()));
+  memcpy(data, message_data.data(), message_data.size());
+
+  FlutterPlatformMessage platform_message = {};
+  platform_message.struct_size = sizeof(FlutterPlatformMessage);
+  platform_message.channel = "test_channel";
+  platform_message.message = data;
+  platform_message.message_size = message_data.size();
+  platform_message.response_handle = nullptr;  // No response needed.
+
+  auto result = FlutterEngineSendPlatformMessageTakingOwnership(
+      engine.get(), &platform_message);
+  ASSERT_EQ(result, kSuccess);
+  message.Wait();
+}
+
 //------------------------------------------------------------------------------
 /// Tests that a null platform message can be sent.
 ///
@@ -2470,6 +2555,35 @@ TEST_F(EmbedderTest, CanSetNextFrameCallback) {
   callback_latch.Wait();
 }
 
+TEST_F(EmbedderTest, CanGetFrameTimingPercentiles) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig();
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterFrameTimingPercentiles percentiles = {};
+  ASSERT_EQ(FlutterEngineGetFrameTimingPercentiles(
+                engine.get(), kFlutterFrameTimingMetricLatency, &percentiles),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetFrameTimingPercentiles(
+                engine.get(), kFlutterFrameTimingMetricLatency, nullptr),
+            kInvalidArguments);
+
+  percentiles.struct_size = sizeof(percentiles);
+  ASSERT_EQ(FlutterEngineGetFrameTimingPercentiles(
+                engine.get(), static_cast<FlutterFrameTimingMetric>(-1),
+                &percentiles),
+            kInvalidArguments);
+  ASSERT_EQ(FlutterEngineGetFrameTimingPercentiles(
+                engine.get(), kFlutterFrameTimingMetricLatency, &percentiles),
+            kSuccess);
+  ASSERT_LE(percentiles.p50_micros, percentiles.p90_micros);
+  ASSERT_LE(percentiles.p90_micros, percentiles.p99_micros);
+  ASSERT_LE(percentiles.p99_micros, percentiles.max_micros);
+}
+
 #if defined(FML_OS_MACOSX)
 
 static void MockThreadConfigSetter(const fml::Thread::ThreadConfig& config) {
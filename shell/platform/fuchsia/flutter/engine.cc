@@ -415,7 +415,8 @@ void Engine::Initialize(
           flatland_connection_ = std::make_shared<FlatlandConnection>(
               thread_label_, std::move(flatland),
               std::move(session_error_callback), [](auto) {},
-              max_frames_in_flight, vsync_offset);
+              max_frames_in_flight, vsync_offset,
+              std::move(session_inspect_node));
 
           fuchsia::ui::views::ViewIdentityOnCreation view_identity = {
               .view_ref = std::move(view_ref_pair.view_ref),
@@ -6,6 +6,9 @@
 
 #include <zircon/status.h>
 
+#include <algorithm>
+#include <utility>
+
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 
@@ -20,16 +23,43 @@ fml::TimePoint GetNextPresentationTime(fml::TimePoint now,
              : next_presentation_time;
 }
 
+fml::TimePoint FromNanoseconds(zx_time_t time) {
+  return fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromNanoseconds(time));
+}
+
 }  // namespace
 
+// static
+const fuchsia::scenic::scheduling::PresentationInfo&
+FlatlandConnection::SelectPresentationInfo(
+    const std::vector<fuchsia::scenic::scheduling::PresentationInfo>&
+        future_presentation_infos,
+    fml::TimePoint now,
+    fml::TimeDelta predicted_frame_duration) {
+  FML_DCHECK(!future_presentation_infos.empty());
+  for (const auto& info : future_presentation_infos) {
+    if (!info.has_latch_point() ||
+        FromNanoseconds(info.latch_point()) >= now + predicted_frame_duration) {
+      return info;
+    }
+  }
+  return future_presentation_infos.back();
+}
+
 FlatlandConnection::FlatlandConnection(
     std::string debug_label,
     fuchsia::ui::composition::FlatlandHandle flatland,
     fml::closure error_callback,
     on_frame_presented_event on_frame_presented_callback,
     uint64_t max_frames_in_flight,
-    fml::TimeDelta vsync_offset)
+    fml::TimeDelta vsync_offset,
+    inspect::Node inspect_node)
     : flatland_(flatland.Bind()),
+      inspect_node_(std::move(inspect_node)),
+      presents_requested_(inspect_node_.CreateUint("PresentsRequested", 0u)),
+      missed_latches_(inspect_node_.CreateUint("MissedLatches", 0u)),
+      predicted_frame_duration_(
+          inspect_node_.CreateInt("PredictedFrameDuration", 0)),
       error_callback_(error_callback),
       on_frame_presented_callback_(std::move(on_frame_presented_callback)) {
   flatland_.set_error_handler([callback = error_callback_](zx_status_t status) {
@@ -53,6 +83,29 @@ void FlatlandConnection::Present() {
     std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
     threadsafe_state_.first_present_called_ = true;
   }
+
+  const fml::TimePoint now = fml::TimePoint::Now();
+  std::optional<fml::TimePoint> frame_start;
+  std::optional<fml::TimePoint> latch_point;
+  {
+    std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
+    frame_start = std::exchange(threadsafe_state_.fired_frame_start_,
+                                std::nullopt);
+    latch_point = std::exchange(threadsafe_state_.fired_latch_point_,
+                                std::nullopt);
+  }
+  presents_requested_.Add(1);
+  if (frame_start.has_value()) {
+    frame_durations_.push_back(now - frame_start.value());
+    if (frame_durations_.size() > kFrameDurationHistorySize) {
+      frame_durations_.pop_front();
+    }
+  }
+  if (latch_point.has_value() && now > latch_point.value()) {
+    TRACE_EVENT_INSTANT0("flutter", "FlatlandConnection::MissedLatch");
+    missed_latches_.Add(1);
+  }
+
   if (present_credits_ > 0) {
     DoPresent();
   } else {
@@ -101,11 +154,17 @@ void FlatlandConnection::AwaitVsync(FireCallbackCallback callback) {
 
   // Immediately fire callback if OnNextFrameBegin() is already called.
   if (threadsafe_state_.on_next_frame_pending_) {
+    const bool missed_presentation =
+        now > threadsafe_state_.next_presentation_time_;
     threadsafe_state_.fire_callback_(
         now, GetNextPresentationTime(
                  now, threadsafe_state_.next_presentation_time_));
     threadsafe_state_.fire_callback_ = nullptr;
     threadsafe_state_.on_next_frame_pending_ = false;
+    threadsafe_state_.fired_frame_start_ = now;
+    threadsafe_state_.fired_latch_point_ =
+        missed_presentation ? std::nullopt
+                            : threadsafe_state_.next_latch_point_;
   }
 }
 
@@ -137,21 +196,43 @@ void FlatlandConnection::OnNextFrameBegin(
   if (present_credits_ > 0) {
     FML_CHECK(values.has_future_presentation_infos() &&
               !values.future_presentation_infos().empty());
+    // Target the first presentation whose latch point the frame is likely to
+    // make, instead of the very next one, so that the frame target matches
+    // when the frame is actually presented.
+    const fml::TimePoint now = fml::TimePoint::Now();
+    const fml::TimeDelta predicted_frame_duration = PredictFrameDuration();
+    predicted_frame_duration_.Set(predicted_frame_duration.ToNanoseconds());
+    const auto& presentation_info = SelectPresentationInfo(
+        values.future_presentation_infos(), now, predicted_frame_duration);
     const auto next_presentation_time =
-        fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromNanoseconds(
-            values.future_presentation_infos().front().presentation_time()));
+        FromNanoseconds(presentation_info.presentation_time());
+    std::optional<fml::TimePoint> next_latch_point;
+    if (presentation_info.has_latch_point()) {
+      next_latch_point = FromNanoseconds(presentation_info.latch_point());
+    }
 
     std::scoped_lock<std::mutex> lock(threadsafe_state_.mutex_);
     if (threadsafe_state_.fire_callback_) {
       threadsafe_state_.fire_callback_(
-          /*frame_start=*/fml::TimePoint::Now(),
+          /*frame_start=*/now,
           /*frame_target=*/next_presentation_time);
       threadsafe_state_.fire_callback_ = nullptr;
+      threadsafe_state_.fired_frame_start_ = now;
+      threadsafe_state_.fired_latch_point_ = next_latch_point;
     } else {
       threadsafe_state_.on_next_frame_pending_ = true;
     }
     threadsafe_state_.next_presentation_time_ = next_presentation_time;
+    threadsafe_state_.next_latch_point_ = next_latch_point;
+  }
+}
+
+// This method is called from the raster thread.
+fml::TimeDelta FlatlandConnection::PredictFrameDuration() const {
+  if (frame_durations_.empty()) {
+    return fml::TimeDelta::Zero();
   }
+  return *std::max_element(frame_durations_.begin(), frame_durations_.end());
 }
 
 // This method is called from the raster thread.
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_FUCHSIA_DEFAULT_FLATLAND_CONNECTION_H_
 
 #include <fuchsia/ui/composition/cpp/fidl.h>
+#include <lib/inspect/cpp/inspect.h>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -15,8 +16,11 @@
 #include "vsync_waiter.h"
 
 #include <cstdint>
+#include <deque>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace flutter_runner {
 
@@ -32,12 +36,23 @@ static constexpr fml::TimeDelta kDefaultFlatlandPresentationInterval =
 // maintaining the Flatland instance connection and presenting updates.
 class FlatlandConnection final {
  public:
+  // Picks the first of the |future_presentation_infos| whose latch point
+  // leaves |predicted_frame_duration| to produce the frame, or the last one if
+  // none of them do. Infos without a latch point are always picked.
+  static const fuchsia::scenic::scheduling::PresentationInfo&
+  SelectPresentationInfo(
+      const std::vector<fuchsia::scenic::scheduling::PresentationInfo>&
+          future_presentation_infos,
+      fml::TimePoint now,
+      fml::TimeDelta predicted_frame_duration);
+
   FlatlandConnection(std::string debug_label,
                      fuchsia::ui::composition::FlatlandHandle flatland,
                      fml::closure error_callback,
                      on_frame_presented_event on_frame_presented_callback,
                      uint64_t max_frames_in_flight,
-                     fml::TimeDelta vsync_offset);
+                     fml::TimeDelta vsync_offset,
+                     inspect::Node inspect_node = inspect::Node());
 
   ~FlatlandConnection();
 
@@ -70,8 +85,20 @@ class FlatlandConnection final {
   void OnFramePresented(fuchsia::scenic::scheduling::FramePresentedInfo info);
   void DoPresent();
 
+  // The longest of the recent frame durations, so that a frame that takes
+  // longer than usual doesn't miss the latch point it was scheduled for.
+  fml::TimeDelta PredictFrameDuration() const;
+
+  // The number of recent frame durations that the prediction is based on.
+  static constexpr size_t kFrameDurationHistorySize = 10;
+
   fuchsia::ui::composition::FlatlandPtr flatland_;
 
+  inspect::Node inspect_node_;
+  inspect::UintProperty presents_requested_;
+  inspect::UintProperty missed_latches_;
+  inspect::IntProperty predicted_frame_duration_;
+
   fml::closure error_callback_;
 
   uint64_t next_transform_id_ = 0;
@@ -84,6 +111,10 @@ class FlatlandConnection final {
   // A flow event trace id for following |Flatland::Present| calls into Scenic.
   uint64_t next_present_trace_id_ = 0;
 
+  // The time between firing the vsync callback and the frame's Present, for
+  // the most recent frames.
+  std::deque<fml::TimeDelta> frame_durations_;
+
   // This struct contains state that is accessed from both from the UI thread
   // (in AwaitVsync) and the raster thread (in OnNextFrameBegin and Present).
   // You should always lock mutex_ before touching anything in this struct
@@ -93,6 +124,12 @@ class FlatlandConnection final {
     bool first_present_called_ = false;
     bool on_next_frame_pending_ = false;
     fml::TimePoint next_presentation_time_;
+    // Empty if Scenic didn't report the latch point of the next presentation.
+    std::optional<fml::TimePoint> next_latch_point_;
+    // The start and the latch point of the last frame whose vsync callback
+    // fired, until the frame is presented.
+    std::optional<fml::TimePoint> fired_frame_start_;
+    std::optional<fml::TimePoint> fired_latch_point_;
   } threadsafe_state_;
 
   std::vector<zx::event> acquire_fences_;
@@ -53,4 +53,11 @@ SkMatrix Surface::GetRootTransformation() const {
   return matrix;
 }
 
+// |flutter::Surface|
+bool Surface::AllowsSkippingUnchangedFrames() const {
+  // Frames are paced by the presents made to Flatland, which must keep
+  // happening for the engine to be given more frames.
+  return false;
+}
+
 }  // namespace flutter_runner
@@ -489,4 +489,35 @@ TEST_F(FlatlandConnectionTest, PresentCreditExhaustion) {
   EXPECT_EQ(num_release_fences, num_onfb);
 }
 
+TEST(FlatlandConnectionStaticTest, SelectsPresentationWithReachableLatchPoint) {
+  std::vector<fuchsia::scenic::scheduling::PresentationInfo> infos;
+  for (int i = 1; i <= 3; i++) {
+    fuchsia::scenic::scheduling::PresentationInfo info;
+    info.set_latch_point(i * 16'000'000 - 4'000'000);
+    info.set_presentation_time(i * 16'000'000);
+    infos.push_back(std::move(info));
+  }
+  const auto now = fml::TimePoint::FromEpochDelta(fml::TimeDelta::Zero());
+
+  // A frame that fits before the first latch point targets the first
+  // presentation.
+  EXPECT_EQ(FlatlandConnection::SelectPresentationInfo(
+                infos, now, fml::TimeDelta::FromMilliseconds(8))
+                .presentation_time(),
+            16'000'000);
+
+  // A frame that is predicted to miss the first latch point targets the
+  // second presentation.
+  EXPECT_EQ(FlatlandConnection::SelectPresentationInfo(
+                infos, now, fml::TimeDelta::FromMilliseconds(20))
+                .presentation_time(),
+            32'000'000);
+
+  // A frame that misses every latch point targets the last presentation.
+  EXPECT_EQ(FlatlandConnection::SelectPresentationInfo(
+                infos, now, fml::TimeDelta::FromMilliseconds(100))
+                .presentation_time(),
+            48'000'000);
+}
+
 }  // namespace flutter_runner::testing
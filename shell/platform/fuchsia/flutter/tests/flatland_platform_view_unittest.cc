@@ -143,6 +143,11 @@ class MockPlatformViewDelegate : public flutter::PlatformView::Delegate {
                                     const std::string error_message,
                                     bool transient) {}
   // |flutter::PlatformView::Delegate|
+  void PrefetchDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions) {}
+  // |flutter::PlatformView::Delegate|
   void UpdateAssetResolverByType(
       std::unique_ptr<flutter::AssetResolver> updated_asset_resolver,
       flutter::AssetResolver::AssetResolverType type) {}
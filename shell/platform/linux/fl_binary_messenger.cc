@@ -74,6 +74,17 @@ G_DEFINE_TYPE(FlBinaryMessengerResponseHandleImpl,
               fl_binary_messenger_response_handle_impl,
               fl_binary_messenger_response_handle_get_type())
 
+struct _FlBinaryMessengerTaskQueue {
+  GObject parent_instance;
+
+  // Pool with a single thread, so that messages are handled in order.
+  GThreadPool* pool;
+};
+
+G_DEFINE_TYPE(FlBinaryMessengerTaskQueue,
+              fl_binary_messenger_task_queue,
+              G_TYPE_OBJECT)
+
 static void fl_binary_messenger_default_init(
     FlBinaryMessengerInterface* iface) {}
 
@@ -400,3 +411,149 @@ G_MODULE_EXPORT GBytes* fl_binary_messenger_send_on_channel_finish(
   return FL_BINARY_MESSENGER_GET_IFACE(self)->send_on_channel_finish(
       self, result, error);
 }
+
+// A handler set on a task queue. Each queued message holds a reference, so
+// that the handler outlives its messages.
+typedef struct {
+  gint ref_count;
+  FlBinaryMessengerMessageHandler message_handler;
+  gpointer message_handler_data;
+  GDestroyNotify message_handler_destroy_notify;
+  FlBinaryMessengerTaskQueue* task_queue;
+} TaskQueueHandler;
+
+typedef struct {
+  TaskQueueHandler* handler;
+  FlBinaryMessenger* messenger;
+  gchar* channel;
+  GBytes* message;
+  FlBinaryMessengerResponseHandle* response_handle;
+} TaskQueueMessage;
+
+static gboolean task_queue_handler_free(gpointer data) {
+  TaskQueueHandler* self = static_cast<TaskQueueHandler*>(data);
+  if (self->message_handler_destroy_notify) {
+    self->message_handler_destroy_notify(self->message_handler_data);
+  }
+  g_object_unref(self->task_queue);
+  g_free(self);
+  return G_SOURCE_REMOVE;
+}
+
+static TaskQueueHandler* task_queue_handler_ref(TaskQueueHandler* self) {
+  g_atomic_int_inc(&self->ref_count);
+  return self;
+}
+
+static void task_queue_handler_unref(gpointer data) {
+  TaskQueueHandler* self = static_cast<TaskQueueHandler*>(data);
+  if (!g_atomic_int_dec_and_test(&self->ref_count)) {
+    return;
+  }
+  // The user data and the task queue are released on the platform thread,
+  // which also avoids freeing the queue from one of its own tasks.
+  if (g_main_context_is_owner(g_main_context_default())) {
+    task_queue_handler_free(self);
+  } else {
+    g_idle_add(task_queue_handler_free, self);
+  }
+}
+
+static void task_queue_run_message(gpointer data, gpointer user_data) {
+  TaskQueueMessage* message = static_cast<TaskQueueMessage*>(data);
+  TaskQueueHandler* handler = message->handler;
+
+  handler->message_handler(message->messenger, message->channel,
+                           message->message, message->response_handle,
+                           handler->message_handler_data);
+
+  g_object_unref(message->response_handle);
+  g_clear_pointer(&message->message, g_bytes_unref);
+  g_free(message->channel);
+  // Like the engine in send_response, the messenger must only be disposed of
+  // on the platform thread.
+  g_idle_add(do_unref, message->messenger);
+  task_queue_handler_unref(handler);
+  g_free(message);
+}
+
+static void task_queue_message_cb(
+    FlBinaryMessenger* messenger,
+    const gchar* channel,
+    GBytes* message,
+    FlBinaryMessengerResponseHandle* response_handle,
+    gpointer user_data) {
+  TaskQueueHandler* handler = static_cast<TaskQueueHandler*>(user_data);
+
+  TaskQueueMessage* task_message = g_new0(TaskQueueMessage, 1);
+  task_message->handler = task_queue_handler_ref(handler);
+  task_message->messenger = FL_BINARY_MESSENGER(g_object_ref(messenger));
+  task_message->channel = g_strdup(channel);
+  task_message->message = message != nullptr ? g_bytes_ref(message) : nullptr;
+  task_message->response_handle =
+      FL_BINARY_MESSENGER_RESPONSE_HANDLE(g_object_ref(response_handle));
+  g_thread_pool_push(handler->task_queue->pool, task_message, nullptr);
+}
+
+static void fl_binary_messenger_task_queue_dispose(GObject* object) {
+  FlBinaryMessengerTaskQueue* self = FL_BINARY_MESSENGER_TASK_QUEUE(object);
+
+  // Queued messages hold references to the queue through their handlers, so
+  // there is nothing left to wait for.
+  if (self->pool != nullptr) {
+    g_thread_pool_free(self->pool, FALSE, FALSE);
+    self->pool = nullptr;
+  }
+
+  G_OBJECT_CLASS(fl_binary_messenger_task_queue_parent_class)->dispose(object);
+}
+
+static void fl_binary_messenger_task_queue_class_init(
+    FlBinaryMessengerTaskQueueClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_binary_messenger_task_queue_dispose;
+}
+
+static void fl_binary_messenger_task_queue_init(
+    FlBinaryMessengerTaskQueue* self) {
+  self->pool =
+      g_thread_pool_new(task_queue_run_message, nullptr, 1, FALSE, nullptr);
+}
+
+G_MODULE_EXPORT FlBinaryMessengerTaskQueue*
+fl_binary_messenger_make_background_task_queue(FlBinaryMessenger* self) {
+  g_return_val_if_fail(FL_IS_BINARY_MESSENGER(self), nullptr);
+
+  return FL_BINARY_MESSENGER_TASK_QUEUE(
+      g_object_new(fl_binary_messenger_task_queue_get_type(), nullptr));
+}
+
+G_MODULE_EXPORT void
+fl_binary_messenger_set_message_handler_on_channel_with_task_queue(
+    FlBinaryMessenger* self,
+    const gchar* channel,
+    FlBinaryMessengerMessageHandler handler,
+    gpointer user_data,
+    GDestroyNotify destroy_notify,
+    FlBinaryMessengerTaskQueue* task_queue) {
+  g_return_if_fail(FL_IS_BINARY_MESSENGER(self));
+  g_return_if_fail(channel != nullptr);
+  g_return_if_fail(task_queue == nullptr ||
+                   FL_IS_BINARY_MESSENGER_TASK_QUEUE(task_queue));
+
+  if (handler == nullptr || task_queue == nullptr) {
+    fl_binary_messenger_set_message_handler_on_channel(
+        self, channel, handler, user_data, destroy_notify);
+    return;
+  }
+
+  TaskQueueHandler* task_queue_handler = g_new0(TaskQueueHandler, 1);
+  task_queue_handler->ref_count = 1;
+  task_queue_handler->message_handler = handler;
+  task_queue_handler->message_handler_data = user_data;
+  task_queue_handler->message_handler_destroy_notify = destroy_notify;
+  task_queue_handler->task_queue =
+      FL_BINARY_MESSENGER_TASK_QUEUE(g_object_ref(task_queue));
+  FL_BINARY_MESSENGER_GET_IFACE(self)->set_message_handler_on_channel(
+      self, channel, task_queue_message_cb, task_queue_handler,
+      task_queue_handler_unref);
+}
@@ -0,0 +1,277 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dma_buf_texture.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+#include <gmodule.h>
+
+#include <cstring>
+
+#include "flutter/shell/platform/linux/fl_dma_buf_texture_private.h"
+
+// DRM_FORMAT_MOD_INVALID from drm_fourcc.h.
+static constexpr uint64_t kModifierInvalid = 0x00ffffffffffffffULL;
+
+// The EGL attributes that describe each plane of a DMA-BUF.
+static constexpr EGLint kPlaneAttributes[FL_DMA_BUF_TEXTURE_MAX_PLANES][5] = {
+    {EGL_DMA_BUF_PLANE0_FD_EXT, EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE0_PITCH_EXT, EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE1_FD_EXT, EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE1_PITCH_EXT, EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE2_FD_EXT, EGL_DMA_BUF_PLANE2_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE2_PITCH_EXT, EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT},
+    {EGL_DMA_BUF_PLANE3_FD_EXT, EGL_DMA_BUF_PLANE3_OFFSET_EXT,
+     EGL_DMA_BUF_PLANE3_PITCH_EXT, EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT,
+     EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT},
+};
+
+// The description of an imported frame.
+typedef struct {
+  uint32_t fourcc;
+  uint64_t modifier;
+  FlDmaBufPlane planes[FL_DMA_BUF_TEXTURE_MAX_PLANES];
+  size_t n_planes;
+  uint32_t width;
+  uint32_t height;
+} FlDmaBufFrame;
+
+typedef struct {
+  int64_t id;
+  GLuint texture_id;
+  GLenum target;
+
+  // The display and image of the last imported frame.
+  EGLDisplay display;
+  EGLImageKHR image;
+  FlDmaBufFrame frame;
+} FlDmaBufTexturePrivate;
+
+static void fl_dma_buf_texture_iface_init(FlTextureInterface* iface);
+
+G_DEFINE_QUARK(fl_dma_buf_texture_error_quark, fl_dma_buf_texture_error)
+
+// Added here to stop the compiler from optimising this function away.
+G_MODULE_EXPORT GType fl_dma_buf_texture_get_type();
+
+G_DEFINE_TYPE_WITH_CODE(FlDmaBufTexture,
+                        fl_dma_buf_texture,
+                        G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(fl_texture_get_type(),
+                                              fl_dma_buf_texture_iface_init);
+                        G_ADD_PRIVATE(FlDmaBufTexture))
+
+// Implements FlTexture::set_id
+static void fl_dma_buf_texture_set_id(FlTexture* texture, int64_t id) {
+  FlDmaBufTexture* self = FL_DMA_BUF_TEXTURE(texture);
+  FlDmaBufTexturePrivate* priv = reinterpret_cast<FlDmaBufTexturePrivate*>(
+      fl_dma_buf_texture_get_instance_private(self));
+  priv->id = id;
+}
+
+// Implements FlTexture::set_id
+static int64_t fl_dma_buf_texture_get_id(FlTexture* texture) {
+  FlDmaBufTexture* self = FL_DMA_BUF_TEXTURE(texture);
+  FlDmaBufTexturePrivate* priv = reinterpret_cast<FlDmaBufTexturePrivate*>(
+      fl_dma_buf_texture_get_instance_private(self));
+  return priv->id;
+}
+
+static void fl_dma_buf_texture_iface_init(FlTextureInterface* iface) {
+  iface->set_id = fl_dma_buf_texture_set_id;
+  iface->get_id = fl_dma_buf_texture_get_id;
+}
+
+// Destroys the image of the last imported frame.
+static void destroy_image(FlDmaBufTexturePrivate* priv) {
+  if (priv->image != EGL_NO_IMAGE_KHR) {
+    eglDestroyImageKHR(priv->display, priv->image);
+    priv->image = EGL_NO_IMAGE_KHR;
+  }
+  priv->display = EGL_NO_DISPLAY;
+}
+
+static void fl_dma_buf_texture_dispose(GObject* object) {
+  FlDmaBufTexture* self = FL_DMA_BUF_TEXTURE(object);
+  FlDmaBufTexturePrivate* priv = reinterpret_cast<FlDmaBufTexturePrivate*>(
+      fl_dma_buf_texture_get_instance_private(self));
+
+  if (priv->texture_id) {
+    glDeleteTextures(1, &priv->texture_id);
+    priv->texture_id = 0;
+  }
+  destroy_image(priv);
+
+  G_OBJECT_CLASS(fl_dma_buf_texture_parent_class)->dispose(object);
+}
+
+static gboolean frames_equal(const FlDmaBufFrame* a, const FlDmaBufFrame* b) {
+  if (a->fourcc != b->fourcc || a->modifier != b->modifier ||
+      a->n_planes != b->n_planes || a->width != b->width ||
+      a->height != b->height) {
+    return FALSE;
+  }
+  for (size_t i = 0; i < a->n_planes; i++) {
+    if (a->planes[i].fd != b->planes[i].fd ||
+        a->planes[i].offset != b->planes[i].offset ||
+        a->planes[i].stride != b->planes[i].stride) {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+// Imports @frame into an EGL image bound to the texture of @priv.
+static gboolean import_frame(FlDmaBufTexturePrivate* priv,
+                             const FlDmaBufFrame* frame,
+                             GError** error) {
+  EGLDisplay display = eglGetCurrentDisplay();
+  if (display == EGL_NO_DISPLAY ||
+      !epoxy_has_egl_extension(display, "EGL_EXT_image_dma_buf_import")) {
+    g_set_error(error, fl_dma_buf_texture_error_quark(),
+                FL_DMA_BUF_TEXTURE_ERROR_FAILED,
+                "EGL_EXT_image_dma_buf_import is not supported");
+    return FALSE;
+  }
+  const bool has_modifier = frame->modifier != kModifierInvalid;
+  if (has_modifier &&
+      !epoxy_has_egl_extension(display,
+                               "EGL_EXT_image_dma_buf_import_modifiers")) {
+    g_set_error(error, fl_dma_buf_texture_error_quark(),
+                FL_DMA_BUF_TEXTURE_ERROR_FAILED,
+                "EGL_EXT_image_dma_buf_import_modifiers is not supported");
+    return FALSE;
+  }
+
+  // Three attributes for the frame, up to five for each plane and the
+  // terminating EGL_NONE, each with a value.
+  EGLint attributes[(3 + 5 * FL_DMA_BUF_TEXTURE_MAX_PLANES) * 2 + 1];
+  size_t n = 0;
+  attributes[n++] = EGL_WIDTH;
+  attributes[n++] = static_cast<EGLint>(frame->width);
+  attributes[n++] = EGL_HEIGHT;
+  attributes[n++] = static_cast<EGLint>(frame->height);
+  attributes[n++] = EGL_LINUX_DRM_FOURCC_EXT;
+  attributes[n++] = static_cast<EGLint>(frame->fourcc);
+  for (size_t i = 0; i < frame->n_planes; i++) {
+    attributes[n++] = kPlaneAttributes[i][0];
+    attributes[n++] = frame->planes[i].fd;
+    attributes[n++] = kPlaneAttributes[i][1];
+    attributes[n++] = static_cast<EGLint>(frame->planes[i].offset);
+    attributes[n++] = kPlaneAttributes[i][2];
+    attributes[n++] = static_cast<EGLint>(frame->planes[i].stride);
+    if (has_modifier) {
+      attributes[n++] = kPlaneAttributes[i][3];
+      attributes[n++] = static_cast<EGLint>(frame->modifier & 0xffffffff);
+      attributes[n++] = kPlaneAttributes[i][4];
+      attributes[n++] = static_cast<EGLint>(frame->modifier >> 32);
+    }
+  }
+  attributes[n++] = EGL_NONE;
+
+  EGLImageKHR image = eglCreateImageKHR(display, EGL_NO_CONTEXT,
+                                        EGL_LINUX_DMA_BUF_EXT, nullptr,
+                                        attributes);
+  if (image == EGL_NO_IMAGE_KHR) {
+    g_set_error(error, fl_dma_buf_texture_error_quark(),
+                FL_DMA_BUF_TEXTURE_ERROR_FAILED,
+                "Failed to import DMA-BUF: EGL error 0x%x", eglGetError());
+    return FALSE;
+  }
+
+  if (priv->texture_id == 0) {
+    // External textures let the driver sample YUV frames, but are not
+    // available in desktop OpenGL contexts.
+    priv->target = epoxy_has_gl_extension("GL_OES_EGL_image_external")
+                       ? GL_TEXTURE_EXTERNAL_OES
+                       : GL_TEXTURE_2D;
+    glGenTextures(1, &priv->texture_id);
+    glBindTexture(priv->target, priv->texture_id);
+    glTexParameteri(priv->target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(priv->target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(priv->target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(priv->target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  } else {
+    glBindTexture(priv->target, priv->texture_id);
+  }
+  glEGLImageTargetTexture2DOES(priv->target,
+                               static_cast<GLeglImageOES>(image));
+  GLenum gl_error = glGetError();
+  if (gl_error != GL_NO_ERROR) {
+    eglDestroyImageKHR(display, image);
+    g_set_error(error, fl_dma_buf_texture_error_quark(),
+                FL_DMA_BUF_TEXTURE_ERROR_FAILED,
+                "Failed to bind DMA-BUF image: GL error 0x%x", gl_error);
+    return FALSE;
+  }
+
+  // The texture now refers to the new image, so the old one can go.
+  destroy_image(priv);
+  priv->display = display;
+  priv->image = image;
+  priv->frame = *frame;
+
+  return TRUE;
+}
+
+gboolean fl_dma_buf_texture_populate(FlDmaBufTexture* texture,
+                                     uint32_t width,
+                                     uint32_t height,
+                                     FlutterOpenGLTexture* opengl_texture,
+                                     GError** error) {
+  FlDmaBufTexture* self = FL_DMA_BUF_TEXTURE(texture);
+  FlDmaBufTexturePrivate* priv = reinterpret_cast<FlDmaBufTexturePrivate*>(
+      fl_dma_buf_texture_get_instance_private(self));
+
+  FlDmaBufFrame frame;
+  memset(&frame, 0, sizeof(frame));
+  frame.modifier = kModifierInvalid;
+  frame.width = width;
+  frame.height = height;
+  if (!FL_DMA_BUF_TEXTURE_GET_CLASS(self)->acquire_frame(
+          self, &frame.fourcc, &frame.modifier, frame.planes, &frame.n_planes,
+          &frame.width, &frame.height, error)) {
+    return FALSE;
+  }
+
+  if (frame.n_planes == 0 || frame.n_planes > FL_DMA_BUF_TEXTURE_MAX_PLANES) {
+    g_set_error(error, fl_dma_buf_texture_error_quark(),
+                FL_DMA_BUF_TEXTURE_ERROR_FAILED,
+                "Invalid number of DMA-BUF planes %zu", frame.n_planes);
+    return FALSE;
+  }
+
+  if (priv->image == EGL_NO_IMAGE_KHR ||
+      !frames_equal(&priv->frame, &frame)) {
+    if (!import_frame(priv, &frame, error)) {
+      return FALSE;
+    }
+  }
+
+  opengl_texture->target = priv->target;
+  opengl_texture->name = priv->texture_id;
+  opengl_texture->format = GL_RGBA8;
+  opengl_texture->destruction_callback = nullptr;
+  opengl_texture->user_data = nullptr;
+  opengl_texture->width = frame.width;
+  opengl_texture->height = frame.height;
+
+  return TRUE;
+}
+
+static void fl_dma_buf_texture_class_init(FlDmaBufTextureClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_dma_buf_texture_dispose;
+}
+
+static void fl_dma_buf_texture_init(FlDmaBufTexture* self) {
+  FlDmaBufTexturePrivate* priv = reinterpret_cast<FlDmaBufTexturePrivate*>(
+      fl_dma_buf_texture_get_instance_private(self));
+  priv->target = GL_TEXTURE_2D;
+  priv->display = EGL_NO_DISPLAY;
+  priv->image = EGL_NO_IMAGE_KHR;
+}
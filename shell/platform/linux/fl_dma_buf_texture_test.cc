@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_dma_buf_texture.h"
+#include "flutter/shell/platform/linux/fl_dma_buf_texture_private.h"
+#include "flutter/shell/platform/linux/fl_texture_private.h"
+#include "flutter/shell/platform/linux/testing/fl_test.h"
+#include "gtest/gtest.h"
+
+#include <epoxy/gl.h>
+
+static constexpr uint32_t kBufferWidth = 4u;
+static constexpr uint32_t kBufferHeight = 4u;
+static constexpr uint32_t kRealBufferWidth = 2u;
+static constexpr uint32_t kRealBufferHeight = 2u;
+// DRM_FORMAT_ABGR8888
+static constexpr uint32_t kFourcc = 0x34324241;
+
+G_DECLARE_FINAL_TYPE(FlTestDmaBufTexture,
+                     fl_test_dma_buf_texture,
+                     FL,
+                     TEST_DMA_BUF_TEXTURE,
+                     FlDmaBufTexture)
+
+/// A simple texture with a fixed frame.
+struct _FlTestDmaBufTexture {
+  FlDmaBufTexture parent_instance;
+
+  size_t n_planes;
+};
+
+G_DEFINE_TYPE(FlTestDmaBufTexture,
+              fl_test_dma_buf_texture,
+              fl_dma_buf_texture_get_type())
+
+static gboolean fl_test_dma_buf_texture_acquire_frame(FlDmaBufTexture* texture,
+                                                      uint32_t* fourcc,
+                                                      uint64_t* modifier,
+                                                      FlDmaBufPlane* planes,
+                                                      size_t* n_planes,
+                                                      uint32_t* width,
+                                                      uint32_t* height,
+                                                      GError** error) {
+  EXPECT_TRUE(FL_IS_TEST_DMA_BUF_TEXTURE(texture));
+  FlTestDmaBufTexture* self = FL_TEST_DMA_BUF_TEXTURE(texture);
+
+  EXPECT_EQ(*width, kBufferWidth);
+  EXPECT_EQ(*height, kBufferHeight);
+  *fourcc = kFourcc;
+  for (size_t i = 0; i < self->n_planes; i++) {
+    planes[i].fd = 42;
+    planes[i].offset = 0;
+    planes[i].stride = kRealBufferWidth * 4;
+  }
+  *n_planes = self->n_planes;
+  *width = kRealBufferWidth;
+  *height = kRealBufferHeight;
+
+  return TRUE;
+}
+
+static void fl_test_dma_buf_texture_class_init(
+    FlTestDmaBufTextureClass* klass) {
+  FL_DMA_BUF_TEXTURE_CLASS(klass)->acquire_frame =
+      fl_test_dma_buf_texture_acquire_frame;
+}
+
+static void fl_test_dma_buf_texture_init(FlTestDmaBufTexture* self) {}
+
+static FlTestDmaBufTexture* fl_test_dma_buf_texture_new(size_t n_planes) {
+  FlTestDmaBufTexture* self = FL_TEST_DMA_BUF_TEXTURE(
+      g_object_new(fl_test_dma_buf_texture_get_type(), nullptr));
+  self->n_planes = n_planes;
+  return self;
+}
+
+// Test that getting the texture ID works.
+TEST(FlDmaBufTextureTest, TextureID) {
+  g_autoptr(FlTexture) texture = FL_TEXTURE(fl_test_dma_buf_texture_new(1));
+  fl_texture_set_id(texture, 42);
+  EXPECT_EQ(fl_texture_get_id(texture), static_cast<int64_t>(42));
+}
+
+// Test that populating an OpenGL texture works.
+TEST(FlDmaBufTextureTest, PopulateTexture) {
+  g_autoptr(FlDmaBufTexture) texture =
+      FL_DMA_BUF_TEXTURE(fl_test_dma_buf_texture_new(1));
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_dma_buf_texture_populate(texture, kBufferWidth, kBufferHeight,
+                                          &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(opengl_texture.target, static_cast<uint32_t>(GL_TEXTURE_2D));
+  EXPECT_EQ(opengl_texture.width, kRealBufferWidth);
+  EXPECT_EQ(opengl_texture.height, kRealBufferHeight);
+
+  // The same frame is reused.
+  EXPECT_TRUE(fl_dma_buf_texture_populate(texture, kBufferWidth, kBufferHeight,
+                                          &opengl_texture, &error));
+  EXPECT_EQ(error, nullptr);
+}
+
+// Test that frames without planes are rejected.
+TEST(FlDmaBufTextureTest, PopulateTextureWithoutPlanes) {
+  g_autoptr(FlDmaBufTexture) texture =
+      FL_DMA_BUF_TEXTURE(fl_test_dma_buf_texture_new(0));
+  FlutterOpenGLTexture opengl_texture = {0};
+  g_autoptr(GError) error = nullptr;
+  EXPECT_FALSE(fl_dma_buf_texture_populate(texture, kBufferWidth, kBufferHeight,
+                                           &opengl_texture, &error));
+  EXPECT_TRUE(g_error_matches(error, FL_DMA_BUF_TEXTURE_ERROR,
+                              FL_DMA_BUF_TEXTURE_ERROR_FAILED));
+}
@@ -14,6 +14,7 @@
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/linux/fl_binary_messenger_private.h"
 #include "flutter/shell/platform/linux/fl_dart_project_private.h"
+#include "flutter/shell/platform/linux/fl_dma_buf_texture_private.h"
 #include "flutter/shell/platform/linux/fl_engine_private.h"
 #include "flutter/shell/platform/linux/fl_pixel_buffer_texture_private.h"
 #include "flutter/shell/platform/linux/fl_plugin_registrar_private.h"
@@ -32,6 +33,9 @@ static constexpr size_t kPlatformTaskRunnerIdentifier = 1;
 static constexpr int32_t kMousePointerDeviceId = 0;
 static constexpr int32_t kPointerPanZoomDeviceId = 1;
 
+// Refresh interval assumed until the display reports one.
+static constexpr int64_t kDefaultRefreshIntervalMicroseconds = 16667;
+
 struct _FlEngine {
   GObject parent_instance;
 
@@ -62,6 +66,13 @@ struct _FlEngine {
   FlEngineOnPreEngineRestartHandler on_pre_engine_restart_handler;
   gpointer on_pre_engine_restart_handler_data;
   GDestroyNotify on_pre_engine_restart_handler_destroy_notify;
+
+  // Timing of the display the engine renders to, as last reported by
+  // fl_engine_set_refresh_info(). Guarded by refresh_info_mutex, as it is read
+  // on the Flutter UI thread.
+  GMutex refresh_info_mutex;
+  gint64 presentation_time;
+  gint64 refresh_interval;
 };
 
 G_DEFINE_QUARK(fl_engine_error_quark, fl_engine_error)
@@ -260,6 +271,9 @@ static bool fl_engine_gl_external_texture_frame_callback(
     result =
         fl_pixel_buffer_texture_populate(FL_PIXEL_BUFFER_TEXTURE(texture),
                                          width, height, opengl_texture, &error);
+  } else if (FL_IS_DMA_BUF_TEXTURE(texture)) {
+    result = fl_dma_buf_texture_populate(FL_DMA_BUF_TEXTURE(texture), width,
+                                         height, opengl_texture, &error);
   } else {
     g_warning("Unsupported texture type %" G_GINT64_FORMAT, texture_id);
     return false;
@@ -333,6 +347,35 @@ static void fl_engine_on_pre_engine_restart_cb(void* user_data) {
   }
 }
 
+// Called on the Flutter UI thread when the engine waits for the next vsync.
+//
+// This replies on the UI thread with the next presentation time of the display
+// rather than waiting for the main thread, as the main thread is blocked while
+// the view waits for a frame of a new size.
+static void fl_engine_vsync_cb(void* user_data, intptr_t baton) {
+  FlEngine* self = FL_ENGINE(user_data);
+
+  gint64 presentation_time, refresh_interval;
+  {
+    g_autoptr(GMutexLocker) locker =
+        g_mutex_locker_new(&self->refresh_info_mutex);
+    presentation_time = self->presentation_time;
+    refresh_interval = self->refresh_interval;
+  }
+
+  // The engine's clock and the GDK frame clock are both monotonic.
+  const int64_t interval = refresh_interval * 1000;
+  const int64_t phase = presentation_time * 1000;
+  const int64_t now = self->embedder_api.GetCurrentTime();
+  int64_t offset = (phase - now) % interval;
+  if (offset < 0) {
+    offset += interval;
+  }
+  const int64_t frame_start_time = now + offset;
+  self->embedder_api.OnVsync(self->engine, baton, frame_start_time,
+                             frame_start_time + interval);
+}
+
 // Called when a response to a sent platform message is received from the
 // engine.
 static void fl_engine_platform_message_response_cb(const uint8_t* data,
@@ -418,8 +461,17 @@ static void fl_engine_dispose(GObject* object) {
   G_OBJECT_CLASS(fl_engine_parent_class)->dispose(object);
 }
 
+static void fl_engine_finalize(GObject* object) {
+  FlEngine* self = FL_ENGINE(object);
+
+  g_mutex_clear(&self->refresh_info_mutex);
+
+  G_OBJECT_CLASS(fl_engine_parent_class)->finalize(object);
+}
+
 static void fl_engine_class_init(FlEngineClass* klass) {
   G_OBJECT_CLASS(klass)->dispose = fl_engine_dispose;
+  G_OBJECT_CLASS(klass)->finalize = fl_engine_finalize;
   G_OBJECT_CLASS(klass)->set_property = fl_engine_set_property;
 
   g_object_class_install_property(
@@ -434,6 +486,9 @@ static void fl_engine_class_init(FlEngineClass* klass) {
 static void fl_engine_init(FlEngine* self) {
   self->thread = g_thread_self();
 
+  g_mutex_init(&self->refresh_info_mutex);
+  self->refresh_interval = kDefaultRefreshIntervalMicroseconds;
+
   self->embedder_api.struct_size = sizeof(FlutterEngineProcTable);
   FlutterEngineGetProcAddresses(&self->embedder_api);
 
@@ -507,6 +562,7 @@ gboolean fl_engine_start(FlEngine* self, GError** error) {
   args.custom_task_runners = &custom_task_runners;
   args.shutdown_dart_vm_when_done = true;
   args.on_pre_engine_restart_callback = fl_engine_on_pre_engine_restart_cb;
+  args.vsync_callback = fl_engine_vsync_cb;
   args.dart_entrypoint_argc =
       dart_entrypoint_args != nullptr ? g_strv_length(dart_entrypoint_args) : 0;
   args.dart_entrypoint_argv =
@@ -888,6 +944,18 @@ void fl_engine_update_accessibility_features(FlEngine* self, int32_t flags) {
       self->engine, static_cast<FlutterAccessibilityFeature>(flags));
 }
 
+void fl_engine_set_refresh_info(FlEngine* self,
+                                gint64 presentation_time,
+                                gint64 refresh_interval) {
+  g_return_if_fail(FL_IS_ENGINE(self));
+  g_return_if_fail(refresh_interval > 0);
+
+  g_autoptr(GMutexLocker) locker =
+      g_mutex_locker_new(&self->refresh_info_mutex);
+  self->presentation_time = presentation_time;
+  self->refresh_interval = refresh_interval;
+}
+
 GPtrArray* fl_engine_get_switches(FlEngine* self) {
   GPtrArray* switches = g_ptr_array_new_with_free_func(g_free);
   for (const auto& env_switch : flutter::GetSwitchesFromEnvironment()) {
@@ -336,6 +336,21 @@ gboolean fl_engine_unregister_external_texture(FlEngine* engine,
  */
 void fl_engine_update_accessibility_features(FlEngine* engine, int32_t flags);
 
+/**
+ * fl_engine_set_refresh_info:
+ * @engine: an #FlEngine.
+ * @presentation_time: the time a recent frame was or will be presented on the
+ * display, in the timebase of g_get_monotonic_time().
+ * @refresh_interval: the refresh interval of the display in microseconds.
+ *
+ * Tells the engine the timing of the display it renders to. Vsync requests
+ * from the engine are answered with the next presentation time that is a
+ * multiple of @refresh_interval after @presentation_time.
+ */
+void fl_engine_set_refresh_info(FlEngine* engine,
+                                gint64 presentation_time,
+                                gint64 refresh_interval);
+
 /**
  * fl_engine_get_switches:
  * @project: an #FlEngine.
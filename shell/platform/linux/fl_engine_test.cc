@@ -324,6 +324,52 @@ TEST(FlEngineTest, OnPreEngineRestart) {
   EXPECT_EQ(count, 11);
 }
 
+// Checks vsync requests are answered with the timing of the display.
+TEST(FlEngineTest, Vsync) {
+  g_autoptr(FlEngine) engine = make_mock_engine();
+  FlutterEngineProcTable* embedder_api = fl_engine_get_embedder_api(engine);
+
+  VsyncCallback callback = nullptr;
+  void* callback_user_data = nullptr;
+  embedder_api->Initialize = MOCK_ENGINE_PROC(
+      Initialize, ([&callback, &callback_user_data](
+                       size_t version, const FlutterRendererConfig* config,
+                       const FlutterProjectArgs* args, void* user_data,
+                       FLUTTER_API_SYMBOL(FlutterEngine) * engine_out) {
+        callback = args->vsync_callback;
+        callback_user_data = user_data;
+        return kSuccess;
+      }));
+  embedder_api->GetCurrentTime =
+      MOCK_ENGINE_PROC(GetCurrentTime, ([]() -> uint64_t { return 1000000; }));
+
+  intptr_t vsync_baton = 0;
+  uint64_t vsync_start_time = 0;
+  uint64_t vsync_target_time = 0;
+  embedder_api->OnVsync = MOCK_ENGINE_PROC(
+      OnVsync,
+      ([&vsync_baton, &vsync_start_time, &vsync_target_time](
+           auto engine, intptr_t baton, uint64_t frame_start_time_nanos,
+           uint64_t frame_target_time_nanos) {
+        vsync_baton = baton;
+        vsync_start_time = frame_start_time_nanos;
+        vsync_target_time = frame_target_time_nanos;
+        return kSuccess;
+      }));
+
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_engine_start(engine, &error));
+  EXPECT_EQ(error, nullptr);
+  ASSERT_NE(callback, nullptr);
+
+  // A 144Hz display that presented a frame at 900us.
+  fl_engine_set_refresh_info(engine, 900, 6944);
+  callback(callback_user_data, 42);
+  EXPECT_EQ(vsync_baton, 42);
+  EXPECT_EQ(vsync_start_time, static_cast<uint64_t>(900000 + 6944000));
+  EXPECT_EQ(vsync_target_time, static_cast<uint64_t>(900000 + 2 * 6944000));
+}
+
 TEST(FlEngineTest, DartEntrypointArgs) {
   g_autoptr(FlDartProject) project = fl_dart_project_new();
 
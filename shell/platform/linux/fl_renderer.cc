@@ -13,6 +13,10 @@
 
 G_DEFINE_QUARK(fl_renderer_error_quark, fl_renderer_error)
 
+// The maximum time to block the main thread for while waiting for a frame at
+// a new size, in microseconds.
+static constexpr gint64 kMaxWaitForFrame = 100 * G_TIME_SPAN_MILLISECOND;
+
 typedef struct {
   FlView* view;
 
@@ -50,8 +54,42 @@ static void fl_renderer_dispose(GObject* self) {
   G_OBJECT_CLASS(fl_renderer_parent_class)->dispose(self);
 }
 
+// Implements FlRenderer::make_current.
+static gboolean fl_renderer_real_make_current(FlRenderer* self,
+                                              GError** error) {
+  FlRendererPrivate* priv = reinterpret_cast<FlRendererPrivate*>(
+      fl_renderer_get_instance_private(self));
+  if (priv->main_context) {
+    gdk_gl_context_make_current(priv->main_context);
+  }
+
+  return TRUE;
+}
+
+// Implements FlRenderer::make_resource_current.
+static gboolean fl_renderer_real_make_resource_current(FlRenderer* self,
+                                                       GError** error) {
+  FlRendererPrivate* priv = reinterpret_cast<FlRendererPrivate*>(
+      fl_renderer_get_instance_private(self));
+  if (priv->resource_context) {
+    gdk_gl_context_make_current(priv->resource_context);
+  }
+
+  return TRUE;
+}
+
+// Implements FlRenderer::clear_current.
+static gboolean fl_renderer_real_clear_current(FlRenderer* self,
+                                               GError** error) {
+  gdk_gl_context_clear_current();
+  return TRUE;
+}
+
 static void fl_renderer_class_init(FlRendererClass* klass) {
   G_OBJECT_CLASS(klass)->dispose = fl_renderer_dispose;
+  klass->make_current = fl_renderer_real_make_current;
+  klass->make_resource_current = fl_renderer_real_make_resource_current;
+  klass->clear_current = fl_renderer_real_clear_current;
 }
 
 static void fl_renderer_init(FlRenderer* self) {}
@@ -93,28 +131,15 @@ void* fl_renderer_get_proc_address(FlRenderer* self, const char* name) {
 }
 
 gboolean fl_renderer_make_current(FlRenderer* self, GError** error) {
-  FlRendererPrivate* priv = reinterpret_cast<FlRendererPrivate*>(
-      fl_renderer_get_instance_private(self));
-  if (priv->main_context) {
-    gdk_gl_context_make_current(priv->main_context);
-  }
-
-  return TRUE;
+  return FL_RENDERER_GET_CLASS(self)->make_current(self, error);
 }
 
 gboolean fl_renderer_make_resource_current(FlRenderer* self, GError** error) {
-  FlRendererPrivate* priv = reinterpret_cast<FlRendererPrivate*>(
-      fl_renderer_get_instance_private(self));
-  if (priv->resource_context) {
-    gdk_gl_context_make_current(priv->resource_context);
-  }
-
-  return TRUE;
+  return FL_RENDERER_GET_CLASS(self)->make_resource_current(self, error);
 }
 
 gboolean fl_renderer_clear_current(FlRenderer* self, GError** error) {
-  gdk_gl_context_clear_current();
-  return TRUE;
+  return FL_RENDERER_GET_CLASS(self)->clear_current(self, error);
 }
 
 guint32 fl_renderer_get_fbo(FlRenderer* self) {
@@ -150,7 +175,12 @@ void fl_renderer_wait_for_frame(FlRenderer* self,
     priv->blocking_main_thread = true;
     FlTaskRunner* runner =
         fl_engine_get_task_runner(fl_view_get_engine(priv->view));
-    fl_task_runner_block_main_thread(runner);
+    if (!fl_task_runner_block_main_thread(runner, kMaxWaitForFrame)) {
+      // The frame at the new size is taking too long, keep presenting the
+      // frames at the old size until it arrives rather than freezing the
+      // window.
+      priv->blocking_main_thread = false;
+    }
   }
 }
 
@@ -97,6 +97,41 @@ struct _FlRendererClass {
   gboolean (*present_layers)(FlRenderer* renderer,
                              const FlutterLayer** layers,
                              size_t layers_count);
+
+  /**
+   * Virtual method called when Flutter needs the rendering context to be
+   * current. The default implementation uses the #GdkGLContext created by
+   * create_contexts.
+   * @renderer: an #FlRenderer.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Returns %TRUE if successful.
+   */
+  gboolean (*make_current)(FlRenderer* renderer, GError** error);
+
+  /**
+   * Virtual method called when Flutter needs the resource loading context to
+   * be current. The default implementation uses the #GdkGLContext created by
+   * create_contexts.
+   * @renderer: an #FlRenderer.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Returns %TRUE if successful.
+   */
+  gboolean (*make_resource_current)(FlRenderer* renderer, GError** error);
+
+  /**
+   * Virtual method called when Flutter no longer needs a context to be
+   * current on the calling thread.
+   * @renderer: an #FlRenderer.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Returns %TRUE if successful.
+   */
+  gboolean (*clear_current)(FlRenderer* renderer, GError** error);
 };
 
 /**
@@ -236,9 +271,9 @@ gboolean fl_renderer_present_layers(FlRenderer* renderer,
  * @target_width: width of frame being waited for
  * @target_height: height of frame being waited for
  *
- * Holds the thread until frame with requested dimensions is presented.
- * While waiting for frame Flutter platform and raster tasks are being
- * processed.
+ * Holds the thread until frame with requested dimensions is presented, or
+ * for at most 100 milliseconds. While waiting for frame Flutter platform and
+ * raster tasks are being processed.
  */
 void fl_renderer_wait_for_frame(FlRenderer* renderer,
                                 int target_width,
@@ -4,46 +4,261 @@
 
 #include "fl_renderer_headless.h"
 
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+
+#include "flutter/shell/platform/linux/fl_backing_store_provider.h"
+
 struct _FlRendererHeadless {
   FlRenderer parent_instance;
+
+  EGLDisplay display;
+
+  // Contexts are made current without a surface if the display supports it,
+  // otherwise each context is paired with a 1x1 pbuffer.
+  EGLContext main_context;
+  EGLSurface main_surface;
+  EGLContext resource_context;
+  EGLSurface resource_surface;
 };
 
 G_DEFINE_TYPE(FlRendererHeadless, fl_renderer_headless, fl_renderer_get_type())
 
+// Gets a display that does not need a window system, preferring the Mesa
+// surfaceless platform so no X11 or Wayland connection is opened.
+static EGLDisplay get_display() {
+  if (epoxy_has_egl_extension(EGL_NO_DISPLAY,
+                              "EGL_MESA_platform_surfaceless")) {
+    EGLDisplay display = eglGetPlatformDisplayEXT(
+        EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (display != EGL_NO_DISPLAY) {
+      return display;
+    }
+  }
+  return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+// Creates the EGL contexts the engine renders with. Errors are logged and
+// leave the contexts unset.
+static void setup_contexts(FlRendererHeadless* self) {
+  self->display = get_display();
+  if (self->display == EGL_NO_DISPLAY ||
+      !eglInitialize(self->display, nullptr, nullptr)) {
+    g_warning("Failed to initialize EGL display for headless renderer");
+    self->display = EGL_NO_DISPLAY;
+    return;
+  }
+
+  gboolean surfaceless =
+      epoxy_has_egl_extension(self->display, "EGL_KHR_surfaceless_context");
+
+  const EGLint config_attributes[] = {
+      EGL_RENDERABLE_TYPE,
+      EGL_OPENGL_ES2_BIT,
+      EGL_SURFACE_TYPE,
+      surfaceless ? EGL_DONT_CARE : EGL_PBUFFER_BIT,
+      EGL_RED_SIZE,
+      8,
+      EGL_GREEN_SIZE,
+      8,
+      EGL_BLUE_SIZE,
+      8,
+      EGL_ALPHA_SIZE,
+      8,
+      EGL_NONE};
+  EGLConfig config = nullptr;
+  EGLint n_config = 0;
+  if (!eglChooseConfig(self->display, config_attributes, &config, 1,
+                       &n_config) ||
+      n_config == 0) {
+    g_warning("Failed to choose EGL config for headless renderer");
+    return;
+  }
+
+  if (!eglBindAPI(EGL_OPENGL_ES_API)) {
+    g_warning("Failed to bind OpenGL ES API for headless renderer");
+    return;
+  }
+
+  const EGLint context_attributes[] = {EGL_CONTEXT_CLIENT_VERSION, 2,
+                                       EGL_NONE};
+  self->main_context = eglCreateContext(self->display, config, EGL_NO_CONTEXT,
+                                        context_attributes);
+  self->resource_context = eglCreateContext(
+      self->display, config, self->main_context, context_attributes);
+  if (self->main_context == EGL_NO_CONTEXT ||
+      self->resource_context == EGL_NO_CONTEXT) {
+    g_warning("Failed to create EGL contexts for headless renderer");
+    return;
+  }
+
+  if (!surfaceless) {
+    const EGLint pbuffer_attributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+    self->main_surface =
+        eglCreatePbufferSurface(self->display, config, pbuffer_attributes);
+    self->resource_surface =
+        eglCreatePbufferSurface(self->display, config, pbuffer_attributes);
+  }
+}
+
+static gboolean make_egl_current(FlRendererHeadless* self,
+                                 EGLContext context,
+                                 EGLSurface surface,
+                                 GError** error) {
+  if (context == EGL_NO_CONTEXT) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "No EGL context available for headless renderer");
+    return FALSE;
+  }
+
+  if (!eglMakeCurrent(self->display, surface, surface, context)) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "Failed to make EGL context current: 0x%x", eglGetError());
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+static void fl_renderer_headless_dispose(GObject* object) {
+  FlRendererHeadless* self = FL_RENDERER_HEADLESS(object);
+
+  if (self->display != EGL_NO_DISPLAY) {
+    if (self->main_surface != EGL_NO_SURFACE) {
+      eglDestroySurface(self->display, self->main_surface);
+      self->main_surface = EGL_NO_SURFACE;
+    }
+    if (self->resource_surface != EGL_NO_SURFACE) {
+      eglDestroySurface(self->display, self->resource_surface);
+      self->resource_surface = EGL_NO_SURFACE;
+    }
+    if (self->resource_context != EGL_NO_CONTEXT) {
+      eglDestroyContext(self->display, self->resource_context);
+      self->resource_context = EGL_NO_CONTEXT;
+    }
+    if (self->main_context != EGL_NO_CONTEXT) {
+      eglDestroyContext(self->display, self->main_context);
+      self->main_context = EGL_NO_CONTEXT;
+    }
+  }
+
+  G_OBJECT_CLASS(fl_renderer_headless_parent_class)->dispose(object);
+}
+
 // Implements FlRenderer::create_contexts.
 static gboolean fl_renderer_headless_create_contexts(FlRenderer* renderer,
                                                      GtkWidget* widget,
                                                      GdkGLContext** visible,
                                                      GdkGLContext** resource,
                                                      GError** error) {
+  // The EGL contexts are not tied to a widget, so there are no GDK contexts.
   return FALSE;
 }
 
+// Implements FlRenderer::make_current.
+static gboolean fl_renderer_headless_make_current(FlRenderer* renderer,
+                                                  GError** error) {
+  FlRendererHeadless* self = FL_RENDERER_HEADLESS(renderer);
+  return make_egl_current(self, self->main_context, self->main_surface,
+                          error);
+}
+
+// Implements FlRenderer::make_resource_current.
+static gboolean fl_renderer_headless_make_resource_current(FlRenderer* renderer,
+                                                           GError** error) {
+  FlRendererHeadless* self = FL_RENDERER_HEADLESS(renderer);
+  return make_egl_current(self, self->resource_context,
+                          self->resource_surface, error);
+}
+
+// Implements FlRenderer::clear_current.
+static gboolean fl_renderer_headless_clear_current(FlRenderer* renderer,
+                                                   GError** error) {
+  FlRendererHeadless* self = FL_RENDERER_HEADLESS(renderer);
+  if (self->display == EGL_NO_DISPLAY) {
+    return TRUE;
+  }
+
+  if (!eglMakeCurrent(self->display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                      EGL_NO_CONTEXT)) {
+    g_set_error(error, fl_renderer_error_quark(), FL_RENDERER_ERROR_FAILED,
+                "Failed to clear EGL context: 0x%x", eglGetError());
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 // Implements FlRenderer::create_backing_store.
 static gboolean fl_renderer_headless_create_backing_store(
     FlRenderer* renderer,
     const FlutterBackingStoreConfig* config,
     FlutterBackingStore* backing_store_out) {
-  return FALSE;
+  g_autoptr(GError) error = nullptr;
+  if (!fl_renderer_make_current(renderer, &error)) {
+    g_warning("Failed to make renderer current when creating backing store: %s",
+              error->message);
+    return FALSE;
+  }
+
+  FlBackingStoreProvider* provider =
+      fl_backing_store_provider_new(config->size.width, config->size.height);
+  if (!provider) {
+    g_warning("Failed to create backing store");
+    return FALSE;
+  }
+
+  backing_store_out->type = kFlutterBackingStoreTypeOpenGL;
+  backing_store_out->open_gl.type = kFlutterOpenGLTargetTypeFramebuffer;
+  backing_store_out->open_gl.framebuffer.user_data = provider;
+  backing_store_out->open_gl.framebuffer.name =
+      fl_backing_store_provider_get_gl_framebuffer_id(provider);
+  backing_store_out->open_gl.framebuffer.target =
+      fl_backing_store_provider_get_gl_format(provider);
+  backing_store_out->open_gl.framebuffer.destruction_callback = [](void* p) {
+    // Backing store destroyed in fl_renderer_headless_collect_backing_store(),
+    // set on FlutterCompositor.collect_backing_store_callback during engine
+    // start.
+  };
+
+  return TRUE;
 }
 
 // Implements FlRenderer::collect_backing_store.
 static gboolean fl_renderer_headless_collect_backing_store(
-    FlRenderer* self,
+    FlRenderer* renderer,
     const FlutterBackingStore* backing_store) {
-  return FALSE;
+  g_autoptr(GError) error = nullptr;
+  if (!fl_renderer_make_current(renderer, &error)) {
+    g_warning(
+        "Failed to make renderer current when collecting backing store: %s",
+        error->message);
+    return FALSE;
+  }
+
+  // OpenGL context is required when destroying #FlBackingStoreProvider.
+  g_object_unref(backing_store->open_gl.framebuffer.user_data);
+  return TRUE;
 }
 
 // Implements FlRenderer::present_layers.
-static gboolean fl_renderer_headless_present_layers(FlRenderer* self,
+static gboolean fl_renderer_headless_present_layers(FlRenderer* renderer,
                                                     const FlutterLayer** layers,
                                                     size_t layers_count) {
-  return FALSE;
+  // The layers stay in their offscreen backing stores; there is nothing to
+  // composite them onto.
+  return TRUE;
 }
 
 static void fl_renderer_headless_class_init(FlRendererHeadlessClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_renderer_headless_dispose;
+
   FL_RENDERER_CLASS(klass)->create_contexts =
       fl_renderer_headless_create_contexts;
+  FL_RENDERER_CLASS(klass)->make_current = fl_renderer_headless_make_current;
+  FL_RENDERER_CLASS(klass)->make_resource_current =
+      fl_renderer_headless_make_resource_current;
+  FL_RENDERER_CLASS(klass)->clear_current = fl_renderer_headless_clear_current;
   FL_RENDERER_CLASS(klass)->create_backing_store =
       fl_renderer_headless_create_backing_store;
   FL_RENDERER_CLASS(klass)->collect_backing_store =
@@ -52,9 +267,17 @@ static void fl_renderer_headless_class_init(FlRendererHeadlessClass* klass) {
       fl_renderer_headless_present_layers;
 }
 
-static void fl_renderer_headless_init(FlRendererHeadless* self) {}
+static void fl_renderer_headless_init(FlRendererHeadless* self) {
+  self->display = EGL_NO_DISPLAY;
+  self->main_context = EGL_NO_CONTEXT;
+  self->main_surface = EGL_NO_SURFACE;
+  self->resource_context = EGL_NO_CONTEXT;
+  self->resource_surface = EGL_NO_SURFACE;
+}
 
 FlRendererHeadless* fl_renderer_headless_new() {
-  return FL_RENDERER_HEADLESS(
+  FlRendererHeadless* self = FL_RENDERER_HEADLESS(
       g_object_new(fl_renderer_headless_get_type(), nullptr));
+  setup_contexts(self);
+  return self;
 }
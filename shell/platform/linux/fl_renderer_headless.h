@@ -19,7 +19,8 @@ G_DECLARE_FINAL_TYPE(FlRendererHeadless,
  * FlRendererHeadless:
  *
  * #FlRendererHeadless is an implementation of #FlRenderer that works without a
- * display.
+ * display. It renders with EGL contexts that are not tied to a window into
+ * offscreen backing stores, without going through GDK.
  */
 
 /**
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
 #include "flutter/shell/platform/linux/fl_standard_message_codec_private.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
@@ -28,6 +29,11 @@ static constexpr int kValueList = 12;
 static constexpr int kValueMap = 13;
 static constexpr int kValueFloat32List = 14;
 
+// Typed lists of at least this many bytes refer to the message they are read
+// from instead of copying it. Smaller lists are copied, so that they don't
+// keep the whole message alive.
+static constexpr size_t kMinWrappedListSize = 1024;
+
 struct _FlStandardMessageCodec {
   FlMessageCodec parent_instance;
 };
@@ -111,6 +117,36 @@ static const uint8_t* get_data(GBytes* buffer, size_t* offset) {
          *offset;
 }
 
+// Reads a typed list of @type occupying @size bytes at @offset in @buffer.
+static FlValue* read_typed_list(FlValueType type,
+                                GBytes* buffer,
+                                size_t offset,
+                                size_t size) {
+  if (size < kMinWrappedListSize) {
+    const uint8_t* data = get_data(buffer, &offset);
+    switch (type) {
+      case FL_VALUE_TYPE_UINT8_LIST:
+        return fl_value_new_uint8_list(data, size);
+      case FL_VALUE_TYPE_INT32_LIST:
+        return fl_value_new_int32_list(
+            reinterpret_cast<const int32_t*>(data), size / sizeof(int32_t));
+      case FL_VALUE_TYPE_INT64_LIST:
+        return fl_value_new_int64_list(
+            reinterpret_cast<const int64_t*>(data), size / sizeof(int64_t));
+      case FL_VALUE_TYPE_FLOAT32_LIST:
+        return fl_value_new_float32_list(reinterpret_cast<const float*>(data),
+                                         size / sizeof(float));
+      case FL_VALUE_TYPE_FLOAT_LIST:
+        return fl_value_new_float_list(reinterpret_cast<const double*>(data),
+                                       size / sizeof(double));
+      default:
+        g_return_val_if_reached(nullptr);
+    }
+  }
+  g_autoptr(GBytes) data = g_bytes_new_from_bytes(buffer, offset, size);
+  return fl_value_new_typed_list_from_bytes(type, data);
+}
+
 // Reads an unsigned 8 bit number from @buffer and writes it to @value.
 // Returns TRUE if successful, otherwise sets an error.
 static gboolean read_uint8(GBytes* buffer,
@@ -243,7 +279,8 @@ static FlValue* read_uint8_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(uint8_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_uint8_list(get_data(buffer, offset), length);
+  FlValue* value = read_typed_list(FL_VALUE_TYPE_UINT8_LIST, buffer, *offset,
+                                   sizeof(uint8_t) * length);
   *offset += length;
   return value;
 }
@@ -266,8 +303,8 @@ static FlValue* read_int32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int32_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int32_list(
-      reinterpret_cast<const int32_t*>(get_data(buffer, offset)), length);
+  FlValue* value = read_typed_list(FL_VALUE_TYPE_INT32_LIST, buffer, *offset,
+                                   sizeof(int32_t) * length);
   *offset += sizeof(int32_t) * length;
   return value;
 }
@@ -290,8 +327,8 @@ static FlValue* read_int64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(int64_t) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_int64_list(
-      reinterpret_cast<const int64_t*>(get_data(buffer, offset)), length);
+  FlValue* value = read_typed_list(FL_VALUE_TYPE_INT64_LIST, buffer, *offset,
+                                   sizeof(int64_t) * length);
   *offset += sizeof(int64_t) * length;
   return value;
 }
@@ -314,8 +351,8 @@ static FlValue* read_float32_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(float) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float32_list(
-      reinterpret_cast<const float*>(get_data(buffer, offset)), length);
+  FlValue* value = read_typed_list(FL_VALUE_TYPE_FLOAT32_LIST, buffer,
+                                   *offset, sizeof(float) * length);
   *offset += sizeof(float) * length;
   return value;
 }
@@ -338,8 +375,8 @@ static FlValue* read_float64_list_value(FlStandardMessageCodec* self,
   if (!check_size(buffer, *offset, sizeof(double) * length, error)) {
     return nullptr;
   }
-  FlValue* value = fl_value_new_float_list(
-      reinterpret_cast<const double*>(get_data(buffer, offset)), length);
+  FlValue* value = read_typed_list(FL_VALUE_TYPE_FLOAT_LIST, buffer, *offset,
+                                   sizeof(double) * length);
   *offset += sizeof(double) * length;
   return value;
 }
@@ -357,14 +394,17 @@ static FlValue* read_list_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) list = fl_value_new_list();
+  // Every child takes at least one byte, which bounds the space reserved
+  // for a list with a corrupt length.
+  g_autoptr(FlValue) list = fl_value_new_list_sized(
+      MIN(length, g_bytes_get_size(buffer) - *offset));
   for (size_t i = 0; i < length; i++) {
-    g_autoptr(FlValue) child =
+    FlValue* child =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
     if (child == nullptr) {
       return nullptr;
     }
-    fl_value_append(list, child);
+    fl_value_append_take(list, child);
   }
 
   return fl_value_ref(list);
@@ -383,7 +423,10 @@ static FlValue* read_map_value(FlStandardMessageCodec* self,
     return nullptr;
   }
 
-  g_autoptr(FlValue) map = fl_value_new_map();
+  // Every entry takes at least two bytes, which bounds the space reserved
+  // for a map with a corrupt length.
+  g_autoptr(FlValue) map = fl_value_new_map_sized(
+      MIN(length, (g_bytes_get_size(buffer) - *offset) / 2));
   for (size_t i = 0; i < length; i++) {
     g_autoptr(FlValue) key =
         fl_standard_message_codec_read_value(self, buffer, offset, error);
@@ -395,7 +438,10 @@ static FlValue* read_map_value(FlStandardMessageCodec* self,
     if (value == nullptr) {
       return nullptr;
     }
-    fl_value_set(map, key, value);
+    // The keys of a map sent by Dart are unique, so they don't need to be
+    // looked up as fl_value_set() would.
+    fl_value_map_append_take(map, static_cast<FlValue*>(g_steal_pointer(&key)),
+                             static_cast<FlValue*>(g_steal_pointer(&value)));
   }
 
   return fl_value_ref(map);
@@ -408,7 +454,8 @@ static GBytes* fl_standard_message_codec_encode_message(FlMessageCodec* codec,
   FlStandardMessageCodec* self =
       reinterpret_cast<FlStandardMessageCodec*>(codec);
 
-  g_autoptr(GByteArray) buffer = g_byte_array_new();
+  g_autoptr(GByteArray) buffer = g_byte_array_sized_new(
+      fl_standard_message_codec_get_encoded_size(self, 0, message));
   if (!fl_standard_message_codec_write_value(self, buffer, message, error)) {
     return nullptr;
   }
@@ -626,6 +673,100 @@ gboolean fl_standard_message_codec_write_value(FlStandardMessageCodec* self,
   return FALSE;
 }
 
+// Gets the number of bytes fl_standard_message_codec_write_size() writes for
+// @size.
+static size_t get_size_size(size_t size) {
+  if (size < 254) {
+    return sizeof(uint8_t);
+  } else if (size <= 0xffff) {
+    return sizeof(uint8_t) + sizeof(uint16_t);
+  } else {
+    return sizeof(uint8_t) + sizeof(uint32_t);
+  }
+}
+
+// Gets the number of padding bytes write_align() writes at @offset.
+static size_t get_align_size(size_t offset, size_t align) {
+  return (align - offset % align) % align;
+}
+
+// Gets the number of bytes a typed list of @length elements of @element_size
+// bytes takes when its type is written at @offset.
+static size_t get_typed_list_size(size_t offset,
+                                  size_t length,
+                                  size_t element_size) {
+  size_t end = offset + sizeof(uint8_t) + get_size_size(length);
+  end += get_align_size(end, element_size) + element_size * length;
+  return end - offset;
+}
+
+size_t fl_standard_message_codec_get_encoded_size(FlStandardMessageCodec* self,
+                                                  size_t offset,
+                                                  FlValue* value) {
+  if (value == nullptr) {
+    return sizeof(uint8_t);
+  }
+
+  switch (fl_value_get_type(value)) {
+    case FL_VALUE_TYPE_NULL:
+    case FL_VALUE_TYPE_BOOL:
+      return sizeof(uint8_t);
+    case FL_VALUE_TYPE_INT: {
+      int64_t v = fl_value_get_int(value);
+      return sizeof(uint8_t) + (v >= INT32_MIN && v <= INT32_MAX
+                                    ? sizeof(int32_t)
+                                    : sizeof(int64_t));
+    }
+    case FL_VALUE_TYPE_FLOAT: {
+      size_t end = offset + sizeof(uint8_t);
+      end += get_align_size(end, sizeof(double)) + sizeof(double);
+      return end - offset;
+    }
+    case FL_VALUE_TYPE_STRING: {
+      size_t length = strlen(fl_value_get_string(value));
+      return sizeof(uint8_t) + get_size_size(length) + length;
+    }
+    case FL_VALUE_TYPE_UINT8_LIST:
+      return get_typed_list_size(offset, fl_value_get_length(value),
+                                 sizeof(uint8_t));
+    case FL_VALUE_TYPE_INT32_LIST:
+      return get_typed_list_size(offset, fl_value_get_length(value),
+                                 sizeof(int32_t));
+    case FL_VALUE_TYPE_INT64_LIST:
+      return get_typed_list_size(offset, fl_value_get_length(value),
+                                 sizeof(int64_t));
+    case FL_VALUE_TYPE_FLOAT32_LIST:
+      return get_typed_list_size(offset, fl_value_get_length(value),
+                                 sizeof(float));
+    case FL_VALUE_TYPE_FLOAT_LIST:
+      return get_typed_list_size(offset, fl_value_get_length(value),
+                                 sizeof(double));
+    case FL_VALUE_TYPE_LIST: {
+      size_t length = fl_value_get_length(value);
+      size_t end = offset + sizeof(uint8_t) + get_size_size(length);
+      for (size_t i = 0; i < length; i++) {
+        end += fl_standard_message_codec_get_encoded_size(
+            self, end, fl_value_get_list_value(value, i));
+      }
+      return end - offset;
+    }
+    case FL_VALUE_TYPE_MAP: {
+      size_t length = fl_value_get_length(value);
+      size_t end = offset + sizeof(uint8_t) + get_size_size(length);
+      for (size_t i = 0; i < length; i++) {
+        end += fl_standard_message_codec_get_encoded_size(
+            self, end, fl_value_get_map_key(value, i));
+        end += fl_standard_message_codec_get_encoded_size(
+            self, end, fl_value_get_map_value(value, i));
+      }
+      return end - offset;
+    }
+  }
+
+  // Unsupported values fail to be written, so they take no space.
+  return 0;
+}
+
 FlValue* fl_standard_message_codec_read_value(FlStandardMessageCodec* self,
                                               GBytes* buffer,
                                               size_t* offset,
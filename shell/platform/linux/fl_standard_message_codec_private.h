@@ -57,6 +57,22 @@ gboolean fl_standard_message_codec_write_value(FlStandardMessageCodec* codec,
                                                FlValue* value,
                                                GError** error);
 
+/**
+ * fl_standard_message_codec_get_encoded_size:
+ * @codec: an #FlStandardMessageCodec.
+ * @offset: position in the buffer the value would be written at, which
+ * determines the padding needed to align it.
+ * @value: (allow-none): value to measure.
+ *
+ * Gets the number of bytes fl_standard_message_codec_write_value() writes for
+ * @value at @offset, so that buffers can be allocated at their final size.
+ *
+ * Returns: the size of the encoding of @value.
+ */
+size_t fl_standard_message_codec_get_encoded_size(FlStandardMessageCodec* codec,
+                                                  size_t offset,
+                                                  FlValue* value);
+
 /**
  * fl_standard_message_codec_read_value:
  * @codec: an #FlStandardMessageCodec.
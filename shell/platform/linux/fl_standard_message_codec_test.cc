@@ -3,6 +3,10 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_standard_message_codec.h"
+
+#include <vector>
+
+#include "flutter/shell/platform/linux/fl_standard_message_codec_private.h"
 #include "flutter/shell/platform/linux/testing/fl_test.h"
 #include "gtest/gtest.h"
 
@@ -1059,6 +1063,44 @@ TEST(FlStandardMessageCodecTest, EncodeDecodeLargeMap) {
   ASSERT_TRUE(fl_value_equal(value, decoded_value));
 }
 
+TEST(FlStandardMessageCodecTest, EncodeDecodeLargeTypedLists) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+
+  std::vector<uint8_t> uint8_data(4096);
+  std::vector<double> float_data(1024);
+  for (size_t i = 0; i < float_data.size(); i++) {
+    uint8_data[i] = i % 256;
+    float_data[i] = i / 2.0;
+  }
+  g_autoptr(FlValue) value = fl_value_new_list();
+  fl_value_append_take(
+      value, fl_value_new_uint8_list(uint8_data.data(), uint8_data.size()));
+  fl_value_append_take(
+      value, fl_value_new_float_list(float_data.data(), float_data.size()));
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(GBytes) message =
+      fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), value, &error);
+  ASSERT_NE(message, nullptr);
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(fl_standard_message_codec_get_encoded_size(codec, 0, value),
+            g_bytes_get_size(message));
+
+  g_autoptr(FlValue) decoded_value =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  EXPECT_EQ(error, nullptr);
+  ASSERT_NE(decoded_value, nullptr);
+  ASSERT_TRUE(fl_value_equal(value, decoded_value));
+
+  // Large lists refer to the message they were decoded from.
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(message, nullptr));
+  const uint8_t* list = fl_value_get_uint8_list(
+      fl_value_get_list_value(decoded_value, 0));
+  EXPECT_GE(list, data);
+  EXPECT_LT(list, data + g_bytes_get_size(message));
+}
+
 TEST(FlStandardMessageCodecTest, DecodeUnknownType) {
   decode_error_value("0f", FL_MESSAGE_CODEC_ERROR,
                      FL_MESSAGE_CODEC_ERROR_UNSUPPORTED_TYPE);
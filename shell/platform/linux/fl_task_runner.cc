@@ -181,18 +181,27 @@ void fl_task_runner_post_task(FlTaskRunner* self,
   fl_task_runner_tasks_did_change_locked(self);
 }
 
-void fl_task_runner_block_main_thread(FlTaskRunner* self) {
+gboolean fl_task_runner_block_main_thread(FlTaskRunner* self,
+                                          gint64 timeout) {
   g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);
   (void)locker;  // unused variable
 
-  g_return_if_fail(self->blocking_main_thread == FALSE);
+  g_return_val_if_fail(self->blocking_main_thread == FALSE, FALSE);
 
   g_object_ref(self);
 
+  gint64 end_time = g_get_monotonic_time() + timeout;
+  gboolean released = TRUE;
   self->blocking_main_thread = true;
   while (self->blocking_main_thread) {
-    g_cond_wait_until(&self->cond, &self->mutex,
-                      fl_task_runner_next_task_expiration_time_locked(self));
+    if (g_get_monotonic_time() >= end_time) {
+      self->blocking_main_thread = FALSE;
+      released = FALSE;
+      break;
+    }
+    g_cond_wait_until(
+        &self->cond, &self->mutex,
+        MIN(end_time, fl_task_runner_next_task_expiration_time_locked(self)));
     fl_task_runner_process_expired_tasks_locked(self);
   }
 
@@ -200,6 +209,8 @@ void fl_task_runner_block_main_thread(FlTaskRunner* self) {
   fl_task_runner_tasks_did_change_locked(self);
 
   g_object_unref(self);
+
+  return released;
 }
 
 void fl_task_runner_release_main_thread(FlTaskRunner* self) {
@@ -40,13 +40,19 @@ void fl_task_runner_post_task(FlTaskRunner* task_runner,
 /**
  * fl_task_runner_block_main_thread:
  * @task_runner: an #FlTaskRunner.
+ * @timeout: the maximum time to block for, in microseconds.
  *
- * Blocks main thread until fl_task_runner_release_main_thread is called.
+ * Blocks main thread until fl_task_runner_release_main_thread is called or
+ * the timeout expires.
  * While main thread is blocked tasks posted to #FlTaskRunner are executed as
  * usual.
  * Must be invoked on main thread.
+ *
+ * Returns: %TRUE if the main thread was released, %FALSE if the timeout
+ * expired.
  */
-void fl_task_runner_block_main_thread(FlTaskRunner* task_runner);
+gboolean fl_task_runner_block_main_thread(FlTaskRunner* task_runner,
+                                          gint64 timeout);
 
 /**
  * fl_task_runner_release_main_thread:
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+#include "flutter/shell/platform/linux/fl_value_private.h"
 
 #include <gmodule.h>
 
@@ -37,30 +38,35 @@ typedef struct {
   FlValue parent;
   uint8_t* values;
   size_t values_length;
+  GBytes* bytes;
 } FlValueUint8List;
 
 typedef struct {
   FlValue parent;
   int32_t* values;
   size_t values_length;
+  GBytes* bytes;
 } FlValueInt32List;
 
 typedef struct {
   FlValue parent;
   int64_t* values;
   size_t values_length;
+  GBytes* bytes;
 } FlValueInt64List;
 
 typedef struct {
   FlValue parent;
   float* values;
   size_t values_length;
+  GBytes* bytes;
 } FlValueFloat32List;
 
 typedef struct {
   FlValue parent;
   double* values;
   size_t values_length;
+  GBytes* bytes;
 } FlValueFloatList;
 
 typedef struct {
@@ -81,6 +87,73 @@ static FlValue* fl_value_new(FlValueType type, size_t size) {
   return self;
 }
 
+// Creates a value of |size| bytes that is followed by |storage_size| bytes of
+// uninitialized storage for its contents, so that the value and its contents
+// take a single allocation.
+static FlValue* fl_value_new_with_storage(FlValueType type,
+                                          size_t size,
+                                          size_t storage_size) {
+  FlValue* self = static_cast<FlValue*>(g_malloc(size + storage_size));
+  memset(self, 0, size);
+  self->type = type;
+  self->ref_count = 1;
+  return self;
+}
+
+// Creates a typed list holding a copy of |data|.
+template <typename ListType, typename T>
+static FlValue* fl_value_new_typed_list(FlValueType type,
+                                        const T* data,
+                                        size_t data_length) {
+  ListType* self = reinterpret_cast<ListType*>(fl_value_new_with_storage(
+      type, sizeof(ListType), sizeof(T) * data_length));
+  self->values = reinterpret_cast<T*>(self + 1);
+  self->values_length = data_length;
+  if (data_length > 0) {
+    memcpy(self->values, data, sizeof(T) * data_length);
+  }
+  return reinterpret_cast<FlValue*>(self);
+}
+
+// Creates a typed list that refers to the contents of |data| instead of
+// copying them, unless they are not aligned for the type of the elements.
+template <typename ListType, typename T>
+static FlValue* fl_value_new_typed_list_wrapping(FlValueType type,
+                                                 GBytes* data) {
+  gsize size;
+  const T* d = static_cast<const T*>(g_bytes_get_data(data, &size));
+  if (reinterpret_cast<uintptr_t>(d) % alignof(T) != 0) {
+    ListType* self = reinterpret_cast<ListType*>(
+        fl_value_new_with_storage(type, sizeof(ListType), size));
+    self->values = reinterpret_cast<T*>(self + 1);
+    self->values_length = size / sizeof(T);
+    memcpy(self->values, d, sizeof(T) * self->values_length);
+    return reinterpret_cast<FlValue*>(self);
+  }
+  ListType* self =
+      reinterpret_cast<ListType*>(fl_value_new(type, sizeof(ListType)));
+  self->values = const_cast<T*>(d);
+  self->values_length = size / sizeof(T);
+  self->bytes = g_bytes_ref(data);
+  return reinterpret_cast<FlValue*>(self);
+}
+
+// Creates a string value holding a copy of the first |value_length| bytes of
+// |value|, stored in the same allocation as the value.
+static FlValue* fl_value_new_string_with_length(const gchar* value,
+                                                size_t value_length) {
+  FlValueString* self = reinterpret_cast<FlValueString*>(
+      fl_value_new_with_storage(FL_VALUE_TYPE_STRING, sizeof(FlValueString),
+                                value_length + 1));
+  self->value = reinterpret_cast<gchar*>(self + 1);
+  if (value_length > 0) {
+    // Like g_strndup(), stops at the first nul character of |value|.
+    strncpy(self->value, value, value_length);
+  }
+  self->value[value_length] = '\0';
+  return reinterpret_cast<FlValue*>(self);
+}
+
 // Helper function to match GDestroyNotify type.
 static void fl_value_destroy(gpointer value) {
   fl_value_unref(static_cast<FlValue*>(value));
@@ -263,82 +336,81 @@ G_MODULE_EXPORT FlValue* fl_value_new_float(double value) {
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_string(const gchar* value) {
-  FlValueString* self = reinterpret_cast<FlValueString*>(
-      fl_value_new(FL_VALUE_TYPE_STRING, sizeof(FlValueString)));
-  self->value = g_strdup(value);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_new_string_with_length(value,
+                                         value != nullptr ? strlen(value) : 0);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_string_sized(const gchar* value,
                                                    size_t value_length) {
-  FlValueString* self = reinterpret_cast<FlValueString*>(
-      fl_value_new(FL_VALUE_TYPE_STRING, sizeof(FlValueString)));
-  self->value =
-      value_length == 0 ? g_strdup("") : g_strndup(value, value_length);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_new_string_with_length(value, value_length);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_uint8_list(const uint8_t* data,
                                                  size_t data_length) {
-  FlValueUint8List* self = reinterpret_cast<FlValueUint8List*>(
-      fl_value_new(FL_VALUE_TYPE_UINT8_LIST, sizeof(FlValueUint8List)));
-  self->values_length = data_length;
-  self->values = static_cast<uint8_t*>(g_malloc(sizeof(uint8_t) * data_length));
-  memcpy(self->values, data, sizeof(uint8_t) * data_length);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_new_typed_list<FlValueUint8List>(FL_VALUE_TYPE_UINT8_LIST,
+                                                   data, data_length);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_uint8_list_from_bytes(GBytes* data) {
-  gsize length;
-  const uint8_t* d =
-      static_cast<const uint8_t*>(g_bytes_get_data(data, &length));
-  return fl_value_new_uint8_list(d, length);
+  return fl_value_new_typed_list_from_bytes(FL_VALUE_TYPE_UINT8_LIST, data);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_int32_list(const int32_t* data,
                                                  size_t data_length) {
-  FlValueInt32List* self = reinterpret_cast<FlValueInt32List*>(
-      fl_value_new(FL_VALUE_TYPE_INT32_LIST, sizeof(FlValueInt32List)));
-  self->values_length = data_length;
-  self->values = static_cast<int32_t*>(g_malloc(sizeof(int32_t) * data_length));
-  memcpy(self->values, data, sizeof(int32_t) * data_length);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_new_typed_list<FlValueInt32List>(FL_VALUE_TYPE_INT32_LIST,
+                                                   data, data_length);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_int64_list(const int64_t* data,
                                                  size_t data_length) {
-  FlValueInt64List* self = reinterpret_cast<FlValueInt64List*>(
-      fl_value_new(FL_VALUE_TYPE_INT64_LIST, sizeof(FlValueInt64List)));
-  self->values_length = data_length;
-  self->values = static_cast<int64_t*>(g_malloc(sizeof(int64_t) * data_length));
-  memcpy(self->values, data, sizeof(int64_t) * data_length);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_new_typed_list<FlValueInt64List>(FL_VALUE_TYPE_INT64_LIST,
+                                                   data, data_length);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_float32_list(const float* data,
                                                    size_t data_length) {
-  FlValueFloat32List* self = reinterpret_cast<FlValueFloat32List*>(
-      fl_value_new(FL_VALUE_TYPE_FLOAT32_LIST, sizeof(FlValueFloat32List)));
-  self->values_length = data_length;
-  self->values = static_cast<float*>(g_malloc(sizeof(float) * data_length));
-  memcpy(self->values, data, sizeof(float) * data_length);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_new_typed_list<FlValueFloat32List>(
+      FL_VALUE_TYPE_FLOAT32_LIST, data, data_length);
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_float_list(const double* data,
                                                  size_t data_length) {
-  FlValueFloatList* self = reinterpret_cast<FlValueFloatList*>(
-      fl_value_new(FL_VALUE_TYPE_FLOAT_LIST, sizeof(FlValueFloatList)));
-  self->values_length = data_length;
-  self->values = static_cast<double*>(g_malloc(sizeof(double) * data_length));
-  memcpy(self->values, data, sizeof(double) * data_length);
-  return reinterpret_cast<FlValue*>(self);
+  return fl_value_new_typed_list<FlValueFloatList>(FL_VALUE_TYPE_FLOAT_LIST,
+                                                   data, data_length);
+}
+
+FlValue* fl_value_new_typed_list_from_bytes(FlValueType type, GBytes* data) {
+  g_return_val_if_fail(data != nullptr, nullptr);
+
+  switch (type) {
+    case FL_VALUE_TYPE_UINT8_LIST:
+      return fl_value_new_typed_list_wrapping<FlValueUint8List, uint8_t>(type,
+                                                                         data);
+    case FL_VALUE_TYPE_INT32_LIST:
+      return fl_value_new_typed_list_wrapping<FlValueInt32List, int32_t>(type,
+                                                                         data);
+    case FL_VALUE_TYPE_INT64_LIST:
+      return fl_value_new_typed_list_wrapping<FlValueInt64List, int64_t>(type,
+                                                                         data);
+    case FL_VALUE_TYPE_FLOAT32_LIST:
+      return fl_value_new_typed_list_wrapping<FlValueFloat32List, float>(type,
+                                                                         data);
+    case FL_VALUE_TYPE_FLOAT_LIST:
+      return fl_value_new_typed_list_wrapping<FlValueFloatList, double>(type,
+                                                                        data);
+    default:
+      g_return_val_if_reached(nullptr);
+  }
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_list() {
+  return fl_value_new_list_sized(0);
+}
+
+FlValue* fl_value_new_list_sized(size_t reserved_size) {
   FlValueList* self = reinterpret_cast<FlValueList*>(
       fl_value_new(FL_VALUE_TYPE_LIST, sizeof(FlValueList)));
-  self->values = g_ptr_array_new_with_free_func(fl_value_destroy);
+  self->values = g_ptr_array_new_full(reserved_size, fl_value_destroy);
   return reinterpret_cast<FlValue*>(self);
 }
 
@@ -353,10 +425,14 @@ G_MODULE_EXPORT FlValue* fl_value_new_list_from_strv(
 }
 
 G_MODULE_EXPORT FlValue* fl_value_new_map() {
+  return fl_value_new_map_sized(0);
+}
+
+FlValue* fl_value_new_map_sized(size_t reserved_size) {
   FlValueMap* self = reinterpret_cast<FlValueMap*>(
       fl_value_new(FL_VALUE_TYPE_MAP, sizeof(FlValueMap)));
-  self->keys = g_ptr_array_new_with_free_func(fl_value_destroy);
-  self->values = g_ptr_array_new_with_free_func(fl_value_destroy);
+  self->keys = g_ptr_array_new_full(reserved_size, fl_value_destroy);
+  self->values = g_ptr_array_new_full(reserved_size, fl_value_destroy);
   return reinterpret_cast<FlValue*>(self);
 }
 
@@ -374,35 +450,31 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     return;
   }
 
+  // Strings and copied typed lists are stored in the allocation of the value.
   switch (self->type) {
-    case FL_VALUE_TYPE_STRING: {
-      FlValueString* v = reinterpret_cast<FlValueString*>(self);
-      g_free(v->value);
-      break;
-    }
     case FL_VALUE_TYPE_UINT8_LIST: {
       FlValueUint8List* v = reinterpret_cast<FlValueUint8List*>(self);
-      g_free(v->values);
+      g_clear_pointer(&v->bytes, g_bytes_unref);
       break;
     }
     case FL_VALUE_TYPE_INT32_LIST: {
       FlValueInt32List* v = reinterpret_cast<FlValueInt32List*>(self);
-      g_free(v->values);
+      g_clear_pointer(&v->bytes, g_bytes_unref);
       break;
     }
     case FL_VALUE_TYPE_INT64_LIST: {
       FlValueInt64List* v = reinterpret_cast<FlValueInt64List*>(self);
-      g_free(v->values);
+      g_clear_pointer(&v->bytes, g_bytes_unref);
       break;
     }
     case FL_VALUE_TYPE_FLOAT32_LIST: {
       FlValueFloat32List* v = reinterpret_cast<FlValueFloat32List*>(self);
-      g_free(v->values);
+      g_clear_pointer(&v->bytes, g_bytes_unref);
       break;
     }
     case FL_VALUE_TYPE_FLOAT_LIST: {
       FlValueFloatList* v = reinterpret_cast<FlValueFloatList*>(self);
-      g_free(v->values);
+      g_clear_pointer(&v->bytes, g_bytes_unref);
       break;
     }
     case FL_VALUE_TYPE_LIST: {
@@ -420,6 +492,7 @@ G_MODULE_EXPORT void fl_value_unref(FlValue* self) {
     case FL_VALUE_TYPE_BOOL:
     case FL_VALUE_TYPE_INT:
     case FL_VALUE_TYPE_FLOAT:
+    case FL_VALUE_TYPE_STRING:
       break;
   }
   g_free(self);
@@ -596,6 +669,17 @@ G_MODULE_EXPORT void fl_value_set_take(FlValue* self,
   }
 }
 
+void fl_value_map_append_take(FlValue* self, FlValue* key, FlValue* value) {
+  g_return_if_fail(self != nullptr);
+  g_return_if_fail(self->type == FL_VALUE_TYPE_MAP);
+  g_return_if_fail(key != nullptr);
+  g_return_if_fail(value != nullptr);
+
+  FlValueMap* v = reinterpret_cast<FlValueMap*>(self);
+  g_ptr_array_add(v->keys, key);
+  g_ptr_array_add(v->values, value);
+}
+
 G_MODULE_EXPORT void fl_value_set_string(FlValue* self,
                                          const gchar* key,
                                          FlValue* value) {
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
+
+#include "flutter/shell/platform/linux/public/flutter_linux/fl_value.h"
+
+G_BEGIN_DECLS
+
+/**
+ * fl_value_new_typed_list_from_bytes:
+ * @type: the type of the list, one of the typed list types.
+ * @data: a #GBytes with the elements of the list.
+ *
+ * Creates a typed list that refers to the contents of @data instead of
+ * copying them. @data is referenced until the #FlValue is freed. The contents
+ * are copied if they are not aligned for the type of the elements.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_typed_list_from_bytes(FlValueType type, GBytes* data);
+
+/**
+ * fl_value_new_list_sized:
+ * @reserved_size: number of children to allocate space for.
+ *
+ * Creates an empty ordered list like fl_value_new_list() with space for
+ * @reserved_size children, so that adding them doesn't reallocate the list.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_list_sized(size_t reserved_size);
+
+/**
+ * fl_value_new_map_sized:
+ * @reserved_size: number of entries to allocate space for.
+ *
+ * Creates an empty map like fl_value_new_map() with space for @reserved_size
+ * entries, so that adding them doesn't reallocate the map.
+ *
+ * Returns: a new #FlValue.
+ */
+FlValue* fl_value_new_map_sized(size_t reserved_size);
+
+/**
+ * fl_value_map_append_take:
+ * @value: an #FlValue of type #FL_VALUE_TYPE_MAP.
+ * @key: (transfer full): an #FlValue.
+ * @child_value: (transfer full): an #FlValue.
+ *
+ * Adds an entry to the end of a map without checking whether @key is already
+ * in it, for building maps whose keys are known to be unique. This avoids the
+ * lookup of fl_value_set_take(), which takes time linear in the size of the
+ * map.
+ */
+void fl_value_map_append_take(FlValue* value,
+                              FlValue* key,
+                              FlValue* child_value);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_VALUE_PRIVATE_H_
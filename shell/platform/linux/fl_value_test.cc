@@ -216,6 +216,18 @@ TEST(FlValueTest, Uint8ListNullptr) {
   ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(0));
 }
 
+TEST(FlValueTest, Uint8ListFromBytes) {
+  uint8_t data[] = {0x00, 0x01, 0xFE, 0xFF};
+  g_autoptr(GBytes) bytes = g_bytes_new(data, 4);
+  g_autoptr(FlValue) value = fl_value_new_uint8_list_from_bytes(bytes);
+  ASSERT_EQ(fl_value_get_type(value), FL_VALUE_TYPE_UINT8_LIST);
+  ASSERT_EQ(fl_value_get_length(value), static_cast<size_t>(4));
+  // The list refers to the contents of the bytes instead of copying them.
+  EXPECT_EQ(fl_value_get_uint8_list(value),
+            g_bytes_get_data(bytes, nullptr));
+  EXPECT_EQ(fl_value_get_uint8_list(value)[2], 0xFE);
+}
+
 TEST(FlValueTest, Uint8ListEqual) {
   uint8_t data1[] = {1, 2, 3};
   g_autoptr(FlValue) value1 = fl_value_new_uint8_list(data1, 3);
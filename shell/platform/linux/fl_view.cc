@@ -56,6 +56,11 @@ struct _FlView {
   // Tracks whether mouse pointer is inside the view.
   gboolean pointer_inside;
 
+  // Frame clock of the window the view is in, which reports the timing of the
+  // display to the engine.
+  GdkFrameClock* frame_clock;
+  gulong frame_clock_after_paint_cb_id;  // Signal connection ID.
+
   /* FlKeyboardViewDelegate related properties */
   KeyboardLayoutNotifier keyboard_layout_notifier;
   GdkKeymap* keymap;
@@ -480,6 +485,35 @@ static void gesture_zoom_end_cb(GtkGestureZoom* gesture,
   fl_scrolling_manager_handle_zoom_end(self->scrolling_manager);
 }
 
+// Called after the window the view is in has been painted, with the timing of
+// the display the frame is presented on.
+static void frame_clock_after_paint_cb(GdkFrameClock* frame_clock,
+                                       FlView* self) {
+  gint64 frame_time = gdk_frame_clock_get_frame_time(frame_clock);
+  gint64 refresh_interval = 0;
+  gint64 presentation_time = 0;
+  gdk_frame_clock_get_refresh_info(frame_clock, frame_time, &refresh_interval,
+                                   &presentation_time);
+  // The presentation time is zero when the windowing system doesn't report
+  // it, in which case frames are aligned to the frame clock instead.
+  fl_engine_set_refresh_info(
+      self->engine, presentation_time != 0 ? presentation_time : frame_time,
+      refresh_interval);
+}
+
+static void disconnect_frame_clock(FlView* self) {
+  if (self->frame_clock_after_paint_cb_id != 0) {
+    g_signal_handler_disconnect(self->frame_clock,
+                                self->frame_clock_after_paint_cb_id);
+    self->frame_clock_after_paint_cb_id = 0;
+  }
+  g_clear_object(&self->frame_clock);
+}
+
+static void unrealize_cb(GtkWidget* widget) {
+  disconnect_frame_clock(FL_VIEW(widget));
+}
+
 static void realize_cb(GtkWidget* widget) {
   FlView* self = FL_VIEW(widget);
   g_autoptr(GError) error = nullptr;
@@ -491,6 +525,14 @@ static void realize_cb(GtkWidget* widget) {
 
   init_keyboard(self);
 
+  GdkFrameClock* frame_clock = gtk_widget_get_frame_clock(widget);
+  if (frame_clock != nullptr) {
+    self->frame_clock = GDK_FRAME_CLOCK(g_object_ref(frame_clock));
+    self->frame_clock_after_paint_cb_id =
+        g_signal_connect(frame_clock, "after-paint",
+                         G_CALLBACK(frame_clock_after_paint_cb), self);
+  }
+
   if (!fl_renderer_start(self->renderer, self, &error)) {
     g_warning("Failed to start Flutter renderer: %s", error->message);
     return;
@@ -566,6 +608,7 @@ static void fl_view_constructed(GObject* object) {
   g_signal_connect(rotate, "end", G_CALLBACK(gesture_rotation_end_cb), self);
 
   g_signal_connect(self, "realize", G_CALLBACK(realize_cb), self);
+  g_signal_connect(self, "unrealize", G_CALLBACK(unrealize_cb), self);
   g_signal_connect(self, "size-allocate", G_CALLBACK(configure_cb), self);
 }
 
@@ -624,6 +667,8 @@ static void fl_view_dispose(GObject* object) {
                                                 nullptr);
   }
 
+  disconnect_frame_clock(self);
+
   g_clear_object(&self->project);
   g_clear_object(&self->renderer);
   g_clear_object(&self->engine);
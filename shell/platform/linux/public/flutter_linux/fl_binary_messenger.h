@@ -41,6 +41,12 @@ G_DECLARE_DERIVABLE_TYPE(FlBinaryMessengerResponseHandle,
                          BINARY_MESSENGER_RESPONSE_HANDLE,
                          GObject)
 
+G_DECLARE_FINAL_TYPE(FlBinaryMessengerTaskQueue,
+                     fl_binary_messenger_task_queue,
+                     FL,
+                     BINARY_MESSENGER_TASK_QUEUE,
+                     GObject)
+
 /**
  * FlBinaryMessengerMessageHandler:
  * @messenger: an #FlBinaryMessenger.
@@ -107,6 +113,14 @@ struct _FlBinaryMessengerResponseHandleClass {
  * #FlBinaryMessengerResponseHandle is an object used to send responses with.
  */
 
+/**
+ * FlBinaryMessengerTaskQueue:
+ *
+ * #FlBinaryMessengerTaskQueue is a queue of messages that are handled on a
+ * background thread instead of the platform thread. The messages of a queue
+ * are handled one at a time, in the order they were received.
+ */
+
 /**
  * fl_binary_messenger_set_platform_message_handler:
  * @binary_messenger: an #FlBinaryMessenger.
@@ -131,6 +145,50 @@ void fl_binary_messenger_set_message_handler_on_channel(
     gpointer user_data,
     GDestroyNotify destroy_notify);
 
+/**
+ * fl_binary_messenger_make_background_task_queue:
+ * @binary_messenger: an #FlBinaryMessenger.
+ *
+ * Creates a queue to handle the messages of one or more channels on a
+ * background thread with
+ * fl_binary_messenger_set_message_handler_on_channel_with_task_queue(). Handlers
+ * that do expensive work, such as disk or database access, should use a task
+ * queue so they don't block the platform thread from handling window events.
+ *
+ * Returns: a new #FlBinaryMessengerTaskQueue.
+ */
+FlBinaryMessengerTaskQueue* fl_binary_messenger_make_background_task_queue(
+    FlBinaryMessenger* messenger);
+
+/**
+ * fl_binary_messenger_set_message_handler_on_channel_with_task_queue:
+ * @binary_messenger: an #FlBinaryMessenger.
+ * @channel: channel to listen on.
+ * @handler: (allow-none): function to call when a message is received on this
+ * channel or %NULL to disable a handler
+ * @user_data: (closure): user data to pass to @handler.
+ * @destroy_notify: (allow-none): a function which gets called to free
+ * @user_data, or %NULL.
+ * @task_queue: (allow-none): the #FlBinaryMessengerTaskQueue to call @handler
+ * on, or %NULL to call it on the platform thread.
+ *
+ * Sets the function called when a platform message is received on the given
+ * channel, like fl_binary_messenger_set_message_handler_on_channel(), but
+ * calls it on the thread of @task_queue. @handler may respond to messages
+ * directly from that thread, since fl_binary_messenger_send_response() is
+ * thread-safe.
+ *
+ * Once the handler is removed, @destroy_notify is called on the platform
+ * thread after the messages already queued for @handler have been handled.
+ */
+void fl_binary_messenger_set_message_handler_on_channel_with_task_queue(
+    FlBinaryMessenger* messenger,
+    const gchar* channel,
+    FlBinaryMessengerMessageHandler handler,
+    gpointer user_data,
+    GDestroyNotify destroy_notify,
+    FlBinaryMessengerTaskQueue* task_queue);
+
 /**
  * fl_binary_messenger_send_response:
  * @binary_messenger: an #FlBinaryMessenger.
@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_DMA_BUF_TEXTURE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_DMA_BUF_TEXTURE_H_
+
+#if !defined(__FLUTTER_LINUX_INSIDE__) && !defined(FLUTTER_LINUX_COMPILATION)
+#error "Only <flutter_linux/flutter_linux.h> can be included directly."
+#endif
+
+#include <glib-object.h>
+#include <stdint.h>
+#include "fl_texture.h"
+
+G_BEGIN_DECLS
+
+/**
+ * FL_DMA_BUF_TEXTURE_MAX_PLANES:
+ *
+ * The maximum number of planes of a DMA-BUF frame.
+ */
+#define FL_DMA_BUF_TEXTURE_MAX_PLANES 4
+
+/**
+ * FlDmaBufPlane:
+ * @fd: DMA-BUF file descriptor of the plane.
+ * @offset: offset of the plane in the buffer in bytes.
+ * @stride: number of bytes between the starts of two rows of the plane.
+ *
+ * A plane of a DMA-BUF frame.
+ */
+typedef struct {
+  int fd;
+  uint32_t offset;
+  uint32_t stride;
+} FlDmaBufPlane;
+
+G_DECLARE_DERIVABLE_TYPE(FlDmaBufTexture,
+                         fl_dma_buf_texture,
+                         FL,
+                         DMA_BUF_TEXTURE,
+                         GObject)
+
+/**
+ * FlDmaBufTexture:
+ *
+ * #FlDmaBufTexture represents a texture imported from a DMA-BUF, such as a
+ * frame decoded by a hardware video decoder or captured by a camera. The
+ * frame is imported with `EGL_EXT_image_dma_buf_import` and is never copied
+ * by the CPU.
+ *
+ * The following example shows how to implement an #FlDmaBufTexture.
+ * ![<!-- language="C" -->
+ *   struct _MyTexture {
+ *     FlDmaBufTexture parent_instance;
+ *
+ *     MyFrame *frame;  // your current frame.
+ *   }
+ *
+ *   G_DEFINE_TYPE(MyTexture,
+ *                 my_texture,
+ *                 fl_dma_buf_texture_get_type ())
+ *
+ *   static gboolean
+ *   my_texture_acquire_frame (FlDmaBufTexture* texture,
+ *                             uint32_t* fourcc,
+ *                             uint64_t* modifier,
+ *                             FlDmaBufPlane* planes,
+ *                             size_t* n_planes,
+ *                             uint32_t* width,
+ *                             uint32_t* height,
+ *                             GError** error) {
+ *     // This method is called on Render Thread. Be careful with your
+ *     // cross-thread operation.
+ *     MyTexture* self = MY_TEXTURE (texture);
+ *
+ *     *fourcc = DRM_FORMAT_NV12;
+ *     *modifier = DRM_FORMAT_MOD_LINEAR;
+ *     for (size_t i = 0; i < 2; i++) {
+ *       planes[i].fd = self->frame->fd;
+ *       planes[i].offset = self->frame->offsets[i];
+ *       planes[i].stride = self->frame->strides[i];
+ *     }
+ *     *n_planes = 2;
+ *     *width = self->frame->width;
+ *     *height = self->frame->height;
+ *     return TRUE;
+ *   }
+ *
+ *   static void my_texture_class_init(MyTextureClass* klass) {
+ *     FL_DMA_BUF_TEXTURE_CLASS(klass)->acquire_frame =
+ * my_texture_acquire_frame;
+ *   }
+ *
+ *   static void my_texture_init(MyTexture* self) {}
+ * ]|
+ */
+
+struct _FlDmaBufTextureClass {
+  GObjectClass parent_class;
+
+  /**
+   * FlDmaBufTexture::acquire_frame:
+   * @texture: an #FlDmaBufTexture.
+   * @fourcc: (out): DRM fourcc format of the frame, for example
+   * `DRM_FORMAT_ARGB8888` or `DRM_FORMAT_NV12`.
+   * @modifier: (out): DRM format modifier of the frame, or
+   * `DRM_FORMAT_MOD_INVALID` to use the implicit modifier of the buffer.
+   * @planes: (out): array of #FL_DMA_BUF_TEXTURE_MAX_PLANES planes to fill.
+   * @n_planes: (out): number of planes of the frame.
+   * @width: (inout): width of the frame in pixels.
+   * @height: (inout): height of the frame in pixels.
+   * @error: (allow-none): #GError location to store the error occurring, or
+   * %NULL to ignore.
+   *
+   * Retrieve the frame to show.
+   *
+   * As this method is usually invoked from the render thread, you must
+   * take care of proper synchronization. The buffers of the frame must not be
+   * released or written to before the next call of this method, or before
+   * this texture is unregistered. The frame is imported again only when any of
+   * the returned values change.
+   *
+   * Returns: %TRUE on success.
+   */
+  gboolean (*acquire_frame)(FlDmaBufTexture* texture,
+                            uint32_t* fourcc,
+                            uint64_t* modifier,
+                            FlDmaBufPlane* planes,
+                            size_t* n_planes,
+                            uint32_t* width,
+                            uint32_t* height,
+                            GError** error);
+};
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_DMA_BUF_TEXTURE_H_
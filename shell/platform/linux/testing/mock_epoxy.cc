@@ -6,6 +6,8 @@
 #include <epoxy/egl.h>
 #include <epoxy/gl.h>
 
+#include <cstring>
+
 typedef struct {
   EGLint config_id;
   EGLint buffer_size;
@@ -45,11 +47,15 @@ typedef struct {
 typedef struct {
 } MockSurface;
 
+typedef struct {
+} MockImage;
+
 static bool display_initialized = false;
 static MockDisplay mock_display;
 static MockConfig mock_config;
 static MockContext mock_context;
 static MockSurface mock_surface;
+static MockImage mock_image;
 
 static EGLint mock_error = EGL_SUCCESS;
 
@@ -135,6 +141,19 @@ EGLContext _eglCreateContext(EGLDisplay dpy,
   return &mock_context;
 }
 
+EGLImageKHR _eglCreateImageKHR(EGLDisplay dpy,
+                               EGLContext ctx,
+                               EGLenum target,
+                               EGLClientBuffer buffer,
+                               const EGLint* attrib_list) {
+  if (!check_display(dpy)) {
+    return EGL_NO_IMAGE_KHR;
+  }
+
+  mock_error = EGL_SUCCESS;
+  return &mock_image;
+}
+
 EGLSurface _eglCreatePbufferSurface(EGLDisplay dpy,
                                     EGLConfig config,
                                     const EGLint* attrib_list) {
@@ -158,6 +177,14 @@ EGLSurface _eglCreateWindowSurface(EGLDisplay dpy,
   return &mock_surface;
 }
 
+EGLBoolean _eglDestroyImageKHR(EGLDisplay dpy, EGLImageKHR image) {
+  if (!check_display(dpy)) {
+    return EGL_FALSE;
+  }
+
+  return bool_success();
+}
+
 EGLBoolean _eglGetConfigAttrib(EGLDisplay dpy,
                                EGLConfig config,
                                EGLint attribute,
@@ -254,6 +281,10 @@ EGLBoolean _eglGetConfigAttrib(EGLDisplay dpy,
   }
 }
 
+EGLDisplay _eglGetCurrentDisplay() {
+  return &mock_display;
+}
+
 EGLDisplay _eglGetDisplay(EGLNativeDisplayType display_id) {
   return &mock_display;
 }
@@ -342,6 +373,8 @@ void _glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {}
 
 void _glDeleteTextures(GLsizei n, const GLuint* textures) {}
 
+static void _glEGLImageTargetTexture2DOES(GLenum target, GLeglImageOES image) {}
+
 static void _glFramebufferTexture2D(GLenum target,
                                     GLenum attachment,
                                     GLenum textarget,
@@ -378,6 +411,10 @@ static GLenum _glGetError() {
   return GL_NO_ERROR;
 }
 
+bool epoxy_has_egl_extension(EGLDisplay dpy, const char* extension) {
+  return strcmp(extension, "EGL_EXT_image_dma_buf_import") == 0;
+}
+
 bool epoxy_has_gl_extension(const char* extension) {
   return false;
 }
@@ -419,6 +456,11 @@ EGLContext (*epoxy_eglCreateContext)(EGLDisplay dpy,
                                      EGLConfig config,
                                      EGLContext share_context,
                                      const EGLint* attrib_list);
+EGLImageKHR (*epoxy_eglCreateImageKHR)(EGLDisplay dpy,
+                                       EGLContext ctx,
+                                       EGLenum target,
+                                       EGLClientBuffer buffer,
+                                       const EGLint* attrib_list);
 EGLSurface (*epoxy_eglCreatePbufferSurface)(EGLDisplay dpy,
                                             EGLConfig config,
                                             const EGLint* attrib_list);
@@ -426,10 +468,12 @@ EGLSurface (*epoxy_eglCreateWindowSurface)(EGLDisplay dpy,
                                            EGLConfig config,
                                            EGLNativeWindowType win,
                                            const EGLint* attrib_list);
+EGLBoolean (*epoxy_eglDestroyImageKHR)(EGLDisplay dpy, EGLImageKHR image);
 EGLBoolean (*epoxy_eglGetConfigAttrib)(EGLDisplay dpy,
                                        EGLConfig config,
                                        EGLint attribute,
                                        EGLint* value);
+EGLDisplay (*epoxy_eglGetCurrentDisplay)();
 EGLDisplay (*epoxy_eglGetDisplay)(EGLNativeDisplayType display_id);
 EGLint (*epoxy_eglGetError)();
 void (*(*epoxy_eglGetProcAddress)(const char* procname))(void);
@@ -444,6 +488,7 @@ void (*epoxy_glBindFramebuffer)(GLenum target, GLuint framebuffer);
 void (*epoxy_glBindTexture)(GLenum target, GLuint texture);
 void (*epoxy_glDeleteFramebuffers)(GLsizei n, const GLuint* framebuffers);
 void (*epoxy_glDeleteTextures)(GLsizei n, const GLuint* textures);
+void (*epoxy_glEGLImageTargetTexture2DOES)(GLenum target, GLeglImageOES image);
 void (*epoxy_glFramebufferTexture2D)(GLenum target,
                                      GLenum attachment,
                                      GLenum textarget,
@@ -468,9 +513,12 @@ static void library_init() {
   epoxy_eglBindAPI = _eglBindAPI;
   epoxy_eglChooseConfig = _eglChooseConfig;
   epoxy_eglCreateContext = _eglCreateContext;
+  epoxy_eglCreateImageKHR = _eglCreateImageKHR;
   epoxy_eglCreatePbufferSurface = _eglCreatePbufferSurface;
   epoxy_eglCreateWindowSurface = _eglCreateWindowSurface;
+  epoxy_eglDestroyImageKHR = _eglDestroyImageKHR;
   epoxy_eglGetConfigAttrib = _eglGetConfigAttrib;
+  epoxy_eglGetCurrentDisplay = _eglGetCurrentDisplay;
   epoxy_eglGetDisplay = _eglGetDisplay;
   epoxy_eglGetError = _eglGetError;
   epoxy_eglGetProcAddress = _eglGetProcAddress;
@@ -482,6 +530,7 @@ static void library_init() {
   epoxy_glBindTexture = _glBindTexture;
   epoxy_glDeleteFramebuffers = _glDeleteFramebuffers;
   epoxy_glDeleteTextures = _glDeleteTextures;
+  epoxy_glEGLImageTargetTexture2DOES = _glEGLImageTargetTexture2DOES;
   epoxy_glFramebufferTexture2D = _glFramebufferTexture2D;
   epoxy_glGenFramebuffers = _glGenFramebuffers;
   epoxy_glGenTextures = _glGenTextures;
@@ -4,6 +4,9 @@
 
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
 
+#include <dxgi.h>
+
+#include <cstring>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -169,9 +172,27 @@ bool AngleSurfaceManager::Initialize() {
     return false;
   }
 
+  const char* extensions = eglQueryString(egl_display_, EGL_EXTENSIONS);
+  supports_direct_composition_ =
+      extensions != nullptr &&
+      strstr(extensions, "EGL_ANGLE_direct_composition") != nullptr;
+
+  LimitFrameLatency();
+
   return true;
 }
 
+void AngleSurfaceManager::LimitFrameLatency() {
+  Microsoft::WRL::ComPtr<ID3D11Device> device;
+  if (!GetDevice(device.GetAddressOf())) {
+    return;
+  }
+  Microsoft::WRL::ComPtr<IDXGIDevice1> dxgi_device;
+  if (SUCCEEDED(device.As(&dxgi_device))) {
+    dxgi_device->SetMaximumFrameLatency(1);
+  }
+}
+
 void AngleSurfaceManager::CleanUp() {
   EGLBoolean result = EGL_FALSE;
 
@@ -215,15 +236,17 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
   }
 
   EGLSurface surface = EGL_NO_SURFACE;
-
-  const EGLint surfaceAttributes[] = {
-      EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width,
-      EGL_HEIGHT,           height,   EGL_NONE};
-
-  surface = eglCreateWindowSurface(
-      egl_display_, egl_config_,
-      static_cast<EGLNativeWindowType>(std::get<HWND>(*render_target)),
-      surfaceAttributes);
+  if (supports_direct_composition_) {
+    // A flip-model swapchain presented through DirectComposition skips the
+    // copy into the window's redirection bitmap.
+    surface = CreateWindowSurface(render_target, width, height, true);
+    if (surface == EGL_NO_SURFACE) {
+      supports_direct_composition_ = false;
+    }
+  }
+  if (surface == EGL_NO_SURFACE) {
+    surface = CreateWindowSurface(render_target, width, height, false);
+  }
   if (surface == EGL_NO_SURFACE) {
     LogEglError("Surface creation failed.");
   }
@@ -234,6 +257,29 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
   return true;
 }
 
+EGLSurface AngleSurfaceManager::CreateWindowSurface(
+    WindowsRenderTarget* render_target,
+    EGLint width,
+    EGLint height,
+    bool direct_composition) {
+  const EGLint surface_attributes[] = {
+      EGL_FIXED_SIZE_ANGLE,
+      EGL_TRUE,
+      EGL_WIDTH,
+      width,
+      EGL_HEIGHT,
+      height,
+      EGL_DIRECT_COMPOSITION_ANGLE,
+      direct_composition ? EGL_TRUE : EGL_FALSE,
+      EGL_NONE,
+  };
+
+  return eglCreateWindowSurface(
+      egl_display_, egl_config_,
+      static_cast<EGLNativeWindowType>(std::get<HWND>(*render_target)),
+      surface_attributes);
+}
+
 void AngleSurfaceManager::ResizeSurface(WindowsRenderTarget* render_target,
                                         EGLint width,
                                         EGLint height) {
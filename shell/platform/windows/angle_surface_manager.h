@@ -88,6 +88,17 @@ class AngleSurfaceManager {
   bool Initialize();
   void CleanUp();
 
+  // Creates a window surface for |render_target|, presented through
+  // DirectComposition when |direct_composition| is true.
+  EGLSurface CreateWindowSurface(WindowsRenderTarget* render_target,
+                                 EGLint width,
+                                 EGLint height,
+                                 bool direct_composition);
+
+  // Limits the number of frames DXGI queues ahead of the display to one, so
+  // that a presented frame reaches the screen on the next vblank.
+  void LimitFrameLatency();
+
   // Attempts to initialize EGL using ANGLE.
   bool InitializeEGL(
       PFNEGLGETPLATFORMDISPLAYEXTPROC egl_get_platform_display_EXT,
@@ -111,6 +122,11 @@ class AngleSurfaceManager {
   // creating surfaces.
   bool initialize_succeeded_;
 
+  // Whether ANGLE can present window surfaces through a DirectComposition
+  // visual with a flip-model swapchain. Cleared if creating such a surface
+  // fails, so that later surfaces use the redirection bitmap directly.
+  bool supports_direct_composition_ = false;
+
   // Current render_surface that engine will draw into.
   EGLSurface render_surface_ = EGL_NO_SURFACE;
 
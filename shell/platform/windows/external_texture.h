@@ -25,6 +25,28 @@ typedef void (*glTexImage2DProc)(GLenum target,
                                  GLenum format,
                                  GLenum type,
                                  const void* data);
+typedef void (*glTexSubImage2DProc)(GLenum target,
+                                    GLint level,
+                                    GLint xoffset,
+                                    GLint yoffset,
+                                    GLsizei width,
+                                    GLsizei height,
+                                    GLenum format,
+                                    GLenum type,
+                                    const void* data);
+typedef const GLubyte* (*glGetStringProc)(GLenum name);
+typedef void (*glGenBuffersProc)(GLsizei n, GLuint* buffers);
+typedef void (*glDeleteBuffersProc)(GLsizei n, const GLuint* buffers);
+typedef void (*glBindBufferProc)(GLenum target, GLuint buffer);
+typedef void (*glBufferDataProc)(GLenum target,
+                                 GLsizeiptr size,
+                                 const void* data,
+                                 GLenum usage);
+typedef void* (*glMapBufferRangeProc)(GLenum target,
+                                      GLintptr offset,
+                                      GLsizeiptr length,
+                                      GLbitfield access);
+typedef GLboolean (*glUnmapBufferProc)(GLenum target);
 
 // A struct containing pointers to resolved gl* functions.
 struct GlProcs {
@@ -33,6 +55,17 @@ struct GlProcs {
   glBindTextureProc glBindTexture;
   glTexParameteriProc glTexParameteri;
   glTexImage2DProc glTexImage2D;
+  glTexSubImage2DProc glTexSubImage2D;
+  // Optional functions used to stage pixel buffers in pixel buffer objects.
+  // They are only used if the context supports |GL_NV_pixel_buffer_object|,
+  // |GL_EXT_map_buffer_range| and |GL_OES_mapbuffer|.
+  glGetStringProc glGetString;
+  glGenBuffersProc glGenBuffers;
+  glDeleteBuffersProc glDeleteBuffers;
+  glBindBufferProc glBindBuffer;
+  glBufferDataProc glBufferData;
+  glMapBufferRangeProc glMapBufferRange;
+  glUnmapBufferProc glUnmapBuffer;
   bool valid;
 };
 
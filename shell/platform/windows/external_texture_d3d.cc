@@ -13,7 +13,7 @@ ExternalTextureD3d::ExternalTextureD3d(
     FlutterDesktopGpuSurfaceType type,
     const FlutterDesktopGpuSurfaceTextureCallback texture_callback,
     void* user_data,
-    const AngleSurfaceManager* surface_manager,
+    AngleSurfaceManager* surface_manager,
     const GlProcs& gl_procs)
     : type_(type),
       texture_callback_(texture_callback),
@@ -35,7 +35,7 @@ bool ExternalTextureD3d::PopulateTexture(size_t width,
   const FlutterDesktopGpuSurfaceDescriptor* descriptor =
       texture_callback_(width, height, user_data_);
 
-  if (!CreateOrUpdateTexture(descriptor)) {
+  if (!CreateOrUpdateTexture(descriptor) || !WaitForFence(descriptor)) {
     return false;
   }
 
@@ -116,4 +116,40 @@ bool ExternalTextureD3d::CreateOrUpdateTexture(
   return egl_surface_ != EGL_NO_SURFACE;
 }
 
+bool ExternalTextureD3d::WaitForFence(
+    const FlutterDesktopGpuSurfaceDescriptor* descriptor) {
+  void* fence_handle = SAFE_ACCESS(descriptor, fence_handle, nullptr);
+  if (fence_handle == nullptr) {
+    return true;
+  }
+
+  if (fence_handle != last_fence_handle_) {
+    fence_.Reset();
+    last_fence_handle_ = nullptr;
+
+    Microsoft::WRL::ComPtr<ID3D11Device> device;
+    Microsoft::WRL::ComPtr<ID3D11Device5> device5;
+    if (!surface_manager_->GetDevice(device.GetAddressOf()) ||
+        FAILED(device.As(&device5)) ||
+        FAILED(device5->OpenSharedFence(fence_handle,
+                                        IID_PPV_ARGS(fence_.GetAddressOf())))) {
+      FML_LOG(ERROR) << "Opening D3D fence failed.";
+      return false;
+    }
+
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> device_context;
+    device->GetImmediateContext(device_context.GetAddressOf());
+    if (FAILED(device_context.As(&device_context_))) {
+      FML_LOG(ERROR) << "Waiting for D3D fences is not supported.";
+      fence_.Reset();
+      return false;
+    }
+    last_fence_handle_ = fence_handle;
+  }
+
+  // The wait is queued on the GPU, so the raster thread does not block.
+  return SUCCEEDED(device_context_->Wait(
+      fence_.Get(), SAFE_ACCESS(descriptor, fence_value, 0)));
+}
+
 }  // namespace flutter
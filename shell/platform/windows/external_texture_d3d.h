@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
 #define FLUTTER_SHELL_PLATFORM_WINDOWS_EXTERNAL_TEXTURE_D3D_H_
 
+#include <d3d11_4.h>
+#include <wrl/client.h>
+
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/windows/angle_surface_manager.h"
 #include "flutter/shell/platform/windows/external_texture.h"
@@ -18,7 +21,7 @@ class ExternalTextureD3d : public ExternalTexture {
       FlutterDesktopGpuSurfaceType type,
       const FlutterDesktopGpuSurfaceTextureCallback texture_callback,
       void* user_data,
-      const AngleSurfaceManager* surface_manager,
+      AngleSurfaceManager* surface_manager,
       const GlProcs& gl_procs);
   virtual ~ExternalTextureD3d();
 
@@ -34,15 +37,23 @@ class ExternalTextureD3d : public ExternalTexture {
       const FlutterDesktopGpuSurfaceDescriptor* descriptor);
   // Detaches the previously attached surface, if any.
   void ReleaseImage();
+  // Makes the GPU wait for the fence of the descriptor, if any, before
+  // sampling the surface.
+  bool WaitForFence(const FlutterDesktopGpuSurfaceDescriptor* descriptor);
 
   FlutterDesktopGpuSurfaceType type_;
   const FlutterDesktopGpuSurfaceTextureCallback texture_callback_;
   void* const user_data_;
-  const AngleSurfaceManager* surface_manager_;
+  AngleSurfaceManager* surface_manager_;
   const GlProcs& gl_;
   GLuint gl_texture_ = 0;
   EGLSurface egl_surface_ = EGL_NO_SURFACE;
   void* last_surface_handle_ = nullptr;
+  // The fence opened from |last_fence_handle_| and the context of the ANGLE
+  // device that waits for it.
+  Microsoft::WRL::ComPtr<ID3D11Fence> fence_;
+  Microsoft::WRL::ComPtr<ID3D11DeviceContext4> device_context_;
+  void* last_fence_handle_ = nullptr;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ExternalTextureD3d);
 };
@@ -4,8 +4,27 @@
 
 #include "flutter/shell/platform/windows/external_texture_pixelbuffer.h"
 
+#include <cstring>
+
 namespace flutter {
 
+namespace {
+
+bool HasExtension(const char* extensions, const char* name) {
+  const size_t length = strlen(name);
+  for (const char* found = strstr(extensions, name); found != nullptr;
+       found = strstr(found + length, name)) {
+    const bool starts = found == extensions || found[-1] == ' ';
+    const bool ends = found[length] == ' ' || found[length] == '\0';
+    if (starts && ends) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 ExternalTexturePixelBuffer::ExternalTexturePixelBuffer(
     const FlutterDesktopPixelBufferTextureCallback texture_callback,
     void* user_data,
@@ -18,6 +37,9 @@ ExternalTexturePixelBuffer::~ExternalTexturePixelBuffer() {
   if (gl_texture_ != 0) {
     gl_.glDeleteTextures(1, &gl_texture_);
   }
+  if (pixel_buffer_object_ != 0) {
+    gl_.glDeleteBuffers(1, &pixel_buffer_object_);
+  }
 }
 
 bool ExternalTexturePixelBuffer::PopulateTexture(
@@ -62,13 +84,73 @@ bool ExternalTexturePixelBuffer::CopyPixelBuffer(size_t& width,
   } else {
     gl_.glBindTexture(GL_TEXTURE_2D, gl_texture_);
   }
-  gl_.glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, pixel_buffer->width,
-                   pixel_buffer->height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
-                   pixel_buffer->buffer);
+
+  // Only reallocate the storage of the texture when the size changes, so that
+  // updates do not wait for the texture to be released by previous frames.
+  if (width != texture_width_ || height != texture_height_) {
+    gl_.glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, nullptr);
+    texture_width_ = width;
+    texture_height_ = height;
+  }
+
+  // With a pixel buffer object bound, the texture is updated from the staged
+  // copy at offset 0 while rendering continues, instead of blocking on an
+  // upload from client memory.
+  const bool staged = StagePixels(pixel_buffer->buffer, width * height * 4);
+  gl_.glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA,
+                      GL_UNSIGNED_BYTE,
+                      staged ? nullptr : pixel_buffer->buffer);
+  if (staged) {
+    gl_.glBindBuffer(GL_PIXEL_UNPACK_BUFFER_NV, 0);
+  }
+
   if (pixel_buffer->release_callback) {
     pixel_buffer->release_callback(pixel_buffer->release_context);
   }
   return true;
 }
 
+bool ExternalTexturePixelBuffer::StagePixels(const uint8_t* pixels,
+                                             size_t size) {
+  if (!checked_pixel_buffer_object_support_) {
+    checked_pixel_buffer_object_support_ = true;
+    const char* extensions =
+        gl_.glGetString ? reinterpret_cast<const char*>(
+                              gl_.glGetString(GL_EXTENSIONS))
+                        : nullptr;
+    supports_pixel_buffer_objects_ =
+        extensions && gl_.glGenBuffers && gl_.glDeleteBuffers &&
+        gl_.glBindBuffer && gl_.glBufferData && gl_.glMapBufferRange &&
+        gl_.glUnmapBuffer &&
+        HasExtension(extensions, "GL_NV_pixel_buffer_object") &&
+        HasExtension(extensions, "GL_EXT_map_buffer_range") &&
+        HasExtension(extensions, "GL_OES_mapbuffer");
+  }
+  if (!supports_pixel_buffer_objects_) {
+    return false;
+  }
+
+  if (pixel_buffer_object_ == 0) {
+    gl_.glGenBuffers(1, &pixel_buffer_object_);
+  }
+  gl_.glBindBuffer(GL_PIXEL_UNPACK_BUFFER_NV, pixel_buffer_object_);
+  // Orphan the previous storage, which may still be read by a pending upload.
+  gl_.glBufferData(GL_PIXEL_UNPACK_BUFFER_NV, size, nullptr, GL_STREAM_DRAW);
+  void* staging = gl_.glMapBufferRange(
+      GL_PIXEL_UNPACK_BUFFER_NV, 0, size,
+      GL_MAP_WRITE_BIT_EXT | GL_MAP_INVALIDATE_BUFFER_BIT_EXT);
+  if (staging == nullptr) {
+    gl_.glBindBuffer(GL_PIXEL_UNPACK_BUFFER_NV, 0);
+    return false;
+  }
+  memcpy(staging, pixels, size);
+  if (gl_.glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER_NV) == GL_FALSE) {
+    // The contents of the buffer were lost.
+    gl_.glBindBuffer(GL_PIXEL_UNPACK_BUFFER_NV, 0);
+    return false;
+  }
+  return true;
+}
+
 }  // namespace flutter
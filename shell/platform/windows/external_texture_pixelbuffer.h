@@ -35,10 +35,23 @@ class ExternalTexturePixelBuffer : public ExternalTexture {
   // by |texture_callback_| was invalid.
   bool CopyPixelBuffer(size_t& width, size_t& height);
 
+  // Copies |pixels| into |pixel_buffer_object_|, from which the texture is
+  // updated asynchronously. Leaves the buffer bound on success.
+  // Returns false if pixel buffer objects are not supported.
+  bool StagePixels(const uint8_t* pixels, size_t size);
+
   const FlutterDesktopPixelBufferTextureCallback texture_callback_ = nullptr;
   void* const user_data_ = nullptr;
   const GlProcs& gl_;
   GLuint gl_texture_ = 0;
+  // The size the storage of |gl_texture_| was allocated with.
+  size_t texture_width_ = 0;
+  size_t texture_height_ = 0;
+  GLuint pixel_buffer_object_ = 0;
+  // Whether the extensions needed for pixel buffer objects have been checked,
+  // which can only be done once the context is current.
+  bool checked_pixel_buffer_object_support_ = false;
+  bool supports_pixel_buffer_objects_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ExternalTexturePixelBuffer);
 };
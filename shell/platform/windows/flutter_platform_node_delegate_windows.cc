@@ -30,19 +30,10 @@ FlutterPlatformNodeDelegateWindows::~FlutterPlatformNodeDelegateWindows() {
   }
 }
 
-// |ui::AXPlatformNodeDelegate|
-void FlutterPlatformNodeDelegateWindows::Init(std::weak_ptr<OwnerBridge> bridge,
-                                              ui::AXNode* node) {
-  FlutterPlatformNodeDelegate::Init(bridge, node);
-  ax_platform_node_ = ui::AXPlatformNode::Create(this);
-  FML_DCHECK(ax_platform_node_) << "Failed to create AXPlatformNode";
-}
-
 // |ui::AXPlatformNodeDelegate|
 gfx::NativeViewAccessible
 FlutterPlatformNodeDelegateWindows::GetNativeViewAccessible() {
-  FML_DCHECK(ax_platform_node_) << "AXPlatformNode hasn't been created";
-  return ax_platform_node_->GetNativeViewAccessible();
+  return GetPlatformNode()->GetNativeViewAccessible();
 }
 
 // |ui::AXPlatformNodeDelegate|
@@ -75,7 +66,7 @@ gfx::NativeViewAccessible FlutterPlatformNodeDelegateWindows::HitTestSync(
   }
 
   // If no children contain the point, but this node does, return this node.
-  return ax_platform_node_->GetNativeViewAccessible();
+  return GetPlatformNode()->GetNativeViewAccessible();
 }
 
 // |FlutterPlatformNodeDelegate|
@@ -95,7 +86,7 @@ gfx::Rect FlutterPlatformNodeDelegateWindows::GetBoundsRect(
 
 void FlutterPlatformNodeDelegateWindows::DispatchWinAccessibilityEvent(
     ax::mojom::Event event_type) {
-  ax_platform_node_->NotifyAccessibilityEvent(event_type);
+  GetPlatformNode()->NotifyAccessibilityEvent(event_type);
 }
 
 void FlutterPlatformNodeDelegateWindows::SetFocus() {
@@ -112,6 +103,11 @@ FlutterPlatformNodeDelegateWindows::GetTargetForNativeAccessibilityEvent() {
 
 ui::AXPlatformNode* FlutterPlatformNodeDelegateWindows::GetPlatformNode()
     const {
+  if (!ax_platform_node_) {
+    ax_platform_node_ = ui::AXPlatformNode::Create(
+        const_cast<FlutterPlatformNodeDelegateWindows*>(this));
+    FML_DCHECK(ax_platform_node_) << "Failed to create AXPlatformNode";
+  }
   return ax_platform_node_;
 }
 
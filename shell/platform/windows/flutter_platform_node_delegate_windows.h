@@ -23,9 +23,6 @@ class FlutterPlatformNodeDelegateWindows : public FlutterPlatformNodeDelegate {
                                      FlutterWindowsView* view);
   virtual ~FlutterPlatformNodeDelegateWindows();
 
-  // |ui::AXPlatformNodeDelegate|
-  void Init(std::weak_ptr<OwnerBridge> bridge, ui::AXNode* node) override;
-
   // |ui::AXPlatformNodeDelegate|
   gfx::NativeViewAccessible GetNativeViewAccessible() override;
 
@@ -53,10 +50,14 @@ class FlutterPlatformNodeDelegateWindows : public FlutterPlatformNodeDelegate {
   gfx::AcceleratedWidget GetTargetForNativeAccessibilityEvent() override;
 
   // | FlutterPlatformNodeDelegate |
+  //
+  // The platform node is created the first time it is needed, when an
+  // assistive technology queries the node or an event is raised for it, so
+  // committing a semantics tree does not create a COM object for every node.
   ui::AXPlatformNode* GetPlatformNode() const override;
 
  private:
-  ui::AXPlatformNode* ax_platform_node_;
+  mutable ui::AXPlatformNode* ax_platform_node_ = nullptr;
   std::weak_ptr<AccessibilityBridge> bridge_;
   FlutterWindowsView* view_;
 
@@ -403,6 +403,9 @@ bool FlutterWindowsEngine::Run(std::string_view entrypoint) {
 
 bool FlutterWindowsEngine::Stop() {
   if (engine_) {
+    // The vertical blank callbacks use the engine on the threads of the
+    // monitors, so those threads are stopped before the engine shuts down.
+    vblank_waiter_->Shutdown();
     for (const auto& [callback, registrar] :
          plugin_registrar_destruction_callbacks_) {
       callback(registrar);
@@ -420,6 +423,26 @@ void FlutterWindowsEngine::SetView(FlutterWindowsView* view) {
 }
 
 void FlutterWindowsEngine::OnVsync(intptr_t baton) {
+  // Frames start on the vertical blank of the monitor the view is on, unless
+  // the frame interval was overridden for testing.
+  if (!frame_interval_override_.has_value()) {
+    HMONITOR monitor =
+        view_ ? MonitorFromWindow(view_->GetPlatformWindow(),
+                                  MONITOR_DEFAULTTONEAREST)
+              : MonitorFromPoint({0, 0}, MONITOR_DEFAULTTOPRIMARY);
+    if (vblank_waiter_->AwaitVBlank(
+            monitor,
+            [this, baton](std::chrono::nanoseconds refresh_interval) {
+              std::chrono::nanoseconds vblank_time =
+                  std::chrono::nanoseconds(embedder_api_.GetCurrentTime());
+              embedder_api_.OnVsync(engine_, baton, vblank_time.count(),
+                                    (vblank_time + refresh_interval).count());
+            })) {
+      return;
+    }
+  }
+
+  // Otherwise frames are aligned to the refresh rate of the compositor.
   std::chrono::nanoseconds current_time =
       std::chrono::nanoseconds(embedder_api_.GetCurrentTime());
   std::chrono::nanoseconds frame_interval = FrameInterval();
@@ -33,6 +33,7 @@
 #include "flutter/shell/platform/windows/settings_plugin.h"
 #include "flutter/shell/platform/windows/task_runner.h"
 #include "flutter/shell/platform/windows/text_input_plugin.h"
+#include "flutter/shell/platform/windows/vblank_waiter.h"
 #include "flutter/shell/platform/windows/window_proc_delegate_manager.h"
 #include "flutter/shell/platform/windows/window_state.h"
 #include "flutter/shell/platform/windows/windows_lifecycle_manager.h"
@@ -390,6 +391,10 @@ class FlutterWindowsEngine {
   std::optional<std::chrono::nanoseconds> frame_interval_override_ =
       std::nullopt;
 
+  // Waits for the vertical blanks of the monitor the view is on.
+  std::unique_ptr<VBlankWaiter> vblank_waiter_ =
+      std::make_unique<VBlankWaiter>();
+
   bool semantics_enabled_ = false;
 
   bool high_contrast_enabled_ = false;
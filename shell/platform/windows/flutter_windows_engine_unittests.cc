@@ -170,6 +170,41 @@ TEST_F(FlutterWindowsEngineTest, ConfiguresFrameVsync) {
   EXPECT_TRUE(on_vsync_called);
 }
 
+TEST_F(FlutterWindowsEngineTest, AlignsFramesToMonitorVBlank) {
+  class FakeVBlankWaiter : public VBlankWaiter {
+   public:
+    bool AwaitVBlank(HMONITOR monitor, Callback callback) override {
+      EXPECT_NE(monitor, nullptr);
+      callback(std::chrono::nanoseconds(8333333));
+      return true;
+    }
+  };
+
+  FlutterWindowsEngineBuilder builder{GetContext()};
+  std::unique_ptr<FlutterWindowsEngine> engine = builder.Build();
+  EngineModifier modifier(engine.get());
+  modifier.SetVBlankWaiter(std::make_unique<FakeVBlankWaiter>());
+  bool on_vsync_called = false;
+
+  modifier.embedder_api().GetCurrentTime =
+      MOCK_ENGINE_PROC(GetCurrentTime, ([]() -> uint64_t { return 5; }));
+  modifier.embedder_api().OnVsync = MOCK_ENGINE_PROC(
+      OnVsync,
+      ([&on_vsync_called](FLUTTER_API_SYMBOL(FlutterEngine) engine,
+                          intptr_t baton, uint64_t frame_start_time_nanos,
+                          uint64_t frame_target_time_nanos) {
+        EXPECT_EQ(baton, 1);
+        EXPECT_EQ(frame_start_time_nanos, 5);
+        EXPECT_EQ(frame_target_time_nanos, 8333338);
+        on_vsync_called = true;
+        return kSuccess;
+      }));
+
+  engine->OnVsync(1);
+
+  EXPECT_TRUE(on_vsync_called);
+}
+
 TEST_F(FlutterWindowsEngineTest, RunWithoutANGLEUsesSoftware) {
   FlutterWindowsEngineBuilder builder{GetContext()};
   std::unique_ptr<FlutterWindowsEngine> engine = builder.Build();
@@ -137,10 +137,26 @@ void FlutterWindowsTextureRegistrar::ResolveGlFunctions(GlProcs& procs) {
       eglGetProcAddress("glTexParameteri"));
   procs.glTexImage2D =
       reinterpret_cast<glTexImage2DProc>(eglGetProcAddress("glTexImage2D"));
+  procs.glTexSubImage2D = reinterpret_cast<glTexSubImage2DProc>(
+      eglGetProcAddress("glTexSubImage2D"));
+  procs.glGetString =
+      reinterpret_cast<glGetStringProc>(eglGetProcAddress("glGetString"));
+  procs.glGenBuffers =
+      reinterpret_cast<glGenBuffersProc>(eglGetProcAddress("glGenBuffers"));
+  procs.glDeleteBuffers = reinterpret_cast<glDeleteBuffersProc>(
+      eglGetProcAddress("glDeleteBuffers"));
+  procs.glBindBuffer =
+      reinterpret_cast<glBindBufferProc>(eglGetProcAddress("glBindBuffer"));
+  procs.glBufferData =
+      reinterpret_cast<glBufferDataProc>(eglGetProcAddress("glBufferData"));
+  procs.glMapBufferRange = reinterpret_cast<glMapBufferRangeProc>(
+      eglGetProcAddress("glMapBufferRangeEXT"));
+  procs.glUnmapBuffer = reinterpret_cast<glUnmapBufferProc>(
+      eglGetProcAddress("glUnmapBufferOES"));
 
   procs.valid = procs.glGenTextures && procs.glDeleteTextures &&
                 procs.glBindTexture && procs.glTexParameteri &&
-                procs.glTexImage2D;
+                procs.glTexImage2D && procs.glTexSubImage2D;
 }
 
 };  // namespace flutter
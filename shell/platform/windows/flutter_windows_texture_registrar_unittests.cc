@@ -189,6 +189,46 @@ TEST(FlutterWindowsTextureRegistrarTest, PopulatePixelBufferTexture) {
   EXPECT_TRUE(release_callback_called);
 }
 
+TEST(FlutterWindowsTextureRegistrarTest,
+     PopulatePixelBufferTextureWithoutPixelBufferObjects) {
+  std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
+  std::unique_ptr<MockGlFunctions> gl = std::make_unique<MockGlFunctions>();
+  GlProcs gl_procs = gl->gl_procs();
+  gl_procs.glMapBufferRange = nullptr;
+  FlutterWindowsTextureRegistrar registrar(engine.get(), gl_procs);
+
+  size_t width = 100;
+  size_t height = 100;
+  std::unique_ptr<uint8_t[]> pixels =
+      std::make_unique<uint8_t[]>(width * height * 4);
+  FlutterDesktopPixelBuffer pixel_buffer = {};
+  pixel_buffer.width = width;
+  pixel_buffer.height = height;
+  pixel_buffer.buffer = pixels.get();
+
+  FlutterDesktopTextureInfo texture_info = {};
+  texture_info.type = kFlutterDesktopPixelBufferTexture;
+  texture_info.pixel_buffer_config.user_data = &pixel_buffer;
+  texture_info.pixel_buffer_config.callback =
+      [](size_t width, size_t height,
+         void* user_data) -> const FlutterDesktopPixelBuffer* {
+    return reinterpret_cast<const FlutterDesktopPixelBuffer*>(user_data);
+  };
+
+  FlutterOpenGLTexture flutter_texture = {};
+  auto texture_id = registrar.RegisterTexture(&texture_info);
+  EXPECT_NE(texture_id, -1);
+
+  // The second frame updates the storage allocated for the first one.
+  for (int i = 0; i < 2; i++) {
+    auto result =
+        registrar.PopulateTexture(texture_id, 640, 480, &flutter_texture);
+    EXPECT_TRUE(result);
+    EXPECT_EQ(flutter_texture.width, width);
+    EXPECT_EQ(flutter_texture.height, height);
+  }
+}
+
 TEST(FlutterWindowsTextureRegistrarTest, PopulateD3dTextureWithHandle) {
   std::unique_ptr<FlutterWindowsEngine> engine = GetTestEngine();
   std::unique_ptr<MockGlFunctions> gl = std::make_unique<MockGlFunctions>();
@@ -53,6 +53,12 @@ class EngineModifier {
         std::optional<std::chrono::nanoseconds>(frame_interval_nanos);
   }
 
+  // Replaces the waiter for the vertical blanks of monitors, which is used
+  // unless the frame interval is overridden.
+  void SetVBlankWaiter(std::unique_ptr<VBlankWaiter> vblank_waiter) {
+    engine_->vblank_waiter_ = std::move(vblank_waiter);
+  }
+
   // Explicitly releases the SurfaceManager being used by the
   // FlutterWindowsEngine instance. This should be used if SetSurfaceManager is
   // used to explicitly set to a non-null value (but not a valid object) to test
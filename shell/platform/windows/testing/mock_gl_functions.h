@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_TESTING_MOCK_GL_FUNCTIONS_H_
 #define FLUTTER_SHELL_PLATFORM_WINDOWS_TESTING_MOCK_GL_FUNCTIONS_H_
 
+#include <vector>
+
 #include "flutter/fml/macros.h"
 #include "flutter/shell/platform/windows/external_texture.h"
 
@@ -20,6 +22,14 @@ class MockGlFunctions {
     gl_procs_.glBindTexture = &glBindTexture;
     gl_procs_.glTexParameteri = &glTexParameteri;
     gl_procs_.glTexImage2D = &glTexImage2D;
+    gl_procs_.glTexSubImage2D = &glTexSubImage2D;
+    gl_procs_.glGetString = &glGetString;
+    gl_procs_.glGenBuffers = &glGenBuffers;
+    gl_procs_.glDeleteBuffers = &glDeleteBuffers;
+    gl_procs_.glBindBuffer = &glBindBuffer;
+    gl_procs_.glBufferData = &glBufferData;
+    gl_procs_.glMapBufferRange = &glMapBufferRange;
+    gl_procs_.glUnmapBuffer = &glUnmapBuffer;
     gl_procs_.valid = true;
   }
 
@@ -44,6 +54,45 @@ class MockGlFunctions {
                            GLenum format,
                            GLenum type,
                            const void* data) {}
+  static void glTexSubImage2D(GLenum target,
+                              GLint level,
+                              GLint xoffset,
+                              GLint yoffset,
+                              GLsizei width,
+                              GLsizei height,
+                              GLenum format,
+                              GLenum type,
+                              const void* data) {}
+
+  static const GLubyte* glGetString(GLenum name) {
+    return reinterpret_cast<const GLubyte*>(
+        "GL_NV_pixel_buffer_object GL_EXT_map_buffer_range GL_OES_mapbuffer");
+  }
+
+  static void glGenBuffers(GLsizei n, GLuint* buffers) {
+    // The minimum valid buffer ID is 1
+    for (auto i = 0; i < n; i++) {
+      buffers[i] = i + 1;
+    }
+  }
+
+  static void glDeleteBuffers(GLsizei n, const GLuint* buffers) {}
+  static void glBindBuffer(GLenum target, GLuint buffer) {}
+  static void glBufferData(GLenum target,
+                           GLsizeiptr size,
+                           const void* data,
+                           GLenum usage) {}
+
+  static void* glMapBufferRange(GLenum target,
+                                GLintptr offset,
+                                GLsizeiptr length,
+                                GLbitfield access) {
+    static std::vector<uint8_t> buffer;
+    buffer.resize(length);
+    return buffer.data();
+  }
+
+  static GLboolean glUnmapBuffer(GLenum target) { return GL_TRUE; }
 
  private:
   GlProcs gl_procs_;
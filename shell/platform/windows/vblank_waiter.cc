@@ -0,0 +1,185 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/vblank_waiter.h"
+
+#include <dxgi.h>
+#include <wrl/client.h>
+
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+// The refresh interval assumed when a monitor doesn't report its refresh
+// rate.
+constexpr std::chrono::nanoseconds kDefaultRefreshInterval(16666667);
+
+// Returns the DXGI output that shows |monitor|, or nullptr if there is none.
+Microsoft::WRL::ComPtr<IDXGIOutput> FindOutput(HMONITOR monitor) {
+  Microsoft::WRL::ComPtr<IDXGIFactory1> factory;
+  if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory)))) {
+    return nullptr;
+  }
+  Microsoft::WRL::ComPtr<IDXGIAdapter1> adapter;
+  for (UINT i = 0; factory->EnumAdapters1(i, &adapter) != DXGI_ERROR_NOT_FOUND;
+       i++) {
+    Microsoft::WRL::ComPtr<IDXGIOutput> output;
+    for (UINT j = 0; adapter->EnumOutputs(j, &output) != DXGI_ERROR_NOT_FOUND;
+         j++) {
+      DXGI_OUTPUT_DESC desc = {};
+      if (SUCCEEDED(output->GetDesc(&desc)) && desc.Monitor == monitor) {
+        return output;
+      }
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+// A thread that waits for the vertical blanks of a monitor whenever
+// callbacks are pending for it, and invokes all of them at once.
+class VBlankWaiter::MonitorThread {
+ public:
+  explicit MonitorThread(Microsoft::WRL::ComPtr<IDXGIOutput> output)
+      : output_(std::move(output)), thread_([this]() { Run(); }) {}
+
+  ~MonitorThread() {
+    {
+      std::scoped_lock lock(mutex_);
+      stopped_ = true;
+    }
+    condition_.notify_one();
+    thread_.join();
+  }
+
+  // Returns false if the thread can no longer wait for the vertical blanks
+  // of its monitor, for example because the monitor was disconnected.
+  bool Await(Callback callback) {
+    {
+      std::scoped_lock lock(mutex_);
+      if (!valid_ || stopped_) {
+        return false;
+      }
+      callbacks_.push_back(std::move(callback));
+    }
+    condition_.notify_one();
+    return true;
+  }
+
+ private:
+  void Run() {
+    while (true) {
+      {
+        std::unique_lock lock(mutex_);
+        condition_.wait(lock,
+                        [this]() { return stopped_ || !callbacks_.empty(); });
+        if (stopped_) {
+          return;
+        }
+      }
+      const HRESULT result = output_->WaitForVBlank();
+      std::vector<Callback> callbacks;
+      {
+        std::scoped_lock lock(mutex_);
+        if (stopped_) {
+          return;
+        }
+        callbacks.swap(callbacks_);
+        valid_ = SUCCEEDED(result);
+      }
+      // The callbacks are invoked even if the wait failed, so that the frames
+      // they were requested for are not lost.
+      const std::chrono::nanoseconds refresh_interval = GetRefreshInterval();
+      for (const auto& callback : callbacks) {
+        callback(refresh_interval);
+      }
+      if (FAILED(result)) {
+        FML_LOG(WARNING) << "Failed to wait for the vertical blank: 0x"
+                         << std::hex << result;
+        return;
+      }
+    }
+  }
+
+  // The refresh rate is queried again for every vertical blank, as it
+  // changes with the display mode of the monitor.
+  std::chrono::nanoseconds GetRefreshInterval() const {
+    DXGI_OUTPUT_DESC desc = {};
+    DEVMODEW mode = {};
+    mode.dmSize = sizeof(mode);
+    if (FAILED(output_->GetDesc(&desc)) ||
+        !EnumDisplaySettingsW(desc.DeviceName, ENUM_CURRENT_SETTINGS, &mode) ||
+        mode.dmDisplayFrequency <= 1) {
+      // Frequencies of 0 and 1 stand for the default of the hardware.
+      return kDefaultRefreshInterval;
+    }
+    return std::chrono::nanoseconds(1000000000 / mode.dmDisplayFrequency);
+  }
+
+  const Microsoft::WRL::ComPtr<IDXGIOutput> output_;
+
+  std::mutex mutex_;
+
+  std::condition_variable condition_;
+
+  std::vector<Callback> callbacks_;
+
+  bool stopped_ = false;
+
+  bool valid_ = true;
+
+  // Declared last so that the thread starts once the rest is initialized.
+  std::thread thread_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MonitorThread);
+};
+
+VBlankWaiter::VBlankWaiter() = default;
+
+VBlankWaiter::~VBlankWaiter() {
+  Shutdown();
+}
+
+bool VBlankWaiter::AwaitVBlank(HMONITOR monitor, Callback callback) {
+  if (!monitor) {
+    return false;
+  }
+  std::scoped_lock lock(mutex_);
+  if (shut_down_) {
+    return false;
+  }
+  auto found = threads_.find(monitor);
+  if (found != threads_.end()) {
+    if (found->second->Await(callback)) {
+      return true;
+    }
+    // The monitor went away, or its handle now refers to another monitor.
+    threads_.erase(found);
+  }
+  Microsoft::WRL::ComPtr<IDXGIOutput> output = FindOutput(monitor);
+  if (!output) {
+    return false;
+  }
+  auto thread = std::make_unique<MonitorThread>(std::move(output));
+  if (!thread->Await(std::move(callback))) {
+    return false;
+  }
+  threads_[monitor] = std::move(thread);
+  return true;
+}
+
+void VBlankWaiter::Shutdown() {
+  std::scoped_lock lock(mutex_);
+  shut_down_ = true;
+  threads_.clear();
+}
+
+}  // namespace flutter
@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_VBLANK_WAITER_H_
+#define FLUTTER_SHELL_PLATFORM_WINDOWS_VBLANK_WAITER_H_
+
+#include <Windows.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// Waits for the vertical blanks of monitors, each on a thread of its own, so
+// that frames can be started in step with the monitor they are shown on.
+class VBlankWaiter {
+ public:
+  // Invoked on the thread of the monitor right after its vertical blank, with
+  // the refresh interval of the monitor.
+  using Callback =
+      std::function<void(std::chrono::nanoseconds refresh_interval)>;
+
+  VBlankWaiter();
+
+  virtual ~VBlankWaiter();
+
+  // Invokes |callback| after the next vertical blank of |monitor|.
+  //
+  // Returns false without invoking |callback| if the vertical blanks of
+  // |monitor| can't be waited for, or if the waiter was shut down.
+  virtual bool AwaitVBlank(HMONITOR monitor, Callback callback);
+
+  // Stops the threads of the monitors. Callbacks that are still pending are
+  // dropped, and no callbacks are invoked once this returns.
+  void Shutdown();
+
+ private:
+  class MonitorThread;
+
+  std::mutex mutex_;
+
+  bool shut_down_ = false;
+
+  std::unordered_map<HMONITOR, std::unique_ptr<MonitorThread>> threads_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(VBlankWaiter);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_WINDOWS_VBLANK_WAITER_H_
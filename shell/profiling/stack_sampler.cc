@@ -0,0 +1,249 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/profiling/stack_sampler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
+#include "flutter/fml/backtrace.h"
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
+
+#if !FML_OS_WIN && !FML_OS_FUCHSIA
+#define STACK_SAMPLING_SUPPORTED 1
+#include <pthread.h>
+#include <cerrno>
+#include <csignal>
+#endif
+
+namespace flutter {
+
+namespace {
+
+#if STACK_SAMPLING_SUPPORTED
+
+constexpr int kSampleSignal = SIGURG;
+
+constexpr size_t kMaxFrames = 64u;
+
+// The frames of the signal handler and of the signal trampoline the kernel
+// returns through.
+constexpr size_t kSignalHandlerFrames = 2u;
+
+// How long a sampled thread may take to handle the sample signal. Threads
+// blocked in the kernel handle it right away, since its handler is installed
+// with SA_RESTART.
+constexpr fml::TimeDelta kSampleTimeout = fml::TimeDelta::FromMilliseconds(10);
+
+// The stack the signal handler of the sampled thread writes into. There is a
+// single one for the process since signal handlers are process wide, so
+// threads are sampled one at a time.
+struct SignalSample {
+  void* frames[kMaxFrames];
+  std::atomic<size_t> frame_count = 0;
+  std::atomic<bool> done = false;
+};
+
+std::mutex gSignalSampleMutex;
+SignalSample gSignalSample;
+std::atomic<SignalSample*> gPendingSignalSample = nullptr;
+
+void SampleSignalHandler(int signal) {
+  const int saved_errno = errno;
+  if (auto sample = gPendingSignalSample.exchange(nullptr)) {
+    sample->frame_count.store(
+        fml::CaptureBacktrace(sample->frames, kMaxFrames));
+    sample->done.store(true, std::memory_order_release);
+  }
+  errno = saved_errno;
+}
+
+void InstallSampleSignalHandler() {
+  static std::once_flag once;
+  std::call_once(once, [] {
+    // Unwinding loads the unwinder on first use, which must not happen in the
+    // signal handler.
+    void* frames[1];
+    fml::CaptureBacktrace(frames, 1u);
+
+    struct sigaction action = {};
+    action.sa_handler = &SampleSignalHandler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (::sigaction(kSampleSignal, &action, nullptr) != 0) {
+      FML_LOG(ERROR) << "Could not install the stack sampling signal handler.";
+    }
+  });
+}
+
+bool CaptureThreadStack(pthread_t thread, std::vector<void*>& frames) {
+  std::scoped_lock lock(gSignalSampleMutex);
+  auto& sample = gSignalSample;
+  sample.frame_count.store(0u);
+  sample.done.store(false);
+  gPendingSignalSample.store(&sample);
+  if (::pthread_kill(thread, kSampleSignal) != 0) {
+    gPendingSignalSample.store(nullptr);
+    return false;
+  }
+  const auto deadline = fml::TimePoint::Now() + kSampleTimeout;
+  while (!sample.done.load(std::memory_order_acquire)) {
+    if (fml::TimePoint::Now() > deadline) {
+      // The handler claims the sample before writing into it. If it hasn't
+      // yet, it never will, and otherwise it is about to be done with it.
+      if (gPendingSignalSample.exchange(nullptr) == nullptr) {
+        while (!sample.done.load(std::memory_order_acquire)) {
+          std::this_thread::yield();
+        }
+        break;
+      }
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  const auto frame_count = sample.frame_count.load();
+  if (frame_count <= kSignalHandlerFrames) {
+    return false;
+  }
+  frames.assign(sample.frames + kSignalHandlerFrames,
+                sample.frames + frame_count);
+  return true;
+}
+
+#endif  // STACK_SAMPLING_SUPPORTED
+
+}  // namespace
+
+struct StackSampler::SampledThread {
+  std::string name;
+#if STACK_SAMPLING_SUPPORTED
+  pthread_t thread;
+#endif  // STACK_SAMPLING_SUPPORTED
+};
+
+// static
+bool StackSampler::IsSupported() {
+#if STACK_SAMPLING_SUPPORTED
+  return fml::IsCrashHandlingSupported();
+#else
+  return false;
+#endif  // STACK_SAMPLING_SUPPORTED
+}
+
+StackSampler::StackSampler(uint32_t samples_per_second)
+    : sample_interval_(fml::TimeDelta::FromSecondsF(
+          1.0 / std::max<uint32_t>(samples_per_second, 1u))) {
+#if STACK_SAMPLING_SUPPORTED
+  if (IsSupported()) {
+    InstallSampleSignalHandler();
+  }
+#endif  // STACK_SAMPLING_SUPPORTED
+}
+
+StackSampler::~StackSampler() {
+  Stop();
+}
+
+void StackSampler::RegisterCurrentThread(const std::string& name) {
+#if STACK_SAMPLING_SUPPORTED
+  std::scoped_lock lock(mutex_);
+  const auto current_thread = ::pthread_self();
+  for (const auto& thread : threads_) {
+    if (::pthread_equal(thread->thread, current_thread)) {
+      return;
+    }
+  }
+  threads_.push_back(std::make_unique<SampledThread>(
+      SampledThread{.name = name, .thread = current_thread}));
+#endif  // STACK_SAMPLING_SUPPORTED
+}
+
+void StackSampler::Start() {
+  if (!IsSupported() || sampler_thread_) {
+    return;
+  }
+  sampler_thread_ = std::make_unique<fml::Thread>("io.flutter.stack_sampler");
+  ScheduleSample(sampler_thread_->GetTaskRunner());
+}
+
+void StackSampler::Stop() {
+  // Joins the sampling thread, which drops the pending sample.
+  sampler_thread_.reset();
+}
+
+void StackSampler::ScheduleSample(
+    const fml::RefPtr<fml::TaskRunner>& task_runner) {
+  task_runner->PostDelayedTask(
+      [sampler = this, task_runner]() {
+        sampler->SampleOnce();
+        sampler->ScheduleSample(task_runner);
+      },
+      sample_interval_);
+}
+
+void StackSampler::SampleOnce() {
+#if STACK_SAMPLING_SUPPORTED
+  if (!IsSupported()) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  std::vector<void*> frames;
+  for (size_t i = 0; i < threads_.size(); i++) {
+    if (!CaptureThreadStack(threads_[i]->thread, frames)) {
+      continue;
+    }
+    stacks_[{.thread = i, .frames = frames}]++;
+    sample_count_++;
+  }
+#endif  // STACK_SAMPLING_SUPPORTED
+}
+
+size_t StackSampler::GetSampleCount() const {
+  std::scoped_lock lock(mutex_);
+  return sample_count_;
+}
+
+std::vector<std::string> StackSampler::GetFoldedStacks() const {
+  std::scoped_lock lock(mutex_);
+  // Stacks share most of their frames, which are expensive to symbolize.
+  std::unordered_map<void*, std::string> symbol_names;
+  const auto get_symbol_name = [&symbol_names](void* address) {
+    auto found = symbol_names.find(address);
+    if (found == symbol_names.end()) {
+      auto name = fml::GetSymbolName(address);
+      // Separators of the folded format.
+      std::replace(name.begin(), name.end(), ';', ':');
+      std::replace(name.begin(), name.end(), ' ', '_');
+      found = symbol_names.emplace(address, std::move(name)).first;
+    }
+    return found->second;
+  };
+
+  std::vector<std::string> folded_stacks;
+  folded_stacks.reserve(stacks_.size());
+  for (const auto& [stack, count] : stacks_) {
+    std::string folded_stack = threads_[stack.thread]->name;
+    for (auto frame = stack.frames.rbegin(); frame != stack.frames.rend();
+         ++frame) {
+      folded_stack += ';';
+      folded_stack += get_symbol_name(*frame);
+    }
+    folded_stack += ' ';
+    folded_stack += std::to_string(count);
+    folded_stacks.push_back(std::move(folded_stack));
+  }
+  return folded_stacks;
+}
+
+void StackSampler::Reset() {
+  std::scoped_lock lock(mutex_);
+  stacks_.clear();
+  sample_count_ = 0;
+}
+
+}  // namespace flutter
@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PROFILING_STACK_SAMPLER_H_
+#define FLUTTER_SHELL_PROFILING_STACK_SAMPLER_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/thread.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/**
+ * @brief Periodically captures the native stacks of a set of threads, and
+ * aggregates them into a flame graph.
+ *
+ * A sample is captured by interrupting the sampled thread with `SIGURG`, whose
+ * handler unwinds the stack of the interrupted thread with
+ * `fml::CaptureBacktrace`. `SIGPROF` is left to the Dart VM profiler. Stacks
+ * are only symbolized when the flame graph is exported, so sampling is cheap
+ * enough to use in profile builds on devices without `perf` or `simpleperf`.
+ *
+ * Sampling is only supported on POSIX platforms with backtraces enabled.
+ * Elsewhere no samples are ever captured.
+ */
+class StackSampler {
+ public:
+  static bool IsSupported();
+
+  /**
+   * @brief Construct a new Stack Sampler object. Sampling starts once `Start`
+   * is called.
+   *
+   * @param samples_per_second number of times per second each registered
+   * thread is sampled.
+   */
+  explicit StackSampler(uint32_t samples_per_second);
+
+  ~StackSampler();
+
+  /**
+   * @brief Adds the calling thread to the threads that are sampled. Its stacks
+   * are prefixed with `name` in the flame graph. The thread must outlive the
+   * sampler. Registering a thread more than once has no effect.
+   */
+  void RegisterCurrentThread(const std::string& name);
+
+  void Start();
+
+  void Stop();
+
+  /**
+   * @brief Captures one sample of each registered thread. Called by the
+   * sampling thread once `Start`ed.
+   */
+  void SampleOnce();
+
+  size_t GetSampleCount() const;
+
+  /**
+   * @brief The aggregated samples, in the folded format that flame graph
+   * tools read: one line per unique stack, with its frames separated by `;`
+   * from the outermost one, followed by a space and the number of samples of
+   * the stack. The first frame of each stack is the name of its thread.
+   */
+  std::vector<std::string> GetFoldedStacks() const;
+
+  void Reset();
+
+ private:
+  struct SampledThread;
+
+  struct StackKey {
+    size_t thread;
+    std::vector<void*> frames;
+
+    bool operator<(const StackKey& other) const {
+      return thread != other.thread ? thread < other.thread
+                                    : frames < other.frames;
+    }
+  };
+
+  const fml::TimeDelta sample_interval_;
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<SampledThread>> threads_;
+  std::map<StackKey, size_t> stacks_;
+  size_t sample_count_ = 0;
+  std::unique_ptr<fml::Thread> sampler_thread_;
+
+  void ScheduleSample(const fml::RefPtr<fml::TaskRunner>& task_runner);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StackSampler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PROFILING_STACK_SAMPLER_H_
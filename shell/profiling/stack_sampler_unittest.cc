@@ -0,0 +1,72 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/profiling/stack_sampler.h"
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(StackSamplerTest, SamplesRegisteredThreads) {
+  if (!StackSampler::IsSupported()) {
+    GTEST_SKIP();
+  }
+  StackSampler sampler(1000);
+  fml::Thread thread("sampled");
+  fml::AutoResetWaitableEvent latch;
+  thread.GetTaskRunner()->PostTask([&] {
+    sampler.RegisterCurrentThread("sampled");
+    sampler.RegisterCurrentThread("sampled");
+    latch.Signal();
+  });
+  latch.Wait();
+
+  sampler.SampleOnce();
+  sampler.SampleOnce();
+  ASSERT_EQ(sampler.GetSampleCount(), 2u);
+
+  const auto folded_stacks = sampler.GetFoldedStacks();
+  ASSERT_FALSE(folded_stacks.empty());
+  size_t sample_count = 0;
+  for (const auto& folded_stack : folded_stacks) {
+    ASSERT_EQ(folded_stack.rfind("sampled;", 0), 0u);
+    const auto count_position = folded_stack.rfind(' ');
+    ASSERT_NE(count_position, std::string::npos);
+    sample_count += std::stoul(folded_stack.substr(count_position + 1));
+  }
+  ASSERT_EQ(sample_count, 2u);
+
+  sampler.Reset();
+  ASSERT_EQ(sampler.GetSampleCount(), 0u);
+  ASSERT_TRUE(sampler.GetFoldedStacks().empty());
+}
+
+TEST(StackSamplerTest, SamplesPeriodicallyOnceStarted) {
+  if (!StackSampler::IsSupported()) {
+    GTEST_SKIP();
+  }
+  StackSampler sampler(1000);
+  fml::Thread thread("sampled");
+  fml::AutoResetWaitableEvent latch;
+  thread.GetTaskRunner()->PostTask([&] {
+    sampler.RegisterCurrentThread("sampled");
+    latch.Signal();
+  });
+  latch.Wait();
+
+  sampler.Start();
+  while (sampler.GetSampleCount() < 3u) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  sampler.Stop();
+  const auto sample_count = sampler.GetSampleCount();
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  ASSERT_EQ(sampler.GetSampleCount(), sample_count);
+}
+
+}  // namespace testing
+}  // namespace flutter
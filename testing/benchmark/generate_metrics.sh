@@ -15,3 +15,4 @@ set -ex
 ./ui_benchmarks --benchmark_format=json > ui_benchmarks.json
 ./display_list_builder_benchmarks --benchmark_format=json > display_list_builder_benchmarks.json
 ./geometry_benchmarks --benchmark_format=json > geometry_benchmarks.json
+./client_wrapper_benchmarks --benchmark_format=json > client_wrapper_benchmarks.json
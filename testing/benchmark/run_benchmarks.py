@@ -0,0 +1,401 @@
+#!/usr/bin/env python3
+#
+# Copyright 2013 The Flutter Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Runs the engine benchmarks repeatedly and compares the results of builds.
+
+  # Run the benchmarks of a build, 5 times, pinned to CPU 2.
+  run_benchmarks.py run --build-dir out/host_release --cpu 2 \\
+      --runs 5 --output before.json
+  # Compare them with those of another build.
+  run_benchmarks.py compare before.json after.json --output diff.json
+
+Each suite is run once per benchmark, so that the hardware counters that
+`perf stat` reads through perf_event, where it is available, are those of
+that benchmark. The counters of a run that selects no benchmark, which are
+those of starting the suite, are subtracted, and the rest is divided by the
+iterations that the benchmark reported. The iterations that Google Benchmark
+runs to decide how many iterations to run are counted too, so the counters
+of an iteration are an upper bound, but they are comparable between builds.
+
+The comparison of each benchmark reports the change of its mean time and
+the 95% confidence interval of that change, from Welch's t-test over the
+repetitions of both builds, in JSON.
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+
+DEFAULT_SUITES = [
+    'display_list_builder_benchmarks',
+    'fml_benchmarks',
+    'geometry_benchmarks',
+    'shell_benchmarks',
+    'txt_benchmarks',
+    'ui_benchmarks',
+]
+
+# The perf events, and the names they are reported with.
+PERF_EVENTS = {
+    'cycles': 'cycles',
+    'instructions': 'instructions',
+    'cache-misses': 'cacheMisses',
+}
+
+# The two-sided 95% quantiles of Student's t distribution, by degrees of
+# freedom. Larger ones are approximated from the normal quantile.
+T_QUANTILES_95 = [
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228
+]
+Z_QUANTILE_95 = 1.959964
+
+
+def t_quantile_95(degrees_of_freedom):
+  """Returns the two-sided 95% quantile of Student's t distribution."""
+  if degrees_of_freedom <= 0:
+    return math.inf
+  if degrees_of_freedom <= len(T_QUANTILES_95):
+    return T_QUANTILES_95[int(math.ceil(degrees_of_freedom)) - 1]
+  # The Cornish-Fisher expansion of the quantile in the normal quantile.
+  z = Z_QUANTILE_95
+  df = degrees_of_freedom
+  return (
+      z + (z**3 + z) / (4 * df) + (5 * z**5 + 16 * z**3 + 3 * z) / (96 * df**2)
+  )
+
+
+def welch_interval(baseline, candidate):
+  """Returns the 95% confidence interval of mean(candidate) - mean(baseline).
+
+  Returns None if either has fewer than two samples.
+  """
+  if len(baseline) < 2 or len(candidate) < 2:
+    return None
+  delta = statistics.mean(candidate) - statistics.mean(baseline)
+  baseline_error = statistics.variance(baseline) / len(baseline)
+  candidate_error = statistics.variance(candidate) / len(candidate)
+  error = baseline_error + candidate_error
+  if error == 0:
+    return (delta, delta)
+  # The Welch-Satterthwaite degrees of freedom.
+  df = error**2 / (
+      baseline_error**2 / (len(baseline) - 1) +
+      candidate_error**2 / (len(candidate) - 1)
+  )
+  margin = t_quantile_95(df) * math.sqrt(error)
+  return (delta - margin, delta + margin)
+
+
+def summarize(samples):
+  return {
+      'mean': statistics.mean(samples),
+      'stddev': statistics.stdev(samples) if len(samples) > 1 else 0.0,
+      'samples': len(samples),
+  }
+
+
+def percent_of(value, reference):
+  return 100.0 * value / reference if reference else None
+
+
+def compare_benchmark(baseline, candidate):
+  """Compares the results of a benchmark, as collected by `run`."""
+  result = {
+      'timeUnit': candidate['timeUnit'],
+      'baseline': summarize(baseline['times']),
+      'candidate': summarize(candidate['times']),
+  }
+  baseline_mean = result['baseline']['mean']
+  delta = result['candidate']['mean'] - baseline_mean
+  result['delta'] = delta
+  result['deltaPercent'] = percent_of(delta, baseline_mean)
+  interval = welch_interval(baseline['times'], candidate['times'])
+  if interval is None:
+    result['ci95Percent'] = None
+    result['significant'] = False
+  else:
+    result['ci95Percent'] = [
+        percent_of(bound, baseline_mean) for bound in interval
+    ]
+    # The change is significant if the interval doesn't contain 0.
+    result['significant'] = interval[0] > 0 or interval[1] < 0
+
+  counters = {}
+  for name in PERF_EVENTS.values():
+    before = baseline.get('counters', {}).get(name)
+    after = candidate.get('counters', {}).get(name)
+    if before is None or after is None:
+      continue
+    counters[name] = {
+        'baseline': before,
+        'candidate': after,
+        'deltaPercent': percent_of(after - before, before),
+    }
+  if counters:
+    result['counters'] = counters
+  return result
+
+
+def compare(baseline, candidate):
+  """Compares the benchmarks that both results have."""
+  benchmarks = {}
+  for key in sorted(set(baseline['benchmarks']) & set(candidate['benchmarks'])):
+    benchmarks[key] = compare_benchmark(
+        baseline['benchmarks'][key], candidate['benchmarks'][key]
+    )
+  return {
+      'baseline': baseline.get('buildDir'),
+      'candidate': candidate.get('buildDir'),
+      'benchmarks': benchmarks,
+      'regressions': [key for key, value in benchmarks.items()
+                      if value['significant'] and value['delta'] > 0],
+      'improvements': [key for key, value in benchmarks.items()
+                       if value['significant'] and value['delta'] < 0],
+  }
+
+
+def parse_perf_stat(output):
+  """Returns the counts of the events in the CSV output of `perf stat -x,`.
+
+  Events that weren't counted are left out.
+  """
+  counts = {}
+  for line in output.splitlines():
+    fields = line.split(',')
+    if len(fields) < 3:
+      continue
+    event = re.sub(r':\w+$', '', fields[2])
+    if event in PERF_EVENTS and fields[0].strip().isdigit():
+      counts[PERF_EVENTS[event]] = int(fields[0])
+  return counts
+
+
+def parse_benchmark_output(output):
+  """Returns the times and iterations of the runs of each benchmark in the
+  JSON output of a Google Benchmark suite, leaving out aggregates."""
+  runs = {}
+  for benchmark in json.loads(output)['benchmarks']:
+    if benchmark.get('run_type', 'iteration') != 'iteration':
+      continue
+    name = benchmark.get('run_name', benchmark['name'])
+    run = runs.setdefault(
+        name, {
+            'timeUnit': benchmark.get('time_unit', 'ns'),
+            'times': [],
+            'iterations': 0,
+        }
+    )
+    run['times'].append(benchmark['real_time'])
+    run['iterations'] += benchmark['iterations']
+  return runs
+
+
+class Runner:
+  """Runs the benchmark suites of a build."""
+
+  def __init__(self, args):
+    self.args = args
+    self.perf = shutil.which('perf') if not args.no_counters else None
+
+  def command(self, suite, benchmark_filter, with_perf):
+    command = []
+    if self.args.cpu is not None and shutil.which('taskset'):
+      command += ['taskset', '--cpu-list', str(self.args.cpu)]
+    if with_perf:
+      command += [
+          self.perf, 'stat', '-x,', '-e', ','.join(PERF_EVENTS), '--'
+      ]
+    command += [
+        os.path.join(self.args.build_dir, suite),
+        '--benchmark_format=json',
+        '--benchmark_filter=%s' % benchmark_filter,
+        '--benchmark_repetitions=%d' % self.args.repetitions,
+        '--benchmark_min_warmup_time=%g' % self.args.warmup_seconds,
+    ]
+    return command
+
+  def run_suite_process(self, suite, benchmark_filter):
+    """Runs the benchmarks of a suite that match the filter in a process.
+
+    Returns their runs and the counters of the process, which are empty if
+    `perf` is unavailable or can't count them.
+    """
+    with_perf = self.perf is not None
+    process = subprocess.run(
+        self.command(suite, benchmark_filter, with_perf),
+        capture_output=True,
+        text=True,
+        check=False,
+    )
+    if process.returncode != 0 and with_perf:
+      # perf_event may be restricted, for example by
+      # /proc/sys/kernel/perf_event_paranoid. Run without counters.
+      print(
+          'Running %s without hardware counters: %s' %
+          (suite, process.stderr.strip().splitlines()[-1:]),
+          file=sys.stderr
+      )
+      self.perf = None
+      return self.run_suite_process(suite, benchmark_filter)
+    process.check_returncode()
+    counters = parse_perf_stat(process.stderr) if with_perf else {}
+    return parse_benchmark_output(process.stdout), counters
+
+  def list_benchmarks(self, suite):
+    process = subprocess.run(
+        [
+            os.path.join(self.args.build_dir, suite),
+            '--benchmark_list_tests=true',
+            '--benchmark_filter=%s' % self.args.filter,
+        ],
+        capture_output=True,
+        text=True,
+        check=True,
+    )
+    return process.stdout.split()
+
+  def run_suite(self, suite, results):
+    # The counters of starting the suite without running any benchmark.
+    _, startup_counters = self.run_suite_process(suite, '^$')
+    for benchmark in self.list_benchmarks(suite):
+      key = '%s/%s' % (suite, benchmark)
+      runs, counters = self.run_suite_process(
+          suite, '^%s$' % re.escape(benchmark)
+      )
+      run = runs.get(benchmark)
+      if run is None:
+        continue
+      result = results.setdefault(
+          key, {
+              'timeUnit': run['timeUnit'],
+              'times': [],
+              'iterations': 0,
+              'counterTotals': {},
+          }
+      )
+      result['times'] += run['times']
+      result['iterations'] += run['iterations']
+      for name, count in counters.items():
+        if name in startup_counters:
+          totals = result['counterTotals']
+          totals[name] = totals.get(name, 0) + max(
+              count - startup_counters[name], 0
+          )
+
+  def run(self):
+    results = {}
+    for run in range(self.args.runs):
+      for suite in self.args.suites:
+        print('Run %d of %s' % (run + 1, suite), file=sys.stderr)
+        self.run_suite(suite, results)
+    for result in results.values():
+      totals = result.pop('counterTotals')
+      if totals and result['iterations']:
+        result['counters'] = {
+            name: total / result['iterations']
+            for name, total in totals.items()
+        }
+    return {
+        'buildDir': os.path.abspath(self.args.build_dir),
+        'cpu': self.args.cpu,
+        'benchmarks': results,
+    }
+
+
+def write_json(value, path):
+  if path:
+    with open(path, 'w') as file:
+      json.dump(value, file, indent=2, sort_keys=True)
+  else:
+    json.dump(value, sys.stdout, indent=2, sort_keys=True)
+    print()
+
+
+def main(argv):
+  parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+  subparsers = parser.add_subparsers(dest='command', required=True)
+
+  run_parser = subparsers.add_parser(
+      'run', help='Run the benchmarks of a build.'
+  )
+  run_parser.add_argument(
+      '--build-dir', required=True, help='The output directory of the build.'
+  )
+  run_parser.add_argument(
+      '--suites',
+      nargs='+',
+      default=DEFAULT_SUITES,
+      help='The benchmark executables to run.'
+  )
+  run_parser.add_argument(
+      '--filter', default='.', help='The benchmarks to run, as a regex.'
+  )
+  run_parser.add_argument(
+      '--runs',
+      type=int,
+      default=3,
+      help='The number of times each suite is run.'
+  )
+  run_parser.add_argument(
+      '--repetitions',
+      type=int,
+      default=5,
+      help='The number of repetitions of each benchmark in a run.'
+  )
+  run_parser.add_argument(
+      '--warmup-seconds',
+      type=float,
+      default=0.5,
+      help='How long each benchmark runs before it is measured.'
+  )
+  run_parser.add_argument(
+      '--cpu', type=int, help='The CPU to pin the benchmarks to.'
+  )
+  run_parser.add_argument(
+      '--no-counters',
+      action='store_true',
+      help='Do not read hardware counters with perf.'
+  )
+  run_parser.add_argument('--output', help='The file to write results to.')
+
+  compare_parser = subparsers.add_parser(
+      'compare', help='Compare the results of two builds.'
+  )
+  compare_parser.add_argument('baseline', help='The results of the baseline.')
+  compare_parser.add_argument('candidate', help='The results to compare.')
+  compare_parser.add_argument(
+      '--output', help='The file to write the comparison to.'
+  )
+  compare_parser.add_argument(
+      '--fail-on-regression',
+      action='store_true',
+      help='Exit with an error if any benchmark is significantly slower.'
+  )
+
+  args = parser.parse_args(argv)
+  if args.command == 'run':
+    write_json(Runner(args).run(), args.output)
+    return 0
+
+  with open(args.baseline) as file:
+    baseline = json.load(file)
+  with open(args.candidate) as file:
+    candidate = json.load(file)
+  comparison = compare(baseline, candidate)
+  write_json(comparison, args.output)
+  if args.fail_on_regression and comparison['regressions']:
+    return 1
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+#
+# Copyright 2013 The Flutter Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+import json
+import unittest
+
+import run_benchmarks
+
+
+class RunBenchmarksTest(unittest.TestCase):
+
+  def test_parse_benchmark_output_leaves_out_aggregates(self):
+    output = json.dumps({
+        'benchmarks': [
+            {
+                'name': 'BM_A', 'run_name': 'BM_A', 'run_type': 'iteration',
+                'iterations': 10, 'real_time': 2.0, 'time_unit': 'us'
+            },
+            {
+                'name': 'BM_A', 'run_name': 'BM_A', 'run_type': 'iteration',
+                'iterations': 10, 'real_time': 4.0, 'time_unit': 'us'
+            },
+            {
+                'name': 'BM_A_mean', 'run_name': 'BM_A',
+                'run_type': 'aggregate', 'iterations': 2, 'real_time': 3.0,
+                'time_unit': 'us'
+            },
+        ]
+    })
+    runs = run_benchmarks.parse_benchmark_output(output)
+    self.assertEqual(
+        runs, {'BM_A': {'timeUnit': 'us', 'times': [2.0, 4.0],
+                        'iterations': 20}}
+    )
+
+  def test_parse_perf_stat(self):
+    output = '\n'.join([
+        '1200,,cycles:u,1000,100.00,,',
+        '3400,,instructions:u,1000,100.00,2.83,insn per cycle',
+        '<not supported>,,cache-misses:u,0,100.00,,',
+    ])
+    self.assertEqual(
+        run_benchmarks.parse_perf_stat(output), {
+            'cycles': 1200,
+            'instructions': 3400
+        }
+    )
+
+  def test_welch_interval(self):
+    interval = run_benchmarks.welch_interval([10, 11, 9, 10], [20, 21, 19, 20])
+    self.assertLess(interval[0], 10)
+    self.assertGreater(interval[0], 8)
+    self.assertGreater(interval[1], 10)
+    self.assertLess(interval[1], 12)
+    self.assertIsNone(run_benchmarks.welch_interval([10], [20, 21]))
+
+  def test_t_quantile_approximation(self):
+    # Student's t quantiles for 20 and 100 degrees of freedom.
+    self.assertAlmostEqual(run_benchmarks.t_quantile_95(20), 2.086, places=3)
+    self.assertAlmostEqual(run_benchmarks.t_quantile_95(100), 1.984, places=3)
+
+  def test_compare_flags_significant_changes(self):
+    baseline = {
+        'benchmarks': {
+            'suite/BM_Slower': {
+                'timeUnit': 'ns', 'times': [10, 11, 9, 10],
+                'counters': {'cycles': 100.0}
+            },
+            'suite/BM_Same': {'timeUnit': 'ns', 'times': [10, 12, 8, 10]},
+            'suite/BM_Removed': {'timeUnit': 'ns', 'times': [1, 1]},
+        }
+    }
+    candidate = {
+        'benchmarks': {
+            'suite/BM_Slower': {
+                'timeUnit': 'ns', 'times': [20, 21, 19, 20],
+                'counters': {'cycles': 150.0}
+            },
+            'suite/BM_Same': {'timeUnit': 'ns', 'times': [11, 9, 10, 10]},
+        }
+    }
+    comparison = run_benchmarks.compare(baseline, candidate)
+    self.assertEqual(
+        sorted(comparison['benchmarks']), ['suite/BM_Same', 'suite/BM_Slower']
+    )
+    self.assertEqual(comparison['regressions'], ['suite/BM_Slower'])
+    self.assertEqual(comparison['improvements'], [])
+    slower = comparison['benchmarks']['suite/BM_Slower']
+    self.assertAlmostEqual(slower['deltaPercent'], 100.0)
+    self.assertAlmostEqual(slower['counters']['cycles']['deltaPercent'], 50.0)
+    self.assertFalse(comparison['benchmarks']['suite/BM_Same']['significant'])
+
+
+if __name__ == '__main__':
+  unittest.main()
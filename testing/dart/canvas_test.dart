@@ -1100,6 +1100,34 @@ void main() {
     canvas.restoreToCount(canvas.getSaveCount() + 1);
     expect(canvas.getSaveCount(), equals(6));
   });
+
+  test('Batched draws keep their order and paints across flushes', () async {
+    const int size = 40;
+    final Image image = await toImage((Canvas canvas) {
+      final Paint paint = Paint();
+      final Paint green = Paint()..color = const Color(0xFF00FF00);
+      for (int y = 0; y < size; y++) {
+        canvas.save();
+        canvas.translate(0, y.toDouble());
+        for (int x = 0; x < size; x++) {
+          // Mutating the paint between draws must not reuse its old data.
+          paint.color = (x + y).isEven ? const Color(0xFFFF0000) : const Color(0xFF0000FF);
+          canvas.drawRect(Rect.fromLTWH(x.toDouble(), 0, 1, 1), paint);
+        }
+        canvas.restore();
+      }
+      // An unbatched draw must land on top of the batched ones.
+      canvas.drawPath(Path()..addRect(const Rect.fromLTWH(0, 0, 1, 1)), green);
+    }, size, size);
+
+    final ByteData data = (await image.toByteData())!;
+    int pixelAt(int x, int y) => data.getUint32((y * size + x) * 4);
+    expect(pixelAt(0, 0), 0x00FF00FF);
+    expect(pixelAt(1, 0), 0x0000FFFF);
+    expect(pixelAt(2, 0), 0xFF0000FF);
+    expect(pixelAt(size - 1, size - 1), 0xFF0000FF);
+    expect(pixelAt(size - 2, size - 1), 0x0000FFFF);
+  });
 }
 
 Matcher listEquals(ByteData expected) => (dynamic v) {
@@ -289,6 +289,18 @@ void main() async {
     shader.dispose();
   });
 
+  test('Concurrent fromAsset calls share one FragmentProgram', () async {
+    final List<FragmentProgram> programs = await Future.wait(<Future<FragmentProgram>>[
+      FragmentProgram.fromAsset('functions.frag.iplr'),
+      FragmentProgram.fromAsset('functions.frag.iplr'),
+    ]);
+    expect(identical(programs[0], programs[1]), true);
+    final FragmentShader shader = programs[0].fragmentShader()
+      ..setFloat(0, 1.0);
+    await _expectShaderRendersGreen(shader);
+    shader.dispose();
+  });
+
   test('fromAsset throws an exception on invalid assetKey', () async {
     bool throws = false;
     try {
@@ -55,6 +55,35 @@ void main() {
     }
   });
 
+  test('layoutAll lays out each paragraph like layout', () {
+    Paragraph build(double fontSize) {
+      final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
+        fontFamily: 'FlutterTest',
+        fontSize: fontSize,
+      ));
+      builder.addText('Test Test Test');
+      return builder.build();
+    }
+
+    final List<double> fontSizes = <double>[10.0, 20.0, 30.0, 40.0, 50.0];
+    final List<Paragraph> paragraphs = fontSizes.map(build).toList();
+    final List<ParagraphConstraints> constraints = fontSizes
+        .map((double fontSize) => ParagraphConstraints(width: fontSize * 6.0))
+        .toList();
+    Paragraph.layoutAll(paragraphs, constraints);
+
+    for (int index = 0; index < fontSizes.length; index += 1) {
+      final double fontSize = fontSizes[index];
+      final Paragraph expected = build(fontSize);
+      expected.layout(constraints[index]);
+      expect(paragraphs[index].width, fontSize * 6.0);
+      expect(paragraphs[index].height, expected.height);
+      expect(paragraphs[index].height, fontSize * 3.0);
+      expect(paragraphs[index].longestLine, expected.longestLine);
+      expect(paragraphs[index].computeLineMetrics().length, 3);
+    }
+  });
+
   test('predictably lays out a multi-line paragraph', () {
     for (final double fontSize in <double>[10.0, 20.0, 30.0, 40.0]) {
       final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
@@ -894,6 +894,7 @@ def run_benchmark_tests(build_dir):
         flags=opts,
         cwd=test_dir
     )
+  run_cmd(['python3', 'run_benchmarks_test.py'], cwd=test_dir)
 
 
 def gather_githooks_tests(build_dir):
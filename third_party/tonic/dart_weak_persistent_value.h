@@ -34,6 +34,10 @@ class DartWeakPersistentValue {
   void Clear();
   Dart_Handle Get();
 
+  // Updates the size of the external allocation the handle was set with. Must
+  // be called on the mutator thread.
+  void UpdateExternalSize(intptr_t external_allocation_size);
+
   const std::weak_ptr<DartState>& dart_state() const { return dart_state_; }
 
  private:
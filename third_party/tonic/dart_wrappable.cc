@@ -15,6 +15,10 @@ DartWrappable::~DartWrappable() {
   // Calls the destructor of dart_wrapper_ to delete WeakPersistentHandle.
 }
 
+size_t DartWrappable::GetAllocationSize() const {
+  return sizeof(*this);
+}
+
 // TODO(dnfield): Delete this. https://github.com/flutter/flutter/issues/50997
 Dart_Handle DartWrappable::CreateDartWrapper(DartState* dart_state) {
   if (!dart_wrapper_.is_empty()) {
@@ -38,7 +42,7 @@ Dart_Handle DartWrappable::CreateDartWrapper(DartState* dart_state) {
   TONIC_DCHECK(!CheckAndHandleError(res));
 
   this->RetainDartWrappableReference();  // Balanced in FinalizeDartWrapper.
-  dart_wrapper_.Set(dart_state, wrapper, this, sizeof(*this),
+  dart_wrapper_.Set(dart_state, wrapper, this, GetAllocationSize(),
                     &FinalizeDartWrapper);
 
   return wrapper;
@@ -59,7 +63,7 @@ void DartWrappable::AssociateWithDartWrapper(Dart_Handle wrapper) {
   this->RetainDartWrappableReference();  // Balanced in FinalizeDartWrapper.
 
   DartState* dart_state = DartState::Current();
-  dart_wrapper_.Set(dart_state, wrapper, this, sizeof(*this),
+  dart_wrapper_.Set(dart_state, wrapper, this, GetAllocationSize(),
                     &FinalizeDartWrapper);
 }
 
@@ -72,6 +76,10 @@ void DartWrappable::ClearDartWrapper() {
   this->ReleaseDartWrappableReference();
 }
 
+void DartWrappable::UpdateDartWrapperExternalSize() {
+  dart_wrapper_.UpdateExternalSize(GetAllocationSize());
+}
+
 void DartWrappable::FinalizeDartWrapper(void* isolate_callback_data,
                                         void* peer) {
   DartWrappable* wrappable = reinterpret_cast<DartWrappable*>(peer);
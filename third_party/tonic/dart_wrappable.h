@@ -38,12 +38,21 @@ class DartWrappable {
 
   virtual void ReleaseDartWrappableReference() const = 0;
 
+  // The memory retained by this object outside of the Dart heap, including
+  // memory held by the GPU, which the Dart VM accounts for when deciding to
+  // collect garbage. Reported when the wrapper is associated, and again
+  // whenever UpdateDartWrapperExternalSize is called.
+  virtual size_t GetAllocationSize() const;
+
   // Use this method sparingly. It follows a slower path using Dart_New.
   // Prefer constructing the object in Dart code and using
   // AssociateWithDartWrapper.
   Dart_Handle CreateDartWrapper(DartState* dart_state);
   void AssociateWithDartWrapper(Dart_Handle wrappable);
   void ClearDartWrapper();  // Warning: Might delete this.
+  // Reports the current GetAllocationSize to the Dart VM, for objects whose
+  // size changes or is only known after their wrapper was associated.
+  void UpdateDartWrapperExternalSize();
   Dart_WeakPersistentHandle dart_wrapper() const {
     return dart_wrapper_.value();
   }
@@ -17,6 +17,9 @@
 #include "paragraph_builder_skia.h"
 #include "paragraph_skia.h"
 
+#include <map>
+#include <type_traits>
+
 #include "third_party/skia/modules/skparagraph/include/ParagraphStyle.h"
 #include "third_party/skia/modules/skparagraph/include/TextStyle.h"
 #include "txt/paragraph_style.h"
@@ -42,26 +45,139 @@ SkFontStyle MakeSkFontStyle(txt::FontWeight font_weight,
                                            : SkFontStyle::Slant::kItalic_Slant);
 }
 
+// Layout cache keys are built by appending the bytes of every value that
+// affects the layout and the painting of a paragraph.
+template <typename T>
+void AppendToKey(std::string& key, const T& value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename C>
+void AppendStringToKey(std::string& key, const std::basic_string<C>& value) {
+  AppendToKey(key, value.size());
+  key.append(reinterpret_cast<const char*>(value.data()),
+             value.size() * sizeof(C));
+}
+
+void AppendToKey(std::string& key, const std::vector<std::string>& values) {
+  AppendToKey(key, values.size());
+  for (const auto& value : values) {
+    AppendStringToKey(key, value);
+  }
+}
+
+template <typename V>
+void AppendToKey(std::string& key, const std::map<std::string, V>& values) {
+  AppendToKey(key, values.size());
+  for (const auto& [tag, value] : values) {
+    AppendStringToKey(key, tag);
+    AppendToKey(key, value);
+  }
+}
+
+void AppendToKey(std::string& key, const ParagraphStyle& style) {
+  AppendToKey(key, style.font_weight);
+  AppendToKey(key, style.font_style);
+  AppendStringToKey(key, style.font_family);
+  AppendToKey(key, style.font_size);
+  AppendToKey(key, style.height);
+  AppendToKey(key, style.has_height_override);
+  AppendToKey(key, style.text_height_behavior);
+  AppendToKey(key, style.strut_enabled);
+  AppendToKey(key, style.strut_font_weight);
+  AppendToKey(key, style.strut_font_style);
+  AppendToKey(key, style.strut_font_families);
+  AppendToKey(key, style.strut_font_size);
+  AppendToKey(key, style.strut_height);
+  AppendToKey(key, style.strut_has_height_override);
+  AppendToKey(key, style.strut_half_leading);
+  AppendToKey(key, style.strut_leading);
+  AppendToKey(key, style.force_strut_height);
+  AppendToKey(key, style.text_align);
+  AppendToKey(key, style.text_direction);
+  AppendToKey(key, style.max_lines);
+  AppendStringToKey(key, style.ellipsis);
+  AppendStringToKey(key, style.locale);
+}
+
+void AppendToKey(std::string& key, const TextStyle& style) {
+  AppendToKey(key, style.color);
+  AppendToKey(key, style.decoration);
+  AppendToKey(key, style.decoration_color);
+  AppendToKey(key, style.decoration_style);
+  AppendToKey(key, style.decoration_thickness_multiplier);
+  AppendToKey(key, style.font_weight);
+  AppendToKey(key, style.font_style);
+  AppendToKey(key, style.text_baseline);
+  AppendToKey(key, style.half_leading);
+  AppendToKey(key, style.font_families);
+  AppendToKey(key, style.font_size);
+  AppendToKey(key, style.letter_spacing);
+  AppendToKey(key, style.word_spacing);
+  AppendToKey(key, style.height);
+  AppendToKey(key, style.has_height_override);
+  AppendStringToKey(key, style.locale);
+  AppendToKey(key, style.text_shadows.size());
+  for (const auto& shadow : style.text_shadows) {
+    AppendToKey(key, shadow.color);
+    AppendToKey(key, shadow.offset.fX);
+    AppendToKey(key, shadow.offset.fY);
+    AppendToKey(key, shadow.blur_sigma);
+  }
+  AppendToKey(key, style.font_features.GetFontFeatures());
+  AppendToKey(key, style.font_variations.GetAxisValues());
+}
+
 }  // anonymous namespace
 
 ParagraphBuilderSkia::ParagraphBuilderSkia(
     const ParagraphStyle& style,
     std::shared_ptr<FontCollection> font_collection)
-    : base_style_(style.GetTextStyle()) {
-  builder_ = skt::ParagraphBuilder::make(
-      TxtToSkia(style), font_collection->CreateSktFontCollection());
+    : base_style_(style.GetTextStyle()),
+      font_collection_(std::move(font_collection)),
+      layout_cache_key_(std::string()) {
+  skia_paragraph_style_ = TxtToSkia(style);
+  auto skia_font_collection = font_collection_->CreateSktFontCollection();
+  builder_ =
+      skt::ParagraphBuilder::make(skia_paragraph_style_, skia_font_collection);
+
+  // Paragraphs built before the fonts of the collection changed must not
+  // share layouts with the ones built after.
+  AppendToKey(*layout_cache_key_, skia_font_collection.get());
+  AppendToKey(*layout_cache_key_, style);
 }
 
 ParagraphBuilderSkia::~ParagraphBuilderSkia() = default;
 
 void ParagraphBuilderSkia::PushStyle(const TextStyle& style) {
-  builder_->pushStyle(TxtToSkia(style));
+  skt::TextStyle skia_style = TxtToSkia(style);
+  builder_->pushStyle(skia_style);
   txt_style_stack_.push(style);
+
+  builder_calls_.push_back([skia_style](skt::ParagraphBuilder& builder) {
+    builder.pushStyle(skia_style);
+  });
+
+  // Arbitrary paints can't be keyed.
+  if (style.foreground.has_value() || style.background.has_value()) {
+    layout_cache_key_.reset();
+  }
+  if (layout_cache_key_) {
+    layout_cache_key_->push_back('S');
+    AppendToKey(*layout_cache_key_, style);
+  }
 }
 
 void ParagraphBuilderSkia::Pop() {
   builder_->pop();
   txt_style_stack_.pop();
+
+  builder_calls_.push_back(
+      [](skt::ParagraphBuilder& builder) { builder.pop(); });
+  if (layout_cache_key_) {
+    layout_cache_key_->push_back('P');
+  }
 }
 
 const TextStyle& ParagraphBuilderSkia::PeekStyle() {
@@ -70,6 +186,14 @@ const TextStyle& ParagraphBuilderSkia::PeekStyle() {
 
 void ParagraphBuilderSkia::AddText(const std::u16string& text) {
   builder_->addText(text);
+  text_length_ += text.size();
+
+  builder_calls_.push_back(
+      [text](skt::ParagraphBuilder& builder) { builder.addText(text); });
+  if (layout_cache_key_) {
+    layout_cache_key_->push_back('T');
+    AppendStringToKey(*layout_cache_key_, text);
+  }
 }
 
 void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
@@ -82,11 +206,39 @@ void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
       static_cast<skt::PlaceholderAlignment>(span.alignment);
 
   builder_->addPlaceholder(placeholder_style);
+
+  builder_calls_.push_back([placeholder_style](skt::ParagraphBuilder& builder) {
+    builder.addPlaceholder(placeholder_style);
+  });
+  if (layout_cache_key_) {
+    layout_cache_key_->push_back('H');
+    AppendToKey(*layout_cache_key_, span.width);
+    AppendToKey(*layout_cache_key_, span.height);
+    AppendToKey(*layout_cache_key_, span.alignment);
+    AppendToKey(*layout_cache_key_, span.baseline);
+    AppendToKey(*layout_cache_key_, span.baseline_offset);
+  }
 }
 
 std::unique_ptr<Paragraph> ParagraphBuilderSkia::Build() {
-  return std::make_unique<ParagraphSkia>(builder_->Build(),
-                                         std::move(dl_paints_));
+  auto rebuild = [style = std::move(skia_paragraph_style_),
+                  calls = std::move(builder_calls_)](
+                     sk_sp<skt::FontCollection> font_collection) {
+    auto builder = skt::ParagraphBuilder::make(style, font_collection);
+    for (const auto& call : calls) {
+      call(*builder);
+    }
+    return builder->Build();
+  };
+  ParagraphSkia::LayoutCacheEntry layout_cache_entry;
+  if (layout_cache_key_) {
+    layout_cache_entry.cache = font_collection_->GetParagraphLayoutCache();
+    layout_cache_entry.key = std::move(layout_cache_key_.value());
+    layout_cache_entry.text_length = text_length_;
+  }
+  return std::make_unique<ParagraphSkia>(
+      builder_->Build(), std::move(dl_paints_), font_collection_,
+      std::move(rebuild), std::move(layout_cache_entry));
 }
 
 skt::ParagraphPainter::PaintID ParagraphBuilderSkia::CreatePaintID(
@@ -19,7 +19,13 @@
 
 #include "txt/paragraph_builder.h"
 
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "flutter/display_list/dl_paint.h"
+#include "paragraph_layout_cache.h"
 #include "third_party/skia/modules/skparagraph/include/ParagraphBuilder.h"
 
 namespace txt {
@@ -49,6 +55,18 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   TextStyle base_style_;
   std::stack<TextStyle> txt_style_stack_;
   std::vector<flutter::DlPaint> dl_paints_;
+
+  std::shared_ptr<FontCollection> font_collection_;
+
+  // The key of the layout cache that identifies the text and styles of the
+  // paragraph, unless they can't be keyed.
+  std::optional<std::string> layout_cache_key_;
+  size_t text_length_ = 0;
+
+  // The calls that replay the paragraph into another builder.
+  skia::textlayout::ParagraphStyle skia_paragraph_style_;
+  std::vector<std::function<void(skia::textlayout::ParagraphBuilder&)>>
+      builder_calls_;
 };
 
 }  // namespace txt
@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "paragraph_layout_cache.h"
+
+#include "flutter/fml/trace_event.h"
+
+namespace txt {
+
+namespace skt = skia::textlayout;
+
+namespace {
+
+// Skia doesn't report the memory a paragraph uses, so the size of a paragraph
+// is estimated from the length of its text. Every UTF-16 code unit takes up
+// about this many bytes in the runs, glyphs, positions and clusters of a laid
+// out paragraph.
+constexpr size_t kEstimatedBytesPerCodeUnit = 64u;
+constexpr size_t kEstimatedBytesPerParagraph = 1024u;
+
+std::string MakeEntryKey(const std::string& key, double width) {
+  std::string entry_key = key;
+  entry_key.append(reinterpret_cast<const char*>(&width), sizeof(width));
+  return entry_key;
+}
+
+}  // namespace
+
+ParagraphLayoutCache::ParagraphLayoutCache(size_t byte_budget)
+    : byte_budget_(byte_budget) {}
+
+ParagraphLayoutCache::~ParagraphLayoutCache() = default;
+
+std::shared_ptr<skt::Paragraph> ParagraphLayoutCache::Find(
+    const std::string& key,
+    double width) {
+  std::scoped_lock lock(mutex_);
+  auto found = index_.find(MakeEntryKey(key, width));
+  if (found == index_.end()) {
+    misses_++;
+    TraceStatsToTimeline();
+    return nullptr;
+  }
+  hits_++;
+  TraceStatsToTimeline();
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->paragraph;
+}
+
+bool ParagraphLayoutCache::Insert(const std::string& key,
+                                  double width,
+                                  std::shared_ptr<skt::Paragraph> paragraph,
+                                  size_t text_length) {
+  const size_t bytes =
+      kEstimatedBytesPerParagraph + text_length * kEstimatedBytesPerCodeUnit;
+  if (bytes > byte_budget_) {
+    return false;
+  }
+
+  std::scoped_lock lock(mutex_);
+  auto entry_key = MakeEntryKey(key, width);
+  auto found = index_.find(entry_key);
+  if (found != index_.end()) {
+    bytes_ -= found->second->bytes;
+    entries_.erase(found->second);
+    index_.erase(found);
+  }
+  while (!entries_.empty() && bytes_ + bytes > byte_budget_) {
+    bytes_ -= entries_.back().bytes;
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  entries_.push_front({entry_key, std::move(paragraph), bytes});
+  index_.emplace(std::move(entry_key), entries_.begin());
+  bytes_ += bytes;
+  return true;
+}
+
+void ParagraphLayoutCache::Clear() {
+  std::scoped_lock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+  bytes_ = 0;
+}
+
+size_t ParagraphLayoutCache::GetByteSize() const {
+  std::scoped_lock lock(mutex_);
+  return bytes_;
+}
+
+size_t ParagraphLayoutCache::GetHitCount() const {
+  std::scoped_lock lock(mutex_);
+  return hits_;
+}
+
+size_t ParagraphLayoutCache::GetMissCount() const {
+  std::scoped_lock lock(mutex_);
+  return misses_;
+}
+
+void ParagraphLayoutCache::TraceStatsToTimeline() const {
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER(
+      "flutter",                                                      //
+      "ParagraphLayoutCache", reinterpret_cast<int64_t>(this),        //
+      "Hits", hits_,                                                  //
+      "Misses", misses_,                                              //
+      "KBytes", bytes_ / 1024);
+#endif  // !FLUTTER_RELEASE
+}
+
+}  // namespace txt
@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
+#define LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/modules/skparagraph/include/Paragraph.h"
+
+namespace txt {
+
+// A cache of paragraphs that have been laid out, so that paragraphs with the
+// same text and styles that are laid out at the same width share one layout
+// instead of each shaping and breaking their text again.
+//
+// Cached paragraphs must not be laid out again, since they may be shared by
+// any number of |ParagraphSkia|s. The least recently used paragraphs are
+// evicted once the estimated size of the cached paragraphs exceeds the byte
+// budget. Hits and misses are reported to the timeline.
+//
+// The cache may be used from multiple threads.
+class ParagraphLayoutCache {
+ public:
+  static constexpr size_t kDefaultByteBudget = 4 * 1024 * 1024;
+
+  explicit ParagraphLayoutCache(size_t byte_budget = kDefaultByteBudget);
+
+  ~ParagraphLayoutCache();
+
+  // Returns the paragraph with the key that was laid out at the width, or
+  // null if there is none.
+  std::shared_ptr<skia::textlayout::Paragraph> Find(const std::string& key,
+                                                    double width);
+
+  // Adds a paragraph that has been laid out at the width to the cache. Returns
+  // false if the paragraph alone exceeds the byte budget and wasn't added.
+  bool Insert(const std::string& key,
+              double width,
+              std::shared_ptr<skia::textlayout::Paragraph> paragraph,
+              size_t text_length);
+
+  void Clear();
+
+  size_t GetByteSize() const;
+
+  size_t GetHitCount() const;
+
+  size_t GetMissCount() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<skia::textlayout::Paragraph> paragraph;
+    size_t bytes;
+  };
+
+  const size_t byte_budget_;
+  mutable std::mutex mutex_;
+  // Ordered from the most to the least recently used entry.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  size_t bytes_ = 0;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+
+  void TraceStatsToTimeline() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ParagraphLayoutCache);
+};
+
+}  // namespace txt
+
+#endif  // LIB_TXT_SRC_PARAGRAPH_LAYOUT_CACHE_H_
@@ -142,8 +142,15 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
 }  // anonymous namespace
 
 ParagraphSkia::ParagraphSkia(std::unique_ptr<skt::Paragraph> paragraph,
-                             std::vector<flutter::DlPaint>&& dl_paints)
-    : paragraph_(std::move(paragraph)), dl_paints_(dl_paints) {}
+                             std::vector<flutter::DlPaint>&& dl_paints,
+                             std::shared_ptr<FontCollection> font_collection,
+                             Rebuild rebuild,
+                             LayoutCacheEntry layout_cache_entry)
+    : paragraph_(std::move(paragraph)),
+      dl_paints_(dl_paints),
+      font_collection_(std::move(font_collection)),
+      rebuild_(std::move(rebuild)),
+      layout_cache_entry_(std::move(layout_cache_entry)) {}
 
 double ParagraphSkia::GetMaxWidth() {
   return SkScalarToDouble(paragraph_->getMaxWidth());
@@ -219,7 +226,52 @@ bool ParagraphSkia::DidExceedMaxLines() {
 void ParagraphSkia::Layout(double width) {
   line_metrics_.reset();
   line_metrics_styles_.clear();
+  if (FindCachedLayout(width)) {
+    return;
+  }
+  if (paragraph_is_shared_) {
+    paragraph_ = rebuild_(font_collection_->CreateSktFontCollection());
+    paragraph_has_own_font_collection_ = false;
+  }
+  LayoutAndCache(width);
+}
+
+void ParagraphSkia::LayoutConcurrently(double width) {
+  line_metrics_.reset();
+  line_metrics_styles_.clear();
+  if (FindCachedLayout(width)) {
+    return;
+  }
+  // The caches of the shared Skia font collection are not thread safe, so the
+  // paragraph is rebuilt with a collection of its own.
+  if (paragraph_is_shared_ || !paragraph_has_own_font_collection_) {
+    paragraph_ = rebuild_(font_collection_->MakeSktFontCollection());
+    paragraph_has_own_font_collection_ = true;
+  }
+  LayoutAndCache(width);
+}
+
+bool ParagraphSkia::FindCachedLayout(double width) {
+  if (!layout_cache_entry_.cache) {
+    return false;
+  }
+  auto cached = layout_cache_entry_.cache->Find(layout_cache_entry_.key, width);
+  if (!cached) {
+    return false;
+  }
+  paragraph_ = std::move(cached);
+  paragraph_is_shared_ = true;
+  return true;
+}
+
+void ParagraphSkia::LayoutAndCache(double width) {
   paragraph_->layout(width);
+  paragraph_is_shared_ = false;
+  if (layout_cache_entry_.cache) {
+    paragraph_is_shared_ = layout_cache_entry_.cache->Insert(
+        layout_cache_entry_.key, width, paragraph_,
+        layout_cache_entry_.text_length);
+  }
 }
 
 bool ParagraphSkia::Paint(DisplayListBuilder* builder, double x, double y) {
@@ -17,8 +17,11 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 #define LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 
+#include <functional>
 #include <optional>
 
+#include "paragraph_layout_cache.h"
+#include "txt/font_collection.h"
 #include "txt/paragraph.h"
 
 #include "third_party/skia/modules/skparagraph/include/Paragraph.h"
@@ -28,8 +31,24 @@ namespace txt {
 // Implementation of Paragraph based on Skia's text layout module.
 class ParagraphSkia : public Paragraph {
  public:
+  // Builds an unlaid out copy of the paragraph with the given font
+  // collection.
+  using Rebuild = std::function<std::unique_ptr<skia::textlayout::Paragraph>(
+      sk_sp<skia::textlayout::FontCollection>)>;
+
+  // Where the layouts of the paragraph are shared with the other paragraphs
+  // with the same key. Paragraphs without a cache don't share their layouts.
+  struct LayoutCacheEntry {
+    std::shared_ptr<ParagraphLayoutCache> cache;
+    std::string key;
+    size_t text_length = 0;
+  };
+
   ParagraphSkia(std::unique_ptr<skia::textlayout::Paragraph> paragraph,
-                std::vector<flutter::DlPaint>&& dl_paints);
+                std::vector<flutter::DlPaint>&& dl_paints,
+                std::shared_ptr<FontCollection> font_collection,
+                Rebuild rebuild,
+                LayoutCacheEntry layout_cache_entry);
 
   virtual ~ParagraphSkia() = default;
 
@@ -53,6 +72,8 @@ class ParagraphSkia : public Paragraph {
 
   void Layout(double width) override;
 
+  void LayoutConcurrently(double width) override;
+
   bool Paint(flutter::DisplayListBuilder* builder, double x, double y) override;
 
   std::vector<TextBox> GetRectsForRange(
@@ -71,10 +92,27 @@ class ParagraphSkia : public Paragraph {
  private:
   TextStyle SkiaToTxt(const skia::textlayout::TextStyle& skia);
 
-  std::unique_ptr<skia::textlayout::Paragraph> paragraph_;
+  std::shared_ptr<skia::textlayout::Paragraph> paragraph_;
   std::vector<flutter::DlPaint> dl_paints_;
+  std::shared_ptr<FontCollection> font_collection_;
+  Rebuild rebuild_;
+  LayoutCacheEntry layout_cache_entry_;
+  // Whether |paragraph_| is shared through the layout cache, and so must not
+  // be laid out again.
+  bool paragraph_is_shared_ = false;
+  // Whether |paragraph_| was built with a Skia font collection of its own,
+  // rather than the shared one of |font_collection_|.
+  bool paragraph_has_own_font_collection_ = false;
   std::optional<std::vector<LineMetrics>> line_metrics_;
   std::vector<TextStyle> line_metrics_styles_;
+
+  // Looks the layout at |width| up in the layout cache, and shares it if
+  // there is one.
+  bool FindCachedLayout(double width);
+
+  // Lays out |paragraph_|, which must not be shared, and adds its layout to
+  // the layout cache.
+  void LayoutAndCache(double width);
 };
 
 }  // namespace txt
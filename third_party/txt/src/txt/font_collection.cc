@@ -31,7 +31,9 @@
 
 namespace txt {
 
-FontCollection::FontCollection() : enable_font_fallback_(true) {}
+FontCollection::FontCollection()
+    : enable_font_fallback_(true),
+      paragraph_layout_cache_(std::make_shared<ParagraphLayoutCache>()) {}
 
 FontCollection::~FontCollection() {
   if (skt_collection_) {
@@ -50,22 +52,22 @@ void FontCollection::SetupDefaultFontManager(
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
   default_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollection();
 }
 
 void FontCollection::SetAssetFontManager(sk_sp<SkFontMgr> font_manager) {
   asset_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollection();
 }
 
 void FontCollection::SetDynamicFontManager(sk_sp<SkFontMgr> font_manager) {
   dynamic_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollection();
 }
 
 void FontCollection::SetTestFontManager(sk_sp<SkFontMgr> font_manager) {
   test_font_manager_ = font_manager;
-  skt_collection_.reset();
+  ResetSktFontCollection();
 }
 
 // Return the available font managers in the order they should be queried.
@@ -87,34 +89,53 @@ void FontCollection::DisableFontFallback() {
   if (skt_collection_) {
     skt_collection_->disableFontFallback();
   }
+  paragraph_layout_cache_->Clear();
 }
 
 void FontCollection::ClearFontFamilyCache() {
   if (skt_collection_) {
     skt_collection_->clearCaches();
   }
+  paragraph_layout_cache_->Clear();
+}
+
+void FontCollection::ResetSktFontCollection() {
+  skt_collection_.reset();
+  paragraph_layout_cache_->Clear();
+}
+
+std::shared_ptr<ParagraphLayoutCache> FontCollection::GetParagraphLayoutCache()
+    const {
+  return paragraph_layout_cache_;
 }
 
 sk_sp<skia::textlayout::FontCollection>
 FontCollection::CreateSktFontCollection() {
   if (!skt_collection_) {
-    skt_collection_ = sk_make_sp<skia::textlayout::FontCollection>();
-
-    std::vector<SkString> default_font_families;
-    for (const std::string& family : GetDefaultFontFamilies()) {
-      default_font_families.emplace_back(family);
-    }
-    skt_collection_->setDefaultFontManager(default_font_manager_,
-                                           default_font_families);
-    skt_collection_->setAssetFontManager(asset_font_manager_);
-    skt_collection_->setDynamicFontManager(dynamic_font_manager_);
-    skt_collection_->setTestFontManager(test_font_manager_);
-    if (!enable_font_fallback_) {
-      skt_collection_->disableFontFallback();
-    }
+    skt_collection_ = MakeSktFontCollection();
   }
 
   return skt_collection_;
 }
 
+sk_sp<skia::textlayout::FontCollection> FontCollection::MakeSktFontCollection()
+    const {
+  auto skt_collection = sk_make_sp<skia::textlayout::FontCollection>();
+
+  std::vector<SkString> default_font_families;
+  for (const std::string& family : GetDefaultFontFamilies()) {
+    default_font_families.emplace_back(family);
+  }
+  skt_collection->setDefaultFontManager(default_font_manager_,
+                                        default_font_families);
+  skt_collection->setAssetFontManager(asset_font_manager_);
+  skt_collection->setDynamicFontManager(dynamic_font_manager_);
+  skt_collection->setTestFontManager(test_font_manager_);
+  if (!enable_font_fallback_) {
+    skt_collection->disableFontFallback();
+  }
+
+  return skt_collection;
+}
+
 }  // namespace txt
@@ -26,6 +26,7 @@
 #include "third_party/googletest/googletest/include/gtest/gtest_prod.h"  // nogncheck
 #include "third_party/skia/include/core/SkFontMgr.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
+#include "skia/paragraph_layout_cache.h"
 #include "third_party/skia/modules/skparagraph/include/FontCollection.h"  // nogncheck
 #include "txt/asset_font_manager.h"
 #include "txt/text_style.h"
@@ -56,6 +57,15 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // Construct a Skia text layout FontCollection based on this collection.
   sk_sp<skia::textlayout::FontCollection> CreateSktFontCollection();
 
+  // Construct a Skia text layout FontCollection based on this collection that
+  // isn't shared with any other paragraph, for laying out a paragraph on
+  // another thread. The caches of Skia's font collections are not thread safe.
+  sk_sp<skia::textlayout::FontCollection> MakeSktFontCollection() const;
+
+  // The layouts of the paragraphs that have been laid out with this
+  // collection. Cleared whenever the fonts of the collection change.
+  std::shared_ptr<ParagraphLayoutCache> GetParagraphLayoutCache() const;
+
  private:
   sk_sp<SkFontMgr> default_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
@@ -66,6 +76,10 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   // An equivalent font collection usable by the Skia text shaper library.
   sk_sp<skia::textlayout::FontCollection> skt_collection_;
 
+  std::shared_ptr<ParagraphLayoutCache> paragraph_layout_cache_;
+
+  void ResetSktFontCollection();
+
   std::vector<sk_sp<SkFontMgr>> GetFontManagerOrder() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
@@ -143,6 +143,11 @@ class Paragraph {
   // before Painting and getting any statistics from this class.
   virtual void Layout(double width) = 0;
 
+  // Like Layout(), but may be called on any thread, concurrently with the
+  // layout of other paragraphs that were built with the same font collection.
+  // The fonts of the collection must not change until it returns.
+  virtual void LayoutConcurrently(double width) = 0;
+
   // Paints the laid out text onto the supplied DisplayListBuilder at
   // (x, y) offset from the origin. Only valid after Layout() is called.
   virtual bool Paint(flutter::DisplayListBuilder* builder,